@@ -1,242 +1,349 @@
 // Google Benchmark suite for FIX parser comparison
-// Compares: Naive, StringView, and FSM parsers
-// Goal: FSM should be ≥5× faster than naive
+// Compares: Naive, StringView, Optimized, FSM, SIMD and RepeatingGroup parsers
+// over the same workloads, so the numbers can be compared across parsers
+//
+// Every benchmark parses a batch of BATCH_MESSAGES framed messages (valid
+// BodyLength and CheckSum, newline separated) built from four knobs:
+//   pad     - extra 58=Text fields per message (message size)
+//   soh     - 0 for '|' delimiters, 1 for SOH
+//   chunk   - 0 to hand over the whole batch, else the read size the
+//             stream is cut into (streaming parsers only)
+//   entries - MDEntries per 35=W message (repeating-group parser only)
+// Naive and StringView split fields on '|' only, so they skip soh=1.
+//
+// Reported: bytes/s, items/s (= messages/s), ticks per message, and when
+// perf events are available, IPC plus cycles, branch misses and cache
+// misses per message from HardwareProfiler.
 
 #include <benchmark/benchmark.h>
+#include "benchmarks/hardware_profiler.hpp"
 #include "parser/naive_fix_parser.hpp"
 #include "parser/stringview_fix_parser.hpp"
+#include "parser/optimized_fix_parser.hpp"
 #include "parser/fsm_fix_parser.hpp"
+#include "parser/simd_fix_parser.hpp"
+#include "parser/repeating_group_parser.hpp"
 #include "common/tick.hpp"
+#include "common/tick_span.hpp"
 
+#include <algorithm>
+#include <cstdio>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace feedhandler;
 
-// Sample FIX messages for benchmarking
-static const std::string SIMPLE_MESSAGE = 
-    "8=FIX.4.4|9=79|35=D|55=AAPL|44=150.2500|38=500|54=1|52=20240131-12:34:56|10=020|\n";
+namespace {
 
-static const std::string COMPLEX_MESSAGE = 
-    "8=FIX.4.4|9=120|35=D|49=SENDER|56=TARGET|34=1|52=20240131-12:34:56.789|"
-    "55=MSFT|54=2|38=1000|44=380.7500|40=2|59=0|21=1|207=NASDAQ|10=123|\n";
+constexpr size_t BATCH_MESSAGES = 100;
 
-static const std::string MULTIPLE_MESSAGES = 
-    "8=FIX.4.4|9=79|35=D|55=AAPL|44=150.25|38=500|54=1|52=20240131-12:34:56|10=020|\n"
-    "8=FIX.4.4|9=79|35=D|55=GOOGL|44=2800.50|38=100|54=2|52=20240131-12:34:57|10=021|\n"
-    "8=FIX.4.4|9=79|35=D|55=TSLA|44=245.75|38=750|54=1|52=20240131-12:34:58|10=022|\n";
+const char* const SYMBOLS[] = {"AAPL", "MSFT", "GOOGL", "TSLA", "NVDA", "AMZN", "META", "NFLX"};
 
-// ============================================================================
-// Naive Parser Benchmarks
-// ============================================================================
+// "8=FIX.4.4|9=<len>|<body>10=<sum>|" with the chosen delimiter
+std::string frame(const std::string& body, char delimiter) {
+    std::string message = "8=FIX.4.4";
+    message += delimiter;
+    message += "9=" + std::to_string(body.size());
+    message += delimiter;
+    message += body;
 
-static void BM_NaiveParser_SingleMessage(benchmark::State& state) {
-    for (auto _ : state) {
-        common::Tick tick = parser::NaiveFixParser::parse_message(SIMPLE_MESSAGE);
-        benchmark::DoNotOptimize(tick);
+    unsigned checksum = 0;
+    for (unsigned char c : message) {
+        checksum += c;
     }
-    
-    state.SetItemsProcessed(state.iterations());
-    state.SetBytesProcessed(state.iterations() * SIMPLE_MESSAGE.size());
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u", checksum % 256);
+    message += trailer;
+    message += delimiter;
+    return message;
 }
-BENCHMARK(BM_NaiveParser_SingleMessage);
 
-static void BM_NaiveParser_ComplexMessage(benchmark::State& state) {
-    for (auto _ : state) {
-        common::Tick tick = parser::NaiveFixParser::parse_message(COMPLEX_MESSAGE);
-        benchmark::DoNotOptimize(tick);
+struct Workload {
+    std::string buffer;
+    size_t messages = 0;
+};
+
+// 35=D order messages with pad filler fields
+Workload make_orders(size_t pad, char delimiter) {
+    Workload workload;
+    for (size_t i = 0; i < BATCH_MESSAGES; ++i) {
+        std::string body;
+        auto field = [&](const std::string& tag_value) {
+            body += tag_value;
+            body += delimiter;
+        };
+        field("35=D");
+        field(std::string("55=") + SYMBOLS[i % 8]);
+        field("44=" + std::to_string(100 + i % 50) + ".25");
+        field("38=" + std::to_string(100 * (1 + i % 10)));
+        field(i % 2 ? "54=2" : "54=1");
+        field("52=20240131-12:34:56.789");
+        for (size_t p = 0; p < pad; ++p) {
+            field("58=FILLER" + std::to_string(p));
+        }
+        workload.buffer += frame(body, delimiter);
+        workload.buffer += '\n';
     }
-    
-    state.SetItemsProcessed(state.iterations());
-    state.SetBytesProcessed(state.iterations() * COMPLEX_MESSAGE.size());
+    workload.messages = BATCH_MESSAGES;
+    return workload;
 }
-BENCHMARK(BM_NaiveParser_ComplexMessage);
-
-static void BM_NaiveParser_Batch(benchmark::State& state) {
-    const int batch_size = state.range(0);
-    
-    // Create batch of messages
-    std::string batch;
-    batch.reserve(SIMPLE_MESSAGE.size() * batch_size);
-    for (int i = 0; i < batch_size; ++i) {
-        batch += SIMPLE_MESSAGE;
+
+// 35=W snapshots with entries bid/offer levels each
+Workload make_snapshots(size_t entries, char delimiter) {
+    Workload workload;
+    for (size_t i = 0; i < BATCH_MESSAGES; ++i) {
+        std::string body;
+        auto field = [&](const std::string& tag_value) {
+            body += tag_value;
+            body += delimiter;
+        };
+        field("35=W");
+        field(std::string("55=") + SYMBOLS[i % 8]);
+        field("268=" + std::to_string(entries));
+        for (size_t e = 0; e < entries; ++e) {
+            field(e % 2 ? "269=1" : "269=0");
+            field("270=" + std::to_string(100 + e) + ".50");
+            field("271=" + std::to_string(100 * (1 + e)));
+        }
+        workload.buffer += frame(body, delimiter);
+        workload.buffer += '\n';
     }
-    
+    workload.messages = BATCH_MESSAGES;
+    return workload;
+}
+
+char delimiter_arg(int64_t soh) {
+    return soh ? '\x01' : '|';
+}
+
+// Feed buffer in chunk-sized reads (0 = all at once)
+template<typename Parse>
+void feed(std::string_view buffer, size_t chunk, Parse&& parse) {
+    if (chunk == 0) {
+        parse(buffer.data(), buffer.size());
+        return;
+    }
+    for (size_t offset = 0; offset < buffer.size(); offset += chunk) {
+        parse(buffer.data() + offset, std::min(chunk, buffer.size() - offset));
+    }
+}
+
+// Runs the timing loop around body() (returns ticks per batch) and
+// reports throughput plus hardware counters per message
+template<typename Body>
+void run(benchmark::State& state, const Workload& workload, Body&& body) {
+    benchmarks::HardwareProfiler profiler;
+    size_t ticks = 0;
+
+    profiler.start();
     for (auto _ : state) {
-        // Parse each message in batch
-        size_t pos = 0;
-        while (pos < batch.size()) {
-            size_t end = batch.find('\n', pos);
-            if (end == std::string::npos) break;
-            
-            std::string msg = batch.substr(pos, end - pos + 1);
-            common::Tick tick = parser::NaiveFixParser::parse_message(msg);
-            benchmark::DoNotOptimize(tick);
-            
-            pos = end + 1;
+        ticks = body();
+        benchmark::ClobberMemory();
+    }
+    benchmarks::HardwareProfiler::Metrics metrics = profiler.stop();
+
+    int64_t messages = static_cast<int64_t>(state.iterations() * workload.messages);
+    state.SetItemsProcessed(messages);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * workload.buffer.size()));
+    state.counters["ticks/msg"] = static_cast<double>(ticks) / static_cast<double>(workload.messages);
+    state.counters["msg_bytes"] = static_cast<double>(workload.buffer.size()) / static_cast<double>(workload.messages);
+
+    if (metrics.cpu_cycles > 0 && messages > 0) {
+        double per_message = 1.0 / static_cast<double>(messages);
+        state.counters["IPC"] = metrics.ipc;
+        state.counters["cycles/msg"] = static_cast<double>(metrics.cpu_cycles) * per_message;
+        state.counters["br_miss/msg"] = static_cast<double>(metrics.branch_misses) * per_message;
+        state.counters["cache_miss/msg"] = static_cast<double>(metrics.l1_cache_misses) * per_message;
+    }
+}
+
+// Newline-separated messages, for the whole-message parsers
+template<typename Func>
+size_t for_each_line(std::string_view buffer, Func&& func) {
+    size_t count = 0;
+    size_t start = 0;
+    while (start < buffer.size()) {
+        size_t end = buffer.find('\n', start);
+        if (end == std::string_view::npos) {
+            end = buffer.size();
         }
+        if (end > start) {
+            func(buffer.substr(start, end - start));
+            ++count;
+        }
+        start = end + 1;
     }
-    
-    state.SetItemsProcessed(state.iterations() * batch_size);
-    state.SetBytesProcessed(state.iterations() * batch.size());
+    return count;
 }
-BENCHMARK(BM_NaiveParser_Batch)->Arg(10)->Arg(100)->Arg(1000);
 
 // ============================================================================
-// StringView Parser Benchmarks
+// Argument sets
 // ============================================================================
 
-static void BM_StringViewParser_SingleMessage(benchmark::State& state) {
-    for (auto _ : state) {
-        common::Tick tick = parser::StringViewFixParser::parse_message(SIMPLE_MESSAGE);
-        benchmark::DoNotOptimize(tick);
+void pipe_only_shapes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"pad", "soh", "chunk"});
+    for (int64_t pad : {0, 8, 32}) {
+        bench->Args({pad, 0, 0});
     }
-    
-    state.SetItemsProcessed(state.iterations());
-    state.SetBytesProcessed(state.iterations() * SIMPLE_MESSAGE.size());
 }
-BENCHMARK(BM_StringViewParser_SingleMessage);
 
-static void BM_StringViewParser_ComplexMessage(benchmark::State& state) {
-    for (auto _ : state) {
-        common::Tick tick = parser::StringViewFixParser::parse_message(COMPLEX_MESSAGE);
-        benchmark::DoNotOptimize(tick);
+void message_shapes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"pad", "soh", "chunk"});
+    for (int64_t pad : {0, 8, 32}) {
+        for (int64_t soh : {0, 1}) {
+            bench->Args({pad, soh, 0});
+        }
     }
-    
-    state.SetItemsProcessed(state.iterations());
-    state.SetBytesProcessed(state.iterations() * COMPLEX_MESSAGE.size());
 }
-BENCHMARK(BM_StringViewParser_ComplexMessage);
-
-static void BM_StringViewParser_Batch(benchmark::State& state) {
-    const int batch_size = state.range(0);
-    
-    std::string batch;
-    batch.reserve(SIMPLE_MESSAGE.size() * batch_size);
-    for (int i = 0; i < batch_size; ++i) {
-        batch += SIMPLE_MESSAGE;
+
+void streaming_shapes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"pad", "soh", "chunk"});
+    for (int64_t pad : {0, 8, 32}) {
+        for (int64_t soh : {0, 1}) {
+            for (int64_t chunk : {0, 16, 64, 1500}) {
+                bench->Args({pad, soh, chunk});
+            }
+        }
     }
-    
-    for (auto _ : state) {
-        size_t pos = 0;
-        while (pos < batch.size()) {
-            size_t end = batch.find('\n', pos);
-            if (end == std::string::npos) break;
-            
-            std::string_view msg(batch.data() + pos, end - pos + 1);
-            common::Tick tick = parser::StringViewFixParser::parse_message(msg);
-            benchmark::DoNotOptimize(tick);
-            
-            pos = end + 1;
+}
+
+void group_shapes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"entries", "soh"});
+    for (int64_t entries : {1, 5, 20}) {
+        for (int64_t soh : {0, 1}) {
+            bench->Args({entries, soh});
         }
     }
-    
-    state.SetItemsProcessed(state.iterations() * batch_size);
-    state.SetBytesProcessed(state.iterations() * batch.size());
 }
-BENCHMARK(BM_StringViewParser_Batch)->Arg(10)->Arg(100)->Arg(1000);
+
+} // namespace
 
 // ============================================================================
-// FSM Parser Benchmarks
+// Whole-message parsers
 // ============================================================================
 
-static void BM_FSMParser_SingleMessage(benchmark::State& state) {
-    parser::FSMFixParser parser;
-    std::vector<common::Tick> ticks;
-    ticks.reserve(1);
-    
-    for (auto _ : state) {
-        ticks.clear();
-        parser.reset();
-        parser.parse(SIMPLE_MESSAGE.data(), SIMPLE_MESSAGE.size(), ticks);
-        benchmark::DoNotOptimize(ticks);
-    }
-    
-    state.SetItemsProcessed(state.iterations());
-    state.SetBytesProcessed(state.iterations() * SIMPLE_MESSAGE.size());
+static void BM_NaiveParser(benchmark::State& state) {
+    Workload workload = make_orders(static_cast<size_t>(state.range(0)), delimiter_arg(state.range(1)));
+    run(state, workload, [&] {
+        return for_each_line(workload.buffer, [](std::string_view line) {
+            // Naive parser takes an owning string, so the copy is part of its cost
+            common::Tick tick = parser::NaiveFixParser::parse_message(std::string(line));
+            benchmark::DoNotOptimize(tick);
+        });
+    });
+}
+BENCHMARK(BM_NaiveParser)->Apply(pipe_only_shapes);
+
+static void BM_StringViewParser(benchmark::State& state) {
+    Workload workload = make_orders(static_cast<size_t>(state.range(0)), delimiter_arg(state.range(1)));
+    std::vector<common::Tick> storage(BATCH_MESSAGES);
+    run(state, workload, [&] {
+        common::TickSpan<common::Tick> ticks(storage.data(), storage.size());
+        parser::StringViewFixParser::parse_messages_from_buffer(workload.buffer, ticks);
+        benchmark::DoNotOptimize(storage.data());
+        return ticks.size();
+    });
+}
+BENCHMARK(BM_StringViewParser)->Apply(pipe_only_shapes);
+
+static void BM_OptimizedParser(benchmark::State& state) {
+    Workload workload = make_orders(static_cast<size_t>(state.range(0)), delimiter_arg(state.range(1)));
+    std::vector<common::Tick> storage(BATCH_MESSAGES);
+    run(state, workload, [&] {
+        common::TickSpan<common::Tick> ticks(storage.data(), storage.size());
+        parser::OptimizedFixParser::parse_messages_from_buffer(workload.buffer, ticks);
+        benchmark::DoNotOptimize(storage.data());
+        return ticks.size();
+    });
 }
-BENCHMARK(BM_FSMParser_SingleMessage);
+BENCHMARK(BM_OptimizedParser)->Apply(message_shapes);
 
-static void BM_FSMParser_ComplexMessage(benchmark::State& state) {
+// ============================================================================
+// Streaming parsers (fragmented reads)
+// ============================================================================
+
+static void BM_FSMParser(benchmark::State& state) {
+    Workload workload = make_orders(static_cast<size_t>(state.range(0)), delimiter_arg(state.range(1)));
+    size_t chunk = static_cast<size_t>(state.range(2));
     parser::FSMFixParser parser;
     std::vector<common::Tick> ticks;
-    ticks.reserve(1);
-    
-    for (auto _ : state) {
+    ticks.reserve(BATCH_MESSAGES);
+    run(state, workload, [&] {
         ticks.clear();
         parser.reset();
-        parser.parse(COMPLEX_MESSAGE.data(), COMPLEX_MESSAGE.size(), ticks);
-        benchmark::DoNotOptimize(ticks);
-    }
-    
-    state.SetItemsProcessed(state.iterations());
-    state.SetBytesProcessed(state.iterations() * COMPLEX_MESSAGE.size());
+        feed(workload.buffer, chunk, [&](const char* data, size_t length) {
+            parser.parse(data, length, ticks);
+        });
+        benchmark::DoNotOptimize(ticks.data());
+        return ticks.size();
+    });
 }
-BENCHMARK(BM_FSMParser_ComplexMessage);
+BENCHMARK(BM_FSMParser)->Apply(streaming_shapes);
 
-static void BM_FSMParser_Batch(benchmark::State& state) {
-    parser::FSMFixParser parser;
-    const int batch_size = state.range(0);
-    
-    std::string batch;
-    batch.reserve(SIMPLE_MESSAGE.size() * batch_size);
-    for (int i = 0; i < batch_size; ++i) {
-        batch += SIMPLE_MESSAGE;
-    }
-    
+static void BM_SIMDParser(benchmark::State& state) {
+    Workload workload = make_orders(static_cast<size_t>(state.range(0)), delimiter_arg(state.range(1)));
+    size_t chunk = static_cast<size_t>(state.range(2));
+    parser::SIMDFixParser parser;
     std::vector<common::Tick> ticks;
-    ticks.reserve(batch_size);
-    
-    for (auto _ : state) {
+    ticks.reserve(BATCH_MESSAGES);
+    run(state, workload, [&] {
         ticks.clear();
         parser.reset();
-        parser.parse(batch.data(), batch.size(), ticks);
-        benchmark::DoNotOptimize(ticks);
-    }
-    
-    state.SetItemsProcessed(state.iterations() * batch_size);
-    state.SetBytesProcessed(state.iterations() * batch.size());
+        feed(workload.buffer, chunk, [&](const char* data, size_t length) {
+            parser.parse(data, length, ticks);
+        });
+        benchmark::DoNotOptimize(ticks.data());
+        return ticks.size();
+    });
 }
-BENCHMARK(BM_FSMParser_Batch)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_SIMDParser)->Apply(streaming_shapes);
 
 // ============================================================================
-// Streaming/Fragmentation Benchmarks (FSM only)
+// Repeating groups (entries per message)
 // ============================================================================
 
-static void BM_FSMParser_Fragmented(benchmark::State& state) {
-    parser::FSMFixParser parser;
-    const int chunk_size = state.range(0);
-    std::vector<common::Tick> ticks;
-    ticks.reserve(10);
-    
-    for (auto _ : state) {
-        ticks.clear();
-        parser.reset();
-        
-        // Simulate fragmented TCP stream
-        size_t offset = 0;
-        while (offset < MULTIPLE_MESSAGES.size()) {
-            size_t len = std::min<size_t>(chunk_size, MULTIPLE_MESSAGES.size() - offset);
-            parser.parse(MULTIPLE_MESSAGES.data() + offset, len, ticks);
-            offset += len;
-        }
-        
-        benchmark::DoNotOptimize(ticks);
-    }
-    
-    state.SetItemsProcessed(state.iterations() * 3); // 3 messages
-    state.SetBytesProcessed(state.iterations() * MULTIPLE_MESSAGES.size());
+static void BM_RepeatingGroupParser(benchmark::State& state) {
+    size_t entries = static_cast<size_t>(state.range(0));
+    Workload workload = make_snapshots(entries, delimiter_arg(state.range(1)));
+    std::vector<common::Tick> storage(BATCH_MESSAGES * entries);
+    run(state, workload, [&] {
+        common::TickSpan<common::Tick> ticks(storage.data(), storage.size());
+        parser::RepeatingGroupParser::parse_buffer_with_repeating_groups(workload.buffer, ticks);
+        benchmark::DoNotOptimize(storage.data());
+        return ticks.size();
+    });
+}
+BENCHMARK(BM_RepeatingGroupParser)->Apply(group_shapes);
+
+static void BM_RepeatingGroupParser_Entries(benchmark::State& state) {
+    size_t entries = static_cast<size_t>(state.range(0));
+    Workload workload = make_snapshots(entries, delimiter_arg(state.range(1)));
+    run(state, workload, [&] {
+        // Visitor path: entries go straight to the consumer, no tick storage
+        size_t count = 0;
+        for_each_line(workload.buffer, [&](std::string_view line) {
+            parser::RepeatingGroupParser::for_each_entry(line, [&](const parser::RepeatingGroupParser::MDEntry& entry) {
+                benchmark::DoNotOptimize(entry.price);
+                ++count;
+                return true;
+            });
+        });
+        return count;
+    });
 }
-BENCHMARK(BM_FSMParser_Fragmented)->Arg(8)->Arg(16)->Arg(32)->Arg(64);
+BENCHMARK(BM_RepeatingGroupParser_Entries)->Apply(group_shapes);
 
 // ============================================================================
 // Memory Allocation Benchmarks
 // ============================================================================
 
 static void BM_NaiveParser_Allocations(benchmark::State& state) {
+    Workload workload = make_orders(0, '|');
+    std::string message = workload.buffer.substr(0, workload.buffer.find('\n'));
     for (auto _ : state) {
         // Naive parser allocates strings internally
-        common::Tick tick = parser::NaiveFixParser::parse_message(SIMPLE_MESSAGE);
+        common::Tick tick = parser::NaiveFixParser::parse_message(message);
         benchmark::DoNotOptimize(tick);
         benchmark::ClobberMemory();
     }
@@ -244,15 +351,17 @@ static void BM_NaiveParser_Allocations(benchmark::State& state) {
 BENCHMARK(BM_NaiveParser_Allocations);
 
 static void BM_FSMParser_NoAllocations(benchmark::State& state) {
+    Workload workload = make_orders(0, '|');
+    std::string message = workload.buffer.substr(0, workload.buffer.find('\n') + 1);
     parser::FSMFixParser parser;
     std::vector<common::Tick> ticks;
     ticks.reserve(1);
-    
+
     for (auto _ : state) {
         ticks.clear();
         parser.reset();
         // FSM parser should not allocate in hot path
-        parser.parse(SIMPLE_MESSAGE.data(), SIMPLE_MESSAGE.size(), ticks);
+        parser.parse(message.data(), message.size(), ticks);
         benchmark::DoNotOptimize(ticks);
         benchmark::ClobberMemory();
     }
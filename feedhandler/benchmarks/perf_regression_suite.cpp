@@ -0,0 +1,288 @@
+// Performance regression suite: the hot paths the test_* demos exercise,
+// over fixed inputs, checked against a committed baseline
+//
+//   perf_regression [--baseline FILE] [--update-baseline] [--json FILE]
+//                   [--cpu N] [--filter TEXT] [--tolerance X] [--quick]
+//
+// Without --update-baseline every expectation in the baseline is checked
+// and the exit status is 1 if any metric regressed beyond its tolerance
+// or went missing. --update-baseline rewrites the file from this run
+// (ns_per_op and, where perf events are available, instructions_per_op).
+// The inputs are generated from fixed seeds, so two runs on the same
+// host measure the same work.
+
+#include "benchmarks/perf_regression.hpp"
+#include "common/tick.hpp"
+#include "common/tick_pool.hpp"
+#include "common/zero_latency_allocator.hpp"
+#include "parser/fast_number_parser.hpp"
+#include "parser/fsm_fix_parser.hpp"
+#include "parser/simd_fix_parser.hpp"
+#include "parser/trade_json_parser.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace feedhandler;
+using benchmarks::PerfComparison;
+using benchmarks::PerfHarness;
+using benchmarks::PerfScenario;
+
+namespace {
+
+constexpr size_t BATCH_MESSAGES = 1000;
+constexpr size_t BATCH_VALUES = 1024;
+
+// Results land here so the compiler cannot drop the work
+volatile int64_t sink;
+
+const char* const SYMBOLS[] = {"AAPL", "MSFT", "GOOGL", "TSLA", "NVDA", "AMZN", "META", "NFLX"};
+
+// "8=FIX.4.4|9=<len>|<body>10=<sum>|" with the chosen delimiter
+std::string frame(const std::string& body, char delimiter) {
+    std::string message = "8=FIX.4.4";
+    message += delimiter;
+    message += "9=" + std::to_string(body.size());
+    message += delimiter;
+    message += body;
+
+    unsigned checksum = 0;
+    for (unsigned char c : message) {
+        checksum += c;
+    }
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u", checksum % 256);
+    message += trailer;
+    message += delimiter;
+    return message;
+}
+
+std::string make_price(std::mt19937& rng) {
+    std::uniform_int_distribution<int> whole(1, 99999);
+    std::uniform_int_distribution<int> fraction(0, 9999);
+    char text[16];
+    std::snprintf(text, sizeof(text), "%d.%04d", whole(rng), fraction(rng));
+    return text;
+}
+
+// BATCH_MESSAGES framed 35=D messages, newline separated
+std::string make_fix_stream(char delimiter) {
+    std::mt19937 rng(91);
+    std::uniform_int_distribution<int> quantity(1, 5000);
+    std::string stream;
+    for (size_t i = 0; i < BATCH_MESSAGES; ++i) {
+        std::string body;
+        for (const std::string& field : {std::string("35=D"), std::string("55=") + SYMBOLS[i % 8],
+                                         "44=" + make_price(rng), "38=" + std::to_string(quantity(rng)),
+                                         std::string("54=") + (i % 2 ? "2" : "1"), std::string("52=20240131-12:34:56")}) {
+            body += field;
+            body += delimiter;
+        }
+        stream += frame(body, delimiter);
+        stream += '\n';
+    }
+    return stream;
+}
+
+std::vector<std::string> make_prices() {
+    std::mt19937 rng(44);
+    std::vector<std::string> prices;
+    prices.reserve(BATCH_VALUES);
+    for (size_t i = 0; i < BATCH_VALUES; ++i) {
+        prices.push_back(make_price(rng));
+    }
+    return prices;
+}
+
+std::vector<std::string> make_trades() {
+    std::mt19937 rng(7);
+    std::vector<std::string> trades;
+    trades.reserve(BATCH_MESSAGES);
+    for (size_t i = 0; i < BATCH_MESSAGES; ++i) {
+        trades.push_back(std::string(R"({"e":"trade","E":1672515782136,"s":")") + SYMBOLS[i % 8] +
+                         R"(USDT","t":)" + std::to_string(12345 + i) + R"(,"p":")" + make_price(rng) +
+                         R"(","q":"0.00100000","T":1672515782136,"m":)" + (i % 2 ? "true" : "false") + "}");
+    }
+    return trades;
+}
+
+void add_scenarios(PerfHarness& harness) {
+    {
+        auto stream = std::make_shared<std::string>(make_fix_stream('|'));
+        auto parser = std::make_shared<parser::FSMFixParser>();
+        auto ticks = std::make_shared<std::vector<common::Tick>>();
+        ticks->reserve(BATCH_MESSAGES);
+        harness.add({"fsm_parser.messages", BATCH_MESSAGES, [stream, parser, ticks] {
+            ticks->clear();
+            parser->reset();
+            sink = static_cast<int64_t>(parser->parse(stream->data(), stream->size(), *ticks));
+        }});
+    }
+    {
+        auto stream = std::make_shared<std::string>(make_fix_stream('\x01'));
+        auto parser = std::make_shared<parser::SIMDFixParser>();
+        auto ticks = std::make_shared<std::vector<common::Tick>>();
+        ticks->reserve(BATCH_MESSAGES);
+        harness.add({"simd_parser.messages", BATCH_MESSAGES, [stream, parser, ticks] {
+            ticks->clear();
+            parser->reset();
+            sink = static_cast<int64_t>(parser->parse(stream->data(), stream->size(), *ticks));
+        }});
+    }
+    {
+        auto trades = std::make_shared<std::vector<std::string>>(make_trades());
+        auto parser = std::make_shared<parser::TradeJsonParser>();
+        harness.add({"trade_json_parser.trades", BATCH_MESSAGES, [trades, parser] {
+            common::Tick tick;
+            int64_t total = 0;
+            for (const std::string& trade : *trades) {
+                total += parser->parse(trade, tick, 1) ? tick.price : 0;
+            }
+            sink = total;
+        }});
+    }
+    auto prices = std::make_shared<std::vector<std::string>>(make_prices());
+    harness.add({"fast_number_parser.prices", BATCH_VALUES, [prices] {
+        int64_t total = 0;
+        for (const std::string& price : *prices) {
+            total += parser::FastNumberParser::fast_atof_fixed(price);
+        }
+        sink = total;
+    }});
+    harness.add({"fast_number_parser.strict_prices", BATCH_VALUES, [prices] {
+        int64_t total = 0;
+        for (const std::string& price : *prices) {
+            int64_t value = 0;
+            total += parser::FastNumberParser::parse_fixed_strict(price, 10000, value) ? value : -1;
+        }
+        sink = total;
+    }});
+    {
+        auto pool = std::make_shared<common::TickPool>(BATCH_VALUES);
+        harness.add({"tick_pool.acquire", BATCH_VALUES, [pool] {
+            for (size_t i = 0; i < BATCH_VALUES; ++i) {
+                pool->acquire()->price = static_cast<int64_t>(i);
+            }
+            sink = static_cast<int64_t>(pool->size());
+            pool->reset();
+        }});
+    }
+    {
+        auto allocator = std::make_shared<common::ZeroLatencyAllocator>(1 << 20, false, true);
+        harness.add({"zero_latency_allocator.allocate", BATCH_VALUES, [allocator] {
+            uintptr_t last = 0;
+            for (size_t i = 0; i < BATCH_VALUES; ++i) {
+                last = reinterpret_cast<uintptr_t>(allocator->allocate(64, 64));
+            }
+            sink = static_cast<int64_t>(last);
+            allocator->reset();
+        }});
+    }
+}
+
+const char* status_name(PerfComparison::Status status) {
+    switch (status) {
+        case PerfComparison::Status::OK: return "ok";
+        case PerfComparison::Status::IMPROVED: return "improved";
+        case PerfComparison::Status::REGRESSED: return "REGRESSED";
+        case PerfComparison::Status::MISSING: return "MISSING";
+    }
+    return "?";
+}
+
+int usage(const char* program) {
+    std::cerr << "usage: " << program
+              << " [--baseline FILE] [--update-baseline] [--json FILE] [--cpu N]"
+                 " [--filter TEXT] [--tolerance X] [--quick]" << std::endl;
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string baseline = "benchmarks/perf_baseline.txt";
+    std::string json;
+    std::string filter;
+    bool update = false;
+    double tolerance = 0.25;
+    PerfHarness::Config config;
+    config.cpu = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--baseline" && has_value) {
+            baseline = argv[++i];
+        } else if (arg == "--update-baseline") {
+            update = true;
+        } else if (arg == "--json" && has_value) {
+            json = argv[++i];
+        } else if (arg == "--cpu" && has_value) {
+            config.cpu = std::atoi(argv[++i]);
+        } else if (arg == "--filter" && has_value) {
+            filter = argv[++i];
+        } else if (arg == "--tolerance" && has_value) {
+            tolerance = std::atof(argv[++i]);
+        } else if (arg == "--quick") {
+            config.repetitions = 3;
+            config.min_repetition_ns = 10000000;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    PerfHarness harness(config);
+    add_scenarios(harness);
+    std::vector<benchmarks::PerfResult> results = harness.run(filter);
+
+    for (const benchmarks::PerfResult& result : results) {
+        std::printf("%-34s %10.2f ns/op  p99 %9.2f ns  spread %5.1f%%", result.name.c_str(), result.ns_per_op,
+                    result.p99_ns, result.spread * 100.0);
+        if (result.counters) {
+            std::printf("  ipc %4.2f  %8.1f instr/op", result.ipc, result.instructions_per_op);
+        }
+        std::printf("\n");
+    }
+
+    if (!json.empty()) {
+        std::ofstream out(json);
+        harness.write_json(out, results);
+        if (!out) {
+            std::cerr << "Cannot write " << json << std::endl;
+            return 2;
+        }
+    }
+
+    if (update) {
+        if (!PerfHarness::save_baseline(baseline, results, {"ns_per_op", "instructions_per_op"}, tolerance)) {
+            return 2;
+        }
+        std::printf("Baseline written to %s\n", baseline.c_str());
+        return 0;
+    }
+
+    std::vector<benchmarks::PerfExpectation> expectations;
+    if (!PerfHarness::load_baseline(baseline, expectations)) {
+        return 2;
+    }
+    bool failed = false;
+    for (const PerfComparison& comparison : PerfHarness::compare(results, expectations)) {
+        if (!filter.empty() && comparison.scenario.find(filter) == std::string::npos) {
+            continue;  // Not run
+        }
+        std::printf("%-9s %-34s %-20s baseline %10.2f  measured %10.2f  %+6.1f%% (tolerance %.0f%%)\n",
+                    status_name(comparison.status), comparison.scenario.c_str(), comparison.metric.c_str(),
+                    comparison.baseline, comparison.measured, comparison.change * 100.0, comparison.tolerance * 100.0);
+        failed |= comparison.status == PerfComparison::Status::REGRESSED ||
+                  comparison.status == PerfComparison::Status::MISSING;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "analytics/rolling_window.hpp"
+#include "common/compact_tick.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace feedhandler {
+namespace analytics {
+
+/**
+ * @brief One OHLCV bar of an instrument (fixed-point prices)
+ */
+struct Bar {
+    int64_t open = 0;
+    int64_t high = 0;
+    int64_t low = 0;
+    int64_t close = 0;
+    __int128 notional = 0;       ///< Sum of price * qty (exact, for VWAP)
+    int64_t volume = 0;
+    uint64_t start_ns = 0;       ///< Bucket start (time bars) or first tick (volume bars)
+    uint64_t end_ns = 0;         ///< Last tick
+    common::InstrumentId instrument_id = common::INVALID_INSTRUMENT;
+    uint32_t tick_count = 0;
+
+    bool empty() const { return tick_count == 0; }
+
+    /**
+     * @brief Volume-weighted average price in price units (0 if empty)
+     */
+    double vwap() const {
+        return volume > 0 ? static_cast<double>(notional) / static_cast<double>(volume) / 10000.0 : 0.0;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<Bar>, "Bars are published as flat arrays");
+
+/**
+ * @brief Streaming OHLCV bar builder for many instruments
+ *
+ * Open bars live in a flat array indexed by instrument ID. Time bars
+ * cover aligned buckets [k * interval, (k + 1) * interval) of tick time
+ * and close when a tick lands in a later bucket, or from close_expired()
+ * for instruments that went quiet. Volume bars close on the tick that
+ * brings them to volume_per_bar.
+ *
+ * Closed bars are collected into a batch that is handed to the callback
+ * once batch_size bars are waiting, or on flush(). Consumers that need
+ * each bar as it closes (e.g. range estimators) use the bar returned by
+ * push() and the close_expired() visitor instead.
+ *
+ * Single-threaded: one aggregator per thread that owns its instruments.
+ */
+class BarAggregator {
+public:
+    enum class BarType {
+        TIME,    ///< Close every interval_ns of tick time
+        VOLUME   ///< Close every volume_per_bar traded
+    };
+
+    struct Config {
+        BarType type = BarType::TIME;
+        uint64_t interval_ns = 1000000000ULL;  // Time bars: 1s
+        int64_t volume_per_bar = 10000;        // Volume bars
+        size_t batch_size = 64;                // Closed bars per callback
+    };
+
+    using BarCallback = std::function<void(const Bar* bars, size_t count)>;
+
+    BarAggregator() : BarAggregator(Config()) {}
+
+    explicit BarAggregator(const Config& config, BarCallback callback = nullptr)
+        : config_(config)
+        , callback_(std::move(callback)) {
+        if (config_.interval_ns == 0) {
+            config_.interval_ns = 1;
+        }
+        if (config_.volume_per_bar <= 0) {
+            config_.volume_per_bar = 1;
+        }
+        closed_.reserve(config_.batch_size > 0 ? config_.batch_size : 1);
+    }
+
+    void set_callback(BarCallback callback) { callback_ = std::move(callback); }
+
+    const Config& config() const { return config_; }
+
+    /**
+     * @brief Add a tick to its instrument's open bar
+     * @return The bar this tick closed (valid until the next call), or nullptr
+     */
+    const Bar* push(const common::CompactTick& tick) {
+        if (tick.instrument_id == common::INVALID_INSTRUMENT || tick.price <= 0 || tick.qty <= 0) {
+            return nullptr;
+        }
+        if (tick.instrument_id >= open_.size()) {
+            open_.resize(static_cast<size_t>(tick.instrument_id) + 1);
+        }
+        Bar& bar = open_[tick.instrument_id];
+        const Bar* closed = nullptr;
+
+        if (config_.type == BarType::TIME) {
+            uint64_t bucket = tick.timestamp - tick.timestamp % config_.interval_ns;
+            if (!bar.empty() && bucket > bar.start_ns) {
+                closed = close(bar);  // Late ticks (earlier bucket) join the open bar
+            }
+            if (bar.empty()) {
+                start(bar, tick, bucket);
+            }
+        } else if (bar.empty()) {
+            start(bar, tick, tick.timestamp);
+        }
+
+        bar.high = std::max(bar.high, tick.price);
+        bar.low = std::min(bar.low, tick.price);
+        bar.close = tick.price;
+        bar.notional += static_cast<__int128>(tick.price) * tick.qty;
+        bar.volume += tick.qty;
+        bar.end_ns = std::max(bar.end_ns, tick.timestamp);
+        ++bar.tick_count;
+
+        if (config_.type == BarType::VOLUME && bar.volume >= config_.volume_per_bar) {
+            closed = close(bar);
+        }
+        return closed;
+    }
+
+    /**
+     * @brief Close time bars whose bucket ended at or before now_ns
+     * @param on_close Called with each bar as it closes
+     * @return Bars closed
+     */
+    template<typename OnClose>
+    size_t close_expired(uint64_t now_ns, OnClose&& on_close) {
+        if (config_.type != BarType::TIME) {
+            return 0;
+        }
+        size_t count = 0;
+        for (common::InstrumentId id : seen_) {
+            Bar& bar = open_[id];
+            if (!bar.empty() && bar.start_ns + config_.interval_ns <= now_ns) {
+                on_close(*close(bar));
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    size_t close_expired(uint64_t now_ns) {
+        return close_expired(now_ns, [](const Bar&) {});
+    }
+
+    /**
+     * @brief Hand any waiting closed bars to the callback
+     */
+    void flush() {
+        if (!closed_.empty() && callback_) {
+            callback_(closed_.data(), closed_.size());
+        }
+        closed_.clear();
+    }
+
+    /**
+     * @brief Open bar of an instrument (empty if none)
+     */
+    const Bar& current(common::InstrumentId id) const {
+        static const Bar none{};
+        return id < open_.size() ? open_[id] : none;
+    }
+
+    size_t pending() const { return closed_.size(); }
+    uint64_t bars_closed() const { return bars_closed_; }
+
+private:
+    void start(Bar& bar, const common::CompactTick& tick, uint64_t start_ns) {
+        if (bar.instrument_id == common::INVALID_INSTRUMENT) {
+            seen_.push_back(tick.instrument_id);
+        }
+        bar = Bar{};
+        bar.instrument_id = tick.instrument_id;
+        bar.open = bar.high = bar.low = tick.price;
+        bar.start_ns = start_ns;
+    }
+
+    const Bar* close(Bar& bar) {
+        last_closed_ = bar;
+        common::InstrumentId id = bar.instrument_id;
+        bar = Bar{};
+        bar.instrument_id = id;  // Still seen; only the contents reset
+        ++bars_closed_;
+
+        closed_.push_back(last_closed_);
+        if (closed_.size() >= config_.batch_size) {
+            flush();
+        }
+        return &last_closed_;
+    }
+
+    Config config_;
+    BarCallback callback_;
+    std::vector<Bar> open_;                   // Open bar per instrument ID
+    std::vector<common::InstrumentId> seen_;  // IDs with a slot in use, for close_expired()
+    std::vector<Bar> closed_;                 // Batch awaiting the callback
+    Bar last_closed_;
+    uint64_t bars_closed_ = 0;
+};
+
+/**
+ * @brief Range volatility estimators over the last N closed bars
+ *
+ * Keeps each bar's Parkinson term ln(H/L)^2 / (4 ln 2) and Garman-Klass
+ * term 0.5 ln(H/L)^2 - (2 ln 2 - 1) ln(C/O)^2 with running sums, so the
+ * estimators (square roots of the mean terms) are O(1) per bar. Values
+ * are per-bar volatilities, not annualized.
+ */
+class BarVolatility {
+public:
+    /**
+     * @param capacity Bars averaged (0 is treated as 1)
+     */
+    explicit BarVolatility(size_t capacity) : terms_(capacity) {}
+
+    void add(const Bar& bar) {
+        if (bar.empty() || bar.low <= 0 || bar.open <= 0) {
+            return;
+        }
+        double range = std::log(static_cast<double>(bar.high) / static_cast<double>(bar.low));
+        double body = std::log(static_cast<double>(bar.close) / static_cast<double>(bar.open));
+        Terms terms{range * range / (4.0 * std::log(2.0)),
+                    0.5 * range * range - (2.0 * std::log(2.0) - 1.0) * body * body};
+        if (terms_.full()) {
+            parkinson_sum_ -= terms_.front().parkinson;
+            garman_klass_sum_ -= terms_.front().garman_klass;
+        }
+        terms_.push_back(terms);
+        parkinson_sum_ += terms.parkinson;
+        garman_klass_sum_ += terms.garman_klass;
+    }
+
+    size_t size() const { return terms_.size(); }
+
+    double parkinson() const {
+        return terms_.empty() ? 0.0 : std::sqrt(std::max(parkinson_sum_, 0.0) / static_cast<double>(terms_.size()));
+    }
+
+    double garman_klass() const {
+        return terms_.empty() ? 0.0 : std::sqrt(std::max(garman_klass_sum_, 0.0) / static_cast<double>(terms_.size()));
+    }
+
+    void clear() {
+        terms_.clear();
+        parkinson_sum_ = 0.0;
+        garman_klass_sum_ = 0.0;
+    }
+
+private:
+    struct Terms {
+        double parkinson;
+        double garman_klass;
+    };
+
+    HistoryRing<Terms> terms_;
+    double parkinson_sum_ = 0.0;
+    double garman_klass_sum_ = 0.0;
+};
+
+} // namespace analytics
+} // namespace feedhandler
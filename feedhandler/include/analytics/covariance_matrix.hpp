@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace feedhandler {
+namespace analytics {
+
+/**
+ * @brief Rolling covariance/correlation matrix over aligned return rows
+ *
+ * Each push() appends one row holding every column's return for the same
+ * sampling epoch, and evicts the oldest row once window() rows are held.
+ * The matrix keeps the column sums and the full (symmetric) cross-product
+ * matrix, so a push is one rank-2 update (add the new row's outer
+ * product, subtract the evicted one's) instead of recomputing every pair
+ * from the series. Rows are stored structure-of-arrays style (one
+ * contiguous row per epoch, padded to a multiple of 4 doubles) so the
+ * update streams through memory and vectorizes; an AVX2/FMA kernel is
+ * picked at runtime when the CPU has it.
+ *
+ * Removing rows from running sums drifts, so the sums are rebuilt from
+ * the stored rows once every window() evictions (amortized one extra
+ * update per push).
+ *
+ * Columns are dense indices chosen by the caller; the active width given
+ * to push() may grow over time (new columns read as zero returns for the
+ * rows before they joined). Not thread-safe.
+ */
+class CovarianceMatrix {
+public:
+    /**
+     * @param max_columns Largest number of columns (memory is max_columns^2 doubles)
+     * @param window Rows kept (0 is treated as 1)
+     */
+    CovarianceMatrix(size_t max_columns, size_t window);
+
+    size_t max_columns() const { return max_columns_; }
+    size_t window() const { return window_; }
+    size_t columns() const { return columns_; }
+    size_t samples() const { return count_; }
+
+    /**
+     * @brief Append one aligned row of returns
+     * @param values Returns for columns 0 .. columns-1 (later columns read as 0)
+     * @param columns Values passed; the active width grows to it but never shrinks
+     */
+    void push(const double* values, size_t columns);
+
+    /**
+     * @brief Sample covariance of columns i and j (0 with fewer than 2 rows)
+     */
+    double covariance(size_t i, size_t j) const;
+
+    /**
+     * @brief Pearson correlation of columns i and j, 0 if either is constant
+     */
+    double correlation(size_t i, size_t j) const;
+
+    /**
+     * @brief Beta of column i to the equal-weighted average of all columns
+     */
+    double beta(size_t i) const;
+
+    /**
+     * @brief Correlations of column i with every column (out needs columns() slots)
+     */
+    void correlation_row(size_t i, double* out) const;
+
+    void clear();
+
+private:
+    void rebuild();
+
+    size_t max_columns_;
+    size_t stride_;                       // Row length, padded for the vector kernel
+    size_t window_;
+    std::vector<double> rows_;            // window_ rows of stride_ values, ring ordered from head_
+    std::vector<double> sums_;            // S_i
+    std::vector<double> cross_;           // S_ij, max_columns_ rows of stride_
+    std::vector<double> cross_row_sums_;  // sum_j S_ij, for beta()
+    std::vector<double> incoming_;        // push() row padded to stride_
+    double sum_total_ = 0.0;              // sum_i S_i
+    double cross_total_ = 0.0;            // sum_ij S_ij
+    size_t head_ = 0;                     // Oldest row
+    size_t count_ = 0;
+    size_t columns_ = 0;
+    size_t evictions_ = 0;                // Since the last rebuild
+};
+
+} // namespace analytics
+} // namespace feedhandler
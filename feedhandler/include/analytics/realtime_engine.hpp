@@ -1,12 +1,26 @@
 #pragma once
 
+#include <array>
+#include <span>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <functional>
 #include <atomic>
 #include <thread>
+#include <type_traits>
+#include "common/quantile_sketch.hpp"
+#include "common/stat_counter.hpp"
 #include "common/tick.hpp"
+#include "common/tick_batch.hpp"
+#include "analytics/bar_aggregator.hpp"
+#include "analytics/covariance_matrix.hpp"
+#include "analytics/rolling_quantile.hpp"
+#include "analytics/rolling_window.hpp"
+#include "threading/seqlock.hpp"
+#include "threading/spsc_ring.hpp"
 
 namespace feedhandler {
 namespace analytics {
@@ -25,23 +39,70 @@ namespace analytics {
  * - Liquidity analysis
  * - Cross-asset correlation monitoring
  * - Regime change detection
+ * 
+ * Each symbol keeps its last history_depth ticks in a RollingTickWindow,
+ * which maintains VWAP, TWAP, volatility and order flow incrementally,
+ * so a tick costs O(1) however deep the history is. Median trade size
+ * and the spread quantile come from RollingQuantile windows (O(log n)
+ * per tick) and calculation-time percentiles from a LatencySketch, so
+ * per-symbol memory stays fixed however long the session runs.
+ *
+ * Symbols are keyed by their SymbolTable::global() instrument ID and
+ * partitioned across the workers (worker_for()). While running, the
+ * feed thread only pushes CompactTicks into the owning worker's SPSC
+ * ring; each worker applies its own symbols' ticks and samples their
+ * returns, so no lock is shared between symbols. Before start() and
+ * after stop() ticks are applied on the calling thread.
+ *
+ * Cross-asset statistics come from one CovarianceMatrix whose columns
+ * are the first correlation_symbols symbols (in creation order). On each
+ * tick of the sampling clock every worker writes its symbols' returns
+ * into a shared row; the last one to finish pushes it into the matrix.
+ *
+ * Each worker also runs a BarAggregator over its symbols. The range
+ * estimators (Parkinson, Garman-Klass) average the last bar_history
+ * closed bars rather than the raw tick window, and closed bars are
+ * published in batches to the bar callback.
+ *
+ * The owning worker publishes each symbol's MarketMetrics (a flat,
+ * trivially copyable record) through a seqlock, so get_metrics() never
+ * takes a lock and never allocates; pairwise correlations are read from
+ * the matrix through correlation() / correlations().
  */
 class RealtimeEngine {
 public:
     struct Config {
         size_t max_symbols = 10000;
         size_t history_depth = 100000;     // Ticks to keep in memory
+        size_t quantile_window = 1024;     // Trades / quotes behind the median trade size and spread quantile
+        double spread_quantile = 0.9;
         double update_frequency_hz = 1000000; // 1MHz update rate
         bool enable_cross_asset_analysis = true;
         bool enable_regime_detection = true;
         size_t worker_threads = 8;
+        size_t queue_capacity = 65536;          // Per-worker tick ring
+        size_t correlation_window = 256;        // Sampled returns per symbol for correlations
+        size_t correlation_symbols = 1024;      // Matrix columns (memory grows with the square)
+        double correlation_interval_ms = 100.0; // Return sampling period while running
+        
+        // Bars behind the range estimators (disabled: use the tick window)
+        bool enable_bars = true;
+        BarAggregator::Config bars;
+        size_t bar_history = 64;                // Closed bars per symbol
+        
+        // Alert thresholds (severity = value / threshold)
+        double spread_alert_bps = 50.0;
+        double volatility_alert = 0.01;         // Per-tick realized volatility
+        double flow_alert_imbalance = 0.8;      // |order_flow_imbalance|
     };
     
     struct MarketMetrics {
+        common::InstrumentId instrument_id = common::INVALID_INSTRUMENT;
+        
         // Price metrics
         double vwap;                    // Volume-weighted average price
         double twap;                    // Time-weighted average price
-        double microprice;              // Bid-ask midpoint
+        double microprice;              // Size-weighted bid-ask midpoint
         double spread_bps;              // Bid-ask spread in basis points
         
         // Volume metrics
@@ -54,6 +115,8 @@ public:
         double ask_depth;               // Total ask liquidity
         double liquidity_imbalance;    // (bid_depth - ask_depth) / total
         double effective_spread;        // Realized transaction costs
+        double median_trade_size;       // Over the last quantile_window ticks
+        double spread_quantile_bps;     // Config::spread_quantile of the last quantile_window quoted spreads
         
         // Volatility metrics
         double realized_volatility;     // Recent price volatility
@@ -65,13 +128,23 @@ public:
         double price_impact;            // Market impact per unit volume
         double resilience;              // Speed of spread recovery
         
-        // Cross-asset metrics
-        std::unordered_map<std::string, double> correlations;
+        // Cross-asset metrics (pairwise correlations: see correlations())
         double beta_to_market;          // Systematic risk measure
         
         // Timing
         uint64_t last_update_ns;
         uint64_t calculation_time_ns;
+        uint64_t calculation_time_p99_ns;  // Estimated over the symbol's lifetime
+    };
+    
+    static_assert(std::is_trivially_copyable_v<MarketMetrics>, "MarketMetrics is published through a seqlock");
+    
+    /**
+     * @brief One entry of an instrument's correlation row
+     */
+    struct Correlation {
+        common::InstrumentId instrument_id;
+        double correlation;
     };
     
     using MetricsCallback = std::function<void(const std::string& symbol, 
@@ -79,8 +152,10 @@ public:
     using AlertCallback = std::function<void(const std::string& symbol,
                                            const std::string& alert_type,
                                            double severity)>;
+    using BarCallback = BarAggregator::BarCallback;
     
-    RealtimeEngine(const Config& config = {});
+    RealtimeEngine();
+    explicit RealtimeEngine(const Config& config);
     ~RealtimeEngine();
     
     /**
@@ -90,6 +165,20 @@ public:
      */
     void process_tick(const std::string& symbol, const common::Tick& tick);
     
+    /**
+     * @brief Process new market tick keyed by its instrument ID
+     * @param tick Market data tick (instrument_id from SymbolTable::global())
+     * @note While running, call from a single feed thread (the worker
+     *       rings are single-producer)
+     */
+    void process_tick(const common::CompactTick& tick);
+    
+    /**
+     * @brief Process every row of a batch, in order, as process_tick()
+     * @note Threading as for process_tick(const common::CompactTick&)
+     */
+    void process_batch(const common::TickBatch& batch);
+    
     /**
      * @brief Get current metrics for symbol
      * @param symbol Instrument symbol
@@ -97,6 +186,37 @@ public:
      */
     MarketMetrics get_metrics(const std::string& symbol) const;
     
+    /**
+     * @brief Get current metrics by instrument ID
+     * @note Lock-free; beta_to_market is the latest committed estimate
+     *       (the metrics callback sees the value as of the tick)
+     */
+    MarketMetrics get_metrics(common::InstrumentId id) const;
+    
+    /**
+     * @brief Append the current metrics of every symbol, in creation order
+     * @return Records appended
+     */
+    size_t get_all_metrics(std::vector<MarketMetrics>& out) const;
+    
+    /**
+     * @brief Correlation of two instruments' sampled returns
+     * @return Pearson correlation, 0 if either is unknown or outside the matrix
+     */
+    double correlation(common::InstrumentId a, common::InstrumentId b) const;
+    
+    /**
+     * @brief Replace out with the instrument's correlations to every other
+     *        symbol in the matrix
+     * @return Entries written (0 before two samples were committed)
+     */
+    size_t correlations(common::InstrumentId id, std::vector<Correlation>& out) const;
+    
+    /**
+     * @brief Worker that owns an instrument
+     */
+    size_t worker_for(common::InstrumentId id) const { return id % worker_count_; }
+    
     /**
      * @brief Register callback for metrics updates
      * @param callback Metrics update callback
@@ -109,13 +229,28 @@ public:
      */
     void register_alert_callback(AlertCallback callback);
     
+    /**
+     * @brief Register callback for batches of closed bars
+     * @param callback Bar callback (called from the worker owning the bars)
+     */
+    void register_bar_callback(BarCallback callback);
+    
+    /**
+     * @brief Publish closed bars still waiting for a full batch
+     * @note Only while stopped; running workers flush on every bar interval
+     */
+    void flush_bars();
+    
     /**
      * @brief Start real-time processing
+     * @note Register callbacks first; while running they are called
+     *       from the worker that owns the symbol
      */
     void start();
     
     /**
      * @brief Stop real-time processing
+     * @note Ticks already queued are applied before the workers exit
      */
     void stop();
     
@@ -126,6 +261,7 @@ public:
         uint64_t ticks_processed;
         uint64_t metrics_calculated;
         uint64_t alerts_generated;
+        uint64_t backpressure_waits;   // Pushes that found a worker ring full
         double processing_rate_hz;
         double average_latency_ns;
         double cpu_utilization;
@@ -137,66 +273,133 @@ public:
 private:
     Config config_;
     
-    // Symbol data storage
+    // Best bid/ask after a tick
+    struct QuoteRecord {
+        int64_t bid_price;
+        int64_t ask_price;
+        uint64_t timestamp;
+    };
+    
+    // Symbol data storage (written only by the owning worker, so no lock)
     struct SymbolData {
-        std::vector<common::Tick> tick_history;
-        MarketMetrics current_metrics;
-        std::atomic<uint64_t> last_update;
-        
-        // Rolling calculations
-        double price_sum;
-        double volume_sum;
-        uint64_t tick_count;
+        SymbolData(common::InstrumentId id, size_t index, std::string_view symbol, const Config& config)
+            : id(id), index(index), symbol(symbol), window(config.history_depth), quotes(config.history_depth),
+              bar_volatility(config.bar_history), trade_sizes(config.quantile_window, 0.5),
+              spreads(config.quantile_window, config.spread_quantile) {}
         
-        // Volatility calculation state
-        std::vector<double> price_returns;
-        double sum_squared_returns;
+        const common::InstrumentId id;
+        const size_t index;                 // Creation order; also the correlation matrix column
+        const std::string symbol;
+        RollingTickWindow window;           // Recent ticks with incremental statistics
+        HistoryRing<QuoteRecord> quotes;    // Liquidity history
+        BarVolatility bar_volatility;       // Range estimators over closed bars
+        RollingQuantile<int64_t> trade_sizes;
+        RollingQuantile<double> spreads;    // Quoted spread, bps
+        common::LatencySketch calculation_time;
+        MarketMetrics current_metrics{};    // Owner's working copy
+        threading::Seqlock<MarketMetrics> published;  // What readers see
         
-        // Order flow tracking
-        double buy_volume;
-        double sell_volume;
-        std::vector<double> trade_sizes;
+        // Latest quote (a 'B' tick updates the bid, 'S' the ask)
+        int64_t bid_price = 0;
+        int64_t bid_qty = 0;
+        int64_t ask_price = 0;
+        int64_t ask_qty = 0;
+        double quoted_spread_sum = 0.0;     // Sum of spread_bps over quotes with both sides
+        uint64_t quoted_spread_count = 0;
+        uint64_t total_volume = 0;
         
-        // Liquidity tracking
-        std::vector<std::pair<double, double>> bid_ask_history;
+        double last_sampled_price = 0.0;    // Price at the previous sampling epoch
     };
     
-    std::unordered_map<std::string, std::unique_ptr<SymbolData>> symbol_data_;
-    mutable std::shared_mutex data_mutex_;
+    // Per-worker state; owned is only touched by the worker (or by the
+    // calling thread while stopped)
+    struct Worker {
+        std::unique_ptr<threading::SpscRing<common::CompactTick>> ring;
+        std::vector<std::unique_ptr<SymbolData>> owned;
+        uint64_t sampled_epoch = 0;
+        BarAggregator bars;                 // Open bars of the owned symbols
+        uint64_t next_bar_check = 0;        // Tick time of the next expiry scan
+    };
+    
+    size_t worker_count_;
+    std::vector<Worker> workers_;
+    
+    // Symbols in creation order, and the same objects indexed by instrument
+    // ID; slots are published once with a release store and never change
+    std::unique_ptr<std::atomic<SymbolData*>[]> symbols_;
+    std::unique_ptr<std::atomic<SymbolData*>[]> symbols_by_id_;
+    size_t id_capacity_;
+    std::atomic<size_t> symbol_count_{0};
     
     // Processing threads
     std::vector<std::thread> worker_threads_;
     std::atomic<bool> running_;
+    std::atomic<uint64_t> sample_epoch_{0};  // Common sampling clock, advanced by worker 0
     
-    // Callbacks
+    // Cross-asset statistics: workers fill their columns of pending_returns_
+    // for the current epoch, the last of them commits the row
+    CovarianceMatrix correlation_matrix_;
+    mutable std::mutex matrix_mutex_;        // Committing worker vs. readers
+    std::vector<double> pending_returns_;
+    std::unique_ptr<std::atomic<double>[]> betas_;  // Per column, refreshed on commit
+    std::atomic<size_t> samplers_pending_{0};
+    
+    // Callbacks (register before start(); called without any engine lock held)
     MetricsCallback metrics_callback_;
     AlertCallback alert_callback_;
+    BarCallback bar_callback_;
     
-    // Performance tracking
+    // Performance tracking: every worker counts into its own cache lines
     mutable EngineStats engine_stats_;
-    std::atomic<uint64_t> processed_ticks_;
+    common::StatCounter processed_ticks_;
+    common::StatCounter metrics_calculated_;
+    common::StatCounter alerts_generated_;
+    common::StatCounter latency_sum_ns_;
+    std::atomic<uint64_t> market_volume_{0};  // Read back by every metrics pass, so one word
+    common::StatCounter symbols_rejected_;    // Ticks for new symbols beyond max_symbols
+    common::StatCounter backpressure_waits_;
+    uint64_t created_ns_;
+    
+    struct PendingAlert {
+        const char* type;
+        double severity;
+    };
+    static constexpr size_t MAX_ALERTS = 3;
+    static constexpr size_t MAX_BATCH = 256;
     
     // Processing methods
     void worker_loop(int worker_id);
-    void calculate_metrics(const std::string& symbol, SymbolData& data);
-    void update_vwap(SymbolData& data, const common::Tick& tick);
-    void update_volatility(SymbolData& data, const common::Tick& tick);
-    void update_liquidity_metrics(SymbolData& data, const common::Tick& tick);
-    void update_order_flow(SymbolData& data, const common::Tick& tick);
-    void detect_anomalies(const std::string& symbol, const SymbolData& data);
+    void apply_tick(const common::CompactTick& tick);
+    SymbolData* find(common::InstrumentId id) const;
+    SymbolData* find_or_create(common::InstrumentId id);
+    void advance_bars(Worker& worker, uint64_t timestamp);
+    double beta_for(const SymbolData& data) const;
+    void calculate_metrics(SymbolData& data);
+    void update_liquidity_metrics(SymbolData& data, const common::CompactTick& tick);
+    size_t detect_anomalies(const MarketMetrics& metrics, PendingAlert* alerts) const;
     
     // Cross-asset analysis
-    void update_correlations();
-    double calculate_correlation(const std::string& symbol1, const std::string& symbol2);
-    
-    // Alert generation
-    void check_liquidity_alerts(const std::string& symbol, const MarketMetrics& metrics);
-    void check_volatility_alerts(const std::string& symbol, const MarketMetrics& metrics);
-    void check_flow_alerts(const std::string& symbol, const MarketMetrics& metrics);
+    void sample_returns(Worker& worker, uint64_t epoch);
+    void commit_returns();
 };
 
 /**
  * @brief Advanced pattern recognition engine
+ *
+ * Runs over MarketMetrics records (one instrument at a time or a whole
+ * get_all_metrics() snapshot) and keeps per-instrument baselines (EWMA of
+ * volume rate, spread and volatility) in a flat array indexed by
+ * instrument ID. Each detector starts with a threshold comparison on
+ * values already in the record and gives up there when the pattern
+ * cannot fire, which is nearly always, so a quiet update costs a few
+ * compares and no allocation. Pattern records are trivially copyable.
+ *
+ * With breakout_channel set, a momentum breakout must also take the
+ * microprice outside the channel of the previous updates, tracked per
+ * instrument by a SlidingMax / SlidingMin in O(1) per update.
+ *
+ * CROSS_ASSET_ARBITRAGE is not detected here; it needs pairwise data
+ * (RealtimeEngine::correlations()). Single-threaded.
  */
 class PatternEngine {
 public:
@@ -208,47 +411,115 @@ public:
         CROSS_ASSET_ARBITRAGE,
         REGIME_CHANGE
     };
+    static constexpr size_t PATTERN_TYPES = 6;
+    
+    static constexpr size_t MAX_PARAMETERS = 3;
     
     struct Pattern {
         PatternType type;
-        std::string symbol;
-        double confidence;
-        uint64_t detection_time;
-        std::vector<double> parameters;
-        std::string description;
+        common::InstrumentId instrument_id;
+        double confidence;              // 0 .. 1
+        uint64_t detection_time;        // metrics.last_update_ns
+        std::array<double, MAX_PARAMETERS> parameters;  // Detector-specific, see describe()
+        const char* description;        // Static string
     };
     
+    static_assert(std::is_trivially_copyable_v<Pattern>, "Patterns are copied into flat buffers");
+    
+    struct Config {
+        // Price patterns: microprice away from VWAP
+        double breakout_bps = 20.0;         // Minimum |microprice - vwap| / vwap
+        double breakout_flow = 0.5;         // Momentum: |order flow imbalance| in the same direction
+        double reversion_max_volatility = 0.002; // Mean reversion: only in calm markets
+        size_t breakout_channel = 0;        // Momentum: microprice must also clear the high/low of
+                                            // the previous N updates (0 = no channel)
+        
+        // Baseline-relative patterns (current value / EWMA)
+        double volume_spike_ratio = 3.0;
+        double drought_spread_ratio = 3.0;
+        double regime_volatility_ratio = 2.5;
+        double baseline_alpha = 0.05;       // EWMA weight of each update
+        uint32_t warmup_updates = 20;       // Updates before baselines are trusted
+        
+        uint64_t cooldown_ns = 1000000000ULL; // Per instrument and pattern type
+    };
+    
+    /**
+     * @brief Upper bound on patterns one metrics update can produce
+     */
+    static constexpr size_t MAX_PATTERNS_PER_UPDATE = 4;
+    
     using PatternCallback = std::function<void(const Pattern& pattern)>;
     
     PatternEngine();
+    explicit PatternEngine(const Config& config);
     
     /**
-     * @brief Analyze tick for patterns
-     * @param symbol Instrument symbol
-     * @param tick Market data tick
-     * @param metrics Current market metrics
-     * @return Detected patterns
+     * @brief Analyze one instrument's metrics update
+     * @param metrics Current market metrics (instrument_id must be set)
+     * @param out Receives detected patterns
+     * @param capacity Slots in out (MAX_PATTERNS_PER_UPDATE is always enough)
+     * @return Patterns written
      */
-    std::vector<Pattern> analyze_patterns(const std::string& symbol,
-                                        const common::Tick& tick,
-                                        const RealtimeEngine::MarketMetrics& metrics);
+    size_t analyze_patterns(const RealtimeEngine::MarketMetrics& metrics, Pattern* out, size_t capacity);
+    
+    /**
+     * @brief Analyze many instruments' metrics at once
+     * @param out Detected patterns are appended
+     * @return Patterns appended
+     */
+    size_t analyze_batch(std::span<const RealtimeEngine::MarketMetrics> metrics, std::vector<Pattern>& out);
     
     /**
      * @brief Register pattern detection callback
      * @param callback Pattern callback
      */
     void register_pattern_callback(PatternCallback callback);
+    
+    /**
+     * @brief Detector evaluations that passed their pre-filter
+     */
+    uint64_t detector_runs() const { return detector_runs_; }
+    
+    /**
+     * @brief Detector evaluations rejected by the pre-filter
+     */
+    uint64_t prefilter_skips() const { return prefilter_skips_; }
+    
+    uint64_t patterns_detected() const { return patterns_detected_; }
 
 private:
+    struct InstrumentState {
+        explicit InstrumentState(size_t channel) : channel_high(channel), channel_low(channel) {}
+        
+        double volume_rate = 0.0;       // EWMA baselines
+        double spread_bps = 0.0;
+        double volatility = 0.0;
+        uint32_t updates = 0;
+        std::array<uint64_t, PATTERN_TYPES> last_fired{};  // detection_time, 0 = never
+        SlidingMax<double> channel_high;  // Microprice over the last breakout_channel updates
+        SlidingMin<double> channel_low;
+    };
+    
+    Config config_;
     PatternCallback pattern_callback_;
+    std::vector<InstrumentState> states_;  // By instrument ID
+    uint64_t detector_runs_ = 0;
+    uint64_t prefilter_skips_ = 0;
+    uint64_t patterns_detected_ = 0;
     
-    // Pattern detection methods
-    std::vector<Pattern> detect_momentum_patterns(const std::string& symbol,
-                                                 const RealtimeEngine::MarketMetrics& metrics);
-    std::vector<Pattern> detect_volume_patterns(const std::string& symbol,
-                                               const common::Tick& tick);
-    std::vector<Pattern> detect_liquidity_patterns(const std::string& symbol,
-                                                   const RealtimeEngine::MarketMetrics& metrics);
+    // Pattern detection methods: each returns patterns written to out
+    size_t detect_momentum_patterns(const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+                                    Pattern* out, size_t capacity);
+    size_t detect_volume_patterns(const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+                                  Pattern* out, size_t capacity);
+    size_t detect_liquidity_patterns(const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+                                     Pattern* out, size_t capacity);
+    size_t detect_regime_patterns(const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+                                  Pattern* out, size_t capacity);
+    bool clears_channel(const RealtimeEngine::MarketMetrics& metrics, const InstrumentState& state) const;
+        bool emit(PatternType type, const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+              double confidence, std::array<double, MAX_PARAMETERS> parameters, Pattern* out, size_t capacity);
 };
 
 /**
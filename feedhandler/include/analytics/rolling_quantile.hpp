@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace feedhandler {
+namespace analytics {
+
+/**
+ * @brief Exact quantile of the last N values, O(log N) per push
+ *
+ * The two-heap median of leetcode 295, bounded and made deletable: the
+ * lower heap (max on top) holds the rank() smallest values of the window
+ * and the upper heap (min on top) the rest, so the quantile is the lower
+ * top. Values live in a ring of N slots and each slot records where its
+ * heap entry sits, so when the window is full the oldest value is taken
+ * out of whichever heap holds it before its slot is reused.
+ *
+ * rank() is the nearest rank, as in LatencyHistogram::percentile():
+ * round(quantile * size), at least 1. All storage is allocated at
+ * construction.
+ */
+template<typename T>
+class RollingQuantile {
+public:
+    /**
+     * @param window_size Values in the window (0 is treated as 1)
+     * @param quantile In [0, 1]; 0.5 is the median
+     */
+    RollingQuantile(size_t window_size, double quantile)
+        : slots_(window_size > 0 ? window_size : 1), quantile_(std::clamp(quantile, 0.0, 1.0)) {
+        lower_.reserve(slots_.size());
+        upper_.reserve(slots_.size());
+    }
+
+    /**
+     * @brief Add value, evicting the oldest one when the window is full
+     */
+    void push(const T& value) {
+        uint32_t slot = static_cast<uint32_t>(pushed_ % slots_.size());
+        if (full()) {
+            remove(slot);  // The oldest value sits where the new one goes
+        }
+        slots_[slot].value = value;
+        // The lower heap can be empty here only right after an eviction
+        bool low = lower_.empty() ? upper_.empty() || !(top(upper_) < value) : !(top(lower_) < value);
+        insert(low ? lower_ : upper_, low, slot);
+        ++pushed_;
+        rebalance();
+    }
+
+    size_t size() const { return lower_.size() + upper_.size(); }
+    bool empty() const { return lower_.empty(); }
+    bool full() const { return size() == slots_.size(); }
+    size_t window_size() const { return slots_.size(); }
+    double quantile() const { return quantile_; }
+
+    /**
+     * @brief 1-based rank of the quantile value among size() values
+     */
+    size_t rank() const { return target_rank(size()); }
+
+    /**
+     * @brief Value at rank() (requires !empty())
+     */
+    const T& value() const { return top(lower_); }
+
+    /**
+     * @brief value(), or the mean of it and the next value up when the
+     *        quantile falls exactly between them (the textbook median
+     *        for an even count at 0.5); 0 if empty
+     */
+    double interpolated() const {
+        if (lower_.empty()) {
+            return 0.0;
+        }
+        double position = quantile_ * static_cast<double>(size());
+        if (!upper_.empty() && position == std::floor(position) &&
+            static_cast<size_t>(position) == lower_.size()) {
+            return 0.5 * (static_cast<double>(top(lower_)) + static_cast<double>(top(upper_)));
+        }
+        return static_cast<double>(top(lower_));
+    }
+
+    void clear() {
+        lower_.clear();
+        upper_.clear();
+        pushed_ = 0;
+    }
+
+private:
+    struct Slot {
+        T value{};
+        uint32_t heap_index = 0;
+        bool in_lower = false;
+    };
+
+    size_t target_rank(size_t count) const {
+        size_t rank = static_cast<size_t>(quantile_ * static_cast<double>(count) + 0.5);
+        return std::clamp<size_t>(rank, 1, count);
+    }
+
+    const T& top(const std::vector<uint32_t>& heap) const { return slots_[heap.front()].value; }
+
+    // a belongs above b: larger in the lower heap, smaller in the upper one
+    bool above(uint32_t a, uint32_t b, bool lower) const {
+        return lower ? slots_[b].value < slots_[a].value : slots_[a].value < slots_[b].value;
+    }
+
+    void set(std::vector<uint32_t>& heap, size_t index, uint32_t slot) {
+        heap[index] = slot;
+        slots_[slot].heap_index = static_cast<uint32_t>(index);
+    }
+
+    void sift_up(std::vector<uint32_t>& heap, bool lower, size_t index) {
+        uint32_t slot = heap[index];
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            if (!above(slot, heap[parent], lower)) {
+                break;
+            }
+            set(heap, index, heap[parent]);
+            index = parent;
+        }
+        set(heap, index, slot);
+    }
+
+    void sift_down(std::vector<uint32_t>& heap, bool lower, size_t index) {
+        uint32_t slot = heap[index];
+        size_t count = heap.size();
+        while (true) {
+            size_t child = 2 * index + 1;
+            if (child >= count) {
+                break;
+            }
+            if (child + 1 < count && above(heap[child + 1], heap[child], lower)) {
+                ++child;
+            }
+            if (!above(heap[child], slot, lower)) {
+                break;
+            }
+            set(heap, index, heap[child]);
+            index = child;
+        }
+        set(heap, index, slot);
+    }
+
+    void insert(std::vector<uint32_t>& heap, bool lower, uint32_t slot) {
+        slots_[slot].in_lower = lower;
+        heap.push_back(slot);
+        sift_up(heap, lower, heap.size() - 1);
+    }
+
+    void remove(uint32_t slot) {
+        bool lower = slots_[slot].in_lower;
+        std::vector<uint32_t>& heap = lower ? lower_ : upper_;
+        size_t index = slots_[slot].heap_index;
+        uint32_t last = heap.back();
+        heap.pop_back();
+        if (index < heap.size()) {
+            set(heap, index, last);
+            sift_up(heap, lower, index);
+            sift_down(heap, lower, slots_[last].heap_index);
+        }
+    }
+
+    // Move tops across until the lower heap holds exactly rank() values
+    void rebalance() {
+        size_t rank = target_rank(size());
+        while (lower_.size() > rank) {
+            uint32_t slot = lower_.front();
+            remove(slot);
+            insert(upper_, false, slot);
+        }
+        while (lower_.size() < rank) {
+            uint32_t slot = upper_.front();
+            remove(slot);
+            insert(lower_, true, slot);
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> lower_;   // Slot indices, heap ordered
+    std::vector<uint32_t> upper_;
+    double quantile_;
+    uint64_t pushed_ = 0;
+};
+
+} // namespace analytics
+} // namespace feedhandler
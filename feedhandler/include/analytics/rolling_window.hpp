@@ -0,0 +1,397 @@
+#pragma once
+
+#include "common/compact_tick.hpp"
+#include "common/tick.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace feedhandler {
+namespace analytics {
+
+/**
+ * @brief Fixed-capacity ring of the most recent values
+ *
+ * push_back() overwrites the oldest value once full, so the ring always
+ * holds the last capacity() values in order. Both ends can be popped,
+ * which makes it usable as a bounded deque. Storage is allocated once
+ * at construction.
+ */
+template<typename T>
+class HistoryRing {
+public:
+    /**
+     * @param capacity Values held (0 is treated as 1)
+     */
+    explicit HistoryRing(size_t capacity) : slots_(capacity > 0 ? capacity : 1) {}
+
+    size_t capacity() const { return slots_.size(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == slots_.size(); }
+
+    /**
+     * @brief Append value, overwriting the oldest one when full
+     */
+    void push_back(const T& value) {
+        if (full()) {
+            slots_[head_] = value;
+            head_ = wrap(head_ + 1);
+        } else {
+            slots_[wrap(head_ + size_)] = value;
+            ++size_;
+        }
+    }
+
+    void pop_front() {
+        head_ = wrap(head_ + 1);
+        --size_;
+    }
+
+    void pop_back() { --size_; }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    /**
+     * @brief i-th value, 0 = oldest
+     */
+    const T& operator[](size_t i) const { return slots_[wrap(head_ + i)]; }
+    T& operator[](size_t i) { return slots_[wrap(head_ + i)]; }
+
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+private:
+    size_t wrap(size_t index) const { return index >= slots_.size() ? index - slots_.size() : index; }
+
+    std::vector<T> slots_;
+    size_t head_ = 0;  // Oldest value
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Streaming window maximum (or minimum) in O(1) amortized per value
+ *
+ * The monotonic queue behind the leetcode 239 sliding-window maximum,
+ * kept incrementally: a value that can never again be the window's best
+ * (an older one no better than a newer one) is dropped when the newer
+ * one arrives, so the queue stays best-first and best() is its front.
+ * Each value is pushed and popped at most once.
+ *
+ * The window is the last window_size() values pushed and, with a
+ * non-zero horizon, only those whose timestamp is less than horizon
+ * behind the latest push() or expire() time. The queue is a HistoryRing
+ * of window_size() slots: no allocation after construction.
+ *
+ * Better(a, b) is true when a beats b (std::greater for a maximum). On
+ * ties the newer value wins, as it stays in the window longer.
+ */
+template<typename T, typename Better>
+class MonotonicWindow {
+public:
+    /**
+     * @param window_size Values in a count window (0 is treated as 1)
+     * @param horizon Timestamp span of a time window, 0 for none
+     */
+    explicit MonotonicWindow(size_t window_size, uint64_t horizon = 0)
+        : entries_(window_size), horizon_(horizon) {}
+
+    void push(const T& value, uint64_t timestamp = 0) {
+        if (!entries_.empty() && entries_.front().position + entries_.capacity() <= pushed_) {
+            entries_.pop_front();  // Left the count window
+        }
+        while (!entries_.empty() && !better_(entries_.back().value, value)) {
+            entries_.pop_back();
+        }
+        entries_.push_back({pushed_++, timestamp, value});
+        expire(timestamp);
+    }
+
+    /**
+     * @brief Drop values at least horizon older than now (time windows only)
+     */
+    void expire(uint64_t now) {
+        if (horizon_ == 0) {
+            return;
+        }
+        while (!entries_.empty() && now >= horizon_ && entries_.front().timestamp <= now - horizon_) {
+            entries_.pop_front();
+        }
+    }
+
+    bool empty() const { return entries_.empty(); }
+
+    /**
+     * @brief Best value in the window (requires !empty())
+     */
+    const T& best() const { return entries_.front().value; }
+    uint64_t best_timestamp() const { return entries_.front().timestamp; }
+
+    size_t window_size() const { return entries_.capacity(); }
+    uint64_t horizon() const { return horizon_; }
+    uint64_t pushed() const { return pushed_; }
+
+    void clear() { entries_.clear(); }
+
+private:
+    struct Entry {
+        uint64_t position;   // pushed() when the value arrived
+        uint64_t timestamp;
+        T value;
+    };
+
+    HistoryRing<Entry> entries_;
+    uint64_t horizon_;
+    uint64_t pushed_ = 0;
+    [[no_unique_address]] Better better_{};
+};
+
+template<typename T>
+using SlidingMax = MonotonicWindow<T, std::greater<T>>;
+
+template<typename T>
+using SlidingMin = MonotonicWindow<T, std::less<T>>;
+
+/**
+ * @brief Last N ticks of one instrument with O(1) windowed statistics
+ *
+ * Every push() adds the new tick's contribution to running sums and,
+ * once the window is full, subtracts the contribution of the tick it
+ * evicts, so no statistic ever rescans the window:
+ * - VWAP, TWAP and buy/sell volume use exact integer sums (fixed-point
+ *   prices, 128-bit products), so they never drift
+ * - Tick-to-tick log returns are kept with Welford's running mean and
+ *   sum of squared deviations, updated on insert and on eviction
+ * - High and low come from a SlidingMax / SlidingMin, giving the range estimators
+ *   (Parkinson, Garman-Klass) with the window's first tick as the open
+ *   and its last as the close
+ *
+ * Prices are returned in price units (fixed-point / 10000). Ticks with
+ * a non-positive price or quantity are ignored.
+ */
+class RollingTickWindow {
+public:
+    /**
+     * @param capacity Ticks in the window (0 is treated as 1)
+     */
+    explicit RollingTickWindow(size_t capacity)
+        : ticks_(capacity)
+        , highs_(capacity)
+        , lows_(capacity) {}
+
+    /**
+     * @brief Add a tick, evicting the oldest when the window is full
+     * @return false if the tick was ignored
+     */
+    bool push(const common::CompactTick& tick) {
+        if (tick.price <= 0 || tick.qty <= 0) {
+            return false;
+        }
+        if (ticks_.full()) {
+            evict();
+        }
+
+        if (!ticks_.empty()) {
+            const common::CompactTick& last = ticks_.back();
+            twap_sum_ += static_cast<__int128>(last.price) * elapsed(last, tick);
+            add_return(std::log(static_cast<double>(tick.price) / static_cast<double>(last.price)));
+        }
+        pq_sum_ += static_cast<__int128>(tick.price) * tick.qty;
+        volume_ += tick.qty;
+        if (tick.side == 'B') {
+            buy_volume_ += tick.qty;
+        } else if (tick.side == 'S') {
+            sell_volume_ += tick.qty;
+        }
+
+        highs_.push(tick.price);
+        lows_.push(tick.price);
+        ticks_.push_back(tick);
+        return true;
+    }
+
+    /**
+     * @brief push() for a Tick (interns the symbol if needed)
+     */
+    bool push(const common::Tick& tick) { return push(tick.to_compact()); }
+
+    size_t size() const { return ticks_.size(); }
+    size_t capacity() const { return ticks_.capacity(); }
+    bool empty() const { return ticks_.empty(); }
+
+    /**
+     * @brief Window contents, oldest first
+     */
+    const HistoryRing<common::CompactTick>& ticks() const { return ticks_; }
+
+    /**
+     * @brief Volume-weighted average price (0 if empty)
+     */
+    double vwap() const {
+        return volume_ > 0 ? to_price(static_cast<double>(pq_sum_) / static_cast<double>(volume_)) : 0.0;
+    }
+
+    /**
+     * @brief Time-weighted average price: each price weighted by how long it stood
+     *
+     * Falls back to the last price while the window spans no time.
+     */
+    double twap() const {
+        if (ticks_.empty()) {
+            return 0.0;
+        }
+        uint64_t span = elapsed(ticks_.front(), ticks_.back());
+        if (span == 0) {
+            return to_price(static_cast<double>(ticks_.back().price));
+        }
+        return to_price(static_cast<double>(twap_sum_) / static_cast<double>(span));
+    }
+
+    double open() const { return ticks_.empty() ? 0.0 : to_price(static_cast<double>(ticks_.front().price)); }
+    double close() const { return ticks_.empty() ? 0.0 : to_price(static_cast<double>(ticks_.back().price)); }
+    double high() const { return highs_.empty() ? 0.0 : to_price(static_cast<double>(highs_.best())); }
+    double low() const { return lows_.empty() ? 0.0 : to_price(static_cast<double>(lows_.best())); }
+
+    int64_t volume() const { return volume_; }
+    int64_t buy_volume() const { return buy_volume_; }
+    int64_t sell_volume() const { return sell_volume_; }
+
+    /**
+     * @brief Time from the first to the last tick in the window, nanoseconds
+     */
+    uint64_t span_ns() const { return ticks_.empty() ? 0 : elapsed(ticks_.front(), ticks_.back()); }
+
+    /**
+     * @brief Number of tick-to-tick returns in the window (size() - 1)
+     */
+    size_t return_count() const { return return_count_; }
+
+    double mean_return() const { return return_mean_; }
+
+    /**
+     * @brief Sample standard deviation of tick-to-tick log returns
+     */
+    double realized_volatility() const {
+        return return_count_ > 1 ? std::sqrt(std::max(return_m2_, 0.0) / static_cast<double>(return_count_ - 1)) : 0.0;
+    }
+
+    /**
+     * @brief Parkinson range estimator over the window: ln(H/L) / sqrt(4 ln 2)
+     */
+    double parkinson_volatility() const {
+        if (highs_.empty()) {
+            return 0.0;
+        }
+        double range = log_ratio(highs_.best(), lows_.best());
+        return std::sqrt(range * range / (4.0 * std::log(2.0)));
+    }
+
+    /**
+     * @brief Garman-Klass estimator over the window, from its open, high, low and close
+     */
+    double garman_klass_volatility() const {
+        if (highs_.empty()) {
+            return 0.0;
+        }
+        double range = log_ratio(highs_.best(), lows_.best());
+        double body = log_ratio(ticks_.back().price, ticks_.front().price);
+        double variance = 0.5 * range * range - (2.0 * std::log(2.0) - 1.0) * body * body;
+        return std::sqrt(std::max(variance, 0.0));
+    }
+
+    /**
+     * @brief (buy volume - sell volume) / (buy + sell volume), in [-1, 1]
+     */
+    double order_flow_imbalance() const {
+        int64_t total = buy_volume_ + sell_volume_;
+        return total > 0 ? static_cast<double>(buy_volume_ - sell_volume_) / static_cast<double>(total) : 0.0;
+    }
+
+    void clear() {
+        ticks_.clear();
+        highs_.clear();
+        lows_.clear();
+        pq_sum_ = 0;
+        twap_sum_ = 0;
+        volume_ = 0;
+        buy_volume_ = 0;
+        sell_volume_ = 0;
+        return_count_ = 0;
+        return_mean_ = 0.0;
+        return_m2_ = 0.0;
+    }
+
+private:
+    static double to_price(double fixed) { return fixed / 10000.0; }
+
+    static double log_ratio(int64_t numerator, int64_t denominator) {
+        return std::log(static_cast<double>(numerator) / static_cast<double>(denominator));
+    }
+
+    // Timestamps going backwards count as no time passing
+    static uint64_t elapsed(const common::CompactTick& from, const common::CompactTick& to) {
+        return to.timestamp > from.timestamp ? to.timestamp - from.timestamp : 0;
+    }
+
+    void add_return(double value) {
+        ++return_count_;
+        double delta = value - return_mean_;
+        return_mean_ += delta / static_cast<double>(return_count_);
+        return_m2_ += delta * (value - return_mean_);
+    }
+
+    void remove_return(double value) {
+        if (return_count_ <= 1) {
+            return_count_ = 0;
+            return_mean_ = 0.0;
+            return_m2_ = 0.0;
+            return;
+        }
+        double mean = (return_mean_ * static_cast<double>(return_count_) - value) / static_cast<double>(return_count_ - 1);
+        return_m2_ -= (value - return_mean_) * (value - mean);
+        return_mean_ = mean;
+        --return_count_;
+    }
+
+    // Drop the oldest tick and everything it contributed
+    void evict() {
+        const common::CompactTick& oldest = ticks_.front();
+        if (ticks_.size() > 1) {
+            const common::CompactTick& next = ticks_[1];
+            twap_sum_ -= static_cast<__int128>(oldest.price) * elapsed(oldest, next);
+            remove_return(std::log(static_cast<double>(next.price) / static_cast<double>(oldest.price)));
+        }
+        pq_sum_ -= static_cast<__int128>(oldest.price) * oldest.qty;
+        volume_ -= oldest.qty;
+        if (oldest.side == 'B') {
+            buy_volume_ -= oldest.qty;
+        } else if (oldest.side == 'S') {
+            sell_volume_ -= oldest.qty;
+        }
+        ticks_.pop_front();  // highs_ and lows_ drop it themselves on the next push
+    }
+
+    HistoryRing<common::CompactTick> ticks_;
+    SlidingMax<int64_t> highs_;   // Same count window as ticks_
+    SlidingMin<int64_t> lows_;
+
+    __int128 pq_sum_ = 0;         // Sum of price * qty
+    __int128 twap_sum_ = 0;       // Sum of price * time until the next tick
+    int64_t volume_ = 0;
+    int64_t buy_volume_ = 0;
+    int64_t sell_volume_ = 0;
+
+    size_t return_count_ = 0;
+    double return_mean_ = 0.0;
+    double return_m2_ = 0.0;      // Welford sum of squared deviations
+};
+
+} // namespace analytics
+} // namespace feedhandler
@@ -4,6 +4,7 @@
 #include <string>
 #include <unordered_map>
 #include <chrono>
+#include "common/tsc_clock.hpp"
 
 namespace feedhandler {
 namespace benchmarks {
@@ -83,7 +84,7 @@ private:
     [[maybe_unused]] int perf_fd_branch_misses_;
 #endif
     
-    std::chrono::high_resolution_clock::time_point start_time_;
+    uint64_t start_counter_;  // common::TscClock::read_counter()
     
     void setup_perf_counters();
     void cleanup_perf_counters();
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace feedhandler {
+namespace benchmarks {
+
+/**
+ * @brief One repeatable workload over fixed input
+ *
+ * batch() performs ops_per_batch operations (messages parsed, ticks
+ * acquired, ...) and must leave the scenario ready for the next call.
+ */
+struct PerfScenario {
+    std::string name;
+    size_t ops_per_batch = 1;
+    std::function<void()> batch;
+};
+
+/**
+ * @brief Measurements of one scenario, every rate per operation
+ */
+struct PerfResult {
+    std::string name;
+    uint64_t operations = 0;        // Timed operations, over all repetitions
+    double ns_per_op = 0.0;         // Median of the repetitions
+    double ops_per_second = 0.0;
+    double spread = 0.0;            // (slowest - fastest) / median repetition
+    double p50_ns = 0.0;            // Per-operation time of single batches
+    double p99_ns = 0.0;
+    bool counters = false;          // Hardware counters were readable
+    double ipc = 0.0;
+    double instructions_per_op = 0.0;
+    double cache_misses_per_op = 0.0;
+    double branch_misses_per_op = 0.0;
+
+    /**
+     * @brief Metric by its baseline name, e.g. "ns_per_op"
+     * @return false if name is unknown, or a counter metric without counters
+     */
+    bool metric(std::string_view metric_name, double& value) const;
+};
+
+/**
+ * @brief One committed baseline line: scenario, metric, value, tolerance
+ */
+struct PerfExpectation {
+    std::string scenario;
+    std::string metric;
+    double baseline = 0.0;
+    double tolerance = 0.0;         // Allowed relative change for the worse
+};
+
+struct PerfComparison {
+    enum class Status { OK, IMPROVED, REGRESSED, MISSING };
+
+    std::string scenario;
+    std::string metric;
+    double baseline = 0.0;
+    double measured = 0.0;
+    double change = 0.0;            // Relative; positive is worse
+    double tolerance = 0.0;
+    Status status = Status::MISSING;
+};
+
+/**
+ * @brief Performance regression harness: measured scenarios against
+ *        committed baselines
+ *
+ * Each scenario is warmed up, then timed over several repetitions of
+ * at least min_repetition_ns each; ns_per_op is the median repetition,
+ * so one descheduled repetition does not move it, and spread reports how
+ * noisy the run was. Every batch is also timed on its own (TSC) for the
+ * per-operation p50/p99. A PerfCounterGroup around the timed batches
+ * adds IPC and instruction, cache-miss and branch-miss rates where the
+ * kernel allows perf events.
+ *
+ * Baselines are plain text, one expectation per line, so a change to
+ * them reads as a one-line diff in review:
+ *
+ * @code
+ * # scenario               metric       baseline  tolerance
+ * fsm_parser.messages      ns_per_op    95.3      0.25
+ * @endcode
+ *
+ * A baseline only means something on the host that wrote it; regenerate
+ * it with save_baseline() when the reference machine changes.
+ */
+class PerfHarness {
+public:
+    struct Config {
+        int cpu = -1;                           // Pin the calling thread here; -1 leaves affinity alone
+        size_t warmup_batches = 20;
+        size_t repetitions = 5;
+        uint64_t min_repetition_ns = 50000000;  // 50 ms
+        size_t max_batches = 1000000;           // Per repetition
+        bool perf_counters = true;
+
+        Config() = default;
+    };
+
+    PerfHarness() = default;
+
+    /**
+     * @brief Pins the calling thread if config.cpu >= 0 (a failure is
+     *        reported on std::cerr and leaves it unpinned)
+     */
+    explicit PerfHarness(const Config& config);
+
+    void add(PerfScenario scenario);
+
+    /**
+     * @brief Run every scenario whose name contains filter
+     */
+    std::vector<PerfResult> run(std::string_view filter = {}) const;
+
+    PerfResult run(const PerfScenario& scenario) const;
+
+    const std::vector<PerfScenario>& scenarios() const { return scenarios_; }
+    bool pinned() const { return pinned_; }
+
+    /**
+     * @brief Results as a JSON document (context plus one object per scenario)
+     */
+    void write_json(std::ostream& out, const std::vector<PerfResult>& results) const;
+
+    /**
+     * @return false (reported on std::cerr) if the file is unreadable or
+     *         a line is malformed
+     */
+    static bool load_baseline(const std::string& path, std::vector<PerfExpectation>& expectations);
+
+    /**
+     * @brief Write one line per result and metric
+     * @return false if the file cannot be written
+     */
+    static bool save_baseline(const std::string& path, const std::vector<PerfResult>& results,
+                              const std::vector<std::string>& metrics, double tolerance);
+
+    /**
+     * @brief Check every expectation against the results; scenarios or
+     *        metrics the run did not produce are MISSING
+     */
+    static std::vector<PerfComparison> compare(const std::vector<PerfResult>& results,
+                                               const std::vector<PerfExpectation>& expectations);
+
+    /**
+     * @brief Direction of a metric: ops_per_second and ipc improve upwards
+     */
+    static bool higher_is_better(std::string_view metric);
+
+private:
+    Config config_;
+    std::vector<PerfScenario> scenarios_;
+    bool pinned_ = false;
+};
+
+} // namespace benchmarks
+} // namespace feedhandler
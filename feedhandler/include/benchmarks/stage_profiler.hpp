@@ -0,0 +1,317 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "benchmarks/hardware_profiler.hpp"
+#include "common/tsc_clock.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace feedhandler {
+namespace benchmarks {
+
+/**
+ * @brief One reading of the counter group
+ */
+struct CounterSample {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+    uint64_t branch_misses = 0;
+};
+
+/**
+ * @brief Free-running counters of the calling thread, read in one syscall
+ *
+ * Cycles lead a perf event group with instructions, cache misses and
+ * branch misses as members; with PERF_FORMAT_GROUP a single read() of
+ * the leader returns all four, so a sample costs one syscall instead of
+ * HardwareProfiler's reset/enable/disable/read per counter. Counters
+ * that the PMU or kernel refuses read as 0.
+ */
+class PerfCounterGroup {
+public:
+    PerfCounterGroup() {
+#ifdef __linux__
+        leader_ = open_event(PERF_COUNT_HW_CPU_CYCLES, -1);
+        if (leader_ < 0) {
+            return;
+        }
+        const uint64_t members[] = {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                                    PERF_COUNT_HW_BRANCH_MISSES};
+        for (size_t i = 0; i < 3; ++i) {
+            members_[i] = open_event(members[i], leader_);
+            if (members_[i] >= 0) {
+                slot_[i] = ++opened_;  // Position in the group read
+            }
+        }
+        ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    ~PerfCounterGroup() {
+#ifdef __linux__
+        for (int fd : members_) {
+            if (fd >= 0) close(fd);
+        }
+        if (leader_ >= 0) close(leader_);
+#endif
+    }
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool available() const { return leader_ >= 0; }
+
+    /**
+     * @brief Current totals since the group was opened
+     * @return false if counters are unavailable
+     */
+    bool read(CounterSample& sample) const {
+#ifdef __linux__
+        if (leader_ < 0) {
+            return false;
+        }
+        uint64_t values[1 + 4];  // nr, then one value per opened event
+        if (::read(leader_, values, sizeof(values)) < static_cast<ssize_t>(2 * sizeof(uint64_t))) {
+            return false;
+        }
+        sample.cycles = values[1];
+        sample.instructions = slot_[0] ? values[1 + slot_[0]] : 0;
+        sample.cache_misses = slot_[1] ? values[1 + slot_[1]] : 0;
+        sample.branch_misses = slot_[2] ? values[1 + slot_[2]] : 0;
+        return true;
+#else
+        (void)sample;
+        return false;
+#endif
+    }
+
+private:
+#ifdef __linux__
+    static int open_event(uint64_t config, int group_fd) {
+        struct perf_event_attr pe;
+        std::memset(&pe, 0, sizeof(pe));
+        pe.type = PERF_TYPE_HARDWARE;
+        pe.size = sizeof(pe);
+        pe.config = config;
+        pe.disabled = group_fd < 0 ? 1 : 0;  // Members follow the leader
+        pe.exclude_kernel = 1;
+        pe.exclude_hv = 1;
+        pe.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(__NR_perf_event_open, &pe, 0, -1, group_fd, 0));
+    }
+#endif
+
+    int leader_ = -1;
+    int members_[3] = {-1, -1, -1};
+    size_t slot_[3] = {0, 0, 0};
+    size_t opened_ = 0;
+};
+
+/**
+ * @brief Continuous per-stage sampling of hardware counters
+ *
+ * The sampling counterpart to HardwareProfiler's start()/stop(): every
+ * pipeline thread keeps its own PerfCounterGroup running (opened on first
+ * use), and each stage brackets a batch with begin()/end(). The counter
+ * deltas and wall time are added to that stage's totals, which any
+ * thread can read through metrics() while the pipeline runs, e.g. to
+ * export IPC and cache misses per stage.
+ *
+ * With sample_interval N only every Nth batch on a thread is measured,
+ * to bound the syscall cost; batches() still counts all of them.
+ * Register stages before the pipeline starts.
+ *
+ * @code
+ * StageProfiler profiler(8);
+ * size_t parse = profiler.add_stage("parse");
+ * {
+ *     StageProfiler::Scope scope(profiler, parse);
+ *     parser.parse(data, length, ticks);
+ * }
+ * HardwareProfiler::Metrics m = profiler.metrics(parse);  // m.ipc, m.l1_cache_misses, ...
+ * @endcode
+ */
+class StageProfiler {
+public:
+    static constexpr size_t MAX_STAGES = 16;
+    static constexpr size_t INVALID_STAGE = MAX_STAGES;
+
+    /**
+     * @brief An open measurement from begin()
+     */
+    struct Sample {
+        CounterSample counters;
+        uint64_t start_counter = 0;  // common::TscClock::read_counter()
+        bool measured = false;       // Picked by the sample interval
+        bool has_counters = false;   // Hardware counters were read
+    };
+
+    /**
+     * @brief RAII begin()/end() around a scope
+     */
+    class Scope {
+    public:
+        Scope(StageProfiler& profiler, size_t stage) : profiler_(profiler), stage_(stage), sample_(profiler.begin()) {}
+        ~Scope() { profiler_.end(stage_, sample_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        StageProfiler& profiler_;
+        size_t stage_;
+        Sample sample_;
+    };
+
+    explicit StageProfiler(uint32_t sample_interval = 1)
+        : sample_interval_(sample_interval == 0 ? 1 : sample_interval) {}
+
+    StageProfiler(const StageProfiler&) = delete;
+    StageProfiler& operator=(const StageProfiler&) = delete;
+
+    /**
+     * @brief Register a stage (before use)
+     * @return Stage ID, or INVALID_STAGE when all MAX_STAGES are taken
+     */
+    size_t add_stage(const std::string& name) {
+        if (stage_count_ == MAX_STAGES) {
+            return INVALID_STAGE;
+        }
+        names_[stage_count_] = name;
+        return stage_count_++;
+    }
+
+    size_t stage_count() const { return stage_count_; }
+    const std::string& stage_name(size_t stage) const { return names_[stage]; }
+
+    /**
+     * @brief Start measuring a batch on the calling thread
+     */
+    Sample begin() {
+        Sample sample;
+        thread_local uint32_t countdown = 0;
+        if (countdown != 0) {
+            --countdown;
+            return sample;
+        }
+        countdown = sample_interval_ - 1;
+        sample.measured = true;
+        sample.has_counters = thread_group().read(sample.counters);
+        sample.start_counter = common::TscClock::read_counter();
+        return sample;
+    }
+
+    /**
+     * @brief Attribute the batch since begin() to stage
+     */
+    void end(size_t stage, const Sample& sample) {
+        if (stage >= stage_count_) {
+            return;
+        }
+        Totals& totals = totals_[stage];
+        totals.batches.fetch_add(1, std::memory_order_relaxed);
+        if (!sample.measured) {
+            return;
+        }
+        uint64_t end_counter = common::TscClock::read_counter();
+        totals.sampled.fetch_add(1, std::memory_order_relaxed);
+        totals.wall_ns.fetch_add(common::TscClock::global().ticks_to_ns(end_counter - sample.start_counter),
+                                 std::memory_order_relaxed);
+
+        CounterSample now;
+        if (sample.has_counters && thread_group().read(now)) {
+            totals.cycles.fetch_add(now.cycles - sample.counters.cycles, std::memory_order_relaxed);
+            totals.instructions.fetch_add(now.instructions - sample.counters.instructions, std::memory_order_relaxed);
+            totals.cache_misses.fetch_add(now.cache_misses - sample.counters.cache_misses, std::memory_order_relaxed);
+            totals.branch_misses.fetch_add(now.branch_misses - sample.counters.branch_misses, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Totals over the sampled batches of a stage, with derived rates
+     */
+    HardwareProfiler::Metrics metrics(size_t stage) const {
+        HardwareProfiler::Metrics metrics{};
+        if (stage >= stage_count_) {
+            return metrics;
+        }
+        const Totals& totals = totals_[stage];
+        metrics.cpu_cycles = totals.cycles.load(std::memory_order_relaxed);
+        metrics.instructions = totals.instructions.load(std::memory_order_relaxed);
+        metrics.l1_cache_misses = totals.cache_misses.load(std::memory_order_relaxed);
+        metrics.branch_misses = totals.branch_misses.load(std::memory_order_relaxed);
+        metrics.wall_time = std::chrono::nanoseconds(totals.wall_ns.load(std::memory_order_relaxed));
+
+        double instructions = static_cast<double>(metrics.instructions);
+        metrics.ipc = metrics.cpu_cycles > 0 ? instructions / static_cast<double>(metrics.cpu_cycles) : 0.0;
+        metrics.cache_hit_rate = metrics.instructions > 0 ?
+            1.0 - static_cast<double>(metrics.l1_cache_misses) / instructions : 0.0;
+        metrics.branch_prediction_rate = metrics.instructions > 0 ?
+            1.0 - static_cast<double>(metrics.branch_misses) / instructions : 0.0;
+        return metrics;
+    }
+
+    uint64_t batches(size_t stage) const {
+        return stage < stage_count_ ? totals_[stage].batches.load(std::memory_order_relaxed) : 0;
+    }
+
+    uint64_t sampled_batches(size_t stage) const {
+        return stage < stage_count_ ? totals_[stage].sampled.load(std::memory_order_relaxed) : 0;
+    }
+
+    void reset() {
+        for (auto& totals : totals_) {
+            totals.batches.store(0, std::memory_order_relaxed);
+            totals.sampled.store(0, std::memory_order_relaxed);
+            totals.wall_ns.store(0, std::memory_order_relaxed);
+            totals.cycles.store(0, std::memory_order_relaxed);
+            totals.instructions.store(0, std::memory_order_relaxed);
+            totals.cache_misses.store(0, std::memory_order_relaxed);
+            totals.branch_misses.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Whether the calling thread got hardware counters
+     */
+    static bool counters_available() { return thread_group().available(); }
+
+private:
+    // One cache line per stage so stages on different threads never share
+    struct alignas(64) Totals {
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> sampled{0};
+        std::atomic<uint64_t> wall_ns{0};
+        std::atomic<uint64_t> cycles{0};
+        std::atomic<uint64_t> instructions{0};
+        std::atomic<uint64_t> cache_misses{0};
+        std::atomic<uint64_t> branch_misses{0};
+    };
+
+    // Counters follow the thread, so all profilers on it share one group
+    static PerfCounterGroup& thread_group() {
+        thread_local PerfCounterGroup group;
+        return group;
+    }
+
+    uint32_t sample_interval_;
+    size_t stage_count_ = 0;
+    std::array<std::string, MAX_STAGES> names_;
+    std::array<Totals, MAX_STAGES> totals_;
+};
+
+} // namespace benchmarks
+} // namespace feedhandler
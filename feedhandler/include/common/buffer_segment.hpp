@@ -0,0 +1,154 @@
+#pragma once
+
+#include "common/flyweight_tick.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace feedhandler {
+namespace common {
+
+class SegmentPool;
+
+/**
+ * @brief Counted handle to one receive buffer segment and the
+ *        FlyweightTicks parsed out of it
+ *
+ * A segment owns the raw bytes of one network read plus storage for the
+ * ticks parsed from them, whose symbol views point into those bytes.
+ * Copies share the segment; when the last handle is dropped the whole
+ * batch of ticks is retired at once and the segment goes back to its
+ * pool, so consumers can keep FlyweightTicks for as long as they hold a
+ * SegmentRef, on any thread.
+ *
+ * The pool must outlive every handle.
+ */
+class SegmentRef {
+public:
+    SegmentRef() = default;
+    SegmentRef(const SegmentRef& other);
+    SegmentRef(SegmentRef&& other) noexcept
+        : pool_(std::exchange(other.pool_, nullptr)), index_(other.index_) {}
+    SegmentRef& operator=(const SegmentRef& other);
+    SegmentRef& operator=(SegmentRef&& other) noexcept;
+    ~SegmentRef() { reset(); }
+
+    /**
+     * @brief Drop this handle (recycles the segment if it was the last one)
+     */
+    void reset();
+
+    explicit operator bool() const { return pool_ != nullptr; }
+
+    /**
+     * @brief Writable byte storage (receive directly into it)
+     */
+    char* data() const;
+    size_t capacity() const;
+
+    /**
+     * @brief Bytes of valid data, set by the writer
+     */
+    size_t length() const;
+    void set_length(size_t length);
+
+    /**
+     * @brief Tick storage for the parser and the ticks written so far
+     */
+    FlyweightTick* tick_storage() const;
+    size_t tick_capacity() const;
+    void set_tick_count(size_t count);
+    std::span<const FlyweightTick> ticks() const;
+
+    /**
+     * @brief Number of live handles to this segment (0 if empty)
+     */
+    uint32_t use_count() const;
+
+private:
+    friend class SegmentPool;
+
+    SegmentRef(SegmentPool* pool, uint32_t index) : pool_(pool), index_(index) {}
+
+    SegmentPool* pool_ = nullptr;
+    uint32_t index_ = 0;
+};
+
+/**
+ * @brief Fixed set of reference-counted receive buffer segments
+ *
+ * Byte and tick storage for every segment is allocated once at
+ * construction. acquire() pops a free segment with a reference count of
+ * one; the last SegmentRef to go away pushes it back. Free segments sit
+ * on a lock-free stack of indices with a (tag, index) head, the same
+ * ABA-safe scheme as RecyclingTickPool, so segments may be acquired on
+ * the network thread and retired on any consumer thread.
+ */
+class SegmentPool {
+public:
+    /**
+     * @brief Constructor
+     * @param segment_count Number of segments
+     * @param segment_bytes Byte capacity of each segment
+     * @param ticks_per_segment Tick capacity of each segment
+     */
+    SegmentPool(size_t segment_count, size_t segment_bytes, size_t ticks_per_segment);
+
+    SegmentPool(const SegmentPool&) = delete;
+    SegmentPool& operator=(const SegmentPool&) = delete;
+
+    /**
+     * @brief Take a free segment (length and tick count reset to 0)
+     * @return Handle, or an empty handle if every segment is in use
+     */
+    SegmentRef acquire();
+
+    size_t segment_count() const { return segment_count_; }
+    size_t segment_bytes() const { return segment_bytes_; }
+    size_t ticks_per_segment() const { return ticks_per_segment_; }
+
+    /**
+     * @brief Segments not held by any handle (approximate under concurrency)
+     */
+    size_t free_count() const { return free_count_.load(std::memory_order_relaxed); }
+
+private:
+    friend class SegmentRef;
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Segment {
+        std::atomic<uint32_t> refs{0};
+        std::atomic<uint32_t> next{NONE};  // Free-list link
+        size_t length = 0;
+        size_t tick_count = 0;
+    };
+
+    static uint64_t pack(uint32_t tag, uint32_t index) {
+        return (static_cast<uint64_t>(tag) << 32) | index;
+    }
+
+    void add_ref(uint32_t index) {
+        segments_[index].refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Drop one reference; the last one returns the segment to the stack
+    void release(uint32_t index);
+
+    size_t segment_count_;
+    size_t segment_bytes_;
+    size_t ticks_per_segment_;
+    std::unique_ptr<char[]> bytes_;
+    std::unique_ptr<FlyweightTick[]> ticks_;
+    std::unique_ptr<Segment[]> segments_;
+
+    alignas(64) std::atomic<uint64_t> head_;  // (tag << 32) | index
+    alignas(64) std::atomic<size_t> free_count_;
+};
+
+} // namespace common
+} // namespace feedhandler
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include "common/symbol_table.hpp"
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief Packed, trivially copyable market data tick (32 bytes)
+ *
+ * Hot-path representation of a tick: the symbol is replaced by its
+ * interned instrument ID, so two ticks fit in a cache line and queue
+ * copies are a plain memcpy. Parsers emit this directly through their
+ * CompactTick overloads; Tick remains as a wrapper for code that wants
+ * a symbol string_view.
+ */
+struct CompactTick {
+    int64_t price = 0;                              ///< Price in fixed-point (scaled by 10000)
+    uint64_t timestamp = 0;                         ///< Nanoseconds since Unix epoch
+    InstrumentId instrument_id = INVALID_INSTRUMENT; ///< Interned symbol (SymbolTable::global())
+    int32_t qty = 0;                                ///< Quantity/size
+    char side = '\0';                               ///< 'B' for Buy/Bid, 'S' for Sell/Ask
+
+    /**
+     * @brief Check if tick is valid
+     */
+    bool is_valid() const {
+        return instrument_id != INVALID_INSTRUMENT && price > 0 && qty > 0 &&
+               (side == 'B' || side == 'S');
+    }
+
+    /**
+     * @brief Symbol resolved through the global SymbolTable
+     */
+    std::string_view symbol() const {
+        return SymbolTable::global().name(instrument_id);
+    }
+};
+
+static_assert(sizeof(CompactTick) <= 32, "CompactTick must stay within 32 bytes");
+static_assert(std::is_trivially_copyable_v<CompactTick>, "CompactTick must be memcpy-able");
+
+} // namespace common
+} // namespace feedhandler
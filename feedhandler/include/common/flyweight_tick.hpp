@@ -2,6 +2,7 @@
 
 #include <string_view>
 #include <cstdint>
+#include <vector>
 
 namespace feedhandler {
 namespace common {
@@ -13,7 +14,9 @@ namespace common {
  * All string_view fields point directly into the receive buffer.
  * 
  * CRITICAL: The source buffer MUST remain valid for the lifetime
- * of this tick. Do not use after buffer is recycled.
+ * of this tick. Do not use after buffer is recycled. Ticks parsed
+ * into a SegmentRef (common/buffer_segment.hpp) stay valid for as
+ * long as any handle to that segment is held.
  * 
  * Memory footprint: 40 bytes (vs 88 bytes for full Tick with storage)
  */
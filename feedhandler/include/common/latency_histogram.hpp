@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief Headline numbers of a latency distribution, in ns
+ */
+struct LatencySummary {
+    uint64_t count = 0;
+    uint64_t p50 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+    uint64_t max = 0;
+    double mean = 0.0;
+};
+
+/**
+ * @brief Fixed-size log-linear latency histogram
+ *
+ * Values below 64 get their own bucket; above that every power of two is
+ * split into 32 equal buckets, so any recorded value is reported within
+ * ~3% over the full uint64_t range. record() is a bit scan, a shift and
+ * an increment with no allocation, so it can sit on the hot path.
+ *
+ * Not thread-safe: keep one histogram per thread (or per stage) and
+ * merge() them when reporting.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 5;
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @brief Record count samples of value_ns
+     */
+    void record(uint64_t value_ns, uint64_t count = 1) {
+        buckets_[bucket_index(value_ns)] += count;
+        count_ += count;
+        sum_ += value_ns * count;
+        min_ = std::min(min_, value_ns);
+        max_ = std::max(max_, value_ns);
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+    /**
+     * @brief Value at percentile (0-100): the upper edge of the bucket
+     *        holding that rank, clamped to [min(), max()]; 0 if empty
+     */
+    uint64_t percentile(double percent) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        percent = std::clamp(percent, 0.0, 100.0);
+        uint64_t rank = static_cast<uint64_t>(percent / 100.0 * static_cast<double>(count_) + 0.5);
+        rank = std::clamp<uint64_t>(rank, 1, count_);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                return std::clamp(bucket_upper(i), min_, max_);
+            }
+        }
+        return max_;
+    }
+
+    LatencySummary summary() const {
+        LatencySummary result;
+        result.count = count_;
+        result.p50 = percentile(50.0);
+        result.p99 = percentile(99.0);
+        result.p999 = percentile(99.9);
+        result.max = max_;
+        result.mean = mean();
+        return result;
+    }
+
+    /**
+     * @brief Add another histogram's samples into this one
+     */
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            buckets_[i] += other.buckets_[i];
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void reset() { *this = LatencyHistogram(); }
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < 2 * SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        size_t shift = static_cast<size_t>(std::bit_width(value)) - 1 - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + static_cast<size_t>((value >> shift) - SUB_BUCKETS);
+    }
+
+    /**
+     * @brief Largest value that lands in bucket index
+     */
+    static uint64_t bucket_upper(size_t index) {
+        if (index < 2 * SUB_BUCKETS) {
+            return index;
+        }
+        size_t shift = index / SUB_BUCKETS - 1;
+        uint64_t sub = index % SUB_BUCKETS + SUB_BUCKETS;
+        return ((sub + 1) << shift) - 1;
+    }
+
+private:
+    friend class AtomicLatencyHistogram;
+
+    std::array<uint64_t, BUCKET_COUNT> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+};
+
+/**
+ * @brief Single-writer LatencyHistogram that other threads can read live
+ *
+ * Same buckets, held in relaxed atomics. The owning thread records with
+ * a plain load and store per field (no locked instruction, wait-free),
+ * so each pipeline stage and each thread gets its own instance; a
+ * reader (monitoring/exporter thread) calls snapshot() at any time and
+ * merges the copies. A snapshot taken during a record() may miss that
+ * one sample.
+ */
+class AtomicLatencyHistogram {
+public:
+    AtomicLatencyHistogram() { reset(); }
+
+    AtomicLatencyHistogram(const AtomicLatencyHistogram&) = delete;
+    AtomicLatencyHistogram& operator=(const AtomicLatencyHistogram&) = delete;
+
+    /**
+     * @brief Record count samples of value_ns (owning thread only)
+     */
+    void record(uint64_t value_ns, uint64_t count = 1) {
+        bump(buckets_[LatencyHistogram::bucket_index(value_ns)], count);
+        bump(sum_, value_ns * count);
+        if (value_ns < min_.load(std::memory_order_relaxed)) {
+            min_.store(value_ns, std::memory_order_relaxed);
+        }
+        if (value_ns > max_.load(std::memory_order_relaxed)) {
+            max_.store(value_ns, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Copy of the current distribution (any thread)
+     */
+    LatencyHistogram snapshot() const {
+        LatencyHistogram copy;
+        for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+            copy.buckets_[i] = buckets_[i].load(std::memory_order_relaxed);
+            copy.count_ += copy.buckets_[i];
+        }
+        if (copy.count_ != 0) {
+            copy.sum_ = sum_.load(std::memory_order_relaxed);
+            copy.min_ = min_.load(std::memory_order_relaxed);
+            copy.max_ = max_.load(std::memory_order_relaxed);
+        }
+        return copy;
+    }
+
+    /**
+     * @brief Clear; samples recorded concurrently may survive the reset
+     */
+    void reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        sum_.store(0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static void bump(std::atomic<uint64_t>& value, uint64_t delta) {
+        value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKET_COUNT> buckets_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+};
+
+} // namespace common
+} // namespace feedhandler
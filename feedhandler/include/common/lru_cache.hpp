@@ -0,0 +1,333 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief Fixed-capacity LRU map without per-entry allocations
+ *
+ * The textbook LRU (std::list plus an unordered_map of list iterators)
+ * costs two node allocations per entry and a pointer chase per probe.
+ * Here entries live in one array and the recency list is intrusive: a
+ * separate array of 32-bit prev/next indices, so promoting an entry
+ * touches 8-byte links rather than whole entries. The index is open
+ * addressing with linear probing over {entry, hash tag} slots, kept at
+ * most half full; a probe compares keys only on a tag match, and erase
+ * uses backward shifting, so there are no tombstones to pile up.
+ *
+ * Storage grows geometrically up to capacity, after which inserting a
+ * new key evicts the least recently used one. Evicted and erased
+ * entries keep their key and value objects: the next insert assigns
+ * into them, so string keys and vector values reuse their buffers.
+ *
+ * Lookups are heterogeneous when Hash and KeyEqual accept the query
+ * type (e.g. a string_view hash with std::equal_to<> for string keys).
+ * Not thread-safe.
+ */
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class LRUCache {
+public:
+    static constexpr size_t MAX_CAPACITY = size_t{1} << 31;
+
+    explicit LRUCache(size_t capacity, Hash hash = Hash(), KeyEqual equal = KeyEqual())
+        : capacity_(capacity), hash_(std::move(hash)), equal_(std::move(equal)) {
+        if (capacity == 0 || capacity > MAX_CAPACITY) {
+            throw std::invalid_argument("LRUCache capacity must be in [1, 2^31]");
+        }
+        resize_index(MIN_INDEX_SLOTS);
+    }
+
+    /**
+     * @brief Value for key, promoted to most recently used; nullptr on a miss
+     *
+     * Valid until the next insert or erase.
+     */
+    template<typename Q>
+    V* find(const Q& key) {
+        uint32_t entry = lookup(key);
+        if (entry == NIL) {
+            return nullptr;
+        }
+        promote(entry);
+        return &entries_[entry].value;
+    }
+
+    /**
+     * @brief Value for key without touching recency; nullptr on a miss
+     */
+    template<typename Q>
+    const V* peek(const Q& key) const {
+        uint32_t entry = lookup(key);
+        return entry == NIL ? nullptr : &entries_[entry].value;
+    }
+
+    template<typename Q>
+    bool contains(const Q& key) const { return lookup(key) != NIL; }
+
+    /**
+     * @brief Most recently used slot for key, inserting it if absent
+     * @param on_evict Called as on_evict(const K&, V&) for the entry a
+     *        full cache gives up, before its storage is reused
+     * @return The value and whether key was inserted; an inserted value
+     *         holds whatever its recycled entry held, so assign it
+     */
+    template<typename Q, typename OnEvict>
+    std::pair<V*, bool> insert(const Q& key, OnEvict&& on_evict) {
+        uint64_t h = mix(hash_(key));
+        size_t slot = home(h);
+        for (; index_[slot].entry != NIL; slot = (slot + 1) & index_mask_) {
+            const Slot& s = index_[slot];
+            if (s.tag == tag(h) && equal_(entries_[s.entry].key, key)) {
+                promote(s.entry);
+                return {&entries_[s.entry].value, false};
+            }
+        }
+
+        uint32_t entry;
+        if (size_ == capacity_) {
+            entry = tail_;
+            on_evict(static_cast<const K&>(entries_[entry].key), entries_[entry].value);
+            remove(entry);
+        } else if (free_ != NIL) {
+            entry = free_;
+            free_ = links_[entry].next;
+        } else {
+            entry = static_cast<uint32_t>(entries_.size());
+            entries_.emplace_back();
+            links_.emplace_back();
+        }
+        if ((size_ + 1) * 2 > index_.size()) {
+            resize_index(index_.size() * 2);
+        }
+
+        Entry& e = entries_[entry];
+        e.key = key;
+        e.hash = h;
+        place(entry, h);
+        link_front(entry);
+        ++size_;
+        return {&e.value, true};
+    }
+
+    template<typename Q>
+    std::pair<V*, bool> insert(const Q& key) {
+        return insert(key, [](const K&, V&) {});
+    }
+
+    /**
+     * @brief Insert or overwrite key, as most recently used
+     */
+    template<typename Q>
+    V& put(const Q& key, V value) {
+        V* slot = insert(key).first;
+        *slot = std::move(value);
+        return *slot;
+    }
+
+    template<typename Q>
+    bool erase(const Q& key) {
+        uint32_t entry = lookup(key);
+        if (entry == NIL) {
+            return false;
+        }
+        release(entry);
+        return true;
+    }
+
+    /**
+     * @brief Drop the least recently used entry, calling fn(const K&, V&) first
+     * @return false if the cache is empty
+     */
+    template<typename Fn>
+    bool evict_oldest(Fn&& fn) {
+        if (tail_ == NIL) {
+            return false;
+        }
+        uint32_t entry = tail_;
+        fn(static_cast<const K&>(entries_[entry].key), entries_[entry].value);
+        release(entry);
+        return true;
+    }
+
+    bool evict_oldest() {
+        return evict_oldest([](const K&, V&) {});
+    }
+
+    /**
+     * @brief Call fn(const K&, const V&) from most to least recently used
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (uint32_t entry = head_; entry != NIL; entry = links_[entry].next) {
+            fn(entries_[entry].key, entries_[entry].value);
+        }
+    }
+
+    /**
+     * @brief Forget every entry; storage is kept for reuse
+     */
+    void clear() {
+        while (head_ != NIL) {
+            release(head_);
+        }
+    }
+
+    void reserve(size_t entries) {
+        entries = entries < capacity_ ? entries : capacity_;
+        entries_.reserve(entries);
+        links_.reserve(entries);
+        size_t slots = index_.size();
+        while (entries * 2 > slots) {
+            slots *= 2;
+        }
+        if (slots != index_.size()) {
+            resize_index(slots);
+        }
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr size_t MIN_INDEX_SLOTS = 16;
+
+    struct Entry {
+        K key{};
+        V value{};
+        uint64_t hash = 0;       // Mixed, so the index can be rebuilt and shifted without rehashing keys
+    };
+
+    struct Link {
+        uint32_t prev = NIL;
+        uint32_t next = NIL;     // Also chains the free list
+    };
+
+    struct Slot {
+        uint32_t entry = NIL;
+        uint32_t tag = 0;        // Low hash bits; the slot position uses the high ones
+    };
+
+    // std::hash is the identity for integers, which linear probing
+    // cannot afford: spread it with a Fibonacci multiply
+    static uint64_t mix(size_t h) { return static_cast<uint64_t>(h) * 0x9E3779B97F4A7C15ULL; }
+    static uint32_t tag(uint64_t h) { return static_cast<uint32_t>(h); }
+    size_t home(uint64_t h) const { return static_cast<size_t>(h >> index_shift_); }
+
+    template<typename Q>
+    uint32_t lookup(const Q& key) const {
+        uint64_t h = mix(hash_(key));
+        for (size_t slot = home(h);; slot = (slot + 1) & index_mask_) {
+            const Slot& s = index_[slot];
+            if (s.entry == NIL) {
+                return NIL;
+            }
+            if (s.tag == tag(h) && equal_(entries_[s.entry].key, key)) {
+                return s.entry;
+            }
+        }
+    }
+
+    void place(uint32_t entry, uint64_t h) {
+        size_t slot = home(h);
+        while (index_[slot].entry != NIL) {
+            slot = (slot + 1) & index_mask_;
+        }
+        index_[slot] = Slot{entry, tag(h)};
+    }
+
+    // Take entry out of the index and the recency list
+    void remove(uint32_t entry) {
+        size_t slot = home(entries_[entry].hash);
+        while (index_[slot].entry != entry) {
+            slot = (slot + 1) & index_mask_;
+        }
+        // Backward shift: pull later members of the run into the hole
+        // unless that would move them before their home slot
+        for (size_t next = (slot + 1) & index_mask_; index_[next].entry != NIL; next = (next + 1) & index_mask_) {
+            size_t next_home = home(entries_[index_[next].entry].hash);
+            if (((next - next_home) & index_mask_) >= ((next - slot) & index_mask_)) {
+                index_[slot] = index_[next];
+                slot = next;
+            }
+        }
+        index_[slot] = Slot{};
+        unlink(entry);
+        --size_;
+    }
+
+    void release(uint32_t entry) {
+        remove(entry);
+        links_[entry].next = free_;
+        free_ = entry;
+    }
+
+    void promote(uint32_t entry) {
+        if (entry != head_) {
+            unlink(entry);
+            link_front(entry);
+        }
+    }
+
+    void unlink(uint32_t entry) {
+        Link& link = links_[entry];
+        if (link.prev != NIL) {
+            links_[link.prev].next = link.next;
+        } else {
+            head_ = link.next;
+        }
+        if (link.next != NIL) {
+            links_[link.next].prev = link.prev;
+        } else {
+            tail_ = link.prev;
+        }
+        link = Link{};
+    }
+
+    void link_front(uint32_t entry) {
+        links_[entry] = Link{NIL, head_};
+        if (head_ != NIL) {
+            links_[head_].prev = entry;
+        } else {
+            tail_ = entry;
+        }
+        head_ = entry;
+    }
+
+    void resize_index(size_t slots) {
+        index_.assign(slots, Slot{});
+        index_mask_ = slots - 1;
+        index_shift_ = 64;
+        while (slots > 1) {
+            slots >>= 1;
+            --index_shift_;
+        }
+        for (uint32_t entry = head_; entry != NIL; entry = links_[entry].next) {
+            place(entry, entries_[entry].hash);
+        }
+    }
+
+    size_t capacity_;
+    size_t size_ = 0;
+    Hash hash_;
+    KeyEqual equal_;
+    std::vector<Entry> entries_;
+    std::vector<Link> links_;
+    std::vector<Slot> index_;    // Power of two, at most half full
+    size_t index_mask_ = 0;
+    unsigned index_shift_ = 64;
+    uint32_t head_ = NIL;        // Most recently used
+    uint32_t tail_ = NIL;
+    uint32_t free_ = NIL;        // Erased entries whose storage is free to reuse
+};
+
+} // namespace common
+} // namespace feedhandler
@@ -2,19 +2,32 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 
 namespace feedhandler {
 namespace common {
 
 /**
  * @brief NUMA-aware lock-free memory pool
- * 
+ *
  * This pool allocates memory on specific NUMA nodes to minimize
  * cross-node memory access latency. Uses lock-free algorithms
  * for allocation/deallocation.
- * 
+ *
+ * The backing region is bound to one node with numa_alloc_onnode()
+ * (mbind), so every page faults in on that node no matter which thread
+ * touches it first; the free list is built at construction, which
+ * prefaults the whole region. Without libnuma support at runtime the
+ * region is plain mmap memory placed by first touch from the
+ * constructing thread.
+ *
+ * The free list head is a (tag, index) pair packed in 64 bits; every
+ * successful CAS bumps the tag, so a pop racing with a pop/push of the
+ * same node (ABA) retries instead of corrupting the list.
+ *
  * Performance improvements:
  * - 50-80% reduction in memory access latency
  * - Zero lock contention
@@ -24,51 +37,141 @@ namespace common {
 template<typename T, size_t PoolSize = 1024>
 class NUMAMemoryPool {
 public:
-    NUMAMemoryPool();
+    /**
+     * @brief Constructor
+     * @param numa_node Node to bind the pool to (-1 = node of the calling thread)
+     */
+    explicit NUMAMemoryPool(int numa_node = -1);
     ~NUMAMemoryPool();
-    
+
+    NUMAMemoryPool(const NUMAMemoryPool&) = delete;
+    NUMAMemoryPool& operator=(const NUMAMemoryPool&) = delete;
+
     /**
      * @brief Allocate object from pool
      * @return Pointer to allocated object, nullptr if pool exhausted
      */
     T* allocate();
-    
+
     /**
      * @brief Return object to pool
-     * @param ptr Pointer to object to deallocate
+     * @param ptr Pointer to object to deallocate (ignored if not from this pool)
      */
     void deallocate(T* ptr);
-    
+
+    /**
+     * @brief Check if ptr was allocated from this pool
+     */
+    bool owns(const T* ptr) const;
+
+    /**
+     * @brief Node the pool memory lives on
+     */
+    int numa_node() const { return numa_node_; }
+
+    /**
+     * @brief true if the memory is bound with libnuma, false for first-touch placement
+     */
+    bool numa_bound() const { return numa_bound_; }
+
+    /**
+     * @brief NUMA node of the CPU the calling thread is running on (0 without NUMA)
+     */
+    static int current_node();
+
     /**
      * @brief Get pool statistics
      */
     struct Stats {
-        size_t allocated_count;
-        size_t free_count;
-        size_t numa_node;
-        double hit_rate;
+        size_t allocated_count;   // Objects currently handed out
+        size_t free_count;        // Objects left in the pool
+        size_t numa_node;         // Node the pool is bound to
+        double hit_rate;          // Fraction of allocate() calls served (not exhausted)
     };
-    
+
     Stats get_stats() const;
 
 private:
-    // Lock-free stack for free objects
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // Free-list node; next is an index so the head can carry a tag
     struct Node {
-        std::atomic<Node*> next;
+        std::atomic<uint32_t> next;
         T data;
     };
-    
-    alignas(64) std::atomic<Node*> free_head_;
+
+    static uint64_t pack(uint32_t tag, uint32_t index) {
+        return (static_cast<uint64_t>(tag) << 32) | index;
+    }
+
+    alignas(64) std::atomic<uint64_t> free_head_;  // (tag << 32) | index
     alignas(64) std::atomic<size_t> allocated_count_;
-    
+    std::atomic<uint64_t> allocate_calls_;
+    std::atomic<uint64_t> allocate_misses_;
+
     // NUMA-aware memory allocation
     void* numa_memory_;
-    size_t numa_node_;
+    int numa_node_;
+    bool numa_bound_;
     Node* pool_memory_;
-    
+
     void initialize_numa_pool();
     int detect_numa_node();
 };
 
+/**
+ * @brief One NUMAMemoryPool per NUMA node, created on first use
+ *
+ * allocate() serves the calling thread from the pool of the node it is
+ * running on (pin threads first for this to be stable) and falls back
+ * to other nodes only when the local pool is exhausted. deallocate()
+ * returns memory to whichever pool owns it, so objects may be freed on
+ * any thread.
+ */
+template<typename T, size_t PoolSize = 1024>
+class NUMAPoolRegistry {
+public:
+    using Pool = NUMAMemoryPool<T, PoolSize>;
+
+    NUMAPoolRegistry();
+
+    NUMAPoolRegistry(const NUMAPoolRegistry&) = delete;
+    NUMAPoolRegistry& operator=(const NUMAPoolRegistry&) = delete;
+
+    /**
+     * @brief Process-wide registry
+     */
+    static NUMAPoolRegistry& instance();
+
+    /**
+     * @brief Pool bound to a node (created on first use)
+     * @return Pool, or nullptr if node is out of range
+     */
+    Pool* for_node(int node);
+
+    /**
+     * @brief Pool of the node the calling thread is running on
+     */
+    Pool& local();
+
+    /**
+     * @brief Allocate on the local node, then any other node
+     * @return Pointer, or nullptr if every pool is exhausted
+     */
+    T* allocate();
+
+    /**
+     * @brief Return object to the pool that owns it
+     */
+    void deallocate(T* ptr);
+
+    size_t node_count() const { return pools_.size(); }
+
+private:
+    std::vector<std::atomic<Pool*>> pools_;     // Lock-free lookup by node
+    std::vector<std::unique_ptr<Pool>> owned_;  // Guarded by create_mutex_
+    std::mutex create_mutex_;
+};
+
 } // namespace common
-} // namespace feedhandler
\ No newline at end of file
+} // namespace feedhandler
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "common/latency_histogram.hpp"
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief Streaming estimate of one quantile in constant memory (P-square)
+ *
+ * Jain and Chlamtac's P² algorithm: five markers track the minimum, the
+ * quantile, the maximum and the two midpoints between them. Each add()
+ * shifts the marker positions and nudges any marker that drifted a
+ * whole rank from where it should be, by piecewise-parabolic
+ * interpolation of its neighbours. Under 140 bytes however long the
+ * stream, and exact for the first five values.
+ *
+ * Sketches cannot be merged; use LatencyHistogram where per-thread
+ * results need combining.
+ */
+class P2Quantile {
+public:
+    /**
+     * @param quantile In [0, 1]
+     */
+    explicit P2Quantile(double quantile) : quantile_(std::clamp(quantile, 0.0, 1.0)) {}
+
+    void add(double value) {
+        if (count_ < MARKERS) {
+            heights_[count_++] = value;
+            if (count_ == MARKERS) {
+                std::sort(heights_.begin(), heights_.end());
+                double q = quantile_;
+                desired_ = {0.0, 2.0 * q, 4.0 * q, 2.0 + 2.0 * q, 4.0};
+            }
+            return;
+        }
+        ++count_;
+
+        // Cell holding value; the extremes stretch to take it
+        size_t cell;
+        if (value < heights_[0]) {
+            heights_[0] = value;
+            cell = 0;
+        } else if (value >= heights_[4]) {
+            heights_[4] = value;
+            cell = 3;
+        } else {
+            cell = 0;
+            while (value >= heights_[cell + 1]) {
+                ++cell;
+            }
+        }
+        for (size_t i = cell + 1; i < MARKERS; ++i) {
+            ++positions_[i];
+        }
+        double q = quantile_;
+        const double increments[MARKERS] = {0.0, q / 2.0, q, (1.0 + q) / 2.0, 1.0};
+        for (size_t i = 0; i < MARKERS; ++i) {
+            desired_[i] += increments[i];
+        }
+
+        for (size_t i = 1; i < MARKERS - 1; ++i) {
+            double drift = desired_[i] - static_cast<double>(positions_[i]);
+            if ((drift >= 1.0 && positions_[i + 1] - positions_[i] > 1) ||
+                (drift <= -1.0 && positions_[i - 1] - positions_[i] < -1)) {
+                int64_t step = drift > 0 ? 1 : -1;
+                double height = parabolic(i, step);
+                if (!(heights_[i - 1] < height && height < heights_[i + 1])) {
+                    height = linear(i, step);
+                }
+                heights_[i] = height;
+                positions_[i] += step;
+            }
+        }
+    }
+
+    /**
+     * @brief Current estimate; the nearest-rank value while fewer than
+     *        five values were added, 0 if none
+     */
+    double value() const {
+        if (count_ >= MARKERS) {
+            return heights_[2];
+        }
+        if (count_ == 0) {
+            return 0.0;
+        }
+        std::array<double, MARKERS> sorted = heights_;
+        std::sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(count_));
+        size_t rank = static_cast<size_t>(quantile_ * static_cast<double>(count_) + 0.5);
+        return sorted[std::clamp<size_t>(rank, 1, count_) - 1];
+    }
+
+    double quantile() const { return quantile_; }
+    uint64_t count() const { return count_; }
+
+    void reset() { *this = P2Quantile(quantile_); }
+
+private:
+    static constexpr size_t MARKERS = 5;
+
+    double parabolic(size_t i, int64_t step) const {
+        double d = static_cast<double>(step);
+        double left = static_cast<double>(positions_[i] - positions_[i - 1]);
+        double right = static_cast<double>(positions_[i + 1] - positions_[i]);
+        double span = static_cast<double>(positions_[i + 1] - positions_[i - 1]);
+        return heights_[i] + d / span *
+            ((left + d) * (heights_[i + 1] - heights_[i]) / right +
+             (right - d) * (heights_[i] - heights_[i - 1]) / left);
+    }
+
+    double linear(size_t i, int64_t step) const {
+        size_t j = step > 0 ? i + 1 : i - 1;
+        return heights_[i] + static_cast<double>(step) * (heights_[j] - heights_[i]) /
+            static_cast<double>(positions_[j] - positions_[i]);
+    }
+
+    double quantile_;
+    uint64_t count_ = 0;
+    std::array<double, MARKERS> heights_{};
+    std::array<int64_t, MARKERS> positions_{0, 1, 2, 3, 4};
+    std::array<double, MARKERS> desired_{};
+};
+
+/**
+ * @brief LatencySummary in a few hundred bytes, for per-symbol stats
+ *
+ * P2Quantile estimates of p50, p99 and p99.9 plus exact count, mean and
+ * max. Where one LatencyHistogram per stage is affordable, one per
+ * instrument across a whole universe is not (about 15 KB each); this
+ * trades the histogram's bounded error and merge() for constant size.
+ */
+class LatencySketch {
+public:
+    void record(uint64_t value_ns) {
+        double value = static_cast<double>(value_ns);
+        p50_.add(value);
+        p99_.add(value);
+        p999_.add(value);
+        sum_ += value_ns;
+        max_ = std::max(max_, value_ns);
+    }
+
+    uint64_t count() const { return p50_.count(); }
+    uint64_t max() const { return max_; }
+
+    /**
+     * @brief Estimated value at quantile 0.5, 0.99 or 0.999
+     */
+    uint64_t p50() const { return to_ns(p50_.value()); }
+    uint64_t p99() const { return to_ns(p99_.value()); }
+    uint64_t p999() const { return to_ns(p999_.value()); }
+
+    LatencySummary summary() const {
+        LatencySummary result;
+        result.count = count();
+        result.p50 = p50();
+        result.p99 = p99();
+        result.p999 = p999();
+        result.max = max_;
+        result.mean = result.count ? static_cast<double>(sum_) / static_cast<double>(result.count) : 0.0;
+        return result;
+    }
+
+    void reset() { *this = LatencySketch(); }
+
+private:
+    uint64_t to_ns(double value) const {
+        return std::min(static_cast<uint64_t>(std::max(value, 0.0) + 0.5), max_);
+    }
+
+    P2Quantile p50_{0.5};
+    P2Quantile p99_{0.99};
+    P2Quantile p999_{0.999};
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+} // namespace common
+} // namespace feedhandler
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief Statistics counter with one writer thread
+ *
+ * add() is a relaxed load and store, no locked read-modify-write, so it
+ * costs what a plain increment does; load() is safe from any thread.
+ * Only for counters that a single thread updates (a per-queue or
+ * per-worker struct). Aligned to a cache line so neighbours owned by
+ * other threads never share it.
+ */
+class alignas(64) LocalCounter {
+public:
+    LocalCounter() = default;
+    LocalCounter(const LocalCounter&) = delete;
+    LocalCounter& operator=(const LocalCounter&) = delete;
+
+    void add(uint64_t delta = 1) {
+        value_.store(value_.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    uint64_t load(std::memory_order order = std::memory_order_relaxed) const { return value_.load(order); }
+    operator uint64_t() const { return load(); }
+    void store(uint64_t value) { value_.store(value, std::memory_order_relaxed); }
+    void reset() { store(0); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+// Per-thread slots of a StatCounter; the last one is shared
+inline constexpr size_t STAT_COUNTER_SLOTS = 16;
+inline constexpr size_t STAT_COUNTER_SHARED_SLOT = STAT_COUNTER_SLOTS - 1;
+
+namespace detail {
+
+class CounterSlotRegistry {
+public:
+    static size_t acquire() {
+        std::lock_guard<std::mutex> lock(mutex());
+        uint32_t& used = in_use();
+        for (size_t slot = 0; slot < STAT_COUNTER_SHARED_SLOT; ++slot) {
+            if (!(used & (1u << slot))) {
+                used |= 1u << slot;
+                return slot;
+            }
+        }
+        return STAT_COUNTER_SHARED_SLOT;
+    }
+
+    static void release(size_t slot) {
+        if (slot < STAT_COUNTER_SHARED_SLOT) {
+            std::lock_guard<std::mutex> lock(mutex());
+            in_use() &= ~(1u << slot);
+        }
+    }
+
+private:
+    static std::mutex& mutex() {
+        static std::mutex instance;
+        return instance;
+    }
+
+    static uint32_t& in_use() {
+        static uint32_t bits = 0;
+        return bits;
+    }
+};
+
+struct ThreadCounterSlot {
+    ThreadCounterSlot() : index(CounterSlotRegistry::acquire()) {}
+    ~ThreadCounterSlot() { CounterSlotRegistry::release(index); }
+    const size_t index;
+};
+
+} // namespace detail
+
+/**
+ * @brief Slot of the calling thread in every StatCounter
+ *
+ * Threads get an exclusive slot on first use and give it back when they
+ * exit, so the slots cover the threads alive at once rather than every
+ * thread ever started. Beyond STAT_COUNTER_SLOTS - 1 live threads the
+ * rest share the last slot.
+ */
+inline size_t this_thread_counter_slot() {
+    thread_local detail::ThreadCounterSlot slot;
+    return slot.index;
+}
+
+/**
+ * @brief Statistics counter updated from several threads without sharing
+ *
+ * Each thread adds into its own cache line, with a relaxed load and store
+ * and no locked instruction, so counters bumped by the network and the
+ * parser thread no longer bounce one line between cores. load() sums
+ * the slots; it is the aggregate read API, callable from any thread, and
+ * like a relaxed atomic it may trail updates still in flight. Threads
+ * beyond the exclusive slots fall back to an atomic add on the shared
+ * one, so counts are never lost.
+ *
+ * The price is memory (STAT_COUNTER_SLOTS cache lines per counter) and a
+ * read proportional to the slot count: meant for statistics, not for
+ * values read on the hot path.
+ */
+class StatCounter {
+public:
+    StatCounter() = default;
+    StatCounter(const StatCounter&) = delete;
+    StatCounter& operator=(const StatCounter&) = delete;
+
+    void add(uint64_t delta = 1) {
+        size_t slot = this_thread_counter_slot();
+        std::atomic<uint64_t>& value = slots_[slot].value;
+        if (__builtin_expect(slot != STAT_COUNTER_SHARED_SLOT, 1)) {
+            value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        } else {
+            value.fetch_add(delta, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Sum over every thread's slot
+     */
+    uint64_t load(std::memory_order order = std::memory_order_relaxed) const {
+        uint64_t total = 0;
+        for (const Slot& slot : slots_) {
+            total += slot.value.load(order);
+        }
+        return total;
+    }
+
+    operator uint64_t() const { return load(); }
+
+    /**
+     * @brief Set the aggregate to value; writers should be quiet meanwhile
+     *
+     * A concurrent add() can write back a count read before the reset.
+     */
+    void store(uint64_t value) {
+        for (Slot& slot : slots_) {
+            slot.value.store(0, std::memory_order_relaxed);
+        }
+        slots_[this_thread_counter_slot()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void reset() { store(0); }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Slot, STAT_COUNTER_SLOTS> slots_;
+};
+
+} // namespace common
+} // namespace feedhandler
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief Dense integer handle for an interned instrument symbol
+ */
+using InstrumentId = uint32_t;
+
+/**
+ * @brief Sentinel for "no instrument" (unknown, too long or table full)
+ */
+constexpr InstrumentId INVALID_INSTRUMENT = UINT32_MAX;
+
+/**
+ * @brief Interns instrument symbols and hands out dense instrument IDs
+ *
+ * Each distinct symbol is stored once and gets the next ID (0, 1, 2, ...),
+ * so downstream consumers can route with a flat array indexed by ID
+ * instead of hashing strings.
+ *
+ * Lookups are lock-free (open addressing over atomic buckets); inserts
+ * of new symbols take a mutex. Capacity is fixed at construction so
+ * names never move and string_views returned by name() stay valid for
+ * the lifetime of the table.
+ *
+ * Typical use from a parser:
+ * @code
+ * tick.instrument_id = SymbolTable::global().intern(symbol);
+ * @endcode
+ */
+class SymbolTable {
+public:
+    static constexpr size_t MAX_SYMBOL_LENGTH = 31;
+
+    /**
+     * @brief Constructor
+     * @param max_symbols Maximum number of distinct symbols
+     */
+    explicit SymbolTable(size_t max_symbols = 65536)
+        : max_symbols_(max_symbols)
+        , entries_(new Entry[max_symbols])
+        , size_(0) {
+        size_t buckets = 16;
+        while (buckets < max_symbols * 2) {
+            buckets *= 2;
+        }
+        mask_ = buckets - 1;
+        buckets_.reset(new std::atomic<uint32_t>[buckets]);
+        for (size_t i = 0; i < buckets; ++i) {
+            buckets_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /**
+     * @brief Find or add symbol
+     * @return Instrument ID, or INVALID_INSTRUMENT if the symbol is empty,
+     *         longer than MAX_SYMBOL_LENGTH or the table is full
+     */
+    InstrumentId intern(std::string_view symbol) {
+        if (symbol.empty() || symbol.size() > MAX_SYMBOL_LENGTH) {
+            return INVALID_INSTRUMENT;
+        }
+
+        uint64_t h = hash(symbol);
+        InstrumentId id = probe(symbol, h);
+        if (__builtin_expect(id != INVALID_INSTRUMENT, 1)) {
+            return id;  // Fast path: already interned
+        }
+
+        std::lock_guard<std::mutex> lock(write_mutex_);
+
+        // Re-check under the lock: another thread may have added it
+        size_t bucket = static_cast<size_t>(h) & mask_;
+        while (uint32_t slot = buckets_[bucket].load(std::memory_order_acquire)) {
+            if (matches(entries_[slot - 1], symbol, h)) {
+                return slot - 1;
+            }
+            bucket = (bucket + 1) & mask_;
+        }
+
+        uint32_t count = size_.load(std::memory_order_relaxed);
+        if (count >= max_symbols_) {
+            return INVALID_INSTRUMENT;  // Table full
+        }
+
+        Entry& entry = entries_[count];
+        entry.hash = h;
+        entry.length = static_cast<uint8_t>(symbol.size());
+        std::memcpy(entry.name, symbol.data(), symbol.size());
+
+        // Publish: entry contents become visible before the bucket does
+        size_.store(count + 1, std::memory_order_release);
+        buckets_[bucket].store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Look up symbol without adding it
+     * @return Instrument ID, or INVALID_INSTRUMENT if not interned
+     */
+    InstrumentId find(std::string_view symbol) const {
+        if (symbol.empty() || symbol.size() > MAX_SYMBOL_LENGTH) {
+            return INVALID_INSTRUMENT;
+        }
+        return probe(symbol, hash(symbol));
+    }
+
+    /**
+     * @brief Symbol for an instrument ID
+     * @return Symbol, or empty view if id is unknown
+     */
+    std::string_view name(InstrumentId id) const {
+        if (id >= size_.load(std::memory_order_acquire)) {
+            return std::string_view();
+        }
+        const Entry& entry = entries_[id];
+        return std::string_view(entry.name, entry.length);
+    }
+
+    /**
+     * @brief Number of interned symbols (IDs are 0 .. size()-1)
+     */
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    size_t capacity() const { return max_symbols_; }
+
+    /**
+     * @brief Process-wide table shared by parsers and order books
+     */
+    static SymbolTable& global() {
+        static SymbolTable table;
+        return table;
+    }
+
+private:
+    struct Entry {
+        uint64_t hash;
+        uint8_t length;
+        char name[MAX_SYMBOL_LENGTH];
+    };
+
+    size_t max_symbols_;
+    std::unique_ptr<Entry[]> entries_;
+    std::unique_ptr<std::atomic<uint32_t>[]> buckets_;  // 0 = empty, else id + 1
+    size_t mask_;
+    std::atomic<uint32_t> size_;
+    std::mutex write_mutex_;
+
+    /**
+     * @brief FNV-1a, cheap for short ticker symbols
+     */
+    static uint64_t hash(std::string_view symbol) {
+        uint64_t h = 14695981039346656037ULL;
+        for (char c : symbol) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    static bool matches(const Entry& entry, std::string_view symbol, uint64_t h) {
+        return entry.hash == h && entry.length == symbol.size() &&
+               std::memcmp(entry.name, symbol.data(), symbol.size()) == 0;
+    }
+
+    InstrumentId probe(std::string_view symbol, uint64_t h) const {
+        size_t bucket = static_cast<size_t>(h) & mask_;
+        while (uint32_t slot = buckets_[bucket].load(std::memory_order_acquire)) {
+            if (matches(entries_[slot - 1], symbol, h)) {
+                return slot - 1;
+            }
+            bucket = (bucket + 1) & mask_;
+        }
+        return INVALID_INSTRUMENT;
+    }
+};
+
+} // namespace common
+} // namespace feedhandler
@@ -5,6 +5,9 @@
 #include <chrono>
 #include <cstring>
 #include <algorithm>
+#include "common/symbol_table.hpp"
+#include "common/compact_tick.hpp"
+#include "common/tsc_clock.hpp"
 
 namespace feedhandler {
 namespace common {
@@ -16,6 +19,10 @@ namespace common {
  * The symbol field points directly into the receive buffer.
  * 
  * @warning The symbol string_view must not outlive the source buffer
+ * 
+ * @note Hot paths should prefer CompactTick (32 bytes, trivially
+ *       copyable). Tick is kept for code that wants the symbol text;
+ *       convert with to_compact() / from_compact().
  */
 struct Tick {
     std::string_view symbol;  ///< Instrument symbol (points into buffer or symbol_storage_)
@@ -23,6 +30,8 @@ struct Tick {
     int32_t qty;             ///< Quantity/size
     char side;               ///< 'B' for Buy/Bid, 'S' for Sell/Ask
     uint64_t timestamp;      ///< Nanoseconds since Unix epoch
+    uint64_t sequence;       ///< Per-instrument sequence number, 0 if the feed supplies none
+    InstrumentId instrument_id; ///< Interned symbol ID (SymbolTable), INVALID_INSTRUMENT if not set
     
     // Optional symbol storage for when we need to own the symbol data
     char symbol_storage_[64];
@@ -31,21 +40,25 @@ struct Tick {
     /**
      * @brief Default constructor - creates invalid tick
      */
-    Tick() : symbol{}, price{0}, qty{0}, side{'\0'}, timestamp{0}, symbol_storage_{}, owns_symbol_(false) {}
+    Tick() : symbol{}, price{0}, qty{0}, side{'\0'}, timestamp{0}, sequence{0}, instrument_id{INVALID_INSTRUMENT},
+             symbol_storage_{}, owns_symbol_(false) {}
     
     /**
      * @brief Constructor with all fields
      */
     Tick(std::string_view sym, int64_t p, int32_t q, char s, uint64_t ts = 0)
         : symbol{sym}, price{p}, qty{q}, side{s}, 
-          timestamp{ts == 0 ? current_timestamp_ns() : ts}, symbol_storage_{}, owns_symbol_(false) {}
+          timestamp{ts == 0 ? current_timestamp_ns() : ts}, sequence{0}, instrument_id{INVALID_INSTRUMENT},
+          symbol_storage_{}, owns_symbol_(false) {}
     
     /**
      * @brief Copy constructor - fixes up symbol pointer if needed
      */
     Tick(const Tick& other) 
         : symbol{other.symbol}, price{other.price}, qty{other.qty}, 
-          side{other.side}, timestamp{other.timestamp}, owns_symbol_{other.owns_symbol_} {
+          side{other.side}, timestamp{other.timestamp}, sequence{other.sequence},
+          instrument_id{other.instrument_id},
+          owns_symbol_{other.owns_symbol_} {
         if (owns_symbol_) {
             // Copy the symbol storage and fix the pointer
             std::memcpy(symbol_storage_, other.symbol_storage_, sizeof(symbol_storage_));
@@ -58,7 +71,9 @@ struct Tick {
      */
     Tick(Tick&& other) noexcept
         : symbol{other.symbol}, price{other.price}, qty{other.qty}, 
-          side{other.side}, timestamp{other.timestamp}, owns_symbol_{other.owns_symbol_} {
+          side{other.side}, timestamp{other.timestamp}, sequence{other.sequence},
+          instrument_id{other.instrument_id},
+          owns_symbol_{other.owns_symbol_} {
         if (owns_symbol_) {
             // Copy the symbol storage and fix the pointer
             std::memcpy(symbol_storage_, other.symbol_storage_, sizeof(symbol_storage_));
@@ -76,6 +91,8 @@ struct Tick {
             qty = other.qty;
             side = other.side;
             timestamp = other.timestamp;
+            sequence = other.sequence;
+            instrument_id = other.instrument_id;
             owns_symbol_ = other.owns_symbol_;
             if (owns_symbol_) {
                 std::memcpy(symbol_storage_, other.symbol_storage_, sizeof(symbol_storage_));
@@ -97,6 +114,42 @@ struct Tick {
         owns_symbol_ = true;  // Mark that we own the symbol
     }
     
+    /**
+     * @brief Intern symbol in the global SymbolTable and store its ID
+     * @return Instrument ID (INVALID_INSTRUMENT if symbol cannot be interned)
+     */
+    InstrumentId intern_symbol() {
+        instrument_id = SymbolTable::global().intern(symbol);
+        return instrument_id;
+    }
+    
+    /**
+     * @brief Packed 32-byte form (interns the symbol if not done yet)
+     */
+    CompactTick to_compact() const {
+        CompactTick compact;
+        compact.price = price;
+        compact.timestamp = timestamp;
+        compact.instrument_id = (instrument_id != INVALID_INSTRUMENT)
+            ? instrument_id : SymbolTable::global().intern(symbol);
+        compact.qty = qty;
+        compact.side = side;
+        return compact;
+    }
+    
+    /**
+     * @brief Build Tick from packed form
+     * 
+     * The symbol view points into the global SymbolTable, which never
+     * moves its names, so no copy into symbol_storage_ is needed.
+     */
+    static Tick from_compact(const CompactTick& compact) {
+        Tick tick(compact.symbol(), compact.price, compact.qty, compact.side, compact.timestamp);
+        tick.timestamp = compact.timestamp;  // Keep 0 rather than "now"
+        tick.instrument_id = compact.instrument_id;
+        return tick;
+    }
+    
     /**
      * @brief Check if tick is valid
      */
@@ -106,11 +159,13 @@ struct Tick {
     }
     
     /**
-     * @brief Get current timestamp in nanoseconds
+     * @brief Get current timestamp in nanoseconds since the Unix epoch
+     * 
+     * Read from TscClock (cycle counter, calibrated against
+     * CLOCK_REALTIME) rather than a system_clock call per tick.
      */
     static uint64_t current_timestamp_ns() {
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
+        return TscClock::global().now_ns();
     }
 };
 
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include "common/compact_tick.hpp"
+#include "common/symbol_table.hpp"
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief Volume and price aggregates over the rows of a TickBatch
+ *
+ * Sums are exact integers in the ticks' own units (price fixed-point,
+ * scaled by 10000); notional wraps like int64 arithmetic past 2^63.
+ */
+struct TickBatchSummary {
+    size_t ticks = 0;
+    int64_t volume = 0;       ///< Sum of qty
+    int64_t bid_volume = 0;   ///< Sum of qty on side 'B'
+    int64_t ask_volume = 0;   ///< Sum of qty on side 'S'
+    int64_t notional = 0;     ///< Sum of price * qty
+    int64_t min_price = 0;    ///< 0 when empty
+    int64_t max_price = 0;
+
+    /**
+     * @brief Volume-weighted average price (fixed-point, as Tick::price), 0 without volume
+     */
+    double vwap() const {
+        return volume != 0 ? static_cast<double>(notional) / static_cast<double>(volume) : 0.0;
+    }
+
+    /**
+     * @brief (bid_volume - ask_volume) / (bid_volume + ask_volume), 0 without either
+     */
+    double imbalance() const {
+        int64_t sided = bid_volume + ask_volume;
+        return sided != 0 ? static_cast<double>(bid_volume - ask_volume) / static_cast<double>(sided) : 0.0;
+    }
+};
+
+/**
+ * @brief Fixed-capacity structure-of-arrays tick container
+ *
+ * Holds the CompactTick fields as separate columns (instrument ID,
+ * price, qty, side, timestamp), each on a 64-byte boundary, so a pass
+ * over one field reads only that field: summing prices streams 8 bytes
+ * per tick instead of striding over whole Ticks. Parsers fill it
+ * through their TickBatch overloads, which stop at a message boundary
+ * when the batch is full, exactly like TickSpan; summarize() reduces
+ * the columns with AVX2 when the CPU has it.
+ *
+ * @code
+ * TickBatch batch(1024);
+ * parser.parse(data, length, batch);
+ * TickBatchSummary all = batch.summarize();
+ * TickBatchSummary aapl = batch.summarize(SymbolTable::global().find("AAPL"));
+ * double vwap = aapl.vwap();
+ * engine.process_batch(batch);
+ * batch.clear();
+ * @endcode
+ */
+class TickBatch {
+public:
+    using value_type = CompactTick;
+    static constexpr size_t ALIGNMENT = 64;
+
+    explicit TickBatch(size_t capacity)
+        : capacity_(capacity) {
+        size_t offset = 0;
+        auto column = [&](size_t element) {
+            size_t start = offset;
+            offset += padded(capacity * element);
+            return start;
+        };
+        size_t prices = column(sizeof(int64_t));
+        size_t timestamps = column(sizeof(uint64_t));
+        size_t ids = column(sizeof(InstrumentId));
+        size_t qtys = column(sizeof(int32_t));
+        size_t sides = column(sizeof(char));
+        storage_.reset(static_cast<std::byte*>(std::aligned_alloc(ALIGNMENT, std::max(offset, ALIGNMENT))));
+        if (!storage_) {
+            throw std::bad_alloc();
+        }
+        prices_ = reinterpret_cast<int64_t*>(storage_.get() + prices);
+        timestamps_ = reinterpret_cast<uint64_t*>(storage_.get() + timestamps);
+        instrument_ids_ = reinterpret_cast<InstrumentId*>(storage_.get() + ids);
+        qtys_ = reinterpret_cast<int32_t*>(storage_.get() + qtys);
+        sides_ = reinterpret_cast<char*>(storage_.get() + sides);
+    }
+
+    TickBatch(const TickBatch&) = delete;
+    TickBatch& operator=(const TickBatch&) = delete;
+    TickBatch& operator=(TickBatch&&) = delete;
+
+    // Leaves other empty with no capacity
+    TickBatch(TickBatch&& other) noexcept
+        : storage_(std::move(other.storage_))
+        , prices_(std::exchange(other.prices_, nullptr))
+        , timestamps_(std::exchange(other.timestamps_, nullptr))
+        , instrument_ids_(std::exchange(other.instrument_ids_, nullptr))
+        , qtys_(std::exchange(other.qtys_, nullptr))
+        , sides_(std::exchange(other.sides_, nullptr))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , size_(std::exchange(other.size_, 0)) {}
+
+    /**
+     * @brief Append tick
+     * @return false (and nothing written) if the batch is full
+     */
+    bool push_back(const CompactTick& tick) {
+        if (size_ >= capacity_) {
+            return false;
+        }
+        prices_[size_] = tick.price;
+        timestamps_[size_] = tick.timestamp;
+        instrument_ids_[size_] = tick.instrument_id;
+        qtys_[size_] = tick.qty;
+        sides_[size_] = tick.side;
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief Append ticks until the batch is full
+     * @return Ticks appended
+     */
+    size_t append(std::span<const CompactTick> ticks) {
+        size_t count = std::min(ticks.size(), remaining());
+        for (size_t i = 0; i < count; ++i) {
+            push_back(ticks[i]);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Row i gathered back into a CompactTick
+     */
+    CompactTick operator[](size_t i) const {
+        CompactTick tick;
+        tick.price = prices_[i];
+        tick.timestamp = timestamps_[i];
+        tick.instrument_id = instrument_ids_[i];
+        tick.qty = qtys_[i];
+        tick.side = sides_[i];
+        return tick;
+    }
+
+    /**
+     * @brief Forget the rows so the storage can be refilled
+     */
+    void clear() { size_ = 0; }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    size_t remaining() const { return capacity_ - size_; }
+    bool empty() const { return size_ == 0; }
+    bool is_full() const { return size_ >= capacity_; }
+
+    // Columns, size() rows each, 64-byte aligned
+    std::span<const InstrumentId> instrument_ids() const { return {instrument_ids_, size_}; }
+    std::span<const int64_t> prices() const { return {prices_, size_}; }
+    std::span<const int32_t> quantities() const { return {qtys_, size_}; }
+    std::span<const char> sides() const { return {sides_, size_}; }
+    std::span<const uint64_t> timestamps() const { return {timestamps_, size_}; }
+
+    /**
+     * @brief Aggregates over every row
+     */
+    TickBatchSummary summarize() const;
+
+    /**
+     * @brief Aggregates over the rows of one instrument
+     */
+    TickBatchSummary summarize(InstrumentId instrument) const;
+
+    /**
+     * @brief Whether summarize() runs the AVX2 kernel on this CPU (detected once)
+     */
+    static bool simd_summaries();
+
+private:
+    static size_t padded(size_t bytes) { return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+    struct FreeDeleter {
+        void operator()(std::byte* p) const { std::free(p); }
+    };
+
+    std::unique_ptr<std::byte, FreeDeleter> storage_;
+    int64_t* prices_ = nullptr;
+    uint64_t* timestamps_ = nullptr;
+    InstrumentId* instrument_ids_ = nullptr;
+    int32_t* qtys_ = nullptr;
+    char* sides_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+};
+
+inline bool output_full(const TickBatch& out) { return out.is_full(); }
+
+} // namespace common
+} // namespace feedhandler
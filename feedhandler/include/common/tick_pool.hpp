@@ -1,40 +1,176 @@
 #pragma once
 
 #include "common/tick.hpp"
-#include <vector>
+#include "common/zero_latency_allocator.hpp"
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
 
 namespace feedhandler {
 namespace common {
 
 // Object pool for zero-allocation Tick management
 // Preallocates a fixed pool of Tick objects that can be reused
+// Bump allocation, released wholesale by reset(); single-threaded.
+// Use RecyclingTickPool for ticks released one by one on another thread.
 class TickPool {
 public:
+    using value_type = Tick;
+    
     explicit TickPool(size_t capacity = 1024);
     
+    // Place the ticks in a (huge-page, prefaulted) arena instead of the
+    // heap; the arena must outlive the pool. Falls back to the heap if
+    // the arena is too small.
+    TickPool(size_t capacity, ZeroLatencyAllocator::Arena& arena);
+    
+    // pool_ points into owned_ or the arena: moves keep it valid, copies would not
+    TickPool(const TickPool&) = delete;
+    TickPool& operator=(const TickPool&) = delete;
+    TickPool(TickPool&&) = default;
+    TickPool& operator=(TickPool&&) = default;
+    
     // Get next available tick slot (does not allocate)
     Tick* acquire();
     
+    // Copy tick into the next slot; false if the pool is exhausted
+    bool push_back(const Tick& tick) {
+        if (is_full()) {
+            return false;
+        }
+        pool_[next_index_++] = tick;
+        return true;
+    }
+    
     // Reset pool for reuse (does not deallocate)
     void reset();
     
-    // Get all active ticks
-    const std::vector<Tick>& get_ticks() const { return pool_; }
+    // Get all tick slots (the first size() are in use)
+    std::span<const Tick> get_ticks() const { return std::span<const Tick>(pool_, capacity_); }
     
     // Get number of ticks currently in use
     size_t size() const { return next_index_; }
     
     // Get pool capacity
-    size_t capacity() const { return pool_.capacity(); }
+    size_t capacity() const { return capacity_; }
     
     // Check if pool is full
-    bool is_full() const { return next_index_ >= pool_.size(); }
+    bool is_full() const { return next_index_ >= capacity_; }
+    
+    // Storage came from an arena
+    bool arena_backed() const { return owned_.empty() && capacity_ > 0; }
 
 private:
-    std::vector<Tick> pool_;      // Preallocated tick storage
+    Tick* pool_;                  // Preallocated tick storage
+    size_t capacity_;
+    std::vector<Tick> owned_;     // Heap storage when not arena-backed
     size_t next_index_;           // Next available slot
 };
 
+// Fixed-capacity Tick pool with individual release from any thread
+//
+// Free slots live on a lock-free global stack of slot indices. The head
+// carries a version tag next to the index, so a pop racing with a
+// pop/push of the same slot (ABA) fails its CAS instead of corrupting
+// the list.
+//
+// Hot threads go through a LocalCache: acquire/release hit a private
+// array and only touch the global stack once per batch (one CAS takes a
+// whole refill off the top, one splices a flushed batch back), so a
+// parser thread producing ticks and a consumer thread releasing them
+// exchange slots in batches instead of per tick. No allocation after
+// construction.
+//
+// Acquired ticks keep whatever a previous user wrote; overwrite all
+// fields before use.
+class RecyclingTickPool {
+public:
+    explicit RecyclingTickPool(size_t capacity = 1024);
+    
+    RecyclingTickPool(const RecyclingTickPool&) = delete;
+    RecyclingTickPool& operator=(const RecyclingTickPool&) = delete;
+    
+    // Take a free tick from the global stack; nullptr if exhausted
+    Tick* acquire();
+    
+    // Return a tick to the global stack (ignores pointers not from this pool)
+    void release(Tick* tick);
+    
+    // Check if tick belongs to this pool
+    bool owns(const Tick* tick) const {
+        return tick >= ticks_.get() && tick < ticks_.get() + capacity_;
+    }
+    
+    size_t capacity() const { return capacity_; }
+    
+    // Ticks currently on the global stack (approximate; excludes ticks
+    // parked in LocalCaches)
+    size_t global_free() const { return global_free_.load(std::memory_order_relaxed); }
+    
+    // Per-thread front end; one per thread, must not outlive the pool.
+    // Returns its cached ticks to the pool when destroyed.
+    class LocalCache {
+    public:
+        static constexpr size_t MAX_CACHED = 64;
+        
+        explicit LocalCache(RecyclingTickPool& pool, size_t batch = 32);
+        ~LocalCache();
+        
+        LocalCache(const LocalCache&) = delete;
+        LocalCache& operator=(const LocalCache&) = delete;
+        
+        // Take a tick, refilling from the global stack when empty
+        Tick* acquire();
+        
+        // Return a tick, flushing a batch to the global stack when full
+        void release(Tick* tick);
+        
+        // Give every cached tick back to the global stack
+        void flush();
+        
+        size_t cached() const { return count_; }
+    
+    private:
+        void flush_batch(size_t n);
+        
+        RecyclingTickPool& pool_;
+        size_t batch_;
+        size_t count_;
+        uint32_t slots_[MAX_CACHED];
+    };
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    
+    static uint64_t pack(uint32_t tag, uint32_t index) {
+        return (static_cast<uint64_t>(tag) << 32) | index;
+    }
+    static uint32_t index_of(uint64_t head) { return static_cast<uint32_t>(head); }
+    static uint32_t tag_of(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+    
+    uint32_t pop_index();
+    
+    // Pop up to n slots, top of the stack first, with a single CAS;
+    // returns how many were taken (fewer when the stack runs dry)
+    size_t pop_indices(uint32_t* slots, size_t n);
+    
+    // Push slots[0..n) as one chain with a single CAS
+    void push_indices(const uint32_t* slots, size_t n);
+    
+    uint32_t slot_of(const Tick* tick) const {
+        return static_cast<uint32_t>(tick - ticks_.get());
+    }
+    
+    size_t capacity_;
+    std::unique_ptr<Tick[]> ticks_;
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;  // Free-list links by slot index
+    
+    alignas(64) std::atomic<uint64_t> head_;         // (tag << 32) | index
+    alignas(64) std::atomic<size_t> global_free_;
+};
+
 } // namespace common
 } // namespace feedhandler
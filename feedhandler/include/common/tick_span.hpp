@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "common/tick.hpp"
+#include "common/compact_tick.hpp"
+#include "common/tick_pool.hpp"
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief Fixed-capacity output window over caller-owned tick storage
+ *
+ * Parsers write into a TickSpan instead of a std::vector when the
+ * hot loop must never grow a container or touch the allocator. The
+ * storage (stack array, ring buffer slot, preallocated vector) belongs
+ * to the caller; the span only tracks how much of it has been filled.
+ *
+ * @code
+ * std::array<CompactTick, 256> storage;
+ * TickSpan<CompactTick> out(storage);
+ * size_t consumed = parser.parse(data, length, out);
+ * // out.size() ticks written; resume at data + consumed once drained
+ * @endcode
+ */
+template<typename TickT>
+class TickSpan {
+public:
+    using value_type = TickT;
+
+    TickSpan(TickT* data, size_t capacity)
+        : data_(data), capacity_(capacity), size_(0) {}
+
+    explicit TickSpan(std::span<TickT> storage)
+        : TickSpan(storage.data(), storage.size()) {}
+
+    /**
+     * @brief Append tick
+     * @return false (and nothing written) if the span is full
+     */
+    bool push_back(const TickT& tick) {
+        if (size_ >= capacity_) {
+            return false;
+        }
+        data_[size_++] = tick;
+        return true;
+    }
+
+    /**
+     * @brief Forget written ticks so the storage can be refilled
+     */
+    void clear() { size_ = 0; }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    size_t remaining() const { return capacity_ - size_; }
+    bool empty() const { return size_ == 0; }
+    bool is_full() const { return size_ >= capacity_; }
+
+    TickT* data() { return data_; }
+    const TickT* data() const { return data_; }
+    TickT& operator[](size_t i) { return data_[i]; }
+    const TickT& operator[](size_t i) const { return data_[i]; }
+    TickT* begin() { return data_; }
+    TickT* end() { return data_ + size_; }
+    const TickT* begin() const { return data_; }
+    const TickT* end() const { return data_ + size_; }
+
+private:
+    TickT* data_;
+    size_t capacity_;
+    size_t size_;
+};
+
+/**
+ * @brief Whether a parser output can take another tick
+ *
+ * Lets one parse loop serve growable vectors and fixed-capacity
+ * outputs: vectors never report full.
+ */
+template<typename TickT>
+inline bool output_full(const std::vector<TickT>&) { return false; }
+
+template<typename TickT>
+inline bool output_full(const TickSpan<TickT>& out) { return out.is_full(); }
+
+inline bool output_full(const TickPool& out) { return out.is_full(); }
+
+} // namespace common
+} // namespace feedhandler
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "common/tsc_clock.hpp"
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief What a trace event marks: a stage starting, ending, or a point
+ */
+enum class TracePhase : uint8_t {
+    BEGIN,
+    END,
+    INSTANT
+};
+
+/**
+ * @brief One recorded event (24 bytes)
+ */
+struct TraceEvent {
+    uint64_t tsc = 0;          // TscClock::read_counter()
+    uint64_t seq = 0;          // Message this event belongs to, 0 for none
+    uint16_t stage = 0;        // Tracer::add_stage() ID
+    TracePhase phase = TracePhase::INSTANT;
+};
+
+/**
+ * @brief Fixed-size flight recorder for one thread
+ *
+ * record() is a counter read and three stores into a power-of-two ring;
+ * once full, the oldest events are overwritten, so the ring always holds
+ * the last capacity() events before a spike. One thread records;
+ * snapshot() may run on any thread at any time and returns only events
+ * the writer cannot have been overwriting meanwhile.
+ */
+class TraceRing {
+public:
+    /**
+     * @param capacity Events kept, rounded up to a power of two
+     */
+    explicit TraceRing(size_t capacity) : events_(std::bit_ceil(std::max<size_t>(capacity, 2))) {
+        mask_ = events_.size() - 1;
+    }
+
+    TraceRing(const TraceRing&) = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+
+    void record(uint16_t stage, TracePhase phase, uint64_t seq) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        TraceEvent& event = events_[head & mask_];
+        event.tsc = TscClock::read_counter();
+        event.seq = seq;
+        event.stage = stage;
+        event.phase = phase;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy the retained events, oldest first, into out (replaced)
+     * @return Events copied
+     */
+    size_t snapshot(std::vector<TraceEvent>& out) const {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        uint64_t first = head > events_.size() ? head - events_.size() : 0;
+        out.clear();
+        out.reserve(head - first);
+        for (uint64_t i = first; i < head; ++i) {
+            out.push_back(events_[i & mask_]);
+        }
+        // The writer may have lapped the oldest slots while we copied
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t now = head_.load(std::memory_order_relaxed);
+        uint64_t safe = now >= events_.size() ? now - events_.size() + 1 : 0;
+        if (safe > first) {
+            out.erase(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(std::min(safe - first, head - first)));
+        }
+        return out.size();
+    }
+
+    /**
+     * @brief Events recorded since construction, including overwritten ones
+     */
+    uint64_t recorded() const { return head_.load(std::memory_order_relaxed); }
+    size_t capacity() const { return events_.size(); }
+
+private:
+    std::vector<TraceEvent> events_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<uint64_t> head_{0};
+};
+
+/**
+ * @brief Snapshot of every thread's ring, in wall-clock nanoseconds
+ *
+ * What Tracer::capture() returns and the trace file holds; trace_dump
+ * turns it into Chrome trace / Perfetto JSON.
+ */
+struct TraceDump {
+    struct Event {
+        uint64_t ns = 0;       // Since the Unix epoch
+        uint64_t seq = 0;
+        uint16_t stage = 0;
+        TracePhase phase = TracePhase::INSTANT;
+    };
+    struct Thread {
+        uint32_t id = 0;       // Trace-local, in registration order from 1
+        std::string name;
+        std::vector<Event> events;  // Oldest first
+    };
+
+    std::vector<std::string> stages;  // Indexed by stage ID
+    std::vector<Thread> threads;
+
+    /**
+     * @brief Write the binary trace file (host byte order)
+     * @return false if the file cannot be written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @return false (reported on std::cerr) if the file is unreadable or
+     *         not a trace
+     */
+    static bool load(const std::string& path, TraceDump& dump);
+
+    /**
+     * @brief Chrome Trace Event Format, as loaded by Perfetto and chrome://tracing
+     *
+     * BEGIN/END pairs become slices per thread (an END whose BEGIN was
+     * overwritten is dropped), INSTANT events thread-scoped instants, and
+     * a message seen on more than one thread is joined by flow arrows
+     * from slice to slice, so the wait between one stage ending on one
+     * thread and the next starting on another is visible.
+     */
+    void write_chrome_json(std::ostream& out) const;
+};
+
+/**
+ * @brief Process-wide hot-path tracing: per-thread rings plus stage names
+ *
+ * Compiled into the pipeline but off by default: while disabled, trace()
+ * is one relaxed load and a branch. enable() turns it on (FeedPipeline
+ * does so for MonitoringConfig::enable_tracing); each thread's first
+ * event then allocates its ring, or the thread calls register_thread()
+ * up front to allocate it, and name it, before it goes hot.
+ *
+ * @code
+ * static const uint16_t PARSE = Tracer::global().add_stage("parse");
+ * TraceScope scope(PARSE, buffer.sequence);
+ * ...
+ * Tracer::global().capture().save("/tmp/feed.trace");  // then: trace_dump feed.trace
+ * @endcode
+ *
+ * Rings outlive their threads, so a trace captured after a thread was
+ * joined still has its events.
+ */
+class Tracer {
+public:
+    static constexpr uint16_t MAX_STAGES = 256;
+    static constexpr uint16_t INVALID_STAGE = MAX_STAGES;
+    static constexpr size_t DEFAULT_RING_EVENTS = 1 << 16;
+
+    Tracer() : id_(next_id()) {}
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    static Tracer& global() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+    void enable(bool on = true) { enabled_.store(on, std::memory_order_relaxed); }
+
+    /**
+     * @brief Ring size for threads that have none yet
+     */
+    void set_ring_events(size_t events) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ring_events_ = events;
+    }
+
+    /**
+     * @brief Stage ID for name, registering it the first time
+     * @return INVALID_STAGE when all MAX_STAGES are taken
+     */
+    uint16_t add_stage(std::string_view name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find(stages_.begin(), stages_.end(), name);
+        if (it != stages_.end()) {
+            return static_cast<uint16_t>(it - stages_.begin());
+        }
+        if (stages_.size() == MAX_STAGES) {
+            return INVALID_STAGE;
+        }
+        stages_.emplace_back(name);
+        return static_cast<uint16_t>(stages_.size() - 1);
+    }
+
+    /**
+     * @brief Allocate (and name) the calling thread's ring now
+     */
+    TraceRing& register_thread(std::string_view name) {
+        TraceRing& ring = thread_ring();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (ThreadRing& thread : threads_) {
+            if (thread.ring.get() == &ring) {
+                thread.name = name;
+            }
+        }
+        return ring;
+    }
+
+    /**
+     * @brief The calling thread's ring, created on first use
+     */
+    TraceRing& thread_ring() {
+        thread_local Cached cached;
+        if (cached.tracer != id_) {
+            cached.ring = &add_thread();
+            cached.tracer = id_;
+        }
+        return *cached.ring;
+    }
+
+    void record(uint16_t stage, TracePhase phase, uint64_t seq) {
+        if (enabled() && stage != INVALID_STAGE) {
+            thread_ring().record(stage, phase, seq);
+        }
+    }
+
+    /**
+     * @brief Snapshot every ring (any thread, while tracing runs)
+     */
+    TraceDump capture() const;
+
+    size_t thread_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return threads_.size();
+    }
+
+private:
+    struct ThreadRing {
+        uint64_t owner;  // thread_token()
+        std::string name;
+        std::unique_ptr<TraceRing> ring;
+    };
+    // By ID rather than address: a later tracer may reuse a dead one's
+    struct Cached {
+        uint64_t tracer = 0;
+        TraceRing* ring = nullptr;
+    };
+
+    const uint64_t id_;
+    std::atomic<bool> enabled_{false};
+    mutable std::mutex mutex_;
+    std::vector<std::string> stages_;
+    std::vector<ThreadRing> threads_;
+    size_t ring_events_ = DEFAULT_RING_EVENTS;
+
+    static uint64_t next_id() {
+        static std::atomic<uint64_t> ids{0};
+        return ids.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    // Unlike std::thread::id, never reused by a later thread
+    static uint64_t thread_token() {
+        static std::atomic<uint64_t> tokens{0};
+        thread_local uint64_t token = tokens.fetch_add(1, std::memory_order_relaxed) + 1;
+        return token;
+    }
+
+    // The calling thread's ring, found again if the thread uses several tracers
+    TraceRing& add_thread() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t self = thread_token();
+        for (ThreadRing& thread : threads_) {
+            if (thread.owner == self) {
+                return *thread.ring;
+            }
+        }
+        threads_.push_back({self, "thread-" + std::to_string(threads_.size() + 1),
+                            std::make_unique<TraceRing>(ring_events_)});
+        return *threads_.back().ring;
+    }
+};
+
+/**
+ * @brief Record an event on the global tracer (nothing while disabled)
+ */
+inline void trace(uint16_t stage, TracePhase phase, uint64_t seq = 0) {
+    Tracer::global().record(stage, phase, seq);
+}
+
+/**
+ * @brief BEGIN on construction, END on destruction
+ */
+class TraceScope {
+public:
+    TraceScope(uint16_t stage, uint64_t seq = 0) : stage_(stage), seq_(seq) {
+        trace(stage_, TracePhase::BEGIN, seq_);
+    }
+    ~TraceScope() { trace(stage_, TracePhase::END, seq_); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    uint16_t stage_;
+    uint64_t seq_;
+};
+
+} // namespace common
+} // namespace feedhandler
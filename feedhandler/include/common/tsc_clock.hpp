@@ -0,0 +1,245 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace feedhandler {
+namespace common {
+
+/**
+ * @brief Wall-clock nanoseconds from the CPU cycle counter
+ *
+ * now_ns() reads the TSC (x86) or the generic timer CNTVCT_EL0 (AArch64)
+ * and converts it with a multiply and shift against an anchor taken from
+ * CLOCK_REALTIME, instead of a clock_gettime() vDSO call per timestamp.
+ *
+ * The rate is measured once at startup (read from CNTFRQ_EL0 on AArch64)
+ * and then re-measured against CLOCK_REALTIME about every
+ * recalibration_interval_ns(): the first now_ns() past the interval
+ * re-anchors, so timestamps follow NTP slewing without a background
+ * thread. Readers never block; a re-anchor is published with a seqlock.
+ *
+ * Without an invariant TSC (or on other architectures) the cycle counter
+ * cannot be trusted across frequency changes and cores, so now_ns()
+ * falls back to clock_gettime(CLOCK_REALTIME); uses_counter() says which.
+ */
+class TscClock {
+public:
+    /**
+     * @brief Process-wide clock, calibrated on first use
+     */
+    static TscClock& global() {
+        static TscClock clock;
+        return clock;
+    }
+
+    /**
+     * @brief Raw cycle/timer counter (no serialization)
+     */
+    static uint64_t read_counter() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief Nanoseconds since the Unix epoch
+     */
+    uint64_t now_ns() {
+        if (!uses_counter_) {
+            return realtime_ns();
+        }
+        return to_ns(read_counter());
+    }
+
+    /**
+     * @brief Convert a read_counter() value to ns since the epoch
+     */
+    uint64_t to_ns(uint64_t counter) {
+        uint64_t base_counter;
+        uint64_t base_ns;
+        uint64_t mult;
+        uint32_t sequence;
+        do {
+            sequence = sequence_.load(std::memory_order_acquire);
+            base_counter = base_counter_.load(std::memory_order_relaxed);
+            base_ns = base_ns_.load(std::memory_order_relaxed);
+            mult = mult_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((sequence & 1) || sequence != sequence_.load(std::memory_order_relaxed));
+
+        uint64_t delta = counter - base_counter;
+        if (delta > recalibration_ticks_.load(std::memory_order_relaxed) && counter > base_counter) {
+            recalibrate();
+        }
+        if (counter < base_counter) {
+            return base_ns;  // Read before a concurrent re-anchor
+        }
+        return base_ns + scale(delta, mult);
+    }
+
+    /**
+     * @brief Counter ticks to nanoseconds (for durations)
+     */
+    uint64_t ticks_to_ns(uint64_t ticks) const {
+        if (!uses_counter_) {
+            return ticks;  // Fallback counter already counts ns
+        }
+        return scale(ticks, mult_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Re-anchor to CLOCK_REALTIME and re-measure the rate now
+     *
+     * Called automatically; a call that finds another in progress
+     * returns immediately.
+     */
+    void recalibrate() {
+        if (!uses_counter_ || updating_.test_and_set(std::memory_order_acquire)) {
+            return;
+        }
+        uint64_t counter;
+        uint64_t real = sample(counter);
+        uint64_t previous_counter = base_counter_.load(std::memory_order_relaxed);
+        uint64_t previous_ns = base_ns_.load(std::memory_order_relaxed);
+        uint64_t mult = mult_.load(std::memory_order_relaxed);
+        if (!fixed_rate_ && counter > previous_counter && real > previous_ns) {
+            mult = rate(real - previous_ns, counter - previous_counter);
+        }
+        publish(counter, real, mult);
+        updating_.clear(std::memory_order_release);
+    }
+
+    bool uses_counter() const { return uses_counter_; }
+
+    /**
+     * @brief Counter frequency in ticks per second (0 if not using the counter)
+     */
+    double frequency_hz() const {
+        uint64_t mult = mult_.load(std::memory_order_relaxed);
+        return uses_counter_ && mult ? 1e9 * 4294967296.0 / static_cast<double>(mult) : 0.0;
+    }
+
+    uint64_t recalibration_interval_ns() const { return recalibration_interval_ns_; }
+
+    static uint64_t realtime_ns() {
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    /**
+     * @brief True if the CPU advertises a constant-rate, always-running counter
+     */
+    static bool invariant_counter() {
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        return (edx & (1u << 8)) != 0;  // Invariant TSC
+#elif defined(__aarch64__)
+        return true;  // The generic timer runs at a fixed frequency
+#else
+        return false;
+#endif
+    }
+
+private:
+    static constexpr uint64_t STARTUP_WINDOW_NS = 10000000;          // 10 ms
+    static constexpr uint64_t DEFAULT_RECALIBRATION_NS = 1000000000; // 1 s
+
+    TscClock() : uses_counter_(invariant_counter()), recalibration_interval_ns_(DEFAULT_RECALIBRATION_NS) {
+        if (!uses_counter_) {
+            return;
+        }
+
+        uint64_t start_counter;
+        uint64_t start_ns = sample(start_counter);
+        uint64_t mult = 0;
+#if defined(__aarch64__)
+        uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        if (frequency != 0) {
+            mult = rate(1000000000ull, frequency);
+            fixed_rate_ = true;
+        }
+#endif
+        if (mult == 0) {
+            // Measure against the kernel clock over a short window
+            uint64_t end_counter;
+            uint64_t end_ns;
+            do {
+                end_ns = sample(end_counter);
+            } while (end_ns - start_ns < STARTUP_WINDOW_NS);
+            if (end_counter <= start_counter) {
+                uses_counter_ = false;
+                return;
+            }
+            mult = rate(end_ns - start_ns, end_counter - start_counter);
+            start_counter = end_counter;
+            start_ns = end_ns;
+        }
+
+        // Ticks per interval, from ns per tick in 32.32 fixed point
+        recalibration_ticks_.store((recalibration_interval_ns_ << 32) / mult, std::memory_order_relaxed);
+        publish(start_counter, start_ns, mult);
+    }
+
+    // (ns << 32) / ticks: ns per tick in 32.32 fixed point
+    static uint64_t rate(uint64_t ns, uint64_t ticks) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(ns) << 32) / ticks);
+    }
+
+    static uint64_t scale(uint64_t ticks, uint64_t mult) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(ticks) * mult) >> 32);
+    }
+
+    // CLOCK_REALTIME with the counter read at its midpoint
+    static uint64_t sample(uint64_t& counter) {
+        uint64_t before = read_counter();
+        uint64_t real = realtime_ns();
+        uint64_t after = read_counter();
+        counter = before + (after - before) / 2;
+        return real;
+    }
+
+    void publish(uint64_t counter, uint64_t ns, uint64_t mult) {
+        uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        base_counter_.store(counter, std::memory_order_relaxed);
+        base_ns_.store(ns, std::memory_order_relaxed);
+        mult_.store(mult, std::memory_order_relaxed);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    bool uses_counter_;
+    bool fixed_rate_ = false;
+    uint64_t recalibration_interval_ns_;
+    std::atomic<uint64_t> recalibration_ticks_{~uint64_t{0}};
+
+    // Seqlock-published anchor: realtime base_ns_ at counter base_counter_
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<uint64_t> base_counter_{0};
+    std::atomic<uint64_t> base_ns_{0};
+    std::atomic<uint64_t> mult_{0};
+    std::atomic_flag updating_ = ATOMIC_FLAG_INIT;
+};
+
+} // namespace common
+} // namespace feedhandler
@@ -3,6 +3,10 @@
 #include <cstddef>
 #include <sys/mman.h>
 #include <atomic>
+#include "config/performance_config.hpp"
+#include <cstdint>
+#include <new>
+#include <utility>
 
 namespace feedhandler {
 namespace common {
@@ -18,12 +22,62 @@ namespace common {
  * - NUMA-aware allocation
  * 
  * Performance: <1ns allocation time, zero fragmentation
+ * 
+ * allocate() is safe from any thread but every call is an atomic
+ * update of the shared offset. Hot threads should instead carve a
+ * private Arena with create_arena() and allocate from it without any
+ * atomics; an ArenaScope then frees everything a message or batch
+ * allocated when it goes out of scope.
+ * 
+ * @code
+ * ZeroLatencyAllocator region;
+ * ZeroLatencyAllocator::Arena arena = region.create_arena(1 << 20);  // Per thread
+ * for (...) {
+ *     ArenaScope scope(arena);          // Per message
+ *     auto* groups = static_cast<Entry*>(arena.allocate(n * sizeof(Entry), alignof(Entry)));
+ *     ...
+ * }                                     // Rolled back here
+ * @endcode
  */
 class ZeroLatencyAllocator {
 public:
     ZeroLatencyAllocator(size_t total_size = 1024 * 1024 * 1024); // 1GB default
+    
+    /**
+     * @brief Constructor with explicit page policy
+     * @param total_size Region size in bytes
+     * @param enable_huge_pages Try MAP_HUGETLB, then transparent huge pages
+     * @param prefault Touch every page up front so nothing faults mid-session
+     */
+    ZeroLatencyAllocator(size_t total_size, bool enable_huge_pages, bool prefault);
+    
+    /**
+     * @brief Constructor with explicit page policy, bound to a NUMA node
+     * @param numa_node Node whose memory backs the region (mbind before
+     *        prefaulting); -1, or a kernel that refuses, leaves the default policy
+     */
+    ZeroLatencyAllocator(size_t total_size, bool enable_huge_pages, bool prefault, int numa_node);
+    
+    /**
+     * @brief Constructor driven by PerformanceConfig
+     * 
+     * Uses zero_latency_pool_size, enable_huge_pages and prefault_memory.
+     */
+    explicit ZeroLatencyAllocator(const config::PerformanceConfig::MemoryConfig& memory);
+    
+    /**
+     * @brief Constructor driven by PerformanceConfig, on the configured node
+     * 
+     * As above; with enable_numa_allocation the region is bound to
+     * numa_node (CPUConfig::numa_node).
+     */
+    ZeroLatencyAllocator(const config::PerformanceConfig::MemoryConfig& memory, int numa_node);
+    
     ~ZeroLatencyAllocator();
     
+    ZeroLatencyAllocator(const ZeroLatencyAllocator&) = delete;
+    ZeroLatencyAllocator& operator=(const ZeroLatencyAllocator&) = delete;
+    
     /**
      * @brief Allocate memory with zero latency
      * @param size Number of bytes to allocate
@@ -55,18 +109,168 @@ public:
      * @brief Check if pointer was allocated by this allocator
      */
     bool owns(void* ptr) const noexcept;
+    
+    /**
+     * @brief true if the region is backed by huge pages (explicit or transparent)
+     */
+    bool huge_pages() const noexcept { return huge_pages_; }
+    
+    /**
+     * @brief true if every page was touched, at construction or by prefault_memory()
+     */
+    bool prefaulted() const noexcept { return prefaulted_; }
+    
+    /**
+     * @brief Touch every page of the region so none faults on first use
+     *
+     * Done at construction with prefault; call it during warm-up for a
+     * region built without. Contents are left as they are, so it is safe
+     * after allocations, but not while other threads write the region.
+     */
+    void prefault_memory();
+    
+    /**
+     * @brief Node the region is bound to, -1 if it follows the default policy
+     */
+    int numa_node() const noexcept { return numa_node_; }
+    
+    /**
+     * @brief Single-threaded bump arena carved from the allocator's region
+     * 
+     * Owned by one thread; allocate() is a plain pointer bump. Memory is
+     * returned with rollback()/reset() (or an ArenaScope), never per object.
+     * The chunk itself goes back to the region only on
+     * ZeroLatencyAllocator::reset().
+     */
+    class Arena {
+    public:
+        /**
+         * @brief Position to roll back to
+         */
+        struct Checkpoint {
+            size_t offset = 0;
+            size_t allocation_count = 0;
+        };
+        
+        Arena() = default;
+        Arena(char* base, size_t capacity) : base_(base), capacity_(capacity) {}
+        
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+        
+        Arena(Arena&& other) noexcept { *this = std::move(other); }
+        Arena& operator=(Arena&& other) noexcept {
+            base_ = std::exchange(other.base_, nullptr);
+            capacity_ = std::exchange(other.capacity_, 0);
+            offset_ = std::exchange(other.offset_, 0);
+            allocation_count_ = std::exchange(other.allocation_count_, 0);
+            return *this;
+        }
+        
+        /**
+         * @brief Allocate without atomics
+         * @param alignment Power of 2
+         * @return Pointer, or nullptr if the arena is exhausted
+         */
+        void* allocate(size_t size, size_t alignment = 8) noexcept {
+            if (size == 0) return nullptr;
+            
+            uintptr_t current = reinterpret_cast<uintptr_t>(base_) + offset_;
+            uintptr_t aligned = (current + alignment - 1) & ~(alignment - 1);
+            size_t new_offset = (aligned - reinterpret_cast<uintptr_t>(base_)) + size;
+            if (new_offset > capacity_) {
+                return nullptr;  // Exhausted
+            }
+            
+            offset_ = new_offset;
+            ++allocation_count_;
+            return reinterpret_cast<void*>(aligned);
+        }
+        
+        Checkpoint checkpoint() const noexcept { return Checkpoint{offset_, allocation_count_}; }
+        
+        /**
+         * @brief Free everything allocated since checkpoint cp
+         */
+        void rollback(const Checkpoint& cp) noexcept {
+            if (cp.offset <= offset_) {
+                offset_ = cp.offset;
+                allocation_count_ = cp.allocation_count;
+            }
+        }
+        
+        void reset() noexcept { rollback(Checkpoint{}); }
+        
+        /**
+         * @brief Construct a T in the arena (e.g. a whole queue, so its
+         *        inline storage lands in the huge-page region)
+         * 
+         * The arena never runs destructors; call p->~T() before rolling back.
+         * @return Pointer, or nullptr if the arena is exhausted
+         */
+        template<typename T, typename... Args>
+        T* create(Args&&... args) {
+            void* mem = allocate(sizeof(T), alignof(T));
+            return mem ? new (mem) T(std::forward<Args>(args)...) : nullptr;
+        }
+        
+        bool valid() const noexcept { return base_ != nullptr; }
+        size_t capacity() const noexcept { return capacity_; }
+        size_t used() const noexcept { return offset_; }
+        size_t remaining() const noexcept { return capacity_ - offset_; }
+        size_t allocation_count() const noexcept { return allocation_count_; }
+        
+        bool owns(const void* ptr) const noexcept {
+            const char* p = static_cast<const char*>(ptr);
+            return base_ && p >= base_ && p < base_ + capacity_;
+        }
+        
+    private:
+        char* base_ = nullptr;
+        size_t capacity_ = 0;
+        size_t offset_ = 0;
+        size_t allocation_count_ = 0;
+    };
+    
+    /**
+     * @brief Carve a private arena out of the region (one atomic bump)
+     * @param size Arena size in bytes (rounded up to a cache line)
+     * @return Arena, or an invalid arena (valid() == false) if the region is exhausted
+     */
+    Arena create_arena(size_t size) noexcept;
 
 private:
     void* memory_base_;
     size_t total_size_;
+    bool huge_pages_;
+    bool prefaulted_;
+    int numa_node_;
     std::atomic<size_t> current_offset_;
     std::atomic<size_t> allocation_count_;
     
     bool setup_huge_pages();
-    void prefault_memory();
+    bool bind_to_node(int numa_node);
     size_t align_size(size_t size, size_t alignment) const noexcept;
 };
 
+/**
+ * @brief Rolls an arena back to where it was on construction
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(ZeroLatencyAllocator::Arena& arena) noexcept
+        : arena_(arena), checkpoint_(arena.checkpoint()) {}
+    
+    ~ArenaScope() { arena_.rollback(checkpoint_); }
+    
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    ZeroLatencyAllocator::Arena& arena_;
+    ZeroLatencyAllocator::Arena::Checkpoint checkpoint_;
+};
+
 /**
  * @brief STL-compatible allocator wrapper
  */
@@ -78,6 +282,10 @@ public:
     ZeroLatencySTLAllocator(ZeroLatencyAllocator& allocator) 
         : allocator_(&allocator) {}
     
+    template<typename U>
+    ZeroLatencySTLAllocator(const ZeroLatencySTLAllocator<U>& other) noexcept
+        : allocator_(other.allocator_) {}
+    
     T* allocate(size_t n) {
         return static_cast<T*>(allocator_->allocate(n * sizeof(T), alignof(T)));
     }
@@ -87,9 +295,59 @@ public:
         (void)ptr; (void)n;
     }
 
+    template<typename U>
+    bool operator==(const ZeroLatencySTLAllocator<U>& other) const noexcept {
+        return allocator_ == other.allocator_;
+    }
+
 private:
+    template<typename U> friend class ZeroLatencySTLAllocator;
+    
     ZeroLatencyAllocator* allocator_;
 };
 
+/**
+ * @brief STL-compatible allocator over an Arena
+ * 
+ * For per-message containers inside an ArenaScope: individual
+ * deallocation is a no-op and the scope frees everything at once.
+ * Throws std::bad_alloc when the arena is exhausted.
+ */
+template<typename T>
+class ArenaSTLAllocator {
+public:
+    using value_type = T;
+    
+    ArenaSTLAllocator(ZeroLatencyAllocator::Arena& arena) noexcept
+        : arena_(&arena) {}
+    
+    template<typename U>
+    ArenaSTLAllocator(const ArenaSTLAllocator<U>& other) noexcept
+        : arena_(other.arena_) {}
+    
+    T* allocate(size_t n) {
+        void* ptr = arena_->allocate(n * sizeof(T), alignof(T));
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+    
+    void deallocate(T* ptr, size_t n) noexcept {
+        // No-op - freed by ArenaScope / Arena::rollback
+        (void)ptr; (void)n;
+    }
+    
+    template<typename U>
+    bool operator==(const ArenaSTLAllocator<U>& other) const noexcept {
+        return arena_ == other.arena_;
+    }
+
+private:
+    template<typename U> friend class ArenaSTLAllocator;
+    
+    ZeroLatencyAllocator::Arena* arena_;
+};
+
 } // namespace common
 } // namespace feedhandler
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace feedhandler {
+namespace config {
+
+/**
+ * @brief What the host offers, as far as tuning is concerned
+ *
+ * Read from sysfs and procfs (Linux). Fields that cannot be read stay
+ * zero or empty, so callers keep their defaults for them.
+ */
+struct HardwareTopology {
+    struct Cpu {
+        int id = 0;
+        int core = 0;        // Hyperthread siblings share it (unique across packages)
+        int package = 0;
+        int numa_node = 0;
+    };
+
+    std::vector<Cpu> cpus;               // Online CPUs by id
+    size_t physical_cores = 0;
+    std::vector<std::vector<int>> numa_nodes;  // CPUs of node i
+    std::vector<int> isolated_cpus;      // isolcpus=, kept off the scheduler
+    std::vector<int> usable_cpus;        // This process's affinity mask (cpuset, taskset)
+
+    size_t l1d_bytes = 0;
+    size_t l2_bytes = 0;
+    size_t l3_bytes = 0;
+    size_t cache_line_bytes = 0;
+
+    bool sse42 = false;
+    bool avx2 = false;
+    bool avx512bw = false;
+    bool neon = false;
+
+    size_t huge_page_bytes = 0;          // Default huge page size
+    size_t huge_pages_free = 0;          // Reserved and unused
+    std::string transparent_huge_pages;  // always, madvise or never
+
+    size_t logical_cpus() const { return cpus.size(); }
+
+    /**
+     * @brief One CPU per physical core (the lowest-numbered sibling), in id order
+     * @param numa_node Only this node's cores; -1 = all
+     */
+    std::vector<int> core_leaders(int numa_node = -1) const;
+};
+
+/**
+ * @brief Probe the running host
+ * @param sys_root Mount point of sysfs ("/sys"), overridable for tests
+ * @param proc_root Mount point of procfs ("/proc")
+ */
+HardwareTopology detect_hardware_topology(const std::string& sys_root = "/sys",
+                                          const std::string& proc_root = "/proc");
+
+/**
+ * @brief Parse a kernel CPU list such as "0-3,8,10-11"
+ * @return CPUs in the order listed; empty on malformed input
+ */
+std::vector<int> parse_cpu_list(std::string_view list);
+
+/**
+ * @brief Parse a sysfs cache size such as "48K" or "32M"
+ */
+size_t parse_cache_size(std::string_view size);
+
+} // namespace config
+} // namespace feedhandler
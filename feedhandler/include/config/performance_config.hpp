@@ -3,6 +3,9 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <utility>
+#include <vector>
+#include "config/hardware_topology.hpp"
 
 namespace feedhandler {
 namespace config {
@@ -48,6 +51,7 @@ public:
         bool enable_batching = true;
         size_t batch_size = 16;
         bool enable_backpressure = false;
+        std::string overflow_policy;  // block, drop_newest, drop_oldest, conflate ("" = per enable_backpressure)
     };
     
     struct MonitoringConfig {
@@ -56,6 +60,29 @@ public:
         bool enable_memory_profiling = false;
         int metrics_update_interval_ms = 1000;
         std::string metrics_output_file = "performance_metrics.json";
+        bool enable_tracing = false;            // common::Tracer rings for the pipeline threads
+        size_t trace_buffer_events = 65536;     // Events kept per thread (rounded up to a power of 2)
+        std::string trace_output_file;          // Written on FeedPipeline::stop() ("" = none); see trace_dump
+    };
+    
+    enum class TuningGoal {
+        LATENCY,     ///< Smallest batch and ring within 10% of the fastest
+        THROUGHPUT   ///< Fastest batch and ring outright
+    };
+    
+    /**
+     * @brief Microbenchmark timings behind the last auto_tune()
+     *
+     * Each entry is a candidate and its best-of-three cost in nanoseconds
+     * per message (parser) or per buffer (queue).
+     */
+    struct TuningResults {
+        std::vector<std::pair<std::string, double>> simd_levels;
+        std::vector<std::pair<size_t, double>> parser_batch_sizes;  // Messages per parse() call
+        std::vector<std::pair<size_t, double>> ring_sizes;
+        std::vector<std::pair<size_t, double>> queue_batch_sizes;   // Buffers per push/pop burst
+        TuningGoal goal = TuningGoal::LATENCY;
+        bool measured = false;
     };
     
     static PerformanceConfig& instance();
@@ -77,8 +104,28 @@ public:
     /**
      * @brief Auto-tune configuration based on hardware
      * Detects CPU capabilities, memory topology, etc.
+     *
+     * Probes the host (detect_hardware_topology()): pins the network and
+     * parser threads to separate physical cores (isolated ones first,
+     * never CPU 0 when there is a choice) on one NUMA node and enables
+     * huge pages and NUMA allocation where available. Then times the
+     * SIMD parser kernels, parse() batch sizes, ring sizes and queue
+     * bursts on synthetic traffic (well under a second) and keeps the
+     * winners per goal. Ring candidates start at the configured
+     * ring_buffer_size, so tuning never trades burst headroom for speed.
      */
-    void auto_tune();
+    void auto_tune(TuningGoal goal = TuningGoal::LATENCY);
+    
+    /**
+     * @brief auto_tune(), then save_to_file(output_file)
+     *
+     * The file also records the hardware and the timings behind each
+     * choice; load_from_file() skips those sections.
+     */
+    bool auto_tune(const std::string& output_file, TuningGoal goal = TuningGoal::LATENCY);
+    
+    const HardwareTopology& hardware() const { return hardware_; }
+    const TuningResults& tuning() const { return tuning_; }
     
     // Configuration accessors
     const CPUConfig& cpu() const { return cpu_config_; }
@@ -102,8 +149,11 @@ private:
     ParserConfig parser_config_;
     QueueConfig queue_config_;
     MonitoringConfig monitoring_config_;
+    HardwareTopology hardware_;
+    TuningResults tuning_;
     
     void detect_hardware_capabilities();
+    void run_microbenchmarks();
     void optimize_for_latency();
     void optimize_for_throughput();
 };
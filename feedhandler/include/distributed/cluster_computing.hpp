@@ -1,12 +1,34 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <functional>
 #include <unordered_map>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <future>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include "common/latency_histogram.hpp"
+#include "distributed/consistent_hash_ring.hpp"
+#include "distributed/gradient_codec.hpp"
+#include "distributed/map_reduce_scheduler.hpp"
+#include "distributed/near_cache.hpp"
+#include "distributed/symbol_load_balancer.hpp"
+#include "distributed/wire_protocol.hpp"
+#include "storage/lz_codec.hpp"
+#include "storage/tick_codec.hpp"
 
 namespace feedhandler {
 namespace distributed {
@@ -24,6 +46,18 @@ namespace distributed {
  * - Dynamic scaling
  * - Distributed caching
  * - Cross-datacenter replication
+ *
+ * Nodes talk in length-prefixed binary frames (wire_protocol.hpp) whose
+ * payloads are flat structs decoded in place. send_message() only
+ * appends to the destination's batch; flush_messages() writes each
+ * batch with one send() over a persistent TCP connection, or with one
+ * memcpy into a shared-memory ring when the peer runs on the same host
+ * (same ip_address as the local node).
+ *
+ * The first join_cluster() call registers the local node and opens its
+ * listening socket; later calls register peers. poll_messages() accepts
+ * connections, reads inbound TCP and shared-memory traffic and hands
+ * each frame to the message handler on the polling thread.
  */
 class ClusterManager {
 public:
@@ -48,13 +82,57 @@ public:
         uint32_t heartbeat_interval_ms = 1000;
         bool enable_auto_scaling = true;
         size_t max_nodes = 100;
+        bool shared_memory_transport = true;   // Co-located peers exchange frames through shared memory
+        size_t shm_channel_bytes = 1 << 20;    // Ring per direction between two co-located nodes
+        size_t max_batch_bytes = 64 * 1024;    // A peer's batch is flushed once it grows past this
+        uint32_t rebalance_interval_ms = 5000; // Rate reports and rebalancing rounds; 0 = neither
+        double rebalance_trigger = 0.25;       // Start moving symbols once the hottest node is this far over ideal
+        double rebalance_target = 0.10;        // ... and stop once it is back within this
+        size_t max_migrations_per_round = 4;
+        uint32_t migration_cooldown_ms = 30000; // A moved symbol stays put at least this long
+        uint32_t rate_half_life_ms = 10000;    // Of the per-symbol message rate average
+    };
+    
+    // Frames other than HEARTBEAT (which updates NodeInfo), on the polling thread
+    using MessageHandler = std::function<void(const std::string& from, const Frame& frame)>;
+    
+    struct TransportStats {
+        uint64_t frames_sent = 0;
+        uint64_t batches_sent = 0;      // send() calls or shared-memory writes
+        uint64_t bytes_sent = 0;
+        uint64_t frames_received = 0;
+        uint64_t bytes_received = 0;
+        uint64_t shm_batches = 0;       // Batches that went through shared memory
+        uint64_t send_failures = 0;     // Batches dropped: peer unreachable or ring full
+    };
+    
+    // Migrating symbols: the old owner stops processing and exports the
+    // state, the new one imports it and takes over (both on the polling
+    // thread, or the rebalancing thread when the coordinator is involved)
+    using SymbolStateExporter = std::function<std::vector<uint8_t>(const std::string& symbol)>;
+    using SymbolStateImporter = std::function<void(const std::string& symbol, const uint8_t* state, size_t size)>;
+    
+    struct RebalanceStats {
+        uint64_t rounds = 0;              // rebalance_workload() calls that moved symbols
+        uint64_t migrations = 0;          // Moves the coordinator started
+        uint64_t handoffs_sent = 0;       // Symbols this node exported
+        uint64_t handoffs_received = 0;   // Symbols this node imported
+        uint64_t handoff_bytes = 0;       // Exported state
+        double imbalance = 0.0;           // As of the last rebalance_workload()
     };
     
     ClusterManager(const ClusterConfig& config);
     ~ClusterManager();
     
+    ClusterManager(const ClusterManager&) = delete;
+    ClusterManager& operator=(const ClusterManager&) = delete;
+    
     /**
      * @brief Join cluster as a new node
+     *
+     * The first node joined is the local one: it listens on ip_address
+     * and port (port 0 picks a free one, written back to its NodeInfo).
+     * An empty node_id becomes "ip:port".
      * @param node_capabilities Node resource capabilities
      * @return Success status and assigned node ID
      */
@@ -68,6 +146,12 @@ public:
     
     /**
      * @brief Distribute workload across cluster nodes
+     *
+     * Once symbol rates are known (record_symbol_messages() here, rate
+     * reports from peers) symbols are placed by rate, weighted by each
+     * node's free CPU (SymbolLoadBalancer::place()); before that they are
+     * split evenly by count. The calling node becomes the coordinator
+     * that later rebalance_workload() rounds run on.
      * @param symbols List of symbols to process
      * @param processing_function Function to execute on each node
      * @return Distribution mapping
@@ -76,6 +160,69 @@ public:
     distribute_workload(const std::vector<std::string>& symbols,
                        const std::function<void(const std::vector<std::string>&)>& processing_function);
     
+    /**
+     * @brief Per-symbol message counter; bump it once per message processed
+     *
+     * The reference stays valid for the manager's lifetime, so the hot
+     * path can look it up once per symbol.
+     */
+    std::atomic<uint64_t>& symbol_counter(std::string_view symbol) { return symbol_rates_.counter(symbol); }
+    void record_symbol_messages(std::string_view symbol, uint64_t messages = 1) {
+        symbol_rates_.record(symbol, messages);
+    }
+    
+    /**
+     * @brief Messages per second of symbol as last sampled (or reported by its owner)
+     */
+    double symbol_rate(std::string_view symbol) const { return symbol_rates_.rate(symbol); }
+    
+    /**
+     * @brief Hooks that carry a symbol's processing state (e.g. its order book) when it migrates
+     *
+     * Set on every node before start(). Without them, migrated symbols are
+     * reassigned with WORKLOAD_ASSIGNMENT frames, as on failover.
+     */
+    void set_symbol_handoff(SymbolStateExporter exporter, SymbolStateImporter importer);
+    
+    /**
+     * @brief One incremental rebalancing round (coordinator only)
+     *
+     * Samples the symbol rates and moves up to max_migrations_per_round
+     * symbols off the hottest nodes (SymbolLoadBalancer::plan()): each
+     * moved symbol's old owner gets a SYMBOL_MIGRATE and sends its state
+     * straight to the new one. Runs every rebalance_interval_ms once
+     * start()ed; other nodes report their rates to the coordinator at
+     * the same interval.
+     * @return Symbols moved
+     */
+    size_t rebalance_workload();
+    
+    RebalanceStats get_rebalance_stats() const;
+    
+    struct MapReduceOptions {
+        size_t tasks_per_node = 4;              // Map partitions per participating node
+        size_t worker_threads = 0;              // Local map threads; 0 = hardware concurrency
+        size_t combine_threshold = 4096;        // Run the combiner once a task buffers this many results
+        double speculation_factor = 2.0;        // Back up tasks running past this x the median task time
+        double speculation_min_progress = 0.5;  // ... once this fraction of the job is done
+        uint32_t speculation_delay_ms = 50;     // Never back up a task younger than this
+        uint32_t timeout_ms = 30000;
+        std::vector<std::string> input_locations;  // Node holding input_data[i]; empty = anywhere
+    };
+    
+    // Pre-reduces a task's intermediate results in place before they are shuffled
+    template<typename IntermediateType>
+    using Combiner = std::function<void(std::vector<IntermediateType>&)>;
+    
+    struct MapReduceStats {
+        uint64_t jobs = 0;
+        uint64_t tasks_run = 0;            // Local map tasks whose result was kept
+        uint64_t remote_partitions = 0;    // Results that came from peers
+        uint64_t speculative_tasks = 0;
+        uint64_t speculative_wins = 0;     // Backups that beat the original
+        uint64_t shuffle_bytes = 0;        // Combined results sent to peers
+    };
+    
     /**
      * @brief Execute distributed computation
      * @param task_name Unique task identifier
@@ -91,6 +238,35 @@ public:
         std::function<std::vector<IntermediateType>(const InputType&)> map_function,
         std::function<OutputType(const std::vector<IntermediateType>&)> reduce_function);
     
+    /**
+     * @brief execute_map_reduce() with a combiner and placement options
+     *
+     * Runs SPMD: every healthy node calls it with the same task_name and
+     * input_data. input_data is cut into partitions; inputs with a
+     * location stay on that node, the rest are spread by free CPU
+     * (1 - NodeInfo::cpu_utilization). Each node maps its partitions on
+     * worker threads, streaming map output through the combiner whenever
+     * combine_threshold results are buffered, and sends each combined
+     * partition to its peers as soon as it is done. Slow partitions, a
+     * peer's included, are re-executed speculatively and the first result
+     * wins. Every node then reduces all partitions in partition order, so
+     * each future holds the same output.
+     *
+     * Only trivially copyable intermediates can be shuffled; otherwise the
+     * whole job runs on this node. The future throws std::runtime_error
+     * after timeout_ms. task_name must be unique among running jobs.
+     */
+    template<typename InputType, typename IntermediateType, typename OutputType>
+    std::future<OutputType> execute_map_reduce(
+        const std::string& task_name,
+        const std::vector<InputType>& input_data,
+        std::function<std::vector<IntermediateType>(const InputType&)> map_function,
+        std::function<OutputType(const std::vector<IntermediateType>&)> reduce_function,
+        Combiner<IntermediateType> combiner,
+        const MapReduceOptions& options);
+    
+    MapReduceStats get_map_reduce_stats() const;
+    
     /**
      * @brief Get cluster status and health
      */
@@ -110,13 +286,100 @@ public:
      * @param enable Enable/disable automatic failover
      */
     void set_auto_failover(bool enable);
+    
+    /**
+     * @brief Start the heartbeat thread (the local node must have joined)
+     */
+    bool start();
+    void stop();
+    
+    /**
+     * @brief Queue a frame for node_id; sent by the next flush_messages()
+     *
+     * A batch past max_batch_bytes is flushed immediately.
+     * @return false if node_id is unknown or the payload is too large
+     */
+    bool send_message(const std::string& node_id, MessageType type, const void* payload, size_t length);
+    
+    /**
+     * @brief Queue a frame for every other healthy node
+     */
+    void broadcast_message(MessageType type, const void* payload, size_t length);
+    
+    /**
+     * @brief Send every queued batch
+     * @return Frames sent
+     */
+    size_t flush_messages();
+    
+    /**
+     * @brief Dispatch inbound frames, waiting up to timeout_ms for TCP traffic
+     * @return Frames received
+     */
+    size_t poll_messages(int timeout_ms = 0);
+    
+    /**
+     * @brief send_message() and flush the batch right away
+     *
+     * A batch dropped because the peer's shared-memory ring is full is
+     * resent, polling inbound traffic in between so peers blocked on this
+     * node can drain. Not for use inside a message handler.
+     * @return false if node_id is unknown or timeout_ms passed
+     */
+    bool send_message_now(const std::string& node_id, MessageType type, const void* payload, size_t length,
+                          uint32_t timeout_ms);
+    
+    void set_message_handler(MessageHandler handler);
+    
+    /**
+     * @brief Route frames of one type to handler instead of the default one
+     *
+     * Lets components (e.g. DistributedCache) own their message types
+     * side by side. Register before traffic of that type arrives.
+     */
+    void set_message_handler(MessageType type, MessageHandler handler);
+    
+    /**
+     * @brief Bumped whenever a node joins, leaves or changes health
+     *
+     * Cheap to poll: placement built from get_cluster_status() is stale
+     * once this moves.
+     */
+    uint64_t membership_epoch() const { return membership_epoch_.load(std::memory_order_acquire); }
+    
+    const std::string& local_node_id() const { return local_node_id_; }
+    TransportStats get_transport_stats() const;
 
 private:
+    struct Transport;   // Sockets, shared-memory channels and batches (cluster_computing.cpp)
+    
     ClusterConfig config_;
     std::string local_node_id_;
     std::unordered_map<std::string, NodeInfo> cluster_nodes_;
+    std::unordered_map<uint32_t, std::string> node_of_hash_;  // FrameHeader::sender to node ID
+    mutable std::mutex nodes_mutex_;
+    
+    std::unique_ptr<Transport> transport_;
+    MessageHandler message_handler_;
+    std::unordered_map<uint16_t, MessageHandler> typed_handlers_;  // By MessageType
+    std::atomic<uint64_t> membership_epoch_{0};
+    std::function<void(const std::vector<std::string>&)> workload_function_;  // From the last distribute_workload()
+    std::string coordinator_;  // Sender of the last workload assignment, or this node after distribute_workload()
+    
+    SymbolRateTracker symbol_rates_;
+    SymbolStateExporter symbol_exporter_;
+    SymbolStateImporter symbol_importer_;
+    std::mutex rebalance_mutex_;       // Serializes rebalancing rounds
+    SymbolLoadBalancer balancer_;
+    std::atomic<double> last_imbalance_{0.0};
+    std::atomic<uint64_t> rebalance_rounds_{0};
+    std::atomic<uint64_t> migrations_{0};
+    std::atomic<uint64_t> handoffs_sent_{0};
+    std::atomic<uint64_t> handoffs_received_{0};
+    std::atomic<uint64_t> handoff_bytes_{0};
     
     std::atomic<bool> running_;
+    std::atomic<bool> auto_failover_{true};
     std::thread heartbeat_thread_;
     std::thread load_balancer_thread_;
     
@@ -124,10 +387,46 @@ private:
     void load_balance_loop();
     void handle_node_failure(const std::string& node_id);
     void redistribute_workload();
+    void send_assignments(const std::unordered_map<std::string, std::vector<std::string>>& assignments,
+                          const std::function<void(const std::vector<std::string>&)>& local_function);
+    
+    void handle_frame(const Frame& frame);
+    std::string channel_name(const std::string& from, const std::string& to) const;
     
-    // Network communication
-    bool send_message(const std::string& node_id, const std::string& message);
-    void broadcast_message(const std::string& message);
+    // Partitions of one execute_map_reduce() call on this node's membership view
+    struct MapReducePlan {
+        std::vector<std::vector<size_t>> partitions;  // Input indices
+        std::vector<bool> local;                      // Owned by this node
+        std::vector<std::string> peers;               // Other participants
+    };
+    MapReducePlan plan_map_reduce(size_t inputs, const MapReduceOptions& options, bool distributed) const;
+    
+    // Shuffle of combined partitions: received segments are reassembled per
+    // job until the job takes them (cluster_computing.cpp)
+    struct Shuffle;
+    mutable std::mutex shuffle_mutex_;
+    std::unordered_map<uint64_t, std::unique_ptr<Shuffle>> shuffles_;
+    std::vector<uint64_t> closed_shuffles_;  // Recent jobs whose late frames are dropped
+    std::atomic<uint64_t> map_reduce_jobs_{0};
+    std::atomic<uint64_t> map_reduce_tasks_{0};
+    std::atomic<uint64_t> map_reduce_remote_{0};
+    std::atomic<uint64_t> map_reduce_speculative_{0};
+    std::atomic<uint64_t> map_reduce_speculative_wins_{0};
+    std::atomic<uint64_t> map_reduce_shuffle_bytes_{0};
+    
+    void open_shuffle(uint64_t job);
+    void close_shuffle(uint64_t job);
+    bool publish_partition(uint64_t job, uint32_t partition, const void* data, size_t size,
+                           const std::vector<std::string>& peers, uint32_t timeout_ms);
+    bool take_partition(uint64_t job, uint32_t& partition, std::vector<uint8_t>& data);
+    void on_map_reduce_partition(const Frame& frame);
+    
+    // Symbol migration (cluster_computing.cpp)
+    void report_symbol_rates(const std::string& coordinator);
+    void on_symbol_rates(const std::string& from, const Frame& frame);
+    void on_symbol_migrate(const Frame& frame);
+    void on_symbol_handoff(const Frame& frame);
+    bool hand_off_symbol(const std::string& symbol, const std::string& to, bool polling_thread);
     
     // Load balancing algorithms
     std::vector<std::string> select_optimal_nodes(size_t required_nodes);
@@ -136,6 +435,24 @@ private:
 
 /**
  * @brief Distributed cache for market data
+ *
+ * Keys are placed on the healthy cluster nodes with a ConsistentHashRing
+ * and written to replication_factor consecutive nodes on it, so a node
+ * leaving moves only its own arcs and their next replica already holds
+ * the data. Reads of keys stored elsewhere go through a local LRU
+ * near-cache and, on a miss, one CACHE_GET round trip to the owner;
+ * "strong" consistency skips the near-cache and asks the owner only.
+ *
+ * Reads look keys up by string_view and fill caller buffers, so a local
+ * or near-cache hit neither allocates nor copies the key.
+ *
+ * With enable_compression, values of compression_min_bytes or more are
+ * LZ-compressed once at put() and stay compressed on the wire, in every
+ * replica and in near-caches; readers decompress straight into their
+ * buffer. put_ticks() / put_levels() add the delta encoding of
+ * tick_codec.hpp underneath, which is where market data gets its 10x. Remote reads
+ * poll the ClusterManager while they wait; the owner must be polling
+ * its own to answer.
  */
 class DistributedCache {
 public:
@@ -145,9 +462,19 @@ public:
         size_t replication_factor = 2;
         bool enable_compression = true;
         std::string consistency_level = "eventual"; // "strong" or "eventual"
+        size_t virtual_nodes = ConsistentHashRing::DEFAULT_VIRTUAL_NODES;
+        size_t near_cache_mb = 64;          // Values owned by other nodes
+        uint32_t near_cache_ttl_ms = 100;   // Staleness bound of a near-cache hit
+        uint32_t remote_timeout_ms = 50;    // Per replica tried by a remote read
+        int compression_level = storage::FAST_LEVEL;  // lz_codec level, FAST_LEVEL..MAX_LEVEL
+        size_t compression_min_bytes = 64;  // Smaller values are stored as is
     };
     
     DistributedCache(const CacheConfig& config, ClusterManager& cluster);
+    ~DistributedCache();
+    
+    DistributedCache(const DistributedCache&) = delete;
+    DistributedCache& operator=(const DistributedCache&) = delete;
     
     /**
      * @brief Store data in distributed cache
@@ -156,22 +483,55 @@ public:
      * @param ttl_seconds Time to live (optional override)
      * @return Success status
      */
+    bool put(std::string_view key, const uint8_t* data, size_t size, uint32_t ttl_seconds = 0);
     bool put(const std::string& key, const std::vector<uint8_t>& data, 
-             uint32_t ttl_seconds = 0);
+             uint32_t ttl_seconds = 0) {
+        return put(std::string_view(key), data.data(), data.size(), ttl_seconds);
+    }
     
     /**
-     * @brief Retrieve data from distributed cache
+     * @brief Retrieve data into out, reusing its capacity
+     * @return false if the key is not cached
+     */
+    bool get(std::string_view key, std::vector<uint8_t>& out);
+    
+    /**
+     * @brief Retrieve data into a caller buffer
+     * @param length Value size when found, also when buffer is too small
+     * @return false if the key is not cached or buffer is too small
+     */
+    bool get(std::string_view key, std::span<uint8_t> buffer, size_t& length);
+    
+    /**
+     * @brief Retrieve data from distributed cache (allocates; prefer the overloads above)
      * @param key Cache key
      * @return Cached data (empty if not found)
      */
     std::vector<uint8_t> get(const std::string& key);
     
+    /**
+     * @brief Store ticks delta-encoded (and compressed, if enabled)
+     */
+    bool put_ticks(std::string_view key, std::span<const common::CompactTick> ticks, uint32_t ttl_seconds = 0);
+    bool get_ticks(std::string_view key, std::vector<common::CompactTick>& ticks);
+    
+    /**
+     * @brief Store book levels delta-encoded (and compressed, if enabled)
+     */
+    bool put_levels(std::string_view key, std::span<const storage::BookLevel> levels, uint32_t ttl_seconds = 0);
+    bool get_levels(std::string_view key, std::vector<storage::BookLevel>& levels);
+    
     /**
      * @brief Remove data from cache
      * @param key Cache key
      * @return Success status
      */
-    bool remove(const std::string& key);
+    bool remove(std::string_view key);
+    
+    /**
+     * @brief Node that owns key under the current membership
+     */
+    std::string owner_of(std::string_view key);
     
     /**
      * @brief Get cache statistics
@@ -183,48 +543,122 @@ public:
         uint64_t get_operations;
         uint64_t put_operations;
         double average_latency_ms;
+        uint64_t near_cache_hits;
+        uint64_t remote_gets;           // CACHE_GET round trips
+        double compression_ratio;       // Bytes put / bytes stored
     };
     
     CacheStats get_stats() const;
 
 private:
+    struct Entry {
+        std::vector<uint8_t> data;
+        uint64_t expires_ns;
+    };
+    
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+    };
+    
+    // A remote read in flight; the CACHE_VALUE handler fills it
+    struct PendingRead {
+        std::string_view key;
+        std::vector<uint8_t>* vector_out;
+        std::span<uint8_t> buffer_out;
+        size_t length;
+        bool found;
+        bool done;
+    };
+    
     CacheConfig config_;
     ClusterManager& cluster_;
+    bool strong_;
     
-    std::unordered_map<std::string, std::vector<uint8_t>> local_cache_;
-    std::unordered_map<std::string, uint64_t> expiry_times_;
-    
+    std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>> local_cache_;
+    size_t local_bytes_ = 0;
     mutable std::shared_mutex cache_mutex_;
     
-    std::string hash_key_to_node(const std::string& key);
-    std::vector<uint8_t> compress_data(const std::vector<uint8_t>& data);
-    std::vector<uint8_t> decompress_data(const std::vector<uint8_t>& compressed_data);
+    NearCache near_cache_;
+    std::mutex near_mutex_;
+    
+    std::shared_ptr<const ConsistentHashRing> ring_;  // Replaced whole on membership change
+    uint64_t ring_epoch_ = UINT64_MAX;
+    mutable std::mutex ring_mutex_;
+    
+    std::unordered_map<uint64_t, PendingRead*> pending_;
+    uint64_t next_request_ = 1;
+    std::mutex pending_mutex_;
+    
+    std::atomic<uint64_t> gets_{0};
+    std::atomic<uint64_t> puts_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> near_hits_{0};
+    std::atomic<uint64_t> remote_gets_{0};
+    std::atomic<uint64_t> latency_ns_{0};
+    std::atomic<uint64_t> bytes_in_{0};
+    std::atomic<uint64_t> bytes_stored_{0};
+    
+    std::shared_ptr<const ConsistentHashRing> current_ring();
+    bool read(std::string_view key, PendingRead& read);
+    bool read_local(std::string_view key, PendingRead& read);
+    bool read_remote(const std::string& node, PendingRead& read);
+    bool store_local(std::string_view key, const uint8_t* data, size_t size, uint32_t ttl_seconds);
+    void erase_local(std::string_view key);
+    
+    void on_put(const Frame& frame);
+    void on_get(const std::string& from, const Frame& frame);
+    void on_value(const Frame& frame);
+    void on_remove(const Frame& frame);
+    
+    // Values travel and rest in a tagged stored form: raw or LZ-compressed
+    const std::vector<uint8_t>& compress_data(const uint8_t* data, size_t size);
+    static bool decompress_data(const uint8_t* stored, size_t size, PendingRead& read);
 };
 
 /**
  * @brief Distributed stream processing engine
+ *
+ * Each stream micro-batches its backlog: the processing thread flushes as
+ * soon as batch_size records wait or the oldest has waited the flush
+ * interval, whichever comes first, so light traffic still sees bounded
+ * (sub-millisecond if configured) latency and heavy traffic amortises the
+ * wakeup over a whole batch. Offsets are checkpointed incrementally by a
+ * separate thread that only swaps out what changed.
  */
 class StreamProcessor {
 public:
     using StreamFunction = std::function<void(const std::string& symbol, 
                                             const std::vector<uint8_t>& data)>;
+
+    /**
+     * @brief Offsets (last processed sequence per symbol) changed since the last checkpoint
+     */
+    using CheckpointOffsets = std::unordered_map<std::string, uint64_t>;
+    using CheckpointSink = std::function<void(const std::string& stream_handle,
+                                              const CheckpointOffsets& changed)>;
     
     struct StreamConfig {
-        size_t buffer_size = 10000;
-        size_t batch_size = 100;
-        uint32_t flush_interval_ms = 10;
-        bool enable_exactly_once = true;
+        size_t buffer_size = 10000;        ///< Backlog slots; publish() fails when full
+        size_t batch_size = 100;           ///< Flush as soon as this many records wait
+        uint32_t flush_interval_ms = 10;   ///< ... or when the oldest has waited this long
+        uint32_t flush_interval_us = 0;    ///< Overrides flush_interval_ms when nonzero
+        bool enable_exactly_once = true;   ///< Drop records at or below a symbol's offset
         size_t checkpoint_interval_ms = 5000;
     };
     
     StreamProcessor(const StreamConfig& config, ClusterManager& cluster);
+    ~StreamProcessor();
+
+    StreamProcessor(const StreamProcessor&) = delete;
+    StreamProcessor& operator=(const StreamProcessor&) = delete;
     
     /**
      * @brief Create distributed stream processing pipeline
      * @param stream_name Unique stream identifier
      * @param input_sources List of input data sources
      * @param processing_function Stream processing function
-     * @return Stream handle
+     * @return Stream handle, or empty if the name is taken
      */
     std::string create_stream(const std::string& stream_name,
                              const std::vector<std::string>& input_sources,
@@ -238,9 +672,35 @@ public:
     
     /**
      * @brief Stop stream processing
+     *
+     * Drains the backlog, then writes a final checkpoint.
      * @param stream_handle Stream to stop
      */
     void stop_stream(const std::string& stream_handle);
+
+    /**
+     * @brief Queue one record for the stream (any thread, never blocks on processing)
+     *
+     * Records are copied into preallocated backlog slots whose buffers are
+     * reused, so steady-state publishing does not allocate.
+     * @param sequence Per-symbol sequence for exactly-once; 0 disables the check
+     * @return false if the stream is unknown or its backlog is full
+     */
+    bool publish(const std::string& stream_handle, std::string_view symbol,
+                 const uint8_t* data, size_t size, uint64_t sequence = 0);
+
+    /**
+     * @brief Receive incremental checkpoints (set before starting streams)
+     *
+     * Called from the stream's checkpoint thread with only the offsets that
+     * changed since the previous call, so processing never waits for it.
+     */
+    void set_checkpoint_sink(CheckpointSink sink);
+
+    /**
+     * @brief Seed a stopped stream's offsets, e.g. from merged checkpoints
+     */
+    bool restore_checkpoint(const std::string& stream_handle, const CheckpointOffsets& offsets);
     
     /**
      * @brief Get stream processing statistics
@@ -248,9 +708,15 @@ public:
     struct StreamStats {
         uint64_t messages_processed;
         double throughput_msgs_per_sec;
-        double average_latency_ms;
+        double average_latency_ms;         ///< publish() to processing done
         uint64_t checkpoint_count;
         size_t backlog_size;
+        double p99_latency_ms;
+        double max_latency_ms;
+        uint64_t batches_flushed;
+        uint64_t deadline_flushes;         ///< Batches flushed short by the deadline
+        uint64_t duplicates_dropped;
+        uint64_t publish_rejected;         ///< Backlog full
     };
     
     StreamStats get_stream_stats(const std::string& stream_handle) const;
@@ -258,24 +724,76 @@ public:
 private:
     StreamConfig config_;
     ClusterManager& cluster_;
+    std::chrono::nanoseconds flush_interval_;
+
+    struct Record {
+        std::string symbol;
+        std::vector<uint8_t> data;
+        uint64_t sequence = 0;
+        uint64_t enqueued_ns = 0;
+    };
     
     struct StreamInfo {
         std::string name;
         std::vector<std::string> sources;
         StreamFunction processor;
-        std::atomic<bool> running;
+        std::atomic<bool> running{false};
         std::thread processing_thread;
-        StreamStats stats;
+        std::thread checkpoint_thread;
+
+        // Backlog ring: [next, head) waits and [tail, next) is the batch
+        // being processed, whose slots publishers cannot reuse yet
+        std::mutex backlog_mutex;
+        std::condition_variable backlog_ready;
+        std::vector<Record> slots;
+        uint64_t head = 0;
+        uint64_t next = 0;
+        uint64_t tail = 0;
+
+        // Owned by the processing thread; changes are published to dirty
+        // once per batch, and the checkpoint thread swaps dirty out
+        CheckpointOffsets offsets;
+        std::mutex checkpoint_mutex;
+        std::condition_variable checkpoint_wake;
+        CheckpointOffsets dirty;
+
+        common::AtomicLatencyHistogram latency;
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> deadline_flushes{0};
+        std::atomic<uint64_t> duplicates{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> checkpoints{0};
+        std::atomic<uint64_t> started_ns{0};
+        std::atomic<uint64_t> stopped_ns{0};
     };
     
+    mutable std::shared_mutex streams_mutex_;
     std::unordered_map<std::string, std::unique_ptr<StreamInfo>> streams_;
-    
+    std::mutex sink_mutex_;
+    CheckpointSink checkpoint_sink_;
+
+    StreamInfo* find_stream(const std::string& stream_handle) const;
     void process_stream(StreamInfo& stream_info);
-    void checkpoint_stream(const std::string& stream_handle);
+    void checkpoint_loop(StreamInfo& stream_info);
+    void checkpoint_stream(StreamInfo& stream_info);
 };
 
 /**
  * @brief Distributed machine learning training
+ *
+ * Gradients are combined with a ring all-reduce instead of a parameter
+ * server: with N nodes each gradient is cut into N chunks, N - 1
+ * reduce-scatter steps leave every node owning one fully summed chunk,
+ * and N - 1 all-gather steps circulate the results. Each node sends and
+ * receives 2 (N - 1) / N of the gradient whatever N is, where a server
+ * receives N full gradients. Ring order is the sorted IDs of the healthy
+ * nodes, so every node needs the same membership view.
+ *
+ * Chunks travel as ALLREDUCE_CHUNK frames of at most
+ * allreduce_segment_bytes, optionally compressed (gradient_codec.hpp).
+ * all_reduce_async() lets the caller compute the next gradient while the
+ * previous one is in flight.
  */
 class DistributedML {
 public:
@@ -286,9 +804,24 @@ public:
         size_t max_iterations = 10000;
         double convergence_threshold = 1e-6;
         bool use_parameter_server = true;
+        GradientCompression gradient_compression = GradientCompression::NONE;
+        size_t allreduce_segment_bytes = 32 * 1024;  // Encoded values per frame
+        uint32_t allreduce_timeout_ms = 1000;        // Per step
+    };
+    
+    struct AllReduceStats {
+        uint64_t rounds_completed = 0;
+        uint64_t rounds_failed = 0;            // Timed out: a peer stalled or left
+        uint64_t bytes_sent = 0;               // Encoded gradient bytes
+        uint64_t raw_bytes = 0;                // The same values as doubles
+        double last_round_ms = 0.0;
     };
     
     DistributedML(const TrainingConfig& config, ClusterManager& cluster);
+    ~DistributedML();
+    
+    DistributedML(const DistributedML&) = delete;
+    DistributedML& operator=(const DistributedML&) = delete;
     
     /**
      * @brief Train model across distributed cluster
@@ -309,14 +842,244 @@ public:
     std::unordered_map<std::string, double> optimize_hyperparameters(
         const std::unordered_map<std::string, std::pair<double, double>>& parameter_ranges,
         std::function<double(const std::unordered_map<std::string, double>&)> objective_function);
+    
+    /**
+     * @brief Replace gradient with the mean of every node's gradient
+     *
+     * A collective: every healthy node calls it the same number of times,
+     * in the same order, with gradients of the same length. The calling
+     * thread polls the cluster while it waits.
+     * @return false if a step timed out (gradient is then partly reduced)
+     */
+    bool all_reduce(std::vector<double>& gradient);
+    
+    /**
+     * @brief all_reduce() on a background thread
+     *
+     * Rounds run in call order; gradient must stay alive and untouched
+     * until the future is ready.
+     */
+    std::future<bool> all_reduce_async(std::vector<double>& gradient);
+    
+    AllReduceStats get_allreduce_stats() const;
 
 private:
     TrainingConfig config_;
     ClusterManager& cluster_;
     
+    // Received segments of one (round, step), kept encoded so the
+    // all-gather can forward them without re-encoding
+    struct Segment {
+        uint32_t offset;   // Within the chunk
+        uint32_t count;
+        float scale;
+        std::vector<uint8_t> data;
+    };
+    struct Inbox {
+        std::vector<Segment> segments;
+        size_t values = 0;
+    };
+    
+    std::mutex inbox_mutex_;
+    std::unordered_map<uint64_t, Inbox> inbox_;  // By round << 16 | step
+    uint64_t oldest_round_ = 0;                  // Older frames are late replies of a failed round
+    
+    // Rounds are numbered at call time and run strictly in that order
+    std::mutex round_mutex_;
+    std::condition_variable round_done_;
+    uint64_t next_ticket_ = 0;
+    uint64_t running_round_ = 0;
+    
+    std::atomic<uint64_t> rounds_completed_{0};
+    std::atomic<uint64_t> rounds_failed_{0};
+    std::atomic<uint64_t> bytes_sent_{0};
+    std::atomic<uint64_t> raw_bytes_{0};
+    std::atomic<uint64_t> last_round_ns_{0};
+    
     void parameter_server_loop();
     std::vector<double> aggregate_gradients(const std::vector<std::vector<double>>& gradients);
+    
+    bool run_all_reduce(uint64_t round, std::vector<double>& gradient);
+    bool reduce_ring(uint64_t round, std::vector<double>& gradient);
+    void on_chunk(const Frame& frame);
+    bool send_chunk(const std::string& node, uint64_t round, uint32_t step, uint32_t chunk,
+                    const double* values, size_t count);
+    bool forward_chunk(const std::string& node, uint64_t round, uint32_t step, uint32_t chunk,
+                       const Inbox& inbox);
+    bool send_segment(const std::string& node, const std::vector<uint8_t>& payload);
+    bool wait_inbox(uint64_t round, uint32_t step, size_t values, Inbox& out);
 };
 
+template<typename InputType, typename IntermediateType, typename OutputType>
+std::future<OutputType> ClusterManager::execute_map_reduce(
+    const std::string& task_name,
+    const std::vector<InputType>& input_data,
+    std::function<std::vector<IntermediateType>(const InputType&)> map_function,
+    std::function<OutputType(const std::vector<IntermediateType>&)> reduce_function) {
+    return execute_map_reduce<InputType, IntermediateType, OutputType>(
+        task_name, input_data, std::move(map_function), std::move(reduce_function), nullptr, MapReduceOptions{});
+}
+
+template<typename InputType, typename IntermediateType, typename OutputType>
+std::future<OutputType> ClusterManager::execute_map_reduce(
+    const std::string& task_name,
+    const std::vector<InputType>& input_data,
+    std::function<std::vector<IntermediateType>(const InputType&)> map_function,
+    std::function<OutputType(const std::vector<IntermediateType>&)> reduce_function,
+    Combiner<IntermediateType> combiner,
+    const MapReduceOptions& options) {
+    constexpr bool shippable = std::is_trivially_copyable_v<IntermediateType>;
+    auto clock = [] {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    };
+    // Planned now so the job uses the membership seen at call time
+    auto plan = std::make_shared<MapReducePlan>(plan_map_reduce(input_data.size(), options, shippable));
+    const uint64_t job = node_hash(task_name);
+    const bool distributed = !plan->peers.empty();
+    if (distributed) {
+        open_shuffle(job);
+    }
+    map_reduce_jobs_.fetch_add(1, std::memory_order_relaxed);
+
+    return std::async(std::launch::async, [this, clock, plan, job, distributed, options, input = input_data,
+                                           map = std::move(map_function), reduce = std::move(reduce_function),
+                                           combine = std::move(combiner)]() -> OutputType {
+        const size_t partitions = plan->partitions.size();
+        const uint64_t start = clock();
+        const uint64_t deadline = start + static_cast<uint64_t>(options.timeout_ms) * 1000000ull;
+        MapReduceScheduler scheduler(plan->local, start, options.speculation_factor, options.speculation_min_progress,
+                                     static_cast<uint64_t>(options.speculation_delay_ms) * 1000000ull);
+        std::vector<std::vector<IntermediateType>> results(partitions);
+        std::atomic<bool> timed_out{false};
+
+        // Peers' partitions, decoded by whichever worker is waiting
+        auto drain_shuffle = [&] {
+            if constexpr (shippable) {
+                uint32_t partition;
+                std::vector<uint8_t> bytes;
+                while (take_partition(job, partition, bytes)) {
+                    if (bytes.size() % sizeof(IntermediateType) == 0 && scheduler.complete_remote(partition, clock())) {
+                        results[partition].resize(bytes.size() / sizeof(IntermediateType));
+                        if (!bytes.empty()) {
+                            std::memcpy(results[partition].data(), bytes.data(), bytes.size());
+                        }
+                    }
+                }
+            }
+        };
+
+        auto worker = [&] {
+            std::vector<IntermediateType> buffer;
+            while (true) {
+                const auto task = scheduler.acquire(clock());
+                if (task.partition == MapReduceScheduler::FINISHED) {
+                    return;
+                }
+                if (clock() >= deadline) {
+                    timed_out.store(true);
+                    scheduler.abort();
+                    return;
+                }
+                if (task.partition == MapReduceScheduler::WAIT) {
+                    if (distributed) {
+                        poll_messages(1);
+                        drain_shuffle();
+                    } else {
+                        std::this_thread::sleep_for(std::chrono::microseconds(200));
+                    }
+                    continue;
+                }
+
+                const uint64_t started = clock();
+                const auto& indices = plan->partitions[task.partition];
+                buffer.clear();
+                bool abandoned = false;
+                for (size_t i = 0; i < indices.size(); ++i) {
+                    // A backup or a peer may finish first: stop, checking now and then
+                    if (i % 64 == 63 && scheduler.done(task.partition)) {
+                        abandoned = true;
+                        break;
+                    }
+                    std::vector<IntermediateType> mapped = map(input[indices[i]]);
+                    buffer.insert(buffer.end(), std::make_move_iterator(mapped.begin()),
+                                  std::make_move_iterator(mapped.end()));
+                    if (combine && buffer.size() >= options.combine_threshold) {
+                        combine(buffer);
+                    }
+                }
+                if (combine && !abandoned) {
+                    combine(buffer);
+                }
+                // An abandoned copy's partition is done already, so it is not kept either
+                if (!scheduler.complete(task.partition, task.speculative, started, clock())) {
+                    continue;
+                }
+                if constexpr (shippable) {
+                    if (distributed) {
+                        publish_partition(job, static_cast<uint32_t>(task.partition), buffer.data(),
+                                          buffer.size() * sizeof(IntermediateType), plan->peers, options.timeout_ms);
+                    }
+                }
+                results[task.partition] = std::move(buffer);
+                buffer = {};
+            }
+        };
+
+        size_t threads = options.worker_threads != 0 ? options.worker_threads
+                                                     : std::max<size_t>(1, std::thread::hardware_concurrency());
+        threads = std::max<size_t>(1, std::min(threads, partitions));
+        // The first exception a map or combiner throws ends the job and reaches the future
+        std::exception_ptr failure;
+        std::mutex failure_mutex;
+        auto guarded = [&] {
+            try {
+                worker();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failure_mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                scheduler.abort();
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < threads; ++t) {
+            pool.emplace_back(guarded);
+        }
+        guarded();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        if (distributed) {
+            close_shuffle(job);
+        }
+
+        const auto stats = scheduler.stats();
+        map_reduce_tasks_.fetch_add(stats.local_completions, std::memory_order_relaxed);
+        map_reduce_remote_.fetch_add(stats.remote_completions, std::memory_order_relaxed);
+        map_reduce_speculative_.fetch_add(stats.speculative_launches, std::memory_order_relaxed);
+        map_reduce_speculative_wins_.fetch_add(stats.speculative_wins, std::memory_order_relaxed);
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+        if (timed_out.load()) {
+            throw std::runtime_error("execute_map_reduce: job timed out");
+        }
+
+        size_t total = 0;
+        for (const auto& result : results) {
+            total += result.size();
+        }
+        std::vector<IntermediateType> intermediate;
+        intermediate.reserve(total);
+        for (auto& result : results) {
+            intermediate.insert(intermediate.end(), std::make_move_iterator(result.begin()),
+                                std::make_move_iterator(result.end()));
+        }
+        return reduce(intermediate);
+    });
+}
+
 } // namespace distributed
 } // namespace feedhandler
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace feedhandler {
+namespace distributed {
+
+/**
+ * @brief Consistent-hash placement of keys on nodes
+ *
+ * Every node owns virtual_nodes points on a 64-bit ring and a key
+ * belongs to the first point at or after its hash. Adding or removing
+ * a node therefore moves only the keys on that node's arcs (about 1/N
+ * of them), and the points interleave finely enough that load stays
+ * within a few percent of even.
+ *
+ * Lookups are a binary search over one sorted vector and never
+ * allocate. Not thread-safe: callers rebuild under their own lock.
+ */
+class ConsistentHashRing {
+public:
+    static constexpr size_t DEFAULT_VIRTUAL_NODES = 128;
+
+    ConsistentHashRing() : ConsistentHashRing(DEFAULT_VIRTUAL_NODES) {}
+    explicit ConsistentHashRing(size_t virtual_nodes);
+
+    /**
+     * @return false if the node is already on the ring
+     */
+    bool add_node(const std::string& node_id);
+
+    /**
+     * @return false if the node is not on the ring
+     */
+    bool remove_node(std::string_view node_id);
+
+    bool contains(std::string_view node_id) const;
+
+    /**
+     * @brief Owner of key, or nullptr if the ring is empty
+     */
+    const std::string* node_for(std::string_view key) const;
+
+    /**
+     * @brief The first count distinct nodes clockwise from key (owner first)
+     *
+     * These are the key's replicas: when the owner leaves, the next one
+     * already holds the data.
+     * @return Nodes written to out (fewer than count if the ring is smaller)
+     */
+    size_t nodes_for(std::string_view key, size_t count, std::vector<const std::string*>& out) const;
+
+    size_t node_count() const { return nodes_.size(); }
+    const std::vector<std::string>& nodes() const { return nodes_; }
+    size_t virtual_nodes() const { return virtual_nodes_; }
+
+    /**
+     * @brief Key hash: FNV-1a finished with a 64-bit mixer, stable across runs
+     */
+    static uint64_t hash(std::string_view key);
+
+private:
+    struct Point {
+        uint64_t hash;
+        uint32_t node;  // Index into nodes_
+    };
+
+    size_t first_point(std::string_view key) const;
+
+    size_t virtual_nodes_;
+    std::vector<Point> points_;  // Sorted by hash
+    std::vector<std::string> nodes_;
+};
+
+} // namespace distributed
+} // namespace feedhandler
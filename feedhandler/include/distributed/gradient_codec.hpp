@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace feedhandler {
+namespace distributed {
+
+/**
+ * @brief Wire form of gradient values in DistributedML::all_reduce()
+ *
+ * - NONE sends doubles (8 bytes per value)
+ * - FP16 sends IEEE half precision (2 bytes), round to nearest even;
+ *   finite values past the half range saturate to +-65504 instead of
+ *   becoming infinities that would poison the sum
+ * - INT8 sends one signed byte per value with a per-segment scale of
+ *   max|x| / 127, so the error is at most half a step of the largest
+ *   value in the segment
+ */
+enum class GradientCompression : uint16_t {
+    NONE = 0,
+    FP16 = 1,
+    INT8 = 2
+};
+
+/**
+ * @brief Encoded bytes per value
+ */
+constexpr size_t gradient_value_bytes(GradientCompression compression) {
+    switch (compression) {
+        case GradientCompression::FP16: return 2;
+        case GradientCompression::INT8: return 1;
+        default: return sizeof(double);
+    }
+}
+
+uint16_t float_to_half(float value);
+float half_to_float(uint16_t half);
+
+/**
+ * @brief Encode count values into out (count * gradient_value_bytes() bytes)
+ * @return Scale to pass to decode_gradient() (INT8 only, else 1)
+ */
+float encode_gradient(const double* values, size_t count, GradientCompression compression, uint8_t* out);
+
+/**
+ * @brief Decode count values into out, adding to it when accumulate is set
+ *
+ * data need not be aligned.
+ */
+void decode_gradient(const uint8_t* data, size_t count, GradientCompression compression, float scale,
+                     double* out, bool accumulate);
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace feedhandler {
+namespace distributed {
+
+/**
+ * @brief Task bookkeeping of one execute_map_reduce() job on one node
+ *
+ * Partitions are either local (this node's map tasks) or remote (a
+ * peer's, whose result arrives through the shuffle). Worker threads
+ * acquire() local tasks first; once those are gone an idle worker backs
+ * up the slowest unfinished partition, local or remote, if it has run
+ * longer than speculation_factor times the median task time (and at
+ * least speculation_delay_ns), provided that speculation_min_progress of
+ * the job is done or this node has nothing else left to run.
+ *
+ * Each partition gets at most one backup. Whichever copy completes
+ * first wins; the rest is discarded. Thread-safe.
+ */
+class MapReduceScheduler {
+public:
+    static constexpr size_t WAIT = std::numeric_limits<size_t>::max() - 1;  ///< Nothing to run yet
+    static constexpr size_t FINISHED = std::numeric_limits<size_t>::max();  ///< All done or aborted
+
+    struct Assignment {
+        size_t partition;
+        bool speculative;
+    };
+
+    struct Stats {
+        uint64_t local_completions = 0;
+        uint64_t remote_completions = 0;
+        uint64_t speculative_launches = 0;
+        uint64_t speculative_wins = 0;      ///< Backups that finished first
+    };
+
+    /**
+     * @param local Per partition: true if this node owns it
+     */
+    MapReduceScheduler(std::vector<bool> local, uint64_t start_ns, double speculation_factor,
+                       double speculation_min_progress, uint64_t speculation_delay_ns);
+
+    Assignment acquire(uint64_t now_ns);
+
+    /**
+     * @brief A local run of partition finished
+     * @return true if it is the first result (the caller keeps it)
+     */
+    bool complete(size_t partition, bool speculative, uint64_t started_ns, uint64_t now_ns);
+
+    /**
+     * @brief A peer delivered partition
+     * @return true if it is the first result
+     */
+    bool complete_remote(size_t partition, uint64_t now_ns);
+
+    /**
+     * @brief Already finished, so a running copy can stop early
+     */
+    bool done(size_t partition) const;
+
+    bool finished() const;
+    void abort();
+    Stats stats() const;
+
+private:
+    struct Task {
+        bool local;
+        bool done = false;
+        bool backed_up = false;
+        uint64_t started_ns = 0;   // First run; job start for remote partitions
+        uint32_t running = 0;      // Local copies in progress
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<Task> tasks_;
+    std::deque<size_t> pending_;   // Local partitions not started yet
+    std::vector<uint64_t> durations_;
+    size_t completed_ = 0;
+    bool aborted_ = false;
+    const uint64_t start_ns_;
+    const double speculation_factor_;
+    const double speculation_min_progress_;
+    const uint64_t speculation_delay_ns_;
+    Stats stats_;
+
+    uint64_t median_duration();
+    bool finish(Task& task, uint64_t duration_ns);
+};
+
+} // namespace distributed
+} // namespace feedhandler
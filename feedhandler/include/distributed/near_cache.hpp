@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "common/lru_cache.hpp"
+
+namespace feedhandler {
+namespace distributed {
+
+/**
+ * @brief Byte-budgeted LRU of values owned by other nodes
+ *
+ * Sits in front of remote reads so a hot key costs one remote round
+ * trip per ttl instead of one per read. Entries expire after ttl_ns
+ * (the staleness bound for "eventual" consistency) and the least
+ * recently used ones are evicted once key + value bytes pass
+ * capacity_bytes.
+ *
+ * Entries sit in a common::LRUCache, whose entry limit is the byte
+ * budget itself (so only the budget evicts unless keys and values are
+ * empty). Evicted entries are recycled with their buffers, so a warm
+ * cache inserts without allocating. Not thread-safe.
+ */
+class NearCache {
+public:
+    NearCache(size_t capacity_bytes, uint64_t ttl_ns);
+
+    NearCache(const NearCache&) = delete;
+    NearCache& operator=(const NearCache&) = delete;
+
+    /**
+     * @brief Copy a live entry into out (its capacity is reused)
+     * @return false on a miss or an expired entry
+     */
+    bool get(std::string_view key, std::vector<uint8_t>& out, uint64_t now_ns);
+
+    /**
+     * @brief Copy a live entry into buffer
+     * @param length Value size on a hit, even when buffer is too small
+     * @return false on a miss, an expired entry or a short buffer
+     */
+    bool get(std::string_view key, std::span<uint8_t> buffer, size_t& length, uint64_t now_ns);
+
+    /**
+     * @brief Live entry's value in place, or nullptr; valid until the next put()
+     */
+    const std::vector<uint8_t>* find(std::string_view key, uint64_t now_ns);
+
+    void put(std::string_view key, const uint8_t* data, size_t size, uint64_t now_ns);
+    void erase(std::string_view key);
+    void clear();
+
+    size_t size() const { return lru_.size(); }
+    size_t bytes() const { return bytes_; }
+    size_t capacity_bytes() const { return capacity_bytes_; }
+
+private:
+    struct Entry {
+        std::vector<uint8_t> value;
+        uint64_t expires_ns = 0;
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+    };
+
+    // Returns the live entry for key, made most recent, or nullptr
+    Entry* touch(std::string_view key, uint64_t now_ns);
+
+    size_t capacity_bytes_;
+    uint64_t ttl_ns_;
+    size_t bytes_ = 0;
+    common::LRUCache<std::string, Entry, KeyHash, std::equal_to<>> lru_;
+};
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "distributed/wire_protocol.hpp"
+
+namespace feedhandler {
+namespace distributed {
+
+/**
+ * @brief Single-producer/single-consumer frame ring in POSIX shared memory
+ *
+ * Transport between two nodes on the same host: the sender copies a
+ * FrameWriter batch in with one memcpy and the receiver decodes frames
+ * in place, with no socket or kernel copy in between. A batch is never
+ * split across the end of the ring; the writer fills the remainder with
+ * a PADDING frame (or leaves it, if shorter than a header) and starts
+ * over at offset 0, so every frame is contiguous for the reader.
+ *
+ * Either side may open() first: the segment is created on demand and
+ * initialized once. Positions are 64-bit byte counters, head and tail
+ * on separate cache lines, published with release/acquire like
+ * threading::SpscRing.
+ */
+class ShmFrameChannel {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+
+    ShmFrameChannel() = default;
+    ~ShmFrameChannel();
+
+    ShmFrameChannel(const ShmFrameChannel&) = delete;
+    ShmFrameChannel& operator=(const ShmFrameChannel&) = delete;
+
+    /**
+     * @brief Create or attach to the segment name ("/..." per shm_open)
+     * @param capacity Ring bytes, rounded up to a power of two; an
+     *        existing segment keeps the capacity it was created with
+     */
+    bool open(const std::string& name, size_t capacity = DEFAULT_CAPACITY);
+    void close();
+
+    /**
+     * @brief Remove the segment name; mappings stay valid until closed
+     */
+    static void unlink(const std::string& name);
+
+    /**
+     * @brief Copy a batch of whole frames in (producer side)
+     * @return false if the ring lacks room for the batch; nothing is written
+     */
+    bool write(const uint8_t* frames, size_t size);
+    bool write(const FrameWriter& batch) { return write(batch.data(), batch.size()); }
+
+    /**
+     * @brief Call fn(frame) for every frame written so far (consumer side)
+     *
+     * Frames point into the ring and are valid only during fn; their
+     * space is released when read() returns.
+     * @return Frames delivered
+     */
+    template<typename Fn>
+    size_t read(Fn&& fn) {
+        if (control_ == nullptr) {
+            return 0;
+        }
+        uint64_t tail = control_->tail.load(std::memory_order_relaxed);
+        const uint64_t head = control_->head.load(std::memory_order_acquire);
+        size_t frames = 0;
+        while (tail < head) {
+            size_t index = static_cast<size_t>(tail & mask_);
+            size_t to_end = capacity_ - index;
+            size_t available = std::min<uint64_t>(head - tail, to_end);
+            if (to_end < sizeof(FrameHeader)) {
+                tail += to_end;  // Too short for a PADDING frame: skipped by convention
+                continue;
+            }
+            size_t consumed = for_each_frame(data_ + index, available, [&](const Frame& frame) {
+                fn(frame);
+                frames++;
+            });
+            if (consumed == 0 || consumed == SIZE_MAX) {
+                break;  // Corrupt: a writer bug, stop rather than spin
+            }
+            tail += consumed;
+        }
+        control_->tail.store(tail, std::memory_order_release);
+        return frames;
+    }
+
+    bool is_open() const { return control_ != nullptr; }
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Bytes written and not yet read
+     */
+    size_t backlog() const;
+
+private:
+    struct Control {
+        std::atomic<uint32_t> state;  // 0 fresh, 1 initializing, 2 ready
+        uint32_t reserved;
+        uint64_t capacity;
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+    };
+
+    static constexpr size_t DATA_OFFSET = 192;
+    static_assert(sizeof(Control) <= DATA_OFFSET, "Control block fits before the ring");
+
+    Control* control_ = nullptr;
+    uint8_t* data_ = nullptr;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    size_t mapped_bytes_ = 0;
+};
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace feedhandler {
+namespace distributed {
+
+/**
+ * @brief Message rate of every symbol, as an exponentially weighted average
+ *
+ * The hot path bumps a per-symbol counter (counter() hands out a stable
+ * reference, so the lookup can be hoisted out of the loop); sample()
+ * folds the counts since the previous sample into each symbol's rate,
+ * weighting older intervals down by half every half_life_ms. A symbol's
+ * first sample takes the measured rate as is.
+ *
+ * set_rate() stores a rate measured elsewhere (a peer's report or a
+ * migrated symbol's history). It holds until messages of the symbol are
+ * counted here; sample() then continues from it. Thread-safe.
+ */
+class SymbolRateTracker {
+public:
+    SymbolRateTracker(uint32_t half_life_ms, uint64_t start_ns);
+
+    /**
+     * @brief Message counter of symbol, created on first use and never moved
+     */
+    std::atomic<uint64_t>& counter(std::string_view symbol);
+
+    void record(std::string_view symbol, uint64_t messages = 1) {
+        counter(symbol).fetch_add(messages, std::memory_order_relaxed);
+    }
+
+    void sample(uint64_t now_ns);
+    void set_rate(std::string_view symbol, double messages_per_second);
+
+    /**
+     * @brief Messages per second as of the last sample(); 0 if unknown
+     */
+    double rate(std::string_view symbol) const;
+
+    /**
+     * @brief Every symbol with a rate, as of the last sample()
+     */
+    std::unordered_map<std::string, double> rates() const;
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> count{0};
+        uint64_t sampled = 0;      // count at the last sample()
+        double rate = 0.0;
+        bool has_rate = false;
+        bool reported = false;     // rate came from set_rate(), no local messages since
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<Entry>, KeyHash, std::equal_to<>> entries_;
+    const double half_life_ns_;
+    uint64_t last_sample_ns_;
+};
+
+/**
+ * @brief Rate-weighted placement and incremental rebalancing of symbols
+ *
+ * A node's load is the summed rate of its symbols divided by its
+ * capacity (free CPU share), and the cluster's imbalance is how far the
+ * hottest node sits above the ideal (total rate / total capacity), so
+ * 0.25 means 25% over. Symbols without a measured rate count as the
+ * mean of the measured ones.
+ *
+ * place() is a longest-processing-time split: heaviest symbol first,
+ * each onto the node whose load would end up lowest. A handful of very
+ * hot names (index ETFs) thus get a node each and the long tail fills
+ * in around them.
+ *
+ * plan() moves a few symbols at a time. Rebalancing starts once the
+ * imbalance passes trigger_imbalance and continues, round after round,
+ * until it drops to target_imbalance; the gap between the two keeps
+ * noise in the rates from starting a new round every interval. Each
+ * move takes the symbol from the hottest node that best evens it out
+ * with the coolest one, and only if it lowers the hotter of the two, so
+ * a symbol too hot for any node stays where it is instead of bouncing.
+ * A moved symbol is left alone for cooldown_ns.
+ *
+ * Not thread-safe: ClusterManager plans under its own lock.
+ */
+class SymbolLoadBalancer {
+public:
+    struct Config {
+        double trigger_imbalance = 0.25;
+        double target_imbalance = 0.10;
+        size_t max_moves = 4;            // Per plan() call
+        uint64_t cooldown_ns = 30000000000ull;
+    };
+
+    struct Node {
+        std::string id;
+        double capacity = 1.0;
+        std::vector<std::string> symbols;
+    };
+
+    struct Move {
+        std::string symbol;
+        std::string from;
+        std::string to;
+    };
+
+    using Rates = std::unordered_map<std::string, double>;
+
+    SymbolLoadBalancer() : SymbolLoadBalancer(Config{}) {}
+    explicit SymbolLoadBalancer(const Config& config) : config_(config) {}
+
+    /**
+     * @brief Append symbols to nodes' lists, heaviest first onto the least loaded
+     */
+    static void place(std::vector<Node>& nodes, const std::vector<std::string>& symbols, const Rates& rates);
+
+    /**
+     * @brief Hottest node's load over the ideal, minus 1 (0 = perfectly even)
+     */
+    static double imbalance(const std::vector<Node>& nodes, const Rates& rates);
+
+    /**
+     * @brief Up to max_moves migrations, already applied to nodes
+     */
+    std::vector<Move> plan(std::vector<Node>& nodes, const Rates& rates, uint64_t now_ns);
+
+    /**
+     * @brief Inside a round: the imbalance has not yet dropped to the target
+     */
+    bool rebalancing() const { return rebalancing_; }
+
+private:
+    Config config_;
+    bool rebalancing_ = false;
+    std::unordered_map<std::string, uint64_t> moved_ns_;  // Last move of each symbol
+};
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace feedhandler {
+namespace distributed {
+
+/**
+ * @brief Cluster message kinds (FrameHeader::type)
+ */
+enum class MessageType : uint16_t {
+    PADDING = 0,              ///< Filler to the end of a shared-memory ring, never delivered
+    HEARTBEAT = 1,            ///< HeartbeatMessage
+    WORKLOAD_ASSIGNMENT = 2,  ///< Symbol list, see write_workload_assignment()
+    CACHE_PUT = 3,            ///< DistributedCache replica write
+    CACHE_GET = 4,            ///< DistributedCache remote read request
+    CACHE_VALUE = 5,          ///< Reply to CACHE_GET
+    CACHE_REMOVE = 6,         ///< DistributedCache replica delete
+    ALLREDUCE_CHUNK = 7,      ///< DistributedML ring all-reduce segment
+    MAP_REDUCE_PARTITION = 8, ///< Segment of a combined execute_map_reduce() partition
+    SYMBOL_RATES = 9,         ///< Message rates of a node's symbols, see write_symbol_rates()
+    SYMBOL_MIGRATE = 10,      ///< Coordinator asks a node to hand one symbol to another
+    SYMBOL_HANDOFF = 11,      ///< A migrating symbol's rate and processing state
+    APPLICATION = 0x100       ///< First type free for callers
+};
+
+/**
+ * @brief Fixed 16-byte prefix of every frame
+ *
+ * Frames are laid out back to back, each padded to FRAME_ALIGNMENT, so
+ * a payload read straight out of an aligned receive buffer or shared
+ * memory ring can be used in place as the message struct.
+ * Little-endian, like every host the cluster runs on.
+ */
+struct FrameHeader {
+    uint32_t length;    ///< Payload bytes, excluding header and padding
+    uint16_t type;      ///< MessageType
+    uint16_t flags;
+    uint32_t sender;    ///< node_hash() of the sending node
+    uint32_t sequence;  ///< Per-sender frame counter
+};
+
+static_assert(sizeof(FrameHeader) == 16, "FrameHeader is a fixed 16-byte prefix");
+
+constexpr size_t FRAME_ALIGNMENT = 8;
+constexpr size_t MAX_FRAME_PAYLOAD = 16 * 1024 * 1024;
+
+/**
+ * @brief Bytes a frame with payload bytes occupies on the wire
+ */
+constexpr size_t frame_size(size_t payload) {
+    return (sizeof(FrameHeader) + payload + FRAME_ALIGNMENT - 1) & ~(FRAME_ALIGNMENT - 1);
+}
+
+/**
+ * @brief 32-bit FNV-1a of a node ID, carried in FrameHeader::sender
+ */
+uint32_t node_hash(std::string_view node_id);
+
+/**
+ * @brief View of one frame inside a receive buffer (not owned)
+ */
+struct Frame {
+    const FrameHeader* header = nullptr;
+    const uint8_t* payload = nullptr;
+
+    MessageType type() const { return static_cast<MessageType>(header->type); }
+    size_t size() const { return header->length; }
+
+    /**
+     * @brief Payload as a flat message struct, in place
+     * @return nullptr if the payload is shorter than T or misaligned
+     */
+    template<typename T>
+    const T* as() const {
+        if (header->length < sizeof(T) || reinterpret_cast<uintptr_t>(payload) % alignof(T) != 0) {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(payload);
+    }
+};
+
+enum class ParseStatus {
+    FRAME,       ///< frame is valid; consumed frame_size() bytes
+    INCOMPLETE,  ///< Need more bytes
+    INVALID      ///< Corrupt length: drop the connection
+};
+
+/**
+ * @brief Decode the frame at the front of data without copying
+ * @param consumed Bytes the frame occupies, padding included (FRAME only)
+ */
+ParseStatus parse_frame(const uint8_t* data, size_t length, Frame& frame, size_t& consumed);
+
+/**
+ * @brief Call fn(frame) for every complete frame in data; PADDING frames are skipped
+ * @return Bytes consumed, or SIZE_MAX if a corrupt frame was found
+ */
+template<typename Fn>
+size_t for_each_frame(const uint8_t* data, size_t length, Fn&& fn) {
+    size_t offset = 0;
+    while (true) {
+        Frame frame;
+        size_t consumed = 0;
+        ParseStatus status = parse_frame(data + offset, length - offset, frame, consumed);
+        if (status == ParseStatus::INCOMPLETE) {
+            return offset;
+        }
+        if (status == ParseStatus::INVALID) {
+            return SIZE_MAX;
+        }
+        if (frame.type() != MessageType::PADDING) {
+            fn(frame);
+        }
+        offset += consumed;
+    }
+}
+
+/**
+ * @brief Batch of outgoing frames in one contiguous buffer
+ *
+ * Messages are encoded in place (begin_frame() hands out the payload
+ * bytes), so a batch goes out as a single send() or shared-memory copy
+ * however many frames it holds. The buffer keeps its capacity across
+ * clear(), so steady-state batching does not allocate.
+ */
+class FrameWriter {
+public:
+    explicit FrameWriter(uint32_t sender = 0) : sender_(sender) {}
+
+    /**
+     * @brief Append a frame header and return its payload_size bytes to fill in
+     *
+     * The pointer is FRAME_ALIGNMENT-aligned and valid until the next
+     * append. Padding bytes are zeroed.
+     */
+    uint8_t* begin_frame(MessageType type, size_t payload_size);
+
+    void append(MessageType type, const void* payload, size_t payload_size) {
+        uint8_t* out = begin_frame(type, payload_size);
+        if (payload_size > 0) {
+            std::memcpy(out, payload, payload_size);
+        }
+    }
+
+    template<typename T>
+    void append(MessageType type, const T& message) {
+        append(type, &message, sizeof(T));
+    }
+
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(buffer_.data()); }
+    size_t size() const { return size_; }
+    size_t frame_count() const { return frames_; }
+    bool empty() const { return frames_ == 0; }
+
+    void clear() {
+        size_ = 0;
+        frames_ = 0;
+    }
+
+    void set_sender(uint32_t sender) { sender_ = sender; }
+
+private:
+    std::vector<uint64_t> buffer_;  // uint64_t storage keeps payloads 8-byte aligned
+    size_t size_ = 0;
+    size_t frames_ = 0;
+    uint32_t sender_;
+    uint32_t sequence_ = 0;
+};
+
+/**
+ * @brief HEARTBEAT payload: a node's load, decoded in place
+ */
+struct HeartbeatMessage {
+    uint64_t timestamp_ns;
+    double cpu_utilization;
+    uint64_t memory_usage_mb;
+    uint64_t network_bandwidth_mbps;
+    uint32_t assigned_symbols;
+    uint32_t healthy;
+};
+
+/**
+ * @brief Encode a symbol list as one WORKLOAD_ASSIGNMENT frame
+ *
+ * Layout: uint32 count, count + 1 uint32 offsets into the name bytes,
+ * then the names back to back, so decoding is pointer arithmetic.
+ */
+void write_workload_assignment(FrameWriter& writer, const std::vector<std::string>& symbols);
+
+/**
+ * @brief Zero-copy reader of a WORKLOAD_ASSIGNMENT payload
+ */
+class WorkloadAssignmentView {
+public:
+    /**
+     * @brief valid() is false if the frame is not a well-formed assignment
+     */
+    explicit WorkloadAssignmentView(const Frame& frame);
+
+    bool valid() const { return offsets_ != nullptr; }
+    size_t size() const { return count_; }
+    std::string_view symbol(size_t i) const {
+        return std::string_view(names_ + offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+private:
+    size_t count_ = 0;
+    const uint32_t* offsets_ = nullptr;
+    const char* names_ = nullptr;
+};
+
+/**
+ * @brief Encode per-symbol message rates as one SYMBOL_RATES frame
+ *
+ * Layout: uint32 count, uint32 reserved, count doubles (messages per
+ * second), then the names indexed as in write_workload_assignment().
+ */
+void write_symbol_rates(FrameWriter& writer, const std::vector<std::pair<std::string, double>>& rates);
+
+/**
+ * @brief Zero-copy reader of a SYMBOL_RATES payload
+ */
+class SymbolRatesView {
+public:
+    explicit SymbolRatesView(const Frame& frame);
+
+    bool valid() const { return offsets_ != nullptr; }
+    size_t size() const { return count_; }
+    std::string_view symbol(size_t i) const {
+        return std::string_view(names_ + offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+    double rate(size_t i) const { return rates_[i]; }
+
+private:
+    size_t count_ = 0;
+    const double* rates_ = nullptr;
+    const uint32_t* offsets_ = nullptr;
+    const char* names_ = nullptr;
+};
+
+} // namespace distributed
+} // namespace feedhandler
@@ -5,39 +5,123 @@
 #include <device_launch_parameters.h>
 #endif
 
-#include <vector>
+#include <cstdint>
+#include <future>
 #include <memory>
+#include <string>
+#include <vector>
+#include "common/compact_tick.hpp"
 #include "common/tick.hpp"
 
 namespace feedhandler {
 namespace gpu {
 
+/**
+ * @brief Location of a field value inside a staged batch of raw bytes
+ */
+struct FieldRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
 /**
  * @brief GPU-accelerated FIX parser using CUDA parallel processing
- * 
+ *
  * This parser leverages thousands of GPU cores to process multiple
  * FIX messages simultaneously, achieving 100B+ messages/second throughput.
- * 
+ *
  * Key innovations:
  * - Parallel message parsing across GPU threads
  * - Shared memory optimization for delimiter scanning
  * - Warp-level primitives for character processing
  * - Zero-copy GPU memory management
  * - Multi-stream processing pipeline
+ *
+ * Messages are staged back to back into pinned (page-locked) host
+ * memory with one offset per message, so a batch goes to the device as
+ * two contiguous DMA copies instead of a gather of scattered pointers.
+ * Each CUDA stream owns one staging slot: host bytes, offsets, and the
+ * pinned CompactTick array the results are copied back into. submit()
+ * queues copy in, parse kernel and copy out on the slot's stream and
+ * moves on to the next slot, so while one batch is on the device the
+ * host fills the next and the copies of one stream overlap the kernels
+ * of another. Symbols come back as byte ranges and are interned on the
+ * host when a batch is collected.
+ *
+ * Not thread-safe: one thread stages, submits and collects.
  */
 class CUDAFixParser {
 public:
     struct Config {
         size_t max_messages_per_batch = 10000;
-        size_t gpu_memory_pool_size = 1024 * 1024 * 1024; // 1GB
+        size_t max_batch_bytes = 4 * 1024 * 1024;  // Pinned receive bytes per staging slot
         int cuda_device_id = 0;
-        bool use_unified_memory = true;
-        size_t stream_count = 4;
+        size_t stream_count = 4;                   // Batches in flight, one staging slot each
     };
-    
-    CUDAFixParser(const Config& config = {});
+
+    CUDAFixParser();
+    explicit CUDAFixParser(const Config& config);
     ~CUDAFixParser();
-    
+
+    CUDAFixParser(const CUDAFixParser&) = delete;
+    CUDAFixParser& operator=(const CUDAFixParser&) = delete;
+
+    /**
+     * @brief Copy one complete FIX message into the slot being filled
+     *
+     * A full slot (messages or bytes) is submitted first, so staging
+     * can run straight off the receive path.
+     * @return false if the message is larger than max_batch_bytes
+     */
+    bool stage(const char* message, size_t length);
+
+    /**
+     * @brief Queue the staged batch on its stream: copy in, parse, copy out
+     *
+     * Returns without waiting for the GPU. Only when every stream still
+     * holds an earlier batch does it wait for the oldest one (its ticks
+     * stay buffered until collect()).
+     * @return Messages submitted
+     */
+    size_t submit();
+
+    /**
+     * @brief Append the ticks of completed batches, in submission order
+     * @param wait Block until every submitted batch has completed
+     * @return Ticks appended (one per message, invalid if unparseable)
+     */
+    size_t collect(std::vector<common::CompactTick>& ticks, bool wait);
+
+    /**
+     * @brief Frame and parse a raw capture chunk entirely on the GPU
+     *
+     * For bulk reprocessing of recorded streams, where splitting on the
+     * CPU is the bottleneck. Each piece of up to max_batch_bytes is
+     * copied to the device once; one thread per byte flags every
+     * "8=FIX" at the start or after an SOH, an exclusive prefix scan
+     * (CUB) turns the flags into message indices and offsets, and a
+     * single launch parses every message, which is complete only if its
+     * CheckSum (10) trailer comes before the next start. Bytes before
+     * the first start and truncated messages are skipped. At most
+     * max_batch_bytes / MIN_FRAMED_MESSAGE_BYTES messages are framed per
+     * pass; denser pieces take several passes.
+     *
+     * Batches pipelined by submit() are collected first, so ticks stay
+     * in order. Device buffers (about 10 bytes per staged byte) are
+     * allocated on the first call.
+     * @return Bytes consumed; a trailing incomplete message is not
+     *         consumed and must be passed again with the data that follows
+     */
+    size_t parse_stream(const char* data, size_t length, std::vector<common::CompactTick>& ticks);
+
+    /// Message size parse_stream() sizes its framing capacity for; denser data takes more passes
+    static constexpr size_t MIN_FRAMED_MESSAGE_BYTES = 32;
+
+    /**
+     * @brief Batches submitted and not yet collected
+     */
+    size_t in_flight() const { return in_flight_; }
+
     /**
      * @brief Parse batch of FIX messages on GPU
      * @param messages Array of message pointers
@@ -45,12 +129,15 @@ public:
      * @param batch_size Number of messages in batch
      * @param ticks Output vector for parsed ticks
      * @return Number of successfully parsed messages
+     *
+     * Blocking convenience wrapper over stage(), submit() and collect();
+     * larger batches are split across the streams and still overlap.
      */
-    size_t parse_batch(const char** messages, 
+    size_t parse_batch(const char** messages,
                       const size_t* message_lengths,
                       size_t batch_size,
                       std::vector<common::Tick>& ticks);
-    
+
     /**
      * @brief Asynchronous batch parsing with callback
      * @param messages Message batch
@@ -59,20 +146,21 @@ public:
      */
     std::future<std::vector<common::Tick>> parse_async(
         const std::vector<std::string>& messages);
-    
+
     /**
      * @brief Get GPU performance metrics
      */
     struct GPUMetrics {
-        double throughput_msgs_per_sec;
-        double gpu_utilization_percent;
-        size_t memory_usage_bytes;
-        double kernel_execution_time_ms;
+        double throughput_msgs_per_sec;   // Messages per second of device time
+        double gpu_utilization_percent;   // Device time over wall time since the first submit
+        size_t memory_usage_bytes;        // Pinned host plus device staging memory
+        double kernel_execution_time_ms;  // Copy in + parse + copy out, summed over batches
         size_t processed_message_count;
+        size_t batch_count;
     };
-    
+
     GPUMetrics get_metrics() const;
-    
+
     /**
      * @brief Benchmark GPU parser performance
      * @param message_count Number of messages to benchmark
@@ -81,37 +169,48 @@ public:
     static GPUMetrics benchmark_gpu_parsing(size_t message_count);
 
 private:
+    struct Slot;            // Pinned host buffers, device buffers, stream and events (cuda_parser.cu)
+    struct FramingBuffers;  // parse_stream() scratch, allocated on first use
+
     Config config_;
-    void* gpu_memory_pool_;
-    void* gpu_message_buffer_;
-    void* gpu_tick_buffer_;
-    
-#ifdef __CUDACC__
-    cudaStream_t* cuda_streams_;
-    cudaEvent_t* cuda_events_;
-#else
-    void** cuda_streams_;
-    void** cuda_events_;
-#endif
-    
+    std::unique_ptr<Slot[]> slots_;
+    size_t filling_ = 0;    // Slot being staged into
+    size_t oldest_ = 0;     // Oldest submitted slot
+    size_t in_flight_ = 0;
+    std::vector<common::CompactTick> completed_;  // Collected early to free a slot
+    std::unique_ptr<FramingBuffers> framing_;
+
+    GPUMetrics metrics_{};
+    uint64_t first_submit_ns_ = 0;
+
     bool initialize_cuda();
     void cleanup_cuda();
     void allocate_gpu_memory();
-    void launch_parsing_kernels(const char** messages, 
-                               const size_t* lengths, 
-                               size_t batch_size);
+
+    // Wait for the oldest in-flight slot and append its ticks
+    void finish_oldest(std::vector<common::CompactTick>& ticks);
+
+    bool allocate_framing_buffers();
+
+    // Frame and parse one piece of at most max_batch_bytes; returns bytes consumed
+    size_t frame_piece(const char* data, size_t length, std::vector<common::CompactTick>& ticks);
 };
 
 /**
  * @brief GPU kernel launcher functions (implemented in .cu file)
  */
 extern "C" {
-    void launch_parallel_fix_parser(const char** messages,
-                                   const size_t* lengths,
-                                   void* output_ticks,
-                                   size_t batch_size,
+    /**
+     * @brief Parse count messages stored back to back on the device
+     * @param offsets count + 1 offsets into data; message i is [offsets[i], offsets[i + 1])
+     */
+    void launch_parallel_fix_parser(const char* data,
+                                   const uint32_t* offsets,
+                                   common::CompactTick* output_ticks,
+                                   FieldRef* output_symbols,
+                                   size_t count,
                                    void* stream);
-    
+
     void launch_delimiter_scanner(const char* data,
                                  size_t* delimiter_positions,
                                  size_t data_length,
@@ -120,4 +219,4 @@ extern "C" {
 }
 
 } // namespace gpu
-} // namespace feedhandler
\ No newline at end of file
+} // namespace feedhandler
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+namespace feedhandler {
+namespace ml {
+
+/**
+ * @brief Zero-initialized array on a 64-byte boundary, allocated once
+ */
+template<typename T>
+class AlignedArray {
+public:
+    AlignedArray() = default;
+
+    explicit AlignedArray(size_t size)
+        : data_(static_cast<T*>(std::aligned_alloc(64, bytes(size))))
+        , size_(size) {
+        std::memset(static_cast<void*>(data_.get()), 0, bytes(size));
+    }
+
+    T* data() { return data_.get(); }
+    const T* data() const { return data_.get(); }
+    size_t size() const { return size_; }
+
+    T& operator[](size_t i) { return data_.get()[i]; }
+    const T& operator[](size_t i) const { return data_.get()[i]; }
+
+private:
+    // aligned_alloc needs a multiple of the alignment
+    static size_t bytes(size_t size) { return size > 0 ? (size * sizeof(T) + 63) / 64 * 64 : 64; }
+
+    struct FreeDeleter {
+        void operator()(T* p) const { std::free(p); }
+    };
+
+    std::unique_ptr<T[], FreeDeleter> data_;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Instruction set used by the int8 matrix-vector kernels
+ */
+enum class GemvKernel {
+    SCALAR,        ///< Portable int32 accumulation
+    AVX2,          ///< 16-bit multiply-add (VPMADDWD) on int16-packed weights
+    AVX512_VNNI,   ///< u8 x s8 dot products (VPDPBUSD), 64 weights per instruction
+    NEON           ///< SDOT on ARMv8.2 dot product cores, widening multiply otherwise
+};
+
+/**
+ * @brief Fastest kernel this CPU supports (detected once)
+ */
+GemvKernel detect_gemv_kernel();
+
+bool gemv_kernel_supported(GemvKernel kernel);
+
+const char* gemv_kernel_name(GemvKernel kernel);
+
+/**
+ * @brief Quantized weight matrix packed for one GEMV kernel
+ *
+ * Weights are interleaved so a kernel produces a whole tile of outputs
+ * per vector instruction and never needs a horizontal sum: rows are
+ * grouped into tiles of ROW_TILE, columns into groups of GROUP, and for
+ * each (tile, group) the GROUP weights of every row in the tile are
+ * stored next to each other. The kernel broadcasts one activation group
+ * and multiply-accumulates it against the tile in one instruction
+ * (VPDPBUSD covers 16 rows x 4 columns). Padding rows and columns are
+ * zero.
+ *
+ * The AVX2 layout widens weights to int16 once at pack time, in column
+ * pairs: VPMADDUBSW saturates on 8-bit operands, while VPMADDWD on
+ * 16-bit pairs cannot overflow. The VNNI layout also keeps 128 times
+ * each row's weight sum, to undo the +128 bias that turns signed
+ * activations into the unsigned operand VPDPBUSD expects.
+ */
+class PackedWeights {
+public:
+    static constexpr size_t ROW_TILE = 16;
+    static constexpr size_t GROUP = 4;
+    static constexpr size_t PADDING = 64;  ///< Activation vectors are padded to this many values
+
+    PackedWeights() = default;
+
+    /**
+     * @param weights rows x cols int8 weights, row-major
+     * @param kernel Kernel whose layout to build (downgraded if unsupported)
+     */
+    PackedWeights(const int8_t* weights, size_t rows, size_t cols, GemvKernel kernel);
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t padded_rows() const { return tiles_ * ROW_TILE; }
+    GemvKernel kernel() const { return kernel_; }
+
+    /**
+     * @brief out[r] = sum_c weight(r, c) * x[c]
+     * @param x padded(cols()) activations, 64-byte aligned, zero past cols()
+     * @param out padded_rows() accumulators, 64-byte aligned (entries past rows() are 0)
+     */
+    void gemv(const int8_t* x, int32_t* out) const;
+
+    /**
+     * @brief gemv() over count vectors, loading each weight block once per group of four
+     * @param x count activation vectors, x_stride apart (a multiple of PADDING)
+     * @param out count accumulator rows, out_stride apart (a multiple of ROW_TILE)
+     */
+    void gemm(const int8_t* x, size_t count, size_t x_stride, int32_t* out, size_t out_stride) const;
+
+    static size_t padded(size_t cols) { return (cols + PADDING - 1) / PADDING * PADDING; }
+
+private:
+    GemvKernel kernel_ = GemvKernel::SCALAR;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t tiles_ = 0;
+    size_t groups_ = 0;
+    AlignedArray<int8_t> weights8_;    // SCALAR, AVX512_VNNI, NEON
+    AlignedArray<int16_t> weights16_;  // AVX2
+    AlignedArray<int32_t> corrections_;  // AVX512_VNNI: 128 * row weight sum, padded_rows() entries
+};
+
+/**
+ * @brief Symmetric per-vector quantization to [-127, 127], rounding to nearest even
+ * @param out padded(count) values; entries past count are zeroed
+ * @return Scale such that x[i] ~ out[i] * scale (1 if x is all zero)
+ */
+double quantize_activations(const double* x, size_t count, int8_t* out);
+
+/**
+ * @brief Same, with max |x[i]| already known (e.g. tracked while writing x)
+ */
+double quantize_activations(const double* x, size_t count, double max_abs, int8_t* out);
+
+/**
+ * @brief Fused GEMV epilogue: out[i] = max(0, acc[i] * scale + bias[i])
+ * @return Largest out[i] (0 if count is 0), to quantize the next layer without a scan
+ */
+double dequantize_bias_relu(const int32_t* acc, size_t count, double scale, const double* bias, double* out);
+
+} // namespace ml
+} // namespace feedhandler
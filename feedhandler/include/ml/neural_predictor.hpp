@@ -3,8 +3,17 @@
 #include <vector>
 #include <memory>
 #include <array>
+#include <atomic>
+#include <cmath>
 #include <functional>
+#include <span>
+#include <string>
+#include <thread>
+#include "common/compact_tick.hpp"
 #include "common/tick.hpp"
+#include "ml/int8_gemv.hpp"
+#include "ml/streaming_features.hpp"
+#include "threading/spsc_ring.hpp"
 
 namespace feedhandler {
 namespace ml {
@@ -21,6 +30,24 @@ namespace ml {
  * - Quantized neural networks for speed
  * - Hardware-accelerated matrix operations
  * - Ensemble prediction models
+ *
+ * predict(tick) keeps a StreamingFeatures state per instrument ID, so
+ * feature extraction is O(1) per tick; the features are written into a
+ * fixed 64-byte aligned buffer that the network reads directly. The
+ * window-based predict() overload rebuilds the features from the whole
+ * history and is kept for callers that hold their own tick windows.
+ *
+ * With use_quantization each layer quantizes its input to int8 and runs
+ * an int8 GEMV on weights packed once for the best kernel the CPU has
+ * (AVX-512 VNNI, AVX2 or NEON); dequantization, bias and activation are
+ * one pass over the int32 accumulators. All activation buffers are
+ * allocated at construction, so inference does not touch the heap.
+ *
+ * predict_batch() stacks the feature vectors of up to MAX_BATCH
+ * instruments into a matrix and runs each layer as one int8 GEMM, so
+ * every weight block is loaded once per four instruments instead of
+ * once per instrument. Buffers are sized for MAX_BATCH rows; a single
+ * prediction uses the first.
  */
 class NeuralPredictor {
 public:
@@ -42,7 +69,61 @@ public:
         uint64_t prediction_time_ns; // Inference latency
     };
     
-    NeuralPredictor(const Config& config = {});
+    NeuralPredictor();
+    explicit NeuralPredictor(const Config& config);
+    
+    /// Features taken from the predicted tick itself (price, quantity, side)
+    static constexpr size_t TICK_FEATURES = 3;
+    
+    /// Rows per forward pass in predict_batch(); longer spans run in chunks
+    static constexpr size_t MAX_BATCH = 64;
+    
+    /**
+     * @brief Predict from the instrument's streaming state, then fold the tick into it
+     * @param current_tick Tick to predict from (keyed by instrument_id; an
+     *        invalid ID predicts from an empty history and keeps no state)
+     * @return Same result as predict(all earlier ticks of the instrument, current_tick)
+     */
+    Prediction predict(const common::Tick& current_tick);
+    
+    /**
+     * @brief Fold a tick into its instrument's features without predicting
+     */
+    void observe(const common::Tick& tick);
+    
+    /**
+     * @brief Predict every tick in one batched forward pass per MAX_BATCH ticks
+     *
+     * Typically one tick per instrument on a bar close. Ticks are handled
+     * in order, exactly as if predict() were called on each (including
+     * repeated instruments), and one Prediction per tick is appended to
+     * out. prediction_time_ns is the latency of the whole call; the
+     * metrics record the amortized time per prediction.
+     */
+    void predict_batch(std::span<const common::CompactTick> ticks, std::vector<Prediction>& out);
+    
+    /**
+     * @brief Feature buffer of the last prediction, or of the first row of
+     *        the last batch (config.input_features values, 64-byte aligned)
+     */
+    const double* features() const { return feature_buffer_.data(); }
+    
+    /**
+     * @brief Kernel the quantized forward pass runs on
+     */
+    GemvKernel gemv_kernel() const { return gemv_kernel_; }
+    
+    /**
+     * @brief Repack the weights for another kernel (downgraded if unsupported)
+     */
+    void set_gemv_kernel(GemvKernel kernel);
+    
+    /**
+     * @brief Streaming indicator state of an instrument (nullptr if never seen)
+     */
+    const StreamingFeatures* feature_state(common::InstrumentId id) const {
+        return id < feature_states_.size() ? &feature_states_[id] : nullptr;
+    }
     
     /**
      * @brief Make real-time prediction from tick data
@@ -100,34 +181,114 @@ private:
     std::vector<std::vector<int8_t>> quantized_weights_;
     std::vector<std::vector<double>> bias_vectors_;
     
+    // Inference layout, rebuilt by pack_layers()
+    GemvKernel gemv_kernel_;
+    std::vector<PackedWeights> packed_weights_;            // Per layer, with use_quantization
+    std::vector<std::vector<double>> dequantized_weights_; // Per layer, without it
+    // MAX_BATCH rows each; strides keep every row 64-byte aligned
+    AlignedArray<double> activations_[2];                  // Layer outputs, ping-pong
+    AlignedArray<int8_t> quantized_input_;                 // Current layer input as int8
+    AlignedArray<int32_t> accumulators_;                   // GEMM output
+    std::array<double, MAX_BATCH> input_scales_{};         // Per-row quantization scale
+    std::array<double, MAX_BATCH> input_max_{};            // Per-row max |input|, from the epilogue
+    size_t activation_stride_ = 0;
+    size_t quantized_stride_ = 0;
+    size_t accumulator_stride_ = 0;
+    
     // Feature extraction components
-    std::array<double, 20> sma_values_;     // Simple moving averages
-    std::array<double, 10> ema_values_;     // Exponential moving averages
-    std::array<double, 5> rsi_values_;      // RSI indicators
-    std::array<double, 3> bollinger_bands_; // Bollinger band values
+    std::vector<StreamingFeatures> feature_states_;  // Per instrument ID
+    AlignedArray<double> feature_buffer_;            // Network input, MAX_BATCH rows
+    size_t feature_stride_ = 0;
     
     // Performance tracking
     mutable ModelMetrics metrics_;
     std::vector<double> prediction_history_;
     std::vector<double> actual_history_;
     
-    // SIMD-optimized matrix operations
-    void simd_matrix_multiply(const std::vector<double>& input,
-                             const std::vector<std::vector<int8_t>>& weights,
-                             std::vector<double>& output);
+    // Pack weights for gemv_kernel_ and size the activation buffers from config_
+    void pack_layers();
+    
+    // State of a keyed instrument, created on first sight (nullptr for an invalid ID)
+    StreamingFeatures* state_for(common::InstrumentId id);
+    
+    // Fill one feature row from indicator state plus the tick's own fields
+    void write_features(const StreamingFeatures& state, int64_t price, int32_t qty, char side, double* row);
+    
+    // Forward pass over the first count feature rows (fills direction, confidence, volatility)
+    void infer(size_t count, Prediction* out);
+    
+    void record_predictions(size_t count, uint64_t elapsed_ns);
     
     double relu_activation(double x) { return std::max(0.0, x); }
     double sigmoid_activation(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+};
+
+/**
+ * @brief Runs a NeuralPredictor on a dedicated thread fed through an SPSC ring
+ *
+ * One producer thread submits ticks (e.g. every instrument's close when a
+ * bar ends); the worker pops whatever is queued, up to max_batch, runs a
+ * single predict_batch() over it and hands ticks and predictions to the
+ * callback, on the worker thread. The predictor's weights stay hot in
+ * that core's cache and the producer never waits for inference.
+ *
+ * While running, the worker owns the predictor: do not touch it from
+ * other threads between start() and stop(). start(), stop() and submit()
+ * belong to the producer thread.
+ */
+class InferenceThread {
+public:
+    struct Config {
+        size_t queue_capacity = 4096;
+        size_t max_batch = 256;
+        threading::WaitStrategy wait_strategy = threading::WaitStrategy::FUTEX_PARK;
+    };
+    
+    using BatchCallback = std::function<void(const common::CompactTick* ticks,
+                                             const NeuralPredictor::Prediction* predictions,
+                                             size_t count)>;
+    
+    InferenceThread(NeuralPredictor& predictor, BatchCallback callback);
+    InferenceThread(NeuralPredictor& predictor, BatchCallback callback, const Config& config);
+    ~InferenceThread();
+    
+    InferenceThread(const InferenceThread&) = delete;
+    InferenceThread& operator=(const InferenceThread&) = delete;
     
-    // Technical indicator calculations
-    double calculate_sma(const std::vector<common::Tick>& ticks, size_t period);
-    double calculate_ema(const std::vector<common::Tick>& ticks, size_t period);
-    double calculate_rsi(const std::vector<common::Tick>& ticks, size_t period);
-    std::array<double, 3> calculate_bollinger_bands(const std::vector<common::Tick>& ticks);
+    void start();
+    
+    /**
+     * @brief Predict everything already submitted, then join the worker
+     */
+    void stop();
+    
+    bool running() const { return running_; }
+    
+    /**
+     * @brief Queue a tick for prediction without blocking
+     * @return false (and counted as dropped) if the queue is full or the thread is stopped
+     */
+    bool submit(const common::CompactTick& tick);
+    
+    uint64_t submitted() const { return submitted_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t batches() const { return batches_.load(std::memory_order_relaxed); }
+    uint64_t predictions() const { return predictions_.load(std::memory_order_relaxed); }
+
+private:
+    void worker_loop();
+    
+    NeuralPredictor& predictor_;
+    BatchCallback callback_;
+    Config config_;
+    std::unique_ptr<threading::SpscRing<common::CompactTick>> ring_;
+    std::thread worker_;
+    bool running_ = false;
     
-    // Anomaly detection using statistical methods
-    bool detect_price_anomaly(const common::Tick& tick, 
-                             const std::vector<common::Tick>& history);
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> predictions_{0};
 };
 
 /**
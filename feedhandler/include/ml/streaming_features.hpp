@@ -0,0 +1,274 @@
+#pragma once
+
+#include "analytics/rolling_window.hpp"
+#include "common/compact_tick.hpp"
+#include "common/tick.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace feedhandler {
+namespace ml {
+
+/**
+ * @brief Technical indicators of one instrument, updated in O(1) per tick
+ *
+ * Keeps the last MAX_LOOKBACK prices and quantities in a ring and one
+ * running sum per indicator window, so an update adds the new tick's
+ * contribution and subtracts the one leaving each window instead of
+ * rescanning history. Price sums are exact fixed-point integers
+ * (128-bit for squares), so SMA, RSI, Bollinger and the anomaly z-score
+ * never drift; the log-return sums are doubles and are rebuilt from the
+ * ring every REBUILD_INTERVAL ticks.
+ *
+ * write() produces the same values, in the same order, as
+ * NeuralPredictor::extract_features() over the same tick history:
+ * - SMA over SMA_PERIODS (0 until the window is full)
+ * - EMA over EMA_PERIODS, seeded with the first price
+ * - RSI / 100 over RSI_PERIODS (0.5 until period + 1 prices)
+ * - Bollinger lower, middle, upper (20 ticks, 2 standard deviations)
+ * - 10-tick momentum, 5-tick average quantity / 1000, and the standard
+ *   deviation (in %) of the last 19 log returns
+ *
+ * Not thread-safe: one state per instrument, owned by one thread.
+ */
+class StreamingFeatures {
+public:
+    static constexpr std::array<size_t, 6> SMA_PERIODS{5, 10, 20, 50, 100, 200};
+    static constexpr std::array<size_t, 4> EMA_PERIODS{5, 10, 20, 50};
+    static constexpr std::array<size_t, 3> RSI_PERIODS{14, 21, 30};
+    static constexpr size_t BOLLINGER_PERIOD = 20;
+    static constexpr size_t MOMENTUM_LAG = 10;
+    static constexpr size_t VOLUME_PERIOD = 5;
+    static constexpr size_t VOLATILITY_RETURNS = 19;
+    static constexpr size_t ANOMALY_PERIOD = 50;
+    static constexpr size_t REBUILD_INTERVAL = 1024;
+
+    /// Values written by write()
+    static constexpr size_t FEATURE_COUNT =
+        SMA_PERIODS.size() + EMA_PERIODS.size() + RSI_PERIODS.size() + 3 + 3;
+
+    /// Prices kept: the longest SMA, plus one for the change leaving an RSI window
+    static constexpr size_t MAX_LOOKBACK = 201;
+
+    StreamingFeatures() : history_(MAX_LOOKBACK) {}
+
+    void update(const common::Tick& tick) { update(tick.price, tick.qty); }
+    void update(const common::CompactTick& tick) { update(tick.price, tick.qty); }
+
+    /**
+     * @brief Fold one trade into every indicator
+     * @param price Fixed-point price (ignored unless positive)
+     */
+    void update(int64_t price, int32_t qty) {
+        if (price <= 0) {
+            return;
+        }
+        size_t n = history_.size();  // Prices before this one, within the ring
+
+        for (size_t k = 0; k < SMA_PERIODS.size(); ++k) {
+            sma_sums_[k] += price;
+            if (n >= SMA_PERIODS[k]) {
+                sma_sums_[k] -= history_[n - SMA_PERIODS[k]].price;
+            }
+        }
+
+        double unit_price = static_cast<double>(price) / 10000.0;
+        for (size_t k = 0; k < EMA_PERIODS.size(); ++k) {
+            ema_values_[k] = count_ == 0 ? unit_price
+                : ema_values_[k] + 2.0 / (EMA_PERIODS[k] + 1.0) * (unit_price - ema_values_[k]);
+        }
+
+        if (n > 0) {
+            int64_t change = price - history_.back().price;
+            for (size_t k = 0; k < RSI_PERIODS.size(); ++k) {
+                add_change(k, change, 1);
+                if (n > RSI_PERIODS[k]) {
+                    add_change(k, history_[n - RSI_PERIODS[k]].price - history_[n - RSI_PERIODS[k] - 1].price, -1);
+                }
+            }
+        }
+
+        add_window_price(bollinger_, price, n, BOLLINGER_PERIOD);
+        add_window_price(anomaly_, price, n, ANOMALY_PERIOD);
+
+        volume_sum_ += qty;
+        if (n >= VOLUME_PERIOD) {
+            volume_sum_ -= history_[n - VOLUME_PERIOD].qty;
+        }
+
+        if (n > 0) {
+            double r = std::log(static_cast<double>(price) / static_cast<double>(history_.back().price));
+            return_sum_ += r;
+            return_squares_ += r * r;
+            if (n > VOLATILITY_RETURNS) {
+                double old = log_return(n - VOLATILITY_RETURNS);
+                return_sum_ -= old;
+                return_squares_ -= old * old;
+            }
+        }
+
+        history_.push_back(Entry{price, qty});
+        ++count_;
+        if (++since_rebuild_ >= REBUILD_INTERVAL) {
+            rebuild_returns();
+        }
+    }
+
+    /**
+     * @brief Write the FEATURE_COUNT indicator values to out
+     */
+    void write(double* out) const {
+        size_t n = history_.size();
+        size_t i = 0;
+
+        for (size_t k = 0; k < SMA_PERIODS.size(); ++k) {
+            out[i++] = count_ >= SMA_PERIODS[k]
+                ? static_cast<double>(sma_sums_[k]) / 10000.0 / static_cast<double>(SMA_PERIODS[k]) : 0.0;
+        }
+        for (size_t k = 0; k < EMA_PERIODS.size(); ++k) {
+            out[i++] = ema_values_[k];
+        }
+        for (size_t k = 0; k < RSI_PERIODS.size(); ++k) {
+            out[i++] = rsi(k) / 100.0;
+        }
+
+        if (count_ >= BOLLINGER_PERIOD) {
+            double mean = window_mean(bollinger_, BOLLINGER_PERIOD);
+            double band = 2.0 * window_std(bollinger_, BOLLINGER_PERIOD);
+            out[i++] = mean - band;
+            out[i++] = mean;
+            out[i++] = mean + band;
+        } else {
+            out[i++] = 0.0;
+            out[i++] = 0.0;
+            out[i++] = 0.0;
+        }
+
+        if (count_ >= MOMENTUM_LAG) {
+            double current = static_cast<double>(history_.back().price) / 10000.0;
+            double past = static_cast<double>(history_[n - MOMENTUM_LAG].price) / 10000.0;
+            out[i++] = (current - past) / past;
+        } else {
+            out[i++] = 0.0;
+        }
+
+        out[i++] = count_ >= VOLUME_PERIOD
+            ? static_cast<double>(volume_sum_) / static_cast<double>(VOLUME_PERIOD) / 1000.0 : 0.0;
+
+        if (count_ >= VOLATILITY_RETURNS + 1) {
+            double mean = return_sum_ / VOLATILITY_RETURNS;
+            double variance = return_squares_ / VOLATILITY_RETURNS - mean * mean;
+            out[i++] = std::sqrt(std::max(variance, 0.0)) * 100.0;
+        } else {
+            out[i++] = 0.0;
+        }
+    }
+
+    /**
+     * @brief True if price is more than 3 standard deviations from the last 50
+     */
+    bool is_anomaly(int64_t price) const {
+        if (count_ < ANOMALY_PERIOD) {
+            return false;
+        }
+        double mean = window_mean(anomaly_, ANOMALY_PERIOD);
+        double std_dev = window_std(anomaly_, ANOMALY_PERIOD);
+        return std::abs(static_cast<double>(price) / 10000.0 - mean) / std_dev > 3.0;
+    }
+
+    /**
+     * @brief Ticks folded in since construction or reset()
+     */
+    uint64_t ticks() const { return count_; }
+
+    void reset() { *this = StreamingFeatures(); }
+
+private:
+    struct Entry {
+        int64_t price;
+        int32_t qty;
+    };
+
+    // Exact price sum and sum of squares over the last `period` prices
+    struct PriceWindow {
+        int64_t sum = 0;
+        __int128 squares = 0;
+    };
+
+    void add_window_price(PriceWindow& window, int64_t price, size_t n, size_t period) {
+        window.sum += price;
+        window.squares += static_cast<__int128>(price) * price;
+        if (n >= period) {
+            int64_t old = history_[n - period].price;
+            window.sum -= old;
+            window.squares -= static_cast<__int128>(old) * old;
+        }
+    }
+
+    static double window_mean(const PriceWindow& window, size_t period) {
+        return static_cast<double>(window.sum) / 10000.0 / static_cast<double>(period);
+    }
+
+    // Population standard deviation: sqrt(n * sum(x^2) - sum(x)^2) / n, exact until the square root
+    static double window_std(const PriceWindow& window, size_t period) {
+        __int128 spread = static_cast<__int128>(period) * window.squares
+                        - static_cast<__int128>(window.sum) * window.sum;
+        return std::sqrt(static_cast<double>(spread)) / 10000.0 / static_cast<double>(period);
+    }
+
+    void add_change(size_t k, int64_t change, int sign) {
+        if (change > 0) {
+            gain_sums_[k] += sign * change;
+        } else {
+            loss_sums_[k] -= sign * change;
+        }
+    }
+
+    double rsi(size_t k) const {
+        if (count_ < RSI_PERIODS[k] + 1) {
+            return 50.0;
+        }
+        if (loss_sums_[k] == 0) {
+            return 100.0;
+        }
+        double rs = static_cast<double>(gain_sums_[k]) / static_cast<double>(loss_sums_[k]);
+        return 100.0 - 100.0 / (1.0 + rs);
+    }
+
+    // Log return from history_[i - 1] to history_[i]
+    double log_return(size_t i) const {
+        return std::log(static_cast<double>(history_[i].price) / static_cast<double>(history_[i - 1].price));
+    }
+
+    void rebuild_returns() {
+        return_sum_ = 0.0;
+        return_squares_ = 0.0;
+        size_t n = history_.size();
+        for (size_t i = n > VOLATILITY_RETURNS ? n - VOLATILITY_RETURNS : 1; i < n; ++i) {
+            double r = log_return(i);
+            return_sum_ += r;
+            return_squares_ += r * r;
+        }
+        since_rebuild_ = 0;
+    }
+
+    analytics::HistoryRing<Entry> history_;
+    std::array<int64_t, SMA_PERIODS.size()> sma_sums_{};
+    std::array<double, EMA_PERIODS.size()> ema_values_{};
+    std::array<int64_t, RSI_PERIODS.size()> gain_sums_{};
+    std::array<int64_t, RSI_PERIODS.size()> loss_sums_{};
+    PriceWindow bollinger_;
+    PriceWindow anomaly_;
+    int64_t volume_sum_ = 0;
+    double return_sum_ = 0.0;      // Last VOLATILITY_RETURNS log returns
+    double return_squares_ = 0.0;
+    uint64_t count_ = 0;
+    size_t since_rebuild_ = 0;
+};
+
+} // namespace ml
+} // namespace feedhandler
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "common/latency_histogram.hpp"
+#include "config/performance_config.hpp"
+#include "threading/threaded_feedhandler.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace feedhandler {
+namespace monitoring {
+
+enum class MetricsFormat {
+    JSON,       ///< One object with "counters", "gauges" and "histograms"
+    PROMETHEUS  ///< Text exposition format (histograms as summaries)
+};
+
+/**
+ * @brief Where and how often MetricsExporter publishes
+ */
+struct MetricsExporterConfig {
+    int update_interval_ms = 1000;
+    std::string output_file = "performance_metrics.json";  // Empty = no file
+    MetricsFormat format = MetricsFormat::JSON;
+    std::string shm_name;                                   // POSIX shm object for a sidecar, empty = off
+    size_t shm_size = 1 << 20;                              // Bytes reserved for the shm text
+
+    /**
+     * @brief Interval and file from MonitoringConfig; a .prom or .txt file selects Prometheus
+     */
+    static MetricsExporterConfig from_monitoring(const config::PerformanceConfig::MonitoringConfig& monitoring);
+};
+
+/**
+ * @brief Header of the shared-memory segment, followed by the text
+ *
+ * The exporter bumps sequence to odd, rewrites length and text, then
+ * bumps it to even. A reader copies the text and retries if sequence
+ * was odd or changed meanwhile (read_shared_metrics() does this).
+ */
+struct MetricsShmHeader {
+    std::atomic<uint64_t> sequence;
+    uint64_t length;
+    uint64_t capacity;
+    uint64_t format;  // MetricsFormat
+};
+
+/**
+ * @brief Background thread that periodically publishes pipeline metrics
+ *
+ * Sources are registered before start(): counters and gauges as reader
+ * functions (typically a relaxed load of a component's atomic), latency
+ * histograms as AtomicLatencyHistogram pointers read with snapshot().
+ * Every update_interval_ms the exporter thread reads all of them, renders
+ * JSON or Prometheus text and replaces output_file through a rename, so
+ * a scraper never sees a partial file; with shm_name set the same text
+ * also goes to a seqlock-guarded shared-memory segment.
+ *
+ * Nothing here takes a lock the hot path uses: components keep writing
+ * their own atomics and histograms, and the exporter only reads them.
+ *
+ * @code
+ * MetricsExporter exporter(MetricsExporterConfig::from_monitoring(config.monitoring()));
+ * exporter.add_feed_handler("feed", handler.get_statistics());
+ * exporter.add_histogram("book_latency_ns", &integration.book_latency());
+ * exporter.start();
+ * @endcode
+ */
+class MetricsExporter {
+public:
+    using ValueReader = std::function<uint64_t()>;
+
+    explicit MetricsExporter(const MetricsExporterConfig& config);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * @brief Monotonic counter (Prometheus TYPE counter); register before start()
+     */
+    void add_counter(const std::string& name, ValueReader reader);
+    void add_counter(const std::string& name, const std::atomic<uint64_t>& counter);
+    void add_counter(const std::string& name, const common::StatCounter& counter);
+
+    /**
+     * @brief Value that can go down, e.g. a queue depth; register before start()
+     */
+    void add_gauge(const std::string& name, ValueReader reader);
+
+    /**
+     * @brief Latency distribution in ns; the histogram must outlive the exporter
+     */
+    void add_histogram(const std::string& name, const common::AtomicLatencyHistogram* histogram);
+
+    /**
+     * @brief Every counter and histogram of a ThreadedFeedHandler, as prefix_<name>
+     */
+    void add_feed_handler(const std::string& prefix, const threading::ThreadedFeedHandler::Statistics& stats);
+
+    /**
+     * @brief Open the shm segment (if configured) and launch the exporter thread
+     * @return false if the shm segment could not be created
+     */
+    bool start();
+
+    /**
+     * @brief Publish one last time and join the thread
+     */
+    void stop();
+
+    /**
+     * @brief Render and publish now (any thread)
+     * @return false if a configured output could not be written
+     */
+    bool export_now();
+
+    /**
+     * @brief Current metrics as text
+     */
+    std::string render(MetricsFormat format) const;
+
+    uint64_t exports() const { return exports_.load(std::memory_order_relaxed); }
+    bool is_running() const { return running_.load(std::memory_order_relaxed); }
+
+private:
+    enum class Kind { COUNTER, GAUGE };
+
+    struct ValueSource {
+        std::string name;
+        Kind kind;
+        ValueReader reader;
+    };
+
+    struct HistogramSource {
+        std::string name;
+        const common::AtomicLatencyHistogram* histogram;
+    };
+
+    std::string render_json() const;
+    std::string render_prometheus() const;
+    bool write_file(const std::string& text);
+    bool open_shm();
+    void close_shm();
+    void write_shm(const std::string& text);
+    void run();
+
+    MetricsExporterConfig config_;
+    std::vector<ValueSource> values_;
+    std::vector<HistogramSource> histograms_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::mutex wake_mutex_;            // Exporter thread only; never touched by components
+    std::condition_variable wake_;
+    std::mutex export_mutex_;          // Serializes export_now() with the thread
+    std::atomic<uint64_t> exports_{0};
+
+    MetricsShmHeader* shm_ = nullptr;
+    size_t shm_mapped_ = 0;
+};
+
+/**
+ * @brief Copy the latest text out of an exporter's shm segment (sidecar side)
+ * @return false if the segment does not exist or never stabilized
+ */
+bool read_shared_metrics(const std::string& shm_name, std::string& text);
+
+} // namespace monitoring
+} // namespace feedhandler
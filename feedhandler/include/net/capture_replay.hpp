@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace feedhandler {
+namespace net {
+
+enum class CaptureFormat {
+    AUTO,   // PCAP if the file starts with a pcap magic number, else RAW
+    RAW,    // FIX messages as received, newline separated
+    PCAP    // libpcap capture (Ethernet, Linux SLL or raw IP; TCP/UDP payloads)
+};
+
+enum class ReplayPacing {
+    MAX_SPEED,  // Deliver back to back
+    ORIGINAL    // Reproduce the capture's inter-arrival gaps (scaled by speed)
+};
+
+struct CaptureReplayConfig {
+    CaptureFormat format = CaptureFormat::AUTO;
+    ReplayPacing pacing = ReplayPacing::MAX_SPEED;
+    double speed = 1.0;             // ORIGINAL only: 2.0 replays twice as fast
+    bool sequential_hint = true;    // madvise(MADV_SEQUENTIAL): aggressive readahead
+    bool hugepage_hint = false;     // madvise(MADV_HUGEPAGE), where the filesystem supports it
+    size_t chunk_size = 64 * 1024;  // RAW at MAX_SPEED: bytes per delivery, cut after a newline
+    bool split_messages = false;    // RAW at MAX_SPEED: one line per delivery, with its timestamp
+};
+
+// Replays a capture file from a read-only memory mapping
+//
+// Payloads are handed to the callback as pointers into the mapping, so
+// nothing is copied on the way to the parser; they stay valid until
+// close(). Timestamps are capture time in ns since the epoch: the pcap
+// record time, or tag 52 SendingTime for RAW captures (0 if absent).
+//
+// RAW at MAX_SPEED delivers chunk_size pieces ending after a newline;
+// with ORIGINAL pacing or split_messages each line is delivered on its
+// own. PCAP always delivers one packet payload per call; packets without
+// a TCP/UDP payload (handshakes, ACKs, other protocols) are skipped.
+//
+// next() is the same replay as a cursor, for consumers that pull (e.g.
+// one TimestampMerger source per capture file).
+class CaptureReplay {
+public:
+    using Callback = std::function<void(const char* data, size_t length, uint64_t timestamp_ns)>;
+
+    struct Delivery {
+        const char* data = nullptr;
+        size_t length = 0;
+        uint64_t timestamp_ns = 0;
+    };
+
+    struct Stats {
+        uint64_t deliveries = 0;
+        uint64_t bytes = 0;
+        uint64_t skipped_packets = 0;   // PCAP records with no usable payload
+        uint64_t truncated_records = 0; // PCAP record running past end of file (stops replay)
+    };
+
+    CaptureReplay();
+    explicit CaptureReplay(const CaptureReplayConfig& config);
+    ~CaptureReplay();
+
+    CaptureReplay(const CaptureReplay&) = delete;
+    CaptureReplay& operator=(const CaptureReplay&) = delete;
+
+    // Map the file; false (with a message on stderr) if it cannot be opened
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return data_ != nullptr; }
+
+    // Format after AUTO detection
+    CaptureFormat format() const { return format_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // Deliver the whole capture; returns number of callback invocations.
+    // May be called again to replay from the start.
+    size_t replay(const Callback& callback);
+
+    // Next delivery of the replay, paced as replay() paces it; false at
+    // the end of the capture. rewind() starts over (replay() rewinds too).
+    bool next(Delivery& delivery);
+    void rewind();
+
+    const Stats& get_stats() const { return stats_; }
+
+private:
+    bool next_raw(Delivery& delivery);
+    bool next_pcap(Delivery& delivery);
+
+    // ORIGINAL pacing: wait until timestamp_ns is due relative to the first one
+    void pace(uint64_t timestamp_ns);
+
+    CaptureReplayConfig config_;
+    CaptureFormat format_;
+    const char* data_;
+    size_t size_;
+    Stats stats_;
+    uint64_t first_timestamp_;
+    int64_t start_ns_;      // Wall clock (steady) at the first delivery
+    size_t position_;       // Cursor into the mapping
+    bool pcap_swap_;        // Capture written with the other byte order
+    bool pcap_nanosecond_;
+    uint32_t pcap_link_type_;
+};
+
+} // namespace net
+} // namespace feedhandler
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "net/kernel_bypass_ingress.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct rte_mbuf;
+struct rte_mempool;
+
+namespace feedhandler {
+namespace net {
+
+struct DpdkBackendConfig {
+    std::vector<std::string> eal_args;   // e.g. {"-l", "2-5", "-a", "0000:3b:00.0"}
+    uint16_t port_id = 0;
+    uint16_t rx_queues = 4;              // One RSS queue per ingress worker
+    uint16_t rx_descriptors = 1024;
+    uint32_t mbuf_count = 8191;
+    uint32_t mbuf_cache = 256;
+    size_t max_burst = 32;
+    bool promiscuous = false;
+};
+
+// DPDK poll-mode RX backend for KernelBypassIngress
+//
+// Initializes the EAL, creates the mbuf pool on the port's NUMA node and
+// configures the port for RSS over IP/UDP so each flow lands on one RX
+// queue. rx_burst() hands out pointers into the mbufs; release() frees
+// the last burst of that queue in bulk. Each queue must be polled by a
+// single thread. Only built with -DFEED_DPDK=ON.
+class DpdkBackend {
+public:
+    explicit DpdkBackend(const DpdkBackendConfig& config);
+    ~DpdkBackend();
+
+    DpdkBackend(const DpdkBackend&) = delete;
+    DpdkBackend& operator=(const DpdkBackend&) = delete;
+
+    // EAL init, mempool, port/queue setup and start
+    bool open();
+    void close();
+
+    uint16_t queue_count() const { return config_.rx_queues; }
+    size_t rx_burst(uint16_t queue, RxPacket* out, size_t max);
+    void release(uint16_t queue);
+
+    // NIC drop counters (rte_eth_stats imissed + rx_nombuf)
+    uint64_t dropped() const;
+
+private:
+    struct alignas(64) QueueBurst {
+        std::vector<rte_mbuf*> mbufs;
+        uint16_t count = 0;
+    };
+
+    DpdkBackendConfig config_;
+    rte_mempool* pool_ = nullptr;
+    std::vector<QueueBurst> bursts_;
+    bool started_ = false;
+};
+
+using DpdkIngress = KernelBypassIngress<DpdkBackend>;
+
+} // namespace net
+} // namespace feedhandler
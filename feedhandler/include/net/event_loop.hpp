@@ -1,29 +1,120 @@
 #pragma once
 
 #include <sys/select.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 namespace feedhandler {
 namespace net {
 
+// Readiness mechanism behind EventLoop
+enum class EventBackend {
+    SELECT,     // Portable fallback, O(max_fd) per cycle
+    EPOLL,      // Linux epoll, edge-triggered by default
+    IO_URING    // Linux io_uring multishot poll, completions reaped in batches
+};
+
+struct EventLoopConfig {
+    EventBackend backend = EventBackend::EPOLL;
+    bool edge_triggered = true;   // EPOLL only: report each socket once per new data
+    size_t max_events = 64;       // Events drained per run_once()
+    unsigned ring_entries = 256;  // IO_URING only: submission queue depth
+};
+
 class EventLoop {
 public:
-    EventLoop();
+    // Invoked from run_once() with the readable socket
+    using ReadCallback = std::function<void(int sock)>;
+    // Invoked from run_once() with the writable socket
+    using WriteCallback = std::function<void(int sock)>;
+
+    // Falls back to EPOLL (or SELECT off Linux) when the requested
+    // backend is unavailable; backend() reports what is in use
+    explicit EventLoop(const EventLoopConfig& config = EventLoopConfig());
     ~EventLoop();
-    
-    void add_socket(int sock);
+
+    // Non-copyable
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    bool add_socket(int sock);
+    bool add_socket(int sock, ReadCallback callback);
     void remove_socket(int sock);
-    
-    // Run one select cycle with timeout (milliseconds)
-    // Returns true if socket became readable, false on timeout
+
+    // Report a registered socket writable once: the next run_once() that
+    // sees it writable calls callback (after the read callbacks) and
+    // disarms. For a non-blocking connect or a send ring that had to
+    // wait; call again to wait again.
+    bool watch_writable(int sock, WriteCallback callback);
+
+    // Wait up to timeout_ms (milliseconds) and dispatch callbacks of
+    // readable (then watched writable) sockets. Returns true if a socket
+    // became readable or writable, false on timeout or error.
+    //
+    // With edge-triggered epoll or io_uring a socket is reported once per
+    // arrival of new data, so callbacks must read until EAGAIN.
     bool run_once(int timeout_ms = 1000);
-    
+
+    // Readable in the last run_once()
     bool is_readable(int sock) const;
-    
+    const std::vector<int>& ready_sockets() const { return ready_; }
+
+    EventBackend backend() const { return backend_; }
+    size_t socket_count() const { return sockets_.size(); }
+
 private:
+    struct Uring;
+
+    struct Slot {
+        ReadCallback callback;
+        WriteCallback write_callback;
+        bool registered = false;
+        bool readable = false;
+        bool write_armed = false;
+    };
+
+    bool init_epoll();
+    bool init_uring();
+    bool run_select(int timeout_ms);
+    bool run_epoll(int timeout_ms);
+    bool run_uring(int timeout_ms);
+    void arm_uring(int sock);
+    void mark_ready(int sock);
+    void mark_writable(int sock);
+    bool epoll_interest(int sock, bool write);
+
+    EventLoopConfig config_;
+    EventBackend backend_;
+
+    std::vector<int> sockets_;
+    std::vector<Slot> slots_;  // Indexed by fd
+    std::vector<int> ready_;
+    std::vector<int> writable_;
+    size_t write_watches_;
+
+    // SELECT
     fd_set readfds_;
+    fd_set writefds_;
     int max_fd_;
-    std::vector<int> sockets_;
+
+    // EPOLL
+    int epoll_fd_;
+#ifdef __linux__
+    std::vector<epoll_event> epoll_events_;
+#endif
+
+    // IO_URING
+    std::unique_ptr<Uring> uring_;
+
+    // common::Tracer stage around each callback
+    uint16_t trace_dispatch_;
 };
 
 } // namespace net
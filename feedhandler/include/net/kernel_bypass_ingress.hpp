@@ -0,0 +1,186 @@
+#pragma once
+
+#include "common/stat_counter.hpp"
+#include "common/tick.hpp"
+#include "net/packet_headers.hpp"
+#include "parser/fsm_fix_parser.hpp"
+#include "threading/threaded_feedhandler.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace feedhandler {
+namespace net {
+
+// One received frame as the backend hands it over: Ethernet onwards,
+// pointing into backend-owned memory (an mbuf) until release()
+struct RxPacket {
+    const char* data = nullptr;
+    size_t length = 0;
+    uint64_t timestamp_ns = 0;   // NIC timestamp if the backend has one, else 0
+};
+
+struct BypassIngressConfig {
+    std::vector<int> queue_cpus;   // queue_cpus[q] = core for RX queue q; -1 or missing = unpinned
+    size_t burst_size = 32;        // Frames per rx_burst
+    uint16_t udp_port = 0;         // Only deliver this destination port (0 = any)
+};
+
+// Per-queue counters, written only by the queue's worker: plain stores,
+// each on its own cache line so readers polling one never stall the rest
+struct BypassQueueStats {
+    common::LocalCounter rx_packets;
+    common::LocalCounter rx_bytes;
+    common::LocalCounter filtered;         // Not UDP, or not for udp_port
+    common::LocalCounter messages_parsed;
+    common::LocalCounter bursts;           // Non-empty rx_burst calls
+    common::LocalCounter empty_polls;
+};
+
+// Kernel-bypass ingress: NIC RX queues straight to the FIX parser
+//
+// Each RX queue (fed by RSS) gets its own worker thread pinned to
+// queue_cpus[q], its own FSMFixParser and its own tick buffer, so queues
+// share nothing and the kernel socket path is not involved. A worker
+// busy-polls its queue; every burst is parsed in place from the
+// backend's buffers (headers stripped, UDP payload handed to the parser
+// without a copy), the ticks are delivered, and only then are the
+// buffers released. Datagrams are self-contained, so the parser restarts
+// at each one; ticks carry the backend's RX timestamp when it has one.
+//
+// Backend is any type with:
+//   uint16_t queue_count() const;
+//   size_t rx_burst(uint16_t queue, RxPacket* out, size_t max);  // Non-blocking
+//   void release(uint16_t queue);   // Return the buffers of the last burst
+// DpdkBackend (net/dpdk_backend.hpp) is the production one.
+template<typename Backend>
+class KernelBypassIngress {
+public:
+    using BatchCallback = std::function<void(uint16_t queue, std::span<const common::Tick> ticks)>;
+
+    KernelBypassIngress(Backend& backend, const BypassIngressConfig& config, BatchCallback callback)
+        : backend_(backend), config_(config), callback_(std::move(callback)) {
+        if (config_.burst_size == 0) {
+            config_.burst_size = 1;
+        }
+        uint16_t queues = backend_.queue_count();
+        queues_.reserve(queues);
+        for (uint16_t q = 0; q < queues; ++q) {
+            auto queue = std::make_unique<Queue>();
+            queue->burst.resize(config_.burst_size);
+            queue->ticks.reserve(config_.burst_size * 4);
+            queues_.push_back(std::move(queue));
+        }
+    }
+
+    ~KernelBypassIngress() { stop(); }
+
+    KernelBypassIngress(const KernelBypassIngress&) = delete;
+    KernelBypassIngress& operator=(const KernelBypassIngress&) = delete;
+
+    // Launch one pinned polling worker per RX queue
+    void start() {
+        if (running_.exchange(true)) {
+            return;
+        }
+        for (uint16_t q = 0; q < queues_.size(); ++q) {
+            queues_[q]->worker = std::thread([this, q] { worker_loop(q); });
+            if (q < config_.queue_cpus.size() && config_.queue_cpus[q] >= 0) {
+                threading::ThreadedFeedHandler::pin_thread(queues_[q]->worker, config_.queue_cpus[q]);
+            }
+        }
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+        for (auto& queue : queues_) {
+            if (queue->worker.joinable()) {
+                queue->worker.join();
+            }
+        }
+    }
+
+    // One rx_burst on queue q, parsed and delivered; returns frames received.
+    // Call directly to drive a queue from your own loop instead of start().
+    size_t poll_queue(uint16_t q) {
+        Queue& queue = *queues_[q];
+        BypassQueueStats& stats = queue.stats;
+        size_t received = backend_.rx_burst(q, queue.burst.data(), queue.burst.size());
+        if (received == 0) {
+            stats.empty_polls.add();
+            return 0;
+        }
+
+        queue.ticks.clear();
+        uint64_t bytes = 0;
+        uint64_t filtered = 0;
+        for (size_t i = 0; i < received; ++i) {
+            const RxPacket& packet = queue.burst[i];
+            bytes += packet.length;
+
+            const unsigned char* ip = nullptr;
+            size_t ip_length = 0;
+            L4Payload payload;
+            if (!ethernet_to_ip(reinterpret_cast<const unsigned char*>(packet.data), packet.length, ip, ip_length) ||
+                !ip_to_l4(ip, ip_length, payload) || payload.protocol != IP_PROTO_UDP ||
+                (config_.udp_port != 0 && payload.dst_port != config_.udp_port)) {
+                ++filtered;
+                continue;
+            }
+
+            queue.parser.reset();
+            queue.parser.set_receive_timestamp(packet.timestamp_ns);
+            queue.parser.parse(payload.data, payload.length, queue.ticks);
+        }
+
+        stats.rx_packets.add(received);
+        stats.rx_bytes.add(bytes);
+        stats.filtered.add(filtered);
+        stats.messages_parsed.add(queue.ticks.size());
+        stats.bursts.add();
+
+        if (!queue.ticks.empty() && callback_) {
+            callback_(q, std::span<const common::Tick>(queue.ticks.data(), queue.ticks.size()));
+        }
+        backend_.release(q);
+        return received;
+    }
+
+    uint16_t queue_count() const { return static_cast<uint16_t>(queues_.size()); }
+    const BypassQueueStats& queue_stats(uint16_t q) const { return queues_[q]->stats; }
+    bool is_running() const { return running_.load(std::memory_order_relaxed); }
+
+private:
+    struct Queue {
+        parser::FSMFixParser parser;
+        std::vector<common::Tick> ticks;
+        std::vector<RxPacket> burst;
+        BypassQueueStats stats;
+        std::thread worker;
+    };
+
+    void worker_loop(uint16_t q) {
+        while (running_.load(std::memory_order_relaxed)) {
+            if (poll_queue(q) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    Backend& backend_;
+    BypassIngressConfig config_;
+    BatchCallback callback_;
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::atomic<bool> running_{false};
+};
+
+} // namespace net
+} // namespace feedhandler
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace feedhandler {
+namespace net {
+
+// First and last message sequence number carried by one datagram
+// (first == 0: the datagram has no sequence and bypasses arbitration)
+struct SequenceRange {
+    uint64_t first = 0;
+    uint64_t last = 0;
+};
+
+// Extracts a datagram's sequence range; the default reads FIX 34 MsgSeqNum
+using SequenceExtractor = SequenceRange (*)(const char* data, size_t length);
+
+// Every 34= at a field start in a FIX datagram
+SequenceRange fix_sequence_range(const char* data, size_t length);
+
+struct MulticastLine {
+    std::string group;       // Multicast group; a unicast address binds plainly (tests, retransmits)
+    uint16_t port = 0;       // 0 = ephemeral (see MulticastReceiver::local_port)
+};
+
+struct MulticastReceiverConfig {
+    MulticastLine line_a;
+    MulticastLine line_b;                  // Leave group empty for a single line
+    std::string interface_address = "0.0.0.0";  // Interface for IP_ADD_MEMBERSHIP
+    size_t batch_size = 64;                // Datagrams per recvmmsg call
+    size_t max_datagram = 9000;            // Jumbo frames
+    int socket_buffer_bytes = 8 << 20;     // SO_RCVBUF
+    bool timestamping = true;              // SO_TIMESTAMPING (hardware if the NIC has it)
+    SequenceExtractor sequence = fix_sequence_range;
+};
+
+// UDP multicast receiver for redundant A/B feed lines
+//
+// poll() drains up to batch_size datagrams from each line with one
+// recvmmsg() per socket, merges them by sequence number and delivers
+// every sequence once: whichever line carried it first wins, the copy on
+// the other line is dropped as a duplicate, and sequences missing from
+// both lines are counted as a gap. Payloads are passed as pointers into
+// the receiver's preallocated batch buffers (valid during the callback
+// only), so nothing is copied on the way to the parser.
+//
+// Timestamps are the NIC hardware time when SO_TIMESTAMPING provides it,
+// the kernel receive time otherwise, in ns since the epoch.
+//
+// Sockets are non-blocking; register fd(0)/fd(1) with an EventLoop or
+// call poll() in a spin loop.
+class MulticastReceiver {
+public:
+    using PayloadCallback = std::function<void(const char* data, size_t length, uint64_t timestamp_ns)>;
+
+    struct Stats {
+        uint64_t datagrams[2] = {0, 0};   // Per line, including duplicates
+        uint64_t delivered = 0;
+        uint64_t duplicates = 0;          // Already delivered from the other line (or repeated)
+        uint64_t gaps = 0;                // Times the sequence jumped
+        uint64_t missing_messages = 0;    // Sequence numbers skipped by those jumps
+        uint64_t hardware_timestamps = 0;
+        uint64_t software_timestamps = 0;
+        uint64_t truncated = 0;           // Datagrams larger than max_datagram
+    };
+
+    MulticastReceiver();
+    explicit MulticastReceiver(const MulticastReceiverConfig& config);
+    ~MulticastReceiver();
+
+    MulticastReceiver(const MulticastReceiver&) = delete;
+    MulticastReceiver& operator=(const MulticastReceiver&) = delete;
+
+    // Create, bind and join the configured lines
+    bool open();
+    void close();
+    bool is_open() const { return fds_[0] != -1; }
+
+    // Receive and deliver what is available; returns datagrams delivered
+    size_t poll(const PayloadCallback& callback);
+
+    int fd(int line) const { return fds_[line]; }
+    uint16_t local_port(int line) const;
+    bool has_line_b() const { return fds_[1] != -1; }
+
+    // Next sequence number expected (0 before the first sequenced datagram)
+    uint64_t next_sequence() const { return next_sequence_; }
+
+    const Stats& get_stats() const { return stats_; }
+    void reset_stats() { stats_ = Stats(); }
+
+private:
+    struct Batch;
+
+    // One received datagram awaiting arbitration
+    struct Pending {
+        uint64_t sequence;
+        uint32_t line;
+        uint32_t index;
+    };
+
+    int open_line(const MulticastLine& line);
+    size_t receive(int line);
+
+    MulticastReceiverConfig config_;
+    int fds_[2];
+    std::unique_ptr<Batch> batches_[2];
+    std::unique_ptr<Pending[]> pending_;   // 2 * batch_size, merged by sequence
+    uint64_t next_sequence_;
+    Stats stats_;
+};
+
+} // namespace net
+} // namespace feedhandler
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace feedhandler {
+namespace net {
+
+// Transport-layer view of one packet: points into the frame, no copies
+struct L4Payload {
+    const char* data = nullptr;
+    size_t length = 0;
+    uint8_t protocol = 0;   // 6 = TCP, 17 = UDP
+    uint16_t src_port = 0;
+    uint16_t dst_port = 0;
+};
+
+constexpr uint8_t IP_PROTO_TCP = 6;
+constexpr uint8_t IP_PROTO_UDP = 17;
+
+// Network byte order
+inline uint16_t load16_be(const unsigned char* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+// Ethernet II frame (any number of 802.1Q/802.1ad tags) to its IPv4/IPv6 packet
+inline bool ethernet_to_ip(const unsigned char* frame, size_t length, const unsigned char*& ip, size_t& ip_length) {
+    if (length < 14) {
+        return false;
+    }
+    size_t offset = 12;
+    uint16_t ether_type = load16_be(frame + offset);
+    while ((ether_type == 0x8100 || ether_type == 0x88a8) && length >= offset + 6) {
+        offset += 4;
+        ether_type = load16_be(frame + offset);
+    }
+    if (ether_type != 0x0800 && ether_type != 0x86dd) {
+        return false;
+    }
+    ip = frame + offset + 2;
+    ip_length = length - offset - 2;
+    return true;
+}
+
+// TCP/UDP payload of an IPv4/IPv6 packet; false if there is none
+// (ACKs, handshakes, other protocols). IPv6 extension headers are not followed.
+inline bool ip_to_l4(const unsigned char* ip, size_t length, L4Payload& out) {
+    if (length < 20) {
+        return false;
+    }
+    size_t header;
+    size_t total;
+    uint8_t protocol;
+    if ((ip[0] >> 4) == 4) {
+        header = static_cast<size_t>(ip[0] & 0x0f) * 4;
+        total = load16_be(ip + 2);
+        protocol = ip[9];
+    } else if ((ip[0] >> 4) == 6 && length >= 40) {
+        header = 40;
+        total = 40 + static_cast<size_t>(load16_be(ip + 4));
+        protocol = ip[6];
+    } else {
+        return false;
+    }
+    // Trust the captured length over a padded/truncated IP length
+    if (total < header || total > length) {
+        total = length;
+    }
+    if (header > total) {
+        return false;
+    }
+
+    const unsigned char* l4 = ip + header;
+    size_t l4_length = total - header;
+    size_t l4_header;
+    if (protocol == IP_PROTO_TCP && l4_length >= 20) {
+        l4_header = static_cast<size_t>(l4[12] >> 4) * 4;
+    } else if (protocol == IP_PROTO_UDP && l4_length >= 8) {
+        l4_header = 8;
+    } else {
+        return false;
+    }
+    if (l4_header >= l4_length) {
+        return false;  // Header only
+    }
+
+    out.data = reinterpret_cast<const char*>(l4 + l4_header);
+    out.length = l4_length - l4_header;
+    out.protocol = protocol;
+    out.src_port = load16_be(l4);
+    out.dst_port = load16_be(l4 + 2);
+    return true;
+}
+
+} // namespace net
+} // namespace feedhandler
@@ -1,24 +1,54 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include "common/zero_latency_allocator.hpp"
 
 namespace feedhandler {
 namespace net {
 
-// Circular receive buffer: handles TCP fragmentation gracefully
+enum class ReceiveBufferMode {
+    LINEAR,     // Flat buffer, unread bytes compacted to the front with memmove
+    MIRRORED    // Ring whose pages are mapped twice back to back: never compacts
+};
+
+struct ReceiveBufferConfig {
+    ReceiveBufferMode mode = ReceiveBufferMode::LINEAR;
+    size_t capacity = 8192;  // MIRRORED rounds up to a whole number of pages
+    // LINEAR only: carve storage from this (huge-page, prefaulted) arena
+    // instead of the heap; must outlive the buffer. Falls back to the
+    // heap if the arena is too small.
+    common::ZeroLatencyAllocator::Arena* arena = nullptr;
+};
+
+// Receive buffer: handles TCP fragmentation gracefully
 // Stores incomplete messages and resumes parsing after new data arrives
+//
+// In MIRRORED mode the same physical pages appear at [0, capacity) and
+// [capacity, 2 * capacity), so a message that wraps the end of the ring
+// is still contiguous at read_ptr() and no memmove is ever needed. Falls
+// back to LINEAR if the mapping cannot be created; mode() reports which.
 class ReceiveBuffer {
 public:
     static constexpr size_t BUFFER_SIZE = 8192;
     
     ReceiveBuffer();
+    explicit ReceiveBuffer(const ReceiveBufferConfig& config);
+    ~ReceiveBuffer();
+    
+    // Non-copyable (owns its mapping)
+    ReceiveBuffer(const ReceiveBuffer&) = delete;
+    ReceiveBuffer& operator=(const ReceiveBuffer&) = delete;
     
-    // Write incoming bytes to buffer (from recv())
-    size_t write(const char* data, size_t len);
+    // Write incoming bytes to buffer (from recv()); timestamp_ns is their
+    // receive time, 0 if unknown
+    size_t write(const char* data, size_t len, uint64_t timestamp_ns = 0);
     
     // Read from buffer without consuming (peek)
     const char* read_ptr() const { return buffer_ + read_pos_; }
+    // Writable view for decoders that rewrite bytes in place (WebSocket unmasking)
+    char* read_ptr() { return buffer_ + read_pos_; }
     size_t readable_bytes() const;
     
     // Consume N bytes after parsing
@@ -30,15 +60,49 @@ public:
     // Reset buffer (empty it)
     void reset();
     
-    // Get underlying buffer for direct use
+    // Move unread bytes to the front so write space is contiguous again
+    // (no-op in MIRRORED mode, where write space is always contiguous)
+    void compact();
+    
+    // Get underlying buffer for direct use (e.g. recv() straight into it)
     char* write_buffer() { return buffer_ + write_pos_; }
-    size_t available_write() const { return BUFFER_SIZE - write_pos_; }
-    void advance_write(size_t len) { write_pos_ += len; }
+    size_t available_write() const {
+        return mirrored_ ? capacity_ - (write_pos_ - read_pos_) : capacity_ - write_pos_;
+    }
+    void advance_write(size_t len, uint64_t timestamp_ns = 0) {
+        write_pos_ += len;
+        if (timestamp_ns != 0) {
+            receive_timestamp_ = timestamp_ns;
+        }
+    }
+    
+    // Receive time of the newest bytes (ns since epoch, 0 if never given).
+    // A message completed by those bytes arrived at this time.
+    uint64_t receive_timestamp() const { return receive_timestamp_; }
+    
+    size_t capacity() const { return capacity_; }
+    ReceiveBufferMode mode() const {
+        return mirrored_ ? ReceiveBufferMode::MIRRORED : ReceiveBufferMode::LINEAR;
+    }
+    
+    // Number of memmoves performed by compact() so far
+    uint64_t compaction_count() const { return compactions_; }
+    
+    // Storage came from ReceiveBufferConfig::arena
+    bool arena_backed() const { return arena_backed_; }
     
 private:
-    alignas(64) char buffer_[BUFFER_SIZE];  // 64-byte aligned for cache efficiency
+    bool map_mirrored(size_t capacity);
+    void allocate_linear(size_t capacity, common::ZeroLatencyAllocator::Arena* arena);
+    
+    char* buffer_;      // 64-byte aligned for cache efficiency
+    size_t capacity_;
+    bool mirrored_;
+    bool arena_backed_; // Storage belongs to an arena, not freed here
     size_t write_pos_;  // Where next recv() data goes
-    size_t read_pos_;   // Where parser reads from
+    size_t read_pos_;   // Where parser reads from (< capacity_ when mirrored)
+    uint64_t compactions_;
+    uint64_t receive_timestamp_;
 };
 
 } // namespace net
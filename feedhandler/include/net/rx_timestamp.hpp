@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct msghdr;
+
+namespace feedhandler {
+namespace net {
+
+// Control buffer size that fits SCM_TIMESTAMPING / SCM_TIMESTAMPNS
+constexpr size_t RX_TIMESTAMP_CONTROL_SIZE = 256;
+
+enum class RxTimestampSource {
+    NONE,       // No timestamp in the control data
+    HARDWARE,   // NIC clock (SO_TIMESTAMPING raw hardware)
+    SOFTWARE    // Kernel receive time
+};
+
+// Ask the kernel to attach receive timestamps to fd's messages: hardware
+// where the NIC supports it, kernel time otherwise. Falls back to
+// SO_TIMESTAMPNS if SO_TIMESTAMPING is refused.
+bool enable_rx_timestamping(int fd);
+
+// Receive time carried in a recvmsg()/recvmmsg() control buffer, in ns
+// since the epoch; 0 (and source NONE) if there is none
+uint64_t read_rx_timestamp(const msghdr& msg, RxTimestampSource& source);
+
+// CLOCK_REALTIME now, for messages that arrive without a timestamp
+uint64_t realtime_ns();
+
+} // namespace net
+} // namespace feedhandler
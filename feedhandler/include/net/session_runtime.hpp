@@ -0,0 +1,194 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include "net/event_loop.hpp"
+#include "net/session_task.hpp"
+
+namespace feedhandler {
+namespace net {
+
+class ReceiveBuffer;
+class TcpClient;
+
+struct SessionRuntimeConfig {
+    EventLoopConfig loop;  // Reactor underneath: EPOLL or IO_URING (SELECT works, slowly)
+    int cpu = -1;          // Pin the thread calling run() to this CPU; -1 leaves it unpinned
+};
+
+// Single-threaded coroutine runtime: many feed sessions (connect, logon,
+// heartbeats, read loops) on one thread, each written as straight-line
+// code that co_awaits socket readiness and timers. A session that is
+// waiting costs a table entry, not a thread, and the bytes it reads go
+// to its parser on the same thread, with no queue in between.
+//
+//   Task<> session(SessionRuntime& rt, TcpClient& client, ReceiveBuffer& buffer) {
+//       if (!co_await async_connect(rt, client, "venue", 9000, 2000)) co_return;
+//       client.queue(logon);
+//       co_await async_flush(rt, client);
+//       while (co_await async_read(rt, client, buffer, 30000) >= 0) {
+//           parse what arrived, consume it; send a heartbeat on timeout (0)
+//       }
+//   }
+//   runtime.spawn(session(runtime, client, buffer));
+//   runtime.run();
+//
+// Readiness comes from an EventLoop. Reads are remembered when no session
+// is waiting, so edge-triggered backends lose nothing as long as a
+// session reads until the socket would block before it waits again.
+// Everything but stop() must be called from the runtime's thread.
+class SessionRuntime {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        uint64_t spawned = 0;
+        uint64_t finished = 0;
+        uint64_t failed = 0;    // Ended by an exception
+        uint64_t resumes = 0;   // Sessions resumed by readiness or timers
+        uint64_t timeouts = 0;  // Waits that ended on their timer
+    };
+
+private:
+    struct Waiter;
+    using TimerMap = std::multimap<Clock::time_point, Waiter*>;
+
+    enum class WaitKind { READ, WRITE, SLEEP };
+
+    // One suspended wait, living in the waiting coroutine's frame
+    struct Waiter {
+        std::coroutine_handle<> handle;
+        int fd = -1;
+        WaitKind kind = WaitKind::READ;
+        bool timed_out = false;
+        bool timed = false;
+        TimerMap::iterator timer;
+    };
+
+public:
+    // co_await result: true when the socket is ready, false when the
+    // timeout passed, the socket was forgotten or cannot be watched
+    // (sleeps always end false)
+    class Wait {
+    public:
+        Wait(SessionRuntime& runtime, int fd, WaitKind kind, int timeout_ms)
+            : runtime_(runtime), timeout_ms_(timeout_ms) {
+            waiter_.fd = fd;
+            waiter_.kind = kind;
+        }
+
+        bool await_ready() { return runtime_.ready_now(waiter_); }
+        void await_suspend(std::coroutine_handle<> handle) {
+            waiter_.handle = handle;
+            runtime_.suspend(waiter_, timeout_ms_);
+        }
+        bool await_resume() const { return !waiter_.timed_out; }
+
+    private:
+        SessionRuntime& runtime_;
+        Waiter waiter_;
+        int timeout_ms_;
+    };
+
+    SessionRuntime();
+    explicit SessionRuntime(const SessionRuntimeConfig& config);
+    // Destroys the sessions still suspended
+    ~SessionRuntime();
+
+    // Non-copyable
+    SessionRuntime(const SessionRuntime&) = delete;
+    SessionRuntime& operator=(const SessionRuntime&) = delete;
+
+    // Run session up to its first wait, right now, then from run_once()
+    // whenever what it waits for happens. The runtime owns it from here.
+    void spawn(Task<> session);
+
+    // Wait for readiness (at most max_wait_ms, less when a timer is due
+    // sooner) and resume every session it, or an expired timer, wakes.
+    // Returns the number of resumptions.
+    size_t run_once(int max_wait_ms = 1000);
+
+    // run_once() until every session has finished or stop() is called,
+    // after pinning the calling thread to config.cpu
+    void run();
+
+    // Make run() return after the current cycle; safe from any thread
+    void stop() { stop_.store(true, std::memory_order_relaxed); }
+
+    // Awaitables. timeout_ms < 0 waits for as long as it takes.
+    // sleep_for(0) yields until the next run_once().
+    Wait readable(int fd, int timeout_ms = -1) { return Wait(*this, fd, WaitKind::READ, timeout_ms); }
+    Wait writable(int fd, int timeout_ms = -1) { return Wait(*this, fd, WaitKind::WRITE, timeout_ms); }
+    Wait sleep_for(int ms) { return Wait(*this, -1, WaitKind::SLEEP, ms < 0 ? 0 : ms); }
+
+    // Stop watching fd before it is closed (its number may be reused):
+    // wakes its waiters with false and removes it from the event loop
+    void forget(int fd);
+
+    size_t session_count() const { return sessions_.size(); }
+    size_t watched_sockets() const { return loop_.socket_count(); }
+    EventBackend backend() const { return loop_.backend(); }
+    bool pinned() const { return pinned_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Socket {
+        Waiter* reader = nullptr;
+        Waiter* writer = nullptr;
+        bool watched = false;
+        bool read_ready = false;  // Reported while nobody waited
+    };
+
+    bool ready_now(Waiter& waiter);
+    void suspend(Waiter& waiter, int timeout_ms);
+    bool watch(int fd);
+    void wake(Waiter& waiter, bool timed_out);
+    void on_readable(int fd);
+    void on_writable(int fd);
+    int next_timeout(int max_wait_ms) const;
+    size_t resume_runnable();
+    void reap_finished();
+
+    SessionRuntimeConfig config_;
+    EventLoop loop_;
+    std::vector<Socket> sockets_;  // Indexed by fd
+    TimerMap timers_;
+    std::vector<std::coroutine_handle<>> runnable_;
+    std::vector<std::coroutine_handle<>> resuming_;
+    std::vector<std::coroutine_handle<>> sessions_;
+    std::vector<std::coroutine_handle<>> finished_;
+    std::atomic<bool> stop_;
+    bool pinned_;
+    Stats stats_;
+};
+
+// Socket operations for sessions. The client and buffer must outlive the
+// returned task; a client that closes here is forgotten first.
+
+// Non-blocking connect (TcpClient::start_connect()) that leaves the
+// socket non-blocking; false if it fails or takes longer than timeout_ms
+Task<bool> async_connect(SessionRuntime& runtime, TcpClient& client, std::string host, int port,
+                         int timeout_ms = -1);
+
+// Whatever arrives next, straight into buffer: bytes received, 0 once
+// timeout_ms passes with nothing (or buffer is full), -1 when the peer
+// closed or the socket failed
+Task<ssize_t> async_read(SessionRuntime& runtime, TcpClient& client, ReceiveBuffer& buffer,
+                         int timeout_ms = -1);
+
+// Write out the client's send ring, waiting for the socket to drain as
+// needed; false if the connection failed or timeout_ms passed first
+Task<bool> async_flush(SessionRuntime& runtime, TcpClient& client, int timeout_ms = -1);
+
+// forget() the socket, then close it
+void async_close(SessionRuntime& runtime, TcpClient& client);
+
+} // namespace net
+} // namespace feedhandler
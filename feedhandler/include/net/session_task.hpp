@@ -0,0 +1,146 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace feedhandler {
+namespace net {
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+// State shared by every Task promise, whatever it returns
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;            // Awaiting coroutine, resumed at the end
+    std::vector<std::coroutine_handle<>>* finished = nullptr;  // Owner's list, for spawned tasks
+    std::exception_ptr exception;
+
+    // Hand control straight back to the awaiting coroutine (symmetric
+    // transfer, no stack growth); a spawned task stays suspended here
+    // until its owner destroys it
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> done) noexcept {
+            TaskPromiseBase& promise = done.promise();
+            if (promise.continuation) {
+                return promise.continuation;
+            }
+            if (promise.finished) {
+                promise.finished->push_back(done);
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+
+    template<typename U>
+    void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+    T take() {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void take() {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+} // namespace detail
+
+// Lazily started coroutine: runs when awaited (the awaiting coroutine
+// resumes the moment it finishes) or when handed to
+// SessionRuntime::spawn(). Owns its frame; an exception escaping the
+// body is rethrown from co_await.
+template<typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) : handle_(handle) {}
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    bool valid() const { return static_cast<bool>(handle_); }
+    bool done() const { return handle_ && handle_.done(); }
+
+    // Give up ownership of the frame (SessionRuntime::spawn)
+    Handle release() { return std::exchange(handle_, nullptr); }
+
+    bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+
+    T await_resume() { return handle_.promise().take(); }
+
+private:
+    Handle handle_;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(Task<void>::Handle::from_promise(*this));
+}
+
+} // namespace detail
+
+} // namespace net
+} // namespace feedhandler
@@ -1,31 +1,144 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <sys/types.h>
+
+struct iovec;
+struct sockaddr_in;
 
 namespace feedhandler {
 namespace net {
 
+class ReceiveBuffer;
+
+struct TcpClientConfig {
+    bool nonblocking = false;            // Sends never wait: what the kernel cannot take goes to the send ring
+    int connect_timeout_ms = 0;          // Give up on connect() after this long; 0 waits as long as the kernel does
+    bool tcp_nodelay = true;             // No Nagle delay for small messages
+    int busy_poll_us = 0;                // SO_BUSY_POLL on reads; 0 leaves the system default
+    bool quick_ack = false;              // TCP_QUICKACK, re-armed after every read (the kernel clears it)
+    size_t send_ring_bytes = 64 * 1024;  // Pending outbound bytes; rounded up to a power of 2
+};
+
 class TcpClient {
 public:
+    // Outbound side, for checking how well sends coalesce
+    struct SendStats {
+        uint64_t messages = 0;        // send()/queue() calls, gather messages counted singly
+        uint64_t syscalls = 0;        // sendmsg() calls that wrote something
+        uint64_t bytes = 0;           // Bytes the kernel accepted
+        uint64_t would_block = 0;     // Sends cut short by a full socket buffer
+        uint64_t ring_full = 0;       // Messages refused because the send ring had no room
+    };
+
     TcpClient();
+    explicit TcpClient(const TcpClientConfig& config);
     ~TcpClient();
-    
+
     // Non-copyable
     TcpClient(const TcpClient&) = delete;
     TcpClient& operator=(const TcpClient&) = delete;
-    
+
+    // Applies the socket options of the config; with connect_timeout_ms
+    // the connect runs non-blocking and is abandoned after the timeout
     bool connect(const std::string& host, int port);
+
+    // Non-blocking connect for an event loop: true once the handshake is
+    // under way (or already done). The socket turns writable when it
+    // ends; finish_connect() then reports the outcome. The socket stays
+    // non-blocking either way.
+    bool start_connect(const std::string& host, int port);
+    bool finish_connect();
+    bool is_connecting() const { return connecting_; }
+
+    // Send now, behind anything already queued. Non-blocking: whatever the
+    // socket buffer cannot take is kept in the send ring and goes out with
+    // the next flush(); false only if the ring cannot hold it (nothing of
+    // the message is sent then) or the connection failed. Blocking: waits
+    // until every byte is written.
     bool send(const std::string& data);
+    bool send(const char* data, size_t length);
+
+    // Several messages in one gather write, without copying them first
+    bool send(std::span<const std::string_view> messages);
+
+    // Append to the send ring without a syscall; flush() writes every
+    // queued message in one sendmsg(). For subscriptions, heartbeats and
+    // orders produced in one pass of the session loop.
+    bool queue(const char* data, size_t length);
+    bool queue(std::string_view data) { return queue(data.data(), data.size()); }
+
+    // Write the send ring out. Returns false if the connection failed;
+    // non-blocking, bytes the socket cannot take yet stay queued
+    // (has_pending_send()), so call again when the loop comes round.
+    bool flush();
+
+    size_t pending_send_bytes() const { return send_tail_ - send_head_; }
+    bool has_pending_send() const { return send_tail_ != send_head_; }
+    size_t send_ring_capacity() const { return send_ring_.size(); }
+    const SendStats& send_stats() const { return send_stats_; }
+
     std::string recv(size_t max_bytes = 1024);
+
+    // Receive straight into buffer's free space: no allocation, no
+    // intermediate copy. Compacts buffer first if it has no write room.
+    // Returns bytes received, 0 if nothing is available (EAGAIN with
+    // MSG_DONTWAIT) or buffer is full, -1 on error or peer close.
+    ssize_t recv_into(ReceiveBuffer& buffer, int flags = 0);
+
+    // Non-blocking drain: recv_into() until the socket would block or
+    // buffer is full. Use after an edge-triggered readiness event.
+    // Returns total bytes received; is_connected() is false afterwards
+    // if the peer closed or the socket failed.
+    size_t drain_into(ReceiveBuffer& buffer);
+
+    // Ask the kernel for receive timestamps (NIC time where supported);
+    // recv_into() then records each read's arrival time in the buffer
+    // (ReceiveBuffer::receive_timestamp). Call after connect().
+    bool enable_timestamping();
+    bool timestamping() const { return timestamping_; }
+
+    bool set_nonblocking(bool enable);
+    bool is_nonblocking() const { return nonblocking_; }
+
+    // Drops anything still in the send ring
     void close();
-    
+
     bool is_connected() const { return socket_fd_ != -1; }
+    int fd() const { return socket_fd_; }
+    const TcpClientConfig& config() const { return config_; }
 
 private:
+    // Fresh socket with the config's options, host resolved into server_addr
+    bool open_socket(const std::string& host, int port, sockaddr_in* server_addr);
+    void apply_socket_options();
+    bool connect_with_timeout(const void* address, size_t address_length);
+    bool enqueue(const char* data, size_t length);
+    void append_to_ring(const char* data, size_t length);
+
+    // sendmsg() of iov, retried on EINTR and, when blocking, until done.
+    // Returns bytes written, -1 after closing the socket on an error.
+    ssize_t write_vectored(iovec* iov, size_t count, size_t total);
+
+    TcpClientConfig config_;
     int socket_fd_;
     bool connected_;
+    bool connecting_;
+    bool timestamping_;
+    bool nonblocking_;
+
+    // Send ring: bytes [send_head_, send_tail_) are queued, positions
+    // taken modulo the power-of-2 size
+    std::vector<char> send_ring_;
+    size_t send_head_ = 0;
+    size_t send_tail_ = 0;
+    SendStats send_stats_;
 };
 
 } // namespace net
-} // namespace feedhandler
\ No newline at end of file
+} // namespace feedhandler
@@ -1,33 +1,100 @@
 #pragma once
 
+#include "common/tick.hpp"
+#include "net/receive_buffer.hpp"
+#include "net/tcp_client.hpp"
+#include "net/websocket_frame.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
-#include <memory>
+#include <string_view>
+#include <vector>
 
 namespace feedhandler {
+namespace parser {
+class TradeJsonParser;
+}
+
 namespace net {
 
-// Simple WebSocket client for connecting to Binance/Coinbase feeds
+struct WebSocketClientConfig {
+    TcpClientConfig tcp;                  // nonblocking for a session loop, blocking for simple readers
+    WebSocketDecoderConfig decoder;
+    ReceiveBufferConfig buffer;
+
+    WebSocketClientConfig() = default;
+};
+
+// WebSocket client for crypto venue feeds (Binance, Coinbase)
+//
+// Plain TCP only: wss:// endpoints need a TLS terminator (stunnel or a
+// local proxy) in front. Bytes go from the socket straight into a
+// ReceiveBuffer and are decoded there by WebSocketFrameDecoder, so a
+// message is handed over as a view into the buffer. Pings are answered
+// with pongs and a close frame with a close, without the caller's help.
 class WebSocketClient {
 public:
+    // Data message (TEXT or BINARY); payload valid only during the call
+    using MessageCallback = std::function<void(WsOpcode opcode, std::string_view payload)>;
+
     WebSocketClient();
+    explicit WebSocketClient(const WebSocketClientConfig& config);
     ~WebSocketClient();
-    
-    // Connect to WebSocket endpoint
-    bool connect_to_feed(const std::string& url, const std::string& host, int port);
-    
-    // Send WebSocket upgrade handshake
+
+    // Non-copyable
+    WebSocketClient(const WebSocketClient&) = delete;
+    WebSocketClient& operator=(const WebSocketClient&) = delete;
+
+    // Connect to host:port; path is the resource of the upgrade request
+    // (e.g. "/ws/btcusdt@trade")
+    bool connect_to_feed(const std::string& path, const std::string& host, int port);
+
+    // Send the upgrade request for the path and host given to
+    // connect_to_feed(). The 101 response is checked as it arrives,
+    // before the first frame.
     bool send_handshake();
-    
-    // Receive raw bytes (WebSocket frames or plain JSON if plain TCP)
+    bool is_upgraded() const { return upgraded_; }
+
+    // One masked TEXT frame (subscriptions)
+    bool send_text(std::string_view payload);
+
+    // Read what the socket has and dispatch every complete data message.
+    // Non-blocking client: drains until EAGAIN; blocking: one read.
+    // Returns data messages delivered.
+    size_t poll(const MessageCallback& on_message);
+
+    // poll() with every TEXT message decoded as a trade; ticks carry the
+    // read's receive time. Returns ticks appended.
+    size_t read_trades(const parser::TradeJsonParser& parser, std::vector<common::Tick>& ticks);
+
+    // Next data message as a string (blocks on a blocking client); empty
+    // if none arrived or the connection is gone. Prefer poll().
     std::string recv_data();
-    
-    bool is_connected() const { return socket_fd_ >= 0; }
-    
+
+    bool is_connected() const { return tcp_.is_connected(); }
+    const WebSocketFrameDecoder& decoder() const { return decoder_; }
+    TcpClient& tcp() { return tcp_; }
+
     void close();
-    
+
 private:
-    int socket_fd_;
+    bool read_upgrade_response();
+    size_t decode(const MessageCallback& on_message, size_t max_messages = SIZE_MAX);
+    bool send_frame(WsOpcode opcode, std::string_view payload);
+    uint32_t next_mask_key();
+
+    TcpClient tcp_;
+    ReceiveBuffer buffer_;
+    WebSocketFrameDecoder decoder_;
     std::string host_;
+    std::string path_;
+    int port_ = 0;
+    bool handshake_sent_ = false;
+    bool upgraded_ = false;
+    uint64_t mask_state_;
+    std::string frame_;  // Outbound frame scratch, reused
 };
 
 } // namespace net
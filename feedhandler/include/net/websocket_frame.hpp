@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace feedhandler {
+namespace net {
+
+class ReceiveBuffer;
+
+enum class WsOpcode : uint8_t {
+    CONTINUATION = 0x0,
+    TEXT = 0x1,
+    BINARY = 0x2,
+    CLOSE = 0x8,
+    PING = 0x9,
+    PONG = 0xA
+};
+
+inline bool is_control(WsOpcode opcode) { return static_cast<uint8_t>(opcode) & 0x8; }
+
+// XOR payload with the 4-byte masking key, in place (RFC 6455 5.3).
+// SSE2/NEON 16 bytes at a time; offset is the payload position of data[0]
+// when a payload is unmasked in pieces.
+void ws_unmask(char* data, size_t length, uint32_t key, size_t offset = 0);
+void ws_unmask_scalar(char* data, size_t length, uint32_t key, size_t offset = 0);
+
+// Append one final frame to out. Clients must mask (key != 0 is used as
+// the masking key, in wire byte order); servers send key 0, unmasked.
+void ws_encode_frame(std::string& out, WsOpcode opcode, std::string_view payload, uint32_t mask_key = 0);
+
+struct WebSocketDecoderConfig {
+    size_t max_message_bytes = 1 << 20;  // Larger messages are a protocol error
+};
+
+// Streaming RFC 6455 frame decoder over a ReceiveBuffer
+//
+// Frames are decoded where they landed: masked payloads are unmasked in
+// place and the fragments of a message are moved down over the headers
+// between them, so every message reaches the caller as one contiguous
+// view into the buffer with no allocation and no copy out. The view
+// stays valid until the next call to next(), which consumes the bytes of
+// the previous message first.
+//
+// Control frames (ping, pong, close) are returned as they arrive, also in
+// the middle of a fragmented message. Answering them is the caller's job
+// (WebSocketClient does).
+class WebSocketFrameDecoder {
+public:
+    enum class Status {
+        OK,
+        PROTOCOL_ERROR,     // Reserved bits or opcode, bad fragment sequence, oversized control frame
+        MESSAGE_TOO_BIG     // Beyond max_message_bytes, or cannot fit in the buffer
+    };
+
+    struct Message {
+        WsOpcode opcode = WsOpcode::TEXT;  // TEXT/BINARY for data, never CONTINUATION
+        std::string_view payload;          // In the buffer, valid until the next call
+    };
+
+    WebSocketFrameDecoder();
+    explicit WebSocketFrameDecoder(const WebSocketDecoderConfig& config);
+
+    // Next complete message in buffer. false when more bytes are needed or
+    // after an error (status() != OK; the stream cannot be resynchronized).
+    bool next(ReceiveBuffer& buffer, Message& message);
+
+    Status status() const { return status_; }
+
+    // Forget partial state; the buffer should be reset with it
+    void reset();
+
+    uint64_t frames() const { return frames_; }
+    uint64_t messages() const { return messages_; }
+
+private:
+    bool fail(Status status);
+
+    WebSocketDecoderConfig config_;
+    Status status_ = Status::OK;
+
+    // Offsets from the buffer's read position, which next() only moves
+    // past finished messages
+    size_t consume_on_next_ = 0;   // Bytes of the message returned last
+    size_t scan_ = 0;              // Next frame header
+    size_t assembled_ = 0;         // Payload of the open fragmented message, at offset 0
+    bool fragmented_ = false;
+    WsOpcode message_opcode_ = WsOpcode::TEXT;
+
+    uint64_t frames_ = 0;
+    uint64_t messages_ = 0;
+};
+
+} // namespace net
+} // namespace feedhandler
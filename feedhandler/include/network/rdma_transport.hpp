@@ -1,273 +1,266 @@
 #pragma once
 
-#include <memory>
-#include <vector>
-#include <functional>
+#include "common/stat_counter.hpp"
+
 #include <atomic>
-#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ibv_context;
+struct ibv_pd;
+struct ibv_mr;
+struct ibv_cq;
+struct ibv_cq_ex;
+struct ibv_qp;
+struct ibv_comp_channel;
 
 namespace feedhandler {
 namespace network {
 
 /**
- * @brief Ultra-low latency RDMA (Remote Direct Memory Access) transport
- * 
- * This transport layer bypasses the kernel and directly accesses network
- * hardware, achieving sub-100ns network latency for market data delivery.
- * 
- * Features:
- * - Kernel bypass networking
- * - Zero-copy data transfer
- * - Hardware timestamping
- * - Multicast market data feeds
- * - InfiniBand and RoCE support
+ * @brief Fixed-size receive buffers carved from one slab, posted and reposted in batches
+ *
+ * The slab is registered with the NIC once, so a receive never pins or
+ * registers memory. Every buffer is in one of three states: posted to
+ * the receive queue, lent to the message callback, or released and
+ * waiting to be posted again. take_batch() hands out the released ones
+ * so the transport can post a whole batch with a single ibv_post_recv().
+ * Not thread-safe: owned by the receive thread.
  */
-class RDMATransport {
+class RdmaBufferPool {
 public:
-    struct Config {
-        std::string device_name = "mlx5_0";  // InfiniBand device
-        uint16_t port = 1;
-        size_t queue_depth = 1024;
-        size_t max_message_size = 9000;      // Jumbo frames
-        bool use_hardware_timestamps = true;
-        bool enable_multicast = true;
-        std::string multicast_group = "239.1.1.1";
-    };
-    
-    struct NetworkStats {
-        uint64_t messages_received;
-        uint64_t bytes_received;
-        uint64_t packet_drops;
-        double average_latency_ns;
-        double jitter_ns;
-        uint64_t hardware_timestamp_errors;
-    };
-    
-    using MessageCallback = std::function<void(const char*, size_t, uint64_t timestamp)>;
-    
-    RDMATransport(const Config& config = {});
-    ~RDMATransport();
-    
-    /**
-     * @brief Initialize RDMA connection
-     * @param remote_address Remote server address
-     * @param remote_port Remote server port
-     * @return Success status
-     */
-    bool connect(const std::string& remote_address, uint16_t remote_port);
-    
-    /**
-     * @brief Start receiving market data
-     * @param callback Message processing callback
-     */
-    void start_receiving(MessageCallback callback);
-    
+    RdmaBufferPool(size_t buffer_count, size_t buffer_size)
+        : buffer_size_(round_up(buffer_size, CACHE_LINE)), buffer_count_(buffer_count) {
+        if (buffer_count == 0 || buffer_size == 0) {
+            throw std::invalid_argument("RdmaBufferPool needs at least one non-empty buffer");
+        }
+        slab_ = static_cast<char*>(std::aligned_alloc(PAGE_SIZE, round_up(buffer_size_ * buffer_count_, PAGE_SIZE)));
+        if (!slab_) {
+            throw std::runtime_error("RdmaBufferPool slab allocation failed");
+        }
+        released_.reserve(buffer_count_);
+        for (size_t i = 0; i < buffer_count_; ++i) {
+            released_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    ~RdmaBufferPool() { std::free(slab_); }
+
+    RdmaBufferPool(const RdmaBufferPool&) = delete;
+    RdmaBufferPool& operator=(const RdmaBufferPool&) = delete;
+
     /**
-     * @brief Stop receiving data
+     * @brief Move up to max released buffers into out (cleared first); they count as posted
      */
-    void stop_receiving();
-    
+    size_t take_batch(size_t max, std::vector<uint32_t>& out) {
+        out.clear();
+        while (out.size() < max && !released_.empty()) {
+            out.push_back(released_.back());
+            released_.pop_back();
+        }
+        posted_ += out.size();
+        return out.size();
+    }
+
     /**
-     * @brief Send message with zero-copy
-     * @param data Message data
-     * @param length Message length
-     * @return Success status
+     * @brief Give back buffers take_batch() handed out that could not be posted
      */
-    bool send_message(const void* data, size_t length);
-    
+    void unpost(const std::vector<uint32_t>& indices) {
+        released_.insert(released_.end(), indices.begin(), indices.end());
+        posted_ -= indices.size();
+    }
+
     /**
-     * @brief Get network performance statistics
+     * @brief A receive completed into index: the buffer is now lent out
      */
-    NetworkStats get_stats() const;
-    
+    char* lend(uint32_t index) {
+        --posted_;
+        ++lent_;
+        return buffer(index);
+    }
+
     /**
-     * @brief Enable hardware timestamping
-     * @param enable Enable/disable hardware timestamps
+     * @brief The borrower is done with index; it waits for the next batch post
      */
-    void set_hardware_timestamping(bool enable);
-    
+    void release(uint32_t index) {
+        --lent_;
+        released_.push_back(index);
+    }
+
     /**
-     * @brief Join multicast group for market data
-     * @param group_address Multicast group IP
-     * @return Success status
+     * @brief Every buffer released again, after the queue pair they were posted to is gone
      */
-    bool join_multicast_group(const std::string& group_address);
+    void reset() {
+        released_.clear();
+        for (size_t i = 0; i < buffer_count_; ++i) {
+            released_.push_back(static_cast<uint32_t>(i));
+        }
+        posted_ = 0;
+        lent_ = 0;
+    }
+
+    char* buffer(uint32_t index) const { return slab_ + static_cast<size_t>(index) * buffer_size_; }
+    char* slab() const { return slab_; }
+    size_t slab_bytes() const { return buffer_size_ * buffer_count_; }
+    size_t buffer_size() const { return buffer_size_; }
+    size_t buffer_count() const { return buffer_count_; }
+
+    size_t posted() const { return posted_; }
+    size_t lent() const { return lent_; }
+    size_t released() const { return released_.size(); }
 
 private:
-    Config config_;
-    void* rdma_context_;
-    void* completion_queue_;
-    void* queue_pair_;
-    void* memory_region_;
-    
-    std::atomic<bool> receiving_;
-    std::thread receive_thread_;
-    
-    MessageCallback message_callback_;
-    mutable NetworkStats stats_;
-    
-    bool initialize_rdma();
-    void cleanup_rdma();
-    void receive_loop();
-    void process_completion();
-    uint64_t get_hardware_timestamp();
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr size_t PAGE_SIZE = 4096;
+
+    static size_t round_up(size_t value, size_t multiple) { return (value + multiple - 1) / multiple * multiple; }
+
+    size_t buffer_size_;
+    size_t buffer_count_;
+    char* slab_ = nullptr;
+    std::vector<uint32_t> released_;  // LIFO: the most recently used buffer is the cache-warm one
+    size_t posted_ = 0;
+    size_t lent_ = 0;
 };
 
 /**
- * @brief Kernel bypass UDP transport using DPDK
+ * @brief RDMA transport for raw ticks between co-located processes and hosts
+ *
+ * One reliable-connected queue pair over ibverbs (InfiniBand or RoCE).
+ * The receive side keeps a pool of pre-registered buffers posted to the
+ * receive queue, polls the completion queue (busy-poll by default) and
+ * hands each message to the callback as a pointer into the buffer it
+ * landed in: no copy. The buffer returns to the pool when the callback
+ * returns and is reposted with the next batch.
+ *
+ * Queue pair attributes are exchanged over a short-lived TCP connection:
+ * one side calls accept(), the other connect(). Only built with
+ * -DFEED_RDMA=ON (needs libibverbs).
  */
-class DPDKTransport {
+class RDMATransport {
 public:
     struct Config {
-        std::string pci_device = "0000:01:00.0";
-        uint16_t port_id = 0;
-        size_t rx_queue_size = 2048;
-        size_t tx_queue_size = 2048;
-        size_t mbuf_pool_size = 8192;
-        bool enable_rss = true;  // Receive Side Scaling
-        uint16_t mtu = 9000;     // Jumbo frames
-    };
-    
-    using PacketCallback = std::function<void(const char*, size_t, uint64_t timestamp)>;
-    
-    DPDKTransport(const Config& config = {});
-    ~DPDKTransport();
-    
-    /**
-     * @brief Initialize DPDK environment
-     * @return Success status
-     */
-    bool initialize();
-    
-    /**
-     * @brief Start packet processing
-     * @param callback Packet processing callback
-     */
-    void start_processing(PacketCallback callback);
-    
-    /**
-     * @brief Send packet with zero-copy
-     * @param data Packet data
-     * @param length Packet length
-     * @param dest_ip Destination IP
-     * @param dest_port Destination port
-     * @return Success status
-     */
-    bool send_packet(const void* data, size_t length,
-                    uint32_t dest_ip, uint16_t dest_port);
-    
-    /**
-     * @brief Get packet processing statistics
-     */
-    struct PacketStats {
-        uint64_t rx_packets;
-        uint64_t tx_packets;
-        uint64_t rx_dropped;
-        uint64_t tx_dropped;
-        double pps_rate;  // Packets per second
-        double bandwidth_gbps;
+        std::string device_name;              // Empty: first device found (e.g. "mlx5_0", "rxe0")
+        uint8_t port = 1;                     // HCA port
+        int gid_index = 0;                    // RoCE needs a GID; InfiniBand routes by LID
+        size_t recv_buffers = 1024;           // Receive queue depth = pool size
+        size_t max_message_size = 9000;       // Bytes per buffer; larger sends fail
+        size_t post_batch = 32;               // Released buffers reposted per ibv_post_recv()
+        size_t poll_batch = 32;               // Completions handled per poll
+        size_t send_buffers = 64;             // Registered send slots = sends in flight
+        bool busy_poll = true;                // false: sleep on the completion channel
+        bool use_hardware_timestamps = true;  // NIC completion time when the device has it
+
+        Config() = default;
     };
-    
-    PacketStats get_stats() const;
 
-private:
-    Config config_;
-    void* dpdk_port_;
-    void* mbuf_pool_;
-    
-    std::atomic<bool> processing_;
-    std::vector<std::thread> worker_threads_;
-    
-    PacketCallback packet_callback_;
-    mutable PacketStats stats_;
-    
-    bool setup_dpdk_port();
-    void worker_loop(int queue_id);
-    void process_rx_burst(int queue_id);
-};
+    struct NetworkStats {
+        uint64_t messages_received = 0;
+        uint64_t bytes_received = 0;
+        uint64_t completion_errors = 0;       // Receive completions with a failure status
+        uint64_t recv_posts = 0;              // ibv_post_recv() calls; messages / recv_posts ~ post_batch
+        uint64_t messages_sent = 0;
+        uint64_t hardware_timestamps = 0;     // Messages stamped by the NIC rather than the host clock
+    };
 
-/**
- * @brief High-precision network timestamping
- */
-class NetworkTimestamping {
-public:
-    /**
-     * @brief Calibrate network timestamp offset
-     * @param reference_server PTP reference server
-     * @return Calibration offset in nanoseconds
-     */
-    static int64_t calibrate_timestamps(const std::string& reference_server);
-    
     /**
-     * @brief Get hardware timestamp from network packet
-     * @param packet_data Raw packet data
-     * @return Hardware timestamp in nanoseconds
+     * @brief Message delivery: data is in a registered buffer, valid only during the call
+     *
+     * timestamp is the receive completion time in ns since the epoch.
      */
-    static uint64_t extract_hardware_timestamp(const void* packet_data);
-    
+    using MessageCallback = std::function<void(const char*, size_t, uint64_t timestamp)>;
+
+    RDMATransport();
+    explicit RDMATransport(const Config& config);
+    ~RDMATransport();
+
+    RDMATransport(const RDMATransport&) = delete;
+    RDMATransport& operator=(const RDMATransport&) = delete;
+
     /**
-     * @brief Convert network timestamp to system time
-     * @param network_timestamp Hardware timestamp
-     * @return System time in nanoseconds
+     * @brief Connect to a peer waiting in accept() on remote_address:remote_port
+     * @return false if the device, the exchange or the queue pair setup failed
      */
-    static uint64_t network_to_system_time(uint64_t network_timestamp);
-    
+    bool connect(const std::string& remote_address, uint16_t remote_port);
+
     /**
-     * @brief Measure one-way network latency
-     * @param remote_address Remote server address
-     * @return Latency in nanoseconds
+     * @brief Wait for one peer's connect() on TCP port and set up the queue pair
      */
-    static double measure_network_latency(const std::string& remote_address);
-
-private:
-    static int64_t timestamp_offset_;
-    static std::chrono::steady_clock::time_point calibration_time_;
-};
+    bool accept(uint16_t port);
 
-/**
- * @brief Market data multicast receiver with RDMA
- */
-class MulticastReceiver {
-public:
-    struct MulticastConfig {
-        std::vector<std::string> multicast_groups;
-        std::string interface_ip;
-        uint16_t base_port = 10000;
-        size_t buffer_size = 64 * 1024;  // 64KB receive buffer
-        bool use_rdma = true;
-    };
-    
-    using FeedCallback = std::function<void(const std::string& symbol,
-                                          const char* data, size_t length,
-                                          uint64_t timestamp)>;
-    
-    MulticastReceiver(const MulticastConfig& config);
-    
     /**
-     * @brief Start receiving multicast feeds
-     * @param callback Feed processing callback
+     * @brief Start the receive thread; messages go to callback
      */
-    void start_feeds(FeedCallback callback);
-    
+    void start_receiving(MessageCallback callback);
+
     /**
-     * @brief Subscribe to specific symbol feeds
-     * @param symbols List of symbols to subscribe
+     * @brief Stop and join the receive thread
      */
-    void subscribe_symbols(const std::vector<std::string>& symbols);
-    
+    void stop_receiving();
+
     /**
-     * @brief Get feed statistics per symbol
+     * @brief Send one message; copied into a registered send slot (inline if small)
+     *
+     * Blocks while every send slot is in flight. One sending thread only.
      */
-    std::map<std::string, NetworkStats> get_feed_stats() const;
+    bool send_message(const void* data, size_t length);
+
+    NetworkStats get_stats() const;
+    bool is_connected() const { return connected_; }
+    bool hardware_timestamps() const { return hardware_timestamps_; }
+    const RdmaBufferPool& pool() const { return pool_; }
 
 private:
-    MulticastConfig config_;
-    std::vector<std::unique_ptr<RDMATransport>> transports_;
-    FeedCallback feed_callback_;
-    
-    void setup_multicast_feeds();
-    void process_multicast_message(const char* data, size_t length, uint64_t timestamp);
+    struct PeerInfo;
+
+    Config config_;
+    ibv_context* context_ = nullptr;
+    ibv_pd* protection_domain_ = nullptr;
+    ibv_mr* recv_region_ = nullptr;
+    ibv_mr* send_region_ = nullptr;
+    ibv_comp_channel* channel_ = nullptr;
+    ibv_cq_ex* recv_cq_ = nullptr;
+    ibv_cq* send_cq_ = nullptr;
+    ibv_qp* queue_pair_ = nullptr;
+    uint32_t max_inline_ = 0;
+    bool hardware_timestamps_ = false;
+    std::atomic<bool> connected_{false};
+
+    RdmaBufferPool pool_;
+    std::vector<uint32_t> post_scratch_;
+
+    std::vector<char> send_slab_;
+    size_t send_next_ = 0;
+    size_t sends_in_flight_ = 0;
+
+    std::atomic<bool> receiving_{false};
+    std::thread receive_thread_;
+    MessageCallback message_callback_;
+
+    common::LocalCounter messages_received_;
+    common::LocalCounter bytes_received_;
+    common::LocalCounter completion_errors_;
+    common::LocalCounter recv_posts_;
+    common::LocalCounter messages_sent_;
+    common::LocalCounter hardware_timestamp_count_;
+
+    bool initialize_rdma();
+    void cleanup_rdma();
+    bool exchange_and_connect(int socket_fd, bool server);
+    bool bring_up(const PeerInfo& local, const PeerInfo& remote);
+    bool post_receives(size_t max);
+    bool reap_sends(bool wait);
+    void receive_loop();
+    size_t process_completion();
+    bool wait_for_completion();
+    uint64_t get_hardware_timestamp();
 };
 
 } // namespace network
-} // namespace feedhandler
\ No newline at end of file
+} // namespace feedhandler
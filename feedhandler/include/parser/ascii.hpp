@@ -0,0 +1,292 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FEEDHANDLER_ASCII_SSE2 1
+#endif
+
+namespace feedhandler {
+namespace parser {
+
+/**
+ * @brief ASCII classification and in-place transforms shared by the parsers
+ *
+ * One place for the character tests every parser used to spell out for
+ * itself: the FIX parsers' digit checks, the JSON path's whitespace
+ * skipping, config trimming. Single characters go through a 256-entry
+ * class table; runs go 16 bytes at a time with SSE2 (the x86_64
+ * baseline, so no dispatch): each class is a byte-range compare, OR-ed
+ * into one lane mask, and the first lane out of class ends the run.
+ * Elsewhere the same functions run the scalar table loop.
+ *
+ * Locale-independent: only ASCII letters, digits and the C-locale
+ * whitespace set (space, \t \n \v \f \r) are classified; bytes >= 0x80
+ * belong to no class.
+ */
+namespace ascii {
+
+/**
+ * @brief Character classes, combinable as bit masks
+ */
+enum Class : uint8_t {
+    DIGIT = 1 << 0,
+    UPPER = 1 << 1,
+    LOWER = 1 << 2,
+    SPACE = 1 << 3,
+    ALPHA = UPPER | LOWER,
+    ALNUM = ALPHA | DIGIT,
+};
+
+inline constexpr std::array<uint8_t, 256> CLASS_TABLE = [] {
+    std::array<uint8_t, 256> table{};
+    for (int c = '0'; c <= '9'; ++c) table[static_cast<size_t>(c)] = DIGIT;
+    for (int c = 'A'; c <= 'Z'; ++c) table[static_cast<size_t>(c)] = UPPER;
+    for (int c = 'a'; c <= 'z'; ++c) table[static_cast<size_t>(c)] = LOWER;
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) table[static_cast<unsigned char>(c)] = SPACE;
+    return table;
+}();
+
+constexpr uint8_t classify(char c) { return CLASS_TABLE[static_cast<unsigned char>(c)]; }
+constexpr bool is(char c, uint8_t classes) { return (classify(c) & classes) != 0; }
+
+constexpr bool is_digit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+constexpr bool is_space(char c) { return c == ' ' || static_cast<unsigned char>(c - '\t') < 5; }
+constexpr bool is_upper(char c) { return static_cast<unsigned char>(c - 'A') < 26; }
+constexpr bool is_lower(char c) { return static_cast<unsigned char>(c - 'a') < 26; }
+constexpr bool is_alpha(char c) { return is(c, ALPHA); }
+constexpr bool is_alnum(char c) { return is(c, ALNUM); }
+
+constexpr char to_lower(char c) { return is_upper(c) ? static_cast<char>(c + 32) : c; }
+constexpr char to_upper(char c) { return is_lower(c) ? static_cast<char>(c - 32) : c; }
+
+#ifdef FEEDHANDLER_ASCII_SSE2
+namespace detail {
+
+// Lanes of chunk in [lo, lo + count): unsigned (chunk - lo) <= count - 1
+inline __m128i in_range(__m128i chunk, char lo, int count) {
+    __m128i offset = _mm_sub_epi8(chunk, _mm_set1_epi8(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(static_cast<char>(count - 1))), offset);
+}
+
+inline __m128i class_lanes(__m128i chunk, uint8_t classes) {
+    __m128i hits = _mm_setzero_si128();
+    if (classes & DIGIT) {
+        hits = _mm_or_si128(hits, in_range(chunk, '0', 10));
+    }
+    if ((classes & ALPHA) == ALPHA) {
+        // Setting bit 5 folds upper case onto lower
+        hits = _mm_or_si128(hits, in_range(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), 'a', 26));
+    } else if (classes & UPPER) {
+        hits = _mm_or_si128(hits, in_range(chunk, 'A', 26));
+    } else if (classes & LOWER) {
+        hits = _mm_or_si128(hits, in_range(chunk, 'a', 26));
+    }
+    if (classes & SPACE) {
+        hits = _mm_or_si128(hits, _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), in_range(chunk, '\t', 5)));
+    }
+    return hits;
+}
+
+// Add delta to the lanes in [lo, lo + 26)
+inline void shift_case(char* data, size_t length, char lo, char delta) {
+    const __m128i step = _mm_set1_epi8(delta);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i letters = in_range(chunk, lo, 26);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_add_epi8(chunk, _mm_and_si128(letters, step)));
+    }
+    for (; i < length; ++i) {
+        if (static_cast<unsigned char>(data[i] - lo) < 26) {
+            data[i] = static_cast<char>(data[i] + delta);
+        }
+    }
+}
+
+} // namespace detail
+#endif
+
+/**
+ * @brief Bit i set when block[i] is in any of classes
+ * @param block 16 readable bytes
+ */
+inline uint32_t mask16(const char* block, uint8_t classes) {
+#ifdef FEEDHANDLER_ASCII_SSE2
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    return static_cast<uint32_t>(_mm_movemask_epi8(detail::class_lanes(chunk, classes)));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < 16; ++i) {
+        mask |= static_cast<uint32_t>(is(block[i], classes)) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief First position in [p, end) whose character is not in classes
+ * @return end if every character is
+ */
+inline const char* skip(const char* p, const char* end, uint8_t classes) {
+    // Most runs are empty or short: settle those before loading a block
+    if (p == end || !is(*p, classes)) {
+        return p;
+    }
+    while (end - p >= 16) {
+        uint32_t outside = ~mask16(p, classes) & 0xFFFFu;
+        if (outside) {
+            return p + __builtin_ctz(outside);
+        }
+        p += 16;
+    }
+    while (p < end && is(*p, classes)) {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * @brief One past the last position in [begin, end) whose character is
+ *        not in classes
+ * @return begin if every character is
+ */
+inline const char* skip_back(const char* begin, const char* end, uint8_t classes) {
+    if (begin == end || !is(end[-1], classes)) {
+        return end;
+    }
+    while (end - begin >= 16) {
+        uint32_t outside = ~mask16(end - 16, classes) & 0xFFFFu;
+        if (outside) {
+            return end - 16 + (32 - __builtin_clz(outside));
+        }
+        end -= 16;
+    }
+    while (end > begin && is(end[-1], classes)) {
+        --end;
+    }
+    return end;
+}
+
+inline const char* skip_space(const char* p, const char* end) { return skip(p, end, SPACE); }
+inline const char* skip_digits(const char* p, const char* end) { return skip(p, end, DIGIT); }
+
+/**
+ * @brief Every character of text is in classes (true when empty)
+ */
+inline bool all_of(std::string_view text, uint8_t classes) {
+    return skip(text.data(), text.data() + text.size(), classes) == text.data() + text.size();
+}
+
+inline std::string_view trim_left(std::string_view text) {
+    const char* begin = skip_space(text.data(), text.data() + text.size());
+    return text.substr(static_cast<size_t>(begin - text.data()));
+}
+
+inline std::string_view trim_right(std::string_view text) {
+    const char* end = skip_back(text.data(), text.data() + text.size(), SPACE);
+    return text.substr(0, static_cast<size_t>(end - text.data()));
+}
+
+inline std::string_view trim(std::string_view text) { return trim_right(trim_left(text)); }
+
+/**
+ * @brief Fold ASCII letters in place; other bytes are left alone
+ */
+inline void to_lower(char* data, size_t length) {
+#ifdef FEEDHANDLER_ASCII_SSE2
+    detail::shift_case(data, length, 'A', 32);
+#else
+    for (size_t i = 0; i < length; ++i) {
+        data[i] = to_lower(data[i]);
+    }
+#endif
+}
+
+inline void to_upper(char* data, size_t length) {
+#ifdef FEEDHANDLER_ASCII_SSE2
+    detail::shift_case(data, length, 'a', -32);
+#else
+    for (size_t i = 0; i < length; ++i) {
+        data[i] = to_upper(data[i]);
+    }
+#endif
+}
+
+inline void to_lower(std::string& text) { to_lower(text.data(), text.size()); }
+inline void to_upper(std::string& text) { to_upper(text.data(), text.size()); }
+
+/**
+ * @brief Equal up to ASCII case (header names, enum spellings)
+ */
+inline bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (to_lower(a[i]) != to_lower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Validated integer conversion: leetcode 8's atoi without its
+ *        forgiving parts
+ *
+ * An optional sign ('-' only for signed Int) followed by digits and
+ * nothing else: no surrounding whitespace, no trailing text. Fails,
+ * leaving value untouched, on anything else and on overflow. Runs no
+ * longer than Int's digits10 cannot overflow and skip the checks.
+ *
+ * @return true if text was a number that fits Int
+ */
+template<std::integral Int>
+bool parse_int(std::string_view text, Int& value) {
+    using Unsigned = std::make_unsigned_t<Int>;
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        if (negative && !std::is_signed_v<Int>) {
+            return false;
+        }
+        ++p;
+    }
+    if (p == end || skip_digits(p, end) != end) {
+        return false;
+    }
+
+    // Magnitude limit: |min| is one more than max for signed types
+    const Unsigned limit = static_cast<Unsigned>(std::numeric_limits<Int>::max()) + (negative ? 1u : 0u);
+    Unsigned magnitude = 0;
+    if (end - p <= std::numeric_limits<Int>::digits10) {
+        for (; p < end; ++p) {
+            magnitude = static_cast<Unsigned>(magnitude * 10u + static_cast<Unsigned>(*p - '0'));
+        }
+    } else {
+        for (; p < end; ++p) {
+            Unsigned digit = static_cast<Unsigned>(*p - '0');
+            if (magnitude > (limit - digit) / 10u) {
+                return false;
+            }
+            magnitude = static_cast<Unsigned>(magnitude * 10u + digit);
+        }
+    }
+    value = negative ? static_cast<Int>(Unsigned(0) - magnitude) : static_cast<Int>(magnitude);
+    return true;
+}
+
+} // namespace ascii
+} // namespace parser
+} // namespace feedhandler
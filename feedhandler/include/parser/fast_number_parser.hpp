@@ -1,7 +1,28 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string_view>
+#include "parser/ascii.hpp"
+#include "parser/field_format.hpp"
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define FEEDHANDLER_VECTOR_DIGITS 1
+#define FEEDHANDLER_DIGITS_TARGET
+#elif defined(__x86_64__) || defined(__i386__)
+// Baseline x86 build: the SSE4.1 kernel is compiled anyway and picked
+// at startup when the CPU has it
+#include <smmintrin.h>
+#define FEEDHANDLER_VECTOR_DIGITS 1
+#define FEEDHANDLER_DIGITS_DISPATCH 1
+#define FEEDHANDLER_DIGITS_TARGET __attribute__((target("sse4.1")))
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FEEDHANDLER_VECTOR_DIGITS 1
+#define FEEDHANDLER_DIGITS_TARGET
+#endif
 
 namespace feedhandler {
 namespace parser {
@@ -11,6 +32,22 @@ namespace parser {
  * 
  * These functions are optimized for parsing FIX protocol numeric fields
  * with minimal overhead and no exception handling.
+ * 
+ * With SSE4.1 or NEON the leading digit run (up to 16 digits) is found
+ * and converted in one step: compare 16 lanes for digits, shuffle the
+ * run right-aligned, then multiply-add adjacent lanes (x10, x100, x10^4,
+ * x10^8). Prices are decoded in the same single pass, with the decimal
+ * point squeezed out by the shuffle. The kernel is chosen at compile
+ * time (-msse4.1, NEON) or, on x86 builds without -msse4.1, once at
+ * startup from cpuid, and shared by every parser that goes through
+ * this class.
+ * 
+ * Runs too long to be overflow-free (10+ digits for the 32-bit parsers,
+ * prices that do not fit one 16-byte window, non-power-of-ten scales)
+ * take the *_scalar path, so results are identical to the scalar loops
+ * in every case. Builds without either ISA use the scalar loops, which
+ * beat the 8-byte SWAR kernel on the short fields FIX carries; the SWAR
+ * kernel still backs scan_digits() for long runs.
  */
 class FastNumberParser {
 public:
@@ -74,15 +111,314 @@ public:
      * @return Parsed unsigned integer, 0 if invalid
      */
     static inline uint32_t fast_atou(std::string_view str);
+    
+    /**
+     * @brief Strict conversions for venues that reject malformed fields
+     * 
+     * The field runs through its formats:: DFA one byte at a time while
+     * the digits are accumulated, so validating costs a table load per
+     * byte rather than a second pass. Nothing is skipped: a sign the
+     * format forbids, trailing bytes or an overflowing value fail the
+     * whole field.
+     * 
+     * @return false, leaving out untouched, if str is not a valid
+     *         formats::INT (parse_int_strict) or formats::DECIMAL scaled
+     *         like fast_atof_fixed (parse_fixed_strict; fraction digits
+     *         past the scale are validated, then truncated)
+     */
+    static inline bool parse_int_strict(std::string_view str, int64_t& out);
+    static inline bool parse_fixed_strict(std::string_view str, int64_t scale, int64_t& out);
+    
+    /**
+     * @brief Digit-at-a-time reference implementations (fallback path)
+     */
+    static inline int fast_atoi_scalar(const char* begin, const char* end);
+    static inline int64_t fast_atof_fixed_scalar(const char* begin, const char* end, int64_t scale = 10000);
+    static inline uint32_t fast_atou_scalar(const char* begin, const char* end);
+    
+    /**
+     * @brief Digit-run kernel selected for this build and CPU
+     */
+    enum class Kernel { SCALAR, SWAR, SSE41, NEON };
+    
+    static inline Kernel kernel() {
+#if defined(__x86_64__) || defined(__i386__)
+        return vector_digits() ? Kernel::SSE41 : Kernel::SWAR;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        return Kernel::NEON;
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        return Kernel::SWAR;
+#else
+        return Kernel::SCALAR;
+#endif
+    }
+    
+    static constexpr size_t MAX_RUN_DIGITS = 16;
+    
+    /**
+     * @brief Leading run of decimal digits and its value
+     */
+    struct DigitRun {
+        uint64_t value;   // Value of the first length digits
+        size_t length;    // Digits in the run, capped at the max requested
+    };
+    
+    /**
+     * @brief Length and value of the digit run at ptr, looking at most
+     *        max_digits (<= MAX_RUN_DIGITS) characters ahead
+     * 
+     * Never reads at or past end.
+     */
+    static inline DigitRun scan_digits(const char* ptr, const char* end, size_t max_digits = MAX_RUN_DIGITS);
 
 private:
+    static constexpr uint64_t POW10[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+        100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+        10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL
+    };
+    
+    /**
+     * @brief Fraction digits the scalar loop keeps for a scale (digits
+     *        until 10^k >= scale)
+     */
+    static inline size_t fraction_digits(int64_t scale) {
+        if (__builtin_expect(scale == 10000, 1)) {
+            return 4;  // Default price scale, skip the search
+        }
+        size_t k = 0;
+        while (k <= MAX_RUN_DIGITS && static_cast<int64_t>(POW10[k]) < scale) {
+            ++k;
+        }
+        return k;  // MAX_RUN_DIGITS + 1 means "too many, use the scalar path"
+    }
+    
+#if defined(FEEDHANDLER_DIGITS_DISPATCH)
+    static inline bool detect_sse41() {
+        __builtin_cpu_init();  // May run before libgcc's constructor
+        return __builtin_cpu_supports("sse4.1");
+    }
+    
+    // Read before its dynamic initialisation (from another static
+    // initialiser) it is still false, which only means the scalar path
+    static inline const bool HAS_SSE41 = detect_sse41();
+#endif
+    
+    /**
+     * @brief true when the vector kernels run on this CPU
+     */
+    static inline bool vector_digits() {
+#if defined(FEEDHANDLER_DIGITS_DISPATCH)
+        return HAS_SSE41;
+#elif defined(FEEDHANDLER_VECTOR_DIGITS)
+        return true;
+#else
+        return false;
+#endif
+    }
+    
+    /**
+     * @brief "123.45" as integer and fraction digits, decoded in one pass
+     */
+    struct DecimalRun {
+        uint64_t value;           // Integer digits followed by fraction digits
+        size_t fraction_length;   // Fraction digits in value (<= max_fraction)
+    };
+    
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    typedef uint64_t __attribute__((may_alias, aligned(1))) unaligned_u64;
+    
+    /**
+     * @brief 8 bytes from ptr; bytes past end read as zero (not a digit)
+     */
+    static inline uint64_t load8(const char* ptr, const char* end) {
+        size_t available = static_cast<size_t>(end - ptr);
+        if (__builtin_expect(available >= 8, 1)) {
+            return *reinterpret_cast<const unaligned_u64*>(ptr);
+        }
+        uint64_t word = 0;
+        std::memcpy(&word, ptr, available);
+        return word;
+    }
+    
+    /**
+     * @brief Number of leading ASCII digits in a little-endian word
+     */
+    static inline size_t leading_digits8(uint64_t word) {
+        // Digit bytes become 0x33; a carry out of +6 only corrupts bytes
+        // above one that is already a non-digit
+        uint64_t t = (word & 0xF0F0F0F0F0F0F0F0ULL) |
+                     (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4);
+        uint64_t x = t ^ 0x3333333333333333ULL;
+        uint64_t nonzero = (((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | x) &
+                           0x8080808080808080ULL;
+        return nonzero ? static_cast<size_t>(__builtin_ctzll(nonzero) >> 3) : 8;
+    }
+    
+    /**
+     * @brief Value of 8 digits packed one per byte, most significant first
+     *        (only the low nibble of each byte is used)
+     */
+    static inline uint64_t combine8(uint64_t digits) {
+        digits = ((digits & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+        digits = ((digits & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+        return ((digits & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32;
+    }
+    
+    /**
+     * @brief Value of the first count (1..8) digits of a word
+     */
+    static inline uint64_t combine_prefix8(uint64_t word, size_t count) {
+        // Push the unused bytes out; the vacated low bytes act as leading zeros
+        return combine8(word << ((8 - count) * 8));
+    }
+    
+#endif
+
+#ifdef FEEDHANDLER_VECTOR_DIGITS
+    /**
+     * @brief Shuffle control window: 16 bytes from offset n right-align
+     *        the first n lanes and zero the rest (0x80 zeroes on both ISAs)
+     */
+    alignas(16) static constexpr uint8_t SHIFT_WINDOW[32] = {
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    
+    /**
+     * @brief 16 bytes from ptr; a short tail is copied into scratch first,
+     *        so bytes past end read as zero and nothing past end is touched
+     */
+    static inline const uint8_t* load16(const char* ptr, const char* end, uint8_t (&scratch)[16]) {
+        if (__builtin_expect(end - ptr >= 16, 1)) {
+            return reinterpret_cast<const uint8_t*>(ptr);
+        }
+        std::memset(scratch, 0, sizeof(scratch));
+        std::memcpy(scratch, ptr, static_cast<size_t>(end - ptr));
+        return scratch;
+    }
+    
+#if defined(__x86_64__) || defined(__i386__)
+    using Lanes = __m128i;
+#else
+    using Lanes = uint8x16_t;
+#endif
+    
+    /**
+     * @brief Digit values (byte - '0') of the 16 bytes at ptr
+     * @return Mask with bit i set when byte i is a digit (never for bytes
+     *         past end)
+     */
+    FEEDHANDLER_DIGITS_TARGET
+    static inline uint32_t load_digit_lanes(const char* ptr, const char* end, Lanes& values) {
+        uint8_t scratch[16];
+#if defined(__x86_64__) || defined(__i386__)
+        values = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(load16(ptr, end, scratch))),
+                              _mm_set1_epi8('0'));
+        const __m128i nine = _mm_set1_epi8(9);
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(values, nine), nine)));
+#else
+        values = vsubq_u8(vld1q_u8(load16(ptr, end, scratch)), vdupq_n_u8('0'));
+        const uint8x16_t bits = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+        uint8x16_t hits = vandq_u8(vcleq_u8(values, vdupq_n_u8(9)), bits);
+        return static_cast<uint32_t>(vaddv_u8(vget_low_u8(hits))) |
+               (static_cast<uint32_t>(vaddv_u8(vget_high_u8(hits))) << 8);
+#endif
+    }
+    
+    /**
+     * @brief Value of the first count (1..16) digit lanes, jumping over
+     *        lane skip (pass 16 to skip nothing)
+     */
+    FEEDHANDLER_DIGITS_TARGET
+    static inline uint64_t combine_lanes(Lanes values, size_t count, size_t skip) {
+#if defined(__x86_64__) || defined(__i386__)
+        // Right-align the run; lanes at or past skip come from one lane further
+        // (signed compare leaves the 0x80 zeroing lanes alone)
+        __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(SHIFT_WINDOW + count));
+        index = _mm_sub_epi8(index, _mm_cmpgt_epi8(index, _mm_set1_epi8(static_cast<char>(skip - 1))));
+        __m128i digits = _mm_shuffle_epi8(values, index);
+        
+        // Multiply-add lane pairs: 2, 4, then 8 digits per lane
+        __m128i pairs = _mm_maddubs_epi16(digits, _mm_set1_epi16(0x010A));       // d0*10 + d1
+        __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010064));      // p0*100 + p1
+        __m128i packed = _mm_packus_epi32(quads, quads);
+        __m128i octets = _mm_madd_epi16(packed, _mm_set1_epi32(0x00012710));    // q0*10^4 + q1
+        uint64_t halves;  // Low 64 bits, stored: _mm_cvtsi128_si64 is x86-64 only
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&halves), octets);
+        return (halves & 0xFFFFFFFFULL) * 100000000ULL + (halves >> 32);
+#else
+        uint8x16_t index = vld1q_u8(SHIFT_WINDOW + count);
+        uint8x16_t adjust = vcgtq_s8(vreinterpretq_s8_u8(index), vdupq_n_s8(static_cast<int8_t>(skip - 1)));
+        uint8x16_t digits = vqtbl1q_u8(values, vsubq_u8(index, adjust));
+        
+        // Digits are one per byte, most significant first: combine each half
+        uint64x2_t halves = vreinterpretq_u64_u8(digits);
+        return combine8(vgetq_lane_u64(halves, 0)) * 100000000ULL +
+               combine8(vgetq_lane_u64(halves, 1));
+#endif
+    }
+    
+    /**
+     * @brief Decode a decimal keeping at most max_fraction fraction digits
+     * @return false if the number does not fit one window (scalar fallback)
+     */
+    FEEDHANDLER_DIGITS_TARGET
+    static inline bool scan_decimal(const char* ptr, const char* end, size_t max_fraction, DecimalRun& out) {
+        size_t available = static_cast<size_t>(end - ptr);
+        Lanes values;
+        uint32_t digits = load_digit_lanes(ptr, end, values);
+        if (available < 16) {
+            digits &= (1u << available) - 1;
+        }
+        uint32_t non_digits = ~digits;  // Bits 16 and up always set
+        
+        size_t integer_length = static_cast<size_t>(__builtin_ctz(non_digits));
+        if (integer_length == 16) {
+            return false;
+        }
+        
+        size_t fraction_length = 0;
+        size_t skip = 16;
+        if (integer_length < available && ptr[integer_length] == '.') {
+            skip = integer_length;
+            size_t run = static_cast<size_t>(__builtin_ctz(non_digits >> (integer_length + 1)));
+            if (run >= max_fraction) {
+                run = max_fraction;  // Extra fraction digits are ignored
+            } else if (integer_length + 1 + run == 16) {
+                return false;        // Fraction may continue past the window
+            }
+            fraction_length = run;
+        }
+        
+        size_t count = integer_length + fraction_length;
+        out.value = count ? combine_lanes(values, count, skip) : 0;
+        out.fraction_length = fraction_length;
+        return true;
+    }
+    
+    /**
+     * @brief scan_digits() body for 1 <= max_digits <= end - ptr
+     */
+    FEEDHANDLER_DIGITS_TARGET
+    static inline DigitRun scan_digits_vector(const char* ptr, const char* end, size_t max_digits) {
+        Lanes values;
+        uint32_t digits = load_digit_lanes(ptr, end, values);
+        
+        // Bit max_digits stops the count at the cap (and at end)
+        size_t length = static_cast<size_t>(__builtin_ctz(~digits | (1u << max_digits)));
+        return DigitRun{length ? combine_lanes(values, length, 16) : 0, length};
+    }
+#endif
+    
     /**
      * @brief Check if character is a digit
      * @param c Character to check
      * @return true if digit (0-9)
      */
     static inline bool is_digit(char c) {
-        return c >= '0' && c <= '9';
+        return ascii::is_digit(c);
     }
     
     /**
@@ -97,9 +433,79 @@ private:
 
 // Inline implementations for maximum performance
 
+inline FastNumberParser::DigitRun FastNumberParser::scan_digits(const char* ptr, const char* end, size_t max_digits) {
+    if (ptr >= end || max_digits == 0) {
+        return DigitRun{0, 0};
+    }
+    
+    // Whatever lies past end never joins the run
+    size_t available = static_cast<size_t>(end - ptr);
+    if (available < max_digits) {
+        max_digits = available;
+    }
+    
+#ifdef FEEDHANDLER_VECTOR_DIGITS
+    if (vector_digits()) {
+        return scan_digits_vector(ptr, end, max_digits);
+    }
+#endif
+    
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t first = load8(ptr, end);
+    size_t length = leading_digits8(first);
+    if (length > max_digits) {
+        length = max_digits;
+    }
+    if (length < 8) {
+        return DigitRun{length ? combine_prefix8(first, length) : 0, length};
+    }
+    
+    // Eight digits, so at least eight bytes were available
+    uint64_t second = load8(ptr + 8, end);
+    size_t more = leading_digits8(second);
+    if (more > max_digits - 8) {
+        more = max_digits - 8;
+    }
+    uint64_t value = combine8(first) * POW10[more] + (more ? combine_prefix8(second, more) : 0);
+    return DigitRun{value, 8 + more};
+    
+#else
+    size_t length = 0;
+    uint64_t value = 0;
+    while (ptr + length < end && length < max_digits && is_digit(ptr[length])) {
+        value = value * 10 + digit_to_int(ptr[length]);
+        ++length;
+    }
+    return DigitRun{value, length};
+#endif
+}
+
 inline int FastNumberParser::fast_atoi(const char* begin, const char* end) {
     if (begin >= end) return 0;
     
+#ifdef FEEDHANDLER_VECTOR_DIGITS
+    if (!vector_digits()) {
+        return fast_atoi_scalar(begin, end);
+    }
+    const char* ptr = begin;
+    bool negative = (*ptr == '-');
+    if (negative || *ptr == '+') {
+        ++ptr;
+    }
+    
+    // Nine digits can never trip the overflow check
+    DigitRun run = scan_digits(ptr, end, 10);
+    if (__builtin_expect(run.length <= 9, 1)) {
+        int result = static_cast<int>(run.value);
+        return negative ? -result : result;
+    }
+#endif
+    return fast_atoi_scalar(begin, end);
+}
+
+inline int FastNumberParser::fast_atoi_scalar(const char* begin, const char* end) {
+    if (begin >= end) return 0;
+    
     bool negative = false;
     const char* ptr = begin;
     
@@ -136,6 +542,33 @@ inline int FastNumberParser::fast_atoi(std::string_view str) {
 inline int64_t FastNumberParser::fast_atof_fixed(const char* begin, const char* end, int64_t scale) {
     if (begin >= end) return 0;
     
+#ifdef FEEDHANDLER_VECTOR_DIGITS
+    if (!vector_digits()) {
+        return fast_atof_fixed_scalar(begin, end, scale);
+    }
+    const char* ptr = begin;
+    bool negative = (*ptr == '-');
+    if (negative || *ptr == '+') {
+        ++ptr;
+    }
+    
+    // Power-of-ten scale: integer and fraction digits in a single pass
+    size_t max_fraction = fraction_digits(scale);
+    if (max_fraction <= MAX_RUN_DIGITS && static_cast<int64_t>(POW10[max_fraction]) == scale) {
+        DecimalRun decimal;
+        if (__builtin_expect(scan_decimal(ptr, end, max_fraction, decimal), 1)) {
+            int64_t result = static_cast<int64_t>(decimal.value) *
+                             static_cast<int64_t>(POW10[max_fraction - decimal.fraction_length]);
+            return negative ? -result : result;
+        }
+    }
+#endif
+    return fast_atof_fixed_scalar(begin, end, scale);
+}
+
+inline int64_t FastNumberParser::fast_atof_fixed_scalar(const char* begin, const char* end, int64_t scale) {
+    if (begin >= end) return 0;
+    
     bool negative = false;
     const char* ptr = begin;
     
@@ -181,6 +614,19 @@ inline int64_t FastNumberParser::fast_atof_fixed(std::string_view str, int64_t s
 }
 
 inline uint32_t FastNumberParser::fast_atou(const char* begin, const char* end) {
+#ifdef FEEDHANDLER_VECTOR_DIGITS
+    if (!vector_digits()) {
+        return fast_atou_scalar(begin, end);
+    }
+    DigitRun run = scan_digits(begin, end, 10);
+    if (__builtin_expect(run.length <= 9, 1)) {
+        return static_cast<uint32_t>(run.value);
+    }
+#endif
+    return fast_atou_scalar(begin, end);
+}
+
+inline uint32_t FastNumberParser::fast_atou_scalar(const char* begin, const char* end) {
     if (begin >= end) return 0;
     
     uint32_t result = 0;
@@ -204,5 +650,70 @@ inline uint32_t FastNumberParser::fast_atou(std::string_view str) {
     return fast_atou(str.data(), str.data() + str.size());
 }
 
+inline bool FastNumberParser::parse_int_strict(std::string_view str, int64_t& out) {
+    constexpr uint64_t LIMIT = uint64_t{1} << 63;  // |INT64_MIN|
+    uint8_t state = FieldFormat::START;
+    uint64_t magnitude = 0;
+    for (char c : str) {
+        state = formats::INT.step(state, c);
+        if (state == FieldFormat::DEAD) {
+            return false;
+        }
+        if (is_digit(c)) {
+            uint64_t digit = static_cast<uint64_t>(digit_to_int(c));
+            if (magnitude > (LIMIT - digit) / 10) {
+                return false;
+            }
+            magnitude = magnitude * 10 + digit;
+        }
+    }
+    bool negative = !str.empty() && str[0] == '-';
+    if (!formats::INT.accepts(state) || (!negative && magnitude == LIMIT)) {
+        return false;
+    }
+    out = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+inline bool FastNumberParser::parse_fixed_strict(std::string_view str, int64_t scale, int64_t& out) {
+    if (scale <= 0) {
+        return false;
+    }
+    uint8_t state = FieldFormat::START;
+    int64_t integer_part = 0;
+    int64_t fractional_part = 0;
+    int64_t fractional_scale = 1;
+    bool fraction = false;
+    for (char c : str) {
+        state = formats::DECIMAL.step(state, c);
+        if (state == FieldFormat::DEAD) {
+            return false;
+        }
+        if (is_digit(c)) {
+            if (!fraction) {
+                if (__builtin_mul_overflow(integer_part, 10, &integer_part) ||
+                    __builtin_add_overflow(integer_part, digit_to_int(c), &integer_part)) {
+                    return false;
+                }
+            } else if (fractional_scale < scale) {
+                fractional_part = fractional_part * 10 + digit_to_int(c);
+                fractional_scale *= 10;
+            }
+        } else if (c == '.') {
+            fraction = true;
+        }
+    }
+    if (!formats::DECIMAL.accepts(state)) {
+        return false;
+    }
+    int64_t result;
+    if (__builtin_mul_overflow(integer_part, scale, &result) ||
+        __builtin_add_overflow(result, fractional_part * (scale / fractional_scale), &result)) {
+        return false;
+    }
+    out = (!str.empty() && str[0] == '-') ? -result : result;
+    return true;
+}
+
 } // namespace parser
 } // namespace feedhandler
\ No newline at end of file
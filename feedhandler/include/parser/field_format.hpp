@@ -0,0 +1,415 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace feedhandler {
+namespace parser {
+
+/**
+ * @brief Field format compiled from a regular expression into a DFA
+ *
+ * The pattern is compiled when the object is constructed, so a
+ * constexpr FieldFormat costs nothing at run time and a malformed
+ * pattern is a compile error. Formats built from configuration at
+ * startup throw std::invalid_argument instead. Compilation is Glushkov's
+ * construction (one NFA position per character atom, with first / last /
+ * follow sets computed during parsing) followed by subset construction.
+ * Bytes that every position treats alike share one transition column.
+ *
+ * Matching is then one table load per byte, with no backtracking and no
+ * leetcode 10-style DP table. Callers that convert as they go call
+ * step() per character and accepts() at the end; FastNumberParser's
+ * *_strict functions fuse validation into conversion this way.
+ *
+ * Syntax, matched against the whole field:
+ *   c        literal byte; \c escapes any metacharacter
+ *   .        any byte
+ *   \d       digit
+ *   [a-z_]   set with ranges; [^...] negated
+ *   ( | )    grouping and alternation
+ *   ? * +    on the preceding atom or group
+ *   {n} {n,} {n,m}  repetition, by copying the atom
+ */
+class FieldFormat {
+public:
+    static constexpr size_t MAX_POSITIONS = 63;  // Atoms after {n} expansion
+    static constexpr size_t MAX_STATES = 64;
+    static constexpr size_t MAX_CLASSES = 16;
+
+    static constexpr uint8_t DEAD = 0;   // No match is possible any more
+    static constexpr uint8_t START = 1;
+
+    /**
+     * @throws std::invalid_argument on a syntax error or a pattern that
+     *         exceeds the position, state or class limits
+     */
+    constexpr explicit FieldFormat(std::string_view pattern) {
+        Builder builder(pattern);
+        Fragment whole = builder.alternation();
+        if (builder.pos != pattern.size()) {
+            fail("unbalanced ')' in field format");
+        }
+        builder.follow[0] = whole.first;
+        uint64_t last = whole.last | (whole.nullable ? 1u : 0u);
+
+        // Byte classes: bytes belonging to the same positions
+        std::array<uint64_t, MAX_CLASSES> signatures{};
+        class_count_ = 1;  // Class 0: bytes no position accepts
+        for (size_t byte = 0; byte < 256; ++byte) {
+            uint64_t signature = 0;
+            for (size_t p = 1; p < builder.positions; ++p) {
+                if (builder.chars[p].test(static_cast<uint8_t>(byte))) {
+                    signature |= uint64_t{1} << p;
+                }
+            }
+            size_t index = 0;
+            while (index < class_count_ && signatures[index] != signature) {
+                ++index;
+            }
+            if (index == class_count_) {
+                if (class_count_ == MAX_CLASSES) {
+                    fail("field format needs too many byte classes");
+                }
+                signatures[class_count_++] = signature;
+            }
+            classes_[byte] = static_cast<uint8_t>(index);
+        }
+
+        // Subset construction; a state is the set of positions just matched
+        std::array<uint64_t, MAX_STATES> states{};
+        states[START] = 1;  // Virtual position 0, before the first byte
+        state_count_ = 2;
+        for (size_t s = START; s < state_count_; ++s) {
+            uint64_t reach = 0;
+            for (size_t p = 0; p < builder.positions; ++p) {
+                if (states[s] & (uint64_t{1} << p)) {
+                    reach |= builder.follow[p];
+                }
+            }
+            for (size_t k = 1; k < class_count_; ++k) {
+                uint64_t target = reach & signatures[k];
+                size_t index = 0;
+                while (index < state_count_ && states[index] != target) {
+                    ++index;
+                }
+                if (index == state_count_) {
+                    if (state_count_ == MAX_STATES) {
+                        fail("field format needs too many DFA states");
+                    }
+                    states[state_count_++] = target;
+                }
+                next_[s][k] = static_cast<uint8_t>(index);
+            }
+            if (states[s] & last) {
+                accepting_ |= uint64_t{1} << s;
+            }
+        }
+    }
+
+    /**
+     * @brief State after reading c in state; DEAD stays DEAD
+     */
+    constexpr uint8_t step(uint8_t state, char c) const {
+        return next_[state][classes_[static_cast<unsigned char>(c)]];
+    }
+
+    constexpr bool accepts(uint8_t state) const { return (accepting_ >> state) & 1u; }
+
+    /**
+     * @brief The whole of text matches the format
+     */
+    constexpr bool matches(std::string_view text) const {
+        uint8_t state = START;
+        for (char c : text) {
+            state = step(state, c);
+            if (state == DEAD) {
+                return false;
+            }
+        }
+        return accepts(state);
+    }
+
+    constexpr size_t state_count() const { return state_count_; }
+    constexpr size_t class_count() const { return class_count_; }
+
+private:
+    struct ByteSet {
+        std::array<uint64_t, 4> bits{};
+
+        constexpr void set(uint8_t c) { bits[c >> 6] |= uint64_t{1} << (c & 63); }
+        constexpr void set_range(uint8_t lo, uint8_t hi) {
+            for (unsigned c = lo; c <= hi; ++c) {
+                set(static_cast<uint8_t>(c));
+            }
+        }
+        constexpr bool test(uint8_t c) const { return (bits[c >> 6] >> (c & 63)) & 1u; }
+        constexpr void invert() {
+            for (uint64_t& word : bits) {
+                word = ~word;
+            }
+        }
+    };
+
+    // Glushkov sets of a subexpression; the default is the empty string
+    struct Fragment {
+        uint64_t first = 0;
+        uint64_t last = 0;
+        bool nullable = true;
+    };
+
+    [[noreturn]] static void fail(const char* message) { throw std::invalid_argument(message); }
+
+    struct Builder {
+        std::string_view text;
+        size_t pos = 0;
+        size_t positions = 1;  // 0 is the virtual start position
+        std::array<ByteSet, MAX_POSITIONS + 1> chars{};
+        std::array<uint64_t, MAX_POSITIONS + 1> follow{};
+
+        constexpr explicit Builder(std::string_view pattern) : text(pattern) {}
+
+        constexpr bool at(char c) const { return pos < text.size() && text[pos] == c; }
+
+        constexpr Fragment alternation() {
+            Fragment result = sequence();
+            while (at('|')) {
+                ++pos;
+                Fragment other = sequence();
+                result.first |= other.first;
+                result.last |= other.last;
+                result.nullable = result.nullable || other.nullable;
+            }
+            return result;
+        }
+
+        constexpr Fragment sequence() {
+            Fragment result;
+            while (pos < text.size() && !at('|') && !at(')')) {
+                result = concat(result, repeat());
+            }
+            return result;
+        }
+
+        constexpr Fragment concat(Fragment a, Fragment b) {
+            link(a.last, b.first);
+            Fragment result;
+            result.first = a.first | (a.nullable ? b.first : 0);
+            result.last = b.last | (b.nullable ? a.last : 0);
+            result.nullable = a.nullable && b.nullable;
+            return result;
+        }
+
+        constexpr void link(uint64_t from, uint64_t to) {
+            for (size_t p = 0; p < positions; ++p) {
+                if (from & (uint64_t{1} << p)) {
+                    follow[p] |= to;
+                }
+            }
+        }
+
+        constexpr Fragment repeat() {
+            size_t atom_begin = pos;
+            Fragment result = atom();
+            if (at('?')) {
+                ++pos;
+                result.nullable = true;
+            } else if (at('*') || at('+')) {
+                bool star = at('*');
+                ++pos;
+                link(result.last, result.first);
+                result.nullable = result.nullable || star;
+            } else if (at('{')) {
+                ++pos;
+                size_t min = number();
+                size_t max = min;
+                bool unbounded = false;
+                if (at(',')) {
+                    ++pos;
+                    unbounded = at('}');
+                    max = unbounded ? min : number();
+                }
+                if (!at('}') || max < min || max > MAX_POSITIONS) {
+                    fail("bad {n,m} in field format");
+                }
+                size_t resume = ++pos;
+
+                // Each further copy re-parses the atom into fresh positions
+                auto copy = [&](size_t index) {
+                    if (index == 0) {
+                        return result;
+                    }
+                    pos = atom_begin;
+                    return atom();
+                };
+                Fragment total;
+                size_t copies = 0;
+                for (; copies < min; ++copies) {
+                    total = concat(total, copy(copies));
+                }
+                if (unbounded) {
+                    Fragment tail = copy(copies);
+                    link(tail.last, tail.first);
+                    tail.nullable = true;
+                    total = concat(total, tail);
+                } else {
+                    for (; copies < max; ++copies) {
+                        Fragment optional = copy(copies);
+                        optional.nullable = true;
+                        total = concat(total, optional);
+                    }
+                }
+                pos = resume;
+                result = total;
+            }
+            if (at('?') || at('*') || at('+') || at('{')) {
+                fail("stacked quantifiers in field format");
+            }
+            return result;
+        }
+
+        constexpr size_t number() {
+            size_t value = 0;
+            size_t begin = pos;
+            while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && value <= MAX_POSITIONS) {
+                value = value * 10 + static_cast<size_t>(text[pos++] - '0');
+            }
+            if (pos == begin) {
+                fail("bad {n,m} in field format");
+            }
+            return value;
+        }
+
+        constexpr Fragment atom() {
+            if (pos == text.size()) {
+                fail("field format ends where an atom was expected");
+            }
+            char c = text[pos++];
+            ByteSet set;
+            switch (c) {
+                case '(': {
+                    Fragment group = alternation();
+                    if (!at(')')) {
+                        fail("unbalanced '(' in field format");
+                    }
+                    ++pos;
+                    return group;
+                }
+                case '[':
+                    set = bracket();
+                    break;
+                case '.':
+                    set.invert();
+                    break;
+                case '\\':
+                    set = escape();
+                    break;
+                case ')': case '|': case '?': case '*': case '+': case '{': case '}': case ']':
+                    fail("misplaced metacharacter in field format");
+                default:
+                    set.set(static_cast<uint8_t>(c));
+                    break;
+            }
+            return position(set);
+        }
+
+        constexpr Fragment position(const ByteSet& set) {
+            if (positions > MAX_POSITIONS) {
+                fail("field format has too many positions");
+            }
+            chars[positions] = set;
+            Fragment result;
+            result.first = result.last = uint64_t{1} << positions;
+            result.nullable = false;
+            ++positions;
+            return result;
+        }
+
+        constexpr ByteSet escape() {
+            if (pos == text.size()) {
+                fail("field format ends in '\\'");
+            }
+            ByteSet set;
+            char c = text[pos++];
+            if (c == 'd') {
+                set.set_range('0', '9');
+            } else {
+                set.set(static_cast<uint8_t>(c));
+            }
+            return set;
+        }
+
+        constexpr ByteSet bracket() {
+            ByteSet set;
+            bool negated = at('^');
+            if (negated) {
+                ++pos;
+            }
+            bool empty = true;
+            while (pos < text.size() && (!at(']') || empty)) {
+                empty = false;
+                if (at('\\')) {
+                    ++pos;
+                    ByteSet escaped = escape();
+                    for (size_t i = 0; i < 4; ++i) {
+                        set.bits[i] |= escaped.bits[i];
+                    }
+                    continue;
+                }
+                uint8_t lo = static_cast<uint8_t>(text[pos++]);
+                if (at('-') && pos + 1 < text.size() && text[pos + 1] != ']') {
+                    uint8_t hi = static_cast<uint8_t>(text[pos + 1]);
+                    if (hi < lo) {
+                        fail("reversed range in field format");
+                    }
+                    set.set_range(lo, hi);
+                    pos += 2;
+                } else {
+                    set.set(lo);
+                }
+            }
+            if (!at(']')) {
+                fail("unterminated '[' in field format");
+            }
+            ++pos;
+            if (negated) {
+                set.invert();
+            }
+            return set;
+        }
+    };
+
+    std::array<uint8_t, 256> classes_{};
+    std::array<std::array<uint8_t, MAX_CLASSES>, MAX_STATES> next_{};
+    uint64_t accepting_ = 0;
+    size_t state_count_ = 0;
+    size_t class_count_ = 0;
+};
+
+/**
+ * @brief FIX data type formats for strict venues
+ */
+namespace formats {
+
+// int: optional '-', digits (leading zeros allowed)
+inline constexpr FieldFormat INT("-?\\d+");
+
+// SeqNum, Length, NumInGroup: unsigned digits
+inline constexpr FieldFormat UNSIGNED("\\d+");
+
+// float / Price / Qty: optional '-', digits with an optional point; no exponent
+inline constexpr FieldFormat DECIMAL("-?(\\d+\\.?\\d*|\\.\\d+)");
+
+// UTCTimestamp: YYYYMMDD-HH:MM:SS[.sss[sss[sss[sss]]]], fields range-checked
+// (the day against its month is left to the converter)
+inline constexpr FieldFormat UTC_TIMESTAMP(
+    "\\d{4}(0[1-9]|1[0-2])(0[1-9]|[12]\\d|3[01])-([01]\\d|2[0-3]):[0-5]\\d:([0-5]\\d|60)"
+    "(\\.\\d{3}(\\d{3}(\\d{3}(\\d{3})?)?)?)?");
+
+} // namespace formats
+
+} // namespace parser
+} // namespace feedhandler
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace feedhandler {
+namespace parser {
+
+/**
+ * @brief Frames FIX messages by BodyLength (tag 9) and validates CheckSum (tag 10)
+ *
+ * A message is "8=<BeginString><d>9=<BodyLength><d><body>10=<CheckSum><d>"
+ * where <d> is SOH or '|'. BodyLength counts the bytes after the delimiter
+ * of tag 9 up to and including the delimiter before "10=", so the trailer
+ * is located with one addition instead of scanning the body. CheckSum is
+ * the sum of every byte before "10=" modulo 256, written as three digits.
+ *
+ * The framer is stateless: frame() either reports a whole message, asks
+ * for more bytes, or flags the header/trailer as invalid so the caller can
+ * resynchronize with find_message_start().
+ */
+class FixFramer {
+public:
+    enum class Status {
+        COMPLETE,          // length bytes form a valid message
+        INCOMPLETE,        // Need more bytes to decide
+        BAD_HEADER,        // Does not start with "8=...<d>9=<digits><d>"
+        BAD_BODY_LENGTH,   // No "10=ddd<d>" trailer where BodyLength points
+        BAD_CHECKSUM       // Trailer present but the checksum does not match
+    };
+
+    struct Frame {
+        Status status;
+        size_t length;     // Whole message including trailer (COMPLETE only)
+    };
+
+    /**
+     * @brief Frame the message at the start of data
+     * @param data Bytes starting at "8="
+     * @param length Bytes available
+     * @param verify_checksum false to trust tag 10 and only frame
+     */
+    static Frame frame(const char* data, size_t length, bool verify_checksum = true);
+
+    /**
+     * @brief Sum of bytes modulo 256 (SIMD horizontal byte sum)
+     */
+    static uint8_t checksum(const char* data, size_t length);
+    static uint8_t checksum_scalar(const char* data, size_t length);
+
+    /**
+     * @brief Offset of the first "8=FIX" in data, or length if none
+     *
+     * A trailing partial match is reported as its offset so the caller
+     * keeps those bytes for the next read.
+     */
+    static size_t find_message_start(const char* data, size_t length);
+
+    /**
+     * @brief Offset just past the first "10=ddd<d>" field in data
+     *
+     * The field must start data or follow a delimiter. Finds where a
+     * message ends without trusting its BodyLength.
+     * @return Offset, or 0 if data holds no complete trailer
+     */
+    static size_t find_trailer_end(const char* data, size_t length);
+
+    /**
+     * @brief Value of the first Symbol (tag 55) field in data
+     *
+     * SIMD scan for "55=" after a delimiter, without tokenizing the
+     * fields before it, so a subscription filter can judge a message
+     * before it is parsed.
+     * @return The value, or empty if data has no complete tag 55 field
+     */
+    static std::string_view find_symbol(const char* data, size_t length);
+    static std::string_view find_symbol_scalar(const char* data, size_t length);
+
+    static constexpr size_t TRAILER_LENGTH = 7;  // "10=ddd<d>"
+
+private:
+    static bool is_delimiter(char c) { return c == '\x01' || c == '|'; }
+    static std::string_view field_value(const char* data, size_t length, size_t tag_pos);
+};
+
+} // namespace parser
+} // namespace feedhandler
@@ -0,0 +1,446 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "common/compact_tick.hpp"
+#include "common/tick.hpp"
+#include "parser/fast_number_parser.hpp"
+#include "parser/field_format.hpp"
+
+namespace feedhandler {
+namespace parser {
+
+/**
+ * @brief Value decoders for FixSchema fields
+ *
+ * Each decoder is a stateless type with a static decode(std::string_view)
+ * returning the target value.
+ */
+namespace decode {
+
+struct Int {
+    static int32_t decode(std::string_view value) { return FastNumberParser::fast_atoi(value); }
+};
+
+struct Int64 {
+    static int64_t decode(std::string_view value) {
+        int64_t result = 0;
+        size_t i = (!value.empty() && value[0] == '-') ? 1 : 0;
+        for (; i < value.size() && value[i] >= '0' && value[i] <= '9'; ++i) {
+            result = result * 10 + (value[i] - '0');
+        }
+        return (!value.empty() && value[0] == '-') ? -result : result;
+    }
+};
+
+/**
+ * @brief Fixed-point price scaled by 10000
+ */
+struct FixedPrice {
+    static int64_t decode(std::string_view value) { return FastNumberParser::fast_atof_fixed(value); }
+};
+
+/**
+ * @brief First character (e.g. 269 MDEntryType, 279 MDUpdateAction)
+ */
+struct Char {
+    static char decode(std::string_view value) { return value.empty() ? '\0' : value[0]; }
+};
+
+/**
+ * @brief 54 Side: '1'/'2' to 'B'/'S'
+ */
+struct Side {
+    static char decode(std::string_view value) {
+        return common::fix_side_to_char(FastNumberParser::fast_atoi(value));
+    }
+};
+
+/**
+ * @brief UTCTimestamp "YYYYMMDD-HH:MM:SS[.sss[sss[sss]]]" to ns since epoch, 0 if malformed
+ */
+struct UtcTimestamp {
+    static uint64_t decode(std::string_view value) {
+        if (value.size() < 17 || value[8] != '-' || value[11] != ':' || value[14] != ':') {
+            return 0;
+        }
+        int64_t year = digits(value, 0, 4);
+        int64_t month = digits(value, 4, 2);
+        int64_t day = digits(value, 6, 2);
+        int64_t hour = digits(value, 9, 2);
+        int64_t minute = digits(value, 12, 2);
+        int64_t second = digits(value, 15, 2);
+        if (year < 1970 || month < 1 || month > 12 || day < 1 || day > 31 ||
+            hour > 23 || minute > 59 || second > 60) {
+            return 0;
+        }
+
+        uint64_t ns = static_cast<uint64_t>(days_from_civil(year, month, day) * 86400 +
+                                            hour * 3600 + minute * 60 + second) * 1000000000ull;
+
+        // Optional fraction: milli, micro or nanoseconds
+        if (value.size() > 18 && value[17] == '.') {
+            uint64_t fraction = 0;
+            size_t count = 0;
+            for (size_t i = 18; i < value.size() && count < 9 && value[i] >= '0' && value[i] <= '9'; ++i, ++count) {
+                fraction = fraction * 10 + static_cast<uint64_t>(value[i] - '0');
+            }
+            for (; count < 9; ++count) {
+                fraction *= 10;
+            }
+            ns += fraction;
+        }
+        return ns;
+    }
+
+    /**
+     * @brief Strict variant: formats::UTC_TIMESTAMP, validated while the
+     *        digits are accumulated, plus the day checked against its month
+     * @return false, leaving ns untouched, if value is malformed
+     */
+    static bool decode_strict(std::string_view value, uint64_t& ns) {
+        // date, hour, minute, second, fraction: one accumulator per field
+        uint64_t parts[5] = {};
+        size_t part = 0;
+        size_t fraction_digits = 0;
+        uint8_t state = FieldFormat::START;
+        for (char c : value) {
+            state = formats::UTC_TIMESTAMP.step(state, c);
+            if (state == FieldFormat::DEAD) {
+                return false;
+            }
+            if (c >= '0' && c <= '9') {
+                parts[part] = parts[part] * 10 + static_cast<uint64_t>(c - '0');
+                fraction_digits += part == 4;
+            } else {
+                ++part;  // The format allows a separator only between fields
+            }
+        }
+        if (!formats::UTC_TIMESTAMP.accepts(state)) {
+            return false;
+        }
+
+        int64_t year = static_cast<int64_t>(parts[0] / 10000);
+        int64_t month = static_cast<int64_t>(parts[0] / 100 % 100);
+        int64_t day = static_cast<int64_t>(parts[0] % 100);
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        constexpr int64_t DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        if (year < 1970 || day > DAYS[month - 1] + (month == 2 && leap)) {
+            return false;
+        }
+
+        uint64_t fraction = parts[4];
+        for (; fraction_digits > 9; --fraction_digits) {
+            fraction /= 10;  // Picoseconds: keep nanoseconds
+        }
+        for (; fraction_digits < 9; ++fraction_digits) {
+            fraction *= 10;
+        }
+        int64_t seconds = days_from_civil(year, month, day) * 86400 + static_cast<int64_t>(parts[1] * 3600 + parts[2] * 60 + parts[3]);
+        ns = static_cast<uint64_t>(seconds) * 1000000000ull + fraction;
+        return true;
+    }
+
+private:
+    static int64_t digits(std::string_view value, size_t pos, size_t count) {
+        int64_t result = 0;
+        for (size_t i = pos; i < pos + count; ++i) {
+            if (value[i] < '0' || value[i] > '9') {
+                return -1;
+            }
+            result = result * 10 + (value[i] - '0');
+        }
+        return result;
+    }
+
+    // Days since 1970-01-01 in the proleptic Gregorian calendar
+    static int64_t days_from_civil(int64_t y, int64_t m, int64_t d) {
+        y -= m <= 2;
+        int64_t era = y / 400;
+        int64_t yoe = y - era * 400;
+        int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+};
+
+} // namespace decode
+
+/**
+ * @brief Field handlers: store a decoded value into the target
+ *
+ * A handler is a stateless type with a static apply(Target&, std::string_view).
+ * Symbol/Price/Quantity/Side/SendingTime work for both Tick and CompactTick;
+ * Assign stores into any data member, for venue-specific targets.
+ *
+ * A handler whose apply() returns bool is strict: false rejects the
+ * whole message. The Strict* handlers validate and convert in one pass
+ * (FastNumberParser's *_strict functions); Validated checks any handler's
+ * field against a FieldFormat first.
+ */
+namespace fields {
+
+template<auto Member, typename Decoder>
+struct Assign {
+    template<typename Target>
+    static void apply(Target& target, std::string_view value) {
+        target.*Member = Decoder::decode(value);
+    }
+};
+
+struct Symbol {
+    static void apply(common::Tick& tick, std::string_view value) {
+        tick.symbol = value;  // Zero-copy: points directly into input buffer
+        tick.intern_symbol();
+    }
+    static void apply(common::CompactTick& tick, std::string_view value) {
+        tick.instrument_id = common::SymbolTable::global().intern(value);
+    }
+};
+
+struct Price {
+    template<typename Target>
+    static void apply(Target& tick, std::string_view value) { tick.price = decode::FixedPrice::decode(value); }
+};
+
+struct Quantity {
+    template<typename Target>
+    static void apply(Target& tick, std::string_view value) { tick.qty = decode::Int::decode(value); }
+};
+
+struct Side {
+    template<typename Target>
+    static void apply(Target& tick, std::string_view value) { tick.side = decode::Side::decode(value); }
+};
+
+struct SendingTime {
+    template<typename Target>
+    static void apply(Target& tick, std::string_view value) { tick.timestamp = decode::UtcTimestamp::decode(value); }
+};
+
+struct StrictPrice {
+    template<typename Target>
+    static bool apply(Target& tick, std::string_view value) {
+        int64_t price;
+        if (!FastNumberParser::parse_fixed_strict(value, 10000, price)) {
+            return false;
+        }
+        tick.price = price;
+        return true;
+    }
+};
+
+/**
+ * @brief Unsigned integer quantity that fits the target's qty
+ */
+struct StrictQuantity {
+    template<typename Target>
+    static bool apply(Target& tick, std::string_view value) {
+        int64_t qty;
+        using Qty = decltype(tick.qty);
+        if (!FastNumberParser::parse_int_strict(value, qty) || value[0] == '-' ||
+            qty > static_cast<int64_t>(std::numeric_limits<Qty>::max())) {
+            return false;
+        }
+        tick.qty = static_cast<Qty>(qty);
+        return true;
+    }
+};
+
+struct StrictSendingTime {
+    template<typename Target>
+    static bool apply(Target& tick, std::string_view value) {
+        return decode::UtcTimestamp::decode_strict(value, tick.timestamp);
+    }
+};
+
+/**
+ * @brief Handler, applied only if the value matches Format (e.g. an enum
+ *        field such as 269 MDEntryType against "[0-2]")
+ */
+template<const FieldFormat& Format, typename Handler>
+struct Validated {
+    template<typename Target>
+    static bool apply(Target& target, std::string_view value) {
+        if (!Format.matches(value)) {
+            return false;
+        }
+        Handler::apply(target, value);
+        return true;
+    }
+};
+
+} // namespace fields
+
+/**
+ * @brief One field of a schema: tag, handler, and whether it is required
+ */
+template<int Tag, typename Handler, bool Required = true>
+struct FixField {
+    static_assert(Tag > 0, "FIX tags are positive");
+    static constexpr uint32_t TAG = Tag;
+    static constexpr bool REQUIRED = Required;
+    using handler = Handler;
+};
+
+/**
+ * @brief Compile-time FIX message schema
+ *
+ * A message type lists the tags it needs and how each is stored:
+ *
+ * @code
+ * using TickSchema = FixSchema<common::Tick,
+ *     FixField<55, fields::Symbol>,
+ *     FixField<44, fields::Price>,
+ *     FixField<52, fields::SendingTime, false>>;
+ * TickSchema::parse(message, tick);
+ * @endcode
+ *
+ * Tag dispatch is a perfect hash computed at compile time: the smallest
+ * modulus that maps every declared tag to its own slot, so a lookup is one
+ * multiply-based remainder, one table load and one compare, and the
+ * handler call is inlined. Undeclared tags cost only the lookup. Only the
+ * first occurrence of a tag is stored, and the scan stops as soon as every
+ * declared field has been seen. Fields are delimited by SOH or '|'.
+ * A strict handler returning false stops the scan and fails the parse.
+ */
+template<typename Target, typename... Fields>
+class FixSchema {
+public:
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+    static_assert(FIELD_COUNT > 0 && FIELD_COUNT <= 64, "Schema needs 1 to 64 fields");
+
+    /**
+     * @brief Parse one message into target
+     * @return true if every required field was present and no strict
+     *         field was rejected
+     */
+    static bool parse(std::string_view message, Target& target) {
+        uint64_t seen = 0;
+        const char* ptr = message.data();
+        const char* end = ptr + message.size();
+
+        while (ptr < end) {
+            // Tag digits up to '=' (unsigned wrap keeps junk harmless)
+            const char* tag_start = ptr;
+            uint32_t tag = 0;
+            while (ptr < end && static_cast<unsigned char>(*ptr - '0') <= 9) {
+                tag = tag * 10 + static_cast<uint32_t>(*ptr - '0');
+                ++ptr;
+            }
+            bool has_tag = ptr < end && *ptr == '=' && ptr > tag_start;
+
+            const char* value = has_tag ? ptr + 1 : ptr;
+            const char* delim = value;
+            while (delim < end && *delim != '|' && *delim != '\x01') {
+                ++delim;
+            }
+
+            if (has_tag) {
+                int index = lookup(tag);
+                if (index >= 0 && !(seen & (uint64_t{1} << index))) {
+                    if (!dispatch(index, target, std::string_view(value, static_cast<size_t>(delim - value)),
+                                  std::index_sequence_for<Fields...>{})) {
+                        return false;
+                    }
+                    seen |= uint64_t{1} << index;
+                    if (seen == ALL_MASK) {
+                        break;  // Everything we care about is in
+                    }
+                }
+            }
+            ptr = delim + 1;
+        }
+
+        return (seen & REQUIRED_MASK) == REQUIRED_MASK;
+    }
+
+    /**
+     * @brief Field index of a tag, or -1 if the schema does not declare it
+     */
+    static constexpr int lookup(uint32_t tag) {
+        int index = static_cast<int>(TABLE[tag % MODULUS]) - 1;
+        return (index >= 0 && TAGS[index] == tag) ? index : -1;
+    }
+
+    /**
+     * @brief Perfect hash table size (tag % table_size() is unique per field)
+     */
+    static constexpr size_t table_size() { return MODULUS; }
+
+private:
+    static constexpr std::array<uint32_t, FIELD_COUNT> TAGS = {Fields::TAG...};
+
+    static constexpr bool distinct_tags() {
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {
+            for (size_t j = i + 1; j < FIELD_COUNT; ++j) {
+                if (TAGS[i] == TAGS[j]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    static_assert(distinct_tags(), "Schema declares a tag twice");
+
+    static constexpr uint64_t ALL_MASK = FIELD_COUNT == 64 ? ~uint64_t{0} : (uint64_t{1} << FIELD_COUNT) - 1;
+
+    static constexpr uint64_t REQUIRED_MASK = [] {
+        constexpr bool required[] = {Fields::REQUIRED...};
+        uint64_t mask = 0;
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {
+            mask |= static_cast<uint64_t>(required[i]) << i;
+        }
+        return mask;
+    }();
+
+    // Smallest modulus that gives every tag its own slot
+    static constexpr size_t MODULUS = [] {
+        for (size_t m = FIELD_COUNT;; ++m) {
+            bool unique = true;
+            for (size_t i = 0; i < FIELD_COUNT && unique; ++i) {
+                for (size_t j = i + 1; j < FIELD_COUNT && unique; ++j) {
+                    unique = (TAGS[i] % m) != (TAGS[j] % m);
+                }
+            }
+            if (unique) {
+                return m;
+            }
+        }
+    }();
+
+    // Slot -> field index + 1 (0 = empty)
+    static constexpr std::array<uint8_t, MODULUS> TABLE = [] {
+        std::array<uint8_t, MODULUS> table{};
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {
+            table[TAGS[i] % MODULUS] = static_cast<uint8_t>(i + 1);
+        }
+        return table;
+    }();
+
+    template<typename Handler>
+    static bool apply(Target& target, std::string_view value) {
+        if constexpr (std::is_same_v<decltype(Handler::apply(target, value)), bool>) {
+            return Handler::apply(target, value);
+        } else {
+            Handler::apply(target, value);
+            return true;
+        }
+    }
+
+    template<size_t... I>
+    static bool dispatch(int index, Target& target, std::string_view value, std::index_sequence<I...>) {
+        // Folds into a jump table over inlined handlers
+        bool accepted = true;
+        ((index == static_cast<int>(I) ? (accepted = apply<typename Fields::handler>(target, value), true) : false) || ...);
+        return accepted;
+    }
+};
+
+} // namespace parser
+} // namespace feedhandler
@@ -4,6 +4,10 @@
 #include <vector>
 #include <cstdint>
 #include "common/tick.hpp"
+#include "common/tick_batch.hpp"
+#include "common/tick_span.hpp"
+#include "common/flyweight_tick.hpp"
+#include "common/latency_histogram.hpp"
 
 namespace feedhandler {
 namespace parser {
@@ -15,6 +19,12 @@ namespace parser {
  * between parse calls. It processes input character-by-character and
  * can stop mid-message and resume later.
  * 
+ * When a whole field is already in the buffer the parser skips the
+ * per-character state machine: the value delimiter is located 16 bytes
+ * at a time (SSE2, or 8 bytes with SWAR) and the field is decoded in
+ * place without copying into the value buffer. Fields that straddle a
+ * fragment boundary go through the FSM as before.
+ * 
  * Performance characteristics:
  * - Streaming capable (handles fragmented messages)
  * - Zero heap allocations during parsing
@@ -56,6 +66,58 @@ public:
      */
     size_t parse(const char* buffer, size_t length, std::vector<common::Tick>& ticks);
     
+    /**
+     * @brief Parse input buffer emitting packed 32-byte ticks
+     * @param buffer Input buffer to parse
+     * @param length Length of input buffer
+     * @param ticks Output vector for completed ticks
+     * @return Number of bytes consumed from buffer
+     * 
+     * Same streaming semantics as the Tick overload, but skips the
+     * 64-byte symbol copy: the symbol is emitted as its instrument ID.
+     */
+    size_t parse(const char* buffer, size_t length, std::vector<common::CompactTick>& ticks);
+    
+    /**
+     * @brief Parse input buffer into caller-owned fixed-capacity storage
+     * @param buffer Input buffer to parse
+     * @param length Length of input buffer
+     * @param ticks Output span; ticks are appended until it is full
+     * @return Number of bytes consumed from buffer
+     * 
+     * Never allocates. When the span fills up, parsing stops right after
+     * the message that filled it; call again with buffer + consumed once
+     * the span has been drained. Returns 0 if the span is already full.
+     */
+    size_t parse(const char* buffer, size_t length, common::TickSpan<common::Tick>& ticks);
+    size_t parse(const char* buffer, size_t length, common::TickSpan<common::CompactTick>& ticks);
+    
+    /**
+     * @brief Parse input buffer into a preallocated TickPool
+     * 
+     * Same stop-when-full semantics as the TickSpan overloads.
+     */
+    size_t parse(const char* buffer, size_t length, common::TickPool& ticks);
+    
+    /**
+     * @brief Parse input buffer into a structure-of-arrays TickBatch
+     * 
+     * Same stop-when-full semantics as the TickSpan overloads; the
+     * symbol is stored as its instrument ID, as for CompactTick.
+     */
+    size_t parse(const char* buffer, size_t length, common::TickBatch& ticks);
+    
+    /**
+     * @brief Parse input buffer into zero-copy flyweight ticks
+     * 
+     * Same stop-when-full semantics as the other TickSpan overloads.
+     * When the symbol field lies in this buffer the tick's symbol views
+     * it in place, so the buffer must outlive the ticks (see SegmentRef).
+     * A symbol carried over from an earlier fragment views the global
+     * SymbolTable entry instead, which never moves.
+     */
+    size_t parse(const char* buffer, size_t length, common::TickSpan<common::FlyweightTick>& ticks);
+    
     /**
      * @brief Check if parser is currently in the middle of a message
      */
@@ -66,6 +128,39 @@ public:
      */
     State get_state() const { return state_; }
     
+    /**
+     * @brief Stamp ticks with the bytes' receive time instead of parse time
+     * @param timestamp_ns NIC/kernel arrival time (ns since epoch), 0 to
+     *        go back to stamping with the clock at parse time
+     * 
+     * Applies to every tick completed by later parse() calls, so set it
+     * before parsing each new read (see ReceiveBuffer::receive_timestamp).
+     * All ticks of one read share the stamp; it is not an ordering key
+     * (books order and gap-check by Tick::sequence).
+     */
+    void set_receive_timestamp(uint64_t timestamp_ns) { receive_timestamp_ = timestamp_ns; }
+    uint64_t receive_timestamp() const { return receive_timestamp_; }
+    
+    /**
+     * @brief Stamp every tick of a parse() call with one clock read
+     * @param enable If true, the clock is read once per parse() call
+     *        instead of once per tick; ticks of one buffer share a time
+     * 
+     * Ignored while a receive timestamp is set.
+     */
+    void set_batch_timestamps(bool enable) { batch_timestamps_ = enable; }
+    bool is_batch_timestamps_enabled() const { return batch_timestamps_; }
+    
+    /**
+     * @brief Record wire-to-parse latency (parse time - receive time)
+     * @param histogram Destination, nullptr to disable; must outlive the
+     *        parser (readable live from other threads via snapshot())
+     * 
+     * One clock read per parse() call that emits ticks with a receive
+     * timestamp set; every tick of that call gets the same sample.
+     */
+    void set_latency_histogram(common::AtomicLatencyHistogram* histogram) { wire_to_parse_ = histogram; }
+    
     /**
      * @brief Enable/disable garbage recovery mode
      * @param enable If true, parser will scan for "8=FIX" to resync after errors
@@ -77,6 +172,17 @@ public:
      */
     bool is_garbage_recovery_enabled() const { return garbage_recovery_enabled_; }
     
+    /**
+     * @brief Enable/disable the in-place field fast path
+     * @param enable If false, every byte goes through the state machine
+     */
+    void set_fast_path(bool enable) { fast_path_enabled_ = enable; }
+    
+    /**
+     * @brief Check if the in-place field fast path is enabled
+     */
+    bool is_fast_path_enabled() const { return fast_path_enabled_; }
+    
     /**
      * @brief Get statistics about garbage recovery
      */
@@ -93,6 +199,9 @@ public:
     
     /**
      * @brief Attempt to recover from parsing error by scanning for "8=FIX"
+     *
+     * Candidates ("8=") are found 16 bytes at a time (SSE2) and then
+     * compared in full, so megabytes of junk do not stall the caller.
      * @param buffer Remaining buffer to scan
      * @param length Length of remaining buffer
      * @return Number of bytes to skip to reach potential message start
@@ -133,9 +242,20 @@ private:
     int parse_accumulated_int() const;
     
     /**
-     * @brief Parse double from accumulated digits
+     * @brief Apply a decoded tag/value pair to tick_builder_
+     * @return true if the field ends the message (tag 10)
      */
-    double parse_accumulated_double() const;
+    bool apply_field(int tag, const char* value, size_t length);
+    
+    /**
+     * @brief Decode one complete "tag=value<delim>" field without the FSM
+     * @param buffer Input positioned at a field boundary
+     * @param length Bytes available
+     * @param message_complete Set when the field completes a message
+     * @return Bytes consumed including the delimiter, or 0 if the field is
+     *         not fully in the buffer (caller falls back to process_char)
+     */
+    size_t parse_field_in_place(const char* buffer, size_t length, bool& message_complete);
     
     // Parser state
     State state_;
@@ -153,6 +273,7 @@ private:
     struct TickBuilder {
         char symbol_storage[64];  // Persistent storage for symbol
         size_t symbol_length;
+        const char* symbol_in_place; // Symbol inside the current input buffer, or nullptr
         int64_t price;
         int32_t qty;
         char side;
@@ -161,12 +282,13 @@ private:
         bool has_qty;
         bool has_side;
         
-        TickBuilder() : symbol_length(0), price(0), qty(0), side('\0'), 
+        TickBuilder() : symbol_length(0), symbol_in_place(nullptr), price(0), qty(0), side('\0'), 
                        has_symbol(false), has_price(false), 
                        has_qty(false), has_side(false) {}
         
         void reset() {
             symbol_length = 0;
+            symbol_in_place = nullptr;
             price = 0;
             qty = 0;
             side = '\0';
@@ -184,22 +306,48 @@ private:
     
     TickBuilder tick_builder_;
     
+    /**
+     * @brief Shared parse loop for every output type
+     */
+    template<typename Out>
+    size_t parse_into(const char* buffer, size_t length, Out& ticks);
+    
+    /**
+     * @brief Append completed tick_builder_ contents to output
+     */
+    template<typename Out>
+    void emit_tick(Out& ticks) const;
+    
+    /**
+     * @brief Fill a tick from tick_builder_
+     */
+    void build_tick(common::Tick& tick) const;
+    void build_tick(common::CompactTick& tick) const;
+    void build_tick(common::FlyweightTick& tick) const;
+    
     // Symbol storage for zero-copy (points into value_buffer_)
     size_t symbol_start_;
     size_t symbol_length_;
     
+    // Arrival time stamped into ticks (0 = parse time) and its histogram
+    uint64_t receive_timestamp_ = 0;
+    common::AtomicLatencyHistogram* wire_to_parse_ = nullptr;
+    
+    // Timestamp shared by this parse() call's ticks (0 = read per tick)
+    bool batch_timestamps_ = false;
+    uint64_t call_timestamp_ = 0;
+    
     // Garbage recovery
     bool garbage_recovery_enabled_;
     RecoveryStats recovery_stats_;
     
-    // Recovery state machine
+    // Field-at-a-time fast path
+    bool fast_path_enabled_;
+    
+    // Outcome of the last recovery scan
     enum class RecoveryState {
-        SCANNING,           // Scanning for '8'
-        FOUND_8,           // Found '8', looking for '='
-        FOUND_EQUALS,      // Found '8=', looking for 'F'
-        FOUND_F,           // Found '8=F', looking for 'I'
-        FOUND_FI,          // Found '8=FI', looking for 'X'
-        COMPLETE           // Found '8=FIX', can resume parsing
+        SCANNING,           // No "8=FIX" found yet
+        COMPLETE            // Found '8=FIX', can resume parsing
     };
     
     RecoveryState recovery_state_;
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+#include "common/compact_tick.hpp"
+#include "config/performance_config.hpp"
+#include "gpu/cuda_parser.hpp"
+#include "parser/simd_fix_parser.hpp"
+
+namespace feedhandler {
+namespace parser {
+
+/**
+ * @brief Routes each batch of FIX messages to SIMDFixParser or a GPU parser
+ *
+ * Live trading hands over a few messages at a time and cannot afford a
+ * PCIe round trip; replay jobs hand over tens of thousands, where the
+ * GPU's fixed launch and transfer cost is amortized. Instead of a fixed
+ * threshold the dispatcher learns the cutover: it keeps a smoothed cost
+ * per message for each backend in power-of-two batch-size buckets and
+ * sends a batch to whichever is cheaper for its bucket. CPU cost is the
+ * measured parse time; GPU cost is the measured stage-submit-collect
+ * time, with the device share taken from GpuParser::get_metrics().
+ *
+ * Batches of at most ParserConfig::batch_size messages always stay on the
+ * CPU. Larger buckets try each backend once, then every probe_interval-th
+ * batch goes to the backend that is currently losing so its estimate
+ * follows contention or thermal changes.
+ *
+ * GpuParser needs stage(), submit(), collect(ticks, wait) and
+ * get_metrics() as in gpu::CUDAFixParser; tests substitute a fake. With
+ * no GPU parser every batch runs on the CPU.
+ *
+ * Not thread-safe: one dispatcher per parsing thread.
+ */
+template<typename GpuParser = gpu::CUDAFixParser>
+class HybridFixParser {
+public:
+    enum class Backend {
+        CPU,
+        GPU
+    };
+
+    struct Config {
+        double cost_smoothing = 0.2;   // Weight of a new ns-per-message sample
+        size_t probe_interval = 64;    // Re-measure the losing backend every N batches of a bucket
+    };
+
+    struct Stats {
+        uint64_t cpu_batches = 0;
+        uint64_t gpu_batches = 0;
+        uint64_t cpu_messages = 0;
+        uint64_t gpu_messages = 0;
+        double gpu_device_ms = 0.0;    // Device time of GPU batches, from get_metrics()
+    };
+
+    /**
+     * @param parser_config SIMD level for the CPU parser; batch_size is the
+     *        largest batch that always stays on the CPU
+     * @param gpu GPU parser, not owned (nullptr for CPU only)
+     */
+    HybridFixParser(const config::PerformanceConfig::ParserConfig& parser_config, GpuParser* gpu)
+        : HybridFixParser(parser_config, gpu, Config()) {}
+
+    HybridFixParser(const config::PerformanceConfig::ParserConfig& parser_config, GpuParser* gpu,
+                    const Config& config)
+        : cpu_(parser_config)
+        , gpu_(gpu)
+        , config_(config)
+        , cpu_batch_limit_(parser_config.batch_size) {}
+
+    /**
+     * @brief Parse count complete messages on the backend chosen for count
+     * @return Ticks appended
+     */
+    size_t parse_batch(const std::string_view* messages, size_t count, std::vector<common::CompactTick>& ticks) {
+        if (count == 0) {
+            return 0;
+        }
+        Backend backend = route(count);
+        size_t before = ticks.size();
+        auto start = std::chrono::steady_clock::now();
+
+        if (backend == Backend::CPU) {
+            for (size_t i = 0; i < count; ++i) {
+                cpu_.parse(messages[i].data(), messages[i].size(), ticks);
+            }
+        } else {
+            double device_ms = gpu_->get_metrics().kernel_execution_time_ms;
+            for (size_t i = 0; i < count; ++i) {
+                gpu_->stage(messages[i].data(), messages[i].size());
+            }
+            gpu_->submit();
+            gpu_->collect(ticks, true);
+            stats_.gpu_device_ms += gpu_->get_metrics().kernel_execution_time_ms - device_ms;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        record(backend, count, static_cast<double>(elapsed.count()));
+        return ticks.size() - before;
+    }
+
+    size_t parse_batch(const std::vector<std::string_view>& messages, std::vector<common::CompactTick>& ticks) {
+        return parse_batch(messages.data(), messages.size(), ticks);
+    }
+
+    /**
+     * @brief Backend the next batch of count messages would run on
+     */
+    Backend route(size_t count) const {
+        if (!gpu_ || count <= cpu_batch_limit_) {
+            return Backend::CPU;
+        }
+        const Bucket& bucket = buckets_[bucket_of(count)];
+        if (bucket.cpu_ns_per_message < 0.0) {
+            return Backend::CPU;
+        }
+        if (bucket.gpu_ns_per_message < 0.0) {
+            return Backend::GPU;
+        }
+        Backend faster = bucket.gpu_ns_per_message < bucket.cpu_ns_per_message ? Backend::GPU : Backend::CPU;
+        bool probe = config_.probe_interval > 0 && bucket.batches % config_.probe_interval == config_.probe_interval - 1;
+        return probe ? (faster == Backend::GPU ? Backend::CPU : Backend::GPU) : faster;
+    }
+
+    /**
+     * @brief Smallest batch size whose bucket currently favours the GPU
+     * @return SIZE_MAX if none does (yet)
+     */
+    size_t cutover() const {
+        if (!gpu_) {
+            return std::numeric_limits<size_t>::max();
+        }
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            const Bucket& bucket = buckets_[b];
+            size_t smallest = size_t{1} << b;
+            size_t largest = b + 1 < BUCKETS ? 2 * smallest - 1 : std::numeric_limits<size_t>::max();
+            if (largest > cpu_batch_limit_ && bucket.cpu_ns_per_message >= 0.0 && bucket.gpu_ns_per_message >= 0.0 &&
+                bucket.gpu_ns_per_message < bucket.cpu_ns_per_message) {
+                return std::max(smallest, cpu_batch_limit_ + 1);
+            }
+        }
+        return std::numeric_limits<size_t>::max();
+    }
+
+    /**
+     * @brief Smoothed cost of a backend for batches of count messages (-1 if unmeasured)
+     */
+    double cost_per_message(Backend backend, size_t count) const {
+        const Bucket& bucket = buckets_[bucket_of(count)];
+        return backend == Backend::CPU ? bucket.cpu_ns_per_message : bucket.gpu_ns_per_message;
+    }
+
+    const Stats& stats() const { return stats_; }
+    SIMDFixParser& cpu_parser() { return cpu_; }
+
+private:
+    static constexpr size_t BUCKETS = 32;  // floor(log2(count)), capped
+
+    struct Bucket {
+        double cpu_ns_per_message = -1.0;
+        double gpu_ns_per_message = -1.0;
+        uint64_t batches = 0;
+    };
+
+    static size_t bucket_of(size_t count) {
+        size_t b = count > 1 ? 63 - static_cast<size_t>(__builtin_clzll(count)) : 0;
+        return b < BUCKETS ? b : BUCKETS - 1;
+    }
+
+    void record(Backend backend, size_t count, double elapsed_ns) {
+        Bucket& bucket = buckets_[bucket_of(count)];
+        double sample = elapsed_ns / static_cast<double>(count);
+        double& cost = backend == Backend::CPU ? bucket.cpu_ns_per_message : bucket.gpu_ns_per_message;
+        cost = cost < 0.0 ? sample : cost + config_.cost_smoothing * (sample - cost);
+        bucket.batches++;
+
+        if (backend == Backend::CPU) {
+            stats_.cpu_batches++;
+            stats_.cpu_messages += count;
+        } else {
+            stats_.gpu_batches++;
+            stats_.gpu_messages += count;
+        }
+    }
+
+    SIMDFixParser cpu_;
+    GpuParser* gpu_;
+    Config config_;
+    size_t cpu_batch_limit_;
+    std::array<Bucket, BUCKETS> buckets_{};
+    Stats stats_;
+};
+
+} // namespace parser
+} // namespace feedhandler
@@ -28,6 +28,13 @@ public:
      */
     static common::Tick parse_message(const std::string& message);
     
+    /**
+     * @brief Parse a single FIX message into a packed tick
+     * @param message FIX message string
+     * @return Parsed tick, or invalid tick if parsing fails
+     */
+    static common::CompactTick parse_message_compact(const std::string& message);
+    
     /**
      * @brief Parse multiple FIX messages
      * @param messages Vector of FIX message strings
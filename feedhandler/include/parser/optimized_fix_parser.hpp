@@ -3,6 +3,8 @@
 #include <string_view>
 #include <vector>
 #include "common/tick.hpp"
+#include "common/tick_span.hpp"
+#include "parser/fix_schema.hpp"
 
 namespace feedhandler {
 namespace parser {
@@ -17,6 +19,8 @@ namespace parser {
  * - Zero heap allocations during parsing
  * - Fast custom number parsing (no std::stoi/stod)
  * - Optimized for FIX protocol field parsing
+ * - Compile-time FixSchema: perfect-hash tag dispatch, stops scanning
+ *   once 55/44/38/54 are all seen
  * - Expected 20-30% improvement over string_view parser
  */
 class OptimizedFixParser {
@@ -38,38 +42,49 @@ public:
     static std::vector<common::Tick> parse_messages_from_buffer(std::string_view buffer);
     
     /**
-     * @brief Benchmark parsing performance
-     * @param message_count Number of messages to parse
-     * @return Parsing time in microseconds
+     * @brief Parse a single FIX message into a packed 32-byte tick
+     * @param message FIX message string_view
+     * @return Parsed tick (symbol interned as instrument ID), invalid on failure
      */
-    static uint64_t benchmark_parsing(size_t message_count);
-
-private:
+    static common::CompactTick parse_message_compact(std::string_view message);
+    
     /**
-     * @brief Field storage for tag-value pairs
+     * @brief Parse multiple FIX messages into packed ticks
+     * @param buffer Buffer containing multiple messages separated by newlines
+     * @param ticks Output vector (appended to)
+     * @return Number of ticks appended
      */
-    struct Field {
-        int tag;
-        std::string_view value;
-    };
+    static size_t parse_messages_from_buffer(std::string_view buffer,
+                                             std::vector<common::CompactTick>& ticks);
     
     /**
-     * @brief Extract tag-value pairs from FIX message using optimized parsing
-     * @param message FIX message string_view
-     * @param fields Output array for fields (must be large enough)
-     * @param max_fields Maximum number of fields to extract
-     * @return Number of fields extracted
+     * @brief Parse multiple FIX messages into caller-owned fixed-capacity storage
+     * @param buffer Buffer containing multiple messages separated by newlines
+     * @param ticks Output span; parsing stops once it is full
+     * @return Number of ticks written
+     * @warning For Tick output the input buffer must outlive the written ticks
      */
-    static size_t extract_fields_optimized(std::string_view message, Field* fields, size_t max_fields);
+    static size_t parse_messages_from_buffer(std::string_view buffer,
+                                             common::TickSpan<common::Tick>& ticks);
+    static size_t parse_messages_from_buffer(std::string_view buffer,
+                                             common::TickSpan<common::CompactTick>& ticks);
     
     /**
-     * @brief Find field by tag in the fields array (optimized)
-     * @param fields Array of fields
-     * @param field_count Number of fields in array
-     * @param tag Tag to search for
-     * @return Pointer to field if found, nullptr otherwise
+     * @brief Benchmark parsing performance
+     * @param message_count Number of messages to parse
+     * @return Parsing time in microseconds
+     */
+    static uint64_t benchmark_parsing(size_t message_count);
+
+    /**
+     * @brief Fields extracted into each tick (symbol, price, quantity, side)
      */
-    static const Field* find_field_fast(const Field* fields, size_t field_count, int tag);
+    template<typename TickT>
+    using TickSchema = FixSchema<TickT,
+        FixField<55, fields::Symbol>,
+        FixField<44, fields::Price>,
+        FixField<38, fields::Quantity>,
+        FixField<54, fields::Side>>;
 };
 
 } // namespace parser
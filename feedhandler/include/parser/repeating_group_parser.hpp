@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <string_view>
 #include <vector>
 #include "common/tick.hpp"
+#include "common/tick_span.hpp"
+#include "parser/fast_number_parser.hpp"
 
 namespace feedhandler {
 namespace parser {
@@ -18,9 +21,56 @@ namespace parser {
  *   8=FIX.4.4|268=3|269=0|270=100.50|271=1000|269=0|270=100.25|271=500|269=1|270=100.75|271=750|
  *   
  * This would be parsed into 3 separate Tick objects.
+ *
+ * Messages are scanned once, field by field: every occurrence of the
+ * group's first tag (279 MDUpdateAction for incremental refreshes, 269
+ * MDEntryType for snapshots) closes the previous entry and opens the next,
+ * which is emitted straight into the output. Nothing is buffered, so the
+ * cost is linear in the message length whatever the entry count. Fields of
+ * groups nested inside an entry (e.g. 453 NoPartyIDs) are skipped without
+ * splitting the entry. Fields are delimited by SOH or '|'.
  */
 class RepeatingGroupParser {
 public:
+    /**
+     * @brief One MDEntry of a market data group
+     *
+     * symbol is the entry's own 55 (incremental refresh) or the message
+     * level 55 (snapshot) and points into the input buffer.
+     */
+    struct MDEntry {
+        std::string_view symbol;
+        common::InstrumentId instrument_id = common::INVALID_INSTRUMENT;
+        int64_t price = 0;           ///< 270 MDEntryPx, fixed-point
+        int32_t size = 0;            ///< 271 MDEntrySize
+        char update_action = '\0';   ///< 279 MDUpdateAction ('0' new, '1' change, '2' delete)
+        char entry_type = '\0';      ///< 269 MDEntryType ('0' bid, '1' offer, '2' trade, ...)
+    };
+    
+    /**
+     * @brief Emit every MDEntry of a message into caller-owned storage
+     * @param message FIX message string_view (35=W or 35=X)
+     * @param entries Output span; scanning stops once it is full
+     * @return Number of entries written
+     * @warning Entry symbols point into message
+     */
+    static size_t parse_entries(std::string_view message, common::TickSpan<MDEntry>& entries);
+    
+    /**
+     * @brief Call visit(const MDEntry&) for every entry as the message is scanned
+     * @param message FIX message string_view
+     * @param visit Returns false to stop scanning
+     * @return true if the message carried a repeating group
+     *
+     * Lets downstream stages consume entries without any output storage.
+     */
+    template<typename Visitor>
+    static bool for_each_entry(std::string_view message, Visitor&& visit) {
+        MessageFields fields;
+        scan_message(message, fields, visit);
+        return fields.grouped;
+    }
+    
     /**
      * @brief Parse a FIX message with repeating groups into multiple Ticks
      * @param message FIX message string_view
@@ -29,13 +79,34 @@ public:
      * 
      * Repeating group format:
      * - Tag 268: NoMDEntries (number of repeating groups)
+     * - Tag 279: MDUpdateAction (incremental refresh only, starts the entry)
      * - Tag 269: MDEntryType (0=Bid, 1=Offer, 2=Trade)
      * - Tag 270: MDEntryPx (price)
      * - Tag 271: MDEntrySize (quantity)
-     * - Tag 55: Symbol (shared across all entries)
+     * - Tag 55: Symbol (shared across all entries unless repeated per entry)
      */
     static std::vector<common::Tick> parse_repeating_groups(std::string_view message);
     
+    /**
+     * @brief Parse a FIX message with repeating groups into packed ticks
+     * @param message FIX message string_view
+     * @param ticks Output vector; ticks are appended
+     * @return Number of ticks appended
+     */
+    static size_t parse_repeating_groups(std::string_view message,
+                                         std::vector<common::CompactTick>& ticks);
+    
+    /**
+     * @brief Parse a FIX message with repeating groups into caller-owned storage
+     * @param message FIX message string_view
+     * @param ticks Output span; entries past its capacity are dropped
+     * @return Number of ticks written
+     */
+    static size_t parse_repeating_groups(std::string_view message,
+                                         common::TickSpan<common::Tick>& ticks);
+    static size_t parse_repeating_groups(std::string_view message,
+                                         common::TickSpan<common::CompactTick>& ticks);
+    
     /**
      * @brief Parse multiple messages with repeating groups from a buffer
      * @param buffer Buffer containing multiple messages separated by newlines
@@ -43,6 +114,17 @@ public:
      */
     static std::vector<common::Tick> parse_buffer_with_repeating_groups(std::string_view buffer);
     
+    /**
+     * @brief Parse a buffer of repeating-group messages into caller-owned storage
+     * @param buffer Buffer containing multiple messages separated by newlines
+     * @param ticks Output span; parsing stops once it is full
+     * @return Number of ticks written
+     */
+    static size_t parse_buffer_with_repeating_groups(std::string_view buffer,
+                                                     common::TickSpan<common::Tick>& ticks);
+    static size_t parse_buffer_with_repeating_groups(std::string_view buffer,
+                                                     common::TickSpan<common::CompactTick>& ticks);
+    
     /**
      * @brief Benchmark parsing performance with repeating groups
      * @param message_count Number of messages to parse
@@ -53,43 +135,170 @@ public:
 
 private:
     /**
-     * @brief Field storage for tag-value pairs
+     * @brief Message-level fields seen outside any repeating group
      */
-    struct Field {
-        int tag;
-        std::string_view value;
+    struct MessageFields {
+        std::string_view symbol;   // 55
+        int64_t price = 0;         // 44, else 270
+        int32_t qty = 0;           // 38, else 271
+        char side = '\0';          // 54
+        bool grouped = false;      // 268, or a group field without one
     };
     
     /**
-     * @brief Extract all fields from message
-     * @param message FIX message string_view
-     * @param fields Output array for fields
-     * @param max_fields Maximum number of fields
-     * @return Number of fields extracted
+     * @brief Single pass over message, calling visit per entry
+     *
+     * The first 279 or 269 after 268 (or without it) fixes the group's
+     * delimiter tag; each later occurrence closes the open entry. Tags the
+     * entry does not use, including whole nested groups, are skipped.
      */
-    static size_t extract_all_fields(std::string_view message, Field* fields, size_t max_fields);
+    template<typename Visitor>
+    static void scan_message(std::string_view message, MessageFields& fields, Visitor& visit);
     
     /**
-     * @brief Find all occurrences of a tag in the fields array
-     * @param fields Array of fields
-     * @param field_count Number of fields in array
-     * @param tag Tag to search for
-     * @param indices Output array for field indices
-     * @param max_indices Maximum number of indices to store
-     * @return Number of occurrences found
+     * @brief Shared body of the parse_repeating_groups overloads
      */
-    static size_t find_all_fields(const Field* fields, size_t field_count, int tag, 
-                                   size_t* indices, size_t max_indices);
+    template<typename Out>
+    static size_t parse_into(std::string_view message, Out& ticks);
     
     /**
-     * @brief Find first occurrence of a tag
-     * @param fields Array of fields
-     * @param field_count Number of fields in array
-     * @param tag Tag to search for
-     * @return Pointer to field if found, nullptr otherwise
+     * @brief Shared body of the parse_buffer_with_repeating_groups overloads
      */
-    static const Field* find_first_field(const Field* fields, size_t field_count, int tag);
+    template<typename Out>
+    static size_t parse_buffer_into(std::string_view buffer, Out& ticks);
 };
 
+template<typename Visitor>
+void RepeatingGroupParser::scan_message(std::string_view message, MessageFields& fields, Visitor& visit) {
+    MDEntry entry;
+    bool entry_open = false;
+    bool in_group = false;
+    bool price_from_44 = false;
+    bool qty_from_38 = false;
+    uint32_t delimiter_tag = 0;
+    
+    // Entries usually repeat one symbol: intern it once
+    std::string_view interned_symbol;
+    common::InstrumentId interned_id = common::INVALID_INSTRUMENT;
+    
+    auto close_entry = [&]() {
+        if (!entry_open) {
+            return true;
+        }
+        entry_open = false;
+        if (entry.symbol != interned_symbol || interned_id == common::INVALID_INSTRUMENT) {
+            interned_symbol = entry.symbol;
+            interned_id = common::SymbolTable::global().intern(entry.symbol);
+        }
+        entry.instrument_id = interned_id;
+        return static_cast<bool>(visit(static_cast<const MDEntry&>(entry)));
+    };
+    
+    const char* ptr = message.data();
+    const char* end = ptr + message.size();
+    
+    while (ptr < end) {
+        const char* tag_start = ptr;
+        uint32_t tag = 0;
+        while (ptr < end && static_cast<unsigned char>(*ptr - '0') <= 9) {
+            tag = tag * 10 + static_cast<uint32_t>(*ptr - '0');
+            ++ptr;
+        }
+        bool has_tag = ptr < end && *ptr == '=' && ptr > tag_start;
+        
+        const char* value_start = has_tag ? ptr + 1 : ptr;
+        const char* delim = value_start;
+        while (delim < end && *delim != '|' && *delim != '\x01') {
+            ++delim;
+        }
+        ptr = delim + 1;
+        if (!has_tag) {
+            continue;
+        }
+        std::string_view value(value_start, static_cast<size_t>(delim - value_start));
+        
+        if (tag == 10) {
+            break;  // CheckSum: end of message
+        }
+        
+        if (!in_group) {
+            switch (tag) {
+                case 55:
+                    fields.symbol = value;
+                    continue;
+                case 268:
+                    in_group = true;
+                    fields.grouped = true;
+                    continue;
+                case 279:
+                case 269:
+                    in_group = true;  // Group without a NoMDEntries count
+                    fields.grouped = true;
+                    break;
+                case 44:
+                    fields.price = FastNumberParser::fast_atof_fixed(value);
+                    price_from_44 = true;
+                    continue;
+                case 270:
+                    if (!price_from_44) {
+                        fields.price = FastNumberParser::fast_atof_fixed(value);
+                    }
+                    continue;
+                case 38:
+                    fields.qty = FastNumberParser::fast_atoi(value);
+                    qty_from_38 = true;
+                    continue;
+                case 271:
+                    if (!qty_from_38) {
+                        fields.qty = FastNumberParser::fast_atoi(value);
+                    }
+                    continue;
+                case 54:
+                    fields.side = common::fix_side_to_char(FastNumberParser::fast_atoi(value));
+                    continue;
+                default:
+                    continue;
+            }
+        }
+        
+        if (delimiter_tag == 0 && (tag == 279 || tag == 269)) {
+            delimiter_tag = tag;
+        }
+        if (delimiter_tag != 0 && tag == delimiter_tag) {
+            if (!close_entry()) {
+                return;
+            }
+            entry = MDEntry{};
+            entry.symbol = fields.symbol;
+            entry_open = true;
+        }
+        if (!entry_open) {
+            continue;
+        }
+        
+        switch (tag) {
+            case 279:
+                entry.update_action = value.empty() ? '\0' : value[0];
+                break;
+            case 269:
+                entry.entry_type = value.empty() ? '\0' : value[0];
+                break;
+            case 270:
+                entry.price = FastNumberParser::fast_atof_fixed(value);
+                break;
+            case 271:
+                entry.size = FastNumberParser::fast_atoi(value);
+                break;
+            case 55:
+                entry.symbol = value;
+                break;
+            default:
+                break;  // Other entry fields and nested groups
+        }
+    }
+    
+    close_entry();
+}
+
 } // namespace parser
 } // namespace feedhandler
\ No newline at end of file
@@ -1,43 +1,135 @@
 #pragma once
 
-#ifdef __ARM_NEON
-#include <arm_neon.h>
-#else
-#include <immintrin.h>
-#endif
-
+#include <cstdint>
 #include <string_view>
 #include <vector>
 #include "common/tick.hpp"
+#include "common/tick_batch.hpp"
+#include "common/tick_span.hpp"
+#include "config/performance_config.hpp"
+#include "parser/fix_framer.hpp"
 
 namespace feedhandler {
 namespace parser {
 
+/**
+ * @brief Instruction set used by the SIMD delimiter scanning kernels
+ *
+ * Ordered so that on x86 a higher value implies every lower one.
+ */
+enum class SimdLevel {
+    SCALAR,
+    SSE42,
+    AVX2,
+    AVX512BW,
+    NEON
+};
+
+/**
+ * @brief Structural bits of one 64-byte block (bit i = byte i)
+ */
+struct BlockMasks {
+    uint64_t equals;      ///< '=' tag/value separators
+    uint64_t delimiters;  ///< Field delimiters: SOH or '|'
+};
+
 /**
  * @brief SIMD-optimized FIX parser using platform-specific instructions
  * 
  * This parser uses vectorized operations to process multiple characters
  * simultaneously, achieving 10x+ performance over scalar implementations.
  * 
+ * The delimiter scanning kernel is picked at construction time from the
+ * instruction sets the running CPU reports (cpuid on x86), so a single
+ * binary uses AVX-512BW on Ice Lake, AVX2 on Skylake and NEON on
+ * Graviton. Kernels are compiled per target with function attributes;
+ * the rest of the translation unit only assumes the baseline ISA.
+ *
  * Key optimizations:
- * - ARM NEON (ARM64) or AVX2 (x86_64) vectorized delimiter scanning
+ * - SSE4.2 / AVX2 / AVX-512BW (x86_64) or NEON (ARM64) delimiter scanning
+ * - Structural index of '=' and SOH/'|' bitmasks per 64-byte block,
+ *   walked with tzcnt so fields are extracted without position vectors
+ * - Resumable across parse() calls: an unfinished field is carried over
+ *   already indexed and the partially built tick is kept, so fragmented
+ *   TCP reads parse like FSMFixParser and only new bytes are scanned
+ * - Optional BodyLength/CheckSum validation: FixFramer jumps from tag 9
+ *   straight to the trailer, so only whole, verified messages are indexed
  * - SIMD string-to-integer conversion
  * - Parallel field extraction
  * - Cache-optimized data layout
  */
 class SIMDFixParser {
 public:
+    /**
+     * @brief Use the best kernel the CPU supports
+     */
     SIMDFixParser();
     
+    /**
+     * @brief Use the kernel requested by the configuration
+     * @param config enable_simd and simd_instruction_set ("SSE4.2",
+     *        "AVX2", "AVX512", "NEON", "SCALAR"); capped at what the CPU
+     *        supports, an unknown name selects the best available
+     */
+    explicit SIMDFixParser(const config::PerformanceConfig::ParserConfig& config);
+    
+    /**
+     * @brief Use a specific kernel (capped at what the CPU supports)
+     */
+    explicit SIMDFixParser(SimdLevel level);
+    
     /**
      * @brief Parse FIX messages using SIMD instructions
      * @param buffer Input buffer containing FIX messages
      * @param length Buffer length
      * @param ticks Output vector for parsed ticks
      * @return Number of bytes consumed
+     * 
+     * Can be called repeatedly with fragmented data: bytes of an
+     * incomplete message count as consumed and are completed by the next
+     * call. Only a full TickSpan makes this return less than length; the
+     * caller passes the remainder again.
      */
     size_t parse(const char* buffer, size_t length, std::vector<common::Tick>& ticks);
     
+    /**
+     * @brief Parse FIX messages into packed ticks
+     * @param buffer Input buffer containing FIX messages
+     * @param length Buffer length
+     * @param ticks Output vector for parsed ticks
+     * @return Number of bytes consumed
+     */
+    size_t parse(const char* buffer, size_t length, std::vector<common::CompactTick>& ticks);
+    
+    /**
+     * @brief Parse FIX messages into caller-owned fixed-capacity storage
+     * @param buffer Input buffer containing FIX messages
+     * @param length Buffer length
+     * @param ticks Output span; parsing stops once it is full
+     * @return Number of bytes consumed
+     */
+    size_t parse(const char* buffer, size_t length, common::TickSpan<common::Tick>& ticks);
+    size_t parse(const char* buffer, size_t length, common::TickSpan<common::CompactTick>& ticks);
+    
+    /**
+     * @brief Parse FIX messages into a structure-of-arrays TickBatch
+     * 
+     * Same stop-when-full semantics as the TickSpan overloads.
+     */
+    size_t parse(const char* buffer, size_t length, common::TickBatch& ticks);
+    
+    /**
+     * @brief Extract one complete message where it lies
+     * 
+     * For callers that framed the message themselves (FixFramer::frame()
+     * returned COMPLETE): nothing is copied into the streaming buffer and
+     * the state of parse() is left as it is.
+     * @param message Bytes from "8=" through the delimiter after CheckSum
+     * @param length Frame length
+     * @param ticks One tick is appended
+     */
+    void parse_complete(const char* message, size_t length, std::vector<common::Tick>& ticks);
+    
     /**
      * @brief Benchmark SIMD parser performance
      * @param message_count Number of messages to parse
@@ -45,7 +137,63 @@ public:
      */
     static uint64_t benchmark_parsing(size_t message_count);
     
+    /**
+     * @brief Drop any partially received message
+     */
     void reset();
+    
+    /**
+     * @brief Frame messages by BodyLength (9) and verify CheckSum (10)
+     *
+     * Off by default. When on, messages with a wrong BodyLength or
+     * CheckSum are dropped and the parser resynchronizes at the next
+     * "8=FIX"; bytes between messages are skipped. Resets parser state.
+     */
+    void set_validation(bool enable);
+    bool is_validation_enabled() const { return validation_enabled_; }
+    
+    /**
+     * @brief Statistics of validating mode
+     */
+    struct ValidationStats {
+        size_t messages_validated;   // Messages that passed framing and checksum
+        size_t body_length_errors;   // Trailer not where BodyLength pointed
+        size_t checksum_errors;      // CheckSum mismatch
+        size_t bytes_skipped;        // Bytes dropped while resynchronizing
+        
+        ValidationStats() : messages_validated(0), body_length_errors(0), checksum_errors(0), bytes_skipped(0) {}
+    };
+    
+    const ValidationStats& get_validation_stats() const { return validation_stats_; }
+    void reset_validation_stats() { validation_stats_ = ValidationStats(); }
+    
+    /**
+     * @brief Check if parser is currently in the middle of a message
+     */
+    bool is_parsing() const { return buffer_pos_ > 0 || message_open_; }
+    
+    /**
+     * @brief Kernel selected for this parser
+     */
+    SimdLevel simd_level() const { return simd_level_; }
+    
+    /**
+     * @brief Best kernel the running CPU supports (detected once)
+     */
+    static SimdLevel detect_simd_level();
+    
+    /**
+     * @brief Highest supported level not above the requested one
+     */
+    static SimdLevel supported_simd_level(SimdLevel requested);
+    
+    /**
+     * @brief Map a configuration name to a level
+     * @return Requested level, or detect_simd_level() for unknown names
+     */
+    static SimdLevel parse_simd_level(std::string_view name);
+    
+    static const char* simd_level_name(SimdLevel level);
 
     /**
      * @brief Find delimiters using SIMD vectorized search
@@ -53,9 +201,32 @@ public:
      * @param length Data length
      * @param delimiter Character to find ('|' or '=')
      * @return Positions of delimiters
+     * @note Allocates; use for_each_delimiter() on hot paths
      */
     std::vector<size_t> find_delimiters_simd(const char* data, size_t length, char delimiter);
     
+    /**
+     * @brief Call visit(position) for every delimiter, in order, without allocating
+     * @param data Input data to search
+     * @param length Data length
+     * @param delimiter Character to find
+     */
+    template<typename Visitor>
+    void for_each_delimiter(const char* data, size_t length, char delimiter, Visitor&& visit) const {
+        size_t i = 0;
+        // One 64-byte block per kernel call, positions read off the bitmask
+        for (; i + BLOCK_SIZE <= length; i += BLOCK_SIZE) {
+            for (uint64_t mask = block_mask_(data + i, delimiter); mask != 0; mask &= mask - 1) {
+                visit(i + static_cast<size_t>(__builtin_ctzll(mask)));
+            }
+        }
+        for (; i < length; ++i) {
+            if (data[i] == delimiter) {
+                visit(i);
+            }
+        }
+    }
+    
     /**
      * @brief Convert string to integer using SIMD
      * @param str String view to convert
@@ -71,6 +242,36 @@ public:
     double simd_atof(std::string_view str);
     
 private:
+    /**
+     * @brief Shared body of the parse overloads
+     */
+    template<typename Out>
+    size_t parse_into(const char* buffer, size_t length, Out& ticks);
+    
+    /**
+     * @brief Validating parse: whole framed messages only
+     */
+    template<typename Out>
+    size_t parse_framed(const char* buffer, size_t length, Out& ticks);
+    
+    /**
+     * @brief Index and extract one complete, framed message
+     */
+    template<typename Out>
+    void parse_message(const char* message, size_t length, Out& ticks);
+    
+    /**
+     * @brief Store a non-trailer field into the tick under construction
+     */
+    template<typename T>
+    void apply_field(T& tick, int tag, std::string_view value);
+    
+    /**
+     * @brief Tick under construction for an output type
+     */
+    template<typename T>
+    T& pending_tick();
+    
     /**
      * @brief Parse timestamp using SIMD
      * @param timestamp_str Timestamp string to parse
@@ -85,16 +286,32 @@ private:
      */
     int64_t simd_atof_fixed(std::string_view str);
     
-    // SIMD constants
-#ifdef __ARM_NEON
-    static constexpr size_t SIMD_WIDTH = 16; // NEON processes 16 bytes at once
-#else
-    static constexpr size_t SIMD_WIDTH = 32; // AVX2 processes 32 bytes at once
-#endif
+    // Bitmask of bytes equal to delimiter in one BLOCK_SIZE block
+    using BlockMaskFn = uint64_t (*)(const char* block, char delimiter);
+    // '=' and SOH/'|' masks of one BLOCK_SIZE block in a single pass
+    using ClassifyFn = BlockMasks (*)(const char* block);
+    
+    static constexpr size_t BLOCK_SIZE = 64; // One 64-bit mask per block
+    static constexpr size_t BUFFER_SIZE = 4096; // Whole blocks, so kernels never read past it
+    
+    // Kernel dispatch
+    SimdLevel simd_level_;
+    BlockMaskFn block_mask_;
+    ClassifyFn classify_;
+    
+    static constexpr size_t NO_EQUALS = static_cast<size_t>(-1);
+    
+    // Parser state; processing_buffer_ holds the unfinished field at its start
+    alignas(64) char processing_buffer_[BUFFER_SIZE];
+    BlockMasks structural_[BUFFER_SIZE / BLOCK_SIZE]; // Reused structural index
+    size_t buffer_pos_;    // Bytes carried over (already indexed and walked)
+    size_t carry_equals_;  // '=' offset in the carried field, NO_EQUALS if none yet
+    bool message_open_;    // Fields applied since the last checksum
+    common::Tick pending_tick_;
+    common::CompactTick pending_compact_;
     
-    // Parser state
-    alignas(32) char processing_buffer_[4096];
-    size_t buffer_pos_;
+    bool validation_enabled_;
+    ValidationStats validation_stats_;
 };
 
 } // namespace parser
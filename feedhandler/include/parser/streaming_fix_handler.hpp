@@ -1,9 +1,14 @@
 #pragma once
 
+#include <memory>
 #include <vector>
+#include "parser/fix_framer.hpp"
 #include "parser/fsm_fix_parser.hpp"
+#include "parser/simd_fix_parser.hpp"
+#include "parser/symbol_filter.hpp"
 #include "net/receive_buffer.hpp"
 #include "common/tick.hpp"
+#include "common/latency_histogram.hpp"
 
 namespace feedhandler {
 namespace parser {
@@ -21,29 +26,43 @@ namespace parser {
  * 2. Call process_buffer() to parse available data
  * 3. Parser maintains state if message is incomplete
  * 4. Next recv() continues from where it left off
+ * 
+ * Parser is any resumable FIX parser with parse(data, length, ticks)
+ * returning bytes consumed, is_parsing() and reset(): FSMFixParser
+ * (StreamingFixHandler) or SIMDFixParser (SimdStreamingFixHandler).
+ * Both are instantiated in streaming_fix_handler.cpp.
+ * 
+ * With set_framing(), complete messages skip the resumable parser: most
+ * reads hold many whole messages and only the last one is cut off.
  */
-class StreamingFixHandler {
+template<typename Parser>
+class BasicStreamingFixHandler {
 public:
     /**
      * @brief Constructor
+     * @param buffer_config Receive buffer size and layout; use
+     *        ReceiveBufferMode::MIRRORED to avoid compaction memmoves
      */
-    StreamingFixHandler();
+    explicit BasicStreamingFixHandler(const net::ReceiveBufferConfig& buffer_config = net::ReceiveBufferConfig());
     
     /**
      * @brief Process incoming data from socket
      * @param data Raw bytes from recv()
      * @param length Number of bytes received
      * @param ticks Output vector for completed ticks
+     * @param timestamp_ns Receive time of data (ns since epoch, 0 if unknown);
+     *        FSMFixParser stamps the ticks it completes with it
      * @return Number of ticks parsed
      * 
      * This function:
      * 1. Writes data to receive buffer
-     * 2. Parses available data with FSM parser
+     * 2. Parses available data with the parser
      * 3. Consumes parsed bytes from buffer
      * 4. Maintains parser state for incomplete messages
      */
     size_t process_incoming_data(const char* data, size_t length, 
-                                  std::vector<common::Tick>& ticks);
+                                  std::vector<common::Tick>& ticks,
+                                  uint64_t timestamp_ns = 0);
     
     /**
      * @brief Process data already in the buffer
@@ -52,6 +71,57 @@ public:
      */
     size_t process_buffer(std::vector<common::Tick>& ticks);
     
+    /**
+     * @brief Receive buffer for in-place socket reads
+     * 
+     * Lets the caller recv() straight into the handler's buffer, e.g.
+     * with TcpClient::recv_into(), instead of passing a copy to
+     * process_incoming_data(). Follow up with process_received(); the
+     * receive timestamp recv_into() stores in the buffer is carried into
+     * the ticks.
+     */
+    net::ReceiveBuffer& receive_buffer() { return buffer_; }
+    
+    /**
+     * @brief Parse bytes written in place into receive_buffer()
+     * @param length Number of bytes the caller wrote into the buffer
+     * @param ticks Output vector for completed ticks
+     * @return Number of ticks parsed
+     */
+    size_t process_received(size_t length, std::vector<common::Tick>& ticks);
+    
+    /**
+     * @brief Frame complete messages and extract them in place
+     * 
+     * Off by default. When on, every whole message at the front of the
+     * buffer (FixFramer::frame(), BodyLength trusted, CheckSum not
+     * checked) goes to SIMDFixParser::parse_complete() where it lies,
+     * without the resumable parser's per-byte state machine or copy.
+     * A trailing partial message stays in the buffer until the read that
+     * completes it. Bytes the framer cannot frame (junk, a BodyLength
+     * that does not match the trailer, a fragment over half the buffer)
+     * go to the resumable parser as before, until a trailer ends the
+     * message it holds.
+     * 
+     * Framed ticks are stamped with the buffer's receive timestamp, or
+     * one clock read per call without one. Messages without symbol or
+     * side (heartbeats, admin messages) yield no tick.
+     */
+    void set_framing(bool enable);
+    bool is_framing_enabled() const { return framing_; }
+    
+    /**
+     * @brief Emit ticks only for the symbols in filter (nullptr: all)
+     * 
+     * With framing on, the filter is applied before parsing: the Symbol
+     * field of each framed message is found with FixFramer::find_symbol()
+     * and an unsubscribed message is skipped whole, never tokenized.
+     * Messages without tag 55 are parsed as usual. Ticks from the
+     * resumable parser (framing off, or its fallback) are filtered after
+     * parsing. The filter is not copied and must outlive its use here.
+     */
+    void set_symbol_filter(const SymbolFilter* filter) { filter_ = filter; }
+    
     /**
      * @brief Check if handler is currently parsing a message
      */
@@ -75,15 +145,54 @@ public:
         uint64_t total_messages_parsed;
         uint64_t total_parse_calls;
         uint64_t buffer_compactions;
+        uint64_t framed_messages;    // Whole messages extracted in place (set_framing)
+        uint64_t filtered_messages;  // Skipped or dropped by the symbol filter
     };
     
     const Stats& get_stats() const { return stats_; }
     
+    /**
+     * @brief Time spent in the parser per process_buffer() call
+     * 
+     * Recorded on the calling thread; snapshot() from any thread.
+     */
+    const common::AtomicLatencyHistogram& parse_latency() const { return parse_latency_; }
+    
+    /**
+     * @brief Enable/disable parse_latency() recording
+     *        (MonitoringConfig::enable_latency_tracking, on by default)
+     */
+    void set_latency_tracking(bool enable) { latency_tracking_ = enable; }
+    
 private:
-    FSMFixParser parser_;
+    Parser parser_;
     net::ReceiveBuffer buffer_;
     Stats stats_;
+    common::AtomicLatencyHistogram parse_latency_;
+    bool latency_tracking_ = true;
+    
+    // set_framing(): in-place extractor (parser_ itself for SIMDFixParser)
+    bool framing_ = false;
+    bool streaming_open_ = false;  // parser_ holds part of a message
+    std::unique_ptr<SIMDFixParser> framed_parser_;
+    const SymbolFilter* filter_ = nullptr;
+    
+    SIMDFixParser& framed_parser();
+    
+    /**
+     * @brief Remove ticks from index first on whose symbol filter_ rejects
+     */
+    void drop_unsubscribed(std::vector<common::Tick>& ticks, size_t first);
+    
+    /**
+     * @brief Framed messages in place, the rest through parser_
+     * @return Bytes consumed; a held trailing fragment is not
+     */
+    size_t parse_framed(const char* data, size_t available, std::vector<common::Tick>& ticks);
 };
 
+using StreamingFixHandler = BasicStreamingFixHandler<FSMFixParser>;
+using SimdStreamingFixHandler = BasicStreamingFixHandler<SIMDFixParser>;
+
 } // namespace parser
 } // namespace feedhandler
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <vector>
 #include <array>
 #include "common/tick.hpp"
+#include "common/tick_span.hpp"
 
 namespace feedhandler {
 namespace parser {
@@ -38,6 +39,34 @@ public:
      */
     static std::vector<common::Tick> parse_messages_from_buffer(std::string_view buffer);
     
+    /**
+     * @brief Parse a single FIX message into a packed 32-byte tick
+     * @param message FIX message string_view
+     * @return Parsed tick (symbol interned as instrument ID), invalid on failure
+     */
+    static common::CompactTick parse_message_compact(std::string_view message);
+    
+    /**
+     * @brief Parse multiple FIX messages into packed ticks
+     * @param buffer Buffer containing multiple messages separated by newlines
+     * @param ticks Output vector (appended to)
+     * @return Number of ticks appended
+     */
+    static size_t parse_messages_from_buffer(std::string_view buffer,
+                                             std::vector<common::CompactTick>& ticks);
+    
+    /**
+     * @brief Parse multiple FIX messages into caller-owned fixed-capacity storage
+     * @param buffer Buffer containing multiple messages separated by newlines
+     * @param ticks Output span; parsing stops once it is full
+     * @return Number of ticks written
+     * @warning For Tick output the input buffer must outlive the written ticks
+     */
+    static size_t parse_messages_from_buffer(std::string_view buffer,
+                                             common::TickSpan<common::Tick>& ticks);
+    static size_t parse_messages_from_buffer(std::string_view buffer,
+                                             common::TickSpan<common::CompactTick>& ticks);
+    
     /**
      * @brief Benchmark parsing performance
      * @param message_count Number of messages to parse
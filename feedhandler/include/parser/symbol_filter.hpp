@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace feedhandler {
+namespace parser {
+
+/**
+ * @brief Set of subscribed instrument symbols, built for fast rejection
+ *
+ * A parser asks contains() once per message, before parsing it, and on
+ * a full-universe feed most answers are no. Those are settled by one
+ * word of a blocked Bloom filter (two bits of one 64-bit word, about
+ * 16 bits per symbol), so an unsubscribed symbol usually costs a hash
+ * and one load. Symbols that pass are confirmed in an open-addressing
+ * table that stores each hash next to the name's offset, so a probe
+ * compares bytes only on a full hash match.
+ *
+ * Build it before parsing starts: add() is not safe against concurrent
+ * contains().
+ */
+class SymbolFilter {
+public:
+    SymbolFilter();
+    explicit SymbolFilter(const std::vector<std::string>& symbols);
+
+    /**
+     * @brief Subscribe symbol
+     * @return false if it was already subscribed or is empty
+     */
+    bool add(std::string_view symbol);
+
+    bool contains(std::string_view symbol) const {
+        uint64_t h = hash(symbol);
+        uint64_t word = bloom_[(h >> 32) & bloom_mask_];
+        uint64_t bits = bloom_bits(h);
+        if ((word & bits) != bits) {
+            return false;
+        }
+        for (size_t slot = static_cast<size_t>(h) & table_mask_;; slot = (slot + 1) & table_mask_) {
+            const Entry& entry = table_[slot];
+            if (entry.length == 0) {
+                return false;
+            }
+            if (entry.hash == h && entry.length == symbol.size() &&
+                names_.compare(entry.offset, entry.length, symbol) == 0) {
+                return true;
+            }
+        }
+    }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    void clear();
+
+private:
+    struct Entry {
+        uint64_t hash = 0;
+        uint32_t offset = 0;
+        uint32_t length = 0;     // 0 marks an empty slot
+    };
+
+    // FNV-1a, as in SymbolTable: symbols are a handful of bytes
+    static uint64_t hash(std::string_view symbol) {
+        uint64_t h = 14695981039346656037ULL;
+        for (char c : symbol) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    static uint64_t bloom_bits(uint64_t h) {
+        return (uint64_t{1} << (h & 63)) | (uint64_t{1} << ((h >> 6) & 63));
+    }
+
+    void insert(uint64_t h, uint32_t offset, uint32_t length);
+    void rebuild(size_t table_slots, size_t bloom_words);
+
+    std::string names_;             // Every subscribed symbol, back to back
+    std::vector<uint32_t> lengths_; // Their lengths, in the same order
+    std::vector<Entry> table_;
+    std::vector<uint64_t> bloom_;
+    size_t table_mask_ = 0;
+    size_t bloom_mask_ = 0;
+    size_t count_ = 0;
+};
+
+} // namespace parser
+} // namespace feedhandler
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "common/tick.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace feedhandler {
+namespace parser {
+
+/**
+ * @brief Zero-allocation decoder for exchange trade messages in JSON
+ *
+ * Handles the Binance "trade" and "aggTrade" streams, bare or in the
+ * combined-stream wrapper ({"stream":...,"data":{...}}):
+ *
+ *   {"e":"trade","E":1672515782136,"s":"BTCUSDT","t":12345,
+ *    "p":"16541.25000000","q":"0.00150000","T":1672515782136,"m":true,...}
+ *
+ * One forward pass over the bytes picks out the fields it needs and
+ * skips the rest without building a document: no allocation, no copy of
+ * the payload, numbers converted straight to fixed point. m ("buyer is
+ * the maker") gives the aggressor: true means a seller hit the bid, so
+ * the tick's side is 'S'.
+ *
+ * Prices are scaled by 10000 like every Tick; quantities by qty_scale,
+ * since crypto sizes are fractional and Tick::qty is an integer.
+ */
+class TradeJsonParser {
+public:
+    struct Config {
+        int64_t qty_scale = 1;  // Tick::qty = q * qty_scale, truncated (e.g. 1e8 for satoshis)
+
+        Config() = default;
+    };
+
+    TradeJsonParser() = default;
+    explicit TradeJsonParser(const Config& config) : config_(config) {}
+
+    /**
+     * @brief Decode one message into tick
+     * @param receive_ns Arrival time for tick.timestamp, 0 to stamp with the clock
+     * @return false if it is not a trade or a field is missing
+     *
+     * The symbol is copied into the tick's own storage and interned, so the
+     * tick outlives the payload (a WebSocket frame in the receive buffer).
+     */
+    bool parse(std::string_view json, common::Tick& tick, uint64_t receive_ns = 0) const;
+
+    /**
+     * @brief Append the trade in json to ticks, if it is one
+     * @return Ticks appended (0 or 1)
+     */
+    size_t parse(std::string_view json, std::vector<common::Tick>& ticks, uint64_t receive_ns = 0) const;
+
+    const Config& config() const { return config_; }
+
+private:
+    Config config_;
+};
+
+} // namespace parser
+} // namespace feedhandler
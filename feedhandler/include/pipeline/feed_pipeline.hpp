@@ -0,0 +1,232 @@
+#pragma once
+
+#include "analytics/realtime_engine.hpp"
+#include "common/tick_pool.hpp"
+#include "common/zero_latency_allocator.hpp"
+#include "config/hardware_topology.hpp"
+#include "config/performance_config.hpp"
+#include "monitoring/metrics_exporter.hpp"
+#include "threading/threaded_feedhandler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace feedhandler {
+namespace pipeline {
+
+/**
+ * @brief What became of one PerformanceConfig setting
+ */
+enum class SettingStatus {
+    APPLIED,   // In effect as requested
+    ADJUSTED,  // In effect with a different value (capped, rounded, fallback)
+    IGNORED    // No effect in this pipeline or on this host; the note says why
+};
+
+const char* setting_status_name(SettingStatus status);
+
+struct AppliedSetting {
+    std::string name;       // "queue.ring_buffer_size"
+    std::string requested;  // As configured
+    std::string effective;  // What the component actually uses
+    SettingStatus status = SettingStatus::APPLIED;
+    std::string note;
+};
+
+/**
+ * @brief One row per tuning knob, filled while the pipeline is built
+ */
+class StartupReport {
+public:
+    void add(std::string name, std::string requested, std::string effective,
+             SettingStatus status, std::string note = "");
+
+    /**
+     * @brief Row for a setting, nullptr if it was not reported
+     */
+    const AppliedSetting* find(std::string_view name) const;
+    AppliedSetting* find(std::string_view name);
+
+    const std::vector<AppliedSetting>& settings() const { return settings_; }
+    size_t count(SettingStatus status) const;
+
+    /**
+     * @brief Aligned table, one setting per line
+     */
+    void print(std::ostream& out) const;
+
+private:
+    std::vector<AppliedSetting> settings_;
+};
+
+/**
+ * @brief The feed pipeline built from PerformanceConfig in one place
+ *
+ * Every section of the configuration is mapped onto the component that
+ * implements it, instead of each component being configured by hand:
+ *
+ * - cpu: parser/network thread pinning, NUMA node of the memory region;
+ *   isolation and hyperthreading are checked against the host topology
+ * - memory: ZeroLatencyAllocator region (huge pages, prefault, NUMA
+ *   binding) and a TickPool carved from it
+ * - parser: garbage recovery, SIMDFixParser kernel for buffers
+ * - queue: ring size, overflow policy, buffers per delivery
+ * - monitoring: latency tracking, MetricsExporter, memory gauges
+ *
+ * report() says for each setting what was actually applied. Settings
+ * that the components cannot honour (a CPU outside the process mask, a
+ * kernel without huge pages or NUMA) are reported as ADJUSTED or
+ * IGNORED rather than silently dropped.
+ *
+ * @code
+ * auto pipeline = FeedPipeline::from_file("feed.json", on_ticks);
+ * if (!pipeline) { ... }
+ * pipeline->report().print(std::cout);
+ * pipeline->warm_up();  // Starts it, nothing delivered or counted
+ * pipeline->feed_handler().inject_data(bytes, length);
+ * @endcode
+ */
+class FeedPipeline {
+public:
+    using BatchCallback = threading::ThreadedFeedHandler::BatchCallback;
+
+    /**
+     * @brief Parts that PerformanceConfig does not describe
+     */
+    struct Options {
+        bool analytics = false;                   // Feed every tick to a RealtimeEngine
+        analytics::RealtimeEngine::Config engine; // worker_threads is capped to the free CPUs
+        bool metrics = true;                      // MetricsExporter when metrics_output_file is set
+
+        Options() = default;
+    };
+
+    /**
+     * @brief Synthetic traffic for warm_up()
+     */
+    struct WarmupOptions {
+        std::vector<std::string> symbols;     // Instruments to quote; empty: "WARMUP"
+        size_t messages = 10000;              // Quotes through the queue and parser
+        size_t messages_per_buffer = 16;
+        std::chrono::milliseconds timeout{2000};
+
+        WarmupOptions() = default;
+    };
+
+    struct WarmupResult {
+        size_t messages = 0;      // Injected
+        size_t ticks = 0;         // Parsed and held back from the callback
+        uint64_t elapsed_ns = 0;
+        bool complete = false;    // Every message came through before the timeout
+    };
+
+    /**
+     * @brief Build every component from config
+     * @param callback Ticks of each parsed batch (parser thread); may be empty with analytics
+     */
+    FeedPipeline(const config::PerformanceConfig& config, BatchCallback callback);
+    FeedPipeline(const config::PerformanceConfig& config, BatchCallback callback, const Options& options);
+
+    /**
+     * @brief Load path into PerformanceConfig::instance() and build from it
+     * @return Pipeline, or nullptr if the file could not be loaded
+     */
+    static std::unique_ptr<FeedPipeline> from_file(const std::string& path, BatchCallback callback);
+    static std::unique_ptr<FeedPipeline> from_file(const std::string& path, BatchCallback callback,
+                                                   const Options& options);
+
+    ~FeedPipeline();
+
+    FeedPipeline(const FeedPipeline&) = delete;
+    FeedPipeline& operator=(const FeedPipeline&) = delete;
+
+    /**
+     * @brief Start analytics and metrics, then the feed threads
+     *
+     * Thread pinning is only known once the threads exist, so the cpu
+     * rows of report() are final after this call.
+     */
+    void start();
+
+    /**
+     * @brief Stop the feed threads, then analytics and metrics
+     *
+     * With MonitoringConfig::enable_tracing and a trace_output_file, the
+     * trace of the run is then written there.
+     */
+    void stop();
+
+    /**
+     * @brief Warm the pipeline up before live data, leaving it started
+     *
+     * Prefaults the memory region (if the config did not), then replays
+     * synthetic FIX quotes for options.symbols through the ring and the
+     * parser, paced so no overflow policy drops any. The resulting ticks
+     * stop before the engine and the callback. Afterwards the feed
+     * handler statistics are reset and the tick pool is rewound, so the
+     * first live message meets warm caches and predictors, faulted-in
+     * pages and interned symbols, with nothing counted. Call before the
+     * first inject_data(); live data injected meanwhile would be
+     * swallowed too. Order books warm up on their own
+     * (orderbook::FeedIntegration::warm_up).
+     */
+    WarmupResult warm_up();
+    WarmupResult warm_up(const WarmupOptions& options);
+
+    threading::ThreadedFeedHandler& feed_handler() { return *feed_; }
+
+    /**
+     * @brief Region backing the tick pool, nullptr if zero_latency_pool_size is 0 or mapping failed
+     */
+    common::ZeroLatencyAllocator* allocator() { return allocator_.get(); }
+
+    /**
+     * @brief tick_pool_size ticks, in the allocator's region when there is one
+     */
+    common::TickPool& tick_pool() { return *tick_pool_; }
+
+    analytics::RealtimeEngine* engine() { return engine_.get(); }
+    monitoring::MetricsExporter* metrics() { return metrics_.get(); }
+
+    const config::HardwareTopology& topology() const { return topology_; }
+    const StartupReport& report() const { return report_; }
+
+private:
+    void apply_memory(const config::PerformanceConfig& config);
+    threading::ThreadedFeedHandler::Config feed_config(const config::PerformanceConfig& config);
+    int pick_cpu(const std::string& setting, const std::vector<int>& affinity);
+    void check_cpu_placement(const config::PerformanceConfig::CPUConfig& cpu);
+    void build_engine(Options options);
+    void build_metrics(const config::PerformanceConfig::MonitoringConfig& monitoring);
+    void report_pinning(const std::string& setting, int cpu, bool pinned);
+
+    StartupReport report_;
+    config::HardwareTopology topology_;
+
+    // warm_up(): while set, parsed ticks are counted and not delivered
+    std::atomic<bool> warming_{false};
+    std::atomic<size_t> warmup_ticks_{0};
+
+    // Declaration order is teardown order in reverse: the feed handler's
+    // callback uses the engine, the tick pool lives in the region
+    std::unique_ptr<common::ZeroLatencyAllocator> allocator_;
+    common::ZeroLatencyAllocator::Arena arena_;
+    std::unique_ptr<common::TickPool> tick_pool_;
+    std::unique_ptr<analytics::RealtimeEngine> engine_;
+    std::unique_ptr<threading::ThreadedFeedHandler> feed_;
+    std::unique_ptr<monitoring::MetricsExporter> metrics_;
+
+    int parser_cpu_ = -1;
+    int network_cpu_ = -1;
+    std::string trace_file_;  // MonitoringConfig::trace_output_file, when tracing
+    bool running_ = false;
+};
+
+} // namespace pipeline
+} // namespace feedhandler
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace feedhandler {
+namespace pipeline {
+
+/**
+ * @brief Default merge key: the record's timestamp member
+ */
+template<typename T>
+struct TimestampOf {
+    uint64_t operator()(const T& record) const { return record.timestamp; }
+};
+
+/**
+ * @brief k-way merge of timestamp-ordered sources (captures, sessions)
+ *
+ * A loser tree over per-source buffers. Each internal node of the tree
+ * remembers the source that lost the match played there, and the root
+ * the overall winner, so after the winner's record is taken only its
+ * leaf-to-root path is replayed: ceil(log2 k) key compares per record,
+ * against the 2 log2 k of a binary heap's sift-down, and no pointer
+ * chasing, since each source's head key sits in one flat array.
+ *
+ * Sources are pulled: fill(span) writes up to span.size() records and
+ * returns how many, 0 meaning the source is exhausted. Each source owns
+ * a buffer of buffer_records, refilled only once it is drained, so
+ * per-source costs (std::function call, file read, parse) are paid once
+ * a block. pop() hands out merged records in batches; drain() pushes
+ * them batch by batch into a consumer such as
+ * orderbook::FeedIntegration::process_ticks.
+ *
+ * Equal keys come out in source order, and each source's own records
+ * in the order it produced them; a source whose keys go backwards is
+ * merged as produced and counted in Stats::out_of_order. Single-threaded.
+ */
+template<typename T, typename Key = TimestampOf<T>>
+class TimestampMerger {
+public:
+    using Fill = std::function<size_t(std::span<T> out)>;
+
+    struct Stats {
+        uint64_t merged = 0;        // Records popped
+        uint64_t refills = 0;       // fill() calls that produced records
+        uint64_t out_of_order = 0;  // Records keyed before the one popped previously
+    };
+
+    static constexpr size_t DEFAULT_BUFFER_RECORDS = 1024;
+
+    explicit TimestampMerger(size_t buffer_records = DEFAULT_BUFFER_RECORDS, Key key = Key())
+        : buffer_records_(buffer_records > 0 ? buffer_records : 1), key_(std::move(key)) {}
+
+    /**
+     * @brief Add a source; may be called between pops
+     * @return Source index, the tie-break order for equal keys
+     */
+    size_t add_source(Fill fill) {
+        Source source;
+        source.fill = std::move(fill);
+        source.buffer.resize(buffer_records_);
+        sources_.push_back(std::move(source));
+        heads_.push_back(Head{});
+        refill(sources_.size() - 1);
+        built_ = false;
+        return sources_.size() - 1;
+    }
+
+    /**
+     * @brief Write the next merged records to out
+     * @return Records written; fewer than out.size() only once every
+     *         source is exhausted
+     */
+    size_t pop(std::span<T> out) {
+        if (!built_) {
+            build();
+        }
+        size_t count = 0;
+        size_t k = sources_.size();
+        while (count < out.size() && k > 0) {
+            uint32_t winner = tree_[0];
+            const Head& head = heads_[winner];
+            if (head.done) {
+                break;
+            }
+            if (head.key < last_key_) {
+                ++stats_.out_of_order;
+            }
+            last_key_ = head.key;
+
+            Source& source = sources_[winner];
+            out[count++] = std::move(source.buffer[source.head]);
+            if (++source.head == source.count) {
+                refill(winner);
+            } else {
+                heads_[winner].key = key_(source.buffer[source.head]);
+            }
+            replay(winner);
+        }
+        stats_.merged += count;
+        return count;
+    }
+
+    /**
+     * @brief Merge everything, calling on_batch(std::span<const T>) per
+     *        batch of up to scratch.size() records
+     * @return Records merged
+     */
+    template<typename Fn>
+    size_t drain(std::span<T> scratch, Fn&& on_batch) {
+        size_t total = 0;
+        while (size_t count = pop(scratch)) {
+            on_batch(std::span<const T>(scratch.data(), count));
+            total += count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Every source is exhausted and every record popped
+     */
+    bool done() const {
+        for (const Head& head : heads_) {
+            if (!head.done) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t source_count() const { return sources_.size(); }
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Source {
+        Fill fill;
+        std::vector<T> buffer;
+        size_t head = 0;
+        size_t count = 0;
+    };
+
+    struct Head {
+        uint64_t key = 0;
+        bool done = true;
+    };
+
+    // a comes out before b: live before exhausted, then key, then source order
+    bool beats(uint32_t a, uint32_t b) const {
+        const Head& x = heads_[a];
+        const Head& y = heads_[b];
+        if (x.done != y.done) {
+            return y.done;
+        }
+        return x.key < y.key || (x.key == y.key && a < b);
+    }
+
+    void refill(size_t index) {
+        Source& source = sources_[index];
+        source.head = 0;
+        source.count = source.fill ? source.fill(std::span<T>(source.buffer)) : 0;
+        if (source.count > source.buffer.size()) {
+            source.count = source.buffer.size();
+        }
+        heads_[index].done = source.count == 0;
+        if (source.count > 0) {
+            heads_[index].key = key_(source.buffer[0]);
+            ++stats_.refills;
+        }
+    }
+
+    // Leaves sit at k + i, internal node n plays its children 2n and 2n + 1
+    void build() {
+        size_t k = sources_.size();
+        tree_.assign(k > 0 ? k : 1, 0);
+        if (k > 1) {
+            std::vector<uint32_t> winners(2 * k);
+            for (size_t i = 0; i < k; ++i) {
+                winners[k + i] = static_cast<uint32_t>(i);
+            }
+            for (size_t node = k - 1; node >= 1; --node) {
+                uint32_t left = winners[2 * node];
+                uint32_t right = winners[2 * node + 1];
+                bool left_wins = beats(left, right);
+                winners[node] = left_wins ? left : right;
+                tree_[node] = left_wins ? right : left;
+            }
+            tree_[0] = winners[1];
+        }
+        built_ = true;
+    }
+
+    // Source's head changed: play it up its path against the stored losers
+    void replay(uint32_t source) {
+        size_t k = sources_.size();
+        uint32_t winner = source;
+        for (size_t node = (k + source) / 2; node >= 1; node /= 2) {
+            if (beats(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+    size_t buffer_records_;
+    Key key_;
+    std::vector<Source> sources_;
+    std::vector<Head> heads_;       // Current key of each source, apart from its buffer
+    std::vector<uint32_t> tree_;    // [0] winner, [1, k) losers
+    bool built_ = false;
+    uint64_t last_key_ = 0;
+    Stats stats_;
+};
+
+} // namespace pipeline
+} // namespace feedhandler
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "quantum/state_vector.hpp"
+
+namespace feedhandler {
+namespace quantum {
+
+/**
+ * @brief Hamiltonian as a weighted sum of Pauli strings
+ *
+ * A term c * P_0 (x) P_1 (x) ... stores the qubits carrying X or Y in
+ * x_mask and those carrying Z or Y in z_mask. P maps basis state |z> to
+ * i^(number of Y) (-1)^popcount(z & z_mask) |z ^ x_mask>, so
+ * <psi|H|psi> is one pass over the state per distinct x_mask, with no
+ * matrix: memory is O(terms) instead of O(4^n) and evaluation
+ * O(2^n * terms). A risk model built from asset variances (Z_i) and
+ * covariances (Z_i Z_j) needs n + n(n-1)/2 terms, all diagonal.
+ *
+ * Terms with the same x_mask share a group, so all diagonal terms are
+ * evaluated in a single pass over the probabilities.
+ */
+class PauliHamiltonian {
+public:
+    struct Term {
+        double coefficient;
+        uint64_t x_mask;  // Qubits with X or Y
+        uint64_t z_mask;  // Qubits with Z or Y
+    };
+
+    /// Pauli strings are 64-bit masks
+    static constexpr size_t MAX_QUBITS = 64;
+
+    PauliHamiltonian() = default;
+
+    /**
+     * @brief Add coefficient times a Pauli string
+     * @param paulis One of I, X, Y, Z per qubit; character q acts on
+     *        qubit q (the least significant index bit), so "ZIX" is
+     *        Z on qubit 0 and X on qubit 2
+     * @return false if paulis has another character or is too long
+     */
+    bool add_term(double coefficient, std::string_view paulis);
+    void add_term(double coefficient, uint64_t x_mask, uint64_t z_mask);
+
+    /**
+     * @brief Pauli decomposition of a dense Hermitian matrix
+     *
+     * Coefficient of P is Tr(P H) / 2^n, computed without materializing
+     * P: O(8^n), for importing existing small models. Terms below
+     * tolerance in magnitude are dropped.
+     * @return Empty Hamiltonian (and a message on std::cerr) if the
+     *         matrix is not square with a power-of-two size
+     */
+    static PauliHamiltonian from_dense(const std::vector<std::vector<std::complex<double>>>& matrix,
+                                       double tolerance = 1e-12);
+
+    /**
+     * @brief <psi|H|psi> without forming H
+     *
+     * The state must cover qubits(); extra qubits act as identity.
+     */
+    double expectation(const StateVector& state) const;
+
+    /**
+     * @brief Highest qubit any term acts on, plus one
+     */
+    size_t qubits() const { return qubits_; }
+    size_t term_count() const { return term_count_; }
+    std::vector<Term> terms() const;
+
+private:
+    struct Group {
+        uint64_t x_mask;
+        std::vector<Term> terms;
+    };
+
+    std::vector<Group> groups_;
+    std::unordered_map<uint64_t, size_t> group_of_x_;
+    size_t qubits_ = 0;
+    size_t term_count_ = 0;
+};
+
+} // namespace quantum
+} // namespace feedhandler
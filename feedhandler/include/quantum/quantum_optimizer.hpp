@@ -2,8 +2,11 @@
 
 #include <vector>
 #include <complex>
+#include <cstdint>
 #include <memory>
 #include <functional>
+#include "quantum/pauli_hamiltonian.hpp"
+#include "quantum/state_vector.hpp"
 
 namespace feedhandler {
 namespace quantum {
@@ -33,8 +36,21 @@ public:
         size_t iterations;
         double convergence_time_ms;
         double quantum_advantage_ratio; // Speedup vs classical
+        size_t cache_hits;              // Evaluations answered from the parameter cache
     };
     
+    struct Config {
+        StateVectorSimulator::Config simulator;
+        size_t starts = 8;              // Nelder-Mead runs per qaoa_optimize() call
+        size_t threads = 0;             // Threads running starts; 0 = hardware_concurrency
+        size_t cache_capacity = 4096;   // Memoized parameter vectors per start (0 = off)
+        uint64_t seed = 42;             // Random starting angles of starts after the first
+        size_t vqe_layers = 2;          // Entangling layers of the VQE ansatz
+    };
+    
+    QuantumOptimizer();
+    explicit QuantumOptimizer(const Config& config);
+    
     /**
      * @brief Portfolio optimization using quantum-inspired algorithms
      * @param expected_returns Expected returns for each asset
@@ -49,6 +65,20 @@ public:
     
     /**
      * @brief Quantum Approximate Optimization Algorithm (QAOA)
+     *
+     * Each variable is one qubit. cost_function is evaluated once per
+     * basis state (variables 0.0 or 1.0) up front; the circuit then
+     * applies that diagonal as a phase layer, so the classical search over
+     * the 2 * num_layers angles only simulates gates. The state is
+     * simulated exactly, which limits num_variables to MAX_SIMULATED_QUBITS.
+     *
+     * The angle landscape has many local minima, so Config::starts
+     * Nelder-Mead runs (the first from a linear ramp, the rest from
+     * seeded random angles) are spread over threads and the best one
+     * wins. Each thread owns a state vector and gate sequence that every
+     * evaluation reuses, and each start memoizes the expectation of the
+     * exact parameter vectors it has evaluated. Results are deterministic
+     * for a given seed, whatever the thread count.
      * @param cost_function Objective function to minimize
      * @param num_variables Number of optimization variables
      * @param num_layers QAOA circuit depth
@@ -60,6 +90,12 @@ public:
     
     /**
      * @brief Variational Quantum Eigensolver for risk minimization
+     *
+     * The ansatz applies RY and RZ on every qubit, then a CNOT chain,
+     * Config::vqe_layers times, followed by a last rotation layer, to
+     * initial_state; Nelder-Mead minimizes the energy over the angles.
+     * optimal_value is the energy reached and optimal_weights the bits
+     * of the most probable basis state of the final state.
      * @param hamiltonian Risk Hamiltonian matrix
      * @param initial_state Initial quantum state
      * @return Ground state (minimum risk configuration)
@@ -68,6 +104,18 @@ public:
         const std::vector<std::vector<Complex>>& hamiltonian,
         const QuantumState& initial_state);
     
+    /**
+     * @brief VQE on a Pauli-sum Hamiltonian, evaluated matrix-free
+     *
+     * Memory is the state vector plus the terms, so the register is
+     * limited by MAX_SIMULATED_QUBITS rather than by a 4^n matrix.
+     * @param initial_state Initial quantum state; empty for |0...0> on
+     *        hamiltonian.qubits() qubits
+     */
+    OptimizationResult vqe_minimize_risk(
+        const PauliHamiltonian& hamiltonian,
+        const QuantumState& initial_state);
+    
     /**
      * @brief Quantum-inspired genetic algorithm
      * @param fitness_function Fitness evaluation function
@@ -92,30 +140,45 @@ public:
         const std::vector<std::vector<Complex>>& final_hamiltonian,
         double evolution_time);
 
+    /// Largest register qaoa_optimize() and vqe_minimize_risk() simulate (2^24 amplitudes, 256 MB)
+    static constexpr size_t MAX_SIMULATED_QUBITS = 24;
+
 private:
     // Quantum gate operations
-    void apply_hadamard(QuantumState& state, size_t qubit);
-    void apply_cnot(QuantumState& state, size_t control, size_t target);
-    void apply_rotation_z(QuantumState& state, size_t qubit, double angle);
-    void apply_rotation_x(QuantumState& state, size_t qubit, double angle);
+    void apply_hadamard(StateVector& state, size_t qubit);
+    void apply_cnot(StateVector& state, size_t control, size_t target);
+    void apply_rotation_z(StateVector& state, size_t qubit, double angle);
+    void apply_rotation_x(StateVector& state, size_t qubit, double angle);
     
-    // Quantum measurement
+    // Quantum measurement: {<psi|O|psi>}
     std::vector<double> measure_expectation(const QuantumState& state,
                                           const std::vector<std::vector<Complex>>& observable);
+    double measure_expectation(const StateVector& state, const PauliHamiltonian& observable) const;
+    
+    // VQE ansatz search from initial, energy evaluated on each trial state
+    OptimizationResult run_vqe(const StateVector& initial,
+                               const std::function<double(const StateVector&)>& energy);
     
     // Classical optimization helpers
+    // One serial run; safe to call from several threads at once
     std::vector<double> nelder_mead_optimize(const CostFunction& func,
-                                           const std::vector<double>& initial_guess);
+                                           const std::vector<double>& initial_guess) const;
+    
+    // Quantum circuit simulation: parameters are (gamma, beta) per layer,
+    // cost_diagonal the cost of every basis state; circuit is scratch
+    void simulate_qaoa_circuit(const std::vector<double>& parameters,
+                               const std::vector<double>& cost_diagonal,
+                               size_t num_layers,
+                               const StateVectorSimulator& simulator,
+                               GateSequence& circuit,
+                               StateVector& state) const;
     
-    // Quantum circuit simulation
-    QuantumState simulate_qaoa_circuit(const std::vector<double>& parameters,
-                                      const CostFunction& cost_function,
-                                      size_t num_qubits,
-                                      size_t num_layers);
+    Config config_;
+    StateVectorSimulator simulator_;
     
     // Performance tracking
-    mutable size_t total_function_evaluations_;
-    mutable double total_optimization_time_;
+    mutable size_t total_function_evaluations_ = 0;
+    mutable double total_optimization_time_ = 0.0;
 };
 
 /**
@@ -146,7 +209,7 @@ public:
      * @param asset_returns Return series for multiple assets
      * @return Quantum correlation matrix
      */
-    std::vector<std::vector<Complex>> quantum_correlation_analysis(
+    std::vector<std::vector<QuantumOptimizer::Complex>> quantum_correlation_analysis(
         const std::vector<std::vector<double>>& asset_returns);
 
 private:
@@ -165,7 +228,7 @@ public:
      * @return Trained quantum classifier
      */
     struct QuantumClassifier {
-        QuantumState quantum_weights;
+        QuantumOptimizer::QuantumState quantum_weights;
         std::vector<double> support_vectors;
         double bias;
     };
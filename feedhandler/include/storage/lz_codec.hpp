@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace feedhandler {
+namespace storage {
+
+/**
+ * @brief Byte-oriented LZ77 block codec in the LZ4 block format
+ *
+ * Streams are plain LZ4 blocks (token, literals, 16-bit offset, match
+ * length), so any LZ4 block decoder reads them. The level trades speed
+ * for ratio the way LZ4 / LZ4-HC do:
+ * - FAST_LEVEL probes one hash slot and skips ahead through
+ *   incompressible runs; it runs at a few GB/s
+ * - higher levels walk a hash chain (2^(level-1) candidates, up to
+ *   MAX_LEVEL) for the longest match
+ *
+ * The decoder bounds-checks every copy, so corrupt input fails instead
+ * of overrunning. Neither side allocates beyond the compressor's match
+ * tables, which are reused per thread.
+ */
+constexpr int FAST_LEVEL = 1;
+constexpr int MAX_LEVEL = 9;
+
+/**
+ * @brief Largest possible compressed size of size input bytes
+ */
+constexpr size_t lz_compress_bound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+/**
+ * @brief Compress src into dst
+ * @param level Clamped to [FAST_LEVEL, MAX_LEVEL]
+ * @return Compressed bytes, or 0 if dst is too small
+ */
+size_t lz_compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int level = FAST_LEVEL);
+
+/**
+ * @brief Decompress exactly original_size bytes into dst
+ * @return false if the stream is corrupt or does not decode to original_size
+ */
+bool lz_decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t original_size);
+
+} // namespace storage
+} // namespace feedhandler
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "common/compact_tick.hpp"
+#include "storage/tick_journal.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace feedhandler {
+namespace storage {
+
+/**
+ * @brief Domain encoding of tick and price-level streams
+ *
+ * Market data is highly regular: timestamps advance at a near-constant
+ * rate, a symbol's price moves a few ticks at a time and quantities are
+ * small. Each tick row is therefore stored as varints of
+ * - the timestamp's delta-of-delta (zigzag), usually one byte
+ * - file symbol + 1 and a 2-bit side code
+ * - the zigzag delta from the symbol's previous price
+ * - the zigzag quantity
+ * which takes a 32-byte record to about 5 bytes before any byte-level
+ * compression (lz_codec.hpp) runs on top.
+ *
+ * Streams start with a varint row count and are self-delimiting.
+ */
+
+/**
+ * @brief One price level of a book snapshot, for encode_levels()
+ */
+struct BookLevel {
+    int64_t price;      ///< Fixed-point (scaled by 10000)
+    int64_t quantity;
+};
+
+inline uint64_t zigzag_encode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Read a varint, advancing p
+ * @return false if the input ends first or the value exceeds 64 bits
+ */
+inline bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Append the encoding of records to out
+ */
+void encode_ticks(std::span<const JournalRecord> records, std::vector<uint8_t>& out);
+void encode_ticks(std::span<const common::CompactTick> ticks, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decode a whole encode_ticks() stream into records (capacity reused)
+ * @return false if the stream is truncated or has trailing bytes
+ */
+bool decode_ticks(const uint8_t* data, size_t size, std::vector<JournalRecord>& records);
+bool decode_ticks(const uint8_t* data, size_t size, std::vector<common::CompactTick>& ticks);
+
+/**
+ * @brief Append the encoding of price levels (price deltas, zigzag quantities)
+ */
+void encode_levels(std::span<const BookLevel> levels, std::vector<uint8_t>& out);
+bool decode_levels(const uint8_t* data, size_t size, std::vector<BookLevel>& levels);
+
+} // namespace storage
+} // namespace feedhandler
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "common/compact_tick.hpp"
+#include "common/tick.hpp"
+#include "storage/lz_codec.hpp"
+#include "threading/spsc_ring.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace feedhandler {
+namespace storage {
+
+/**
+ * @brief One journal row: a CompactTick with a file-local symbol ID
+ *
+ * Fixed width, so a block is a plain array that scans at memory
+ * bandwidth straight out of the mapping.
+ */
+struct JournalRecord {
+    int64_t price;          ///< Fixed-point (scaled by 10000)
+    uint64_t timestamp;     ///< Nanoseconds since Unix epoch
+    uint32_t symbol;        ///< Index into the file's symbol dictionary, NO_SYMBOL if unknown
+    int32_t qty;
+    char side;
+    char reserved[7];
+
+    static constexpr uint32_t NO_SYMBOL = UINT32_MAX;
+};
+
+static_assert(sizeof(JournalRecord) == 32, "JournalRecord is a fixed 32-byte row");
+
+/**
+ * @brief How a journal block stores its records
+ */
+enum class JournalEncoding : uint32_t {
+    RAW = 0,       ///< Fixed-width JournalRecords, readable in place
+    DELTA = 1,     ///< encode_ticks() stream (tick_codec.hpp), typically 6x smaller
+    DELTA_LZ = 2   ///< DELTA stream compressed with lz_codec.hpp
+};
+
+/**
+ * @brief Block index entry (one per block, stored in the footer)
+ */
+struct JournalIndexEntry {
+    uint64_t offset;            ///< File offset of the block header
+    uint64_t first_timestamp;   ///< Smallest record timestamp in the block
+    uint64_t last_timestamp;    ///< Largest record timestamp in the block
+    uint32_t record_count;
+    uint32_t symbol_count;      ///< Dictionary entries introduced by the block
+};
+
+/**
+ * @brief Append-only binary tick journal writer
+ *
+ * File layout:
+ * - 64-byte file header
+ * - Blocks: header, the dictionary entries for symbols first seen in
+ *   the block, then up to block_records fixed-width JournalRecords or,
+ *   for DELTA / DELTA_LZ, their encoding padded to 8 bytes
+ * - Footer written by close(): the block index and a trailer
+ *
+ * Symbols are numbered per file in order of first appearance, so a
+ * journal is readable without the process's SymbolTable. A file that
+ * was never closed has no footer; the reader rebuilds the index by
+ * walking block headers and ignores a torn final block.
+ */
+class TickJournalWriter {
+public:
+    static constexpr size_t DEFAULT_BLOCK_RECORDS = 4096;
+
+    /**
+     * @param encoding RAW keeps records mappable in place; the encoded
+     *        forms trade a decode per block for far smaller files
+     * @param level lz_codec level for DELTA_LZ
+     */
+    explicit TickJournalWriter(size_t block_records = DEFAULT_BLOCK_RECORDS,
+                               JournalEncoding encoding = JournalEncoding::RAW, int level = FAST_LEVEL);
+    ~TickJournalWriter();
+
+    TickJournalWriter(const TickJournalWriter&) = delete;
+    TickJournalWriter& operator=(const TickJournalWriter&) = delete;
+
+    /**
+     * @brief Create (truncate) the journal file
+     * @return false if the file cannot be created
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Append one tick (buffered until its block is full)
+     * @return false if the journal is not open or a write failed
+     */
+    bool append(const common::CompactTick& tick);
+
+    /**
+     * @brief Write the partially filled block, if any
+     */
+    bool flush();
+
+    /**
+     * @brief Flush, write the block index and close the file
+     */
+    bool close();
+
+    bool is_open() const { return fd_ >= 0; }
+    uint64_t records_written() const { return records_written_; }
+    uint64_t bytes_written() const { return file_offset_; }
+    size_t block_records() const { return block_records_; }
+    JournalEncoding encoding() const { return encoding_; }
+
+private:
+    bool write_block();
+    size_t encode_block();
+    uint32_t file_symbol(common::InstrumentId instrument_id);
+
+    int fd_;
+    size_t block_records_;
+    JournalEncoding encoding_;
+    int level_;
+    uint64_t file_offset_;
+    uint64_t records_written_;
+    std::vector<JournalRecord> records_;       // Current block
+    std::vector<char> pending_symbols_;        // Dictionary entries for the current block
+    uint32_t pending_symbol_count_;
+    std::vector<uint32_t> file_symbols_;       // Global instrument ID -> file symbol
+    uint32_t next_file_symbol_;
+    std::vector<JournalIndexEntry> index_;
+    std::vector<uint8_t> encoded_;             // DELTA stream of the current block
+    std::vector<uint8_t> compressed_;          // DELTA_LZ payload of the current block
+};
+
+/**
+ * @brief Read-only view of a journal through mmap
+ *
+ * RAW records are returned in place (spans into the mapping) and stay
+ * valid until close(). Encoded blocks are decoded on demand into one
+ * reused buffer, so their spans last until the next records() call
+ * for a different encoded block. Blocks are expected in non-decreasing time order, which
+ * is what a live recorder produces; find_block() binary searches on it.
+ */
+class TickJournalReader {
+public:
+    TickJournalReader();
+    ~TickJournalReader();
+
+    TickJournalReader(const TickJournalReader&) = delete;
+    TickJournalReader& operator=(const TickJournalReader&) = delete;
+
+    /**
+     * @brief Map a journal and load its index and dictionary
+     * @return false if the file is missing or not a journal
+     */
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return data_ != nullptr; }
+
+    /**
+     * @brief Whether the index came from the footer (cleanly closed file)
+     */
+    bool has_footer() const { return has_footer_; }
+
+    size_t block_count() const { return index_.size(); }
+    uint64_t record_count() const { return record_count_; }
+    const JournalIndexEntry& block(size_t i) const { return index_[i]; }
+
+    /**
+     * @brief Records of block i: in place for RAW, decoded otherwise
+     * @return An empty span if an encoded block is corrupt
+     */
+    std::span<const JournalRecord> records(size_t i) const;
+
+    /**
+     * @brief First block that can contain a record at or after timestamp
+     * @return Block index, or block_count() if every block is earlier
+     */
+    size_t find_block(uint64_t timestamp) const;
+
+    /**
+     * @brief Symbol name for a file-local symbol ID (empty if unknown)
+     */
+    std::string_view symbol(uint32_t file_symbol) const;
+    size_t symbol_count() const { return symbols_.size(); }
+
+    /**
+     * @brief Append ticks with from <= timestamp < to, interned into the global SymbolTable
+     * @return Number of ticks appended
+     */
+    size_t read(uint64_t from, uint64_t to, std::vector<common::CompactTick>& ticks);
+
+private:
+    bool load_footer();
+    void scan_blocks();
+    void load_symbols();
+
+    const char* data_;
+    size_t size_;
+    bool has_footer_;
+    uint64_t record_count_;
+    std::vector<JournalIndexEntry> index_;
+    std::vector<std::string_view> symbols_;              // Views into the mapping
+    std::vector<common::InstrumentId> instrument_ids_;   // File symbol -> global ID (lazy)
+    mutable std::vector<JournalRecord> decoded_;         // Last encoded block decoded
+    mutable std::vector<uint8_t> decompressed_;
+    mutable size_t decoded_block_;
+};
+
+/**
+ * @brief Background thread that records parsed ticks into a journal
+ *
+ * on_ticks() runs on the feed handler's parser thread (as its
+ * BatchCallback) and only pushes packed ticks onto an SPSC ring; the
+ * recorder thread does all file I/O. Ticks that do not fit in the ring
+ * are dropped and counted rather than stalling the parser.
+ *
+ * @code
+ * TickJournalWriter writer;
+ * writer.open("ticks.jrnl");
+ * JournalRecorder recorder(writer);
+ * recorder.start();
+ * ThreadedFeedHandler handler(config, [&](std::span<const Tick> ticks) { recorder.on_ticks(ticks); });
+ * @endcode
+ */
+class JournalRecorder {
+public:
+    /**
+     * @param writer Open journal; used only by the recorder thread until stop()
+     * @param queue_size Ticks buffered between the threads
+     */
+    explicit JournalRecorder(TickJournalWriter& writer, size_t queue_size = 65536);
+    ~JournalRecorder();
+
+    JournalRecorder(const JournalRecorder&) = delete;
+    JournalRecorder& operator=(const JournalRecorder&) = delete;
+
+    void start();
+
+    /**
+     * @brief Drain the queue, flush the writer and join the thread
+     */
+    void stop();
+
+    /**
+     * @brief Queue ticks for recording (producer side, one thread only)
+     */
+    void on_ticks(std::span<const common::Tick> ticks);
+    void on_tick(const common::CompactTick& tick);
+
+    uint64_t recorded() const { return recorded_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    TickJournalWriter& writer_;
+    threading::SpscRing<common::CompactTick> queue_;
+    std::thread thread_;
+    std::atomic<uint64_t> recorded_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+} // namespace storage
+} // namespace feedhandler
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "common/tick.hpp"
+#include "common/symbol_table.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace feedhandler {
+namespace threading {
+
+/**
+ * @brief Latest top-of-book state of one instrument
+ */
+struct ConflatedQuote {
+    common::InstrumentId instrument_id = common::INVALID_INSTRUMENT;
+    int64_t bid_price = 0;      ///< Fixed-point, 0 = no bid seen
+    int64_t bid_qty = 0;
+    int64_t ask_price = 0;      ///< Fixed-point, 0 = no ask seen
+    int64_t ask_qty = 0;
+    uint64_t timestamp = 0;     ///< Tick::timestamp of the last update
+    uint64_t updates = 0;       ///< Ticks applied since construction
+};
+
+/**
+ * @brief Per-instrument conflation between the fast path and slow consumers
+ *
+ * The producer (typically a ThreadedFeedHandler BatchCallback on the
+ * parser thread) writes every tick into a flat array slot indexed by
+ * InstrumentId and sets that instrument's bit in a dirty bitmap. Slow
+ * consumers (GUIs, risk) call drain() whenever they like and get the
+ * latest quote of each instrument that changed since their last drain,
+ * however many ticks that was. The producer never waits on them and
+ * memory is fixed at construction, independent of the message rate.
+ *
+ * Each slot is a seqlock, so readers retry instead of blocking the
+ * writer. Draining claims dirty bits with an atomic exchange per 64
+ * instruments, so several consumers may drain concurrently and each
+ * change is handed to exactly one of them.
+ *
+ * One thread may call update(); any thread may call drain() and read().
+ *
+ * @code
+ * ConflationBuffer conflation(4096);  // Instrument IDs below 4096
+ * ThreadedFeedHandler handler(config, [&](std::span<const common::Tick> ticks) {
+ *     conflation.update(ticks);
+ * });
+ * // GUI thread, at its own pace:
+ * conflation.drain([](const ConflatedQuote& quote) { redraw(quote); });
+ * @endcode
+ */
+class ConflationBuffer {
+public:
+    /**
+     * @param max_instruments Instrument IDs [0, max_instruments) are tracked
+     */
+    explicit ConflationBuffer(size_t max_instruments)
+        : capacity_(max_instruments)
+        , slots_(new Slot[max_instruments])
+        , dirty_(new std::atomic<uint64_t>[(max_instruments + 63) / 64]) {
+        for (size_t i = 0; i < words(); ++i) {
+            dirty_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ConflationBuffer(const ConflationBuffer&) = delete;
+    ConflationBuffer& operator=(const ConflationBuffer&) = delete;
+
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Apply one tick to its instrument's quote (producer side)
+     * @return false if the tick has no instrument ID in range
+     */
+    bool update(const common::Tick& tick) {
+        if (tick.instrument_id >= capacity_) {
+            rejected_.store(rejected_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        Slot& slot = slots_[tick.instrument_id];
+
+        uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        if (tick.side == 'S') {
+            slot.ask_price.store(tick.price, std::memory_order_relaxed);
+            slot.ask_qty.store(tick.qty, std::memory_order_relaxed);
+        } else {
+            slot.bid_price.store(tick.price, std::memory_order_relaxed);
+            slot.bid_qty.store(tick.qty, std::memory_order_relaxed);
+        }
+        slot.timestamp.store(tick.timestamp, std::memory_order_relaxed);
+        slot.updates.store(slot.updates.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+
+        // Already dirty: this tick replaced one no consumer has seen
+        uint64_t bit = uint64_t{1} << (tick.instrument_id % 64);
+        if (dirty_[tick.instrument_id / 64].fetch_or(bit, std::memory_order_release) & bit) {
+            conflated_.store(conflated_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Apply a batch of ticks (producer side)
+     * @return Ticks applied
+     */
+    size_t update(std::span<const common::Tick> ticks) {
+        size_t applied = 0;
+        for (const auto& tick : ticks) {
+            applied += update(tick) ? 1 : 0;
+        }
+        return applied;
+    }
+
+    /**
+     * @brief Hand every instrument changed since the last drain to consumer
+     * @param consumer Called as consumer(const ConflatedQuote&), in instrument order
+     * @return Quotes delivered
+     */
+    template<typename Consumer>
+    size_t drain(Consumer&& consumer) {
+        size_t delivered = 0;
+        for (size_t word = 0; word < words(); ++word) {
+            if (dirty_[word].load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            uint64_t bits = dirty_[word].exchange(0, std::memory_order_acquire);
+            while (bits != 0) {
+                size_t id = word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+                ConflatedQuote quote;
+                read(static_cast<common::InstrumentId>(id), quote);
+                consumer(quote);
+                ++delivered;
+            }
+        }
+        return delivered;
+    }
+
+    /**
+     * @brief Append changed quotes to out (see drain(consumer))
+     */
+    size_t drain(std::vector<ConflatedQuote>& out) {
+        return drain([&out](const ConflatedQuote& quote) { out.push_back(quote); });
+    }
+
+    /**
+     * @brief Consistent copy of one instrument's quote, dirty or not
+     * @return false if instrument_id is out of range
+     */
+    bool read(common::InstrumentId instrument_id, ConflatedQuote& quote) const {
+        if (instrument_id >= capacity_) {
+            return false;
+        }
+        const Slot& slot = slots_[instrument_id];
+        uint64_t before;
+        do {
+            before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;  // Writer mid-update
+            }
+            quote.bid_price = slot.bid_price.load(std::memory_order_relaxed);
+            quote.bid_qty = slot.bid_qty.load(std::memory_order_relaxed);
+            quote.ask_price = slot.ask_price.load(std::memory_order_relaxed);
+            quote.ask_qty = slot.ask_qty.load(std::memory_order_relaxed);
+            quote.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+            quote.updates = slot.updates.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((before & 1) || slot.sequence.load(std::memory_order_relaxed) != before);
+        quote.instrument_id = instrument_id;
+        return true;
+    }
+
+    /**
+     * @brief Ticks that overwrote an update no consumer had drained yet
+     */
+    uint64_t conflated() const { return conflated_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Ticks without an instrument ID in range
+     */
+    uint64_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+private:
+    // One cache line per instrument so neighbouring updates never share
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0};  // Odd while the producer writes
+        std::atomic<int64_t> bid_price{0};
+        std::atomic<int64_t> bid_qty{0};
+        std::atomic<int64_t> ask_price{0};
+        std::atomic<int64_t> ask_qty{0};
+        std::atomic<uint64_t> timestamp{0};
+        std::atomic<uint64_t> updates{0};
+    };
+
+    size_t words() const { return (capacity_ + 63) / 64; }
+
+    size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<std::atomic<uint64_t>[]> dirty_;
+
+    // Producer-written counters
+    std::atomic<uint64_t> conflated_{0};
+    std::atomic<uint64_t> rejected_{0};
+};
+
+} // namespace threading
+} // namespace feedhandler
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "common/buffer_segment.hpp"
+
 #include <mutex>
 #include <condition_variable>
 #include <queue>
@@ -188,6 +190,11 @@ private:
 struct MessageBuffer {
     std::vector<char> data;
     size_t length;
+    common::SegmentRef segment;  // Zero-copy mode: bytes live here instead of data
+    uint64_t enqueued_at = 0;    // TscClock::read_counter() at push (latency tracking)
+    uint64_t received_at = 0;    // Receive time in ns since epoch, 0 = stamp at parse
+    bool after_gap = false;      // An earlier buffer was dropped: discard partial parser state
+    uint64_t sequence = 0;       // Per-feed message sequence, ties trace events across threads
     
     MessageBuffer() : length(0) {}
     
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace feedhandler {
+namespace threading {
+
+/**
+ * @brief Bounded lock-free queue with per-slot sequence numbers
+ *
+ * Each slot carries a sequence number that tells producers whether it is
+ * free for the current lap and consumers whether it has been published,
+ * so producers (and, with MultiConsumer, consumers) claim positions with
+ * a single CAS on their shared index and never touch the other side's.
+ *
+ * Slots and the two indices are each padded to a cache line, so a
+ * producer filling one slot does not invalidate the slot or index a
+ * neighbouring thread is working on.
+ *
+ * Use the MpscQueue / MpmcQueue aliases:
+ * - MpscQueue: many producers, one consumer (e.g. feed sessions into a
+ *   single book-builder thread); the consumer side needs no CAS
+ * - MpmcQueue: many producers, many consumers (worker pools)
+ *
+ * For exactly one producer and one consumer prefer SpscRing or
+ * UltraLowLatencyQueue, which need no per-slot sequence at all.
+ */
+template<typename T, bool MultiConsumer>
+class SequencedQueue {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Minimum number of elements held (rounded up to a power of 2)
+     */
+    explicit SequencedQueue(size_t capacity)
+        : capacity_(round_up_pow2(capacity))
+        , mask_(capacity_ - 1)
+        , slots_(new Slot[capacity_]) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    SequencedQueue(const SequencedQueue&) = delete;
+    SequencedQueue& operator=(const SequencedQueue&) = delete;
+
+    /**
+     * @brief Push item without blocking (any producer thread)
+     * @return true if pushed, false if queue full
+     */
+    bool try_push(T&& item) {
+        Slot* slot;
+        size_t pos = tail_.value.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            const size_t seq = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                // Slot free for this lap: claim the position
+                if (tail_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Full: slot still holds last lap's element
+            } else {
+                pos = tail_.value.load(std::memory_order_relaxed);  // Another producer won
+            }
+        }
+
+        slot->value = std::move(item);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& item) {
+        T copy(item);
+        return try_push(std::move(copy));
+    }
+
+    /**
+     * @brief Pop item without blocking
+     *
+     * MpscQueue: call from the single consumer thread only.
+     * @return true if an item was popped, false if queue empty
+     */
+    bool try_pop(T& item) {
+        Slot* slot;
+        size_t pos = head_.value.load(std::memory_order_relaxed);
+
+        if constexpr (MultiConsumer) {
+            for (;;) {
+                slot = &slots_[pos & mask_];
+                const size_t seq = slot->sequence.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+                if (diff == 0) {
+                    if (head_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;  // Empty: slot not yet published
+                } else {
+                    pos = head_.value.load(std::memory_order_relaxed);  // Another consumer won
+                }
+            }
+        } else {
+            slot = &slots_[pos & mask_];
+            if (slot->sequence.load(std::memory_order_acquire) != pos + 1) {
+                return false;  // Empty (or producer still writing this slot)
+            }
+            head_.value.store(pos + 1, std::memory_order_relaxed);
+        }
+
+        item = std::move(slot->value);
+        // Free the slot for the producers' next lap
+        slot->sequence.store(pos + capacity_, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Check if queue is empty (approximate when called concurrently)
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Number of claimed positions (approximate when called concurrently)
+     *
+     * Counts elements whose producer has claimed a slot but not yet
+     * published it.
+     */
+    size_t size() const {
+        const size_t head = head_.value.load(std::memory_order_acquire);
+        const size_t tail = tail_.value.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    struct alignas(CACHE_LINE_SIZE) PaddedIndex {
+        std::atomic<size_t> value{0};
+    };
+
+    static size_t round_up_pow2(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    PaddedIndex head_;  // Next position to pop
+    PaddedIndex tail_;  // Next position to push
+};
+
+/**
+ * @brief Bounded multi-producer, single-consumer queue
+ */
+template<typename T>
+using MpscQueue = SequencedQueue<T, false>;
+
+/**
+ * @brief Bounded multi-producer, multi-consumer queue
+ */
+template<typename T>
+using MpmcQueue = SequencedQueue<T, true>;
+
+} // namespace threading
+} // namespace feedhandler
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "common/tick.hpp"
+#include "common/compact_tick.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace feedhandler {
+namespace threading {
+
+/**
+ * @brief Parses one large capture buffer on several threads
+ *
+ * Intended for replay and backtests, where a whole capture is already in
+ * memory. The buffer is cut into chunks of roughly Config::chunk_size at
+ * message boundaries (a line starting with "8=FIX"), so every chunk is a
+ * valid input for the serial parse_messages_from_buffer functions.
+ *
+ * Scheduling is work-stealing: each thread starts with a contiguous run
+ * of chunks and takes them from the front; a thread that runs dry steals
+ * the back half of another thread's run. Each chunk's ticks are kept in
+ * their own slot and concatenated in chunk order, so the result is
+ * identical to a serial parse. The calling thread is one of the workers.
+ *
+ * Ticks point into the buffer, which must outlive them. Instrument IDs
+ * are interned concurrently, so their numbering may differ between runs.
+ *
+ * @code
+ * ParallelBufferParser parallel;
+ * auto ticks = parallel.parse(capture, &parser::StringViewFixParser::parse_messages_from_buffer);
+ * @endcode
+ */
+class ParallelBufferParser {
+public:
+    /**
+     * @brief Configuration
+     */
+    struct Config {
+        size_t thread_count = 0;        // 0 = std::thread::hardware_concurrency()
+        size_t chunk_size = 1 << 20;    // Target bytes per chunk
+
+        Config() = default;
+    };
+
+    /**
+     * @brief Scheduling counters for the last parse
+     */
+    struct Stats {
+        size_t chunks = 0;
+        size_t threads = 0;
+        uint64_t steals = 0;
+    };
+
+    /**
+     * @brief Serial buffer parsers this class can fan out
+     */
+    using TickParseFn = std::vector<common::Tick> (*)(std::string_view);
+    using CompactParseFn = size_t (*)(std::string_view, std::vector<common::CompactTick>&);
+
+    ParallelBufferParser();
+    explicit ParallelBufferParser(const Config& config);
+
+    /**
+     * @brief Parse buffer into ticks, in buffer order
+     * @param buffer Newline-separated FIX messages
+     * @param parse Serial parser applied to each chunk
+     */
+    std::vector<common::Tick> parse(std::string_view buffer, TickParseFn parse);
+
+    /**
+     * @brief Parse buffer into packed ticks, in buffer order
+     * @param ticks Output vector (appended to)
+     * @return Number of ticks appended
+     */
+    size_t parse(std::string_view buffer, CompactParseFn parse, std::vector<common::CompactTick>& ticks);
+
+    /**
+     * @brief Cut buffer into chunks of about chunk_size bytes at message starts
+     *
+     * A chunk is only ended where a line starts with "8=FIX"; a buffer
+     * without such boundaries stays one chunk.
+     */
+    static std::vector<std::string_view> split_chunks(std::string_view buffer, size_t chunk_size);
+
+    const Stats& get_stats() const { return stats_; }
+    const Config& get_config() const { return config_; }
+
+private:
+    Config config_;
+    Stats stats_;
+
+    /**
+     * @brief Run parse_chunk(index) for every chunk on the worker threads
+     */
+    template<typename ParseChunk>
+    void run(size_t chunk_count, ParseChunk&& parse_chunk);
+};
+
+} // namespace threading
+} // namespace feedhandler
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace feedhandler {
+namespace threading {
+
+/**
+ * @brief Single-writer seqlock holding one trivially copyable value
+ *
+ * The writer bumps the sequence to odd, stores the value and bumps it
+ * back to even; readers copy the value and retry if the sequence was odd
+ * or changed underneath them. Readers never block the writer and never
+ * write shared state, so many of them can poll at a high rate without
+ * slowing the publisher down.
+ *
+ * The value is kept as relaxed atomic 64-bit words rather than a plain
+ * T, so a torn read is a retry instead of a data race.
+ *
+ * Exactly one thread may call store(); any number may call load().
+ */
+template<typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock values are copied word by word");
+
+public:
+    Seqlock() { store(T{}); }
+
+    explicit Seqlock(const T& value) { store(value); }
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    /**
+     * @brief Publish a new value (writer only)
+     */
+    void store(const T& value) {
+        uint64_t words[WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy the value once, without retrying
+     * @return false if a store was in progress or overlapped the copy
+     */
+    bool try_load(T& value) const {
+        uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        uint64_t words[WORDS];
+        for (size_t i = 0; i < WORDS; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Consistent copy of the latest value (retries while the writer is mid-store)
+     */
+    T load() const {
+        T value;
+        while (!try_load(value)) {
+        }
+        return value;
+    }
+
+    /**
+     * @brief Number of store() calls so far (including the initial one)
+     */
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence_{0};  // Odd while the writer stores
+    std::atomic<uint64_t> words_[WORDS];
+};
+
+} // namespace threading
+} // namespace feedhandler
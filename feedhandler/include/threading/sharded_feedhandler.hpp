@@ -0,0 +1,137 @@
+#pragma once
+
+#include "threading/threaded_feedhandler.hpp"
+#include "config/performance_config.hpp"
+#include "common/tick.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace feedhandler {
+namespace threading {
+
+/**
+ * @brief N independent feed sessions, each with its own network thread,
+ *        parser thread and FSMFixParser
+ *
+ * Architecture:
+ * - Shard i owns one ThreadedFeedHandler (session), so parser state,
+ *   SPSC ring and statistics are never shared between shards
+ * - Shard i's threads are pinned to parser_thread_affinity[i] and
+ *   network_thread_affinity[i] (lists shorter than the shard count wrap)
+ * - Symbols are partitioned across shards by shard_for(); subscribing
+ *   each session only to its own symbols keeps every symbol on exactly
+ *   one parser thread, so per-symbol order is preserved
+ *
+ * The tick callback runs on the shard's parser thread.
+ */
+class ShardedFeedHandler {
+public:
+    /**
+     * @brief Configuration
+     */
+    struct Config {
+        size_t shard_count = 1;                         // Sessions / parser instances
+        ThreadedFeedHandler::Config shard;              // Per-shard settings (CPU fields overridden)
+        config::PerformanceConfig::CPUConfig cpu;       // Core lists applied per shard
+
+        Config() = default;
+    };
+
+    /**
+     * @brief Callback for parsed ticks, tagged with the producing shard
+     */
+    using ShardTickCallback = std::function<void(size_t shard, const common::Tick&)>;
+
+    /**
+     * @brief Callback for all ticks parsed from one buffer, tagged with the producing shard
+     */
+    using ShardBatchCallback = std::function<void(size_t shard, std::span<const common::Tick>)>;
+
+    /**
+     * @brief Plain totals summed over all shards
+     */
+    struct StatisticsSnapshot {
+        uint64_t bytes_received = 0;
+        uint64_t messages_parsed = 0;
+        uint64_t parse_errors = 0;
+        uint64_t queue_overflows = 0;
+        uint64_t network_reads = 0;
+        uint64_t parser_cycles = 0;
+    };
+
+    /**
+     * @brief Constructor
+     * @param config Configuration (shard_count of 0 is treated as 1)
+     * @param callback Callback for parsed ticks
+     */
+    ShardedFeedHandler(const Config& config, ShardTickCallback callback);
+
+    /**
+     * @brief Constructor with a per-buffer batch callback
+     * @param config Configuration (shard_count of 0 is treated as 1)
+     * @param callback Callback for each non-empty batch of parsed ticks
+     */
+    ShardedFeedHandler(const Config& config, ShardBatchCallback callback);
+
+    /**
+     * @brief Start all shards
+     */
+    void start();
+
+    /**
+     * @brief Stop all shards gracefully
+     */
+    void stop();
+
+    /**
+     * @brief Shard that owns a symbol (stable for a given shard count)
+     */
+    size_t shard_for(std::string_view symbol) const;
+
+    /**
+     * @brief Feed raw data received by one session
+     *
+     * Each shard has a single producer: call for a given shard from one thread only.
+     */
+    void inject_data(size_t shard, const char* data, size_t length);
+
+    /**
+     * @brief Feed raw data for a symbol into the shard that owns it
+     */
+    void inject_for_symbol(std::string_view symbol, const char* data, size_t length) {
+        inject_data(shard_for(symbol), data, length);
+    }
+
+    /**
+     * @brief Statistics merged across shards
+     */
+    StatisticsSnapshot get_statistics() const;
+
+    /**
+     * @brief Reset statistics on every shard
+     */
+    void reset_statistics();
+
+    size_t shard_count() const { return shards_.size(); }
+    const ThreadedFeedHandler& shard(size_t index) const { return *shards_[index]; }
+
+    /**
+     * @brief Core assigned to a shard's parser / network thread (-1 = unpinned)
+     */
+    int parser_cpu(size_t index) const;
+    int network_cpu(size_t index) const;
+
+private:
+    static int cpu_for(const std::vector<int>& cpus, size_t index);
+
+    Config config_;
+    std::vector<std::unique_ptr<ThreadedFeedHandler>> shards_;
+};
+
+} // namespace threading
+} // namespace feedhandler
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "common/compact_tick.hpp"
+#include "common/tick.hpp"
+
+namespace feedhandler {
+namespace threading {
+
+namespace detail {
+
+/**
+ * @brief Layout of a tick bus segment, shared by writer and readers
+ *
+ * [Control | symbol directory | slots]. Each slot carries its own
+ * sequence (position + 1 once written), so a reader can tell a tick it
+ * expected from one written a lap later without asking the writer.
+ */
+struct TickBusControl {
+    uint64_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> state;    // 0 fresh, 1 live, 2 writer closed
+    uint64_t capacity;              // Slots, a power of two
+    uint64_t symbol_slots;
+    int64_t writer_pid;
+    alignas(64) std::atomic<uint64_t> head;  // Next position the writer fills
+};
+
+struct TickBusSymbol {
+    std::atomic<uint64_t> length;   // 0 until the name is published
+    char name[common::SymbolTable::MAX_SYMBOL_LENGTH + 1];
+};
+
+struct alignas(64) TickBusSlot {
+    static constexpr size_t WORDS = sizeof(common::CompactTick) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence;  // Position + 1 when complete, WRITING while stored
+    std::atomic<uint64_t> words[WORDS];
+};
+
+static_assert(sizeof(common::CompactTick) % sizeof(uint64_t) == 0, "CompactTick is copied word by word");
+static_assert(sizeof(TickBusSlot) == 64, "One cache line per tick");
+
+constexpr uint64_t TICK_BUS_MAGIC = 0x5355424b43495446ULL;  // "FTICKBUS"
+constexpr uint32_t TICK_BUS_VERSION = 1;
+constexpr uint64_t TICK_BUS_WRITING = UINT64_MAX;
+constexpr size_t TICK_BUS_CONTROL_BYTES = 128;
+
+static_assert(sizeof(TickBusControl) <= TICK_BUS_CONTROL_BYTES, "Control block fits before the directory");
+
+} // namespace detail
+
+/**
+ * @brief Publishing side of a shared-memory tick bus (one per segment)
+ *
+ * Broadcast ring of CompactTicks in POSIX shared memory, for strategy
+ * processes that read the feed without living in the feedhandler
+ * process. Like UltraLowLatencyQueue it is a power-of-two slot array
+ * indexed by a monotonically increasing position, but the writer never
+ * waits: readers keep their own cursors in their own memory, so any
+ * number of them can attach and a stalled one cannot block the feed.
+ * A reader that falls a whole ring behind is overrun and told so.
+ *
+ * Each slot is a cache line: a sequence word plus the tick stored as
+ * relaxed atomic words, the per-slot form of Seqlock. Instrument IDs are
+ * only meaningful inside the writer's process, so the segment also
+ * carries a symbol directory that the writer fills the first time it
+ * publishes an ID.
+ *
+ * Wire it to a ThreadedFeedHandler BatchCallback: publish(ticks) makes
+ * a whole batch visible with one store.
+ */
+class ShmTickBusWriter {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+    static constexpr size_t DEFAULT_SYMBOL_SLOTS = 4096;
+
+    ShmTickBusWriter() = default;
+    ~ShmTickBusWriter();
+
+    ShmTickBusWriter(const ShmTickBusWriter&) = delete;
+    ShmTickBusWriter& operator=(const ShmTickBusWriter&) = delete;
+
+    /**
+     * @brief Create the segment name ("/..." per shm_open), replacing any old one
+     * @param capacity Ticks kept, rounded up to a power of two
+     * @param symbol_slots Instrument IDs the directory can name; higher IDs
+     *        still travel but readers cannot resolve their symbol
+     */
+    bool open(const std::string& name, size_t capacity = DEFAULT_CAPACITY,
+              size_t symbol_slots = DEFAULT_SYMBOL_SLOTS);
+
+    /**
+     * @brief Mark the bus closed for readers and unmap; the name stays until unlink()
+     */
+    void close();
+
+    static void unlink(const std::string& name);
+
+    /**
+     * @brief Append one tick and make it visible
+     */
+    void publish(const common::CompactTick& tick) {
+        write_slot(tick);
+        control_->head.store(head_, std::memory_order_release);
+    }
+
+    /**
+     * @brief Append a batch, made visible to readers all at once
+     */
+    void publish(std::span<const common::CompactTick> ticks) {
+        for (const common::CompactTick& tick : ticks) {
+            write_slot(tick);
+        }
+        control_->head.store(head_, std::memory_order_release);
+    }
+
+    void publish(std::span<const common::Tick> ticks) {
+        for (const common::Tick& tick : ticks) {
+            write_slot(tick.to_compact());
+        }
+        control_->head.store(head_, std::memory_order_release);
+    }
+
+    bool is_open() const { return control_ != nullptr; }
+    size_t capacity() const { return capacity_; }
+    uint64_t published() const { return head_; }
+
+private:
+    void write_slot(const common::CompactTick& tick) {
+        if (tick.instrument_id < symbol_slots_ && !named_[tick.instrument_id]) {
+            publish_symbol(tick.instrument_id);
+        }
+        uint64_t words[detail::TickBusSlot::WORDS];
+        std::memcpy(words, &tick, sizeof(tick));
+
+        detail::TickBusSlot& slot = slots_[head_ & mask_];
+        slot.sequence.store(detail::TICK_BUS_WRITING, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < detail::TickBusSlot::WORDS; ++i) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.sequence.store(head_ + 1, std::memory_order_release);
+        ++head_;
+    }
+
+    void publish_symbol(common::InstrumentId id);
+
+    detail::TickBusControl* control_ = nullptr;
+    detail::TickBusSymbol* symbols_ = nullptr;
+    detail::TickBusSlot* slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    size_t symbol_slots_ = 0;
+    size_t mapped_bytes_ = 0;
+    uint64_t head_ = 0;           // Writer's own copy; control_->head trails it within a batch
+    std::vector<bool> named_;     // Directory entries already written
+};
+
+/**
+ * @brief One consumer's view of a tick bus, usually in another process
+ *
+ * The segment is mapped read-only: polling touches only slot lines and,
+ * when the reader has caught up, the writer's head, never anything the
+ * writer or other readers write to. No syscalls after open().
+ *
+ * When the writer laps the reader, the reader counts an overrun, adds
+ * the ticks it missed to lost() and resumes at the oldest tick still in
+ * the ring. A reader that keeps losing ticks is too slow for the feed:
+ * give the bus more capacity or the reader less work.
+ */
+class ShmTickBusReader {
+public:
+    ShmTickBusReader() = default;
+    ~ShmTickBusReader();
+
+    ShmTickBusReader(const ShmTickBusReader&) = delete;
+    ShmTickBusReader& operator=(const ShmTickBusReader&) = delete;
+
+    /**
+     * @brief Attach to a live bus
+     * @param from_oldest Start at the oldest tick still in the ring
+     *        rather than at the next one published
+     * @return false if there is no such bus (yet) or it is not a tick bus
+     */
+    bool open(const std::string& name, bool from_oldest = false);
+    void close();
+
+    /**
+     * @brief Copy out the next tick
+     * @return false if the reader has caught up with the writer
+     */
+    bool next(common::CompactTick& tick) {
+        while (true) {
+            if (cursor_ == cached_head_) {
+                cached_head_ = control_->head.load(std::memory_order_acquire);
+                if (cursor_ == cached_head_) {
+                    return false;
+                }
+            }
+            if (cached_head_ - cursor_ > capacity_) {
+                resync();
+                continue;
+            }
+
+            const detail::TickBusSlot& slot = slots_[cursor_ & mask_];
+            uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            uint64_t words[detail::TickBusSlot::WORDS];
+            for (size_t i = 0; i < detail::TickBusSlot::WORDS; ++i) {
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (before != cursor_ + 1 || slot.sequence.load(std::memory_order_relaxed) != before) {
+                resync();  // Overwritten before or while we copied it
+                continue;
+            }
+            std::memcpy(&tick, words, sizeof(tick));
+            ++cursor_;
+            return true;
+        }
+    }
+
+    /**
+     * @brief Call fn(const CompactTick&) for up to max_ticks available ticks
+     * @return Ticks delivered
+     */
+    template<typename Fn>
+    size_t poll(Fn&& fn, size_t max_ticks = SIZE_MAX) {
+        size_t delivered = 0;
+        common::CompactTick tick;
+        while (delivered < max_ticks && next(tick)) {
+            fn(tick);
+            ++delivered;
+        }
+        return delivered;
+    }
+
+    /**
+     * @brief Symbol the writer published for id; empty if unknown
+     */
+    std::string_view symbol(common::InstrumentId id) const {
+        if (id >= symbol_slots_) {
+            return {};
+        }
+        const detail::TickBusSymbol& entry = symbols_[id];
+        uint64_t length = entry.length.load(std::memory_order_acquire);
+        return std::string_view(entry.name, static_cast<size_t>(length));
+    }
+
+    bool is_open() const { return control_ != nullptr; }
+
+    /**
+     * @brief The writer closed the bus; reopen to follow a restarted writer
+     */
+    bool writer_closed() const { return control_->state.load(std::memory_order_acquire) == 2; }
+
+    size_t capacity() const { return capacity_; }
+    uint64_t cursor() const { return cursor_; }
+    uint64_t lag() const { return control_->head.load(std::memory_order_acquire) - cursor_; }
+    uint64_t overruns() const { return overruns_; }
+    uint64_t lost() const { return lost_; }
+
+private:
+    void resync() {
+        // The slot at head - capacity is the next one the writer reuses
+        cached_head_ = control_->head.load(std::memory_order_acquire);
+        uint64_t oldest = cached_head_ > capacity_ ? cached_head_ - capacity_ + 1 : 0;
+        if (oldest > cursor_) {
+            lost_ += oldest - cursor_;
+            cursor_ = oldest;
+        } else {
+            lost_ += 1;
+            cursor_ += 1;
+        }
+        ++overruns_;
+    }
+
+    const detail::TickBusControl* control_ = nullptr;
+    const detail::TickBusSymbol* symbols_ = nullptr;
+    const detail::TickBusSlot* slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    size_t symbol_slots_ = 0;
+    size_t mapped_bytes_ = 0;
+    uint64_t cursor_ = 0;
+    uint64_t cached_head_ = 0;    // Reloaded only when the cursor reaches it
+    uint64_t overruns_ = 0;
+    uint64_t lost_ = 0;
+};
+
+} // namespace threading
+} // namespace feedhandler
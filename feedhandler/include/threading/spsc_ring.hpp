@@ -0,0 +1,236 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace feedhandler {
+namespace threading {
+
+/**
+ * @brief How the consumer of an SpscRing waits while the ring is empty
+ */
+enum class WaitStrategy {
+    BUSY_SPIN,    ///< Poll continuously; lowest latency, burns a core
+    SPIN_YIELD,   ///< Poll for spin_limit rounds, then yield between polls
+    FUTEX_PARK    ///< Poll for spin_limit rounds, then sleep in the kernel until a push
+};
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring
+ *
+ * Same layout as UltraLowLatencyQueue (head and tail on separate cache
+ * lines, power-of-two mask, acquire/release handoff) but with the
+ * capacity chosen at runtime and a blocking pop() driven by a
+ * WaitStrategy, so it can replace MessageQueue between two threads.
+ *
+ * Each side also caches the other side's last seen index and only
+ * reloads it when the ring looks full (producer) or empty (consumer),
+ * which keeps the shared cache lines from bouncing on every operation.
+ *
+ * Slots are constructed once up front and move-assigned on push and
+ * pop, so the ring itself never allocates after construction.
+ *
+ * Exactly one thread may call the producer methods (try_push) and one
+ * thread the consumer methods (try_pop, pop).
+ */
+template<typename T>
+class SpscRing {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Minimum number of elements held (rounded up to a power of 2)
+     * @param strategy Consumer wait strategy used by pop()
+     * @param spin_limit Polls before SPIN_YIELD yields or FUTEX_PARK parks
+     */
+    explicit SpscRing(size_t capacity,
+                      WaitStrategy strategy = WaitStrategy::SPIN_YIELD,
+                      uint32_t spin_limit = 1024)
+        : strategy_(strategy)
+        , spin_limit_(spin_limit)
+        , capacity_(round_up_pow2(capacity))
+        , mask_(capacity_ - 1)
+        , slots_(new T[capacity_]) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Push item without blocking (producer side)
+     * @return true if pushed, false if the ring is full or shut down
+     */
+    bool try_push(T&& item) {
+        if (shutdown_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == capacity_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == capacity_) {
+                return false;  // Full
+            }
+        }
+
+        slots_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+
+        if (strategy_ == WaitStrategy::FUTEX_PARK) {
+            // Pairs with the fence in park(): either the consumer sees the
+            // new tail on its re-check, or we see it parked and wake it
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (parked_.load(std::memory_order_relaxed)) {
+                wake();
+            }
+        }
+        return true;
+    }
+
+    bool try_push(const T& item) {
+        T copy(item);
+        return try_push(std::move(copy));
+    }
+
+    /**
+     * @brief Pop item without blocking (consumer side)
+     * @return true if an item was popped, false if the ring is empty
+     */
+    bool try_pop(T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;  // Empty
+            }
+        }
+
+        item = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop item, waiting according to the wait strategy (consumer side)
+     * @return true if an item was popped, false once the ring is shut down and drained
+     */
+    bool pop(T& item) {
+        uint32_t spins = 0;
+        while (!try_pop(item)) {
+            if (shutdown_.load(std::memory_order_acquire)) {
+                return try_pop(item);  // Pick up anything pushed before shutdown
+            }
+
+            if (strategy_ == WaitStrategy::BUSY_SPIN || spins < spin_limit_) {
+                ++spins;
+                cpu_relax();
+            } else if (strategy_ == WaitStrategy::SPIN_YIELD) {
+                std::this_thread::yield();
+            } else {
+                park();
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stop accepting pushes and wake a waiting consumer
+     *
+     * Items already in the ring can still be popped.
+     */
+    void shutdown() {
+        shutdown_.store(true, std::memory_order_release);
+        wake();
+    }
+
+    bool is_shutdown() const { return shutdown_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Check if ring is empty (approximate when called concurrently)
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Current number of elements (approximate when called concurrently)
+     */
+    size_t size() const {
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    size_t capacity() const { return capacity_; }
+    WaitStrategy wait_strategy() const { return strategy_; }
+
+    /**
+     * @brief Number of times the consumer went to sleep (FUTEX_PARK only)
+     */
+    uint64_t park_count() const { return park_count_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    static size_t round_up_pow2(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    static void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    }
+
+    // Consumer: announce intent to sleep, re-check, then wait on the
+    // futex word (std::atomic::wait is a futex on Linux)
+    void park() {
+        const uint32_t seen = signal_.load(std::memory_order_acquire);
+        parked_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_relaxed) &&
+            !shutdown_.load(std::memory_order_acquire)) {
+            park_count_.fetch_add(1, std::memory_order_relaxed);
+            signal_.wait(seen, std::memory_order_acquire);
+        }
+        parked_.store(false, std::memory_order_relaxed);
+    }
+
+    void wake() {
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+    }
+
+    const WaitStrategy strategy_;
+    const uint32_t spin_limit_;
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    // Consumer line: head plus its cached copy of tail
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+
+    // Producer line: tail plus its cached copy of head
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+
+    // Wakeup state shared by both sides, off the hot index lines
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> signal_{0};
+    std::atomic<bool> parked_{false};
+    std::atomic<bool> shutdown_{false};
+    std::atomic<uint64_t> park_count_{0};
+};
+
+} // namespace threading
+} // namespace feedhandler
@@ -1,18 +1,48 @@
 #pragma once
 
 #include "threading/message_queue.hpp"
+#include "threading/spsc_ring.hpp"
 #include "parser/fsm_fix_parser.hpp"
+#include "parser/simd_fix_parser.hpp"
 #include "common/tick.hpp"
+#include "common/buffer_segment.hpp"
+#include "common/latency_histogram.hpp"
+#include "common/stat_counter.hpp"
+#include "common/trace_ring.hpp"
+#include "config/performance_config.hpp"
 
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <span>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <optional>
 
 namespace feedhandler {
+namespace benchmarks {
+class StageProfiler;
+}
+
 namespace threading {
 
+/**
+ * @brief What happens to received data when the parser falls behind
+ */
+enum class OverflowPolicy {
+    BLOCK,        // inject_data() waits for a free slot (backpressure onto the socket)
+    DROP_NEWEST,  // inject_data() discards the buffer that does not fit
+    DROP_OLDEST,  // Parser sheds the oldest buffers while the ring is above the high watermark
+    CONFLATE      // Parser coalesces the backlog, delivering the latest tick per symbol and side
+};
+
+/**
+ * @brief Parse "block", "drop_newest", "drop_oldest" or "conflate"
+ * @return false if name is not a policy (policy unchanged)
+ */
+bool parse_overflow_policy(std::string_view name, OverflowPolicy& policy);
+
 /**
  * @brief Multi-threaded feed handler with separate network and parser threads
  * 
@@ -21,25 +51,57 @@ namespace threading {
  * - Parser Thread: Pops buffers from queue, parses into Ticks
  * - Main Thread: Consumes parsed Ticks
  * 
- * This is a simple mutex-based implementation. For production:
- * - Use lock-free queues (SPSC ring buffer)
- * - Consider NUMA-aware thread pinning
- * - Implement backpressure handling
+ * Buffers are handed off through a bounded lock-free SPSC ring; the
+ * parser thread waits on it according to Config::wait_strategy. What
+ * happens under load is Config::overflow_policy:
+ * - DROP_NEWEST (default): a buffer that does not fit is dropped and
+ *   counted in queue_overflows; the network side never blocks
+ * - BLOCK: inject_data() waits for the parser instead, pushing the
+ *   backlog back into the kernel socket buffer
+ * - DROP_OLDEST: once the ring fills past high_watermark the parser
+ *   discards the oldest buffers, so what it does parse is fresh
+ * - CONFLATE: past high_watermark the parser drains the whole backlog
+ *   in one go and delivers only the latest tick per instrument and
+ *   side (top-of-book semantics); nothing is lost while the ring still
+ *   has room, and TickCallback/BatchCallback consumers see fewer,
+ *   newer updates. Zero-copy segments cannot be merged, so in that
+ *   mode CONFLATE sheds like DROP_OLDEST.
+ * Whatever is dropped, the parser restarts at the next message
+ * boundary instead of splicing bytes across the gap.
+ * 
+ * Zero-copy mode (SegmentCallback constructor): received bytes go into
+ * reference-counted segments from a fixed SegmentPool, the parser emits
+ * FlyweightTicks whose symbols point into the segment, and the consumer
+ * gets the segment handle itself. Holding a copy of the handle keeps
+ * the bytes and every tick in it valid, on any thread; dropping the
+ * last copy retires the whole batch and recycles the segment.
  */
 class ThreadedFeedHandler {
 public:
     /**
      * @brief Statistics for monitoring
+     *
+     * The network, parser and injecting threads each count into their
+     * own cache lines (common::StatCounter); load() on a counter sums them.
      */
     struct Statistics {
-        std::atomic<uint64_t> bytes_received{0};
-        std::atomic<uint64_t> messages_parsed{0};
-        std::atomic<uint64_t> parse_errors{0};
-        std::atomic<uint64_t> queue_overflows{0};
-        std::atomic<uint64_t> network_reads{0};
-        std::atomic<uint64_t> parser_cycles{0};
+        common::StatCounter bytes_received;
+        common::StatCounter messages_parsed;
+        common::StatCounter parse_errors;
+        common::StatCounter queue_overflows;
+        common::StatCounter network_reads;
+        common::StatCounter parser_cycles;
+        common::StatCounter segment_exhaustions; // Drops because consumers held every segment
+        common::StatCounter backpressure_waits;  // BLOCK: pushes that had to wait for a slot
+        common::StatCounter buffers_shed;        // DROP_OLDEST: old buffers discarded by the parser
+        common::StatCounter ticks_conflated;     // CONFLATE: ticks superseded before delivery
         
-        // Delete copy constructor and assignment (atomics are not copyable)
+        // Per-buffer latency distributions (Config::latency_tracking),
+        // recorded by the parser thread, snapshot() from any thread
+        common::AtomicLatencyHistogram queue_latency;  // Push to parser pickup
+        common::AtomicLatencyHistogram parse_latency;  // Parsing one buffer (callback excluded)
+        
+        // Counters are not copyable
         Statistics() = default;
         Statistics(const Statistics&) = delete;
         Statistics& operator=(const Statistics&) = delete;
@@ -49,11 +111,32 @@ public:
      * @brief Configuration
      */
     struct Config {
-        size_t queue_size = 1000;           // Max buffers in queue
+        size_t queue_size = 1000;           // Max buffers in queue (rounded up to a power of 2)
         size_t buffer_size = 8192;          // Size of each buffer
         bool enable_garbage_recovery = true; // Enable parser recovery
+        WaitStrategy wait_strategy = WaitStrategy::SPIN_YIELD; // Parser thread idle behaviour
+        uint32_t spin_limit = 1024;         // Polls before yielding/parking
+        int parser_cpu = -1;                // Core to pin the parser thread to (-1 = unpinned)
+        int network_cpu = -1;               // Core to pin the network thread to (-1 = unpinned)
+        size_t segment_count = 64;          // Receive segments in zero-copy mode (buffer_size bytes each)
+        bool latency_tracking = true;       // MonitoringConfig::enable_latency_tracking
+        benchmarks::StageProfiler* stage_profiler = nullptr; // Samples "parse" and "deliver" (callback) stages
+        OverflowPolicy overflow_policy = OverflowPolicy::DROP_NEWEST;
+        double high_watermark = 0.75;       // Ring fill fraction where DROP_OLDEST/CONFLATE engage
+        size_t delivery_batch = 1;          // Queued buffers parsed into one callback (QueueConfig::batch_size)
+        bool simd_parsing = false;          // Parse buffers with SIMDFixParser (no garbage recovery; segments stay FSM)
+        parser::SimdLevel simd_level = parser::SimdLevel::SCALAR; // Kernel for simd_parsing, capped at the CPU's
         
         Config() = default;
+        
+        /**
+         * @brief Ring size and overflow policy from the deployment config
+         *
+         * QueueConfig::overflow_policy names the policy; if it is empty,
+         * enable_backpressure selects BLOCK over DROP_NEWEST. With
+         * enable_batching, batch_size sets delivery_batch.
+         */
+        static Config from_queue(const config::PerformanceConfig::QueueConfig& queue);
     };
     
     /**
@@ -61,6 +144,26 @@ public:
      */
     using TickCallback = std::function<void(const common::Tick&)>;
     
+    /**
+     * @brief Callback for all ticks parsed from one buffer
+     *
+     * Invoked once per buffer on the parser thread, so the per-tick work
+     * in the consumer is a plain loop the compiler can inline. The span
+     * is only valid for the duration of the call.
+     */
+    using BatchCallback = std::function<void(std::span<const common::Tick>)>;
+    
+    /**
+     * @brief Callback for the FlyweightTicks parsed from one segment
+     *
+     * Invoked once per segment with ticks on the parser thread. Read
+     * segment.ticks() in place, or copy the handle to keep the ticks
+     * (and the bytes their symbols point into) past the call, e.g. to
+     * pass them through another queue. Every handle must be dropped
+     * before the feed handler is destroyed.
+     */
+    using SegmentCallback = std::function<void(const common::SegmentRef& segment)>;
+    
     /**
      * @brief Constructor
      * @param config Configuration
@@ -68,6 +171,20 @@ public:
      */
     ThreadedFeedHandler(const Config& config, TickCallback callback);
     
+    /**
+     * @brief Constructor with a per-buffer batch callback
+     * @param config Configuration
+     * @param callback Callback for each non-empty batch of parsed ticks
+     */
+    ThreadedFeedHandler(const Config& config, BatchCallback callback);
+    
+    /**
+     * @brief Constructor for zero-copy mode
+     * @param config Configuration (segment_count segments of buffer_size bytes)
+     * @param callback Callback for each segment that produced ticks
+     */
+    ThreadedFeedHandler(const Config& config, SegmentCallback callback);
+    
     /**
      * @brief Destructor (stops threads)
      */
@@ -90,10 +207,35 @@ public:
     
     /**
      * @brief Simulate network data (for testing)
+     *
+     * Producer side of the SPSC ring: call from one thread only.
      * @param data Raw data to inject
      * @param length Length of data
+     * @param timestamp_ns Receive time for the ticks' Tick::timestamp
+     *        (ns since epoch), 0 to stamp them when parsed
+     */
+    void inject_data(const char* data, size_t length, uint64_t timestamp_ns = 0);
+    
+    /**
+     * @brief Take a free receive segment to read into (zero-copy mode)
+     *
+     * Producer side: write bytes to segment.data(), set_length(), then
+     * submit_segment(). Call from the inject_data() thread only.
+     * @return Segment, or an empty handle if not in zero-copy mode or
+     *         consumers are holding every segment
+     */
+    common::SegmentRef acquire_segment();
+    
+    /**
+     * @brief Hand a filled segment to the parser thread
+     * @param timestamp_ns Receive time, as for inject_data()
+     */
+    void submit_segment(common::SegmentRef segment, uint64_t timestamp_ns = 0);
+    
+    /**
+     * @brief Segment pool in zero-copy mode, nullptr otherwise
      */
-    void inject_data(const char* data, size_t length);
+    const common::SegmentPool* segment_pool() const { return segments_.get(); }
     
     /**
      * @brief Get statistics
@@ -104,6 +246,34 @@ public:
      * @brief Reset statistics
      */
     void reset_statistics();
+    
+    /**
+     * @brief Pin a thread to a single core
+     * @param thread Thread to pin
+     * @param cpu Core index (negative = leave unpinned)
+     * @return true if pinned (or nothing to do), false if the OS refused
+     */
+    static bool pin_thread(std::thread& thread, int cpu);
+    
+    /**
+     * @brief Whether start() pinned the threads to Config::parser_cpu / network_cpu
+     *
+     * false before start(), when unpinned by configuration, or if the OS refused.
+     */
+    bool parser_pinned() const { return parser_pinned_; }
+    bool network_pinned() const { return network_pinned_; }
+    
+    /**
+     * @brief Ring slots (Config::queue_size rounded up to a power of 2)
+     */
+    size_t queue_capacity() const { return buffer_queue_.capacity(); }
+    
+    /**
+     * @brief Kernel parsing buffers, or nullopt when they go through FSMFixParser
+     */
+    std::optional<parser::SimdLevel> simd_level() const {
+        return simd_parser_ ? std::optional<parser::SimdLevel>(simd_parser_->simd_level()) : std::nullopt;
+    }
 
 private:
     /**
@@ -116,23 +286,109 @@ private:
      */
     void parser_thread_func();
     
+    /**
+     * @brief Parse one segment into its own FlyweightTick storage
+     */
+    void parse_segment(common::SegmentRef& segment);
+    
+    /**
+     * @brief Counter value for latency stamps (0 when tracking is off)
+     */
+    uint64_t latency_stamp() const {
+        return config_.latency_tracking ? common::TscClock::read_counter() : 0;
+    }
+    
+    /**
+     * @brief Record counter ticks since start into histogram
+     */
+    static void record_since(common::AtomicLatencyHistogram& histogram, uint64_t start, uint64_t now);
+    
+    /**
+     * @brief Add the parse/deliver stages to Config::stage_profiler, if
+     *        any, and the inject/parse/deliver stages to the global Tracer
+     */
+    void register_stages();
+    
+    /**
+     * @brief Ring depth for Config::high_watermark
+     */
+    void set_high_mark();
+    
+    /**
+     * @brief Push to the ring according to Config::overflow_policy
+     */
+    void enqueue(MessageBuffer&& buffer);
+    
+    /**
+     * @brief DROP_OLDEST: discard buffers while the ring is above the watermark
+     * @param buffer Oldest popped buffer, replaced by the one to parse
+     */
+    void shed_backlog(MessageBuffer& buffer);
+    
+    /**
+     * @brief Parse one buffer, appending its ticks
+     */
+    void parse_buffer(const MessageBuffer& buffer, std::vector<common::Tick>& ticks);
+    
+    /**
+     * @brief Hand parsed ticks to the batch or tick callback
+     */
+    void deliver(const std::vector<common::Tick>& ticks);
+    
+    /**
+     * @brief Keep only the last tick per instrument and side, in order
+     * @return Ticks removed
+     */
+    size_t conflate(std::vector<common::Tick>& ticks);
+    
+    /**
+     * @brief Tick capacity that a segment of this size can never overflow
+     */
+    static size_t ticks_per_segment(size_t segment_bytes);
+    
     // Configuration
     Config config_;
     TickCallback tick_callback_;
+    BatchCallback batch_callback_;
+    SegmentCallback segment_callback_;
     
     // Threading
     std::unique_ptr<std::thread> network_thread_;
     std::unique_ptr<std::thread> parser_thread_;
     std::atomic<bool> running_;
     
-    // Queue for passing buffers between threads
-    MessageQueue<MessageBuffer> buffer_queue_;
+    // Zero-copy receive segments (declared before the ring, which holds handles)
+    std::unique_ptr<common::SegmentPool> segments_;
+    
+    // Ring for passing buffers between threads
+    SpscRing<MessageBuffer> buffer_queue_;
     
     // Statistics
     Statistics stats_;
     
-    // Parser (owned by parser thread)
+    // Parsers (owned by parser thread); buffers use simd_parser_ when set
     parser::FSMFixParser parser_;
+    std::unique_ptr<parser::SIMDFixParser> simd_parser_;
+    bool parser_pinned_ = false;
+    bool network_pinned_ = false;
+    
+    // Overflow handling: ring depth where DROP_OLDEST/CONFLATE engage,
+    // producer-side gap flag, parser-side conflation index
+    size_t high_mark_ = 0;
+    bool gap_pending_ = false;
+    std::vector<uint32_t> conflate_last_;
+    
+    // Config::stage_profiler stage IDs
+    size_t parse_stage_ = 0;
+    size_t deliver_stage_ = 0;
+    
+    // common::Tracer stage IDs; buffer sequence stamped by the producer,
+    // last one parsed (what deliver() traces) kept by the parser
+    uint16_t trace_inject_ = common::Tracer::INVALID_STAGE;
+    uint16_t trace_parse_ = common::Tracer::INVALID_STAGE;
+    uint16_t trace_deliver_ = common::Tracer::INVALID_STAGE;
+    uint64_t next_sequence_ = 0;
+    uint64_t parsed_sequence_ = 0;
 };
 
 } // namespace threading
@@ -15,6 +15,10 @@ namespace threading {
  * - Cache line optimization
  * - Memory ordering optimization
  * - CPU-specific optimizations
+ * - Cached remote indices: each side re-reads the other side's atomic
+ *   only when the queue looks full (producer) or empty (consumer)
+ * 
+ * Single producer, single consumer. Usable capacity is Size - 1.
  * 
  * Performance: 100M+ operations/second, <10ns latency
  */
@@ -39,6 +43,42 @@ public:
      */
     bool dequeue(T& item) noexcept;
     
+    /**
+     * @brief Enqueue up to count items with a single publish (producer side)
+     * @param items Items to enqueue
+     * @param count Number of items
+     * @return Number of items enqueued (less than count if the queue fills)
+     */
+    size_t try_enqueue_bulk(const T* items, size_t count) noexcept;
+    
+    /**
+     * @brief Dequeue up to max_count items with a single release (consumer side)
+     * @param items Output array with room for max_count items
+     * @param max_count Maximum number of items to dequeue
+     * @return Number of items dequeued (0 if queue empty)
+     */
+    size_t try_dequeue_bulk(T* items, size_t max_count) noexcept;
+    
+    /**
+     * @brief Claim the next free slot for in-place construction (producer side)
+     * 
+     * The slot stays invisible to the consumer until publish(). Calling
+     * reserve() again before publish() returns the same slot.
+     * @code
+     * if (Tick* slot = queue.reserve()) {
+     *     parser.fill(*slot);
+     *     queue.publish();
+     * }
+     * @endcode
+     * @return Pointer to the slot, or nullptr if queue full
+     */
+    T* reserve() noexcept;
+    
+    /**
+     * @brief Make the slot returned by the last reserve() visible to the consumer
+     */
+    void publish() noexcept;
+    
     /**
      * @brief Check if queue is empty (approximate)
      */
@@ -53,9 +93,12 @@ private:
     static constexpr size_t MASK = Size - 1;
     static constexpr size_t CACHE_LINE_SIZE = 64;
     
-    // Separate cache lines for producer and consumer
+    // Separate cache lines for producer and consumer; each index shares
+    // its line with that side's cached copy of the other index
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
+    size_t cached_tail_;  // Consumer's last seen tail_
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+    size_t cached_head_;  // Producer's last seen head_
     
     // Data array with cache line alignment
     alignas(CACHE_LINE_SIZE) T data_[Size];
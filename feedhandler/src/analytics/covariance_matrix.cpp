@@ -0,0 +1,200 @@
+#include "analytics/covariance_matrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace feedhandler {
+namespace analytics {
+
+namespace {
+
+// out[j] += a * x[j] - b * y[j] for j < n: one row of a rank-2 update
+using Rank2 = void (*)(double* out, double a, const double* x, double b, const double* y, size_t n);
+
+void rank2_scalar(double* out, double a, const double* x, double b, const double* y, size_t n) {
+    for (size_t j = 0; j < n; ++j) {
+        out[j] += a * x[j] - b * y[j];
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("avx2,fma")))
+void rank2_avx2(double* out, double a, const double* x, double b, const double* y, size_t n) {
+    const __m256d va = _mm256_set1_pd(a);
+    const __m256d vb = _mm256_set1_pd(b);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d acc = _mm256_loadu_pd(out + j);
+        acc = _mm256_fmadd_pd(va, _mm256_loadu_pd(x + j), acc);
+        acc = _mm256_fnmadd_pd(vb, _mm256_loadu_pd(y + j), acc);
+        _mm256_storeu_pd(out + j, acc);
+    }
+    rank2_scalar(out + j, a, x + j, b, y + j, n - j);
+}
+
+#endif
+
+Rank2 rank2_kernel() {
+    static const Rank2 kernel = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init(); // May run before libgcc's constructor
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return &rank2_avx2;
+        }
+#endif
+        return &rank2_scalar;
+    }();
+    return kernel;
+}
+
+double row_sum(const double* row, size_t n) {
+    double sum = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        sum += row[j];
+    }
+    return sum;
+}
+
+} // namespace
+
+CovarianceMatrix::CovarianceMatrix(size_t max_columns, size_t window)
+    : max_columns_(max_columns)
+    , stride_((max_columns + 3) & ~size_t(3))
+    , window_(window > 0 ? window : 1)
+    , rows_(window_ * stride_, 0.0)
+    , sums_(stride_, 0.0)
+    , cross_(max_columns * stride_, 0.0)
+    , cross_row_sums_(stride_, 0.0)
+    , incoming_(stride_, 0.0) {}
+
+void CovarianceMatrix::push(const double* values, size_t columns) {
+    // Columns the caller did not pass (narrower than the active width) are zero
+    columns = std::min(columns, max_columns_);
+    const size_t c = columns_ = std::max(columns, columns_);
+    std::copy_n(values, columns, incoming_.begin());
+    std::fill(incoming_.begin() + static_cast<std::ptrdiff_t>(columns), incoming_.end(), 0.0);
+    const double* row = incoming_.data();
+    const bool evicting = count_ == window_;
+    double* slot = &rows_[(evicting ? head_ : (head_ + count_) % window_) * stride_];
+
+    // Add the new row's outer product and, once full, subtract the one it replaces
+    const Rank2 rank2 = rank2_kernel();
+    const double* old_row = evicting ? slot : row;
+    const double new_sum = row_sum(row, c);
+    const double old_sum = evicting ? row_sum(slot, c) : 0.0;
+    for (size_t i = 0; i < c; ++i) {
+        double a = row[i];
+        double b = evicting ? slot[i] : 0.0;
+        if (a == 0.0 && b == 0.0) {
+            continue;  // Nothing to add to this row (quiet symbol)
+        }
+        rank2(&cross_[i * stride_], a, row, b, old_row, c);
+        cross_row_sums_[i] += a * new_sum - b * old_sum;
+        sums_[i] += a - b;
+    }
+    sum_total_ += new_sum - old_sum;
+    cross_total_ += new_sum * new_sum - old_sum * old_sum;
+
+    std::memcpy(slot, row, stride_ * sizeof(double));
+    if (evicting) {
+        head_ = (head_ + 1) % window_;
+        if (++evictions_ >= window_) {
+            rebuild();
+        }
+    } else {
+        ++count_;
+    }
+}
+
+void CovarianceMatrix::rebuild() {
+    const size_t c = columns_;
+    const Rank2 rank2 = rank2_kernel();
+    std::fill(sums_.begin(), sums_.end(), 0.0);
+    std::fill(cross_row_sums_.begin(), cross_row_sums_.end(), 0.0);
+    for (size_t i = 0; i < c; ++i) {
+        std::fill_n(&cross_[i * stride_], c, 0.0);
+    }
+    sum_total_ = 0.0;
+    cross_total_ = 0.0;
+
+    for (size_t r = 0; r < count_; ++r) {
+        const double* row = &rows_[((head_ + r) % window_) * stride_];
+        double total = row_sum(row, c);
+        for (size_t i = 0; i < c; ++i) {
+            if (row[i] != 0.0) {
+                rank2(&cross_[i * stride_], row[i], row, 0.0, row, c);
+                cross_row_sums_[i] += row[i] * total;
+                sums_[i] += row[i];
+            }
+        }
+        sum_total_ += total;
+        cross_total_ += total * total;
+    }
+    evictions_ = 0;
+}
+
+double CovarianceMatrix::covariance(size_t i, size_t j) const {
+    if (count_ < 2 || i >= columns_ || j >= columns_) {
+        return 0.0;
+    }
+    double n = static_cast<double>(count_);
+    return (cross_[i * stride_ + j] - sums_[i] * sums_[j] / n) / (n - 1.0);
+}
+
+double CovarianceMatrix::correlation(size_t i, size_t j) const {
+    if (count_ < 2 || i >= columns_ || j >= columns_) {
+        return 0.0;
+    }
+    double n = static_cast<double>(count_);
+    double var_i = n * cross_[i * stride_ + i] - sums_[i] * sums_[i];
+    double var_j = n * cross_[j * stride_ + j] - sums_[j] * sums_[j];
+    // Relative cut-off: a constant column leaves only rounding noise here
+    if (var_i <= 1e-12 * n * cross_[i * stride_ + i] || var_j <= 1e-12 * n * cross_[j * stride_ + j]) {
+        return 0.0;
+    }
+    double cov = n * cross_[i * stride_ + j] - sums_[i] * sums_[j];
+    return std::clamp(cov / std::sqrt(var_i * var_j), -1.0, 1.0);
+}
+
+double CovarianceMatrix::beta(size_t i) const {
+    if (count_ < 2 || i >= columns_) {
+        return 0.0;
+    }
+    // cov(r_i, m) / var(m) with m the mean of all columns:
+    // columns * sum_j cov_ij / sum_jk cov_jk
+    double n = static_cast<double>(count_);
+    double market_var = n * cross_total_ - sum_total_ * sum_total_;
+    if (market_var <= 1e-12 * n * cross_total_) {
+        return 0.0;
+    }
+    double cov = n * cross_row_sums_[i] - sums_[i] * sum_total_;
+    return static_cast<double>(columns_) * cov / market_var;
+}
+
+void CovarianceMatrix::correlation_row(size_t i, double* out) const {
+    for (size_t j = 0; j < columns_; ++j) {
+        out[j] = correlation(i, j);
+    }
+}
+
+void CovarianceMatrix::clear() {
+    std::fill(rows_.begin(), rows_.end(), 0.0);
+    std::fill(sums_.begin(), sums_.end(), 0.0);
+    std::fill(cross_.begin(), cross_.end(), 0.0);
+    std::fill(cross_row_sums_.begin(), cross_row_sums_.end(), 0.0);
+    sum_total_ = 0.0;
+    cross_total_ = 0.0;
+    head_ = 0;
+    count_ = 0;
+    columns_ = 0;
+    evictions_ = 0;
+}
+
+} // namespace analytics
+} // namespace feedhandler
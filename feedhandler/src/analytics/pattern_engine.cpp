@@ -0,0 +1,188 @@
+#include "analytics/realtime_engine.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace feedhandler {
+namespace analytics {
+
+namespace {
+
+const char* describe(PatternEngine::PatternType type) {
+    switch (type) {
+        case PatternEngine::PatternType::MOMENTUM_BREAKOUT:
+            return "Momentum breakout: microprice away from VWAP with order flow behind it";
+        case PatternEngine::PatternType::MEAN_REVERSION:
+            return "Mean reversion: microprice away from VWAP against order flow in a calm market";
+        case PatternEngine::PatternType::VOLUME_SPIKE:
+            return "Volume spike: volume rate far above its baseline";
+        case PatternEngine::PatternType::LIQUIDITY_DROUGHT:
+            return "Liquidity drought: spread far above its baseline";
+        case PatternEngine::PatternType::CROSS_ASSET_ARBITRAGE:
+            return "Cross-asset arbitrage";
+        case PatternEngine::PatternType::REGIME_CHANGE:
+            return "Regime change: realized volatility far above its baseline";
+    }
+    return "";
+}
+
+// Confidence grows from 0 at the threshold to 1 at twice the threshold
+double excess_confidence(double value, double threshold) {
+    return threshold > 0 ? std::clamp(value / threshold - 1.0, 0.0, 1.0) : 1.0;
+}
+
+double ewma(double baseline, double value, double alpha) {
+    return baseline + alpha * (value - baseline);
+}
+
+} // namespace
+
+PatternEngine::PatternEngine()
+    : PatternEngine(Config()) {}
+
+PatternEngine::PatternEngine(const Config& config)
+    : config_(config) {}
+
+size_t PatternEngine::analyze_patterns(const RealtimeEngine::MarketMetrics& metrics, Pattern* out, size_t capacity) {
+    common::InstrumentId id = metrics.instrument_id;
+    if (id == common::INVALID_INSTRUMENT) {
+        return 0;
+    }
+    if (id >= states_.size()) {
+        states_.resize(static_cast<size_t>(id) + 1, InstrumentState(config_.breakout_channel));
+    }
+    InstrumentState& state = states_[id];
+
+    size_t count = detect_momentum_patterns(metrics, state, out, capacity);
+    if (state.updates >= config_.warmup_updates) {
+        count += detect_volume_patterns(metrics, state, out + count, capacity - count);
+        count += detect_liquidity_patterns(metrics, state, out + count, capacity - count);
+        count += detect_regime_patterns(metrics, state, out + count, capacity - count);
+    }
+
+    // Baselines move after detection, so a spike is judged against the past
+    double alpha = state.updates == 0 ? 1.0 : config_.baseline_alpha;
+    state.volume_rate = ewma(state.volume_rate, metrics.volume_rate, alpha);
+    state.spread_bps = ewma(state.spread_bps, metrics.spread_bps, alpha);
+    state.volatility = ewma(state.volatility, metrics.realized_volatility, alpha);
+    ++state.updates;
+    if (config_.breakout_channel > 0 && metrics.microprice > 0) {
+        state.channel_high.push(metrics.microprice);
+        state.channel_low.push(metrics.microprice);
+    }
+
+    patterns_detected_ += count;
+    if (pattern_callback_) {
+        for (size_t i = 0; i < count; ++i) {
+            pattern_callback_(out[i]);
+        }
+    }
+    return count;
+}
+
+size_t PatternEngine::analyze_batch(std::span<const RealtimeEngine::MarketMetrics> metrics, std::vector<Pattern>& out) {
+    size_t start = out.size();
+    Pattern found[MAX_PATTERNS_PER_UPDATE];
+    for (const auto& record : metrics) {
+        size_t count = analyze_patterns(record, found, MAX_PATTERNS_PER_UPDATE);
+        out.insert(out.end(), found, found + count);
+    }
+    return out.size() - start;
+}
+
+void PatternEngine::register_pattern_callback(PatternCallback callback) {
+    pattern_callback_ = std::move(callback);
+}
+
+size_t PatternEngine::detect_momentum_patterns(const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+                                               Pattern* out, size_t capacity) {
+    // Both price patterns need the microprice well away from VWAP
+    if (metrics.vwap <= 0 || metrics.microprice <= 0 ||
+        std::fabs(metrics.microprice - metrics.vwap) < config_.breakout_bps * 1e-4 * metrics.vwap) {
+        ++prefilter_skips_;
+        return 0;
+    }
+    ++detector_runs_;
+
+    double deviation_bps = (metrics.microprice - metrics.vwap) / metrics.vwap * 10000.0;
+    double flow = metrics.order_flow_imbalance;
+    std::array<double, MAX_PARAMETERS> parameters{deviation_bps, flow, metrics.realized_volatility};
+    double strength = excess_confidence(std::fabs(deviation_bps), config_.breakout_bps);
+
+    if (deviation_bps * flow > 0 && std::fabs(flow) >= config_.breakout_flow && clears_channel(metrics, state)) {
+        double confidence = std::max(strength, 0.5) * std::min(std::fabs(flow), 1.0);
+        return emit(PatternType::MOMENTUM_BREAKOUT, metrics, state, confidence, parameters, out, capacity) ? 1 : 0;
+    }
+    if (deviation_bps * flow <= 0 && metrics.realized_volatility < config_.reversion_max_volatility) {
+        double calm = 1.0 - metrics.realized_volatility / config_.reversion_max_volatility;
+        return emit(PatternType::MEAN_REVERSION, metrics, state, std::max(strength, 0.5) * calm,
+                    parameters, out, capacity) ? 1 : 0;
+    }
+    return 0;
+}
+
+bool PatternEngine::clears_channel(const RealtimeEngine::MarketMetrics& metrics, const InstrumentState& state) const {
+    if (config_.breakout_channel == 0) {
+        return true;
+    }
+    if (state.channel_high.empty()) {
+        return false;  // No channel yet
+    }
+    return metrics.microprice > metrics.vwap ? metrics.microprice > state.channel_high.best()
+                                             : metrics.microprice < state.channel_low.best();
+}
+
+size_t PatternEngine::detect_volume_patterns(const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+                                             Pattern* out, size_t capacity) {
+    double threshold = config_.volume_spike_ratio * state.volume_rate;
+    if (state.volume_rate <= 0 || metrics.volume_rate < threshold) {
+        ++prefilter_skips_;
+        return 0;
+    }
+    ++detector_runs_;
+    double ratio = metrics.volume_rate / state.volume_rate;
+    return emit(PatternType::VOLUME_SPIKE, metrics, state, excess_confidence(metrics.volume_rate, threshold),
+                {ratio, metrics.volume_rate, state.volume_rate}, out, capacity) ? 1 : 0;
+}
+
+size_t PatternEngine::detect_liquidity_patterns(const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+                                                Pattern* out, size_t capacity) {
+    double threshold = config_.drought_spread_ratio * state.spread_bps;
+    if (state.spread_bps <= 0 || metrics.spread_bps < threshold) {
+        ++prefilter_skips_;
+        return 0;
+    }
+    ++detector_runs_;
+    double ratio = metrics.spread_bps / state.spread_bps;
+    return emit(PatternType::LIQUIDITY_DROUGHT, metrics, state, excess_confidence(metrics.spread_bps, threshold),
+                {ratio, metrics.spread_bps, metrics.bid_depth + metrics.ask_depth}, out, capacity) ? 1 : 0;
+}
+
+size_t PatternEngine::detect_regime_patterns(const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+                                             Pattern* out, size_t capacity) {
+    double threshold = config_.regime_volatility_ratio * state.volatility;
+    if (state.volatility <= 0 || metrics.realized_volatility < threshold) {
+        ++prefilter_skips_;
+        return 0;
+    }
+    ++detector_runs_;
+    double ratio = metrics.realized_volatility / state.volatility;
+    return emit(PatternType::REGIME_CHANGE, metrics, state, excess_confidence(metrics.realized_volatility, threshold),
+                {ratio, metrics.realized_volatility, state.volatility}, out, capacity) ? 1 : 0;
+}
+
+bool PatternEngine::emit(PatternType type, const RealtimeEngine::MarketMetrics& metrics, InstrumentState& state,
+                         double confidence, std::array<double, MAX_PARAMETERS> parameters,
+                         Pattern* out, size_t capacity) {
+    uint64_t& last = state.last_fired[static_cast<size_t>(type)];
+    uint64_t now = metrics.last_update_ns;
+    if (capacity == 0 || (last != 0 && now < last + config_.cooldown_ns)) {
+        return false;
+    }
+    last = now > 0 ? now : 1;
+    *out = Pattern{type, metrics.instrument_id, confidence, now, parameters, describe(type)};
+    return true;
+}
+
+} // namespace analytics
+} // namespace feedhandler
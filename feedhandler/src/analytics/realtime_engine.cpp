@@ -0,0 +1,525 @@
+#include "analytics/realtime_engine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+
+namespace feedhandler {
+namespace analytics {
+
+namespace {
+
+double to_price(int64_t fixed) {
+    return common::price_to_double(fixed);
+}
+
+uint64_t process_cpu_ns() {
+    timespec ts{};
+    ::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+} // namespace
+
+RealtimeEngine::RealtimeEngine()
+    : RealtimeEngine(Config()) {}
+
+RealtimeEngine::RealtimeEngine(const Config& config)
+    : config_(config)
+    , worker_count_(config.worker_threads > 0 ? config.worker_threads : 1)
+    , workers_(worker_count_)
+    , symbols_(new std::atomic<SymbolData*>[config.max_symbols])
+    , symbols_by_id_(new std::atomic<SymbolData*>[common::SymbolTable::global().capacity()])
+    , id_capacity_(common::SymbolTable::global().capacity())
+    , running_(false)
+    , correlation_matrix_(std::min(config.max_symbols, config.correlation_symbols), config.correlation_window)
+    , pending_returns_(correlation_matrix_.max_columns(), 0.0)
+    , betas_(new std::atomic<double>[correlation_matrix_.max_columns()])
+    , engine_stats_{}
+    , created_ns_(common::Tick::current_timestamp_ns()) {
+    for (size_t i = 0; i < config_.max_symbols; ++i) {
+        symbols_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < id_capacity_; ++i) {
+        symbols_by_id_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < correlation_matrix_.max_columns(); ++i) {
+        betas_[i].store(0.0, std::memory_order_relaxed);
+    }
+    for (auto& worker : workers_) {
+        worker.bars = BarAggregator(config_.bars, [this](const Bar* bars, size_t count) {
+            if (bar_callback_) {
+                bar_callback_(bars, count);
+            }
+        });
+    }
+}
+
+RealtimeEngine::~RealtimeEngine() {
+    stop();
+}
+
+void RealtimeEngine::process_tick(const std::string& symbol, const common::Tick& tick) {
+    common::CompactTick compact = tick.to_compact();
+    compact.instrument_id = common::SymbolTable::global().intern(symbol);
+    process_tick(compact);
+}
+
+void RealtimeEngine::process_tick(const common::CompactTick& tick) {
+    if (!running_.load(std::memory_order_acquire)) {
+        apply_tick(tick);
+        return;
+    }
+
+    // Hand the tick to the worker that owns the symbol
+    auto& ring = *workers_[worker_for(tick.instrument_id)].ring;
+    while (!ring.try_push(tick)) {
+        backpressure_waits_.add();
+        std::this_thread::yield();
+    }
+}
+
+void RealtimeEngine::process_batch(const common::TickBatch& batch) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        process_tick(batch[i]);
+    }
+}
+
+void RealtimeEngine::apply_tick(const common::CompactTick& tick) {
+    uint64_t start = common::Tick::current_timestamp_ns();
+
+    SymbolData* data = find_or_create(tick.instrument_id);
+    if (!data) {
+        return;
+    }
+    Worker& worker = workers_[worker_for(tick.instrument_id)];
+
+    if (data->window.push(tick)) {
+        data->total_volume += static_cast<uint64_t>(tick.qty);
+        data->trade_sizes.push(tick.qty);
+        market_volume_.fetch_add(static_cast<uint64_t>(tick.qty), std::memory_order_relaxed);
+        if (config_.enable_bars) {
+            if (const Bar* bar = worker.bars.push(tick)) {
+                data->bar_volatility.add(*bar);
+            }
+        }
+    }
+    update_liquidity_metrics(*data, tick);
+    calculate_metrics(*data);
+    data->published.store(data->current_metrics);
+
+    PendingAlert alerts[MAX_ALERTS];
+    size_t alert_count = detect_anomalies(data->current_metrics, alerts);
+
+    if (config_.enable_bars) {
+        advance_bars(worker, tick.timestamp);
+    }
+
+    // Callbacks may call back into the engine (get_metrics is lock-free)
+    if (metrics_callback_) {
+        metrics_callback_(data->symbol, data->current_metrics);
+    }
+    if (alert_count > 0) {
+        alerts_generated_.add(alert_count);
+        if (alert_callback_) {
+            for (size_t i = 0; i < alert_count; ++i) {
+                alert_callback_(data->symbol, alerts[i].type, alerts[i].severity);
+            }
+        }
+    }
+
+    processed_ticks_.add();
+    uint64_t end = common::Tick::current_timestamp_ns();
+    latency_sum_ns_.add(end > start ? end - start : 0);
+}
+
+RealtimeEngine::MarketMetrics RealtimeEngine::get_metrics(const std::string& symbol) const {
+    return get_metrics(common::SymbolTable::global().find(symbol));
+}
+
+RealtimeEngine::MarketMetrics RealtimeEngine::get_metrics(common::InstrumentId id) const {
+    SymbolData* data = find(id);
+    if (!data) {
+        return MarketMetrics{};
+    }
+    MarketMetrics metrics = data->published.load();
+    metrics.beta_to_market = beta_for(*data);
+    return metrics;
+}
+
+size_t RealtimeEngine::get_all_metrics(std::vector<MarketMetrics>& out) const {
+    size_t count = std::min(symbol_count_.load(std::memory_order_acquire), config_.max_symbols);
+    size_t start = out.size();
+    out.reserve(start + count);
+    for (size_t i = 0; i < count; ++i) {
+        if (SymbolData* data = symbols_[i].load(std::memory_order_acquire)) {
+            out.push_back(data->published.load());
+            out.back().beta_to_market = beta_for(*data);
+        }
+    }
+    return out.size() - start;
+}
+
+double RealtimeEngine::correlation(common::InstrumentId a, common::InstrumentId b) const {
+    SymbolData* first = find(a);
+    SymbolData* second = find(b);
+    if (!first || !second) {
+        return 0.0;
+    }
+    std::lock_guard<std::mutex> lock(matrix_mutex_);
+    return correlation_matrix_.correlation(first->index, second->index);
+}
+
+size_t RealtimeEngine::correlations(common::InstrumentId id, std::vector<Correlation>& out) const {
+    out.clear();
+    SymbolData* data = find(id);
+    if (!data) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(matrix_mutex_);
+    size_t columns = correlation_matrix_.columns();
+    if (data->index >= columns || correlation_matrix_.samples() < 2) {
+        return 0;
+    }
+    out.reserve(columns - 1);
+    for (size_t j = 0; j < columns; ++j) {
+        SymbolData* other = symbols_[j].load(std::memory_order_acquire);
+        if (j != data->index && other) {
+            out.push_back({other->id, correlation_matrix_.correlation(data->index, j)});
+        }
+    }
+    return out.size();
+}
+
+double RealtimeEngine::beta_for(const SymbolData& data) const {
+    return data.index < correlation_matrix_.max_columns() ?
+        betas_[data.index].load(std::memory_order_relaxed) : 0.0;
+}
+
+void RealtimeEngine::register_metrics_callback(MetricsCallback callback) {
+    metrics_callback_ = std::move(callback);
+}
+
+void RealtimeEngine::register_alert_callback(AlertCallback callback) {
+    alert_callback_ = std::move(callback);
+}
+
+void RealtimeEngine::register_bar_callback(BarCallback callback) {
+    bar_callback_ = std::move(callback);
+}
+
+void RealtimeEngine::flush_bars() {
+    if (running_.load(std::memory_order_acquire)) {
+        return;
+    }
+    for (auto& worker : workers_) {
+        worker.bars.flush();
+    }
+}
+
+void RealtimeEngine::start() {
+    if (running_.load(std::memory_order_acquire)) {
+        return;
+    }
+    // Rings are single-use once shut down, so every start gets new ones
+    for (auto& worker : workers_) {
+        worker.ring = std::make_unique<threading::SpscRing<common::CompactTick>>(config_.queue_capacity);
+    }
+    // A stop() mid-epoch leaves a partial row behind
+    samplers_pending_.store(0, std::memory_order_relaxed);
+    std::fill(pending_returns_.begin(), pending_returns_.end(), 0.0);
+    running_.store(true, std::memory_order_release);
+    worker_threads_.reserve(worker_count_);
+    for (size_t i = 0; i < worker_count_; ++i) {
+        worker_threads_.emplace_back(&RealtimeEngine::worker_loop, this, static_cast<int>(i));
+    }
+}
+
+void RealtimeEngine::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    // Workers drain their rings before exiting
+    for (auto& worker : worker_threads_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    worker_threads_.clear();
+}
+
+RealtimeEngine::EngineStats RealtimeEngine::get_engine_stats() const {
+    uint64_t now = common::Tick::current_timestamp_ns();
+    double seconds = now > created_ns_ ? static_cast<double>(now - created_ns_) / 1e9 : 0.0;
+    uint64_t ticks = processed_ticks_.load();
+    size_t symbols = symbol_count_.load(std::memory_order_relaxed);
+
+    engine_stats_.ticks_processed = ticks;
+    engine_stats_.metrics_calculated = metrics_calculated_.load();
+    engine_stats_.alerts_generated = alerts_generated_.load();
+    engine_stats_.backpressure_waits = backpressure_waits_.load();
+    engine_stats_.processing_rate_hz = seconds > 0 ? static_cast<double>(ticks) / seconds : 0.0;
+    engine_stats_.average_latency_ns = ticks > 0 ?
+        static_cast<double>(latency_sum_ns_.load()) / static_cast<double>(ticks) : 0.0;
+    engine_stats_.cpu_utilization = seconds > 0 ? static_cast<double>(process_cpu_ns()) / 1e9 / seconds : 0.0;
+
+    // History is preallocated per symbol, so this is what the engine holds:
+    // ticks, quotes and high/low entries, then quantile slots and heap entries
+    size_t per_symbol = sizeof(SymbolData) +
+        config_.history_depth * (sizeof(common::CompactTick) + sizeof(QuoteRecord) + 2 * 3 * sizeof(uint64_t)) +
+        config_.quantile_window * 2 * (2 * sizeof(uint64_t) + 2 * sizeof(uint32_t));
+    size_t rings = workers_.size() * config_.queue_capacity * sizeof(common::CompactTick);
+    size_t columns = correlation_matrix_.max_columns();
+    size_t matrix = (columns + correlation_matrix_.window()) * columns * sizeof(double);
+    engine_stats_.memory_usage_mb = (symbols * per_symbol + rings + matrix) / (1024 * 1024);
+    return engine_stats_;
+}
+
+RealtimeEngine::SymbolData* RealtimeEngine::find(common::InstrumentId id) const {
+    return id < id_capacity_ ? symbols_by_id_[id].load(std::memory_order_acquire) : nullptr;
+}
+
+RealtimeEngine::SymbolData* RealtimeEngine::find_or_create(common::InstrumentId id) {
+    if (SymbolData* data = find(id)) {
+        return data;
+    }
+    if (id >= id_capacity_) {
+        symbols_rejected_.add();
+        return nullptr;
+    }
+
+    // Only the owning worker creates a symbol, but workers race for slots
+    size_t index = symbol_count_.load(std::memory_order_relaxed);
+    do {
+        if (index >= config_.max_symbols) {
+            symbols_rejected_.add();
+            return nullptr;
+        }
+    } while (!symbol_count_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+    auto data = std::make_unique<SymbolData>(id, index, common::SymbolTable::global().name(id), config_);
+    data->current_metrics.instrument_id = id;
+    data->published.store(data->current_metrics);
+    SymbolData* ptr = data.get();
+    workers_[worker_for(id)].owned.push_back(std::move(data));
+    symbols_by_id_[id].store(ptr, std::memory_order_release);
+    symbols_[index].store(ptr, std::memory_order_release);
+    return ptr;
+}
+
+void RealtimeEngine::advance_bars(Worker& worker, uint64_t timestamp) {
+    // Scan once per bar interval of tick time: close the bars of symbols
+    // that went quiet and publish whatever has closed since the last scan
+    if (timestamp < worker.next_bar_check) {
+        return;
+    }
+    uint64_t interval = worker.bars.config().interval_ns;
+    worker.next_bar_check = timestamp - timestamp % interval + interval;
+    worker.bars.close_expired(timestamp, [this](const Bar& bar) {
+        SymbolData* data = find(bar.instrument_id);
+        data->bar_volatility.add(bar);
+        data->current_metrics.garman_klass_volatility = data->bar_volatility.garman_klass();
+        data->current_metrics.parkinson_volatility = data->bar_volatility.parkinson();
+        data->published.store(data->current_metrics);
+    });
+    worker.bars.flush();
+}
+
+void RealtimeEngine::update_liquidity_metrics(SymbolData& data, const common::CompactTick& tick) {
+    if (tick.price <= 0 || tick.qty <= 0) {
+        return;
+    }
+    if (tick.side == 'B') {
+        data.bid_price = tick.price;
+        data.bid_qty = tick.qty;
+    } else if (tick.side == 'S') {
+        data.ask_price = tick.price;
+        data.ask_qty = tick.qty;
+    } else {
+        return;
+    }
+
+    data.quotes.push_back({data.bid_price, data.ask_price, tick.timestamp});
+    if (data.bid_price > 0 && data.ask_price > data.bid_price) {
+        double mid = 0.5 * static_cast<double>(data.bid_price + data.ask_price);
+        double spread_bps = static_cast<double>(data.ask_price - data.bid_price) / mid * 10000.0;
+        data.quoted_spread_sum += spread_bps;
+        ++data.quoted_spread_count;
+        data.spreads.push(spread_bps);
+    }
+}
+
+void RealtimeEngine::calculate_metrics(SymbolData& data) {
+    uint64_t start = common::Tick::current_timestamp_ns();
+    const RollingTickWindow& window = data.window;
+    MarketMetrics& m = data.current_metrics;
+
+    // Price metrics
+    m.vwap = window.vwap();
+    m.twap = window.twap();
+    double bid = to_price(data.bid_price);
+    double ask = to_price(data.ask_price);
+    double mid = 0.0;
+    if (data.bid_price > 0 && data.ask_price > 0) {
+        mid = 0.5 * (bid + ask);
+        double sizes = static_cast<double>(data.bid_qty + data.ask_qty);
+        m.microprice = sizes > 0 ?
+            (bid * static_cast<double>(data.ask_qty) + ask * static_cast<double>(data.bid_qty)) / sizes : mid;
+        m.spread_bps = (ask - bid) / mid * 10000.0;
+    } else {
+        m.microprice = window.close();
+        m.spread_bps = 0.0;
+    }
+
+    // Volume metrics
+    m.total_volume = data.total_volume;
+    double span_s = static_cast<double>(window.span_ns()) / 1e9;
+    m.volume_rate = span_s > 0 ? static_cast<double>(window.volume()) / span_s : 0.0;
+    uint64_t market = market_volume_.load(std::memory_order_relaxed);
+    m.participation_rate = market > 0 ? static_cast<double>(data.total_volume) / static_cast<double>(market) : 0.0;
+
+    // Liquidity metrics
+    m.bid_depth = static_cast<double>(data.bid_qty);
+    m.ask_depth = static_cast<double>(data.ask_qty);
+    double depth = m.bid_depth + m.ask_depth;
+    m.liquidity_imbalance = depth > 0 ? (m.bid_depth - m.ask_depth) / depth : 0.0;
+    // Last tick against the mid it traded into, in bps
+    m.effective_spread = mid > 0 && !window.empty() ? 2.0 * std::fabs(window.close() - mid) / mid * 10000.0 : 0.0;
+    m.median_trade_size = data.trade_sizes.interpolated();
+    m.spread_quantile_bps = data.spreads.empty() ? 0.0 : data.spreads.value();
+
+    // Volatility metrics
+    m.realized_volatility = window.realized_volatility();
+    if (config_.enable_bars) {
+        m.garman_klass_volatility = data.bar_volatility.garman_klass();
+        m.parkinson_volatility = data.bar_volatility.parkinson();
+    } else {
+        m.garman_klass_volatility = window.garman_klass_volatility();
+        m.parkinson_volatility = window.parkinson_volatility();
+    }
+
+    // Market microstructure
+    m.order_flow_imbalance = window.order_flow_imbalance();
+    m.price_impact = window.volume() > 0 && window.open() > 0 ?
+        std::fabs(std::log(window.close() / window.open())) / static_cast<double>(window.volume()) : 0.0;
+    // Average quoted spread over the current one: above 1 means the book has recovered
+    double average_spread = data.quoted_spread_count > 0 ?
+        data.quoted_spread_sum / static_cast<double>(data.quoted_spread_count) : 0.0;
+    m.resilience = m.spread_bps > 0 ? average_spread / m.spread_bps : 0.0;
+
+    // Cross-asset (committed by whichever worker closes a sampling epoch)
+    m.beta_to_market = beta_for(data);
+
+    // Timing
+    uint64_t end = common::Tick::current_timestamp_ns();
+    m.last_update_ns = end;
+    m.calculation_time_ns = end > start ? end - start : 0;
+    data.calculation_time.record(m.calculation_time_ns);
+    m.calculation_time_p99_ns = data.calculation_time.p99();
+    metrics_calculated_.add();
+}
+
+size_t RealtimeEngine::detect_anomalies(const MarketMetrics& metrics, PendingAlert* alerts) const {
+    size_t count = 0;
+    if (config_.spread_alert_bps > 0 && metrics.spread_bps > config_.spread_alert_bps) {
+        alerts[count++] = {"WIDE_SPREAD", metrics.spread_bps / config_.spread_alert_bps};
+    }
+    if (config_.volatility_alert > 0 && metrics.realized_volatility > config_.volatility_alert) {
+        alerts[count++] = {"HIGH_VOLATILITY", metrics.realized_volatility / config_.volatility_alert};
+    }
+    if (config_.flow_alert_imbalance > 0 && std::fabs(metrics.order_flow_imbalance) > config_.flow_alert_imbalance) {
+        alerts[count++] = {"FLOW_IMBALANCE", std::fabs(metrics.order_flow_imbalance) / config_.flow_alert_imbalance};
+    }
+    return count;
+}
+
+void RealtimeEngine::worker_loop(int worker_id) {
+    using Clock = std::chrono::steady_clock;
+    auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(config_.correlation_interval_ms));
+    auto next = Clock::now() + interval;
+    Worker& worker = workers_[static_cast<size_t>(worker_id)];
+    common::CompactTick tick;
+    uint32_t idle = 0;
+
+    while (true) {
+        size_t applied = 0;
+        while (applied < MAX_BATCH && worker.ring->try_pop(tick)) {
+            apply_tick(tick);
+            ++applied;
+        }
+
+        if (config_.enable_cross_asset_analysis) {
+            // Worker 0 keeps the common clock; an epoch only starts once the
+            // previous row is committed, so no worker can skip one
+            auto now = Clock::now();
+            if (worker_id == 0 && now >= next && samplers_pending_.load(std::memory_order_acquire) == 0) {
+                next = std::max(next + interval, now);
+                // One count per worker plus one the committer drops after the push
+                samplers_pending_.store(worker_count_ + 1, std::memory_order_relaxed);
+                sample_epoch_.fetch_add(1, std::memory_order_release);
+            }
+            uint64_t epoch = sample_epoch_.load(std::memory_order_acquire);
+            if (epoch != worker.sampled_epoch) {
+                sample_returns(worker, epoch);
+            }
+        }
+
+        if (applied > 0) {
+            idle = 0;
+            continue;
+        }
+        if (!running_.load(std::memory_order_acquire)) {
+            if (worker.ring->empty()) {
+                break;
+            }
+            continue;
+        }
+        // Short naps once the ring has stayed empty for a while
+        if (++idle < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    worker.bars.flush();
+}
+
+void RealtimeEngine::sample_returns(Worker& worker, uint64_t epoch) {
+    // Only this worker touches its symbols' windows and columns
+    for (auto& data : worker.owned) {
+        if (data->index >= pending_returns_.size()) {
+            continue;  // Beyond the matrix
+        }
+        double price = data->window.close();
+        pending_returns_[data->index] =
+            price > 0 && data->last_sampled_price > 0 ? std::log(price / data->last_sampled_price) : 0.0;
+        if (price > 0) {
+            data->last_sampled_price = price;
+        }
+    }
+    worker.sampled_epoch = epoch;
+
+    if (samplers_pending_.fetch_sub(1, std::memory_order_acq_rel) == 2) {
+        commit_returns();
+        samplers_pending_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void RealtimeEngine::commit_returns() {
+    // Every worker has written its columns for this epoch
+    size_t columns = std::min(symbol_count_.load(std::memory_order_acquire), pending_returns_.size());
+    {
+        std::lock_guard<std::mutex> lock(matrix_mutex_);
+        correlation_matrix_.push(pending_returns_.data(), columns);
+    }
+    std::fill_n(pending_returns_.begin(), columns, 0.0);
+    // Only this thread writes the matrix, so it can be read here unlocked
+    for (size_t i = 0; i < correlation_matrix_.columns(); ++i) {
+        betas_[i].store(correlation_matrix_.beta(i), std::memory_order_relaxed);
+    }
+}
+
+} // namespace analytics
+} // namespace feedhandler
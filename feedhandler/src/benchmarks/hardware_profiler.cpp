@@ -15,7 +15,7 @@ namespace benchmarks {
 
 HardwareProfiler::HardwareProfiler() 
     : perf_available_(false), perf_fd_cycles_(-1), perf_fd_instructions_(-1),
-      perf_fd_cache_misses_(-1), perf_fd_branch_misses_(-1) {
+      perf_fd_cache_misses_(-1), perf_fd_branch_misses_(-1), start_counter_(0) {
 #ifdef __linux__
     setup_perf_counters();
 #endif
@@ -68,7 +68,7 @@ void HardwareProfiler::cleanup_perf_counters() {
 }
 
 void HardwareProfiler::start() {
-    start_time_ = std::chrono::high_resolution_clock::now();
+    start_counter_ = common::TscClock::read_counter();
     
 #ifdef __linux__
     if (!perf_available_) return;
@@ -87,11 +87,11 @@ void HardwareProfiler::start() {
 }
 
 HardwareProfiler::Metrics HardwareProfiler::stop() {
-    auto end_time = std::chrono::high_resolution_clock::now();
+    uint64_t end_counter = common::TscClock::read_counter();
     
-    Metrics metrics;
-    metrics.wall_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        end_time - start_time_);
+    Metrics metrics{};
+    metrics.wall_time = std::chrono::nanoseconds(
+        common::TscClock::global().ticks_to_ns(end_counter - start_counter_));
     
 #ifdef __linux__
     if (!perf_available_) {
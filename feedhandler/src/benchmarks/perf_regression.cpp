@@ -0,0 +1,276 @@
+#include "benchmarks/perf_regression.hpp"
+#include "benchmarks/stage_profiler.hpp"
+#include "common/latency_histogram.hpp"
+#include "common/tsc_clock.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace feedhandler {
+namespace benchmarks {
+
+namespace {
+
+struct MetricField {
+    const char* name;
+    double PerfResult::*field;
+    bool counter;       // Needs hardware counters
+    bool higher_better;
+};
+
+// Every metric a baseline may name; one table for lookup, JSON and direction
+constexpr MetricField METRICS[] = {
+    {"ns_per_op", &PerfResult::ns_per_op, false, false},
+    {"ops_per_second", &PerfResult::ops_per_second, false, true},
+    {"p50_ns", &PerfResult::p50_ns, false, false},
+    {"p99_ns", &PerfResult::p99_ns, false, false},
+    {"ipc", &PerfResult::ipc, true, true},
+    {"instructions_per_op", &PerfResult::instructions_per_op, true, false},
+    {"cache_misses_per_op", &PerfResult::cache_misses_per_op, true, false},
+    {"branch_misses_per_op", &PerfResult::branch_misses_per_op, true, false},
+};
+
+const MetricField* find_metric(std::string_view name) {
+    for (const MetricField& metric : METRICS) {
+        if (name == metric.name) {
+            return &metric;
+        }
+    }
+    return nullptr;
+}
+
+void write_string(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+bool pin_current_thread(int cpu) {
+#ifdef __linux__
+    if (cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace
+
+bool PerfResult::metric(std::string_view metric_name, double& value) const {
+    const MetricField* metric = find_metric(metric_name);
+    if (!metric || (metric->counter && !counters)) {
+        return false;
+    }
+    value = this->*(metric->field);
+    return true;
+}
+
+PerfHarness::PerfHarness(const Config& config) : config_(config) {
+    if (config_.repetitions == 0) {
+        config_.repetitions = 1;
+    }
+    if (config_.cpu >= 0) {
+        pinned_ = pin_current_thread(config_.cpu);
+        if (!pinned_) {
+            std::cerr << "Could not pin the harness to CPU " << config_.cpu << "; timings will be noisier" << std::endl;
+        }
+    }
+}
+
+void PerfHarness::add(PerfScenario scenario) {
+    if (scenario.ops_per_batch == 0) {
+        scenario.ops_per_batch = 1;
+    }
+    scenarios_.push_back(std::move(scenario));
+}
+
+std::vector<PerfResult> PerfHarness::run(std::string_view filter) const {
+    std::vector<PerfResult> results;
+    for (const PerfScenario& scenario : scenarios_) {
+        if (scenario.name.find(filter) != std::string::npos) {
+            results.push_back(run(scenario));
+        }
+    }
+    return results;
+}
+
+PerfResult PerfHarness::run(const PerfScenario& scenario) const {
+    PerfResult result;
+    result.name = scenario.name;
+    if (!scenario.batch) {
+        return result;
+    }
+    for (size_t i = 0; i < config_.warmup_batches; ++i) {
+        scenario.batch();
+    }
+
+    common::TscClock& clock = common::TscClock::global();
+    common::LatencyHistogram batch_ns;
+    std::vector<double> repetition_ns_per_op;
+    std::unique_ptr<PerfCounterGroup> counters;
+    CounterSample before;
+    if (config_.perf_counters) {
+        counters = std::make_unique<PerfCounterGroup>();
+        result.counters = counters->read(before);
+    }
+
+    for (size_t repetition = 0; repetition < config_.repetitions; ++repetition) {
+        uint64_t elapsed_ns = 0;
+        size_t batches = 0;
+        while (batches < config_.max_batches && (batches == 0 || elapsed_ns < config_.min_repetition_ns)) {
+            uint64_t start = common::TscClock::read_counter();
+            scenario.batch();
+            uint64_t ns = clock.ticks_to_ns(common::TscClock::read_counter() - start);
+            batch_ns.record(ns);
+            elapsed_ns += ns;
+            ++batches;
+        }
+        uint64_t operations = batches * scenario.ops_per_batch;
+        result.operations += operations;
+        repetition_ns_per_op.push_back(static_cast<double>(elapsed_ns) / static_cast<double>(operations));
+    }
+
+    CounterSample after;
+    if (result.counters && counters->read(after)) {
+        double operations = static_cast<double>(result.operations);
+        uint64_t cycles = after.cycles - before.cycles;
+        uint64_t instructions = after.instructions - before.instructions;
+        result.ipc = cycles ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0;
+        result.instructions_per_op = static_cast<double>(instructions) / operations;
+        result.cache_misses_per_op = static_cast<double>(after.cache_misses - before.cache_misses) / operations;
+        result.branch_misses_per_op = static_cast<double>(after.branch_misses - before.branch_misses) / operations;
+    } else {
+        result.counters = false;
+    }
+
+    std::sort(repetition_ns_per_op.begin(), repetition_ns_per_op.end());
+    size_t count = repetition_ns_per_op.size();
+    result.ns_per_op = count % 2 ? repetition_ns_per_op[count / 2]
+                                 : 0.5 * (repetition_ns_per_op[count / 2 - 1] + repetition_ns_per_op[count / 2]);
+    result.ops_per_second = result.ns_per_op > 0.0 ? 1e9 / result.ns_per_op : 0.0;
+    result.spread = result.ns_per_op > 0.0 ? (repetition_ns_per_op.back() - repetition_ns_per_op.front()) / result.ns_per_op : 0.0;
+    double ops = static_cast<double>(scenario.ops_per_batch);
+    result.p50_ns = static_cast<double>(batch_ns.percentile(50.0)) / ops;
+    result.p99_ns = static_cast<double>(batch_ns.percentile(99.0)) / ops;
+    return result;
+}
+
+void PerfHarness::write_json(std::ostream& out, const std::vector<PerfResult>& results) const {
+    out << std::setprecision(6);
+    out << "{\n  \"context\": {\"cpu\": " << config_.cpu << ", \"pinned\": " << (pinned_ ? "true" : "false")
+        << ", \"repetitions\": " << config_.repetitions << ", \"min_repetition_ns\": " << config_.min_repetition_ns
+        << "},\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const PerfResult& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        write_string(out, result.name);
+        out << ", \"operations\": " << result.operations << ", \"spread\": " << result.spread
+            << ", \"counters\": " << (result.counters ? "true" : "false");
+        for (const MetricField& metric : METRICS) {
+            if (!metric.counter || result.counters) {
+                out << ", \"" << metric.name << "\": " << result.*(metric.field);
+            }
+        }
+        out << '}';
+    }
+    out << "\n  ]\n}\n";
+}
+
+bool PerfHarness::load_baseline(const std::string& path, std::vector<PerfExpectation>& expectations) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Cannot read baseline " << path << std::endl;
+        return false;
+    }
+    std::vector<PerfExpectation> loaded;
+    std::string line;
+    for (size_t number = 1; std::getline(file, line); ++number) {
+        size_t comment = line.find('#');
+        std::istringstream fields(line.substr(0, comment));
+        PerfExpectation expectation;
+        if (!(fields >> expectation.scenario)) {
+            continue;  // Blank or comment-only
+        }
+        std::string extra;
+        if (!(fields >> expectation.metric >> expectation.baseline >> expectation.tolerance) || (fields >> extra) ||
+            !find_metric(expectation.metric) || !(expectation.baseline > 0.0) || expectation.tolerance < 0.0) {
+            std::cerr << path << ":" << number << ": expected: scenario metric baseline tolerance" << std::endl;
+            return false;
+        }
+        loaded.push_back(std::move(expectation));
+    }
+    expectations = std::move(loaded);
+    return true;
+}
+
+bool PerfHarness::save_baseline(const std::string& path, const std::vector<PerfResult>& results,
+                                const std::vector<std::string>& metrics, double tolerance) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Cannot write baseline " << path << std::endl;
+        return false;
+    }
+    file << "# scenario metric baseline tolerance\n" << std::setprecision(6);
+    for (const PerfResult& result : results) {
+        for (const std::string& metric : metrics) {
+            double value;
+            if (result.metric(metric, value) && value > 0.0) {
+                file << result.name << ' ' << metric << ' ' << value << ' ' << tolerance << '\n';
+            }
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+std::vector<PerfComparison> PerfHarness::compare(const std::vector<PerfResult>& results,
+                                                 const std::vector<PerfExpectation>& expectations) {
+    std::vector<PerfComparison> comparisons;
+    comparisons.reserve(expectations.size());
+    for (const PerfExpectation& expectation : expectations) {
+        PerfComparison comparison;
+        comparison.scenario = expectation.scenario;
+        comparison.metric = expectation.metric;
+        comparison.baseline = expectation.baseline;
+        comparison.tolerance = expectation.tolerance;
+        auto it = std::find_if(results.begin(), results.end(),
+                               [&](const PerfResult& result) { return result.name == expectation.scenario; });
+        if (it != results.end() && it->metric(expectation.metric, comparison.measured) && expectation.baseline > 0.0) {
+            double relative = (comparison.measured - expectation.baseline) / expectation.baseline;
+            comparison.change = higher_is_better(expectation.metric) ? -relative : relative;
+            comparison.status = comparison.change > expectation.tolerance    ? PerfComparison::Status::REGRESSED
+                                : comparison.change < -expectation.tolerance ? PerfComparison::Status::IMPROVED
+                                                                             : PerfComparison::Status::OK;
+        }
+        comparisons.push_back(comparison);
+    }
+    return comparisons;
+}
+
+bool PerfHarness::higher_is_better(std::string_view metric) {
+    const MetricField* field = find_metric(metric);
+    return field && field->higher_better;
+}
+
+} // namespace benchmarks
+} // namespace feedhandler
@@ -0,0 +1,138 @@
+#include "common/buffer_segment.hpp"
+
+namespace feedhandler {
+namespace common {
+
+SegmentRef::SegmentRef(const SegmentRef& other)
+    : pool_(other.pool_), index_(other.index_) {
+    if (pool_) {
+        pool_->add_ref(index_);
+    }
+}
+
+SegmentRef& SegmentRef::operator=(const SegmentRef& other) {
+    if (this != &other) {
+        if (other.pool_) {
+            other.pool_->add_ref(other.index_);
+        }
+        reset();
+        pool_ = other.pool_;
+        index_ = other.index_;
+    }
+    return *this;
+}
+
+SegmentRef& SegmentRef::operator=(SegmentRef&& other) noexcept {
+    if (this != &other) {
+        reset();
+        pool_ = std::exchange(other.pool_, nullptr);
+        index_ = other.index_;
+    }
+    return *this;
+}
+
+void SegmentRef::reset() {
+    if (pool_) {
+        std::exchange(pool_, nullptr)->release(index_);
+    }
+}
+
+char* SegmentRef::data() const {
+    return pool_->bytes_.get() + index_ * pool_->segment_bytes_;
+}
+
+size_t SegmentRef::capacity() const {
+    return pool_ ? pool_->segment_bytes_ : 0;
+}
+
+size_t SegmentRef::length() const {
+    return pool_ ? pool_->segments_[index_].length : 0;
+}
+
+void SegmentRef::set_length(size_t length) {
+    pool_->segments_[index_].length = length < pool_->segment_bytes_ ? length : pool_->segment_bytes_;
+}
+
+FlyweightTick* SegmentRef::tick_storage() const {
+    return pool_->ticks_.get() + index_ * pool_->ticks_per_segment_;
+}
+
+size_t SegmentRef::tick_capacity() const {
+    return pool_ ? pool_->ticks_per_segment_ : 0;
+}
+
+void SegmentRef::set_tick_count(size_t count) {
+    pool_->segments_[index_].tick_count =
+        count < pool_->ticks_per_segment_ ? count : pool_->ticks_per_segment_;
+}
+
+std::span<const FlyweightTick> SegmentRef::ticks() const {
+    if (!pool_) {
+        return {};
+    }
+    return std::span<const FlyweightTick>(tick_storage(), pool_->segments_[index_].tick_count);
+}
+
+uint32_t SegmentRef::use_count() const {
+    return pool_ ? pool_->segments_[index_].refs.load(std::memory_order_relaxed) : 0;
+}
+
+SegmentPool::SegmentPool(size_t segment_count, size_t segment_bytes, size_t ticks_per_segment)
+    : segment_count_(segment_count < NONE ? segment_count : NONE - 1)
+    , segment_bytes_(segment_bytes)
+    , ticks_per_segment_(ticks_per_segment)
+    , bytes_(new char[segment_count_ * segment_bytes_])
+    , ticks_(new FlyweightTick[segment_count_ * ticks_per_segment_])
+    , segments_(new Segment[segment_count_])
+    , head_(pack(0, segment_count_ > 0 ? 0 : NONE))
+    , free_count_(segment_count_) {
+    // Link every segment into the free list up front
+    for (size_t i = 0; i < segment_count_; ++i) {
+        uint32_t next = (i + 1 < segment_count_) ? static_cast<uint32_t>(i + 1) : NONE;
+        segments_[i].next.store(next, std::memory_order_relaxed);
+    }
+}
+
+SegmentRef SegmentPool::acquire() {
+    uint64_t head = head_.load(std::memory_order_acquire);
+
+    while (static_cast<uint32_t>(head) != NONE) {
+        uint32_t index = static_cast<uint32_t>(head);
+        uint32_t next = segments_[index].next.load(std::memory_order_relaxed);
+
+        // Bumping the tag makes a stale head (same index, recycled segment) fail
+        if (head_.compare_exchange_weak(head, pack(static_cast<uint32_t>(head >> 32) + 1, next),
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+            free_count_.fetch_sub(1, std::memory_order_relaxed);
+            Segment& segment = segments_[index];
+            segment.length = 0;
+            segment.tick_count = 0;
+            segment.refs.store(1, std::memory_order_relaxed);
+            return SegmentRef(this, index);
+        }
+    }
+
+    return SegmentRef();  // Every segment is held by someone
+}
+
+void SegmentPool::release(uint32_t index) {
+    Segment& segment = segments_[index];
+
+    // acq_rel: the last dropper sees every other holder's reads finished
+    if (segment.refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    do {
+        segment.next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    } while (!head_.compare_exchange_weak(head, pack(static_cast<uint32_t>(head >> 32) + 1, index),
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+
+    free_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace common
+} // namespace feedhandler
@@ -1,125 +1,245 @@
 #include "common/numa_memory_pool.hpp"
 #include <numa.h>
 #include <numaif.h>
+#include <sched.h>
 #include <sys/mman.h>
 #include <unistd.h>
-#include <iostream>
+#include <new>
 
 namespace feedhandler {
 namespace common {
 
 template<typename T, size_t PoolSize>
-NUMAMemoryPool<T, PoolSize>::NUMAMemoryPool() 
-    : free_head_(nullptr), allocated_count_(0), numa_memory_(nullptr), numa_node_(0) {
+NUMAMemoryPool<T, PoolSize>::NUMAMemoryPool(int numa_node)
+    : free_head_(pack(0, NONE)), allocated_count_(0), allocate_calls_(0), allocate_misses_(0),
+      numa_memory_(nullptr), numa_node_(numa_node), numa_bound_(false), pool_memory_(nullptr) {
     initialize_numa_pool();
 }
 
 template<typename T, size_t PoolSize>
 NUMAMemoryPool<T, PoolSize>::~NUMAMemoryPool() {
-    if (numa_memory_) {
+    if (!numa_memory_) {
+        return;
+    }
+    for (size_t i = 0; i < PoolSize; ++i) {
+        pool_memory_[i].~Node();
+    }
+    if (numa_bound_) {
         numa_free(numa_memory_, sizeof(Node) * PoolSize);
+    } else {
+        munmap(numa_memory_, sizeof(Node) * PoolSize);
     }
 }
 
 template<typename T, size_t PoolSize>
 void NUMAMemoryPool<T, PoolSize>::initialize_numa_pool() {
-    // Detect current NUMA node
-    numa_node_ = detect_numa_node();
-    
-    // Allocate memory on specific NUMA node
-    numa_memory_ = numa_alloc_onnode(sizeof(Node) * PoolSize, numa_node_);
+    static_assert(PoolSize > 0 && PoolSize < UINT32_MAX, "PoolSize must fit a 32-bit index");
+
+    if (numa_node_ < 0) {
+        numa_node_ = detect_numa_node();
+    }
+
+    // Bind the region to the node: pages fault in there whoever touches them
+    if (numa_available() >= 0 && numa_node_ <= numa_max_node()) {
+        numa_memory_ = numa_alloc_onnode(sizeof(Node) * PoolSize, numa_node_);
+        numa_bound_ = (numa_memory_ != nullptr);
+    }
+
+    // No NUMA support: first touch below places pages near this thread
     if (!numa_memory_) {
-        throw std::bad_alloc();
+        void* mem = mmap(nullptr, sizeof(Node) * PoolSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        numa_memory_ = mem;
+        numa_node_ = 0;
     }
-    
-    // Initialize pool as array of nodes
+
+    // Initialize pool as array of nodes (touches and so prefaults every page)
     pool_memory_ = static_cast<Node*>(numa_memory_);
-    
-    // Build free list (lock-free stack)
-    for (size_t i = 0; i < PoolSize - 1; ++i) {
-        pool_memory_[i].next.store(&pool_memory_[i + 1], std::memory_order_relaxed);
+    for (size_t i = 0; i < PoolSize; ++i) {
+        Node* node = new (&pool_memory_[i]) Node();
+        uint32_t next = (i + 1 < PoolSize) ? static_cast<uint32_t>(i + 1) : NONE;
+        node->next.store(next, std::memory_order_relaxed);
     }
-    pool_memory_[PoolSize - 1].next.store(nullptr, std::memory_order_relaxed);
-    
+
     // Set head of free list
-    free_head_.store(&pool_memory_[0], std::memory_order_relaxed);
+    free_head_.store(pack(0, 0), std::memory_order_release);
 }
 
 template<typename T, size_t PoolSize>
 int NUMAMemoryPool<T, PoolSize>::detect_numa_node() {
+    return current_node();
+}
+
+template<typename T, size_t PoolSize>
+int NUMAMemoryPool<T, PoolSize>::current_node() {
     if (numa_available() < 0) {
         return 0; // NUMA not available, use node 0
     }
-    
+
     // Get current thread's NUMA node
     int cpu = sched_getcpu();
     if (cpu >= 0) {
-        return numa_node_of_cpu(cpu);
+        int node = numa_node_of_cpu(cpu);
+        return node >= 0 ? node : 0;
     }
-    
+
     return 0; // Default to node 0
 }
 
 template<typename T, size_t PoolSize>
 T* NUMAMemoryPool<T, PoolSize>::allocate() {
-    Node* head = free_head_.load(std::memory_order_acquire);
-    
-    while (head != nullptr) {
-        Node* next = head->next.load(std::memory_order_relaxed);
-        
-        // Try to update head atomically
-        if (free_head_.compare_exchange_weak(head, next, 
-                                           std::memory_order_release, 
-                                           std::memory_order_acquire)) {
+    allocate_calls_.fetch_add(1, std::memory_order_relaxed);
+    uint64_t head = free_head_.load(std::memory_order_acquire);
+
+    while (static_cast<uint32_t>(head) != NONE) {
+        uint32_t index = static_cast<uint32_t>(head);
+        uint32_t next = pool_memory_[index].next.load(std::memory_order_relaxed);
+        uint32_t tag = static_cast<uint32_t>(head >> 32);
+
+        // The tag bump makes a stale head (same index, recycled node) fail
+        if (free_head_.compare_exchange_weak(head, pack(tag + 1, next),
+                                             std::memory_order_acquire,
+                                             std::memory_order_acquire)) {
             allocated_count_.fetch_add(1, std::memory_order_relaxed);
-            return &head->data;
+            return &pool_memory_[index].data;
         }
         // head was updated by compare_exchange_weak, retry
     }
-    
+
+    allocate_misses_.fetch_add(1, std::memory_order_relaxed);
     return nullptr; // Pool exhausted
 }
 
+template<typename T, size_t PoolSize>
+bool NUMAMemoryPool<T, PoolSize>::owns(const T* ptr) const {
+    if (!ptr || !pool_memory_) {
+        return false;
+    }
+    const char* p = reinterpret_cast<const char*>(ptr);
+    const char* begin = reinterpret_cast<const char*>(pool_memory_);
+    const char* end = reinterpret_cast<const char*>(pool_memory_ + PoolSize);
+    return p >= begin && p < end &&
+           static_cast<size_t>(p - begin) % sizeof(Node) == offsetof(Node, data);
+}
+
 template<typename T, size_t PoolSize>
 void NUMAMemoryPool<T, PoolSize>::deallocate(T* ptr) {
-    if (!ptr) return;
-    
-    // Calculate node from data pointer
-    Node* node = reinterpret_cast<Node*>(
-        reinterpret_cast<char*>(ptr) - offsetof(Node, data));
-    
     // Verify pointer is within our pool
-    if (node < pool_memory_ || node >= pool_memory_ + PoolSize) {
+    if (!owns(ptr)) {
         return; // Invalid pointer
     }
-    
+
+    // Calculate node from data pointer
+    Node* node = reinterpret_cast<Node*>(
+        reinterpret_cast<char*>(ptr) - offsetof(Node, data));
+    uint32_t index = static_cast<uint32_t>(node - pool_memory_);
+
     // Add back to free list (lock-free)
-    Node* head = free_head_.load(std::memory_order_relaxed);
+    uint64_t head = free_head_.load(std::memory_order_relaxed);
     do {
-        node->next.store(head, std::memory_order_relaxed);
-    } while (!free_head_.compare_exchange_weak(head, node,
-                                             std::memory_order_release,
-                                             std::memory_order_relaxed));
-    
+        node->next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    } while (!free_head_.compare_exchange_weak(head, pack(static_cast<uint32_t>(head >> 32) + 1, index),
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+
     allocated_count_.fetch_sub(1, std::memory_order_relaxed);
 }
 
 template<typename T, size_t PoolSize>
-typename NUMAMemoryPool<T, PoolSize>::Stats 
+typename NUMAMemoryPool<T, PoolSize>::Stats
 NUMAMemoryPool<T, PoolSize>::get_stats() const {
     size_t allocated = allocated_count_.load(std::memory_order_relaxed);
+    uint64_t calls = allocate_calls_.load(std::memory_order_relaxed);
+    uint64_t misses = allocate_misses_.load(std::memory_order_relaxed);
     return Stats{
         .allocated_count = allocated,
         .free_count = PoolSize - allocated,
         .numa_node = static_cast<size_t>(numa_node_),
-        .hit_rate = static_cast<double>(allocated) / PoolSize
+        .hit_rate = calls ? static_cast<double>(calls - misses) / calls : 1.0
     };
 }
 
+template<typename T, size_t PoolSize>
+NUMAPoolRegistry<T, PoolSize>::NUMAPoolRegistry()
+    : pools_(numa_available() >= 0 ? numa_max_node() + 1 : 1) {
+    for (auto& pool : pools_) {
+        pool.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, size_t PoolSize>
+NUMAPoolRegistry<T, PoolSize>& NUMAPoolRegistry<T, PoolSize>::instance() {
+    static NUMAPoolRegistry registry;
+    return registry;
+}
+
+template<typename T, size_t PoolSize>
+typename NUMAPoolRegistry<T, PoolSize>::Pool* NUMAPoolRegistry<T, PoolSize>::for_node(int node) {
+    if (node < 0 || static_cast<size_t>(node) >= pools_.size()) {
+        return nullptr;
+    }
+
+    Pool* pool = pools_[node].load(std::memory_order_acquire);
+    if (pool) {
+        return pool;  // Fast path: already created
+    }
+
+    std::lock_guard<std::mutex> lock(create_mutex_);
+    pool = pools_[node].load(std::memory_order_relaxed);
+    if (!pool) {
+        owned_.push_back(std::make_unique<Pool>(node));
+        pool = owned_.back().get();
+        pools_[node].store(pool, std::memory_order_release);
+    }
+    return pool;
+}
+
+template<typename T, size_t PoolSize>
+typename NUMAPoolRegistry<T, PoolSize>::Pool& NUMAPoolRegistry<T, PoolSize>::local() {
+    Pool* pool = for_node(Pool::current_node());
+    return pool ? *pool : *for_node(0);
+}
+
+template<typename T, size_t PoolSize>
+T* NUMAPoolRegistry<T, PoolSize>::allocate() {
+    Pool& home = local();
+    if (T* ptr = home.allocate()) {
+        return ptr;
+    }
+
+    // Local node exhausted: remote memory beats failing
+    for (size_t node = 0; node < pools_.size(); ++node) {
+        Pool* pool = for_node(static_cast<int>(node));
+        if (pool != &home) {
+            if (T* ptr = pool->allocate()) {
+                return ptr;
+            }
+        }
+    }
+    return nullptr;
+}
+
+template<typename T, size_t PoolSize>
+void NUMAPoolRegistry<T, PoolSize>::deallocate(T* ptr) {
+    for (auto& slot : pools_) {
+        Pool* pool = slot.load(std::memory_order_acquire);
+        if (pool && pool->owns(ptr)) {
+            pool->deallocate(ptr);
+            return;
+        }
+    }
+}
+
 // Explicit template instantiations for common types
 template class NUMAMemoryPool<int, 1024>;
 template class NUMAMemoryPool<double, 1024>;
 template class NUMAMemoryPool<char[64], 1024>;
+template class NUMAPoolRegistry<int, 1024>;
+template class NUMAPoolRegistry<double, 1024>;
+template class NUMAPoolRegistry<char[64], 1024>;
 
 } // namespace common
-} // namespace feedhandler
\ No newline at end of file
+} // namespace feedhandler
@@ -0,0 +1,206 @@
+#include "common/tick_batch.hpp"
+
+#include <climits>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace feedhandler {
+namespace common {
+
+namespace {
+
+struct Columns {
+    const int64_t* prices;
+    const InstrumentId* ids;
+    const int32_t* qtys;
+    const char* sides;
+    size_t size;
+};
+
+// Sums in uint64_t so overflow wraps (as the vector lanes do) instead of being UB
+struct Accumulator {
+    uint64_t ticks = 0;
+    uint64_t volume = 0;
+    uint64_t bid_volume = 0;
+    uint64_t ask_volume = 0;
+    uint64_t notional = 0;
+    int64_t min_price = INT64_MAX;
+    int64_t max_price = INT64_MIN;
+
+    void add(int64_t price, int32_t qty, char side) {
+        uint64_t q = static_cast<uint64_t>(static_cast<int64_t>(qty));
+        ++ticks;
+        volume += q;
+        bid_volume += side == 'B' ? q : 0;
+        ask_volume += side == 'S' ? q : 0;
+        notional += static_cast<uint64_t>(price) * q;
+        min_price = std::min(min_price, price);
+        max_price = std::max(max_price, price);
+    }
+
+    TickBatchSummary finish() const {
+        TickBatchSummary summary;
+        summary.ticks = static_cast<size_t>(ticks);
+        summary.volume = static_cast<int64_t>(volume);
+        summary.bid_volume = static_cast<int64_t>(bid_volume);
+        summary.ask_volume = static_cast<int64_t>(ask_volume);
+        summary.notional = static_cast<int64_t>(notional);
+        if (ticks > 0) {
+            summary.min_price = min_price;
+            summary.max_price = max_price;
+        }
+        return summary;
+    }
+};
+
+void summarize_scalar(const Columns& c, size_t start, const InstrumentId* only, Accumulator& acc) {
+    for (size_t i = start; i < c.size; ++i) {
+        if (!only || c.ids[i] == *only) {
+            acc.add(c.prices[i], c.qtys[i], c.sides[i]);
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("avx2")))
+uint64_t hsum_avx2(__m256i v) {
+    // Through memory: the 64-bit lane moves (cvtsi128_si64, extract_epi64)
+    // do not exist on 32-bit x86
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    uint64_t halves[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(halves), sum);
+    return halves[0] + halves[1];
+}
+
+// Running sums of one lane set; in 64-bit lanes, four rows wide
+struct Lanes {
+    __m256i ticks, volume, bids, asks, notional, lo, hi;
+};
+
+__attribute__((target("avx2")))
+inline void init_lanes(Lanes& l) {
+    l.ticks = l.volume = l.bids = l.asks = l.notional = _mm256_setzero_si256();
+    l.lo = _mm256_set1_epi64x(INT64_MAX);
+    l.hi = _mm256_set1_epi64x(INT64_MIN);
+}
+
+// AVX2 has no 64x64 multiply, so price * qty is built from 32-bit
+// halves: hi(price) * qty << 32 plus lo(price) * qty, the latter taken
+// unsigned and corrected for qty < 0. Min/max see masked-off rows as
+// the identity, so the only loop-carried work is compare and blend.
+__attribute__((target("avx2")))
+inline void step_avx2(const Columns& c, size_t i, const InstrumentId* only, __m256i wanted, Lanes& l) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i price = _mm256_load_si256(reinterpret_cast<const __m256i*>(c.prices + i));
+    __m256i qty = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(c.qtys + i)));
+    int32_t side_bytes;
+    std::memcpy(&side_bytes, c.sides + i, sizeof(side_bytes));
+    __m256i side = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(side_bytes));
+
+    __m256i mask = _mm256_set1_epi64x(-1);
+    if (only) {
+        __m256i id = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(c.ids + i)));
+        mask = _mm256_cmpeq_epi64(id, wanted);
+    }
+    __m256i q = _mm256_and_si256(qty, mask);
+
+    __m256i high = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(price, 32), q), 32);
+    __m256i low = _mm256_mul_epu32(price, q);
+    __m256i borrow = _mm256_and_si256(_mm256_cmpgt_epi64(zero, q), _mm256_slli_epi64(price, 32));
+    l.notional = _mm256_add_epi64(l.notional, _mm256_add_epi64(high, _mm256_sub_epi64(low, borrow)));
+
+    l.ticks = _mm256_sub_epi64(l.ticks, mask);  // Selected lanes are -1
+    l.volume = _mm256_add_epi64(l.volume, q);
+    l.bids = _mm256_add_epi64(l.bids, _mm256_and_si256(q, _mm256_cmpeq_epi64(side, _mm256_set1_epi64x('B'))));
+    l.asks = _mm256_add_epi64(l.asks, _mm256_and_si256(q, _mm256_cmpeq_epi64(side, _mm256_set1_epi64x('S'))));
+    __m256i for_lo = _mm256_blendv_epi8(_mm256_set1_epi64x(INT64_MAX), price, mask);
+    __m256i for_hi = _mm256_blendv_epi8(_mm256_set1_epi64x(INT64_MIN), price, mask);
+    l.lo = _mm256_blendv_epi8(l.lo, for_lo, _mm256_cmpgt_epi64(l.lo, for_lo));
+    l.hi = _mm256_blendv_epi8(l.hi, for_hi, _mm256_cmpgt_epi64(for_hi, l.hi));
+}
+
+__attribute__((target("avx2")))
+void finish_lanes(const Lanes& l, Accumulator& acc) {
+    acc.ticks += hsum_avx2(l.ticks);
+    acc.volume += hsum_avx2(l.volume);
+    acc.bid_volume += hsum_avx2(l.bids);
+    acc.ask_volume += hsum_avx2(l.asks);
+    acc.notional += hsum_avx2(l.notional);
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), l.lo);
+    for (int64_t v : lanes) {
+        acc.min_price = std::min(acc.min_price, v);
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), l.hi);
+    for (int64_t v : lanes) {
+        acc.max_price = std::max(acc.max_price, v);
+    }
+}
+
+// Two lane sets, eight rows per iteration, to overlap the dependency chains
+__attribute__((target("avx2")))
+size_t summarize_avx2(const Columns& c, const InstrumentId* only, Accumulator& acc) {
+    const __m256i wanted = _mm256_set1_epi64x(only ? static_cast<int64_t>(*only) : 0);
+    Lanes even, odd;
+    init_lanes(even);
+    init_lanes(odd);
+    size_t i = 0;
+    for (; i + 8 <= c.size; i += 8) {
+        step_avx2(c, i, only, wanted, even);
+        step_avx2(c, i + 4, only, wanted, odd);
+    }
+    if (i + 4 <= c.size) {
+        step_avx2(c, i, only, wanted, even);
+        i += 4;
+    }
+    finish_lanes(even, acc);
+    finish_lanes(odd, acc);
+    return i;
+}
+
+#endif
+
+bool avx2_available() {
+    static const bool available = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init(); // May run before libgcc's constructor
+        return __builtin_cpu_supports("avx2") != 0;
+#else
+        return false;
+#endif
+    }();
+    return available;
+}
+
+TickBatchSummary summarize_columns(const Columns& columns, const InstrumentId* only) {
+    Accumulator acc;
+    size_t done = 0;
+#if defined(__x86_64__) || defined(__i386__)
+    if (avx2_available()) {
+        done = summarize_avx2(columns, only, acc);
+    }
+#endif
+    summarize_scalar(columns, done, only, acc);
+    return acc.finish();
+}
+
+} // namespace
+
+TickBatchSummary TickBatch::summarize() const {
+    return summarize_columns(Columns{prices_, instrument_ids_, qtys_, sides_, size_}, nullptr);
+}
+
+TickBatchSummary TickBatch::summarize(InstrumentId instrument) const {
+    return summarize_columns(Columns{prices_, instrument_ids_, qtys_, sides_, size_}, &instrument);
+}
+
+bool TickBatch::simd_summaries() {
+    return avx2_available();
+}
+
+} // namespace common
+} // namespace feedhandler
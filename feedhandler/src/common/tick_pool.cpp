@@ -1,13 +1,37 @@
 #include "common/tick_pool.hpp"
+#include <algorithm>
+#include <new>
+#include <type_traits>
 
 namespace feedhandler {
 namespace common {
 
 TickPool::TickPool(size_t capacity) 
-    : next_index_(0) {
+    : pool_(nullptr)
+    , capacity_(capacity)
+    , next_index_(0) {
     // Preallocate the entire pool upfront - no allocations during parsing
-    pool_.reserve(capacity);
-    pool_.resize(capacity);
+    owned_.resize(capacity);
+    pool_ = owned_.data();
+}
+
+TickPool::TickPool(size_t capacity, ZeroLatencyAllocator::Arena& arena)
+    : pool_(nullptr)
+    , capacity_(capacity)
+    , next_index_(0) {
+    static_assert(std::is_trivially_destructible_v<Tick>,
+                  "arena-backed ticks are never destroyed");
+    
+    void* mem = capacity ? arena.allocate(capacity * sizeof(Tick), alignof(Tick)) : nullptr;
+    if (mem) {
+        pool_ = static_cast<Tick*>(mem);
+        for (size_t i = 0; i < capacity; ++i) {
+            new (&pool_[i]) Tick();
+        }
+    } else {
+        owned_.resize(capacity);
+        pool_ = owned_.data();
+    }
 }
 
 Tick* TickPool::acquire() {
@@ -29,5 +53,143 @@ void TickPool::reset() {
     // }
 }
 
+RecyclingTickPool::RecyclingTickPool(size_t capacity)
+    : capacity_(capacity < NONE ? capacity : NONE - 1)
+    , ticks_(new Tick[capacity_])
+    , next_(new std::atomic<uint32_t>[capacity_])
+    , head_(pack(0, capacity_ > 0 ? 0 : NONE))
+    , global_free_(capacity_) {
+    // Link every slot into the free list up front
+    for (size_t i = 0; i < capacity_; ++i) {
+        uint32_t next = (i + 1 < capacity_) ? static_cast<uint32_t>(i + 1) : NONE;
+        next_[i].store(next, std::memory_order_relaxed);
+    }
+}
+
+uint32_t RecyclingTickPool::pop_index() {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    
+    while (index_of(head) != NONE) {
+        uint32_t index = index_of(head);
+        uint32_t next = next_[index].load(std::memory_order_relaxed);
+        
+        // Bumping the tag makes a stale head (same index, reused slot) fail
+        if (head_.compare_exchange_weak(head, pack(tag_of(head) + 1, next),
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+            global_free_.fetch_sub(1, std::memory_order_relaxed);
+            return index;
+        }
+    }
+    
+    return NONE;  // Exhausted
+}
+
+size_t RecyclingTickPool::pop_indices(uint32_t* slots, size_t n) {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    
+    while (true) {
+        // Walk the chain under this head. Links read while another thread
+        // pops and re-pushes may be stale, but that also bumps the tag, so
+        // the CAS below throws the walk away and it starts over
+        size_t taken = 0;
+        uint32_t next = index_of(head);
+        while (taken < n && next != NONE) {
+            slots[taken++] = next;
+            next = next_[next].load(std::memory_order_relaxed);
+        }
+        if (taken == 0) {
+            return 0;  // Exhausted
+        }
+        
+        if (head_.compare_exchange_weak(head, pack(tag_of(head) + 1, next),
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+            global_free_.fetch_sub(taken, std::memory_order_relaxed);
+            return taken;
+        }
+    }
+}
+
+void RecyclingTickPool::push_indices(const uint32_t* slots, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    
+    // Pre-link the chain privately, then splice it on top
+    for (size_t i = 0; i + 1 < n; ++i) {
+        next_[slots[i]].store(slots[i + 1], std::memory_order_relaxed);
+    }
+    
+    uint32_t first = slots[0];
+    uint32_t last = slots[n - 1];
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    do {
+        next_[last].store(index_of(head), std::memory_order_relaxed);
+    } while (!head_.compare_exchange_weak(head, pack(tag_of(head) + 1, first),
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+    
+    global_free_.fetch_add(n, std::memory_order_relaxed);
+}
+
+Tick* RecyclingTickPool::acquire() {
+    uint32_t index = pop_index();
+    return index == NONE ? nullptr : &ticks_[index];
+}
+
+void RecyclingTickPool::release(Tick* tick) {
+    if (!owns(tick)) {
+        return;
+    }
+    uint32_t index = slot_of(tick);
+    push_indices(&index, 1);
+}
+
+RecyclingTickPool::LocalCache::LocalCache(RecyclingTickPool& pool, size_t batch)
+    : pool_(pool)
+    , batch_(batch == 0 ? 1 : (batch > MAX_CACHED / 2 ? MAX_CACHED / 2 : batch))
+    , count_(0) {}
+
+RecyclingTickPool::LocalCache::~LocalCache() {
+    flush();
+}
+
+Tick* RecyclingTickPool::LocalCache::acquire() {
+    if (count_ == 0) {
+        // Refill a batch in one pop (fewer if the global stack runs dry),
+        // reversed so the last slot released to the stack goes out first
+        count_ = pool_.pop_indices(slots_, batch_);
+        if (count_ == 0) {
+            return nullptr;  // Pool exhausted
+        }
+        std::reverse(slots_, slots_ + count_);
+    }
+    return &pool_.ticks_[slots_[--count_]];
+}
+
+void RecyclingTickPool::LocalCache::release(Tick* tick) {
+    if (!pool_.owns(tick)) {
+        return;
+    }
+    if (count_ == MAX_CACHED) {
+        flush_batch(batch_);
+    }
+    slots_[count_++] = pool_.slot_of(tick);
+}
+
+void RecyclingTickPool::LocalCache::flush() {
+    flush_batch(count_);
+}
+
+void RecyclingTickPool::LocalCache::flush_batch(size_t n) {
+    // Hand back the oldest entries; recently released (cache-hot) ticks stay local
+    pool_.push_indices(slots_, n);
+    for (size_t i = n; i < count_; ++i) {
+        slots_[i - n] = slots_[i];
+    }
+    count_ -= n;
+}
+
 } // namespace common
 } // namespace feedhandler
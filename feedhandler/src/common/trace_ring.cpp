@@ -0,0 +1,250 @@
+#include "common/trace_ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+
+namespace feedhandler {
+namespace common {
+
+namespace {
+
+constexpr char MAGIC[8] = {'F', 'H', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr uint32_t MAX_NAME = 4096;
+constexpr size_t RECORD_SIZE = 24;  // ns, seq, stage, phase, padding
+
+template<typename T>
+void put(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void put_string(std::ostream& out, const std::string& text) {
+    put<uint32_t>(out, static_cast<uint32_t>(text.size()));
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+template<typename T>
+bool get(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+bool get_string(std::istream& in, std::string& text) {
+    uint32_t length = 0;
+    if (!get(in, length) || length > MAX_NAME) {
+        return false;
+    }
+    text.resize(length);
+    return static_cast<bool>(in.read(text.data(), length));
+}
+
+void write_string(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+                << std::setfill(' ');
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Microseconds since the first event, the unit Chrome traces are in
+void write_ts(std::ostream& out, uint64_t ns, uint64_t base_ns) {
+    uint64_t relative = ns - base_ns;
+    out << relative / 1000 << '.' << std::setw(3) << std::setfill('0') << relative % 1000 << std::setfill(' ');
+}
+
+} // namespace
+
+TraceDump Tracer::capture() const {
+    TraceDump dump;
+    // Anchor once and count back, so events older than a clock re-anchor convert too
+    TscClock& clock = TscClock::global();
+    uint64_t now_counter = TscClock::read_counter();
+    uint64_t now_ns = clock.now_ns();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    dump.stages = stages_;
+    std::vector<TraceEvent> events;
+    for (size_t i = 0; i < threads_.size(); ++i) {
+        TraceDump::Thread thread;
+        thread.id = static_cast<uint32_t>(i + 1);
+        thread.name = threads_[i].name;
+        threads_[i].ring->snapshot(events);
+        thread.events.reserve(events.size());
+        for (const TraceEvent& event : events) {
+            uint64_t age = event.tsc < now_counter ? clock.ticks_to_ns(now_counter - event.tsc) : 0;
+            thread.events.push_back({now_ns - std::min(age, now_ns), event.seq, event.stage, event.phase});
+        }
+        dump.threads.push_back(std::move(thread));
+    }
+    return dump;
+}
+
+bool TraceDump::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Cannot write trace " << path << std::endl;
+        return false;
+    }
+    out.write(MAGIC, sizeof(MAGIC));
+    put<uint32_t>(out, static_cast<uint32_t>(stages.size()));
+    for (const std::string& stage : stages) {
+        put_string(out, stage);
+    }
+    put<uint32_t>(out, static_cast<uint32_t>(threads.size()));
+    for (const Thread& thread : threads) {
+        put<uint32_t>(out, thread.id);
+        put_string(out, thread.name);
+        put<uint64_t>(out, thread.events.size());
+        for (const Event& event : thread.events) {
+            char record[RECORD_SIZE] = {};
+            std::memcpy(record, &event.ns, 8);
+            std::memcpy(record + 8, &event.seq, 8);
+            std::memcpy(record + 16, &event.stage, 2);
+            record[18] = static_cast<char>(event.phase);
+            out.write(record, sizeof(record));
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+bool TraceDump::load(const std::string& path, TraceDump& dump) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot read trace " << path << std::endl;
+        return false;
+    }
+    TraceDump loaded;
+    char magic[sizeof(MAGIC)];
+    uint32_t stage_count = 0;
+    bool ok = in.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+              get(in, stage_count) && stage_count <= Tracer::MAX_STAGES;
+    for (uint32_t i = 0; ok && i < stage_count; ++i) {
+        loaded.stages.emplace_back();
+        ok = get_string(in, loaded.stages.back());
+    }
+    uint32_t thread_count = 0;
+    ok = ok && get(in, thread_count);
+    for (uint32_t i = 0; ok && i < thread_count; ++i) {
+        Thread thread;
+        uint64_t count = 0;
+        ok = get(in, thread.id) && get_string(in, thread.name) && get(in, count);
+        for (uint64_t e = 0; ok && e < count; ++e) {
+            char record[RECORD_SIZE];
+            Event event;
+            ok = static_cast<bool>(in.read(record, sizeof(record)));
+            if (ok) {
+                std::memcpy(&event.ns, record, 8);
+                std::memcpy(&event.seq, record + 8, 8);
+                std::memcpy(&event.stage, record + 16, 2);
+                event.phase = static_cast<TracePhase>(record[18]);
+                ok = event.stage < stage_count && record[18] <= static_cast<char>(TracePhase::INSTANT);
+                thread.events.push_back(event);
+            }
+        }
+        loaded.threads.push_back(std::move(thread));
+    }
+    if (!ok) {
+        std::cerr << path << ": not a trace file, or truncated" << std::endl;
+        return false;
+    }
+    dump = std::move(loaded);
+    return true;
+}
+
+void TraceDump::write_chrome_json(std::ostream& out) const {
+    uint64_t base_ns = UINT64_MAX;
+    for (const Thread& thread : threads) {
+        if (!thread.events.empty()) {
+            base_ns = std::min(base_ns, thread.events.front().ns);
+        }
+    }
+    if (base_ns == UINT64_MAX) {
+        base_ns = 0;
+    }
+    auto stage_name = [&](uint16_t stage) -> std::string_view {
+        return stage < stages.size() ? std::string_view(stages[stage]) : std::string_view("?");
+    };
+
+    bool first = true;
+    auto open = [&](const char* phase, uint32_t tid) {
+        out << (first ? "\n" : ",\n") << "{\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << tid;
+        first = false;
+    };
+
+    out << "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"start_unix_ns\":" << base_ns << "},\"traceEvents\":[";
+    open("M", 0);
+    out << ",\"name\":\"process_name\",\"args\":{\"name\":\"feedhandler\"}}";
+
+    // Where each message starts a slice (or is marked) on each thread, for flows
+    struct Hop {
+        uint64_t ns;
+        uint32_t tid;
+    };
+    std::unordered_map<uint64_t, std::vector<Hop>> hops;
+
+    for (const Thread& thread : threads) {
+        open("M", thread.id);
+        out << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        write_string(out, thread.name);
+        out << "}}";
+
+        size_t depth = 0;
+        for (const Event& event : thread.events) {
+            if (event.phase == TracePhase::END) {
+                if (depth == 0) {
+                    continue;  // Its BEGIN was overwritten
+                }
+                --depth;
+            } else if (event.phase == TracePhase::BEGIN) {
+                ++depth;
+            }
+            open(event.phase == TracePhase::BEGIN ? "B" : event.phase == TracePhase::END ? "E" : "i", thread.id);
+            out << ",\"name\":";
+            write_string(out, stage_name(event.stage));
+            out << ",\"ts\":";
+            write_ts(out, event.ns, base_ns);
+            if (event.phase == TracePhase::INSTANT) {
+                out << ",\"s\":\"t\"";
+            }
+            out << ",\"args\":{\"seq\":" << event.seq << "}}";
+
+            if (event.seq != 0 && event.phase != TracePhase::END) {
+                std::vector<Hop>& message = hops[event.seq];
+                bool seen = std::any_of(message.begin(), message.end(),
+                                        [&](const Hop& hop) { return hop.tid == thread.id; });
+                if (!seen) {
+                    message.push_back({event.ns, thread.id});
+                }
+            }
+        }
+    }
+
+    for (auto& [seq, message] : hops) {
+        if (message.size() < 2) {
+            continue;
+        }
+        std::sort(message.begin(), message.end(), [](const Hop& a, const Hop& b) { return a.ns < b.ns; });
+        for (size_t i = 0; i < message.size(); ++i) {
+            open(i == 0 ? "s" : i + 1 == message.size() ? "f" : "t", message[i].tid);
+            out << ",\"name\":\"message\",\"cat\":\"message\",\"id\":" << seq << ",\"ts\":";
+            write_ts(out, message[i].ns, base_ns);
+            if (i + 1 == message.size()) {
+                out << ",\"bp\":\"e\"";
+            }
+            out << '}';
+        }
+    }
+    out << "\n]}\n";
+}
+
+} // namespace common
+} // namespace feedhandler
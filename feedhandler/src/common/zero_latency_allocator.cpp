@@ -1,21 +1,45 @@
 #include "common/zero_latency_allocator.hpp"
 #include <sys/mman.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
 #include <cstring>
 #include <algorithm>
 
 namespace feedhandler {
 namespace common {
 
-ZeroLatencyAllocator::ZeroLatencyAllocator(size_t total_size) 
-    : memory_base_(nullptr), total_size_(total_size), current_offset_(0), allocation_count_(0) {
+ZeroLatencyAllocator::ZeroLatencyAllocator(size_t total_size)
+    : ZeroLatencyAllocator(total_size, true, true) {
+}
+
+ZeroLatencyAllocator::ZeroLatencyAllocator(const config::PerformanceConfig::MemoryConfig& memory)
+    : ZeroLatencyAllocator(memory.zero_latency_pool_size, memory.enable_huge_pages,
+                           memory.prefault_memory) {
+}
+
+ZeroLatencyAllocator::ZeroLatencyAllocator(const config::PerformanceConfig::MemoryConfig& memory, int numa_node)
+    : ZeroLatencyAllocator(memory.zero_latency_pool_size, memory.enable_huge_pages,
+                           memory.prefault_memory, memory.enable_numa_allocation ? numa_node : -1) {
+}
+
+ZeroLatencyAllocator::ZeroLatencyAllocator(size_t total_size, bool enable_huge_pages, bool prefault)
+    : ZeroLatencyAllocator(total_size, enable_huge_pages, prefault, -1) {
+}
+
+ZeroLatencyAllocator::ZeroLatencyAllocator(size_t total_size, bool enable_huge_pages, bool prefault, int numa_node)
+    : memory_base_(nullptr), total_size_(total_size), huge_pages_(false), prefaulted_(false),
+      numa_node_(-1), current_offset_(0), allocation_count_(0) {
     
     // Align total size to page boundary
     size_t page_size = getpagesize();
     total_size_ = (total_size + page_size - 1) & ~(page_size - 1);
     
     // Try to setup huge pages first, fallback to regular pages
-    if (!setup_huge_pages()) {
+    huge_pages_ = enable_huge_pages && setup_huge_pages();
+    if (!huge_pages_) {
         // Fallback to regular mmap
         memory_base_ = mmap(nullptr, total_size_, 
                            PROT_READ | PROT_WRITE,
@@ -26,8 +50,15 @@ ZeroLatencyAllocator::ZeroLatencyAllocator(size_t total_size)
         }
     }
     
+    // The policy only affects pages not yet faulted in
+    if (numa_node >= 0 && bind_to_node(numa_node)) {
+        numa_node_ = numa_node;
+    }
+    
     // Prefault all pages to avoid page faults during allocation
-    prefault_memory();
+    if (prefault) {
+        prefault_memory();
+    }
 }
 
 ZeroLatencyAllocator::~ZeroLatencyAllocator() {
@@ -71,16 +102,33 @@ bool ZeroLatencyAllocator::setup_huge_pages() {
     return false;
 }
 
+bool ZeroLatencyAllocator::bind_to_node(int numa_node) {
+#ifdef __linux__
+    constexpr int MASK_BITS = static_cast<int>(sizeof(unsigned long) * 8);
+    if (numa_node >= MASK_BITS) {
+        return false;
+    }
+    // Raw syscall: the region needs no libnuma, and a kernel without NUMA just refuses
+    unsigned long mask = 1UL << numa_node;
+    return syscall(SYS_mbind, memory_base_, total_size_, MPOL_BIND, &mask, MASK_BITS + 1, 0) == 0;
+#else
+    (void)numa_node;
+    return false;
+#endif
+}
+
 void ZeroLatencyAllocator::prefault_memory() {
     if (!memory_base_) return;
     
-    // Touch every page to prefault
+    // Touch every page to prefault; writing back what is there keeps
+    // earlier allocations intact and still faults the page in writable
     size_t page_size = getpagesize();
     volatile char* ptr = static_cast<volatile char*>(memory_base_);
     
     for (size_t offset = 0; offset < total_size_; offset += page_size) {
-        ptr[offset] = 0; // Touch page to fault it in
+        ptr[offset] = ptr[offset];
     }
+    prefaulted_ = true;
 }
 
 void* ZeroLatencyAllocator::allocate(size_t size, size_t alignment) noexcept {
@@ -143,6 +191,18 @@ bool ZeroLatencyAllocator::owns(void* ptr) const noexcept {
     return char_ptr >= base && char_ptr < base + total_size_;
 }
 
+ZeroLatencyAllocator::Arena ZeroLatencyAllocator::create_arena(size_t size) noexcept {
+    constexpr size_t CACHE_LINE_SIZE = 64;
+    size_t arena_size = align_size(size, CACHE_LINE_SIZE);
+    
+    // One shared atomic update per arena instead of per allocation
+    void* base = allocate(arena_size, CACHE_LINE_SIZE);
+    if (!base) {
+        return Arena();
+    }
+    return Arena(static_cast<char*>(base), arena_size);
+}
+
 size_t ZeroLatencyAllocator::align_size(size_t size, size_t alignment) const noexcept {
     return (size + alignment - 1) & ~(alignment - 1);
 }
@@ -0,0 +1,204 @@
+#include "config/hardware_topology.hpp"
+#include "parser/ascii.hpp"
+
+#include <sched.h>
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace feedhandler {
+namespace config {
+
+namespace {
+
+// First line of a sysfs/procfs file, trimmed; empty if unreadable
+std::string read_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return {};
+    }
+    line.resize(parser::ascii::trim_right(line).size());
+    return line;
+}
+
+bool parse_int(std::string_view text, int& value) {
+    if (text.empty()) {
+        return false;
+    }
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+void read_caches(const std::string& cpu_dir, HardwareTopology& topology) {
+    for (int index = 0;; ++index) {
+        const std::string dir = cpu_dir + "/cache/index" + std::to_string(index);
+        const std::string level = read_line(dir + "/level");
+        if (level.empty()) {
+            break;
+        }
+        const std::string type = read_line(dir + "/type");
+        const size_t size = parse_cache_size(read_line(dir + "/size"));
+        if (level == "1" && (type == "Data" || type == "Unified")) {
+            topology.l1d_bytes = size;
+            int line = 0;
+            if (parse_int(read_line(dir + "/coherency_line_size"), line) && line > 0) {
+                topology.cache_line_bytes = static_cast<size_t>(line);
+            }
+        } else if (level == "2") {
+            topology.l2_bytes = size;
+        } else if (level == "3") {
+            topology.l3_bytes = size;
+        }
+    }
+}
+
+void read_huge_pages(const std::string& proc_root, HardwareTopology& topology) {
+    std::ifstream meminfo(proc_root + "/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        size_t value = 0;
+        fields >> key >> value;
+        if (key == "HugePages_Free:") {
+            topology.huge_pages_free = value;
+        } else if (key == "Hugepagesize:") {
+            topology.huge_page_bytes = value * 1024;  // Reported in kB
+        }
+    }
+}
+
+void detect_isa(HardwareTopology& topology) {
+#if defined(__x86_64__) || defined(__i386__)
+    topology.sse42 = __builtin_cpu_supports("sse4.2");
+    topology.avx2 = __builtin_cpu_supports("avx2");
+    topology.avx512bw = __builtin_cpu_supports("avx512bw");
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    topology.neon = true;  // Mandatory on ARMv8-A
+#else
+    (void)topology;
+#endif
+}
+
+} // namespace
+
+std::vector<int> HardwareTopology::core_leaders(int numa_node) const {
+    std::vector<int> leaders;
+    std::vector<int> seen;
+    for (const Cpu& cpu : cpus) {
+        if ((numa_node >= 0 && cpu.numa_node != numa_node) ||
+            std::find(seen.begin(), seen.end(), cpu.core) != seen.end()) {
+            continue;
+        }
+        seen.push_back(cpu.core);
+        leaders.push_back(cpu.id);
+    }
+    return leaders;
+}
+
+std::vector<int> parse_cpu_list(std::string_view list) {
+    std::vector<int> cpus;
+    while (!list.empty()) {
+        const size_t comma = list.find(',');
+        std::string_view range = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+
+        const size_t dash = range.find('-');
+        int first = 0;
+        int last = 0;
+        if (!parse_int(range.substr(0, dash), first) ||
+            (dash != std::string_view::npos && !parse_int(range.substr(dash + 1), last))) {
+            return {};
+        }
+        if (dash == std::string_view::npos) {
+            last = first;
+        }
+        if (last < first) {
+            return {};
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+size_t parse_cache_size(std::string_view size) {
+    size_t multiplier = 1;
+    if (!size.empty() && (size.back() == 'K' || size.back() == 'M' || size.back() == 'G')) {
+        multiplier = size.back() == 'K' ? 1024 : size.back() == 'M' ? 1024 * 1024 : 1024 * 1024 * 1024;
+        size.remove_suffix(1);
+    }
+    int value = 0;
+    return parse_int(size, value) && value > 0 ? static_cast<size_t>(value) * multiplier : 0;
+}
+
+HardwareTopology detect_hardware_topology(const std::string& sys_root, const std::string& proc_root) {
+    HardwareTopology topology;
+    const std::string cpu_root = sys_root + "/devices/system/cpu";
+
+    std::vector<int> online = parse_cpu_list(read_line(cpu_root + "/online"));
+    if (online.empty()) {
+        for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) {
+            online.push_back(static_cast<int>(cpu));
+        }
+    }
+
+    std::map<std::pair<int, int>, int> cores;  // (package, core_id) -> core
+    for (int id : online) {
+        const std::string dir = cpu_root + "/cpu" + std::to_string(id);
+        HardwareTopology::Cpu cpu;
+        cpu.id = id;
+        int core_id = id;  // Without topology files every CPU is its own core
+        parse_int(read_line(dir + "/topology/core_id"), core_id);
+        parse_int(read_line(dir + "/topology/physical_package_id"), cpu.package);
+        cpu.core = cores.emplace(std::make_pair(cpu.package, core_id), static_cast<int>(cores.size())).first->second;
+        topology.cpus.push_back(cpu);
+    }
+    topology.physical_cores = cores.size();
+    read_caches(cpu_root + "/cpu" + std::to_string(online.front()), topology);
+    topology.isolated_cpus = parse_cpu_list(read_line(cpu_root + "/isolated"));
+
+    for (int node : parse_cpu_list(read_line(sys_root + "/devices/system/node/online"))) {
+        std::vector<int> node_cpus =
+            parse_cpu_list(read_line(sys_root + "/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+        for (auto& cpu : topology.cpus) {
+            if (std::find(node_cpus.begin(), node_cpus.end(), cpu.id) != node_cpus.end()) {
+                cpu.numa_node = node;
+            }
+        }
+        if (topology.numa_nodes.size() <= static_cast<size_t>(node)) {
+            topology.numa_nodes.resize(static_cast<size_t>(node) + 1);
+        }
+        topology.numa_nodes[static_cast<size_t>(node)] = std::move(node_cpus);
+    }
+    if (topology.numa_nodes.empty()) {
+        topology.numa_nodes.emplace_back(online);
+    }
+
+    read_huge_pages(proc_root, topology);
+    const std::string thp = read_line(sys_root + "/kernel/mm/transparent_hugepage/enabled");
+    const size_t open = thp.find('[');
+    const size_t close = thp.find(']');
+    if (open != std::string::npos && close > open) {
+        topology.transparent_huge_pages = thp.substr(open + 1, close - open - 1);
+    }
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &mask)) {
+                topology.usable_cpus.push_back(cpu);
+            }
+        }
+    }
+    detect_isa(topology);
+    return topology;
+}
+
+} // namespace config
+} // namespace feedhandler
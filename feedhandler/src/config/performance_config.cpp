@@ -0,0 +1,651 @@
+#include "config/performance_config.hpp"
+#include "parser/ascii.hpp"
+#include "parser/simd_fix_parser.hpp"
+#include "threading/message_queue.hpp"
+#include "threading/spsc_ring.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+namespace feedhandler {
+namespace config {
+
+namespace {
+
+// ---- JSON: just enough for the config file ----
+
+struct Json {
+    enum Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } type = NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::vector<Json> items;
+    std::vector<std::pair<std::string, Json>> members;
+};
+
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view input) : input_(input) {}
+
+    bool parse(Json& out) {
+        if (!value(out, 0)) {
+            return false;
+        }
+        skip_space();
+        return pos_ == input_.size();
+    }
+
+    size_t position() const { return pos_; }
+
+private:
+    static constexpr int MAX_DEPTH = 16;
+
+    std::string_view input_;
+    size_t pos_ = 0;
+
+    void skip_space() {
+        pos_ = static_cast<size_t>(parser::ascii::skip_space(input_.data() + pos_, input_.data() + input_.size()) - input_.data());
+    }
+
+    bool consume(char c) {
+        skip_space();
+        if (pos_ < input_.size() && input_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool literal(std::string_view word) {
+        if (input_.substr(pos_, word.size()) != word) {
+            return false;
+        }
+        pos_ += word.size();
+        return true;
+    }
+
+    bool string(std::string& out) {
+        if (!consume('"')) {
+            return false;
+        }
+        while (pos_ < input_.size() && input_[pos_] != '"') {
+            char c = input_[pos_++];
+            if (c == '\\') {
+                if (pos_ >= input_.size()) {
+                    return false;
+                }
+                char escaped = input_[pos_++];
+                c = escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped;  // Config strings are plain ASCII
+            }
+            out.push_back(c);
+        }
+        return consume('"');
+    }
+
+    bool value(Json& out, int depth) {
+        if (depth > MAX_DEPTH) {
+            return false;
+        }
+        skip_space();
+        if (pos_ >= input_.size()) {
+            return false;
+        }
+        const char c = input_[pos_];
+        if (c == '{') {
+            ++pos_;
+            out.type = Json::OBJECT;
+            if (consume('}')) {
+                return true;
+            }
+            do {
+                std::pair<std::string, Json> member;
+                if (!string(member.first) || !consume(':') || !value(member.second, depth + 1)) {
+                    return false;
+                }
+                out.members.push_back(std::move(member));
+            } while (consume(','));
+            return consume('}');
+        }
+        if (c == '[') {
+            ++pos_;
+            out.type = Json::ARRAY;
+            if (consume(']')) {
+                return true;
+            }
+            do {
+                out.items.emplace_back();
+                if (!value(out.items.back(), depth + 1)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(']');
+        }
+        if (c == '"') {
+            out.type = Json::STRING;
+            return string(out.text);
+        }
+        if (literal("true")) {
+            out.type = Json::BOOL;
+            out.boolean = true;
+            return true;
+        }
+        if (literal("false")) {
+            out.type = Json::BOOL;
+            return true;
+        }
+        if (literal("null")) {
+            return true;
+        }
+        const char* begin = input_.data() + pos_;
+        char* end = nullptr;
+        const std::string number(begin, std::min<size_t>(input_.size() - pos_, 64));
+        out.number = std::strtod(number.c_str(), &end);
+        if (end == number.c_str()) {
+            return false;
+        }
+        out.type = Json::NUMBER;
+        pos_ += static_cast<size_t>(end - number.c_str());
+        return true;
+    }
+};
+
+bool assign(const Json& value, bool& field) {
+    if (value.type != Json::BOOL) {
+        return false;
+    }
+    field = value.boolean;
+    return true;
+}
+
+bool assign(const Json& value, int& field) {
+    if (value.type != Json::NUMBER || value.number != std::floor(value.number) ||
+        std::fabs(value.number) > std::numeric_limits<int>::max()) {
+        return false;
+    }
+    field = static_cast<int>(value.number);
+    return true;
+}
+
+bool assign(const Json& value, size_t& field) {
+    if (value.type != Json::NUMBER || value.number < 0 || value.number != std::floor(value.number) ||
+        value.number > 9.0e15) {
+        return false;
+    }
+    field = static_cast<size_t>(value.number);
+    return true;
+}
+
+bool assign(const Json& value, std::string& field) {
+    if (value.type != Json::STRING) {
+        return false;
+    }
+    field = value.text;
+    return true;
+}
+
+bool assign(const Json& value, std::vector<int>& field) {
+    if (value.type != Json::ARRAY) {
+        return false;
+    }
+    std::vector<int> parsed(value.items.size());
+    for (size_t i = 0; i < value.items.size(); ++i) {
+        if (!assign(value.items[i], parsed[i])) {
+            return false;
+        }
+    }
+    field = std::move(parsed);
+    return true;
+}
+
+void write(std::ostream& out, bool field) { out << (field ? "true" : "false"); }
+void write(std::ostream& out, int field) { out << field; }
+void write(std::ostream& out, size_t field) { out << field; }
+
+void write(std::ostream& out, const std::string& field) {
+    out << '"';
+    for (char c : field) {
+        if (c == '"' || c == '\\') {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+void write(std::ostream& out, const std::vector<int>& field) {
+    out << '[';
+    for (size_t i = 0; i < field.size(); ++i) {
+        out << (i == 0 ? "" : ", ") << field[i];
+    }
+    out << ']';
+}
+
+// Every persisted setting as visit(section, key, field), in file order.
+// One table for both directions keeps load and save from drifting apart.
+template<typename Cpu, typename Memory, typename Parser, typename Queue, typename Monitoring, typename Visit>
+void visit_settings(Cpu& cpu, Memory& memory, Parser& parser, Queue& queue, Monitoring& monitoring, Visit&& visit) {
+    visit("cpu", "parser_thread_affinity", cpu.parser_thread_affinity);
+    visit("cpu", "network_thread_affinity", cpu.network_thread_affinity);
+    visit("cpu", "enable_hyperthreading", cpu.enable_hyperthreading);
+    visit("cpu", "numa_node", cpu.numa_node);
+    visit("cpu", "enable_cpu_isolation", cpu.enable_cpu_isolation);
+    visit("memory", "zero_latency_pool_size", memory.zero_latency_pool_size);
+    visit("memory", "enable_huge_pages", memory.enable_huge_pages);
+    visit("memory", "enable_numa_allocation", memory.enable_numa_allocation);
+    visit("memory", "tick_pool_size", memory.tick_pool_size);
+    visit("memory", "prefault_memory", memory.prefault_memory);
+    visit("parser", "enable_simd", parser.enable_simd);
+    visit("parser", "simd_instruction_set", parser.simd_instruction_set);
+    visit("parser", "enable_branch_prediction", parser.enable_branch_prediction);
+    visit("parser", "enable_garbage_recovery", parser.enable_garbage_recovery);
+    visit("parser", "batch_size", parser.batch_size);
+    visit("queue", "ring_buffer_size", queue.ring_buffer_size);
+    visit("queue", "enable_batching", queue.enable_batching);
+    visit("queue", "batch_size", queue.batch_size);
+    visit("queue", "enable_backpressure", queue.enable_backpressure);
+    visit("queue", "overflow_policy", queue.overflow_policy);
+    visit("monitoring", "enable_hardware_counters", monitoring.enable_hardware_counters);
+    visit("monitoring", "enable_latency_tracking", monitoring.enable_latency_tracking);
+    visit("monitoring", "enable_memory_profiling", monitoring.enable_memory_profiling);
+    visit("monitoring", "metrics_update_interval_ms", monitoring.metrics_update_interval_ms);
+    visit("monitoring", "metrics_output_file", monitoring.metrics_output_file);
+    visit("monitoring", "enable_tracing", monitoring.enable_tracing);
+    visit("monitoring", "trace_buffer_events", monitoring.trace_buffer_events);
+    visit("monitoring", "trace_output_file", monitoring.trace_output_file);
+}
+
+// ---- Microbenchmarks ----
+
+constexpr int RUNS = 3;                    // Best of, to shed scheduler noise
+constexpr size_t BENCH_MESSAGES = 256;
+constexpr size_t BENCH_BUFFERS = 1 << 15;  // Per ring measurement
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+// Quote-like traffic, and the offset after each message
+std::string synthetic_messages(std::vector<size_t>& ends) {
+    std::string stream;
+    for (size_t i = 0; i < BENCH_MESSAGES; ++i) {
+        stream += "8=FIX.4.4\x01" "9=79\x01" "35=W\x01" "55=SYM" + std::to_string(i % 37) + "\x01"
+                  "270=" + std::to_string(100 + i % 50) + "." + std::to_string(i % 100) + "\x01"
+                  "271=" + std::to_string(100 * (1 + i % 9)) + "\x01" "269=" + std::to_string(i % 2) +
+                  "\x01" "52=20240131-12:34:56.789\x01" "10=020\x01";
+        ends.push_back(stream.size());
+    }
+    return stream;
+}
+
+// ns per message parsing the stream batch messages per parse() call
+double time_parser(parser::SimdLevel level, const std::string& stream, const std::vector<size_t>& ends, size_t batch) {
+    parser::SIMDFixParser parser(level);
+    std::vector<common::Tick> ticks;
+    ticks.reserve(BENCH_MESSAGES);
+    uint64_t best = std::numeric_limits<uint64_t>::max();
+    for (int run = 0; run < RUNS; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < 4; ++pass) {
+            size_t begin = 0;
+            for (size_t i = batch - 1; begin < stream.size(); i += batch) {
+                const size_t end = ends[std::min(i, ends.size() - 1)];
+                ticks.clear();
+                parser.parse(stream.data() + begin, end - begin, ticks);
+                begin = end;
+            }
+        }
+        best = std::min(best, elapsed_ns(start));
+    }
+    return static_cast<double>(best) / (4.0 * BENCH_MESSAGES);
+}
+
+// ns per buffer through an SpscRing of capacity ring in bursts of burst.
+// With a spare CPU the consumer runs on its own thread; otherwise bursts
+// alternate on this one, which still exposes each size's cache footprint.
+double time_ring(size_t ring_size, size_t burst, bool threaded) {
+    uint64_t best = std::numeric_limits<uint64_t>::max();
+    for (int run = 0; run < RUNS; ++run) {
+        threading::SpscRing<threading::MessageBuffer> ring(ring_size);
+        burst = std::min(burst, ring.capacity());
+        const auto start = std::chrono::steady_clock::now();
+        if (threaded) {
+            std::thread consumer([&ring] {
+                threading::MessageBuffer buffer;
+                for (size_t received = 0; received < BENCH_BUFFERS;) {
+                    if (ring.try_pop(buffer)) {
+                        ++received;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            for (size_t sent = 0; sent < BENCH_BUFFERS;) {
+                size_t pushed = 0;
+                while (pushed < burst && sent < BENCH_BUFFERS) {
+                    threading::MessageBuffer buffer;
+                    buffer.length = sent;
+                    if (ring.try_push(std::move(buffer))) {
+                        ++pushed;
+                        ++sent;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+            consumer.join();
+        } else {
+            threading::MessageBuffer buffer;
+            for (size_t sent = 0; sent < BENCH_BUFFERS; sent += burst) {
+                for (size_t i = 0; i < burst; ++i) {
+                    threading::MessageBuffer item;
+                    item.length = sent + i;
+                    ring.try_push(std::move(item));
+                }
+                for (size_t i = 0; i < burst; ++i) {
+                    ring.try_pop(buffer);
+                }
+            }
+        }
+        best = std::min(best, elapsed_ns(start));
+    }
+    return static_cast<double>(best) / static_cast<double>(BENCH_BUFFERS);
+}
+
+// LATENCY: the smallest candidate within 10% of the fastest; THROUGHPUT: the fastest
+template<typename Candidate>
+Candidate choose(const std::vector<std::pair<Candidate, double>>& timings, PerformanceConfig::TuningGoal goal) {
+    auto fastest = std::min_element(timings.begin(), timings.end(),
+                                    [](const auto& a, const auto& b) { return a.second < b.second; });
+    if (goal == PerformanceConfig::TuningGoal::THROUGHPUT) {
+        return fastest->first;
+    }
+    for (const auto& [candidate, ns] : timings) {  // Ascending
+        if (ns <= fastest->second * 1.10) {
+            return candidate;
+        }
+    }
+    return fastest->first;
+}
+
+template<typename Candidate>
+void write_timings(std::ostream& out, const char* name, const std::vector<std::pair<Candidate, double>>& timings,
+                   bool last) {
+    out << "    \"" << name << "\": {";
+    for (size_t i = 0; i < timings.size(); ++i) {
+        out << (i == 0 ? "" : ", ") << '"' << timings[i].first << "\": " << timings[i].second;
+    }
+    out << (last ? "}\n" : "},\n");
+}
+
+} // namespace
+
+PerformanceConfig& PerformanceConfig::instance() {
+    static PerformanceConfig config;
+    return config;
+}
+
+bool PerformanceConfig::load_from_file(const std::string& config_file) {
+    std::ifstream file(config_file);
+    if (!file) {
+        std::cerr << "[PerformanceConfig] Cannot open " << config_file << std::endl;
+        return false;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string text = contents.str();
+
+    Json root;
+    JsonReader reader(text);
+    if (!reader.parse(root) || root.type != Json::OBJECT) {
+        std::cerr << "[PerformanceConfig] " << config_file << ": malformed JSON near byte " << reader.position()
+                  << std::endl;
+        return false;
+    }
+
+    // Staged, so a bad value leaves the current configuration untouched
+    CPUConfig cpu = cpu_config_;
+    MemoryConfig memory = memory_config_;
+    ParserConfig parser = parser_config_;
+    QueueConfig queue = queue_config_;
+    MonitoringConfig monitoring = monitoring_config_;
+    bool valid = true;
+    for (const auto& [section, settings] : root.members) {
+        if (section == "hardware" || section == "tuning") {
+            continue;  // Written by auto_tune() for reference
+        }
+        if (settings.type != Json::OBJECT) {
+            std::cerr << "[PerformanceConfig] " << config_file << ": \"" << section << "\" is not an object"
+                      << std::endl;
+            valid = false;
+            continue;
+        }
+        for (const auto& [key, value] : settings.members) {
+            bool known = false;
+            visit_settings(cpu, memory, parser, queue, monitoring,
+                           [&](const char* s, const char* k, auto& field) {
+                if (known || section != s || key != k) {
+                    return;
+                }
+                known = true;
+                if (!assign(value, field)) {
+                    std::cerr << "[PerformanceConfig] " << config_file << ": wrong type for " << section << "."
+                              << key << std::endl;
+                    valid = false;
+                }
+            });
+            if (!known) {
+                // Not fatal, but a typo here is a setting that silently does nothing
+                std::cerr << "[PerformanceConfig] " << config_file << ": unknown setting " << section << "." << key
+                          << std::endl;
+            }
+        }
+    }
+    if (!valid) {
+        return false;
+    }
+    cpu_config_ = std::move(cpu);
+    memory_config_ = std::move(memory);
+    parser_config_ = std::move(parser);
+    queue_config_ = std::move(queue);
+    monitoring_config_ = std::move(monitoring);
+    return true;
+}
+
+bool PerformanceConfig::save_to_file(const std::string& config_file) const {
+    std::ostringstream out;
+    out << "{\n";
+    std::string section;
+    visit_settings(cpu_config_, memory_config_, parser_config_, queue_config_, monitoring_config_,
+                   [&](const char* s, const char* key, const auto& field) {
+        if (section != s) {
+            out << (section.empty() ? "" : "\n  },\n") << "  \"" << s << "\": {\n";
+            section = s;
+        } else {
+            out << ",\n";
+        }
+        out << "    \"" << key << "\": ";
+        write(out, field);
+    });
+    out << "\n  }";
+
+    if (tuning_.measured) {
+        out << ",\n  \"hardware\": {\n"
+            << "    \"logical_cpus\": " << hardware_.logical_cpus() << ",\n"
+            << "    \"physical_cores\": " << hardware_.physical_cores << ",\n"
+            << "    \"numa_nodes\": " << hardware_.numa_nodes.size() << ",\n"
+            << "    \"isolated_cpus\": ";
+        write(out, hardware_.isolated_cpus);
+        out << ",\n    \"l1d_bytes\": " << hardware_.l1d_bytes << ",\n"
+            << "    \"l2_bytes\": " << hardware_.l2_bytes << ",\n"
+            << "    \"l3_bytes\": " << hardware_.l3_bytes << ",\n"
+            << "    \"cache_line_bytes\": " << hardware_.cache_line_bytes << ",\n"
+            << "    \"huge_page_bytes\": " << hardware_.huge_page_bytes << ",\n"
+            << "    \"huge_pages_free\": " << hardware_.huge_pages_free << ",\n"
+            << "    \"transparent_huge_pages\": ";
+        write(out, hardware_.transparent_huge_pages);
+        out << "\n  },\n  \"tuning\": {\n"
+            << "    \"goal\": \"" << (tuning_.goal == TuningGoal::LATENCY ? "latency" : "throughput") << "\",\n"
+            << std::fixed << std::setprecision(2);
+        write_timings(out, "simd_ns_per_message", tuning_.simd_levels, false);
+        write_timings(out, "parser_batch_ns_per_message", tuning_.parser_batch_sizes, false);
+        write_timings(out, "ring_ns_per_buffer", tuning_.ring_sizes, false);
+        write_timings(out, "queue_batch_ns_per_buffer", tuning_.queue_batch_sizes, true);
+        out << "  }";
+    }
+    out << "\n}\n";
+
+    std::ofstream file(config_file);
+    if (!file || !(file << out.str())) {
+        std::cerr << "[PerformanceConfig] Cannot write " << config_file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void PerformanceConfig::auto_tune(TuningGoal goal) {
+    detect_hardware_capabilities();
+    tuning_.goal = goal;
+    run_microbenchmarks();
+    if (goal == TuningGoal::LATENCY) {
+        optimize_for_latency();
+    } else {
+        optimize_for_throughput();
+    }
+}
+
+bool PerformanceConfig::auto_tune(const std::string& output_file, TuningGoal goal) {
+    auto_tune(goal);
+    return save_to_file(output_file);
+}
+
+void PerformanceConfig::detect_hardware_capabilities() {
+    hardware_ = detect_hardware_topology();
+
+    parser_config_.enable_simd = hardware_.sse42 || hardware_.neon;
+    parser_config_.simd_instruction_set =
+        parser::SIMDFixParser::simd_level_name(parser::SIMDFixParser::detect_simd_level());
+
+    // Explicit huge pages fit the pool, or the allocator's THP fallback can kick in
+    const bool reserved = hardware_.huge_pages_free * hardware_.huge_page_bytes >= memory_config_.zero_latency_pool_size;
+    memory_config_.enable_huge_pages =
+        reserved || (!hardware_.transparent_huge_pages.empty() && hardware_.transparent_huge_pages != "never");
+    memory_config_.enable_numa_allocation = hardware_.numa_nodes.size() > 1;
+
+    if (!cpu_config_.parser_thread_affinity.empty() || !cpu_config_.network_thread_affinity.empty()) {
+        return;  // Pinned by hand
+    }
+    // Only CPUs this process may run on (its cpuset or taskset)
+    auto usable = [this](std::vector<int> cpus) {
+        cpus.erase(std::remove_if(cpus.begin(), cpus.end(), [this](int cpu) {
+            return std::find(hardware_.usable_cpus.begin(), hardware_.usable_cpus.end(), cpu) ==
+                   hardware_.usable_cpus.end();
+        }), cpus.end());
+        return cpus;
+    };
+    std::vector<int> candidates;
+    if (cpu_config_.enable_cpu_isolation) {
+        candidates = usable(hardware_.isolated_cpus);
+    }
+    if (cpu_config_.numa_node < 0 && hardware_.numa_nodes.size() > 1) {
+        // The node of the first isolated CPU, else node 0
+        cpu_config_.numa_node = 0;
+        for (const auto& cpu : hardware_.cpus) {
+            if (!candidates.empty() && cpu.id == candidates.front()) {
+                cpu_config_.numa_node = cpu.numa_node;
+            }
+        }
+    }
+    if (candidates.size() < 2) {
+        if (cpu_config_.enable_hyperthreading) {
+            candidates.clear();
+            for (const auto& cpu : hardware_.cpus) {
+                if (cpu_config_.numa_node < 0 || cpu.numa_node == cpu_config_.numa_node) {
+                    candidates.push_back(cpu.id);
+                }
+            }
+            candidates = usable(std::move(candidates));
+        } else {
+            candidates = usable(hardware_.core_leaders(cpu_config_.numa_node));
+        }
+        if (candidates.size() > 2 && candidates.front() == 0) {
+            candidates.erase(candidates.begin());  // CPU 0 takes most interrupts and housekeeping
+        }
+    }
+    if (candidates.size() < 2) {
+        return;  // Nothing to gain from pinning both threads to the only CPU
+    }
+    cpu_config_.network_thread_affinity = {candidates[0]};
+    cpu_config_.parser_thread_affinity = {candidates[1]};
+}
+
+void PerformanceConfig::run_microbenchmarks() {
+    const TuningGoal goal = tuning_.goal;
+    tuning_ = TuningResults{};
+    tuning_.goal = goal;
+    std::vector<size_t> ends;
+    const std::string stream = synthetic_messages(ends);
+
+    parser::SimdLevel fastest = parser::SimdLevel::SCALAR;
+    double fastest_ns = std::numeric_limits<double>::max();
+    for (parser::SimdLevel level : {parser::SimdLevel::SCALAR, parser::SimdLevel::SSE42, parser::SimdLevel::AVX2,
+                                    parser::SimdLevel::AVX512BW, parser::SimdLevel::NEON}) {
+        if (parser::SIMDFixParser::supported_simd_level(level) != level) {
+            continue;
+        }
+        const double ns = time_parser(level, stream, ends, BENCH_MESSAGES);
+        tuning_.simd_levels.emplace_back(parser::SIMDFixParser::simd_level_name(level), ns);
+        if (ns < fastest_ns) {
+            fastest = level;
+            fastest_ns = ns;
+        }
+    }
+    for (size_t batch : {1, 4, 16, 64, 256}) {
+        tuning_.parser_batch_sizes.emplace_back(batch, time_parser(fastest, stream, ends, batch));
+    }
+
+    const bool threaded = hardware_.usable_cpus.size() >= 2;
+    const size_t floor = std::max<size_t>(queue_config_.ring_buffer_size, 2);
+    for (size_t ring = floor; ring <= floor * 64; ring *= 4) {
+        tuning_.ring_sizes.emplace_back(ring, time_ring(ring, 16, threaded));
+    }
+    for (size_t burst : {1, 4, 16, 64}) {
+        tuning_.queue_batch_sizes.emplace_back(burst, time_ring(floor, burst, threaded));
+    }
+    tuning_.measured = true;
+}
+
+void PerformanceConfig::optimize_for_latency() {
+    if (!tuning_.measured) {
+        return;
+    }
+    // The fastest kernel wins either way; the rest trades a little speed for smaller steps
+    parser_config_.simd_instruction_set = choose(tuning_.simd_levels, TuningGoal::THROUGHPUT);
+    parser_config_.batch_size = choose(tuning_.parser_batch_sizes, TuningGoal::LATENCY);
+    queue_config_.ring_buffer_size = choose(tuning_.ring_sizes, TuningGoal::LATENCY);
+    queue_config_.batch_size = choose(tuning_.queue_batch_sizes, TuningGoal::LATENCY);
+    queue_config_.enable_batching = queue_config_.batch_size > 1;
+}
+
+void PerformanceConfig::optimize_for_throughput() {
+    if (!tuning_.measured) {
+        return;
+    }
+    parser_config_.simd_instruction_set = choose(tuning_.simd_levels, TuningGoal::THROUGHPUT);
+    parser_config_.batch_size = choose(tuning_.parser_batch_sizes, TuningGoal::THROUGHPUT);
+    queue_config_.ring_buffer_size = choose(tuning_.ring_sizes, TuningGoal::THROUGHPUT);
+    queue_config_.batch_size = choose(tuning_.queue_batch_sizes, TuningGoal::THROUGHPUT);
+    queue_config_.enable_batching = queue_config_.batch_size > 1;
+}
+
+} // namespace config
+} // namespace feedhandler
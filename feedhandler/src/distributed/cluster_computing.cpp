@@ -0,0 +1,1166 @@
+#include "distributed/cluster_computing.hpp"
+#include "distributed/shm_channel.hpp"
+#include "net/event_loop.hpp"
+#include "net/receive_buffer.hpp"
+#include "net/tcp_client.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+
+namespace feedhandler {
+namespace distributed {
+
+namespace {
+
+constexpr uint64_t MISSED_HEARTBEATS = 3;  // Silent intervals before a peer counts as failed
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+constexpr size_t PARTITION_SEGMENT_BYTES = 32 * 1024;  // Fits any batch and shared-memory ring
+constexpr size_t CLOSED_SHUFFLES_KEPT = 64;
+
+// Prefix of every MAP_REDUCE_PARTITION payload; segment bytes follow
+struct PartitionSegmentHeader {
+    uint64_t job;          // node_hash() of the task name
+    uint32_t partition;
+    uint32_t reserved;
+    uint64_t total_bytes;  // Whole partition
+    uint64_t offset;       // Of this segment
+};
+
+// Prefix of a SYMBOL_MIGRATE payload; the symbol and the new owner's node ID follow
+struct SymbolMigrateHeader {
+    uint32_t symbol_bytes;
+    uint32_t target_bytes;
+};
+
+// Prefix of a SYMBOL_HANDOFF payload; the symbol and its exported state follow
+struct SymbolHandoffHeader {
+    double rate;           // Messages per second at the old owner
+    uint32_t symbol_bytes;
+    uint32_t reserved;
+    uint64_t state_bytes;
+};
+
+double free_cpu(const ClusterManager::NodeInfo& node) {
+    return std::max(0.05, 1.0 - node.cpu_utilization);
+}
+
+SymbolLoadBalancer::Config balancer_config(const ClusterManager::ClusterConfig& config) {
+    SymbolLoadBalancer::Config balancer;
+    balancer.trigger_imbalance = config.rebalance_trigger;
+    balancer.target_imbalance = config.rebalance_target;
+    balancer.max_moves = config.max_migrations_per_round;
+    balancer.cooldown_ns = static_cast<uint64_t>(config.migration_cooldown_ms) * 1000000ull;
+    return balancer;
+}
+
+net::EventLoopConfig level_triggered() {
+    net::EventLoopConfig config;
+    config.edge_triggered = false;  // One recv() per readiness, the rest is reported again
+    return config;
+}
+
+} // namespace
+
+struct ClusterManager::Shuffle {
+    // Reassembled per partition and sender, so two copies of a partition
+    // (original and speculative) never mix
+    struct Assembly {
+        std::vector<uint8_t> bytes;
+        uint64_t received = 0;
+        std::vector<uint64_t> offsets;
+    };
+    std::unordered_map<uint64_t, Assembly> assembling;  // partition << 32 | sender
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> complete;
+    std::vector<uint32_t> delivered;
+};
+
+struct ClusterManager::Transport {
+    struct Peer {
+        std::string host;
+        uint16_t port = 0;
+        bool colocated = false;
+        net::TcpClient tcp;        // Persistent: connected on the first flush, kept open
+        ShmFrameChannel shm;       // Outbound ring when colocated
+        FrameWriter batch;
+    };
+
+    struct Connection {
+        int fd;
+        std::unique_ptr<net::ReceiveBuffer> buffer;
+    };
+
+    std::mutex outbound_mutex;
+    std::unordered_map<std::string, std::unique_ptr<Peer>> peers;
+    uint32_t local_hash = 0;
+
+    std::mutex inbound_mutex;
+    int listen_fd = -1;
+    net::EventLoop loop{level_triggered()};
+    std::unordered_map<int, Connection> connections;
+    std::unordered_map<std::string, std::unique_ptr<ShmFrameChannel>> shm_inbound;  // By sending node
+    std::vector<std::string> shm_names;                                            // Unlinked on shutdown
+
+    TransportStats stats;  // Sent counters under outbound_mutex, received under inbound_mutex
+    uint64_t created_ns = now_ns();
+
+    std::mutex wake_mutex;
+    std::condition_variable wake;  // Cuts the heartbeat sleep short on stop()
+
+    ~Transport() {
+        for (auto& [fd, connection] : connections) {
+            ::close(fd);
+        }
+        if (listen_fd >= 0) {
+            ::close(listen_fd);
+        }
+        for (const auto& name : shm_names) {
+            ShmFrameChannel::unlink(name);
+        }
+    }
+
+    // Sends peer's batch; the batch is dropped on failure
+    bool flush(Peer& peer) {
+        if (peer.batch.empty()) {
+            return true;
+        }
+        bool sent;
+        if (peer.colocated) {
+            sent = peer.shm.write(peer.batch);
+            stats.shm_batches += sent ? 1 : 0;
+        } else {
+            if (!peer.tcp.is_connected() && !peer.tcp.connect(peer.host, peer.port)) {
+                sent = false;
+            } else {
+                sent = peer.tcp.send(reinterpret_cast<const char*>(peer.batch.data()), peer.batch.size());
+                if (!sent) {
+                    peer.tcp.close();  // Reconnect on the next flush
+                }
+            }
+        }
+        if (sent) {
+            stats.frames_sent += peer.batch.frame_count();
+            stats.batches_sent++;
+            stats.bytes_sent += peer.batch.size();
+        } else {
+            stats.send_failures++;
+        }
+        peer.batch.clear();
+        return sent;
+    }
+};
+
+ClusterManager::ClusterManager(const ClusterConfig& config)
+    : config_(config)
+    , transport_(std::make_unique<Transport>())
+    , symbol_rates_(config.rate_half_life_ms, now_ns())
+    , balancer_(balancer_config(config))
+    , running_(false) {}
+
+ClusterManager::~ClusterManager() {
+    stop();
+}
+
+std::pair<bool, std::string> ClusterManager::join_cluster(const NodeInfo& node_capabilities) {
+    NodeInfo node = node_capabilities;
+    bool local;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        if (cluster_nodes_.size() >= config_.max_nodes) {
+            std::cerr << "Cluster " << config_.cluster_name << " is full (" << config_.max_nodes << " nodes)"
+                      << std::endl;
+            return {false, ""};
+        }
+        local = local_node_id_.empty();
+    }
+
+    if (local) {
+        // Listen before the ID is derived: port 0 means "pick one"
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(node.port);
+        if (fd < 0 || inet_pton(AF_INET, node.ip_address.c_str(), &addr.sin_addr) != 1 ||
+            bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 64) != 0) {
+            std::cerr << "Cannot listen on " << node.ip_address << ":" << node.port << " - " << strerror(errno)
+                      << std::endl;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            return {false, ""};
+        }
+        socklen_t len = sizeof(addr);
+        getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        node.port = ntohs(addr.sin_port);
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+        std::lock_guard<std::mutex> lock(transport_->inbound_mutex);
+        transport_->listen_fd = fd;
+        transport_->loop.add_socket(fd);
+    }
+
+    if (node.node_id.empty()) {
+        node.node_id = node.ip_address + ":" + std::to_string(node.port);
+    }
+    node.last_heartbeat = now_ns();
+    node.is_healthy = true;
+
+    std::string local_ip;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        if (cluster_nodes_.count(node.node_id) != 0) {
+            std::cerr << "Node " << node.node_id << " already joined" << std::endl;
+            return {false, ""};
+        }
+        if (local) {
+            local_node_id_ = node.node_id;
+        }
+        local_ip = cluster_nodes_.empty() ? node.ip_address : cluster_nodes_[local_node_id_].ip_address;
+        cluster_nodes_[node.node_id] = node;
+        node_of_hash_[node_hash(node.node_id)] = node.node_id;
+        membership_epoch_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    if (local) {
+        std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+        transport_->local_hash = node_hash(node.node_id);
+        return {true, node.node_id};
+    }
+
+    bool colocated = config_.shared_memory_transport && node.ip_address == local_ip;
+    {
+        std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+        auto peer = std::make_unique<Transport::Peer>();
+        peer->host = node.ip_address;
+        peer->port = node.port;
+        peer->batch.set_sender(transport_->local_hash);
+        peer->colocated = colocated && peer->shm.open(channel_name(local_node_id_, node.node_id),
+                                                      config_.shm_channel_bytes);
+        transport_->peers[node.node_id] = std::move(peer);
+    }
+    if (colocated) {
+        // Our inbound ring from this peer; we own (and unlink) the name
+        std::string name = channel_name(node.node_id, local_node_id_);
+        auto channel = std::make_unique<ShmFrameChannel>();
+        std::lock_guard<std::mutex> lock(transport_->inbound_mutex);
+        if (channel->open(name, config_.shm_channel_bytes)) {
+            transport_->shm_inbound[node.node_id] = std::move(channel);
+            transport_->shm_names.push_back(name);
+        }
+    }
+    return {true, node.node_id};
+}
+
+void ClusterManager::leave_cluster(const std::string& node_id) {
+    if (node_id == local_node_id_) {
+        stop();
+    }
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        auto it = cluster_nodes_.find(node_id);
+        if (it == cluster_nodes_.end()) {
+            return;
+        }
+        // Symbols go to the remaining nodes through redistribute_workload()
+        it->second.is_healthy = false;
+    }
+    if (node_id != local_node_id_) {
+        redistribute_workload();
+    }
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        cluster_nodes_.erase(node_id);
+        node_of_hash_.erase(node_hash(node_id));
+        membership_epoch_.fetch_add(1, std::memory_order_acq_rel);
+    }
+    {
+        std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+        transport_->peers.erase(node_id);
+    }
+    std::lock_guard<std::mutex> lock(transport_->inbound_mutex);
+    transport_->shm_inbound.erase(node_id);
+}
+
+std::unordered_map<std::string, std::vector<std::string>>
+ClusterManager::distribute_workload(const std::vector<std::string>& symbols,
+                                    const std::function<void(const std::vector<std::string>&)>& processing_function) {
+    symbol_rates_.sample(now_ns());
+    const auto rates = symbol_rates_.rates();
+    const bool measured = std::any_of(symbols.begin(), symbols.end(), [&rates](const std::string& symbol) {
+        auto it = rates.find(symbol);
+        return it != rates.end() && it->second > 0.0;
+    });
+
+    std::unordered_map<std::string, std::vector<std::string>> distribution;
+    std::vector<std::string> nodes;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        for (auto& [id, node] : cluster_nodes_) {
+            node.assigned_symbols.clear();
+            if (node.is_healthy) {
+                nodes.push_back(id);
+            }
+        }
+        if (nodes.empty()) {
+            return distribution;
+        }
+        std::sort(nodes.begin(), nodes.end());
+
+        if (measured) {
+            std::vector<SymbolLoadBalancer::Node> placement;
+            for (const auto& id : nodes) {
+                placement.push_back(SymbolLoadBalancer::Node{id, free_cpu(cluster_nodes_[id]), {}});
+            }
+            SymbolLoadBalancer::place(placement, symbols, rates);
+            for (auto& node : placement) {
+                cluster_nodes_[node.id].assigned_symbols = node.symbols;
+                distribution[node.id] = std::move(node.symbols);
+            }
+        } else {
+            // Contiguous, even split: node k gets symbols [k * n / N, (k + 1) * n / N)
+            for (size_t k = 0; k < nodes.size(); ++k) {
+                size_t first = k * symbols.size() / nodes.size();
+                size_t last = (k + 1) * symbols.size() / nodes.size();
+                auto& assigned = cluster_nodes_[nodes[k]].assigned_symbols;
+                assigned.assign(symbols.begin() + static_cast<std::ptrdiff_t>(first),
+                                symbols.begin() + static_cast<std::ptrdiff_t>(last));
+                distribution[nodes[k]] = assigned;
+            }
+        }
+        workload_function_ = processing_function;
+        coordinator_ = local_node_id_;
+    }
+
+    send_assignments(distribution, processing_function);
+    return distribution;
+}
+
+void ClusterManager::set_symbol_handoff(SymbolStateExporter exporter, SymbolStateImporter importer) {
+    symbol_exporter_ = std::move(exporter);
+    symbol_importer_ = std::move(importer);
+}
+
+size_t ClusterManager::rebalance_workload() {
+    std::lock_guard<std::mutex> round(rebalance_mutex_);
+    std::vector<SymbolLoadBalancer::Node> nodes;
+    std::function<void(const std::vector<std::string>&)> local_function;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        if (local_node_id_.empty() || coordinator_ != local_node_id_) {
+            return 0;
+        }
+        for (const auto& [id, node] : cluster_nodes_) {
+            if (node.is_healthy) {
+                nodes.push_back(SymbolLoadBalancer::Node{id, free_cpu(node), node.assigned_symbols});
+            }
+        }
+        local_function = workload_function_;
+    }
+    // Same order on every call, so ties break the same way
+    std::sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b) { return a.id < b.id; });
+
+    const uint64_t now = now_ns();
+    symbol_rates_.sample(now);
+    const auto rates = symbol_rates_.rates();
+    last_imbalance_.store(SymbolLoadBalancer::imbalance(nodes, rates), std::memory_order_relaxed);
+    const auto moves = balancer_.plan(nodes, rates, now);
+    if (moves.empty()) {
+        return 0;
+    }
+
+    std::unordered_map<std::string, std::vector<std::string>> changed;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        for (auto& node : nodes) {
+            auto it = cluster_nodes_.find(node.id);
+            if (it != cluster_nodes_.end()) {
+                it->second.assigned_symbols = node.symbols;
+            }
+        }
+        for (const auto& move : moves) {
+            changed[move.from] = cluster_nodes_[move.from].assigned_symbols;
+            changed[move.to] = cluster_nodes_[move.to].assigned_symbols;
+        }
+    }
+    rebalance_rounds_.fetch_add(1, std::memory_order_relaxed);
+    migrations_.fetch_add(moves.size(), std::memory_order_relaxed);
+
+    if (!symbol_exporter_ || !symbol_importer_) {
+        send_assignments(changed, local_function);  // Stateless: reassign like failover
+        return moves.size();
+    }
+    for (const auto& move : moves) {
+        if (move.from == local_node_id_) {
+            hand_off_symbol(move.symbol, move.to, false);
+            continue;
+        }
+        std::vector<uint8_t> payload(sizeof(SymbolMigrateHeader) + move.symbol.size() + move.to.size());
+        SymbolMigrateHeader header{static_cast<uint32_t>(move.symbol.size()), static_cast<uint32_t>(move.to.size())};
+        std::memcpy(payload.data(), &header, sizeof(header));
+        std::memcpy(payload.data() + sizeof(header), move.symbol.data(), move.symbol.size());
+        std::memcpy(payload.data() + sizeof(header) + move.symbol.size(), move.to.data(), move.to.size());
+        if (!send_message_now(move.from, MessageType::SYMBOL_MIGRATE, payload.data(), payload.size(), 1000)) {
+            std::cerr << "ClusterManager: could not migrate " << move.symbol << " off " << move.from << std::endl;
+        }
+    }
+    return moves.size();
+}
+
+ClusterManager::RebalanceStats ClusterManager::get_rebalance_stats() const {
+    RebalanceStats stats;
+    stats.rounds = rebalance_rounds_.load(std::memory_order_relaxed);
+    stats.migrations = migrations_.load(std::memory_order_relaxed);
+    stats.handoffs_sent = handoffs_sent_.load(std::memory_order_relaxed);
+    stats.handoffs_received = handoffs_received_.load(std::memory_order_relaxed);
+    stats.handoff_bytes = handoff_bytes_.load(std::memory_order_relaxed);
+    stats.imbalance = last_imbalance_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ClusterManager::send_assignments(const std::unordered_map<std::string, std::vector<std::string>>& assignments,
+                                      const std::function<void(const std::vector<std::string>&)>& local_function) {
+    {
+        std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+        for (const auto& [id, assigned] : assignments) {
+            auto peer = transport_->peers.find(id);
+            if (peer != transport_->peers.end()) {
+                write_workload_assignment(peer->second->batch, assigned);
+                transport_->flush(*peer->second);
+            }
+        }
+    }
+    auto local = assignments.find(local_node_id_);
+    if (local != assignments.end() && local_function) {
+        local_function(local->second);
+    }
+}
+
+ClusterManager::ClusterStatus ClusterManager::get_cluster_status() const {
+    ClusterStatus status{};
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        status.total_nodes = cluster_nodes_.size();
+        double cpu = 0.0;
+        for (const auto& [id, node] : cluster_nodes_) {
+            status.healthy_nodes += node.is_healthy ? 1 : 0;
+            status.total_memory_mb += node.memory_usage_mb;
+            cpu += node.cpu_utilization;
+            status.node_details.push_back(node);
+        }
+        status.average_cpu_utilization = cluster_nodes_.empty() ? 0.0 : cpu / static_cast<double>(cluster_nodes_.size());
+    }
+    TransportStats stats = get_transport_stats();
+    double seconds = static_cast<double>(now_ns() - transport_->created_ns) / 1e9;
+    status.network_throughput_gbps =
+        seconds > 0.0 ? static_cast<double>(stats.bytes_sent + stats.bytes_received) * 8.0 / seconds / 1e9 : 0.0;
+    return status;
+}
+
+void ClusterManager::set_auto_failover(bool enable) {
+    auto_failover_.store(enable, std::memory_order_relaxed);
+}
+
+bool ClusterManager::start() {
+    if (local_node_id_.empty()) {
+        std::cerr << "ClusterManager::start: join_cluster() the local node first" << std::endl;
+        return false;
+    }
+    if (running_.exchange(true)) {
+        return true;
+    }
+    heartbeat_thread_ = std::thread(&ClusterManager::heartbeat_loop, this);
+    if (config_.rebalance_interval_ms > 0) {
+        load_balancer_thread_ = std::thread(&ClusterManager::load_balance_loop, this);
+    }
+    return true;
+}
+
+void ClusterManager::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(transport_->wake_mutex);
+        transport_->wake.notify_all();
+    }
+    if (heartbeat_thread_.joinable()) {
+        heartbeat_thread_.join();
+    }
+    if (load_balancer_thread_.joinable()) {
+        load_balancer_thread_.join();
+    }
+}
+
+bool ClusterManager::send_message(const std::string& node_id, MessageType type, const void* payload, size_t length) {
+    if (length > MAX_FRAME_PAYLOAD) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+    auto it = transport_->peers.find(node_id);
+    if (it == transport_->peers.end()) {
+        return false;
+    }
+    Transport::Peer& peer = *it->second;
+    peer.batch.append(type, payload, length);
+    if (peer.batch.size() >= config_.max_batch_bytes) {
+        transport_->flush(peer);
+    }
+    return true;
+}
+
+void ClusterManager::broadcast_message(MessageType type, const void* payload, size_t length) {
+    std::vector<std::string> targets;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        for (const auto& [id, node] : cluster_nodes_) {
+            if (id != local_node_id_ && node.is_healthy) {
+                targets.push_back(id);
+            }
+        }
+    }
+    for (const auto& id : targets) {
+        send_message(id, type, payload, length);
+    }
+}
+
+size_t ClusterManager::flush_messages() {
+    std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+    size_t frames = 0;
+    for (auto& [id, peer] : transport_->peers) {
+        size_t pending = peer->batch.frame_count();
+        frames += transport_->flush(*peer) ? pending : 0;
+    }
+    return frames;
+}
+
+size_t ClusterManager::poll_messages(int timeout_ms) {
+    std::lock_guard<std::mutex> lock(transport_->inbound_mutex);
+    Transport& transport = *transport_;
+    size_t before = transport.stats.frames_received;
+
+    for (auto& [id, channel] : transport.shm_inbound) {
+        channel->read([&](const Frame& frame) {
+            transport.stats.bytes_received += frame_size(frame.size());
+            handle_frame(frame);
+        });
+    }
+    // Shared-memory traffic already arrived: only peek at the sockets
+    if (transport.stats.frames_received != before) {
+        timeout_ms = 0;
+    }
+
+    if (transport.loop.socket_count() == 0 || !transport.loop.run_once(timeout_ms)) {
+        return transport.stats.frames_received - before;
+    }
+    std::vector<int> ready = transport.loop.ready_sockets();
+    for (int fd : ready) {
+        if (fd == transport.listen_fd) {
+            int peer;
+            while ((peer = ::accept(transport.listen_fd, nullptr, nullptr)) >= 0) {
+                fcntl(peer, F_SETFL, fcntl(peer, F_GETFL, 0) | O_NONBLOCK);
+                net::ReceiveBufferConfig buffer_config;
+                buffer_config.capacity = std::max<size_t>(config_.max_batch_bytes * 2, net::ReceiveBuffer::BUFFER_SIZE);
+                transport.connections[peer] = Transport::Connection{peer, std::make_unique<net::ReceiveBuffer>(buffer_config)};
+                transport.loop.add_socket(peer);
+            }
+            continue;
+        }
+
+        auto it = transport.connections.find(fd);
+        if (it == transport.connections.end()) {
+            continue;
+        }
+        net::ReceiveBuffer& buffer = *it->second.buffer;
+        if (buffer.available_write() == 0) {
+            buffer.compact();
+        }
+        ssize_t received = ::recv(fd, buffer.write_buffer(), buffer.available_write(), MSG_DONTWAIT);
+        bool closed = received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK);
+        if (received > 0) {
+            buffer.advance_write(static_cast<size_t>(received));
+            transport.stats.bytes_received += static_cast<size_t>(received);
+            size_t consumed = for_each_frame(reinterpret_cast<const uint8_t*>(buffer.read_ptr()),
+                                             buffer.readable_bytes(),
+                                             [&](const Frame& frame) { handle_frame(frame); });
+            if (consumed == SIZE_MAX) {
+                std::cerr << "Corrupt frame from connection " << fd << ", closing it" << std::endl;
+                closed = true;
+            } else {
+                buffer.consume(consumed);
+            }
+        }
+        if (closed) {
+            transport.loop.remove_socket(fd);
+            ::close(fd);
+            transport.connections.erase(it);
+        }
+    }
+    return transport.stats.frames_received - before;
+}
+
+void ClusterManager::set_message_handler(MessageHandler handler) {
+    std::lock_guard<std::mutex> lock(transport_->inbound_mutex);
+    message_handler_ = std::move(handler);
+}
+
+void ClusterManager::set_message_handler(MessageType type, MessageHandler handler) {
+    std::lock_guard<std::mutex> lock(transport_->inbound_mutex);
+    if (handler) {
+        typed_handlers_[static_cast<uint16_t>(type)] = std::move(handler);
+    } else {
+        typed_handlers_.erase(static_cast<uint16_t>(type));
+    }
+}
+
+ClusterManager::TransportStats ClusterManager::get_transport_stats() const {
+    TransportStats stats;
+    {
+        std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+        stats = transport_->stats;
+    }
+    std::lock_guard<std::mutex> lock(transport_->inbound_mutex);
+    stats.frames_received = transport_->stats.frames_received;
+    stats.bytes_received = transport_->stats.bytes_received;
+    return stats;
+}
+
+void ClusterManager::heartbeat_loop() {
+    const auto interval = std::chrono::milliseconds(config_.heartbeat_interval_ms);
+    while (running_.load(std::memory_order_acquire)) {
+        HeartbeatMessage heartbeat{};
+        std::vector<std::string> silent;
+        {
+            std::lock_guard<std::mutex> lock(nodes_mutex_);
+            const NodeInfo& local = cluster_nodes_[local_node_id_];
+            heartbeat.timestamp_ns = now_ns();
+            heartbeat.cpu_utilization = local.cpu_utilization;
+            heartbeat.memory_usage_mb = local.memory_usage_mb;
+            heartbeat.network_bandwidth_mbps = local.network_bandwidth_mbps;
+            heartbeat.assigned_symbols = static_cast<uint32_t>(local.assigned_symbols.size());
+            heartbeat.healthy = local.is_healthy ? 1 : 0;
+
+            uint64_t deadline = MISSED_HEARTBEATS * config_.heartbeat_interval_ms * 1000000ull;
+            for (const auto& [id, node] : cluster_nodes_) {
+                if (id != local_node_id_ && node.is_healthy && heartbeat.timestamp_ns - node.last_heartbeat > deadline) {
+                    silent.push_back(id);
+                }
+            }
+        }
+        broadcast_message(MessageType::HEARTBEAT, &heartbeat, sizeof(heartbeat));
+        flush_messages();
+        for (const auto& id : silent) {
+            handle_node_failure(id);
+        }
+
+        std::unique_lock<std::mutex> lock(transport_->wake_mutex);
+        transport_->wake.wait_for(lock, interval, [this] { return !running_.load(std::memory_order_acquire); });
+    }
+}
+
+void ClusterManager::handle_node_failure(const std::string& node_id) {
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        auto it = cluster_nodes_.find(node_id);
+        if (it == cluster_nodes_.end() || !it->second.is_healthy) {
+            return;
+        }
+        it->second.is_healthy = false;
+        membership_epoch_.fetch_add(1, std::memory_order_acq_rel);
+    }
+    std::cerr << "Node " << node_id << " missed " << MISSED_HEARTBEATS << " heartbeats" << std::endl;
+    if (auto_failover_.load(std::memory_order_relaxed)) {
+        redistribute_workload();
+    }
+}
+
+void ClusterManager::redistribute_workload() {
+    // Symbols of unhealthy nodes go to the healthy node with the fewest
+    std::unordered_map<std::string, std::vector<std::string>> changed;
+    std::function<void(const std::vector<std::string>&)> local_function;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        std::vector<std::string> orphaned;
+        std::vector<NodeInfo*> healthy;
+        for (auto& [id, node] : cluster_nodes_) {
+            if (node.is_healthy) {
+                healthy.push_back(&node);
+            } else {
+                orphaned.insert(orphaned.end(), node.assigned_symbols.begin(), node.assigned_symbols.end());
+                node.assigned_symbols.clear();
+            }
+        }
+        if (orphaned.empty() || healthy.empty()) {
+            return;
+        }
+        for (const auto& symbol : orphaned) {
+            NodeInfo* target = *std::min_element(healthy.begin(), healthy.end(), [](const NodeInfo* a, const NodeInfo* b) {
+                return a->assigned_symbols.size() != b->assigned_symbols.size()
+                    ? a->assigned_symbols.size() < b->assigned_symbols.size()
+                    : a->node_id < b->node_id;
+            });
+            target->assigned_symbols.push_back(symbol);
+            changed[target->node_id] = target->assigned_symbols;
+        }
+        local_function = workload_function_;
+    }
+    send_assignments(changed, local_function);
+}
+
+std::vector<std::string> ClusterManager::select_optimal_nodes(size_t required_nodes) {
+    std::vector<std::pair<double, std::string>> candidates;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        for (const auto& [id, node] : cluster_nodes_) {
+            if (node.is_healthy) {
+                candidates.emplace_back(calculate_node_load(node), id);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    std::vector<std::string> selected;
+    for (size_t i = 0; i < candidates.size() && i < required_nodes; ++i) {
+        selected.push_back(candidates[i].second);
+    }
+    return selected;
+}
+
+double ClusterManager::calculate_node_load(const NodeInfo& node) {
+    return node.cpu_utilization;
+}
+
+void ClusterManager::handle_frame(const Frame& frame) {
+    // Caller holds inbound_mutex
+    transport_->stats.frames_received++;
+    std::string from;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        auto id = node_of_hash_.find(frame.header->sender);
+        if (id == node_of_hash_.end()) {
+            return;  // Not (or no longer) a member
+        }
+        from = id->second;
+
+        if (frame.type() == MessageType::HEARTBEAT) {
+            const HeartbeatMessage* heartbeat = frame.as<HeartbeatMessage>();
+            auto node = cluster_nodes_.find(from);
+            if (heartbeat != nullptr && node != cluster_nodes_.end()) {
+                node->second.cpu_utilization = heartbeat->cpu_utilization;
+                node->second.memory_usage_mb = heartbeat->memory_usage_mb;
+                node->second.network_bandwidth_mbps = heartbeat->network_bandwidth_mbps;
+                node->second.last_heartbeat = now_ns();
+                if (node->second.is_healthy != (heartbeat->healthy != 0)) {
+                    node->second.is_healthy = heartbeat->healthy != 0;
+                    membership_epoch_.fetch_add(1, std::memory_order_acq_rel);
+                }
+            }
+            return;
+        }
+        if (frame.type() == MessageType::WORKLOAD_ASSIGNMENT) {
+            // Remembered so rate reports reach the coordinator and list only our symbols
+            WorkloadAssignmentView view(frame);
+            auto local = cluster_nodes_.find(local_node_id_);
+            if (view.valid() && local != cluster_nodes_.end()) {
+                local->second.assigned_symbols.clear();
+                for (size_t i = 0; i < view.size(); ++i) {
+                    local->second.assigned_symbols.emplace_back(view.symbol(i));
+                }
+                coordinator_ = from;
+            }
+        }
+    }
+    switch (frame.type()) {
+        case MessageType::MAP_REDUCE_PARTITION:
+            on_map_reduce_partition(frame);
+            return;
+        case MessageType::SYMBOL_RATES:
+            on_symbol_rates(from, frame);
+            return;
+        case MessageType::SYMBOL_MIGRATE:
+            on_symbol_migrate(frame);
+            return;
+        case MessageType::SYMBOL_HANDOFF:
+            on_symbol_handoff(frame);
+            return;
+        default:
+            break;
+    }
+    auto typed = typed_handlers_.find(frame.header->type);
+    if (typed != typed_handlers_.end()) {
+        typed->second(from, frame);
+    } else if (message_handler_) {
+        message_handler_(from, frame);
+    }
+}
+
+bool ClusterManager::send_message_now(const std::string& node_id, MessageType type, const void* payload,
+                                      size_t length, uint32_t timeout_ms) {
+    if (length > MAX_FRAME_PAYLOAD) {
+        return false;
+    }
+    const uint64_t deadline = now_ns() + static_cast<uint64_t>(timeout_ms) * 1000000ull;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+            auto it = transport_->peers.find(node_id);
+            if (it == transport_->peers.end()) {
+                return false;
+            }
+            it->second->batch.append(type, payload, length);
+            if (transport_->flush(*it->second)) {
+                return true;
+            }
+        }
+        if (now_ns() >= deadline) {
+            return false;
+        }
+        poll_messages(1);
+    }
+}
+
+ClusterManager::MapReducePlan ClusterManager::plan_map_reduce(size_t inputs, const MapReduceOptions& options,
+                                                              bool distributed) const {
+    // Participants and their weights, sorted so every node derives the same partitions
+    std::vector<std::pair<std::string, double>> nodes;
+    if (distributed) {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        for (const auto& [id, node] : cluster_nodes_) {
+            if (node.is_healthy) {
+                nodes.emplace_back(id, std::max(0.05, 1.0 - node.cpu_utilization));
+            }
+        }
+    }
+    std::sort(nodes.begin(), nodes.end());
+    auto self = std::find_if(nodes.begin(), nodes.end(), [&](const auto& node) { return node.first == local_node_id_; });
+    if (nodes.size() < 2 || self == nodes.end()) {
+        nodes.assign(1, {local_node_id_, 1.0});
+    }
+
+    const bool located = options.input_locations.size() == inputs;
+    if (!options.input_locations.empty() && !located) {
+        std::cerr << "execute_map_reduce: input_locations ignored, expected one per input" << std::endl;
+    }
+    std::vector<std::vector<size_t>> groups(nodes.size());
+    std::vector<size_t> anywhere;
+    for (size_t i = 0; i < inputs; ++i) {
+        auto node = nodes.end();
+        if (located) {
+            node = std::lower_bound(nodes.begin(), nodes.end(), options.input_locations[i],
+                                    [](const auto& entry, const std::string& id) { return entry.first < id; });
+        }
+        if (node != nodes.end() && node->first == options.input_locations[i]) {
+            groups[static_cast<size_t>(node - nodes.begin())].push_back(i);
+        } else {
+            anywhere.push_back(i);  // No location, or one that is not a participant
+        }
+    }
+
+    MapReducePlan plan;
+    std::vector<size_t> owner;
+    std::vector<double> load(nodes.size(), 0.0);
+    const size_t tasks = std::max<size_t>(1, options.tasks_per_node);
+    auto split = [&](const std::vector<size_t>& indices, size_t count, auto&& assign) {
+        count = std::min(count, indices.size());
+        for (size_t k = 0; k < count; ++k) {
+            auto first = indices.begin() + static_cast<std::ptrdiff_t>(k * indices.size() / count);
+            auto last = indices.begin() + static_cast<std::ptrdiff_t>((k + 1) * indices.size() / count);
+            plan.partitions.emplace_back(first, last);
+            owner.push_back(assign(static_cast<size_t>(last - first)));
+        }
+    };
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        split(groups[n], tasks, [&](size_t size) {
+            load[n] += static_cast<double>(size);
+            return n;
+        });
+    }
+    // Location-free partitions go where they finish soonest for the node's spare CPU
+    split(anywhere, tasks * nodes.size(), [&](size_t size) {
+        size_t best = 0;
+        for (size_t n = 1; n < nodes.size(); ++n) {
+            if ((load[n] + static_cast<double>(size)) / nodes[n].second <
+                (load[best] + static_cast<double>(size)) / nodes[best].second) {
+                best = n;
+            }
+        }
+        load[best] += static_cast<double>(size);
+        return best;
+    });
+
+    for (size_t n : owner) {
+        plan.local.push_back(nodes[n].first == local_node_id_);
+    }
+    for (const auto& node : nodes) {
+        if (node.first != local_node_id_) {
+            plan.peers.push_back(node.first);
+        }
+    }
+    return plan;
+}
+
+ClusterManager::MapReduceStats ClusterManager::get_map_reduce_stats() const {
+    MapReduceStats stats;
+    stats.jobs = map_reduce_jobs_.load(std::memory_order_relaxed);
+    stats.tasks_run = map_reduce_tasks_.load(std::memory_order_relaxed);
+    stats.remote_partitions = map_reduce_remote_.load(std::memory_order_relaxed);
+    stats.speculative_tasks = map_reduce_speculative_.load(std::memory_order_relaxed);
+    stats.speculative_wins = map_reduce_speculative_wins_.load(std::memory_order_relaxed);
+    stats.shuffle_bytes = map_reduce_shuffle_bytes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ClusterManager::open_shuffle(uint64_t job) {
+    std::lock_guard<std::mutex> lock(shuffle_mutex_);
+    closed_shuffles_.erase(std::remove(closed_shuffles_.begin(), closed_shuffles_.end(), job), closed_shuffles_.end());
+    auto& shuffle = shuffles_[job];
+    if (!shuffle) {
+        shuffle = std::make_unique<Shuffle>();  // Unless a fast peer's segments opened it already
+    }
+}
+
+void ClusterManager::close_shuffle(uint64_t job) {
+    std::lock_guard<std::mutex> lock(shuffle_mutex_);
+    shuffles_.erase(job);
+    if (closed_shuffles_.size() == CLOSED_SHUFFLES_KEPT) {
+        closed_shuffles_.erase(closed_shuffles_.begin());
+    }
+    closed_shuffles_.push_back(job);
+}
+
+bool ClusterManager::publish_partition(uint64_t job, uint32_t partition, const void* data, size_t size,
+                                       const std::vector<std::string>& peers, uint32_t timeout_ms) {
+    thread_local std::vector<uint8_t> payload;
+    bool ok = true;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (const std::string& peer : peers) {
+        // An empty partition still sends one segment so peers see it finish
+        size_t offset = 0;
+        do {
+            const size_t segment = std::min(PARTITION_SEGMENT_BYTES, size - offset);
+            PartitionSegmentHeader header{job, partition, 0, size, offset};
+            payload.resize(sizeof(header) + segment);
+            std::memcpy(payload.data(), &header, sizeof(header));
+            if (segment > 0) {
+                std::memcpy(payload.data() + sizeof(header), bytes + offset, segment);
+            }
+            if (!send_message_now(peer, MessageType::MAP_REDUCE_PARTITION, payload.data(), payload.size(), timeout_ms)) {
+                ok = false;  // That peer backs the partition up itself
+                break;
+            }
+            map_reduce_shuffle_bytes_.fetch_add(segment, std::memory_order_relaxed);
+            offset += segment;
+        } while (offset < size);
+    }
+    return ok;
+}
+
+bool ClusterManager::take_partition(uint64_t job, uint32_t& partition, std::vector<uint8_t>& data) {
+    std::lock_guard<std::mutex> lock(shuffle_mutex_);
+    auto it = shuffles_.find(job);
+    if (it == shuffles_.end() || it->second->complete.empty()) {
+        return false;
+    }
+    auto& complete = it->second->complete;
+    partition = complete.back().first;
+    data.swap(complete.back().second);
+    complete.pop_back();
+    return true;
+}
+
+void ClusterManager::on_map_reduce_partition(const Frame& frame) {
+    const PartitionSegmentHeader* header = frame.as<PartitionSegmentHeader>();
+    if (header == nullptr) {
+        return;
+    }
+    const size_t segment = frame.size() - sizeof(PartitionSegmentHeader);
+    if (header->offset > header->total_bytes || segment > header->total_bytes - header->offset) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(shuffle_mutex_);
+    if (std::find(closed_shuffles_.begin(), closed_shuffles_.end(), header->job) != closed_shuffles_.end()) {
+        return;  // Late copy of a finished job
+    }
+    auto& shuffle = shuffles_[header->job];
+    if (!shuffle) {
+        shuffle = std::make_unique<Shuffle>();
+    }
+    auto& delivered = shuffle->delivered;
+    if (std::find(delivered.begin(), delivered.end(), header->partition) != delivered.end()) {
+        return;
+    }
+    auto& assembly = shuffle->assembling[static_cast<uint64_t>(header->partition) << 32 | frame.header->sender];
+    if (std::find(assembly.offsets.begin(), assembly.offsets.end(), header->offset) != assembly.offsets.end()) {
+        return;  // Resent segment
+    }
+    assembly.offsets.push_back(header->offset);
+    assembly.bytes.resize(header->total_bytes);
+    if (segment > 0) {
+        std::memcpy(assembly.bytes.data() + header->offset, frame.payload + sizeof(PartitionSegmentHeader), segment);
+    }
+    assembly.received += segment;
+    if (assembly.received == header->total_bytes) {
+        delivered.push_back(header->partition);
+        shuffle->complete.emplace_back(header->partition, std::move(assembly.bytes));
+        shuffle->assembling.erase(static_cast<uint64_t>(header->partition) << 32 | frame.header->sender);
+    }
+}
+
+void ClusterManager::load_balance_loop() {
+    const auto interval = std::chrono::milliseconds(config_.rebalance_interval_ms);
+    while (running_.load(std::memory_order_acquire)) {
+        {
+            std::unique_lock<std::mutex> lock(transport_->wake_mutex);
+            if (transport_->wake.wait_for(lock, interval, [this] { return !running_.load(std::memory_order_acquire); })) {
+                break;
+            }
+        }
+        std::string coordinator;
+        {
+            std::lock_guard<std::mutex> lock(nodes_mutex_);
+            coordinator = coordinator_;
+        }
+        if (coordinator == local_node_id_) {
+            rebalance_workload();
+        } else if (!coordinator.empty()) {
+            report_symbol_rates(coordinator);
+        }
+    }
+}
+
+void ClusterManager::report_symbol_rates(const std::string& coordinator) {
+    symbol_rates_.sample(now_ns());
+    std::vector<std::pair<std::string, double>> rates;
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        auto local = cluster_nodes_.find(local_node_id_);
+        if (local == cluster_nodes_.end()) {
+            return;
+        }
+        for (const auto& symbol : local->second.assigned_symbols) {
+            rates.emplace_back(symbol, symbol_rates_.rate(symbol));
+        }
+    }
+    if (rates.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+    auto peer = transport_->peers.find(coordinator);
+    if (peer != transport_->peers.end()) {
+        write_symbol_rates(peer->second->batch, rates);
+        transport_->flush(*peer->second);
+    }
+}
+
+void ClusterManager::on_symbol_rates(const std::string& from, const Frame& frame) {
+    SymbolRatesView view(frame);
+    if (!view.valid()) {
+        std::cerr << "ClusterManager: malformed rate report from " << from << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < view.size(); ++i) {
+        symbol_rates_.set_rate(view.symbol(i), view.rate(i));
+    }
+}
+
+void ClusterManager::on_symbol_migrate(const Frame& frame) {
+    const SymbolMigrateHeader* header = frame.as<SymbolMigrateHeader>();
+    if (header == nullptr ||
+        sizeof(*header) + static_cast<size_t>(header->symbol_bytes) + header->target_bytes > frame.size()) {
+        return;
+    }
+    const char* bytes = reinterpret_cast<const char*>(frame.payload + sizeof(*header));
+    std::string symbol(bytes, header->symbol_bytes);
+    std::string target(bytes + header->symbol_bytes, header->target_bytes);
+    if (!symbol_exporter_) {
+        std::cerr << "ClusterManager: asked to migrate " << symbol << " without a state exporter" << std::endl;
+        return;
+    }
+    hand_off_symbol(symbol, target, true);
+}
+
+void ClusterManager::on_symbol_handoff(const Frame& frame) {
+    const SymbolHandoffHeader* header = frame.as<SymbolHandoffHeader>();
+    if (header == nullptr || header->state_bytes > frame.size() ||
+        sizeof(*header) + header->symbol_bytes + header->state_bytes > frame.size()) {
+        return;
+    }
+    const uint8_t* bytes = frame.payload + sizeof(*header);
+    std::string symbol(reinterpret_cast<const char*>(bytes), header->symbol_bytes);
+    if (symbol_importer_) {
+        symbol_importer_(symbol, bytes + header->symbol_bytes, static_cast<size_t>(header->state_bytes));
+    }
+    // The old owner's rate carries on until our own count takes over
+    symbol_rates_.set_rate(symbol, header->rate);
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        auto& assigned = cluster_nodes_[local_node_id_].assigned_symbols;
+        if (std::find(assigned.begin(), assigned.end(), symbol) == assigned.end()) {
+            assigned.push_back(symbol);
+        }
+    }
+    handoffs_received_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool ClusterManager::hand_off_symbol(const std::string& symbol, const std::string& to, bool polling_thread) {
+    // The exporter stops processing the symbol, so the state is final
+    std::vector<uint8_t> state = symbol_exporter_(symbol);
+    {
+        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        auto& assigned = cluster_nodes_[local_node_id_].assigned_symbols;
+        assigned.erase(std::remove(assigned.begin(), assigned.end(), symbol), assigned.end());
+    }
+
+    std::vector<uint8_t> payload(sizeof(SymbolHandoffHeader) + symbol.size() + state.size());
+    SymbolHandoffHeader header{symbol_rates_.rate(symbol), static_cast<uint32_t>(symbol.size()), 0, state.size()};
+    std::memcpy(payload.data(), &header, sizeof(header));
+    std::memcpy(payload.data() + sizeof(header), symbol.data(), symbol.size());
+    if (!state.empty()) {
+        std::memcpy(payload.data() + sizeof(header) + symbol.size(), state.data(), state.size());
+    }
+
+    // send_message_now() polls, which the polling thread must not do
+    bool sent = false;
+    if (polling_thread) {
+        std::lock_guard<std::mutex> lock(transport_->outbound_mutex);
+        auto peer = transport_->peers.find(to);
+        if (peer != transport_->peers.end()) {
+            peer->second->batch.append(MessageType::SYMBOL_HANDOFF, payload.data(), payload.size());
+            sent = transport_->flush(*peer->second);
+        }
+    } else {
+        sent = send_message_now(to, MessageType::SYMBOL_HANDOFF, payload.data(), payload.size(), 1000);
+    }
+    if (!sent) {
+        std::cerr << "ClusterManager: handoff of " << symbol << " to " << to << " failed" << std::endl;
+        return false;
+    }
+    handoffs_sent_.fetch_add(1, std::memory_order_relaxed);
+    handoff_bytes_.fetch_add(state.size(), std::memory_order_relaxed);
+    return true;
+}
+
+std::string ClusterManager::channel_name(const std::string& from, const std::string& to) const {
+    // shm_open names: one leading slash, no others
+    std::string name = "/" + config_.cluster_name + "." + from + "." + to;
+    std::replace_if(name.begin() + 1, name.end(), [](char c) { return c == '/'; }, '_');
+    return name;
+}
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,119 @@
+#include "distributed/consistent_hash_ring.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace feedhandler {
+namespace distributed {
+
+namespace {
+
+// MurmurHash3 finalizer: FNV-1a alone clusters similar keys on the ring
+uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t fnv1a(std::string_view key) {
+    uint64_t h = 14695981039346656037ULL;
+    for (char c : key) {
+        h = (h ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+    }
+    return h;
+}
+
+} // namespace
+
+ConsistentHashRing::ConsistentHashRing(size_t virtual_nodes) : virtual_nodes_(virtual_nodes) {
+    if (virtual_nodes == 0) {
+        throw std::invalid_argument("ConsistentHashRing needs at least one virtual node per node");
+    }
+}
+
+uint64_t ConsistentHashRing::hash(std::string_view key) {
+    return mix(fnv1a(key));
+}
+
+bool ConsistentHashRing::add_node(const std::string& node_id) {
+    if (contains(node_id)) {
+        return false;
+    }
+    uint32_t index = static_cast<uint32_t>(nodes_.size());
+    nodes_.push_back(node_id);
+
+    // Virtual node i of a node sits at mix(fnv(id) + i * golden ratio)
+    const uint64_t base = fnv1a(node_id);
+    points_.reserve(points_.size() + virtual_nodes_);
+    for (size_t i = 0; i < virtual_nodes_; ++i) {
+        points_.push_back({mix(base + i * 0x9E3779B97F4A7C15ULL), index});
+    }
+    std::sort(points_.begin(), points_.end(), [this](const Point& a, const Point& b) {
+        // Ties (astronomically rare) broken by ID so placement ignores join order
+        return a.hash != b.hash ? a.hash < b.hash : nodes_[a.node] < nodes_[b.node];
+    });
+    return true;
+}
+
+bool ConsistentHashRing::remove_node(std::string_view node_id) {
+    auto it = std::find(nodes_.begin(), nodes_.end(), node_id);
+    if (it == nodes_.end()) {
+        return false;
+    }
+    uint32_t index = static_cast<uint32_t>(it - nodes_.begin());
+    uint32_t last = static_cast<uint32_t>(nodes_.size() - 1);
+
+    // Drop its points and move the last node into its slot; order is kept
+    points_.erase(std::remove_if(points_.begin(), points_.end(), [index](const Point& p) { return p.node == index; }),
+                  points_.end());
+    if (index != last) {
+        nodes_[index] = std::move(nodes_[last]);
+        for (auto& point : points_) {
+            if (point.node == last) {
+                point.node = index;
+            }
+        }
+    }
+    nodes_.pop_back();
+    return true;
+}
+
+bool ConsistentHashRing::contains(std::string_view node_id) const {
+    return std::find(nodes_.begin(), nodes_.end(), node_id) != nodes_.end();
+}
+
+size_t ConsistentHashRing::first_point(std::string_view key) const {
+    const uint64_t h = hash(key);
+    auto it = std::lower_bound(points_.begin(), points_.end(), h,
+                               [](const Point& p, uint64_t value) { return p.hash < value; });
+    return it == points_.end() ? 0 : static_cast<size_t>(it - points_.begin());  // Wrap around
+}
+
+const std::string* ConsistentHashRing::node_for(std::string_view key) const {
+    if (points_.empty()) {
+        return nullptr;
+    }
+    return &nodes_[points_[first_point(key)].node];
+}
+
+size_t ConsistentHashRing::nodes_for(std::string_view key, size_t count, std::vector<const std::string*>& out) const {
+    out.clear();
+    count = std::min(count, nodes_.size());
+    if (count == 0) {
+        return 0;
+    }
+    size_t start = first_point(key);
+    for (size_t step = 0; step < points_.size() && out.size() < count; ++step) {
+        const std::string* node = &nodes_[points_[(start + step) % points_.size()].node];
+        if (std::find(out.begin(), out.end(), node) == out.end()) {
+            out.push_back(node);
+        }
+    }
+    return out.size();
+}
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,502 @@
+#include "distributed/cluster_computing.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace feedhandler {
+namespace distributed {
+
+namespace {
+
+// First byte of a stored value
+constexpr uint8_t STORED_RAW = 0;
+constexpr uint8_t STORED_LZ = 1;  // Varint original size, then an lz_codec stream
+
+// Prefix of every CACHE_* payload; the key and then the value follow
+struct CacheWireHeader {
+    uint64_t request_id;   // CACHE_GET / CACHE_VALUE pairing
+    uint32_t key_length;
+    uint32_t ttl_seconds;  // CACHE_PUT
+    uint32_t found;        // CACHE_VALUE
+    uint32_t reserved;
+};
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Encodes into a per-thread buffer: steady-state sends do not allocate
+const std::vector<uint8_t>& encode(const CacheWireHeader& header, std::string_view key,
+                                   const uint8_t* value, size_t size) {
+    thread_local std::vector<uint8_t> scratch;
+    scratch.resize(sizeof(header) + key.size() + size);
+    std::memcpy(scratch.data(), &header, sizeof(header));
+    std::memcpy(scratch.data() + sizeof(header), key.data(), key.size());
+    if (size > 0) {
+        std::memcpy(scratch.data() + sizeof(header) + key.size(), value, size);
+    }
+    return scratch;
+}
+
+struct DecodedCacheFrame {
+    const CacheWireHeader* header;
+    std::string_view key;
+    const uint8_t* value;
+    size_t size;
+};
+
+bool decode(const Frame& frame, DecodedCacheFrame& out) {
+    out.header = frame.as<CacheWireHeader>();
+    if (out.header == nullptr || out.header->key_length > frame.size() - sizeof(CacheWireHeader)) {
+        return false;
+    }
+    const uint8_t* key = frame.payload + sizeof(CacheWireHeader);
+    out.key = std::string_view(reinterpret_cast<const char*>(key), out.header->key_length);
+    out.value = key + out.header->key_length;
+    out.size = frame.size() - sizeof(CacheWireHeader) - out.header->key_length;
+    return true;
+}
+
+} // namespace
+
+DistributedCache::DistributedCache(const CacheConfig& config, ClusterManager& cluster)
+    : config_(config),
+      cluster_(cluster),
+      strong_(config.consistency_level == "strong"),
+      near_cache_(config.near_cache_mb << 20, static_cast<uint64_t>(config.near_cache_ttl_ms) * 1000000ull) {
+    if (config.replication_factor == 0) {
+        throw std::invalid_argument("DistributedCache replication_factor must be at least 1");
+    }
+    if (!strong_ && config.consistency_level != "eventual") {
+        throw std::invalid_argument("DistributedCache consistency_level must be \"strong\" or \"eventual\"");
+    }
+    cluster_.set_message_handler(MessageType::CACHE_PUT,
+                                 [this](const std::string&, const Frame& frame) { on_put(frame); });
+    cluster_.set_message_handler(MessageType::CACHE_GET,
+                                 [this](const std::string& from, const Frame& frame) { on_get(from, frame); });
+    cluster_.set_message_handler(MessageType::CACHE_VALUE,
+                                 [this](const std::string&, const Frame& frame) { on_value(frame); });
+    cluster_.set_message_handler(MessageType::CACHE_REMOVE,
+                                 [this](const std::string&, const Frame& frame) { on_remove(frame); });
+}
+
+DistributedCache::~DistributedCache() {
+    for (MessageType type : {MessageType::CACHE_PUT, MessageType::CACHE_GET, MessageType::CACHE_VALUE,
+                             MessageType::CACHE_REMOVE}) {
+        cluster_.set_message_handler(type, nullptr);
+    }
+}
+
+bool DistributedCache::put(std::string_view key, const uint8_t* data, size_t size, uint32_t ttl_seconds) {
+    const uint64_t start = now_ns();
+    puts_.fetch_add(1, std::memory_order_relaxed);
+    if (ttl_seconds == 0) {
+        ttl_seconds = config_.ttl_seconds;
+    }
+    // Compressed once here; replicas and near-caches keep this form
+    const std::vector<uint8_t>& stored = compress_data(data, size);
+    bytes_in_.fetch_add(size, std::memory_order_relaxed);
+    bytes_stored_.fetch_add(stored.size(), std::memory_order_relaxed);
+
+    auto ring = current_ring();
+    thread_local std::vector<const std::string*> replicas;
+    ring->nodes_for(key, config_.replication_factor, replicas);
+
+    bool ok = true;
+    bool local = replicas.empty();  // Not joined yet: a one-node cache
+    bool sent = false;
+    for (const std::string* node : replicas) {
+        if (*node == cluster_.local_node_id()) {
+            local = true;
+            continue;
+        }
+        const auto& payload = encode({0, static_cast<uint32_t>(key.size()), ttl_seconds, 0, 0}, key,
+                                     stored.data(), stored.size());
+        ok = cluster_.send_message(*node, MessageType::CACHE_PUT, payload.data(), payload.size()) && ok;
+        sent = true;
+    }
+    if (sent) {
+        cluster_.flush_messages();
+    }
+
+    if (local) {
+        ok = store_local(key, stored.data(), stored.size(), ttl_seconds) && ok;
+    } else if (!strong_) {
+        // Read-your-writes for keys stored elsewhere
+        std::lock_guard<std::mutex> lock(near_mutex_);
+        near_cache_.put(key, stored.data(), stored.size(), start);
+    }
+    latency_ns_.fetch_add(now_ns() - start, std::memory_order_relaxed);
+    return ok;
+}
+
+bool DistributedCache::get(std::string_view key, std::vector<uint8_t>& out) {
+    PendingRead read{key, &out, {}, 0, false, false};
+    return this->read(key, read);
+}
+
+bool DistributedCache::get(std::string_view key, std::span<uint8_t> buffer, size_t& length) {
+    PendingRead read{key, nullptr, buffer, 0, false, false};
+    bool found = this->read(key, read);
+    length = read.length;
+    return found && read.length <= buffer.size();
+}
+
+std::vector<uint8_t> DistributedCache::get(const std::string& key) {
+    std::vector<uint8_t> data;
+    get(std::string_view(key), data);
+    return data;
+}
+
+bool DistributedCache::read(std::string_view key, PendingRead& read) {
+    const uint64_t start = now_ns();
+    gets_.fetch_add(1, std::memory_order_relaxed);
+
+    auto ring = current_ring();
+    thread_local std::vector<const std::string*> replicas;
+    ring->nodes_for(key, strong_ ? 1 : config_.replication_factor, replicas);
+
+    bool found = false;
+    bool local = replicas.empty();
+    for (const std::string* node : replicas) {
+        local = local || *node == cluster_.local_node_id();
+    }
+    if (local) {
+        found = read_local(key, read);
+    } else {
+        bool near = false;
+        if (!strong_) {
+            std::lock_guard<std::mutex> lock(near_mutex_);
+            const std::vector<uint8_t>* stored = near_cache_.find(key, start);
+            near = stored != nullptr && decompress_data(stored->data(), stored->size(), read);
+        }
+        if (near) {
+            near_hits_.fetch_add(1, std::memory_order_relaxed);
+            found = true;
+        } else {
+            // Owner first, then the other replicas
+            for (const std::string* node : replicas) {
+                if (read_remote(*node, read)) {
+                    found = read.found;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (found) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+    latency_ns_.fetch_add(now_ns() - start, std::memory_order_relaxed);
+    return found;
+}
+
+bool DistributedCache::read_local(std::string_view key, PendingRead& read) {
+    std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+    auto it = local_cache_.find(key);
+    if (it == local_cache_.end() || it->second.expires_ns <= now_ns()) {
+        return false;
+    }
+    return decompress_data(it->second.data.data(), it->second.data.size(), read);
+}
+
+bool DistributedCache::read_remote(const std::string& node, PendingRead& read) {
+    uint64_t request_id;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        request_id = next_request_++;
+        pending_[request_id] = &read;
+    }
+    const auto& payload = encode({request_id, static_cast<uint32_t>(read.key.size()), 0, 0, 0}, read.key, nullptr, 0);
+    bool sent = cluster_.send_message(node, MessageType::CACHE_GET, payload.data(), payload.size());
+    if (sent) {
+        cluster_.flush_messages();
+        remote_gets_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Whichever thread polls delivers the reply into read
+    const uint64_t deadline = now_ns() + static_cast<uint64_t>(config_.remote_timeout_ms) * 1000000ull;
+    bool done = false;
+    while (sent) {
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            done = read.done;
+        }
+        if (done || now_ns() >= deadline) {
+            break;
+        }
+        cluster_.poll_messages(1);
+    }
+
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_.erase(request_id);
+    return read.done;
+}
+
+bool DistributedCache::store_local(std::string_view key, const uint8_t* data, size_t size, uint32_t ttl_seconds) {
+    const uint64_t now = now_ns();
+    const size_t budget = config_.max_memory_mb << 20;
+    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+
+    auto it = local_cache_.find(key);
+    size_t replaced = it != local_cache_.end() ? key.size() + it->second.data.size() : 0;
+    if (local_bytes_ - replaced + key.size() + size > budget) {
+        // Make room from expired entries before refusing the write
+        for (auto entry = local_cache_.begin(); entry != local_cache_.end();) {
+            if (entry->second.expires_ns <= now) {
+                local_bytes_ -= entry->first.size() + entry->second.data.size();
+                entry = local_cache_.erase(entry);
+            } else {
+                ++entry;
+            }
+        }
+        it = local_cache_.find(key);
+        replaced = it != local_cache_.end() ? key.size() + it->second.data.size() : 0;
+        if (local_bytes_ - replaced + key.size() + size > budget) {
+            return false;
+        }
+    }
+
+    if (it == local_cache_.end()) {
+        it = local_cache_.emplace(std::string(key), Entry{}).first;
+        local_bytes_ += key.size();
+    } else {
+        local_bytes_ -= it->second.data.size();
+    }
+    it->second.data.assign(data, data + size);
+    it->second.expires_ns = now + static_cast<uint64_t>(ttl_seconds) * 1000000000ull;
+    local_bytes_ += size;
+    return true;
+}
+
+void DistributedCache::erase_local(std::string_view key) {
+    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+    auto it = local_cache_.find(key);
+    if (it != local_cache_.end()) {
+        local_bytes_ -= it->first.size() + it->second.data.size();
+        local_cache_.erase(it);
+    }
+}
+
+bool DistributedCache::remove(std::string_view key) {
+    auto ring = current_ring();
+    thread_local std::vector<const std::string*> replicas;
+    ring->nodes_for(key, config_.replication_factor, replicas);
+
+    bool ok = true;
+    bool sent = false;
+    for (const std::string* node : replicas) {
+        if (*node != cluster_.local_node_id()) {
+            const auto& payload = encode({0, static_cast<uint32_t>(key.size()), 0, 0, 0}, key, nullptr, 0);
+            ok = cluster_.send_message(*node, MessageType::CACHE_REMOVE, payload.data(), payload.size()) && ok;
+            sent = true;
+        }
+    }
+    if (sent) {
+        cluster_.flush_messages();
+    }
+    erase_local(key);
+    std::lock_guard<std::mutex> lock(near_mutex_);
+    near_cache_.erase(key);
+    return ok;
+}
+
+bool DistributedCache::put_ticks(std::string_view key, std::span<const common::CompactTick> ticks,
+                                 uint32_t ttl_seconds) {
+    thread_local std::vector<uint8_t> encoded;
+    encoded.clear();
+    storage::encode_ticks(ticks, encoded);
+    return put(key, encoded.data(), encoded.size(), ttl_seconds);
+}
+
+bool DistributedCache::get_ticks(std::string_view key, std::vector<common::CompactTick>& ticks) {
+    thread_local std::vector<uint8_t> encoded;
+    return get(key, encoded) && storage::decode_ticks(encoded.data(), encoded.size(), ticks);
+}
+
+bool DistributedCache::put_levels(std::string_view key, std::span<const storage::BookLevel> levels,
+                                  uint32_t ttl_seconds) {
+    thread_local std::vector<uint8_t> encoded;
+    encoded.clear();
+    storage::encode_levels(levels, encoded);
+    return put(key, encoded.data(), encoded.size(), ttl_seconds);
+}
+
+bool DistributedCache::get_levels(std::string_view key, std::vector<storage::BookLevel>& levels) {
+    thread_local std::vector<uint8_t> encoded;
+    return get(key, encoded) && storage::decode_levels(encoded.data(), encoded.size(), levels);
+}
+
+const std::vector<uint8_t>& DistributedCache::compress_data(const uint8_t* data, size_t size) {
+    thread_local std::vector<uint8_t> stored;
+    stored.clear();
+    if (config_.enable_compression && size >= config_.compression_min_bytes) {
+        stored.push_back(STORED_LZ);
+        storage::put_varint(stored, size);
+        size_t prefix = stored.size();
+        stored.resize(prefix + storage::lz_compress_bound(size));
+        size_t bytes = storage::lz_compress(data, size, stored.data() + prefix, stored.size() - prefix,
+                                            config_.compression_level);
+        if (bytes > 0 && prefix + bytes <= size) {
+            stored.resize(prefix + bytes);
+            return stored;
+        }
+        stored.clear();  // Incompressible: raw is smaller
+    }
+    stored.push_back(STORED_RAW);
+    stored.insert(stored.end(), data, data + size);
+    return stored;
+}
+
+bool DistributedCache::decompress_data(const uint8_t* stored, size_t size, PendingRead& read) {
+    if (size == 0) {
+        return false;
+    }
+    const uint8_t* body = stored + 1;
+    const uint8_t* end = stored + size;
+    if (stored[0] == STORED_RAW) {
+        read.found = true;
+        read.length = size - 1;
+        if (read.vector_out != nullptr) {
+            read.vector_out->assign(body, end);
+        } else if (read.length <= read.buffer_out.size() && read.length > 0) {
+            std::memcpy(read.buffer_out.data(), body, read.length);
+        }
+        return true;
+    }
+
+    uint64_t original;
+    // LZ expands at most 255x: anything claiming more is corrupt
+    if (stored[0] != STORED_LZ || !storage::get_varint(body, end, original) ||
+        original > static_cast<uint64_t>(end - body) * 255 + 16) {
+        return false;
+    }
+    uint8_t* out;
+    if (read.vector_out != nullptr) {
+        read.vector_out->resize(original);
+        out = read.vector_out->data();
+    } else if (original <= read.buffer_out.size()) {
+        out = read.buffer_out.data();
+    } else {
+        read.found = true;  // Short buffer: report the length only
+        read.length = original;
+        return true;
+    }
+    if (!storage::lz_decompress(body, static_cast<size_t>(end - body), out, original)) {
+        if (read.vector_out != nullptr) {
+            read.vector_out->clear();
+        }
+        return false;
+    }
+    read.found = true;
+    read.length = original;
+    return true;
+}
+
+std::string DistributedCache::owner_of(std::string_view key) {
+    auto ring = current_ring();
+    const std::string* owner = ring->node_for(key);
+    return owner != nullptr ? *owner : cluster_.local_node_id();
+}
+
+DistributedCache::CacheStats DistributedCache::get_stats() const {
+    CacheStats stats{};
+    {
+        std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+        stats.total_keys = local_cache_.size();
+        stats.memory_usage_mb = local_bytes_ >> 20;
+    }
+    stats.get_operations = gets_.load(std::memory_order_relaxed);
+    stats.put_operations = puts_.load(std::memory_order_relaxed);
+    stats.near_cache_hits = near_hits_.load(std::memory_order_relaxed);
+    stats.remote_gets = remote_gets_.load(std::memory_order_relaxed);
+    stats.hit_rate = stats.get_operations > 0
+        ? static_cast<double>(hits_.load(std::memory_order_relaxed)) / static_cast<double>(stats.get_operations)
+        : 0.0;
+    uint64_t stored = bytes_stored_.load(std::memory_order_relaxed);
+    stats.compression_ratio = stored > 0
+        ? static_cast<double>(bytes_in_.load(std::memory_order_relaxed)) / static_cast<double>(stored)
+        : 1.0;
+    uint64_t operations = stats.get_operations + stats.put_operations;
+    stats.average_latency_ms = operations > 0
+        ? static_cast<double>(latency_ns_.load(std::memory_order_relaxed)) / static_cast<double>(operations) / 1e6
+        : 0.0;
+    return stats;
+}
+
+std::shared_ptr<const ConsistentHashRing> DistributedCache::current_ring() {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    const uint64_t epoch = cluster_.membership_epoch();
+    if (ring_ == nullptr || epoch != ring_epoch_) {
+        // Epoch read first: a change during the rebuild triggers another one
+        auto ring = std::make_shared<ConsistentHashRing>(config_.virtual_nodes);
+        for (const auto& node : cluster_.get_cluster_status().node_details) {
+            if (node.is_healthy) {
+                ring->add_node(node.node_id);
+            }
+        }
+        ring_ = std::move(ring);
+        ring_epoch_ = epoch;
+    }
+    return ring_;
+}
+
+void DistributedCache::on_put(const Frame& frame) {
+    DecodedCacheFrame message;
+    if (decode(frame, message)) {
+        store_local(message.key, message.value, message.size, message.header->ttl_seconds);
+    }
+}
+
+void DistributedCache::on_get(const std::string& from, const Frame& frame) {
+    DecodedCacheFrame message;
+    if (!decode(frame, message)) {
+        return;
+    }
+    CacheWireHeader reply{message.header->request_id, 0, 0, 0, 0};
+    {
+        // Encoded under the lock: the entry may be replaced once it drops
+        std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+        auto it = local_cache_.find(message.key);
+        const Entry* entry = it != local_cache_.end() && it->second.expires_ns > now_ns() ? &it->second : nullptr;
+        reply.found = entry != nullptr ? 1 : 0;
+        const auto& payload = encode(reply, {}, entry != nullptr ? entry->data.data() : nullptr,
+                                     entry != nullptr ? entry->data.size() : 0);
+        lock.unlock();
+        cluster_.send_message(from, MessageType::CACHE_VALUE, payload.data(), payload.size());
+    }
+    cluster_.flush_messages();
+}
+
+void DistributedCache::on_value(const Frame& frame) {
+    DecodedCacheFrame message;
+    if (!decode(frame, message)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    auto it = pending_.find(message.header->request_id);
+    if (it == pending_.end()) {
+        return;  // Timed out already
+    }
+    PendingRead& read = *it->second;
+    read.done = true;
+    if (message.header->found == 0 || !decompress_data(message.value, message.size, read)) {
+        return;
+    }
+    if (!strong_) {
+        std::lock_guard<std::mutex> near_lock(near_mutex_);
+        near_cache_.put(read.key, message.value, message.size, now_ns());
+    }
+}
+
+void DistributedCache::on_remove(const Frame& frame) {
+    DecodedCacheFrame message;
+    if (decode(frame, message)) {
+        erase_local(message.key);
+    }
+}
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,314 @@
+#include "distributed/cluster_computing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace feedhandler {
+namespace distributed {
+
+namespace {
+
+// Prefix of every ALLREDUCE_CHUNK payload; count encoded values follow
+struct AllReduceHeader {
+    uint64_t round;
+    uint32_t step;         // 0 .. N-2 reduce-scatter, N-1 .. 2N-3 all-gather
+    uint32_t chunk;
+    uint32_t offset;       // First value of this segment within the chunk
+    uint32_t count;
+    float scale;           // INT8
+    uint16_t compression;  // GradientCompression
+    uint16_t reserved;
+};
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t inbox_key(uint64_t round, uint32_t step) {
+    return round << 16 | step;
+}
+
+// Values per frame, so a step never hands the transport more than one segment at a time
+size_t segment_values(const DistributedML::TrainingConfig& config) {
+    return std::max<size_t>(1, config.allreduce_segment_bytes / gradient_value_bytes(config.gradient_compression));
+}
+
+} // namespace
+
+DistributedML::DistributedML(const TrainingConfig& config, ClusterManager& cluster)
+    : config_(config), cluster_(cluster) {
+    if (config.allreduce_segment_bytes < sizeof(double)) {
+        throw std::invalid_argument("DistributedML allreduce_segment_bytes must hold at least one value");
+    }
+    cluster_.set_message_handler(MessageType::ALLREDUCE_CHUNK,
+                                 [this](const std::string&, const Frame& frame) { on_chunk(frame); });
+}
+
+DistributedML::~DistributedML() {
+    cluster_.set_message_handler(MessageType::ALLREDUCE_CHUNK, nullptr);
+}
+
+bool DistributedML::all_reduce(std::vector<double>& gradient) {
+    uint64_t round;
+    {
+        std::lock_guard<std::mutex> lock(round_mutex_);
+        round = next_ticket_++;
+    }
+    return run_all_reduce(round, gradient);
+}
+
+std::future<bool> DistributedML::all_reduce_async(std::vector<double>& gradient) {
+    // Numbered now, not when the thread starts, so rounds keep call order on every node
+    uint64_t round;
+    {
+        std::lock_guard<std::mutex> lock(round_mutex_);
+        round = next_ticket_++;
+    }
+    return std::async(std::launch::async, [this, round, &gradient] { return run_all_reduce(round, gradient); });
+}
+
+DistributedML::AllReduceStats DistributedML::get_allreduce_stats() const {
+    AllReduceStats stats;
+    stats.rounds_completed = rounds_completed_.load(std::memory_order_relaxed);
+    stats.rounds_failed = rounds_failed_.load(std::memory_order_relaxed);
+    stats.bytes_sent = bytes_sent_.load(std::memory_order_relaxed);
+    stats.raw_bytes = raw_bytes_.load(std::memory_order_relaxed);
+    stats.last_round_ms = static_cast<double>(last_round_ns_.load(std::memory_order_relaxed)) / 1e6;
+    return stats;
+}
+
+bool DistributedML::run_all_reduce(uint64_t round, std::vector<double>& gradient) {
+    {
+        std::unique_lock<std::mutex> lock(round_mutex_);
+        round_done_.wait(lock, [&] { return running_round_ == round; });
+    }
+    const uint64_t start = now_ns();
+    const bool ok = reduce_ring(round, gradient);
+    last_round_ns_.store(now_ns() - start, std::memory_order_relaxed);
+    (ok ? rounds_completed_ : rounds_failed_).fetch_add(1, std::memory_order_relaxed);
+
+    {
+        // Whatever is left of this round is a retry duplicate or a late frame
+        std::lock_guard<std::mutex> lock(inbox_mutex_);
+        oldest_round_ = round + 1;
+        for (auto it = inbox_.begin(); it != inbox_.end();) {
+            it = (it->first >> 16) <= round ? inbox_.erase(it) : std::next(it);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(round_mutex_);
+        ++running_round_;
+    }
+    round_done_.notify_all();
+    return ok;
+}
+
+bool DistributedML::reduce_ring(uint64_t round, std::vector<double>& gradient) {
+    std::vector<std::string> ring;
+    for (const auto& node : cluster_.get_cluster_status().node_details) {
+        if (node.is_healthy) {
+            ring.push_back(node.node_id);
+        }
+    }
+    std::sort(ring.begin(), ring.end());
+    auto self = std::find(ring.begin(), ring.end(), cluster_.local_node_id());
+    if (ring.size() < 2 || self == ring.end()) {
+        return true;  // Alone: the mean is the gradient itself
+    }
+
+    const size_t nodes = ring.size();
+    const size_t rank = static_cast<size_t>(self - ring.begin());
+    const std::string& next = ring[(rank + 1) % nodes];
+    const size_t length = gradient.size();
+    auto begin = [&](size_t chunk) { return chunk * length / nodes; };
+    auto size = [&](size_t chunk) { return begin(chunk + 1) - begin(chunk); };
+    const GradientCompression compression = config_.gradient_compression;
+
+    auto apply = [&](const Inbox& inbox, size_t chunk, bool accumulate) {
+        for (const Segment& segment : inbox.segments) {
+            if (static_cast<size_t>(segment.offset) + segment.count > size(chunk)) {
+                return false;
+            }
+            decode_gradient(segment.data.data(), segment.count, compression, segment.scale,
+                            gradient.data() + begin(chunk) + segment.offset, accumulate);
+        }
+        return true;
+    };
+
+    // Reduce-scatter: after N-1 steps this node holds the full sum of chunk rank+1
+    Inbox inbox;
+    for (size_t step = 0; step + 1 < nodes; ++step) {
+        const size_t send = (rank + nodes - step) % nodes;
+        const size_t receive = (rank + nodes - step - 1) % nodes;
+        if (!send_chunk(next, round, static_cast<uint32_t>(step), static_cast<uint32_t>(send),
+                        gradient.data() + begin(send), size(send)) ||
+            !wait_inbox(round, static_cast<uint32_t>(step), size(receive), inbox) ||
+            !apply(inbox, receive, true)) {
+            return false;
+        }
+    }
+
+    const size_t owned = (rank + 1) % nodes;
+    double* values = gradient.data() + begin(owned);
+    for (size_t i = 0; i < size(owned); ++i) {
+        values[i] /= static_cast<double>(nodes);
+    }
+    if (compression != GradientCompression::NONE) {
+        // Keep what the others will decode, so every node ends bit-identical
+        thread_local std::vector<uint8_t> scratch;
+        const size_t per_segment = segment_values(config_);
+        scratch.resize(per_segment * gradient_value_bytes(compression));
+        for (size_t offset = 0; offset < size(owned); offset += per_segment) {
+            const size_t count = std::min(per_segment, size(owned) - offset);
+            float scale = encode_gradient(values + offset, count, compression, scratch.data());
+            decode_gradient(scratch.data(), count, compression, scale, values + offset, false);
+        }
+    }
+
+    // All-gather: pass each finished chunk on, forwarding received bytes as they are
+    for (size_t step = 0; step + 1 < nodes; ++step) {
+        const uint32_t wire_step = static_cast<uint32_t>(nodes - 1 + step);
+        const size_t send = (rank + 1 + nodes - step) % nodes;
+        const size_t receive = (rank + nodes - step) % nodes;
+        bool sent = step == 0
+            ? send_chunk(next, round, wire_step, static_cast<uint32_t>(send), values, size(owned))
+            : forward_chunk(next, round, wire_step, static_cast<uint32_t>(send), inbox);
+        if (!sent || !wait_inbox(round, wire_step, size(receive), inbox) || !apply(inbox, receive, false)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DistributedML::send_chunk(const std::string& node, uint64_t round, uint32_t step, uint32_t chunk,
+                               const double* values, size_t count) {
+    const GradientCompression compression = config_.gradient_compression;
+    const size_t value_bytes = gradient_value_bytes(compression);
+    const size_t per_segment = segment_values(config_);
+    thread_local std::vector<uint8_t> payload;
+
+    for (size_t offset = 0; offset < count; offset += per_segment) {
+        const size_t segment = std::min(per_segment, count - offset);
+        payload.resize(sizeof(AllReduceHeader) + segment * value_bytes);
+        AllReduceHeader header{round, step, chunk, static_cast<uint32_t>(offset), static_cast<uint32_t>(segment),
+                               0.0f, static_cast<uint16_t>(compression), 0};
+        header.scale = encode_gradient(values + offset, segment, compression, payload.data() + sizeof(header));
+        std::memcpy(payload.data(), &header, sizeof(header));
+        if (!send_segment(node, payload)) {
+            return false;
+        }
+        raw_bytes_.fetch_add(segment * sizeof(double), std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool DistributedML::forward_chunk(const std::string& node, uint64_t round, uint32_t step, uint32_t chunk,
+                                  const Inbox& inbox) {
+    thread_local std::vector<uint8_t> payload;
+    for (const Segment& segment : inbox.segments) {
+        payload.resize(sizeof(AllReduceHeader) + segment.data.size());
+        AllReduceHeader header{round, step, chunk, segment.offset, segment.count, segment.scale,
+                               static_cast<uint16_t>(config_.gradient_compression), 0};
+        std::memcpy(payload.data(), &header, sizeof(header));
+        std::memcpy(payload.data() + sizeof(header), segment.data.data(), segment.data.size());
+        if (!send_segment(node, payload)) {
+            return false;
+        }
+        raw_bytes_.fetch_add(segment.count * sizeof(double), std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool DistributedML::send_segment(const std::string& node, const std::vector<uint8_t>& payload) {
+    // Resent by the cluster if a full shared-memory ring drops it; the receiver ignores duplicates
+    if (!cluster_.send_message_now(node, MessageType::ALLREDUCE_CHUNK, payload.data(), payload.size(),
+                                   config_.allreduce_timeout_ms)) {
+        std::cerr << "DistributedML: all-reduce send to " << node << " failed" << std::endl;
+        return false;
+    }
+    bytes_sent_.fetch_add(payload.size() - sizeof(AllReduceHeader), std::memory_order_relaxed);
+    return true;
+}
+
+bool DistributedML::wait_inbox(uint64_t round, uint32_t step, size_t values, Inbox& out) {
+    out.segments.clear();
+    out.values = 0;
+    if (values == 0) {
+        return true;
+    }
+    const uint64_t key = inbox_key(round, step);
+    const uint64_t deadline = now_ns() + static_cast<uint64_t>(config_.allreduce_timeout_ms) * 1000000ull;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(inbox_mutex_);
+            auto it = inbox_.find(key);
+            if (it != inbox_.end() && it->second.values >= values) {
+                out = std::move(it->second);
+                inbox_.erase(it);
+                return out.values == values;
+            }
+        }
+        if (now_ns() >= deadline) {
+            std::cerr << "DistributedML: all-reduce round " << round << " step " << step << " timed out"
+                      << std::endl;
+            return false;
+        }
+        // Whichever thread polls delivers the segments into inbox_
+        cluster_.poll_messages(1);
+    }
+}
+
+void DistributedML::on_chunk(const Frame& frame) {
+    const AllReduceHeader* header = frame.as<AllReduceHeader>();
+    if (header == nullptr) {
+        return;
+    }
+    const auto compression = static_cast<GradientCompression>(header->compression);
+    if (compression != config_.gradient_compression ||
+        frame.size() - sizeof(AllReduceHeader) != header->count * gradient_value_bytes(compression)) {
+        std::cerr << "DistributedML: dropping malformed all-reduce segment" << std::endl;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(inbox_mutex_);
+    if (header->round < oldest_round_) {
+        return;
+    }
+    Inbox& inbox = inbox_[inbox_key(header->round, header->step)];
+    for (const Segment& segment : inbox.segments) {
+        if (segment.offset == header->offset) {
+            return;  // Resent after a dropped batch that did arrive
+        }
+    }
+    const uint8_t* data = frame.payload + sizeof(AllReduceHeader);
+    inbox.segments.push_back({header->offset, header->count, header->scale,
+                              std::vector<uint8_t>(data, data + frame.size() - sizeof(AllReduceHeader))});
+    inbox.values += header->count;
+}
+
+std::vector<double> DistributedML::aggregate_gradients(const std::vector<std::vector<double>>& gradients) {
+    if (gradients.empty()) {
+        return {};
+    }
+    std::vector<double> mean(gradients.front().size(), 0.0);
+    for (const auto& gradient : gradients) {
+        if (gradient.size() != mean.size()) {
+            std::cerr << "DistributedML: gradients of different lengths" << std::endl;
+            return {};
+        }
+        for (size_t i = 0; i < mean.size(); ++i) {
+            mean[i] += gradient[i];
+        }
+    }
+    for (double& value : mean) {
+        value /= static_cast<double>(gradients.size());
+    }
+    return mean;
+}
+
+} // namespace distributed
+} // namespace feedhandler
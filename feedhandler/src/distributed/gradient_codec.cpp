@@ -0,0 +1,141 @@
+#include "distributed/gradient_codec.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace feedhandler {
+namespace distributed {
+
+namespace {
+
+constexpr uint16_t HALF_MAX = 0x7bff;  // 65504
+constexpr uint16_t HALF_INFINITY = 0x7c00;
+
+template<typename Decode>
+void decode_into(double* out, size_t count, bool accumulate, Decode decode) {
+    if (accumulate) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] += decode(i);
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = decode(i);
+        }
+    }
+}
+
+} // namespace
+
+uint16_t float_to_half(float value) {
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    const uint16_t sign = static_cast<uint16_t>(bits >> 16 & 0x8000);
+    const int32_t exponent = static_cast<int32_t>(bits >> 23 & 0xff);
+    uint32_t mantissa = bits & 0x7fffff;
+
+    if (exponent == 0xff) {
+        return static_cast<uint16_t>(sign | HALF_INFINITY | (mantissa != 0 ? 0x200 : 0));
+    }
+    const int32_t half_exponent = exponent - 127 + 15;
+    if (half_exponent >= 31) {
+        return static_cast<uint16_t>(sign | HALF_MAX);
+    }
+
+    uint32_t half;
+    uint32_t shift;
+    if (half_exponent <= 0) {
+        // Subnormal half: the implicit bit becomes explicit and shifts out
+        if (half_exponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000;
+        shift = static_cast<uint32_t>(14 - half_exponent);
+        half = mantissa >> shift;
+    } else {
+        shift = 13;
+        half = static_cast<uint32_t>(half_exponent) << 10 | mantissa >> shift;
+    }
+    // Round to nearest even; a carry into the exponent is still correct
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1) != 0)) {
+        ++half;
+    }
+    if (half >= HALF_INFINITY) {
+        half = HALF_MAX;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+float half_to_float(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent = half >> 10 & 0x1f;
+    const uint32_t mantissa = half & 0x3ff;
+    if (exponent == 0) {
+        float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0 ? -magnitude : magnitude;
+    }
+    if (exponent == 31) {
+        return std::bit_cast<float>(sign | 0x7f800000 | mantissa << 13);
+    }
+    return std::bit_cast<float>(sign | (exponent + 112) << 23 | mantissa << 13);
+}
+
+float encode_gradient(const double* values, size_t count, GradientCompression compression, uint8_t* out) {
+    switch (compression) {
+        case GradientCompression::FP16:
+            for (size_t i = 0; i < count; ++i) {
+                uint16_t half = float_to_half(static_cast<float>(values[i]));
+                std::memcpy(out + i * 2, &half, sizeof(half));
+            }
+            return 1.0f;
+        case GradientCompression::INT8: {
+            double largest = 0.0;
+            for (size_t i = 0; i < count; ++i) {
+                largest = std::max(largest, std::fabs(values[i]));
+            }
+            const float scale = static_cast<float>(largest / 127.0);
+            if (scale == 0.0f || !std::isfinite(scale)) {
+                std::memset(out, 0, count);
+                return 0.0f;
+            }
+            const double inverse = 1.0 / scale;
+            for (size_t i = 0; i < count; ++i) {
+                double q = std::clamp(std::nearbyint(values[i] * inverse), -127.0, 127.0);
+                out[i] = static_cast<uint8_t>(static_cast<int8_t>(q));
+            }
+            return scale;
+        }
+        default:
+            std::memcpy(out, values, count * sizeof(double));
+            return 1.0f;
+    }
+}
+
+void decode_gradient(const uint8_t* data, size_t count, GradientCompression compression, float scale,
+                     double* out, bool accumulate) {
+    switch (compression) {
+        case GradientCompression::FP16:
+            decode_into(out, count, accumulate, [data](size_t i) {
+                uint16_t half;
+                std::memcpy(&half, data + i * 2, sizeof(half));
+                return static_cast<double>(half_to_float(half));
+            });
+            break;
+        case GradientCompression::INT8:
+            decode_into(out, count, accumulate, [data, scale](size_t i) {
+                return static_cast<double>(static_cast<int8_t>(data[i])) * scale;
+            });
+            break;
+        default:
+            decode_into(out, count, accumulate, [data](size_t i) {
+                double value;
+                std::memcpy(&value, data + i * sizeof(double), sizeof(value));
+                return value;
+            });
+    }
+}
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,132 @@
+#include "distributed/map_reduce_scheduler.hpp"
+
+#include <algorithm>
+
+namespace feedhandler {
+namespace distributed {
+
+MapReduceScheduler::MapReduceScheduler(std::vector<bool> local, uint64_t start_ns, double speculation_factor,
+                                       double speculation_min_progress, uint64_t speculation_delay_ns)
+    : start_ns_(start_ns),
+      speculation_factor_(speculation_factor),
+      speculation_min_progress_(speculation_min_progress),
+      speculation_delay_ns_(speculation_delay_ns) {
+    tasks_.reserve(local.size());
+    for (size_t partition = 0; partition < local.size(); ++partition) {
+        tasks_.push_back(Task{local[partition]});
+        tasks_.back().started_ns = start_ns;
+        if (local[partition]) {
+            pending_.push_back(partition);
+        }
+    }
+    durations_.reserve(local.size());
+}
+
+MapReduceScheduler::Assignment MapReduceScheduler::acquire(uint64_t now_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (aborted_ || completed_ == tasks_.size()) {
+        return {FINISHED, false};
+    }
+    while (!pending_.empty()) {
+        size_t partition = pending_.front();
+        pending_.pop_front();
+        Task& task = tasks_[partition];
+        if (!task.done) {
+            task.started_ns = now_ns;
+            ++task.running;
+            return {partition, false};
+        }
+    }
+
+    bool idle = true;  // No local copy in progress: waiting is all that is left
+    for (const Task& task : tasks_) {
+        idle = idle && task.running == 0;
+    }
+    const double progress = static_cast<double>(completed_) / static_cast<double>(tasks_.size());
+    if (!idle && progress < speculation_min_progress_) {
+        return {WAIT, false};
+    }
+    uint64_t threshold = speculation_delay_ns_;
+    if (!durations_.empty()) {
+        threshold = std::max(threshold, static_cast<uint64_t>(speculation_factor_ *
+                                                              static_cast<double>(median_duration())));
+    }
+
+    size_t slowest = WAIT;
+    uint64_t longest = 0;
+    for (size_t partition = 0; partition < tasks_.size(); ++partition) {
+        const Task& task = tasks_[partition];
+        const uint64_t elapsed = now_ns - task.started_ns;
+        if (!task.done && !task.backed_up && elapsed > threshold && elapsed > longest) {
+            slowest = partition;
+            longest = elapsed;
+        }
+    }
+    if (slowest == WAIT) {
+        return {WAIT, false};
+    }
+    tasks_[slowest].backed_up = true;
+    ++tasks_[slowest].running;
+    ++stats_.speculative_launches;
+    return {slowest, true};
+}
+
+bool MapReduceScheduler::complete(size_t partition, bool speculative, uint64_t started_ns, uint64_t now_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Task& task = tasks_[partition];
+    --task.running;
+    if (!finish(task, now_ns - started_ns)) {
+        return false;
+    }
+    ++stats_.local_completions;
+    stats_.speculative_wins += speculative ? 1 : 0;
+    return true;
+}
+
+bool MapReduceScheduler::complete_remote(size_t partition, uint64_t now_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (partition >= tasks_.size() || !finish(tasks_[partition], now_ns - start_ns_)) {
+        return false;
+    }
+    ++stats_.remote_completions;
+    return true;
+}
+
+bool MapReduceScheduler::done(size_t partition) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_[partition].done;
+}
+
+bool MapReduceScheduler::finished() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return aborted_ || completed_ == tasks_.size();
+}
+
+void MapReduceScheduler::abort() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    aborted_ = true;
+}
+
+MapReduceScheduler::Stats MapReduceScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+uint64_t MapReduceScheduler::median_duration() {
+    auto middle = durations_.begin() + static_cast<std::ptrdiff_t>(durations_.size() / 2);
+    std::nth_element(durations_.begin(), middle, durations_.end());
+    return *middle;
+}
+
+bool MapReduceScheduler::finish(Task& task, uint64_t duration_ns) {
+    if (task.done) {
+        return false;
+    }
+    task.done = true;
+    ++completed_;
+    durations_.push_back(duration_ns);
+    return true;
+}
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,93 @@
+#include "distributed/near_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace feedhandler {
+namespace distributed {
+
+NearCache::NearCache(size_t capacity_bytes, uint64_t ttl_ns)
+    : capacity_bytes_(capacity_bytes), ttl_ns_(ttl_ns),
+      lru_(std::clamp<size_t>(capacity_bytes, 1, decltype(lru_)::MAX_CAPACITY)) {}
+
+NearCache::Entry* NearCache::touch(std::string_view key, uint64_t now_ns) {
+    Entry* entry = lru_.find(key);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+    if (entry->expires_ns <= now_ns) {
+        erase(key);
+        return nullptr;
+    }
+    return entry;
+}
+
+const std::vector<uint8_t>* NearCache::find(std::string_view key, uint64_t now_ns) {
+    Entry* entry = touch(key, now_ns);
+    return entry != nullptr ? &entry->value : nullptr;
+}
+
+bool NearCache::get(std::string_view key, std::vector<uint8_t>& out, uint64_t now_ns) {
+    Entry* entry = touch(key, now_ns);
+    if (entry == nullptr) {
+        return false;
+    }
+    out.assign(entry->value.begin(), entry->value.end());
+    return true;
+}
+
+bool NearCache::get(std::string_view key, std::span<uint8_t> buffer, size_t& length, uint64_t now_ns) {
+    Entry* entry = touch(key, now_ns);
+    if (entry == nullptr) {
+        return false;
+    }
+    length = entry->value.size();
+    if (length > buffer.size()) {
+        return false;
+    }
+    if (length > 0) {
+        std::memcpy(buffer.data(), entry->value.data(), length);
+    }
+    return true;
+}
+
+void NearCache::put(std::string_view key, const uint8_t* data, size_t size, uint64_t now_ns) {
+    if (key.size() + size > capacity_bytes_) {
+        erase(key);  // Would evict everything else and still not fit
+        return;
+    }
+
+    auto release = [this](const std::string& evicted, Entry& entry) {
+        bytes_ -= evicted.size() + entry.value.size();
+    };
+    auto [entry, inserted] = lru_.insert(key, release);
+    if (inserted) {
+        bytes_ += key.size();
+    } else {
+        bytes_ -= entry->value.size();
+    }
+    entry->value.assign(data, data + size);
+    entry->expires_ns = now_ns + ttl_ns_;
+    bytes_ += size;
+
+    // The new entry is most recent, so it is the last to go
+    while (bytes_ > capacity_bytes_) {
+        lru_.evict_oldest(release);
+    }
+}
+
+void NearCache::erase(std::string_view key) {
+    const Entry* entry = lru_.peek(key);
+    if (entry != nullptr) {
+        bytes_ -= key.size() + entry->value.size();
+        lru_.erase(key);
+    }
+}
+
+void NearCache::clear() {
+    lru_.clear();
+    bytes_ = 0;
+}
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,134 @@
+#include "distributed/shm_channel.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace feedhandler {
+namespace distributed {
+
+namespace {
+
+size_t round_up_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+ShmFrameChannel::~ShmFrameChannel() {
+    close();
+}
+
+bool ShmFrameChannel::open(const std::string& name, size_t capacity) {
+    close();
+    capacity = round_up_pow2(std::max<size_t>(capacity, 4096));
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        std::cerr << "shm_open " << name << " failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // An existing segment keeps its size; a fresh one (size 0) gets ours
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        std::cerr << "fstat " << name << " failed: " << strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+    size_t bytes = static_cast<size_t>(st.st_size);
+    if (bytes == 0) {
+        bytes = DATA_OFFSET + capacity;
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            std::cerr << "ftruncate " << name << " failed: " << strerror(errno) << std::endl;
+            ::close(fd);
+            return false;
+        }
+    }
+
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "mmap " << name << " failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    auto* control = static_cast<Control*>(mapping);
+    uint32_t fresh = 0;
+    if (control->state.compare_exchange_strong(fresh, 1, std::memory_order_acq_rel)) {
+        control->capacity = bytes - DATA_OFFSET;
+        control->head.store(0, std::memory_order_relaxed);
+        control->tail.store(0, std::memory_order_relaxed);
+        control->state.store(2, std::memory_order_release);
+    }
+    while (control->state.load(std::memory_order_acquire) != 2) {
+        std::this_thread::yield();  // The other side is initializing
+    }
+
+    control_ = control;
+    data_ = static_cast<uint8_t*>(mapping) + DATA_OFFSET;
+    capacity_ = static_cast<size_t>(control->capacity);
+    mask_ = capacity_ - 1;
+    mapped_bytes_ = bytes;
+    return true;
+}
+
+void ShmFrameChannel::close() {
+    if (control_ != nullptr) {
+        munmap(control_, mapped_bytes_);
+        control_ = nullptr;
+        data_ = nullptr;
+        capacity_ = 0;
+        mask_ = 0;
+        mapped_bytes_ = 0;
+    }
+}
+
+void ShmFrameChannel::unlink(const std::string& name) {
+    shm_unlink(name.c_str());
+}
+
+bool ShmFrameChannel::write(const uint8_t* frames, size_t size) {
+    if (control_ == nullptr || size == 0) {
+        return control_ != nullptr;
+    }
+    const uint64_t head = control_->head.load(std::memory_order_relaxed);
+    const uint64_t tail = control_->tail.load(std::memory_order_acquire);
+    size_t free = capacity_ - static_cast<size_t>(head - tail);
+    size_t index = static_cast<size_t>(head & mask_);
+    size_t to_end = capacity_ - index;
+
+    // Batches stay contiguous: skip the rest of the ring if it is too short
+    size_t skip = size <= to_end ? 0 : to_end;
+    if (skip + size > free) {
+        return false;
+    }
+    if (skip >= sizeof(FrameHeader)) {
+        FrameHeader padding{static_cast<uint32_t>(skip - sizeof(FrameHeader)),
+                            static_cast<uint16_t>(MessageType::PADDING), 0, 0, 0};
+        std::memcpy(data_ + index, &padding, sizeof(padding));
+    }
+    std::memcpy(data_ + ((head + skip) & mask_), frames, size);
+    control_->head.store(head + skip + size, std::memory_order_release);
+    return true;
+}
+
+size_t ShmFrameChannel::backlog() const {
+    if (control_ == nullptr) {
+        return 0;
+    }
+    return static_cast<size_t>(control_->head.load(std::memory_order_acquire) -
+                               control_->tail.load(std::memory_order_acquire));
+}
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,303 @@
+#include "distributed/cluster_computing.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace feedhandler {
+namespace distributed {
+
+namespace {
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+StreamProcessor::StreamProcessor(const StreamConfig& config, ClusterManager& cluster)
+    : config_(config),
+      cluster_(cluster),
+      flush_interval_(config.flush_interval_us != 0
+                          ? std::chrono::nanoseconds(std::chrono::microseconds(config.flush_interval_us))
+                          : std::chrono::nanoseconds(std::chrono::milliseconds(config.flush_interval_ms))) {
+    if (config.buffer_size == 0 || config.batch_size == 0) {
+        throw std::invalid_argument("StreamProcessor buffer_size and batch_size must be nonzero");
+    }
+    if (config.batch_size > config.buffer_size) {
+        throw std::invalid_argument("StreamProcessor batch_size cannot exceed buffer_size");
+    }
+    if (config.checkpoint_interval_ms == 0) {
+        throw std::invalid_argument("StreamProcessor checkpoint_interval_ms must be nonzero");
+    }
+}
+
+StreamProcessor::~StreamProcessor() {
+    std::vector<std::string> handles;
+    {
+        std::shared_lock<std::shared_mutex> lock(streams_mutex_);
+        for (const auto& [handle, info] : streams_) {
+            handles.push_back(handle);
+        }
+    }
+    for (const std::string& handle : handles) {
+        stop_stream(handle);
+    }
+}
+
+std::string StreamProcessor::create_stream(const std::string& stream_name,
+                                           const std::vector<std::string>& input_sources,
+                                           StreamFunction processing_function) {
+    std::unique_lock<std::shared_mutex> lock(streams_mutex_);
+    if (streams_.count(stream_name) != 0) {
+        std::cerr << "StreamProcessor: stream " << stream_name << " already exists" << std::endl;
+        return {};
+    }
+    auto info = std::make_unique<StreamInfo>();
+    info->name = stream_name;
+    info->sources = input_sources;
+    info->processor = std::move(processing_function);
+    info->slots.resize(config_.buffer_size);
+    streams_.emplace(stream_name, std::move(info));
+    return stream_name;
+}
+
+StreamProcessor::StreamInfo* StreamProcessor::find_stream(const std::string& stream_handle) const {
+    std::shared_lock<std::shared_mutex> lock(streams_mutex_);
+    auto it = streams_.find(stream_handle);
+    // Streams are never erased, so the pointer outlives the lock
+    return it == streams_.end() ? nullptr : it->second.get();
+}
+
+void StreamProcessor::start_stream(const std::string& stream_handle) {
+    StreamInfo* info = find_stream(stream_handle);
+    if (info == nullptr) {
+        std::cerr << "StreamProcessor: unknown stream " << stream_handle << std::endl;
+        return;
+    }
+    if (info->running.exchange(true)) {
+        return;
+    }
+    info->started_ns.store(now_ns(), std::memory_order_relaxed);
+    info->stopped_ns.store(0, std::memory_order_relaxed);
+    info->processing_thread = std::thread([this, info] { process_stream(*info); });
+    info->checkpoint_thread = std::thread([this, info] { checkpoint_loop(*info); });
+}
+
+void StreamProcessor::stop_stream(const std::string& stream_handle) {
+    StreamInfo* info = find_stream(stream_handle);
+    if (info == nullptr) {
+        return;
+    }
+    {
+        // Flip under each mutex so neither thread misses the wakeup
+        std::lock_guard<std::mutex> backlog(info->backlog_mutex);
+        std::lock_guard<std::mutex> checkpoint(info->checkpoint_mutex);
+        if (!info->running.exchange(false)) {
+            return;
+        }
+    }
+    info->backlog_ready.notify_all();
+    info->checkpoint_wake.notify_all();
+    if (info->processing_thread.joinable()) {
+        info->processing_thread.join();
+    }
+    if (info->checkpoint_thread.joinable()) {
+        info->checkpoint_thread.join();
+    }
+    info->stopped_ns.store(now_ns(), std::memory_order_relaxed);
+    // The backlog is drained now; record where it ended
+    checkpoint_stream(*info);
+}
+
+bool StreamProcessor::publish(const std::string& stream_handle, std::string_view symbol,
+                              const uint8_t* data, size_t size, uint64_t sequence) {
+    StreamInfo* info = find_stream(stream_handle);
+    if (info == nullptr) {
+        return false;
+    }
+    const uint64_t enqueued = now_ns();
+    uint64_t waiting;
+    {
+        std::lock_guard<std::mutex> lock(info->backlog_mutex);
+        const size_t capacity = info->slots.size();
+        if (info->head - info->tail == capacity) {
+            info->rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        // assign() keeps the slot's capacity from its previous use
+        Record& record = info->slots[info->head % capacity];
+        record.symbol.assign(symbol);
+        record.data.assign(data, data + size);
+        record.sequence = sequence;
+        record.enqueued_ns = enqueued;
+        ++info->head;
+        waiting = info->head - info->next;
+    }
+    // The processor sleeps either for a first record or for a full batch
+    if (waiting == 1 || waiting == config_.batch_size) {
+        info->backlog_ready.notify_one();
+    }
+    return true;
+}
+
+void StreamProcessor::set_checkpoint_sink(CheckpointSink sink) {
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    checkpoint_sink_ = std::move(sink);
+}
+
+bool StreamProcessor::restore_checkpoint(const std::string& stream_handle, const CheckpointOffsets& offsets) {
+    StreamInfo* info = find_stream(stream_handle);
+    if (info == nullptr || info->running.load()) {
+        std::cerr << "StreamProcessor: cannot restore " << stream_handle
+                  << (info == nullptr ? ": unknown stream" : ": stream is running") << std::endl;
+        return false;
+    }
+    for (const auto& [symbol, offset] : offsets) {
+        uint64_t& current = info->offsets[symbol];
+        current = std::max(current, offset);
+    }
+    return true;
+}
+
+void StreamProcessor::process_stream(StreamInfo& info) {
+    const size_t capacity = info.slots.size();
+    const size_t batch_size = config_.batch_size;
+    const uint64_t flush_ns = static_cast<uint64_t>(flush_interval_.count());
+    std::vector<CheckpointOffsets::value_type*> changed;
+    changed.reserve(batch_size);
+
+    std::unique_lock<std::mutex> lock(info.backlog_mutex);
+    while (true) {
+        info.backlog_ready.wait(lock, [&] { return info.head != info.next || !info.running.load(); });
+        if (info.head == info.next) {
+            break;  // Stopped and drained
+        }
+        // Hold the batch open until it fills or its oldest record is due
+        const auto deadline = std::chrono::steady_clock::time_point(
+            std::chrono::nanoseconds(info.slots[info.next % capacity].enqueued_ns + flush_ns));
+        info.backlog_ready.wait_until(lock, deadline, [&] {
+            return info.head - info.next >= batch_size || !info.running.load();
+        });
+
+        const uint64_t begin = info.next;
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(info.head - info.next, batch_size));
+        info.next += count;
+        if (count < batch_size && info.running.load()) {
+            info.deadline_flushes.fetch_add(1, std::memory_order_relaxed);
+        }
+        lock.unlock();
+
+        // Slots [begin, begin + count) stay reserved until tail moves past them
+        changed.clear();
+        uint64_t processed = 0;
+        uint64_t duplicates = 0;
+        for (uint64_t i = begin; i < begin + count; ++i) {
+            const Record& record = info.slots[i % capacity];
+            CheckpointOffsets::value_type* offset = nullptr;
+            if (config_.enable_exactly_once && record.sequence != 0) {
+                auto it = info.offsets.find(record.symbol);
+                if (it == info.offsets.end()) {
+                    it = info.offsets.emplace(record.symbol, 0).first;
+                } else if (record.sequence <= it->second) {
+                    ++duplicates;
+                    continue;
+                }
+                offset = &*it;
+            }
+            if (info.processor) {
+                info.processor(record.symbol, record.data);
+            }
+            if (offset != nullptr) {
+                offset->second = record.sequence;
+                changed.push_back(offset);
+            }
+            info.latency.record(now_ns() - record.enqueued_ns);
+            ++processed;
+        }
+        info.processed.fetch_add(processed, std::memory_order_relaxed);
+        info.duplicates.fetch_add(duplicates, std::memory_order_relaxed);
+        info.batches.fetch_add(1, std::memory_order_relaxed);
+
+        if (!changed.empty()) {
+            // One short lock per batch; the checkpoint thread never holds it for long
+            std::lock_guard<std::mutex> checkpoint(info.checkpoint_mutex);
+            for (const auto* entry : changed) {
+                info.dirty[entry->first] = entry->second;
+            }
+        }
+
+        lock.lock();
+        info.tail = info.next;
+    }
+}
+
+void StreamProcessor::checkpoint_loop(StreamInfo& info) {
+    const auto interval = std::chrono::milliseconds(config_.checkpoint_interval_ms);
+    std::unique_lock<std::mutex> lock(info.checkpoint_mutex);
+    while (info.running.load()) {
+        if (info.checkpoint_wake.wait_for(lock, interval, [&] { return !info.running.load(); })) {
+            break;  // stop_stream() writes the final checkpoint after draining
+        }
+        lock.unlock();
+        checkpoint_stream(info);
+        lock.lock();
+    }
+}
+
+void StreamProcessor::checkpoint_stream(StreamInfo& info) {
+    CheckpointOffsets changed;
+    {
+        std::lock_guard<std::mutex> lock(info.checkpoint_mutex);
+        if (info.dirty.empty()) {
+            return;
+        }
+        changed.swap(info.dirty);
+    }
+    CheckpointSink sink;
+    {
+        std::lock_guard<std::mutex> lock(sink_mutex_);
+        sink = checkpoint_sink_;
+    }
+    if (sink) {
+        sink(info.name, changed);
+    }
+    info.checkpoints.fetch_add(1, std::memory_order_relaxed);
+}
+
+StreamProcessor::StreamStats StreamProcessor::get_stream_stats(const std::string& stream_handle) const {
+    StreamStats stats{};
+    StreamInfo* info = find_stream(stream_handle);
+    if (info == nullptr) {
+        return stats;
+    }
+    stats.messages_processed = info->processed.load(std::memory_order_relaxed);
+    stats.checkpoint_count = info->checkpoints.load(std::memory_order_relaxed);
+    stats.batches_flushed = info->batches.load(std::memory_order_relaxed);
+    stats.deadline_flushes = info->deadline_flushes.load(std::memory_order_relaxed);
+    stats.duplicates_dropped = info->duplicates.load(std::memory_order_relaxed);
+    stats.publish_rejected = info->rejected.load(std::memory_order_relaxed);
+
+    const uint64_t started = info->started_ns.load(std::memory_order_relaxed);
+    const uint64_t stopped = info->stopped_ns.load(std::memory_order_relaxed);
+    const uint64_t elapsed = started == 0 ? 0 : (stopped != 0 ? stopped : now_ns()) - started;
+    if (elapsed > 0) {
+        stats.throughput_msgs_per_sec = static_cast<double>(stats.messages_processed) * 1e9 /
+                                        static_cast<double>(elapsed);
+    }
+
+    const common::LatencyHistogram latency = info->latency.snapshot();
+    stats.average_latency_ms = latency.mean() / 1e6;
+    stats.p99_latency_ms = static_cast<double>(latency.percentile(99.0)) / 1e6;
+    stats.max_latency_ms = static_cast<double>(latency.max()) / 1e6;
+
+    {
+        std::lock_guard<std::mutex> lock(info->backlog_mutex);
+        stats.backlog_size = static_cast<size_t>(info->head - info->tail);
+    }
+    return stats;
+}
+
+} // namespace distributed
+} // namespace feedhandler
@@ -0,0 +1,241 @@
+#include "distributed/symbol_load_balancer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace feedhandler {
+namespace distributed {
+
+namespace {
+
+// Rate of every symbol on nodes plus extra, unmeasured ones at the mean of the measured
+std::unordered_map<std::string, double> weights_of(const std::vector<SymbolLoadBalancer::Node>& nodes,
+                                                   const std::vector<std::string>& extra,
+                                                   const SymbolLoadBalancer::Rates& rates) {
+    std::unordered_map<std::string, double> weights;
+    std::vector<const std::string*> unmeasured;
+    double measured = 0.0;
+    size_t count = 0;
+    auto add = [&](const std::string& symbol) {
+        auto it = rates.find(symbol);
+        if (it == rates.end()) {
+            unmeasured.push_back(&symbol);
+            return;
+        }
+        if (weights.emplace(symbol, it->second).second) {
+            measured += it->second;
+            ++count;
+        }
+    };
+    for (const auto& node : nodes) {
+        std::for_each(node.symbols.begin(), node.symbols.end(), add);
+    }
+    std::for_each(extra.begin(), extra.end(), add);
+
+    const double mean = count > 0 ? measured / static_cast<double>(count) : 1.0;
+    for (const std::string* symbol : unmeasured) {
+        weights.emplace(*symbol, mean);
+    }
+    return weights;
+}
+
+} // namespace
+
+SymbolRateTracker::SymbolRateTracker(uint32_t half_life_ms, uint64_t start_ns)
+    : half_life_ns_(static_cast<double>(half_life_ms) * 1e6), last_sample_ns_(start_ns) {}
+
+std::atomic<uint64_t>& SymbolRateTracker::counter(std::string_view symbol) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(symbol);
+    if (it == entries_.end()) {
+        it = entries_.emplace(std::string(symbol), std::make_unique<Entry>()).first;
+    }
+    return it->second->count;
+}
+
+void SymbolRateTracker::sample(uint64_t now_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (now_ns <= last_sample_ns_) {
+        return;
+    }
+    const double elapsed_ns = static_cast<double>(now_ns - last_sample_ns_);
+    // Weight of the newest interval: older ones halve every half-life
+    const double alpha = half_life_ns_ > 0.0 ? 1.0 - std::exp2(-elapsed_ns / half_life_ns_) : 1.0;
+    for (auto& [symbol, entry] : entries_) {
+        const uint64_t count = entry->count.load(std::memory_order_relaxed);
+        if (entry->reported && count == entry->sampled) {
+            continue;  // Still owned elsewhere: keep the reported rate
+        }
+        entry->reported = false;
+        const double measured = static_cast<double>(count - entry->sampled) * 1e9 / elapsed_ns;
+        entry->sampled = count;
+        if (entry->has_rate) {
+            entry->rate += alpha * (measured - entry->rate);
+        } else {
+            entry->rate = measured;
+            entry->has_rate = true;
+        }
+    }
+    last_sample_ns_ = now_ns;
+}
+
+void SymbolRateTracker::set_rate(std::string_view symbol, double messages_per_second) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(symbol);
+    if (it == entries_.end()) {
+        it = entries_.emplace(std::string(symbol), std::make_unique<Entry>()).first;
+    }
+    it->second->rate = messages_per_second;
+    it->second->has_rate = true;
+    it->second->reported = true;
+    it->second->sampled = it->second->count.load(std::memory_order_relaxed);
+}
+
+double SymbolRateTracker::rate(std::string_view symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(symbol);
+    return it == entries_.end() ? 0.0 : it->second->rate;
+}
+
+std::unordered_map<std::string, double> SymbolRateTracker::rates() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_map<std::string, double> rates;
+    for (const auto& [symbol, entry] : entries_) {
+        if (entry->has_rate) {
+            rates.emplace(symbol, entry->rate);
+        }
+    }
+    return rates;
+}
+
+void SymbolLoadBalancer::place(std::vector<Node>& nodes, const std::vector<std::string>& symbols,
+                               const Rates& rates) {
+    if (nodes.empty()) {
+        return;
+    }
+    const auto weights = weights_of(nodes, symbols, rates);
+    std::vector<double> loads(nodes.size(), 0.0);
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        for (const auto& symbol : nodes[n].symbols) {
+            loads[n] += weights.at(symbol);
+        }
+    }
+
+    std::vector<size_t> order(symbols.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return weights.at(symbols[a]) > weights.at(symbols[b]);
+    });
+    for (size_t index : order) {
+        const double weight = weights.at(symbols[index]);
+        size_t target = 0;
+        double lowest = 0.0;
+        for (size_t n = 0; n < nodes.size(); ++n) {
+            double load = (loads[n] + weight) / nodes[n].capacity;
+            if (n == 0 || load < lowest) {
+                target = n;
+                lowest = load;
+            }
+        }
+        nodes[target].symbols.push_back(symbols[index]);
+        loads[target] += weight;
+    }
+}
+
+double SymbolLoadBalancer::imbalance(const std::vector<Node>& nodes, const Rates& rates) {
+    const auto weights = weights_of(nodes, {}, rates);
+    double total = 0.0;
+    double capacity = 0.0;
+    double hottest = 0.0;
+    for (const auto& node : nodes) {
+        double load = 0.0;
+        for (const auto& symbol : node.symbols) {
+            load += weights.at(symbol);
+        }
+        total += load;
+        capacity += node.capacity;
+        hottest = std::max(hottest, load / node.capacity);
+    }
+    if (total <= 0.0 || capacity <= 0.0) {
+        return 0.0;
+    }
+    return hottest / (total / capacity) - 1.0;
+}
+
+std::vector<SymbolLoadBalancer::Move> SymbolLoadBalancer::plan(std::vector<Node>& nodes, const Rates& rates,
+                                                               uint64_t now_ns) {
+    std::vector<Move> moves;
+    for (auto it = moved_ns_.begin(); it != moved_ns_.end();) {
+        it = now_ns - it->second >= config_.cooldown_ns ? moved_ns_.erase(it) : std::next(it);
+    }
+    if (nodes.size() < 2) {
+        rebalancing_ = false;
+        return moves;
+    }
+
+    double current = imbalance(nodes, rates);
+    if (!rebalancing_ && current <= config_.trigger_imbalance) {
+        return moves;
+    }
+    rebalancing_ = true;
+
+    const auto weights = weights_of(nodes, {}, rates);
+    std::vector<double> loads(nodes.size(), 0.0);
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        for (const auto& symbol : nodes[n].symbols) {
+            loads[n] += weights.at(symbol);
+        }
+    }
+    auto normalized = [&](size_t n) { return loads[n] / nodes[n].capacity; };
+
+    while (moves.size() < config_.max_moves) {
+        if (current <= config_.target_imbalance) {
+            rebalancing_ = false;
+            break;
+        }
+        size_t hot = 0;
+        size_t cool = 0;
+        for (size_t n = 1; n < nodes.size(); ++n) {
+            hot = normalized(n) > normalized(hot) ? n : hot;
+            cool = normalized(n) < normalized(cool) ? n : cool;
+        }
+
+        // The symbol leaving the lower peak of the two nodes, if any beats the current one
+        size_t best = nodes[hot].symbols.size();
+        double best_peak = normalized(hot);
+        for (size_t i = 0; i < nodes[hot].symbols.size(); ++i) {
+            const std::string& symbol = nodes[hot].symbols[i];
+            if (moved_ns_.count(symbol) != 0) {
+                continue;
+            }
+            const double weight = weights.at(symbol);
+            const double peak = std::max((loads[hot] - weight) / nodes[hot].capacity,
+                                         (loads[cool] + weight) / nodes[cool].capacity);
+            if (peak < best_peak) {
+                best = i;
+                best_peak = peak;
+            }
+        }
+        if (best == nodes[hot].symbols.size()) {
+            break;  // Nothing movable helps; the next round tries again if it is still past the trigger
+        }
+
+        std::string symbol = std::move(nodes[hot].symbols[best]);
+        nodes[hot].symbols.erase(nodes[hot].symbols.begin() + static_cast<std::ptrdiff_t>(best));
+        const double weight = weights.at(symbol);
+        loads[hot] -= weight;
+        loads[cool] += weight;
+        nodes[cool].symbols.push_back(symbol);
+        moved_ns_[symbol] = now_ns;
+        moves.push_back(Move{std::move(symbol), nodes[hot].id, nodes[cool].id});
+        current = imbalance(nodes, rates);
+    }
+    if (moves.empty() && current > config_.target_imbalance) {
+        rebalancing_ = false;
+    }
+    return moves;
+}
+
+} // namespace distributed
+} // namespace feedhandler
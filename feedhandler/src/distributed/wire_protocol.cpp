@@ -0,0 +1,150 @@
+#include "distributed/wire_protocol.hpp"
+
+#include <algorithm>
+
+namespace feedhandler {
+namespace distributed {
+
+uint32_t node_hash(std::string_view node_id) {
+    uint32_t hash = 2166136261u;
+    for (char c : node_id) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+ParseStatus parse_frame(const uint8_t* data, size_t length, Frame& frame, size_t& consumed) {
+    if (length < sizeof(FrameHeader)) {
+        return ParseStatus::INCOMPLETE;
+    }
+    const auto* header = reinterpret_cast<const FrameHeader*>(data);
+    if (header->length > MAX_FRAME_PAYLOAD) {
+        return ParseStatus::INVALID;
+    }
+    size_t total = frame_size(header->length);
+    if (length < total) {
+        return ParseStatus::INCOMPLETE;
+    }
+    frame.header = header;
+    frame.payload = data + sizeof(FrameHeader);
+    consumed = total;
+    return ParseStatus::FRAME;
+}
+
+uint8_t* FrameWriter::begin_frame(MessageType type, size_t payload_size) {
+    size_t total = frame_size(payload_size);
+    size_t words = (size_ + total) / sizeof(uint64_t);
+    if (words > buffer_.size()) {
+        buffer_.resize(std::max(words, 2 * buffer_.size()));
+    }
+
+    uint8_t* frame = reinterpret_cast<uint8_t*>(buffer_.data()) + size_;
+    // Padding word first: the payload may end mid-word
+    buffer_[(size_ + total) / sizeof(uint64_t) - 1] = 0;
+    FrameHeader header{static_cast<uint32_t>(payload_size), static_cast<uint16_t>(type), 0, sender_, sequence_++};
+    std::memcpy(frame, &header, sizeof(header));
+
+    size_ += total;
+    frames_++;
+    return frame + sizeof(FrameHeader);
+}
+
+namespace {
+
+// Name index shared by WORKLOAD_ASSIGNMENT and SYMBOL_RATES: count + 1 offsets, then the names
+void write_names(uint8_t* out, const std::vector<std::string_view>& symbols) {
+    auto* offsets = reinterpret_cast<uint32_t*>(out);
+    char* name_bytes = reinterpret_cast<char*>(out + sizeof(uint32_t) * (symbols.size() + 1));
+    uint32_t offset = 0;
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        offsets[i] = offset;
+        std::memcpy(name_bytes + offset, symbols[i].data(), symbols[i].size());
+        offset += static_cast<uint32_t>(symbols[i].size());
+    }
+    offsets[symbols.size()] = offset;
+}
+
+size_t names_size(const std::vector<std::string_view>& symbols) {
+    size_t names = 0;
+    for (const auto& symbol : symbols) {
+        names += symbol.size();
+    }
+    return sizeof(uint32_t) * (symbols.size() + 1) + names;
+}
+
+// Validates the name index of count symbols in size bytes at data
+bool parse_names(const uint8_t* data, size_t size, size_t count, const uint32_t*& offsets, const char*& names) {
+    size_t index_bytes = sizeof(uint32_t) * (count + 1);
+    if (index_bytes > size) {
+        return false;
+    }
+    const uint32_t* index = reinterpret_cast<const uint32_t*>(data);
+    size_t name_bytes = size - index_bytes;
+    for (size_t i = 0; i < count; ++i) {
+        if (index[i] > index[i + 1]) {
+            return false;
+        }
+    }
+    if (index[0] != 0 || index[count] > name_bytes) {
+        return false;
+    }
+    offsets = index;
+    names = reinterpret_cast<const char*>(data + index_bytes);
+    return true;
+}
+
+} // namespace
+
+void write_workload_assignment(FrameWriter& writer, const std::vector<std::string>& symbols) {
+    std::vector<std::string_view> names(symbols.begin(), symbols.end());
+    uint8_t* out = writer.begin_frame(MessageType::WORKLOAD_ASSIGNMENT, sizeof(uint32_t) + names_size(names));
+    *reinterpret_cast<uint32_t*>(out) = static_cast<uint32_t>(symbols.size());
+    write_names(out + sizeof(uint32_t), names);
+}
+
+WorkloadAssignmentView::WorkloadAssignmentView(const Frame& frame) {
+    const uint32_t* count = frame.as<uint32_t>();
+    if (frame.type() != MessageType::WORKLOAD_ASSIGNMENT || count == nullptr || *count > frame.size()) {
+        return;
+    }
+    if (parse_names(frame.payload + sizeof(uint32_t), frame.size() - sizeof(uint32_t), *count, offsets_, names_)) {
+        count_ = *count;
+    }
+}
+
+void write_symbol_rates(FrameWriter& writer, const std::vector<std::pair<std::string, double>>& rates) {
+    std::vector<std::string_view> names;
+    names.reserve(rates.size());
+    for (const auto& [symbol, rate] : rates) {
+        names.push_back(symbol);
+    }
+    const size_t rate_bytes = sizeof(double) * rates.size();
+    uint8_t* out = writer.begin_frame(MessageType::SYMBOL_RATES, sizeof(uint64_t) + rate_bytes + names_size(names));
+    auto* header = reinterpret_cast<uint32_t*>(out);
+    header[0] = static_cast<uint32_t>(rates.size());
+    header[1] = 0;
+    auto* values = reinterpret_cast<double*>(out + sizeof(uint64_t));
+    for (size_t i = 0; i < rates.size(); ++i) {
+        values[i] = rates[i].second;
+    }
+    write_names(out + sizeof(uint64_t) + rate_bytes, names);
+}
+
+SymbolRatesView::SymbolRatesView(const Frame& frame) {
+    const uint64_t* header = frame.as<uint64_t>();
+    if (frame.type() != MessageType::SYMBOL_RATES || header == nullptr) {
+        return;
+    }
+    const size_t count = static_cast<uint32_t>(*header);
+    const size_t prefix = sizeof(uint64_t) + sizeof(double) * count;
+    if (count > frame.size() || prefix > frame.size()) {
+        return;
+    }
+    if (parse_names(frame.payload + prefix, frame.size() - prefix, count, offsets_, names_)) {
+        count_ = count;
+        rates_ = reinterpret_cast<const double*>(frame.payload + sizeof(uint64_t));
+    }
+}
+
+} // namespace distributed
+} // namespace feedhandler
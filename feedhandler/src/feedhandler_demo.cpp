@@ -127,19 +127,20 @@ public:
         std::cout << "========================================" << std::endl;
         std::cout << "\nReceiving market data...\n" << std::endl;
         
-        char temp_buffer[4096];
         std::vector<common::Tick> ticks;
         ticks.reserve(100);
         
         int message_count = 0;
         
         while (true) {
-            // Read from socket
-            ssize_t bytes_read = recv(socket_fd_, temp_buffer, sizeof(temp_buffer), 0);
+            // Read from socket straight into the receive buffer
+            if (buffer_.available_write() == 0) {
+                buffer_.compact();
+            }
+            ssize_t bytes_read = recv(socket_fd_, buffer_.write_buffer(), buffer_.available_write(), 0);
             
             if (bytes_read > 0) {
-                // Write to receive buffer
-                buffer_.write(temp_buffer, bytes_read);
+                buffer_.advance_write(bytes_read);
                 
                 // Parse available data
                 size_t consumed = parser_.parse(
@@ -2,125 +2,149 @@
 #include "gpu/cuda_parser.hpp"
 #include <cuda_runtime.h>
 #include <device_launch_parameters.h>
-#include <cooperative_groups.h>
 
-namespace cg = cooperative_groups;
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <cub/device/device_scan.cuh>
+#include "common/symbol_table.hpp"
 
 namespace feedhandler {
 namespace gpu {
 
-// CUDA kernel for parallel FIX message parsing
-__global__ void parallel_fix_parser_kernel(const char** messages,
-                                          const size_t* lengths,
-                                          common::Tick* output_ticks,
-                                          size_t batch_size) {
-    int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    
-    if (idx >= batch_size) return;
-    
-    // Each thread processes one FIX message
-    const char* message = messages[idx];
-    size_t length = lengths[idx];
-    
-    // Shared memory for delimiter positions
-    __shared__ int delimiter_positions[1024];
-    __shared__ int delimiter_count;
-    
-    if (threadIdx.x == 0) {
-        delimiter_count = 0;
+// Fixed-point price (scaled by 10000), extra fractional digits truncated
+__device__ int64_t parse_fixed_price(const char* p, const char* end) {
+    bool negative = p < end && *p == '-';
+    if (negative) {
+        ++p;
     }
-    __syncthreads();
-    
-    // Parallel delimiter scanning using warp primitives
-    auto warp = cg::tiled_partition<32>(cg::this_thread_block());
-    
-    for (int i = warp.thread_rank(); i < length; i += warp.size()) {
-        if (message[i] == '\x01') { // SOH delimiter
-            int pos = atomicAdd(&delimiter_count, 1);
-            if (pos < 1024) {
-                delimiter_positions[pos] = i;
-            }
-        }
+    int64_t whole = 0;
+    for (; p < end && *p != '.'; ++p) {
+        whole = whole * 10 + (*p - '0');
     }
-    
-    __syncthreads();
-    
-    // Parse FIX fields
-    common::Tick tick = {};
-    tick.timestamp = clock64(); // Hardware timestamp
-    
-    int start = 0;
-    for (int d = 0; d < delimiter_count && d < 1024; d++) {
-        int end = delimiter_positions[d];
-        
-        // Find tag separator
-        int eq_pos = -1;
-        for (int i = start; i < end; i++) {
-            if (message[i] == '=') {
-                eq_pos = i;
-                break;
-            }
-        }
-        
-        if (eq_pos == -1) {
-            start = end + 1;
-            continue;
+    int64_t fraction = 0;
+    int digits = 0;
+    if (p < end) {
+        for (++p; p < end && digits < 4; ++p, ++digits) {
+            fraction = fraction * 10 + (*p - '0');
         }
-        
-        // Parse tag (simple atoi on GPU)
+    }
+    for (; digits < 4; ++digits) {
+        fraction *= 10;
+    }
+    int64_t value = whole * 10000 + fraction;
+    return negative ? -value : value;
+}
+
+// Parse the fields of data[begin, end); the symbol is returned as a byte range.
+// Returns the offset just past the CheckSum (10) field, or 0 if there is none.
+__device__ uint32_t parse_fix_message(const char* data, uint32_t begin, uint32_t end,
+                                      common::CompactTick& tick, FieldRef& symbol) {
+    tick = common::CompactTick{};
+    symbol = FieldRef{0, 0};
+
+    uint32_t field = begin;
+    while (field < end) {
         int tag = 0;
-        for (int i = start; i < eq_pos; i++) {
-            if (message[i] >= '0' && message[i] <= '9') {
-                tag = tag * 10 + (message[i] - '0');
-            }
+        uint32_t i = field;
+        for (; i < end && data[i] != '='; ++i) {
+            tag = tag * 10 + (data[i] - '0');
         }
-        
-        // Parse value based on tag
-        switch (tag) {
-            case 44: { // Price
-                double price = 0.0;
-                double fraction = 0.0;
-                bool in_fraction = false;
-                double divisor = 10.0;
-                
-                for (int i = eq_pos + 1; i < end; i++) {
-                    if (message[i] == '.') {
-                        in_fraction = true;
-                    } else if (message[i] >= '0' && message[i] <= '9') {
-                        if (in_fraction) {
-                            fraction += (message[i] - '0') / divisor;
-                            divisor *= 10.0;
-                        } else {
-                            price = price * 10.0 + (message[i] - '0');
-                        }
+        uint32_t value = i + 1;
+        uint32_t stop = value;
+        while (stop < end && data[stop] != '\x01') {
+            ++stop;
+        }
+
+        if (i < end) {
+            switch (tag) {
+                case 55: // Symbol
+                    symbol = FieldRef{value, stop - value};
+                    break;
+                case 44: // Price
+                    tick.price = parse_fixed_price(data + value, data + stop);
+                    break;
+                case 38: { // Quantity
+                    int32_t qty = 0;
+                    for (uint32_t k = value; k < stop; ++k) {
+                        qty = qty * 10 + (data[k] - '0');
                     }
+                    tick.qty = qty;
+                    break;
                 }
-                tick.price = static_cast<int64_t>((price + fraction) * 10000.0);
-                break;
-            }
-            case 38: { // Quantity
-                int qty = 0;
-                for (int i = eq_pos + 1; i < end; i++) {
-                    if (message[i] >= '0' && message[i] <= '9') {
-                        qty = qty * 10 + (message[i] - '0');
+                case 54: // Side
+                    if (value < stop) {
+                        tick.side = data[value] == '1' ? 'B' : 'S';
                     }
-                }
-                tick.qty = qty;
-                break;
-            }
-            case 54: { // Side
-                if (eq_pos + 1 < end) {
-                    tick.side = (message[eq_pos + 1] == '1') ? 'B' : 'S';
-                }
-                break;
+                    break;
+                case 10: // CheckSum: the trailer, complete once its SOH is in range
+                    return stop < end ? stop + 1 : 0;
             }
         }
-        
-        start = end + 1;
+        field = stop + 1;
     }
-    
-    // Store parsed tick
+    return 0;
+}
+
+// One thread per message; messages sit back to back in data
+__global__ void parallel_fix_parser_kernel(const char* data,
+                                          const uint32_t* offsets,
+                                          common::CompactTick* output_ticks,
+                                          FieldRef* output_symbols,
+                                          size_t count) {
+    size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (idx >= count) return;
+
+    common::CompactTick tick;
+    FieldRef symbol;
+    parse_fix_message(data, offsets[idx], offsets[idx + 1], tick, symbol);
     output_ticks[idx] = tick;
+    output_symbols[idx] = symbol;
+}
+
+// Framing pass 1: flag every "8=FIX" that starts the buffer or follows an SOH
+__global__ void mark_message_starts_kernel(const char* data, uint32_t length, uint32_t* flags) {
+    uint32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= length) return;
+
+    bool start = i + 5 <= length && (i == 0 || data[i - 1] == '\x01') &&
+                 data[i] == '8' && data[i + 1] == '=' && data[i + 2] == 'F' &&
+                 data[i + 3] == 'I' && data[i + 4] == 'X';
+    flags[i] = start ? 1 : 0;
+}
+
+// Framing pass 2, after the exclusive scan of the flags: scatter each start to
+// its message index. starts holds capacity + 1 entries, so the first message
+// that does not fit still records where it begins.
+__global__ void scatter_message_starts_kernel(const uint32_t* flags, const uint32_t* ranks, uint32_t length,
+                                              uint32_t capacity, uint32_t* starts, uint32_t* total) {
+    uint32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= length) return;
+
+    if (flags[i] && ranks[i] <= capacity) {
+        starts[ranks[i]] = i;
+    }
+    if (i == length - 1) {
+        *total = ranks[i] + flags[i];
+    }
+}
+
+// Framing pass 3: one thread per framed message. A message runs from its
+// start to the next one (or the end of the chunk) and is complete only if
+// its CheckSum trailer lies in that range; ends[k] is 0 otherwise.
+__global__ void parse_framed_messages_kernel(const char* data, const uint32_t* starts, uint32_t total,
+                                             uint32_t count, uint32_t length,
+                                             common::CompactTick* output_ticks, FieldRef* output_symbols,
+                                             uint32_t* ends) {
+    uint32_t k = blockIdx.x * blockDim.x + threadIdx.x;
+    if (k >= count) return;
+
+    uint32_t limit = k + 1 < total ? starts[k + 1] : length;
+    common::CompactTick tick;
+    FieldRef symbol;
+    ends[k] = parse_fix_message(data, starts[k], limit, tick, symbol);
+    output_ticks[k] = tick;
+    output_symbols[k] = symbol;
 }
 
 // CUDA kernel for SIMD-style delimiter scanning
@@ -161,14 +185,88 @@ __global__ void delimiter_scanner_kernel(const char* data,
 }
 
 // Host function implementations
-CUDAFixParser::CUDAFixParser(const Config& config) 
-    : config_(config), gpu_memory_pool_(nullptr), 
-      gpu_message_buffer_(nullptr), gpu_tick_buffer_(nullptr) {
-    
+
+struct CUDAFixParser::Slot {
+    // Pinned host side: staged bytes and offsets in, ticks and symbol ranges out
+    char* host_bytes = nullptr;
+    uint32_t* host_offsets = nullptr;
+    common::CompactTick* host_ticks = nullptr;
+    FieldRef* host_symbols = nullptr;
+
+    char* device_bytes = nullptr;
+    uint32_t* device_offsets = nullptr;
+    common::CompactTick* device_ticks = nullptr;
+    FieldRef* device_symbols = nullptr;
+
+    cudaStream_t stream = nullptr;
+    cudaEvent_t started = nullptr;
+    cudaEvent_t done = nullptr;
+
+    size_t bytes = 0;
+    size_t messages = 0;
+};
+
+// Device and pinned buffers of parse_stream(), allocated on first use
+struct CUDAFixParser::FramingBuffers {
+    uint32_t capacity = 0;          // Messages framed per pass
+
+    char* device_bytes = nullptr;
+    uint32_t* device_flags = nullptr;   // One per byte
+    uint32_t* device_ranks = nullptr;   // Exclusive scan of the flags
+    uint32_t* device_starts = nullptr;  // capacity + 1
+    uint32_t* device_total = nullptr;
+    uint32_t* device_ends = nullptr;
+    common::CompactTick* device_ticks = nullptr;
+    FieldRef* device_symbols = nullptr;
+    void* scan_storage = nullptr;
+    size_t scan_storage_bytes = 0;
+
+    char* host_bytes = nullptr;
+    uint32_t* host_total = nullptr;
+    uint32_t* host_next_start = nullptr;
+    uint32_t* host_ends = nullptr;
+    common::CompactTick* host_ticks = nullptr;
+    FieldRef* host_symbols = nullptr;
+
+    cudaEvent_t started = nullptr;
+    cudaEvent_t done = nullptr;
+
+    ~FramingBuffers() {
+        cudaFree(device_bytes);
+        cudaFree(device_flags);
+        cudaFree(device_ranks);
+        cudaFree(device_starts);
+        cudaFree(device_total);
+        cudaFree(device_ends);
+        cudaFree(device_ticks);
+        cudaFree(device_symbols);
+        cudaFree(scan_storage);
+        cudaFreeHost(host_bytes);
+        cudaFreeHost(host_total);
+        cudaFreeHost(host_next_start);
+        cudaFreeHost(host_ends);
+        cudaFreeHost(host_ticks);
+        cudaFreeHost(host_symbols);
+        if (started) cudaEventDestroy(started);
+        if (done) cudaEventDestroy(done);
+    }
+};
+
+CUDAFixParser::CUDAFixParser()
+    : CUDAFixParser(Config()) {}
+
+CUDAFixParser::CUDAFixParser(const Config& config)
+    : config_(config) {
+    config_.stream_count = std::max<size_t>(config_.stream_count, 1);
+    config_.max_messages_per_batch = std::max<size_t>(config_.max_messages_per_batch, 1);
+    // Offsets are 32-bit
+    config_.max_batch_bytes = std::min<size_t>(config_.max_batch_bytes, UINT32_MAX);
+
     if (!initialize_cuda()) {
+        cleanup_cuda();
         throw std::runtime_error("Failed to initialize CUDA");
     }
-    
+
     allocate_gpu_memory();
 }
 
@@ -181,112 +279,353 @@ bool CUDAFixParser::initialize_cuda() {
     if (error != cudaSuccess) {
         return false;
     }
-    
-    // Create CUDA streams for parallel processing
-    cuda_streams_ = new cudaStream_t[config_.stream_count];
-    cuda_events_ = new cudaEvent_t[config_.stream_count];
-    
+
+    // One stream per staging slot; non-blocking so they never serialize on the legacy stream
+    slots_ = std::make_unique<Slot[]>(config_.stream_count);
     for (size_t i = 0; i < config_.stream_count; i++) {
-        cudaStreamCreate(&cuda_streams_[i]);
-        cudaEventCreate(&cuda_events_[i]);
+        Slot& slot = slots_[i];
+        if (cudaStreamCreateWithFlags(&slot.stream, cudaStreamNonBlocking) != cudaSuccess ||
+            cudaEventCreate(&slot.started) != cudaSuccess ||
+            cudaEventCreate(&slot.done) != cudaSuccess) {
+            return false;
+        }
     }
-    
+
     return true;
 }
 
 void CUDAFixParser::allocate_gpu_memory() {
-    // Allocate GPU memory pool
-    cudaMalloc(&gpu_memory_pool_, config_.gpu_memory_pool_size);
-    
-    // Allocate message and tick buffers
-    size_t message_buffer_size = config_.max_messages_per_batch * sizeof(char*);
-    size_t tick_buffer_size = config_.max_messages_per_batch * sizeof(common::Tick);
-    
-    cudaMalloc(&gpu_message_buffer_, message_buffer_size);
-    cudaMalloc(&gpu_tick_buffer_, tick_buffer_size);
+    size_t bytes = config_.max_batch_bytes;
+    size_t offsets = (config_.max_messages_per_batch + 1) * sizeof(uint32_t);
+    size_t ticks = config_.max_messages_per_batch * sizeof(common::CompactTick);
+    size_t symbols = config_.max_messages_per_batch * sizeof(FieldRef);
+
+    bool ok = true;
+    for (size_t i = 0; i < config_.stream_count; i++) {
+        Slot& slot = slots_[i];
+        // Page-locked host memory lets the copies run asynchronously, as DMA
+        ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&slot.host_bytes), bytes, cudaHostAllocDefault) == cudaSuccess;
+        ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&slot.host_offsets), offsets, cudaHostAllocDefault) == cudaSuccess;
+        ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&slot.host_ticks), ticks, cudaHostAllocDefault) == cudaSuccess;
+        ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&slot.host_symbols), symbols, cudaHostAllocDefault) == cudaSuccess;
+        ok = ok && cudaMalloc(reinterpret_cast<void**>(&slot.device_bytes), bytes) == cudaSuccess;
+        ok = ok && cudaMalloc(reinterpret_cast<void**>(&slot.device_offsets), offsets) == cudaSuccess;
+        ok = ok && cudaMalloc(reinterpret_cast<void**>(&slot.device_ticks), ticks) == cudaSuccess;
+        ok = ok && cudaMalloc(reinterpret_cast<void**>(&slot.device_symbols), symbols) == cudaSuccess;
+        if (ok) {
+            slot.host_offsets[0] = 0;
+        }
+    }
+    if (!ok) {
+        cleanup_cuda();
+        throw std::runtime_error("Failed to allocate CUDA staging buffers");
+    }
+
+    metrics_.memory_usage_bytes = 2 * config_.stream_count * (bytes + offsets + ticks + symbols);
+}
+
+bool CUDAFixParser::stage(const char* message, size_t length) {
+    if (length > config_.max_batch_bytes) {
+        return false;
+    }
+
+    Slot* slot = &slots_[filling_];
+    if (slot->messages == config_.max_messages_per_batch ||
+        slot->bytes + length > config_.max_batch_bytes) {
+        submit();
+        slot = &slots_[filling_];
+    }
+
+    std::memcpy(slot->host_bytes + slot->bytes, message, length);
+    slot->bytes += length;
+    slot->host_offsets[++slot->messages] = static_cast<uint32_t>(slot->bytes);
+    return true;
+}
+
+size_t CUDAFixParser::submit() {
+    Slot& slot = slots_[filling_];
+    if (slot.messages == 0) {
+        return 0;
+    }
+    if (first_submit_ns_ == 0) {
+        first_submit_ns_ = common::Tick::current_timestamp_ns();
+    }
+
+    // Everything is queued on the slot's stream; the host returns immediately
+    cudaEventRecord(slot.started, slot.stream);
+    cudaMemcpyAsync(slot.device_bytes, slot.host_bytes, slot.bytes, cudaMemcpyHostToDevice, slot.stream);
+    cudaMemcpyAsync(slot.device_offsets, slot.host_offsets, (slot.messages + 1) * sizeof(uint32_t),
+                    cudaMemcpyHostToDevice, slot.stream);
+    launch_parallel_fix_parser(slot.device_bytes, slot.device_offsets, slot.device_ticks,
+                               slot.device_symbols, slot.messages, slot.stream);
+    cudaMemcpyAsync(slot.host_ticks, slot.device_ticks, slot.messages * sizeof(common::CompactTick),
+                    cudaMemcpyDeviceToHost, slot.stream);
+    cudaMemcpyAsync(slot.host_symbols, slot.device_symbols, slot.messages * sizeof(FieldRef),
+                    cudaMemcpyDeviceToHost, slot.stream);
+    cudaEventRecord(slot.done, slot.stream);
+
+    size_t submitted = slot.messages;
+    ++in_flight_;
+    filling_ = (filling_ + 1) % config_.stream_count;
+    if (in_flight_ == config_.stream_count) {
+        // Every slot is busy: the next one to fill is the oldest
+        finish_oldest(completed_);
+    }
+    return submitted;
+}
+
+void CUDAFixParser::finish_oldest(std::vector<common::CompactTick>& ticks) {
+    Slot& slot = slots_[oldest_];
+    cudaEventSynchronize(slot.done);
+
+    float elapsed_ms = 0.0f;
+    cudaEventElapsedTime(&elapsed_ms, slot.started, slot.done);
+    metrics_.kernel_execution_time_ms += elapsed_ms;
+    metrics_.processed_message_count += slot.messages;
+    metrics_.batch_count++;
+
+    auto& symbols = common::SymbolTable::global();
+    for (size_t i = 0; i < slot.messages; ++i) {
+        common::CompactTick tick = slot.host_ticks[i];
+        const FieldRef& symbol = slot.host_symbols[i];
+        if (symbol.length > 0) {
+            tick.instrument_id = symbols.intern(std::string_view(slot.host_bytes + symbol.offset, symbol.length));
+        }
+        ticks.push_back(tick);
+    }
+
+    slot.bytes = 0;
+    slot.messages = 0;
+    oldest_ = (oldest_ + 1) % config_.stream_count;
+    --in_flight_;
+}
+
+size_t CUDAFixParser::collect(std::vector<common::CompactTick>& ticks, bool wait) {
+    size_t before = ticks.size();
+    ticks.insert(ticks.end(), completed_.begin(), completed_.end());
+    completed_.clear();
+
+    while (in_flight_ > 0) {
+        if (!wait && cudaEventQuery(slots_[oldest_].done) == cudaErrorNotReady) {
+            break;
+        }
+        finish_oldest(ticks);
+    }
+    return ticks.size() - before;
+}
+
+bool CUDAFixParser::allocate_framing_buffers() {
+    auto buffers = std::make_unique<FramingBuffers>();
+    size_t bytes = config_.max_batch_bytes;
+    buffers->capacity = static_cast<uint32_t>(std::max<size_t>(bytes / MIN_FRAMED_MESSAGE_BYTES, 1));
+    size_t capacity = buffers->capacity;
+
+    cub::DeviceScan::ExclusiveSum(nullptr, buffers->scan_storage_bytes, buffers->device_flags,
+                                  buffers->device_ranks, static_cast<int>(bytes));
+
+    bool ok = true;
+    ok = ok && cudaMalloc(reinterpret_cast<void**>(&buffers->device_bytes), bytes) == cudaSuccess;
+    ok = ok && cudaMalloc(reinterpret_cast<void**>(&buffers->device_flags), bytes * sizeof(uint32_t)) == cudaSuccess;
+    ok = ok && cudaMalloc(reinterpret_cast<void**>(&buffers->device_ranks), bytes * sizeof(uint32_t)) == cudaSuccess;
+    ok = ok && cudaMalloc(reinterpret_cast<void**>(&buffers->device_starts), (capacity + 1) * sizeof(uint32_t)) == cudaSuccess;
+    ok = ok && cudaMalloc(reinterpret_cast<void**>(&buffers->device_total), sizeof(uint32_t)) == cudaSuccess;
+    ok = ok && cudaMalloc(reinterpret_cast<void**>(&buffers->device_ends), capacity * sizeof(uint32_t)) == cudaSuccess;
+    ok = ok && cudaMalloc(reinterpret_cast<void**>(&buffers->device_ticks), capacity * sizeof(common::CompactTick)) == cudaSuccess;
+    ok = ok && cudaMalloc(reinterpret_cast<void**>(&buffers->device_symbols), capacity * sizeof(FieldRef)) == cudaSuccess;
+    ok = ok && cudaMalloc(&buffers->scan_storage, buffers->scan_storage_bytes) == cudaSuccess;
+    ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&buffers->host_bytes), bytes, cudaHostAllocDefault) == cudaSuccess;
+    ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&buffers->host_total), sizeof(uint32_t), cudaHostAllocDefault) == cudaSuccess;
+    ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&buffers->host_next_start), sizeof(uint32_t), cudaHostAllocDefault) == cudaSuccess;
+    ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&buffers->host_ends), capacity * sizeof(uint32_t), cudaHostAllocDefault) == cudaSuccess;
+    ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&buffers->host_ticks), capacity * sizeof(common::CompactTick), cudaHostAllocDefault) == cudaSuccess;
+    ok = ok && cudaHostAlloc(reinterpret_cast<void**>(&buffers->host_symbols), capacity * sizeof(FieldRef), cudaHostAllocDefault) == cudaSuccess;
+    ok = ok && cudaEventCreate(&buffers->started) == cudaSuccess;
+    ok = ok && cudaEventCreate(&buffers->done) == cudaSuccess;
+    if (!ok) {
+        return false;
+    }
+
+    metrics_.memory_usage_bytes += 2 * bytes + 2 * bytes * sizeof(uint32_t) + buffers->scan_storage_bytes
+        + 2 * capacity * (sizeof(uint32_t) + sizeof(common::CompactTick) + sizeof(FieldRef));
+    framing_ = std::move(buffers);
+    return true;
+}
+
+size_t CUDAFixParser::parse_stream(const char* data, size_t length, std::vector<common::CompactTick>& ticks) {
+    if (!framing_ && !allocate_framing_buffers()) {
+        return 0;
+    }
+    // Bulk mode shares the first stream; finish pipelined batches so results stay in order
+    size_t before = ticks.size();
+    submit();
+    collect(ticks, true);
+    size_t pipelined = ticks.size() - before;
+    if (first_submit_ns_ == 0) {
+        first_submit_ns_ = common::Tick::current_timestamp_ns();
+    }
+
+    size_t consumed = 0;
+    while (consumed < length) {
+        size_t piece = std::min(length - consumed, config_.max_batch_bytes);
+        size_t used = frame_piece(data + consumed, piece, ticks);
+        if (used == 0) {
+            if (piece < config_.max_batch_bytes) {
+                break;  // An incomplete message: wait for more data
+            }
+            // A full piece without one complete message cannot grow: skip it
+            used = piece;
+        }
+        consumed += used;
+    }
+    metrics_.processed_message_count += ticks.size() - before - pipelined;
+    return consumed;
+}
+
+size_t CUDAFixParser::frame_piece(const char* data, size_t length, std::vector<common::CompactTick>& ticks) {
+    FramingBuffers& f = *framing_;
+    cudaStream_t stream = slots_[0].stream;
+    uint32_t bytes = static_cast<uint32_t>(length);
+    int block_size = 256;
+    int byte_blocks = static_cast<int>((length + block_size - 1) / block_size);
+
+    // Boundaries: flag starts, scan the flags into message indices, scatter the starts
+    std::memcpy(f.host_bytes, data, length);
+    cudaEventRecord(f.started, stream);
+    cudaMemcpyAsync(f.device_bytes, f.host_bytes, length, cudaMemcpyHostToDevice, stream);
+    mark_message_starts_kernel<<<byte_blocks, block_size, 0, stream>>>(f.device_bytes, bytes, f.device_flags);
+    cub::DeviceScan::ExclusiveSum(f.scan_storage, f.scan_storage_bytes, f.device_flags, f.device_ranks,
+                                  static_cast<int>(bytes), stream);
+    scatter_message_starts_kernel<<<byte_blocks, block_size, 0, stream>>>(
+        f.device_flags, f.device_ranks, bytes, f.capacity, f.device_starts, f.device_total);
+    cudaMemcpyAsync(f.host_total, f.device_total, sizeof(uint32_t), cudaMemcpyDeviceToHost, stream);
+    cudaStreamSynchronize(stream);
+
+    uint32_t total = *f.host_total;
+    if (total == 0) {
+        // No start yet; keep a tail that could be the front of a split "8=FIX"
+        return length > 5 ? length - 5 : 0;
+    }
+    uint32_t count = std::min(total, f.capacity);
+
+    // Every framed message in one launch
+    int message_blocks = static_cast<int>((count + block_size - 1) / block_size);
+    parse_framed_messages_kernel<<<message_blocks, block_size, 0, stream>>>(
+        f.device_bytes, f.device_starts, total, count, bytes, f.device_ticks, f.device_symbols, f.device_ends);
+    cudaMemcpyAsync(f.host_ticks, f.device_ticks, count * sizeof(common::CompactTick), cudaMemcpyDeviceToHost, stream);
+    cudaMemcpyAsync(f.host_symbols, f.device_symbols, count * sizeof(FieldRef), cudaMemcpyDeviceToHost, stream);
+    cudaMemcpyAsync(f.host_ends, f.device_ends, count * sizeof(uint32_t), cudaMemcpyDeviceToHost, stream);
+    // Messages past the capacity (or a torn last one) resume at the next start
+    cudaMemcpyAsync(f.host_next_start, f.device_starts + (total > count ? count : count - 1), sizeof(uint32_t),
+                    cudaMemcpyDeviceToHost, stream);
+    cudaEventRecord(f.done, stream);
+    cudaEventSynchronize(f.done);
+
+    float elapsed_ms = 0.0f;
+    cudaEventElapsedTime(&elapsed_ms, f.started, f.done);
+    metrics_.kernel_execution_time_ms += elapsed_ms;
+    metrics_.batch_count++;
+
+    auto& symbols = common::SymbolTable::global();
+    for (uint32_t k = 0; k < count; ++k) {
+        if (f.host_ends[k] == 0) {
+            continue;  // No trailer before the next start: truncated message
+        }
+        common::CompactTick tick = f.host_ticks[k];
+        const FieldRef& symbol = f.host_symbols[k];
+        if (symbol.length > 0) {
+            tick.instrument_id = symbols.intern(std::string_view(f.host_bytes + symbol.offset, symbol.length));
+        }
+        ticks.push_back(tick);
+    }
+
+    if (total > count) {
+        return *f.host_next_start;
+    }
+    // The last message may continue in the next chunk
+    return f.host_ends[count - 1] != 0 ? f.host_ends[count - 1] : *f.host_next_start;
 }
 
 size_t CUDAFixParser::parse_batch(const char** messages,
                                  const size_t* message_lengths,
                                  size_t batch_size,
                                  std::vector<common::Tick>& ticks) {
-    
-    if (batch_size > config_.max_messages_per_batch) {
-        batch_size = config_.max_messages_per_batch;
+    // Ticks of messages staged earlier and not yet collected come first
+    for (size_t i = 0; i < batch_size; ++i) {
+        stage(messages[i], message_lengths[i]);
     }
-    
-    // Copy message pointers to GPU
-    cudaMemcpy(gpu_message_buffer_, messages, 
-               batch_size * sizeof(char*), cudaMemcpyHostToDevice);
-    
-    // Launch parsing kernel
-    int block_size = 256;
-    int grid_size = (batch_size + block_size - 1) / block_size;
-    
-    parallel_fix_parser_kernel<<<grid_size, block_size>>>(
-        static_cast<const char**>(gpu_message_buffer_),
-        message_lengths,
-        static_cast<common::Tick*>(gpu_tick_buffer_),
-        batch_size
-    );
-    
-    // Wait for completion
-    cudaDeviceSynchronize();
-    
-    // Copy results back to host
-    ticks.resize(batch_size);
-    cudaMemcpy(ticks.data(), gpu_tick_buffer_,
-               batch_size * sizeof(common::Tick), cudaMemcpyDeviceToHost);
-    
-    return batch_size;
+    submit();
+
+    std::vector<common::CompactTick> compact;
+    collect(compact, true);
+
+    auto& symbols = common::SymbolTable::global();
+    size_t parsed = 0;
+    ticks.clear();
+    ticks.reserve(compact.size());
+    for (const auto& tick : compact) {
+        common::Tick full(symbols.name(tick.instrument_id), tick.price, tick.qty, tick.side, tick.timestamp);
+        full.instrument_id = tick.instrument_id;
+        ticks.push_back(full);
+        parsed += tick.is_valid() ? 1 : 0;
+    }
+    return parsed;
 }
 
 CUDAFixParser::GPUMetrics CUDAFixParser::get_metrics() const {
-    GPUMetrics metrics = {};
-    
-    // Query GPU utilization
-    cudaDeviceProp prop;
-    cudaGetDeviceProperties(&prop, config_.cuda_device_id);
-    
-    size_t free_mem, total_mem;
-    cudaMemGetInfo(&free_mem, &total_mem);
-    
-    metrics.memory_usage_bytes = total_mem - free_mem;
-    metrics.throughput_msgs_per_sec = 100000000.0; // 100M msg/s theoretical
-    metrics.gpu_utilization_percent = 85.0; // Estimated
-    
+    GPUMetrics metrics = metrics_;
+
+    // Per-batch device times overlap across streams, so both figures are conservative
+    double device_seconds = metrics.kernel_execution_time_ms / 1000.0;
+    metrics.throughput_msgs_per_sec = device_seconds > 0.0 ?
+        static_cast<double>(metrics.processed_message_count) / device_seconds : 0.0;
+
+    uint64_t now = common::Tick::current_timestamp_ns();
+    double wall_seconds = first_submit_ns_ > 0 && now > first_submit_ns_ ?
+        static_cast<double>(now - first_submit_ns_) / 1e9 : 0.0;
+    metrics.gpu_utilization_percent = wall_seconds > 0.0 ?
+        std::min(100.0, 100.0 * device_seconds / wall_seconds) : 0.0;
+
     return metrics;
 }
 
 void CUDAFixParser::cleanup_cuda() {
-    if (gpu_memory_pool_) cudaFree(gpu_memory_pool_);
-    if (gpu_message_buffer_) cudaFree(gpu_message_buffer_);
-    if (gpu_tick_buffer_) cudaFree(gpu_tick_buffer_);
-    
-    if (cuda_streams_) {
-        for (size_t i = 0; i < config_.stream_count; i++) {
-            cudaStreamDestroy(cuda_streams_[i]);
-            cudaEventDestroy(cuda_events_[i]);
-        }
-        delete[] cuda_streams_;
-        delete[] cuda_events_;
+    framing_.reset();
+    if (!slots_) {
+        return;
+    }
+    for (size_t i = 0; i < config_.stream_count; i++) {
+        Slot& slot = slots_[i];
+        if (slot.stream) cudaStreamSynchronize(slot.stream);
+        if (slot.host_bytes) cudaFreeHost(slot.host_bytes);
+        if (slot.host_offsets) cudaFreeHost(slot.host_offsets);
+        if (slot.host_ticks) cudaFreeHost(slot.host_ticks);
+        if (slot.host_symbols) cudaFreeHost(slot.host_symbols);
+        if (slot.device_bytes) cudaFree(slot.device_bytes);
+        if (slot.device_offsets) cudaFree(slot.device_offsets);
+        if (slot.device_ticks) cudaFree(slot.device_ticks);
+        if (slot.device_symbols) cudaFree(slot.device_symbols);
+        if (slot.started) cudaEventDestroy(slot.started);
+        if (slot.done) cudaEventDestroy(slot.done);
+        if (slot.stream) cudaStreamDestroy(slot.stream);
     }
+    slots_.reset();
 }
 
 // C interface functions
 extern "C" {
-    void launch_parallel_fix_parser(const char** messages,
-                                   const size_t* lengths,
-                                   void* output_ticks,
-                                   size_t batch_size,
+    void launch_parallel_fix_parser(const char* data,
+                                   const uint32_t* offsets,
+                                   common::CompactTick* output_ticks,
+                                   FieldRef* output_symbols,
+                                   size_t count,
                                    void* stream) {
         
         int block_size = 256;
-        int grid_size = (batch_size + block_size - 1) / block_size;
+        int grid_size = static_cast<int>((count + block_size - 1) / block_size);
         
         parallel_fix_parser_kernel<<<grid_size, block_size, 0, 
                                    static_cast<cudaStream_t>(stream)>>>(
-            messages, lengths, static_cast<common::Tick*>(output_ticks), batch_size
+            data, offsets, output_ticks, output_symbols, count
         );
     }
     
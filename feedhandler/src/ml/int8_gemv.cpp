@@ -0,0 +1,520 @@
+#include "ml/int8_gemv.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace feedhandler {
+namespace ml {
+
+namespace {
+
+constexpr size_t TILE = PackedWeights::ROW_TILE;
+constexpr size_t GROUP = PackedWeights::GROUP;
+constexpr size_t BLOCK = TILE * GROUP;  // Weights per (tile, group)
+constexpr size_t BATCH = 4;             // Vectors sharing each weight load in gemm()
+
+// The GROUP activations of group g as one word, for broadcasting
+inline int32_t load_group(const int8_t* x, size_t g) {
+    int32_t word;
+    std::memcpy(&word, x + g * GROUP, sizeof(word));
+    return word;
+}
+
+void gemv_scalar(const int8_t* w, size_t tiles, size_t groups, const int8_t* x, int32_t* out) {
+    for (size_t t = 0; t < tiles; ++t) {
+        int32_t acc[TILE] = {};
+        for (size_t g = 0; g < groups; ++g) {
+            const int8_t* block = w + (t * groups + g) * BLOCK;
+            const int32_t x0 = x[g * GROUP];
+            const int32_t x1 = x[g * GROUP + 1];
+            const int32_t x2 = x[g * GROUP + 2];
+            const int32_t x3 = x[g * GROUP + 3];
+            for (size_t r = 0; r < TILE; ++r) {
+                const int8_t* row = block + r * GROUP;
+                acc[r] += row[0] * x0 + row[1] * x1 + row[2] * x2 + row[3] * x3;
+            }
+        }
+        std::memcpy(out + t * TILE, acc, sizeof(acc));
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Each group is two column pairs; VPMADDWD multiplies a broadcast pair against 8 rows
+__attribute__((target("avx2")))
+void gemv_avx2(const int16_t* w, size_t tiles, size_t groups, const int8_t* x, int32_t* out) {
+    for (size_t t = 0; t < tiles; ++t) {
+        __m256i lo = _mm256_setzero_si256();  // Rows 0-7 of the tile
+        __m256i hi = _mm256_setzero_si256();  // Rows 8-15
+        const int16_t* block = w + t * groups * BLOCK;
+        for (size_t g = 0; g < groups; ++g, block += BLOCK) {
+            __m128i x16 = _mm_cvtepi8_epi16(_mm_cvtsi32_si128(load_group(x, g)));
+            __m256i pair0 = _mm256_broadcastd_epi32(x16);
+            __m256i pair1 = _mm256_broadcastd_epi32(_mm_srli_si128(x16, 4));
+            const __m256i* b = reinterpret_cast<const __m256i*>(block);
+            lo = _mm256_add_epi32(lo, _mm256_madd_epi16(pair0, _mm256_load_si256(b)));
+            hi = _mm256_add_epi32(hi, _mm256_madd_epi16(pair0, _mm256_load_si256(b + 1)));
+            lo = _mm256_add_epi32(lo, _mm256_madd_epi16(pair1, _mm256_load_si256(b + 2)));
+            hi = _mm256_add_epi32(hi, _mm256_madd_epi16(pair1, _mm256_load_si256(b + 3)));
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out + t * TILE), lo);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out + t * TILE + 8), hi);
+    }
+}
+
+// gemv_avx2 over BATCH vectors at once: each weight block is loaded once
+// and multiplied against all of them. count is a multiple of BATCH.
+__attribute__((target("avx2")))
+void gemm_avx2(const int16_t* w, size_t tiles, size_t groups, const int8_t* x, size_t x_stride,
+               size_t count, int32_t* out, size_t out_stride) {
+    for (size_t t = 0; t < tiles; ++t) {
+        for (size_t n = 0; n < count; n += BATCH) {
+            __m256i lo[BATCH];
+            __m256i hi[BATCH];
+#pragma GCC unroll 4
+            for (size_t k = 0; k < BATCH; ++k) {
+                lo[k] = _mm256_setzero_si256();
+                hi[k] = _mm256_setzero_si256();
+            }
+            const int16_t* block = w + t * groups * BLOCK;
+            for (size_t g = 0; g < groups; ++g, block += BLOCK) {
+                const __m256i* b = reinterpret_cast<const __m256i*>(block);
+                __m256i w0 = _mm256_load_si256(b);
+                __m256i w1 = _mm256_load_si256(b + 1);
+                __m256i w2 = _mm256_load_si256(b + 2);
+                __m256i w3 = _mm256_load_si256(b + 3);
+#pragma GCC unroll 4
+                for (size_t k = 0; k < BATCH; ++k) {
+                    __m128i x16 = _mm_cvtepi8_epi16(_mm_cvtsi32_si128(load_group(x + (n + k) * x_stride, g)));
+                    __m256i pair0 = _mm256_broadcastd_epi32(x16);
+                    __m256i pair1 = _mm256_broadcastd_epi32(_mm_srli_si128(x16, 4));
+                    lo[k] = _mm256_add_epi32(lo[k], _mm256_madd_epi16(pair0, w0));
+                    hi[k] = _mm256_add_epi32(hi[k], _mm256_madd_epi16(pair0, w1));
+                    lo[k] = _mm256_add_epi32(lo[k], _mm256_madd_epi16(pair1, w2));
+                    hi[k] = _mm256_add_epi32(hi[k], _mm256_madd_epi16(pair1, w3));
+                }
+            }
+#pragma GCC unroll 4
+            for (size_t k = 0; k < BATCH; ++k) {
+                int32_t* row = out + (n + k) * out_stride + t * TILE;
+                _mm256_store_si256(reinterpret_cast<__m256i*>(row), lo[k]);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(row + 8), hi[k]);
+            }
+        }
+    }
+}
+
+// Operands are (x + 128) as u8 and w as s8, so each row sum carries an extra 128 * sum(w)
+__attribute__((target("avx512f,avx512vnni")))
+void gemv_avx512_vnni(const int8_t* w, const int32_t* corrections, size_t tiles, size_t groups,
+                      const int8_t* x, int32_t* out) {
+    const int32_t bias = static_cast<int32_t>(0x80808080u);
+    for (size_t t = 0; t < tiles; ++t) {
+        // Two accumulators hide the VPDPBUSD latency
+        __m512i even = _mm512_setzero_si512();
+        __m512i odd = _mm512_setzero_si512();
+        const int8_t* block = w + t * groups * BLOCK;
+        size_t g = 0;
+        for (; g + 1 < groups; g += 2) {
+            even = _mm512_dpbusd_epi32(even, _mm512_set1_epi32(load_group(x, g) ^ bias),
+                                       _mm512_load_si512(block + g * BLOCK));
+            odd = _mm512_dpbusd_epi32(odd, _mm512_set1_epi32(load_group(x, g + 1) ^ bias),
+                                      _mm512_load_si512(block + (g + 1) * BLOCK));
+        }
+        if (g < groups) {
+            even = _mm512_dpbusd_epi32(even, _mm512_set1_epi32(load_group(x, g) ^ bias),
+                                       _mm512_load_si512(block + g * BLOCK));
+        }
+        _mm512_store_si512(out + t * TILE, _mm512_sub_epi32(_mm512_add_epi32(even, odd),
+                                                             _mm512_load_si512(corrections + t * TILE)));
+    }
+}
+
+// BATCH independent accumulators also cover the VPDPBUSD latency
+__attribute__((target("avx512f,avx512vnni")))
+void gemm_avx512_vnni(const int8_t* w, const int32_t* corrections, size_t tiles, size_t groups,
+                      const int8_t* x, size_t x_stride, size_t count, int32_t* out, size_t out_stride) {
+    const int32_t bias = static_cast<int32_t>(0x80808080u);
+    for (size_t t = 0; t < tiles; ++t) {
+        const __m512i correction = _mm512_load_si512(corrections + t * TILE);
+        for (size_t n = 0; n < count; n += BATCH) {
+            __m512i acc[BATCH];
+#pragma GCC unroll 4
+            for (size_t k = 0; k < BATCH; ++k) {
+                acc[k] = _mm512_setzero_si512();
+            }
+            const int8_t* block = w + t * groups * BLOCK;
+            for (size_t g = 0; g < groups; ++g, block += BLOCK) {
+                __m512i weights = _mm512_load_si512(block);
+#pragma GCC unroll 4
+                for (size_t k = 0; k < BATCH; ++k) {
+                    acc[k] = _mm512_dpbusd_epi32(acc[k], _mm512_set1_epi32(load_group(x + (n + k) * x_stride, g) ^ bias),
+                                                 weights);
+                }
+            }
+#pragma GCC unroll 4
+            for (size_t k = 0; k < BATCH; ++k) {
+                _mm512_store_si512(out + (n + k) * out_stride + t * TILE, _mm512_sub_epi32(acc[k], correction));
+            }
+        }
+    }
+}
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+// Four rows x GROUP columns per call: lane i gets the dot product of row i with x
+inline int32x4_t dot4_neon(int32x4_t acc, int8x16_t w, int8x16_t x) {
+#if defined(__ARM_FEATURE_DOTPROD)
+    return vdotq_s32(acc, w, x);
+#else
+    int32x4_t lo = vpaddlq_s16(vmull_s8(vget_low_s8(w), vget_low_s8(x)));
+    int32x4_t hi = vpaddlq_s16(vmull_high_s8(w, x));
+    return vaddq_s32(acc, vpaddq_s32(lo, hi));
+#endif
+}
+
+void gemv_neon(const int8_t* w, size_t tiles, size_t groups, const int8_t* x, int32_t* out) {
+    for (size_t t = 0; t < tiles; ++t) {
+        int32x4_t acc0 = vdupq_n_s32(0);
+        int32x4_t acc1 = vdupq_n_s32(0);
+        int32x4_t acc2 = vdupq_n_s32(0);
+        int32x4_t acc3 = vdupq_n_s32(0);
+        const int8_t* block = w + t * groups * BLOCK;
+        for (size_t g = 0; g < groups; ++g, block += BLOCK) {
+            int8x16_t xv = vreinterpretq_s8_s32(vdupq_n_s32(load_group(x, g)));
+            acc0 = dot4_neon(acc0, vld1q_s8(block), xv);
+            acc1 = dot4_neon(acc1, vld1q_s8(block + 16), xv);
+            acc2 = dot4_neon(acc2, vld1q_s8(block + 32), xv);
+            acc3 = dot4_neon(acc3, vld1q_s8(block + 48), xv);
+        }
+        vst1q_s32(out + t * TILE, acc0);
+        vst1q_s32(out + t * TILE + 4, acc1);
+        vst1q_s32(out + t * TILE + 8, acc2);
+        vst1q_s32(out + t * TILE + 12, acc3);
+    }
+}
+
+void gemm_neon(const int8_t* w, size_t tiles, size_t groups, const int8_t* x, size_t x_stride,
+               size_t count, int32_t* out, size_t out_stride) {
+    for (size_t t = 0; t < tiles; ++t) {
+        for (size_t n = 0; n < count; n += BATCH) {
+            int32x4_t acc[BATCH][4];
+#pragma GCC unroll 4
+            for (size_t k = 0; k < BATCH; ++k) {
+                for (size_t q = 0; q < 4; ++q) {
+                    acc[k][q] = vdupq_n_s32(0);
+                }
+            }
+            const int8_t* block = w + t * groups * BLOCK;
+            for (size_t g = 0; g < groups; ++g, block += BLOCK) {
+                int8x16_t w0 = vld1q_s8(block);
+                int8x16_t w1 = vld1q_s8(block + 16);
+                int8x16_t w2 = vld1q_s8(block + 32);
+                int8x16_t w3 = vld1q_s8(block + 48);
+#pragma GCC unroll 4
+                for (size_t k = 0; k < BATCH; ++k) {
+                    int8x16_t xv = vreinterpretq_s8_s32(vdupq_n_s32(load_group(x + (n + k) * x_stride, g)));
+                    acc[k][0] = dot4_neon(acc[k][0], w0, xv);
+                    acc[k][1] = dot4_neon(acc[k][1], w1, xv);
+                    acc[k][2] = dot4_neon(acc[k][2], w2, xv);
+                    acc[k][3] = dot4_neon(acc[k][3], w3, xv);
+                }
+            }
+#pragma GCC unroll 4
+            for (size_t k = 0; k < BATCH; ++k) {
+                for (size_t q = 0; q < 4; ++q) {
+                    vst1q_s32(out + (n + k) * out_stride + t * TILE + q * 4, acc[k][q]);
+                }
+            }
+        }
+    }
+}
+
+#endif
+
+// Elementwise passes around the GEMV. Scalar versions keep four
+// independent max chains so the loop is not bound by MAXSD latency.
+
+double max_abs_scalar(const double* x, size_t count) {
+    double m[4] = {};
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (size_t k = 0; k < 4; ++k) {
+            m[k] = std::max(m[k], std::fabs(x[i + k]));
+        }
+    }
+    for (; i < count; ++i) {
+        m[0] = std::max(m[0], std::fabs(x[i]));
+    }
+    return std::max(std::max(m[0], m[1]), std::max(m[2], m[3]));
+}
+
+// out[i] = clamp(round_half_even(x[i] * inverse), -127, 127)
+void quantize_scalar(const double* x, size_t count, double inverse, int8_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<int8_t>(std::nearbyint(std::clamp(x[i] * inverse, -127.0, 127.0)));
+    }
+}
+
+// out[i] = max(0, acc[i] * scale + bias[i]); returns max out[i]
+double dequantize_bias_relu_scalar(const int32_t* acc, size_t count, double scale, const double* bias, double* out) {
+    double m[4] = {};
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (size_t k = 0; k < 4; ++k) {
+            out[i + k] = std::max(0.0, acc[i + k] * scale + bias[i + k]);
+            m[k] = std::max(m[k], out[i + k]);
+        }
+    }
+    for (; i < count; ++i) {
+        out[i] = std::max(0.0, acc[i] * scale + bias[i]);
+        m[0] = std::max(m[0], out[i]);
+    }
+    return std::max(std::max(m[0], m[1]), std::max(m[2], m[3]));
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Tails stay inline: calling the SSE-encoded scalar passes with dirty
+// upper YMM state costs an AVX-SSE transition per call
+
+__attribute__((target("avx2")))
+double hmax_avx2(__m256d v) {
+    __m128d m = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return std::max(_mm_cvtsd_f64(m), _mm_cvtsd_f64(_mm_unpackhi_pd(m, m)));
+}
+
+__attribute__((target("avx2")))
+double max_abs_avx2(const double* x, size_t count) {
+    const __m256d magnitude = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    __m256d m0 = _mm256_setzero_pd();
+    __m256d m1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        m0 = _mm256_max_pd(m0, _mm256_and_pd(_mm256_loadu_pd(x + i), magnitude));
+        m1 = _mm256_max_pd(m1, _mm256_and_pd(_mm256_loadu_pd(x + i + 4), magnitude));
+    }
+    double tail = 0.0;
+    for (; i < count; ++i) {
+        tail = std::max(tail, std::fabs(x[i]));
+    }
+    return std::max(hmax_avx2(_mm256_max_pd(m0, m1)), tail);
+}
+
+__attribute__((target("avx2")))
+void quantize_avx2(const double* x, size_t count, double inverse, int8_t* out) {
+    const __m256d scale = _mm256_set1_pd(inverse);
+    const __m256d low = _mm256_set1_pd(-127.0);
+    const __m256d high = _mm256_set1_pd(127.0);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d v = _mm256_min_pd(_mm256_max_pd(_mm256_mul_pd(_mm256_loadu_pd(x + i), scale), low), high);
+        __m128i q = _mm256_cvtpd_epi32(v);  // Rounds to nearest even
+        q = _mm_packs_epi16(_mm_packs_epi32(q, q), q);
+        int32_t word = _mm_cvtsi128_si32(q);
+        std::memcpy(out + i, &word, sizeof(word));
+    }
+    for (; i < count; ++i) {
+        out[i] = static_cast<int8_t>(std::nearbyint(std::clamp(x[i] * inverse, -127.0, 127.0)));
+    }
+}
+
+// Separate multiply and add (no FMA) so results match the scalar pass bit for bit
+__attribute__((target("avx2")))
+double dequantize_bias_relu_avx2(const int32_t* acc, size_t count, double scale, const double* bias, double* out) {
+    const __m256d factor = _mm256_set1_pd(scale);
+    __m256d m = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d v = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i)));
+        v = _mm256_max_pd(_mm256_add_pd(_mm256_mul_pd(v, factor), _mm256_loadu_pd(bias + i)), _mm256_setzero_pd());
+        _mm256_storeu_pd(out + i, v);
+        m = _mm256_max_pd(m, v);
+    }
+    double tail = 0.0;
+    for (; i < count; ++i) {
+        out[i] = std::max(0.0, acc[i] * scale + bias[i]);
+        tail = std::max(tail, out[i]);
+    }
+    return std::max(hmax_avx2(m), tail);
+}
+
+#endif
+
+struct ActivationKernels {
+    double (*max_abs)(const double*, size_t);
+    void (*quantize)(const double*, size_t, double, int8_t*);
+    double (*dequantize_bias_relu)(const int32_t*, size_t, double, const double*, double*);
+};
+
+const ActivationKernels& activation_kernels() {
+    static const ActivationKernels kernels = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init(); // May run before libgcc's constructor
+        if (__builtin_cpu_supports("avx2")) {
+            return ActivationKernels{max_abs_avx2, quantize_avx2, dequantize_bias_relu_avx2};
+        }
+#endif
+        return ActivationKernels{max_abs_scalar, quantize_scalar, dequantize_bias_relu_scalar};
+    }();
+    return kernels;
+}
+
+} // namespace
+
+bool gemv_kernel_supported(GemvKernel kernel) {
+    switch (kernel) {
+        case GemvKernel::SCALAR:
+            return true;
+#if defined(__x86_64__) || defined(__i386__)
+        case GemvKernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case GemvKernel::AVX512_VNNI:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vnni");
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        case GemvKernel::NEON:
+            return true; // Mandatory on ARMv8-A; SDOT is chosen at compile time
+#endif
+        default:
+            return false;
+    }
+}
+
+GemvKernel detect_gemv_kernel() {
+    static const GemvKernel detected = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init(); // May run before libgcc's constructor
+#endif
+        for (GemvKernel kernel : {GemvKernel::NEON, GemvKernel::AVX512_VNNI, GemvKernel::AVX2}) {
+            if (gemv_kernel_supported(kernel)) {
+                return kernel;
+            }
+        }
+        return GemvKernel::SCALAR;
+    }();
+    return detected;
+}
+
+const char* gemv_kernel_name(GemvKernel kernel) {
+    switch (kernel) {
+        case GemvKernel::SCALAR:
+            return "scalar";
+        case GemvKernel::AVX2:
+            return "avx2";
+        case GemvKernel::AVX512_VNNI:
+            return "avx512_vnni";
+        case GemvKernel::NEON:
+            return "neon";
+    }
+    return "unknown";
+}
+
+PackedWeights::PackedWeights(const int8_t* weights, size_t rows, size_t cols, GemvKernel kernel)
+    : kernel_(gemv_kernel_supported(kernel) ? kernel : GemvKernel::SCALAR)
+    , rows_(rows)
+    , cols_(cols)
+    , tiles_((rows + TILE - 1) / TILE)
+    , groups_((cols + GROUP - 1) / GROUP) {
+    if (kernel_ == GemvKernel::AVX2) {
+        // Per (tile, group): column pair 0 for all rows, then column pair 1
+        weights16_ = AlignedArray<int16_t>(tiles_ * groups_ * BLOCK);
+        for (size_t r = 0; r < rows_; ++r) {
+            for (size_t c = 0; c < cols_; ++c) {
+                size_t block = (r / TILE) * groups_ + c / GROUP;
+                size_t pair = (c % GROUP) / 2;
+                weights16_[block * BLOCK + (pair * TILE + r % TILE) * 2 + c % 2] = weights[r * cols_ + c];
+            }
+        }
+        return;
+    }
+
+    weights8_ = AlignedArray<int8_t>(tiles_ * groups_ * BLOCK);
+    for (size_t r = 0; r < rows_; ++r) {
+        for (size_t c = 0; c < cols_; ++c) {
+            size_t block = (r / TILE) * groups_ + c / GROUP;
+            weights8_[block * BLOCK + (r % TILE) * GROUP + c % GROUP] = weights[r * cols_ + c];
+        }
+    }
+    if (kernel_ == GemvKernel::AVX512_VNNI) {
+        corrections_ = AlignedArray<int32_t>(padded_rows());
+        for (size_t r = 0; r < rows_; ++r) {
+            int32_t sum = 0;
+            for (size_t c = 0; c < cols_; ++c) {
+                sum += weights[r * cols_ + c];
+            }
+            corrections_[r] = 128 * sum;
+        }
+    }
+}
+
+void PackedWeights::gemv(const int8_t* x, int32_t* out) const {
+    switch (kernel_) {
+#if defined(__x86_64__) || defined(__i386__)
+        case GemvKernel::AVX2:
+            gemv_avx2(weights16_.data(), tiles_, groups_, x, out);
+            return;
+        case GemvKernel::AVX512_VNNI:
+            gemv_avx512_vnni(weights8_.data(), corrections_.data(), tiles_, groups_, x, out);
+            return;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        case GemvKernel::NEON:
+            gemv_neon(weights8_.data(), tiles_, groups_, x, out);
+            return;
+#endif
+        default:
+            gemv_scalar(weights8_.data(), tiles_, groups_, x, out);
+            return;
+    }
+}
+
+void PackedWeights::gemm(const int8_t* x, size_t count, size_t x_stride, int32_t* out, size_t out_stride) const {
+    size_t blocked = kernel_ == GemvKernel::SCALAR ? 0 : count / BATCH * BATCH;
+    if (blocked > 0) {
+        switch (kernel_) {
+#if defined(__x86_64__) || defined(__i386__)
+            case GemvKernel::AVX2:
+                gemm_avx2(weights16_.data(), tiles_, groups_, x, x_stride, blocked, out, out_stride);
+                break;
+            case GemvKernel::AVX512_VNNI:
+                gemm_avx512_vnni(weights8_.data(), corrections_.data(), tiles_, groups_,
+                                 x, x_stride, blocked, out, out_stride);
+                break;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+            case GemvKernel::NEON:
+                gemm_neon(weights8_.data(), tiles_, groups_, x, x_stride, blocked, out, out_stride);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+    // Leftover vectors (and the scalar kernel, which gains nothing from blocking)
+    for (size_t n = blocked; n < count; ++n) {
+        gemv(x + n * x_stride, out + n * out_stride);
+    }
+}
+
+double quantize_activations(const double* x, size_t count, int8_t* out) {
+    return quantize_activations(x, count, activation_kernels().max_abs(x, count), out);
+}
+
+double quantize_activations(const double* x, size_t count, double max_abs, int8_t* out) {
+    double scale = max_abs > 0.0 ? max_abs / 127.0 : 1.0;
+    activation_kernels().quantize(x, count, 1.0 / scale, out);
+    std::fill(out + count, out + PackedWeights::padded(count), int8_t{0});
+    return scale;
+}
+
+double dequantize_bias_relu(const int32_t* acc, size_t count, double scale, const double* bias, double* out) {
+    return activation_kernels().dequantize_bias_relu(acc, count, scale, bias, out);
+}
+
+} // namespace ml
+} // namespace feedhandler
@@ -5,18 +5,20 @@
 #include <random>
 #include <fstream>
 #include <chrono>
-
-#ifdef __ARM_NEON
-#include <arm_neon.h>
-#else
-#include <immintrin.h>
-#endif
+#include <utility>
 
 namespace feedhandler {
 namespace ml {
 
+NeuralPredictor::NeuralPredictor()
+    : NeuralPredictor(Config()) {}
+
 NeuralPredictor::NeuralPredictor(const Config& config) 
-    : config_(config), metrics_{} {
+    : config_(config), gemv_kernel_(detect_gemv_kernel()), metrics_{} {
+    
+    // Inference reads the tick features after the indicators
+    config_.input_features = std::max(config_.input_features,
+                                      StreamingFeatures::FEATURE_COUNT + TICK_FEATURES);
     
     // Initialize quantized neural network weights
     std::random_device rd;
@@ -62,336 +64,244 @@ NeuralPredictor::NeuralPredictor(const Config& config)
         bias_vectors_.back()[i] = weight_dist(gen);
     }
     
-    // Initialize technical indicator arrays
-    sma_values_.fill(0.0);
-    ema_values_.fill(0.0);
-    rsi_values_.fill(50.0);
-    bollinger_bands_.fill(0.0);
+    pack_layers();
 }
 
-NeuralPredictor::Prediction NeuralPredictor::predict(
-    const std::vector<common::Tick>& recent_ticks,
-    const common::Tick& current_tick) {
-    
-    auto start_time = std::chrono::high_resolution_clock::now();
-    
-    // Extract features from tick data
-    std::vector<double> features = extract_features(recent_ticks);
-    
-    // Add current tick features
-    features.push_back(static_cast<double>(current_tick.price) / 10000.0);
-    features.push_back(static_cast<double>(current_tick.qty));
-    features.push_back(current_tick.side == 'B' ? 1.0 : -1.0);
-    
-    // Ensure feature vector is correct size
-    features.resize(config_.input_features, 0.0);
-    
-    // Forward pass through neural network
-    std::vector<double> current_layer = features;
-    std::vector<double> next_layer;
+void NeuralPredictor::set_gemv_kernel(GemvKernel kernel) {
+    gemv_kernel_ = gemv_kernel_supported(kernel) ? kernel : GemvKernel::SCALAR;
+    pack_layers();
+}
+
+void NeuralPredictor::pack_layers() {
+    packed_weights_.clear();
+    dequantized_weights_.clear();
     
+    size_t inputs = config_.input_features;
+    size_t widest = inputs;
     for (size_t layer = 0; layer < quantized_weights_.size(); ++layer) {
-        size_t input_size = current_layer.size();
-        size_t output_size = bias_vectors_[layer].size();
-        
-        next_layer.resize(output_size);
-        
-        // SIMD-optimized matrix multiplication with quantized weights
-        simd_matrix_multiply(current_layer, {quantized_weights_[layer]}, next_layer);
-        
-        // Add bias and apply activation
-        for (size_t i = 0; i < output_size; ++i) {
-            next_layer[i] += bias_vectors_[layer][i];
-            
-            if (layer < quantized_weights_.size() - 1) {
-                next_layer[i] = relu_activation(next_layer[i]);
-            } else {
-                // Output layer uses different activations
-                if (i == 0) { // Price direction
-                    next_layer[i] = std::tanh(next_layer[i]);
-                } else { // Confidence and volatility
-                    next_layer[i] = sigmoid_activation(next_layer[i]);
-                }
+        size_t outputs = bias_vectors_[layer].size();
+        if (config_.use_quantization) {
+            packed_weights_.emplace_back(quantized_weights_[layer].data(), outputs, inputs, gemv_kernel_);
+        } else {
+            std::vector<double> weights(quantized_weights_[layer].size());
+            for (size_t i = 0; i < weights.size(); ++i) {
+                weights[i] = static_cast<double>(quantized_weights_[layer][i]) / 127.0;
             }
+            dequantized_weights_.push_back(std::move(weights));
         }
-        
-        current_layer = std::move(next_layer);
+        widest = std::max(widest, outputs);
+        inputs = outputs;
     }
     
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto inference_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        end_time - start_time).count();
-    
-    // Create prediction result
-    Prediction prediction;
-    prediction.price_direction = current_layer[0];
-    prediction.confidence = current_layer[1];
-    prediction.volatility_forecast = current_layer[2];
-    prediction.anomaly_detected = detect_price_anomaly(current_tick, recent_ticks);
-    prediction.prediction_time_ns = inference_time;
-    
-    // Update metrics
-    metrics_.predictions_made++;
-    metrics_.inference_time_ns = (metrics_.inference_time_ns * 0.9) + (inference_time * 0.1);
-    
-    return prediction;
+    // Row strides: whole cache lines, and the padding the GEMM kernels read
+    auto round_up = [](size_t n, size_t multiple) { return (n + multiple - 1) / multiple * multiple; };
+    activation_stride_ = round_up(widest, 8);
+    quantized_stride_ = PackedWeights::padded(widest);
+    accumulator_stride_ = round_up(widest, PackedWeights::ROW_TILE);
+    // A loaded model may take fewer inputs than write_features() produces
+    feature_stride_ = round_up(std::max(config_.input_features, StreamingFeatures::FEATURE_COUNT + TICK_FEATURES), 8);
+    
+    activations_[0] = AlignedArray<double>(MAX_BATCH * activation_stride_);
+    activations_[1] = AlignedArray<double>(MAX_BATCH * activation_stride_);
+    quantized_input_ = AlignedArray<int8_t>(MAX_BATCH * quantized_stride_);
+    accumulators_ = AlignedArray<int32_t>(MAX_BATCH * accumulator_stride_);
+    feature_buffer_ = AlignedArray<double>(MAX_BATCH * feature_stride_);
 }
 
-std::vector<double> NeuralPredictor::extract_features(
-    const std::vector<common::Tick>& ticks) {
-    
-    std::vector<double> features;
-    features.reserve(config_.input_features);
+NeuralPredictor::Prediction NeuralPredictor::predict(const common::Tick& current_tick) {
+    auto start_time = std::chrono::high_resolution_clock::now();
     
-    if (ticks.empty()) {
-        features.resize(config_.input_features, 0.0);
-        return features;
+    static const StreamingFeatures empty_state;
+    StreamingFeatures* state = state_for(current_tick.instrument_id);
+    const StreamingFeatures& history = state ? *state : empty_state;
+    
+    // Features describe the history before this tick, as in the window overload
+    write_features(history, current_tick.price, current_tick.qty, current_tick.side, feature_buffer_.data());
+    Prediction prediction{};
+    infer(1, &prediction);
+    prediction.anomaly_detected = history.is_anomaly(current_tick.price);
+    if (state) {
+        state->update(current_tick);
     }
     
-    // Calculate technical indicators
-    std::vector<size_t> sma_periods = {5, 10, 20, 50, 100, 200};
-    for (size_t period : sma_periods) {
-        double sma = calculate_sma(ticks, period);
-        features.push_back(sma);
-    }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    prediction.prediction_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end_time - start_time).count();
     
-    std::vector<size_t> ema_periods = {5, 10, 20, 50};
-    for (size_t period : ema_periods) {
-        double ema = calculate_ema(ticks, period);
-        features.push_back(ema);
-    }
+    record_predictions(1, prediction.prediction_time_ns);
+    return prediction;
+}
+
+void NeuralPredictor::predict_batch(std::span<const common::CompactTick> ticks, std::vector<Prediction>& out) {
+    auto start_time = std::chrono::high_resolution_clock::now();
     
-    // RSI indicators
-    std::vector<size_t> rsi_periods = {14, 21, 30};
-    for (size_t period : rsi_periods) {
-        double rsi = calculate_rsi(ticks, period);
-        features.push_back(rsi / 100.0); // Normalize to 0-1
+    static const StreamingFeatures empty_state;
+    size_t first = out.size();
+    out.resize(first + ticks.size());
+    
+    for (size_t begin = 0; begin < ticks.size(); begin += MAX_BATCH) {
+        size_t count = std::min(MAX_BATCH, ticks.size() - begin);
+        Prediction* predictions = out.data() + first + begin;
+        for (size_t row = 0; row < count; ++row) {
+            const common::CompactTick& tick = ticks[begin + row];
+            StreamingFeatures* state = state_for(tick.instrument_id);
+            const StreamingFeatures& history = state ? *state : empty_state;
+            
+            // Row written before the update, so a repeated instrument sees its earlier ticks
+            write_features(history, tick.price, tick.qty, tick.side, feature_buffer_.data() + row * feature_stride_);
+            predictions[row] = Prediction{};
+            predictions[row].anomaly_detected = history.is_anomaly(tick.price);
+            if (state) {
+                state->update(tick);
+            }
+        }
+        infer(count, predictions);
     }
     
-    // Bollinger Bands
-    auto bb = calculate_bollinger_bands(ticks);
-    features.insert(features.end(), bb.begin(), bb.end());
-    
-    // Price momentum features
-    if (ticks.size() >= 10) {
-        double current_price = static_cast<double>(ticks.back().price) / 10000.0;
-        double price_10_ago = static_cast<double>(ticks[ticks.size()-10].price) / 10000.0;
-        features.push_back((current_price - price_10_ago) / price_10_ago);
-    } else {
-        features.push_back(0.0);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    uint64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+    for (size_t i = first; i < out.size(); ++i) {
+        out[i].prediction_time_ns = elapsed_ns;
     }
-    
-    // Volume features
-    if (ticks.size() >= 5) {
-        double avg_volume = 0.0;
-        for (size_t i = ticks.size() - 5; i < ticks.size(); ++i) {
-            avg_volume += ticks[i].qty;
-        }
-        avg_volume /= 5.0;
-        features.push_back(avg_volume / 1000.0); // Normalize
-    } else {
-        features.push_back(0.0);
+    if (!ticks.empty()) {
+        record_predictions(ticks.size(), elapsed_ns);
     }
-    
-    // Volatility features
-    if (ticks.size() >= 20) {
-        std::vector<double> returns;
-        for (size_t i = ticks.size() - 19; i < ticks.size(); ++i) {
-            double prev_price = static_cast<double>(ticks[i-1].price) / 10000.0;
-            double curr_price = static_cast<double>(ticks[i].price) / 10000.0;
-            returns.push_back(std::log(curr_price / prev_price));
-        }
-        
-        double mean_return = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-        double variance = 0.0;
-        for (double ret : returns) {
-            variance += (ret - mean_return) * (ret - mean_return);
-        }
-        variance /= returns.size();
-        features.push_back(std::sqrt(variance) * 100.0); // Volatility in %
-    } else {
-        features.push_back(0.0);
+}
+
+void NeuralPredictor::observe(const common::Tick& tick) {
+    if (StreamingFeatures* state = state_for(tick.instrument_id)) {
+        state->update(tick);
     }
-    
-    // Ensure we have exactly the right number of features
-    features.resize(config_.input_features, 0.0);
-    
-    return features;
 }
 
-void NeuralPredictor::simd_matrix_multiply(const std::vector<double>& input,
-                                          const std::vector<std::vector<int8_t>>& weights,
-                                          std::vector<double>& output) {
-    
-    const auto& weight_matrix = weights[0];
-    size_t input_size = input.size();
-    size_t output_size = output.size();
-    
-    // SIMD-optimized matrix multiplication
-#ifdef __ARM_NEON
-    // ARM NEON implementation
-    for (size_t out_idx = 0; out_idx < output_size; ++out_idx) {
-        float32x4_t sum_vec = vdupq_n_f32(0.0f);
-        
-        size_t simd_end = (input_size / 4) * 4;
-        for (size_t in_idx = 0; in_idx < simd_end; in_idx += 4) {
-            // Load input values
-            float32x4_t input_vec = vld1q_f32(reinterpret_cast<const float*>(&input[in_idx]));
-            
-            // Load and convert quantized weights
-            int8x8_t weight_i8 = vld1_s8(&weight_matrix[out_idx * input_size + in_idx]);
-            int16x4_t weight_i16 = vget_low_s16(vmovl_s8(weight_i8));
-            float32x4_t weight_vec = vcvtq_f32_s32(vmovl_s16(weight_i16));
-            
-            // Scale quantized weights back to float range
-            weight_vec = vmulq_n_f32(weight_vec, 1.0f / 127.0f);
-            
-            // Multiply and accumulate
-            sum_vec = vmlaq_f32(sum_vec, input_vec, weight_vec);
-        }
-        
-        // Sum the vector elements
-        float sum = vaddvq_f32(sum_vec);
-        
-        // Handle remaining elements
-        for (size_t in_idx = simd_end; in_idx < input_size; ++in_idx) {
-            int8_t quantized_weight = weight_matrix[out_idx * input_size + in_idx];
-            double weight = static_cast<double>(quantized_weight) / 127.0;
-            sum += input[in_idx] * weight;
-        }
-        
-        output[out_idx] = sum;
+StreamingFeatures* NeuralPredictor::state_for(common::InstrumentId id) {
+    if (id == common::INVALID_INSTRUMENT) {
+        return nullptr;
     }
-#else
-    // x86 AVX implementation
-    for (size_t out_idx = 0; out_idx < output_size; ++out_idx) {
-        __m256d sum_vec = _mm256_setzero_pd();
-        
-        size_t simd_end = (input_size / 4) * 4;
-        for (size_t in_idx = 0; in_idx < simd_end; in_idx += 4) {
-            // Load input values
-            __m256d input_vec = _mm256_loadu_pd(&input[in_idx]);
-            
-            // Load and convert quantized weights
-            __m128i weight_i8 = _mm_loadl_epi64(
-                reinterpret_cast<const __m128i*>(&weight_matrix[out_idx * input_size + in_idx]));
-            __m128i weight_i32 = _mm_cvtepi8_epi32(weight_i8);
-            __m256d weight_vec = _mm256_cvtepi32_pd(weight_i32);
-            
-            // Scale quantized weights back to double range
-            weight_vec = _mm256_mul_pd(weight_vec, _mm256_set1_pd(1.0 / 127.0));
-            
-            // Multiply and accumulate
-            sum_vec = _mm256_fmadd_pd(input_vec, weight_vec, sum_vec);
-        }
-        
-        // Sum the vector elements
-        double sum_array[4];
-        _mm256_storeu_pd(sum_array, sum_vec);
-        double sum = sum_array[0] + sum_array[1] + sum_array[2] + sum_array[3];
-        
-        // Handle remaining elements
-        for (size_t in_idx = simd_end; in_idx < input_size; ++in_idx) {
-            int8_t quantized_weight = weight_matrix[out_idx * input_size + in_idx];
-            double weight = static_cast<double>(quantized_weight) / 127.0;
-            sum += input[in_idx] * weight;
-        }
-        
-        output[out_idx] = sum;
+    if (id >= feature_states_.size()) {
+        feature_states_.resize(static_cast<size_t>(id) + 1);
     }
-#endif
+    return &feature_states_[id];
 }
 
-double NeuralPredictor::calculate_sma(const std::vector<common::Tick>& ticks, size_t period) {
-    if (ticks.size() < period) return 0.0;
-    
-    double sum = 0.0;
-    for (size_t i = ticks.size() - period; i < ticks.size(); ++i) {
-        sum += static_cast<double>(ticks[i].price) / 10000.0;
-    }
-    return sum / period;
+void NeuralPredictor::record_predictions(size_t count, uint64_t elapsed_ns) {
+    double per_prediction_ns = static_cast<double>(elapsed_ns) / static_cast<double>(count);
+    metrics_.predictions_made += count;
+    metrics_.inference_time_ns = (metrics_.inference_time_ns * 0.9) + (per_prediction_ns * 0.1);
 }
 
-double NeuralPredictor::calculate_ema(const std::vector<common::Tick>& ticks, size_t period) {
-    if (ticks.empty()) return 0.0;
+NeuralPredictor::Prediction NeuralPredictor::predict(
+    const std::vector<common::Tick>& recent_ticks,
+    const common::Tick& current_tick) {
     
-    double alpha = 2.0 / (period + 1.0);
-    double ema = static_cast<double>(ticks[0].price) / 10000.0;
+    auto start_time = std::chrono::high_resolution_clock::now();
     
-    for (size_t i = 1; i < ticks.size(); ++i) {
-        double price = static_cast<double>(ticks[i].price) / 10000.0;
-        ema = alpha * price + (1.0 - alpha) * ema;
+    // Replays the window through a scratch state: O(n), use predict(tick) on live feeds
+    StreamingFeatures history;
+    for (const auto& tick : recent_ticks) {
+        history.update(tick);
     }
+    write_features(history, current_tick.price, current_tick.qty, current_tick.side, feature_buffer_.data());
+    Prediction prediction{};
+    infer(1, &prediction);
+    prediction.anomaly_detected = history.is_anomaly(current_tick.price);
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    prediction.prediction_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end_time - start_time).count();
     
-    return ema;
+    record_predictions(1, prediction.prediction_time_ns);
+    return prediction;
 }
 
-double NeuralPredictor::calculate_rsi(const std::vector<common::Tick>& ticks, size_t period) {
-    if (ticks.size() < period + 1) return 50.0;
-    
-    double gain_sum = 0.0;
-    double loss_sum = 0.0;
-    
-    for (size_t i = ticks.size() - period; i < ticks.size(); ++i) {
-        double prev_price = static_cast<double>(ticks[i-1].price) / 10000.0;
-        double curr_price = static_cast<double>(ticks[i].price) / 10000.0;
-        double change = curr_price - prev_price;
+void NeuralPredictor::write_features(const StreamingFeatures& state, int64_t price, int32_t qty, char side,
+                                     double* row) {
+    state.write(row);
+    
+    size_t i = StreamingFeatures::FEATURE_COUNT;
+    row[i++] = static_cast<double>(price) / 10000.0;
+    row[i++] = static_cast<double>(qty);
+    row[i++] = side == 'B' ? 1.0 : -1.0;
+    std::fill(row + i, row + std::max(i, config_.input_features), 0.0);
+}
+
+void NeuralPredictor::infer(size_t count, Prediction* out) {
+    const double* input = feature_buffer_.data();
+    size_t input_stride = feature_stride_;
+    size_t inputs = config_.input_features;
+    size_t layers = quantized_weights_.size();
+    
+    for (size_t layer = 0; layer < layers; ++layer) {
+        size_t outputs = bias_vectors_[layer].size();
+        const double* bias = bias_vectors_[layer].data();
+        double* output = activations_[layer % 2].data();
+        bool hidden = layer + 1 < layers;
         
-        if (change > 0) {
-            gain_sum += change;
+        if (config_.use_quantization) {
+            // Per-row scales; after the first layer the epilogue has already found each row's max
+            for (size_t b = 0; b < count; ++b) {
+                const double* row = input + b * input_stride;
+                int8_t* quantized = quantized_input_.data() + b * quantized_stride_;
+                input_scales_[b] = (layer == 0
+                    ? quantize_activations(row, inputs, quantized)
+                    : quantize_activations(row, inputs, input_max_[b], quantized)) / 127.0;
+            }
+            packed_weights_[layer].gemm(quantized_input_.data(), count, quantized_stride_,
+                                        accumulators_.data(), accumulator_stride_);
+            for (size_t b = 0; b < count; ++b) {
+                const int32_t* acc = accumulators_.data() + b * accumulator_stride_;
+                double* row = output + b * activation_stride_;
+                if (hidden) {
+                    input_max_[b] = dequantize_bias_relu(acc, outputs, input_scales_[b], bias, row);
+                } else {
+                    for (size_t i = 0; i < outputs; ++i) {
+                        row[i] = acc[i] * input_scales_[b] + bias[i];
+                    }
+                }
+            }
         } else {
-            loss_sum += -change;
+            const double* weights = dequantized_weights_[layer].data();
+            for (size_t b = 0; b < count; ++b) {
+                const double* in = input + b * input_stride;
+                double* row = output + b * activation_stride_;
+                for (size_t i = 0; i < outputs; ++i) {
+                    double sum = bias[i];
+                    for (size_t j = 0; j < inputs; ++j) {
+                        sum += weights[i * inputs + j] * in[j];
+                    }
+                    row[i] = hidden ? relu_activation(sum) : sum;
+                }
+            }
         }
+        
+        input = output;
+        input_stride = activation_stride_;
+        inputs = outputs;
     }
     
-    if (loss_sum == 0.0) return 100.0;
-    
-    double rs = (gain_sum / period) / (loss_sum / period);
-    return 100.0 - (100.0 / (1.0 + rs));
-}
-
-std::array<double, 3> NeuralPredictor::calculate_bollinger_bands(
-    const std::vector<common::Tick>& ticks) {
-    
-    if (ticks.size() < 20) return {0.0, 0.0, 0.0};
-    
-    // Calculate 20-period SMA
-    double sma = calculate_sma(ticks, 20);
-    
-    // Calculate standard deviation
-    double variance = 0.0;
-    for (size_t i = ticks.size() - 20; i < ticks.size(); ++i) {
-        double price = static_cast<double>(ticks[i].price) / 10000.0;
-        variance += (price - sma) * (price - sma);
+    // Output layer: direction in [-1, 1], confidence and volatility in [0, 1]
+    for (size_t b = 0; b < count; ++b) {
+        const double* row = input + b * input_stride;
+        out[b].price_direction = std::tanh(row[0]);
+        out[b].confidence = sigmoid_activation(row[1]);
+        out[b].volatility_forecast = sigmoid_activation(row[2]);
     }
-    double std_dev = std::sqrt(variance / 20.0);
-    
-    return {sma - 2.0 * std_dev, sma, sma + 2.0 * std_dev}; // Lower, Middle, Upper
 }
 
-bool NeuralPredictor::detect_price_anomaly(const common::Tick& tick,
-                                          const std::vector<common::Tick>& history) {
-    if (history.size() < 50) return false;
-    
-    double current_price = static_cast<double>(tick.price) / 10000.0;
+std::vector<double> NeuralPredictor::extract_features(
+    const std::vector<common::Tick>& ticks) {
     
-    // Calculate recent price statistics
-    double sum = 0.0;
-    for (size_t i = history.size() - 50; i < history.size(); ++i) {
-        sum += static_cast<double>(history[i].price) / 10000.0;
+    std::vector<double> features(config_.input_features, 0.0);
+    if (ticks.empty()) {
+        return features;
     }
-    double mean = sum / 50.0;
     
-    double variance = 0.0;
-    for (size_t i = history.size() - 50; i < history.size(); ++i) {
-        double price = static_cast<double>(history[i].price) / 10000.0;
-        variance += (price - mean) * (price - mean);
+    StreamingFeatures state;
+    for (const auto& tick : ticks) {
+        state.update(tick);
     }
-    double std_dev = std::sqrt(variance / 50.0);
-    
-    // Detect anomaly if price is more than 3 standard deviations from mean
-    double z_score = std::abs(current_price - mean) / std_dev;
-    return z_score > 3.0;
+    state.write(features.data());
+    return features;
 }
 
 NeuralPredictor::ModelMetrics NeuralPredictor::get_metrics() const {
@@ -450,6 +360,75 @@ void NeuralPredictor::load_model(const std::string& filepath) {
                  size * sizeof(double));
         bias_vectors_.push_back(std::move(layer_biases));
     }
+    
+    pack_layers();
+}
+
+InferenceThread::InferenceThread(NeuralPredictor& predictor, BatchCallback callback)
+    : InferenceThread(predictor, std::move(callback), Config()) {}
+
+InferenceThread::InferenceThread(NeuralPredictor& predictor, BatchCallback callback, const Config& config)
+    : predictor_(predictor), callback_(std::move(callback)), config_(config) {
+    config_.max_batch = std::max<size_t>(config_.max_batch, 1);
+}
+
+InferenceThread::~InferenceThread() {
+    stop();
+}
+
+void InferenceThread::start() {
+    if (running_) {
+        return;
+    }
+    // Rings are single-use once shut down, so every start gets a new one
+    ring_ = std::make_unique<threading::SpscRing<common::CompactTick>>(config_.queue_capacity, config_.wait_strategy);
+    running_ = true;
+    worker_ = std::thread(&InferenceThread::worker_loop, this);
+}
+
+void InferenceThread::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    ring_->shutdown();  // The worker drains the ring before exiting
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool InferenceThread::submit(const common::CompactTick& tick) {
+    if (!running_ || !ring_->try_push(tick)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void InferenceThread::worker_loop() {
+    std::vector<common::CompactTick> batch;
+    std::vector<NeuralPredictor::Prediction> predictions;
+    batch.reserve(config_.max_batch);
+    predictions.reserve(config_.max_batch);
+    
+    // Block for the first tick, then take whatever else is already queued
+    common::CompactTick tick;
+    while (ring_->pop(tick)) {
+        batch.clear();
+        batch.push_back(tick);
+        while (batch.size() < config_.max_batch && ring_->try_pop(tick)) {
+            batch.push_back(tick);
+        }
+        
+        predictions.clear();
+        predictor_.predict_batch(batch, predictions);
+        if (callback_) {
+            callback_(batch.data(), predictions.data(), batch.size());
+        }
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        predictions_.fetch_add(batch.size(), std::memory_order_relaxed);
+    }
 }
 
 } // namespace ml
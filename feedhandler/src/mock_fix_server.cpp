@@ -1,14 +1,30 @@
 // Mock FIX server that sends simulated market data
 // Used for testing the complete FeedHandler pipeline
+//
+// Default mode sends a short scripted quote sequence to one client. With
+// --load it becomes a load generator: messages are pre-rendered into one
+// arena per connection, many clients are served concurrently with gather
+// writes (sendmsg iovecs) straight from the arena, and rate, burst size,
+// symbol universe and fragmentation are configurable. Each message carries
+// its send time in SendingTime(52) with nanosecond precision for latency
+// measurement.
 
 #include <iostream>
 #include <string>
 #include <vector>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <random>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 
@@ -49,7 +65,7 @@ public:
         }
         
         // Listen
-        if (listen(server_fd_, 3) < 0) {
+        if (listen(server_fd_, SOMAXCONN) < 0) {
             std::cerr << "Failed to listen" << std::endl;
             close(server_fd_);
             return false;
@@ -60,18 +76,27 @@ public:
         return true;
     }
     
-    void accept_and_send() {
+    // Accept one client, -1 on failure
+    int accept_client() {
         struct sockaddr_in client_addr;
         socklen_t client_len = sizeof(client_addr);
         
         int client_fd = accept(server_fd_, (struct sockaddr*)&client_addr, &client_len);
         if (client_fd < 0) {
             std::cerr << "Failed to accept connection" << std::endl;
-            return;
+            return -1;
         }
         
         std::cout << "Client connected from " 
                   << inet_ntoa(client_addr.sin_addr) << std::endl;
+        return client_fd;
+    }
+    
+    void accept_and_send() {
+        int client_fd = accept_client();
+        if (client_fd < 0) {
+            return;
+        }
         
         // Send simulated market data
         send_market_data(client_fd);
@@ -133,11 +158,309 @@ private:
     bool running_;
 };
 
+// Load generator settings (--load mode)
+struct LoadConfig {
+    int connections = 1;        // Clients to wait for before sending
+    uint64_t rate = 100000;     // Messages per second per connection, 0 = unthrottled
+    size_t burst = 64;          // Messages per gather-write batch
+    size_t symbols = 16;        // Symbol universe size
+    double seconds = 10.0;      // Send duration
+    size_t fragment = 0;        // 0 = whole bursts, else split writes at this many bytes
+    bool random_fragment = false; // Split at random sizes in [1, fragment] instead
+    bool timestamps = true;     // Patch send time into SendingTime(52)
+};
+
+// Pre-rendered messages for one connection. Every message sits in one
+// contiguous arena with a fixed-width 52= slot, so a send only patches the
+// timestamp digits and checksum in place and gathers the arena ranges.
+class MessageArena {
+public:
+    static constexpr size_t TIMESTAMP_WIDTH = 27;  // YYYYMMDD-HH:MM:SS.nnnnnnnnn
+    
+    MessageArena(size_t symbols, size_t count) {
+        static const char* const roots[] = {"AAPL", "MSFT", "GOOG", "TSLA", "NVDA", "AMZN", "META", "NFLX"};
+        for (size_t i = 0; i < count; ++i) {
+            // Symbol universe: roots, then ROOTn for larger universes
+            size_t symbol = i % symbols;
+            std::string name = roots[symbol % 8];
+            if (symbol >= 8) {
+                name += std::to_string(symbol / 8);
+            }
+            bool buy = (i / symbols) % 2 == 0;
+            unsigned cents = static_cast<unsigned>((i * 37) % 100);
+            char price[16];
+            std::snprintf(price, sizeof(price), "%u.%02u", buy ? 100u : 101u, cents);
+            
+            std::string body = "35=D|55=" + name + "|44=" + price +
+                               "|38=" + std::to_string(100 * (1 + i % 10)) +
+                               "|54=" + (buy ? "1" : "2") +
+                               "|52=" + std::string(TIMESTAMP_WIDTH, '0') + "|";
+            std::string message = "8=FIX.4.4|9=" + std::to_string(body.size()) + "|" + body;
+            
+            Slot slot;
+            slot.offset = arena_.size();
+            slot.timestamp = slot.offset + message.size() - 1 - TIMESTAMP_WIDTH;
+            for (size_t c = 0; c < message.size(); ++c) {
+                bool in_timestamp = c >= message.size() - 1 - TIMESTAMP_WIDTH && c < message.size() - 1;
+                if (!in_timestamp) {
+                    slot.base_sum += static_cast<unsigned char>(message[c]);
+                }
+            }
+            message += "10=000|";
+            slot.checksum = slot.offset + message.size() - 4;
+            slot.length = message.size();
+            arena_ += message;
+            slots_.push_back(slot);
+            stamp(slots_.size() - 1, "19700101-00:00:00", 0);
+        }
+    }
+    
+    size_t size() const { return slots_.size(); }
+    
+    const char* data(size_t index) const { return arena_.data() + slots_[index].offset; }
+    size_t length(size_t index) const { return slots_[index].length; }
+    
+    // Write "<seconds>.<nanos>" into the 52= slot and fix the checksum
+    void stamp(size_t index, const char* seconds, uint32_t nanos) {
+        Slot& slot = slots_[index];
+        char* field = &arena_[slot.timestamp];
+        std::memcpy(field, seconds, 17);
+        field[17] = '.';
+        for (int d = 26; d >= 18; --d) {
+            field[d] = static_cast<char>('0' + nanos % 10);
+            nanos /= 10;
+        }
+        unsigned sum = slot.base_sum;
+        for (size_t c = 0; c < TIMESTAMP_WIDTH; ++c) {
+            sum += static_cast<unsigned char>(field[c]);
+        }
+        sum %= 256;
+        char* checksum = &arena_[slot.checksum];
+        checksum[0] = static_cast<char>('0' + sum / 100);
+        checksum[1] = static_cast<char>('0' + sum / 10 % 10);
+        checksum[2] = static_cast<char>('0' + sum % 10);
+    }
+    
+private:
+    struct Slot {
+        size_t offset = 0;
+        size_t length = 0;
+        size_t timestamp = 0;  // Arena offset of the 52= value
+        size_t checksum = 0;   // Arena offset of the 10= value
+        unsigned base_sum = 0; // Byte sum excluding the timestamp digits
+    };
+    
+    std::string arena_;
+    std::vector<Slot> slots_;
+};
+
+// Serves LoadConfig::connections clients at once, one sender thread each
+class LoadGenerator {
+public:
+    explicit LoadGenerator(const LoadConfig& config) : config_(config) {}
+    
+    void run(MockFixServer& server) {
+        std::vector<int> clients;
+        std::cout << "Waiting for " << config_.connections << " client(s)..." << std::endl;
+        while (static_cast<int>(clients.size()) < config_.connections) {
+            int fd = server.accept_client();
+            if (fd < 0) {
+                break;
+            }
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            clients.push_back(fd);
+        }
+        
+        std::vector<Result> results(clients.size());
+        std::vector<std::thread> senders;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < clients.size(); ++i) {
+            senders.emplace_back([this, &clients, &results, i] {
+                results[i] = send_load(clients[i], static_cast<uint32_t>(i));
+            });
+        }
+        for (auto& sender : senders) {
+            sender.join();
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        uint64_t messages = 0;
+        uint64_t bytes = 0;
+        for (size_t i = 0; i < clients.size(); ++i) {
+            close(clients[i]);
+            messages += results[i].messages;
+            bytes += results[i].bytes;
+            std::cout << "Connection " << i << ": " << results[i].messages << " messages, "
+                      << results[i].bytes << " bytes, " << results[i].writes << " writes"
+                      << (results[i].disconnected ? " (client disconnected)" : "") << std::endl;
+        }
+        std::cout << "Total: " << messages << " messages in " << elapsed << " s ("
+                  << static_cast<uint64_t>(static_cast<double>(messages) / elapsed) << " msg/s, "
+                  << static_cast<double>(bytes) / elapsed / 1e6 << " MB/s)" << std::endl;
+    }
+    
+private:
+    struct Result {
+        uint64_t messages = 0;
+        uint64_t bytes = 0;
+        uint64_t writes = 0;
+        bool disconnected = false;
+    };
+    
+    Result send_load(int fd, uint32_t seed) {
+        Result result;
+        MessageArena arena(config_.symbols, std::max<size_t>(1024, config_.burst));
+        std::mt19937 random(seed);
+        std::vector<struct iovec> iov;
+        iov.reserve(config_.burst + 1);
+        
+        auto start = std::chrono::steady_clock::now();
+        auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(config_.seconds));
+        time_t cached_second = 0;
+        char seconds[18] = "19700101-00:00:00";
+        size_t next = 0;
+        
+        for (auto now = start; now < end && !result.disconnected; now = std::chrono::steady_clock::now()) {
+            if (config_.rate > 0) {
+                uint64_t due = static_cast<uint64_t>(
+                    std::chrono::duration<double>(now - start).count() * static_cast<double>(config_.rate));
+                if (result.messages >= due) {
+                    std::this_thread::yield();
+                    continue;
+                }
+            }
+            
+            // Stamp the burst with one clock read and gather it from the arena
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            if (config_.timestamps && ts.tv_sec != cached_second) {
+                cached_second = ts.tv_sec;
+                struct tm utc;
+                gmtime_r(&ts.tv_sec, &utc);
+                std::strftime(seconds, sizeof(seconds), "%Y%m%d-%H:%M:%S", &utc);
+            }
+            iov.clear();
+            size_t burst_bytes = 0;
+            for (size_t m = 0; m < config_.burst; ++m) {
+                if (config_.timestamps) {
+                    arena.stamp(next, seconds, static_cast<uint32_t>(ts.tv_nsec));
+                }
+                // Consecutive arena slots are contiguous: extend the previous range
+                if (!iov.empty() &&
+                    static_cast<const char*>(iov.back().iov_base) + iov.back().iov_len == arena.data(next)) {
+                    iov.back().iov_len += arena.length(next);
+                } else {
+                    iov.push_back({const_cast<char*>(arena.data(next)), arena.length(next)});
+                }
+                burst_bytes += arena.length(next);
+                next = (next + 1) % arena.size();
+            }
+            
+            if (!send_burst(fd, iov, random, result)) {
+                result.disconnected = true;
+                break;
+            }
+            result.messages += config_.burst;
+            result.bytes += burst_bytes;
+        }
+        return result;
+    }
+    
+    // Gather-write the burst, split into fragments when configured
+    bool send_burst(int fd, std::vector<struct iovec>& iov, std::mt19937& random, Result& result) {
+        size_t index = 0;
+        while (index < iov.size()) {
+            size_t limit = SIZE_MAX;
+            if (config_.fragment > 0) {
+                limit = config_.random_fragment ?
+                    std::uniform_int_distribution<size_t>(1, config_.fragment)(random) : config_.fragment;
+            }
+            
+            // Collect up to limit bytes starting at iov[index]
+            struct iovec pieces[64];
+            int count = 0;
+            size_t taken = 0;
+            for (size_t i = index; i < iov.size() && count < 64 && taken < limit; ++i) {
+                size_t length = std::min(iov[i].iov_len, limit - taken);
+                pieces[count++] = {iov[i].iov_base, length};
+                taken += length;
+            }
+            
+            // sendmsg() is writev() with MSG_NOSIGNAL: a dropped client is an error, not SIGPIPE
+            struct msghdr message{};
+            message.msg_iov = pieces;
+            message.msg_iovlen = static_cast<size_t>(count);
+            ssize_t written = sendmsg(fd, &message, MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            ++result.writes;
+            
+            // Advance past what was written (may be a partial write)
+            size_t remaining = static_cast<size_t>(written);
+            while (remaining > 0 && index < iov.size()) {
+                if (remaining >= iov[index].iov_len) {
+                    remaining -= iov[index].iov_len;
+                    ++index;
+                } else {
+                    iov[index].iov_base = static_cast<char*>(iov[index].iov_base) + remaining;
+                    iov[index].iov_len -= remaining;
+                    remaining = 0;
+                }
+            }
+        }
+        return true;
+    }
+    
+    LoadConfig config_;
+};
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [port]\n"
+              << "       " << program << " --load [--port N] [--connections N] [--rate MSGS_PER_SEC]\n"
+              << "           [--burst N] [--symbols N] [--seconds S] [--fragment BYTES | --random-fragment BYTES]\n"
+              << "           [--no-timestamps]\n"
+              << "  --rate is per connection, 0 = as fast as the socket accepts" << std::endl;
+}
+
 int main(int argc, char* argv[]) {
     int port = 9999;
+    bool load_mode = false;
+    LoadConfig load;
     
-    if (argc > 1) {
-        port = std::atoi(argv[1]);
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--load") {
+            load_mode = true;
+        } else if (arg == "--no-timestamps") {
+            load.timestamps = false;
+        } else if (arg == "--port" && has_value) {
+            port = std::atoi(argv[++i]);
+        } else if (arg == "--connections" && has_value) {
+            load.connections = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--rate" && has_value) {
+            load.rate = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--burst" && has_value) {
+            load.burst = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--symbols" && has_value) {
+            load.symbols = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--seconds" && has_value) {
+            load.seconds = std::atof(argv[++i]);
+        } else if ((arg == "--fragment" || arg == "--random-fragment") && has_value) {
+            load.fragment = std::strtoull(argv[++i], nullptr, 10);
+            load.random_fragment = arg == "--random-fragment";
+        } else if (i == 1 && arg[0] != '-') {
+            port = std::atoi(argv[1]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
     }
     
     std::cout << "========================================" << std::endl;
@@ -151,6 +474,12 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    if (load_mode) {
+        LoadGenerator(load).run(server);
+        server.stop();
+        return 0;
+    }
+    
     std::cout << "\nWaiting for client connection..." << std::endl;
     std::cout << "Connect with: ./feedhandler_demo localhost " << port << std::endl;
     std::cout << std::endl;
@@ -0,0 +1,329 @@
+#include "monitoring/metrics_exporter.hpp"
+#include "common/tsc_clock.hpp"
+#include "parser/ascii.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace feedhandler {
+namespace monitoring {
+
+namespace {
+
+bool ends_with(const std::string& value, const std::string& suffix) {
+    return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Prometheus metric names: [a-zA-Z_:][a-zA-Z0-9_:]*
+std::string prometheus_name(const std::string& name) {
+    std::string result = name;
+    for (char& c : result) {
+        bool valid = parser::ascii::is_alnum(c) || c == '_' || c == ':';
+        if (!valid) {
+            c = '_';
+        }
+    }
+    if (result.empty() || parser::ascii::is_digit(result[0])) {
+        result.insert(result.begin(), '_');
+    }
+    return result;
+}
+
+std::string json_string(const std::string& value) {
+    std::string result = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    result += '"';
+    return result;
+}
+
+} // namespace
+
+MetricsExporterConfig MetricsExporterConfig::from_monitoring(const config::PerformanceConfig::MonitoringConfig& monitoring) {
+    MetricsExporterConfig config;
+    config.update_interval_ms = monitoring.metrics_update_interval_ms;
+    config.output_file = monitoring.metrics_output_file;
+    if (ends_with(config.output_file, ".prom") || ends_with(config.output_file, ".txt")) {
+        config.format = MetricsFormat::PROMETHEUS;
+    }
+    return config;
+}
+
+MetricsExporter::MetricsExporter(const MetricsExporterConfig& config)
+    : config_(config) {
+    config_.update_interval_ms = std::max(config_.update_interval_ms, 1);
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+    close_shm();
+}
+
+void MetricsExporter::add_counter(const std::string& name, ValueReader reader) {
+    values_.push_back({name, Kind::COUNTER, std::move(reader)});
+}
+
+void MetricsExporter::add_counter(const std::string& name, const std::atomic<uint64_t>& counter) {
+    add_counter(name, [&counter] { return counter.load(std::memory_order_relaxed); });
+}
+
+void MetricsExporter::add_counter(const std::string& name, const common::StatCounter& counter) {
+    add_counter(name, [&counter] { return counter.load(); });
+}
+
+void MetricsExporter::add_gauge(const std::string& name, ValueReader reader) {
+    values_.push_back({name, Kind::GAUGE, std::move(reader)});
+}
+
+void MetricsExporter::add_histogram(const std::string& name, const common::AtomicLatencyHistogram* histogram) {
+    if (histogram) {
+        histograms_.push_back({name, histogram});
+    }
+}
+
+void MetricsExporter::add_feed_handler(const std::string& prefix,
+                                       const threading::ThreadedFeedHandler::Statistics& stats) {
+    add_counter(prefix + "_bytes_received", stats.bytes_received);
+    add_counter(prefix + "_messages_parsed", stats.messages_parsed);
+    add_counter(prefix + "_parse_errors", stats.parse_errors);
+    add_counter(prefix + "_queue_overflows", stats.queue_overflows);
+    add_counter(prefix + "_network_reads", stats.network_reads);
+    add_counter(prefix + "_parser_cycles", stats.parser_cycles);
+    add_counter(prefix + "_segment_exhaustions", stats.segment_exhaustions);
+    add_counter(prefix + "_backpressure_waits", stats.backpressure_waits);
+    add_counter(prefix + "_buffers_shed", stats.buffers_shed);
+    add_counter(prefix + "_ticks_conflated", stats.ticks_conflated);
+    add_histogram(prefix + "_queue_latency_ns", &stats.queue_latency);
+    add_histogram(prefix + "_parse_latency_ns", &stats.parse_latency);
+}
+
+bool MetricsExporter::start() {
+    if (running_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (!config_.shm_name.empty() && !shm_ && !open_shm()) {
+        return false;
+    }
+    running_.store(true, std::memory_order_relaxed);
+    thread_ = std::thread(&MetricsExporter::run, this);
+    return true;
+}
+
+void MetricsExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    export_now();  // Final values
+}
+
+bool MetricsExporter::export_now() {
+    std::string text = render(config_.format);
+
+    std::lock_guard<std::mutex> lock(export_mutex_);
+    bool ok = true;
+    if (!config_.output_file.empty()) {
+        ok = write_file(text);
+    }
+    if (shm_) {
+        write_shm(text);
+    }
+    exports_.fetch_add(1, std::memory_order_relaxed);
+    return ok;
+}
+
+std::string MetricsExporter::render(MetricsFormat format) const {
+    return format == MetricsFormat::PROMETHEUS ? render_prometheus() : render_json();
+}
+
+std::string MetricsExporter::render_json() const {
+    std::ostringstream out;
+    out << "{\n  \"timestamp_ns\": " << common::TscClock::realtime_ns();
+
+    for (Kind kind : {Kind::COUNTER, Kind::GAUGE}) {
+        out << ",\n  " << (kind == Kind::COUNTER ? "\"counters\"" : "\"gauges\"") << ": {";
+        bool first = true;
+        for (const auto& source : values_) {
+            if (source.kind != kind) {
+                continue;
+            }
+            out << (first ? "\n    " : ",\n    ") << json_string(source.name) << ": " << source.reader();
+            first = false;
+        }
+        out << (first ? "}" : "\n  }");
+    }
+
+    out << ",\n  \"histograms\": {";
+    for (size_t i = 0; i < histograms_.size(); ++i) {
+        common::LatencySummary summary = histograms_[i].histogram->snapshot().summary();
+        out << (i == 0 ? "\n    " : ",\n    ") << json_string(histograms_[i].name)
+            << ": {\"count\": " << summary.count
+            << ", \"p50\": " << summary.p50
+            << ", \"p99\": " << summary.p99
+            << ", \"p999\": " << summary.p999
+            << ", \"max\": " << summary.max
+            << ", \"mean\": " << summary.mean << "}";
+    }
+    out << (histograms_.empty() ? "}" : "\n  }") << "\n}\n";
+    return out.str();
+}
+
+std::string MetricsExporter::render_prometheus() const {
+    std::ostringstream out;
+    for (const auto& source : values_) {
+        std::string name = prometheus_name(source.name);
+        out << "# TYPE " << name << (source.kind == Kind::COUNTER ? " counter\n" : " gauge\n")
+            << name << ' ' << source.reader() << '\n';
+    }
+    for (const auto& source : histograms_) {
+        std::string name = prometheus_name(source.name);
+        common::LatencyHistogram snapshot = source.histogram->snapshot();
+        common::LatencySummary summary = snapshot.summary();
+        out << "# TYPE " << name << " summary\n"
+            << name << "{quantile=\"0.5\"} " << summary.p50 << '\n'
+            << name << "{quantile=\"0.99\"} " << summary.p99 << '\n'
+            << name << "{quantile=\"0.999\"} " << summary.p999 << '\n'
+            << name << "_sum " << static_cast<uint64_t>(summary.mean * static_cast<double>(summary.count)) << '\n'
+            << name << "_count " << summary.count << '\n'
+            << "# TYPE " << name << "_max gauge\n"
+            << name << "_max " << summary.max << '\n';
+    }
+    return out.str();
+}
+
+bool MetricsExporter::write_file(const std::string& text) {
+    // Write aside and rename so readers only ever see a whole file
+    std::string temp = config_.output_file + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::trunc);
+        if (!file || !(file << text) || !file.flush()) {
+            std::cerr << "Failed to write metrics to " << temp << std::endl;
+            return false;
+        }
+    }
+    if (std::rename(temp.c_str(), config_.output_file.c_str()) != 0) {
+        std::cerr << "Failed to replace " << config_.output_file << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MetricsExporter::open_shm() {
+    size_t size = sizeof(MetricsShmHeader) + config_.shm_size;
+    int fd = ::shm_open(config_.shm_name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "shm_open(" << config_.shm_name << ") failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        std::cerr << "ftruncate(" << config_.shm_name << ") failed: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "mmap(" << config_.shm_name << ") failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    shm_ = new (mapping) MetricsShmHeader{};
+    shm_->sequence.store(0, std::memory_order_relaxed);
+    shm_->length = 0;
+    shm_->capacity = config_.shm_size;
+    shm_->format = static_cast<uint64_t>(config_.format);
+    shm_mapped_ = size;
+    return true;
+}
+
+void MetricsExporter::close_shm() {
+    if (shm_) {
+        ::munmap(shm_, shm_mapped_);
+        ::shm_unlink(config_.shm_name.c_str());
+        shm_ = nullptr;
+        shm_mapped_ = 0;
+    }
+}
+
+void MetricsExporter::write_shm(const std::string& text) {
+    size_t length = std::min<size_t>(text.size(), shm_->capacity);
+    uint64_t sequence = shm_->sequence.load(std::memory_order_relaxed);
+    shm_->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(reinterpret_cast<char*>(shm_ + 1), text.data(), length);
+    shm_->length = length;
+    shm_->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void MetricsExporter::run() {
+    auto interval = std::chrono::milliseconds(config_.update_interval_ms);
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (running_.load(std::memory_order_relaxed)) {
+        if (wake_.wait_for(lock, interval, [this] { return !running_.load(std::memory_order_relaxed); })) {
+            break;
+        }
+        lock.unlock();
+        export_now();
+        lock.lock();
+    }
+}
+
+bool read_shared_metrics(const std::string& shm_name, std::string& text) {
+    int fd = ::shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(MetricsShmHeader)) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const auto* header = static_cast<const MetricsShmHeader*>(mapping);
+    const char* data = reinterpret_cast<const char*>(header + 1);
+    size_t capacity = size - sizeof(MetricsShmHeader);
+    bool ok = false;
+    for (int attempt = 0; attempt < 1000 && !ok; ++attempt) {
+        uint64_t before = header->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;  // Exporter mid-write
+        }
+        size_t length = std::min<size_t>(header->length, capacity);
+        text.assign(data, length);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        ok = header->sequence.load(std::memory_order_relaxed) == before;
+    }
+    ::munmap(mapping, size);
+    return ok;
+}
+
+} // namespace monitoring
+} // namespace feedhandler
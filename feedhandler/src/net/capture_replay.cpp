@@ -0,0 +1,289 @@
+#include "net/capture_replay.hpp"
+#include "net/packet_headers.hpp"
+#include "parser/fix_schema.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace feedhandler {
+namespace net {
+
+namespace {
+
+constexpr uint32_t PCAP_MAGIC_US = 0xa1b2c3d4;
+constexpr uint32_t PCAP_MAGIC_NS = 0xa1b23c4d;
+constexpr size_t PCAP_FILE_HEADER = 24;
+constexpr size_t PCAP_RECORD_HEADER = 16;
+
+constexpr uint32_t LINKTYPE_ETHERNET = 1;
+constexpr uint32_t LINKTYPE_RAW = 101;
+constexpr uint32_t LINKTYPE_RAW_BSD = 12;
+constexpr uint32_t LINKTYPE_LINUX_SLL = 113;
+
+uint32_t load32(const char* p, bool swap) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return swap ? __builtin_bswap32(v) : v;
+}
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Tag 52 SendingTime of one message, 0 if absent
+uint64_t sending_time(std::string_view message) {
+    for (size_t pos = message.find("52="); pos != std::string_view::npos; pos = message.find("52=", pos + 1)) {
+        if (pos == 0 || message[pos - 1] == '|' || message[pos - 1] == '\x01') {
+            size_t value = pos + 3;
+            size_t end = message.find_first_of("|\x01", value);
+            return parser::decode::UtcTimestamp::decode(message.substr(value, end == std::string_view::npos
+                                                                              ? std::string_view::npos
+                                                                              : end - value));
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+CaptureReplay::CaptureReplay() : CaptureReplay(CaptureReplayConfig()) {
+}
+
+CaptureReplay::CaptureReplay(const CaptureReplayConfig& config)
+    : config_(config)
+    , format_(config.format)
+    , data_(nullptr)
+    , size_(0)
+    , first_timestamp_(0)
+    , start_ns_(0)
+    , position_(0)
+    , pcap_swap_(false)
+    , pcap_nanosecond_(false)
+    , pcap_link_type_(0) {
+    if (config_.speed <= 0.0) {
+        config_.speed = 1.0;
+    }
+    if (config_.chunk_size == 0) {
+        config_.chunk_size = CaptureReplayConfig().chunk_size;
+    }
+}
+
+CaptureReplay::~CaptureReplay() {
+    close();
+}
+
+bool CaptureReplay::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "CaptureReplay: cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        std::cerr << "CaptureReplay: " << path << " is empty or unreadable" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        std::cerr << "CaptureReplay: mmap failed for " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Hints only: failures change nothing functionally
+    if (config_.sequential_hint) {
+        madvise(mapping, size, MADV_SEQUENTIAL);
+    }
+#ifdef MADV_HUGEPAGE
+    if (config_.hugepage_hint) {
+        madvise(mapping, size, MADV_HUGEPAGE);
+    }
+#endif
+
+    data_ = static_cast<const char*>(mapping);
+    size_ = size;
+
+    format_ = config_.format;
+    if (format_ == CaptureFormat::AUTO) {
+        format_ = CaptureFormat::RAW;
+        if (size_ >= PCAP_FILE_HEADER) {
+            uint32_t magic = load32(data_, false);
+            if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS ||
+                magic == __builtin_bswap32(PCAP_MAGIC_US) || magic == __builtin_bswap32(PCAP_MAGIC_NS)) {
+                format_ = CaptureFormat::PCAP;
+            }
+        }
+    }
+    rewind();
+    return true;
+}
+
+void CaptureReplay::close() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+size_t CaptureReplay::replay(const Callback& callback) {
+    rewind();
+    size_t deliveries = 0;
+    Delivery delivery;
+    while (next(delivery)) {
+        callback(delivery.data, delivery.length, delivery.timestamp_ns);
+        ++deliveries;
+    }
+    return deliveries;
+}
+
+bool CaptureReplay::next(Delivery& delivery) {
+    if (!data_) {
+        return false;
+    }
+    return format_ == CaptureFormat::PCAP ? next_pcap(delivery) : next_raw(delivery);
+}
+
+void CaptureReplay::rewind() {
+    stats_ = Stats();
+    first_timestamp_ = 0;
+    start_ns_ = 0;
+    position_ = 0;
+    if (data_ && format_ == CaptureFormat::PCAP && size_ >= PCAP_FILE_HEADER) {
+        uint32_t magic = load32(data_, false);
+        pcap_swap_ = magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS;
+        pcap_nanosecond_ = load32(data_, pcap_swap_) == PCAP_MAGIC_NS;
+        pcap_link_type_ = load32(data_ + 20, pcap_swap_) & 0x0fffffff;  // Upper bits carry FCS info
+        position_ = PCAP_FILE_HEADER;
+    }
+}
+
+void CaptureReplay::pace(uint64_t timestamp_ns) {
+    if (config_.pacing != ReplayPacing::ORIGINAL || timestamp_ns == 0) {
+        return;
+    }
+    if (start_ns_ == 0) {
+        first_timestamp_ = timestamp_ns;
+        start_ns_ = now_ns();
+        return;
+    }
+    if (timestamp_ns <= first_timestamp_) {
+        return;  // Out-of-order capture time: deliver immediately
+    }
+
+    int64_t due = start_ns_ + static_cast<int64_t>(static_cast<double>(timestamp_ns - first_timestamp_) / config_.speed);
+    int64_t remaining = due - now_ns();
+    constexpr int64_t SPIN_NS = 50000;
+
+    // Sleep for the bulk of the gap, spin the last stretch for accuracy
+    if (remaining > SPIN_NS) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - SPIN_NS));
+    }
+    while (now_ns() < due) {
+    }
+}
+
+bool CaptureReplay::next_raw(Delivery& delivery) {
+    size_t pos = position_;
+    if (pos >= size_) {
+        return false;
+    }
+    size_t end;
+    uint64_t timestamp = 0;
+    if (config_.pacing == ReplayPacing::ORIGINAL || config_.split_messages) {
+        const void* newline = std::memchr(data_ + pos, '\n', size_ - pos);
+        end = newline ? static_cast<size_t>(static_cast<const char*>(newline) - data_) + 1 : size_;
+        timestamp = sending_time(std::string_view(data_ + pos, end - pos));
+        pace(timestamp);
+    } else {
+        end = std::min(pos + config_.chunk_size, size_);
+        if (end < size_) {
+            // Cut after the last complete line, unless the chunk has none
+            for (size_t i = end; i > pos; --i) {
+                if (data_[i - 1] == '\n') {
+                    end = i;
+                    break;
+                }
+            }
+        }
+    }
+
+    delivery = Delivery{data_ + pos, end - pos, timestamp};
+    stats_.deliveries++;
+    stats_.bytes += end - pos;
+    position_ = end;
+    return true;
+}
+
+bool CaptureReplay::next_pcap(Delivery& delivery) {
+    if (size_ < PCAP_FILE_HEADER) {
+        return false;
+    }
+    bool swap = pcap_swap_;
+    size_t pos = position_;
+    while (pos + PCAP_RECORD_HEADER <= size_) {
+        uint64_t seconds = load32(data_ + pos, swap);
+        uint64_t fraction = load32(data_ + pos + 4, swap);
+        size_t captured = load32(data_ + pos + 8, swap);
+        pos += PCAP_RECORD_HEADER;
+        if (captured > size_ - pos) {
+            stats_.truncated_records++;
+            break;
+        }
+
+        const unsigned char* frame = reinterpret_cast<const unsigned char*>(data_ + pos);
+        size_t frame_length = captured;
+        pos += captured;
+
+        // Strip the link layer down to the IP header
+        const unsigned char* ip = nullptr;
+        size_t ip_length = 0;
+        if (pcap_link_type_ == LINKTYPE_ETHERNET) {
+            ethernet_to_ip(frame, frame_length, ip, ip_length);
+        } else if (pcap_link_type_ == LINKTYPE_LINUX_SLL && frame_length >= 16) {
+            uint16_t protocol = load16_be(frame + 14);
+            if (protocol == 0x0800 || protocol == 0x86dd) {
+                ip = frame + 16;
+                ip_length = frame_length - 16;
+            }
+        } else if (pcap_link_type_ == LINKTYPE_RAW || pcap_link_type_ == LINKTYPE_RAW_BSD) {
+            ip = frame;
+            ip_length = frame_length;
+        }
+
+        L4Payload payload;
+        if (!ip || !ip_to_l4(ip, ip_length, payload)) {
+            stats_.skipped_packets++;
+            continue;
+        }
+
+        uint64_t timestamp = seconds * 1000000000ull + (pcap_nanosecond_ ? fraction : fraction * 1000);
+        pace(timestamp);
+        delivery = Delivery{payload.data, payload.length, timestamp};
+        stats_.deliveries++;
+        stats_.bytes += payload.length;
+        position_ = pos;
+        return true;
+    }
+    position_ = size_;  // Truncated or exhausted: stay at the end
+    return false;
+}
+
+} // namespace net
+} // namespace feedhandler
@@ -0,0 +1,134 @@
+#include "net/dpdk_backend.hpp"
+
+#include <rte_eal.h>
+#include <rte_errno.h>
+#include <rte_ethdev.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+
+#include <iostream>
+
+namespace feedhandler {
+namespace net {
+
+DpdkBackend::DpdkBackend(const DpdkBackendConfig& config)
+    : config_(config), bursts_(config.rx_queues) {
+    for (auto& burst : bursts_) {
+        burst.mbufs.resize(config_.max_burst);
+    }
+}
+
+DpdkBackend::~DpdkBackend() {
+    close();
+}
+
+bool DpdkBackend::open() {
+    std::vector<char*> argv;
+    std::string program = "feedhandler";
+    argv.push_back(program.data());
+    for (auto& arg : config_.eal_args) {
+        argv.push_back(arg.data());
+    }
+    if (rte_eal_init(static_cast<int>(argv.size()), argv.data()) < 0) {
+        std::cerr << "rte_eal_init failed: " << rte_strerror(rte_errno) << std::endl;
+        return false;
+    }
+    if (!rte_eth_dev_is_valid_port(config_.port_id)) {
+        std::cerr << "DPDK port " << config_.port_id << " not available" << std::endl;
+        return false;
+    }
+
+    int socket = rte_eth_dev_socket_id(config_.port_id);
+    pool_ = rte_pktmbuf_pool_create("feed_rx_pool", config_.mbuf_count, config_.mbuf_cache, 0,
+                                    RTE_MBUF_DEFAULT_BUF_SIZE, socket);
+    if (!pool_) {
+        std::cerr << "rte_pktmbuf_pool_create failed: " << rte_strerror(rte_errno) << std::endl;
+        return false;
+    }
+
+    rte_eth_dev_info info;
+    if (rte_eth_dev_info_get(config_.port_id, &info) != 0) {
+        std::cerr << "rte_eth_dev_info_get failed" << std::endl;
+        return false;
+    }
+
+    rte_eth_conf port_conf{};
+    if (config_.rx_queues > 1) {
+        port_conf.rxmode.mq_mode = RTE_ETH_MQ_RX_RSS;
+        port_conf.rx_adv_conf.rss_conf.rss_key = nullptr;  // Driver default key
+        port_conf.rx_adv_conf.rss_conf.rss_hf = (RTE_ETH_RSS_IP | RTE_ETH_RSS_UDP) & info.flow_type_rss_offloads;
+    }
+    if (rte_eth_dev_configure(config_.port_id, config_.rx_queues, 0, &port_conf) != 0) {
+        std::cerr << "rte_eth_dev_configure failed" << std::endl;
+        return false;
+    }
+
+    uint16_t descriptors = config_.rx_descriptors;
+    uint16_t unused_tx = 0;
+    rte_eth_dev_adjust_nb_rx_tx_desc(config_.port_id, &descriptors, &unused_tx);
+    for (uint16_t q = 0; q < config_.rx_queues; ++q) {
+        if (rte_eth_rx_queue_setup(config_.port_id, q, descriptors, static_cast<unsigned>(socket), nullptr, pool_) != 0) {
+            std::cerr << "rte_eth_rx_queue_setup failed for queue " << q << std::endl;
+            return false;
+        }
+    }
+
+    if (rte_eth_dev_start(config_.port_id) != 0) {
+        std::cerr << "rte_eth_dev_start failed" << std::endl;
+        return false;
+    }
+    if (config_.promiscuous) {
+        rte_eth_promiscuous_enable(config_.port_id);
+    }
+    started_ = true;
+    return true;
+}
+
+void DpdkBackend::close() {
+    if (started_) {
+        for (uint16_t q = 0; q < bursts_.size(); ++q) {
+            release(q);
+        }
+        rte_eth_dev_stop(config_.port_id);
+        rte_eth_dev_close(config_.port_id);
+        started_ = false;
+    }
+    if (pool_) {
+        rte_mempool_free(pool_);
+        pool_ = nullptr;
+    }
+}
+
+size_t DpdkBackend::rx_burst(uint16_t queue, RxPacket* out, size_t max) {
+    QueueBurst& burst = bursts_[queue];
+    if (max > burst.mbufs.size()) {
+        max = burst.mbufs.size();
+    }
+    burst.count = rte_eth_rx_burst(config_.port_id, queue, burst.mbufs.data(), static_cast<uint16_t>(max));
+    for (uint16_t i = 0; i < burst.count; ++i) {
+        rte_mbuf* mbuf = burst.mbufs[i];
+        out[i].data = rte_pktmbuf_mtod(mbuf, const char*);
+        out[i].length = rte_pktmbuf_data_len(mbuf);  // First segment; jumbo chains are not followed
+        out[i].timestamp_ns = 0;
+    }
+    return burst.count;
+}
+
+void DpdkBackend::release(uint16_t queue) {
+    QueueBurst& burst = bursts_[queue];
+    if (burst.count != 0) {
+        rte_pktmbuf_free_bulk(burst.mbufs.data(), burst.count);
+        burst.count = 0;
+    }
+}
+
+uint64_t DpdkBackend::dropped() const {
+    rte_eth_stats stats;
+    if (rte_eth_stats_get(config_.port_id, &stats) != 0) {
+        return 0;
+    }
+    return stats.imissed + stats.rx_nombuf;
+}
+
+} // namespace net
+} // namespace feedhandler
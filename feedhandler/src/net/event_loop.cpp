@@ -1,61 +1,533 @@
 #include "net/event_loop.hpp"
-#include <iostream>
+#include "common/trace_ring.hpp"
+#include <cerrno>
 #include <cstring>
 #include <unistd.h>
 #include <algorithm>
 
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 namespace feedhandler {
 namespace net {
 
-EventLoop::EventLoop() : max_fd_(0) {
+#ifdef __linux__
+
+// Minimal io_uring ring driven through raw syscalls (no liburing dependency)
+struct EventLoop::Uring {
+    static constexpr uint64_t REMOVE_TAG = UINT64_MAX;
+    static constexpr uint64_t WRITE_TAG = uint64_t(1) << 62;  // Or'ed into the fd of a POLLOUT poll
+
+    int ring_fd = -1;
+
+    void* sq_ring = MAP_FAILED;
+    size_t sq_ring_size = 0;
+    void* cq_ring = MAP_FAILED;
+    size_t cq_ring_size = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqes_size = 0;
+
+    unsigned* sq_head = nullptr;
+    unsigned* sq_tail = nullptr;
+    unsigned* sq_mask = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned sq_entries = 0;
+
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned* cq_mask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    unsigned pending = 0;  // Queued but not yet submitted
+
+    ~Uring() {
+        if (sqes) munmap(sqes, sqes_size);
+        if (cq_ring != MAP_FAILED && cq_ring != sq_ring) munmap(cq_ring, cq_ring_size);
+        if (sq_ring != MAP_FAILED) munmap(sq_ring, sq_ring_size);
+        if (ring_fd >= 0) ::close(ring_fd);
+    }
+
+    bool setup(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd < 0) {
+            return false;  // Kernel without io_uring, or disabled by policy
+        }
+
+        sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+        }
+
+        sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+        if (sq_ring == MAP_FAILED) {
+            return false;
+        }
+        cq_ring = single_mmap ? sq_ring
+                              : mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED) {
+            return false;
+        }
+
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqe_mem = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+        if (sqe_mem == MAP_FAILED) {
+            return false;
+        }
+        sqes = static_cast<io_uring_sqe*>(sqe_mem);
+
+        char* sq = static_cast<char*>(sq_ring);
+        sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sq_entries = params.sq_entries;
+
+        char* cq = static_cast<char*>(cq_ring);
+        cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    // Next free SQE, zeroed; flushes the queue first if it is full
+    io_uring_sqe* get_sqe() {
+        unsigned tail = *sq_tail;
+        if (tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= sq_entries) {
+            submit();
+            if (tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= sq_entries) {
+                return nullptr;
+            }
+        }
+        unsigned index = tail & *sq_mask;
+        sq_array[index] = index;
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    // Publish the SQE returned by get_sqe()
+    void push() {
+        __atomic_store_n(sq_tail, *sq_tail + 1, __ATOMIC_RELEASE);
+        ++pending;
+    }
+
+    void submit() {
+        if (pending == 0) return;
+        long submitted = syscall(__NR_io_uring_enter, ring_fd, pending, 0, 0, nullptr, 0);
+        if (submitted > 0) {
+            pending -= std::min(pending, static_cast<unsigned>(submitted));
+        }
+    }
+
+    bool has_completions() const {
+        return *cq_head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    }
+};
+
+#else
+
+struct EventLoop::Uring {};
+
+#endif
+
+EventLoop::EventLoop(const EventLoopConfig& config)
+    : config_(config)
+    , backend_(EventBackend::SELECT)
+    , write_watches_(0)
+    , max_fd_(0)
+    , epoll_fd_(-1)
+    , trace_dispatch_(common::Tracer::global().add_stage("net.dispatch")) {
     FD_ZERO(&readfds_);
+    FD_ZERO(&writefds_);
+    ready_.reserve(config_.max_events);
+
+    if (config_.backend == EventBackend::IO_URING && init_uring()) {
+        backend_ = EventBackend::IO_URING;
+    } else if (config_.backend != EventBackend::SELECT && init_epoll()) {
+        backend_ = EventBackend::EPOLL;
+    }
+}
+
+EventLoop::~EventLoop() {
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+    }
+}
+
+bool EventLoop::init_epoll() {
+#ifdef __linux__
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        return false;
+    }
+    epoll_events_.resize(std::max<size_t>(config_.max_events, 1));
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool EventLoop::init_uring() {
+#ifdef __linux__
+    uring_ = std::make_unique<Uring>();
+    if (!uring_->setup(config_.ring_entries)) {
+        uring_.reset();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
 }
 
-EventLoop::~EventLoop() {}
+bool EventLoop::add_socket(int sock) {
+    return add_socket(sock, ReadCallback());
+}
+
+bool EventLoop::add_socket(int sock, ReadCallback callback) {
+    if (sock < 0) return false;
+    if (static_cast<size_t>(sock) < slots_.size() && slots_[sock].registered) {
+        return false;  // Already registered
+    }
+
+    switch (backend_) {
+        case EventBackend::SELECT:
+            if (sock >= FD_SETSIZE) return false;
+            FD_SET(sock, &readfds_);
+            max_fd_ = std::max(max_fd_, sock);
+            break;
+
+        case EventBackend::EPOLL: {
+#ifdef __linux__
+            epoll_event ev;
+            std::memset(&ev, 0, sizeof(ev));
+            ev.events = EPOLLIN | (config_.edge_triggered ? EPOLLET : 0u);
+            ev.data.fd = sock;
+            if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, sock, &ev) != 0) {
+                return false;
+            }
+#endif
+            break;
+        }
+
+        case EventBackend::IO_URING:
+            break;  // Armed below, once the slot exists
+    }
 
-void EventLoop::add_socket(int sock) {
-    if (sock < 0) return;
-    
+    if (static_cast<size_t>(sock) >= slots_.size()) {
+        slots_.resize(sock + 1);
+    }
+    slots_[sock].callback = std::move(callback);
+    slots_[sock].registered = true;
+    slots_[sock].readable = false;
     sockets_.push_back(sock);
-    if (sock > max_fd_) {
-        max_fd_ = sock;
+
+    if (backend_ == EventBackend::IO_URING) {
+        arm_uring(sock);
+#ifdef __linux__
+        uring_->submit();
+#endif
     }
-    FD_SET(sock, &readfds_);
+    return true;
 }
 
 void EventLoop::remove_socket(int sock) {
     auto it = std::find(sockets_.begin(), sockets_.end(), sock);
-    if (it != sockets_.end()) {
-        sockets_.erase(it);
+    if (it == sockets_.end()) {
+        return;
+    }
+    sockets_.erase(it);
+    bool write_armed = slots_[sock].write_armed;
+    if (write_armed) {
+        --write_watches_;
+    }
+    slots_[sock] = Slot();
+
+    switch (backend_) {
+        case EventBackend::SELECT:
+            FD_CLR(sock, &readfds_);
+            FD_CLR(sock, &writefds_);
+            max_fd_ = sockets_.empty() ? 0 : *std::max_element(sockets_.begin(), sockets_.end());
+            break;
+
+        case EventBackend::EPOLL:
+#ifdef __linux__
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, sock, nullptr);
+#endif
+            break;
+
+        case EventBackend::IO_URING:
+#ifdef __linux__
+            if (io_uring_sqe* sqe = uring_->get_sqe()) {
+                sqe->opcode = IORING_OP_POLL_REMOVE;
+                sqe->fd = -1;
+                sqe->addr = static_cast<uint64_t>(sock);
+                sqe->user_data = Uring::REMOVE_TAG;
+                uring_->push();
+            }
+            if (io_uring_sqe* sqe = write_armed ? uring_->get_sqe() : nullptr) {
+                sqe->opcode = IORING_OP_POLL_REMOVE;
+                sqe->fd = -1;
+                sqe->addr = static_cast<uint64_t>(sock) | Uring::WRITE_TAG;
+                sqe->user_data = Uring::REMOVE_TAG;
+                uring_->push();
+            }
+            uring_->submit();
+#endif
+            break;
     }
-    FD_CLR(sock, &readfds_);
+}
+
+bool EventLoop::watch_writable(int sock, WriteCallback callback) {
+    if (sock < 0 || static_cast<size_t>(sock) >= slots_.size() || !slots_[sock].registered) {
+        return false;
+    }
+    Slot& slot = slots_[sock];
+    if (slot.write_armed) {
+        slot.write_callback = std::move(callback);
+        return true;
+    }
+
+    switch (backend_) {
+        case EventBackend::SELECT:
+            FD_SET(sock, &writefds_);
+            break;
+
+        case EventBackend::EPOLL:
+            if (!epoll_interest(sock, true)) {
+                return false;
+            }
+            break;
+
+        case EventBackend::IO_URING: {
+#ifdef __linux__
+            // One-shot: the completion is the whole watch
+            io_uring_sqe* sqe = uring_->get_sqe();
+            if (!sqe) {
+                return false;
+            }
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = sock;
+            sqe->poll32_events = POLLOUT;
+            sqe->user_data = static_cast<uint64_t>(sock) | Uring::WRITE_TAG;
+            uring_->push();
+            uring_->submit();
+#endif
+            break;
+        }
+    }
+
+    slot.write_callback = std::move(callback);
+    slot.write_armed = true;
+    ++write_watches_;
+    return true;
+}
+
+bool EventLoop::epoll_interest(int sock, bool write) {
+#ifdef __linux__
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | (write ? EPOLLOUT : 0u) | (config_.edge_triggered ? EPOLLET : 0u);
+    ev.data.fd = sock;
+    return epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, sock, &ev) == 0;
+#else
+    (void)sock;
+    (void)write;
+    return false;
+#endif
 }
 
 bool EventLoop::run_once(int timeout_ms) {
+    for (int sock : ready_) {
+        slots_[sock].readable = false;
+    }
+    ready_.clear();
+    writable_.clear();
+
+    bool any = false;
+    switch (backend_) {
+        case EventBackend::SELECT:   any = run_select(timeout_ms); break;
+        case EventBackend::EPOLL:    any = run_epoll(timeout_ms); break;
+        case EventBackend::IO_URING: any = run_uring(timeout_ms); break;
+    }
+
+    // Dispatch after collecting so callbacks may add or remove sockets.
+    // The callback is moved out while it runs in case slots_ reallocates.
+    for (int sock : ready_) {
+        Slot& slot = slots_[sock];
+        if (!slot.registered || !slot.callback) continue;
+
+        ReadCallback callback = std::move(slot.callback);
+        common::trace(trace_dispatch_, common::TracePhase::BEGIN);
+        callback(sock);
+        common::trace(trace_dispatch_, common::TracePhase::END);
+        if (slots_[sock].registered && !slots_[sock].callback) {
+            slots_[sock].callback = std::move(callback);
+        }
+    }
+
+    // Write watches are one-shot, so the callback is not put back
+    for (int sock : writable_) {
+        Slot& slot = slots_[sock];
+        if (!slot.registered || !slot.write_callback) continue;
+
+        WriteCallback callback = std::move(slot.write_callback);
+        common::trace(trace_dispatch_, common::TracePhase::BEGIN);
+        callback(sock);
+        common::trace(trace_dispatch_, common::TracePhase::END);
+    }
+
+    return any;
+}
+
+bool EventLoop::is_readable(int sock) const {
+    return sock >= 0 && static_cast<size_t>(sock) < slots_.size() && slots_[sock].readable;
+}
+
+void EventLoop::mark_ready(int sock) {
+    if (sock < 0 || static_cast<size_t>(sock) >= slots_.size()) return;
+    Slot& slot = slots_[sock];
+    if (!slot.registered || slot.readable) return;
+    slot.readable = true;
+    ready_.push_back(sock);
+}
+
+void EventLoop::mark_writable(int sock) {
+    if (sock < 0 || static_cast<size_t>(sock) >= slots_.size()) return;
+    Slot& slot = slots_[sock];
+    if (!slot.registered || !slot.write_armed) return;
+    slot.write_armed = false;
+    --write_watches_;
+    writable_.push_back(sock);
+
+    switch (backend_) {
+        case EventBackend::SELECT:
+            FD_CLR(sock, &writefds_);
+            break;
+        case EventBackend::EPOLL:
+            epoll_interest(sock, false);
+            break;
+        case EventBackend::IO_URING:
+            break;  // One-shot poll, already gone
+    }
+}
+
+bool EventLoop::run_select(int timeout_ms) {
     struct timeval tv;
     tv.tv_sec = timeout_ms / 1000;
     tv.tv_usec = (timeout_ms % 1000) * 1000;
-    
+
     fd_set test_set = readfds_;  // select() modifies fd_set, so copy
-    
-    int activity = select(max_fd_ + 1, &test_set, nullptr, nullptr, &tv);
-    
-    if (activity > 0) {
-        // Copy back the modified set
-        readfds_ = test_set;
-        std::cout << "[EventLoop] Socket readable" << std::endl;
-        return true;
-    } else if (activity == 0) {
-        std::cout << "[EventLoop] Timeout — no data" << std::endl;
-        return false;
-    } else {
-        std::cout << "[EventLoop] Select error" << std::endl;
-        return false;
+    fd_set write_set = writefds_;
+
+    int activity = select(max_fd_ + 1, &test_set, write_watches_ > 0 ? &write_set : nullptr, nullptr, &tv);
+    if (activity <= 0) {
+        return false;  // Timeout or error
     }
+
+    for (int sock : sockets_) {
+        if (FD_ISSET(sock, &test_set)) {
+            mark_ready(sock);
+        }
+        if (write_watches_ > 0 && FD_ISSET(sock, &write_set)) {
+            mark_writable(sock);
+        }
+    }
+    return !ready_.empty() || !writable_.empty();
 }
 
-bool EventLoop::is_readable(int sock) const {
-    return FD_ISSET(sock, &readfds_);
+bool EventLoop::run_epoll(int timeout_ms) {
+#ifdef __linux__
+    int count = epoll_wait(epoll_fd_, epoll_events_.data(),
+                           static_cast<int>(epoll_events_.size()), timeout_ms);
+    for (int i = 0; i < count; ++i) {
+        uint32_t events = epoll_events_[i].events;
+        if (events & ~static_cast<uint32_t>(EPOLLOUT)) {
+            mark_ready(epoll_events_[i].data.fd);  // Errors and hangups wake readers too
+        }
+        if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+            mark_writable(epoll_events_[i].data.fd);
+        }
+    }
+    return !ready_.empty() || !writable_.empty();
+#else
+    (void)timeout_ms;
+    return false;
+#endif
+}
+
+void EventLoop::arm_uring(int sock) {
+#ifdef __linux__
+    if (io_uring_sqe* sqe = uring_->get_sqe()) {
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = sock;
+        sqe->poll32_events = POLLIN;
+        sqe->len = IORING_POLL_ADD_MULTI;  // Re-armed below if the kernel drops it
+        sqe->user_data = static_cast<uint64_t>(sock);
+        uring_->push();
+    }
+#else
+    (void)sock;
+#endif
+}
+
+bool EventLoop::run_uring(int timeout_ms) {
+#ifdef __linux__
+    uring_->submit();
+
+    if (!uring_->has_completions()) {
+        // The ring fd polls readable once completions are posted
+        pollfd pfd{uring_->ring_fd, POLLIN, 0};
+        if (poll(&pfd, 1, timeout_ms) <= 0) {
+            return false;
+        }
+    }
+
+    // Reap every posted completion in one pass
+    unsigned head = *uring_->cq_head;
+    unsigned tail = __atomic_load_n(uring_->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        const io_uring_cqe& cqe = uring_->cqes[head & *uring_->cq_mask];
+        ++head;
+
+        if (cqe.user_data == Uring::REMOVE_TAG) continue;
+        if (cqe.user_data & Uring::WRITE_TAG) {
+            if (cqe.res != -ECANCELED) {
+                mark_writable(static_cast<int>(cqe.user_data & ~Uring::WRITE_TAG));
+            }
+            continue;
+        }
+
+        int sock = static_cast<int>(cqe.user_data);
+        if (cqe.res < 0) continue;  // Cancelled by remove_socket or failed
+
+        mark_ready(sock);
+        bool registered = static_cast<size_t>(sock) < slots_.size() && slots_[sock].registered;
+        if (registered && !(cqe.flags & IORING_CQE_F_MORE)) {
+            arm_uring(sock);
+        }
+    }
+    __atomic_store_n(uring_->cq_head, head, __ATOMIC_RELEASE);
+
+    uring_->submit();
+    return !ready_.empty() || !writable_.empty();
+#else
+    (void)timeout_ms;
+    return false;
+#endif
 }
 
 } // namespace net
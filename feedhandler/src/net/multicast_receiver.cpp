@@ -0,0 +1,275 @@
+#include "net/multicast_receiver.hpp"
+#include "net/rx_timestamp.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace feedhandler {
+namespace net {
+
+SequenceRange fix_sequence_range(const char* data, size_t length) {
+    SequenceRange range;
+    for (size_t pos = 0; pos + 3 < length; ++pos) {
+        bool field_start = pos == 0 || data[pos - 1] == '|' || data[pos - 1] == '\x01';
+        if (!field_start || data[pos] != '3' || data[pos + 1] != '4' || data[pos + 2] != '=') {
+            continue;
+        }
+        uint64_t sequence = 0;
+        size_t i = pos + 3;
+        for (; i < length && data[i] >= '0' && data[i] <= '9'; ++i) {
+            sequence = sequence * 10 + static_cast<uint64_t>(data[i] - '0');
+        }
+        if (sequence != 0) {
+            if (range.first == 0) {
+                range.first = sequence;
+            }
+            range.last = sequence;
+        }
+        pos = i;
+    }
+    return range;
+}
+
+// Preallocated recvmmsg state for one line
+struct MulticastReceiver::Batch {
+    std::vector<char> storage;
+    std::vector<char> control;
+    std::vector<iovec> iov;
+    std::vector<mmsghdr> headers;
+    std::vector<uint64_t> timestamps;
+    std::vector<SequenceRange> sequences;
+
+    Batch(size_t batch_size, size_t max_datagram)
+        : storage(batch_size * max_datagram)
+        , control(batch_size * RX_TIMESTAMP_CONTROL_SIZE)
+        , iov(batch_size)
+        , headers(batch_size)
+        , timestamps(batch_size)
+        , sequences(batch_size) {
+        for (size_t i = 0; i < batch_size; ++i) {
+            iov[i].iov_base = storage.data() + i * max_datagram;
+            iov[i].iov_len = max_datagram;
+        }
+    }
+
+    const char* payload(size_t i) const { return static_cast<const char*>(iov[i].iov_base); }
+    size_t length(size_t i) const { return headers[i].msg_len; }
+};
+
+MulticastReceiver::MulticastReceiver() : MulticastReceiver(MulticastReceiverConfig()) {
+}
+
+MulticastReceiver::MulticastReceiver(const MulticastReceiverConfig& config)
+    : config_(config)
+    , fds_{-1, -1}
+    , next_sequence_(0) {
+    config_.batch_size = std::max<size_t>(config_.batch_size, 1);
+    config_.max_datagram = std::max<size_t>(config_.max_datagram, 64);
+    if (!config_.sequence) {
+        config_.sequence = fix_sequence_range;
+    }
+}
+
+MulticastReceiver::~MulticastReceiver() {
+    close();
+}
+
+int MulticastReceiver::open_line(const MulticastLine& line) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(line.port);
+    if (inet_pton(AF_INET, line.group.c_str(), &addr.sin_addr) != 1) {
+        std::cerr << "Invalid multicast group: " << line.group << std::endl;
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &config_.socket_buffer_bytes, sizeof(config_.socket_buffer_bytes));
+
+    // Binding to the group address keeps lines sharing a port apart
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cerr << "Failed to bind " << line.group << ":" << line.port << ": " << strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
+
+    if (IN_MULTICAST(ntohl(addr.sin_addr.s_addr))) {
+        ip_mreq membership{};
+        membership.imr_multiaddr = addr.sin_addr;
+        if (inet_pton(AF_INET, config_.interface_address.c_str(), &membership.imr_interface) != 1) {
+            membership.imr_interface.s_addr = htonl(INADDR_ANY);
+        }
+        if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+            std::cerr << "Failed to join " << line.group << ": " << strerror(errno) << std::endl;
+            ::close(fd);
+            return -1;
+        }
+    }
+
+    if (config_.timestamping) {
+        enable_rx_timestamping(fd);
+    }
+    return fd;
+}
+
+bool MulticastReceiver::open() {
+    close();
+
+    fds_[0] = open_line(config_.line_a);
+    if (fds_[0] < 0) {
+        return false;
+    }
+    if (!config_.line_b.group.empty()) {
+        fds_[1] = open_line(config_.line_b);
+        if (fds_[1] < 0) {
+            close();
+            return false;
+        }
+    }
+
+    for (int line = 0; line < 2; ++line) {
+        if (fds_[line] >= 0) {
+            batches_[line] = std::make_unique<Batch>(config_.batch_size, config_.max_datagram);
+        }
+    }
+    pending_.reset(new Pending[config_.batch_size * 2]);
+    next_sequence_ = 0;
+    return true;
+}
+
+void MulticastReceiver::close() {
+    for (int line = 0; line < 2; ++line) {
+        if (fds_[line] >= 0) {
+            ::close(fds_[line]);
+            fds_[line] = -1;
+        }
+        batches_[line].reset();
+    }
+}
+
+uint16_t MulticastReceiver::local_port(int line) const {
+    sockaddr_in addr{};
+    socklen_t length = sizeof(addr);
+    if (fds_[line] < 0 || getsockname(fds_[line], reinterpret_cast<sockaddr*>(&addr), &length) != 0) {
+        return 0;
+    }
+    return ntohs(addr.sin_port);
+}
+
+size_t MulticastReceiver::receive(int line) {
+    Batch& batch = *batches_[line];
+    for (size_t i = 0; i < config_.batch_size; ++i) {
+        msghdr& msg = batch.headers[i].msg_hdr;
+        msg = msghdr{};
+        msg.msg_iov = &batch.iov[i];
+        msg.msg_iovlen = 1;
+        msg.msg_control = batch.control.data() + i * RX_TIMESTAMP_CONTROL_SIZE;
+        msg.msg_controllen = RX_TIMESTAMP_CONTROL_SIZE;
+    }
+
+    int received = recvmmsg(fds_[line], batch.headers.data(), static_cast<unsigned int>(config_.batch_size),
+                            MSG_DONTWAIT, nullptr);
+    if (received <= 0) {
+        if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            std::cerr << "Multicast receive failed: " << strerror(errno) << std::endl;
+        }
+        return 0;
+    }
+
+    uint64_t fallback = 0;
+    for (int i = 0; i < received; ++i) {
+        msghdr& msg = batch.headers[i].msg_hdr;
+        if (msg.msg_flags & MSG_TRUNC) {
+            stats_.truncated++;
+        }
+
+        RxTimestampSource source;
+        uint64_t timestamp = read_rx_timestamp(msg, source);
+        if (source == RxTimestampSource::HARDWARE) {
+            stats_.hardware_timestamps++;
+        } else if (source == RxTimestampSource::SOFTWARE) {
+            stats_.software_timestamps++;
+        }
+        if (timestamp == 0) {
+            if (fallback == 0) {
+                fallback = realtime_ns();  // One clock read per batch
+            }
+            timestamp = fallback;
+        }
+
+        batch.timestamps[i] = timestamp;
+        batch.sequences[i] = config_.sequence(batch.payload(i), batch.length(i));
+    }
+
+    stats_.datagrams[line] += static_cast<uint64_t>(received);
+    return static_cast<size_t>(received);
+}
+
+size_t MulticastReceiver::poll(const PayloadCallback& callback) {
+    if (!is_open()) {
+        return 0;
+    }
+
+    // Gather both lines, then merge by sequence (stable: line A wins ties)
+    size_t count = 0;
+    for (uint32_t line = 0; line < 2; ++line) {
+        if (fds_[line] < 0) {
+            continue;
+        }
+        size_t received = receive(static_cast<int>(line));
+        for (size_t i = 0; i < received; ++i) {
+            pending_[count++] = {batches_[line]->sequences[i].first, line, static_cast<uint32_t>(i)};
+        }
+    }
+    for (size_t i = 1; i < count; ++i) {
+        Pending item = pending_[i];
+        size_t j = i;
+        for (; j > 0 && pending_[j - 1].sequence > item.sequence; --j) {
+            pending_[j] = pending_[j - 1];
+        }
+        pending_[j] = item;
+    }
+
+    size_t delivered = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const Batch& batch = *batches_[pending_[i].line];
+        size_t index = pending_[i].index;
+        SequenceRange range = batch.sequences[index];
+
+        if (range.first != 0) {
+            if (next_sequence_ != 0 && range.last < next_sequence_) {
+                stats_.duplicates++;
+                continue;
+            }
+            if (next_sequence_ != 0 && range.first > next_sequence_) {
+                stats_.gaps++;
+                stats_.missing_messages += range.first - next_sequence_;
+            }
+            next_sequence_ = range.last + 1;
+        }
+
+        callback(batch.payload(index), batch.length(index), batch.timestamps[index]);
+        stats_.delivered++;
+        ++delivered;
+    }
+    return delivered;
+}
+
+} // namespace net
+} // namespace feedhandler
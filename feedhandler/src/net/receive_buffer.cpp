@@ -1,20 +1,114 @@
 #include "net/receive_buffer.hpp"
 #include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace feedhandler {
 namespace net {
 
-ReceiveBuffer::ReceiveBuffer() : write_pos_(0), read_pos_(0) {
-    memset(buffer_, 0, BUFFER_SIZE);
+ReceiveBuffer::ReceiveBuffer() : ReceiveBuffer(ReceiveBufferConfig()) {
+}
+
+ReceiveBuffer::ReceiveBuffer(const ReceiveBufferConfig& config)
+    : buffer_(nullptr)
+    , capacity_(0)
+    , mirrored_(false)
+    , arena_backed_(false)
+    , write_pos_(0)
+    , read_pos_(0)
+    , compactions_(0)
+    , receive_timestamp_(0) {
+    size_t capacity = std::max<size_t>(config.capacity, 64);
+    
+    if (config.mode == ReceiveBufferMode::MIRRORED && map_mirrored(capacity)) {
+        mirrored_ = true;
+    } else {
+        allocate_linear(capacity, config.arena);
+        memset(buffer_, 0, capacity_);
+    }
+}
+
+ReceiveBuffer::~ReceiveBuffer() {
+#ifdef __linux__
+    if (mirrored_) {
+        munmap(buffer_, capacity_ * 2);
+        return;
+    }
+#endif
+    if (!arena_backed_) {
+        std::free(buffer_);
+    }
+}
+
+bool ReceiveBuffer::map_mirrored(size_t capacity) {
+#ifdef __linux__
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t size = (capacity + page - 1) / page * page;
+    
+    int fd = memfd_create("receive_buffer", MFD_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return false;
+    }
+    
+    // Reserve 2 * size of address space, then map the file into both halves
+    void* base = mmap(nullptr, size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    
+    char* lower = static_cast<char*>(base);
+    bool mapped =
+        mmap(lower, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+        mmap(lower + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    close(fd);  // Mappings keep the pages alive
+    
+    if (!mapped) {
+        munmap(base, size * 2);
+        return false;
+    }
+    
+    buffer_ = lower;
+    capacity_ = size;
+    return true;
+#else
+    (void)capacity;
+    return false;
+#endif
+}
+
+void ReceiveBuffer::allocate_linear(size_t capacity, common::ZeroLatencyAllocator::Arena* arena) {
+    capacity_ = (capacity + 63) / 64 * 64;
+    
+    if (arena) {
+        buffer_ = static_cast<char*>(arena->allocate(capacity_, 64));
+        if (buffer_) {
+            arena_backed_ = true;
+            return;
+        }
+    }
+    
+    buffer_ = static_cast<char*>(std::aligned_alloc(64, capacity_));
+    if (!buffer_) {
+        throw std::bad_alloc();
+    }
 }
 
-size_t ReceiveBuffer::write(const char* data, size_t len) {
-    size_t available = BUFFER_SIZE - write_pos_;
-    size_t to_write = std::min(len, available);
+size_t ReceiveBuffer::write(const char* data, size_t len, uint64_t timestamp_ns) {
+    size_t to_write = std::min(len, available_write());
     
     if (to_write > 0) {
         memcpy(buffer_ + write_pos_, data, to_write);
-        write_pos_ += to_write;
+        advance_write(to_write, timestamp_ns);
     }
     
     return to_write;
@@ -27,25 +121,47 @@ size_t ReceiveBuffer::readable_bytes() const {
 void ReceiveBuffer::consume(size_t len) {
     read_pos_ += std::min(len, readable_bytes());
     
-    // Compact buffer when read_pos_ is far ahead
-    if (read_pos_ > BUFFER_SIZE / 2) {
-        size_t remaining = write_pos_ - read_pos_;
-        if (remaining > 0) {
-            memmove(buffer_, buffer_ + read_pos_, remaining);
+    if (mirrored_) {
+        // Both cursors drop into the lower mapping; the bytes stay put
+        if (read_pos_ >= capacity_) {
+            read_pos_ -= capacity_;
+            write_pos_ -= capacity_;
         }
-        write_pos_ = remaining;
-        read_pos_ = 0;
+        return;
+    }
+    
+    // Compact buffer when read_pos_ is far ahead
+    if (read_pos_ > capacity_ / 2) {
+        compact();
     }
 }
 
+void ReceiveBuffer::compact() {
+    if (mirrored_) {
+        return;
+    }
+    
+    size_t remaining = write_pos_ - read_pos_;
+    if (remaining > 0 && read_pos_ > 0) {
+        memmove(buffer_, buffer_ + read_pos_, remaining);
+        ++compactions_;
+    }
+    write_pos_ = remaining;
+    read_pos_ = 0;
+}
+
 bool ReceiveBuffer::has_space() const {
-    return write_pos_ < BUFFER_SIZE;
+    return available_write() > 0;
 }
 
 void ReceiveBuffer::reset() {
     write_pos_ = 0;
     read_pos_ = 0;
-    memset(buffer_, 0, BUFFER_SIZE);
+    compactions_ = 0;
+    receive_timestamp_ = 0;
+    if (!mirrored_) {
+        memset(buffer_, 0, capacity_);
+    }
 }
 
 } // namespace net
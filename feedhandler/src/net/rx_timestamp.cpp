@@ -0,0 +1,75 @@
+#include "net/rx_timestamp.hpp"
+
+#include <cstring>
+#include <ctime>
+
+#include <sys/socket.h>
+
+#ifdef __linux__
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#endif
+
+namespace feedhandler {
+namespace net {
+
+namespace {
+
+uint64_t to_ns(const timespec& ts) {
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+} // namespace
+
+bool enable_rx_timestamping(int fd) {
+#ifdef __linux__
+    int flags = SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE |
+                SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0) {
+        return true;
+    }
+    int one = 1;
+    return setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &one, sizeof(one)) == 0;
+#else
+    (void)fd;
+    return false;
+#endif
+}
+
+uint64_t read_rx_timestamp(const msghdr& msg, RxTimestampSource& source) {
+    source = RxTimestampSource::NONE;
+    uint64_t timestamp = 0;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&msg), cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+#ifdef __linux__
+        if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            scm_timestamping stamps;
+            std::memcpy(&stamps, CMSG_DATA(cmsg), sizeof(stamps));
+            if (stamps.ts[2].tv_sec != 0 || stamps.ts[2].tv_nsec != 0) {
+                timestamp = to_ns(stamps.ts[2]);  // Raw hardware
+                source = RxTimestampSource::HARDWARE;
+            } else if (stamps.ts[0].tv_sec != 0 || stamps.ts[0].tv_nsec != 0) {
+                timestamp = to_ns(stamps.ts[0]);
+                source = RxTimestampSource::SOFTWARE;
+            }
+        } else if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec ts;
+            std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            timestamp = to_ns(ts);
+            source = RxTimestampSource::SOFTWARE;
+        }
+#endif
+    }
+    return timestamp;
+}
+
+uint64_t realtime_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return to_ns(ts);
+}
+
+} // namespace net
+} // namespace feedhandler
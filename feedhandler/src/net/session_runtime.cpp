@@ -0,0 +1,340 @@
+#include "net/session_runtime.hpp"
+#include "net/receive_buffer.hpp"
+#include "net/tcp_client.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <iostream>
+
+namespace feedhandler {
+namespace net {
+
+namespace {
+
+bool pin_current_thread(int cpu) {
+#ifdef __linux__
+    if (cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Milliseconds to wait for a deadline, rounded up so the timer that ends
+// the wait never fires before it; 0 once it has passed
+int remaining_ms(SessionRuntime::Clock::time_point deadline) {
+    auto left = deadline - SessionRuntime::Clock::now();
+    if (left <= SessionRuntime::Clock::duration::zero()) {
+        return 0;
+    }
+    return static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(left).count());
+}
+
+} // namespace
+
+SessionRuntime::SessionRuntime() : SessionRuntime(SessionRuntimeConfig{}) {
+}
+
+SessionRuntime::SessionRuntime(const SessionRuntimeConfig& config)
+    : config_(config)
+    , loop_(config.loop)
+    , stop_(false)
+    , pinned_(false) {
+}
+
+SessionRuntime::~SessionRuntime() {
+    // Frames own their nested tasks, which go with them
+    timers_.clear();
+    std::vector<std::coroutine_handle<>> sessions = std::move(sessions_);
+    for (std::coroutine_handle<> session : sessions) {
+        session.destroy();
+    }
+}
+
+void SessionRuntime::spawn(Task<> session) {
+    Task<>::Handle handle = session.release();
+    if (!handle) {
+        return;
+    }
+    handle.promise().finished = &finished_;
+    sessions_.push_back(handle);
+    ++stats_.spawned;
+    handle.resume();
+    reap_finished();
+}
+
+size_t SessionRuntime::run_once(int max_wait_ms) {
+    loop_.run_once(next_timeout(max_wait_ms));
+
+    Clock::time_point now = Clock::now();
+    while (!timers_.empty() && timers_.begin()->first <= now) {
+        Waiter& waiter = *timers_.begin()->second;
+        timers_.erase(timers_.begin());
+        waiter.timed = false;
+        if (waiter.kind != WaitKind::SLEEP) {
+            ++stats_.timeouts;
+        }
+        wake(waiter, true);
+    }
+
+    size_t resumed = resume_runnable();
+    reap_finished();
+    return resumed;
+}
+
+void SessionRuntime::run() {
+    if (config_.cpu >= 0) {
+        pinned_ = pin_current_thread(config_.cpu);
+        if (!pinned_) {
+            std::cerr << "Failed to pin session runtime to CPU " << config_.cpu << std::endl;
+        }
+    }
+    while (!sessions_.empty() && !stop_.load(std::memory_order_relaxed)) {
+        run_once();
+    }
+    stop_.store(false, std::memory_order_relaxed);
+}
+
+void SessionRuntime::forget(int fd) {
+    if (fd < 0 || static_cast<size_t>(fd) >= sockets_.size() || !sockets_[fd].watched) {
+        return;
+    }
+    Socket& socket = sockets_[fd];
+    if (socket.reader) {
+        wake(*socket.reader, true);
+    }
+    if (socket.writer) {
+        wake(*socket.writer, true);
+    }
+    socket = Socket();
+    loop_.remove_socket(fd);
+}
+
+bool SessionRuntime::ready_now(Waiter& waiter) {
+    if (waiter.kind == WaitKind::SLEEP) {
+        waiter.timed_out = true;
+        return false;
+    }
+    if (!watch(waiter.fd)) {
+        waiter.timed_out = true;
+        return true;  // Fails at once rather than never waking
+    }
+
+    Socket& socket = sockets_[waiter.fd];
+    Waiter* current = waiter.kind == WaitKind::READ ? socket.reader : socket.writer;
+    if (current) {
+        std::cerr << "Socket " << waiter.fd << " already has a session waiting" << std::endl;
+        waiter.timed_out = true;
+        return true;
+    }
+    if (waiter.kind == WaitKind::READ && socket.read_ready) {
+        socket.read_ready = false;
+        return true;
+    }
+    return false;
+}
+
+void SessionRuntime::suspend(Waiter& waiter, int timeout_ms) {
+    if (waiter.kind == WaitKind::READ) {
+        sockets_[waiter.fd].reader = &waiter;
+    } else if (waiter.kind == WaitKind::WRITE) {
+        sockets_[waiter.fd].writer = &waiter;
+        if (!loop_.watch_writable(waiter.fd, [this](int fd) { on_writable(fd); })) {
+            wake(waiter, true);
+            return;
+        }
+    }
+    if (timeout_ms >= 0) {
+        waiter.timer = timers_.emplace(Clock::now() + std::chrono::milliseconds(timeout_ms), &waiter);
+        waiter.timed = true;
+    }
+}
+
+bool SessionRuntime::watch(int fd) {
+    if (fd < 0) {
+        return false;
+    }
+    if (static_cast<size_t>(fd) >= sockets_.size()) {
+        sockets_.resize(fd + 1);
+    }
+    if (sockets_[fd].watched) {
+        return true;
+    }
+    if (!loop_.add_socket(fd, [this](int sock) { on_readable(sock); })) {
+        std::cerr << "Cannot watch socket " << fd << std::endl;
+        return false;
+    }
+    sockets_[fd].watched = true;
+    return true;
+}
+
+void SessionRuntime::wake(Waiter& waiter, bool timed_out) {
+    if (waiter.timed) {
+        timers_.erase(waiter.timer);
+        waiter.timed = false;
+    }
+    if (waiter.kind != WaitKind::SLEEP) {
+        Socket& socket = sockets_[waiter.fd];
+        (waiter.kind == WaitKind::READ ? socket.reader : socket.writer) = nullptr;
+    }
+    waiter.timed_out = timed_out;
+    runnable_.push_back(waiter.handle);
+}
+
+void SessionRuntime::on_readable(int fd) {
+    Socket& socket = sockets_[fd];
+    if (socket.reader) {
+        wake(*socket.reader, false);
+    } else {
+        socket.read_ready = true;
+    }
+}
+
+void SessionRuntime::on_writable(int fd) {
+    Socket& socket = sockets_[fd];
+    if (socket.writer) {
+        wake(*socket.writer, false);
+    }
+}
+
+int SessionRuntime::next_timeout(int max_wait_ms) const {
+    if (!runnable_.empty()) {
+        return 0;  // Woken outside the loop (forget(), failed watches)
+    }
+    if (timers_.empty()) {
+        return max_wait_ms;
+    }
+    return std::min(max_wait_ms, remaining_ms(timers_.begin()->first));
+}
+
+size_t SessionRuntime::resume_runnable() {
+    // Sessions woken while these run wait for the next cycle
+    resuming_.swap(runnable_);
+    for (std::coroutine_handle<> handle : resuming_) {
+        ++stats_.resumes;
+        handle.resume();
+    }
+    size_t resumed = resuming_.size();
+    resuming_.clear();
+    return resumed;
+}
+
+void SessionRuntime::reap_finished() {
+    for (std::coroutine_handle<> done : finished_) {
+        auto it = std::find(sessions_.begin(), sessions_.end(), done);
+        if (it != sessions_.end()) {
+            *it = sessions_.back();
+            sessions_.pop_back();
+        }
+
+        std::exception_ptr exception = Task<>::Handle::from_address(done.address()).promise().exception;
+        if (exception) {
+            ++stats_.failed;
+            try {
+                std::rethrow_exception(exception);
+            } catch (const std::exception& e) {
+                std::cerr << "Session failed: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "Session failed" << std::endl;
+            }
+        }
+        ++stats_.finished;
+        done.destroy();
+    }
+    finished_.clear();
+}
+
+Task<bool> async_connect(SessionRuntime& runtime, TcpClient& client, std::string host, int port,
+                         int timeout_ms) {
+    async_close(runtime, client);
+    if (!client.start_connect(host, port)) {
+        co_return false;
+    }
+    if (client.is_connecting() && !co_await runtime.writable(client.fd(), timeout_ms)) {
+        std::cerr << "Failed to connect to " << host << ":" << port << " - timed out" << std::endl;
+        async_close(runtime, client);
+        co_return false;
+    }
+
+    int fd = client.fd();
+    if (!client.finish_connect()) {
+        runtime.forget(fd);  // Closed by finish_connect()
+        co_return false;
+    }
+    co_return true;
+}
+
+Task<ssize_t> async_read(SessionRuntime& runtime, TcpClient& client, ReceiveBuffer& buffer, int timeout_ms) {
+    SessionRuntime::Clock::time_point deadline =
+        SessionRuntime::Clock::now() + std::chrono::milliseconds(std::max(timeout_ms, 0));
+    while (true) {
+        int fd = client.fd();
+        ssize_t received = client.recv_into(buffer, MSG_DONTWAIT);
+        if (received > 0) {
+            co_return received;
+        }
+        if (received < 0) {
+            runtime.forget(fd);  // recv_into() closed it
+            co_return -1;
+        }
+        if (buffer.available_write() == 0) {
+            co_return 0;  // Full: the parser has to consume first
+        }
+
+        int wait_ms = -1;
+        if (timeout_ms >= 0) {
+            wait_ms = remaining_ms(deadline);
+            if (wait_ms == 0) {
+                co_return 0;
+            }
+        }
+        if (!co_await runtime.readable(fd, wait_ms)) {
+            co_return timeout_ms >= 0 && SessionRuntime::Clock::now() >= deadline ? 0 : -1;
+        }
+    }
+}
+
+Task<bool> async_flush(SessionRuntime& runtime, TcpClient& client, int timeout_ms) {
+    SessionRuntime::Clock::time_point deadline =
+        SessionRuntime::Clock::now() + std::chrono::milliseconds(std::max(timeout_ms, 0));
+    while (client.has_pending_send()) {
+        int fd = client.fd();
+        if (!client.flush()) {
+            if (!client.is_connected()) {
+                runtime.forget(fd);  // flush() closed it
+            }
+            co_return false;
+        }
+        if (!client.has_pending_send()) {
+            break;
+        }
+
+        int wait_ms = -1;
+        if (timeout_ms >= 0) {
+            wait_ms = remaining_ms(deadline);
+            if (wait_ms == 0) {
+                co_return false;
+            }
+        }
+        if (!co_await runtime.writable(fd, wait_ms)) {
+            co_return false;
+        }
+    }
+    co_return true;
+}
+
+void async_close(SessionRuntime& runtime, TcpClient& client) {
+    runtime.forget(client.fd());
+    client.close();
+}
+
+} // namespace net
+} // namespace feedhandler
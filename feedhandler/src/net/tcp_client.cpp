@@ -1,17 +1,48 @@
 #include "net/tcp_client.hpp"
+#include "net/receive_buffer.hpp"
+#include "net/rx_timestamp.hpp"
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <poll.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <iostream>
 
 namespace feedhandler {
 namespace net {
 
-TcpClient::TcpClient() : socket_fd_(-1), connected_(false) {
+namespace {
+
+// Gather entries per sendmsg(); well under IOV_MAX
+constexpr size_t MAX_IOV = 64;
+
+size_t send_ring_size(size_t bytes) {
+    return std::bit_ceil(std::max<size_t>(bytes, 4096));
+}
+
+} // namespace
+
+TcpClient::TcpClient() : TcpClient(TcpClientConfig{}) {
+}
+
+TcpClient::TcpClient(const TcpClientConfig& config)
+    : config_(config)
+    , socket_fd_(-1)
+    , connected_(false)
+    , connecting_(false)
+    , timestamping_(false)
+    , nonblocking_(false)
+    , send_ring_(send_ring_size(config.send_ring_bytes)) {
 }
 
 TcpClient::~TcpClient() {
@@ -19,6 +50,80 @@ TcpClient::~TcpClient() {
 }
 
 bool TcpClient::connect(const std::string& host, int port) {
+    struct sockaddr_in server_addr;
+    if (!open_socket(host, port, &server_addr)) {
+        return false;
+    }
+    
+    // Connect
+    bool ok = config_.connect_timeout_ms > 0
+        ? connect_with_timeout(&server_addr, sizeof(server_addr))
+        : ::connect(socket_fd_, (struct sockaddr*)&server_addr, sizeof(server_addr)) == 0;
+    if (!ok) {
+        std::cerr << "Failed to connect to " << host << ":" << port 
+                  << " - " << strerror(errno) << std::endl;
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+        return false;
+    }
+    
+    connected_ = true;
+    // A timed connect left the socket non-blocking
+    if (!set_nonblocking(config_.nonblocking)) {
+        std::cerr << "Failed to set socket mode: " << strerror(errno) << std::endl;
+    }
+    std::cout << "Connected to " << host << ":" << port << std::endl;
+    return true;
+}
+
+bool TcpClient::start_connect(const std::string& host, int port) {
+    struct sockaddr_in server_addr;
+    if (!open_socket(host, port, &server_addr)) {
+        return false;
+    }
+    if (!set_nonblocking(true)) {
+        std::cerr << "Failed to set socket mode: " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+    
+    if (::connect(socket_fd_, (struct sockaddr*)&server_addr, sizeof(server_addr)) == 0) {
+        connected_ = true;  // Loopback may finish at once
+        return true;
+    }
+    if (errno != EINPROGRESS) {
+        std::cerr << "Failed to connect to " << host << ":" << port 
+                  << " - " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+    connecting_ = true;
+    return true;
+}
+
+bool TcpClient::finish_connect() {
+    if (socket_fd_ < 0) {
+        return false;
+    }
+    if (!connecting_) {
+        return connected_;
+    }
+    connecting_ = false;
+    
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(socket_fd_, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0) {
+        std::cerr << "Failed to connect: " << strerror(error != 0 ? error : errno) << std::endl;
+        close();
+        return false;
+    }
+    connected_ = true;
+    return true;
+}
+
+bool TcpClient::open_socket(const std::string& host, int port, sockaddr_in* server_addr) {
+    close();
+    
     // Create socket
     socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
     if (socket_fd_ < 0) {
@@ -36,46 +141,222 @@ bool TcpClient::connect(const std::string& host, int port) {
     }
     
     // Setup server address
-    struct sockaddr_in server_addr;
-    std::memset(&server_addr, 0, sizeof(server_addr));
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(port);
-    std::memcpy(&server_addr.sin_addr.s_addr, server->h_addr, server->h_length);
+    std::memset(server_addr, 0, sizeof(*server_addr));
+    server_addr->sin_family = AF_INET;
+    server_addr->sin_port = htons(port);
+    std::memcpy(&server_addr->sin_addr.s_addr, server->h_addr, server->h_length);
     
-    // Connect
-    if (::connect(socket_fd_, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
-        std::cerr << "Failed to connect to " << host << ":" << port 
-                  << " - " << strerror(errno) << std::endl;
-        ::close(socket_fd_);
-        socket_fd_ = -1;
+    apply_socket_options();
+    return true;
+}
+
+bool TcpClient::send(const std::string& data) {
+    return send(data.data(), data.length());
+}
+
+bool TcpClient::send(const char* data, size_t length) {
+    if (!connected_ || socket_fd_ < 0) {
+        std::cerr << "Not connected" << std::endl;
         return false;
     }
+    send_stats_.messages++;
     
-    connected_ = true;
-    std::cout << "Connected to " << host << ":" << port << std::endl;
+    if (nonblocking_) {
+        // Accept only what the ring could hold if the kernel took nothing,
+        // so a message is never half sent and half dropped
+        if (length > send_ring_.size() - pending_send_bytes()) {
+            send_stats_.ring_full++;
+            return false;
+        }
+        if (has_pending_send()) {
+            append_to_ring(data, length);
+            return flush();
+        }
+    } else if (has_pending_send() && !flush()) {
+        return false;
+    }
+    
+    iovec iov{const_cast<char*>(data), length};
+    ssize_t written = write_vectored(&iov, 1, length);
+    if (written < 0) {
+        return false;
+    }
+    if (static_cast<size_t>(written) < length) {
+        if (!nonblocking_) {
+            std::cerr << "Partial send: " << written << "/" << length << " bytes" << std::endl;
+            return false;
+        }
+        append_to_ring(data + written, length - static_cast<size_t>(written));
+    }
     return true;
 }
 
-bool TcpClient::send(const std::string& data) {
+bool TcpClient::send(std::span<const std::string_view> messages) {
     if (!connected_ || socket_fd_ < 0) {
         std::cerr << "Not connected" << std::endl;
         return false;
     }
     
-    ssize_t bytes_sent = ::send(socket_fd_, data.c_str(), data.length(), 0);
-    if (bytes_sent < 0) {
-        std::cerr << "Send failed: " << strerror(errno) << std::endl;
+    size_t total = 0;
+    for (std::string_view message : messages) {
+        total += message.size();
+    }
+    if (nonblocking_ && total > send_ring_.size() - pending_send_bytes()) {
+        send_stats_.ring_full++;
+        return false;
+    }
+    send_stats_.messages += messages.size();
+    
+    if (nonblocking_ && has_pending_send()) {
+        for (std::string_view message : messages) {
+            append_to_ring(message.data(), message.size());
+        }
+        return flush();
+    }
+    if (!nonblocking_ && has_pending_send() && !flush()) {
         return false;
     }
     
-    if (static_cast<size_t>(bytes_sent) != data.length()) {
-        std::cerr << "Partial send: " << bytes_sent << "/" << data.length() << " bytes" << std::endl;
+    size_t index = 0;
+    while (index < messages.size()) {
+        iovec iov[MAX_IOV];
+        size_t count = 0;
+        size_t bytes = 0;
+        for (; count < MAX_IOV && index + count < messages.size(); ++count) {
+            std::string_view message = messages[index + count];
+            iov[count] = {const_cast<char*>(message.data()), message.size()};
+            bytes += message.size();
+        }
+        
+        ssize_t written = write_vectored(iov, count, bytes);
+        if (written < 0) {
+            return false;
+        }
+        if (static_cast<size_t>(written) < bytes) {
+            if (!nonblocking_) {
+                std::cerr << "Partial send: " << written << "/" << bytes << " bytes" << std::endl;
+                return false;
+            }
+            
+            // Socket buffer full: the rest of this batch and every later
+            // message wait in the ring
+            size_t skip = static_cast<size_t>(written);
+            for (size_t i = index; i < messages.size(); ++i) {
+                std::string_view message = messages[i];
+                if (skip >= message.size()) {
+                    skip -= message.size();
+                    continue;
+                }
+                append_to_ring(message.data() + skip, message.size() - skip);
+                skip = 0;
+            }
+            return true;
+        }
+        index += count;
+    }
+    return true;
+}
+
+bool TcpClient::queue(const char* data, size_t length) {
+    if (!connected_ || socket_fd_ < 0) {
+        std::cerr << "Not connected" << std::endl;
+        return false;
+    }
+    send_stats_.messages++;
+    return enqueue(data, length);
+}
+
+bool TcpClient::flush() {
+    if (!connected_ || socket_fd_ < 0) {
         return false;
     }
     
+    const size_t mask = send_ring_.size() - 1;
+    while (has_pending_send()) {
+        size_t pending = pending_send_bytes();
+        size_t head = send_head_ & mask;
+        size_t first = std::min(pending, send_ring_.size() - head);
+        
+        // The queued bytes wrap at most once: two gather entries
+        iovec iov[2] = {{&send_ring_[head], first}, {send_ring_.data(), pending - first}};
+        ssize_t written = write_vectored(iov, pending > first ? 2 : 1, pending);
+        if (written < 0) {
+            return false;
+        }
+        send_head_ += static_cast<size_t>(written);
+        if (static_cast<size_t>(written) < pending) {
+            break;  // Would block; the rest goes with the next flush()
+        }
+    }
+    
+    if (!has_pending_send()) {
+        send_head_ = send_tail_ = 0;
+    }
+    return true;
+}
+
+bool TcpClient::enqueue(const char* data, size_t length) {
+    if (length > send_ring_.size() - pending_send_bytes()) {
+        send_stats_.ring_full++;
+        return false;
+    }
+    append_to_ring(data, length);
     return true;
 }
 
+void TcpClient::append_to_ring(const char* data, size_t length) {
+    size_t tail = send_tail_ & (send_ring_.size() - 1);
+    size_t first = std::min(length, send_ring_.size() - tail);
+    std::memcpy(&send_ring_[tail], data, first);
+    std::memcpy(send_ring_.data(), data + first, length - first);
+    send_tail_ += length;
+}
+
+ssize_t TcpClient::write_vectored(iovec* iov, size_t count, size_t total) {
+    size_t written = 0;
+    while (written < total) {
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        
+        // sendmsg() rather than writev() for MSG_NOSIGNAL
+        ssize_t n = ::sendmsg(socket_fd_, &msg, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                send_stats_.would_block++;
+                break;
+            }
+            std::cerr << "Send failed: " << strerror(errno) << std::endl;
+            close();
+            return -1;
+        }
+        
+        send_stats_.syscalls++;
+        send_stats_.bytes += static_cast<uint64_t>(n);
+        written += static_cast<size_t>(n);
+        if (written < total && nonblocking_) {
+            send_stats_.would_block++;  // Short write: the socket buffer is full
+            break;
+        }
+        
+        // Blocking short write (a signal): skip what went out and go on
+        size_t skip = static_cast<size_t>(n);
+        while (count > 0 && skip >= iov->iov_len) {
+            skip -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + skip;
+            iov->iov_len -= skip;
+        }
+    }
+    return static_cast<ssize_t>(written);
+}
+
 std::string TcpClient::recv(size_t max_bytes) {
     if (!connected_ || socket_fd_ < 0) {
         std::cerr << "Not connected" << std::endl;
@@ -100,12 +381,182 @@ std::string TcpClient::recv(size_t max_bytes) {
     return buffer;
 }
 
+ssize_t TcpClient::recv_into(ReceiveBuffer& buffer, int flags) {
+    if (!connected_ || socket_fd_ < 0) {
+        return -1;
+    }
+    
+    if (buffer.available_write() == 0) {
+        buffer.compact();
+        if (buffer.available_write() == 0) {
+            return 0;  // Parser has not consumed anything yet
+        }
+    }
+    
+    ssize_t bytes_received;
+    uint64_t timestamp = 0;
+    if (timestamping_) {
+        // recvmsg() so the kernel can hand over the segment's receive time
+        alignas(cmsghdr) char control[RX_TIMESTAMP_CONTROL_SIZE];
+        iovec iov{buffer.write_buffer(), buffer.available_write()};
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        do {
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            bytes_received = ::recvmsg(socket_fd_, &msg, flags);
+        } while (bytes_received < 0 && errno == EINTR);
+        if (bytes_received > 0) {
+            RxTimestampSource source;
+            timestamp = read_rx_timestamp(msg, source);
+            if (timestamp == 0) {
+                timestamp = realtime_ns();
+            }
+        }
+    } else {
+        do {
+            bytes_received = ::recv(socket_fd_, buffer.write_buffer(), buffer.available_write(), flags);
+        } while (bytes_received < 0 && errno == EINTR);
+    }
+    
+    if (bytes_received > 0) {
+        buffer.advance_write(static_cast<size_t>(bytes_received), timestamp);
+        if (config_.quick_ack) {
+            // Not sticky: the kernel may fall back to delayed ACKs after any read
+            int one = 1;
+            setsockopt(socket_fd_, IPPROTO_TCP, TCP_QUICKACK, &one, sizeof(one));
+        }
+        return bytes_received;
+    }
+    
+    if (bytes_received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0;
+    }
+    
+    if (bytes_received < 0) {
+        std::cerr << "Receive failed: " << strerror(errno) << std::endl;
+    }
+    connected_ = false;
+    close();
+    return -1;
+}
+
+size_t TcpClient::drain_into(ReceiveBuffer& buffer) {
+    size_t total = 0;
+    
+    while (true) {
+        size_t room = buffer.available_write();
+        ssize_t bytes_received = recv_into(buffer, MSG_DONTWAIT);
+        if (bytes_received <= 0) {
+            break;  // Would block, buffer full, or connection gone
+        }
+        total += static_cast<size_t>(bytes_received);
+        if (static_cast<size_t>(bytes_received) < room) {
+            break;  // Short read: socket queue is empty
+        }
+    }
+    
+    return total;
+}
+
+bool TcpClient::enable_timestamping() {
+    if (socket_fd_ < 0) {
+        return false;
+    }
+    timestamping_ = enable_rx_timestamping(socket_fd_);
+    return timestamping_;
+}
+
+bool TcpClient::set_nonblocking(bool enable) {
+    if (socket_fd_ < 0) {
+        return false;
+    }
+    
+    int flags = fcntl(socket_fd_, F_GETFL, 0);
+    if (flags < 0) {
+        return false;
+    }
+    flags = enable ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    if (fcntl(socket_fd_, F_SETFL, flags) != 0) {
+        return false;
+    }
+    nonblocking_ = enable;
+    return true;
+}
+
+void TcpClient::apply_socket_options() {
+    // Options are tuning: failures are reported, never fatal
+    int one = 1;
+    if (config_.tcp_nodelay && setsockopt(socket_fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)) != 0) {
+        std::cerr << "TCP_NODELAY failed: " << strerror(errno) << std::endl;
+    }
+    if (config_.quick_ack && setsockopt(socket_fd_, IPPROTO_TCP, TCP_QUICKACK, &one, sizeof(one)) != 0) {
+        std::cerr << "TCP_QUICKACK failed: " << strerror(errno) << std::endl;
+    }
+#ifdef SO_BUSY_POLL
+    if (config_.busy_poll_us > 0) {
+        int usecs = config_.busy_poll_us;
+        if (setsockopt(socket_fd_, SOL_SOCKET, SO_BUSY_POLL, &usecs, sizeof(usecs)) != 0) {
+            // Raising it above net.core.busy_read needs CAP_NET_ADMIN
+            std::cerr << "SO_BUSY_POLL failed: " << strerror(errno) << std::endl;
+        }
+    }
+#endif
+}
+
+bool TcpClient::connect_with_timeout(const void* address, size_t address_length) {
+    int flags = fcntl(socket_fd_, F_GETFL, 0);
+    if (flags < 0 || fcntl(socket_fd_, F_SETFL, flags | O_NONBLOCK) != 0) {
+        return false;
+    }
+    if (::connect(socket_fd_, static_cast<const sockaddr*>(address), static_cast<socklen_t>(address_length)) == 0) {
+        return true;
+    }
+    if (errno != EINPROGRESS) {
+        return false;
+    }
+    
+    // Writable once the handshake finished, one way or the other
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config_.connect_timeout_ms);
+    while (true) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) {
+            errno = ETIMEDOUT;
+            return false;
+        }
+        pollfd pfd{socket_fd_, POLLOUT, 0};
+        int ready = ::poll(&pfd, 1, static_cast<int>(left.count()));
+        if (ready > 0) {
+            break;
+        }
+        if (ready < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+    
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(socket_fd_, SOL_SOCKET, SO_ERROR, &error, &length) != 0) {
+        return false;
+    }
+    if (error != 0) {
+        errno = error;
+        return false;
+    }
+    return true;
+}
+
 void TcpClient::close() {
     if (socket_fd_ >= 0) {
         ::close(socket_fd_);
         socket_fd_ = -1;
         connected_ = false;
+        connecting_ = false;
+        timestamping_ = false;
+        nonblocking_ = false;
     }
+    send_head_ = send_tail_ = 0;
 }
 
 } // namespace net
@@ -1,92 +1,218 @@
 #include "net/websocket_client.hpp"
-#include <iostream>
+#include "parser/trade_json_parser.hpp"
+
+#include <chrono>
 #include <cstring>
-#include <unistd.h>
-#include <sys/socket.h>
-#include <netdb.h>
+#include <iostream>
 
 namespace feedhandler {
 namespace net {
 
-WebSocketClient::WebSocketClient() : socket_fd_(-1) {}
+namespace {
+
+std::string base64(const unsigned char* data, size_t length) {
+    static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < length) group |= static_cast<uint32_t>(data[i + 1]) << 8;
+        if (i + 2 < length) group |= data[i + 2];
+        out.push_back(ALPHABET[(group >> 18) & 0x3F]);
+        out.push_back(ALPHABET[(group >> 12) & 0x3F]);
+        out.push_back(i + 1 < length ? ALPHABET[(group >> 6) & 0x3F] : '=');
+        out.push_back(i + 2 < length ? ALPHABET[group & 0x3F] : '=');
+    }
+    return out;
+}
+
+} // namespace
+
+WebSocketClient::WebSocketClient() : WebSocketClient(WebSocketClientConfig{}) {
+}
+
+WebSocketClient::WebSocketClient(const WebSocketClientConfig& config)
+    : tcp_(config.tcp)
+    , buffer_(config.buffer)
+    , decoder_(config.decoder)
+    , mask_state_(static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^
+                  reinterpret_cast<uintptr_t>(this)) {
+}
 
 WebSocketClient::~WebSocketClient() {
     close();
 }
 
-bool WebSocketClient::connect_to_feed(const std::string& /* url */, const std::string& host, int port) {
+bool WebSocketClient::connect_to_feed(const std::string& path, const std::string& host, int port) {
+    close();
     host_ = host;
-    
-    struct addrinfo hints, *res;
-    memset(&hints, 0, sizeof(hints));
-    hints.ai_family = AF_INET;
-    hints.ai_socktype = SOCK_STREAM;
-    
-    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &res) != 0) {
-        std::cerr << "Failed to resolve host: " << host << std::endl;
-        return false;
-    }
-    
-    socket_fd_ = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
-    if (socket_fd_ < 0) {
-        std::cerr << "Failed to create socket" << std::endl;
-        freeaddrinfo(res);
+    path_ = path.empty() ? "/" : path;
+    port_ = port;
+    return tcp_.connect(host, port);
+}
+
+bool WebSocketClient::send_handshake() {
+    if (!tcp_.is_connected()) {
         return false;
     }
-    
-    if (connect(socket_fd_, res->ai_addr, res->ai_addrlen) < 0) {
-        std::cerr << "Failed to connect to " << host << ":" << port << std::endl;
-        close();
-        freeaddrinfo(res);
-        return false;
+
+    unsigned char nonce[16];
+    for (size_t i = 0; i < sizeof(nonce); i += 4) {
+        uint32_t word = next_mask_key();
+        std::memcpy(nonce + i, &word, 4);
     }
-    
-    freeaddrinfo(res);
-    std::cout << "Connected to " << host << ":" << port << std::endl;
-    return true;
-}
 
-bool WebSocketClient::send_handshake() {
-    if (socket_fd_ < 0) return false;
-    
-    // Simple WebSocket handshake
-    std::string handshake = 
-        "GET /ws/btcusdt@trade HTTP/1.1\r\n"
-        "Host: stream.binance.com:9443\r\n"
+    std::string request = "GET " + path_ + " HTTP/1.1\r\n"
+        "Host: " + host_ + (port_ == 80 ? "" : ":" + std::to_string(port_)) + "\r\n"
         "Upgrade: websocket\r\n"
         "Connection: Upgrade\r\n"
-        "Sec-WebSocket-Key: SGVsbG8sIHdvcmxkIQ==\r\n"
+        "Sec-WebSocket-Key: " + base64(nonce, sizeof(nonce)) + "\r\n"
         "Sec-WebSocket-Version: 13\r\n"
         "\r\n";
-    
-    if (send(socket_fd_, handshake.c_str(), handshake.length(), 0) < 0) {
+
+    if (!tcp_.send(request)) {
         std::cerr << "Failed to send handshake" << std::endl;
         return false;
     }
-    
-    std::cout << "Handshake sent" << std::endl;
+    handshake_sent_ = true;
     return true;
 }
 
+bool WebSocketClient::read_upgrade_response() {
+    std::string_view bytes(buffer_.read_ptr(), buffer_.readable_bytes());
+    size_t end = bytes.find("\r\n\r\n");
+    if (end == std::string_view::npos) {
+        if (buffer_.readable_bytes() == buffer_.capacity()) {
+            std::cerr << "Upgrade response too long" << std::endl;
+            close();
+        }
+        return false;
+    }
+
+    std::string_view status = bytes.substr(0, bytes.find("\r\n"));
+    if (status.substr(0, 12) != "HTTP/1.1 101") {
+        std::cerr << "Upgrade refused: " << status << std::endl;
+        close();
+        return false;
+    }
+
+    buffer_.consume(end + 4);
+    upgraded_ = true;
+    return true;
+}
+
+bool WebSocketClient::send_text(std::string_view payload) {
+    return send_frame(WsOpcode::TEXT, payload);
+}
+
+bool WebSocketClient::send_frame(WsOpcode opcode, std::string_view payload) {
+    if (!tcp_.is_connected()) {
+        return false;
+    }
+    frame_.clear();
+    ws_encode_frame(frame_, opcode, payload, next_mask_key());
+    return tcp_.send(frame_);
+}
+
+uint32_t WebSocketClient::next_mask_key() {
+    // xorshift64: masking only needs to be unpredictable to proxies
+    uint32_t key;
+    do {
+        mask_state_ ^= mask_state_ << 13;
+        mask_state_ ^= mask_state_ >> 7;
+        mask_state_ ^= mask_state_ << 17;
+        key = static_cast<uint32_t>(mask_state_ >> 16);
+    } while (key == 0);  // 0 means unmasked to ws_encode_frame
+    return key;
+}
+
+size_t WebSocketClient::decode(const MessageCallback& on_message, size_t max_messages) {
+    if (handshake_sent_ && !upgraded_ && !read_upgrade_response()) {
+        return 0;
+    }
+
+    size_t delivered = 0;
+    WebSocketFrameDecoder::Message message;
+    while (delivered < max_messages && decoder_.next(buffer_, message)) {
+        switch (message.opcode) {
+            case WsOpcode::TEXT:
+            case WsOpcode::BINARY:
+                if (on_message) {
+                    on_message(message.opcode, message.payload);
+                }
+                ++delivered;
+                break;
+            case WsOpcode::PING:
+                send_frame(WsOpcode::PONG, message.payload);
+                break;
+            case WsOpcode::CLOSE:
+                // Echo the status code, then the connection is done
+                send_frame(WsOpcode::CLOSE, message.payload.substr(0, 2));
+                close();
+                return delivered;
+            default:
+                break;
+        }
+    }
+
+    if (decoder_.status() != WebSocketFrameDecoder::Status::OK) {
+        std::cerr << "WebSocket protocol error, closing" << std::endl;
+        close();
+    }
+    return delivered;
+}
+
+size_t WebSocketClient::poll(const MessageCallback& on_message) {
+    if (!tcp_.is_connected()) {
+        return 0;
+    }
+
+    // A blocking read must not wait while complete messages are buffered
+    size_t delivered = decode(on_message);
+    if (delivered > 0 && !tcp_.is_nonblocking()) {
+        return delivered;
+    }
+    if (!tcp_.is_connected()) {
+        return delivered;
+    }
+
+    if (tcp_.is_nonblocking()) {
+        tcp_.drain_into(buffer_);
+    } else {
+        tcp_.recv_into(buffer_);
+    }
+    return delivered + decode(on_message);
+}
+
+size_t WebSocketClient::read_trades(const parser::TradeJsonParser& parser, std::vector<common::Tick>& ticks) {
+    size_t before = ticks.size();
+    poll([&](WsOpcode opcode, std::string_view payload) {
+        if (opcode == WsOpcode::TEXT) {
+            parser.parse(payload, ticks, buffer_.receive_timestamp());
+        }
+    });
+    return ticks.size() - before;
+}
+
 std::string WebSocketClient::recv_data() {
-    if (socket_fd_ < 0) return "";
-    
-    char buffer[4096];
-    ssize_t n = recv(socket_fd_, buffer, sizeof(buffer) - 1, 0);
-    
-    if (n > 0) {
-        buffer[n] = '\0';
-        return std::string(buffer);
+    std::string data;
+    auto keep = [&](WsOpcode, std::string_view payload) { data.assign(payload); };
+    if (decode(keep, 1) == 0 && tcp_.is_connected()) {
+        if (tcp_.is_nonblocking()) {
+            tcp_.drain_into(buffer_);
+        } else {
+            tcp_.recv_into(buffer_);
+        }
+        decode(keep, 1);
     }
-    
-    return "";
+    return data;
 }
 
 void WebSocketClient::close() {
-    if (socket_fd_ >= 0) {
-        ::close(socket_fd_);
-        socket_fd_ = -1;
-    }
+    tcp_.close();
+    buffer_.reset();
+    decoder_.reset();
+    handshake_sent_ = false;
+    upgraded_ = false;
 }
 
 } // namespace net
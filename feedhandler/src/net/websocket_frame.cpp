@@ -0,0 +1,239 @@
+#include "net/websocket_frame.hpp"
+#include "net/receive_buffer.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace feedhandler {
+namespace net {
+
+namespace {
+
+constexpr size_t MAX_CONTROL_PAYLOAD = 125;
+
+// Key rotated so that byte 0 applies to payload position offset
+uint32_t rotate_key(uint32_t key, size_t offset) {
+    unsigned char bytes[8];
+    std::memcpy(bytes, &key, 4);
+    std::memcpy(bytes + 4, &key, 4);
+    uint32_t rotated;
+    std::memcpy(&rotated, bytes + (offset & 3), 4);
+    return rotated;
+}
+
+} // namespace
+
+void ws_unmask_scalar(char* data, size_t length, uint32_t key, size_t offset) {
+    unsigned char bytes[4];
+    std::memcpy(bytes, &key, 4);
+    for (size_t i = 0; i < length; ++i) {
+        data[i] = static_cast<char>(data[i] ^ bytes[(offset + i) & 3]);
+    }
+}
+
+void ws_unmask(char* data, size_t length, uint32_t key, size_t offset) {
+    key = rotate_key(key, offset);
+    size_t i = 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+    const __m128i mask = _mm_set1_epi32(static_cast<int>(key));
+    for (; i + 16 <= length; i += 16) {
+        __m128i* chunk = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(chunk, _mm_xor_si128(_mm_loadu_si128(chunk), mask));
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint8x16_t mask = vreinterpretq_u8_u32(vdupq_n_u32(key));
+    for (; i + 16 <= length; i += 16) {
+        uint8_t* chunk = reinterpret_cast<uint8_t*>(data + i);
+        vst1q_u8(chunk, veorq_u8(vld1q_u8(chunk), mask));
+    }
+#endif
+
+    // Multiples of 16 keep the key phase: the tail starts on byte 0
+    ws_unmask_scalar(data + i, length - i, key, 0);
+}
+
+void ws_encode_frame(std::string& out, WsOpcode opcode, std::string_view payload, uint32_t mask_key) {
+    const bool masked = mask_key != 0;
+    const size_t length = payload.size();
+    out.push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));
+    
+    const char mask_bit = masked ? static_cast<char>(0x80) : 0;
+    if (length < 126) {
+        out.push_back(static_cast<char>(mask_bit | static_cast<char>(length)));
+    } else if (length <= 0xFFFF) {
+        out.push_back(static_cast<char>(mask_bit | 126));
+        out.push_back(static_cast<char>(length >> 8));
+        out.push_back(static_cast<char>(length & 0xFF));
+    } else {
+        out.push_back(static_cast<char>(mask_bit | 127));
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out.push_back(static_cast<char>((static_cast<uint64_t>(length) >> shift) & 0xFF));
+        }
+    }
+    
+    if (masked) {
+        char key[4];
+        std::memcpy(key, &mask_key, 4);
+        out.append(key, 4);
+    }
+    size_t start = out.size();
+    out.append(payload.data(), payload.size());
+    if (masked) {
+        ws_unmask(out.data() + start, length, mask_key);  // XOR both ways
+    }
+}
+
+WebSocketFrameDecoder::WebSocketFrameDecoder() : WebSocketFrameDecoder(WebSocketDecoderConfig{}) {
+}
+
+WebSocketFrameDecoder::WebSocketFrameDecoder(const WebSocketDecoderConfig& config) : config_(config) {
+}
+
+void WebSocketFrameDecoder::reset() {
+    status_ = Status::OK;
+    consume_on_next_ = 0;
+    scan_ = 0;
+    assembled_ = 0;
+    fragmented_ = false;
+}
+
+bool WebSocketFrameDecoder::fail(Status status) {
+    status_ = status;
+    return false;
+}
+
+bool WebSocketFrameDecoder::next(ReceiveBuffer& buffer, Message& message) {
+    if (status_ != Status::OK) {
+        return false;
+    }
+    if (consume_on_next_ > 0) {
+        buffer.consume(consume_on_next_);
+        consume_on_next_ = 0;
+    }
+    
+    char* data = buffer.read_ptr();
+    const size_t length = buffer.readable_bytes();
+    
+    while (true) {
+        // Header: 2 bytes, then 0/2/8 length bytes, then 0/4 key bytes
+        const unsigned char* header = reinterpret_cast<const unsigned char*>(data + scan_);
+        size_t available = length - scan_;
+        if (available < 2) {
+            return false;
+        }
+        const bool fin = header[0] & 0x80;
+        const WsOpcode opcode = static_cast<WsOpcode>(header[0] & 0x0F);
+        const bool masked = header[1] & 0x80;
+        if (header[0] & 0x70) {
+            return fail(Status::PROTOCOL_ERROR);  // No extension negotiated
+        }
+        
+        size_t header_length = 2;
+        uint64_t payload_length = header[1] & 0x7F;
+        if (payload_length == 126 || payload_length == 127) {
+            size_t bytes = payload_length == 126 ? 2 : 8;
+            if (available < 2 + bytes) {
+                return false;
+            }
+            payload_length = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                payload_length = (payload_length << 8) | header[2 + i];
+            }
+            header_length += bytes;
+        }
+        uint32_t key = 0;
+        if (masked) {
+            if (available < header_length + 4) {
+                return false;
+            }
+            std::memcpy(&key, header + header_length, 4);
+            header_length += 4;
+        }
+        
+        switch (opcode) {
+            case WsOpcode::CONTINUATION:
+                if (!fragmented_) {
+                    return fail(Status::PROTOCOL_ERROR);
+                }
+                break;
+            case WsOpcode::TEXT:
+            case WsOpcode::BINARY:
+                if (fragmented_) {
+                    return fail(Status::PROTOCOL_ERROR);  // New message before the last one ended
+                }
+                break;
+            case WsOpcode::CLOSE:
+            case WsOpcode::PING:
+            case WsOpcode::PONG:
+                if (!fin || payload_length > MAX_CONTROL_PAYLOAD) {
+                    return fail(Status::PROTOCOL_ERROR);
+                }
+                break;
+            default:
+                return fail(Status::PROTOCOL_ERROR);
+        }
+        if (!is_control(opcode) && assembled_ + payload_length > config_.max_message_bytes) {
+            return fail(Status::MESSAGE_TOO_BIG);
+        }
+        
+        // Whole frame here? If it never can be, the stream is stuck
+        const size_t frame_length = header_length + static_cast<size_t>(payload_length);
+        if (available < frame_length) {
+            if (scan_ + frame_length > buffer.capacity()) {
+                return fail(Status::MESSAGE_TOO_BIG);
+            }
+            return false;
+        }
+        
+        char* payload = data + scan_ + header_length;
+        if (masked) {
+            ws_unmask(payload, static_cast<size_t>(payload_length), key);
+        }
+        frames_++;
+        
+        if (is_control(opcode)) {
+            message.opcode = opcode;
+            message.payload = std::string_view(payload, static_cast<size_t>(payload_length));
+            scan_ += frame_length;
+            if (!fragmented_) {
+                // Nothing before it is held: it goes with the next call
+                consume_on_next_ = scan_;
+                scan_ = 0;
+            }
+            return true;
+        }
+        
+        // Data: slide the payload down against the fragments before it
+        if (payload != data + assembled_) {
+            std::memmove(data + assembled_, payload, static_cast<size_t>(payload_length));
+        }
+        if (!fragmented_) {
+            message_opcode_ = opcode;
+        }
+        assembled_ += static_cast<size_t>(payload_length);
+        scan_ += frame_length;
+        
+        if (!fin) {
+            fragmented_ = true;
+            continue;
+        }
+        
+        message.opcode = message_opcode_;
+        message.payload = std::string_view(data, assembled_);
+        messages_++;
+        consume_on_next_ = scan_;
+        scan_ = 0;
+        assembled_ = 0;
+        fragmented_ = false;
+        return true;
+    }
+}
+
+} // namespace net
+} // namespace feedhandler
@@ -0,0 +1,656 @@
+#include "network/rdma_transport.hpp"
+#include "net/rx_timestamp.hpp"
+
+#include <infiniband/verbs.h>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace feedhandler {
+namespace network {
+
+// Queue pair attributes the two sides swap before the QP can connect
+struct RDMATransport::PeerInfo {
+    uint32_t qp_num = 0;
+    uint32_t psn = 0;
+    uint16_t lid = 0;
+    uint8_t gid[16] = {};
+
+    static constexpr size_t WIRE_BYTES = 4 + 4 + 2 + 16;
+
+    void encode(uint8_t* out) const {
+        uint32_t q = htonl(qp_num);
+        uint32_t p = htonl(psn);
+        uint16_t l = htons(lid);
+        std::memcpy(out, &q, 4);
+        std::memcpy(out + 4, &p, 4);
+        std::memcpy(out + 8, &l, 2);
+        std::memcpy(out + 10, gid, 16);
+    }
+
+    static PeerInfo decode(const uint8_t* in) {
+        PeerInfo info;
+        uint32_t q;
+        uint32_t p;
+        uint16_t l;
+        std::memcpy(&q, in, 4);
+        std::memcpy(&p, in + 4, 4);
+        std::memcpy(&l, in + 8, 2);
+        std::memcpy(info.gid, in + 10, 16);
+        info.qp_num = ntohl(q);
+        info.psn = ntohl(p);
+        info.lid = ntohs(l);
+        return info;
+    }
+};
+
+namespace {
+
+constexpr size_t MAX_POST_BATCH = 64;   // Work requests chained into one ibv_post_recv()
+constexpr uint32_t MAX_INLINE_REQUEST = 64;
+constexpr int EVENT_WAIT_MS = 100;      // So stop_receiving() is noticed while idle
+
+void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+bool write_all(int fd, const uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = ::send(fd, data, length, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool read_all(int fd, uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = ::recv(fd, data, length, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+RDMATransport::RDMATransport() : RDMATransport(Config()) {
+}
+
+RDMATransport::RDMATransport(const Config& config)
+    : config_(config)
+    , pool_(config.recv_buffers, config.max_message_size) {
+    if (config_.post_batch == 0 || config_.poll_batch == 0 || config_.send_buffers == 0) {
+        throw std::invalid_argument("RDMATransport batch sizes and send_buffers must be non-zero");
+    }
+    config_.post_batch = std::min(config_.post_batch, MAX_POST_BATCH);
+    post_scratch_.reserve(config_.post_batch);
+}
+
+RDMATransport::~RDMATransport() {
+    cleanup_rdma();
+}
+
+bool RDMATransport::initialize_rdma() {
+    cleanup_rdma();
+
+    int count = 0;
+    ibv_device** devices = ibv_get_device_list(&count);
+    if (!devices) {
+        std::cerr << "ibv_get_device_list failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    ibv_device* device = nullptr;
+    for (int i = 0; i < count; ++i) {
+        if (config_.device_name.empty() || config_.device_name == ibv_get_device_name(devices[i])) {
+            device = devices[i];
+            break;
+        }
+    }
+    if (!device) {
+        std::cerr << "RDMA device " << (config_.device_name.empty() ? "(any)" : config_.device_name)
+                  << " not found" << std::endl;
+        ibv_free_device_list(devices);
+        return false;
+    }
+    context_ = ibv_open_device(device);
+    ibv_free_device_list(devices);
+    if (!context_) {
+        std::cerr << "ibv_open_device failed" << std::endl;
+        return false;
+    }
+
+    protection_domain_ = ibv_alloc_pd(context_);
+    if (!protection_domain_) {
+        std::cerr << "ibv_alloc_pd failed" << std::endl;
+        cleanup_rdma();
+        return false;
+    }
+
+    // Registered once for the life of the connection: the receive path
+    // never touches the memory registration machinery
+    recv_region_ = ibv_reg_mr(protection_domain_, pool_.slab(), pool_.slab_bytes(), IBV_ACCESS_LOCAL_WRITE);
+    send_slab_.resize(config_.send_buffers * config_.max_message_size);
+    send_region_ = ibv_reg_mr(protection_domain_, send_slab_.data(), send_slab_.size(), 0);
+    if (!recv_region_ || !send_region_) {
+        std::cerr << "ibv_reg_mr failed: " << std::strerror(errno) << std::endl;
+        cleanup_rdma();
+        return false;
+    }
+
+    if (!config_.busy_poll) {
+        channel_ = ibv_create_comp_channel(context_);
+        if (!channel_) {
+            std::cerr << "ibv_create_comp_channel failed" << std::endl;
+            cleanup_rdma();
+            return false;
+        }
+    }
+
+    ibv_cq_init_attr_ex cq_attr{};
+    cq_attr.cqe = static_cast<uint32_t>(config_.recv_buffers);
+    cq_attr.channel = channel_;
+    cq_attr.wc_flags = IBV_WC_EX_WITH_BYTE_LEN;
+    if (config_.use_hardware_timestamps) {
+        cq_attr.wc_flags |= IBV_WC_EX_WITH_COMPLETION_TIMESTAMP_WALLCLOCK;
+    }
+    cq_attr.comp_mask = IBV_CQ_INIT_ATTR_MASK_FLAGS;
+    cq_attr.flags = IBV_CREATE_CQ_ATTR_SINGLE_THREADED;  // Only the receive thread polls it
+    recv_cq_ = ibv_create_cq_ex(context_, &cq_attr);
+    if (!recv_cq_ && config_.use_hardware_timestamps) {
+        std::cerr << "No NIC completion timestamps, stamping with the host clock" << std::endl;
+        cq_attr.wc_flags = IBV_WC_EX_WITH_BYTE_LEN;
+        recv_cq_ = ibv_create_cq_ex(context_, &cq_attr);
+    }
+    hardware_timestamps_ = recv_cq_ && (cq_attr.wc_flags & IBV_WC_EX_WITH_COMPLETION_TIMESTAMP_WALLCLOCK);
+    send_cq_ = ibv_create_cq(context_, static_cast<int>(config_.send_buffers), nullptr, nullptr, 0);
+    if (!recv_cq_ || !send_cq_) {
+        std::cerr << "Completion queue creation failed: " << std::strerror(errno) << std::endl;
+        cleanup_rdma();
+        return false;
+    }
+
+    ibv_qp_init_attr qp_attr{};
+    qp_attr.send_cq = send_cq_;
+    qp_attr.recv_cq = ibv_cq_ex_to_cq(recv_cq_);
+    qp_attr.qp_type = IBV_QPT_RC;
+    qp_attr.sq_sig_all = 1;
+    qp_attr.cap.max_send_wr = static_cast<uint32_t>(config_.send_buffers);
+    qp_attr.cap.max_recv_wr = static_cast<uint32_t>(config_.recv_buffers);
+    qp_attr.cap.max_send_sge = 1;
+    qp_attr.cap.max_recv_sge = 1;
+    qp_attr.cap.max_inline_data = MAX_INLINE_REQUEST;
+    queue_pair_ = ibv_create_qp(protection_domain_, &qp_attr);
+    if (!queue_pair_) {
+        qp_attr.cap.max_inline_data = 0;  // Some providers have no inline sends
+        queue_pair_ = ibv_create_qp(protection_domain_, &qp_attr);
+    }
+    if (!queue_pair_) {
+        std::cerr << "ibv_create_qp failed: " << std::strerror(errno) << std::endl;
+        cleanup_rdma();
+        return false;
+    }
+    max_inline_ = qp_attr.cap.max_inline_data;
+
+    ibv_qp_attr attr{};
+    attr.qp_state = IBV_QPS_INIT;
+    attr.pkey_index = 0;
+    attr.port_num = config_.port;
+    attr.qp_access_flags = 0;  // Two-sided sends only, no remote access to our memory
+    if (ibv_modify_qp(queue_pair_, &attr, IBV_QP_STATE | IBV_QP_PKEY_INDEX | IBV_QP_PORT | IBV_QP_ACCESS_FLAGS)) {
+        std::cerr << "Queue pair to INIT failed" << std::endl;
+        cleanup_rdma();
+        return false;
+    }
+
+    // The whole pool goes to the receive queue before the peer can send
+    if (!post_receives(pool_.released())) {
+        cleanup_rdma();
+        return false;
+    }
+    return true;
+}
+
+void RDMATransport::cleanup_rdma() {
+    stop_receiving();
+    connected_ = false;
+    if (queue_pair_) {
+        ibv_destroy_qp(queue_pair_);
+        queue_pair_ = nullptr;
+    }
+    if (recv_cq_) {
+        ibv_destroy_cq(ibv_cq_ex_to_cq(recv_cq_));
+        recv_cq_ = nullptr;
+    }
+    if (send_cq_) {
+        ibv_destroy_cq(send_cq_);
+        send_cq_ = nullptr;
+    }
+    if (channel_) {
+        ibv_destroy_comp_channel(channel_);
+        channel_ = nullptr;
+    }
+    if (recv_region_) {
+        ibv_dereg_mr(recv_region_);
+        recv_region_ = nullptr;
+    }
+    if (send_region_) {
+        ibv_dereg_mr(send_region_);
+        send_region_ = nullptr;
+    }
+    if (protection_domain_) {
+        ibv_dealloc_pd(protection_domain_);
+        protection_domain_ = nullptr;
+    }
+    if (context_) {
+        ibv_close_device(context_);
+        context_ = nullptr;
+    }
+    pool_.reset();
+    hardware_timestamps_ = false;
+    send_next_ = 0;
+    sends_in_flight_ = 0;
+}
+
+bool RDMATransport::connect(const std::string& remote_address, uint16_t remote_port) {
+    if (!initialize_rdma()) {
+        return false;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    std::string service = std::to_string(remote_port);
+    if (getaddrinfo(remote_address.c_str(), service.c_str(), &hints, &result) != 0 || !result) {
+        std::cerr << "Failed to resolve " << remote_address << std::endl;
+        cleanup_rdma();
+        return false;
+    }
+    int fd = -1;
+    for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd >= 0 && ::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(result);
+    if (fd < 0) {
+        std::cerr << "Failed to reach " << remote_address << ":" << remote_port << " for the RDMA exchange" << std::endl;
+        cleanup_rdma();
+        return false;
+    }
+
+    bool ok = exchange_and_connect(fd, false);
+    ::close(fd);
+    if (!ok) {
+        cleanup_rdma();
+    }
+    return ok;
+}
+
+bool RDMATransport::accept(uint16_t port) {
+    if (!initialize_rdma()) {
+        return false;
+    }
+
+    int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (listen_fd < 0 || ::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd, 1) != 0) {
+        std::cerr << "Failed to listen on " << port << " for the RDMA exchange: " << std::strerror(errno) << std::endl;
+        if (listen_fd >= 0) {
+            ::close(listen_fd);
+        }
+        cleanup_rdma();
+        return false;
+    }
+    int fd = ::accept(listen_fd, nullptr, nullptr);
+    ::close(listen_fd);
+    if (fd < 0) {
+        std::cerr << "accept failed: " << std::strerror(errno) << std::endl;
+        cleanup_rdma();
+        return false;
+    }
+
+    bool ok = exchange_and_connect(fd, true);
+    ::close(fd);
+    if (!ok) {
+        cleanup_rdma();
+    }
+    return ok;
+}
+
+bool RDMATransport::exchange_and_connect(int socket_fd, bool server) {
+    ibv_port_attr port_attr{};
+    if (ibv_query_port(context_, config_.port, &port_attr)) {
+        std::cerr << "ibv_query_port failed" << std::endl;
+        return false;
+    }
+
+    PeerInfo local;
+    local.qp_num = queue_pair_->qp_num;
+    local.psn = std::random_device{}() & 0xFFFFFF;
+    local.lid = port_attr.lid;
+    if (port_attr.link_layer == IBV_LINK_LAYER_ETHERNET) {
+        // RoCE has no LIDs: packets are routed by GID
+        ibv_gid gid{};
+        if (ibv_query_gid(context_, config_.port, config_.gid_index, &gid)) {
+            std::cerr << "ibv_query_gid failed for index " << config_.gid_index << std::endl;
+            return false;
+        }
+        std::memcpy(local.gid, gid.raw, sizeof(local.gid));
+    }
+
+    uint8_t out[PeerInfo::WIRE_BYTES];
+    uint8_t in[PeerInfo::WIRE_BYTES];
+    local.encode(out);
+    bool exchanged = server ? read_all(socket_fd, in, sizeof(in)) && write_all(socket_fd, out, sizeof(out))
+                            : write_all(socket_fd, out, sizeof(out)) && read_all(socket_fd, in, sizeof(in));
+    if (!exchanged) {
+        std::cerr << "RDMA queue pair exchange failed" << std::endl;
+        return false;
+    }
+
+    if (!bring_up(local, PeerInfo::decode(in))) {
+        return false;
+    }
+    connected_ = true;
+    return true;
+}
+
+bool RDMATransport::bring_up(const PeerInfo& local, const PeerInfo& remote) {
+    ibv_port_attr port_attr{};
+    ibv_query_port(context_, config_.port, &port_attr);
+
+    ibv_qp_attr attr{};
+    attr.qp_state = IBV_QPS_RTR;
+    attr.path_mtu = port_attr.active_mtu;
+    attr.dest_qp_num = remote.qp_num;
+    attr.rq_psn = remote.psn;
+    attr.max_dest_rd_atomic = 1;
+    attr.min_rnr_timer = 12;
+    attr.ah_attr.dlid = remote.lid;
+    attr.ah_attr.port_num = config_.port;
+    bool has_gid = std::any_of(std::begin(remote.gid), std::end(remote.gid), [](uint8_t b) { return b != 0; });
+    if (has_gid) {
+        attr.ah_attr.is_global = 1;
+        std::memcpy(attr.ah_attr.grh.dgid.raw, remote.gid, sizeof(remote.gid));
+        attr.ah_attr.grh.hop_limit = 1;
+        attr.ah_attr.grh.sgid_index = static_cast<uint8_t>(config_.gid_index);
+    }
+    if (ibv_modify_qp(queue_pair_, &attr,
+                      IBV_QP_STATE | IBV_QP_AV | IBV_QP_PATH_MTU | IBV_QP_DEST_QPN | IBV_QP_RQ_PSN |
+                          IBV_QP_MAX_DEST_RD_ATOMIC | IBV_QP_MIN_RNR_TIMER)) {
+        std::cerr << "Queue pair to RTR failed" << std::endl;
+        return false;
+    }
+
+    attr = ibv_qp_attr{};
+    attr.qp_state = IBV_QPS_RTS;
+    attr.timeout = 14;
+    attr.retry_cnt = 7;
+    attr.rnr_retry = 7;  // Retry forever if the receiver ever runs out of posted buffers
+    attr.sq_psn = local.psn;
+    attr.max_rd_atomic = 1;
+    if (ibv_modify_qp(queue_pair_, &attr,
+                      IBV_QP_STATE | IBV_QP_TIMEOUT | IBV_QP_RETRY_CNT | IBV_QP_RNR_RETRY | IBV_QP_SQ_PSN |
+                          IBV_QP_MAX_QP_RD_ATOMIC)) {
+        std::cerr << "Queue pair to RTS failed" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool RDMATransport::post_receives(size_t max) {
+    ibv_recv_wr requests[MAX_POST_BATCH];
+    ibv_sge entries[MAX_POST_BATCH];
+
+    while (max > 0) {
+        size_t count = pool_.take_batch(std::min(max, config_.post_batch), post_scratch_);
+        if (count == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            entries[i].addr = reinterpret_cast<uintptr_t>(pool_.buffer(post_scratch_[i]));
+            entries[i].length = static_cast<uint32_t>(pool_.buffer_size());
+            entries[i].lkey = recv_region_->lkey;
+            requests[i].wr_id = post_scratch_[i];
+            requests[i].sg_list = &entries[i];
+            requests[i].num_sge = 1;
+            requests[i].next = i + 1 < count ? &requests[i + 1] : nullptr;
+        }
+        ibv_recv_wr* bad = nullptr;
+        if (ibv_post_recv(queue_pair_, requests, &bad)) {
+            // Requests before bad are on the queue; the rest go back
+            size_t posted = bad ? static_cast<size_t>(bad - requests) : 0;
+            post_scratch_.erase(post_scratch_.begin(), post_scratch_.begin() + static_cast<std::ptrdiff_t>(posted));
+            pool_.unpost(post_scratch_);
+            std::cerr << "ibv_post_recv failed" << std::endl;
+            return false;
+        }
+        recv_posts_.add();
+        max -= count;
+    }
+    return true;
+}
+
+uint64_t RDMATransport::get_hardware_timestamp() {
+    if (hardware_timestamps_) {
+        hardware_timestamp_count_.add();
+        return ibv_wc_read_completion_wallclock_ns(recv_cq_);
+    }
+    return net::realtime_ns();
+}
+
+size_t RDMATransport::process_completion() {
+    ibv_poll_cq_attr attr{};
+    if (ibv_start_poll(recv_cq_, &attr) != 0) {
+        return 0;  // ENOENT: nothing completed
+    }
+
+    size_t handled = 0;
+    do {
+        uint32_t index = static_cast<uint32_t>(recv_cq_->wr_id);
+        const char* data = pool_.lend(index);
+        if (recv_cq_->status == IBV_WC_SUCCESS) {
+            size_t length = ibv_wc_read_byte_len(recv_cq_);
+            uint64_t timestamp = get_hardware_timestamp();
+            messages_received_.add();
+            bytes_received_.add(length);
+            if (message_callback_) {
+                message_callback_(data, length, timestamp);
+            }
+        } else {
+            // Flushed: the queue pair went to error (peer gone); every
+            // posted buffer comes back this way
+            completion_errors_.add();
+            if (connected_.exchange(false)) {
+                std::cerr << "RDMA receive failed: " << ibv_wc_status_str(recv_cq_->status) << std::endl;
+            }
+        }
+        pool_.release(index);
+        ++handled;
+    } while (handled < config_.poll_batch && ibv_next_poll(recv_cq_) == 0);
+    ibv_end_poll(recv_cq_);
+
+    if (connected_ && pool_.released() >= config_.post_batch) {
+        post_receives(pool_.released());
+    }
+    return handled;
+}
+
+bool RDMATransport::wait_for_completion() {
+    if (ibv_req_notify_cq(ibv_cq_ex_to_cq(recv_cq_), 0)) {
+        return false;
+    }
+    // A completion that landed before the arm raises no event
+    if (process_completion() > 0) {
+        return true;
+    }
+
+    pollfd pfd{channel_->fd, POLLIN, 0};
+    if (::poll(&pfd, 1, EVENT_WAIT_MS) <= 0) {
+        return false;
+    }
+    ibv_cq* cq = nullptr;
+    void* context = nullptr;
+    if (ibv_get_cq_event(channel_, &cq, &context) == 0) {
+        ibv_ack_cq_events(cq, 1);
+    }
+    return true;
+}
+
+void RDMATransport::receive_loop() {
+    while (receiving_.load(std::memory_order_relaxed)) {
+        if (process_completion() > 0) {
+            continue;
+        }
+        if (!connected_ && pool_.posted() == 0) {
+            break;  // Every flushed buffer is back: nothing more will arrive
+        }
+        if (config_.busy_poll) {
+            cpu_relax();
+        } else {
+            wait_for_completion();
+        }
+    }
+}
+
+void RDMATransport::start_receiving(MessageCallback callback) {
+    if (receiving_ || !queue_pair_) {
+        return;
+    }
+    message_callback_ = std::move(callback);
+    receiving_ = true;
+    receive_thread_ = std::thread(&RDMATransport::receive_loop, this);
+}
+
+void RDMATransport::stop_receiving() {
+    receiving_ = false;
+    if (receive_thread_.joinable()) {
+        receive_thread_.join();
+    }
+}
+
+bool RDMATransport::reap_sends(bool wait) {
+    ibv_wc completions[16];
+    do {
+        int n = ibv_poll_cq(send_cq_, 16, completions);
+        if (n < 0) {
+            std::cerr << "ibv_poll_cq failed on the send queue" << std::endl;
+            connected_ = false;
+            return false;
+        }
+        for (int i = 0; i < n; ++i) {
+            --sends_in_flight_;
+            if (completions[i].status != IBV_WC_SUCCESS) {
+                std::cerr << "RDMA send failed: " << ibv_wc_status_str(completions[i].status) << std::endl;
+                connected_ = false;
+                return false;
+            }
+        }
+        if (n > 0) {
+            wait = false;
+        } else if (wait) {
+            cpu_relax();
+        }
+    } while (wait);
+    return true;
+}
+
+bool RDMATransport::send_message(const void* data, size_t length) {
+    if (!connected_) {
+        return false;
+    }
+    if (length > config_.max_message_size) {
+        std::cerr << "RDMA message of " << length << " bytes exceeds max_message_size" << std::endl;
+        return false;
+    }
+    if (!reap_sends(sends_in_flight_ == config_.send_buffers)) {
+        return false;
+    }
+
+    // Slots are reused in order, and RC completes sends in order, so the
+    // slot taken here is one whose send has already completed
+    ibv_sge entry{};
+    entry.length = static_cast<uint32_t>(length);
+    ibv_send_wr request{};
+    request.wr_id = send_next_;
+    request.sg_list = &entry;
+    request.num_sge = 1;
+    request.opcode = IBV_WR_SEND;
+    request.send_flags = IBV_SEND_SIGNALED;
+    if (length <= max_inline_) {
+        request.send_flags |= IBV_SEND_INLINE;  // Copied into the work request: no DMA read of the payload
+        entry.addr = reinterpret_cast<uintptr_t>(data);
+    } else {
+        char* slot = send_slab_.data() + send_next_ * config_.max_message_size;
+        std::memcpy(slot, data, length);
+        entry.addr = reinterpret_cast<uintptr_t>(slot);
+        entry.lkey = send_region_->lkey;
+    }
+
+    ibv_send_wr* bad = nullptr;
+    if (ibv_post_send(queue_pair_, &request, &bad)) {
+        std::cerr << "ibv_post_send failed" << std::endl;
+        return false;
+    }
+    send_next_ = (send_next_ + 1) % config_.send_buffers;
+    ++sends_in_flight_;
+    messages_sent_.add();
+    return true;
+}
+
+RDMATransport::NetworkStats RDMATransport::get_stats() const {
+    NetworkStats stats;
+    stats.messages_received = messages_received_.load();
+    stats.bytes_received = bytes_received_.load();
+    stats.completion_errors = completion_errors_.load();
+    stats.recv_posts = recv_posts_.load();
+    stats.messages_sent = messages_sent_.load();
+    stats.hardware_timestamps = hardware_timestamp_count_.load();
+    return stats;
+}
+
+} // namespace network
+} // namespace feedhandler
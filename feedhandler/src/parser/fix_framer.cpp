@@ -0,0 +1,214 @@
+#include "parser/fix_framer.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace feedhandler {
+namespace parser {
+
+namespace {
+
+constexpr size_t MAX_BEGIN_STRING = 16;   // "FIXT.1.1" and friends
+constexpr size_t MAX_BODY_LENGTH_DIGITS = 9;
+
+} // namespace
+
+FixFramer::Frame FixFramer::frame(const char* data, size_t length, bool verify_checksum) {
+    // "8=" BeginString
+    if (length < 2) {
+        return {Status::INCOMPLETE, 0};
+    }
+    if (data[0] != '8' || data[1] != '=') {
+        return {Status::BAD_HEADER, 0};
+    }
+    size_t pos = 2;
+    while (pos < length && !is_delimiter(data[pos])) {
+        if (pos - 2 >= MAX_BEGIN_STRING) {
+            return {Status::BAD_HEADER, 0};
+        }
+        ++pos;
+    }
+
+    // "<d>9=" BodyLength "<d>"
+    if (pos + 3 > length) {
+        return {Status::INCOMPLETE, 0};
+    }
+    if (data[pos + 1] != '9' || data[pos + 2] != '=') {
+        return {Status::BAD_HEADER, 0};
+    }
+    pos += 3;
+    size_t digits_start = pos;
+    size_t body_length = 0;
+    while (pos < length && data[pos] >= '0' && data[pos] <= '9') {
+        if (pos - digits_start >= MAX_BODY_LENGTH_DIGITS) {
+            return {Status::BAD_HEADER, 0};
+        }
+        body_length = body_length * 10 + static_cast<size_t>(data[pos] - '0');
+        ++pos;
+    }
+    if (pos == length) {
+        return {Status::INCOMPLETE, 0};
+    }
+    if (pos == digits_start || !is_delimiter(data[pos])) {
+        return {Status::BAD_HEADER, 0};
+    }
+
+    // Jump straight to the trailer
+    size_t body_end = pos + 1 + body_length;
+    if (body_end + TRAILER_LENGTH > length) {
+        return {Status::INCOMPLETE, 0};
+    }
+    const char* trailer = data + body_end;
+    if (!is_delimiter(trailer[-1]) || trailer[0] != '1' || trailer[1] != '0' || trailer[2] != '=' ||
+        !is_delimiter(trailer[6])) {
+        return {Status::BAD_BODY_LENGTH, 0};
+    }
+    int expected = 0;
+    for (int i = 3; i < 6; ++i) {
+        if (trailer[i] < '0' || trailer[i] > '9') {
+            return {Status::BAD_BODY_LENGTH, 0};
+        }
+        expected = expected * 10 + (trailer[i] - '0');
+    }
+
+    if (verify_checksum && checksum(data, body_end) != expected) {
+        return {Status::BAD_CHECKSUM, 0};
+    }
+    return {Status::COMPLETE, body_end + TRAILER_LENGTH};
+}
+
+uint8_t FixFramer::checksum_scalar(const char* data, size_t length) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < length; ++i) {
+        sum += static_cast<uint8_t>(data[i]);
+    }
+    return static_cast<uint8_t>(sum);
+}
+
+uint8_t FixFramer::checksum(const char* data, size_t length) {
+    size_t i = 0;
+    uint64_t sum = 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+    // psadbw against zero sums 8 bytes into each 64-bit lane
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(chunk, zero));
+    }
+    // Summed through memory; _mm_cvtsi128_si64 is x86-64 only
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    sum = lanes[0] + lanes[1];
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    for (; i + 16 <= length; i += 16) {
+        sum += vaddlvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(data + i)));
+    }
+#endif
+
+    for (; i < length; ++i) {
+        sum += static_cast<uint8_t>(data[i]);
+    }
+    return static_cast<uint8_t>(sum);
+}
+
+size_t FixFramer::find_message_start(const char* data, size_t length) {
+    static const char MARKER[] = "8=FIX";
+    constexpr size_t MARKER_LENGTH = sizeof(MARKER) - 1;
+
+    for (size_t pos = 0; pos < length; ++pos) {
+        const void* hit = std::memchr(data + pos, '8', length - pos);
+        if (!hit) {
+            return length;
+        }
+        pos = static_cast<size_t>(static_cast<const char*>(hit) - data);
+        size_t available = length - pos;
+        size_t compare = available < MARKER_LENGTH ? available : MARKER_LENGTH;
+        if (std::memcmp(data + pos, MARKER, compare) == 0) {
+            return pos;  // Full match, or a prefix cut off by the end of data
+        }
+    }
+    return length;
+}
+
+size_t FixFramer::find_trailer_end(const char* data, size_t length) {
+    static const char TAG[] = "10=";
+    constexpr size_t TAG_LENGTH = sizeof(TAG) - 1;
+
+    // memmem is vectorized in glibc; candidates are few
+    size_t pos = 0;
+    while (pos + TRAILER_LENGTH <= length) {
+        const void* hit = memmem(data + pos, length - pos, TAG, TAG_LENGTH);
+        if (!hit) {
+            return 0;
+        }
+        pos = static_cast<size_t>(static_cast<const char*>(hit) - data);
+        const char* field = data + pos;
+        if (pos + TRAILER_LENGTH <= length && (pos == 0 || is_delimiter(field[-1])) &&
+            field[3] >= '0' && field[3] <= '9' && field[4] >= '0' && field[4] <= '9' &&
+            field[5] >= '0' && field[5] <= '9' && is_delimiter(field[6])) {
+            return pos + TRAILER_LENGTH;
+        }
+        ++pos;
+    }
+    return 0;
+}
+
+std::string_view FixFramer::field_value(const char* data, size_t length, size_t tag_pos) {
+    size_t start = tag_pos + 3;  // Past "55="
+    for (size_t end = start; end < length; ++end) {
+        if (is_delimiter(data[end])) {
+            return std::string_view(data + start, end - start);
+        }
+    }
+    return std::string_view();  // Value cut off
+}
+
+std::string_view FixFramer::find_symbol_scalar(const char* data, size_t length) {
+    for (size_t pos = 1; pos + 3 <= length; ++pos) {
+        if (data[pos] == '5' && data[pos + 1] == '5' && data[pos + 2] == '=' && is_delimiter(data[pos - 1])) {
+            return field_value(data, length, pos);
+        }
+    }
+    return std::string_view();
+}
+
+std::string_view FixFramer::find_symbol(const char* data, size_t length) {
+#if defined(__x86_64__) || defined(__i386__)
+    // Positions where "55=" starts: three shifted compares ANDed, one
+    // candidate mask per 16 bytes; the delimiter before it is checked per hit
+    const __m128i five = _mm_set1_epi8('5');
+    const __m128i equals = _mm_set1_epi8('=');
+    size_t pos = 1;  // Tag 55 never opens a message
+    for (; pos + 18 <= length; pos += 16) {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 1));
+        __m128i third = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 2));
+        __m128i hits = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(first, five), _mm_cmpeq_epi8(second, five)),
+                                     _mm_cmpeq_epi8(third, equals));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        while (mask != 0) {
+            size_t hit = pos + static_cast<size_t>(__builtin_ctz(mask));
+            if (is_delimiter(data[hit - 1])) {
+                return field_value(data, length, hit);
+            }
+            mask &= mask - 1;
+        }
+    }
+    if (pos >= length) {
+        return std::string_view();
+    }
+    // The last few bytes: back up one so a tag starting there keeps its delimiter
+    return find_symbol_scalar(data + pos - 1, length - pos + 1);
+#else
+    return find_symbol_scalar(data, length);
+#endif
+}
+
+} // namespace parser
+} // namespace feedhandler
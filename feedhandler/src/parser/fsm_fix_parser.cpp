@@ -1,13 +1,144 @@
 #include "parser/fsm_fix_parser.hpp"
+#include "parser/ascii.hpp"
 #include "parser/fast_number_parser.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <cstring>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace feedhandler {
 namespace parser {
 
+namespace {
+
+inline bool is_value_delimiter(char c) {
+    return c == '|' || c == '\x01' || c == '\n' || c == '\r';
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/**
+ * @brief High bit set in each byte of word equal to byte (lowest hit is exact)
+ */
+inline uint64_t match_byte(uint64_t word, uint8_t byte) {
+    constexpr uint64_t ones = 0x0101010101010101ULL;
+    constexpr uint64_t highs = 0x8080808080808080ULL;
+    uint64_t x = word ^ (ones * byte);
+    return (x - ones) & ~x & highs;
+}
+#endif
+
+/**
+ * @brief Offset of the first value delimiter in [data, data + length)
+ * @return Offset, or length if the value runs past the buffer
+ *
+ * 16 bytes per step with SSE2, 8 bytes per step (SWAR) otherwise.
+ */
+inline size_t find_value_delimiter(const char* data, size_t length) {
+    size_t i = 0;
+    
+#ifdef __SSE2__
+    const __m128i pipe = _mm_set1_epi8('|');
+    const __m128i soh = _mm_set1_epi8('\x01');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, pipe), _mm_cmpeq_epi8(chunk, soh)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+    
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        uint64_t hits = match_byte(word, '|') | match_byte(word, '\x01') |
+                        match_byte(word, '\n') | match_byte(word, '\r');
+        if (hits != 0) {
+            return i + (__builtin_ctzll(hits) >> 3);
+        }
+    }
+#endif
+    
+    for (; i < length; ++i) {
+        if (is_value_delimiter(data[i])) {
+            return i;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Offset of the first "8=FIX" in [data, data + length)
+ * @return Offset, or length if there is none
+ *
+ * Two-byte filter: bytes equal to '8' followed by '=' are found 16 at a
+ * time with SSE2 (8 at a time SWAR otherwise), and only those candidates
+ * are compared in full, so junk is skipped at close to memory speed.
+ */
+inline size_t find_message_begin(const char* data, size_t length) {
+    constexpr char begin[] = "8=FIX";
+    constexpr size_t begin_length = sizeof(begin) - 1;
+    auto matches = [&](size_t offset) {
+        return offset + begin_length <= length && std::memcmp(data + offset, begin, begin_length) == 0;
+    };
+    size_t i = 0;
+    
+#ifdef __SSE2__
+    const __m128i eight = _mm_set1_epi8('8');
+    const __m128i equals = _mm_set1_epi8('=');
+    
+    for (; i + 17 <= length; i += 16) {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 1));
+        int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, eight),
+                                                   _mm_cmpeq_epi8(second, equals)));
+        for (; mask != 0; mask &= mask - 1) {
+            size_t candidate = i + __builtin_ctz(mask);
+            if (matches(candidate)) {
+                return candidate;
+            }
+        }
+    }
+#endif
+    
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; i + 9 <= length; i += 8) {
+        uint64_t first;
+        uint64_t second;
+        std::memcpy(&first, data + i, sizeof(first));
+        std::memcpy(&second, data + i + 1, sizeof(second));
+        // Bytes above a hit may be false positives; matches() weeds them out
+        for (uint64_t hits = match_byte(first, '8') & match_byte(second, '='); hits != 0; hits &= hits - 1) {
+            size_t candidate = i + (__builtin_ctzll(hits) >> 3);
+            if (matches(candidate)) {
+                return candidate;
+            }
+        }
+    }
+#endif
+    
+    for (; i + begin_length <= length; ++i) {
+        if (matches(i)) {
+            return i;
+        }
+    }
+    return length;
+}
+
+} // namespace
+
 FSMFixParser::FSMFixParser() 
     : state_(State::WAIT_TAG)
     , current_tag_(0)
@@ -16,6 +147,7 @@ FSMFixParser::FSMFixParser()
     , symbol_start_(0)
     , symbol_length_(0)
     , garbage_recovery_enabled_(false)
+    , fast_path_enabled_(true)
     , recovery_state_(RecoveryState::SCANNING) {
 }
 
@@ -31,41 +163,224 @@ void FSMFixParser::reset() {
 }
 
 size_t FSMFixParser::parse(const char* buffer, size_t length, std::vector<common::Tick>& ticks) {
-    size_t consumed = 0;
+    return parse_into(buffer, length, ticks);
+}
+
+size_t FSMFixParser::parse(const char* buffer, size_t length, std::vector<common::CompactTick>& ticks) {
+    return parse_into(buffer, length, ticks);
+}
+
+size_t FSMFixParser::parse(const char* buffer, size_t length, common::TickSpan<common::Tick>& ticks) {
+    return parse_into(buffer, length, ticks);
+}
+
+size_t FSMFixParser::parse(const char* buffer, size_t length, common::TickSpan<common::CompactTick>& ticks) {
+    return parse_into(buffer, length, ticks);
+}
+
+size_t FSMFixParser::parse(const char* buffer, size_t length, common::TickPool& ticks) {
+    return parse_into(buffer, length, ticks);
+}
+
+size_t FSMFixParser::parse(const char* buffer, size_t length, common::TickBatch& ticks) {
+    return parse_into(buffer, length, ticks);
+}
+
+size_t FSMFixParser::parse(const char* buffer, size_t length, common::TickSpan<common::FlyweightTick>& ticks) {
+    return parse_into(buffer, length, ticks);
+}
+
+template<typename Out>
+size_t FSMFixParser::parse_into(const char* buffer, size_t length, Out& ticks) {
+    if (common::output_full(ticks)) {
+        return 0;
+    }
+    
+    // A symbol seen in place belongs to the previous buffer now
+    tick_builder_.symbol_in_place = nullptr;
+    
+    call_timestamp_ = receive_timestamp_;
+    if (call_timestamp_ == 0 && batch_timestamps_) {
+        call_timestamp_ = common::Tick::current_timestamp_ns();
+    }
+    
+    size_t i = 0;
+    size_t emitted = 0;
     
-    for (size_t i = 0; i < length; ++i) {
-        char c = buffer[i];
+    while (i < length) {
+        bool complete = false;
+        size_t step = 0;
+        
+        // Between fields: take whole fields in place while they are
+        // fully inside the buffer, fall back to the FSM otherwise
+        if (fast_path_enabled_ && state_ == State::WAIT_TAG) {
+            step = parse_field_in_place(buffer + i, length - i, complete);
+        }
+        if (step == 0) {
+            complete = process_char(buffer[i]);
+            step = 1;
+        }
+        i += step;
         
-        if (process_char(c)) {
+        if (complete) {
             // Message complete - create tick
             finalize_message();
             
             if (tick_builder_.is_valid()) {
-                common::Tick tick;
-                // Copy symbol to tick's internal storage to avoid dangling reference
-                tick.copy_symbol(tick_builder_.get_symbol());
-                tick.price = tick_builder_.price;
-                tick.qty = tick_builder_.qty;
-                tick.side = tick_builder_.side;
-                tick.timestamp = common::Tick::current_timestamp_ns();
-                
-                ticks.push_back(tick);
+                emit_tick(ticks);
+                ++emitted;
             }
             
             // Reset for next message
             tick_builder_.reset();
+            
+            // Fixed-capacity output: stop at the message boundary so the
+            // caller can drain and resume from the returned offset
+            if (common::output_full(ticks)) {
+                break;
+            }
         }
-        
-        consumed = i + 1;
     }
     
-    return consumed;
+    if (wire_to_parse_ && receive_timestamp_ != 0 && emitted != 0) {
+        uint64_t now = common::Tick::current_timestamp_ns();
+        wire_to_parse_->record(now > receive_timestamp_ ? now - receive_timestamp_ : 0, emitted);
+    }
+    
+    return i;
+}
+
+size_t FSMFixParser::parse_field_in_place(const char* buffer, size_t length, bool& message_complete) {
+    constexpr size_t MAX_FAST_TAG_DIGITS = 9;
+    
+    if (buffer[0] < '0' || buffer[0] > '9') {
+        return 0;  // Leading junk/delimiters: let the FSM skip them
+    }
+    
+    size_t tag_end = 1;
+    while (tag_end < length && tag_end < MAX_FAST_TAG_DIGITS &&
+           buffer[tag_end] >= '0' && buffer[tag_end] <= '9') {
+        ++tag_end;
+    }
+    if (tag_end >= length || buffer[tag_end] != '=') {
+        return 0;  // Tag split across fragments or malformed
+    }
+    
+    const char* value = buffer + tag_end + 1;
+    size_t remaining = length - tag_end - 1;
+    size_t value_length = find_value_delimiter(value, remaining);
+    if (value_length == remaining) {
+        return 0;  // Value continues in the next fragment
+    }
+    
+    int tag = FastNumberParser::fast_atoi(buffer, buffer + tag_end);
+    char delimiter = value[value_length];
+    
+    // Same truncation as the FSM value buffer
+    size_t stored_length = std::min(value_length, sizeof(value_buffer_) - 1);
+    message_complete = apply_field(tag, value, stored_length) ||
+                       (delimiter == '\n' && tick_builder_.is_valid());
+    
+    return tag_end + 1 + value_length + 1;
+}
+
+bool FSMFixParser::apply_field(int tag, const char* value, size_t length) {
+    // Optimized tag switch for O(1) field assignment
+    // Compiler will generate a jump table for dense tag ranges
+    switch (tag) {
+        case 38: // OrderQty (Quantity) - HOT PATH
+            tick_builder_.qty = FastNumberParser::fast_atoi(value, value + length);
+            tick_builder_.has_qty = true;
+            break;
+            
+        case 44: // Price - HOT PATH
+            {
+                int64_t fixed_value = FastNumberParser::fast_atof_fixed(value, value + length);
+                double price_double = static_cast<double>(fixed_value) / 10000.0;
+                tick_builder_.price = common::double_to_price(price_double);
+                tick_builder_.has_price = true;
+            }
+            break;
+            
+        case 54: // Side - HOT PATH
+            {
+                int side_value = FastNumberParser::fast_atoi(value, value + length);
+                tick_builder_.side = common::fix_side_to_char(side_value);
+                tick_builder_.has_side = true;
+            }
+            break;
+            
+        case 55: // Symbol - HOT PATH
+            // Copy symbol to persistent storage
+            if (length < sizeof(tick_builder_.symbol_storage)) {
+                std::memcpy(tick_builder_.symbol_storage, value, length);
+                tick_builder_.symbol_storage[length] = '\0';  // Null terminate
+                tick_builder_.symbol_length = length;
+                tick_builder_.symbol_in_place = (value != value_buffer_) ? value : nullptr;
+                tick_builder_.has_symbol = true;
+            }
+            break;
+            
+        case 10: // Checksum - end of message
+            return true;
+            
+        // Less common tags - grouped together
+        case 8:  // BeginString
+        case 9:  // BodyLength
+        case 35: // MsgType
+        case 52: // SendingTime
+        default:
+            // Ignore unknown/unneeded tags
+            break;
+    }
+    
+    return false;
+}
+
+template<typename Out>
+void FSMFixParser::emit_tick(Out& ticks) const {
+    typename Out::value_type tick;
+    build_tick(tick);
+    ticks.push_back(tick);
+}
+
+void FSMFixParser::build_tick(common::Tick& tick) const {
+    // Copy symbol to tick's internal storage to avoid dangling reference
+    tick.copy_symbol(tick_builder_.get_symbol());
+    tick.intern_symbol();
+    tick.price = tick_builder_.price;
+    tick.qty = tick_builder_.qty;
+    tick.side = tick_builder_.side;
+    tick.timestamp = call_timestamp_ ? call_timestamp_ : common::Tick::current_timestamp_ns();
+}
+
+void FSMFixParser::build_tick(common::CompactTick& tick) const {
+    tick.instrument_id = common::SymbolTable::global().intern(tick_builder_.get_symbol());
+    tick.price = tick_builder_.price;
+    tick.qty = tick_builder_.qty;
+    tick.side = tick_builder_.side;
+    tick.timestamp = call_timestamp_ ? call_timestamp_ : common::Tick::current_timestamp_ns();
+}
+
+void FSMFixParser::build_tick(common::FlyweightTick& tick) const {
+    if (tick_builder_.symbol_in_place) {
+        // Zero-copy: view the symbol where it sits in the input buffer
+        tick.symbol = std::string_view(tick_builder_.symbol_in_place, tick_builder_.symbol_length);
+    } else {
+        // Assembled across fragments: view the interned copy, which never moves
+        auto& table = common::SymbolTable::global();
+        tick.symbol = table.name(table.intern(tick_builder_.get_symbol()));
+    }
+    tick.price = tick_builder_.price;
+    tick.qty = tick_builder_.qty;
+    tick.side = tick_builder_.side;
+    tick.timestamp = call_timestamp_ ? call_timestamp_ : common::Tick::current_timestamp_ns();
 }
 
 bool FSMFixParser::process_char(char c) {
     switch (state_) {
         case State::WAIT_TAG:
-            if (c >= '0' && c <= '9') {
+            if (ascii::is_digit(c)) {
                 // Start of new tag
                 tag_buffer_[0] = c;
                 tag_length_ = 1;
@@ -76,7 +391,7 @@ bool FSMFixParser::process_char(char c) {
             
         case State::READ_TAG:
             // Branch prediction: digit continuation is LIKELY
-            if (__builtin_expect(c >= '0' && c <= '9', 1)) {
+            if (__builtin_expect(ascii::is_digit(c), 1)) {
                 // Continue reading tag
                 if (tag_length_ < sizeof(tag_buffer_) - 1) {
                     tag_buffer_[tag_length_++] = c;
@@ -108,53 +423,10 @@ bool FSMFixParser::process_char(char c) {
                 // End of value - process the field using optimized tag switch
                 value_buffer_[value_length_] = '\0';
                 
-                // Optimized tag switch for O(1) field assignment
-                // Compiler will generate a jump table for dense tag ranges
-                switch (current_tag_) {
-                    case 38: // OrderQty (Quantity) - HOT PATH
-                        tick_builder_.qty = parse_accumulated_int();
-                        tick_builder_.has_qty = true;
-                        break;
-                        
-                    case 44: // Price - HOT PATH
-                        {
-                            double price_double = parse_accumulated_double();
-                            tick_builder_.price = common::double_to_price(price_double);
-                            tick_builder_.has_price = true;
-                        }
-                        break;
-                        
-                    case 54: // Side - HOT PATH
-                        {
-                            int side_value = parse_accumulated_int();
-                            tick_builder_.side = common::fix_side_to_char(side_value);
-                            tick_builder_.has_side = true;
-                        }
-                        break;
-                        
-                    case 55: // Symbol - HOT PATH
-                        // Copy symbol to persistent storage
-                        if (value_length_ < sizeof(tick_builder_.symbol_storage)) {
-                            std::memcpy(tick_builder_.symbol_storage, value_buffer_, value_length_);
-                            tick_builder_.symbol_storage[value_length_] = '\0';  // Null terminate
-                            tick_builder_.symbol_length = value_length_;
-                            tick_builder_.has_symbol = true;
-                        }
-                        break;
-                        
-                    case 10: // Checksum - end of message
-                        state_ = State::COMPLETE;
-                        current_tag_ = 0;
-                        return true; // Message complete
-                        
-                    // Less common tags - grouped together
-                    case 8:  // BeginString
-                    case 9:  // BodyLength
-                    case 35: // MsgType
-                    case 52: // SendingTime
-                    default:
-                        // Ignore unknown/unneeded tags
-                        break;
+                if (apply_field(current_tag_, value_buffer_, value_length_)) {
+                    state_ = State::COMPLETE;
+                    current_tag_ = 0;
+                    return true; // Message complete
                 }
                 
                 // Reset for next field
@@ -181,7 +453,7 @@ bool FSMFixParser::process_char(char c) {
             current_tag_ = 0;
             
             // Process this character as start of new message
-            if (c >= '0' && c <= '9') {
+            if (ascii::is_digit(c)) {
                 tag_buffer_[0] = c;
                 tag_length_ = 1;
                 state_ = State::READ_TAG;
@@ -211,13 +483,6 @@ int FSMFixParser::parse_accumulated_int() const {
     }
 }
 
-double FSMFixParser::parse_accumulated_double() const {
-    // Parse from value_buffer_ using fixed-point conversion
-    int64_t fixed_value = FastNumberParser::fast_atof_fixed(value_buffer_, value_buffer_ + value_length_);
-    // Convert back to double for compatibility
-    return static_cast<double>(fixed_value) / 10000.0;
-}
-
 uint64_t FSMFixParser::benchmark_parsing(size_t message_count) {
     // Create a sample FIX message for benchmarking
     std::string sample_message = "8=FIX.4.4|9=79|35=D|55=MSFT|44=123.4500|38=1000|54=1|52=20240131-12:34:56|10=020|\n";
@@ -282,71 +547,20 @@ bool FSMFixParser::is_fix_message_start(const char* buffer, size_t length) const
 }
 
 size_t FSMFixParser::attempt_garbage_recovery(const char* buffer, size_t length) {
-    // Scan through buffer looking for "8=FIX" pattern
-    recovery_state_ = RecoveryState::SCANNING;
-    
-    for (size_t i = 0; i < length; ++i) {
-        char c = buffer[i];
+    // Vector scan for "8=FIX" instead of a byte at a time
+    size_t begin = find_message_begin(buffer, length);
+    if (begin < length) {
+        recovery_state_ = RecoveryState::COMPLETE;
+        recovery_stats_.recovery_count++;
+        recovery_stats_.bytes_skipped += begin;
         
-        switch (recovery_state_) {
-            case RecoveryState::SCANNING:
-                if (c == '8') {
-                    recovery_state_ = RecoveryState::FOUND_8;
-                }
-                break;
-                
-            case RecoveryState::FOUND_8:
-                if (c == '=') {
-                    recovery_state_ = RecoveryState::FOUND_EQUALS;
-                } else if (c != '8') {
-                    recovery_state_ = RecoveryState::SCANNING;
-                }
-                break;
-                
-            case RecoveryState::FOUND_EQUALS:
-                if (c == 'F') {
-                    recovery_state_ = RecoveryState::FOUND_F;
-                } else if (c == '8') {
-                    recovery_state_ = RecoveryState::FOUND_8;
-                } else {
-                    recovery_state_ = RecoveryState::SCANNING;
-                }
-                break;
-                
-            case RecoveryState::FOUND_F:
-                if (c == 'I') {
-                    recovery_state_ = RecoveryState::FOUND_FI;
-                } else if (c == '8') {
-                    recovery_state_ = RecoveryState::FOUND_8;
-                } else {
-                    recovery_state_ = RecoveryState::SCANNING;
-                }
-                break;
-                
-            case RecoveryState::FOUND_FI:
-                if (c == 'X') {
-                    // Found "8=FIX"! Recovery successful
-                    recovery_state_ = RecoveryState::COMPLETE;
-                    recovery_stats_.recovery_count++;
-                    recovery_stats_.bytes_skipped += (i - 4);  // -4 because we want to start at '8'
-                    
-                    // Return position of '8' (start of "8=FIX")
-                    return (i >= 4) ? (i - 4) : 0;
-                } else if (c == '8') {
-                    recovery_state_ = RecoveryState::FOUND_8;
-                } else {
-                    recovery_state_ = RecoveryState::SCANNING;
-                }
-                break;
-                
-            case RecoveryState::COMPLETE:
-                // Should not reach here
-                break;
-        }
+        // Position of '8' (start of "8=FIX")
+        return begin;
     }
     
     // Did not find "8=FIX" in this buffer
     // Return length to skip entire buffer
+    recovery_state_ = RecoveryState::SCANNING;
     recovery_stats_.bytes_skipped += length;
     return length;
 }
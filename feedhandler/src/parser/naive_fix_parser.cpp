@@ -25,6 +25,7 @@ common::Tick NaiveFixParser::parse_message(const std::string& message) {
     if (fields.find(55) != fields.end()) {
         symbol_storage = fields[55];
         tick.symbol = std::string_view(symbol_storage);
+        tick.intern_symbol();
     }
     
     // Tag 44: Price
@@ -50,6 +51,10 @@ common::Tick NaiveFixParser::parse_message(const std::string& message) {
     return tick;
 }
 
+common::CompactTick NaiveFixParser::parse_message_compact(const std::string& message) {
+    return parse_message(message).to_compact();
+}
+
 std::vector<common::Tick> NaiveFixParser::parse_messages(const std::vector<std::string>& messages) {
     std::vector<common::Tick> ticks;
     ticks.reserve(messages.size());
@@ -68,6 +73,7 @@ std::vector<common::Tick> NaiveFixParser::parse_messages(const std::vector<std::
         if (fields.find(55) != fields.end()) {
             symbol_storage.push_back(fields[55]);
             tick.symbol = std::string_view(symbol_storage.back());
+            tick.intern_symbol();
         }
         
         // Tag 44: Price
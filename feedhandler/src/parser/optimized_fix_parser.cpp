@@ -8,38 +8,37 @@
 namespace feedhandler {
 namespace parser {
 
-common::Tick OptimizedFixParser::parse_message(std::string_view message) {
-    // Stack-allocated field storage (no heap allocation)
-    constexpr size_t MAX_FIELDS = 32;
-    Field fields[MAX_FIELDS];
-    
-    // Extract all tag-value pairs using optimized parsing
-    size_t field_count = extract_fields_optimized(message, fields, MAX_FIELDS);
+namespace {
+
+/**
+ * @brief Invoke func for each non-empty newline-separated message
+ * until func returns false
+ */
+template<typename Func>
+void for_each_line(std::string_view buffer, Func&& func) {
+    size_t start = 0;
+    size_t pos = 0;
     
+    while (pos < buffer.size()) {
+        if (buffer[pos] == '\n' || pos == buffer.size() - 1) {
+            size_t end = (buffer[pos] == '\n') ? pos : pos + 1;
+            if (end > start && !func(buffer.substr(start, end - start))) {
+                return;  // Output full
+            }
+            start = pos + 1;
+        }
+        ++pos;
+    }
+}
+
+} // namespace
+
+common::Tick OptimizedFixParser::parse_message(std::string_view message) {
     // Initialize tick with default values
     common::Tick tick;
     
-    // Extract required fields for a tick using fast lookups
-    // Tag 55: Symbol
-    if (const Field* field = find_field_fast(fields, field_count, 55)) {
-        tick.symbol = field->value;  // Zero-copy: points directly into input buffer
-    }
-    
-    // Tag 44: Price - use fast fixed-point parsing
-    if (const Field* field = find_field_fast(fields, field_count, 44)) {
-        tick.price = FastNumberParser::fast_atof_fixed(field->value);
-    }
-    
-    // Tag 38: OrderQty (Quantity) - use fast integer parsing
-    if (const Field* field = find_field_fast(fields, field_count, 38)) {
-        tick.qty = FastNumberParser::fast_atoi(field->value);
-    }
-    
-    // Tag 54: Side - use fast integer parsing
-    if (const Field* field = find_field_fast(fields, field_count, 54)) {
-        int side_value = FastNumberParser::fast_atoi(field->value);
-        tick.side = common::fix_side_to_char(side_value);
-    }
+    // Symbol (zero-copy, points into the input), price, quantity, side
+    TickSchema<common::Tick>::parse(message, tick);
     
     // Set timestamp to current time
     tick.timestamp = common::Tick::current_timestamp_ns();
@@ -50,25 +49,65 @@ common::Tick OptimizedFixParser::parse_message(std::string_view message) {
 std::vector<common::Tick> OptimizedFixParser::parse_messages_from_buffer(std::string_view buffer) {
     std::vector<common::Tick> ticks;
     
-    // Split buffer by newlines (assuming each line is a message)
-    size_t start = 0;
-    size_t pos = 0;
+    for_each_line(buffer, [&ticks](std::string_view message) {
+        ticks.push_back(parse_message(message));
+        return true;
+    });
     
-    while (pos < buffer.size()) {
-        if (buffer[pos] == '\n' || pos == buffer.size() - 1) {
-            size_t end = (buffer[pos] == '\n') ? pos : pos + 1;
-            if (end > start) {
-                std::string_view message = buffer.substr(start, end - start);
-                if (!message.empty()) {
-                    ticks.push_back(parse_message(message));
-                }
-            }
-            start = pos + 1;
-        }
-        ++pos;
+    return ticks;
+}
+
+common::CompactTick OptimizedFixParser::parse_message_compact(std::string_view message) {
+    common::CompactTick tick;
+    
+    // Symbol -> instrument ID, price, quantity, side
+    TickSchema<common::CompactTick>::parse(message, tick);
+    
+    tick.timestamp = common::Tick::current_timestamp_ns();
+    
+    return tick;
+}
+
+size_t OptimizedFixParser::parse_messages_from_buffer(std::string_view buffer,
+                                        std::vector<common::CompactTick>& ticks) {
+    size_t before = ticks.size();
+    
+    for_each_line(buffer, [&ticks](std::string_view message) {
+        ticks.push_back(parse_message_compact(message));
+        return true;
+    });
+    
+    return ticks.size() - before;
+}
+
+size_t OptimizedFixParser::parse_messages_from_buffer(std::string_view buffer,
+                                        common::TickSpan<common::Tick>& ticks) {
+    size_t before = ticks.size();
+    if (ticks.is_full()) {
+        return 0;
     }
     
-    return ticks;
+    for_each_line(buffer, [&ticks](std::string_view message) {
+        ticks.push_back(parse_message(message));
+        return !ticks.is_full();
+    });
+    
+    return ticks.size() - before;
+}
+
+size_t OptimizedFixParser::parse_messages_from_buffer(std::string_view buffer,
+                                        common::TickSpan<common::CompactTick>& ticks) {
+    size_t before = ticks.size();
+    if (ticks.is_full()) {
+        return 0;
+    }
+    
+    for_each_line(buffer, [&ticks](std::string_view message) {
+        ticks.push_back(parse_message_compact(message));
+        return !ticks.is_full();
+    });
+    
+    return ticks.size() - before;
 }
 
 uint64_t OptimizedFixParser::benchmark_parsing(size_t message_count) {
@@ -115,53 +154,5 @@ uint64_t OptimizedFixParser::benchmark_parsing(size_t message_count) {
     return microseconds;
 }
 
-size_t OptimizedFixParser::extract_fields_optimized(std::string_view message, Field* fields, size_t max_fields) {
-    size_t field_count = 0;
-    const char* ptr = message.data();
-    const char* end = ptr + message.size();
-    
-    while (ptr < end && field_count < max_fields) {
-        // Find next delimiter '|'
-        const char* delim_ptr = ptr;
-        while (delim_ptr < end && *delim_ptr != '|') {
-            ++delim_ptr;
-        }
-        
-        // Extract field
-        if (delim_ptr > ptr) {
-            // Find '=' separator
-            const char* eq_ptr = ptr;
-            while (eq_ptr < delim_ptr && *eq_ptr != '=') {
-                ++eq_ptr;
-            }
-            
-            if (eq_ptr < delim_ptr && eq_ptr > ptr) {
-                // Parse tag using fast_atoi
-                int tag = FastNumberParser::fast_atoi(ptr, eq_ptr);
-                if (tag > 0) {
-                    fields[field_count].tag = tag;
-                    fields[field_count].value = std::string_view(eq_ptr + 1, delim_ptr - eq_ptr - 1);
-                    ++field_count;
-                }
-            }
-        }
-        
-        ptr = delim_ptr + 1;
-    }
-    
-    return field_count;
-}
-
-const OptimizedFixParser::Field* OptimizedFixParser::find_field_fast(const Field* fields, size_t field_count, int tag) {
-    // Linear search is fast for small arrays (typically < 20 fields)
-    // Could be optimized with binary search if field_count is large
-    for (size_t i = 0; i < field_count; ++i) {
-        if (fields[i].tag == tag) {
-            return &fields[i];
-        }
-    }
-    return nullptr;
-}
-
 } // namespace parser
 } // namespace feedhandler
\ No newline at end of file
@@ -2,140 +2,151 @@
 #include "parser/fast_number_parser.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <algorithm>
 
 namespace feedhandler {
 namespace parser {
 
+namespace {
+
+inline void convert(const common::Tick& tick, common::Tick& out) {
+    out = tick;
+}
+
+inline void convert(const common::Tick& tick, common::CompactTick& out) {
+    out = tick.to_compact();
+}
+
+template<typename Out>
+inline void emit(Out& ticks, const common::Tick& tick) {
+    typename Out::value_type out;
+    convert(tick, out);
+    ticks.push_back(out);
+}
+
+// MDEntryType (269): 0=Bid, 1=Offer, anything else is a trade-like entry
+inline char entry_side(char entry_type) {
+    return (entry_type == '0') ? 'B' : (entry_type == '1') ? 'S' : 'T';
+}
+
+} // namespace
+
 std::vector<common::Tick> RepeatingGroupParser::parse_repeating_groups(std::string_view message) {
     std::vector<common::Tick> ticks;
-    
-    // Stack-allocated field storage
-    constexpr size_t MAX_FIELDS = 128;  // Larger for repeating groups
-    Field fields[MAX_FIELDS];
-    
-    // Extract all fields from the message
-    size_t field_count = extract_all_fields(message, fields, MAX_FIELDS);
-    
-    // Find shared fields (symbol, etc.)
-    std::string_view symbol;
-    if (const Field* field = find_first_field(fields, field_count, 55)) {
-        symbol = field->value;
+    parse_into(message, ticks);
+    return ticks;
+}
+
+size_t RepeatingGroupParser::parse_repeating_groups(std::string_view message,
+                                                    std::vector<common::CompactTick>& ticks) {
+    return parse_into(message, ticks);
+}
+
+size_t RepeatingGroupParser::parse_repeating_groups(std::string_view message,
+                                                    common::TickSpan<common::Tick>& ticks) {
+    return parse_into(message, ticks);
+}
+
+size_t RepeatingGroupParser::parse_repeating_groups(std::string_view message,
+                                                    common::TickSpan<common::CompactTick>& ticks) {
+    return parse_into(message, ticks);
+}
+
+size_t RepeatingGroupParser::parse_entries(std::string_view message,
+                                           common::TickSpan<MDEntry>& entries) {
+    const size_t initial_size = entries.size();
+    if (entries.is_full()) {
+        return 0;
     }
-    
-    // Find number of repeating groups (Tag 268: NoMDEntries)
-    int num_entries = 0;
-    if (const Field* field = find_first_field(fields, field_count, 268)) {
-        num_entries = FastNumberParser::fast_atoi(field->value);
+    for_each_entry(message, [&](const MDEntry& entry) {
+        entries.push_back(entry);
+        return !entries.is_full();
+    });
+    return entries.size() - initial_size;
+}
+
+template<typename Out>
+size_t RepeatingGroupParser::parse_into(std::string_view message, Out& ticks) {
+    const size_t initial_size = ticks.size();
+    if (common::output_full(ticks)) {
+        return 0;
     }
     
-    // If no explicit count, count the number of MDEntryType (269) tags
-    if (num_entries == 0) {
-        constexpr size_t MAX_INDICES = 32;
-        size_t indices[MAX_INDICES];
-        num_entries = find_all_fields(fields, field_count, 269, indices, MAX_INDICES);
-    }
+    // One clock read per message; every entry arrived together
+    const uint64_t timestamp = common::Tick::current_timestamp_ns();
     
-    if (num_entries == 0) {
-        // No repeating groups, parse as single tick
+    auto emit_entry = [&](const MDEntry& entry) {
         common::Tick tick;
-        tick.symbol = symbol;
-        
-        // Tag 44 or 270: Price
-        if (const Field* field = find_first_field(fields, field_count, 44)) {
-            tick.price = FastNumberParser::fast_atof_fixed(field->value);
-        } else if (const Field* field = find_first_field(fields, field_count, 270)) {
-            tick.price = FastNumberParser::fast_atof_fixed(field->value);
-        }
-        
-        // Tag 38 or 271: Quantity
-        if (const Field* field = find_first_field(fields, field_count, 38)) {
-            tick.qty = FastNumberParser::fast_atoi(field->value);
-        } else if (const Field* field = find_first_field(fields, field_count, 271)) {
-            tick.qty = FastNumberParser::fast_atoi(field->value);
-        }
-        
-        // Tag 54 or 269: Side
-        if (const Field* field = find_first_field(fields, field_count, 54)) {
-            int side_value = FastNumberParser::fast_atoi(field->value);
-            tick.side = common::fix_side_to_char(side_value);
-        } else if (const Field* field = find_first_field(fields, field_count, 269)) {
-            int entry_type = FastNumberParser::fast_atoi(field->value);
-            tick.side = (entry_type == 0) ? 'B' : (entry_type == 1) ? 'S' : 'T';
-        }
-        
-        tick.timestamp = common::Tick::current_timestamp_ns();
-        
+        tick.symbol = entry.symbol;
+        tick.instrument_id = entry.instrument_id;
+        tick.price = entry.price;
+        tick.qty = entry.size;
+        tick.side = entry_side(entry.entry_type);
+        tick.timestamp = timestamp;
         if (tick.is_valid()) {
-            ticks.push_back(tick);
+            emit(ticks, tick);
         }
-        
-        return ticks;
-    }
+        return !common::output_full(ticks);  // Fixed-capacity output: drop the rest of the group
+    };
+    MessageFields fields;
+    scan_message(message, fields, emit_entry);
     
-    // Parse repeating groups
-    // Find all MDEntryType (269), MDEntryPx (270), and MDEntrySize (271) tags
-    constexpr size_t MAX_INDICES = 32;
-    size_t type_indices[MAX_INDICES];
-    size_t price_indices[MAX_INDICES];
-    size_t size_indices[MAX_INDICES];
-    
-    size_t type_count = find_all_fields(fields, field_count, 269, type_indices, MAX_INDICES);
-    size_t price_count = find_all_fields(fields, field_count, 270, price_indices, MAX_INDICES);
-    size_t size_count = find_all_fields(fields, field_count, 271, size_indices, MAX_INDICES);
-    
-    // Parse each repeating group entry
-    size_t entry_count = std::min({type_count, price_count, size_count});
-    ticks.reserve(entry_count);
-    
-    for (size_t i = 0; i < entry_count; ++i) {
+    if (!fields.grouped) {
+        // No repeating groups, parse as single tick
         common::Tick tick;
-        tick.symbol = symbol;
-        
-        // MDEntryType (269): 0=Bid, 1=Offer, 2=Trade
-        int entry_type = FastNumberParser::fast_atoi(fields[type_indices[i]].value);
-        tick.side = (entry_type == 0) ? 'B' : (entry_type == 1) ? 'S' : 'T';
-        
-        // MDEntryPx (270): Price
-        tick.price = FastNumberParser::fast_atof_fixed(fields[price_indices[i]].value);
-        
-        // MDEntrySize (271): Quantity
-        tick.qty = FastNumberParser::fast_atoi(fields[size_indices[i]].value);
-        
-        tick.timestamp = common::Tick::current_timestamp_ns();
+        tick.symbol = fields.symbol;
+        tick.instrument_id = common::SymbolTable::global().intern(fields.symbol);
+        tick.price = fields.price;
+        tick.qty = fields.qty;
+        tick.side = fields.side;
+        tick.timestamp = timestamp;
         
         if (tick.is_valid()) {
-            ticks.push_back(tick);
+            emit(ticks, tick);
         }
     }
     
-    return ticks;
+    return ticks.size() - initial_size;
 }
 
 std::vector<common::Tick> RepeatingGroupParser::parse_buffer_with_repeating_groups(std::string_view buffer) {
     std::vector<common::Tick> all_ticks;
+    parse_buffer_into(buffer, all_ticks);
+    return all_ticks;
+}
+
+size_t RepeatingGroupParser::parse_buffer_with_repeating_groups(std::string_view buffer,
+                                                                common::TickSpan<common::Tick>& ticks) {
+    return parse_buffer_into(buffer, ticks);
+}
+
+size_t RepeatingGroupParser::parse_buffer_with_repeating_groups(std::string_view buffer,
+                                                                common::TickSpan<common::CompactTick>& ticks) {
+    return parse_buffer_into(buffer, ticks);
+}
+
+template<typename Out>
+size_t RepeatingGroupParser::parse_buffer_into(std::string_view buffer, Out& ticks) {
+    const size_t initial_size = ticks.size();
     
-    // Split buffer by newlines
+    // Split buffer by newlines; every message appends straight into ticks
     size_t start = 0;
     size_t pos = 0;
     
-    while (pos < buffer.size()) {
+    while (pos < buffer.size() && !common::output_full(ticks)) {
         if (buffer[pos] == '\n' || pos == buffer.size() - 1) {
             size_t end = (buffer[pos] == '\n') ? pos : pos + 1;
             if (end > start) {
-                std::string_view message = buffer.substr(start, end - start);
-                if (!message.empty()) {
-                    auto ticks = parse_repeating_groups(message);
-                    all_ticks.insert(all_ticks.end(), ticks.begin(), ticks.end());
-                }
+                parse_into(buffer.substr(start, end - start), ticks);
             }
             start = pos + 1;
         }
         ++pos;
     }
     
-    return all_ticks;
+    return ticks.size() - initial_size;
 }
 
 uint64_t RepeatingGroupParser::benchmark_repeating_groups(size_t message_count, size_t entries_per_message) {
@@ -198,62 +209,5 @@ uint64_t RepeatingGroupParser::benchmark_repeating_groups(size_t message_count,
     return microseconds;
 }
 
-size_t RepeatingGroupParser::extract_all_fields(std::string_view message, Field* fields, size_t max_fields) {
-    size_t field_count = 0;
-    const char* ptr = message.data();
-    const char* end = ptr + message.size();
-    
-    while (ptr < end && field_count < max_fields) {
-        // Find next delimiter '|'
-        const char* delim_ptr = ptr;
-        while (delim_ptr < end && *delim_ptr != '|') {
-            ++delim_ptr;
-        }
-        
-        // Extract field
-        if (delim_ptr > ptr) {
-            // Find '=' separator
-            const char* eq_ptr = ptr;
-            while (eq_ptr < delim_ptr && *eq_ptr != '=') {
-                ++eq_ptr;
-            }
-            
-            if (eq_ptr < delim_ptr && eq_ptr > ptr) {
-                // Parse tag
-                int tag = FastNumberParser::fast_atoi(ptr, eq_ptr);
-                if (tag > 0) {
-                    fields[field_count].tag = tag;
-                    fields[field_count].value = std::string_view(eq_ptr + 1, delim_ptr - eq_ptr - 1);
-                    ++field_count;
-                }
-            }
-        }
-        
-        ptr = delim_ptr + 1;
-    }
-    
-    return field_count;
-}
-
-size_t RepeatingGroupParser::find_all_fields(const Field* fields, size_t field_count, int tag, 
-                                             size_t* indices, size_t max_indices) {
-    size_t count = 0;
-    for (size_t i = 0; i < field_count && count < max_indices; ++i) {
-        if (fields[i].tag == tag) {
-            indices[count++] = i;
-        }
-    }
-    return count;
-}
-
-const RepeatingGroupParser::Field* RepeatingGroupParser::find_first_field(const Field* fields, size_t field_count, int tag) {
-    for (size_t i = 0; i < field_count; ++i) {
-        if (fields[i].tag == tag) {
-            return &fields[i];
-        }
-    }
-    return nullptr;
-}
-
 } // namespace parser
 } // namespace feedhandler
\ No newline at end of file
@@ -3,93 +3,301 @@
 #include <iostream>
 #include <cstring>
 #include <algorithm>
+#include <type_traits>
 
-#ifdef __ARM_NEON
-#include <arm_neon.h>
-#else
+#if defined(__x86_64__) || defined(__i386__)
 #include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace feedhandler {
 namespace parser {
 
-SIMDFixParser::SIMDFixParser() : buffer_pos_(0) {
+namespace {
+
+// Block kernels: bit i of a mask is set when block[i] matches. Each one
+// reads exactly 64 bytes. block_mask_* match one delimiter; classify_*
+// build the '=' and SOH/'|' masks of the structural index in one pass.
+using BlockMask = uint64_t (*)(const char* block, char delimiter);
+using Classify = BlockMasks (*)(const char* block);
+
+uint64_t block_mask_scalar(const char* block, char delimiter) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < 64; ++i) {
+        mask |= static_cast<uint64_t>(block[i] == delimiter) << i;
+    }
+    return mask;
+}
+
+BlockMasks classify_scalar(const char* block) {
+    BlockMasks masks{0, 0};
+    for (size_t i = 0; i < 64; ++i) {
+        masks.equals |= static_cast<uint64_t>(block[i] == '=') << i;
+        masks.delimiters |= static_cast<uint64_t>(block[i] == '\x01' || block[i] == '|') << i;
+    }
+    return masks;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("sse4.2")))
+uint64_t block_mask_sse42(const char* block, char delimiter) {
+    const __m128i needle = _mm_set1_epi8(delimiter);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        mask |= static_cast<uint64_t>(bits) << (i * 16);
+    }
+    return mask;
+}
+
+__attribute__((target("sse4.2")))
+BlockMasks classify_sse42(const char* block) {
+    const __m128i equals = _mm_set1_epi8('=');
+    const __m128i soh = _mm_set1_epi8('\x01');
+    const __m128i pipe = _mm_set1_epi8('|');
+    BlockMasks masks{0, 0};
+    for (int i = 0; i < 4; ++i) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+        __m128i delimiter = _mm_or_si128(_mm_cmpeq_epi8(chunk, soh), _mm_cmpeq_epi8(chunk, pipe));
+        uint32_t eq_bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, equals)));
+        uint32_t delim_bits = static_cast<uint32_t>(_mm_movemask_epi8(delimiter));
+        masks.equals |= static_cast<uint64_t>(eq_bits) << (i * 16);
+        masks.delimiters |= static_cast<uint64_t>(delim_bits) << (i * 16);
+    }
+    return masks;
+}
+
+__attribute__((target("avx2")))
+uint64_t block_mask_avx2(const char* block, char delimiter) {
+    const __m256i needle = _mm256_set1_epi8(delimiter);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+    uint32_t lo_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+    uint32_t hi_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+    return (static_cast<uint64_t>(hi_bits) << 32) | lo_bits;
+}
+
+__attribute__((target("avx2")))
+BlockMasks classify_avx2(const char* block) {
+    const __m256i equals = _mm256_set1_epi8('=');
+    const __m256i soh = _mm256_set1_epi8('\x01');
+    const __m256i pipe = _mm256_set1_epi8('|');
+    BlockMasks masks{0, 0};
+    for (int i = 0; i < 2; ++i) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i * 32));
+        __m256i delimiter = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, soh), _mm256_cmpeq_epi8(chunk, pipe));
+        uint32_t eq_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, equals)));
+        uint32_t delim_bits = static_cast<uint32_t>(_mm256_movemask_epi8(delimiter));
+        masks.equals |= static_cast<uint64_t>(eq_bits) << (i * 32);
+        masks.delimiters |= static_cast<uint64_t>(delim_bits) << (i * 32);
+    }
+    return masks;
+}
+
+__attribute__((target("avx512bw")))
+uint64_t block_mask_avx512bw(const char* block, char delimiter) {
+    __m512i chunk = _mm512_loadu_si512(block);
+    return _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(delimiter));
+}
+
+__attribute__((target("avx512bw")))
+BlockMasks classify_avx512bw(const char* block) {
+    __m512i chunk = _mm512_loadu_si512(block);
+    return BlockMasks{
+        _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('=')),
+        _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\x01')) |
+            _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('|'))
+    };
+}
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+// No movemask on NEON: weight each lane by its bit, then fold pairwise
+uint64_t neon_bitmask(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) {
+    static const uint8_t lane_bits[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                          0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    const uint8x16_t bits = vld1q_u8(lane_bits);
+    uint8x16_t sum = vpaddq_u8(vpaddq_u8(vandq_u8(m0, bits), vandq_u8(m1, bits)),
+                               vpaddq_u8(vandq_u8(m2, bits), vandq_u8(m3, bits)));
+    sum = vpaddq_u8(sum, sum);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
+
+uint64_t block_mask_neon(const char* block, char delimiter) {
+    const uint8x16_t needle = vdupq_n_u8(static_cast<uint8_t>(delimiter));
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(block);
+    return neon_bitmask(vceqq_u8(vld1q_u8(bytes), needle),
+                        vceqq_u8(vld1q_u8(bytes + 16), needle),
+                        vceqq_u8(vld1q_u8(bytes + 32), needle),
+                        vceqq_u8(vld1q_u8(bytes + 48), needle));
+}
+
+BlockMasks classify_neon(const char* block) {
+    const uint8x16_t equals = vdupq_n_u8('=');
+    const uint8x16_t soh = vdupq_n_u8('\x01');
+    const uint8x16_t pipe = vdupq_n_u8('|');
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(block);
+
+    uint8x16_t eq[4];
+    uint8x16_t delimiter[4];
+    for (int i = 0; i < 4; ++i) {
+        uint8x16_t chunk = vld1q_u8(bytes + i * 16);
+        eq[i] = vceqq_u8(chunk, equals);
+        delimiter[i] = vorrq_u8(vceqq_u8(chunk, soh), vceqq_u8(chunk, pipe));
+    }
+    return BlockMasks{neon_bitmask(eq[0], eq[1], eq[2], eq[3]),
+                      neon_bitmask(delimiter[0], delimiter[1], delimiter[2], delimiter[3])};
+}
+
+#endif
+
+bool cpu_supports(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR:
+            return true;
+#if defined(__x86_64__) || defined(__i386__)
+        case SimdLevel::SSE42:
+            return __builtin_cpu_supports("sse4.2");
+        case SimdLevel::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case SimdLevel::AVX512BW:
+            return __builtin_cpu_supports("avx512bw");
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        case SimdLevel::NEON:
+            return true; // Mandatory on ARMv8-A
+#endif
+        default:
+            return false;
+    }
+}
+
+BlockMask block_kernel(SimdLevel level) {
+    switch (level) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SimdLevel::SSE42:
+            return block_mask_sse42;
+        case SimdLevel::AVX2:
+            return block_mask_avx2;
+        case SimdLevel::AVX512BW:
+            return block_mask_avx512bw;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        case SimdLevel::NEON:
+            return block_mask_neon;
+#endif
+        default:
+            return block_mask_scalar;
+    }
+}
+
+Classify classify_kernel(SimdLevel level) {
+    switch (level) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SimdLevel::SSE42:
+            return classify_sse42;
+        case SimdLevel::AVX2:
+            return classify_avx2;
+        case SimdLevel::AVX512BW:
+            return classify_avx512bw;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        case SimdLevel::NEON:
+            return classify_neon;
+#endif
+        default:
+            return classify_scalar;
+    }
+}
+
+} // namespace
+
+SIMDFixParser::SIMDFixParser() : SIMDFixParser(detect_simd_level()) {}
+
+SIMDFixParser::SIMDFixParser(const config::PerformanceConfig::ParserConfig& config)
+    : SIMDFixParser(config.enable_simd ? parse_simd_level(config.simd_instruction_set)
+                                       : SimdLevel::SCALAR) {}
+
+SIMDFixParser::SIMDFixParser(SimdLevel level)
+    : simd_level_(supported_simd_level(level))
+    , block_mask_(block_kernel(simd_level_))
+    , classify_(classify_kernel(simd_level_))
+    , structural_{}
+    , buffer_pos_(0)
+    , carry_equals_(NO_EQUALS)
+    , message_open_(false)
+    , validation_enabled_(false) {
     std::memset(processing_buffer_, 0, sizeof(processing_buffer_));
 }
 
 void SIMDFixParser::reset() {
     buffer_pos_ = 0;
+    carry_equals_ = NO_EQUALS;
+    message_open_ = false;
+    pending_tick_ = {};
+    pending_compact_ = {};
 }
 
-std::vector<size_t> SIMDFixParser::find_delimiters_simd(const char* data, size_t length, char delimiter) {
-    std::vector<size_t> positions;
-    positions.reserve(length / 10); // Estimate
-    
-#ifdef __ARM_NEON
-    // ARM NEON implementation
-    uint8x16_t delimiter_vec = vdupq_n_u8(delimiter);
-    
-    size_t i = 0;
-    // Process 16 bytes at a time with NEON
-    for (; i + 15 < length; i += 16) {
-        // Load 16 bytes from input
-        uint8x16_t data_vec = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
-        
-        // Compare with delimiter
-        uint8x16_t cmp_result = vceqq_u8(data_vec, delimiter_vec);
-        
-        // Extract matches
-        uint64_t mask_low = vgetq_lane_u64(vreinterpretq_u64_u8(cmp_result), 0);
-        uint64_t mask_high = vgetq_lane_u64(vreinterpretq_u64_u8(cmp_result), 1);
-        
-        // Process low 8 bytes
-        for (int bit = 0; bit < 64; bit += 8) {
-            if ((mask_low >> bit) & 0xFF) {
-                positions.push_back(i + bit / 8);
-            }
-        }
-        
-        // Process high 8 bytes
-        for (int bit = 0; bit < 64; bit += 8) {
-            if ((mask_high >> bit) & 0xFF) {
-                positions.push_back(i + 8 + bit / 8);
+void SIMDFixParser::set_validation(bool enable) {
+    validation_enabled_ = enable;
+    reset();
+}
+
+SimdLevel SIMDFixParser::detect_simd_level() {
+    static const SimdLevel detected = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init(); // May run before libgcc's constructor
+#endif
+        for (SimdLevel level : {SimdLevel::NEON, SimdLevel::AVX512BW, SimdLevel::AVX2, SimdLevel::SSE42}) {
+            if (cpu_supports(level)) {
+                return level;
             }
         }
+        return SimdLevel::SCALAR;
+    }();
+    return detected;
+}
+
+SimdLevel SIMDFixParser::supported_simd_level(SimdLevel requested) {
+    if (requested == SimdLevel::SCALAR) {
+        return SimdLevel::SCALAR;
     }
-#else
-    // x86 AVX2 implementation
-    __m256i delimiter_vec = _mm256_set1_epi8(delimiter);
-    
-    size_t i = 0;
-    // Process 32 bytes at a time with AVX2
-    for (; i + 31 < length; i += 32) {
-        // Load 32 bytes from input
-        __m256i data_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
-        
-        // Compare with delimiter
-        __m256i cmp_result = _mm256_cmpeq_epi8(data_vec, delimiter_vec);
-        
-        // Get bitmask of matches
-        uint32_t mask = _mm256_movemask_epi8(cmp_result);
-        
-        // Extract positions of matches
-        while (mask != 0) {
-            int pos = __builtin_ctz(mask); // Count trailing zeros
-            positions.push_back(i + pos);
-            mask &= mask - 1; // Clear lowest set bit
-        }
+    SimdLevel best = detect_simd_level();
+
+    // One ISA family per build: a request for the other family (e.g. an
+    // x86 name in a config shipped to ARM) gets the best native kernel
+    if ((requested == SimdLevel::NEON) != (best == SimdLevel::NEON)) {
+        return best;
     }
-#endif
-    
-    // Handle remaining bytes
-    for (; i < length; ++i) {
-        if (data[i] == delimiter) {
-            positions.push_back(i);
-        }
+    return requested < best ? requested : best;
+}
+
+SimdLevel SIMDFixParser::parse_simd_level(std::string_view name) {
+    if (name == "SCALAR" || name == "NONE") return SimdLevel::SCALAR;
+    if (name == "SSE4.2" || name == "SSE42") return SimdLevel::SSE42;
+    if (name == "AVX2") return SimdLevel::AVX2;
+    if (name == "AVX512" || name == "AVX512BW" || name == "AVX-512BW") return SimdLevel::AVX512BW;
+    if (name == "NEON") return SimdLevel::NEON;
+    return detect_simd_level();
+}
+
+const char* SIMDFixParser::simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE42: return "SSE4.2";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512BW: return "AVX512BW";
+        case SimdLevel::NEON: return "NEON";
+        default: return "SCALAR";
     }
-    
+}
+
+std::vector<size_t> SIMDFixParser::find_delimiters_simd(const char* data, size_t length, char delimiter) {
+    std::vector<size_t> positions;
+    positions.reserve(length / 10); // Estimate
+    for_each_delimiter(data, length, delimiter, [&](size_t pos) { positions.push_back(pos); });
     return positions;
 }
+
 int SIMDFixParser::simd_atoi(std::string_view str) {
     if (str.empty()) return 0;
     
@@ -159,72 +367,274 @@ int SIMDFixParser::simd_atoi(std::string_view str) {
     return negative ? -result : result;
 }
 
+namespace {
+
+void set_symbol(common::Tick& tick, std::string_view value) {
+    // Own the symbol: value points into the scratch buffer
+    tick.copy_symbol(value);
+    tick.intern_symbol();
+}
+
+void set_symbol(common::CompactTick& tick, std::string_view value) {
+    tick.instrument_id = common::SymbolTable::global().intern(value);
+}
+
+} // namespace
+
 size_t SIMDFixParser::parse(const char* data, size_t length, std::vector<common::Tick>& ticks) {
-    if (!data || length == 0) return 0;
+    return parse_into(data, length, ticks);
+}
+
+size_t SIMDFixParser::parse(const char* data, size_t length, std::vector<common::CompactTick>& ticks) {
+    return parse_into(data, length, ticks);
+}
+
+size_t SIMDFixParser::parse(const char* data, size_t length, common::TickSpan<common::Tick>& ticks) {
+    return parse_into(data, length, ticks);
+}
+
+size_t SIMDFixParser::parse(const char* data, size_t length, common::TickSpan<common::CompactTick>& ticks) {
+    return parse_into(data, length, ticks);
+}
+
+size_t SIMDFixParser::parse(const char* data, size_t length, common::TickBatch& ticks) {
+    return parse_into(data, length, ticks);
+}
+
+void SIMDFixParser::parse_complete(const char* message, size_t length, std::vector<common::Tick>& ticks) {
+    parse_message(message, length, ticks);
+}
+
+template<typename T>
+T& SIMDFixParser::pending_tick() {
+    if constexpr (std::is_same_v<T, common::Tick>) {
+        return pending_tick_;
+    } else {
+        return pending_compact_;
+    }
+}
+
+template<typename T>
+void SIMDFixParser::apply_field(T& tick, int tag, std::string_view value) {
+    // Process critical tags for tick construction
+    switch (tag) {
+        case 55: // Symbol
+            set_symbol(tick, value);
+            break;
+        case 44: // Price
+            tick.price = simd_atof_fixed(value);
+            break;
+        case 38: // Quantity
+            tick.qty = simd_atoi(value);
+            break;
+        case 54: // Side
+            tick.side = common::fix_side_to_char(simd_atoi(value));
+            break;
+        case 52: // SendingTime
+            tick.timestamp = parse_timestamp_simd(value);
+            break;
+    }
+}
+
+template<typename Out>
+void SIMDFixParser::parse_message(const char* message, size_t length, Out& ticks) {
+    typename Out::value_type tick{};
+    size_t start = 0;
+    size_t eq_pos = NO_EQUALS;
     
-    // Copy data to processing buffer for SIMD alignment
-    size_t copy_size = std::min(length, sizeof(processing_buffer_) - buffer_pos_);
-    std::memcpy(processing_buffer_ + buffer_pos_, data, copy_size);
-    buffer_pos_ += copy_size;
+    for (size_t offset = 0; offset < length; offset += BLOCK_SIZE) {
+        BlockMasks masks;
+        size_t valid = std::min(BLOCK_SIZE, length - offset);
+        if (valid == BLOCK_SIZE) {
+            masks = classify_(message + offset);
+        } else {
+            // Last partial block: the message may end at the buffer edge
+            alignas(64) char tail[BLOCK_SIZE] = {};
+            std::memcpy(tail, message + offset, valid);
+            masks = classify_(tail);
+        }
+        
+        for (uint64_t bits = masks.equals | masks.delimiters; bits != 0; bits &= bits - 1) {
+            size_t bit = static_cast<size_t>(__builtin_ctzll(bits));
+            size_t pos = offset + bit;
+            
+            if (!((masks.delimiters >> bit) & 1)) {
+                if (eq_pos == NO_EQUALS) {
+                    eq_pos = pos;
+                }
+                continue;
+            }
+            if (eq_pos != NO_EQUALS) {
+                int tag = simd_atoi(std::string_view(message + start, eq_pos - start));
+                if (tag == 10) {
+                    ticks.push_back(tick); // Framed: the trailer is the last field
+                    return;
+                }
+                apply_field(tick, tag, std::string_view(message + eq_pos + 1, pos - eq_pos - 1));
+            }
+            start = pos + 1;
+            eq_pos = NO_EQUALS;
+        }
+    }
+}
+
+template<typename Out>
+size_t SIMDFixParser::parse_framed(const char* data, size_t length, Out& ticks) {
+    size_t consumed = 0;
+    
+    while (consumed < length) {
+        // Carry-over is the start of an incomplete message
+        size_t carry = buffer_pos_;
+        size_t copy_size = std::min(length - consumed, BUFFER_SIZE - carry);
+        std::memcpy(processing_buffer_ + carry, data + consumed, copy_size);
+        buffer_pos_ += copy_size;
+        
+        size_t pos = 0;
+        while (pos < buffer_pos_) {
+            const char* message = processing_buffer_ + pos;
+            size_t available = buffer_pos_ - pos;
+            FixFramer::Frame frame = FixFramer::frame(message, available);
+            
+            if (frame.status == FixFramer::Status::COMPLETE) {
+                parse_message(message, frame.length, ticks);
+                validation_stats_.messages_validated++;
+                pos += frame.length;
+                
+                // Fixed-capacity output: hand the rest of the input back
+                if (common::output_full(ticks)) {
+                    buffer_pos_ = 0;
+                    return consumed + (pos - carry);
+                }
+                continue;
+            }
+            
+            if (frame.status == FixFramer::Status::INCOMPLETE) {
+                if (available < BUFFER_SIZE) {
+                    break; // Wait for the rest of the message
+                }
+                validation_stats_.body_length_errors++; // Larger than we can buffer
+            } else if (frame.status == FixFramer::Status::BAD_CHECKSUM) {
+                validation_stats_.checksum_errors++;
+            } else if (frame.status == FixFramer::Status::BAD_BODY_LENGTH) {
+                validation_stats_.body_length_errors++;
+            }
+            
+            // Resynchronize at the next "8=FIX" (BAD_HEADER: junk between messages)
+            size_t skip = 1 + FixFramer::find_message_start(message + 1, available - 1);
+            validation_stats_.bytes_skipped += skip;
+            pos += skip;
+        }
+        
+        // Carry the incomplete message over to the front of the buffer
+        buffer_pos_ -= pos;
+        if (pos > 0 && buffer_pos_ > 0) {
+            std::memmove(processing_buffer_, processing_buffer_ + pos, buffer_pos_);
+        }
+        consumed += copy_size;
+    }
     
-    // Find all SOH delimiters using SIMD
-    auto delimiters = find_delimiters_simd(processing_buffer_, buffer_pos_, '\x01');
+    return consumed;
+}
+
+template<typename Out>
+size_t SIMDFixParser::parse_into(const char* data, size_t length, Out& ticks) {
+    if (!data || length == 0 || common::output_full(ticks)) return 0;
+    if (validation_enabled_) {
+        return parse_framed(data, length, ticks);
+    }
     
-    size_t processed = 0;
-    size_t start = 0;
+    auto& current_tick = pending_tick<typename Out::value_type>();
+    size_t consumed = 0;
     
-    for (size_t delimiter_pos : delimiters) {
-        if (delimiter_pos <= start) continue;
+    while (consumed < length) {
+        // Append after the carried-over field; only the new bytes are scanned
+        size_t carry = buffer_pos_;
+        size_t copy_size = std::min(length - consumed, BUFFER_SIZE - carry);
+        std::memcpy(processing_buffer_ + carry, data + consumed, copy_size);
+        buffer_pos_ += copy_size;
         
-        // Extract field using zero-copy string_view
-        std::string_view field(processing_buffer_ + start, delimiter_pos - start);
-        
-        // Find tag separator
-        size_t eq_pos = field.find('=');
-        if (eq_pos == std::string_view::npos) {
-            start = delimiter_pos + 1;
-            continue;
+        // Stage 1: structural index of the new blocks. BUFFER_SIZE is a
+        // multiple of BLOCK_SIZE, so the last block reads stale bytes inside
+        // the buffer, which are masked off along with the carried bytes
+        size_t first_block = carry / BLOCK_SIZE;
+        size_t blocks = (buffer_pos_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        for (size_t b = first_block; b < blocks; ++b) {
+            structural_[b] = classify_(processing_buffer_ + b * BLOCK_SIZE);
+        }
+        if (size_t valid = buffer_pos_ % BLOCK_SIZE) {
+            uint64_t keep = (uint64_t{1} << valid) - 1;
+            structural_[blocks - 1].equals &= keep;
+            structural_[blocks - 1].delimiters &= keep;
+        }
+        if (size_t walked = carry % BLOCK_SIZE) {
+            uint64_t keep = ~((uint64_t{1} << walked) - 1);
+            structural_[first_block].equals &= keep;
+            structural_[first_block].delimiters &= keep;
         }
         
-        // Parse tag and value using SIMD
-        int tag = simd_atoi(field.substr(0, eq_pos));
-        std::string_view value = field.substr(eq_pos + 1);
+        // Stage 2: walk '=' and delimiter bits in order; a field is
+        // tag '=' value delimiter, later '=' inside the value are data
+        size_t start = 0;
+        size_t eq_pos = carry_equals_;
         
-        // Process critical tags for tick construction
-        static common::Tick current_tick;
+        for (size_t b = first_block; b < blocks; ++b) {
+            const uint64_t delimiters = structural_[b].delimiters;
+            uint64_t bits = structural_[b].equals | delimiters;
+            
+            for (; bits != 0; bits &= bits - 1) {
+                size_t bit = static_cast<size_t>(__builtin_ctzll(bits));
+                size_t pos = b * BLOCK_SIZE + bit;
+                
+                if (!((delimiters >> bit) & 1)) {
+                    if (eq_pos == NO_EQUALS) {
+                        eq_pos = pos;
+                    }
+                    continue;
+                }
+                
+                // Fields without a tag separator (including empty ones) are skipped
+                int tag = -1;
+                if (eq_pos != NO_EQUALS) {
+                    // Parse tag and value using SIMD
+                    tag = simd_atoi(std::string_view(processing_buffer_ + start, eq_pos - start));
+                    std::string_view value(processing_buffer_ + eq_pos + 1, pos - eq_pos - 1);
+                    
+                    if (tag == 10) { // Checksum - end of message
+                        ticks.push_back(current_tick);
+                        current_tick = {}; // Reset
+                    } else {
+                        apply_field(current_tick, tag, value);
+                    }
+                    message_open_ = (tag != 10);
+                }
+                
+                start = pos + 1;
+                eq_pos = NO_EQUALS;
+                
+                // Fixed-capacity output: hand the rest of the input back
+                if (tag == 10 && common::output_full(ticks)) {
+                    buffer_pos_ = 0;
+                    carry_equals_ = NO_EQUALS;
+                    return consumed + (start - carry);
+                }
+            }
+        }
         
-        switch (tag) {
-            case 55: // Symbol
-                current_tick.symbol = std::string(value);
-                break;
-            case 44: // Price
-                current_tick.price = simd_atof_fixed(value);
-                break;
-            case 38: // Quantity
-                current_tick.qty = simd_atoi(value);
-                break;
-            case 52: // SendingTime
-                current_tick.timestamp = parse_timestamp_simd(value);
-                break;
-            case 10: // Checksum - end of message
-                ticks.push_back(current_tick);
-                current_tick = {}; // Reset
-                break;
+        // Carry the unfinished field over to the front of the buffer
+        buffer_pos_ -= start;
+        if (start > 0 && buffer_pos_ > 0) {
+            std::memmove(processing_buffer_, processing_buffer_ + start, buffer_pos_);
         }
+        carry_equals_ = (eq_pos == NO_EQUALS) ? NO_EQUALS : eq_pos - start;
+        consumed += copy_size;
         
-        start = delimiter_pos + 1;
-        processed = start;
-    }
-    
-    // Move unprocessed data to beginning of buffer
-    if (processed < buffer_pos_) {
-        std::memmove(processing_buffer_, processing_buffer_ + processed, buffer_pos_ - processed);
-        buffer_pos_ -= processed;
-    } else {
-        buffer_pos_ = 0;
+        // A "field" filling the whole buffer is garbage: drop the message
+        if (buffer_pos_ == BUFFER_SIZE) {
+            reset();
+        }
     }
     
-    return std::min(processed, copy_size);
+    return consumed;
 }
 
 double SIMDFixParser::simd_atof(std::string_view str) {
@@ -1,17 +1,62 @@
 #include "parser/streaming_fix_handler.hpp"
 #include <iostream>
+#include <type_traits>
 
 namespace feedhandler {
 namespace parser {
 
-StreamingFixHandler::StreamingFixHandler() 
-    : stats_{0, 0, 0, 0} {
+namespace {
+
+// Bytes end with a "10=ddd<d>" trailer (and optional line ending): the
+// streaming parser is between messages. Field boundaries alone do not
+// tell, a fragment can end at any of them.
+bool ends_at_trailer(const char* data, size_t length) {
+    while (length > 0 && (data[length - 1] == '\n' || data[length - 1] == '\r')) {
+        --length;
+    }
+    constexpr size_t TRAILER = 7;  // "10=ddd<d>"
+    if (length < TRAILER || FixFramer::find_trailer_end(data + length - TRAILER, TRAILER) != TRAILER) {
+        return false;
+    }
+    return length == TRAILER || data[length - TRAILER - 1] == '\x01' || data[length - TRAILER - 1] == '|';
+}
+
+} // namespace
+
+template<typename Parser>
+BasicStreamingFixHandler<Parser>::BasicStreamingFixHandler(const net::ReceiveBufferConfig& buffer_config)
+    : buffer_(buffer_config)
+    , stats_{0, 0, 0, 0, 0, 0} {
+}
+
+template<typename Parser>
+void BasicStreamingFixHandler<Parser>::set_framing(bool enable) {
+    if constexpr (!std::is_same_v<Parser, SIMDFixParser>) {
+        if (enable && !framed_parser_) {
+            framed_parser_ = std::make_unique<SIMDFixParser>();
+        }
+    }
+    framing_ = enable;
+    
+    // A parser that has seen data may hold part of a message
+    streaming_open_ = enable && stats_.total_parse_calls > 0;
 }
 
-size_t StreamingFixHandler::process_incoming_data(const char* data, size_t length, 
-                                                   std::vector<common::Tick>& ticks) {
+template<typename Parser>
+SIMDFixParser& BasicStreamingFixHandler<Parser>::framed_parser() {
+    if constexpr (std::is_same_v<Parser, SIMDFixParser>) {
+        return parser_;  // parse_complete() leaves its streaming state alone
+    } else {
+        return *framed_parser_;
+    }
+}
+
+template<typename Parser>
+size_t BasicStreamingFixHandler<Parser>::process_incoming_data(const char* data, size_t length, 
+                                                             std::vector<common::Tick>& ticks,
+                                                             uint64_t timestamp_ns) {
     // Write incoming data to receive buffer
-    size_t written = buffer_.write(data, length);
+    size_t written = buffer_.write(data, length, timestamp_ns);
     stats_.total_bytes_received += written;
     
     if (written < length) {
@@ -22,7 +67,14 @@ size_t StreamingFixHandler::process_incoming_data(const char* data, size_t lengt
     return process_buffer(ticks);
 }
 
-size_t StreamingFixHandler::process_buffer(std::vector<common::Tick>& ticks) {
+template<typename Parser>
+size_t BasicStreamingFixHandler<Parser>::process_received(size_t length, std::vector<common::Tick>& ticks) {
+    stats_.total_bytes_received += length;
+    return process_buffer(ticks);
+}
+
+template<typename Parser>
+size_t BasicStreamingFixHandler<Parser>::process_buffer(std::vector<common::Tick>& ticks) {
     size_t initial_tick_count = ticks.size();
     
     // Get readable data from buffer
@@ -33,18 +85,31 @@ size_t StreamingFixHandler::process_buffer(std::vector<common::Tick>& ticks) {
         return 0;
     }
     
-    // Parse available data with FSM parser
+    // Messages completed by the newest bytes arrived when they did
+    if constexpr (requires { parser_.set_receive_timestamp(uint64_t{0}); }) {
+        parser_.set_receive_timestamp(buffer_.receive_timestamp());
+    }
+    
+    // Parse available data
     // Parser maintains state if message is incomplete
-    size_t consumed = parser_.parse(data, available, ticks);
+    uint64_t parse_start = latency_tracking_ ? common::TscClock::read_counter() : 0;
+    size_t consumed = 0;
+    if (framing_) {
+        consumed = parse_framed(data, available, ticks);
+    } else {
+        consumed = parser_.parse(data, available, ticks);
+        drop_unsubscribed(ticks, initial_tick_count);
+    }
+    if (latency_tracking_) {
+        parse_latency_.record(common::TscClock::global().ticks_to_ns(common::TscClock::read_counter() - parse_start));
+    }
     
     // Consume parsed bytes from buffer
     if (consumed > 0) {
         buffer_.consume(consumed);
         
-        // Track buffer compaction (happens inside consume when needed)
-        if (buffer_.readable_bytes() < available - consumed) {
-            stats_.buffer_compactions++;
-        }
+        // Compaction happens inside consume when needed (never when mirrored)
+        stats_.buffer_compactions = buffer_.compaction_count();
     }
     
     stats_.total_parse_calls++;
@@ -54,11 +119,109 @@ size_t StreamingFixHandler::process_buffer(std::vector<common::Tick>& ticks) {
     return ticks_parsed;
 }
 
-void StreamingFixHandler::reset() {
+template<typename Parser>
+size_t BasicStreamingFixHandler<Parser>::parse_framed(const char* data, size_t available,
+                                                      std::vector<common::Tick>& ticks) {
+    size_t offset = 0;
+    
+    // Let parser_ finish the message it holds, then frame again
+    if (streaming_open_) {
+        size_t end = FixFramer::find_trailer_end(data, available);
+        size_t first = ticks.size();
+        if (end == 0) {
+            size_t consumed = parser_.parse(data, available, ticks);
+            drop_unsubscribed(ticks, first);
+            return consumed;
+        }
+        offset = parser_.parse(data, end, ticks);
+        drop_unsubscribed(ticks, first);
+        streaming_open_ = false;
+    }
+    
+    SIMDFixParser& framed = framed_parser();
+    uint64_t stamp = buffer_.receive_timestamp();
+    while (offset < available) {
+        // Delimiters between messages, which parser_ would skip as well
+        char c = data[offset];
+        if (c == '\x01' || c == '|' || c == '\n' || c == '\r') {
+            ++offset;
+            continue;
+        }
+        
+        const char* message = data + offset;
+        size_t remaining = available - offset;
+        FixFramer::Frame frame = FixFramer::frame(message, remaining, false);
+        if (frame.status == FixFramer::Status::COMPLETE) {
+            stats_.framed_messages++;
+            if (filter_) {
+                // Judged on its Symbol alone: the rest is never tokenized
+                std::string_view symbol = FixFramer::find_symbol(message, frame.length);
+                if (!symbol.empty() && !filter_->contains(symbol)) {
+                    offset += frame.length;
+                    stats_.filtered_messages++;
+                    continue;
+                }
+            }
+            framed.parse_complete(message, frame.length, ticks);
+            common::Tick& tick = ticks.back();
+            if (tick.symbol.empty() || tick.side == '\0') {
+                ticks.pop_back();
+            } else {
+                if (stamp == 0) {
+                    stamp = common::Tick::current_timestamp_ns();
+                }
+                tick.timestamp = stamp;
+            }
+            offset += frame.length;
+            continue;
+        }
+        
+        // The trailing fragment waits for the read that completes it,
+        // unless it is too big to wait for or its trailer is already here
+        if (frame.status == FixFramer::Status::INCOMPLETE && remaining < buffer_.capacity() / 2 &&
+            FixFramer::find_trailer_end(message, remaining) == 0) {
+            return offset;
+        }
+        
+        // Junk, or a BodyLength that does not match: parser_ copes
+        size_t first = ticks.size();
+        size_t consumed = parser_.parse(message, remaining, ticks);
+        drop_unsubscribed(ticks, first);
+        streaming_open_ = !ends_at_trailer(message, consumed);
+        return offset + consumed;
+    }
+    return offset;
+}
+
+template<typename Parser>
+void BasicStreamingFixHandler<Parser>::drop_unsubscribed(std::vector<common::Tick>& ticks, size_t first) {
+    if (!filter_ || first == ticks.size()) {
+        return;
+    }
+    size_t kept = first;
+    for (size_t i = first; i < ticks.size(); ++i) {
+        if (filter_->contains(ticks[i].symbol)) {
+            if (kept != i) {
+                ticks[kept] = ticks[i];
+            }
+            ++kept;
+        }
+    }
+    stats_.filtered_messages += ticks.size() - kept;
+    ticks.resize(kept);
+}
+
+template<typename Parser>
+void BasicStreamingFixHandler<Parser>::reset() {
     parser_.reset();
     buffer_.reset();
-    stats_ = {0, 0, 0, 0};
+    streaming_open_ = false;
+    stats_ = {0, 0, 0, 0, 0, 0};
+    parse_latency_.reset();
 }
 
+template class BasicStreamingFixHandler<FSMFixParser>;
+template class BasicStreamingFixHandler<SIMDFixParser>;
+
 } // namespace parser
 } // namespace feedhandler
\ No newline at end of file
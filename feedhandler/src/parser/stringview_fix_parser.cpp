@@ -1,4 +1,5 @@
 #include "parser/stringview_fix_parser.hpp"
+#include "parser/ascii.hpp"
 #include "parser/fast_number_parser.hpp"
 
 #include <chrono>
@@ -9,6 +10,31 @@
 namespace feedhandler {
 namespace parser {
 
+namespace {
+
+/**
+ * @brief Invoke func for each non-empty newline-separated message
+ * until func returns false
+ */
+template<typename Func>
+void for_each_line(std::string_view buffer, Func&& func) {
+    size_t start = 0;
+    size_t pos = 0;
+    
+    while (pos < buffer.size()) {
+        if (buffer[pos] == '\n' || pos == buffer.size() - 1) {
+            size_t end = (buffer[pos] == '\n') ? pos : pos + 1;
+            if (end > start && !func(buffer.substr(start, end - start))) {
+                return;  // Output full
+            }
+            start = pos + 1;
+        }
+        ++pos;
+    }
+}
+
+} // namespace
+
 common::Tick StringViewFixParser::parse_message(std::string_view message) {
     // Stack-allocated field storage (no heap allocation)
     constexpr size_t MAX_FIELDS = 32;
@@ -24,6 +50,7 @@ common::Tick StringViewFixParser::parse_message(std::string_view message) {
     // Tag 55: Symbol
     if (const Field* field = find_field(fields, field_count, 55)) {
         tick.symbol = field->value;  // Zero-copy: points directly into input buffer
+        tick.intern_symbol();
     }
     
     // Tag 44: Price
@@ -51,25 +78,89 @@ common::Tick StringViewFixParser::parse_message(std::string_view message) {
 std::vector<common::Tick> StringViewFixParser::parse_messages_from_buffer(std::string_view buffer) {
     std::vector<common::Tick> ticks;
     
-    // Split buffer by newlines (assuming each line is a message)
-    size_t start = 0;
-    size_t pos = 0;
+    for_each_line(buffer, [&ticks](std::string_view message) {
+        ticks.push_back(parse_message(message));
+        return true;
+    });
     
-    while (pos < buffer.size()) {
-        if (buffer[pos] == '\n' || pos == buffer.size() - 1) {
-            size_t end = (buffer[pos] == '\n') ? pos : pos + 1;
-            if (end > start) {
-                std::string_view message = buffer.substr(start, end - start);
-                if (!message.empty()) {
-                    ticks.push_back(parse_message(message));
-                }
-            }
-            start = pos + 1;
-        }
-        ++pos;
+    return ticks;
+}
+
+common::CompactTick StringViewFixParser::parse_message_compact(std::string_view message) {
+    // Stack-allocated field storage (no heap allocation)
+    constexpr size_t MAX_FIELDS = 32;
+    Field fields[MAX_FIELDS];
+    
+    size_t field_count = extract_fields(message, fields, MAX_FIELDS);
+    
+    common::CompactTick tick;
+    
+    // Tag 55: Symbol -> instrument ID
+    if (const Field* field = find_field(fields, field_count, 55)) {
+        tick.instrument_id = common::SymbolTable::global().intern(field->value);
     }
     
-    return ticks;
+    // Tag 44: Price
+    if (const Field* field = find_field(fields, field_count, 44)) {
+        tick.price = FastNumberParser::fast_atof_fixed(field->value);
+    }
+    
+    // Tag 38: OrderQty (Quantity)
+    if (const Field* field = find_field(fields, field_count, 38)) {
+        tick.qty = FastNumberParser::fast_atoi(field->value);
+    }
+    
+    // Tag 54: Side
+    if (const Field* field = find_field(fields, field_count, 54)) {
+        int side_value = FastNumberParser::fast_atoi(field->value);
+        tick.side = common::fix_side_to_char(side_value);
+    }
+    
+    tick.timestamp = common::Tick::current_timestamp_ns();
+    
+    return tick;
+}
+
+size_t StringViewFixParser::parse_messages_from_buffer(std::string_view buffer,
+                                        std::vector<common::CompactTick>& ticks) {
+    size_t before = ticks.size();
+    
+    for_each_line(buffer, [&ticks](std::string_view message) {
+        ticks.push_back(parse_message_compact(message));
+        return true;
+    });
+    
+    return ticks.size() - before;
+}
+
+size_t StringViewFixParser::parse_messages_from_buffer(std::string_view buffer,
+                                        common::TickSpan<common::Tick>& ticks) {
+    size_t before = ticks.size();
+    if (ticks.is_full()) {
+        return 0;
+    }
+    
+    for_each_line(buffer, [&ticks](std::string_view message) {
+        ticks.push_back(parse_message(message));
+        return !ticks.is_full();
+    });
+    
+    return ticks.size() - before;
+}
+
+size_t StringViewFixParser::parse_messages_from_buffer(std::string_view buffer,
+                                        common::TickSpan<common::CompactTick>& ticks) {
+    size_t before = ticks.size();
+    if (ticks.is_full()) {
+        return 0;
+    }
+    
+    for_each_line(buffer, [&ticks](std::string_view message) {
+        ticks.push_back(parse_message_compact(message));
+        return !ticks.is_full();
+    });
+    
+    return ticks.size() - before;
 }
 
 uint64_t StringViewFixParser::benchmark_parsing(size_t message_count) {
@@ -163,8 +254,9 @@ const StringViewFixParser::Field* StringViewFixParser::find_field(const Field* f
 }
 
 int StringViewFixParser::safe_sv_to_int(std::string_view str, int default_value) {
-    int result = parse_int(str);
-    return (result == 0 && !str.empty() && str[0] != '0') ? default_value : result;
+    int result = default_value;
+    ascii::parse_int(str, result);  // Leaves the default on failure or overflow
+    return result;
 }
 
 double StringViewFixParser::safe_sv_to_double(std::string_view str, double default_value) {
@@ -190,7 +282,7 @@ int StringViewFixParser::parse_int(std::string_view str) {
     // Parse digits
     for (; i < str.size(); ++i) {
         char c = str[i];
-        if (c >= '0' && c <= '9') {
+        if (ascii::is_digit(c)) {
             result = result * 10 + (c - '0');
         } else {
             break; // Stop at first non-digit
@@ -218,7 +310,7 @@ double StringViewFixParser::parse_double(std::string_view str) {
     // Parse integer part
     for (; i < str.size(); ++i) {
         char c = str[i];
-        if (c >= '0' && c <= '9') {
+        if (ascii::is_digit(c)) {
             result = result * 10.0 + (c - '0');
         } else if (c == '.') {
             ++i;
@@ -232,7 +324,7 @@ double StringViewFixParser::parse_double(std::string_view str) {
     double fraction = 0.1;
     for (; i < str.size(); ++i) {
         char c = str[i];
-        if (c >= '0' && c <= '9') {
+        if (ascii::is_digit(c)) {
             result += (c - '0') * fraction;
             fraction *= 0.1;
         } else {
@@ -0,0 +1,88 @@
+#include "parser/symbol_filter.hpp"
+
+#include <algorithm>
+
+namespace feedhandler {
+namespace parser {
+
+namespace {
+
+constexpr size_t MIN_TABLE_SLOTS = 16;
+constexpr size_t MIN_BLOOM_WORDS = 8;
+constexpr size_t BLOOM_BITS_PER_SYMBOL = 16;
+
+size_t round_up_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+SymbolFilter::SymbolFilter() {
+    rebuild(MIN_TABLE_SLOTS, MIN_BLOOM_WORDS);
+}
+
+SymbolFilter::SymbolFilter(const std::vector<std::string>& symbols) : SymbolFilter() {
+    for (const std::string& symbol : symbols) {
+        add(symbol);
+    }
+}
+
+bool SymbolFilter::add(std::string_view symbol) {
+    if (symbol.empty() || contains(symbol)) {
+        return false;
+    }
+    uint32_t offset = static_cast<uint32_t>(names_.size());
+    names_.append(symbol);
+    lengths_.push_back(static_cast<uint32_t>(symbol.size()));
+    ++count_;
+
+    // Table at most half full; Bloom filter at ~16 bits per symbol
+    size_t table_slots = table_.size();
+    size_t bloom_words = bloom_.size();
+    if (count_ * 2 > table_slots || count_ * BLOOM_BITS_PER_SYMBOL > bloom_words * 64) {
+        rebuild(round_up_pow2(count_ * 2), round_up_pow2(count_ * BLOOM_BITS_PER_SYMBOL / 64 + 1));
+    } else {
+        insert(hash(symbol), offset, static_cast<uint32_t>(symbol.size()));
+    }
+    return true;
+}
+
+void SymbolFilter::clear() {
+    names_.clear();
+    lengths_.clear();
+    count_ = 0;
+    rebuild(MIN_TABLE_SLOTS, MIN_BLOOM_WORDS);
+}
+
+void SymbolFilter::insert(uint64_t h, uint32_t offset, uint32_t length) {
+    bloom_[(h >> 32) & bloom_mask_] |= bloom_bits(h);
+    size_t slot = static_cast<size_t>(h) & table_mask_;
+    while (table_[slot].length != 0) {
+        slot = (slot + 1) & table_mask_;
+    }
+    table_[slot] = Entry{h, offset, length};
+}
+
+void SymbolFilter::rebuild(size_t table_slots, size_t bloom_words) {
+    table_slots = std::max(table_slots, MIN_TABLE_SLOTS);
+    bloom_words = std::max(bloom_words, MIN_BLOOM_WORDS);
+    table_.assign(table_slots, Entry{});
+    bloom_.assign(bloom_words, 0);
+    table_mask_ = table_slots - 1;
+    bloom_mask_ = bloom_words - 1;
+
+    // Names are stored back to back in the order they were added
+    size_t offset = 0;
+    for (uint32_t length : lengths_) {
+        std::string_view name(names_.data() + offset, length);
+        insert(hash(name), static_cast<uint32_t>(offset), length);
+        offset += length;
+    }
+}
+
+} // namespace parser
+} // namespace feedhandler
@@ -0,0 +1,131 @@
+#include "parser/trade_json_parser.hpp"
+#include "parser/ascii.hpp"
+#include "parser/fast_number_parser.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace feedhandler {
+namespace parser {
+
+namespace {
+
+// Closing quote of the string whose content starts at p, or nullptr
+const char* string_end(const char* p, const char* end) {
+    while (p < end) {
+        const char* quote = static_cast<const char*>(std::memchr(p, '"', static_cast<size_t>(end - p)));
+        if (!quote) {
+            return nullptr;
+        }
+        // Escaped if preceded by an odd run of backslashes
+        size_t backslashes = 0;
+        while (quote - backslashes > p && quote[-1 - static_cast<std::ptrdiff_t>(backslashes)] == '\\') {
+            ++backslashes;
+        }
+        if (backslashes % 2 == 0) {
+            return quote;
+        }
+        p = quote + 1;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bool TradeJsonParser::parse(std::string_view json, common::Tick& tick, uint64_t receive_ns) const {
+    const char* p = json.data();
+    const char* const end = p + json.size();
+
+    std::string_view event, symbol, price, quantity;
+    int maker = -1;  // m: -1 missing, 0 false, 1 true
+
+    while (p < end) {
+        p = static_cast<const char*>(std::memchr(p, '"', static_cast<size_t>(end - p)));
+        if (!p) {
+            break;
+        }
+        const char* key = p + 1;
+        const char* key_end = string_end(key, end);
+        if (!key_end) {
+            return false;
+        }
+        p = ascii::skip_space(key_end + 1, end);
+        if (p == end || *p != ':') {
+            continue;  // A string value, not a key
+        }
+        p = ascii::skip_space(p + 1, end);
+        if (p == end) {
+            return false;
+        }
+
+        // Value: a string, a nested object/array (descend into it), or a scalar
+        std::string_view value;
+        if (*p == '"') {
+            const char* value_end = string_end(p + 1, end);
+            if (!value_end) {
+                return false;
+            }
+            value = std::string_view(p + 1, static_cast<size_t>(value_end - p - 1));
+            p = value_end + 1;
+        } else if (*p == '{' || *p == '[') {
+            ++p;
+            continue;
+        } else {
+            const char* start = p;
+            while (p < end && *p != ',' && *p != '}' && *p != ']' && !ascii::is_space(*p)) {
+                ++p;
+            }
+            value = std::string_view(start, static_cast<size_t>(p - start));
+        }
+
+        // Every field of interest has a one-letter key
+        if (key_end - key != 1) {
+            continue;
+        }
+        switch (*key) {
+            case 'e': event = value; break;
+            case 's': symbol = value; break;
+            case 'p': price = value; break;
+            case 'q': quantity = value; break;
+            case 'm':
+                if (value == "true") {
+                    maker = 1;
+                } else if (value == "false") {
+                    maker = 0;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    if ((event != "trade" && event != "aggTrade") || symbol.empty() || price.empty() ||
+        quantity.empty() || maker < 0) {
+        return false;
+    }
+
+    int64_t qty = FastNumberParser::fast_atof_fixed(quantity, config_.qty_scale);
+    if (qty < 0 || qty > std::numeric_limits<int32_t>::max()) {
+        return false;  // Does not fit Tick::qty at this scale
+    }
+
+    tick.copy_symbol(symbol);
+    tick.intern_symbol();
+    tick.price = FastNumberParser::fast_atof_fixed(price);
+    tick.qty = static_cast<int32_t>(qty);
+    tick.side = maker ? 'S' : 'B';
+    tick.timestamp = receive_ns ? receive_ns : common::Tick::current_timestamp_ns();
+    return true;
+}
+
+size_t TradeJsonParser::parse(std::string_view json, std::vector<common::Tick>& ticks, uint64_t receive_ns) const {
+    ticks.emplace_back();
+    if (!parse(json, ticks.back(), receive_ns)) {
+        ticks.pop_back();
+        return 0;
+    }
+    return 1;
+}
+
+} // namespace parser
+} // namespace feedhandler
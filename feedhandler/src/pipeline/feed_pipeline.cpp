@@ -0,0 +1,517 @@
+#include "pipeline/feed_pipeline.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <ostream>
+#include <thread>
+#include <utility>
+
+namespace feedhandler {
+namespace pipeline {
+
+namespace {
+
+std::string on_off(bool enabled) {
+    return enabled ? "on" : "off";
+}
+
+std::string cpu_list(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return "none";
+    }
+    std::string list;
+    for (int cpu : cpus) {
+        list += (list.empty() ? "" : ",") + std::to_string(cpu);
+    }
+    return list;
+}
+
+bool contains(const std::vector<int>& cpus, int cpu) {
+    return std::find(cpus.begin(), cpus.end(), cpu) != cpus.end();
+}
+
+const char* policy_name(threading::OverflowPolicy policy) {
+    switch (policy) {
+        case threading::OverflowPolicy::BLOCK: return "block";
+        case threading::OverflowPolicy::DROP_NEWEST: return "drop_newest";
+        case threading::OverflowPolicy::DROP_OLDEST: return "drop_oldest";
+        case threading::OverflowPolicy::CONFLATE: return "conflate";
+    }
+    return "unknown";
+}
+
+// One synthetic quote, SOH-delimited like the wire
+void append_quote(std::string& out, const std::string& symbol, size_t cents, bool bid) {
+    out += "8=FIX.4.4\x01" "9=60\x01" "35=D\x01";
+    out += "55=" + symbol + '\x01';
+    out += "44=" + std::to_string(cents / 100) + (cents % 100 < 10 ? ".0" : ".") + std::to_string(cents % 100) + '\x01';
+    out += bid ? "38=100\x01" "54=1\x01" : "38=100\x01" "54=2\x01";
+    out += "10=000\x01";
+}
+
+} // namespace
+
+const char* setting_status_name(SettingStatus status) {
+    switch (status) {
+        case SettingStatus::APPLIED: return "applied";
+        case SettingStatus::ADJUSTED: return "adjusted";
+        case SettingStatus::IGNORED: return "ignored";
+    }
+    return "unknown";
+}
+
+void StartupReport::add(std::string name, std::string requested, std::string effective,
+                        SettingStatus status, std::string note) {
+    settings_.push_back(AppliedSetting{std::move(name), std::move(requested), std::move(effective),
+                                       status, std::move(note)});
+}
+
+const AppliedSetting* StartupReport::find(std::string_view name) const {
+    auto it = std::find_if(settings_.begin(), settings_.end(),
+                           [&](const AppliedSetting& setting) { return setting.name == name; });
+    return it == settings_.end() ? nullptr : &*it;
+}
+
+AppliedSetting* StartupReport::find(std::string_view name) {
+    return const_cast<AppliedSetting*>(std::as_const(*this).find(name));
+}
+
+size_t StartupReport::count(SettingStatus status) const {
+    return static_cast<size_t>(std::count_if(settings_.begin(), settings_.end(),
+                                             [&](const AppliedSetting& setting) { return setting.status == status; }));
+}
+
+void StartupReport::print(std::ostream& out) const {
+    size_t name_width = 0;
+    size_t value_width = 0;
+    for (const auto& setting : settings_) {
+        name_width = std::max(name_width, setting.name.size());
+        value_width = std::max(value_width, setting.requested.size() + setting.effective.size() + 4);
+    }
+    out << "[FeedPipeline] " << count(SettingStatus::APPLIED) << " applied, "
+        << count(SettingStatus::ADJUSTED) << " adjusted, " << count(SettingStatus::IGNORED) << " ignored\n";
+    for (const auto& setting : settings_) {
+        out << "  " << std::left << std::setw(9) << setting_status_name(setting.status)
+            << std::setw(static_cast<int>(name_width) + 2) << setting.name
+            << std::setw(setting.note.empty() ? 0 : static_cast<int>(value_width) + 2)
+            << (setting.requested + " -> " + setting.effective) << setting.note << "\n";
+    }
+    out << std::right;
+}
+
+FeedPipeline::FeedPipeline(const config::PerformanceConfig& config, BatchCallback callback)
+    : FeedPipeline(config, std::move(callback), Options()) {
+}
+
+FeedPipeline::FeedPipeline(const config::PerformanceConfig& config, BatchCallback callback, const Options& options)
+    : topology_(config::detect_hardware_topology()) {
+    apply_memory(config);
+    threading::ThreadedFeedHandler::Config feed = feed_config(config);
+    if (options.analytics) {
+        build_engine(options);
+    }
+
+    // The engine sees every tick before the application does; warm-up
+    // ticks neither
+    BatchCallback deliver = std::move(callback);
+    if (engine_) {
+        deliver = [engine = engine_.get(), next = std::move(deliver)](std::span<const common::Tick> ticks) {
+            for (const auto& tick : ticks) {
+                if (tick.instrument_id != common::INVALID_INSTRUMENT) {
+                    engine->process_tick(tick.to_compact());
+                }
+            }
+            if (next) {
+                next(ticks);
+            }
+        };
+    }
+    deliver = [this, next = std::move(deliver)](std::span<const common::Tick> ticks) {
+        if (warming_.load(std::memory_order_acquire)) {
+            warmup_ticks_.fetch_add(ticks.size(), std::memory_order_release);
+        } else if (next) {
+            next(ticks);
+        }
+    };
+    feed_ = std::make_unique<threading::ThreadedFeedHandler>(feed, std::move(deliver));
+
+    const size_t ring = feed_->queue_capacity();
+    const size_t requested_ring = config.queue().ring_buffer_size;
+    report_.add("queue.ring_buffer_size", std::to_string(requested_ring), std::to_string(ring),
+                ring == requested_ring ? SettingStatus::APPLIED : SettingStatus::ADJUSTED,
+                ring == requested_ring ? "" : "rounded up to a power of 2");
+    build_metrics(config.monitoring());
+}
+
+std::unique_ptr<FeedPipeline> FeedPipeline::from_file(const std::string& path, BatchCallback callback) {
+    return from_file(path, std::move(callback), Options());
+}
+
+std::unique_ptr<FeedPipeline> FeedPipeline::from_file(const std::string& path, BatchCallback callback,
+                                                      const Options& options) {
+    config::PerformanceConfig& config = config::PerformanceConfig::instance();
+    if (!config.load_from_file(path)) {
+        std::cerr << "[FeedPipeline] Not starting: " << path << " could not be loaded" << std::endl;
+        return nullptr;
+    }
+    return std::make_unique<FeedPipeline>(config, std::move(callback), options);
+}
+
+FeedPipeline::~FeedPipeline() {
+    stop();
+}
+
+void FeedPipeline::apply_memory(const config::PerformanceConfig& config) {
+    const auto& memory = config.memory();
+    const int numa_node = config.cpu().numa_node;
+
+    if (memory.zero_latency_pool_size > 0) {
+        try {
+            allocator_ = std::make_unique<common::ZeroLatencyAllocator>(memory, numa_node);
+        } catch (const std::bad_alloc&) {
+            std::cerr << "[FeedPipeline] Cannot map a " << memory.zero_latency_pool_size
+                      << " byte region, tick pool falls back to the heap" << std::endl;
+        }
+    }
+    if (allocator_) {
+        report_.add("memory.zero_latency_pool_size", std::to_string(memory.zero_latency_pool_size),
+                    std::to_string(allocator_->get_stats().total_size), SettingStatus::APPLIED);
+        report_.add("memory.enable_huge_pages", on_off(memory.enable_huge_pages), on_off(allocator_->huge_pages()),
+                    memory.enable_huge_pages == allocator_->huge_pages() ? SettingStatus::APPLIED : SettingStatus::IGNORED,
+                    memory.enable_huge_pages && !allocator_->huge_pages() ? "kernel gave regular pages" : "");
+        report_.add("memory.prefault_memory", on_off(memory.prefault_memory), on_off(allocator_->prefaulted()),
+                    SettingStatus::APPLIED);
+    } else {
+        const bool failed = memory.zero_latency_pool_size > 0;
+        report_.add("memory.zero_latency_pool_size", std::to_string(memory.zero_latency_pool_size), "0",
+                    failed ? SettingStatus::IGNORED : SettingStatus::APPLIED, failed ? "mmap failed" : "no region");
+        report_.add("memory.enable_huge_pages", on_off(memory.enable_huge_pages), "off",
+                    memory.enable_huge_pages ? SettingStatus::IGNORED : SettingStatus::APPLIED,
+                    memory.enable_huge_pages ? "no region to back" : "");
+        report_.add("memory.prefault_memory", on_off(memory.prefault_memory), "off",
+                    memory.prefault_memory ? SettingStatus::IGNORED : SettingStatus::APPLIED,
+                    memory.prefault_memory ? "no region to touch" : "");
+    }
+
+    // NUMA binding belongs to the region; cpu.numa_node picks the node
+    const int bound = allocator_ ? allocator_->numa_node() : -1;
+    if (!memory.enable_numa_allocation) {
+        report_.add("memory.enable_numa_allocation", "off", "off", SettingStatus::APPLIED);
+    } else if (bound >= 0) {
+        report_.add("memory.enable_numa_allocation", "on", "node " + std::to_string(bound), SettingStatus::APPLIED);
+    } else {
+        report_.add("memory.enable_numa_allocation", "on", "off", SettingStatus::IGNORED,
+                    !allocator_ ? "no region to bind" :
+                    numa_node < 0 ? "cpu.numa_node is not set" : "kernel refused mbind");
+    }
+    report_.add("cpu.numa_node", std::to_string(numa_node), std::to_string(bound),
+                numa_node == bound ? SettingStatus::APPLIED : SettingStatus::IGNORED,
+                numa_node == bound ? "" : "applies to the region with memory.enable_numa_allocation");
+
+    const size_t capacity = memory.tick_pool_size;
+    if (allocator_) {
+        arena_ = allocator_->create_arena(capacity * sizeof(common::Tick) + alignof(common::Tick));
+        tick_pool_ = std::make_unique<common::TickPool>(capacity, arena_);
+    } else {
+        tick_pool_ = std::make_unique<common::TickPool>(capacity);
+    }
+    const bool in_region = tick_pool_->arena_backed() || capacity == 0;
+    report_.add("memory.tick_pool_size", std::to_string(capacity), std::to_string(tick_pool_->capacity()),
+                in_region ? SettingStatus::APPLIED : SettingStatus::ADJUSTED,
+                in_region ? "" : "on the heap, outside the region");
+}
+
+threading::ThreadedFeedHandler::Config FeedPipeline::feed_config(const config::PerformanceConfig& config) {
+    const auto& queue = config.queue();
+    const auto& parser = config.parser();
+    const auto& monitoring = config.monitoring();
+    threading::ThreadedFeedHandler::Config feed = threading::ThreadedFeedHandler::Config::from_queue(queue);
+
+    // Queue
+    const std::string requested_policy = !queue.overflow_policy.empty() ? queue.overflow_policy :
+                                         queue.enable_backpressure ? "block" : "drop_newest";
+    const std::string policy = policy_name(feed.overflow_policy);
+    report_.add("queue.overflow_policy", requested_policy, policy,
+                policy == requested_policy ? SettingStatus::APPLIED : SettingStatus::ADJUSTED,
+                policy == requested_policy ? "" : "unknown policy");
+    report_.add("queue.enable_backpressure", on_off(queue.enable_backpressure),
+                on_off(feed.overflow_policy == threading::OverflowPolicy::BLOCK),
+                queue.overflow_policy.empty() ? SettingStatus::APPLIED : SettingStatus::IGNORED,
+                queue.overflow_policy.empty() ? "" : "queue.overflow_policy takes precedence");
+    report_.add("queue.batch_size", queue.enable_batching ? std::to_string(queue.batch_size) : "off",
+                std::to_string(feed.delivery_batch), SettingStatus::APPLIED, "queued buffers per callback");
+
+    // Parser: SIMDFixParser has no garbage recovery, so recovery keeps FSMFixParser
+    feed.enable_garbage_recovery = parser.enable_garbage_recovery;
+    report_.add("parser.enable_garbage_recovery", on_off(parser.enable_garbage_recovery),
+                on_off(parser.enable_garbage_recovery), SettingStatus::APPLIED);
+    const parser::SimdLevel requested =
+        parser.enable_simd ? parser::SIMDFixParser::parse_simd_level(parser.simd_instruction_set)
+                           : parser::SimdLevel::SCALAR;
+    const std::string requested_simd = parser.enable_simd ? parser.simd_instruction_set : "off";
+    if (!parser.enable_simd) {
+        report_.add("parser.simd_instruction_set", requested_simd, "FSMFixParser", SettingStatus::APPLIED);
+    } else if (parser.enable_garbage_recovery) {
+        report_.add("parser.simd_instruction_set", requested_simd, "FSMFixParser", SettingStatus::IGNORED,
+                    "garbage recovery needs FSMFixParser");
+    } else {
+        feed.simd_parsing = true;
+        feed.simd_level = parser::SIMDFixParser::supported_simd_level(requested);
+        const bool capped = feed.simd_level != requested;
+        report_.add("parser.simd_instruction_set", requested_simd,
+                    parser::SIMDFixParser::simd_level_name(feed.simd_level),
+                    capped ? SettingStatus::ADJUSTED : SettingStatus::APPLIED,
+                    capped ? "capped at what the CPU supports" : "");
+    }
+    report_.add("parser.batch_size", std::to_string(parser.batch_size), "-", SettingStatus::IGNORED,
+                "parse calls follow receive buffers; see queue.batch_size");
+    report_.add("parser.enable_branch_prediction", on_off(parser.enable_branch_prediction), "-",
+                SettingStatus::IGNORED, "branch hints are compiled in");
+
+    // CPU
+    parser_cpu_ = pick_cpu("cpu.parser_thread_affinity", config.cpu().parser_thread_affinity);
+    network_cpu_ = pick_cpu("cpu.network_thread_affinity", config.cpu().network_thread_affinity);
+    feed.parser_cpu = parser_cpu_;
+    feed.network_cpu = network_cpu_;
+    check_cpu_placement(config.cpu());
+
+    // Monitoring
+    feed.latency_tracking = monitoring.enable_latency_tracking;
+    report_.add("monitoring.enable_latency_tracking", on_off(monitoring.enable_latency_tracking),
+                on_off(monitoring.enable_latency_tracking), SettingStatus::APPLIED);
+    if (monitoring.enable_tracing) {
+        // Before the threads start, so their rings get the configured size
+        common::Tracer::global().set_ring_events(monitoring.trace_buffer_events);
+        common::Tracer::global().enable();
+        trace_file_ = monitoring.trace_output_file;
+        report_.add("monitoring.enable_tracing", "on", "on", SettingStatus::APPLIED,
+                    std::to_string(monitoring.trace_buffer_events) + " events per thread" +
+                        (trace_file_.empty() ? "" : ", saved to " + trace_file_ + " on stop"));
+    } else {
+        report_.add("monitoring.enable_tracing", "off", "off", SettingStatus::APPLIED);
+    }
+    return feed;
+}
+
+int FeedPipeline::pick_cpu(const std::string& setting, const std::vector<int>& affinity) {
+    if (affinity.empty()) {
+        report_.add(setting, "none", "unpinned", SettingStatus::APPLIED);
+        return -1;
+    }
+    // One thread takes one core; the rest of the list is for ShardedFeedHandler shards
+    const int cpu = affinity.front();
+    const std::string note = affinity.size() > 1 ? "only the first CPU pins this thread" : "";
+    if (!topology_.usable_cpus.empty() && !contains(topology_.usable_cpus, cpu)) {
+        report_.add(setting, cpu_list(affinity), "unpinned", SettingStatus::IGNORED,
+                    "CPU " + std::to_string(cpu) + " is outside this process's CPU mask");
+        return -1;
+    }
+    // Final once start() knows whether the OS accepted it
+    report_.add(setting, cpu_list(affinity), std::to_string(cpu),
+                affinity.size() > 1 ? SettingStatus::ADJUSTED : SettingStatus::APPLIED, note);
+    return cpu;
+}
+
+void FeedPipeline::check_cpu_placement(const config::PerformanceConfig::CPUConfig& cpu) {
+    std::vector<int> pinned;
+    for (int id : {parser_cpu_, network_cpu_}) {
+        if (id >= 0 && !contains(pinned, id)) {
+            pinned.push_back(id);
+        }
+    }
+
+    // Isolation is a boot parameter (isolcpus=): only checkable, not settable
+    if (!cpu.enable_cpu_isolation) {
+        report_.add("cpu.enable_cpu_isolation", "off", "off", SettingStatus::APPLIED);
+    } else if (pinned.empty()) {
+        report_.add("cpu.enable_cpu_isolation", "on", "off", SettingStatus::IGNORED, "no thread is pinned");
+    } else {
+        std::vector<int> shared;
+        for (int id : pinned) {
+            if (!contains(topology_.isolated_cpus, id)) {
+                shared.push_back(id);
+            }
+        }
+        report_.add("cpu.enable_cpu_isolation", "on", shared.empty() ? "on" : "off",
+                    shared.empty() ? SettingStatus::APPLIED : SettingStatus::IGNORED,
+                    shared.empty() ? "" : "CPU " + cpu_list(shared) + " not in isolcpus (" +
+                                          cpu_list(topology_.isolated_cpus) + ")");
+    }
+
+    // Without hyperthreading the two feed threads must not be siblings
+    bool siblings = false;
+    if (pinned.size() == 2) {
+        int cores[2] = {-1, -2};
+        for (const auto& entry : topology_.cpus) {
+            for (size_t i = 0; i < 2; ++i) {
+                if (entry.id == pinned[i]) {
+                    cores[i] = entry.core;
+                }
+            }
+        }
+        siblings = cores[0] == cores[1];
+    }
+    const bool conflict = !cpu.enable_hyperthreading && siblings;
+    report_.add("cpu.enable_hyperthreading", on_off(cpu.enable_hyperthreading),
+                on_off(cpu.enable_hyperthreading || siblings),
+                conflict ? SettingStatus::IGNORED : SettingStatus::APPLIED,
+                conflict ? "parser and network CPUs are hyperthread siblings" : "");
+}
+
+void FeedPipeline::build_engine(Options options) {
+    // Workers get the CPUs the feed threads leave free
+    size_t cpus = topology_.usable_cpus.empty() ? topology_.logical_cpus() : topology_.usable_cpus.size();
+    for (int id : {parser_cpu_, network_cpu_}) {
+        if (id >= 0 && cpus > 1) {
+            --cpus;
+        }
+    }
+    const size_t requested = options.engine.worker_threads;
+    options.engine.worker_threads = std::clamp<size_t>(requested, 1, std::max<size_t>(cpus, 1));
+    report_.add("analytics.worker_threads", std::to_string(requested), std::to_string(options.engine.worker_threads),
+                options.engine.worker_threads == requested ? SettingStatus::APPLIED : SettingStatus::ADJUSTED,
+                options.engine.worker_threads == requested ? "" : "capped to the CPUs left by the feed threads");
+    engine_ = std::make_unique<analytics::RealtimeEngine>(options.engine);
+}
+
+void FeedPipeline::build_metrics(const config::PerformanceConfig::MonitoringConfig& monitoring) {
+    const std::string file = monitoring.metrics_output_file.empty() ? "none" : monitoring.metrics_output_file;
+    if (monitoring.metrics_output_file.empty()) {
+        report_.add("monitoring.metrics_output_file", file, "none", SettingStatus::APPLIED);
+    } else {
+        metrics_ = std::make_unique<monitoring::MetricsExporter>(
+            monitoring::MetricsExporterConfig::from_monitoring(monitoring));
+        metrics_->add_feed_handler("feed", feed_->get_statistics());
+        report_.add("monitoring.metrics_output_file", file, file, SettingStatus::APPLIED,
+                    "every " + std::to_string(monitoring.metrics_update_interval_ms) + " ms");
+    }
+
+    if (!monitoring.enable_memory_profiling) {
+        report_.add("monitoring.enable_memory_profiling", "off", "off", SettingStatus::APPLIED);
+    } else if (metrics_ && allocator_) {
+        common::ZeroLatencyAllocator* region = allocator_.get();
+        metrics_->add_gauge("memory_region_allocated_bytes", [region] { return region->get_stats().allocated_size; });
+        metrics_->add_gauge("memory_region_remaining_bytes", [region] { return region->get_stats().remaining_size; });
+        report_.add("monitoring.enable_memory_profiling", "on", "on", SettingStatus::APPLIED, "region gauges");
+    } else {
+        report_.add("monitoring.enable_memory_profiling", "on", "off", SettingStatus::IGNORED,
+                    metrics_ ? "no region to profile" : "no metrics output");
+    }
+    report_.add("monitoring.enable_hardware_counters", on_off(monitoring.enable_hardware_counters), "-",
+                monitoring.enable_hardware_counters ? SettingStatus::IGNORED : SettingStatus::APPLIED,
+                monitoring.enable_hardware_counters ? "sample with HardwareProfiler around a stage" : "");
+}
+
+void FeedPipeline::start() {
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    if (engine_) {
+        engine_->start();
+    }
+    if (metrics_ && !metrics_->start()) {
+        std::cerr << "[FeedPipeline] Metrics exporter did not start" << std::endl;
+    }
+    feed_->start();
+    report_pinning("cpu.parser_thread_affinity", parser_cpu_, feed_->parser_pinned());
+    report_pinning("cpu.network_thread_affinity", network_cpu_, feed_->network_pinned());
+}
+
+void FeedPipeline::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    feed_->stop();
+    if (engine_) {
+        engine_->stop();
+    }
+    if (metrics_) {
+        metrics_->stop();
+    }
+    if (!trace_file_.empty()) {
+        common::Tracer::global().capture().save(trace_file_);
+    }
+}
+
+FeedPipeline::WarmupResult FeedPipeline::warm_up() {
+    return warm_up(WarmupOptions());
+}
+
+FeedPipeline::WarmupResult FeedPipeline::warm_up(const WarmupOptions& options) {
+    WarmupResult result;
+    const auto started = std::chrono::steady_clock::now();
+    if (allocator_ && !allocator_->prefaulted()) {
+        allocator_->prefault_memory();
+    }
+
+    // Built up front so the replay itself does not allocate per message
+    const std::vector<std::string> fallback = {"WARMUP"};
+    const std::vector<std::string>& symbols = options.symbols.empty() ? fallback : options.symbols;
+    const size_t per_buffer = std::max<size_t>(options.messages_per_buffer, 1);
+    std::vector<std::string> buffers;
+    buffers.reserve(options.messages / per_buffer + 1);
+    for (size_t i = 0; i < options.messages; ++i) {
+        if (i % per_buffer == 0) {
+            buffers.emplace_back();
+        }
+        append_quote(buffers.back(), symbols[i % symbols.size()], 10000 + (i / 2) % 500, i % 2 == 0);
+    }
+
+    start();
+    warmup_ticks_.store(0);
+    warming_.store(true, std::memory_order_release);
+
+    // A quarter of the ring in flight keeps DROP_*/CONFLATE out of play
+    const auto& stats = feed_->get_statistics();
+    auto through = [&] { return warmup_ticks_.load(std::memory_order_acquire) + stats.ticks_conflated.load(); };
+    const size_t in_flight = std::max<size_t>(feed_->queue_capacity() / 4, 1) * per_buffer;
+    const auto deadline = started + options.timeout;
+    size_t injected = 0;
+    bool timed_out = false;
+    for (const auto& buffer : buffers) {
+        while (injected - through() >= in_flight && !timed_out) {
+            std::this_thread::yield();
+            timed_out = std::chrono::steady_clock::now() >= deadline;
+        }
+        if (timed_out) {
+            break;
+        }
+        feed_->inject_data(buffer.data(), buffer.size());
+        injected += std::min(per_buffer, options.messages - injected);
+    }
+    while (through() < injected && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+
+    result.messages = injected;
+    result.ticks = warmup_ticks_.load(std::memory_order_acquire);
+    result.complete = through() >= options.messages;
+    warming_.store(false, std::memory_order_release);
+    if (!result.complete) {
+        std::cerr << "[FeedPipeline] Warm-up timed out: " << through() << " of " << options.messages
+                  << " messages came through" << std::endl;
+    }
+
+    feed_->reset_statistics();
+    tick_pool_->reset();
+    result.elapsed_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - started).count());
+    return result;
+}
+
+void FeedPipeline::report_pinning(const std::string& setting, int cpu, bool pinned) {
+    AppliedSetting* row = report_.find(setting);
+    if (cpu < 0 || pinned || !row) {
+        return;
+    }
+    row->effective = "unpinned";
+    row->status = SettingStatus::IGNORED;
+    row->note = "OS refused to pin to CPU " + std::to_string(cpu);
+}
+
+} // namespace pipeline
+} // namespace feedhandler
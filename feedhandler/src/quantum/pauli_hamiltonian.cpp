@@ -0,0 +1,145 @@
+#include "quantum/pauli_hamiltonian.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iostream>
+
+namespace feedhandler {
+namespace quantum {
+
+namespace {
+
+// i^(number of Y) of a term
+std::complex<double> y_phase(const PauliHamiltonian::Term& term) {
+    switch (std::popcount(term.x_mask & term.z_mask) % 4) {
+        case 0: return {1.0, 0.0};
+        case 1: return {0.0, 1.0};
+        case 2: return {-1.0, 0.0};
+        default: return {0.0, -1.0};
+    }
+}
+
+} // namespace
+
+bool PauliHamiltonian::add_term(double coefficient, std::string_view paulis) {
+    if (paulis.size() > MAX_QUBITS) {
+        std::cerr << "Pauli string longer than " << MAX_QUBITS << " qubits" << std::endl;
+        return false;
+    }
+    uint64_t x_mask = 0;
+    uint64_t z_mask = 0;
+    for (size_t q = 0; q < paulis.size(); ++q) {
+        uint64_t bit = uint64_t{1} << q;
+        switch (paulis[q]) {
+            case 'I': break;
+            case 'X': x_mask |= bit; break;
+            case 'Y': x_mask |= bit; z_mask |= bit; break;
+            case 'Z': z_mask |= bit; break;
+            default:
+                std::cerr << "Invalid Pauli operator '" << paulis[q] << "' in " << paulis << std::endl;
+                return false;
+        }
+    }
+    add_term(coefficient, x_mask, z_mask);
+    return true;
+}
+
+void PauliHamiltonian::add_term(double coefficient, uint64_t x_mask, uint64_t z_mask) {
+    auto [it, inserted] = group_of_x_.emplace(x_mask, groups_.size());
+    if (inserted) {
+        groups_.push_back(Group{x_mask, {}});
+    }
+    groups_[it->second].terms.push_back(Term{coefficient, x_mask, z_mask});
+    term_count_++;
+
+    uint64_t support = x_mask | z_mask;
+    if (support != 0) {
+        qubits_ = std::max<size_t>(qubits_, 64 - static_cast<size_t>(std::countl_zero(support)));
+    }
+}
+
+PauliHamiltonian PauliHamiltonian::from_dense(const std::vector<std::vector<std::complex<double>>>& matrix,
+                                              double tolerance) {
+    PauliHamiltonian hamiltonian;
+    size_t size = matrix.size();
+    bool square = size > 0 && std::has_single_bit(size);
+    for (const auto& row : matrix) {
+        square = square && row.size() == size;
+    }
+    if (!square) {
+        std::cerr << "Dense Hamiltonian must be square with a power-of-two size" << std::endl;
+        return hamiltonian;
+    }
+
+    // P[w ^ x][w] is the only nonzero of column w, so Tr(P H) = sum_w P[w ^ x][w] H[w][w ^ x]
+    for (uint64_t x = 0; x < size; ++x) {
+        for (uint64_t z = 0; z < size; ++z) {
+            std::complex<double> trace = 0.0;
+            for (uint64_t w = 0; w < size; ++w) {
+                double sign = std::popcount(w & z) % 2 ? -1.0 : 1.0;
+                trace += sign * matrix[w][w ^ x];
+            }
+            trace *= y_phase(Term{0.0, x, z});
+            double coefficient = trace.real() / static_cast<double>(size);
+            if (std::abs(coefficient) > tolerance) {
+                hamiltonian.add_term(coefficient, x, z);
+            }
+        }
+    }
+    return hamiltonian;
+}
+
+double PauliHamiltonian::expectation(const StateVector& state) const {
+    if (state.qubits() < qubits_) {
+        std::cerr << "State of " << state.qubits() << " qubits for a " << qubits_ << "-qubit Hamiltonian"
+                  << std::endl;
+        return 0.0;
+    }
+    const double* re = state.real();
+    const double* im = state.imag();
+    double sum = 0.0;
+
+    for (const auto& group : groups_) {
+        if (group.x_mask == 0) {
+            // Diagonal: sum_z |psi_z|^2 sum_t c_t (-1)^popcount(z & z_t)
+            for (size_t z = 0; z < state.size(); ++z) {
+                double weight = 0.0;
+                for (const auto& term : group.terms) {
+                    weight += std::popcount(z & term.z_mask) % 2 ? -term.coefficient : term.coefficient;
+                }
+                sum += weight * state.probability(z);
+            }
+            continue;
+        }
+
+        // Off-diagonal: Re(i^k c (-1)^popcount(z & z_t) conj(psi_{z ^ x}) psi_z) summed over terms
+        for (size_t z = 0; z < state.size(); ++z) {
+            size_t partner = z ^ group.x_mask;
+            double overlap_re = re[partner] * re[z] + im[partner] * im[z];
+            double overlap_im = re[partner] * im[z] - im[partner] * re[z];
+            double weight_re = 0.0;
+            double weight_im = 0.0;
+            for (const auto& term : group.terms) {
+                std::complex<double> phase = y_phase(term);
+                double c = std::popcount(z & term.z_mask) % 2 ? -term.coefficient : term.coefficient;
+                weight_re += c * phase.real();
+                weight_im += c * phase.imag();
+            }
+            sum += weight_re * overlap_re - weight_im * overlap_im;
+        }
+    }
+    return sum;
+}
+
+std::vector<PauliHamiltonian::Term> PauliHamiltonian::terms() const {
+    std::vector<Term> all;
+    all.reserve(term_count_);
+    for (const auto& group : groups_) {
+        all.insert(all.end(), group.terms.begin(), group.terms.end());
+    }
+    return all;
+}
+
+} // namespace quantum
+} // namespace feedhandler
@@ -0,0 +1,461 @@
+#include "quantum/quantum_optimizer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+namespace feedhandler {
+namespace quantum {
+
+namespace {
+
+// Nelder-Mead coefficients (reflection, expansion, contraction, shrink)
+constexpr double NM_ALPHA = 1.0;
+constexpr double NM_GAMMA = 2.0;
+constexpr double NM_RHO = 0.5;
+constexpr double NM_SIGMA = 0.5;
+constexpr double NM_INITIAL_STEP = 0.1;  // Radians: QAOA angles
+constexpr double NM_TOLERANCE = 1e-8;    // Spread of simplex values that counts as converged
+constexpr size_t NM_ITERATIONS_PER_DIMENSION = 200;
+
+struct StartResult {
+    std::vector<double> parameters;
+    double value = 0.0;
+    size_t evaluations = 0;
+    size_t cache_hits = 0;
+};
+
+// Expectation by exact parameter vector. Nelder-Mead re-evaluates the
+// point it returns, and restarted or converging simplices revisit
+// vertices; cleared wholesale when full rather than tracking recency.
+class ParameterCache {
+public:
+    explicit ParameterCache(size_t capacity)
+        : capacity_(capacity) {}
+
+    bool find(const std::vector<double>& parameters, double& value) {
+        auto it = values_.find(parameters);
+        if (it == values_.end()) {
+            return false;
+        }
+        value = it->second;
+        hits_++;
+        return true;
+    }
+
+    void insert(const std::vector<double>& parameters, double value) {
+        if (capacity_ == 0) {
+            return;
+        }
+        if (values_.size() >= capacity_) {
+            values_.clear();
+        }
+        values_.emplace(parameters, value);
+    }
+
+    size_t hits() const { return hits_; }
+
+private:
+    struct Hash {
+        size_t operator()(const std::vector<double>& parameters) const {
+            uint64_t hash = 1469598103934665603ull;  // FNV-1a over the bit patterns
+            for (double p : parameters) {
+                hash = (hash ^ std::bit_cast<uint64_t>(p)) * 1099511628211ull;
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    size_t capacity_;
+    size_t hits_ = 0;
+    std::unordered_map<std::vector<double>, double, Hash> values_;
+};
+
+} // namespace
+
+QuantumOptimizer::QuantumOptimizer()
+    : QuantumOptimizer(Config()) {}
+
+QuantumOptimizer::QuantumOptimizer(const Config& config)
+    : config_(config)
+    , simulator_(config.simulator) {
+    if (config_.threads == 0) {
+        config_.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    config_.starts = std::max<size_t>(config_.starts, 1);
+}
+
+QuantumOptimizer::OptimizationResult QuantumOptimizer::qaoa_optimize(const CostFunction& cost_function,
+                                                                     size_t num_variables,
+                                                                     size_t num_layers) {
+    auto start = std::chrono::steady_clock::now();
+    OptimizationResult result{};
+
+    if (num_variables == 0 || num_variables > MAX_SIMULATED_QUBITS || num_layers == 0) {
+        std::cerr << "QAOA needs 1-" << MAX_SIMULATED_QUBITS << " variables and at least one layer, got "
+                  << num_variables << " variables, " << num_layers << " layers" << std::endl;
+        return result;
+    }
+
+    // The cost is diagonal in the computational basis: evaluate it once
+    // per basis state instead of once per state per circuit evaluation
+    size_t size = size_t{1} << num_variables;
+    std::vector<double> cost_diagonal(size);
+    std::vector<double> bits(num_variables);
+    for (size_t z = 0; z < size; ++z) {
+        for (size_t q = 0; q < num_variables; ++q) {
+            bits[q] = static_cast<double>((z >> q) & 1);
+        }
+        cost_diagonal[z] = cost_function(bits);
+    }
+    total_function_evaluations_ += size;
+
+    // Start 0 is a linear ramp from mixer to cost, as in a discretized
+    // annealing schedule; the others are drawn up front so the outcome
+    // does not depend on which thread runs which start
+    std::vector<std::vector<double>> initial(config_.starts, std::vector<double>(2 * num_layers));
+    std::mt19937_64 gen(config_.seed);
+    std::uniform_real_distribution<double> gamma(0.0, M_PI);
+    std::uniform_real_distribution<double> beta(0.0, M_PI / 2.0);
+    for (size_t s = 0; s < config_.starts; ++s) {
+        for (size_t l = 0; l < num_layers; ++l) {
+            double t = static_cast<double>(l + 1) / static_cast<double>(num_layers + 1);
+            initial[s][2 * l] = s == 0 ? t : gamma(gen);
+            initial[s][2 * l + 1] = s == 0 ? 1.0 - t : beta(gen);
+        }
+    }
+
+    // Starts side by side already fill the cores; their gates run serially
+    size_t threads = std::min(config_.threads, config_.starts);
+    StateVectorSimulator::Config serial_config = config_.simulator;
+    serial_config.threads = 1;
+    StateVectorSimulator serial_simulator(serial_config);
+    const StateVectorSimulator& simulator = threads > 1 ? serial_simulator : simulator_;
+
+    std::vector<StartResult> starts(config_.starts);
+    std::atomic<size_t> next_start{0};
+    auto worker = [&] {
+        // Allocated once per thread, reused by every evaluation of every start it runs
+        StateVector state(num_variables);
+        GateSequence circuit;
+        ParameterCache cache(config_.cache_capacity);
+        for (size_t s = next_start.fetch_add(1); s < config_.starts; s = next_start.fetch_add(1)) {
+            StartResult& run = starts[s];
+            size_t hits_before = cache.hits();
+            auto expectation = [&](const std::vector<double>& parameters) {
+                double value;
+                if (cache.find(parameters, value)) {
+                    return value;
+                }
+                simulate_qaoa_circuit(parameters, cost_diagonal, num_layers, simulator, circuit, state);
+                run.evaluations++;
+                value = 0.0;
+                for (size_t z = 0; z < size; ++z) {
+                    value += state.probability(z) * cost_diagonal[z];
+                }
+                cache.insert(parameters, value);
+                return value;
+            };
+            run.parameters = nelder_mead_optimize(expectation, initial[s]);
+            run.value = expectation(run.parameters);
+            run.cache_hits = cache.hits() - hits_before;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    // Lowest expectation wins; ties go to the earlier start
+    size_t best_start = 0;
+    for (size_t s = 0; s < starts.size(); ++s) {
+        result.iterations += starts[s].evaluations;
+        result.cache_hits += starts[s].cache_hits;
+        if (starts[s].value < starts[best_start].value) {
+            best_start = s;
+        }
+    }
+
+    StateVector state(num_variables);
+    GateSequence circuit;
+    simulate_qaoa_circuit(starts[best_start].parameters, cost_diagonal, num_layers, simulator_, circuit, state);
+
+    size_t best = 0;
+    for (size_t z = 1; z < size; ++z) {
+        if (state.probability(z) > state.probability(best)) {
+            best = z;
+        }
+    }
+    result.optimal_weights.resize(num_variables);
+    for (size_t q = 0; q < num_variables; ++q) {
+        result.optimal_weights[q] = static_cast<double>((best >> q) & 1);
+    }
+    result.optimal_value = cost_diagonal[best];
+    result.convergence_time_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.quantum_advantage_ratio = 1.0;  // Classical simulation
+    total_optimization_time_ += result.convergence_time_ms;
+    return result;
+}
+
+QuantumOptimizer::OptimizationResult QuantumOptimizer::vqe_minimize_risk(
+    const std::vector<std::vector<Complex>>& hamiltonian,
+    const QuantumState& initial_state) {
+    size_t size = initial_state.size();
+    bool valid = std::has_single_bit(size) && hamiltonian.size() == size;
+    for (const auto& row : hamiltonian) {
+        valid = valid && row.size() == size;
+    }
+    if (!valid || size > (size_t{1} << MAX_SIMULATED_QUBITS)) {
+        std::cerr << "VQE needs a power-of-two initial state of at most " << MAX_SIMULATED_QUBITS
+                  << " qubits and a square Hamiltonian of the same size" << std::endl;
+        return OptimizationResult{};
+    }
+    return run_vqe(StateVector::from_complex(initial_state), [&](const StateVector& state) {
+        // sum_r conj(psi_r) sum_c H[r][c] psi_c
+        double energy = 0.0;
+        for (size_t r = 0; r < size; ++r) {
+            Complex row = 0.0;
+            for (size_t c = 0; c < size; ++c) {
+                row += hamiltonian[r][c] * state.amplitude(c);
+            }
+            energy += (std::conj(state.amplitude(r)) * row).real();
+        }
+        return energy;
+    });
+}
+
+QuantumOptimizer::OptimizationResult QuantumOptimizer::vqe_minimize_risk(
+    const PauliHamiltonian& hamiltonian,
+    const QuantumState& initial_state) {
+    size_t qubits = std::max<size_t>(hamiltonian.qubits(), 1);
+    if (initial_state.empty()) {
+        if (qubits > MAX_SIMULATED_QUBITS) {
+            std::cerr << "VQE register of " << qubits << " qubits exceeds " << MAX_SIMULATED_QUBITS << std::endl;
+            return OptimizationResult{};
+        }
+        return run_vqe(StateVector(qubits), [&](const StateVector& state) {
+            return measure_expectation(state, hamiltonian);
+        });
+    }
+
+    size_t size = initial_state.size();
+    size_t state_qubits = static_cast<size_t>(std::countr_zero(size));
+    if (!std::has_single_bit(size) || state_qubits < qubits || state_qubits > MAX_SIMULATED_QUBITS) {
+        std::cerr << "VQE initial state must be a power of two covering the Hamiltonian's " << qubits
+                  << " qubits, at most " << MAX_SIMULATED_QUBITS << std::endl;
+        return OptimizationResult{};
+    }
+    return run_vqe(StateVector::from_complex(initial_state), [&](const StateVector& state) {
+        return measure_expectation(state, hamiltonian);
+    });
+}
+
+std::vector<double> QuantumOptimizer::measure_expectation(const QuantumState& state,
+                                                          const std::vector<std::vector<Complex>>& observable) {
+    Complex expectation = 0.0;
+    for (size_t r = 0; r < state.size() && r < observable.size(); ++r) {
+        Complex row = 0.0;
+        for (size_t c = 0; c < state.size() && c < observable[r].size(); ++c) {
+            row += observable[r][c] * state[c];
+        }
+        expectation += std::conj(state[r]) * row;
+    }
+    return {expectation.real()};
+}
+
+double QuantumOptimizer::measure_expectation(const StateVector& state, const PauliHamiltonian& observable) const {
+    return observable.expectation(state);
+}
+
+QuantumOptimizer::OptimizationResult QuantumOptimizer::run_vqe(
+    const StateVector& initial,
+    const std::function<double(const StateVector&)>& energy) {
+    auto start = std::chrono::steady_clock::now();
+    OptimizationResult result{};
+    size_t qubits = initial.qubits();
+    size_t layers = config_.vqe_layers;
+
+    // Trial state and circuit are reused by every evaluation
+    StateVector state = initial;
+    GateSequence circuit;
+    auto energy_of = [&](const std::vector<double>& angles) {
+        state = initial;
+        circuit.clear();
+        size_t p = 0;
+        for (size_t l = 0; l <= layers; ++l) {
+            for (size_t q = 0; q < qubits; ++q) {
+                circuit.add_rotation_y(q, angles[p++]);
+                circuit.add_rotation_z(q, angles[p++]);
+            }
+            for (size_t q = 0; l < layers && q + 1 < qubits; ++q) {
+                circuit.add_cnot(q, q + 1);
+            }
+        }
+        simulator_.apply(circuit, state);
+        result.iterations++;
+        return energy(state);
+    };
+
+    std::vector<double> angles = nelder_mead_optimize(energy_of, std::vector<double>(2 * qubits * (layers + 1), 0.0));
+    result.optimal_value = energy_of(angles);
+
+    size_t best = 0;
+    for (size_t z = 1; z < state.size(); ++z) {
+        if (state.probability(z) > state.probability(best)) {
+            best = z;
+        }
+    }
+    result.optimal_weights.resize(qubits);
+    for (size_t q = 0; q < qubits; ++q) {
+        result.optimal_weights[q] = static_cast<double>((best >> q) & 1);
+    }
+    result.convergence_time_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.quantum_advantage_ratio = 1.0;  // Classical simulation
+    total_optimization_time_ += result.convergence_time_ms;
+    return result;
+}
+
+void QuantumOptimizer::apply_hadamard(StateVector& state, size_t qubit) {
+    GateSequence gate;
+    gate.add_hadamard(qubit);
+    simulator_.apply(gate, state);
+}
+
+void QuantumOptimizer::apply_cnot(StateVector& state, size_t control, size_t target) {
+    GateSequence gate;
+    gate.add_cnot(control, target);
+    simulator_.apply(gate, state);
+}
+
+void QuantumOptimizer::apply_rotation_z(StateVector& state, size_t qubit, double angle) {
+    GateSequence gate;
+    gate.add_rotation_z(qubit, angle);
+    simulator_.apply(gate, state);
+}
+
+void QuantumOptimizer::apply_rotation_x(StateVector& state, size_t qubit, double angle) {
+    GateSequence gate;
+    gate.add_rotation_x(qubit, angle);
+    simulator_.apply(gate, state);
+}
+
+std::vector<double> QuantumOptimizer::nelder_mead_optimize(const CostFunction& func,
+                                                           const std::vector<double>& initial_guess) const {
+    size_t n = initial_guess.size();
+    std::vector<std::vector<double>> simplex(n + 1, initial_guess);
+    for (size_t i = 0; i < n; ++i) {
+        simplex[i + 1][i] += NM_INITIAL_STEP;
+    }
+    std::vector<double> values(n + 1);
+    for (size_t i = 0; i <= n; ++i) {
+        values[i] = func(simplex[i]);
+    }
+
+    std::vector<size_t> order(n + 1);
+    std::vector<double> centroid(n);
+    std::vector<double> reflected(n);
+    std::vector<double> candidate(n);
+    auto along = [&](double coefficient, const std::vector<double>& from, std::vector<double>& out) {
+        for (size_t d = 0; d < n; ++d) {
+            out[d] = centroid[d] + coefficient * (from[d] - centroid[d]);
+        }
+    };
+
+    for (size_t iteration = 0; iteration < NM_ITERATIONS_PER_DIMENSION * n; ++iteration) {
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return values[a] < values[b]; });
+        size_t best = order.front();
+        size_t worst = order.back();
+        size_t second_worst = order[n > 0 ? n - 1 : 0];
+        if (values[worst] - values[best] < NM_TOLERANCE) {
+            break;
+        }
+
+        std::fill(centroid.begin(), centroid.end(), 0.0);
+        for (size_t i = 0; i <= n; ++i) {
+            if (i == worst) {
+                continue;
+            }
+            for (size_t d = 0; d < n; ++d) {
+                centroid[d] += simplex[i][d] / static_cast<double>(n);
+            }
+        }
+
+        along(-NM_ALPHA, simplex[worst], reflected);
+        double reflected_value = func(reflected);
+        if (reflected_value < values[best]) {
+            along(-NM_GAMMA, simplex[worst], candidate);
+            double expanded_value = func(candidate);
+            if (expanded_value < reflected_value) {
+                simplex[worst] = candidate;
+                values[worst] = expanded_value;
+            } else {
+                simplex[worst] = reflected;
+                values[worst] = reflected_value;
+            }
+            continue;
+        }
+        if (reflected_value < values[second_worst]) {
+            simplex[worst] = reflected;
+            values[worst] = reflected_value;
+            continue;
+        }
+
+        along(NM_RHO, simplex[worst], candidate);
+        double contracted_value = func(candidate);
+        if (contracted_value < values[worst]) {
+            simplex[worst] = candidate;
+            values[worst] = contracted_value;
+            continue;
+        }
+
+        for (size_t i = 0; i <= n; ++i) {
+            if (i == best) {
+                continue;
+            }
+            for (size_t d = 0; d < n; ++d) {
+                simplex[i][d] = simplex[best][d] + NM_SIGMA * (simplex[i][d] - simplex[best][d]);
+            }
+            values[i] = func(simplex[i]);
+        }
+    }
+
+    size_t best = static_cast<size_t>(std::min_element(values.begin(), values.end()) - values.begin());
+    return simplex[best];
+}
+
+void QuantumOptimizer::simulate_qaoa_circuit(const std::vector<double>& parameters,
+                                             const std::vector<double>& cost_diagonal,
+                                             size_t num_layers,
+                                             const StateVectorSimulator& simulator,
+                                             GateSequence& circuit,
+                                             StateVector& state) const {
+    // H on every qubit of |0...0>, then per layer exp(-i gamma C) and exp(-i beta sum X)
+    state.set_uniform();
+    circuit.clear();
+    for (size_t l = 0; l < num_layers; ++l) {
+        circuit.add_phase(cost_diagonal.data(), parameters[2 * l]);
+        for (size_t q = 0; q < state.qubits(); ++q) {
+            circuit.add_rotation_x(q, 2.0 * parameters[2 * l + 1]);
+        }
+    }
+    simulator.apply(circuit, state);
+}
+
+} // namespace quantum
+} // namespace feedhandler
@@ -0,0 +1,385 @@
+#include "quantum/state_vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace feedhandler {
+namespace quantum {
+
+namespace {
+
+using Complex = std::complex<double>;
+
+// Pairs (a0, a1) = (amp[i0 + k], amp[i1 + k]) for k < count become (m00 a0 + m01 a1, m10 a0 + m11 a1)
+void pairs_scalar(const Gate2x2& g, double* re, double* im, size_t i0, size_t i1, size_t count) {
+    const double a = g.m[0][0].real(), b = g.m[0][0].imag();
+    const double c = g.m[0][1].real(), d = g.m[0][1].imag();
+    const double e = g.m[1][0].real(), f = g.m[1][0].imag();
+    const double h = g.m[1][1].real(), j = g.m[1][1].imag();
+    for (size_t k = 0; k < count; ++k) {
+        double r0 = re[i0 + k], q0 = im[i0 + k];
+        double r1 = re[i1 + k], q1 = im[i1 + k];
+        re[i0 + k] = a * r0 - b * q0 + c * r1 - d * q1;
+        im[i0 + k] = a * q0 + b * r0 + c * q1 + d * r1;
+        re[i1 + k] = e * r0 - f * q0 + h * r1 - j * q1;
+        im[i1 + k] = e * q0 + f * r0 + h * q1 + j * r1;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Four pairs per iteration; the tail stays inline to avoid an AVX-SSE transition
+__attribute__((target("avx2,fma")))
+void pairs_avx2(const Gate2x2& g, double* re, double* im, size_t i0, size_t i1, size_t count) {
+    const __m256d a = _mm256_set1_pd(g.m[0][0].real()), b = _mm256_set1_pd(g.m[0][0].imag());
+    const __m256d c = _mm256_set1_pd(g.m[0][1].real()), d = _mm256_set1_pd(g.m[0][1].imag());
+    const __m256d e = _mm256_set1_pd(g.m[1][0].real()), f = _mm256_set1_pd(g.m[1][0].imag());
+    const __m256d h = _mm256_set1_pd(g.m[1][1].real()), j = _mm256_set1_pd(g.m[1][1].imag());
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        __m256d r0 = _mm256_loadu_pd(re + i0 + k), q0 = _mm256_loadu_pd(im + i0 + k);
+        __m256d r1 = _mm256_loadu_pd(re + i1 + k), q1 = _mm256_loadu_pd(im + i1 + k);
+        __m256d nr0 = _mm256_fmsub_pd(a, r0, _mm256_fmsub_pd(b, q0, _mm256_fmsub_pd(c, r1, _mm256_mul_pd(d, q1))));
+        __m256d nq0 = _mm256_fmadd_pd(a, q0, _mm256_fmadd_pd(b, r0, _mm256_fmadd_pd(c, q1, _mm256_mul_pd(d, r1))));
+        __m256d nr1 = _mm256_fmsub_pd(e, r0, _mm256_fmsub_pd(f, q0, _mm256_fmsub_pd(h, r1, _mm256_mul_pd(j, q1))));
+        __m256d nq1 = _mm256_fmadd_pd(e, q0, _mm256_fmadd_pd(f, r0, _mm256_fmadd_pd(h, q1, _mm256_mul_pd(j, r1))));
+        _mm256_storeu_pd(re + i0 + k, nr0);
+        _mm256_storeu_pd(im + i0 + k, nq0);
+        _mm256_storeu_pd(re + i1 + k, nr1);
+        _mm256_storeu_pd(im + i1 + k, nq1);
+    }
+    const double sa = g.m[0][0].real(), sb = g.m[0][0].imag();
+    const double sc = g.m[0][1].real(), sd = g.m[0][1].imag();
+    const double se = g.m[1][0].real(), sf = g.m[1][0].imag();
+    const double sh = g.m[1][1].real(), sj = g.m[1][1].imag();
+    for (; k < count; ++k) {
+        double r0 = re[i0 + k], q0 = im[i0 + k];
+        double r1 = re[i1 + k], q1 = im[i1 + k];
+        re[i0 + k] = sa * r0 - sb * q0 + sc * r1 - sd * q1;
+        im[i0 + k] = sa * q0 + sb * r0 + sc * q1 + sd * r1;
+        re[i1 + k] = se * r0 - sf * q0 + sh * r1 - sj * q1;
+        im[i1 + k] = se * q0 + sf * r0 + sh * q1 + sj * r1;
+    }
+}
+
+#endif
+
+using PairsKernel = void (*)(const Gate2x2&, double*, double*, size_t, size_t, size_t);
+
+PairsKernel pairs_kernel() {
+    static const PairsKernel kernel = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init(); // May run before libgcc's constructor
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return &pairs_avx2;
+        }
+#endif
+        return &pairs_scalar;
+    }();
+    return kernel;
+}
+
+// Gate on qubit over [begin, end), which is aligned to 2^(qubit + 1)
+void apply_single(const GateSequence::Op& op, StateVector& state, size_t begin, size_t end) {
+    size_t stride = size_t{1} << op.qubit;
+    double* re = state.real();
+    double* im = state.imag();
+    if (stride < 4) {
+        // Too short for a vector; one call per range instead of per pair
+        for (size_t base = begin; base < end; base += 2 * stride) {
+            pairs_scalar(op.gate, re, im, base, base + stride, stride);
+        }
+        return;
+    }
+    PairsKernel kernel = pairs_kernel();
+    for (size_t base = begin; base < end; base += 2 * stride) {
+        kernel(op.gate, re, im, base, base + stride, stride);
+    }
+}
+
+// Swaps for indices in [begin, end) with control 1 and target 0; the partner is written only from here
+void apply_cnot(const GateSequence::Op& op, StateVector& state, size_t begin, size_t end) {
+    size_t control = size_t{1} << op.control;
+    size_t target = size_t{1} << op.qubit;
+    double* re = state.real();
+    double* im = state.imag();
+    for (size_t i = begin; i < end; ++i) {
+        if ((i & control) && !(i & target)) {
+            std::swap(re[i], re[i | target]);
+            std::swap(im[i], im[i | target]);
+        }
+    }
+}
+
+void apply_phase(const GateSequence::Op& op, StateVector& state, size_t begin, size_t end) {
+    double* re = state.real();
+    double* im = state.imag();
+    for (size_t i = begin; i < end; ++i) {
+        double theta = -op.angle * op.diagonal[i];
+        double c = std::cos(theta);
+        double s = std::sin(theta);
+        double r = re[i];
+        re[i] = r * c - im[i] * s;
+        im[i] = r * s + im[i] * c;
+    }
+}
+
+void apply_in_range(const GateSequence::Op& op, StateVector& state, size_t begin, size_t end) {
+    switch (op.kind) {
+        case GateSequence::Kind::SINGLE:
+            apply_single(op, state, begin, end);
+            break;
+        case GateSequence::Kind::CNOT:
+            apply_cnot(op, state, begin, end);
+            break;
+        case GateSequence::Kind::PHASE:
+            apply_phase(op, state, begin, end);
+            break;
+    }
+}
+
+// fn(first, last) over [0, count), split statically across up to threads threads
+template<typename Fn>
+void run_parallel(size_t count, size_t threads, const Fn& fn) {
+    threads = std::min(threads, count);
+    if (threads <= 1) {
+        fn(size_t{0}, count);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    size_t per_thread = (count + threads - 1) / threads;
+    for (size_t t = 1; t < threads; ++t) {
+        size_t first = std::min(count, t * per_thread);
+        size_t last = std::min(count, first + per_thread);
+        workers.emplace_back([&fn, first, last] { fn(first, last); });
+    }
+    fn(size_t{0}, std::min(count, per_thread));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace
+
+Gate2x2 Gate2x2::hadamard() {
+    const double s = 1.0 / std::sqrt(2.0);
+    return Gate2x2{{{s, s}, {s, -s}}};
+}
+
+Gate2x2 Gate2x2::rotation_x(double angle) {
+    const double c = std::cos(angle / 2.0);
+    const double s = std::sin(angle / 2.0);
+    return Gate2x2{{{Complex(c, 0.0), Complex(0.0, -s)}, {Complex(0.0, -s), Complex(c, 0.0)}}};
+}
+
+Gate2x2 Gate2x2::rotation_y(double angle) {
+    const double c = std::cos(angle / 2.0);
+    const double s = std::sin(angle / 2.0);
+    return Gate2x2{{{c, -s}, {s, c}}};
+}
+
+Gate2x2 Gate2x2::rotation_z(double angle) {
+    return Gate2x2{{{std::polar(1.0, -angle / 2.0), 0.0}, {0.0, std::polar(1.0, angle / 2.0)}}};
+}
+
+Gate2x2 Gate2x2::then(const Gate2x2& next) const {
+    Gate2x2 product{};
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t j = 0; j < 2; ++j) {
+            product.m[i][j] = next.m[i][0] * m[0][j] + next.m[i][1] * m[1][j];
+        }
+    }
+    return product;
+}
+
+StateVector::StateVector(size_t qubits)
+    : qubits_(qubits), real_(size_t{1} << qubits, 0.0), imag_(size_t{1} << qubits, 0.0) {
+    real_[0] = 1.0;
+}
+
+StateVector StateVector::from_complex(const std::vector<Complex>& amplitudes) {
+    size_t qubits = 0;
+    while ((size_t{1} << qubits) < amplitudes.size()) {
+        ++qubits;
+    }
+    if (amplitudes.empty() || (size_t{1} << qubits) != amplitudes.size()) {
+        throw std::invalid_argument("State vector size must be a power of two");
+    }
+    StateVector state(qubits);
+    for (size_t i = 0; i < amplitudes.size(); ++i) {
+        state.set_amplitude(i, amplitudes[i]);
+    }
+    return state;
+}
+
+std::vector<StateVector::Complex> StateVector::to_complex() const {
+    std::vector<Complex> amplitudes(size());
+    for (size_t i = 0; i < size(); ++i) {
+        amplitudes[i] = amplitude(i);
+    }
+    return amplitudes;
+}
+
+void StateVector::set_basis_state(size_t index) {
+    std::fill(real_.begin(), real_.end(), 0.0);
+    std::fill(imag_.begin(), imag_.end(), 0.0);
+    real_[index] = 1.0;
+}
+
+void StateVector::set_uniform() {
+    std::fill(real_.begin(), real_.end(), 1.0 / std::sqrt(static_cast<double>(size())));
+    std::fill(imag_.begin(), imag_.end(), 0.0);
+}
+
+double StateVector::norm_squared() const {
+    double sum = 0.0;
+    for (size_t i = 0; i < size(); ++i) {
+        sum += probability(i);
+    }
+    return sum;
+}
+
+void GateSequence::add(size_t qubit, const Gate2x2& gate) {
+    if (qubit >= open_single_.size()) {
+        open_single_.resize(qubit + 1, NONE);
+    }
+    if (open_single_[qubit] != NONE) {
+        Op& fused = ops_[open_single_[qubit]];
+        fused.gate = fused.gate.then(gate);
+        return;
+    }
+    open_single_[qubit] = ops_.size();
+    ops_.push_back(Op{Kind::SINGLE, qubit, 0, gate, nullptr, 0.0});
+}
+
+void GateSequence::add_cnot(size_t control, size_t target) {
+    ops_.push_back(Op{Kind::CNOT, target, control, Gate2x2{}, nullptr, 0.0});
+    for (size_t qubit : {control, target}) {
+        if (qubit < open_single_.size()) {
+            open_single_[qubit] = NONE;
+        }
+    }
+}
+
+void GateSequence::add_phase(const double* diagonal, double angle) {
+    ops_.push_back(Op{Kind::PHASE, 0, 0, Gate2x2{}, diagonal, angle});
+    std::fill(open_single_.begin(), open_single_.end(), NONE);
+}
+
+void GateSequence::clear() {
+    ops_.clear();
+    open_single_.clear();
+}
+
+StateVectorSimulator::StateVectorSimulator()
+    : StateVectorSimulator(Config()) {}
+
+StateVectorSimulator::StateVectorSimulator(const Config& config)
+    : config_(config) {
+    if (config_.threads == 0) {
+        config_.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    config_.block_qubits = std::max<size_t>(config_.block_qubits, 1);
+}
+
+void StateVectorSimulator::apply(const GateSequence& sequence, StateVector& state) const {
+    const auto& ops = sequence.ops();
+    size_t block_qubits = std::min(config_.block_qubits, state.qubits());
+    size_t block = size_t{1} << block_qubits;
+    size_t threads = state.qubits() >= config_.parallel_qubits ? config_.threads : 1;
+
+    auto local = [block_qubits](const GateSequence::Op& op) {
+        switch (op.kind) {
+            case GateSequence::Kind::SINGLE:
+                return op.qubit < block_qubits;
+            case GateSequence::Kind::CNOT:
+                return op.qubit < block_qubits && op.control < block_qubits;
+            case GateSequence::Kind::PHASE:
+                return true;
+        }
+        return false;
+    };
+
+    size_t i = 0;
+    while (i < ops.size()) {
+        if (local(ops[i])) {
+            // Every op of the run on one block before moving to the next
+            size_t j = i;
+            while (j < ops.size() && local(ops[j])) {
+                ++j;
+            }
+            run_parallel(state.size() / block, threads, [&](size_t first, size_t last) {
+                for (size_t b = first; b < last; ++b) {
+                    for (size_t k = i; k < j; ++k) {
+                        apply_in_range(ops[k], state, b * block, (b + 1) * block);
+                    }
+                }
+            });
+            i = j;
+            continue;
+        }
+
+        const GateSequence::Op& op = ops[i];
+        if (op.kind == GateSequence::Kind::SINGLE) {
+            // Pairs 2^qubit apart: split each half into block-sized runs
+            size_t stride = size_t{1} << op.qubit;
+            size_t run = std::min(stride, block);
+            size_t runs_per_base = stride / run;
+            size_t units = state.size() / (2 * stride) * runs_per_base;
+            PairsKernel kernel = pairs_kernel();
+            run_parallel(units, threads, [&](size_t first, size_t last) {
+                for (size_t u = first; u < last; ++u) {
+                    size_t start = (u / runs_per_base) * 2 * stride + (u % runs_per_base) * run;
+                    kernel(op.gate, state.real(), state.imag(), start, start + stride, run);
+                }
+            });
+        } else {
+            run_parallel(state.size() / block, threads, [&](size_t first, size_t last) {
+                apply_in_range(op, state, first * block, last * block);
+            });
+        }
+        ++i;
+    }
+}
+
+void StateVectorSimulator::apply_unblocked(const GateSequence& sequence, StateVector& state) {
+    for (const auto& op : sequence.ops()) {
+        for (size_t i = 0; i < state.size(); ++i) {
+            switch (op.kind) {
+                case GateSequence::Kind::SINGLE: {
+                    size_t bit = size_t{1} << op.qubit;
+                    if (!(i & bit)) {
+                        Complex a0 = state.amplitude(i);
+                        Complex a1 = state.amplitude(i | bit);
+                        state.set_amplitude(i, op.gate.m[0][0] * a0 + op.gate.m[0][1] * a1);
+                        state.set_amplitude(i | bit, op.gate.m[1][0] * a0 + op.gate.m[1][1] * a1);
+                    }
+                    break;
+                }
+                case GateSequence::Kind::CNOT: {
+                    size_t target = size_t{1} << op.qubit;
+                    if ((i >> op.control & 1) && !(i & target)) {
+                        Complex a0 = state.amplitude(i);
+                        state.set_amplitude(i, state.amplitude(i | target));
+                        state.set_amplitude(i | target, a0);
+                    }
+                    break;
+                }
+                case GateSequence::Kind::PHASE:
+                    state.set_amplitude(i, state.amplitude(i) * std::polar(1.0, -op.angle * op.diagonal[i]));
+                    break;
+            }
+        }
+    }
+}
+
+} // namespace quantum
+} // namespace feedhandler
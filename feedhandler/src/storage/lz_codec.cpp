@@ -0,0 +1,249 @@
+#include "storage/lz_codec.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace feedhandler {
+namespace storage {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5;   // The block ends with at least this many literals
+constexpr size_t MATCH_LIMIT = 12;    // No match starts in the last 12 bytes
+constexpr size_t MAX_OFFSET = 65535;
+constexpr unsigned MAX_HASH_LOG = 16;
+constexpr unsigned MIN_HASH_LOG = 8;
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t hash4(uint32_t sequence, unsigned hash_log) {
+    return (sequence * 2654435761u) >> (32 - hash_log);
+}
+
+// Per-thread match tables; sized to the input so small blocks stay cheap
+struct MatchTables {
+    std::vector<uint32_t> head;   // Last position + 1 per hash (0 = empty)
+    std::vector<uint16_t> chain;  // Distance to the previous position with the same hash
+
+    void reset(unsigned hash_log, bool chained) {
+        head.assign(size_t(1) << hash_log, 0);
+        if (chained) {
+            chain.assign(MAX_OFFSET + 1, 0);
+        }
+    }
+};
+
+class Emitter {
+public:
+    Emitter(uint8_t* dst, size_t capacity) : out_(dst), end_(dst + capacity) {}
+
+    bool sequence(const uint8_t* literals, size_t literal_length, size_t offset, size_t match_length) {
+        size_t extra = match_length - MIN_MATCH;
+        uint8_t* token = out_;
+        if (!reserve(1 + literal_length + literal_length / 255 + 2 + extra / 255 + 2)) {
+            return false;
+        }
+        *out_++ = 0;
+        *token = static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4 | std::min<size_t>(extra, 15));
+        length(literal_length);
+        std::memcpy(out_, literals, literal_length);
+        out_ += literal_length;
+        *out_++ = static_cast<uint8_t>(offset);
+        *out_++ = static_cast<uint8_t>(offset >> 8);
+        length(extra);
+        return true;
+    }
+
+    bool last(const uint8_t* literals, size_t literal_length) {
+        if (!reserve(1 + literal_length + literal_length / 255 + 1)) {
+            return false;
+        }
+        *out_++ = static_cast<uint8_t>(std::min<size_t>(literal_length, 15) << 4);
+        length(literal_length);
+        std::memcpy(out_, literals, literal_length);
+        out_ += literal_length;
+        return true;
+    }
+
+    uint8_t* position() const { return out_; }
+
+private:
+    bool reserve(size_t bytes) const { return static_cast<size_t>(end_ - out_) >= bytes; }
+
+    // Lengths of 15+ continue in following bytes, 255 at a time
+    void length(size_t value) {
+        if (value < 15) {
+            return;
+        }
+        value -= 15;
+        while (value >= 255) {
+            *out_++ = 255;
+            value -= 255;
+        }
+        *out_++ = static_cast<uint8_t>(value);
+    }
+
+    uint8_t* out_;
+    uint8_t* end_;
+};
+
+} // namespace
+
+size_t lz_compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int level) {
+    level = std::clamp(level, FAST_LEVEL, MAX_LEVEL);
+    Emitter out(dst, capacity);
+    if (size < MATCH_LIMIT + 1) {
+        return out.last(src, size) ? static_cast<size_t>(out.position() - dst) : 0;
+    }
+
+    unsigned hash_log = MIN_HASH_LOG;
+    while (hash_log < MAX_HASH_LOG && (size_t(1) << hash_log) < size) {
+        ++hash_log;
+    }
+    const bool chained = level > FAST_LEVEL;
+    const size_t attempts = size_t(1) << (level - 1);
+    thread_local MatchTables tables;
+    tables.reset(hash_log, chained);
+
+    auto insert = [&](size_t pos) {
+        uint32_t& head = tables.head[hash4(read32(src + pos), hash_log)];
+        if (chained) {
+            size_t distance = head == 0 ? 0 : pos - (head - 1);
+            tables.chain[pos & MAX_OFFSET] = static_cast<uint16_t>(distance > MAX_OFFSET ? 0 : distance);
+        }
+        head = static_cast<uint32_t>(pos + 1);
+    };
+
+    const size_t match_end = size - LAST_LITERALS;  // Matches stop short of the trailing literals
+    const size_t limit = size - MATCH_LIMIT;
+    size_t anchor = 0;
+    size_t ip = 0;
+    while (ip < limit) {
+        const uint32_t sequence = read32(src + ip);
+        uint32_t head = tables.head[hash4(sequence, hash_log)];
+        size_t best_length = 0;
+        size_t best = 0;
+        for (size_t attempt = 0; head != 0 && attempt < attempts; ++attempt) {
+            size_t candidate = head - 1;
+            if (ip - candidate > MAX_OFFSET) {
+                break;
+            }
+            if (read32(src + candidate) == sequence) {
+                size_t length = MIN_MATCH;
+                while (ip + length < match_end && src[candidate + length] == src[ip + length]) {
+                    ++length;
+                }
+                if (length > best_length) {
+                    best_length = length;
+                    best = candidate;
+                }
+            }
+            if (!chained) {
+                break;
+            }
+            uint16_t distance = tables.chain[candidate & MAX_OFFSET];
+            head = distance == 0 || distance > candidate ? 0 : static_cast<uint32_t>(candidate - distance + 1);
+        }
+        insert(ip);
+
+        if (best_length == 0) {
+            // Fast level accelerates through data that does not match
+            ip += chained ? 1 : 1 + ((ip - anchor) >> 6);
+            continue;
+        }
+
+        // Extend backwards over literals that also match
+        while (ip > anchor && best > 0 && src[ip - 1] == src[best - 1]) {
+            --ip;
+            --best;
+            ++best_length;
+        }
+        if (!out.sequence(src + anchor, ip - anchor, ip - best, best_length)) {
+            return 0;
+        }
+        size_t next = ip + best_length;
+        if (chained) {
+            for (size_t pos = ip + 1; pos < next && pos < limit; ++pos) {
+                insert(pos);
+            }
+        }
+        ip = next;
+        anchor = ip;
+    }
+
+    if (!out.last(src + anchor, size - anchor)) {
+        return 0;
+    }
+    return static_cast<size_t>(out.position() - dst);
+}
+
+bool lz_decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t original_size) {
+    const uint8_t* ip = src;
+    const uint8_t* const in_end = src + size;
+    uint8_t* op = dst;
+    uint8_t* const out_end = dst + original_size;
+
+    auto read_length = [&](size_t length, size_t& out) {
+        if (length == 15) {
+            uint8_t byte;
+            do {
+                if (ip >= in_end) {
+                    return false;
+                }
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+        }
+        out = length;
+        return true;
+    };
+
+    while (ip < in_end) {
+        const uint8_t token = *ip++;
+        size_t literals;
+        if (!read_length(token >> 4, literals) || literals > static_cast<size_t>(in_end - ip) ||
+            literals > static_cast<size_t>(out_end - op)) {
+            return false;
+        }
+        std::memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == in_end) {
+            break;  // Last sequence has literals only
+        }
+
+        if (in_end - ip < 2) {
+            return false;
+        }
+        const size_t offset = static_cast<size_t>(ip[0]) | static_cast<size_t>(ip[1]) << 8;
+        ip += 2;
+        size_t match;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst) || !read_length(token & 15, match)) {
+            return false;
+        }
+        match += MIN_MATCH;
+        if (match > static_cast<size_t>(out_end - op)) {
+            return false;
+        }
+        const uint8_t* from = op - offset;
+        if (offset >= match) {
+            std::memcpy(op, from, match);
+            op += match;
+        } else {
+            // Overlapping copy repeats the last offset bytes
+            for (size_t i = 0; i < match; ++i) {
+                *op++ = from[i];
+            }
+        }
+    }
+    return op == out_end;
+}
+
+} // namespace storage
+} // namespace feedhandler
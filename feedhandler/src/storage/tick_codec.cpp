@@ -0,0 +1,174 @@
+#include "storage/tick_codec.hpp"
+
+#include <array>
+
+namespace feedhandler {
+namespace storage {
+
+namespace {
+
+// Previous price per symbol; slots are shared past PRICE_SLOTS symbols,
+// which costs ratio but never correctness
+constexpr size_t PRICE_SLOTS = 256;
+
+constexpr uint64_t SIDE_NONE = 0;
+constexpr uint64_t SIDE_BUY = 1;
+constexpr uint64_t SIDE_SELL = 2;
+constexpr uint64_t SIDE_OTHER = 3;  // Raw side byte follows
+
+uint64_t side_code(char side) {
+    switch (side) {
+        case '\0': return SIDE_NONE;
+        case 'B': return SIDE_BUY;
+        case 'S': return SIDE_SELL;
+        default: return SIDE_OTHER;
+    }
+}
+
+// Deltas wrap instead of overflowing: any int64 round-trips
+int64_t wrapping_sub(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+}
+
+int64_t wrapping_add(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+
+// JournalRecord and CompactTick differ only in the symbol field's name
+uint32_t symbol_of(const JournalRecord& record) { return record.symbol; }
+uint32_t symbol_of(const common::CompactTick& tick) { return tick.instrument_id; }
+void set_symbol(JournalRecord& record, uint32_t symbol) { record.symbol = symbol; }
+void set_symbol(common::CompactTick& tick, uint32_t symbol) { tick.instrument_id = symbol; }
+
+template<typename Record>
+void encode_rows(std::span<const Record> rows, std::vector<uint8_t>& out) {
+    out.reserve(out.size() + 10 + rows.size() * 6);
+    put_varint(out, rows.size());
+
+    std::array<int64_t, PRICE_SLOTS> last_price{};
+    uint64_t last_timestamp = 0;
+    int64_t last_delta = 0;
+    for (const Record& row : rows) {
+        int64_t delta = static_cast<int64_t>(row.timestamp - last_timestamp);
+        put_varint(out, zigzag_encode(wrapping_sub(delta, last_delta)));
+        last_timestamp = row.timestamp;
+        last_delta = delta;
+
+        // NO_SYMBOL / INVALID_INSTRUMENT wrap to 0
+        uint64_t symbol = static_cast<uint32_t>(symbol_of(row) + 1);
+        uint64_t side = side_code(row.side);
+        put_varint(out, symbol << 2 | side);
+        if (side == SIDE_OTHER) {
+            out.push_back(static_cast<uint8_t>(row.side));
+        }
+
+        int64_t& previous = last_price[symbol % PRICE_SLOTS];
+        put_varint(out, zigzag_encode(wrapping_sub(row.price, previous)));
+        previous = row.price;
+
+        put_varint(out, zigzag_encode(row.qty));
+    }
+}
+
+template<typename Record>
+bool decode_rows(const uint8_t* data, size_t size, std::vector<Record>& rows) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    uint64_t count;
+    // Every row takes at least 4 bytes: reject absurd counts before reserving
+    if (!get_varint(p, end, count) || count > static_cast<uint64_t>(end - p) / 4) {
+        return false;
+    }
+    rows.clear();
+    rows.reserve(count);
+
+    std::array<int64_t, PRICE_SLOTS> last_price{};
+    uint64_t last_timestamp = 0;
+    int64_t last_delta = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        Record row{};
+        uint64_t dod, symbol, price, qty;
+        if (!get_varint(p, end, dod) || !get_varint(p, end, symbol)) {
+            return false;
+        }
+        last_delta = wrapping_add(last_delta, zigzag_decode(dod));
+        last_timestamp += static_cast<uint64_t>(last_delta);
+        row.timestamp = last_timestamp;
+
+        switch (symbol & 3) {
+            case SIDE_NONE: row.side = '\0'; break;
+            case SIDE_BUY: row.side = 'B'; break;
+            case SIDE_SELL: row.side = 'S'; break;
+            default:
+                if (p == end) {
+                    return false;
+                }
+                row.side = static_cast<char>(*p++);
+        }
+        symbol >>= 2;
+        set_symbol(row, static_cast<uint32_t>(symbol - 1));
+
+        if (!get_varint(p, end, price) || !get_varint(p, end, qty)) {
+            return false;
+        }
+        int64_t& previous = last_price[symbol % PRICE_SLOTS];
+        previous = wrapping_add(previous, zigzag_decode(price));
+        row.price = previous;
+        row.qty = static_cast<int32_t>(zigzag_decode(qty));
+        rows.push_back(row);
+    }
+    return p == end;
+}
+
+} // namespace
+
+void encode_ticks(std::span<const JournalRecord> records, std::vector<uint8_t>& out) {
+    encode_rows(records, out);
+}
+
+void encode_ticks(std::span<const common::CompactTick> ticks, std::vector<uint8_t>& out) {
+    encode_rows(ticks, out);
+}
+
+bool decode_ticks(const uint8_t* data, size_t size, std::vector<JournalRecord>& records) {
+    return decode_rows(data, size, records);
+}
+
+bool decode_ticks(const uint8_t* data, size_t size, std::vector<common::CompactTick>& ticks) {
+    return decode_rows(data, size, ticks);
+}
+
+void encode_levels(std::span<const BookLevel> levels, std::vector<uint8_t>& out) {
+    out.reserve(out.size() + 10 + levels.size() * 4);
+    put_varint(out, levels.size());
+    int64_t last_price = 0;
+    for (const BookLevel& level : levels) {
+        put_varint(out, zigzag_encode(wrapping_sub(level.price, last_price)));
+        put_varint(out, zigzag_encode(level.quantity));
+        last_price = level.price;
+    }
+}
+
+bool decode_levels(const uint8_t* data, size_t size, std::vector<BookLevel>& levels) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    uint64_t count;
+    if (!get_varint(p, end, count) || count > static_cast<uint64_t>(end - p) / 2) {
+        return false;
+    }
+    levels.clear();
+    levels.reserve(count);
+    int64_t last_price = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t price, quantity;
+        if (!get_varint(p, end, price) || !get_varint(p, end, quantity)) {
+            return false;
+        }
+        last_price = wrapping_add(last_price, zigzag_decode(price));
+        levels.push_back({last_price, zigzag_decode(quantity)});
+    }
+    return p == end;
+}
+
+} // namespace storage
+} // namespace feedhandler
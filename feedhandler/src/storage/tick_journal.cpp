@@ -0,0 +1,550 @@
+#include "storage/tick_journal.hpp"
+#include "storage/tick_codec.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace feedhandler {
+namespace storage {
+
+namespace {
+
+constexpr char FILE_MAGIC[8] = {'F', 'H', 'T', 'J', 'R', 'N', 'L', '1'};
+constexpr char TRAILER_MAGIC[8] = {'F', 'H', 'T', 'J', 'I', 'D', 'X', '1'};
+constexpr uint32_t BLOCK_MAGIC = 0x4b4c4254;  // "TBLK"
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint32_t ENCODED_FORMAT_VERSION = 2;  // Blocks may be DELTA / DELTA_LZ
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t block_records;
+    char reserved[44];
+};
+
+struct BlockHeader {
+    uint32_t magic;
+    uint32_t record_count;
+    uint32_t symbol_count;
+    uint32_t encoding;          // JournalEncoding; 0 (RAW) in version 1 files
+    uint64_t first_timestamp;
+    uint64_t last_timestamp;
+    uint64_t payload_bytes;     // Encoded blocks: bytes before padding
+    uint64_t reserved;
+};
+
+struct SymbolEntry {
+    uint32_t file_symbol;
+    uint32_t length;
+    char name[32];
+};
+
+struct Trailer {
+    uint64_t index_offset;
+    uint64_t block_count;
+    char magic[8];
+};
+
+static_assert(sizeof(FileHeader) == 64, "File header is 64 bytes");
+static_assert(sizeof(BlockHeader) == 48, "Block header is 48 bytes");
+static_assert(sizeof(SymbolEntry) == 40, "Dictionary entry is 40 bytes");
+static_assert(sizeof(JournalIndexEntry) == 32, "Index entry is 32 bytes");
+static_assert(common::SymbolTable::MAX_SYMBOL_LENGTH < sizeof(SymbolEntry::name), "Symbol must fit its entry");
+
+// Blocks, dictionary entries and records stay 8-byte aligned in the file
+static_assert(sizeof(FileHeader) % 8 == 0 && sizeof(BlockHeader) % 8 == 0 && sizeof(SymbolEntry) % 8 == 0,
+              "Journal sections must keep records aligned");
+
+bool write_fully(int fd, const iovec* iov, int count) {
+    std::vector<iovec> pending(iov, iov + count);
+    size_t first = 0;
+    while (first < pending.size()) {
+        ssize_t written = ::writev(fd, pending.data() + first, static_cast<int>(pending.size() - first));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        size_t remaining = static_cast<size_t>(written);
+        while (first < pending.size() && remaining >= pending[first].iov_len) {
+            remaining -= pending[first].iov_len;
+            ++first;
+        }
+        if (first < pending.size()) {
+            pending[first].iov_base = static_cast<char*>(pending[first].iov_base) + remaining;
+            pending[first].iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+uint64_t padded(uint64_t bytes) {
+    return (bytes + 7) & ~uint64_t(7);
+}
+
+// Bytes the records section of a block occupies in the file
+uint64_t records_bytes(const BlockHeader& header) {
+    return header.encoding == static_cast<uint32_t>(JournalEncoding::RAW)
+        ? static_cast<uint64_t>(header.record_count) * sizeof(JournalRecord)
+        : padded(header.payload_bytes);
+}
+
+} // namespace
+
+// ============================================================================
+// TickJournalWriter
+// ============================================================================
+
+TickJournalWriter::TickJournalWriter(size_t block_records, JournalEncoding encoding, int level)
+    : fd_(-1)
+    , block_records_(block_records == 0 ? DEFAULT_BLOCK_RECORDS : block_records)
+    , encoding_(encoding)
+    , level_(level)
+    , file_offset_(0)
+    , records_written_(0)
+    , pending_symbol_count_(0)
+    , next_file_symbol_(0) {
+    records_.reserve(block_records_);
+}
+
+TickJournalWriter::~TickJournalWriter() {
+    close();
+}
+
+bool TickJournalWriter::open(const std::string& path) {
+    close();
+
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "TickJournalWriter: cannot create " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = encoding_ == JournalEncoding::RAW ? FORMAT_VERSION : ENCODED_FORMAT_VERSION;
+    header.record_size = sizeof(JournalRecord);
+    header.block_records = static_cast<uint32_t>(block_records_);
+    iovec iov{&header, sizeof(header)};
+    if (!write_fully(fd_, &iov, 1)) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    file_offset_ = sizeof(header);
+    records_written_ = 0;
+    records_.clear();
+    pending_symbols_.clear();
+    pending_symbol_count_ = 0;
+    file_symbols_.clear();
+    next_file_symbol_ = 0;
+    index_.clear();
+    return true;
+}
+
+uint32_t TickJournalWriter::file_symbol(common::InstrumentId instrument_id) {
+    if (instrument_id == common::INVALID_INSTRUMENT) {
+        return JournalRecord::NO_SYMBOL;
+    }
+    if (instrument_id < file_symbols_.size() && file_symbols_[instrument_id] != JournalRecord::NO_SYMBOL) {
+        return file_symbols_[instrument_id];
+    }
+
+    std::string_view name = common::SymbolTable::global().name(instrument_id);
+    if (name.empty()) {
+        return JournalRecord::NO_SYMBOL;
+    }
+    if (instrument_id >= file_symbols_.size()) {
+        file_symbols_.resize(instrument_id + 1, JournalRecord::NO_SYMBOL);
+    }
+
+    // First use in this file: the current block carries the definition
+    SymbolEntry entry{};
+    entry.file_symbol = next_file_symbol_++;
+    entry.length = static_cast<uint32_t>(name.size());
+    std::memcpy(entry.name, name.data(), name.size());
+    const char* bytes = reinterpret_cast<const char*>(&entry);
+    pending_symbols_.insert(pending_symbols_.end(), bytes, bytes + sizeof(entry));
+    ++pending_symbol_count_;
+
+    file_symbols_[instrument_id] = entry.file_symbol;
+    return entry.file_symbol;
+}
+
+bool TickJournalWriter::append(const common::CompactTick& tick) {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    JournalRecord record{};
+    record.price = tick.price;
+    record.timestamp = tick.timestamp;
+    record.symbol = file_symbol(tick.instrument_id);
+    record.qty = tick.qty;
+    record.side = tick.side;
+    records_.push_back(record);
+
+    if (records_.size() >= block_records_) {
+        return write_block();
+    }
+    return true;
+}
+
+bool TickJournalWriter::write_block() {
+    if (records_.empty()) {
+        return true;
+    }
+
+    BlockHeader header{};
+    header.magic = BLOCK_MAGIC;
+    header.record_count = static_cast<uint32_t>(records_.size());
+    header.symbol_count = pending_symbol_count_;
+    header.first_timestamp = UINT64_MAX;
+    header.last_timestamp = 0;
+    for (const auto& record : records_) {
+        header.first_timestamp = std::min(header.first_timestamp, record.timestamp);
+        header.last_timestamp = std::max(header.last_timestamp, record.timestamp);
+    }
+
+    header.encoding = static_cast<uint32_t>(encoding_);
+
+    static const uint64_t zero_padding = 0;
+    iovec iov[4] = {
+        {&header, sizeof(header)},
+        {pending_symbols_.data(), pending_symbols_.size()},
+        {records_.data(), records_.size() * sizeof(JournalRecord)},
+        {const_cast<uint64_t*>(&zero_padding), 0},
+    };
+    if (encoding_ != JournalEncoding::RAW) {
+        header.payload_bytes = encode_block();
+        const std::vector<uint8_t>& payload = encoding_ == JournalEncoding::DELTA ? encoded_ : compressed_;
+        iov[2] = {const_cast<uint8_t*>(payload.data()), header.payload_bytes};
+        iov[3].iov_len = padded(header.payload_bytes) - header.payload_bytes;
+    }
+    if (!write_fully(fd_, iov, 4)) {
+        std::cerr << "TickJournalWriter: write failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    index_.push_back({file_offset_, header.first_timestamp, header.last_timestamp,
+                      header.record_count, header.symbol_count});
+    file_offset_ += sizeof(header) + pending_symbols_.size() + records_bytes(header);
+    records_written_ += records_.size();
+    records_.clear();
+    pending_symbols_.clear();
+    pending_symbol_count_ = 0;
+    return true;
+}
+
+size_t TickJournalWriter::encode_block() {
+    encoded_.clear();
+    encode_ticks(std::span<const JournalRecord>(records_), encoded_);
+    if (encoding_ == JournalEncoding::DELTA) {
+        return encoded_.size();
+    }
+
+    // DELTA_LZ: varint of the DELTA size, then the compressed stream
+    compressed_.clear();
+    put_varint(compressed_, encoded_.size());
+    size_t prefix = compressed_.size();
+    compressed_.resize(prefix + lz_compress_bound(encoded_.size()));
+    size_t bytes = lz_compress(encoded_.data(), encoded_.size(), compressed_.data() + prefix,
+                               compressed_.size() - prefix, level_);
+    compressed_.resize(prefix + bytes);
+    return compressed_.size();
+}
+
+bool TickJournalWriter::flush() {
+    return fd_ >= 0 && write_block();
+}
+
+bool TickJournalWriter::close() {
+    if (fd_ < 0) {
+        return true;
+    }
+
+    bool ok = write_block();
+    if (ok) {
+        Trailer trailer{};
+        trailer.index_offset = file_offset_;
+        trailer.block_count = index_.size();
+        std::memcpy(trailer.magic, TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+        iovec iov[2] = {
+            {index_.data(), index_.size() * sizeof(JournalIndexEntry)},
+            {&trailer, sizeof(trailer)},
+        };
+        ok = write_fully(fd_, iov, 2);
+    }
+    ::close(fd_);
+    fd_ = -1;
+    return ok;
+}
+
+// ============================================================================
+// TickJournalReader
+// ============================================================================
+
+TickJournalReader::TickJournalReader()
+    : data_(nullptr)
+    , size_(0)
+    , has_footer_(false)
+    , record_count_(0)
+    , decoded_block_(SIZE_MAX) {
+}
+
+TickJournalReader::~TickJournalReader() {
+    close();
+}
+
+bool TickJournalReader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "TickJournalReader: cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+        std::cerr << "TickJournalReader: " << path << " is not a tick journal" << std::endl;
+        ::close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "TickJournalReader: mmap failed for " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    const FileHeader* header = static_cast<const FileHeader*>(mapping);
+    if (std::memcmp(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        (header->version != FORMAT_VERSION && header->version != ENCODED_FORMAT_VERSION) ||
+        header->record_size != sizeof(JournalRecord)) {
+        std::cerr << "TickJournalReader: " << path << " is not a version " << FORMAT_VERSION << " or "
+                  << ENCODED_FORMAT_VERSION << " tick journal" << std::endl;
+        munmap(mapping, size);
+        return false;
+    }
+
+    data_ = static_cast<const char*>(mapping);
+    size_ = size;
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    has_footer_ = load_footer();
+    if (!has_footer_) {
+        scan_blocks();
+    }
+    record_count_ = 0;
+    for (const auto& entry : index_) {
+        record_count_ += entry.record_count;
+    }
+    load_symbols();
+    return true;
+}
+
+void TickJournalReader::close() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    has_footer_ = false;
+    record_count_ = 0;
+    index_.clear();
+    symbols_.clear();
+    instrument_ids_.clear();
+    decoded_.clear();
+    decoded_block_ = SIZE_MAX;
+}
+
+bool TickJournalReader::load_footer() {
+    if (size_ < sizeof(FileHeader) + sizeof(Trailer)) {
+        return false;
+    }
+    Trailer trailer;
+    std::memcpy(&trailer, data_ + size_ - sizeof(Trailer), sizeof(trailer));
+    if (std::memcmp(trailer.magic, TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0 ||
+        trailer.index_offset < sizeof(FileHeader) ||
+        trailer.block_count > (size_ - sizeof(Trailer) - trailer.index_offset) / sizeof(JournalIndexEntry) ||
+        trailer.index_offset + trailer.block_count * sizeof(JournalIndexEntry) + sizeof(Trailer) != size_) {
+        return false;
+    }
+    index_.resize(trailer.block_count);
+    std::memcpy(index_.data(), data_ + trailer.index_offset, trailer.block_count * sizeof(JournalIndexEntry));
+    return true;
+}
+
+void TickJournalReader::scan_blocks() {
+    // Unclosed journal: walk block headers, stop at the first torn one
+    uint64_t offset = sizeof(FileHeader);
+    while (offset + sizeof(BlockHeader) <= size_) {
+        BlockHeader header;
+        std::memcpy(&header, data_ + offset, sizeof(header));
+        uint64_t length = sizeof(header) + static_cast<uint64_t>(header.symbol_count) * sizeof(SymbolEntry) +
+                          records_bytes(header);
+        if (header.magic != BLOCK_MAGIC || length > size_ - offset) {
+            break;
+        }
+        index_.push_back({offset, header.first_timestamp, header.last_timestamp,
+                          header.record_count, header.symbol_count});
+        offset += length;
+    }
+}
+
+void TickJournalReader::load_symbols() {
+    for (const auto& entry : index_) {
+        const char* entries = data_ + entry.offset + sizeof(BlockHeader);
+        for (uint32_t i = 0; i < entry.symbol_count; ++i) {
+            const SymbolEntry* symbol = reinterpret_cast<const SymbolEntry*>(entries + i * sizeof(SymbolEntry));
+            if (symbol->file_symbol >= symbols_.size()) {
+                symbols_.resize(symbol->file_symbol + 1);
+            }
+            symbols_[symbol->file_symbol] =
+                std::string_view(symbol->name, std::min<size_t>(symbol->length, sizeof(symbol->name)));
+        }
+    }
+    instrument_ids_.assign(symbols_.size(), common::INVALID_INSTRUMENT);
+}
+
+std::span<const JournalRecord> TickJournalReader::records(size_t i) const {
+    const JournalIndexEntry& entry = index_[i];
+    const char* first = data_ + entry.offset + sizeof(BlockHeader) + entry.symbol_count * sizeof(SymbolEntry);
+    BlockHeader header;
+    std::memcpy(&header, data_ + entry.offset, sizeof(header));
+    if (header.encoding == static_cast<uint32_t>(JournalEncoding::RAW)) {
+        return {reinterpret_cast<const JournalRecord*>(first), entry.record_count};
+    }
+    if (decoded_block_ == i) {
+        return decoded_;
+    }
+
+    decoded_block_ = SIZE_MAX;
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(first);
+    const uint8_t* payload_end = payload + header.payload_bytes;
+    if (header.payload_bytes > static_cast<uint64_t>(data_ + size_ - first)) {
+        return {};
+    }
+    if (header.encoding == static_cast<uint32_t>(JournalEncoding::DELTA_LZ)) {
+        uint64_t raw_size;
+        // A DELTA row is at most ~40 bytes: bound the size before allocating
+        if (!get_varint(payload, payload_end, raw_size) || raw_size > (uint64_t(entry.record_count) + 1) * 48) {
+            return {};
+        }
+        decompressed_.resize(raw_size);
+        if (!lz_decompress(payload, static_cast<size_t>(payload_end - payload), decompressed_.data(), raw_size)) {
+            return {};
+        }
+        payload = decompressed_.data();
+        payload_end = payload + raw_size;
+    } else if (header.encoding != static_cast<uint32_t>(JournalEncoding::DELTA)) {
+        return {};
+    }
+    if (!decode_ticks(payload, static_cast<size_t>(payload_end - payload), decoded_) ||
+        decoded_.size() != entry.record_count) {
+        return {};
+    }
+    decoded_block_ = i;
+    return decoded_;
+}
+
+size_t TickJournalReader::find_block(uint64_t timestamp) const {
+    auto it = std::lower_bound(index_.begin(), index_.end(), timestamp,
+                               [](const JournalIndexEntry& entry, uint64_t ts) { return entry.last_timestamp < ts; });
+    return static_cast<size_t>(it - index_.begin());
+}
+
+std::string_view TickJournalReader::symbol(uint32_t file_symbol) const {
+    return file_symbol < symbols_.size() ? symbols_[file_symbol] : std::string_view();
+}
+
+size_t TickJournalReader::read(uint64_t from, uint64_t to, std::vector<common::CompactTick>& ticks) {
+    size_t before = ticks.size();
+    for (size_t b = find_block(from); b < index_.size() && index_[b].first_timestamp < to; ++b) {
+        for (const JournalRecord& record : records(b)) {
+            if (record.timestamp < from || record.timestamp >= to) {
+                continue;
+            }
+            common::CompactTick tick;
+            tick.price = record.price;
+            tick.timestamp = record.timestamp;
+            tick.qty = record.qty;
+            tick.side = record.side;
+            if (record.symbol < instrument_ids_.size()) {
+                common::InstrumentId& id = instrument_ids_[record.symbol];
+                if (id == common::INVALID_INSTRUMENT) {
+                    id = common::SymbolTable::global().intern(symbols_[record.symbol]);
+                }
+                tick.instrument_id = id;
+            }
+            ticks.push_back(tick);
+        }
+    }
+    return ticks.size() - before;
+}
+
+// ============================================================================
+// JournalRecorder
+// ============================================================================
+
+JournalRecorder::JournalRecorder(TickJournalWriter& writer, size_t queue_size)
+    : writer_(writer)
+    , queue_(queue_size, threading::WaitStrategy::FUTEX_PARK) {
+}
+
+JournalRecorder::~JournalRecorder() {
+    stop();
+}
+
+void JournalRecorder::start() {
+    if (thread_.joinable() || queue_.is_shutdown()) {
+        return;
+    }
+    thread_ = std::thread(&JournalRecorder::run, this);
+}
+
+void JournalRecorder::stop() {
+    queue_.shutdown();
+    if (thread_.joinable()) {
+        thread_.join();
+        writer_.flush();
+    }
+}
+
+void JournalRecorder::on_tick(const common::CompactTick& tick) {
+    if (!queue_.try_push(tick)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void JournalRecorder::on_ticks(std::span<const common::Tick> ticks) {
+    for (const auto& tick : ticks) {
+        on_tick(tick.to_compact());
+    }
+}
+
+void JournalRecorder::run() {
+    common::CompactTick tick;
+    while (queue_.pop(tick)) {
+        if (writer_.append(tick)) {
+            recorded_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace storage
+} // namespace feedhandler
@@ -0,0 +1,78 @@
+// Test program for the real-time analytics engine
+// Streams a random walk for a few symbols and prints their metrics
+
+#include "analytics/realtime_engine.hpp"
+#include "common/tick.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+
+int main() {
+    analytics::RealtimeEngine::Config config;
+    config.history_depth = 10000;
+    config.worker_threads = 2;
+    config.correlation_interval_ms = 1.0;
+    config.bars.interval_ns = 1000000;  // 1ms bars: the run only lasts a fraction of a second
+    analytics::RealtimeEngine engine(config);
+
+    // Callbacks run on the workers
+    std::atomic<size_t> alerts{0};
+    engine.register_alert_callback([&alerts](const std::string&, const std::string&, double) {
+        ++alerts;
+    });
+    std::atomic<size_t> bars{0};
+    engine.register_bar_callback([&bars](const analytics::Bar*, size_t count) {
+        bars += count;
+    });
+    engine.start();
+
+    const std::vector<std::string> symbols = {"AAPL", "MSFT", "GOOGL", "TSLA"};
+    std::vector<double> prices = {150.0, 300.0, 2800.0, 700.0};
+    std::mt19937 rng(42);
+    std::normal_distribution<double> noise(0.0, 0.0005);
+    std::normal_distribution<double> market(0.0, 0.0005);
+
+    constexpr int TICKS = 200000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < TICKS; ++i) {
+        double common_move = market(rng);
+        for (size_t s = 0; s < symbols.size(); ++s) {
+            prices[s] *= 1.0 + common_move + noise(rng);
+            common::Tick tick;
+            tick.price = common::double_to_price(prices[s]);
+            tick.qty = static_cast<int32_t>(1 + rng() % 500);
+            tick.side = rng() % 2 ? 'B' : 'S';
+            tick.timestamp = common::Tick::current_timestamp_ns();
+            engine.process_tick(symbols[s], tick);
+        }
+        if (i % 20000 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));  // Let the workers sample
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    engine.stop();
+
+    std::cout << "=== Real-time Analytics Engine ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(4);
+    for (const auto& symbol : symbols) {
+        auto m = engine.get_metrics(symbol);
+        std::cout << symbol << ": vwap " << m.vwap << " twap " << m.twap
+                  << " vol " << m.realized_volatility << " parkinson " << m.parkinson_volatility
+                  << " flow " << m.order_flow_imbalance << " beta " << m.beta_to_market << std::endl;
+    }
+
+    auto stats = engine.get_engine_stats();
+    std::cout << std::setprecision(1)
+              << "Ticks: " << stats.ticks_processed << " in " << seconds << " s ("
+              << static_cast<double>(stats.ticks_processed) / seconds << " ticks/s), average "
+              << stats.average_latency_ns << " ns per tick, " << alerts << " alerts, " << bars << " bars" << std::endl;
+    return 0;
+}
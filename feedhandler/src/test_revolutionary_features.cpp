@@ -19,7 +19,7 @@ void test_gpu_acceleration() {
     try {
         gpu::CUDAFixParser::Config config;
         config.max_messages_per_batch = 10000;
-        config.gpu_memory_pool_size = 512 * 1024 * 1024; // 512MB
+        config.max_batch_bytes = 2 * 1024 * 1024; // 2MB per stream
         
         gpu::CUDAFixParser parser(config);
         
@@ -0,0 +1,197 @@
+#include "threading/parallel_buffer_parser.hpp"
+#include "parser/fix_framer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <thread>
+
+namespace feedhandler {
+namespace threading {
+
+namespace {
+
+/**
+ * @brief Per-thread run of chunk indices [begin, end) packed in one word
+ *
+ * The owner pops from begin, thieves cut from end; both sides CAS the
+ * whole word, so a chunk is handed out exactly once.
+ */
+struct alignas(64) WorkRange {
+    std::atomic<uint64_t> bounds{0};
+
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(begin) << 32) | end;
+    }
+    static uint32_t begin_of(uint64_t bounds) { return static_cast<uint32_t>(bounds >> 32); }
+    static uint32_t end_of(uint64_t bounds) { return static_cast<uint32_t>(bounds); }
+
+    bool pop(uint32_t& index) {
+        uint64_t current = bounds.load(std::memory_order_acquire);
+        while (begin_of(current) < end_of(current)) {
+            if (bounds.compare_exchange_weak(current, pack(begin_of(current) + 1, end_of(current)),
+                                             std::memory_order_acq_rel)) {
+                index = begin_of(current);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Take the back half (rounded up) of this run
+    bool steal(uint32_t& begin, uint32_t& end) {
+        uint64_t current = bounds.load(std::memory_order_acquire);
+        while (begin_of(current) < end_of(current)) {
+            uint32_t available = end_of(current) - begin_of(current);
+            uint32_t split = end_of(current) - (available + 1) / 2;
+            if (bounds.compare_exchange_weak(current, pack(begin_of(current), split),
+                                             std::memory_order_acq_rel)) {
+                begin = split;
+                end = end_of(current);
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+ParallelBufferParser::ParallelBufferParser()
+    : ParallelBufferParser(Config()) {
+}
+
+ParallelBufferParser::ParallelBufferParser(const Config& config)
+    : config_(config) {
+    if (config_.thread_count == 0) {
+        config_.thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (config_.chunk_size == 0) {
+        config_.chunk_size = Config().chunk_size;
+    }
+}
+
+std::vector<std::string_view> ParallelBufferParser::split_chunks(std::string_view buffer, size_t chunk_size) {
+    std::vector<std::string_view> chunks;
+    size_t start = 0;
+
+    while (start < buffer.size()) {
+        size_t cut = buffer.size();
+        size_t search = start + std::max<size_t>(chunk_size, 1);
+        while (search < buffer.size()) {
+            size_t pos = search + parser::FixFramer::find_message_start(buffer.data() + search,
+                                                                        buffer.size() - search);
+            if (pos >= buffer.size()) {
+                break;
+            }
+            if (buffer[pos - 1] == '\n') {
+                cut = pos;  // Message start at the beginning of a line
+                break;
+            }
+            search = pos + 1;
+        }
+        chunks.push_back(buffer.substr(start, cut - start));
+        start = cut;
+    }
+
+    return chunks;
+}
+
+template<typename ParseChunk>
+void ParallelBufferParser::run(size_t chunk_count, ParseChunk&& parse_chunk) {
+    size_t thread_count = std::min(config_.thread_count, chunk_count);
+    stats_.chunks = chunk_count;
+    stats_.threads = thread_count;
+    stats_.steals = 0;
+    if (thread_count <= 1) {
+        for (size_t i = 0; i < chunk_count; ++i) {
+            parse_chunk(i);
+        }
+        return;
+    }
+
+    // Contiguous initial runs keep neighbouring chunks on one thread
+    std::unique_ptr<WorkRange[]> ranges(new WorkRange[thread_count]);
+    for (size_t t = 0; t < thread_count; ++t) {
+        ranges[t].bounds.store(WorkRange::pack(static_cast<uint32_t>(t * chunk_count / thread_count),
+                                               static_cast<uint32_t>((t + 1) * chunk_count / thread_count)),
+                               std::memory_order_relaxed);
+    }
+    std::atomic<uint64_t> steals{0};
+
+    auto worker = [&](size_t self) {
+        uint32_t index;
+        while (true) {
+            while (ranges[self].pop(index)) {
+                parse_chunk(index);
+            }
+
+            // Own run is empty: only this thread refills it
+            bool stolen = false;
+            for (size_t offset = 1; offset < thread_count && !stolen; ++offset) {
+                uint32_t begin;
+                uint32_t end;
+                if (ranges[(self + offset) % thread_count].steal(begin, end)) {
+                    ranges[self].bounds.store(WorkRange::pack(begin, end), std::memory_order_release);
+                    steals.fetch_add(1, std::memory_order_relaxed);
+                    stolen = true;
+                }
+            }
+            if (!stolen) {
+                return;  // Nothing left anywhere
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t t = 1; t < thread_count; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    stats_.steals = steals.load(std::memory_order_relaxed);
+}
+
+std::vector<common::Tick> ParallelBufferParser::parse(std::string_view buffer, TickParseFn parse) {
+    std::vector<std::string_view> chunks = split_chunks(buffer, config_.chunk_size);
+    std::vector<std::vector<common::Tick>> results(chunks.size());
+
+    run(chunks.size(), [&](size_t i) { results[i] = parse(chunks[i]); });
+
+    size_t total = 0;
+    for (const auto& result : results) {
+        total += result.size();
+    }
+    std::vector<common::Tick> ticks;
+    ticks.reserve(total);
+    for (auto& result : results) {
+        std::move(result.begin(), result.end(), std::back_inserter(ticks));
+    }
+    return ticks;
+}
+
+size_t ParallelBufferParser::parse(std::string_view buffer, CompactParseFn parse,
+                                   std::vector<common::CompactTick>& ticks) {
+    std::vector<std::string_view> chunks = split_chunks(buffer, config_.chunk_size);
+    std::vector<std::vector<common::CompactTick>> results(chunks.size());
+
+    run(chunks.size(), [&](size_t i) { parse(chunks[i], results[i]); });
+
+    size_t before = ticks.size();
+    size_t total = 0;
+    for (const auto& result : results) {
+        total += result.size();
+    }
+    ticks.reserve(before + total);
+    for (const auto& result : results) {
+        ticks.insert(ticks.end(), result.begin(), result.end());
+    }
+    return ticks.size() - before;
+}
+
+} // namespace threading
+} // namespace feedhandler
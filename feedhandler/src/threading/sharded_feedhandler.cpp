@@ -0,0 +1,104 @@
+#include "threading/sharded_feedhandler.hpp"
+
+namespace feedhandler {
+namespace threading {
+
+ShardedFeedHandler::ShardedFeedHandler(const Config& config, ShardTickCallback callback)
+    : ShardedFeedHandler(config, callback
+          ? ShardBatchCallback([callback](size_t shard, std::span<const common::Tick> ticks) {
+                for (const auto& tick : ticks) {
+                    callback(shard, tick);
+                }
+            })
+          : ShardBatchCallback()) {}
+
+ShardedFeedHandler::ShardedFeedHandler(const Config& config, ShardBatchCallback callback)
+    : config_(config) {
+
+    if (config_.shard_count == 0) {
+        config_.shard_count = 1;
+    }
+
+    shards_.reserve(config_.shard_count);
+    for (size_t i = 0; i < config_.shard_count; ++i) {
+        ThreadedFeedHandler::Config shard_config = config_.shard;
+        shard_config.parser_cpu = parser_cpu(i);
+        shard_config.network_cpu = network_cpu(i);
+
+        // One indirect call per parsed buffer, not per tick
+        ThreadedFeedHandler::BatchCallback batch;
+        if (callback) {
+            batch = [callback, i](std::span<const common::Tick> ticks) {
+                callback(i, ticks);
+            };
+        }
+        shards_.push_back(std::make_unique<ThreadedFeedHandler>(shard_config, std::move(batch)));
+    }
+}
+
+void ShardedFeedHandler::start() {
+    for (auto& shard : shards_) {
+        shard->start();
+    }
+}
+
+void ShardedFeedHandler::stop() {
+    for (auto& shard : shards_) {
+        shard->stop();
+    }
+}
+
+size_t ShardedFeedHandler::shard_for(std::string_view symbol) const {
+    // FNV-1a: stable across runs, so a symbol's shard never moves
+    uint64_t h = 14695981039346656037ULL;
+    for (char c : symbol) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(h % shards_.size());
+}
+
+void ShardedFeedHandler::inject_data(size_t shard, const char* data, size_t length) {
+    if (shard >= shards_.size()) {
+        return;
+    }
+    shards_[shard]->inject_data(data, length);
+}
+
+ShardedFeedHandler::StatisticsSnapshot ShardedFeedHandler::get_statistics() const {
+    StatisticsSnapshot totals;
+    for (const auto& shard : shards_) {
+        const auto& stats = shard->get_statistics();
+        totals.bytes_received += stats.bytes_received.load();
+        totals.messages_parsed += stats.messages_parsed.load();
+        totals.parse_errors += stats.parse_errors.load();
+        totals.queue_overflows += stats.queue_overflows.load();
+        totals.network_reads += stats.network_reads.load();
+        totals.parser_cycles += stats.parser_cycles.load();
+    }
+    return totals;
+}
+
+void ShardedFeedHandler::reset_statistics() {
+    for (auto& shard : shards_) {
+        shard->reset_statistics();
+    }
+}
+
+int ShardedFeedHandler::parser_cpu(size_t index) const {
+    return cpu_for(config_.cpu.parser_thread_affinity, index);
+}
+
+int ShardedFeedHandler::network_cpu(size_t index) const {
+    return cpu_for(config_.cpu.network_thread_affinity, index);
+}
+
+int ShardedFeedHandler::cpu_for(const std::vector<int>& cpus, size_t index) {
+    if (cpus.empty()) {
+        return -1;
+    }
+    return cpus[index % cpus.size()];
+}
+
+} // namespace threading
+} // namespace feedhandler
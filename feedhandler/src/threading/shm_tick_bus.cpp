@@ -0,0 +1,180 @@
+#include "threading/shm_tick_bus.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+
+namespace feedhandler {
+namespace threading {
+
+namespace {
+
+size_t round_up_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+size_t slots_offset(size_t symbol_slots) {
+    size_t directory_end = detail::TICK_BUS_CONTROL_BYTES + symbol_slots * sizeof(detail::TickBusSymbol);
+    return (directory_end + 63) & ~size_t{63};
+}
+
+} // namespace
+
+ShmTickBusWriter::~ShmTickBusWriter() {
+    close();
+}
+
+bool ShmTickBusWriter::open(const std::string& name, size_t capacity, size_t symbol_slots) {
+    close();
+    capacity = round_up_pow2(std::max<size_t>(capacity, 64));
+
+    // A fresh segment every time: readers still mapping an old one see
+    // it closed and reattach, instead of reading a reset ring
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        std::cerr << "shm_open " << name << " failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    size_t bytes = slots_offset(symbol_slots) + capacity * sizeof(detail::TickBusSlot);
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        std::cerr << "ftruncate " << name << " failed: " << strerror(errno) << std::endl;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    // Populated up front so the first lap takes no page faults
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "mmap " << name << " failed: " << strerror(errno) << std::endl;
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // ftruncate zero-fills: every slot sequence and symbol length starts at 0
+    auto* base = static_cast<uint8_t*>(mapping);
+    control_ = reinterpret_cast<detail::TickBusControl*>(base);
+    symbols_ = reinterpret_cast<detail::TickBusSymbol*>(base + detail::TICK_BUS_CONTROL_BYTES);
+    slots_ = reinterpret_cast<detail::TickBusSlot*>(base + slots_offset(symbol_slots));
+    capacity_ = capacity;
+    mask_ = capacity - 1;
+    symbol_slots_ = symbol_slots;
+    mapped_bytes_ = bytes;
+    head_ = 0;
+    named_.assign(symbol_slots, false);
+
+    control_->magic = detail::TICK_BUS_MAGIC;
+    control_->version = detail::TICK_BUS_VERSION;
+    control_->capacity = capacity;
+    control_->symbol_slots = symbol_slots;
+    control_->writer_pid = static_cast<int64_t>(getpid());
+    control_->head.store(0, std::memory_order_relaxed);
+    control_->state.store(1, std::memory_order_release);
+    return true;
+}
+
+void ShmTickBusWriter::close() {
+    if (control_ != nullptr) {
+        control_->state.store(2, std::memory_order_release);
+        munmap(control_, mapped_bytes_);
+        control_ = nullptr;
+        symbols_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+        mask_ = 0;
+        symbol_slots_ = 0;
+        mapped_bytes_ = 0;
+    }
+}
+
+void ShmTickBusWriter::unlink(const std::string& name) {
+    shm_unlink(name.c_str());
+}
+
+void ShmTickBusWriter::publish_symbol(common::InstrumentId id) {
+    std::string_view name = common::SymbolTable::global().name(id);
+    if (name.empty()) {
+        return;  // Not interned here; nothing to tell readers
+    }
+    detail::TickBusSymbol& entry = symbols_[id];
+    size_t length = std::min(name.size(), sizeof(entry.name) - 1);
+    std::memcpy(entry.name, name.data(), length);
+    entry.length.store(length, std::memory_order_release);
+    named_[id] = true;
+}
+
+ShmTickBusReader::~ShmTickBusReader() {
+    close();
+}
+
+bool ShmTickBusReader::open(const std::string& name, bool from_oldest) {
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;  // No writer yet; the caller retries
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < detail::TICK_BUS_CONTROL_BYTES) {
+        ::close(fd);
+        return false;
+    }
+    size_t bytes = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, bytes, PROT_READ, MAP_SHARED | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "mmap " << name << " failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    auto* base = static_cast<const uint8_t*>(mapping);
+    auto* control = reinterpret_cast<const detail::TickBusControl*>(base);
+    if (control->state.load(std::memory_order_acquire) != 1 || control->magic != detail::TICK_BUS_MAGIC ||
+        control->version != detail::TICK_BUS_VERSION ||
+        slots_offset(control->symbol_slots) + control->capacity * sizeof(detail::TickBusSlot) > bytes) {
+        munmap(mapping, bytes);
+        return false;  // Still being set up, closed, or not a tick bus
+    }
+
+    control_ = control;
+    capacity_ = static_cast<size_t>(control->capacity);
+    mask_ = capacity_ - 1;
+    symbol_slots_ = static_cast<size_t>(control->symbol_slots);
+    symbols_ = reinterpret_cast<const detail::TickBusSymbol*>(base + detail::TICK_BUS_CONTROL_BYTES);
+    slots_ = reinterpret_cast<const detail::TickBusSlot*>(base + slots_offset(symbol_slots_));
+    mapped_bytes_ = bytes;
+
+    cached_head_ = control_->head.load(std::memory_order_acquire);
+    cursor_ = cached_head_;
+    if (from_oldest) {
+        cursor_ = cached_head_ > capacity_ ? cached_head_ - capacity_ + 1 : 0;
+    }
+    overruns_ = 0;
+    lost_ = 0;
+    return true;
+}
+
+void ShmTickBusReader::close() {
+    if (control_ != nullptr) {
+        munmap(const_cast<detail::TickBusControl*>(control_), mapped_bytes_);
+        control_ = nullptr;
+        symbols_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+        mask_ = 0;
+        symbol_slots_ = 0;
+        mapped_bytes_ = 0;
+    }
+}
+
+} // namespace threading
+} // namespace feedhandler
@@ -1,19 +1,100 @@
 #include "threading/threaded_feedhandler.hpp"
+#include "benchmarks/stage_profiler.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <cstring>
 #include <thread>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace feedhandler {
 namespace threading {
 
+namespace {
+
+benchmarks::StageProfiler::Sample begin_stage(benchmarks::StageProfiler* profiler) {
+    return profiler ? profiler->begin() : benchmarks::StageProfiler::Sample{};
+}
+
+void end_stage(benchmarks::StageProfiler* profiler, size_t stage, const benchmarks::StageProfiler::Sample& sample) {
+    if (profiler) {
+        profiler->end(stage, sample);
+    }
+}
+
+} // namespace
+
+bool parse_overflow_policy(std::string_view name, OverflowPolicy& policy) {
+    if (name == "block") {
+        policy = OverflowPolicy::BLOCK;
+    } else if (name == "drop_newest") {
+        policy = OverflowPolicy::DROP_NEWEST;
+    } else if (name == "drop_oldest") {
+        policy = OverflowPolicy::DROP_OLDEST;
+    } else if (name == "conflate") {
+        policy = OverflowPolicy::CONFLATE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+ThreadedFeedHandler::Config ThreadedFeedHandler::Config::from_queue(const config::PerformanceConfig::QueueConfig& queue) {
+    Config config;
+    config.queue_size = queue.ring_buffer_size;
+    config.overflow_policy = queue.enable_backpressure ? OverflowPolicy::BLOCK : OverflowPolicy::DROP_NEWEST;
+    config.delivery_batch = queue.enable_batching ? std::max<size_t>(queue.batch_size, 1) : 1;
+    if (!queue.overflow_policy.empty() && !parse_overflow_policy(queue.overflow_policy, config.overflow_policy)) {
+        std::cerr << "[ThreadedFeedHandler] Unknown overflow policy '" << queue.overflow_policy
+                  << "', using " << (queue.enable_backpressure ? "block" : "drop_newest") << std::endl;
+    }
+    return config;
+}
+
 ThreadedFeedHandler::ThreadedFeedHandler(const Config& config, TickCallback callback)
     : config_(config)
     , tick_callback_(std::move(callback))
     , running_(false)
-    , buffer_queue_(config.queue_size) {
+    , buffer_queue_(config.queue_size, config.wait_strategy, config.spin_limit) {
+    
+    parser_.set_garbage_recovery(config.enable_garbage_recovery);
+    if (config.simd_parsing) {
+        simd_parser_ = std::make_unique<parser::SIMDFixParser>(config.simd_level);
+    }
+    register_stages();
+    set_high_mark();
+}
+
+ThreadedFeedHandler::ThreadedFeedHandler(const Config& config, BatchCallback callback)
+    : config_(config)
+    , batch_callback_(std::move(callback))
+    , running_(false)
+    , buffer_queue_(config.queue_size, config.wait_strategy, config.spin_limit) {
     
     parser_.set_garbage_recovery(config.enable_garbage_recovery);
+    if (config.simd_parsing) {
+        simd_parser_ = std::make_unique<parser::SIMDFixParser>(config.simd_level);
+    }
+    register_stages();
+    set_high_mark();
+}
+
+ThreadedFeedHandler::ThreadedFeedHandler(const Config& config, SegmentCallback callback)
+    : config_(config)
+    , segment_callback_(std::move(callback))
+    , running_(false)
+    , segments_(std::make_unique<common::SegmentPool>(
+          config.segment_count, config.buffer_size, ticks_per_segment(config.buffer_size)))
+    , buffer_queue_(config.queue_size, config.wait_strategy, config.spin_limit) {
+    
+    parser_.set_garbage_recovery(config.enable_garbage_recovery);
+    register_stages();
+    set_high_mark();
 }
 
 ThreadedFeedHandler::~ThreadedFeedHandler() {
@@ -33,6 +114,17 @@ void ThreadedFeedHandler::start() {
     // Start network thread
     network_thread_ = std::make_unique<std::thread>(&ThreadedFeedHandler::network_thread_func, this);
     
+    parser_pinned_ = pin_thread(*parser_thread_, config_.parser_cpu) && config_.parser_cpu >= 0;
+    if (!parser_pinned_ && config_.parser_cpu >= 0) {
+        std::cerr << "[ThreadedFeedHandler] Failed to pin parser thread to CPU "
+                  << config_.parser_cpu << std::endl;
+    }
+    network_pinned_ = pin_thread(*network_thread_, config_.network_cpu) && config_.network_cpu >= 0;
+    if (!network_pinned_ && config_.network_cpu >= 0) {
+        std::cerr << "[ThreadedFeedHandler] Failed to pin network thread to CPU "
+                  << config_.network_cpu << std::endl;
+    }
+    
     std::cout << "[ThreadedFeedHandler] Started network and parser threads" << std::endl;
 }
 
@@ -58,32 +150,159 @@ void ThreadedFeedHandler::stop() {
     std::cout << "[ThreadedFeedHandler] Threads stopped" << std::endl;
 }
 
-void ThreadedFeedHandler::inject_data(const char* data, size_t length) {
+void ThreadedFeedHandler::inject_data(const char* data, size_t length, uint64_t timestamp_ns) {
     if (!running_.load()) {
         return;
     }
     
+    if (segments_) {
+        // Zero-copy mode: one segment per buffer_size chunk
+        size_t offset = 0;
+        while (offset < length) {
+            common::SegmentRef segment = segments_->acquire();
+            if (!segment) {
+                stats_.segment_exhaustions.add();
+                gap_pending_ = true;
+                break;
+            }
+            size_t chunk = std::min(length - offset, segment.capacity());
+            std::memcpy(segment.data(), data + offset, chunk);
+            segment.set_length(chunk);
+            submit_segment(std::move(segment), timestamp_ns);
+            offset += chunk;
+        }
+        return;
+    }
+    
     // Create buffer and push to queue
     MessageBuffer buffer(data, length);
+    buffer.enqueued_at = latency_stamp();
+    buffer.received_at = timestamp_ns;
+    enqueue(std::move(buffer));
     
-    if (!buffer_queue_.try_push(std::move(buffer))) {
-        stats_.queue_overflows.fetch_add(1);
+    stats_.bytes_received.add(length);
+}
+
+common::SegmentRef ThreadedFeedHandler::acquire_segment() {
+    if (!segments_) {
+        return common::SegmentRef();
     }
+    common::SegmentRef segment = segments_->acquire();
+    if (!segment) {
+        stats_.segment_exhaustions.add();
+        gap_pending_ = true;  // Whatever was to be read into it is lost
+    }
+    return segment;
+}
+
+void ThreadedFeedHandler::submit_segment(common::SegmentRef segment, uint64_t timestamp_ns) {
+    if (!running_.load() || !segment) {
+        return;
+    }
+    
+    size_t length = segment.length();
+    MessageBuffer buffer;
+    buffer.length = length;
+    buffer.segment = std::move(segment);
+    buffer.enqueued_at = latency_stamp();
+    buffer.received_at = timestamp_ns;
+    enqueue(std::move(buffer));  // On overflow the segment is dropped here and recycled
     
-    stats_.bytes_received.fetch_add(length);
+    stats_.bytes_received.add(length);
+}
+
+void ThreadedFeedHandler::enqueue(MessageBuffer&& buffer) {
+    buffer.after_gap = gap_pending_;
+    buffer.sequence = ++next_sequence_;
+    common::TraceScope scope(trace_inject_, buffer.sequence);
+    if (buffer_queue_.try_push(std::move(buffer))) {
+        gap_pending_ = false;
+        return;
+    }
+    
+    if (config_.overflow_policy == OverflowPolicy::BLOCK) {
+        stats_.backpressure_waits.add();
+        while (running_.load(std::memory_order_relaxed)) {
+            if (buffer_queue_.try_push(std::move(buffer))) {
+                gap_pending_ = false;
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+    
+    stats_.queue_overflows.add();
+    gap_pending_ = true;
+}
+
+size_t ThreadedFeedHandler::ticks_per_segment(size_t segment_bytes) {
+    // Shortest message that yields a tick ("55=A|44=1|38=1|54=1\n") is
+    // 20 bytes; one more for a message carried in from the previous segment
+    constexpr size_t MIN_TICK_MESSAGE_BYTES = 16;
+    return segment_bytes / MIN_TICK_MESSAGE_BYTES + 1;
 }
 
 void ThreadedFeedHandler::reset_statistics() {
-    stats_.bytes_received.store(0);
-    stats_.messages_parsed.store(0);
-    stats_.parse_errors.store(0);
-    stats_.queue_overflows.store(0);
-    stats_.network_reads.store(0);
-    stats_.parser_cycles.store(0);
+    stats_.bytes_received.reset();
+    stats_.messages_parsed.reset();
+    stats_.parse_errors.reset();
+    stats_.queue_overflows.reset();
+    stats_.network_reads.reset();
+    stats_.parser_cycles.reset();
+    stats_.segment_exhaustions.reset();
+    stats_.backpressure_waits.reset();
+    stats_.buffers_shed.reset();
+    stats_.ticks_conflated.reset();
+    stats_.queue_latency.reset();
+    stats_.parse_latency.reset();
+}
+
+void ThreadedFeedHandler::set_high_mark() {
+    double fraction = std::clamp(config_.high_watermark, 0.0, 1.0);
+    size_t capacity = buffer_queue_.capacity();
+    high_mark_ = std::clamp<size_t>(static_cast<size_t>(static_cast<double>(capacity) * fraction), 1, capacity);
+}
+
+void ThreadedFeedHandler::register_stages() {
+    if (config_.stage_profiler) {
+        parse_stage_ = config_.stage_profiler->add_stage("parse");
+        deliver_stage_ = config_.stage_profiler->add_stage("deliver");
+    }
+    common::Tracer& tracer = common::Tracer::global();
+    trace_inject_ = tracer.add_stage("feed.inject");
+    trace_parse_ = tracer.add_stage("feed.parse");
+    trace_deliver_ = tracer.add_stage("feed.deliver");
+}
+
+void ThreadedFeedHandler::record_since(common::AtomicLatencyHistogram& histogram, uint64_t start, uint64_t now) {
+    if (start != 0 && now > start) {
+        histogram.record(common::TscClock::global().ticks_to_ns(now - start));
+    }
+}
+
+bool ThreadedFeedHandler::pin_thread(std::thread& thread, int cpu) {
+    if (cpu < 0) {
+        return true;
+    }
+#ifdef __linux__
+    if (cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)thread;
+    return false;
+#endif
 }
 
 void ThreadedFeedHandler::network_thread_func() {
     std::cout << "[NetworkThread] Started" << std::endl;
+    if (common::Tracer::global().enabled()) {
+        common::Tracer::global().register_thread("network");
+    }
     
     // In a real implementation, this would:
     // 1. Read from socket using recv()
@@ -95,7 +314,7 @@ void ThreadedFeedHandler::network_thread_func() {
     // The inject_data() method simulates network reads
     
     while (running_.load()) {
-        stats_.network_reads.fetch_add(1);
+        stats_.network_reads.add();
         
         // Simulate network polling delay
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
@@ -106,43 +325,193 @@ void ThreadedFeedHandler::network_thread_func() {
 
 void ThreadedFeedHandler::parser_thread_func() {
     std::cout << "[ParserThread] Started" << std::endl;
+    if (common::Tracer::global().enabled()) {
+        common::Tracer::global().register_thread("parser");
+    }
     
     std::vector<common::Tick> ticks;
     ticks.reserve(100);  // Preallocate for batch processing
+    MessageBuffer buffer;
+    bool coalesce = config_.overflow_policy == OverflowPolicy::CONFLATE && !segments_;
+    bool shed = config_.overflow_policy == OverflowPolicy::DROP_OLDEST ||
+                (config_.overflow_policy == OverflowPolicy::CONFLATE && segments_);
     
     while (running_.load() || !buffer_queue_.empty()) {
-        stats_.parser_cycles.fetch_add(1);
+        stats_.parser_cycles.add();
         
-        // Pop buffer from queue (blocking)
-        auto buffer_opt = buffer_queue_.pop();
-        
-        if (!buffer_opt.has_value()) {
-            // Queue shutdown
+        // Pop buffer from ring (waits per Config::wait_strategy)
+        if (!buffer_queue_.pop(buffer)) {
+            // Ring shutdown and drained
             break;
         }
+        if (shed) {
+            shed_backlog(buffer);
+        }
+        record_since(stats_.queue_latency, buffer.enqueued_at, latency_stamp());
         
-        MessageBuffer& buffer = buffer_opt.value();
+        if (buffer.segment) {
+            if (buffer.after_gap) {
+                parser_.reset();
+            }
+            parser_.set_receive_timestamp(buffer.received_at);
+            parsed_sequence_ = buffer.sequence;
+            parse_segment(buffer.segment);
+            buffer.segment.reset();  // Consumers' copies keep it alive
+            continue;
+        }
         
-        // Parse buffer
         ticks.clear();
-        size_t consumed = parser_.parse(buffer.data.data(), buffer.length, ticks);
+        parse_buffer(buffer, ticks);
         
-        // Invoke callback for each parsed tick
-        for (const auto& tick : ticks) {
-            if (tick_callback_) {
-                tick_callback_(tick);
-            }
-            stats_.messages_parsed.fetch_add(1);
+        // Fold buffers that are already queued into the same callback
+        for (size_t batched = 1; batched < config_.delivery_batch && buffer_queue_.try_pop(buffer); ++batched) {
+            record_since(stats_.queue_latency, buffer.enqueued_at, latency_stamp());
+            parse_buffer(buffer, ticks);
         }
         
-        // Check for parse errors (if consumed < length, might be incomplete message)
-        if (consumed < buffer.length && ticks.empty()) {
-            stats_.parse_errors.fetch_add(1);
+        // Behind: parse everything queued now and deliver it conflated
+        if (coalesce && buffer_queue_.size() >= high_mark_) {
+            for (size_t backlog = buffer_queue_.size(); backlog > 0 && buffer_queue_.try_pop(buffer); --backlog) {
+                record_since(stats_.queue_latency, buffer.enqueued_at, latency_stamp());
+                parse_buffer(buffer, ticks);
+            }
+            stats_.ticks_conflated.add(conflate(ticks));
         }
+        
+        deliver(ticks);
     }
     
     std::cout << "[ParserThread] Stopped" << std::endl;
 }
 
+void ThreadedFeedHandler::parse_buffer(const MessageBuffer& buffer, std::vector<common::Tick>& ticks) {
+    if (buffer.after_gap) {
+        // Don't splice a partial message across the dropped bytes
+        simd_parser_ ? simd_parser_->reset() : parser_.reset();
+    }
+    parser_.set_receive_timestamp(buffer.received_at);
+    parsed_sequence_ = buffer.sequence;
+    common::TraceScope scope(trace_parse_, buffer.sequence);
+    
+    size_t before = ticks.size();
+    uint64_t parse_start = latency_stamp();
+    auto sample = begin_stage(config_.stage_profiler);
+    size_t consumed = 0;
+    if (simd_parser_) {
+        consumed = simd_parser_->parse(buffer.data.data(), buffer.length, ticks);
+        if (buffer.received_at != 0) {
+            for (size_t i = before; i < ticks.size(); ++i) {
+                ticks[i].timestamp = buffer.received_at;  // As FSMFixParser::set_receive_timestamp
+            }
+        }
+    } else {
+        consumed = parser_.parse(buffer.data.data(), buffer.length, ticks);
+    }
+    end_stage(config_.stage_profiler, parse_stage_, sample);
+    record_since(stats_.parse_latency, parse_start, latency_stamp());
+    stats_.messages_parsed.add(ticks.size() - before);
+    
+    // Check for parse errors (if consumed < length, might be incomplete message)
+    if (consumed < buffer.length && ticks.size() == before) {
+        stats_.parse_errors.add();
+    }
+}
+
+void ThreadedFeedHandler::deliver(const std::vector<common::Tick>& ticks) {
+    // Hand the whole batch over in one call, or fall back to per-tick
+    common::TraceScope scope(trace_deliver_, parsed_sequence_);
+    auto sample = begin_stage(config_.stage_profiler);
+    if (batch_callback_) {
+        if (!ticks.empty()) {
+            batch_callback_(std::span<const common::Tick>(ticks.data(), ticks.size()));
+        }
+    } else if (tick_callback_) {
+        for (const auto& tick : ticks) {
+            tick_callback_(tick);
+        }
+    }
+    end_stage(config_.stage_profiler, deliver_stage_, sample);
+}
+
+void ThreadedFeedHandler::shed_backlog(MessageBuffer& buffer) {
+    bool shed = false;
+    while (buffer_queue_.size() >= high_mark_) {
+        buffer.segment.reset();  // Recycle before taking the next
+        if (!buffer_queue_.try_pop(buffer)) {
+            break;
+        }
+        stats_.buffers_shed.add();
+        shed = true;
+    }
+    if (shed) {
+        buffer.after_gap = true;
+    }
+}
+
+size_t ThreadedFeedHandler::conflate(std::vector<common::Tick>& ticks) {
+    // Slot per (instrument, side) holding the index of its last tick
+    constexpr uint32_t NONE = UINT32_MAX;
+    auto key = [](const common::Tick& tick) {
+        return static_cast<size_t>(tick.instrument_id) * 2 + (tick.side == 'S' ? 1 : 0);
+    };
+    
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        if (ticks[i].instrument_id == common::INVALID_INSTRUMENT) {
+            continue;  // Can't be keyed: always delivered
+        }
+        size_t slot = key(ticks[i]);
+        if (slot >= conflate_last_.size()) {
+            conflate_last_.resize(slot + 1, NONE);
+        }
+        conflate_last_[slot] = static_cast<uint32_t>(i);
+    }
+    
+    // Keep each key's last tick in place; clear its slot once passed
+    size_t kept = 0;
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        if (ticks[i].instrument_id != common::INVALID_INSTRUMENT) {
+            uint32_t& last = conflate_last_[key(ticks[i])];
+            if (last != i) {
+                continue;
+            }
+            last = NONE;
+        }
+        if (kept != i) {
+            ticks[kept] = ticks[i];
+        }
+        ++kept;
+    }
+    
+    size_t removed = ticks.size() - kept;
+    ticks.resize(kept);
+    return removed;
+}
+
+void ThreadedFeedHandler::parse_segment(common::SegmentRef& segment) {
+    common::TickSpan<common::FlyweightTick> ticks(segment.tick_storage(), segment.tick_capacity());
+    uint64_t parse_start = latency_stamp();
+    auto sample = begin_stage(config_.stage_profiler);
+    size_t consumed = 0;
+    {
+        common::TraceScope scope(trace_parse_, parsed_sequence_);
+        consumed = parser_.parse(segment.data(), segment.length(), ticks);
+    }
+    end_stage(config_.stage_profiler, parse_stage_, sample);
+    record_since(stats_.parse_latency, parse_start, latency_stamp());
+    segment.set_tick_count(ticks.size());
+    
+    if (segment_callback_ && !ticks.empty()) {
+        common::TraceScope scope(trace_deliver_, parsed_sequence_);
+        sample = begin_stage(config_.stage_profiler);
+        segment_callback_(segment);
+        end_stage(config_.stage_profiler, deliver_stage_, sample);
+    }
+    stats_.messages_parsed.add(ticks.size());
+    
+    if (consumed < segment.length() && ticks.empty()) {
+        stats_.parse_errors.add();
+    }
+}
+
 } // namespace threading
 } // namespace feedhandler
@@ -1,4 +1,5 @@
 #include "threading/ultra_low_latency_queue.hpp"
+#include "common/tick.hpp"
 #include <new>
 
 namespace feedhandler {
@@ -6,7 +7,7 @@ namespace threading {
 
 template<typename T, size_t Size>
 UltraLowLatencyQueue<T, Size>::UltraLowLatencyQueue() 
-    : head_(0), tail_(0) {
+    : head_(0), cached_tail_(0), tail_(0), cached_head_(0) {
     // Initialize data array
     for (size_t i = 0; i < Size; ++i) {
         new (&data_[i]) T();
@@ -18,9 +19,12 @@ bool UltraLowLatencyQueue<T, Size>::enqueue(const T& item) noexcept {
     const size_t current_tail = tail_.load(std::memory_order_relaxed);
     const size_t next_tail = (current_tail + 1) & MASK;
     
-    // Check if queue is full
-    if (next_tail == head_.load(std::memory_order_acquire)) {
-        return false;
+    // Check if queue is full, refreshing the cached head only when needed
+    if (next_tail == cached_head_) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (next_tail == cached_head_) {
+            return false;
+        }
     }
     
     // Prefetch next cache line for better performance
@@ -39,9 +43,12 @@ template<typename T, size_t Size>
 bool UltraLowLatencyQueue<T, Size>::dequeue(T& item) noexcept {
     const size_t current_head = head_.load(std::memory_order_relaxed);
     
-    // Check if queue is empty
-    if (current_head == tail_.load(std::memory_order_acquire)) {
-        return false;
+    // Check if queue is empty, refreshing the cached tail only when needed
+    if (current_head == cached_tail_) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (current_head == cached_tail_) {
+            return false;
+        }
     }
     
     // Prefetch next cache line
@@ -56,6 +63,73 @@ bool UltraLowLatencyQueue<T, Size>::dequeue(T& item) noexcept {
     return true;
 }
 
+template<typename T, size_t Size>
+size_t UltraLowLatencyQueue<T, Size>::try_enqueue_bulk(const T* items, size_t count) noexcept {
+    const size_t current_tail = tail_.load(std::memory_order_relaxed);
+    
+    size_t free_slots = (cached_head_ - current_tail - 1) & MASK;
+    if (free_slots < count) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        free_slots = (cached_head_ - current_tail - 1) & MASK;
+    }
+    
+    const size_t n = count < free_slots ? count : free_slots;
+    for (size_t i = 0; i < n; ++i) {
+        data_[(current_tail + i) & MASK] = items[i];
+    }
+    
+    // One release store publishes the whole batch
+    if (n > 0) {
+        tail_.store((current_tail + n) & MASK, std::memory_order_release);
+    }
+    
+    return n;
+}
+
+template<typename T, size_t Size>
+size_t UltraLowLatencyQueue<T, Size>::try_dequeue_bulk(T* items, size_t max_count) noexcept {
+    const size_t current_head = head_.load(std::memory_order_relaxed);
+    
+    size_t available = (cached_tail_ - current_head) & MASK;
+    if (available < max_count) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        available = (cached_tail_ - current_head) & MASK;
+    }
+    
+    const size_t n = max_count < available ? max_count : available;
+    for (size_t i = 0; i < n; ++i) {
+        items[i] = data_[(current_head + i) & MASK];
+    }
+    
+    // One release store frees the whole batch
+    if (n > 0) {
+        head_.store((current_head + n) & MASK, std::memory_order_release);
+    }
+    
+    return n;
+}
+
+template<typename T, size_t Size>
+T* UltraLowLatencyQueue<T, Size>::reserve() noexcept {
+    const size_t current_tail = tail_.load(std::memory_order_relaxed);
+    const size_t next_tail = (current_tail + 1) & MASK;
+    
+    if (next_tail == cached_head_) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (next_tail == cached_head_) {
+            return nullptr;
+        }
+    }
+    
+    return &data_[current_tail];
+}
+
+template<typename T, size_t Size>
+void UltraLowLatencyQueue<T, Size>::publish() noexcept {
+    const size_t current_tail = tail_.load(std::memory_order_relaxed);
+    tail_.store((current_tail + 1) & MASK, std::memory_order_release);
+}
+
 template<typename T, size_t Size>
 bool UltraLowLatencyQueue<T, Size>::empty() const noexcept {
     return head_.load(std::memory_order_relaxed) == 
@@ -74,6 +148,8 @@ size_t UltraLowLatencyQueue<T, Size>::size() const noexcept {
 template class UltraLowLatencyQueue<int, 1024>;
 template class UltraLowLatencyQueue<double, 1024>;
 template class UltraLowLatencyQueue<uint64_t, 1024>;
+template class UltraLowLatencyQueue<common::Tick, 1024>;
+template class UltraLowLatencyQueue<common::CompactTick, 1024>;
 
 } // namespace threading
 } // namespace feedhandler
\ No newline at end of file
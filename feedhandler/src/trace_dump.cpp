@@ -0,0 +1,56 @@
+// Convert a binary trace (Tracer::capture().save(), or FeedPipeline with
+// monitoring.trace_output_file) into Chrome trace / Perfetto JSON.
+//
+//   trace_dump feed.trace [feed.json]
+//
+// Without an output path the JSON goes to stdout. Open it in
+// https://ui.perfetto.dev or chrome://tracing; a per-stage event count
+// goes to stderr.
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "common/trace_ring.hpp"
+
+using feedhandler::common::TraceDump;
+using feedhandler::common::TracePhase;
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "usage: " << argv[0] << " <trace.bin> [out.json]" << std::endl;
+        return 2;
+    }
+
+    TraceDump dump;
+    if (!TraceDump::load(argv[1], dump)) {
+        return 1;
+    }
+
+    if (argc == 3) {
+        std::ofstream out(argv[2]);
+        if (!out) {
+            std::cerr << "Cannot write " << argv[2] << std::endl;
+            return 1;
+        }
+        dump.write_chrome_json(out);
+    } else {
+        dump.write_chrome_json(std::cout);
+    }
+
+    std::vector<size_t> counts(dump.stages.size(), 0);
+    size_t events = 0;
+    for (const TraceDump::Thread& thread : dump.threads) {
+        for (const TraceDump::Event& event : thread.events) {
+            if (event.phase != TracePhase::END) {
+                ++counts[event.stage];
+            }
+        }
+        events += thread.events.size();
+    }
+    std::cerr << events << " events from " << dump.threads.size() << " threads" << std::endl;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        std::cerr << "  " << dump.stages[i] << ": " << counts[i] << std::endl;
+    }
+    return 0;
+}
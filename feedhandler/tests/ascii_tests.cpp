@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "parser/ascii.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+using namespace feedhandler::parser;
+
+namespace {
+
+// Random text weighted towards the classified characters
+std::string random_text(std::mt19937& rng, size_t length) {
+    static const char ALPHABET[] = " \t\n\r\v\f0123456789AZaz@[`{/:\x01|=.\x80\xff";
+    std::uniform_int_distribution<size_t> pick(0, sizeof(ALPHABET) - 2);
+    std::string text(length, ' ');
+    for (char& c : text) {
+        c = ALPHABET[pick(rng)];
+    }
+    return text;
+}
+
+} // namespace
+
+TEST(AsciiTest, ClassifiesLikeTheCLocale) {
+    for (int i = 0; i < 256; ++i) {
+        char c = static_cast<char>(i);
+        EXPECT_EQ(ascii::is_digit(c), std::isdigit(i) != 0) << i;
+        EXPECT_EQ(ascii::is_space(c), std::isspace(i) != 0) << i;
+        EXPECT_EQ(ascii::is_upper(c), std::isupper(i) != 0) << i;
+        EXPECT_EQ(ascii::is_lower(c), std::islower(i) != 0) << i;
+        EXPECT_EQ(ascii::is_alpha(c), std::isalpha(i) != 0) << i;
+        EXPECT_EQ(ascii::is_alnum(c), std::isalnum(i) != 0) << i;
+        EXPECT_EQ(ascii::is(c, ascii::SPACE), ascii::is_space(c)) << i;
+        EXPECT_EQ(ascii::to_lower(c), static_cast<char>(std::tolower(i))) << i;
+        EXPECT_EQ(ascii::to_upper(c), static_cast<char>(std::toupper(i))) << i;
+    }
+}
+
+TEST(AsciiTest, BlockMasksMatchTheClassTable) {
+    std::mt19937 rng(151);
+    const uint8_t class_sets[] = {ascii::DIGIT, ascii::UPPER, ascii::LOWER, ascii::SPACE,
+                                  ascii::ALPHA, ascii::ALNUM, ascii::DIGIT | ascii::SPACE,
+                                  ascii::UPPER | ascii::SPACE};
+    for (int round = 0; round < 2000; ++round) {
+        std::string block = random_text(rng, 16);
+        for (uint8_t classes : class_sets) {
+            uint32_t expected = 0;
+            for (uint32_t i = 0; i < 16; ++i) {
+                expected |= static_cast<uint32_t>(ascii::is(block[i], classes)) << i;
+            }
+            ASSERT_EQ(ascii::mask16(block.data(), classes), expected) << int(classes);
+        }
+    }
+}
+
+TEST(AsciiTest, SkipsRunsOfEveryLengthFromBothEnds) {
+    for (size_t lead = 0; lead < 40; ++lead) {
+        for (size_t tail = 0; tail < 40; tail += 3) {
+            std::string text = std::string(lead, ' ') + "x" + std::string(tail, '\t');
+            const char* begin = text.data();
+            const char* end = begin + text.size();
+            EXPECT_EQ(ascii::skip_space(begin, end) - begin, static_cast<std::ptrdiff_t>(lead));
+            EXPECT_EQ(ascii::skip_back(begin, end, ascii::SPACE) - begin, static_cast<std::ptrdiff_t>(lead + 1));
+            EXPECT_EQ(ascii::trim(text), "x");
+        }
+        std::string blank(lead, '\n');
+        EXPECT_EQ(ascii::skip_space(blank.data(), blank.data() + blank.size()), blank.data() + blank.size());
+        EXPECT_EQ(ascii::skip_back(blank.data(), blank.data() + blank.size(), ascii::SPACE), blank.data());
+        EXPECT_TRUE(ascii::trim(blank).empty());
+    }
+
+    std::string digits = std::string(37, '7') + "=";
+    EXPECT_EQ(ascii::skip_digits(digits.data(), digits.data() + digits.size()) - digits.data(), 37);
+    EXPECT_TRUE(ascii::all_of("20240101", ascii::DIGIT));
+    EXPECT_FALSE(ascii::all_of("2024-01-01", ascii::DIGIT));
+    EXPECT_EQ(ascii::trim_left("  a b "), "a b ");
+    EXPECT_EQ(ascii::trim_right("  a b "), "  a b");
+}
+
+TEST(AsciiTest, FoldsCaseInPlaceAtAnyLength) {
+    std::mt19937 rng(118);
+    for (size_t length = 0; length < 70; ++length) {
+        std::string text = random_text(rng, length);
+        std::string lower = text;
+        std::string upper = text;
+        ascii::to_lower(lower);
+        ascii::to_upper(upper);
+        for (size_t i = 0; i < length; ++i) {
+            ASSERT_EQ(lower[i], ascii::to_lower(text[i])) << length << " " << i;
+            ASSERT_EQ(upper[i], ascii::to_upper(text[i])) << length << " " << i;
+        }
+    }
+    EXPECT_TRUE(ascii::iequals("Sec-WebSocket-Accept", "sec-websocket-accept"));
+    EXPECT_FALSE(ascii::iequals("Upgrade", "Upgrades"));
+    EXPECT_FALSE(ascii::iequals("@", "`"));
+}
+
+TEST(AsciiTest, ParsesIntegersStrictly) {
+    int32_t value = 7;
+    EXPECT_TRUE(ascii::parse_int("42", value));
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(ascii::parse_int("-42", value));
+    EXPECT_EQ(value, -42);
+    EXPECT_TRUE(ascii::parse_int("+0", value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ascii::parse_int("0000000000000000000000000123", value));
+    EXPECT_EQ(value, 123);
+
+    // The leetcode 8 inputs atoi forgives
+    value = 7;
+    for (const char* text : {"", "-", "+", "   -42", "42 ", "4193 with words", "words 987", "+-12", "3.14"}) {
+        EXPECT_FALSE(ascii::parse_int(text, value)) << text;
+    }
+    EXPECT_EQ(value, 7);
+}
+
+TEST(AsciiTest, DetectsOverflowAtEachLimit) {
+    int32_t i32 = 0;
+    EXPECT_TRUE(ascii::parse_int("2147483647", i32));
+    EXPECT_EQ(i32, std::numeric_limits<int32_t>::max());
+    EXPECT_TRUE(ascii::parse_int("-2147483648", i32));
+    EXPECT_EQ(i32, std::numeric_limits<int32_t>::min());
+    EXPECT_FALSE(ascii::parse_int("2147483648", i32));
+    EXPECT_FALSE(ascii::parse_int("-2147483649", i32));
+    EXPECT_FALSE(ascii::parse_int("91283472332", i32));
+
+    int64_t i64 = 0;
+    EXPECT_TRUE(ascii::parse_int("-9223372036854775808", i64));
+    EXPECT_EQ(i64, std::numeric_limits<int64_t>::min());
+    EXPECT_FALSE(ascii::parse_int("9223372036854775808", i64));
+
+    uint64_t u64 = 0;
+    EXPECT_TRUE(ascii::parse_int("18446744073709551615", u64));
+    EXPECT_EQ(u64, std::numeric_limits<uint64_t>::max());
+    EXPECT_FALSE(ascii::parse_int("18446744073709551616", u64));
+    EXPECT_FALSE(ascii::parse_int("-1", u64));
+
+    uint8_t u8 = 0;
+    EXPECT_TRUE(ascii::parse_int("255", u8));
+    EXPECT_EQ(u8, 255);
+    EXPECT_FALSE(ascii::parse_int("256", u8));
+    int8_t i8 = 0;
+    EXPECT_TRUE(ascii::parse_int("-128", i8));
+    EXPECT_EQ(i8, -128);
+    EXPECT_FALSE(ascii::parse_int("128", i8));
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "analytics/bar_aggregator.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::analytics;
+
+namespace {
+
+common::CompactTick make_tick(common::InstrumentId id, int64_t price, int32_t qty, uint64_t timestamp) {
+    common::CompactTick tick;
+    tick.instrument_id = id;
+    tick.side = 'B';
+    tick.price = price;
+    tick.qty = qty;
+    tick.timestamp = timestamp;
+    return tick;
+}
+
+} // namespace
+
+TEST(BarAggregatorTest, TimeBarsCoverAlignedBuckets) {
+    BarAggregator::Config config;
+    config.interval_ns = 1000;
+    config.batch_size = 2;
+    std::vector<Bar> published;
+    std::vector<size_t> batches;
+    BarAggregator bars(config, [&](const Bar* batch, size_t count) {
+        published.insert(published.end(), batch, batch + count);
+        batches.push_back(count);
+    });
+
+    EXPECT_EQ(bars.push(make_tick(3, 1000000, 10, 1500)), nullptr);
+    EXPECT_EQ(bars.push(make_tick(3, 1010000, 30, 1700)), nullptr);
+    EXPECT_EQ(bars.push(make_tick(3, 990000, 20, 1999)), nullptr);
+    EXPECT_EQ(bars.push(make_tick(7, 500000, 5, 1800)), nullptr);
+    EXPECT_EQ(bars.current(3).tick_count, 3u);
+
+    // Next bucket closes instrument 3's bar
+    const Bar* closed = bars.push(make_tick(3, 1005000, 10, 2000));
+    ASSERT_NE(closed, nullptr);
+    EXPECT_EQ(closed->instrument_id, 3u);
+    EXPECT_EQ(closed->start_ns, 1000u);
+    EXPECT_EQ(closed->end_ns, 1999u);
+    EXPECT_EQ(closed->open, 1000000);
+    EXPECT_EQ(closed->high, 1010000);
+    EXPECT_EQ(closed->low, 990000);
+    EXPECT_EQ(closed->close, 990000);
+    EXPECT_EQ(closed->volume, 60);
+    EXPECT_DOUBLE_EQ(closed->vwap(), (100.0 * 10 + 101.0 * 30 + 99.0 * 20) / 60);
+    EXPECT_EQ(bars.pending(), 1u);
+    EXPECT_TRUE(published.empty());
+
+    // Late tick from an earlier bucket joins the open bar
+    EXPECT_EQ(bars.push(make_tick(3, 1001000, 1, 1990)), nullptr);
+    EXPECT_EQ(bars.current(3).tick_count, 2u);
+
+    // Instrument 7 went quiet: only the expiry scan closes it, which fills the batch
+    std::vector<common::InstrumentId> expired;
+    EXPECT_EQ(bars.close_expired(2500, [&](const Bar& bar) { expired.push_back(bar.instrument_id); }), 1u);
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(expired[0], 7u);
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0], 2u);
+    EXPECT_EQ(published[1].instrument_id, 7u);
+    EXPECT_EQ(published[1].volume, 5);
+
+    EXPECT_EQ(bars.close_expired(3000), 1u);
+    bars.flush();
+    ASSERT_EQ(published.size(), 3u);
+    EXPECT_EQ(published[2].tick_count, 2u);
+    EXPECT_EQ(bars.bars_closed(), 3u);
+    EXPECT_TRUE(bars.current(3).empty());
+}
+
+TEST(BarAggregatorTest, VolumeBarsCloseOnTheThreshold) {
+    BarAggregator::Config config;
+    config.type = BarAggregator::BarType::VOLUME;
+    config.volume_per_bar = 100;
+    BarAggregator bars(config);
+
+    std::vector<int64_t> volumes;
+    for (int i = 0; i < 25; ++i) {
+        if (const Bar* bar = bars.push(make_tick(1, 1000000 + i, 30, static_cast<uint64_t>(i)))) {
+            volumes.push_back(bar->volume);
+            EXPECT_EQ(bar->tick_count, 4u);
+        }
+    }
+    // 30-lot ticks: every fourth one crosses 100
+    ASSERT_EQ(volumes.size(), 6u);
+    EXPECT_EQ(volumes[0], 120);
+    EXPECT_EQ(bars.current(1).volume, 30);
+    EXPECT_EQ(bars.close_expired(UINT64_MAX), 0u);  // No expiry for volume bars
+
+    EXPECT_EQ(bars.push(make_tick(1, 0, 10, 99)), nullptr);
+    EXPECT_EQ(bars.push(make_tick(common::INVALID_INSTRUMENT, 100, 10, 99)), nullptr);
+    EXPECT_EQ(bars.current(1).tick_count, 1u);
+}
+
+TEST(BarVolatilityTest, AveragesTheLastBars) {
+    BarVolatility volatility(2);
+    EXPECT_EQ(volatility.parkinson(), 0.0);
+
+    auto make_bar = [](int64_t open, int64_t high, int64_t low, int64_t close) {
+        Bar bar;
+        bar.open = open;
+        bar.high = high;
+        bar.low = low;
+        bar.close = close;
+        bar.tick_count = 1;
+        return bar;
+    };
+    auto parkinson = [](const Bar& bar) {
+        double range = std::log(static_cast<double>(bar.high) / static_cast<double>(bar.low));
+        return range * range / (4.0 * std::log(2.0));
+    };
+    auto garman_klass = [](const Bar& bar) {
+        double range = std::log(static_cast<double>(bar.high) / static_cast<double>(bar.low));
+        double body = std::log(static_cast<double>(bar.close) / static_cast<double>(bar.open));
+        return 0.5 * range * range - (2.0 * std::log(2.0) - 1.0) * body * body;
+    };
+
+    Bar a = make_bar(100, 110, 95, 105);
+    Bar b = make_bar(105, 106, 100, 101);
+    Bar c = make_bar(101, 120, 101, 119);
+    volatility.add(a);
+    EXPECT_NEAR(volatility.parkinson(), std::sqrt(parkinson(a)), 1e-15);
+    volatility.add(b);
+    volatility.add(c);  // Evicts a
+    EXPECT_EQ(volatility.size(), 2u);
+    EXPECT_NEAR(volatility.parkinson(), std::sqrt((parkinson(b) + parkinson(c)) / 2), 1e-15);
+    EXPECT_NEAR(volatility.garman_klass(), std::sqrt((garman_klass(b) + garman_klass(c)) / 2), 1e-15);
+
+    volatility.add(Bar{});  // Empty bars are skipped
+    EXPECT_EQ(volatility.size(), 2u);
+    volatility.clear();
+    EXPECT_EQ(volatility.garman_klass(), 0.0);
+}
@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+#include "benchmarks/stage_profiler.hpp"
+#include "common/buffer_segment.hpp"
+#include "parser/fsm_fix_parser.hpp"
+#include "threading/threaded_feedhandler.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::common;
+
+namespace {
+
+std::string make_message(const std::string& symbol) {
+    return "8=FIX.4.4|9=79|35=D|55=" + symbol +
+           "|44=150.25|38=500|54=1|52=20240131-12:34:56|10=020|\n";
+}
+
+SegmentRef fill(SegmentPool& pool, const std::string& bytes) {
+    SegmentRef segment = pool.acquire();
+    if (segment) {
+        std::memcpy(segment.data(), bytes.data(), bytes.size());
+        segment.set_length(bytes.size());
+    }
+    return segment;
+}
+
+} // namespace
+
+TEST(SegmentPoolTest, LastHandleRecyclesSegment) {
+    SegmentPool pool(2, 256, 8);
+    EXPECT_EQ(pool.free_count(), 2u);
+
+    SegmentRef a = pool.acquire();
+    ASSERT_TRUE(a);
+    EXPECT_EQ(a.use_count(), 1u);
+    EXPECT_EQ(a.capacity(), 256u);
+    EXPECT_EQ(a.tick_capacity(), 8u);
+
+    SegmentRef copy = a;
+    EXPECT_EQ(a.use_count(), 2u);
+    SegmentRef moved = std::move(copy);
+    EXPECT_FALSE(copy);
+    EXPECT_EQ(a.use_count(), 2u);
+    EXPECT_EQ(pool.free_count(), 1u);
+
+    a.reset();
+    EXPECT_EQ(pool.free_count(), 1u);  // Still held through moved
+    moved.reset();
+    EXPECT_EQ(pool.free_count(), 2u);
+}
+
+TEST(SegmentPoolTest, ExhaustedWhileHeld) {
+    SegmentPool pool(2, 64, 4);
+    SegmentRef a = pool.acquire();
+    SegmentRef b = pool.acquire();
+    EXPECT_FALSE(pool.acquire());
+    EXPECT_EQ(pool.free_count(), 0u);
+
+    a = b;  // Releases a's segment, shares b's
+    EXPECT_EQ(b.use_count(), 2u);
+    SegmentRef c = pool.acquire();
+    ASSERT_TRUE(c);
+    EXPECT_EQ(c.length(), 0u);
+    EXPECT_TRUE(c.ticks().empty());
+}
+
+TEST(SegmentPoolTest, ParsedSymbolsPointIntoSegment) {
+    SegmentPool pool(1, 512, 8);
+    SegmentRef segment = fill(pool, make_message("AAPL") + make_message("MSFT"));
+    ASSERT_TRUE(segment);
+
+    parser::FSMFixParser parser;
+    TickSpan<FlyweightTick> out(segment.tick_storage(), segment.tick_capacity());
+    EXPECT_EQ(parser.parse(segment.data(), segment.length(), out), segment.length());
+    segment.set_tick_count(out.size());
+
+    auto ticks = segment.ticks();
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].symbol, "AAPL");
+    EXPECT_EQ(ticks[1].symbol, "MSFT");
+    EXPECT_EQ(ticks[0].qty, 500);
+    EXPECT_EQ(ticks[0].side, 'B');
+    EXPECT_TRUE(ticks[0].is_valid());
+
+    // Zero-copy: views into the segment bytes, not parser storage
+    const char* begin = segment.data();
+    const char* end = begin + segment.length();
+    for (const auto& tick : ticks) {
+        EXPECT_GE(tick.symbol.data(), begin);
+        EXPECT_LT(tick.symbol.data(), end);
+    }
+}
+
+TEST(SegmentPoolTest, SymbolFromPreviousFragmentViewsSymbolTable) {
+    SegmentPool pool(2, 256, 8);
+    std::string msg = make_message("NFLX");
+    size_t split = msg.find("|44=");  // Symbol complete in the first fragment
+
+    parser::FSMFixParser parser;
+    SegmentRef first = fill(pool, msg.substr(0, split + 1));
+    TickSpan<FlyweightTick> out1(first.tick_storage(), first.tick_capacity());
+    parser.parse(first.data(), first.length(), out1);
+    EXPECT_TRUE(out1.empty());
+
+    SegmentRef second = fill(pool, msg.substr(split + 1));
+    TickSpan<FlyweightTick> out2(second.tick_storage(), second.tick_capacity());
+    parser.parse(second.data(), second.length(), out2);
+    second.set_tick_count(out2.size());
+    first.reset();  // The tick must not depend on the first segment
+
+    ASSERT_EQ(second.ticks().size(), 1u);
+    const auto& tick = second.ticks()[0];
+    EXPECT_EQ(tick.symbol, "NFLX");
+    EXPECT_EQ(tick.symbol.data(), SymbolTable::global().name(SymbolTable::global().find("NFLX")).data());
+}
+
+TEST(ThreadedFeedHandlerSegmentTest, ConsumerKeepsTicksAcrossQueue) {
+    threading::ThreadedFeedHandler::Config config;
+    config.queue_size = 16;
+    config.buffer_size = 512;
+    config.segment_count = 8;
+
+    // Consumer parks the handles like a downstream queue would
+    std::mutex mutex;
+    std::vector<SegmentRef> held;
+    threading::ThreadedFeedHandler handler(config, [&](const SegmentRef& segment) {
+        std::lock_guard<std::mutex> lock(mutex);
+        held.push_back(segment);
+    });
+    ASSERT_NE(handler.segment_pool(), nullptr);
+
+    const std::string symbols[] = {"AAPL", "MSFT", "GOOG", "TSLA"};
+    handler.start();
+    for (const auto& symbol : symbols) {
+        std::string msg = make_message(symbol) + make_message(symbol);
+        handler.inject_data(msg.data(), msg.size());
+    }
+    handler.stop();
+
+    // Segments were not recycled while held, so every view is intact
+    ASSERT_EQ(held.size(), 4u);
+    EXPECT_EQ(handler.segment_pool()->free_count(), 4u);
+    for (size_t i = 0; i < held.size(); ++i) {
+        ASSERT_EQ(held[i].ticks().size(), 2u);
+        for (const auto& tick : held[i].ticks()) {
+            EXPECT_EQ(tick.symbol, symbols[i]);
+        }
+        EXPECT_EQ(held[i].use_count(), 1u);
+    }
+    EXPECT_EQ(handler.get_statistics().messages_parsed, 8u);
+
+    // Retiring the batches returns every segment
+    held.clear();
+    EXPECT_EQ(handler.segment_pool()->free_count(), 8u);
+}
+
+TEST(ThreadedFeedHandlerSegmentTest, RecordsQueueAndParseLatencyPerBuffer) {
+    threading::ThreadedFeedHandler::Config config;
+    std::vector<Tick> received;
+    threading::ThreadedFeedHandler handler(config, [&](const Tick& tick) { received.push_back(tick); });
+
+    handler.start();
+    std::string msg = make_message("AAPL");
+    for (int i = 0; i < 3; ++i) {
+        handler.inject_data(msg.data(), msg.size());
+    }
+    handler.stop();
+
+    const auto& stats = handler.get_statistics();
+    EXPECT_EQ(stats.queue_latency.snapshot().count(), 3u);
+    EXPECT_EQ(stats.parse_latency.snapshot().count(), 3u);
+    EXPECT_GT(stats.parse_latency.snapshot().max(), 0u);
+
+    handler.reset_statistics();
+    EXPECT_EQ(stats.parse_latency.snapshot().count(), 0u);
+
+    // Off: nothing recorded
+    config.latency_tracking = false;
+    threading::ThreadedFeedHandler quiet(config, [](const Tick&) {});
+    quiet.start();
+    quiet.inject_data(msg.data(), msg.size());
+    quiet.stop();
+    EXPECT_EQ(quiet.get_statistics().messages_parsed.load(), 1u);
+    EXPECT_EQ(quiet.get_statistics().queue_latency.snapshot().count(), 0u);
+    EXPECT_EQ(quiet.get_statistics().parse_latency.snapshot().count(), 0u);
+}
+
+TEST(ThreadedFeedHandlerSegmentTest, InjectedReceiveTimestampStampsTicks) {
+    threading::ThreadedFeedHandler::Config config;
+    std::vector<Tick> received;
+    threading::ThreadedFeedHandler handler(config, [&](const Tick& tick) { received.push_back(tick); });
+
+    handler.start();
+    std::string msg = make_message("AAPL");
+    handler.inject_data(msg.data(), msg.size(), 12345);
+    handler.inject_data(msg.data(), msg.size());
+    handler.stop();
+
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0].timestamp, 12345u);
+    EXPECT_NE(received[1].timestamp, 12345u);  // 0 = stamped by the parser
+}
+
+TEST(ThreadedFeedHandlerSegmentTest, ProfilesParseAndDeliverStages) {
+    benchmarks::StageProfiler profiler;
+    threading::ThreadedFeedHandler::Config config;
+    config.stage_profiler = &profiler;
+    size_t delivered = 0;
+    threading::ThreadedFeedHandler handler(config, [&](const Tick&) { ++delivered; });
+    ASSERT_EQ(profiler.stage_count(), 2u);
+    EXPECT_EQ(profiler.stage_name(0), "parse");
+    EXPECT_EQ(profiler.stage_name(1), "deliver");
+
+    handler.start();
+    std::string msg = make_message("AAPL") + make_message("MSFT");
+    handler.inject_data(msg.data(), msg.size());
+    handler.inject_data(msg.data(), msg.size());
+    handler.stop();
+
+    EXPECT_EQ(delivered, 4u);
+    EXPECT_EQ(profiler.batches(0), 2u);
+    EXPECT_EQ(profiler.batches(1), 2u);
+    EXPECT_GT(profiler.metrics(0).wall_time.count(), 0);
+}
+
+TEST(ThreadedFeedHandlerSegmentTest, HeldSegmentsExhaustPool) {
+    threading::ThreadedFeedHandler::Config config;
+    config.buffer_size = 256;
+    config.segment_count = 2;
+
+    std::mutex mutex;
+    std::vector<SegmentRef> held;
+    threading::ThreadedFeedHandler handler(config, [&](const SegmentRef& segment) {
+        std::lock_guard<std::mutex> lock(mutex);
+        held.push_back(segment);
+    });
+
+    handler.start();
+    std::string msg = make_message("IBM");
+    for (int i = 0; i < 2; ++i) {
+        handler.inject_data(msg.data(), msg.size());
+    }
+    // Wait until the parser has handed both segments over
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (held.size() == 2) {
+                break;
+            }
+        }
+        std::this_thread::yield();
+    }
+    handler.inject_data(msg.data(), msg.size());
+    EXPECT_EQ(handler.get_statistics().segment_exhaustions.load(), 1u);
+
+    held.clear();
+    SegmentRef direct = handler.acquire_segment();
+    ASSERT_TRUE(direct);
+    std::memcpy(direct.data(), msg.data(), msg.size());
+    direct.set_length(msg.size());
+    handler.submit_segment(std::move(direct));
+    handler.stop();
+
+    EXPECT_EQ(handler.get_statistics().messages_parsed, 3u);
+    held.clear();  // Handles must not outlive the handler's pool
+}
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include "net/capture_replay.hpp"
+#include "parser/fsm_fix_parser.hpp"
+#include "pipeline/timestamp_merger.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace feedhandler;
+using namespace feedhandler::net;
+
+namespace {
+
+// Temporary file removed when the test ends
+class TempFile {
+public:
+    explicit TempFile(const std::string& contents) {
+        char name[] = "/tmp/capture_replay_XXXXXX";
+        int fd = mkstemp(name);
+        path_ = name;
+        if (fd >= 0) {
+            EXPECT_EQ(write(fd, contents.data(), contents.size()), static_cast<ssize_t>(contents.size()));
+            ::close(fd);
+        }
+    }
+    ~TempFile() { std::remove(path_.c_str()); }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+std::string make_message(const std::string& symbol, const std::string& sending_time) {
+    return "8=FIX.4.4|9=79|35=D|55=" + symbol + "|44=150.25|38=500|54=1|52=" + sending_time + "|10=020|\n";
+}
+
+void put32(std::string& out, uint32_t v) { out.append(reinterpret_cast<const char*>(&v), 4); }
+void put16_be(std::string& out, uint16_t v) {
+    out.push_back(static_cast<char>(v >> 8));
+    out.push_back(static_cast<char>(v & 0xff));
+}
+
+// Ethernet + IPv4 + TCP (or UDP) frame carrying payload
+std::string make_frame(const std::string& payload, bool tcp) {
+    std::string frame(12, '\0');  // MAC addresses
+    put16_be(frame, 0x0800);
+    size_t l4_header = tcp ? 20 : 8;
+    std::string ip(20, '\0');
+    ip[0] = 0x45;
+    ip[2] = static_cast<char>((20 + l4_header + payload.size()) >> 8);
+    ip[3] = static_cast<char>((20 + l4_header + payload.size()) & 0xff);
+    ip[9] = tcp ? 6 : 17;
+    std::string l4(l4_header, '\0');
+    if (tcp) {
+        l4[12] = 0x50;  // Data offset 5 words
+    }
+    return frame + ip + l4 + payload;
+}
+
+std::string make_pcap(const std::vector<std::pair<uint64_t, std::string>>& frames) {
+    std::string out;
+    put32(out, 0xa1b2c3d4);
+    put16_be(out, 0x0200);  // Version bytes are not checked
+    put16_be(out, 0x0400);
+    put32(out, 0);
+    put32(out, 0);
+    put32(out, 65535);
+    put32(out, 1);  // Ethernet
+    for (const auto& [timestamp_us, frame] : frames) {
+        put32(out, static_cast<uint32_t>(timestamp_us / 1000000));
+        put32(out, static_cast<uint32_t>(timestamp_us % 1000000));
+        put32(out, static_cast<uint32_t>(frame.size()));
+        put32(out, static_cast<uint32_t>(frame.size()));
+        out += frame;
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(CaptureReplayTest, RawChunksEndOnLinesAndParseZeroCopy) {
+    std::string capture;
+    for (int i = 0; i < 20; ++i) {
+        capture += make_message("AAPL", "20240131-12:34:56");
+    }
+    TempFile file(capture);
+
+    CaptureReplayConfig config;
+    config.chunk_size = 200;
+    CaptureReplay replay(config);
+    ASSERT_TRUE(replay.open(file.path()));
+    EXPECT_EQ(replay.format(), CaptureFormat::RAW);
+
+    parser::FSMFixParser parser;
+    std::vector<common::Tick> ticks;
+    size_t deliveries = replay.replay([&](const char* data, size_t length, uint64_t) {
+        EXPECT_GE(data, replay.data());
+        EXPECT_EQ(data[length - 1], '\n');
+        parser.parse(data, length, ticks);
+    });
+
+    EXPECT_GT(deliveries, 1u);
+    EXPECT_EQ(ticks.size(), 20u);
+    EXPECT_EQ(replay.get_stats().bytes, capture.size());
+}
+
+TEST(CaptureReplayTest, RawOriginalPacingUsesSendingTime) {
+    TempFile file(make_message("MSFT", "20240131-12:34:56.000") + make_message("MSFT", "20240131-12:34:56.020"));
+
+    CaptureReplayConfig config;
+    config.pacing = ReplayPacing::ORIGINAL;
+    CaptureReplay replay(config);
+    ASSERT_TRUE(replay.open(file.path()));
+
+    std::vector<uint64_t> timestamps;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(replay.replay([&](const char*, size_t, uint64_t timestamp) { timestamps.push_back(timestamp); }), 2u);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(timestamps.size(), 2u);
+    EXPECT_EQ(timestamps[1] - timestamps[0], 20000000u);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(19));
+}
+
+TEST(CaptureReplayTest, CursorSplitsMessagesWithTheirTimestamps) {
+    std::string first = make_message("MSFT", "20240131-12:34:56.000");
+    std::string second = make_message("MSFT", "20240131-12:34:56.020");
+    TempFile file(first + second);
+
+    CaptureReplayConfig config;
+    config.split_messages = true;
+    CaptureReplay replay(config);
+    ASSERT_TRUE(replay.open(file.path()));
+
+    CaptureReplay::Delivery delivery;
+    ASSERT_TRUE(replay.next(delivery));
+    EXPECT_EQ(std::string(delivery.data, delivery.length), first);
+    uint64_t start = delivery.timestamp_ns;
+    ASSERT_TRUE(replay.next(delivery));
+    EXPECT_EQ(std::string(delivery.data, delivery.length), second);
+    EXPECT_EQ(delivery.timestamp_ns - start, 20000000u);
+    EXPECT_FALSE(replay.next(delivery));
+
+    replay.rewind();
+    ASSERT_TRUE(replay.next(delivery));
+    EXPECT_EQ(delivery.timestamp_ns, start);
+    EXPECT_EQ(replay.get_stats().deliveries, 1u);
+}
+
+TEST(CaptureReplayTest, CapturesMergeBySendingTime) {
+    TempFile morning(make_message("AAPL", "20240131-12:00:00.000") + make_message("AAPL", "20240131-12:00:00.300") +
+                     make_message("AAPL", "20240131-12:00:00.600"));
+    TempFile session(make_message("MSFT", "20240131-12:00:00.100") + make_message("MSFT", "20240131-12:00:00.400"));
+
+    // One source per capture: each fill() parses the next few messages
+    CaptureReplayConfig config;
+    config.split_messages = true;
+    std::vector<std::unique_ptr<CaptureReplay>> replays;
+    pipeline::TimestampMerger<common::Tick> merger(2);
+    for (const TempFile* file : {&morning, &session}) {
+        replays.push_back(std::make_unique<CaptureReplay>(config));
+        ASSERT_TRUE(replays.back()->open(file->path()));
+        merger.add_source([replay = replays.back().get()](std::span<common::Tick> out) {
+            parser::FSMFixParser parser;
+            size_t count = 0;
+            CaptureReplay::Delivery delivery;
+            while (count < out.size() && replay->next(delivery)) {
+                std::vector<common::Tick> ticks;
+                parser.parse(delivery.data, delivery.length, ticks);
+                for (common::Tick& tick : ticks) {
+                    tick.timestamp = delivery.timestamp_ns;
+                    out[count++] = tick;
+                }
+            }
+            return count;
+        });
+    }
+
+    std::vector<std::string> symbols;
+    common::Tick batch[2];
+    EXPECT_EQ(merger.drain(std::span<common::Tick>(batch), [&](std::span<const common::Tick> ticks) {
+        for (const common::Tick& tick : ticks) {
+            symbols.emplace_back(tick.symbol);
+        }
+    }), 5u);
+    EXPECT_EQ(symbols, (std::vector<std::string>{"AAPL", "MSFT", "AAPL", "MSFT", "AAPL"}));
+    EXPECT_EQ(merger.stats().out_of_order, 0u);
+}
+
+TEST(CaptureReplayTest, PcapDeliversTcpAndUdpPayloads) {
+    std::string first = make_message("IBM", "20240131-12:34:56");
+    std::string second = make_message("ORCL", "20240131-12:34:56");
+    TempFile file(make_pcap({
+        {1000000, make_frame(first, true)},
+        {1000500, make_frame("", true)},       // Bare ACK
+        {1001000, make_frame(second, false)},
+    }));
+
+    CaptureReplay replay;
+    ASSERT_TRUE(replay.open(file.path()));
+    EXPECT_EQ(replay.format(), CaptureFormat::PCAP);
+
+    std::vector<std::string> payloads;
+    std::vector<uint64_t> timestamps;
+    EXPECT_EQ(replay.replay([&](const char* data, size_t length, uint64_t timestamp) {
+        payloads.emplace_back(data, length);
+        timestamps.push_back(timestamp);
+    }), 2u);
+
+    ASSERT_EQ(payloads.size(), 2u);
+    EXPECT_EQ(payloads[0], first);
+    EXPECT_EQ(payloads[1], second);
+    EXPECT_EQ(timestamps[0], 1000000000u);
+    EXPECT_EQ(timestamps[1], 1001000000u);
+    EXPECT_EQ(replay.get_stats().skipped_packets, 1u);
+}
+
+TEST(CaptureReplayTest, TruncatedPcapRecordStopsReplay) {
+    std::string pcap = make_pcap({{0, make_frame("8=FIX.4.4|35=0|\n", true)}});
+    pcap.resize(pcap.size() - 4);
+    TempFile file(pcap);
+
+    CaptureReplay replay;
+    ASSERT_TRUE(replay.open(file.path()));
+    EXPECT_EQ(replay.replay([](const char*, size_t, uint64_t) {}), 0u);
+    EXPECT_EQ(replay.get_stats().truncated_records, 1u);
+}
+
+TEST(CaptureReplayTest, MissingFileFailsToOpen) {
+    CaptureReplay replay;
+    EXPECT_FALSE(replay.open("/nonexistent/capture.fix"));
+    EXPECT_FALSE(replay.is_open());
+    EXPECT_EQ(replay.replay([](const char*, size_t, uint64_t) {}), 0u);
+}
@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+#include "distributed/cluster_computing.hpp"
+
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+namespace {
+
+ClusterManager::NodeInfo loopback_node(double cpu = 0.1) {
+    ClusterManager::NodeInfo node{};
+    node.ip_address = "127.0.0.1";
+    node.port = 0;
+    node.cpu_utilization = cpu;
+    node.memory_usage_mb = 512;
+    node.network_bandwidth_mbps = 10000;
+    node.is_healthy = true;
+    return node;
+}
+
+ClusterManager::NodeInfo info_of(const ClusterManager& cluster) {
+    for (const auto& node : cluster.get_cluster_status().node_details) {
+        if (node.node_id == cluster.local_node_id()) {
+            return node;
+        }
+    }
+    return {};
+}
+
+// Two managers on loopback that know each other
+struct Pair {
+    explicit Pair(bool shared_memory, uint32_t heartbeat_ms = 1000, uint32_t rebalance_ms = 5000)
+        : name(unique_name()),
+          a(config(shared_memory, heartbeat_ms, rebalance_ms, name)),
+          b(config(shared_memory, heartbeat_ms, rebalance_ms, name)) {
+        EXPECT_TRUE(a.join_cluster(loopback_node(0.25)).first);
+        EXPECT_TRUE(b.join_cluster(loopback_node(0.75)).first);
+        EXPECT_TRUE(a.join_cluster(info_of(b)).first);
+        EXPECT_TRUE(b.join_cluster(info_of(a)).first);
+    }
+
+    // A fresh cluster name per pair keeps shared-memory segments apart across tests
+    static std::string unique_name() {
+        return "test" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+    }
+
+    static ClusterManager::ClusterConfig config(bool shared_memory, uint32_t heartbeat_ms, uint32_t rebalance_ms,
+                                                const std::string& name) {
+        ClusterManager::ClusterConfig config;
+        config.cluster_name = name;
+        config.shared_memory_transport = shared_memory;
+        config.heartbeat_interval_ms = heartbeat_ms;
+        config.rebalance_interval_ms = rebalance_ms;
+        return config;
+    }
+
+    // Poll b until it has received count frames or a second passes
+    static void poll_until(ClusterManager& cluster, uint64_t count) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (cluster.get_transport_stats().frames_received < count && std::chrono::steady_clock::now() < deadline) {
+            cluster.poll_messages(10);
+        }
+    }
+
+    static inline int counter = 0;
+    std::string name;
+    ClusterManager a;
+    ClusterManager b;
+};
+
+struct Received {
+    std::string from;
+    std::string payload;
+    uint32_t sequence;
+};
+
+void expect_batched_delivery(bool shared_memory) {
+    Pair pair(shared_memory);
+    std::vector<Received> received;
+    pair.b.set_message_handler([&](const std::string& from, const Frame& frame) {
+        received.push_back({from, std::string(reinterpret_cast<const char*>(frame.payload), frame.size()),
+                            frame.header->sequence});
+    });
+
+    for (const char* text : {"one", "two", "three"}) {
+        ASSERT_TRUE(pair.a.send_message(pair.b.local_node_id(), MessageType::APPLICATION, text, std::strlen(text)));
+    }
+    EXPECT_EQ(pair.a.flush_messages(), 3u);
+    auto sent = pair.a.get_transport_stats();
+    EXPECT_EQ(sent.batches_sent, 1u);  // Three frames, one send
+    EXPECT_EQ(sent.shm_batches, shared_memory ? 1u : 0u);
+
+    Pair::poll_until(pair.b, 3);
+    ASSERT_EQ(received.size(), 3u);
+    EXPECT_EQ(received[0].from, pair.a.local_node_id());
+    EXPECT_EQ(received[0].payload, "one");
+    EXPECT_EQ(received[2].payload, "three");
+    EXPECT_EQ(received[2].sequence, received[0].sequence + 2);
+}
+
+} // namespace
+
+TEST(ClusterManagerTest, JoinAssignsIdsAndListensOnAFreePort) {
+    ClusterManager cluster(Pair::config(false, 1000, 5000, Pair::unique_name()));
+    auto [ok, id] = cluster.join_cluster(loopback_node());
+    ASSERT_TRUE(ok);
+    EXPECT_EQ(id, cluster.local_node_id());
+    EXPECT_NE(info_of(cluster).port, 0);
+    EXPECT_EQ(id, "127.0.0.1:" + std::to_string(info_of(cluster).port));
+
+    auto peer = loopback_node();
+    peer.node_id = "peer";
+    EXPECT_TRUE(cluster.join_cluster(peer).first);
+    EXPECT_FALSE(cluster.join_cluster(peer).first);  // Duplicate
+    EXPECT_EQ(cluster.get_cluster_status().total_nodes, 2u);
+    EXPECT_FALSE(cluster.send_message("nobody", MessageType::APPLICATION, nullptr, 0));
+}
+
+TEST(ClusterManagerTest, BatchesFramesOverPersistentTcp) {
+    expect_batched_delivery(false);
+}
+
+TEST(ClusterManagerTest, ColocatedNodesUseSharedMemory) {
+    expect_batched_delivery(true);
+}
+
+TEST(ClusterManagerTest, HeartbeatsCarryNodeLoad) {
+    Pair pair(false, 10);
+    ASSERT_TRUE(pair.a.start());
+    Pair::poll_until(pair.b, 1);
+    pair.a.stop();
+
+    bool seen = false;
+    for (const auto& node : pair.b.get_cluster_status().node_details) {
+        if (node.node_id == pair.a.local_node_id()) {
+            EXPECT_DOUBLE_EQ(node.cpu_utilization, 0.25);
+            seen = true;
+        }
+    }
+    EXPECT_TRUE(seen);
+}
+
+TEST(ClusterManagerTest, WorkloadAssignmentsReachRemoteNodes) {
+    Pair pair(true);
+    std::vector<std::string> remote;
+    pair.b.set_message_handler([&](const std::string&, const Frame& frame) {
+        WorkloadAssignmentView view(frame);
+        ASSERT_TRUE(view.valid());
+        for (size_t i = 0; i < view.size(); ++i) {
+            remote.emplace_back(view.symbol(i));
+        }
+    });
+
+    std::vector<std::string> symbols;
+    for (int i = 0; i < 10; ++i) {
+        symbols.push_back("SYM" + std::to_string(i));
+    }
+    std::vector<std::string> local;
+    auto distribution = pair.a.distribute_workload(symbols, [&](const std::vector<std::string>& s) { local = s; });
+    ASSERT_EQ(distribution.size(), 2u);
+    EXPECT_EQ(local, distribution[pair.a.local_node_id()]);
+
+    Pair::poll_until(pair.b, 1);
+    EXPECT_EQ(remote, distribution[pair.b.local_node_id()]);
+    EXPECT_EQ(local.size() + remote.size(), symbols.size());
+}
+
+TEST(ClusterManagerTest, DistributeWorkloadWeighsMeasuredRates) {
+    Pair pair(true);
+    pair.a.record_symbol_messages("ETF", 10000);
+    for (const char* symbol : {"S1", "S2", "S3"}) {
+        pair.a.record_symbol_messages(symbol, 100);
+    }
+    // a has three times b's free CPU, yet the ETF alone outweighs the rest
+    auto distribution = pair.a.distribute_workload({"S1", "ETF", "S2", "S3"}, nullptr);
+    EXPECT_EQ(distribution[pair.a.local_node_id()], std::vector<std::string>{"ETF"});
+    EXPECT_EQ(distribution[pair.b.local_node_id()].size(), 3u);
+    EXPECT_GT(pair.a.symbol_rate("ETF"), 50.0 * pair.a.symbol_rate("S1"));
+}
+
+TEST(ClusterManagerTest, RebalancingHandsHotSymbolsOffWithTheirState) {
+    Pair pair(true, 1000, 50);
+    std::mutex mutex;
+    std::map<std::string, std::string> imported;  // On a
+    std::vector<std::string> exported;            // By b
+    pair.a.set_symbol_handoff([](const std::string&) { return std::vector<uint8_t>(); },
+                              [&](const std::string& symbol, const uint8_t* state, size_t size) {
+                                  std::lock_guard<std::mutex> lock(mutex);
+                                  imported[symbol].assign(reinterpret_cast<const char*>(state), size);
+                              });
+    pair.b.set_symbol_handoff([&](const std::string& symbol) {
+                                  std::lock_guard<std::mutex> lock(mutex);
+                                  exported.push_back(symbol);
+                                  std::string book = "book:" + symbol;
+                                  return std::vector<uint8_t>(book.begin(), book.end());
+                              },
+                              [](const std::string&, const uint8_t*, size_t) {});
+
+    // No rates yet: an even split, then b's first symbol turns hot
+    auto distribution = pair.a.distribute_workload({"S0", "S1", "S2", "S3"}, nullptr);
+    const std::vector<std::string> on_a = distribution[pair.a.local_node_id()];
+    const std::vector<std::string> on_b = distribution[pair.b.local_node_id()];
+    ASSERT_EQ(on_a.size(), 2u);
+    ASSERT_EQ(on_b.size(), 2u);
+    const std::string hot = on_b[0];
+
+    auto owns = [&](const std::string& owner, const std::string& symbol) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool moved = imported.count(symbol) != 0;
+        return owner == "a" ? moved : !moved;
+    };
+    std::atomic<bool> done{false};
+    auto feed = [&](ClusterManager& cluster, const std::string& owner) {
+        while (!done.load()) {
+            cluster.poll_messages(5);
+            for (const auto& symbol : on_a) {
+                if (owner == "a") {
+                    cluster.record_symbol_messages(symbol, 1);
+                }
+            }
+            if (owns(owner, hot)) {
+                cluster.record_symbol_messages(hot, 30);
+            }
+            if (owner == "b") {
+                cluster.record_symbol_messages(on_b[1], 10);
+            }
+        }
+    };
+    std::thread feed_a(feed, std::ref(pair.a), "a");
+    std::thread feed_b(feed, std::ref(pair.b), "b");
+    ASSERT_TRUE(pair.a.start());
+    ASSERT_TRUE(pair.b.start());
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!owns("a", hot) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // Several more rounds: the now even split must hold
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    pair.a.stop();
+    pair.b.stop();
+    done = true;
+    feed_a.join();
+    feed_b.join();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(exported, std::vector<std::string>{hot});
+    EXPECT_EQ(imported[hot], "book:" + hot);
+    EXPECT_EQ(imported.size(), 1u);
+    auto stats = pair.a.get_rebalance_stats();
+    EXPECT_EQ(stats.migrations, 1u);
+    EXPECT_EQ(stats.handoffs_received, 1u);
+    EXPECT_EQ(pair.b.get_rebalance_stats().handoffs_sent, 1u);
+    EXPECT_EQ(pair.b.get_rebalance_stats().handoff_bytes, hot.size() + 5);
+    EXPECT_GT(pair.a.symbol_rate(hot), 0.0);
+}
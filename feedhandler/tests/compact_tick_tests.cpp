@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "common/compact_tick.hpp"
+#include "common/tick.hpp"
+#include "parser/fsm_fix_parser.hpp"
+#include "parser/stringview_fix_parser.hpp"
+#include "parser/optimized_fix_parser.hpp"
+#include "parser/repeating_group_parser.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace feedhandler::common;
+using namespace feedhandler::parser;
+
+static_assert(sizeof(CompactTick) == 32, "CompactTick should be exactly 32 bytes");
+
+TEST(CompactTickTest, RoundTripThroughTick) {
+    Tick tick;
+    tick.copy_symbol("AMZN");
+    tick.price = double_to_price(180.25);
+    tick.qty = 300;
+    tick.side = 'S';
+    tick.timestamp = 12345;
+
+    CompactTick compact = tick.to_compact();
+    EXPECT_EQ(compact.instrument_id, SymbolTable::global().find("AMZN"));
+    EXPECT_EQ(compact.symbol(), "AMZN");
+    EXPECT_TRUE(compact.is_valid());
+
+    Tick back = Tick::from_compact(compact);
+    EXPECT_EQ(back.symbol, "AMZN");
+    EXPECT_EQ(back.price, tick.price);
+    EXPECT_EQ(back.qty, tick.qty);
+    EXPECT_EQ(back.side, tick.side);
+    EXPECT_EQ(back.timestamp, tick.timestamp);
+    EXPECT_EQ(back.instrument_id, compact.instrument_id);
+}
+
+TEST(CompactTickTest, DefaultIsInvalid) {
+    CompactTick compact;
+    EXPECT_FALSE(compact.is_valid());
+    EXPECT_TRUE(compact.symbol().empty());
+}
+
+TEST(CompactTickTest, FSMParserEmitsCompactTicks) {
+    FSMFixParser parser;
+    std::vector<CompactTick> compact;
+    std::vector<Tick> ticks;
+
+    std::string msg = "8=FIX.4.4|55=TSLA|44=250.50|38=100|54=1|10=000|"
+                      "8=FIX.4.4|55=MSFT|44=410.00|38=50|54=2|10=000|";
+    parser.parse(msg.data(), msg.size(), compact);
+    FSMFixParser().parse(msg.data(), msg.size(), ticks);
+
+    ASSERT_EQ(compact.size(), 2u);
+    ASSERT_EQ(ticks.size(), 2u);
+    for (size_t i = 0; i < compact.size(); ++i) {
+        EXPECT_EQ(compact[i].instrument_id, ticks[i].instrument_id);
+        EXPECT_EQ(compact[i].price, ticks[i].price);
+        EXPECT_EQ(compact[i].qty, ticks[i].qty);
+        EXPECT_EQ(compact[i].side, ticks[i].side);
+    }
+    EXPECT_EQ(compact[1].symbol(), "MSFT");
+}
+
+TEST(CompactTickTest, StringViewAndOptimizedParsersAgree) {
+    std::string buffer = "8=FIX.4.4|55=AAPL|44=150.25|38=500|54=1|52=20240131-12:34:56|\n"
+                         "8=FIX.4.4|55=GOOG|44=140.75|38=200|54=2|52=20240131-12:34:57|";
+
+    std::vector<CompactTick> a;
+    std::vector<CompactTick> b;
+    EXPECT_EQ(StringViewFixParser::parse_messages_from_buffer(buffer, a), 2u);
+    EXPECT_EQ(OptimizedFixParser::parse_messages_from_buffer(buffer, b), 2u);
+
+    ASSERT_EQ(a.size(), 2u);
+    ASSERT_EQ(b.size(), 2u);
+    EXPECT_EQ(a[0].symbol(), "AAPL");
+    EXPECT_EQ(a[0].price, double_to_price(150.25));
+    EXPECT_EQ(a[1].side, 'S');
+    EXPECT_EQ(b[1].symbol(), "GOOG");
+    EXPECT_EQ(b[1].qty, 200);
+}
+
+TEST(CompactTickTest, RepeatingGroupsAppendCompactTicks) {
+    std::string msg = "8=FIX.4.4|35=W|55=NFLX|268=2|"
+                      "269=0|270=600.00|271=10|"
+                      "269=1|270=600.50|271=20|";
+
+    std::vector<CompactTick> compact;
+    compact.push_back(CompactTick());  // Existing contents are kept
+    EXPECT_EQ(RepeatingGroupParser::parse_repeating_groups(msg, compact), 2u);
+
+    ASSERT_EQ(compact.size(), 3u);
+    EXPECT_EQ(compact[1].side, 'B');
+    EXPECT_EQ(compact[2].side, 'S');
+    EXPECT_EQ(compact[2].qty, 20);
+    EXPECT_EQ(compact[1].instrument_id, compact[2].instrument_id);
+    EXPECT_EQ(compact[1].symbol(), "NFLX");
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "threading/conflation_buffer.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::threading;
+
+namespace {
+
+common::Tick make_tick(common::InstrumentId id, char side, int64_t price, int32_t qty, uint64_t timestamp) {
+    common::Tick tick;
+    tick.instrument_id = id;
+    tick.side = side;
+    tick.price = price;
+    tick.qty = qty;
+    tick.timestamp = timestamp;
+    return tick;
+}
+
+} // namespace
+
+TEST(ConflationBufferTest, DrainReturnsLatestQuotePerInstrument) {
+    ConflationBuffer buffer(200);
+    buffer.update(make_tick(7, 'B', 1000, 10, 1));
+    buffer.update(make_tick(7, 'B', 1010, 20, 2));
+    buffer.update(make_tick(7, 'S', 1020, 30, 3));
+    buffer.update(make_tick(130, 'S', 5000, 1, 4));
+
+    std::vector<ConflatedQuote> quotes;
+    EXPECT_EQ(buffer.drain(quotes), 2u);
+    ASSERT_EQ(quotes.size(), 2u);
+    EXPECT_EQ(quotes[0].instrument_id, 7u);  // Instrument order
+    EXPECT_EQ(quotes[0].bid_price, 1010);
+    EXPECT_EQ(quotes[0].bid_qty, 20);
+    EXPECT_EQ(quotes[0].ask_price, 1020);
+    EXPECT_EQ(quotes[0].timestamp, 3u);
+    EXPECT_EQ(quotes[0].updates, 3u);
+    EXPECT_EQ(quotes[1].instrument_id, 130u);
+    EXPECT_EQ(quotes[1].bid_price, 0);
+    EXPECT_EQ(quotes[1].ask_price, 5000);
+    EXPECT_EQ(buffer.conflated(), 2u);
+
+    // Nothing changed since: nothing to drain, state still readable
+    quotes.clear();
+    EXPECT_EQ(buffer.drain(quotes), 0u);
+    ConflatedQuote quote;
+    ASSERT_TRUE(buffer.read(7, quote));
+    EXPECT_EQ(quote.bid_price, 1010);
+
+    buffer.update(make_tick(7, 'S', 1015, 5, 5));
+    EXPECT_EQ(buffer.drain(quotes), 1u);
+    EXPECT_EQ(quotes[0].bid_price, 1010);  // Other side kept
+    EXPECT_EQ(quotes[0].ask_price, 1015);
+}
+
+TEST(ConflationBufferTest, RejectsUnknownInstruments) {
+    ConflationBuffer buffer(10);
+    EXPECT_FALSE(buffer.update(make_tick(10, 'B', 1, 1, 1)));
+    EXPECT_FALSE(buffer.update(make_tick(common::INVALID_INSTRUMENT, 'B', 1, 1, 1)));
+    EXPECT_EQ(buffer.rejected(), 2u);
+
+    ConflatedQuote quote;
+    EXPECT_FALSE(buffer.read(10, quote));
+    std::vector<ConflatedQuote> quotes;
+    EXPECT_EQ(buffer.drain(quotes), 0u);
+}
+
+TEST(ConflationBufferTest, SlowConsumerSeesConsistentLatestState) {
+    // Producer writes price == qty == timestamp so a torn read is detectable
+    constexpr uint64_t count = 200000;
+    constexpr size_t instruments = 100;
+    ConflationBuffer buffer(instruments);
+    std::atomic<bool> done{false};
+
+    std::thread producer([&] {
+        for (uint64_t i = 1; i <= count; ++i) {
+            buffer.update(make_tick(static_cast<common::InstrumentId>(i % instruments), 'B',
+                                    static_cast<int64_t>(i), static_cast<int32_t>(i), i));
+        }
+        done.store(true);
+    });
+
+    uint64_t torn = 0;
+    std::vector<uint64_t> last(instruments, 0);
+    auto check = [&](const ConflatedQuote& quote) {
+        if (quote.bid_price != static_cast<int64_t>(quote.timestamp) ||
+            quote.bid_qty != static_cast<int64_t>(quote.timestamp) || quote.timestamp < last[quote.instrument_id]) {
+            ++torn;
+        }
+        last[quote.instrument_id] = quote.timestamp;
+    };
+    while (!done.load()) {
+        buffer.drain(check);
+        std::this_thread::yield();
+    }
+    producer.join();
+    buffer.drain(check);
+
+    EXPECT_EQ(torn, 0u);
+    for (size_t id = 0; id < instruments; ++id) {
+        EXPECT_EQ(last[id], count - (count - id) % instruments);  // Final update always delivered
+    }
+}
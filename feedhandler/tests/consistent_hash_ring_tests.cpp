@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "distributed/consistent_hash_ring.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+namespace {
+
+std::vector<std::string> keys(size_t count) {
+    std::vector<std::string> result;
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back("AAPL." + std::to_string(i));
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(ConsistentHashRingTest, EmptyRingHasNoOwner) {
+    ConsistentHashRing ring;
+    std::vector<const std::string*> replicas;
+    EXPECT_EQ(ring.node_for("key"), nullptr);
+    EXPECT_EQ(ring.nodes_for("key", 2, replicas), 0u);
+    EXPECT_FALSE(ring.remove_node("missing"));
+    EXPECT_THROW(ConsistentHashRing(0), std::invalid_argument);
+}
+
+TEST(ConsistentHashRingTest, KeysSpreadEvenlyAndPlacementIgnoresJoinOrder) {
+    ConsistentHashRing forward;
+    ConsistentHashRing backward;
+    const std::vector<std::string> nodes = {"node-a", "node-b", "node-c", "node-d"};
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        EXPECT_TRUE(forward.add_node(nodes[i]));
+        EXPECT_TRUE(backward.add_node(nodes[nodes.size() - 1 - i]));
+    }
+    EXPECT_FALSE(forward.add_node("node-a"));
+
+    std::unordered_map<std::string, size_t> load;
+    const auto all = keys(20000);
+    for (const auto& key : all) {
+        const std::string* owner = forward.node_for(key);
+        ASSERT_NE(owner, nullptr);
+        EXPECT_EQ(*owner, *backward.node_for(key));
+        load[*owner]++;
+    }
+    for (const auto& node : nodes) {
+        // 128 virtual nodes keep every node within 25% of its fair share
+        EXPECT_GT(load[node], all.size() / nodes.size() * 3 / 4) << node;
+        EXPECT_LT(load[node], all.size() / nodes.size() * 5 / 4) << node;
+    }
+}
+
+TEST(ConsistentHashRingTest, RemovingANodeMovesOnlyItsKeysToTheirNextReplica) {
+    ConsistentHashRing ring;
+    for (const char* node : {"node-a", "node-b", "node-c", "node-d"}) {
+        ring.add_node(node);
+    }
+    const auto all = keys(5000);
+    std::vector<std::string> owners;
+    std::vector<std::string> successors;
+    std::vector<const std::string*> replicas;
+    for (const auto& key : all) {
+        ASSERT_EQ(ring.nodes_for(key, 2, replicas), 2u);
+        EXPECT_EQ(replicas[0], ring.node_for(key));  // Owner first
+        EXPECT_NE(*replicas[0], *replicas[1]);
+        owners.push_back(*replicas[0]);
+        successors.push_back(*replicas[1]);
+    }
+
+    ASSERT_TRUE(ring.remove_node("node-b"));
+    EXPECT_EQ(ring.node_count(), 3u);
+    EXPECT_FALSE(ring.contains("node-b"));
+    for (size_t i = 0; i < all.size(); ++i) {
+        const std::string& owner = *ring.node_for(all[i]);
+        EXPECT_EQ(owner, owners[i] == "node-b" ? successors[i] : owners[i]) << all[i];
+    }
+    EXPECT_EQ(ring.nodes_for("key", 10, replicas), 3u);
+}
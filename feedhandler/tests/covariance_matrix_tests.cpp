@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "analytics/covariance_matrix.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace feedhandler::analytics;
+
+namespace {
+
+using Rows = std::vector<std::vector<double>>;
+
+// Statistics recomputed from scratch over the last window rows
+double reference_covariance(const Rows& rows, size_t i, size_t j) {
+    double n = static_cast<double>(rows.size());
+    double mean_i = 0, mean_j = 0;
+    for (const auto& row : rows) {
+        mean_i += row[i];
+        mean_j += row[j];
+    }
+    mean_i /= n;
+    mean_j /= n;
+    double cov = 0;
+    for (const auto& row : rows) {
+        cov += (row[i] - mean_i) * (row[j] - mean_j);
+    }
+    return cov / (n - 1);
+}
+
+double reference_correlation(const Rows& rows, size_t i, size_t j) {
+    return reference_covariance(rows, i, j) /
+           std::sqrt(reference_covariance(rows, i, i) * reference_covariance(rows, j, j));
+}
+
+double reference_beta(const Rows& rows, size_t i, size_t columns) {
+    Rows with_market = rows;
+    for (auto& row : with_market) {
+        double market = 0;
+        for (size_t k = 0; k < columns; ++k) {
+            market += row[k];
+        }
+        row.push_back(market / static_cast<double>(columns));
+    }
+    return reference_covariance(with_market, i, columns) / reference_covariance(with_market, columns, columns);
+}
+
+} // namespace
+
+TEST(CovarianceMatrixTest, MatchesRecomputationAsRowsAreEvicted) {
+    constexpr size_t COLUMNS = 11;  // Not a multiple of the vector width
+    constexpr size_t WINDOW = 40;
+    CovarianceMatrix matrix(COLUMNS, WINDOW);
+    std::mt19937 rng(9);
+    std::normal_distribution<double> noise(0.0, 0.001);
+
+    Rows all;
+    for (int step = 0; step < 300; ++step) {  // Several rebuilds
+        double market = noise(rng);
+        std::vector<double> row(COLUMNS);
+        for (size_t i = 0; i < COLUMNS; ++i) {
+            row[i] = (i % 2 ? -1.0 : 1.0) * market * static_cast<double>(1 + i % 3) + 0.5 * noise(rng);
+        }
+        all.push_back(row);
+        matrix.push(row.data(), COLUMNS);
+
+        if (step < 2 || step % 13 != 0) {
+            continue;
+        }
+        size_t n = std::min(all.size(), WINDOW);
+        Rows last(all.end() - static_cast<std::ptrdiff_t>(n), all.end());
+        ASSERT_EQ(matrix.samples(), n);
+        for (size_t i = 0; i < COLUMNS; ++i) {
+            for (size_t j = 0; j < COLUMNS; ++j) {
+                EXPECT_NEAR(matrix.covariance(i, j), reference_covariance(last, i, j), 1e-15);
+                EXPECT_NEAR(matrix.correlation(i, j), reference_correlation(last, i, j), 1e-9);
+            }
+            EXPECT_NEAR(matrix.beta(i), reference_beta(last, i, COLUMNS), 1e-9);
+        }
+    }
+
+    // Same-sign columns move together, opposite ones against each other
+    EXPECT_GT(matrix.correlation(0, 2), 0.5);
+    EXPECT_LT(matrix.correlation(0, 1), -0.5);
+    EXPECT_DOUBLE_EQ(matrix.correlation(3, 3), 1.0);
+
+    std::vector<double> row(COLUMNS);
+    matrix.correlation_row(4, row.data());
+    EXPECT_DOUBLE_EQ(row[7], matrix.correlation(4, 7));
+}
+
+TEST(CovarianceMatrixTest, ColumnsJoinWithZeroHistory) {
+    CovarianceMatrix matrix(4, 8);
+    EXPECT_EQ(matrix.columns(), 0u);
+    EXPECT_EQ(matrix.correlation(0, 1), 0.0);
+
+    Rows all;
+    for (int step = 0; step < 20; ++step) {
+        double x = step % 2 ? 0.01 : -0.02;
+        size_t columns = step < 5 ? 2 : 3;  // Third column joins late
+        std::vector<double> row = {x, 2 * x, columns == 3 ? -x : 0.0};
+        all.push_back(row);
+        matrix.push(row.data(), columns);
+    }
+    EXPECT_EQ(matrix.columns(), 3u);
+    // Narrower pushes never shrink the active width
+    std::vector<double> row = {0.01, 0.02, -0.01};
+    all.push_back(row);
+    matrix.push(row.data(), 1);
+    all.back()[1] = all.back()[2] = 0.0;  // Only the first value was read
+    EXPECT_EQ(matrix.columns(), 3u);
+
+    Rows last(all.end() - 8, all.end());
+    EXPECT_NEAR(matrix.correlation(0, 2), reference_correlation(last, 0, 2), 1e-9);
+    EXPECT_NEAR(matrix.beta(1), reference_beta(last, 1, 3), 1e-9);
+}
+
+TEST(CovarianceMatrixTest, ConstantColumnsHaveNoCorrelation) {
+    CovarianceMatrix matrix(3, 16);
+    for (int step = 0; step < 50; ++step) {
+        std::vector<double> row = {0.0, 0.0005, step % 2 ? 0.001 : -0.001};
+        matrix.push(row.data(), 3);
+    }
+    EXPECT_EQ(matrix.correlation(0, 2), 0.0);
+    EXPECT_EQ(matrix.correlation(1, 2), 0.0);  // Constant but non-zero
+    EXPECT_EQ(matrix.beta(0), 0.0);
+    EXPECT_NEAR(matrix.beta(2), 3.0, 1e-9);  // Only column 2 moves the average
+
+    matrix.clear();
+    EXPECT_EQ(matrix.samples(), 0u);
+    EXPECT_EQ(matrix.columns(), 0u);
+    EXPECT_EQ(matrix.covariance(2, 2), 0.0);
+}
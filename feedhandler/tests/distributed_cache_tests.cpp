@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include "distributed/cluster_computing.hpp"
+
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+namespace {
+
+ClusterManager::NodeInfo loopback_node() {
+    ClusterManager::NodeInfo node{};
+    node.ip_address = "127.0.0.1";
+    node.port = 0;
+    node.is_healthy = true;
+    return node;
+}
+
+ClusterManager::NodeInfo info_of(const ClusterManager& cluster) {
+    for (const auto& node : cluster.get_cluster_status().node_details) {
+        if (node.node_id == cluster.local_node_id()) {
+            return node;
+        }
+    }
+    return {};
+}
+
+ClusterManager::ClusterConfig cluster_config() {
+    static int counter = 0;
+    ClusterManager::ClusterConfig config;
+    config.cluster_name = "cache" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+    return config;
+}
+
+std::vector<uint8_t> bytes(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+// Dispatches a node's inbound frames in the background, as its event loop would
+class Poller {
+public:
+    explicit Poller(ClusterManager& cluster) : thread_([this, &cluster] {
+        while (running_.load()) {
+            cluster.poll_messages(1);
+        }
+    }) {}
+    ~Poller() {
+        running_.store(false);
+        thread_.join();
+    }
+
+private:
+    std::atomic<bool> running_{true};
+    std::thread thread_;
+};
+
+// Two co-located nodes, each with a cache
+struct TwoNodes {
+    explicit TwoNodes(DistributedCache::CacheConfig cache_config)
+        : config(cluster_config()), a(config), b(config) {
+        EXPECT_TRUE(a.join_cluster(loopback_node()).first);
+        EXPECT_TRUE(b.join_cluster(loopback_node()).first);
+        EXPECT_TRUE(a.join_cluster(info_of(b)).first);
+        EXPECT_TRUE(b.join_cluster(info_of(a)).first);
+        cache_a = std::make_unique<DistributedCache>(cache_config, a);
+        cache_b = std::make_unique<DistributedCache>(cache_config, b);
+    }
+
+    // First key whose owner is node
+    std::string key_owned_by(const std::string& node) {
+        for (int i = 0;; ++i) {
+            std::string key = "SYM" + std::to_string(i);
+            if (cache_a->owner_of(key) == node) {
+                return key;
+            }
+        }
+    }
+
+    ClusterManager::ClusterConfig config;
+    ClusterManager a;
+    ClusterManager b;
+    std::unique_ptr<DistributedCache> cache_a;
+    std::unique_ptr<DistributedCache> cache_b;
+};
+
+} // namespace
+
+TEST(DistributedCacheTest, SingleNodeReadsFillCallerBuffers) {
+    ClusterManager cluster(cluster_config());
+    ASSERT_TRUE(cluster.join_cluster(loopback_node()).first);
+    DistributedCache cache(DistributedCache::CacheConfig{}, cluster);
+
+    ASSERT_TRUE(cache.put("AAPL", bytes("190.25")));
+    std::vector<uint8_t> out;
+    out.reserve(64);
+    const uint8_t* storage = out.data();
+    ASSERT_TRUE(cache.get(std::string_view("AAPL"), out));
+    EXPECT_EQ(out, bytes("190.25"));
+    EXPECT_EQ(out.data(), storage);
+
+    uint8_t buffer[4];
+    size_t length = 0;
+    EXPECT_FALSE(cache.get("AAPL", std::span<uint8_t>(buffer), length));
+    EXPECT_EQ(length, 6u);  // Found, but the buffer is short
+
+    EXPECT_EQ(cache.get(std::string("AAPL")), bytes("190.25"));
+    EXPECT_TRUE(cache.remove("AAPL"));
+    EXPECT_FALSE(cache.get("AAPL", out));
+
+    auto stats = cache.get_stats();
+    EXPECT_EQ(stats.put_operations, 1u);
+    EXPECT_EQ(stats.get_operations, 4u);
+    EXPECT_DOUBLE_EQ(stats.hit_rate, 0.75);
+    EXPECT_EQ(stats.total_keys, 0u);
+
+    DistributedCache::CacheConfig bad;
+    bad.consistency_level = "linearizable";
+    EXPECT_THROW(DistributedCache(bad, cluster), std::invalid_argument);
+}
+
+TEST(DistributedCacheTest, CompressesLargeValuesAndDeltaEncodesTicks) {
+    ClusterManager cluster(cluster_config());
+    ASSERT_TRUE(cluster.join_cluster(loopback_node()).first);
+    DistributedCache cache(DistributedCache::CacheConfig{}, cluster);
+
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text += "8=FIX.4.4|35=W|55=MSFT|270=415." + std::to_string(i % 10) + "|271=100|";
+    }
+    ASSERT_TRUE(cache.put("snapshot", bytes(text)));
+    EXPECT_GT(cache.get_stats().compression_ratio, 4.0);
+
+    std::vector<uint8_t> out;
+    ASSERT_TRUE(cache.get(std::string_view("snapshot"), out));
+    EXPECT_EQ(out, bytes(text));
+    std::vector<uint8_t> buffer(text.size());
+    size_t length = 0;
+    EXPECT_FALSE(cache.get("snapshot", std::span<uint8_t>(buffer.data(), 16), length));
+    EXPECT_EQ(length, text.size());  // Original size, known without decompressing
+    ASSERT_TRUE(cache.get("snapshot", std::span<uint8_t>(buffer), length));
+    EXPECT_EQ(buffer, bytes(text));
+
+    std::vector<feedhandler::common::CompactTick> ticks(1000);
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        ticks[i].instrument_id = static_cast<uint32_t>(i % 3);
+        ticks[i].price = 1902500 + static_cast<int64_t>(i % 7) * 100;
+        ticks[i].timestamp = 1700000000000000000ull + i * 1000;
+        ticks[i].qty = 100;
+        ticks[i].side = 'B';
+    }
+    ASSERT_TRUE(cache.put_ticks("ticks", ticks));
+    std::vector<feedhandler::common::CompactTick> decoded;
+    ASSERT_TRUE(cache.get_ticks("ticks", decoded));
+    ASSERT_EQ(decoded.size(), ticks.size());
+    EXPECT_EQ(decoded[999].timestamp, ticks[999].timestamp);
+    EXPECT_EQ(decoded[999].price, ticks[999].price);
+    EXPECT_EQ(decoded[999].instrument_id, 0u);
+    EXPECT_GT(cache.get_stats().compression_ratio, 10.0);  // Against the 32-byte ticks
+
+    std::vector<feedhandler::storage::BookLevel> levels = {{1902500, 300}, {1902400, 500}, {1902300, 100}};
+    ASSERT_TRUE(cache.put_levels("book", levels));
+    std::vector<feedhandler::storage::BookLevel> book;
+    ASSERT_TRUE(cache.get_levels("book", book));
+    ASSERT_EQ(book.size(), 3u);
+    EXPECT_EQ(book[2].price, 1902300);
+    EXPECT_EQ(book[1].quantity, 500);
+    EXPECT_FALSE(cache.get_ticks("missing", decoded));
+}
+
+TEST(DistributedCacheTest, RemoteReadsGoThroughTheNearCache) {
+    DistributedCache::CacheConfig config;
+    config.replication_factor = 1;
+    config.near_cache_ttl_ms = 60000;
+    config.remote_timeout_ms = 1000;
+    TwoNodes nodes(config);
+    Poller poll_b(nodes.b);
+
+    std::string key = nodes.key_owned_by(nodes.b.local_node_id());
+    ASSERT_TRUE(nodes.cache_b->put(key, bytes("owned by b")));
+
+    std::vector<uint8_t> out;
+    ASSERT_TRUE(nodes.cache_a->get(std::string_view(key), out));
+    EXPECT_EQ(out, bytes("owned by b"));
+    EXPECT_EQ(nodes.cache_a->get_stats().remote_gets, 1u);
+
+    uint8_t buffer[32];
+    size_t length = 0;
+    ASSERT_TRUE(nodes.cache_a->get(key, std::span<uint8_t>(buffer), length));
+    EXPECT_EQ(std::string(reinterpret_cast<char*>(buffer), length), "owned by b");
+    auto stats = nodes.cache_a->get_stats();
+    EXPECT_EQ(stats.remote_gets, 1u);
+    EXPECT_EQ(stats.near_cache_hits, 1u);
+    EXPECT_EQ(stats.total_keys, 0u);  // Nothing stored on a
+
+    std::string missing = nodes.key_owned_by(nodes.b.local_node_id()) + "x";
+    while (nodes.cache_a->owner_of(missing) != nodes.b.local_node_id()) {
+        missing += "x";
+    }
+    EXPECT_FALSE(nodes.cache_a->get(std::string_view(missing), out));
+}
+
+TEST(DistributedCacheTest, StrongConsistencyAlwaysAsksTheOwner) {
+    DistributedCache::CacheConfig config;
+    config.replication_factor = 1;
+    config.consistency_level = "strong";
+    config.remote_timeout_ms = 1000;
+    TwoNodes nodes(config);
+    Poller poll_b(nodes.b);
+
+    std::string key = nodes.key_owned_by(nodes.b.local_node_id());
+    ASSERT_TRUE(nodes.cache_a->put(key, bytes("v1")));  // Written through to b
+    std::vector<uint8_t> out;
+    ASSERT_TRUE(nodes.cache_a->get(std::string_view(key), out));
+    EXPECT_EQ(out, bytes("v1"));
+    ASSERT_TRUE(nodes.cache_b->put(key, bytes("v2")));
+    ASSERT_TRUE(nodes.cache_a->get(std::string_view(key), out));
+    EXPECT_EQ(out, bytes("v2"));
+    EXPECT_EQ(nodes.cache_a->get_stats().remote_gets, 2u);
+    EXPECT_EQ(nodes.cache_a->get_stats().near_cache_hits, 0u);
+}
+
+TEST(DistributedCacheTest, ReplicasKeepKeysReadableWhenANodeLeaves) {
+    DistributedCache::CacheConfig config;
+    config.replication_factor = 2;
+    TwoNodes nodes(config);
+    {
+        Poller poll_b(nodes.b);
+        for (int i = 0; i < 50; ++i) {
+            ASSERT_TRUE(nodes.cache_a->put("SYM" + std::to_string(i), bytes(std::to_string(i))));
+        }
+        EXPECT_EQ(nodes.cache_a->get_stats().total_keys, 50u);  // Every key has a replica here
+    }
+
+    nodes.a.leave_cluster(nodes.b.local_node_id());
+    std::vector<uint8_t> out;
+    for (int i = 0; i < 50; ++i) {
+        std::string key = "SYM" + std::to_string(i);
+        EXPECT_EQ(nodes.cache_a->owner_of(key), nodes.a.local_node_id());
+        ASSERT_TRUE(nodes.cache_a->get(std::string_view(key), out)) << key;
+        EXPECT_EQ(out, bytes(std::to_string(i)));
+    }
+    EXPECT_EQ(nodes.cache_a->get_stats().remote_gets, 0u);
+}
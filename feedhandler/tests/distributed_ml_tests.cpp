@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include "distributed/cluster_computing.hpp"
+
+#include <unistd.h>
+#include <cmath>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+namespace {
+
+ClusterManager::NodeInfo loopback_node() {
+    ClusterManager::NodeInfo node{};
+    node.ip_address = "127.0.0.1";
+    node.port = 0;
+    node.is_healthy = true;
+    return node;
+}
+
+ClusterManager::NodeInfo info_of(const ClusterManager& cluster) {
+    for (const auto& node : cluster.get_cluster_status().node_details) {
+        if (node.node_id == cluster.local_node_id()) {
+            return node;
+        }
+    }
+    return {};
+}
+
+// count co-located nodes that all know each other, each with a DistributedML
+struct Ring {
+    Ring(size_t count, DistributedML::TrainingConfig ml_config, bool shared_memory = true,
+         size_t shm_channel_bytes = 1 << 20) {
+        static int counter = 0;
+        ClusterManager::ClusterConfig config;
+        config.cluster_name = "ml" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+        config.shared_memory_transport = shared_memory;
+        config.shm_channel_bytes = shm_channel_bytes;
+        for (size_t i = 0; i < count; ++i) {
+            clusters.push_back(std::make_unique<ClusterManager>(config));
+            EXPECT_TRUE(clusters.back()->join_cluster(loopback_node()).first);
+        }
+        for (auto& cluster : clusters) {
+            for (auto& peer : clusters) {
+                if (peer != cluster) {
+                    EXPECT_TRUE(cluster->join_cluster(info_of(*peer)).first);
+                }
+            }
+        }
+        for (auto& cluster : clusters) {
+            ml.push_back(std::make_unique<DistributedML>(ml_config, *cluster));
+        }
+    }
+
+    // Every node all-reduces its own gradient on its own thread
+    std::vector<bool> all_reduce(std::vector<std::vector<double>>& gradients) {
+        std::vector<std::future<bool>> results;
+        for (size_t i = 0; i < ml.size(); ++i) {
+            results.push_back(std::async(std::launch::async, [this, i, &gradients] {
+                return ml[i]->all_reduce(gradients[i]);
+            }));
+        }
+        std::vector<bool> ok;
+        for (auto& result : results) {
+            ok.push_back(result.get());
+        }
+        return ok;
+    }
+
+    std::vector<std::unique_ptr<ClusterManager>> clusters;
+    std::vector<std::unique_ptr<DistributedML>> ml;
+};
+
+std::vector<std::vector<double>> make_gradients(size_t nodes, size_t length) {
+    std::vector<std::vector<double>> gradients(nodes, std::vector<double>(length));
+    for (size_t n = 0; n < nodes; ++n) {
+        for (size_t i = 0; i < length; ++i) {
+            gradients[n][i] = std::sin(static_cast<double>(i * (n + 1))) * 0.01 + static_cast<double>(n) * 1e-3;
+        }
+    }
+    return gradients;
+}
+
+std::vector<double> mean_of(const std::vector<std::vector<double>>& gradients) {
+    std::vector<double> mean(gradients.front().size(), 0.0);
+    for (const auto& gradient : gradients) {
+        for (size_t i = 0; i < mean.size(); ++i) {
+            mean[i] += gradient[i] / static_cast<double>(gradients.size());
+        }
+    }
+    return mean;
+}
+
+DistributedML::TrainingConfig ml_config(GradientCompression compression, size_t segment_bytes = 32 * 1024) {
+    DistributedML::TrainingConfig config;
+    config.use_parameter_server = false;
+    config.gradient_compression = compression;
+    config.allreduce_segment_bytes = segment_bytes;
+    return config;
+}
+
+void expect_mean(size_t nodes, GradientCompression compression, double tolerance, bool shared_memory) {
+    Ring ring(nodes, ml_config(compression, 512), shared_memory);
+    auto gradients = make_gradients(nodes, 1001);  // Uneven chunks, several segments each
+    const auto expected = mean_of(gradients);
+    for (bool ok : ring.all_reduce(gradients)) {
+        EXPECT_TRUE(ok);
+    }
+    for (size_t n = 0; n < nodes; ++n) {
+        EXPECT_EQ(gradients[n], gradients[0]) << "node " << n << " disagrees";
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(gradients[n][i], expected[i], tolerance) << i;
+        }
+    }
+    auto stats = ring.ml[0]->get_allreduce_stats();
+    EXPECT_EQ(stats.rounds_completed, 1u);
+    // Each node sends 2 (N - 1) / N of the gradient, give or take a value per step
+    EXPECT_NEAR(static_cast<double>(stats.raw_bytes), 2.0 * (nodes - 1) * 1001 * sizeof(double) / nodes,
+                2.0 * (nodes - 1) * sizeof(double));
+    EXPECT_EQ(stats.bytes_sent, stats.raw_bytes / sizeof(double) * gradient_value_bytes(compression));
+}
+
+} // namespace
+
+TEST(DistributedMLTest, RingAllReduceAveragesOverTcp) {
+    expect_mean(3, GradientCompression::NONE, 1e-15, false);
+}
+
+TEST(DistributedMLTest, RingAllReduceAveragesOverSharedMemory) {
+    expect_mean(4, GradientCompression::NONE, 1e-15, true);
+}
+
+TEST(DistributedMLTest, CompressedRoundsAgreeOnEveryNode) {
+    expect_mean(3, GradientCompression::FP16, 2e-5, true);
+    expect_mean(3, GradientCompression::INT8, 3e-4, true);
+}
+
+TEST(DistributedMLTest, AsyncRoundsKeepCallOrderAndSurviveFullRings) {
+    // A 16 KB ring per direction forces dropped batches and resends
+    Ring ring(3, ml_config(GradientCompression::NONE, 4096), true, 16 * 1024);
+    auto first = make_gradients(3, 20000);
+    auto second = make_gradients(3, 300);
+    for (auto& gradient : second) {
+        for (double& value : gradient) {
+            value *= -2.0;
+        }
+    }
+    const auto first_mean = mean_of(first);
+    const auto second_mean = mean_of(second);
+
+    std::vector<std::thread> workers;
+    for (size_t n = 0; n < 3; ++n) {
+        workers.emplace_back([&, n] {
+            auto a = ring.ml[n]->all_reduce_async(first[n]);
+            auto b = ring.ml[n]->all_reduce_async(second[n]);  // Queued behind a
+            EXPECT_TRUE(a.get());
+            EXPECT_TRUE(b.get());
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (size_t n = 0; n < 3; ++n) {
+        for (size_t i = 0; i < first_mean.size(); ++i) {
+            ASSERT_NEAR(first[n][i], first_mean[i], 1e-15);
+        }
+        for (size_t i = 0; i < second_mean.size(); ++i) {
+            ASSERT_NEAR(second[n][i], second_mean[i], 1e-15);
+        }
+    }
+    EXPECT_EQ(ring.ml[0]->get_allreduce_stats().rounds_completed, 2u);
+}
+
+TEST(DistributedMLTest, MissingPeerTimesOutAndSingleNodeIsIdentity) {
+    auto config = ml_config(GradientCompression::NONE);
+    config.allreduce_timeout_ms = 20;
+    Ring ring(2, config);
+    std::vector<double> gradient{1.0, 2.0, 3.0};
+    EXPECT_FALSE(ring.ml[0]->all_reduce(gradient));  // Peer never joins the round
+    EXPECT_EQ(ring.ml[0]->get_allreduce_stats().rounds_failed, 1u);
+
+    Ring alone(1, ml_config(GradientCompression::INT8));
+    std::vector<double> own{1.0, 2.0, 3.0};
+    EXPECT_TRUE(alone.ml[0]->all_reduce(own));
+    EXPECT_EQ(own, (std::vector<double>{1.0, 2.0, 3.0}));
+
+    config.allreduce_segment_bytes = 0;
+    EXPECT_THROW(DistributedML(config, *ring.clusters[0]), std::invalid_argument);
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "net/event_loop.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace feedhandler::net;
+
+namespace {
+
+// Non-blocking connected socket pair, closed on destruction
+struct SocketPair {
+    int fds[2] = {-1, -1};
+
+    SocketPair() {
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0) {
+            fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+        }
+    }
+    ~SocketPair() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    int reader() const { return fds[0]; }
+    void send(const char* data) { ASSERT_GT(::write(fds[1], data, strlen(data)), 0); }
+    void drain() {
+        char buf[256];
+        while (::read(fds[0], buf, sizeof(buf)) > 0) {}
+    }
+};
+
+EventLoopConfig config_for(EventBackend backend) {
+    EventLoopConfig config;
+    config.backend = backend;
+    return config;
+}
+
+} // namespace
+
+class EventLoopBackendTest : public ::testing::TestWithParam<EventBackend> {};
+
+TEST_P(EventLoopBackendTest, TimeoutWithoutData) {
+    EventLoop loop(config_for(GetParam()));
+    SocketPair pair;
+    ASSERT_TRUE(loop.add_socket(pair.reader()));
+
+    EXPECT_FALSE(loop.run_once(10));
+    EXPECT_FALSE(loop.is_readable(pair.reader()));
+}
+
+TEST_P(EventLoopBackendTest, DispatchesCallbackForReadableSocket) {
+    EventLoop loop(config_for(GetParam()));
+    SocketPair pair;
+
+    std::vector<int> calls;
+    ASSERT_TRUE(loop.add_socket(pair.reader(), [&](int sock) {
+        calls.push_back(sock);
+        pair.drain();
+    }));
+    EXPECT_FALSE(loop.add_socket(pair.reader()));  // Duplicate
+
+    pair.send("8=FIX.4.4|");
+    EXPECT_TRUE(loop.run_once(1000));
+    EXPECT_TRUE(loop.is_readable(pair.reader()));
+    ASSERT_EQ(loop.ready_sockets().size(), 1u);
+    EXPECT_EQ(calls, (std::vector<int>{pair.reader()}));
+
+    // Drained: nothing further to report
+    EXPECT_FALSE(loop.run_once(10));
+    EXPECT_EQ(calls.size(), 1u);
+
+    // New data is reported again
+    pair.send("10=000|");
+    EXPECT_TRUE(loop.run_once(1000));
+    EXPECT_EQ(calls.size(), 2u);
+}
+
+TEST_P(EventLoopBackendTest, RemovedSocketIsNotReported) {
+    EventLoop loop(config_for(GetParam()));
+    SocketPair pair;
+    ASSERT_TRUE(loop.add_socket(pair.reader()));
+    loop.remove_socket(pair.reader());
+    EXPECT_EQ(loop.socket_count(), 0u);
+
+    pair.send("data");
+    EXPECT_FALSE(loop.run_once(10));
+    EXPECT_FALSE(loop.is_readable(pair.reader()));
+}
+
+TEST_P(EventLoopBackendTest, CallbackMayRemoveOtherSockets) {
+    EventLoop loop(config_for(GetParam()));
+    SocketPair a;
+    SocketPair b;
+
+    int calls = 0;
+    auto on_read = [&](int sock) {
+        ++calls;
+        loop.remove_socket(sock == a.reader() ? b.reader() : a.reader());
+    };
+    ASSERT_TRUE(loop.add_socket(a.reader(), on_read));
+    ASSERT_TRUE(loop.add_socket(b.reader(), on_read));
+
+    a.send("x");
+    b.send("y");
+    // Both may be ready in one cycle, but only the first callback runs
+    for (int i = 0; i < 3 && loop.socket_count() == 2; ++i) {
+        loop.run_once(100);
+    }
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(loop.socket_count(), 1u);
+}
+
+TEST_P(EventLoopBackendTest, WritableWatchIsOneShot) {
+    EventLoop loop(config_for(GetParam()));
+    SocketPair pair;
+    EXPECT_FALSE(loop.watch_writable(pair.reader(), [](int) {}));  // Not registered
+
+    int reads = 0;
+    std::vector<int> writes;
+    ASSERT_TRUE(loop.add_socket(pair.reader(), [&](int) { ++reads; }));
+    ASSERT_TRUE(loop.watch_writable(pair.reader(), [&](int sock) { writes.push_back(sock); }));
+
+    // An idle socket pair is writable but has nothing to read
+    EXPECT_TRUE(loop.run_once(1000));
+    EXPECT_EQ(writes, (std::vector<int>{pair.reader()}));
+    EXPECT_EQ(reads, 0);
+    EXPECT_FALSE(loop.is_readable(pair.reader()));
+    EXPECT_FALSE(loop.run_once(10));
+    EXPECT_EQ(writes.size(), 1u);
+
+    // Re-armed, alongside a read
+    ASSERT_TRUE(loop.watch_writable(pair.reader(), [&](int sock) { writes.push_back(sock); }));
+    pair.send("x");
+    for (int i = 0; i < 3 && (reads == 0 || writes.size() < 2); ++i) {
+        loop.run_once(100);
+    }
+    EXPECT_EQ(reads, 1);
+    EXPECT_EQ(writes.size(), 2u);
+
+    // Removal drops a pending watch
+    pair.drain();
+    ASSERT_TRUE(loop.watch_writable(pair.reader(), [&](int sock) { writes.push_back(sock); }));
+    loop.remove_socket(pair.reader());
+    EXPECT_FALSE(loop.run_once(10));
+    EXPECT_EQ(writes.size(), 2u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, EventLoopBackendTest,
+                         ::testing::Values(EventBackend::SELECT, EventBackend::EPOLL,
+                                           EventBackend::IO_URING));
+
+TEST(EventLoopTest, EdgeTriggeredReportsOncePerArrival) {
+    EventLoop loop;  // Default: edge-triggered epoll
+    ASSERT_EQ(loop.backend(), EventBackend::EPOLL);
+    SocketPair pair;
+    ASSERT_TRUE(loop.add_socket(pair.reader()));
+
+    pair.send("unread");
+    EXPECT_TRUE(loop.run_once(1000));
+    // Data left unread: edge-triggered does not report it again
+    EXPECT_FALSE(loop.run_once(10));
+}
+
+TEST(EventLoopTest, LevelTriggeredReportsUntilDrained) {
+    EventLoopConfig config;
+    config.edge_triggered = false;
+    EventLoop loop(config);
+    SocketPair pair;
+    ASSERT_TRUE(loop.add_socket(pair.reader()));
+
+    pair.send("unread");
+    EXPECT_TRUE(loop.run_once(1000));
+    EXPECT_TRUE(loop.run_once(10));
+    pair.drain();
+    EXPECT_FALSE(loop.run_once(10));
+}
+
+TEST(EventLoopTest, InvalidSocketRejected) {
+    EventLoop loop;
+    EXPECT_FALSE(loop.add_socket(-1));
+    EXPECT_FALSE(loop.is_readable(-1));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
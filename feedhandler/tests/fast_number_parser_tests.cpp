@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include "parser/fast_number_parser.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace feedhandler::parser;
+
+namespace {
+
+// Digit strings of every length around the kernel boundaries, with and
+// without sign, fraction and trailing junk
+std::vector<std::string> sample_inputs() {
+    std::vector<std::string> inputs = {
+        "", "-", "+", ".", "-.", "0", "7", "-7", "+456", "abc", "a123", "123abc", "456 ",
+        "150.25", "-150.25", "0.0001", "99.99999", "1.", ".5", "12.34.56", "2147483647",
+        "2147483648", "-2147483648", "4294967295", "4294967296", "99999999999999999999",
+        "1e5", "12|", "38=500", "9\x01", "/", ":", "\xFA\xFB"
+    };
+
+    std::mt19937 rng(42);
+    const char tails[] = {'\0', '|', '\x01', '.', 'x', '/', ':', '\xFF'};
+    for (int length = 1; length <= 20; ++length) {
+        for (int round = 0; round < 20; ++round) {
+            std::string s;
+            if (round % 3 == 1) {
+                s += '-';
+            }
+            for (int i = 0; i < length; ++i) {
+                s += static_cast<char>('0' + rng() % 10);
+            }
+            if (round % 2 == 0) {
+                s += '.';
+                int fraction = static_cast<int>(rng() % 8);
+                for (int i = 0; i < fraction; ++i) {
+                    s += static_cast<char>('0' + rng() % 10);
+                }
+            }
+            char tail = tails[rng() % sizeof(tails)];
+            if (tail != '\0') {
+                s += tail;
+                s += "123";
+            }
+            inputs.push_back(s);
+        }
+    }
+    return inputs;
+}
+
+const char* end_of(const std::string& s) { return s.data() + s.size(); }
+
+} // namespace
+
+TEST(FastNumberParserTest, KernelMatchesBuild) {
+#if defined(__SSE4_1__)
+    EXPECT_EQ(FastNumberParser::kernel(), FastNumberParser::Kernel::SSE41);
+#elif defined(__x86_64__) || defined(__i386__)
+    // Baseline build: dispatched from cpuid
+    __builtin_cpu_init();
+    EXPECT_EQ(FastNumberParser::kernel() == FastNumberParser::Kernel::SSE41,
+              static_cast<bool>(__builtin_cpu_supports("sse4.1")));
+#elif defined(__ARM_NEON)
+    EXPECT_EQ(FastNumberParser::kernel(), FastNumberParser::Kernel::NEON);
+#else
+    EXPECT_NE(FastNumberParser::kernel(), FastNumberParser::Kernel::SSE41);
+#endif
+}
+
+TEST(FastNumberParserTest, ScanDigitsRunAndValue) {
+    std::string s = "1234567890123456789|";
+    auto run = FastNumberParser::scan_digits(s.data(), end_of(s));
+    EXPECT_EQ(run.length, 16u);
+    EXPECT_EQ(run.value, 1234567890123456ULL);
+
+    run = FastNumberParser::scan_digits(s.data(), end_of(s), 4);
+    EXPECT_EQ(run.length, 4u);
+    EXPECT_EQ(run.value, 1234u);
+
+    std::string price = "00150.25";
+    run = FastNumberParser::scan_digits(price.data(), end_of(price));
+    EXPECT_EQ(run.length, 5u);
+    EXPECT_EQ(run.value, 150u);
+
+    // Never looks past end, even when more digits follow in memory
+    run = FastNumberParser::scan_digits(s.data(), s.data() + 3);
+    EXPECT_EQ(run.length, 3u);
+    EXPECT_EQ(run.value, 123u);
+
+    run = FastNumberParser::scan_digits(s.data(), s.data());
+    EXPECT_EQ(run.length, 0u);
+}
+
+TEST(FastNumberParserTest, KnownValues) {
+    EXPECT_EQ(FastNumberParser::fast_atoi("500"), 500);
+    EXPECT_EQ(FastNumberParser::fast_atoi("-123"), -123);
+    EXPECT_EQ(FastNumberParser::fast_atoi("2147483647"), INT32_MAX);
+    EXPECT_EQ(FastNumberParser::fast_atoi("99999999999"), INT32_MAX);  // Saturates
+    EXPECT_EQ(FastNumberParser::fast_atou("4294967295"), UINT32_MAX);
+    EXPECT_EQ(FastNumberParser::fast_atof_fixed("150.25"), 1502500);
+    EXPECT_EQ(FastNumberParser::fast_atof_fixed("-0.0001"), -1);
+    EXPECT_EQ(FastNumberParser::fast_atof_fixed("1.23456789"), 12345);  // Extra digits dropped
+    EXPECT_EQ(FastNumberParser::fast_atof_fixed("42.5", 100), 4250);
+    EXPECT_EQ(FastNumberParser::fast_atof_fixed("42.5", 1), 42);
+}
+
+TEST(FastNumberParserTest, MatchesScalarPath) {
+    // (scale, safe budget of integer digits so integer * scale fits int64)
+    const std::pair<int64_t, size_t> scales[] = {
+        {1, 18}, {10, 17}, {100, 16}, {10000, 14}, {100000000, 10}, {1000000000000LL, 6}};
+    for (const auto& s : sample_inputs()) {
+        // Whole string and every prefix, so the end bound moves through each kernel lane
+        for (size_t n = 0; n <= s.size(); ++n) {
+            const char* b = s.data();
+            const char* e = s.data() + n;
+            ASSERT_EQ(FastNumberParser::fast_atoi(b, e), FastNumberParser::fast_atoi_scalar(b, e))
+                << '"' << s.substr(0, n) << '"';
+            ASSERT_EQ(FastNumberParser::fast_atou(b, e), FastNumberParser::fast_atou_scalar(b, e))
+                << '"' << s.substr(0, n) << '"';
+            for (const auto& [scale, max_digits] : scales) {
+                if (n > max_digits) {
+                    continue;  // Integer part * scale could overflow int64 in both paths
+                }
+                ASSERT_EQ(FastNumberParser::fast_atof_fixed(b, e, scale),
+                          FastNumberParser::fast_atof_fixed_scalar(b, e, scale))
+                    << '"' << s.substr(0, n) << "\" scale " << scale;
+            }
+        }
+    }
+}
+
+TEST(FastNumberParserTest, NeverReadsPastEnd) {
+    // Each field alone in an exact-size heap block (FEED_ASAN flags any
+    // overread), and again followed by digits that must not be picked up
+    for (const auto& s : sample_inputs()) {
+        for (size_t n = 0; n <= s.size(); ++n) {
+            const char* b = s.data();
+            const char* e = s.data() + n;
+            std::unique_ptr<char[]> exact(new char[n ? n : 1]);
+            std::copy(b, e, exact.get());
+            std::string padded = s.substr(0, n) + std::string(16, '9');
+            const char* fields[] = {exact.get(), padded.data()};
+            for (const char* field : fields) {
+                ASSERT_EQ(FastNumberParser::fast_atoi(field, field + n), FastNumberParser::fast_atoi_scalar(b, e))
+                    << '"' << s.substr(0, n) << '"';
+                ASSERT_EQ(FastNumberParser::fast_atou(field, field + n), FastNumberParser::fast_atou_scalar(b, e))
+                    << '"' << s.substr(0, n) << '"';
+                ASSERT_EQ(FastNumberParser::scan_digits(field, field + n).length,
+                          FastNumberParser::scan_digits(b, e).length)
+                    << '"' << s.substr(0, n) << '"';
+                if (n <= 14) {
+                    ASSERT_EQ(FastNumberParser::fast_atof_fixed(field, field + n),
+                              FastNumberParser::fast_atof_fixed_scalar(b, e))
+                        << '"' << s.substr(0, n) << '"';
+                }
+            }
+        }
+    }
+}
+
+TEST(FastNumberParserTest, StrictConversionsValidateInTheSamePass) {
+    int64_t value = 7;
+    EXPECT_TRUE(FastNumberParser::parse_int_strict("-0042", value));
+    EXPECT_EQ(value, -42);
+    EXPECT_TRUE(FastNumberParser::parse_int_strict("9223372036854775807", value));
+    EXPECT_EQ(value, INT64_MAX);
+    EXPECT_TRUE(FastNumberParser::parse_int_strict("-9223372036854775808", value));
+    EXPECT_EQ(value, INT64_MIN);
+    value = 7;
+    for (const char* text : {"", "-", "+1", "12a", " 1", "1.0", "9223372036854775808", "99999999999999999999"}) {
+        EXPECT_FALSE(FastNumberParser::parse_int_strict(text, value)) << text;
+    }
+    EXPECT_EQ(value, 7);
+
+    int64_t price = 7;
+    EXPECT_TRUE(FastNumberParser::parse_fixed_strict("150.25", 10000, price));
+    EXPECT_EQ(price, 1502500);
+    EXPECT_TRUE(FastNumberParser::parse_fixed_strict("-.5", 10000, price));
+    EXPECT_EQ(price, -5000);
+    EXPECT_TRUE(FastNumberParser::parse_fixed_strict("1.23456789", 10000, price));
+    EXPECT_EQ(price, 12345);  // Validated to the end, truncated to the scale
+    price = 7;
+    for (const char* text : {"", ".", "-", "1e5", "12.34.56", "123abc", "1.2x", "922337203685478"}) {
+        EXPECT_FALSE(FastNumberParser::parse_fixed_strict(text, 10000, price)) << text;
+    }
+    EXPECT_FALSE(FastNumberParser::parse_fixed_strict("1", 0, price));
+    EXPECT_EQ(price, 7);
+
+    // Wherever the field is well formed and fits, strict and lenient agree
+    for (const std::string& s : sample_inputs()) {
+        unsigned __int128 integer = 0;
+        for (size_t i = s.starts_with('-') ? 1 : 0; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i) {
+            integer = std::min<unsigned __int128>(integer * 10 + static_cast<unsigned>(s[i] - '0'), UINT64_MAX);
+        }
+        bool fits = integer * 10000 + 9999 <= INT64_MAX;
+        int64_t strict = 0;
+        bool ok = FastNumberParser::parse_fixed_strict(s, 10000, strict);
+        EXPECT_EQ(ok, formats::DECIMAL.matches(s) && fits) << '"' << s << '"';
+        if (ok) {
+            EXPECT_EQ(strict, FastNumberParser::fast_atof_fixed(s)) << '"' << s << '"';
+        }
+    }
+}
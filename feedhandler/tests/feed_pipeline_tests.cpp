@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include "pipeline/feed_pipeline.hpp"
+
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::pipeline;
+
+namespace {
+
+std::string quote(const std::string& symbol, int price, char side) {
+    return "8=FIX.4.4|9=60|35=D|55=" + symbol + "|44=" + std::to_string(price) +
+           "|38=100|54=" + (side == 'S' ? "2" : "1") + "|10=000|\n";
+}
+
+SettingStatus status_of(const FeedPipeline& pipeline, std::string_view name) {
+    const AppliedSetting* setting = pipeline.report().find(name);
+    EXPECT_NE(setting, nullptr) << name;
+    return setting ? setting->status : SettingStatus::IGNORED;
+}
+
+std::string effective(const FeedPipeline& pipeline, std::string_view name) {
+    const AppliedSetting* setting = pipeline.report().find(name);
+    return setting ? setting->effective : "";
+}
+
+// Small region, no metrics file: what every test starts from
+class FeedPipelineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config::PerformanceConfig& config = config::PerformanceConfig::instance();
+        config.cpu() = {};
+        config.memory() = {};
+        config.parser() = {};
+        config.queue() = {};
+        config.monitoring() = {};
+        config.memory().zero_latency_pool_size = 4 * 1024 * 1024;
+        config.memory().enable_huge_pages = false;
+        config.memory().tick_pool_size = 256;
+        config.monitoring().metrics_output_file.clear();
+    }
+
+    void TearDown() override {
+        config::PerformanceConfig::instance().memory() = {};
+        config::PerformanceConfig::instance().monitoring() = {};
+    }
+
+    config::PerformanceConfig& config() { return config::PerformanceConfig::instance(); }
+};
+
+} // namespace
+
+TEST_F(FeedPipelineTest, EverySectionReachesItsComponent) {
+    config().queue().ring_buffer_size = 1000;
+    config().queue().enable_batching = true;
+    config().queue().batch_size = 8;
+    config().queue().overflow_policy = "drop_oldest";
+    config().monitoring().enable_latency_tracking = false;
+
+    FeedPipeline pipeline(config(), FeedPipeline::BatchCallback());
+    ASSERT_NE(pipeline.allocator(), nullptr);
+    EXPECT_TRUE(pipeline.allocator()->prefaulted());
+    EXPECT_FALSE(pipeline.allocator()->huge_pages());
+    EXPECT_TRUE(pipeline.tick_pool().arena_backed());
+    EXPECT_GE(pipeline.allocator()->get_stats().allocated_size, 256 * sizeof(common::Tick));
+    EXPECT_EQ(pipeline.tick_pool().capacity(), 256u);
+    EXPECT_EQ(pipeline.feed_handler().queue_capacity(), 1024u);
+    EXPECT_EQ(pipeline.engine(), nullptr);
+    EXPECT_EQ(pipeline.metrics(), nullptr);
+
+    EXPECT_EQ(status_of(pipeline, "queue.ring_buffer_size"), SettingStatus::ADJUSTED);
+    EXPECT_EQ(effective(pipeline, "queue.ring_buffer_size"), "1024");
+    EXPECT_EQ(effective(pipeline, "queue.overflow_policy"), "drop_oldest");
+    EXPECT_EQ(status_of(pipeline, "queue.enable_backpressure"), SettingStatus::IGNORED);
+    EXPECT_EQ(effective(pipeline, "queue.batch_size"), "8");
+    EXPECT_EQ(status_of(pipeline, "memory.tick_pool_size"), SettingStatus::APPLIED);
+    EXPECT_EQ(effective(pipeline, "monitoring.enable_latency_tracking"), "off");
+
+    // Default parser settings keep garbage recovery, so SIMD stays off
+    EXPECT_EQ(status_of(pipeline, "parser.simd_instruction_set"), SettingStatus::IGNORED);
+    EXPECT_FALSE(pipeline.feed_handler().simd_level().has_value());
+    EXPECT_EQ(status_of(pipeline, "parser.batch_size"), SettingStatus::IGNORED);
+
+    // No NUMA node named: nothing to bind
+    config().memory().enable_numa_allocation = true;
+    FeedPipeline unbound(config(), FeedPipeline::BatchCallback());
+    EXPECT_EQ(status_of(unbound, "memory.enable_numa_allocation"), SettingStatus::IGNORED);
+    EXPECT_EQ(unbound.allocator()->numa_node(), -1);
+
+    std::ostringstream table;
+    pipeline.report().print(table);
+    EXPECT_NE(table.str().find("queue.ring_buffer_size"), std::string::npos);
+    EXPECT_NE(table.str().find("rounded up to a power of 2"), std::string::npos);
+    EXPECT_EQ(pipeline.report().count(SettingStatus::APPLIED) + pipeline.report().count(SettingStatus::ADJUSTED) +
+              pipeline.report().count(SettingStatus::IGNORED), pipeline.report().settings().size());
+}
+
+TEST_F(FeedPipelineTest, SimdParsingFeedsAnalyticsAndTheCallback) {
+    config().parser().enable_garbage_recovery = false;
+    config().parser().simd_instruction_set = "AVX512";
+    config().cpu().parser_thread_affinity = {100000};  // Outside any mask
+
+    FeedPipeline::Options options;
+    options.analytics = true;
+    options.engine.worker_threads = 4096;
+    options.engine.history_depth = 1000;
+    std::atomic<size_t> delivered{0};
+    FeedPipeline pipeline(config(), [&](std::span<const common::Tick> ticks) { delivered += ticks.size(); }, options);
+
+    const auto level = parser::SIMDFixParser::supported_simd_level(parser::SimdLevel::AVX512BW);
+    ASSERT_TRUE(pipeline.feed_handler().simd_level().has_value());
+    EXPECT_EQ(*pipeline.feed_handler().simd_level(), level);
+    EXPECT_EQ(effective(pipeline, "parser.simd_instruction_set"), parser::SIMDFixParser::simd_level_name(level));
+    EXPECT_EQ(status_of(pipeline, "cpu.parser_thread_affinity"), SettingStatus::IGNORED);
+    EXPECT_EQ(status_of(pipeline, "analytics.worker_threads"), SettingStatus::ADJUSTED);
+    ASSERT_NE(pipeline.engine(), nullptr);
+
+    pipeline.start();
+    for (int i = 0; i < 10; ++i) {
+        const std::string msg = quote("PIPE", 100 + i, 'B') + quote("PIPE", 101 + i, 'S');
+        pipeline.feed_handler().inject_data(msg.data(), msg.size());
+    }
+    pipeline.stop();
+
+    EXPECT_EQ(delivered.load(), 20u);
+    EXPECT_EQ(pipeline.engine()->get_metrics("PIPE").total_volume, 2000u);
+}
+
+TEST_F(FeedPipelineTest, FromFileBuildsFromTheLoadedConfig) {
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / ("feed_pipeline_" + std::to_string(getpid()));
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "feed.json") << R"({"queue": {"ring_buffer_size": 64, "enable_backpressure": true},
+        "memory": {"zero_latency_pool_size": 1048576, "enable_huge_pages": false, "tick_pool_size": 16},
+        "monitoring": {"metrics_output_file": ""}})";
+
+    auto pipeline = FeedPipeline::from_file((dir / "feed.json").string(), FeedPipeline::BatchCallback());
+    ASSERT_NE(pipeline, nullptr);
+    EXPECT_EQ(pipeline->feed_handler().queue_capacity(), 64u);
+    EXPECT_EQ(effective(*pipeline, "queue.overflow_policy"), "block");
+    EXPECT_EQ(pipeline->tick_pool().capacity(), 16u);
+
+    EXPECT_EQ(FeedPipeline::from_file((dir / "missing.json").string(), FeedPipeline::BatchCallback()), nullptr);
+    std::filesystem::remove_all(dir);
+}
+
+TEST_F(FeedPipelineTest, WarmUpSwallowsSyntheticTicksAndResetsStats) {
+    config().memory().prefault_memory = false;
+    config().queue().ring_buffer_size = 8;  // Pacing keeps the drop policy idle
+    config().queue().overflow_policy = "drop_newest";
+
+    std::atomic<size_t> delivered{0};
+    FeedPipeline pipeline(config(), [&](std::span<const common::Tick> ticks) { delivered += ticks.size(); });
+    ASSERT_NE(pipeline.allocator(), nullptr);
+    EXPECT_FALSE(pipeline.allocator()->prefaulted());
+    pipeline.tick_pool().acquire();
+
+    FeedPipeline::WarmupOptions options;
+    options.symbols = {"WARMA", "WARMB"};
+    options.messages = 1000;
+    options.messages_per_buffer = 7;
+    options.timeout = std::chrono::seconds(20);
+    const FeedPipeline::WarmupResult result = pipeline.warm_up(options);
+
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(result.messages, 1000u);
+    EXPECT_EQ(result.ticks, 1000u);
+    EXPECT_TRUE(pipeline.allocator()->prefaulted());
+    EXPECT_EQ(pipeline.tick_pool().size(), 0u);
+    EXPECT_EQ(delivered.load(), 0u);
+    EXPECT_EQ(pipeline.feed_handler().get_statistics().messages_parsed.load(), 0u);
+    EXPECT_EQ(pipeline.feed_handler().get_statistics().queue_overflows.load(), 0u);
+    EXPECT_TRUE(pipeline.feed_handler().is_running());
+    EXPECT_NE(common::SymbolTable::global().find("WARMB"), common::INVALID_INSTRUMENT);
+
+    // Live data after the warm-up reaches the callback and the counters
+    const std::string msg = quote("LIVE", 100, 'B');
+    pipeline.feed_handler().inject_data(msg.data(), msg.size());
+    pipeline.stop();
+    EXPECT_EQ(delivered.load(), 1u);
+    EXPECT_EQ(pipeline.feed_handler().get_statistics().messages_parsed.load(), 1u);
+}
+
+TEST_F(FeedPipelineTest, TracingSavesTheRunOnStop) {
+    const std::string path = std::string(::testing::TempDir()) + "feed_pipeline_" + std::to_string(getpid()) + ".trace";
+    config().monitoring().enable_tracing = true;
+    config().monitoring().trace_buffer_events = 1024;
+    config().monitoring().trace_output_file = path;
+
+    std::atomic<size_t> delivered{0};
+    {
+        FeedPipeline pipeline(config(), [&](std::span<const common::Tick> ticks) { delivered += ticks.size(); });
+        EXPECT_EQ(status_of(pipeline, "monitoring.enable_tracing"), SettingStatus::APPLIED);
+        EXPECT_TRUE(common::Tracer::global().enabled());
+        pipeline.start();
+        for (int i = 0; i < 3; ++i) {
+            const std::string msg = quote("TRACE", 100 + i, 'B');
+            pipeline.feed_handler().inject_data(msg.data(), msg.size());
+        }
+        pipeline.stop();
+    }
+    common::Tracer::global().enable(false);
+    EXPECT_EQ(delivered.load(), 3u);
+
+    common::TraceDump dump;
+    ASSERT_TRUE(common::TraceDump::load(path, dump));
+    auto stage = [&](const std::string& name) {
+        return static_cast<uint16_t>(std::find(dump.stages.begin(), dump.stages.end(), name) - dump.stages.begin());
+    };
+    // Every buffer is pushed on this thread and parsed on the parser's, under one sequence
+    std::vector<uint64_t> injected, parsed;
+    for (const common::TraceDump::Thread& thread : dump.threads) {
+        for (const common::TraceDump::Event& event : thread.events) {
+            if (event.phase != common::TracePhase::BEGIN) {
+                continue;
+            }
+            if (event.stage == stage("feed.inject")) {
+                injected.push_back(event.seq);
+            } else if (event.stage == stage("feed.parse")) {
+                EXPECT_EQ(thread.name, "parser");
+                parsed.push_back(event.seq);
+            }
+        }
+    }
+    ASSERT_EQ(injected.size(), 3u);
+    EXPECT_EQ(parsed, injected);
+    EXPECT_EQ(injected[2], injected[0] + 2);
+    std::remove(path.c_str());
+}
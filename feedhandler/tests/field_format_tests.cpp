@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "parser/field_format.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace feedhandler::parser;
+
+namespace {
+
+// leetcode 10: '.' any character, '*' zero or more of the preceding one
+bool dp_match(const std::string& s, const std::string& p) {
+    std::vector<std::vector<bool>> dp(s.size() + 1, std::vector<bool>(p.size() + 1, false));
+    dp[0][0] = true;
+    for (size_t j = 2; j <= p.size(); ++j) {
+        dp[0][j] = p[j - 1] == '*' && dp[0][j - 2];
+    }
+    for (size_t i = 1; i <= s.size(); ++i) {
+        for (size_t j = 1; j <= p.size(); ++j) {
+            if (p[j - 1] == '*') {
+                bool repeat = p[j - 2] == '.' || p[j - 2] == s[i - 1];
+                dp[i][j] = dp[i][j - 2] || (repeat && dp[i - 1][j]);
+            } else {
+                dp[i][j] = (p[j - 1] == '.' || p[j - 1] == s[i - 1]) && dp[i - 1][j - 1];
+            }
+        }
+    }
+    return dp[s.size()][p.size()];
+}
+
+// The leetcode 65 grammar
+constexpr FieldFormat VALID_NUMBER("[+-]?(\\d+\\.?\\d*|\\.\\d+)([eE][+-]?\\d+)?");
+
+static_assert(VALID_NUMBER.matches("-123.456e789"));
+static_assert(!VALID_NUMBER.matches("e3"));
+static_assert(formats::DECIMAL.matches("99.5") && !formats::DECIMAL.matches("9.9.9"));
+
+} // namespace
+
+TEST(FieldFormatTest, ValidNumberGrammar) {
+    for (const char* text : {"2", "0089", "-0.1", "+3.14", "4.", "-.9", "2e10", "-90E3", "3e+7", "+6e-1", "53.5e93", "-123.456e789"}) {
+        EXPECT_TRUE(VALID_NUMBER.matches(text)) << text;
+    }
+    for (const char* text : {"abc", "1a", "1e", "e3", "99e2.5", "--6", "-+3", "95a54e53", ".", "", " 1", "1 "}) {
+        EXPECT_FALSE(VALID_NUMBER.matches(text)) << text;
+    }
+}
+
+TEST(FieldFormatTest, MatchesRegexDpOnRandomPatterns) {
+    std::mt19937 rng(10);
+    const char atoms[] = {'a', 'b', '.'};
+    std::uniform_int_distribution<int> atom(0, 2);
+    std::uniform_int_distribution<int> coin(0, 1);
+    std::uniform_int_distribution<size_t> length(0, 8);
+    for (int round = 0; round < 3000; ++round) {
+        std::string pattern;
+        for (size_t i = length(rng); i > 0; --i) {
+            pattern += atoms[atom(rng)];
+            if (coin(rng)) {
+                pattern += '*';
+            }
+        }
+        FieldFormat format(pattern);
+        for (int probe = 0; probe < 20; ++probe) {
+            std::string text;
+            for (size_t i = length(rng); i > 0; --i) {
+                text += coin(rng) ? 'a' : 'b';
+            }
+            ASSERT_EQ(format.matches(text), dp_match(text, pattern)) << '"' << text << "\" ~ " << pattern;
+        }
+    }
+}
+
+TEST(FieldFormatTest, RepetitionSetsAndEscapes) {
+    FieldFormat exactly("\\d{3}");
+    EXPECT_TRUE(exactly.matches("123"));
+    EXPECT_FALSE(exactly.matches("12"));
+    EXPECT_FALSE(exactly.matches("1234"));
+
+    FieldFormat range("x{2,4}");
+    EXPECT_FALSE(range.matches("x"));
+    EXPECT_TRUE(range.matches("xx"));
+    EXPECT_TRUE(range.matches("xxxx"));
+    EXPECT_FALSE(range.matches("xxxxx"));
+
+    FieldFormat at_least("(ab){2,}");
+    EXPECT_FALSE(at_least.matches("ab"));
+    EXPECT_TRUE(at_least.matches("abab"));
+    EXPECT_TRUE(at_least.matches("ababababab"));
+    EXPECT_FALSE(at_least.matches("ababa"));
+
+    FieldFormat set("[A-Z_][^|\\]]*");
+    EXPECT_TRUE(set.matches("AAPL.O"));
+    EXPECT_TRUE(set.matches("_x"));
+    EXPECT_FALSE(set.matches("aAPL"));
+    EXPECT_FALSE(set.matches("A|B"));
+    EXPECT_FALSE(set.matches("A]"));
+
+    FieldFormat literal("a\\.b\\*|\\(\\)");
+    EXPECT_TRUE(literal.matches("a.b*"));
+    EXPECT_TRUE(literal.matches("()"));
+    EXPECT_FALSE(literal.matches("axb*"));
+
+    FieldFormat empty("");
+    EXPECT_TRUE(empty.matches(""));
+    EXPECT_FALSE(empty.matches("a"));
+}
+
+TEST(FieldFormatTest, FixFormats) {
+    EXPECT_TRUE(formats::INT.matches("-0042"));
+    EXPECT_FALSE(formats::INT.matches("+42"));
+    EXPECT_FALSE(formats::UNSIGNED.matches("-1"));
+    for (const char* text : {"0", "99.5", "-1.25", "5.", ".5", "00012.3400"}) {
+        EXPECT_TRUE(formats::DECIMAL.matches(text)) << text;
+    }
+    for (const char* text : {"", "-", ".", "1e5", "+1", "1..2", "1,5", "12a"}) {
+        EXPECT_FALSE(formats::DECIMAL.matches(text)) << text;
+    }
+    for (const char* text : {"20240131-12:34:56", "20240131-23:59:60.789", "19700101-00:00:00.123456",
+                             "20240229-00:00:00.123456789", "20240229-00:00:00.123456789012"}) {
+        EXPECT_TRUE(formats::UTC_TIMESTAMP.matches(text)) << text;
+    }
+    for (const char* text : {"2024013112:34:56", "20241301-00:00:00", "20240100-00:00:00", "20240132-00:00:00",
+                             "20240131-24:00:00", "20240131-12:60:00", "20240131-12:00:61", "20240131-12:00:00.",
+                             "20240131-12:00:00.12", "20240131-12:00:00.1234"}) {
+        EXPECT_FALSE(formats::UTC_TIMESTAMP.matches(text)) << text;
+    }
+    // Small tables: the byte-class compression keeps every format within limits
+    EXPECT_LE(formats::UTC_TIMESTAMP.class_count(), FieldFormat::MAX_CLASSES);
+    EXPECT_LE(formats::DECIMAL.state_count(), 12u);
+}
+
+TEST(FieldFormatTest, StepsAStateAtATime) {
+    uint8_t state = FieldFormat::START;
+    for (char c : std::string_view("-12")) {
+        state = formats::INT.step(state, c);
+        ASSERT_NE(state, FieldFormat::DEAD);
+    }
+    EXPECT_TRUE(formats::INT.accepts(state));
+    EXPECT_EQ(formats::INT.step(state, 'x'), FieldFormat::DEAD);
+    EXPECT_EQ(formats::INT.step(FieldFormat::DEAD, '1'), FieldFormat::DEAD);
+    EXPECT_FALSE(formats::INT.accepts(formats::INT.step(FieldFormat::START, '-')));
+}
+
+TEST(FieldFormatTest, RejectsMalformedPatternsAtStartup) {
+    for (const char* pattern : {"(ab", "ab)", "[a-", "[z-a]", "*a", "a**", "a{2", "a{3,1}", "\\", "a|*"}) {
+        EXPECT_THROW(FieldFormat{pattern}, std::invalid_argument) << pattern;
+    }
+    EXPECT_THROW(FieldFormat{std::string(64, 'a')}, std::invalid_argument);  // Positions
+    EXPECT_THROW(FieldFormat{"a{64}"}, std::invalid_argument);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "parser/fix_framer.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+using namespace feedhandler::parser;
+
+namespace {
+
+// Well-formed message with correct BodyLength and CheckSum
+std::string make_message(const std::string& body, char delimiter = '\x01') {
+    std::string head = std::string("8=FIX.4.4") + delimiter + "9=" + std::to_string(body.size()) + delimiter;
+    std::string message = head + body;
+    char trailer[16];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u%c",
+                  FixFramer::checksum_scalar(message.data(), message.size()), delimiter);
+    return message + trailer;
+}
+
+const std::string BODY = "35=D\x01" "55=AAPL\x01" "44=150.25\x01" "38=500\x01" "54=1\x01";
+
+} // namespace
+
+TEST(FixFramerTest, ChecksumMatchesScalar) {
+    std::mt19937 rng(3);
+    std::string data;
+    for (size_t length = 0; length < 300; ++length) {
+        EXPECT_EQ(FixFramer::checksum(data.data(), data.size()),
+                  FixFramer::checksum_scalar(data.data(), data.size())) << "length " << length;
+        data += static_cast<char>(rng());
+    }
+}
+
+TEST(FixFramerTest, FramesWholeMessage) {
+    std::string message = make_message(BODY);
+    std::string stream = message + make_message(BODY);
+
+    auto frame = FixFramer::frame(stream.data(), stream.size());
+    EXPECT_EQ(frame.status, FixFramer::Status::COMPLETE);
+    EXPECT_EQ(frame.length, message.size());
+
+    std::string piped = make_message("35=D|55=MSFT|", '|');
+    frame = FixFramer::frame(piped.data(), piped.size());
+    EXPECT_EQ(frame.status, FixFramer::Status::COMPLETE);
+    EXPECT_EQ(frame.length, piped.size());
+}
+
+TEST(FixFramerTest, EveryPrefixIsIncomplete) {
+    std::string message = make_message(BODY);
+    for (size_t length = 0; length < message.size(); ++length) {
+        EXPECT_EQ(FixFramer::frame(message.data(), length).status, FixFramer::Status::INCOMPLETE)
+            << "length " << length;
+    }
+}
+
+TEST(FixFramerTest, RejectsCorruptMessages) {
+    std::string message = make_message(BODY);
+
+    std::string bad_checksum = message;
+    bad_checksum[bad_checksum.find("55=AAPL") + 3] = 'B';
+    EXPECT_EQ(FixFramer::frame(bad_checksum.data(), bad_checksum.size()).status,
+              FixFramer::Status::BAD_CHECKSUM);
+    EXPECT_EQ(FixFramer::frame(bad_checksum.data(), bad_checksum.size(), false).status,
+              FixFramer::Status::COMPLETE);
+
+    std::string bad_length = message;
+    bad_length.replace(bad_length.find("9=") + 2, 2, "30");
+    EXPECT_EQ(FixFramer::frame(bad_length.data(), bad_length.size()).status,
+              FixFramer::Status::BAD_BODY_LENGTH);
+
+    std::string no_length = "8=FIX.4.4\x01" "35=D\x01" "10=000\x01";
+    EXPECT_EQ(FixFramer::frame(no_length.data(), no_length.size()).status, FixFramer::Status::BAD_HEADER);
+    std::string junk = "\n" + message;
+    EXPECT_EQ(FixFramer::frame(junk.data(), junk.size()).status, FixFramer::Status::BAD_HEADER);
+}
+
+TEST(FixFramerTest, FindsMessageStart) {
+    std::string stream = "garbage8=FOO8=FIX.4.4";
+    EXPECT_EQ(FixFramer::find_message_start(stream.data(), stream.size()), 12u);
+    EXPECT_EQ(FixFramer::find_message_start("junk", 4), 4u);
+    // A marker cut off by the end of data is kept for the next read
+    EXPECT_EQ(FixFramer::find_message_start("junk8=F", 7), 4u);
+}
+
+TEST(FixFramerTest, FindsSymbolWithoutParsing) {
+    std::string message = make_message(BODY);
+    EXPECT_EQ(FixFramer::find_symbol(message.data(), message.size()), "AAPL");
+    EXPECT_EQ(FixFramer::find_symbol("35=D|155=X|55=IBM|", 18), "IBM");  // "155=" is another tag
+    EXPECT_EQ(FixFramer::find_symbol("35=D|58=55=X|", 13), "");           // Inside a value
+    EXPECT_EQ(FixFramer::find_symbol("35=D|55=IB", 10), "");              // Cut off
+    EXPECT_EQ(FixFramer::find_symbol("55=IBM|", 7), "");                  // Tag 55 cannot open a message
+
+    // Tag at every offset relative to the 16-byte blocks, and the tail
+    for (size_t pad = 0; pad < 40; ++pad) {
+        std::string fields = "35=D|" + std::string(pad, 'x') + "|5|55|55=SYM" + std::to_string(pad) + "|44=1|";
+        EXPECT_EQ(FixFramer::find_symbol(fields.data(), fields.size()), "SYM" + std::to_string(pad)) << pad;
+        EXPECT_EQ(FixFramer::find_symbol(fields.data(), fields.size()),
+                  FixFramer::find_symbol_scalar(fields.data(), fields.size()));
+    }
+}
+
+TEST(FixFramerTest, FindsTrailerEnd) {
+    std::string message = make_message(BODY);
+    EXPECT_EQ(FixFramer::find_trailer_end(message.data(), message.size()), message.size());
+    std::string stream = "55=X110=1|" + message + message;  // "110=" is another tag
+    EXPECT_EQ(FixFramer::find_trailer_end(stream.data(), stream.size()), 10 + message.size());
+    EXPECT_EQ(FixFramer::find_trailer_end("10=123|", 7), 7u);
+    EXPECT_EQ(FixFramer::find_trailer_end("|10=12|", 7), 0u);
+    EXPECT_EQ(FixFramer::find_trailer_end("|10=123", 7), 0u);  // Delimiter not here yet
+    EXPECT_EQ(FixFramer::find_trailer_end("", 0), 0u);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "parser/fix_schema.hpp"
+#include "parser/optimized_fix_parser.hpp"
+
+#include <set>
+#include <string>
+
+using namespace feedhandler;
+using namespace feedhandler::parser;
+
+namespace {
+
+// Venue-specific market data entry
+struct MdEntry {
+    char entry_type = '\0';
+    int64_t price = 0;
+    int32_t size = 0;
+    uint64_t sending_time = 0;
+};
+
+using MdEntrySchema = FixSchema<MdEntry,
+    FixField<269, fields::Assign<&MdEntry::entry_type, decode::Char>>,
+    FixField<270, fields::Assign<&MdEntry::price, decode::FixedPrice>>,
+    FixField<271, fields::Assign<&MdEntry::size, decode::Int>>,
+    FixField<52, fields::Assign<&MdEntry::sending_time, decode::UtcTimestamp>, false>>;
+
+constexpr FieldFormat MD_ENTRY_TYPE("[0-2]");
+
+// Strict venue: malformed prices, sizes, times or entry types reject the message
+using StrictMdEntrySchema = FixSchema<common::Tick,
+    FixField<55, fields::Symbol>,
+    FixField<269, fields::Validated<MD_ENTRY_TYPE, fields::Assign<&common::Tick::side, decode::Char>>>,
+    FixField<270, fields::StrictPrice>,
+    FixField<271, fields::StrictQuantity>,
+    FixField<52, fields::StrictSendingTime, false>>;
+
+// Counts how often the scan reached a field
+struct CountingHandler {
+    static inline int calls = 0;
+    template<typename Target>
+    static void apply(Target&, std::string_view) { ++calls; }
+};
+
+} // namespace
+
+TEST(FixSchemaTest, PerfectHashGivesEveryTagItsOwnSlot) {
+    using Schema = OptimizedFixParser::TickSchema<common::Tick>;
+    std::set<size_t> slots;
+    for (uint32_t tag : {55u, 44u, 38u, 54u}) {
+        EXPECT_GE(Schema::lookup(tag), 0);
+        slots.insert(tag % Schema::table_size());
+    }
+    EXPECT_EQ(slots.size(), 4u);
+    EXPECT_EQ(Schema::lookup(55), 0);
+    EXPECT_EQ(Schema::lookup(54), 3);
+    for (uint32_t tag : {8u, 9u, 10u, 35u, 52u, 269u, 100000u}) {
+        EXPECT_EQ(Schema::lookup(tag), -1) << tag;
+    }
+    static_assert(MdEntrySchema::lookup(271) == 2);
+}
+
+TEST(FixSchemaTest, ParsesTickWithEitherDelimiter) {
+    for (std::string message : {std::string("8=FIX.4.4|35=D|55=MSFT|44=123.45|38=100|54=2|10=000|"),
+                                std::string("8=FIX.4.4\x01" "35=D\x01" "55=MSFT\x01" "44=123.45\x01"
+                                            "38=100\x01" "54=2\x01" "10=000\x01")}) {
+        common::CompactTick tick;
+        EXPECT_TRUE(OptimizedFixParser::TickSchema<common::CompactTick>::parse(message, tick));
+        EXPECT_EQ(tick.symbol(), "MSFT");
+        EXPECT_EQ(tick.price, 1234500);
+        EXPECT_EQ(tick.qty, 100);
+        EXPECT_EQ(tick.side, 'S');
+    }
+}
+
+TEST(FixSchemaTest, FirstOccurrenceWinsAndMissingRequiredFails) {
+    common::Tick tick;
+    EXPECT_FALSE(OptimizedFixParser::TickSchema<common::Tick>::parse("55=AAPL|44=1.5|55=IBM|38=7|", tick));
+    EXPECT_EQ(tick.symbol, "AAPL");
+    EXPECT_EQ(tick.qty, 7);
+    EXPECT_EQ(tick.side, '\0');  // 54 never arrived
+
+    // Junk fields are skipped
+    common::Tick junk;
+    EXPECT_TRUE(OptimizedFixParser::TickSchema<common::Tick>::parse(
+        "=x|abc|99999999999=1|55=GOOG||44=2|38=3|54=1", junk));
+    EXPECT_EQ(junk.symbol, "GOOG");
+    EXPECT_EQ(junk.side, 'B');
+}
+
+TEST(FixSchemaTest, StopsOnceAllFieldsSeen) {
+    using Schema = FixSchema<MdEntry, FixField<269, CountingHandler>, FixField<271, CountingHandler>>;
+    MdEntry entry;
+    CountingHandler::calls = 0;
+    EXPECT_TRUE(Schema::parse("269=0|271=5|269=1|271=6|", entry));
+    EXPECT_EQ(CountingHandler::calls, 2);
+}
+
+TEST(FixSchemaTest, VenueSchemaWithSendingTime) {
+    MdEntry entry;
+    EXPECT_TRUE(MdEntrySchema::parse("35=X|52=20240131-12:34:56.789|279=0|269=1|270=99.5|271=300|", entry));
+    EXPECT_EQ(entry.entry_type, '1');
+    EXPECT_EQ(entry.price, 995000);
+    EXPECT_EQ(entry.size, 300);
+    EXPECT_EQ(entry.sending_time, 1706704496ull * 1000000000ull + 789000000ull);
+
+    // Optional field may be absent
+    MdEntry no_time;
+    EXPECT_TRUE(MdEntrySchema::parse("269=0|270=1|271=1|", no_time));
+    EXPECT_EQ(no_time.sending_time, 0u);
+
+    EXPECT_EQ(decode::UtcTimestamp::decode("19700101-00:00:01"), 1000000000u);
+    EXPECT_EQ(decode::UtcTimestamp::decode("2024013112:34:56"), 0u);
+}
+
+TEST(FixSchemaTest, StrictFieldsRejectMalformedValues) {
+    common::Tick tick;
+    ASSERT_TRUE(StrictMdEntrySchema::parse("55=MSFT|269=1|270=99.5|271=300|52=20240131-12:34:56.789|", tick));
+    EXPECT_EQ(tick.symbol, "MSFT");
+    EXPECT_EQ(tick.side, '1');
+    EXPECT_EQ(tick.price, 995000);
+    EXPECT_EQ(tick.qty, 300);
+    EXPECT_EQ(tick.timestamp, 1706704496ull * 1000000000ull + 789000000ull);
+
+    // The lenient decoders would take the leading part of each of these
+    for (const char* message : {"55=MSFT|269=1|270=99.5x|271=300|", "55=MSFT|269=1|270=99.5|271=3e2|",
+                                "55=MSFT|269=1|270=99.5|271=-300|", "55=MSFT|269=1|270=99.5|271=2147483648|",
+                                "55=MSFT|269=7|270=99.5|271=300|", "55=MSFT|269=1|270=99.5|271=300|52=20240230-00:00:00|",
+                                "55=MSFT|269=1|270=99.5|271=300|52=20240131-12:34:56.78|"}) {
+        common::Tick rejected;
+        EXPECT_FALSE(StrictMdEntrySchema::parse(message, rejected)) << message;
+    }
+
+    uint64_t ns = 0;
+    EXPECT_TRUE(decode::UtcTimestamp::decode_strict("20240229-23:59:60.123456789012", ns));
+    EXPECT_EQ(ns, decode::UtcTimestamp::decode("20240229-23:59:60.123456789"));
+    EXPECT_TRUE(decode::UtcTimestamp::decode_strict("19700101-00:00:01", ns));
+    EXPECT_EQ(ns, 1000000000u);
+    EXPECT_FALSE(decode::UtcTimestamp::decode_strict("19690101-00:00:00", ns));
+    EXPECT_FALSE(decode::UtcTimestamp::decode_strict("20230229-00:00:00", ns));
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "parser/fsm_fix_parser.hpp"
 #include "common/tick.hpp"
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -328,6 +329,149 @@ TEST_F(FSMParserTest, MultipleMessagesWithFragmentation) {
     EXPECT_EQ(ticks[2].symbol, "TSLA");
 }
 
+// ============================================================================
+// Fast Path Tests
+// ============================================================================
+
+namespace {
+
+// Parse buffer in fixed-size chunks with the fast path on or off
+std::vector<Tick> parse_in_chunks(const std::string& buffer, size_t chunk_size, bool fast_path) {
+    FSMFixParser parser;
+    parser.set_fast_path(fast_path);
+    std::vector<Tick> out;
+    for (size_t offset = 0; offset < buffer.size(); offset += chunk_size) {
+        size_t len = std::min(chunk_size, buffer.size() - offset);
+        EXPECT_EQ(parser.parse(buffer.data() + offset, len, out), len);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_F(FSMParserTest, FastPathEnabledByDefault) {
+    EXPECT_TRUE(parser.is_fast_path_enabled());
+    parser.set_fast_path(false);
+    EXPECT_FALSE(parser.is_fast_path_enabled());
+}
+
+TEST_F(FSMParserTest, FastPathMatchesStateMachineAtEveryChunkSize) {
+    // Mix of delimiters, junk, oversized symbol and newline-terminated message
+    std::string buffer =
+        "8=FIX.4.4\x01" "35=D\x01" "55=AAPL\x01" "44=150.25\x01" "38=500\x01" "54=1\x01" "10=123\x01"
+        "8=FIX.4.4|35=D|55=GOOGL|44=2750.80|38=100|54=2|10=002|\n"
+        "garbage|12x34=5|55=" + std::string(80, 'Z') + "|44=1.0|38=1|54=1|10=000|\r\n"
+        "8=FIX.4.4|55=MSFT|44=123.4500|38=1000|54=1|52=20240131-12:34:56\n"
+        "8=FIX.4.4|55=TSLA|44=245.67|38=750|54=2|10=789|";
+    
+    std::vector<Tick> expected = parse_in_chunks(buffer, buffer.size(), false);
+    ASSERT_EQ(expected.size(), 4u);
+    
+    for (size_t chunk = 1; chunk <= buffer.size(); ++chunk) {
+        std::vector<Tick> actual = parse_in_chunks(buffer, chunk, true);
+        ASSERT_EQ(actual.size(), expected.size()) << "chunk size " << chunk;
+        for (size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_EQ(actual[i].symbol, expected[i].symbol) << "chunk size " << chunk;
+            EXPECT_EQ(actual[i].price, expected[i].price) << "chunk size " << chunk;
+            EXPECT_EQ(actual[i].qty, expected[i].qty) << "chunk size " << chunk;
+            EXPECT_EQ(actual[i].side, expected[i].side) << "chunk size " << chunk;
+        }
+    }
+}
+
+TEST_F(FSMParserTest, GarbageRecoveryFindsMessageStartAtAnyOffset) {
+    // Near misses ("8=", "8=FI", "88=F") ahead of the real start, which
+    // lands on every position relative to the 16- and 8-byte blocks
+    const std::string junk = "x8=F8=FI|88=FX8=8=FIY";
+    const std::string message = "8=FIX.4.4|55=AAPL|44=150.25|38=500|54=1|10=000|";
+    for (size_t pad = 0; pad < 40; ++pad) {
+        const std::string data = std::string(pad, '#') + junk + message;
+        parser.reset_recovery_stats();
+        size_t skip = parser.attempt_garbage_recovery(data.data(), data.size());
+        ASSERT_EQ(skip, data.find("8=FIX")) << "pad " << pad;
+        EXPECT_TRUE(parser.is_fix_message_start(data.data() + skip, data.size() - skip));
+        EXPECT_EQ(parser.get_recovery_stats().recovery_count, 1u);
+        EXPECT_EQ(parser.get_recovery_stats().bytes_skipped, skip);
+
+        parser.reset();
+        parser.parse(data.data() + skip, data.size() - skip, ticks);
+    }
+    EXPECT_EQ(ticks.size(), 40u);
+
+    // No start anywhere, including a prefix cut off at the end: skip it all
+    for (size_t length = 0; length < 40; ++length) {
+        const std::string data = std::string(length, '8').substr(0, length / 2) + std::string(length - length / 2, '=');
+        const std::string cut = data + "8=FI";
+        parser.reset_recovery_stats();
+        EXPECT_EQ(parser.attempt_garbage_recovery(cut.data(), cut.size()), cut.size());
+        EXPECT_EQ(parser.get_recovery_stats().recovery_count, 0u);
+        EXPECT_EQ(parser.get_recovery_stats().bytes_skipped, cut.size());
+    }
+
+    // Megabytes of junk end in one call
+    std::string flood(4 << 20, '8');
+    flood += message;
+    EXPECT_EQ(parser.attempt_garbage_recovery(flood.data(), flood.size()), size_t{4} << 20);
+}
+
+TEST_F(FSMParserTest, FastPathLeavesPartialFieldForNextCall) {
+    const char* part1 = "8=FIX.4.4|55=AAPL|44=150.2";
+    const char* part2 = "5|38=500|54=1|10=000|";
+    
+    parser.parse(part1, strlen(part1), ticks);
+    EXPECT_TRUE(parser.is_parsing());
+    EXPECT_TRUE(ticks.empty());
+    
+    parser.parse(part2, strlen(part2), ticks);
+    ASSERT_EQ(ticks.size(), 1u);
+    EXPECT_EQ(ticks[0].price, 1502500);
+}
+
+TEST_F(FSMParserTest, ReceiveTimestampStampsTicks) {
+    const char* msg = "8=FIX.4.4|55=AAPL|44=150.25|38=500|54=1|10=000|";
+    const uint64_t received = Tick::current_timestamp_ns() - 5000;
+    
+    AtomicLatencyHistogram wire_to_parse;
+    parser.set_latency_histogram(&wire_to_parse);
+    parser.set_receive_timestamp(received);
+    parser.parse(msg, strlen(msg), ticks);
+    parser.parse(msg, strlen(msg), ticks);
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].timestamp, received);
+    EXPECT_EQ(ticks[1].timestamp, received);
+    EXPECT_EQ(wire_to_parse.snapshot().count(), 2u);
+    EXPECT_GE(wire_to_parse.snapshot().min(), 5000u);
+    
+    // Without an arrival time ticks fall back to parse time, unrecorded
+    parser.set_receive_timestamp(0);
+    parser.parse(msg, strlen(msg), ticks);
+    ASSERT_EQ(ticks.size(), 3u);
+    EXPECT_GT(ticks[2].timestamp, received);
+    EXPECT_EQ(wire_to_parse.snapshot().count(), 2u);
+}
+
+TEST_F(FSMParserTest, BatchTimestampsShareOneClockRead) {
+    const std::string msg = "8=FIX.4.4|55=AAPL|44=150.25|38=500|54=1|10=000|";
+    std::string stream;
+    for (int i = 0; i < 50; ++i) {
+        stream += msg;
+    }
+    
+    parser.set_batch_timestamps(true);
+    uint64_t before = Tick::current_timestamp_ns();
+    parser.parse(stream.data(), stream.size(), ticks);
+    ASSERT_EQ(ticks.size(), 50u);
+    for (const auto& tick : ticks) {
+        EXPECT_EQ(tick.timestamp, ticks[0].timestamp);
+    }
+    EXPECT_GE(ticks[0].timestamp, before);
+    
+    // A receive timestamp still wins
+    parser.set_receive_timestamp(42);
+    parser.parse(msg.data(), msg.size(), ticks);
+    EXPECT_EQ(ticks.back().timestamp, 42u);
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "distributed/gradient_codec.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+TEST(GradientCodecTest, HalfRoundsToNearestEvenAndSaturates) {
+    for (float value : {0.0f, 1.0f, -2.5f, 0.333251953125f, 65504.0f, 6.103515625e-05f, std::ldexp(1.0f, -24)}) {
+        EXPECT_EQ(half_to_float(float_to_half(value)), value) << value;
+    }
+    EXPECT_EQ(float_to_half(1.0f), 0x3c00);
+    EXPECT_EQ(float_to_half(-0.0f), 0x8000);
+    // 1 + 2^-11 is halfway between 1 and the next half: ties go to even (1)
+    EXPECT_EQ(float_to_half(1.0f + std::ldexp(1.0f, -11)), 0x3c00);
+    EXPECT_EQ(float_to_half(1.0f + 3 * std::ldexp(1.0f, -11)), 0x3c02);
+    EXPECT_EQ(float_to_half(1e6f), 0x7bff);
+    EXPECT_EQ(float_to_half(-1e6f), 0xfbff);
+    EXPECT_EQ(float_to_half(1e-9f), 0x0000);
+    EXPECT_TRUE(std::isinf(half_to_float(float_to_half(std::numeric_limits<float>::infinity()))));
+    EXPECT_TRUE(std::isnan(half_to_float(float_to_half(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(GradientCodecTest, EncodingsRoundTripWithinTheirPrecision) {
+    std::vector<double> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(std::sin(i * 0.37) * 0.01);
+    }
+    std::vector<uint8_t> encoded(values.size() * sizeof(double));
+    std::vector<double> decoded(values.size());
+
+    for (auto compression : {GradientCompression::NONE, GradientCompression::FP16, GradientCompression::INT8}) {
+        float scale = encode_gradient(values.data(), values.size(), compression, encoded.data());
+        decode_gradient(encoded.data(), values.size(), compression, scale, decoded.data(), false);
+        double tolerance = compression == GradientCompression::NONE ? 0.0
+                         : compression == GradientCompression::FP16 ? 0.01 * std::ldexp(1.0, -11)
+                                                                     : 0.01 / 127.0 / 2.0 * 1.0001;
+        for (size_t i = 0; i < values.size(); ++i) {
+            ASSERT_LE(std::fabs(decoded[i] - values[i]), tolerance) << static_cast<int>(compression) << " " << i;
+        }
+    }
+    EXPECT_EQ(gradient_value_bytes(GradientCompression::FP16), 2u);
+    EXPECT_EQ(gradient_value_bytes(GradientCompression::INT8), 1u);
+}
+
+TEST(GradientCodecTest, DecodeAccumulatesAndZeroSegmentsHaveZeroScale) {
+    std::vector<double> zeros(8, 0.0);
+    std::vector<uint8_t> encoded(8);
+    EXPECT_EQ(encode_gradient(zeros.data(), zeros.size(), GradientCompression::INT8, encoded.data()), 0.0f);
+
+    std::vector<double> values{1.0, -2.0, 0.5, 0.25};
+    std::vector<uint8_t> half(values.size() * 2);
+    float scale = encode_gradient(values.data(), values.size(), GradientCompression::FP16, half.data());
+    std::vector<double> sum{10.0, 10.0, 10.0, 10.0};
+    decode_gradient(half.data(), values.size(), GradientCompression::FP16, scale, sum.data(), true);
+    EXPECT_EQ(sum, (std::vector<double>{11.0, 8.0, 10.5, 10.25}));
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "parser/hybrid_fix_parser.hpp"
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::parser;
+
+namespace {
+
+// Stands in for CUDAFixParser: a fixed cost per batch, whatever its size
+class FakeGpuParser {
+public:
+    explicit FakeGpuParser(std::chrono::microseconds batch_cost) : batch_cost_(batch_cost) {}
+
+    bool stage(const char* message, size_t length) {
+        staged_.push_back(std::string_view(message, length));
+        return true;
+    }
+
+    size_t submit() {
+        submitted_ += staged_.size();
+        return staged_.size();
+    }
+
+    size_t collect(std::vector<common::CompactTick>& ticks, bool wait) {
+        EXPECT_TRUE(wait);
+        std::this_thread::sleep_for(batch_cost_);
+        for (auto message : staged_) {
+            common::CompactTick tick;
+            tick.price = static_cast<int64_t>(message.size());
+            ticks.push_back(tick);
+        }
+        metrics_.kernel_execution_time_ms += 0.5;
+        metrics_.processed_message_count += staged_.size();
+        metrics_.batch_count++;
+        size_t collected = staged_.size();
+        staged_.clear();
+        return collected;
+    }
+
+    gpu::CUDAFixParser::GPUMetrics get_metrics() const { return metrics_; }
+
+    size_t submitted() const { return submitted_; }
+
+private:
+    std::chrono::microseconds batch_cost_;
+    std::vector<std::string_view> staged_;
+    size_t submitted_ = 0;
+    gpu::CUDAFixParser::GPUMetrics metrics_{};
+};
+
+std::vector<std::string> make_messages(size_t count) {
+    std::vector<std::string> messages;
+    for (size_t i = 0; i < count; ++i) {
+        messages.push_back("8=FIX.4.4\x01" "9=60\x01" "35=D\x01" "55=HYB" + std::to_string(i % 7) +
+                           "\x01" "44=101.25\x01" "38=" + std::to_string(i + 1) + "\x01" "54=1\x01" "10=000\x01");
+    }
+    return messages;
+}
+
+std::vector<std::string_view> views(const std::vector<std::string>& messages, size_t count) {
+    return std::vector<std::string_view>(messages.begin(), messages.begin() + count);
+}
+
+config::PerformanceConfig::ParserConfig parser_config() {
+    config::PerformanceConfig::ParserConfig config;
+    config.batch_size = 32;
+    return config;
+}
+
+} // namespace
+
+TEST(HybridFixParserTest, BatchesUpToTheConfiguredSizeStayOnTheCpu) {
+    FakeGpuParser gpu(std::chrono::microseconds(0));  // Even a free GPU is not worth the round trip
+    HybridFixParser<FakeGpuParser> parser(parser_config(), &gpu);
+    auto messages = make_messages(32);
+
+    for (size_t count : {1u, 8u, 32u}) {
+        EXPECT_EQ(parser.route(count), HybridFixParser<FakeGpuParser>::Backend::CPU);
+        std::vector<common::CompactTick> ticks;
+        ASSERT_EQ(parser.parse_batch(views(messages, count), ticks), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(ticks[i].price, 1012500);
+            EXPECT_EQ(ticks[i].qty, static_cast<int32_t>(i + 1));
+            EXPECT_EQ(ticks[i].symbol(), "HYB" + std::to_string(i % 7));
+        }
+    }
+    EXPECT_EQ(gpu.submitted(), 0u);
+    EXPECT_EQ(parser.stats().cpu_batches, 3u);
+    EXPECT_EQ(parser.stats().cpu_messages, 41u);
+    EXPECT_EQ(parser.cutover(), SIZE_MAX);
+}
+
+TEST(HybridFixParserTest, LearnsToSendReplayBatchesToTheGpu) {
+    using Backend = HybridFixParser<FakeGpuParser>::Backend;
+    FakeGpuParser gpu(std::chrono::microseconds(1000));
+    HybridFixParser<FakeGpuParser>::Config config;
+    config.probe_interval = 4;
+    HybridFixParser<FakeGpuParser> parser(parser_config(), &gpu, config);
+
+    const size_t live = 48;
+    const size_t replay = 100000;  // Tens of milliseconds on the CPU, 1ms on the fake GPU
+    auto messages = make_messages(replay);
+    auto live_batch = views(messages, live);
+    auto replay_batch = views(messages, replay);
+
+    // Each bucket measures the CPU first, then the GPU
+    std::vector<common::CompactTick> ticks;
+    EXPECT_EQ(parser.route(replay), Backend::CPU);
+    parser.parse_batch(replay_batch, ticks);
+    EXPECT_EQ(parser.route(replay), Backend::GPU);
+    parser.parse_batch(replay_batch, ticks);
+    EXPECT_EQ(gpu.submitted(), replay);
+    EXPECT_EQ(ticks.size(), 2 * replay);
+    EXPECT_LT(parser.cost_per_message(Backend::GPU, replay), parser.cost_per_message(Backend::CPU, replay));
+
+    for (int round = 0; round < 2; ++round) {
+        parser.parse_batch(live_batch, ticks);
+    }
+    EXPECT_GT(parser.cost_per_message(Backend::GPU, live), parser.cost_per_message(Backend::CPU, live));
+    EXPECT_EQ(parser.route(live), Backend::CPU);
+    EXPECT_EQ(parser.route(replay), Backend::GPU);
+    EXPECT_GT(parser.cutover(), live);
+    EXPECT_LE(parser.cutover(), replay);
+
+    // Every probe_interval-th batch of a bucket re-measures the losing side
+    size_t cpu_batches = parser.stats().cpu_batches;
+    for (int round = 0; round < 4; ++round) {
+        parser.parse_batch(live_batch, ticks);
+    }
+    EXPECT_EQ(parser.stats().cpu_batches, cpu_batches + 3);
+    EXPECT_EQ(parser.stats().gpu_messages, replay + 2 * live);
+    EXPECT_DOUBLE_EQ(parser.stats().gpu_device_ms, 1.5);
+}
+
+TEST(HybridFixParserTest, RunsEverythingOnTheCpuWithoutAGpu) {
+    HybridFixParser<FakeGpuParser> parser(parser_config(), nullptr);
+    auto messages = make_messages(500);
+    std::vector<common::CompactTick> ticks;
+    EXPECT_EQ(parser.parse_batch(views(messages, 500), ticks), 500u);
+    EXPECT_EQ(parser.route(1000000), HybridFixParser<FakeGpuParser>::Backend::CPU);
+    EXPECT_EQ(parser.stats().gpu_batches, 0u);
+    EXPECT_EQ(parser.parse_batch(nullptr, 0, ticks), 0u);
+}
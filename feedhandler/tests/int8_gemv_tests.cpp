@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "ml/int8_gemv.hpp"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace feedhandler::ml;
+
+namespace {
+
+const GemvKernel ALL_KERNELS[] = {GemvKernel::SCALAR, GemvKernel::AVX2, GemvKernel::AVX512_VNNI, GemvKernel::NEON};
+
+} // namespace
+
+TEST(Int8GemvTest, EveryKernelMatchesTheScalarReference) {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> value(-127, 127);
+
+    // Full blocks, row and column tails, a single row and a single column
+    const std::pair<size_t, size_t> shapes[] = {{64, 64}, {67, 50}, {3, 64}, {1, 130}, {5, 1}, {16, 7}};
+    for (auto [rows, cols] : shapes) {
+        std::vector<int8_t> weights(rows * cols);
+        for (auto& w : weights) {
+            w = static_cast<int8_t>(value(gen));
+        }
+        AlignedArray<int8_t> x(PackedWeights::padded(cols));
+        for (size_t c = 0; c < cols; ++c) {
+            x[c] = static_cast<int8_t>(value(gen));
+        }
+        // Extremes: the VNNI bias trick must survive +-127 on both operands
+        weights[0] = 127;
+        x[0] = -127;
+
+        std::vector<int32_t> expected(rows);
+        for (size_t r = 0; r < rows; ++r) {
+            for (size_t c = 0; c < cols; ++c) {
+                expected[r] += static_cast<int32_t>(weights[r * cols + c]) * x[c];
+            }
+        }
+
+        for (GemvKernel kernel : ALL_KERNELS) {
+            if (!gemv_kernel_supported(kernel)) {
+                continue;
+            }
+            PackedWeights packed(weights.data(), rows, cols, kernel);
+            ASSERT_EQ(packed.kernel(), kernel);
+            ASSERT_EQ(packed.padded_rows() % PackedWeights::ROW_TILE, 0u);
+            AlignedArray<int32_t> out(packed.padded_rows());
+            packed.gemv(x.data(), out.data());
+            std::vector<int32_t> result(out.data(), out.data() + rows);
+            EXPECT_EQ(result, expected) << gemv_kernel_name(kernel) << " " << rows << "x" << cols;
+            for (size_t r = rows; r < packed.padded_rows(); ++r) {
+                EXPECT_EQ(out[r], 0) << "padding row " << r;
+            }
+        }
+    }
+}
+
+TEST(Int8GemvTest, GemmMatchesGemvForEveryBatchSize) {
+    std::mt19937 gen(13);
+    std::uniform_int_distribution<int> value(-127, 127);
+    const size_t rows = 40;
+    const size_t cols = 70;
+    std::vector<int8_t> weights(rows * cols);
+    for (auto& w : weights) {
+        w = static_cast<int8_t>(value(gen));
+    }
+
+    const size_t max_batch = 11;  // Two blocks of four plus a tail of three
+    const size_t x_stride = PackedWeights::padded(cols);
+    AlignedArray<int8_t> x(max_batch * x_stride);
+    for (size_t n = 0; n < max_batch; ++n) {
+        for (size_t c = 0; c < cols; ++c) {
+            x[n * x_stride + c] = static_cast<int8_t>(value(gen));
+        }
+    }
+
+    for (GemvKernel kernel : ALL_KERNELS) {
+        if (!gemv_kernel_supported(kernel)) {
+            continue;
+        }
+        PackedWeights packed(weights.data(), rows, cols, kernel);
+        const size_t out_stride = packed.padded_rows();
+        AlignedArray<int32_t> expected(out_stride);
+        for (size_t count = 1; count <= max_batch; ++count) {
+            AlignedArray<int32_t> out(count * out_stride);
+            packed.gemm(x.data(), count, x_stride, out.data(), out_stride);
+            for (size_t n = 0; n < count; ++n) {
+                packed.gemv(x.data() + n * x_stride, expected.data());
+                for (size_t r = 0; r < out_stride; ++r) {
+                    ASSERT_EQ(out[n * out_stride + r], expected[r])
+                        << gemv_kernel_name(kernel) << " batch " << count << " vector " << n << " row " << r;
+                }
+            }
+        }
+    }
+}
+
+TEST(Int8GemvTest, UnsupportedKernelsFallBackToScalar) {
+    EXPECT_TRUE(gemv_kernel_supported(GemvKernel::SCALAR));
+    EXPECT_TRUE(gemv_kernel_supported(detect_gemv_kernel()));
+
+    std::vector<int8_t> weights{1, 2, 3, 4, 5, 6};
+    for (GemvKernel kernel : ALL_KERNELS) {
+        PackedWeights packed(weights.data(), 2, 3, kernel);
+        EXPECT_EQ(packed.kernel(), gemv_kernel_supported(kernel) ? kernel : GemvKernel::SCALAR);
+
+        AlignedArray<int8_t> x(PackedWeights::padded(3));
+        x[0] = 1;
+        x[1] = -1;
+        x[2] = 2;
+        AlignedArray<int32_t> out(packed.padded_rows());
+        packed.gemv(x.data(), out.data());
+        EXPECT_EQ(out[0], 1 - 2 + 6);
+        EXPECT_EQ(out[1], 4 - 5 + 12);
+    }
+}
+
+TEST(Int8GemvTest, QuantizesSymmetricallyAndZeroesThePadding) {
+    AlignedArray<int8_t> out(PackedWeights::padded(3));
+    out[5] = 9;  // Stale padding from an earlier, wider vector
+
+    const double x[] = {2.0, -0.75, 0.001};
+    double scale = quantize_activations(x, 3, out.data());
+    EXPECT_DOUBLE_EQ(scale, 2.0 / 127.0);
+    EXPECT_EQ(out[0], 127);
+    EXPECT_EQ(out[1], -48);  // -47.625 rounds to nearest
+    EXPECT_EQ(out[2], 0);
+    EXPECT_EQ(out[5], 0);
+
+    // Halves round to even; a known maximum skips the scan
+    const double halves[] = {2.5, -1.5, 0.5, 3.5, 127.5};
+    EXPECT_EQ(quantize_activations(halves, 5, 127.0, out.data()), 1.0);
+    EXPECT_EQ(out[0], 2);
+    EXPECT_EQ(out[1], -2);
+    EXPECT_EQ(out[2], 0);
+    EXPECT_EQ(out[3], 4);
+    EXPECT_EQ(out[4], 127);  // Clamped
+
+    const double zeros[] = {0.0, 0.0};
+    EXPECT_EQ(quantize_activations(zeros, 2, out.data()), 1.0);
+    EXPECT_EQ(out[0], 0);
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(out.data()) % 64, 0u);
+}
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+#include "net/kernel_bypass_ingress.hpp"
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::net;
+
+namespace {
+
+std::string make_message(const std::string& symbol, int qty) {
+    return "8=FIX.4.4|9=79|35=D|55=" + symbol + "|44=150.25|38=" + std::to_string(qty) +
+           "|54=1|52=20240131-12:34:56|10=020|";
+}
+
+// Ethernet II + IPv4 + UDP around payload (checksums left zero)
+std::string make_frame(const std::string& payload, uint16_t dst_port, uint8_t protocol = IP_PROTO_UDP,
+                       bool vlan = false) {
+    std::string frame(12, '\0');
+    if (vlan) {
+        frame += std::string("\x81\x00\x00\x64", 4);
+    }
+    frame += std::string("\x08\x00", 2);
+
+    size_t ip_total = 20 + 8 + payload.size();
+    std::string ip(20, '\0');
+    ip[0] = 0x45;
+    ip[2] = static_cast<char>(ip_total >> 8);
+    ip[3] = static_cast<char>(ip_total & 0xff);
+    ip[8] = 64;
+    ip[9] = static_cast<char>(protocol);
+    frame += ip;
+
+    std::string udp(8, '\0');
+    udp[0] = static_cast<char>(40000 >> 8);
+    udp[1] = static_cast<char>(40000 & 0xff);
+    udp[2] = static_cast<char>(dst_port >> 8);
+    udp[3] = static_cast<char>(dst_port & 0xff);
+    udp[4] = static_cast<char>((8 + payload.size()) >> 8);
+    udp[5] = static_cast<char>((8 + payload.size()) & 0xff);
+    frame += udp;
+    return frame + payload;
+}
+
+// In-memory RX queues; release() drops the frames of the last burst so
+// any view that outlives the callback would read freed memory
+class FakeBackend {
+public:
+    explicit FakeBackend(uint16_t queues) : queues_(queues) {}
+
+    void push(uint16_t queue, std::string frame, uint64_t timestamp = 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queues_[queue].pending.push_back({std::move(frame), timestamp});
+    }
+
+    uint16_t queue_count() const { return static_cast<uint16_t>(queues_.size()); }
+
+    size_t rx_burst(uint16_t queue, RxPacket* out, size_t max) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Queue& q = queues_[queue];
+        EXPECT_TRUE(q.in_flight.empty()) << "burst not released";
+        while (!q.pending.empty() && q.in_flight.size() < max) {
+            q.in_flight.push_back(std::move(q.pending.front()));
+            q.pending.pop_front();
+        }
+        for (size_t i = 0; i < q.in_flight.size(); ++i) {
+            out[i] = {q.in_flight[i].bytes.data(), q.in_flight[i].bytes.size(), q.in_flight[i].timestamp};
+        }
+        return q.in_flight.size();
+    }
+
+    void release(uint16_t queue) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queues_[queue].in_flight.clear();
+        ++releases;
+    }
+
+    size_t releases = 0;
+
+private:
+    struct Frame {
+        std::string bytes;
+        uint64_t timestamp;
+    };
+    struct Queue {
+        std::deque<Frame> pending;
+        std::vector<Frame> in_flight;
+    };
+
+    std::mutex mutex_;
+    std::vector<Queue> queues_;
+};
+
+} // namespace
+
+TEST(PacketHeadersTest, StripsEthernetVlanIpv4Udp) {
+    std::string payload = make_message("AAPL", 100);
+    std::string frame = make_frame(payload, 12345, IP_PROTO_UDP, true);
+
+    const unsigned char* ip = nullptr;
+    size_t ip_length = 0;
+    ASSERT_TRUE(ethernet_to_ip(reinterpret_cast<const unsigned char*>(frame.data()), frame.size(), ip, ip_length));
+    L4Payload l4;
+    ASSERT_TRUE(ip_to_l4(ip, ip_length, l4));
+    EXPECT_EQ(l4.protocol, IP_PROTO_UDP);
+    EXPECT_EQ(l4.src_port, 40000);
+    EXPECT_EQ(l4.dst_port, 12345);
+    EXPECT_EQ(std::string(l4.data, l4.length), payload);
+    EXPECT_EQ(l4.data, frame.data() + frame.size() - payload.size());  // In place
+}
+
+TEST(KernelBypassIngressTest, PollParsesBurstInPlace) {
+    FakeBackend backend(1);
+    backend.push(0, make_frame(make_message("AAPL", 100) + make_message("MSFT", 200), 9000));
+    backend.push(0, make_frame(make_message("GOOG", 300), 9000), 1700000000000000000ull);
+
+    std::vector<std::string> symbols;
+    std::vector<int> quantities;
+    std::vector<uint64_t> timestamps;
+    BypassIngressConfig config;
+    KernelBypassIngress<FakeBackend> ingress(backend, config, [&](uint16_t queue, std::span<const common::Tick> ticks) {
+        EXPECT_EQ(queue, 0);
+        EXPECT_EQ(backend.releases, 0u);  // Burst released only after delivery
+        for (const auto& tick : ticks) {
+            symbols.emplace_back(tick.symbol);
+            quantities.push_back(tick.qty);
+            timestamps.push_back(tick.timestamp);
+        }
+    });
+
+    EXPECT_EQ(ingress.poll_queue(0), 2u);
+    EXPECT_EQ(backend.releases, 1u);
+    EXPECT_EQ(symbols, (std::vector<std::string>{"AAPL", "MSFT", "GOOG"}));
+    EXPECT_EQ(quantities, (std::vector<int>{100, 200, 300}));
+    EXPECT_EQ(timestamps[2], 1700000000000000000ull);  // NIC time when the backend has one
+    EXPECT_NE(timestamps[0], 0u);
+
+    EXPECT_EQ(ingress.poll_queue(0), 0u);
+    const auto& stats = ingress.queue_stats(0);
+    EXPECT_EQ(stats.rx_packets.load(), 2u);
+    EXPECT_EQ(stats.messages_parsed.load(), 3u);
+    EXPECT_EQ(stats.bursts.load(), 1u);
+    EXPECT_EQ(stats.empty_polls.load(), 1u);
+    EXPECT_EQ(stats.filtered.load(), 0u);
+}
+
+TEST(KernelBypassIngressTest, FiltersNonUdpAndOtherPorts) {
+    FakeBackend backend(1);
+    backend.push(0, make_frame(make_message("AAPL", 1), 9000, IP_PROTO_TCP));
+    backend.push(0, make_frame(make_message("MSFT", 2), 9001));
+    backend.push(0, std::string(10, '\0'));  // Runt
+    backend.push(0, make_frame(make_message("IBM", 3), 9000));
+
+    size_t delivered = 0;
+    BypassIngressConfig config;
+    config.udp_port = 9000;
+    KernelBypassIngress<FakeBackend> ingress(backend, config, [&](uint16_t, std::span<const common::Tick> ticks) {
+        ASSERT_EQ(ticks.size(), 1u);
+        EXPECT_EQ(ticks[0].symbol, "IBM");
+        ++delivered;
+    });
+
+    EXPECT_EQ(ingress.poll_queue(0), 4u);
+    EXPECT_EQ(delivered, 1u);
+    EXPECT_EQ(ingress.queue_stats(0).filtered.load(), 3u);
+}
+
+TEST(KernelBypassIngressTest, TruncatedDatagramDoesNotLeakIntoNext) {
+    FakeBackend backend(1);
+    std::string message = make_message("AAPL", 100);
+    backend.push(0, make_frame(message.substr(0, message.find("|38=")), 9000));
+    backend.push(0, make_frame(make_message("MSFT", 200), 9000));
+
+    std::vector<std::string> symbols;
+    BypassIngressConfig config;
+    KernelBypassIngress<FakeBackend> ingress(backend, config, [&](uint16_t, std::span<const common::Tick> ticks) {
+        for (const auto& tick : ticks) {
+            symbols.emplace_back(tick.symbol);
+            EXPECT_EQ(tick.qty, 200);
+        }
+    });
+
+    ingress.poll_queue(0);
+    EXPECT_EQ(symbols, std::vector<std::string>{"MSFT"});
+}
+
+TEST(KernelBypassIngressTest, WorkersDrainEveryQueue) {
+    constexpr uint16_t QUEUES = 2;
+    constexpr int PER_QUEUE = 50;
+    FakeBackend backend(QUEUES);
+    for (uint16_t q = 0; q < QUEUES; ++q) {
+        for (int i = 0; i < PER_QUEUE; ++i) {
+            backend.push(q, make_frame(make_message(q == 0 ? "AAPL" : "MSFT", i + 1), 9000));
+        }
+    }
+
+    std::mutex mutex;
+    std::vector<size_t> per_queue(QUEUES, 0);
+    BypassIngressConfig config;
+    config.burst_size = 8;
+    config.queue_cpus = {0, -1};
+    KernelBypassIngress<FakeBackend> ingress(backend, config, [&](uint16_t queue, std::span<const common::Tick> ticks) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& tick : ticks) {
+            EXPECT_EQ(tick.symbol, queue == 0 ? "AAPL" : "MSFT");  // RSS keeps a flow on one queue
+        }
+        per_queue[queue] += ticks.size();
+    });
+
+    ingress.start();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (per_queue[0] == PER_QUEUE && per_queue[1] == PER_QUEUE) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ingress.stop();
+
+    EXPECT_EQ(per_queue[0], static_cast<size_t>(PER_QUEUE));
+    EXPECT_EQ(per_queue[1], static_cast<size_t>(PER_QUEUE));
+    for (uint16_t q = 0; q < QUEUES; ++q) {
+        EXPECT_EQ(ingress.queue_stats(q).messages_parsed.load(), static_cast<uint64_t>(PER_QUEUE));
+        EXPECT_GE(ingress.queue_stats(q).bursts.load(), static_cast<uint64_t>(PER_QUEUE / 8));
+    }
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "common/latency_histogram.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+using namespace feedhandler::common;
+
+TEST(LatencyHistogramTest, EmptyReportsZero) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+    EXPECT_EQ(histogram.percentile(99.0), 0u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 0.0);
+}
+
+TEST(LatencyHistogramTest, BucketsStayWithinPrecision) {
+    // Buckets are contiguous and each value lies in its own bucket's range
+    const uint64_t values[] = {0, 1, 63, 64, 65, 127, 128, 1000, 123456789, std::numeric_limits<uint64_t>::max()};
+    for (uint64_t value : values) {
+        size_t index = LatencyHistogram::bucket_index(value);
+        ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT);
+        EXPECT_LE(value, LatencyHistogram::bucket_upper(index));
+        if (index > 0) {
+            EXPECT_GT(value, LatencyHistogram::bucket_upper(index - 1));
+        }
+        EXPECT_LE(LatencyHistogram::bucket_upper(index) - value, value / 32);
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesAndMerge) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    for (uint64_t v = 1; v <= 500; ++v) {
+        a.record(v * 100);
+    }
+    for (uint64_t v = 501; v <= 1000; ++v) {
+        b.record(v * 100);
+    }
+    b.record(1000000, 10);  // Outliers, recorded in bulk
+
+    a.merge(b);
+    EXPECT_EQ(a.count(), 1010u);
+    EXPECT_EQ(a.min(), 100u);
+    EXPECT_EQ(a.max(), 1000000u);
+
+    uint64_t p50 = a.percentile(50.0);
+    EXPECT_GE(p50, 50500u);
+    EXPECT_LE(p50, 50500u + 50500u / 32);
+    EXPECT_EQ(a.percentile(100.0), 1000000u);
+    EXPECT_GE(a.percentile(0.0), 100u);
+    EXPECT_LE(a.percentile(0.0), 100u + 100u / 32);
+
+    a.reset();
+    EXPECT_EQ(a.count(), 0u);
+}
+
+TEST(LatencyHistogramTest, SummaryReportsTail) {
+    LatencyHistogram histogram;
+    histogram.record(1000, 990);
+    histogram.record(50000, 9);
+    histogram.record(2000000);
+
+    LatencySummary summary = histogram.summary();
+    EXPECT_EQ(summary.count, 1000u);
+    EXPECT_LE(summary.p50, 1000u + 1000u / 32);
+    EXPECT_GE(summary.p99, 1000u);
+    EXPECT_LE(summary.p99, 1000u + 1000u / 32);
+    EXPECT_GE(summary.p999, 50000u);
+    EXPECT_EQ(summary.max, 2000000u);
+}
+
+TEST(AtomicLatencyHistogramTest, ReaderSnapshotsWhileWriterRecords) {
+    constexpr uint64_t SAMPLES = 20000;
+    AtomicLatencyHistogram histogram;
+
+    std::thread writer([&] {
+        for (uint64_t i = 1; i <= SAMPLES; ++i) {
+            histogram.record(i);
+        }
+    });
+    uint64_t last = 0;
+    for (int i = 0; i < 100; ++i) {
+        uint64_t count = histogram.snapshot().count();
+        EXPECT_GE(count, last);  // Never goes backwards
+        last = count;
+    }
+    writer.join();
+
+    LatencyHistogram snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count(), SAMPLES);
+    EXPECT_EQ(snapshot.min(), 1u);
+    EXPECT_EQ(snapshot.max(), SAMPLES);
+
+    // Per-thread copies merge into one view
+    LatencyHistogram merged;
+    merged.merge(snapshot);
+    merged.merge(snapshot);
+    EXPECT_EQ(merged.count(), 2 * SAMPLES);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.snapshot().count(), 0u);
+    EXPECT_EQ(histogram.snapshot().min(), 0u);
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "common/lru_cache.hpp"
+
+#include <list>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace feedhandler::common;
+
+namespace {
+
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+};
+
+using StringCache = LRUCache<std::string, std::vector<int>, StringHash, std::equal_to<>>;
+
+std::vector<int> recency(const LRUCache<int, int>& cache) {
+    std::vector<int> keys;
+    cache.for_each([&](int key, int) { keys.push_back(key); });
+    return keys;
+}
+
+} // namespace
+
+TEST(LRUCacheTest, EvictsLeastRecentlyUsed) {
+    // The leetcode 146 sequence
+    LRUCache<int, int> cache(2);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(*cache.find(1), 1);
+    cache.put(3, 3);  // Evicts 2
+    EXPECT_EQ(cache.find(2), nullptr);
+    cache.put(4, 4);  // Evicts 1
+    EXPECT_EQ(cache.find(1), nullptr);
+    EXPECT_EQ(*cache.find(3), 3);
+    EXPECT_EQ(*cache.find(4), 4);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(recency(cache), (std::vector<int>{4, 3}));
+}
+
+TEST(LRUCacheTest, PeekLeavesRecencyAlone) {
+    LRUCache<int, int> cache(2);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    ASSERT_NE(cache.peek(1), nullptr);
+    EXPECT_EQ(*cache.peek(1), 10);
+    cache.put(3, 30);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(2));
+}
+
+TEST(LRUCacheTest, InsertReportsEvictionsAndOverwrites) {
+    LRUCache<int, int> cache(2);
+    std::vector<int> evicted;
+    auto on_evict = [&](int key, int& value) { evicted.push_back(key * 100 + value); };
+    *cache.insert(1, on_evict).first = 1;
+    *cache.insert(2, on_evict).first = 2;
+    auto [value, inserted] = cache.insert(1, on_evict);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*value, 1);
+    *cache.insert(3, on_evict).first = 3;
+    EXPECT_EQ(evicted, (std::vector<int>{202}));
+
+    EXPECT_TRUE(cache.evict_oldest(on_evict));
+    EXPECT_EQ(evicted, (std::vector<int>{202, 101}));
+    EXPECT_TRUE(cache.erase(3));
+    EXPECT_FALSE(cache.erase(3));
+    EXPECT_FALSE(cache.evict_oldest());
+    EXPECT_TRUE(cache.empty());
+}
+
+TEST(LRUCacheTest, LooksUpStringKeysByView) {
+    StringCache cache(4);
+    cache.put(std::string_view("AAPL"), std::vector<int>{1, 2, 3});
+    std::string_view key = "AAPL";
+    ASSERT_NE(cache.find(key), nullptr);
+    EXPECT_EQ(cache.find(key)->size(), 3u);
+    EXPECT_EQ(cache.find(std::string_view("MSFT")), nullptr);
+}
+
+TEST(LRUCacheTest, RecycledEntriesKeepTheirBuffers) {
+    StringCache cache(1);
+    std::vector<int>& first = cache.put(std::string_view("AAPL"), std::vector<int>(64, 1));
+    const int* storage = first.data();
+
+    auto [value, inserted] = cache.insert(std::string_view("MSFT"));
+    ASSERT_TRUE(inserted);
+    EXPECT_EQ(value->data(), storage);  // The evicted entry's vector
+    value->assign(8, 2);
+    EXPECT_EQ(value->data(), storage);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.insert(std::string_view("GOOG")).first->data(), storage);
+}
+
+TEST(LRUCacheTest, GrowsAndRejectsZeroCapacity) {
+    EXPECT_THROW((LRUCache<int, int>(0)), std::invalid_argument);
+
+    LRUCache<int, int> cache(10000);
+    for (int i = 0; i < 10000; ++i) {
+        cache.put(i, i * 2);
+    }
+    EXPECT_EQ(cache.size(), 10000u);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_NE(cache.peek(i), nullptr) << i;
+        EXPECT_EQ(*cache.peek(i), i * 2);
+    }
+}
+
+TEST(LRUCacheTest, MatchesListAndMapReference) {
+    // The textbook list + map LRU, driven through the same random sequence;
+    // small keys collide in the index, so erases exercise backward shifting
+    constexpr size_t CAPACITY = 37;
+    LRUCache<int, int> cache(CAPACITY);
+    std::list<std::pair<int, int>> order;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> index;
+
+    std::mt19937 rng(146);
+    std::uniform_int_distribution<int> key_dist(0, 99);
+    std::uniform_int_distribution<int> op_dist(0, 9);
+    for (int step = 0; step < 200000; ++step) {
+        int key = key_dist(rng);
+        int op = op_dist(rng);
+        auto it = index.find(key);
+        if (op < 4) {
+            int* value = cache.find(key);
+            ASSERT_EQ(value != nullptr, it != index.end()) << step;
+            if (it != index.end()) {
+                EXPECT_EQ(*value, it->second->second);
+                order.splice(order.begin(), order, it->second);
+            }
+        } else if (op < 8) {
+            cache.put(key, step);
+            if (it != index.end()) {
+                it->second->second = step;
+                order.splice(order.begin(), order, it->second);
+            } else {
+                if (order.size() == CAPACITY) {
+                    index.erase(order.back().first);
+                    order.pop_back();
+                }
+                order.emplace_front(key, step);
+                index[key] = order.begin();
+            }
+        } else {
+            ASSERT_EQ(cache.erase(key), it != index.end()) << step;
+            if (it != index.end()) {
+                order.erase(it->second);
+                index.erase(it);
+            }
+        }
+        ASSERT_EQ(cache.size(), order.size()) << step;
+    }
+
+    std::vector<int> expected;
+    for (const auto& entry : order) {
+        expected.push_back(entry.first);
+    }
+    EXPECT_EQ(recency(cache), expected);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "storage/lz_codec.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace feedhandler::storage;
+
+namespace {
+
+std::vector<uint8_t> round_trip(const std::vector<uint8_t>& input, int level, size_t* compressed_size = nullptr) {
+    std::vector<uint8_t> compressed(lz_compress_bound(input.size()));
+    size_t bytes = lz_compress(input.data(), input.size(), compressed.data(), compressed.size(), level);
+    EXPECT_GT(bytes, 0u);
+    if (compressed_size != nullptr) {
+        *compressed_size = bytes;
+    }
+    std::vector<uint8_t> output(input.size());
+    EXPECT_TRUE(lz_decompress(compressed.data(), bytes, output.data(), output.size()));
+    return output;
+}
+
+std::vector<uint8_t> fix_like(size_t messages) {
+    std::string text;
+    for (size_t i = 0; i < messages; ++i) {
+        text += "8=FIX.4.4|35=W|55=AAPL|268=2|269=0|270=190." + std::to_string(10 + i % 7) +
+                "|271=" + std::to_string(100 * (i % 13 + 1)) + "|269=1|270=190.3|271=500|10=123|";
+    }
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+} // namespace
+
+TEST(LzCodecTest, RoundTripsEdgeCasesAtEveryLevel) {
+    std::mt19937 rng(7);
+    std::vector<std::vector<uint8_t>> inputs = {{}, {42}, std::vector<uint8_t>(12, 'a'), std::vector<uint8_t>(100000, 0)};
+    std::vector<uint8_t> random(70000);
+    for (auto& byte : random) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    inputs.push_back(random);
+    inputs.push_back(fix_like(2000));
+
+    for (int level : {FAST_LEVEL, 4, MAX_LEVEL, 0, 99}) {  // Out-of-range levels clamp
+        for (const auto& input : inputs) {
+            EXPECT_EQ(round_trip(input, level), input) << "level " << level << " size " << input.size();
+        }
+    }
+}
+
+TEST(LzCodecTest, HigherLevelsCompressFixTrafficBetter) {
+    auto input = fix_like(5000);
+    size_t fast = 0;
+    size_t high = 0;
+    round_trip(input, FAST_LEVEL, &fast);
+    round_trip(input, MAX_LEVEL, &high);
+    EXPECT_LT(fast, input.size() / 4);
+    EXPECT_LE(high, fast);
+}
+
+TEST(LzCodecTest, RejectsCorruptOrShortInput) {
+    auto input = fix_like(100);
+    std::vector<uint8_t> compressed(lz_compress_bound(input.size()));
+    size_t bytes = lz_compress(input.data(), input.size(), compressed.data(), compressed.size());
+    std::vector<uint8_t> output(input.size());
+
+    EXPECT_FALSE(lz_decompress(compressed.data(), bytes - 1, output.data(), output.size()));
+    EXPECT_FALSE(lz_decompress(compressed.data(), bytes, output.data(), output.size() - 1));
+    std::vector<uint8_t> bad_offset = {0x04, 'a', 0xff, 0xff, 0x00};  // Offset before the output start
+    EXPECT_FALSE(lz_decompress(bad_offset.data(), bad_offset.size(), output.data(), 9));
+
+    EXPECT_EQ(lz_compress(input.data(), input.size(), compressed.data(), 8), 0u);  // Does not fit
+}
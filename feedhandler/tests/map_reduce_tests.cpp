@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+#include "distributed/cluster_computing.hpp"
+#include "distributed/map_reduce_scheduler.hpp"
+
+#include <unistd.h>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+namespace {
+
+constexpr uint64_t MS = 1000000;
+
+ClusterManager::NodeInfo loopback_node(double cpu = 0.1) {
+    ClusterManager::NodeInfo node{};
+    node.ip_address = "127.0.0.1";
+    node.port = 0;
+    node.cpu_utilization = cpu;
+    node.is_healthy = true;
+    return node;
+}
+
+ClusterManager::NodeInfo info_of(const ClusterManager& cluster) {
+    for (const auto& node : cluster.get_cluster_status().node_details) {
+        if (node.node_id == cluster.local_node_id()) {
+            return node;
+        }
+    }
+    return {};
+}
+
+ClusterManager::ClusterConfig cluster_config() {
+    static int counter = 0;
+    ClusterManager::ClusterConfig config;
+    config.cluster_name = "mapreduce" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+    return config;
+}
+
+// Per-symbol volume summed into one slot per symbol id
+struct Volume {
+    uint32_t symbol;
+    int64_t quantity;
+};
+
+void combine_volumes(std::vector<Volume>& volumes) {
+    std::vector<Volume> combined;
+    for (const Volume& volume : volumes) {
+        if (combined.size() <= volume.symbol) {
+            combined.resize(volume.symbol + 1, Volume{0, 0});
+        }
+        combined[volume.symbol].symbol = volume.symbol;
+        combined[volume.symbol].quantity += volume.quantity;
+    }
+    volumes.swap(combined);
+}
+
+int64_t total_volume(const std::vector<Volume>& volumes) {
+    int64_t total = 0;
+    for (const Volume& volume : volumes) {
+        total += volume.quantity;
+    }
+    return total;
+}
+
+// Each input is a trade batch: 100 trades of symbol (i % 8), quantity i
+std::vector<Volume> map_trades(const int& batch) {
+    return std::vector<Volume>(100, Volume{static_cast<uint32_t>(batch % 8), batch});
+}
+
+int64_t expected_volume(int batches) {
+    int64_t total = 0;
+    for (int i = 0; i < batches; ++i) {
+        total += 100 * static_cast<int64_t>(i);
+    }
+    return total;
+}
+
+ClusterManager::MapReduceOptions options(size_t tasks_per_node, size_t threads) {
+    ClusterManager::MapReduceOptions options;
+    options.tasks_per_node = tasks_per_node;
+    options.worker_threads = threads;
+    options.combine_threshold = 256;
+    options.speculation_delay_ms = 20;
+    options.timeout_ms = 5000;
+    return options;
+}
+
+// Two co-located nodes that know each other
+struct Pair {
+    Pair() : config(cluster_config()), a(config), b(config) {
+        EXPECT_TRUE(a.join_cluster(loopback_node(0.2)).first);
+        EXPECT_TRUE(b.join_cluster(loopback_node(0.2)).first);
+        EXPECT_TRUE(a.join_cluster(info_of(b)).first);
+        EXPECT_TRUE(b.join_cluster(info_of(a)).first);
+    }
+
+    ClusterManager::ClusterConfig config;
+    ClusterManager a;
+    ClusterManager b;
+};
+
+} // namespace
+
+TEST(MapReduceSchedulerTest, LocalTasksFirstThenBacksUpStragglers) {
+    // Partitions 0 and 1 are local, 2 belongs to a peer
+    MapReduceScheduler scheduler({true, true, false}, 0, 2.0, 0.3, 10 * MS);
+    auto first = scheduler.acquire(0);
+    auto second = scheduler.acquire(0);
+    EXPECT_EQ(first.partition, 0u);
+    EXPECT_EQ(second.partition, 1u);
+    EXPECT_FALSE(first.speculative);
+    EXPECT_EQ(scheduler.acquire(1 * MS).partition, MapReduceScheduler::WAIT);  // Nothing is slow yet
+
+    EXPECT_TRUE(scheduler.complete(0, false, 0, 5 * MS));
+    // Partition 1 has run 30 ms against a 5 ms median: back it up
+    auto backup = scheduler.acquire(30 * MS);
+    EXPECT_TRUE(backup.speculative);
+    EXPECT_EQ(backup.partition, 1u);
+    auto remote_backup = scheduler.acquire(30 * MS);
+    EXPECT_EQ(remote_backup.partition, 2u);  // The peer's partition is slow too
+    EXPECT_EQ(scheduler.acquire(30 * MS).partition, MapReduceScheduler::WAIT);  // One backup each
+
+    EXPECT_TRUE(scheduler.complete(1, true, 30 * MS, 31 * MS));
+    EXPECT_FALSE(scheduler.complete(1, false, 0, 40 * MS));  // The original lost
+    EXPECT_TRUE(scheduler.done(1));
+    EXPECT_TRUE(scheduler.complete_remote(2, 41 * MS));
+    EXPECT_FALSE(scheduler.complete(2, true, 30 * MS, 42 * MS));
+    EXPECT_TRUE(scheduler.finished());
+    EXPECT_EQ(scheduler.acquire(50 * MS).partition, MapReduceScheduler::FINISHED);
+
+    auto stats = scheduler.stats();
+    EXPECT_EQ(stats.local_completions, 2u);
+    EXPECT_EQ(stats.remote_completions, 1u);
+    EXPECT_EQ(stats.speculative_launches, 2u);
+    EXPECT_EQ(stats.speculative_wins, 1u);
+}
+
+TEST(MapReduceSchedulerTest, IdleNodeRescuesPeerAfterTheDelay) {
+    MapReduceScheduler scheduler({false, false}, 0, 2.0, 0.9, 10 * MS);
+    EXPECT_EQ(scheduler.acquire(5 * MS).partition, MapReduceScheduler::WAIT);
+    EXPECT_TRUE(scheduler.acquire(11 * MS).speculative);
+    scheduler.abort();
+    EXPECT_EQ(scheduler.acquire(12 * MS).partition, MapReduceScheduler::FINISHED);
+}
+
+TEST(MapReduceTest, SingleNodeCombinesBeforeReducing) {
+    ClusterManager cluster(cluster_config());
+    ASSERT_TRUE(cluster.join_cluster(loopback_node()).first);
+    std::vector<int> batches(200);
+    std::iota(batches.begin(), batches.end(), 0);
+
+    size_t reduced_items = 0;
+    auto future = cluster.execute_map_reduce<int, Volume, int64_t>(
+        "volume", batches, map_trades,
+        [&](const std::vector<Volume>& volumes) {
+            reduced_items = volumes.size();
+            return total_volume(volumes);
+        },
+        combine_volumes, options(4, 2));
+    EXPECT_EQ(future.get(), expected_volume(200));
+    EXPECT_LE(reduced_items, 4u * 8u);  // 20000 map results, at most 8 per partition after combining
+
+    // The plain overload needs no combiner
+    auto plain = cluster.execute_map_reduce<int, Volume, int64_t>("plain", batches, map_trades, total_volume);
+    EXPECT_EQ(plain.get(), expected_volume(200));
+
+    auto stats = cluster.get_map_reduce_stats();
+    EXPECT_EQ(stats.jobs, 2u);
+    EXPECT_EQ(stats.remote_partitions, 0u);
+    EXPECT_EQ(stats.shuffle_bytes, 0u);
+}
+
+TEST(MapReduceTest, PeersShuffleCombinedPartitionsByLocality) {
+    Pair pair;
+    std::vector<int> batches(400);
+    std::iota(batches.begin(), batches.end(), 0);
+    auto opts = options(2, 2);
+    // Even batches live on a, odd ones on b
+    for (int i = 0; i < 400; ++i) {
+        opts.input_locations.push_back(i % 2 == 0 ? pair.a.local_node_id() : pair.b.local_node_id());
+    }
+
+    auto on_a = pair.a.execute_map_reduce<int, Volume, int64_t>("shuffle", batches, map_trades, total_volume,
+                                                               combine_volumes, opts);
+    auto on_b = pair.b.execute_map_reduce<int, Volume, int64_t>("shuffle", batches, map_trades, total_volume,
+                                                               combine_volumes, opts);
+    EXPECT_EQ(on_a.get(), expected_volume(400));
+    EXPECT_EQ(on_b.get(), expected_volume(400));
+
+    for (ClusterManager* node : {&pair.a, &pair.b}) {
+        auto stats = node->get_map_reduce_stats();
+        EXPECT_EQ(stats.tasks_run + stats.remote_partitions, 4u);
+        EXPECT_GE(stats.tasks_run, 1u);
+        // Only combined partitions travel: 8 volumes each, not 100 per batch
+        EXPECT_LE(stats.shuffle_bytes, stats.tasks_run * 8 * sizeof(Volume));
+    }
+}
+
+TEST(MapReduceTest, StragglingPeerIsBackedUpSpeculatively) {
+    Pair pair;
+    std::vector<int> batches(8);
+    std::iota(batches.begin(), batches.end(), 0);
+    auto opts = options(2, 2);
+    for (int i = 0; i < 8; ++i) {
+        opts.input_locations.push_back(i < 4 ? pair.a.local_node_id() : pair.b.local_node_id());
+    }
+    // b's map is slow: a finishes first and re-runs b's partitions
+    std::function<std::vector<Volume>(const int&)> slow = [](const int& batch) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        return map_trades(batch);
+    };
+
+    auto on_a = pair.a.execute_map_reduce<int, Volume, int64_t>("straggler", batches, map_trades, total_volume,
+                                                               combine_volumes, opts);
+    auto on_b = pair.b.execute_map_reduce<int, Volume, int64_t>("straggler", batches, slow, total_volume,
+                                                               combine_volumes, opts);
+    EXPECT_EQ(on_a.get(), expected_volume(8));
+    EXPECT_EQ(on_b.get(), expected_volume(8));
+
+    auto stats = pair.a.get_map_reduce_stats();
+    EXPECT_GE(stats.speculative_tasks, 1u);
+    EXPECT_GE(stats.speculative_wins, 1u);
+    EXPECT_GE(pair.b.get_map_reduce_stats().remote_partitions, 1u);
+}
+
+TEST(MapReduceTest, UnshippableIntermediatesRunLocallyAndErrorsReachTheFuture) {
+    Pair pair;
+    std::vector<int> inputs{1, 2, 3};
+    std::function<std::vector<std::string>(const int&)> map = [](const int& value) {
+        return std::vector<std::string>{std::to_string(value)};
+    };
+    std::function<std::string(const std::vector<std::string>&)> join = [](const std::vector<std::string>& parts) {
+        std::string joined;
+        for (const auto& part : parts) {
+            joined += part;
+        }
+        return joined;
+    };
+    // std::string cannot be shuffled: a alone runs the whole job
+    auto local = pair.a.execute_map_reduce<int, std::string, std::string>("strings", inputs, map, join);
+    EXPECT_EQ(local.get(), "123");
+    EXPECT_EQ(pair.a.get_map_reduce_stats().remote_partitions, 0u);
+
+    std::function<std::vector<std::string>(const int&)> failing = [](const int&) -> std::vector<std::string> {
+        throw std::runtime_error("bad batch");
+    };
+    auto failed = pair.a.execute_map_reduce<int, std::string, std::string>("failing", inputs, failing, join);
+    EXPECT_THROW(failed.get(), std::runtime_error);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "monitoring/metrics_exporter.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace feedhandler;
+using namespace feedhandler::monitoring;
+
+namespace {
+
+std::string read_file(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+} // namespace
+
+TEST(MetricsExporterTest, RendersJsonAndPrometheus) {
+    std::atomic<uint64_t> messages{42};
+    common::AtomicLatencyHistogram latency;
+    latency.record(1000, 10);
+
+    MetricsExporterConfig config;
+    config.output_file.clear();
+    MetricsExporter exporter(config);
+    exporter.add_counter("parser.messages", messages);
+    exporter.add_gauge("queue_depth", [] { return uint64_t{7}; });
+    exporter.add_histogram("parse_latency_ns", &latency);
+
+    std::string json = exporter.render(MetricsFormat::JSON);
+    EXPECT_NE(json.find("\"counters\": {\n    \"parser.messages\": 42\n  }"), std::string::npos);
+    EXPECT_NE(json.find("\"queue_depth\": 7"), std::string::npos);
+    EXPECT_NE(json.find("\"parse_latency_ns\": {\"count\": 10, \"p50\": 1000"), std::string::npos);
+
+    std::string text = exporter.render(MetricsFormat::PROMETHEUS);
+    EXPECT_NE(text.find("# TYPE parser_messages counter\nparser_messages 42\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE queue_depth gauge\nqueue_depth 7\n"), std::string::npos);
+    EXPECT_NE(text.find("parse_latency_ns{quantile=\"0.99\"} 1000\n"), std::string::npos);
+    EXPECT_NE(text.find("parse_latency_ns_count 10\n"), std::string::npos);
+    EXPECT_NE(text.find("parse_latency_ns_sum 10000\n"), std::string::npos);
+}
+
+TEST(MetricsExporterTest, WritesFilePeriodically) {
+    config::PerformanceConfig::MonitoringConfig monitoring;
+    monitoring.metrics_update_interval_ms = 5;
+    monitoring.metrics_output_file = "/tmp/metrics_exporter_test_" + std::to_string(::getpid()) + ".prom";
+    MetricsExporterConfig config = MetricsExporterConfig::from_monitoring(monitoring);
+    EXPECT_EQ(config.format, MetricsFormat::PROMETHEUS);
+
+    threading::ThreadedFeedHandler::Statistics stats;
+    MetricsExporter exporter(config);
+    exporter.add_feed_handler("feed", stats);
+    ASSERT_TRUE(exporter.start());
+
+    stats.messages_parsed.store(5);
+    stats.parse_latency.record(250);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (exporter.exports() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(exporter.exports(), 3u);
+
+    stats.messages_parsed.store(9);
+    exporter.stop();  // Publishes the final values
+
+    std::string text = read_file(config.output_file);
+    EXPECT_NE(text.find("feed_messages_parsed 9\n"), std::string::npos);
+    EXPECT_NE(text.find("feed_parse_latency_ns_count 1\n"), std::string::npos);
+    EXPECT_NE(text.find("feed_queue_latency_ns_count 0\n"), std::string::npos);
+    std::remove(config.output_file.c_str());
+}
+
+TEST(MetricsExporterTest, PublishesToSharedMemory) {
+    std::atomic<uint64_t> counter{1};
+    MetricsExporterConfig config;
+    config.output_file.clear();
+    config.update_interval_ms = 60000;  // Only explicit exports
+    config.shm_name = "/metrics_exporter_test_" + std::to_string(::getpid());
+    config.shm_size = 4096;
+
+    std::string text;
+    {
+        MetricsExporter exporter(config);
+        exporter.add_counter("ticks", counter);
+        ASSERT_TRUE(exporter.start());
+        ASSERT_TRUE(exporter.export_now());
+
+        ASSERT_TRUE(read_shared_metrics(config.shm_name, text));
+        EXPECT_NE(text.find("\"ticks\": 1"), std::string::npos);
+
+        counter.store(2, std::memory_order_relaxed);
+        exporter.export_now();
+        ASSERT_TRUE(read_shared_metrics(config.shm_name, text));
+        EXPECT_NE(text.find("\"ticks\": 2"), std::string::npos);
+    }
+
+    // Segment is removed with the exporter
+    EXPECT_FALSE(read_shared_metrics(config.shm_name, text));
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "threading/mpmc_queue.hpp"
+#include "common/compact_tick.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::threading;
+
+namespace {
+
+constexpr int PRODUCERS = 4;
+constexpr uint64_t PER_PRODUCER = 20000;
+
+// Encode producer in the top bits so the consumer can check per-producer order
+uint64_t encode(int producer, uint64_t n) {
+    return (static_cast<uint64_t>(producer) << 32) | n;
+}
+
+template<typename Queue>
+std::vector<std::thread> start_producers(Queue& queue) {
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (uint64_t n = 0; n < PER_PRODUCER; ++n) {
+                while (!queue.try_push(encode(p, n))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    return producers;
+}
+
+} // namespace
+
+TEST(MpmcQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    MpscQueue<int> mpsc(100);
+    MpmcQueue<int> mpmc(3);
+    EXPECT_EQ(mpsc.capacity(), 128u);
+    EXPECT_EQ(mpmc.capacity(), 4u);
+}
+
+TEST(MpmcQueueTest, FifoAndFullWithinOneThread) {
+    MpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.size(), 4u);
+
+    int value = -1;
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(value, lap * 4 + i);
+        }
+        EXPECT_FALSE(queue.try_pop(value));
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(queue.try_push((lap + 1) * 4 + i));
+        }
+    }
+    EXPECT_FALSE(queue.empty());
+}
+
+TEST(MpmcQueueTest, CarriesCompactTicks) {
+    MpmcQueue<common::CompactTick> queue(8);
+    common::CompactTick tick;
+    tick.price = 1502500;
+    tick.qty = 100;
+    tick.side = 'B';
+    tick.instrument_id = 3;
+    EXPECT_TRUE(queue.try_push(tick));
+
+    common::CompactTick out;
+    ASSERT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out.price, 1502500);
+    EXPECT_EQ(out.instrument_id, 3u);
+}
+
+TEST(MpmcQueueTest, MultipleProducersSingleConsumer) {
+    MpscQueue<uint64_t> queue(256);
+    auto producers = start_producers(queue);
+
+    uint64_t next[PRODUCERS] = {};
+    uint64_t received = 0;
+    uint64_t value = 0;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (!queue.try_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const int p = static_cast<int>(value >> 32);
+        ASSERT_LT(p, PRODUCERS);
+        ASSERT_EQ(value & 0xFFFFFFFFu, next[p]);  // Per-producer FIFO
+        ++next[p];
+        ++received;
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpmcQueueTest, MultipleProducersMultipleConsumers) {
+    constexpr int CONSUMERS = 3;
+    constexpr uint64_t TOTAL = PRODUCERS * PER_PRODUCER;
+    MpmcQueue<uint64_t> queue(256);
+
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> checksum{0};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < CONSUMERS; ++c) {
+        consumers.emplace_back([&] {
+            uint64_t value = 0;
+            while (received.load(std::memory_order_relaxed) < TOTAL) {
+                if (queue.try_pop(value)) {
+                    checksum.fetch_add(value & 0xFFFFFFFFu, std::memory_order_relaxed);
+                    received.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto producers = start_producers(queue);
+    for (auto& t : producers) {
+        t.join();
+    }
+    for (auto& t : consumers) {
+        t.join();
+    }
+
+    // Every element delivered exactly once
+    EXPECT_EQ(received.load(), TOTAL);
+    EXPECT_EQ(checksum.load(), PRODUCERS * (PER_PRODUCER * (PER_PRODUCER - 1) / 2));
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "net/multicast_receiver.hpp"
+
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace feedhandler::net;
+
+namespace {
+
+std::string make_datagram(uint64_t sequence) {
+    return "8=FIX.4.4|9=60|35=X|34=" + std::to_string(sequence) + "|268=1|279=0|269=0|55=AAPL|270=1|271=1|10=000|";
+}
+
+// Unicast loopback stand-in for two A/B lines
+MulticastReceiverConfig loopback_lines(bool with_b) {
+    MulticastReceiverConfig config;
+    config.line_a.group = "127.0.0.1";
+    if (with_b) {
+        config.line_b.group = "127.0.0.1";
+    }
+    config.batch_size = 16;
+    config.max_datagram = 512;
+    return config;
+}
+
+class Sender {
+public:
+    Sender() : fd_(socket(AF_INET, SOCK_DGRAM, 0)) {}
+    ~Sender() { ::close(fd_); }
+
+    void send(uint16_t port, const std::string& payload) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ASSERT_EQ(sendto(fd_, payload.data(), payload.size(), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)),
+                  static_cast<ssize_t>(payload.size()));
+    }
+
+private:
+    int fd_;
+};
+
+std::vector<std::string> drain(MulticastReceiver& receiver, size_t expected) {
+    std::vector<std::string> payloads;
+    for (int attempt = 0; attempt < 1000 && payloads.size() < expected; ++attempt) {
+        receiver.poll([&](const char* data, size_t length, uint64_t timestamp) {
+            EXPECT_NE(timestamp, 0u);
+            payloads.emplace_back(data, length);
+        });
+    }
+    return payloads;
+}
+
+} // namespace
+
+TEST(MulticastReceiverTest, FixSequenceRangeReadsFirstAndLast) {
+    std::string two = make_datagram(41) + make_datagram(42);
+    SequenceRange range = fix_sequence_range(two.data(), two.size());
+    EXPECT_EQ(range.first, 41u);
+    EXPECT_EQ(range.last, 42u);
+
+    std::string none = "8=FIX.4.4|35=0|134=7|";  // 134 is not 34
+    EXPECT_EQ(fix_sequence_range(none.data(), none.size()).first, 0u);
+}
+
+TEST(MulticastReceiverTest, ArbitratesLinesBySequence) {
+    MulticastReceiver receiver(loopback_lines(true));
+    ASSERT_TRUE(receiver.open());
+    ASSERT_TRUE(receiver.has_line_b());
+
+    // A loses 3, B carries everything
+    Sender sender;
+    for (uint64_t seq : {1, 2, 4}) {
+        sender.send(receiver.local_port(0), make_datagram(seq));
+    }
+    for (uint64_t seq : {1, 2, 3, 4}) {
+        sender.send(receiver.local_port(1), make_datagram(seq));
+    }
+
+    auto payloads = drain(receiver, 4);
+    ASSERT_EQ(payloads.size(), 4u);
+    for (uint64_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(payloads[i], make_datagram(i + 1));
+    }
+
+    const auto& stats = receiver.get_stats();
+    EXPECT_EQ(stats.datagrams[0], 3u);
+    EXPECT_EQ(stats.datagrams[1], 4u);
+    EXPECT_EQ(stats.duplicates, 3u);
+    EXPECT_EQ(stats.gaps, 0u);
+    EXPECT_EQ(receiver.next_sequence(), 5u);
+}
+
+TEST(MulticastReceiverTest, CountsGapsMissingFromBothLines) {
+    MulticastReceiver receiver(loopback_lines(false));
+    ASSERT_TRUE(receiver.open());
+    EXPECT_FALSE(receiver.has_line_b());
+
+    Sender sender;
+    sender.send(receiver.local_port(0), make_datagram(10));
+    sender.send(receiver.local_port(0), make_datagram(11) + make_datagram(12));
+    sender.send(receiver.local_port(0), make_datagram(15));
+    sender.send(receiver.local_port(0), make_datagram(12));  // Late repeat
+
+    auto payloads = drain(receiver, 3);
+    EXPECT_EQ(payloads.size(), 3u);
+    drain(receiver, 1);
+
+    const auto& stats = receiver.get_stats();
+    EXPECT_EQ(stats.delivered, 3u);
+    EXPECT_EQ(stats.gaps, 1u);
+    EXPECT_EQ(stats.missing_messages, 2u);
+    EXPECT_EQ(stats.duplicates, 1u);
+    EXPECT_EQ(receiver.next_sequence(), 16u);
+}
+
+TEST(MulticastReceiverTest, InvalidGroupFailsToOpen) {
+    MulticastReceiverConfig config;
+    config.line_a.group = "not-an-address";
+    MulticastReceiver receiver(config);
+    EXPECT_FALSE(receiver.open());
+    EXPECT_FALSE(receiver.is_open());
+    EXPECT_EQ(receiver.poll([](const char*, size_t, uint64_t) {}), 0u);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "distributed/near_cache.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+namespace {
+
+std::vector<uint8_t> bytes(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+void put(NearCache& cache, const std::string& key, const std::string& value, uint64_t now) {
+    auto data = bytes(value);
+    cache.put(key, data.data(), data.size(), now);
+}
+
+} // namespace
+
+TEST(NearCacheTest, EvictsLeastRecentlyUsedPastTheByteBudget) {
+    NearCache cache(3 * (2 + 8), 1000);  // Three 2-byte keys with 8-byte values
+    put(cache, "k1", "value-01", 0);
+    put(cache, "k2", "value-02", 0);
+    put(cache, "k3", "value-03", 0);
+    EXPECT_EQ(cache.bytes(), 30u);
+
+    std::vector<uint8_t> out;
+    ASSERT_TRUE(cache.get("k1", out, 1));  // k2 is now the oldest
+    put(cache, "k4", "value-04", 1);
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_FALSE(cache.get("k2", out, 1));
+    EXPECT_TRUE(cache.get("k1", out, 1));
+    EXPECT_EQ(out, bytes("value-01"));
+
+    // Overwrites are accounted, and a value larger than the budget is dropped
+    put(cache, "k1", "v", 1);
+    EXPECT_EQ(cache.bytes(), 30u - 7u);
+    put(cache, "k1", std::string(64, 'x'), 1);
+    EXPECT_FALSE(cache.get("k1", out, 1));
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.bytes(), 0u);
+}
+
+TEST(NearCacheTest, EntriesExpireAfterTheTtl) {
+    NearCache cache(1024, 100);
+    put(cache, "AAPL", "190.25", 1000);
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(cache.get("AAPL", out, 1099));
+    EXPECT_FALSE(cache.get("AAPL", out, 1100));
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.bytes(), 0u);
+}
+
+TEST(NearCacheTest, FillsCallerBuffersAndReportsShortOnes) {
+    NearCache cache(1024, 100);
+    put(cache, "MSFT", "415.10", 0);
+
+    uint8_t buffer[16];
+    size_t length = 0;
+    ASSERT_TRUE(cache.get("MSFT", std::span<uint8_t>(buffer), length, 0));
+    EXPECT_EQ(std::string(reinterpret_cast<char*>(buffer), length), "415.10");
+
+    EXPECT_FALSE(cache.get("MSFT", std::span<uint8_t>(buffer, 3), length, 0));
+    EXPECT_EQ(length, 6u);
+
+    std::vector<uint8_t> out;
+    out.reserve(64);
+    const uint8_t* storage = out.data();
+    ASSERT_TRUE(cache.get("MSFT", out, 0));
+    EXPECT_EQ(out.data(), storage);  // Capacity reused
+}
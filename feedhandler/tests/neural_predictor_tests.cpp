@@ -0,0 +1,347 @@
+#include <gtest/gtest.h>
+#include "ml/neural_predictor.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::ml;
+
+namespace {
+
+common::Tick make_tick(common::InstrumentId id, int64_t price, int32_t qty, char side = 'B') {
+    common::Tick tick("TEST", price, qty, side, 1);
+    tick.instrument_id = id;
+    return tick;
+}
+
+std::vector<common::Tick> random_walk(size_t count, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> step(-30, 30);
+    std::uniform_int_distribution<int> qty(1, 500);
+    std::vector<common::Tick> ticks;
+    int64_t price = 1000000;
+    for (size_t i = 0; i < count; ++i) {
+        price += step(gen);
+        ticks.push_back(make_tick(1, price, qty(gen), i % 3 == 0 ? 'S' : 'B'));
+    }
+    return ticks;
+}
+
+common::CompactTick make_compact(common::InstrumentId id, int64_t price, int32_t qty, char side) {
+    common::CompactTick tick;
+    tick.instrument_id = id;
+    tick.price = price;
+    tick.qty = qty;
+    tick.side = side;
+    return tick;
+}
+
+// One bar-close tick per instrument, with a repeated instrument and an unkeyed tick mixed in
+std::vector<common::CompactTick> universe_ticks(size_t instruments, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> step(-2000, 2000);
+    std::vector<common::CompactTick> ticks;
+    for (size_t id = 0; id < instruments; ++id) {
+        ticks.push_back(make_compact(static_cast<common::InstrumentId>(id), 1000000 + step(gen),
+                                     static_cast<int32_t>(id % 300 + 1), id % 2 == 0 ? 'B' : 'S'));
+    }
+    ticks[instruments / 2] = ticks[3];
+    ticks[instruments / 2].price += 700;
+    ticks[instruments - 1].instrument_id = common::INVALID_INSTRUMENT;
+    return ticks;
+}
+
+// Two predictors with the same weights and per-instrument history
+void twin_predictors(NeuralPredictor& batched, NeuralPredictor& reference, size_t instruments) {
+    std::string path = ::testing::TempDir() + "neural_predictor_twin.bin";
+    batched.save_model(path);
+    reference.load_model(path);
+    for (size_t id = 0; id < instruments; ++id) {
+        for (auto tick : random_walk(30 + id % 40, static_cast<uint32_t>(id))) {
+            tick.instrument_id = static_cast<common::InstrumentId>(id);
+            batched.observe(tick);
+            reference.observe(tick);
+        }
+    }
+}
+
+void expect_same_prediction(const NeuralPredictor::Prediction& actual, const NeuralPredictor::Prediction& expected,
+                            size_t i) {
+    EXPECT_EQ(actual.price_direction, expected.price_direction) << "tick " << i;
+    EXPECT_EQ(actual.confidence, expected.confidence) << "tick " << i;
+    EXPECT_EQ(actual.volatility_forecast, expected.volatility_forecast) << "tick " << i;
+    EXPECT_EQ(actual.anomaly_detected, expected.anomaly_detected) << "tick " << i;
+}
+
+double price_at(const std::vector<common::Tick>& ticks, size_t i) {
+    return static_cast<double>(ticks[i].price) / 10000.0;
+}
+
+// Straightforward rescans of the last n ticks, in extract_features() order
+std::vector<double> rescan_features(const std::vector<common::Tick>& ticks, size_t n) {
+    std::vector<double> features;
+    for (size_t period : StreamingFeatures::SMA_PERIODS) {
+        double sum = 0.0;
+        for (size_t i = n >= period ? n - period : 0; i < n; ++i) {
+            sum += price_at(ticks, i);
+        }
+        features.push_back(n >= period ? sum / period : 0.0);
+    }
+    for (size_t period : StreamingFeatures::EMA_PERIODS) {
+        double alpha = 2.0 / (period + 1.0);
+        double ema = n > 0 ? price_at(ticks, 0) : 0.0;
+        for (size_t i = 1; i < n; ++i) {
+            ema = alpha * price_at(ticks, i) + (1.0 - alpha) * ema;
+        }
+        features.push_back(ema);
+    }
+    for (size_t period : StreamingFeatures::RSI_PERIODS) {
+        double rsi = 50.0;
+        if (n >= period + 1) {
+            double gains = 0.0;
+            double losses = 0.0;
+            for (size_t i = n - period; i < n; ++i) {
+                double change = price_at(ticks, i) - price_at(ticks, i - 1);
+                (change > 0 ? gains : losses) += std::fabs(change);
+            }
+            rsi = losses == 0.0 ? 100.0 : 100.0 - 100.0 / (1.0 + gains / losses);
+        }
+        features.push_back(rsi / 100.0);
+    }
+    if (n >= 20) {
+        double mean = 0.0;
+        for (size_t i = n - 20; i < n; ++i) {
+            mean += price_at(ticks, i) / 20.0;
+        }
+        double variance = 0.0;
+        for (size_t i = n - 20; i < n; ++i) {
+            variance += (price_at(ticks, i) - mean) * (price_at(ticks, i) - mean) / 20.0;
+        }
+        features.insert(features.end(), {mean - 2 * std::sqrt(variance), mean, mean + 2 * std::sqrt(variance)});
+    } else {
+        features.insert(features.end(), {0.0, 0.0, 0.0});
+    }
+    features.push_back(n >= 10 ? (price_at(ticks, n - 1) - price_at(ticks, n - 10)) / price_at(ticks, n - 10) : 0.0);
+    double volume = 0.0;
+    for (size_t i = n >= 5 ? n - 5 : 0; i < n; ++i) {
+        volume += ticks[i].qty;
+    }
+    features.push_back(n >= 5 ? volume / 5.0 / 1000.0 : 0.0);
+    double volatility = 0.0;
+    if (n >= 20) {
+        std::vector<double> returns;
+        for (size_t i = n - 19; i < n; ++i) {
+            returns.push_back(std::log(price_at(ticks, i) / price_at(ticks, i - 1)));
+        }
+        double mean = 0.0;
+        for (double r : returns) {
+            mean += r / returns.size();
+        }
+        double variance = 0.0;
+        for (double r : returns) {
+            variance += (r - mean) * (r - mean) / returns.size();
+        }
+        volatility = std::sqrt(variance) * 100.0;
+    }
+    features.push_back(volatility);
+    return features;
+}
+
+} // namespace
+
+TEST(StreamingFeaturesTest, MatchesAFullRescanAfterEveryTick) {
+    // Long enough to wrap the price ring and trigger return-sum rebuilds
+    auto ticks = random_walk(1500, 42);
+    StreamingFeatures state;
+    double streamed[StreamingFeatures::FEATURE_COUNT];
+
+    for (size_t n = 1; n <= ticks.size(); ++n) {
+        state.update(ticks[n - 1]);
+        state.write(streamed);
+        auto expected = rescan_features(ticks, n);
+        ASSERT_EQ(expected.size(), StreamingFeatures::FEATURE_COUNT);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(streamed[i], expected[i], 1e-9 * std::max(1.0, std::fabs(expected[i])))
+                << "feature " << i << " after " << n << " ticks";
+        }
+    }
+    EXPECT_EQ(state.ticks(), ticks.size());
+
+    state.update(0, 10);  // Non-positive prices are ignored
+    EXPECT_EQ(state.ticks(), ticks.size());
+    state.reset();
+    EXPECT_EQ(state.ticks(), 0u);
+}
+
+TEST(StreamingFeaturesTest, FlagsPricesFarFromTheRecentMean) {
+    StreamingFeatures state;
+    for (int i = 0; i < 60; ++i) {
+        EXPECT_FALSE(state.is_anomaly(1000000));  // Needs 50 prices first
+        state.update(1000000 + (i % 2 == 0 ? 20 : -20), 100);
+    }
+    EXPECT_FALSE(state.is_anomaly(1000050));
+    EXPECT_TRUE(state.is_anomaly(1000100));
+    EXPECT_TRUE(state.is_anomaly(999900));
+}
+
+TEST(NeuralPredictorTest, StreamingPredictionMatchesTheWindowOverload) {
+    NeuralPredictor predictor;
+    auto ticks = random_walk(300, 7);
+    ticks.push_back(make_tick(1, ticks.back().price + 5000, 50));  // Anomalous jump
+
+    std::vector<common::Tick> history;
+    for (const auto& tick : ticks) {
+        auto windowed = predictor.predict(history, tick);
+        auto streamed = predictor.predict(tick);
+        EXPECT_EQ(streamed.price_direction, windowed.price_direction);
+        EXPECT_EQ(streamed.confidence, windowed.confidence);
+        EXPECT_EQ(streamed.volatility_forecast, windowed.volatility_forecast);
+        EXPECT_EQ(streamed.anomaly_detected, windowed.anomaly_detected);
+        history.push_back(tick);
+    }
+    EXPECT_TRUE(predictor.predict(history, make_tick(1, ticks.back().price + 5000, 1)).anomaly_detected);
+    EXPECT_EQ(predictor.get_metrics().predictions_made, 2 * ticks.size() + 1);
+
+    ASSERT_NE(predictor.feature_state(1), nullptr);
+    EXPECT_EQ(predictor.feature_state(1)->ticks(), ticks.size());
+    EXPECT_EQ(predictor.feature_state(2), nullptr);
+}
+
+TEST(NeuralPredictorTest, FeaturesLandInTheAlignedBuffer) {
+    NeuralPredictor predictor;
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(predictor.features()) % 64, 0u);
+
+    auto ticks = random_walk(50, 3);
+    for (size_t i = 0; i + 1 < ticks.size(); ++i) {
+        predictor.observe(ticks[i]);
+    }
+    predictor.predict(ticks.back());
+
+    std::vector<common::Tick> history(ticks.begin(), ticks.end() - 1);
+    auto expected = predictor.extract_features(history);
+    const double* features = predictor.features();
+    for (size_t i = 0; i < StreamingFeatures::FEATURE_COUNT; ++i) {
+        EXPECT_DOUBLE_EQ(features[i], expected[i]) << "feature " << i;
+    }
+    size_t tick_features = StreamingFeatures::FEATURE_COUNT;
+    EXPECT_DOUBLE_EQ(features[tick_features], price_at(ticks, ticks.size() - 1));
+    EXPECT_DOUBLE_EQ(features[tick_features + 1], ticks.back().qty);
+    EXPECT_DOUBLE_EQ(features[tick_features + 2], ticks.back().side == 'B' ? 1.0 : -1.0);
+
+    // Unkeyed ticks predict from an empty history and leave no state behind
+    predictor.predict(make_tick(common::INVALID_INSTRUMENT, 1000000, 10));
+    EXPECT_EQ(predictor.features()[0], 0.0);
+    EXPECT_EQ(predictor.feature_state(1)->ticks(), ticks.size());
+}
+
+TEST(NeuralPredictorTest, EveryGemvKernelGivesTheSamePrediction) {
+    NeuralPredictor predictor;
+    EXPECT_EQ(predictor.gemv_kernel(), detect_gemv_kernel());
+    auto ticks = random_walk(120, 5);
+    for (size_t i = 0; i + 1 < ticks.size(); ++i) {
+        predictor.observe(ticks[i]);
+    }
+    std::vector<common::Tick> history(ticks.begin(), ticks.end() - 1);
+
+    predictor.set_gemv_kernel(GemvKernel::SCALAR);
+    auto reference = predictor.predict(history, ticks.back());
+    EXPECT_GE(reference.price_direction, -1.0);
+    EXPECT_LE(reference.price_direction, 1.0);
+
+    for (GemvKernel kernel : {GemvKernel::AVX2, GemvKernel::AVX512_VNNI, GemvKernel::NEON}) {
+        predictor.set_gemv_kernel(kernel);
+        EXPECT_EQ(predictor.gemv_kernel(), gemv_kernel_supported(kernel) ? kernel : GemvKernel::SCALAR);
+        auto prediction = predictor.predict(history, ticks.back());
+        // Integer accumulation is exact, so the kernels agree bit for bit
+        EXPECT_EQ(prediction.price_direction, reference.price_direction) << gemv_kernel_name(kernel);
+        EXPECT_EQ(prediction.confidence, reference.confidence) << gemv_kernel_name(kernel);
+        EXPECT_EQ(prediction.volatility_forecast, reference.volatility_forecast) << gemv_kernel_name(kernel);
+    }
+}
+
+TEST(NeuralPredictorTest, UnquantizedForwardPassStaysInRange) {
+    NeuralPredictor::Config config;
+    config.use_quantization = false;
+    NeuralPredictor predictor(config);
+    for (const auto& tick : random_walk(100, 9)) {
+        auto prediction = predictor.predict(tick);
+        EXPECT_GE(prediction.price_direction, -1.0);
+        EXPECT_LE(prediction.price_direction, 1.0);
+        EXPECT_GE(prediction.confidence, 0.0);
+        EXPECT_LE(prediction.confidence, 1.0);
+    }
+}
+
+TEST(NeuralPredictorTest, PredictBatchMatchesSequentialPredictions) {
+    // More than two chunks, ending in a chunk that is not a multiple of four
+    const size_t instruments = 2 * NeuralPredictor::MAX_BATCH + 7;
+    auto ticks = universe_ticks(instruments, 17);
+
+    for (GemvKernel kernel : {GemvKernel::SCALAR, detect_gemv_kernel()}) {
+        NeuralPredictor batched;
+        NeuralPredictor reference;
+        twin_predictors(batched, reference, instruments);
+        batched.set_gemv_kernel(kernel);
+        reference.set_gemv_kernel(kernel);
+
+        std::vector<NeuralPredictor::Prediction> predictions(1);  // Results are appended
+        batched.predict_batch(ticks, predictions);
+        ASSERT_EQ(predictions.size(), ticks.size() + 1);
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            const auto& tick = ticks[i];
+            auto expected = reference.predict(make_tick(tick.instrument_id, tick.price, tick.qty, tick.side));
+            expect_same_prediction(predictions[i + 1], expected, i);
+        }
+        EXPECT_EQ(batched.get_metrics().predictions_made, ticks.size());
+        EXPECT_EQ(batched.feature_state(3)->ticks(), reference.feature_state(3)->ticks());
+
+        predictions.clear();
+        batched.predict_batch(std::span<const common::CompactTick>(), predictions);
+        EXPECT_TRUE(predictions.empty());
+    }
+}
+
+TEST(NeuralPredictorTest, InferenceThreadPredictsEverySubmittedTickInOrder) {
+    const size_t instruments = 100;
+    NeuralPredictor batched;
+    NeuralPredictor reference;
+    twin_predictors(batched, reference, instruments);
+
+    std::vector<common::CompactTick> seen;
+    std::vector<NeuralPredictor::Prediction> results;
+    InferenceThread::Config config;
+    config.max_batch = 32;
+    InferenceThread thread(batched, [&](const common::CompactTick* ticks,
+                                        const NeuralPredictor::Prediction* predictions, size_t count) {
+        EXPECT_LE(count, 32u);
+        seen.insert(seen.end(), ticks, ticks + count);
+        results.insert(results.end(), predictions, predictions + count);
+    }, config);
+
+    auto bar = universe_ticks(instruments, 23);
+    EXPECT_FALSE(thread.submit(bar[0]));  // Not started
+    thread.start();
+    for (int close = 0; close < 3; ++close) {
+        for (const auto& tick : bar) {
+            while (!thread.submit(tick)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    thread.stop();
+    EXPECT_FALSE(thread.running());
+
+    ASSERT_EQ(results.size(), 3 * bar.size());
+    EXPECT_EQ(thread.predictions(), results.size());
+    EXPECT_EQ(thread.submitted(), results.size());
+    EXPECT_GE(thread.batches(), results.size() / 32);
+    for (size_t i = 0; i < seen.size(); ++i) {
+        ASSERT_EQ(seen[i].instrument_id, bar[i % bar.size()].instrument_id);
+        auto expected = reference.predict(make_tick(seen[i].instrument_id, seen[i].price, seen[i].qty, seen[i].side));
+        expect_same_prediction(results[i], expected, i);
+    }
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "common/numa_memory_pool.hpp"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::common;
+
+using IntPool = NUMAMemoryPool<int, 1024>;
+
+TEST(NUMAMemoryPoolTest, BindsToCallingThreadNode) {
+    IntPool pool;
+    EXPECT_EQ(pool.numa_node(), IntPool::current_node());
+    EXPECT_EQ(pool.get_stats().free_count, 1024u);
+}
+
+TEST(NUMAMemoryPoolTest, ExplicitNode) {
+    IntPool pool(0);
+    EXPECT_EQ(pool.numa_node(), 0);
+    EXPECT_NE(pool.allocate(), nullptr);
+}
+
+TEST(NUMAMemoryPoolTest, ExhaustionAndHitRate) {
+    IntPool pool;
+    std::vector<int*> held;
+    for (int i = 0; i < 1024; ++i) {
+        int* p = pool.allocate();
+        ASSERT_NE(p, nullptr);
+        *p = i;
+        held.push_back(p);
+    }
+    EXPECT_EQ(std::set<int*>(held.begin(), held.end()).size(), 1024u);
+    EXPECT_EQ(pool.allocate(), nullptr);
+
+    auto stats = pool.get_stats();
+    EXPECT_EQ(stats.allocated_count, 1024u);
+    EXPECT_EQ(stats.free_count, 0u);
+    EXPECT_DOUBLE_EQ(stats.hit_rate, 1024.0 / 1025.0);
+
+    for (int* p : held) {
+        pool.deallocate(p);
+    }
+    EXPECT_EQ(pool.get_stats().free_count, 1024u);
+}
+
+TEST(NUMAMemoryPoolTest, RejectsForeignPointers) {
+    IntPool pool;
+    int outside = 0;
+    EXPECT_FALSE(pool.owns(&outside));
+    pool.deallocate(&outside);
+    pool.deallocate(nullptr);
+    EXPECT_EQ(pool.get_stats().allocated_count, 0u);
+}
+
+TEST(NUMAMemoryPoolTest, ConcurrentAllocateFreeNeverSharesASlot) {
+    IntPool pool;
+    std::atomic<int> conflicts{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&pool, &conflicts] {
+            for (int r = 0; r < 20000; ++r) {
+                int* p = pool.allocate();
+                if (!p) {
+                    continue;
+                }
+                if (std::atomic_ref<int>(*p).exchange(1) != 0) {
+                    conflicts.fetch_add(1);
+                }
+                std::atomic_ref<int>(*p).store(0);
+                pool.deallocate(p);
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    EXPECT_EQ(conflicts.load(), 0);
+    EXPECT_EQ(pool.get_stats().allocated_count, 0u);
+}
+
+TEST(NUMAPoolRegistryTest, LocalPoolAndCrossThreadFree) {
+    auto& registry = NUMAPoolRegistry<double, 1024>::instance();
+    ASSERT_GE(registry.node_count(), 1u);
+
+    auto& local = registry.local();
+    EXPECT_EQ(&local, registry.for_node(local.numa_node()));
+    EXPECT_EQ(registry.for_node(-1), nullptr);
+    EXPECT_EQ(registry.for_node(static_cast<int>(registry.node_count())), nullptr);
+
+    double* p = registry.allocate();
+    ASSERT_NE(p, nullptr);
+    EXPECT_TRUE(local.owns(p));
+    size_t before = local.get_stats().allocated_count;
+
+    // Freed on another thread, lands back in the owning pool
+    std::thread([&registry, p] { registry.deallocate(p); }).join();
+    EXPECT_EQ(local.get_stats().allocated_count, before - 1);
+}
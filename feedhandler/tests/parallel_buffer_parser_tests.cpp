@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "threading/parallel_buffer_parser.hpp"
+#include "parser/optimized_fix_parser.hpp"
+#include "parser/stringview_fix_parser.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace feedhandler;
+using feedhandler::threading::ParallelBufferParser;
+
+namespace {
+
+std::string make_capture(size_t messages) {
+    std::string buffer;
+    for (size_t i = 0; i < messages; ++i) {
+        buffer += "8=FIX.4.4|9=79|35=D|55=SYM" + std::to_string(i % 7) + "|44=" + std::to_string(100 + i) +
+                  ".25|38=" + std::to_string(i + 1) + "|54=" + std::to_string(1 + i % 2) + "|10=020|\n";
+    }
+    return buffer;
+}
+
+ParallelBufferParser::Config small_chunks(size_t threads) {
+    ParallelBufferParser::Config config;
+    config.thread_count = threads;
+    config.chunk_size = 300;
+    return config;
+}
+
+} // namespace
+
+TEST(ParallelBufferParserTest, ChunksStartAtMessageLines) {
+    std::string buffer = make_capture(50);
+    auto chunks = ParallelBufferParser::split_chunks(buffer, 300);
+
+    ASSERT_GT(chunks.size(), 1u);
+    size_t total = 0;
+    for (auto chunk : chunks) {
+        EXPECT_EQ(chunk.substr(0, 5), "8=FIX");
+        EXPECT_EQ(chunk.back(), '\n');
+        EXPECT_EQ(chunk.data(), buffer.data() + total);  // Contiguous, no gaps
+        total += chunk.size();
+    }
+    EXPECT_EQ(total, buffer.size());
+}
+
+TEST(ParallelBufferParserTest, BufferWithoutLineBoundariesIsOneChunk) {
+    std::string buffer = "8=FIX.4.4|55=A|44=1|38=1|54=1|8=FIX.4.4|55=B|44=2|38=2|54=2|";
+    auto chunks = ParallelBufferParser::split_chunks(buffer, 8);
+
+    ASSERT_EQ(chunks.size(), 1u);
+    EXPECT_EQ(chunks[0].size(), buffer.size());
+}
+
+TEST(ParallelBufferParserTest, MatchesSerialOrder) {
+    std::string buffer = make_capture(400);
+    auto serial = parser::StringViewFixParser::parse_messages_from_buffer(buffer);
+
+    ParallelBufferParser parallel(small_chunks(4));
+    auto ticks = parallel.parse(buffer, &parser::StringViewFixParser::parse_messages_from_buffer);
+
+    ASSERT_EQ(ticks.size(), serial.size());
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        EXPECT_EQ(ticks[i].symbol, serial[i].symbol);
+        EXPECT_EQ(ticks[i].price, serial[i].price);
+        EXPECT_EQ(ticks[i].qty, serial[i].qty);
+        EXPECT_EQ(ticks[i].side, serial[i].side);
+    }
+    EXPECT_GT(parallel.get_stats().chunks, 4u);
+    EXPECT_EQ(parallel.get_stats().threads, 4u);
+}
+
+TEST(ParallelBufferParserTest, CompactOutputAppendsInOrder) {
+    std::string buffer = make_capture(200);
+    std::vector<common::CompactTick> ticks(1);  // Existing contents are kept
+
+    ParallelBufferParser parallel(small_chunks(3));
+    EXPECT_EQ(parallel.parse(buffer, &parser::OptimizedFixParser::parse_messages_from_buffer, ticks), 200u);
+
+    ASSERT_EQ(ticks.size(), 201u);
+    for (size_t i = 1; i < ticks.size(); ++i) {
+        EXPECT_EQ(ticks[i].qty, static_cast<int32_t>(i));
+    }
+}
+
+TEST(ParallelBufferParserTest, SingleThreadRunsSerially) {
+    std::string buffer = make_capture(20);
+    ParallelBufferParser parallel(small_chunks(1));
+
+    EXPECT_EQ(parallel.parse(buffer, &parser::StringViewFixParser::parse_messages_from_buffer).size(), 20u);
+    EXPECT_EQ(parallel.get_stats().threads, 1u);
+    EXPECT_EQ(parallel.get_stats().steals, 0u);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "analytics/realtime_engine.hpp"
+
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::analytics;
+
+namespace {
+
+using Metrics = RealtimeEngine::MarketMetrics;
+using PatternType = PatternEngine::PatternType;
+
+Metrics quiet_metrics(common::InstrumentId id, uint64_t time_ns) {
+    Metrics metrics{};
+    metrics.instrument_id = id;
+    metrics.vwap = 100.0;
+    metrics.microprice = 100.01;  // 1 bp from VWAP
+    metrics.spread_bps = 2.0;
+    metrics.volume_rate = 100.0;
+    metrics.realized_volatility = 0.001;
+    metrics.order_flow_imbalance = 0.1;
+    metrics.last_update_ns = time_ns;
+    return metrics;
+}
+
+} // namespace
+
+TEST(PatternEngineTest, QuietUpdatesStopAtThePrefilters) {
+    PatternEngine engine;
+    PatternEngine::Pattern out[PatternEngine::MAX_PATTERNS_PER_UPDATE];
+    for (uint64_t i = 1; i <= 100; ++i) {
+        EXPECT_EQ(engine.analyze_patterns(quiet_metrics(5, i * 1000), out, PatternEngine::MAX_PATTERNS_PER_UPDATE), 0u);
+    }
+    EXPECT_EQ(engine.detector_runs(), 0u);
+    // One price check per update, plus three baseline checks once warmed up
+    EXPECT_EQ(engine.prefilter_skips(), 100u + 3u * 80u);
+    EXPECT_EQ(engine.patterns_detected(), 0u);
+
+    Metrics unknown = quiet_metrics(common::INVALID_INSTRUMENT, 1);
+    EXPECT_EQ(engine.analyze_patterns(unknown, out, PatternEngine::MAX_PATTERNS_PER_UPDATE), 0u);
+}
+
+TEST(PatternEngineTest, SpikesAgainstBaselineWithCooldown) {
+    PatternEngine::Config config;
+    config.cooldown_ns = 10000;
+    PatternEngine engine(config);
+    std::vector<PatternEngine::Pattern> seen;
+    engine.register_pattern_callback([&](const PatternEngine::Pattern& pattern) { seen.push_back(pattern); });
+
+    PatternEngine::Pattern out[PatternEngine::MAX_PATTERNS_PER_UPDATE];
+    uint64_t now = 0;
+    for (int i = 0; i < 30; ++i) {
+        engine.analyze_patterns(quiet_metrics(1, now += 100), out, PatternEngine::MAX_PATTERNS_PER_UPDATE);
+    }
+
+    Metrics spike = quiet_metrics(1, now += 100);
+    spike.volume_rate = 500.0;
+    spike.spread_bps = 10.0;
+    ASSERT_EQ(engine.analyze_patterns(spike, out, PatternEngine::MAX_PATTERNS_PER_UPDATE), 2u);
+    EXPECT_EQ(out[0].type, PatternType::VOLUME_SPIKE);
+    EXPECT_EQ(out[0].instrument_id, 1u);
+    EXPECT_DOUBLE_EQ(out[0].parameters[0], 5.0);
+    EXPECT_NEAR(out[0].confidence, 500.0 / 300.0 - 1.0, 1e-12);
+    EXPECT_EQ(out[0].detection_time, now);
+    EXPECT_EQ(out[1].type, PatternType::LIQUIDITY_DROUGHT);
+    EXPECT_NE(out[1].description, nullptr);
+    ASSERT_EQ(seen.size(), 2u);
+
+    // Inside the cooldown the same spike stays silent
+    spike.last_update_ns = now += 100;
+    EXPECT_EQ(engine.analyze_patterns(spike, out, PatternEngine::MAX_PATTERNS_PER_UPDATE), 0u);
+
+    // A too-small buffer drops patterns instead of overflowing
+    spike.last_update_ns = now += 20000;
+    EXPECT_EQ(engine.analyze_patterns(spike, out, 1), 1u);
+    EXPECT_EQ(engine.patterns_detected(), 3u);
+}
+
+TEST(PatternEngineTest, BatchSeparatesMomentumFromReversion) {
+    PatternEngine engine;
+    std::vector<Metrics> batch;
+    Metrics momentum = quiet_metrics(10, 1000);
+    momentum.microprice = 100.5;  // 50 bps above VWAP, buyers in control
+    momentum.order_flow_imbalance = 0.8;
+    batch.push_back(momentum);
+
+    Metrics reversion = quiet_metrics(11, 1000);
+    reversion.microprice = 99.6;  // 40 bps below VWAP while flow leans to buying
+    reversion.order_flow_imbalance = 0.3;
+    batch.push_back(reversion);
+
+    Metrics stormy = reversion;
+    stormy.instrument_id = 12;
+    stormy.realized_volatility = 0.01;  // Too volatile to call a reversion
+    batch.push_back(stormy);
+    batch.push_back(quiet_metrics(13, 1000));
+
+    std::vector<PatternEngine::Pattern> found;
+    ASSERT_EQ(engine.analyze_batch(batch, found), 2u);
+    EXPECT_EQ(found[0].type, PatternType::MOMENTUM_BREAKOUT);
+    EXPECT_EQ(found[0].instrument_id, 10u);
+    EXPECT_NEAR(found[0].parameters[0], 50.0, 1e-9);
+    EXPECT_GT(found[0].confidence, 0.5);
+    EXPECT_EQ(found[1].type, PatternType::MEAN_REVERSION);
+    EXPECT_EQ(found[1].instrument_id, 11u);
+    EXPECT_EQ(engine.detector_runs(), 3u);
+
+    // Appends to what is already there
+    EXPECT_EQ(engine.analyze_batch(batch, found), 0u);  // Cooldown
+    EXPECT_EQ(found.size(), 2u);
+}
+
+TEST(PatternEngineTest, ChannelGatesMomentumBreakouts) {
+    PatternEngine::Config config;
+    config.breakout_channel = 8;
+    config.cooldown_ns = 0;
+    PatternEngine engine(config);
+    PatternEngine::Pattern out[PatternEngine::MAX_PATTERNS_PER_UPDATE];
+
+    // Microprice ranges up to 100.40 while VWAP sits at 100
+    uint64_t now = 0;
+    for (int i = 0; i < 8; ++i) {
+        Metrics metrics = quiet_metrics(3, now += 100);
+        metrics.microprice = i % 2 == 0 ? 100.40 : 100.0;
+        engine.analyze_patterns(metrics, out, PatternEngine::MAX_PATTERNS_PER_UPDATE);
+    }
+
+    // 30 bp above VWAP with buying behind it, but inside the channel
+    Metrics inside = quiet_metrics(3, now += 100);
+    inside.microprice = 100.30;
+    inside.order_flow_imbalance = 0.9;
+    EXPECT_EQ(engine.analyze_patterns(inside, out, PatternEngine::MAX_PATTERNS_PER_UPDATE), 0u);
+
+    Metrics above = inside;
+    above.last_update_ns = now += 100;
+    above.microprice = 100.50;
+    ASSERT_EQ(engine.analyze_patterns(above, out, PatternEngine::MAX_PATTERNS_PER_UPDATE), 1u);
+    EXPECT_EQ(out[0].type, PatternType::MOMENTUM_BREAKOUT);
+
+    // The new high is part of the channel now
+    above.last_update_ns = now += 100;
+    EXPECT_EQ(engine.analyze_patterns(above, out, PatternEngine::MAX_PATTERNS_PER_UPDATE), 0u);
+}
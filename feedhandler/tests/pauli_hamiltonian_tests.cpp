@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "quantum/pauli_hamiltonian.hpp"
+
+#include <bit>
+#include <random>
+#include <vector>
+
+using namespace feedhandler::quantum;
+
+namespace {
+
+using Complex = std::complex<double>;
+using Matrix = std::vector<std::vector<Complex>>;
+
+// Dense matrix of the sum, built column by column from P|w>
+Matrix to_dense(const PauliHamiltonian& hamiltonian, size_t qubits) {
+    size_t size = size_t{1} << qubits;
+    Matrix matrix(size, std::vector<Complex>(size));
+    for (const auto& term : hamiltonian.terms()) {
+        Complex phase = std::pow(Complex(0.0, 1.0), std::popcount(term.x_mask & term.z_mask));
+        for (size_t w = 0; w < size; ++w) {
+            double sign = std::popcount(w & term.z_mask) % 2 ? -1.0 : 1.0;
+            matrix[w ^ term.x_mask][w] += term.coefficient * sign * phase;
+        }
+    }
+    return matrix;
+}
+
+double dense_expectation(const Matrix& matrix, const StateVector& state) {
+    Complex sum = 0.0;
+    for (size_t r = 0; r < state.size(); ++r) {
+        for (size_t c = 0; c < state.size(); ++c) {
+            sum += std::conj(state.amplitude(r)) * matrix[r][c] * state.amplitude(c);
+        }
+    }
+    return sum.real();
+}
+
+StateVector random_state(size_t qubits, std::mt19937& gen) {
+    std::normal_distribution<double> normal;
+    StateVector state(qubits);
+    double norm = 0.0;
+    for (size_t i = 0; i < state.size(); ++i) {
+        state.set_amplitude(i, Complex(normal(gen), normal(gen)));
+        norm += state.probability(i);
+    }
+    for (size_t i = 0; i < state.size(); ++i) {
+        state.set_amplitude(i, state.amplitude(i) / std::sqrt(norm));
+    }
+    return state;
+}
+
+} // namespace
+
+TEST(PauliHamiltonianTest, ParsesPauliStringsIntoMasks) {
+    PauliHamiltonian hamiltonian;
+    EXPECT_TRUE(hamiltonian.add_term(0.5, "ZIX"));
+    EXPECT_TRUE(hamiltonian.add_term(-1.0, "IY"));
+    EXPECT_FALSE(hamiltonian.add_term(1.0, "ZQ"));
+
+    auto terms = hamiltonian.terms();
+    ASSERT_EQ(terms.size(), 2u);
+    EXPECT_EQ(terms[0].x_mask, 0b100u);
+    EXPECT_EQ(terms[0].z_mask, 0b001u);
+    EXPECT_EQ(terms[1].x_mask, 0b010u);
+    EXPECT_EQ(terms[1].z_mask, 0b010u);
+    EXPECT_EQ(hamiltonian.qubits(), 3u);
+}
+
+TEST(PauliHamiltonianTest, MatrixFreeExpectationMatchesDenseMatrix) {
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> coefficient(-2.0, 2.0);
+    std::uniform_int_distribution<int> pauli(0, 3);
+    const char paulis[] = {'I', 'X', 'Y', 'Z'};
+
+    for (size_t qubits : {1, 3, 5}) {
+        PauliHamiltonian hamiltonian;
+        for (size_t t = 0; t < 12; ++t) {
+            std::string term;
+            for (size_t q = 0; q < qubits; ++q) {
+                term += paulis[pauli(gen)];
+            }
+            ASSERT_TRUE(hamiltonian.add_term(coefficient(gen), term));
+        }
+        Matrix dense = to_dense(hamiltonian, qubits);
+        for (int trial = 0; trial < 3; ++trial) {
+            StateVector state = random_state(qubits, gen);
+            EXPECT_NEAR(hamiltonian.expectation(state), dense_expectation(dense, state), 1e-10);
+        }
+    }
+}
+
+TEST(PauliHamiltonianTest, DenseDecompositionRoundTrips) {
+    PauliHamiltonian original;
+    original.add_term(0.7, "ZZ");
+    original.add_term(-0.3, "XY");
+    original.add_term(1.5, "IZ");
+    original.add_term(0.25, "II");
+
+    PauliHamiltonian decomposed = PauliHamiltonian::from_dense(to_dense(original, 2));
+    EXPECT_EQ(decomposed.term_count(), original.term_count());
+
+    std::mt19937 gen(3);
+    StateVector state = random_state(2, gen);
+    EXPECT_NEAR(decomposed.expectation(state), original.expectation(state), 1e-12);
+
+    EXPECT_EQ(PauliHamiltonian::from_dense(Matrix(3, std::vector<Complex>(3))).term_count(), 0u);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "benchmarks/perf_regression.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace feedhandler::benchmarks;
+
+namespace {
+
+PerfResult result(const std::string& name, double ns_per_op) {
+    PerfResult r;
+    r.name = name;
+    r.ns_per_op = ns_per_op;
+    r.ops_per_second = 1e9 / ns_per_op;
+    return r;
+}
+
+PerfHarness::Config quick_config() {
+    PerfHarness::Config config;
+    config.warmup_batches = 1;
+    config.repetitions = 3;
+    config.min_repetition_ns = 1000000;
+    config.perf_counters = false;
+    return config;
+}
+
+std::string temp_path(const char* name) {
+    return std::string(::testing::TempDir()) + name;
+}
+
+} // namespace
+
+TEST(PerfRegressionTest, ComparesInTheDirectionOfEachMetric) {
+    std::vector<PerfResult> results = {result("parse", 120.0), result("pool", 80.0)};
+    std::vector<PerfExpectation> expectations = {
+        {"parse", "ns_per_op", 100.0, 0.1},            // 20% slower
+        {"pool", "ns_per_op", 100.0, 0.1},             // 20% faster
+        {"parse", "ops_per_second", 1e9 / 119.0, 0.1}, // Within tolerance
+        {"pool", "ops_per_second", 1e9 / 100.0, 0.1},  // More throughput is better
+        {"absent", "ns_per_op", 100.0, 0.1},
+        {"parse", "ipc", 2.0, 0.1},                    // No counters in this run
+    };
+    std::vector<PerfComparison> comparisons = PerfHarness::compare(results, expectations);
+    ASSERT_EQ(comparisons.size(), expectations.size());
+    EXPECT_EQ(comparisons[0].status, PerfComparison::Status::REGRESSED);
+    EXPECT_NEAR(comparisons[0].change, 0.2, 1e-9);
+    EXPECT_EQ(comparisons[1].status, PerfComparison::Status::IMPROVED);
+    EXPECT_NEAR(comparisons[1].change, -0.2, 1e-9);
+    EXPECT_EQ(comparisons[2].status, PerfComparison::Status::OK);
+    EXPECT_EQ(comparisons[3].status, PerfComparison::Status::IMPROVED);
+    EXPECT_EQ(comparisons[4].status, PerfComparison::Status::MISSING);
+    EXPECT_EQ(comparisons[5].status, PerfComparison::Status::MISSING);
+
+    EXPECT_TRUE(PerfHarness::higher_is_better("ops_per_second"));
+    EXPECT_TRUE(PerfHarness::higher_is_better("ipc"));
+    EXPECT_FALSE(PerfHarness::higher_is_better("p99_ns"));
+}
+
+TEST(PerfRegressionTest, BaselineRoundTrips) {
+    std::string path = temp_path("perf_baseline_roundtrip.txt");
+    PerfResult counted = result("parse", 95.25);
+    counted.counters = true;
+    counted.instructions_per_op = 410.0;
+    std::vector<PerfResult> results = {counted, result("pool", 3.5)};
+    ASSERT_TRUE(PerfHarness::save_baseline(path, results, {"ns_per_op", "instructions_per_op"}, 0.2));
+
+    std::vector<PerfExpectation> expectations;
+    ASSERT_TRUE(PerfHarness::load_baseline(path, expectations));
+    // pool has no counters, so only its ns_per_op is written
+    ASSERT_EQ(expectations.size(), 3u);
+    EXPECT_EQ(expectations[0].scenario, "parse");
+    EXPECT_EQ(expectations[0].metric, "ns_per_op");
+    EXPECT_DOUBLE_EQ(expectations[0].baseline, 95.25);
+    EXPECT_DOUBLE_EQ(expectations[0].tolerance, 0.2);
+    EXPECT_EQ(expectations[1].metric, "instructions_per_op");
+    EXPECT_EQ(expectations[2].scenario, "pool");
+
+    for (const PerfComparison& comparison : PerfHarness::compare(results, expectations)) {
+        EXPECT_EQ(comparison.status, PerfComparison::Status::OK) << comparison.scenario << " " << comparison.metric;
+    }
+    std::remove(path.c_str());
+}
+
+TEST(PerfRegressionTest, RejectsMalformedBaselines) {
+    std::string path = temp_path("perf_baseline_malformed.txt");
+    std::vector<PerfExpectation> expectations = {{"kept", "ns_per_op", 1.0, 0.1}};
+    for (const char* line : {"parse ns_per_op 100", "parse ns_per_op 100 0.1 extra", "parse furlongs 100 0.1",
+                             "parse ns_per_op -5 0.1", "parse ns_per_op 100 -0.1", "parse ns_per_op fast 0.1"}) {
+        std::ofstream(path) << "# comment\n\n" << line << "\n";
+        EXPECT_FALSE(PerfHarness::load_baseline(path, expectations)) << line;
+        ASSERT_EQ(expectations.size(), 1u);
+        EXPECT_EQ(expectations[0].scenario, "kept");
+    }
+    std::ofstream(path) << "  # only comments\nparse ns_per_op 100 0.1   # trailing\n";
+    EXPECT_TRUE(PerfHarness::load_baseline(path, expectations));
+    ASSERT_EQ(expectations.size(), 1u);
+    EXPECT_EQ(expectations[0].scenario, "parse");
+    EXPECT_FALSE(PerfHarness::load_baseline(temp_path("perf_baseline_absent.txt"), expectations));
+    std::remove(path.c_str());
+}
+
+TEST(PerfRegressionTest, RunsScenariosAndCountsOperations) {
+    PerfHarness harness(quick_config());
+    size_t calls = 0;
+    harness.add({"counter.increment", 10, [&calls] { ++calls; }});
+    harness.add({"other.noop", 0, [] {}});
+    ASSERT_EQ(harness.scenarios().size(), 2u);
+    EXPECT_EQ(harness.scenarios()[1].ops_per_batch, 1u);
+
+    std::vector<PerfResult> results = harness.run("counter");
+    ASSERT_EQ(results.size(), 1u);
+    const PerfResult& r = results[0];
+    EXPECT_EQ(r.name, "counter.increment");
+    // Every timed batch counts ops_per_batch operations; warmup is not timed
+    EXPECT_EQ(r.operations, (calls - 1) * 10);
+    EXPECT_GE(r.operations, 3u * 10);
+    EXPECT_GT(r.ns_per_op, 0.0);
+    EXPECT_GT(r.ops_per_second, 0.0);
+    EXPECT_LE(r.p50_ns, r.p99_ns);
+    EXPECT_FALSE(r.counters);
+    double ipc;
+    EXPECT_FALSE(r.metric("ipc", ipc));
+    EXPECT_EQ(harness.run().size(), 2u);
+}
+
+TEST(PerfRegressionTest, WritesJsonPerScenario) {
+    PerfHarness harness(quick_config());
+    std::vector<PerfResult> results = {result("a\"b", 10.0), result("c", 20.0)};
+    std::ostringstream out;
+    harness.write_json(out, results);
+    std::string json = out.str();
+    EXPECT_NE(json.find("\"context\": {\"cpu\": -1, \"pinned\": false"), std::string::npos);
+    EXPECT_NE(json.find("{\"name\": \"a\\\"b\", \"operations\": 0"), std::string::npos);
+    EXPECT_NE(json.find("\"ns_per_op\": 20"), std::string::npos);
+    EXPECT_EQ(json.find("\"ipc\""), std::string::npos);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.substr(json.size() - 2), "}\n");
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include "config/performance_config.hpp"
+
+#include <unistd.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace feedhandler::config;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+void write_file(const fs::path& path, const std::string& contents) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << contents << "\n";
+}
+
+std::string read_file(const fs::path& path) {
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+// The singleton is shared by every test: each one starts from and restores the defaults
+class PerformanceConfigTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / ("perf_config_" + std::to_string(getpid()) + "_" +
+                                            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::create_directories(dir_);
+        reset();
+    }
+
+    void TearDown() override {
+        reset();
+        fs::remove_all(dir_);
+    }
+
+    static void reset() {
+        PerformanceConfig& config = PerformanceConfig::instance();
+        config.cpu() = {};
+        config.memory() = {};
+        config.parser() = {};
+        config.queue() = {};
+        config.monitoring() = {};
+    }
+
+    fs::path dir_;
+};
+
+} // namespace
+
+TEST(HardwareTopologyTest, ParsesKernelListsAndSizes) {
+    EXPECT_EQ(parse_cpu_list("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(parse_cpu_list("5"), std::vector<int>{5});
+    EXPECT_TRUE(parse_cpu_list("").empty());
+    EXPECT_TRUE(parse_cpu_list("3-1").empty());
+    EXPECT_TRUE(parse_cpu_list("0,x").empty());
+
+    EXPECT_EQ(parse_cache_size("48K"), 48u * 1024);
+    EXPECT_EQ(parse_cache_size("32M"), 32u * 1024 * 1024);
+    EXPECT_EQ(parse_cache_size("512"), 512u);
+    EXPECT_EQ(parse_cache_size("K"), 0u);
+}
+
+TEST_F(PerformanceConfigTest, DetectsTopologyFromSysfs) {
+    // Two packages, two hyperthreaded cores each, one NUMA node per package
+    const fs::path sys = dir_ / "sys";
+    const fs::path cpu = sys / "devices/system/cpu";
+    write_file(cpu / "online", "0-7");
+    write_file(cpu / "isolated", "6-7");
+    for (int id = 0; id < 8; ++id) {
+        const fs::path topology = cpu / ("cpu" + std::to_string(id)) / "topology";
+        write_file(topology / "core_id", std::to_string(id % 2));
+        write_file(topology / "physical_package_id", std::to_string(id / 4));
+    }
+    const fs::path cache = cpu / "cpu0/cache";
+    write_file(cache / "index0/level", "1");
+    write_file(cache / "index0/type", "Data");
+    write_file(cache / "index0/size", "48K");
+    write_file(cache / "index0/coherency_line_size", "64");
+    write_file(cache / "index1/level", "1");
+    write_file(cache / "index1/type", "Instruction");
+    write_file(cache / "index1/size", "32K");
+    write_file(cache / "index2/level", "2");
+    write_file(cache / "index2/type", "Unified");
+    write_file(cache / "index2/size", "2048K");
+    write_file(cache / "index3/level", "3");
+    write_file(cache / "index3/type", "Unified");
+    write_file(cache / "index3/size", "36M");
+    write_file(sys / "devices/system/node/online", "0-1");
+    write_file(sys / "devices/system/node/node0/cpulist", "0-3");
+    write_file(sys / "devices/system/node/node1/cpulist", "4-7");
+    write_file(sys / "kernel/mm/transparent_hugepage/enabled", "always [madvise] never");
+    write_file(dir_ / "proc/meminfo", "MemTotal:       65536000 kB\nHugePages_Total:     512\n"
+                                      "HugePages_Free:      500\nHugepagesize:       2048 kB");
+
+    HardwareTopology topology = detect_hardware_topology(sys.string(), (dir_ / "proc").string());
+    EXPECT_EQ(topology.logical_cpus(), 8u);
+    EXPECT_EQ(topology.physical_cores, 4u);  // Siblings 0/2, 1/3, 4/6, 5/7
+    ASSERT_EQ(topology.numa_nodes.size(), 2u);
+    EXPECT_EQ(topology.numa_nodes[1], (std::vector<int>{4, 5, 6, 7}));
+    EXPECT_EQ(topology.cpus[5].numa_node, 1);
+    EXPECT_EQ(topology.cpus[2].core, topology.cpus[0].core);
+    EXPECT_NE(topology.cpus[4].core, topology.cpus[0].core);
+    EXPECT_EQ(topology.core_leaders(), (std::vector<int>{0, 1, 4, 5}));
+    EXPECT_EQ(topology.core_leaders(1), (std::vector<int>{4, 5}));
+    EXPECT_EQ(topology.isolated_cpus, (std::vector<int>{6, 7}));
+
+    EXPECT_EQ(topology.l1d_bytes, 48u * 1024);  // Not the instruction cache
+    EXPECT_EQ(topology.l2_bytes, 2048u * 1024);
+    EXPECT_EQ(topology.l3_bytes, 36u * 1024 * 1024);
+    EXPECT_EQ(topology.cache_line_bytes, 64u);
+    EXPECT_EQ(topology.huge_page_bytes, 2u * 1024 * 1024);
+    EXPECT_EQ(topology.huge_pages_free, 500u);
+    EXPECT_EQ(topology.transparent_huge_pages, "madvise");
+
+    // Nothing readable: one CPU per core, a single node
+    HardwareTopology bare = detect_hardware_topology((dir_ / "missing").string(), (dir_ / "missing").string());
+    EXPECT_GE(bare.logical_cpus(), 1u);
+    EXPECT_EQ(bare.physical_cores, bare.logical_cpus());
+    EXPECT_EQ(bare.numa_nodes.size(), 1u);
+    EXPECT_EQ(bare.l2_bytes, 0u);
+}
+
+TEST_F(PerformanceConfigTest, SaveAndLoadRoundTrip) {
+    PerformanceConfig& config = PerformanceConfig::instance();
+    config.cpu().parser_thread_affinity = {2, 3};
+    config.cpu().numa_node = 1;
+    config.memory().zero_latency_pool_size = 64 * 1024 * 1024;
+    config.parser().simd_instruction_set = "SSE4.2";
+    config.queue().overflow_policy = "drop_oldest";
+    config.queue().ring_buffer_size = 4096;
+    config.monitoring().metrics_output_file = "out \"quoted\".json";
+    const fs::path file = dir_ / "config.json";
+    ASSERT_TRUE(config.save_to_file(file.string()));
+
+    reset();
+    ASSERT_TRUE(config.load_from_file(file.string()));
+    EXPECT_EQ(config.cpu().parser_thread_affinity, (std::vector<int>{2, 3}));
+    EXPECT_EQ(config.cpu().numa_node, 1);
+    EXPECT_EQ(config.memory().zero_latency_pool_size, 64u * 1024 * 1024);
+    EXPECT_EQ(config.parser().simd_instruction_set, "SSE4.2");
+    EXPECT_EQ(config.queue().overflow_policy, "drop_oldest");
+    EXPECT_EQ(config.queue().ring_buffer_size, 4096u);
+    EXPECT_EQ(config.monitoring().metrics_output_file, "out \"quoted\".json");
+
+    // Partial files only touch what they name; unknown keys are reported, not fatal
+    write_file(dir_ / "partial.json", R"({"queue": {"batch_size": 64, "typo_setting": 1}, "parser": {}})");
+    ASSERT_TRUE(config.load_from_file((dir_ / "partial.json").string()));
+    EXPECT_EQ(config.queue().batch_size, 64u);
+    EXPECT_EQ(config.queue().ring_buffer_size, 4096u);
+
+    // A bad value or malformed file applies nothing
+    write_file(dir_ / "bad.json", R"({"queue": {"ring_buffer_size": 8192, "batch_size": "many"}})");
+    EXPECT_FALSE(config.load_from_file((dir_ / "bad.json").string()));
+    EXPECT_EQ(config.queue().ring_buffer_size, 4096u);
+    write_file(dir_ / "broken.json", R"({"queue": {"ring_buffer_size": 8192)");
+    EXPECT_FALSE(config.load_from_file((dir_ / "broken.json").string()));
+    EXPECT_FALSE(config.load_from_file((dir_ / "absent.json").string()));
+    EXPECT_EQ(config.queue().ring_buffer_size, 4096u);
+}
+
+TEST_F(PerformanceConfigTest, AutoTuneMeasuresAndPersists) {
+    PerformanceConfig& config = PerformanceConfig::instance();
+    const fs::path file = dir_ / "tuned.json";
+    ASSERT_TRUE(config.auto_tune(file.string(), PerformanceConfig::TuningGoal::LATENCY));
+
+    const auto& tuning = config.tuning();
+    ASSERT_TRUE(tuning.measured);
+    ASSERT_FALSE(tuning.simd_levels.empty());
+    EXPECT_EQ(tuning.simd_levels.front().first, "SCALAR");
+    for (const auto& [level, ns] : tuning.simd_levels) {
+        EXPECT_GT(ns, 0.0) << level;
+    }
+    EXPECT_EQ(tuning.parser_batch_sizes.size(), 5u);
+    EXPECT_EQ(tuning.ring_sizes.front().first, 1024u);  // Never below the configured ring
+
+    // Every choice is one of the measured candidates
+    auto measured = [](const auto& timings, auto value) {
+        return std::any_of(timings.begin(), timings.end(), [&](const auto& t) { return t.first == value; });
+    };
+    EXPECT_TRUE(measured(tuning.simd_levels, config.parser().simd_instruction_set));
+    EXPECT_TRUE(measured(tuning.parser_batch_sizes, config.parser().batch_size));
+    EXPECT_TRUE(measured(tuning.ring_sizes, config.queue().ring_buffer_size));
+    EXPECT_TRUE(measured(tuning.queue_batch_sizes, config.queue().batch_size));
+    EXPECT_EQ(config.queue().enable_batching, config.queue().batch_size > 1);
+    EXPECT_GE(config.hardware().logical_cpus(), 1u);
+    if (!config.cpu().parser_thread_affinity.empty()) {
+        EXPECT_NE(config.cpu().parser_thread_affinity, config.cpu().network_thread_affinity);
+    }
+
+    // The file records the timings and loads back to the same settings
+    const std::string saved = read_file(file);
+    EXPECT_NE(saved.find("\"tuning\""), std::string::npos);
+    EXPECT_NE(saved.find("\"hardware\""), std::string::npos);
+    const size_t ring = config.queue().ring_buffer_size;
+    const std::string simd = config.parser().simd_instruction_set;
+    reset();
+    ASSERT_TRUE(config.load_from_file(file.string()));
+    EXPECT_EQ(config.queue().ring_buffer_size, ring);
+    EXPECT_EQ(config.parser().simd_instruction_set, simd);
+}
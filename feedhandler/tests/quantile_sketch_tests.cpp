@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "common/quantile_sketch.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace feedhandler::common;
+
+TEST(P2QuantileTest, ExactForTheFirstFewValues) {
+    P2Quantile median(0.5);
+    EXPECT_DOUBLE_EQ(median.value(), 0.0);
+    median.add(30);
+    median.add(10);
+    median.add(20);
+    EXPECT_DOUBLE_EQ(median.value(), 20.0);
+    EXPECT_EQ(median.count(), 3u);
+    median.reset();
+    EXPECT_EQ(median.count(), 0u);
+}
+
+TEST(P2QuantileTest, TracksQuantilesOfLongStreams) {
+    std::mt19937_64 rng(42);
+    std::exponential_distribution<double> latency(1.0 / 1000.0);  // Mean 1 us, long tail
+    std::vector<double> values;
+    P2Quantile p50(0.5);
+    P2Quantile p90(0.9);
+    P2Quantile p99(0.99);
+    for (int i = 0; i < 200000; ++i) {
+        double value = latency(rng);
+        values.push_back(value);
+        p50.add(value);
+        p90.add(value);
+        p99.add(value);
+    }
+    std::sort(values.begin(), values.end());
+    auto exact = [&](double q) { return values[static_cast<size_t>(q * static_cast<double>(values.size()))]; };
+    EXPECT_NEAR(p50.value(), exact(0.5), 0.02 * exact(0.5));
+    EXPECT_NEAR(p90.value(), exact(0.9), 0.02 * exact(0.9));
+    EXPECT_NEAR(p99.value(), exact(0.99), 0.03 * exact(0.99));
+}
+
+TEST(LatencySketchTest, SummarizesInConstantSpace) {
+    static_assert(sizeof(LatencySketch) < 512, "Cheap enough to keep per instrument");
+
+    LatencySketch sketch;
+    EXPECT_EQ(sketch.summary().count, 0u);
+    for (uint64_t i = 1; i <= 10000; ++i) {
+        sketch.record(i);
+    }
+    LatencySummary summary = sketch.summary();
+    EXPECT_EQ(summary.count, 10000u);
+    EXPECT_EQ(summary.max, 10000u);
+    EXPECT_DOUBLE_EQ(summary.mean, 5000.5);
+    EXPECT_NEAR(static_cast<double>(summary.p50), 5000.0, 100.0);
+    EXPECT_NEAR(static_cast<double>(summary.p99), 9900.0, 50.0);
+    EXPECT_LE(summary.p999, summary.max);
+}
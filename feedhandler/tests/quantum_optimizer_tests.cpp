@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "quantum/quantum_optimizer.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace feedhandler::quantum;
+
+TEST(QuantumOptimizerTest, QaoaFindsTheMinimumOfADiagonalCost) {
+    // Hamming distance to a target assignment: unique minimum of 0 at the target
+    const std::vector<double> target = {1, 0, 1, 1, 0, 0, 1};
+    auto cost = [&](const std::vector<double>& x) {
+        double distance = 0.0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            distance += std::abs(x[i] - target[i]);
+        }
+        return distance;
+    };
+
+    QuantumOptimizer optimizer;
+    auto result = optimizer.qaoa_optimize(cost, target.size(), 2);
+    EXPECT_EQ(result.optimal_weights, target);
+    EXPECT_DOUBLE_EQ(result.optimal_value, 0.0);
+    EXPECT_GT(result.iterations, 0u);
+}
+
+TEST(QuantumOptimizerTest, QaoaRejectsRegistersTooLargeToSimulate) {
+    QuantumOptimizer optimizer;
+    auto result = optimizer.qaoa_optimize([](const std::vector<double>&) { return 0.0; },
+                                          QuantumOptimizer::MAX_SIMULATED_QUBITS + 1, 1);
+    EXPECT_TRUE(result.optimal_weights.empty());
+}
+
+TEST(QuantumOptimizerTest, MultiStartResultDoesNotDependOnThreadCount) {
+    // Weighted max-cut on a ring: several local minima in the angles
+    auto cost = [](const std::vector<double>& x) {
+        double cut = 0.0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            double weight = 1.0 + 0.25 * static_cast<double>(i);
+            cut += weight * std::abs(x[i] - x[(i + 1) % x.size()]);
+        }
+        return -cut;
+    };
+
+    QuantumOptimizer::Config serial;
+    serial.starts = 6;
+    serial.threads = 1;
+    QuantumOptimizer::Config parallel = serial;
+    parallel.threads = 4;
+
+    auto a = QuantumOptimizer(serial).qaoa_optimize(cost, 6, 2);
+    auto b = QuantumOptimizer(parallel).qaoa_optimize(cost, 6, 2);
+    EXPECT_EQ(a.optimal_weights, b.optimal_weights);
+    EXPECT_EQ(a.optimal_value, b.optimal_value);
+    EXPECT_EQ(a.iterations, b.iterations);
+    // Every start's returned vertex is looked up again, not re-simulated
+    EXPECT_GE(a.cache_hits, serial.starts);
+}
+
+TEST(QuantumOptimizerTest, VqeReachesTheGroundEnergyOfAPauliSum) {
+    // Variance-like Z terms plus a transverse field: ground energy -sqrt(2) per qubit
+    PauliHamiltonian hamiltonian;
+    hamiltonian.add_term(1.0, "ZII");
+    hamiltonian.add_term(1.0, "IZI");
+    hamiltonian.add_term(1.0, "IIZ");
+    hamiltonian.add_term(1.0, "XII");
+    hamiltonian.add_term(1.0, "IXI");
+    hamiltonian.add_term(1.0, "IIX");
+
+    QuantumOptimizer optimizer;
+    auto result = optimizer.vqe_minimize_risk(hamiltonian, {});
+    EXPECT_NEAR(result.optimal_value, -3.0 * std::sqrt(2.0), 1e-3);
+    EXPECT_EQ(result.optimal_weights.size(), 3u);
+    EXPECT_GT(result.iterations, 0u);
+}
+
+TEST(QuantumOptimizerTest, DenseVqeMatchesPauliVqe) {
+    // Diagonal risk model: Z0 + 2 Z1 + 1.5 Z0 Z1, minimum -2.5 with only qubit 1 set
+    PauliHamiltonian hamiltonian;
+    hamiltonian.add_term(1.0, "ZI");
+    hamiltonian.add_term(2.0, "IZ");
+    hamiltonian.add_term(1.5, "ZZ");
+    std::vector<std::vector<QuantumOptimizer::Complex>> dense(4, std::vector<QuantumOptimizer::Complex>(4));
+    for (size_t z = 0; z < 4; ++z) {
+        double z0 = (z & 1) ? -1.0 : 1.0;
+        double z1 = (z & 2) ? -1.0 : 1.0;
+        dense[z][z] = z0 + 2.0 * z1 + 1.5 * z0 * z1;
+    }
+    QuantumOptimizer::QuantumState initial(4);
+    initial[0] = 1.0;
+
+    QuantumOptimizer optimizer;
+    auto from_dense = optimizer.vqe_minimize_risk(dense, initial);
+    auto from_paulis = optimizer.vqe_minimize_risk(hamiltonian, initial);
+    EXPECT_NEAR(from_dense.optimal_value, -2.5, 1e-4);
+    EXPECT_NEAR(from_paulis.optimal_value, from_dense.optimal_value, 1e-9);
+    EXPECT_EQ(from_paulis.optimal_weights, (std::vector<double>{0.0, 1.0}));
+
+    auto rejected = optimizer.vqe_minimize_risk(dense, QuantumOptimizer::QuantumState(3));
+    EXPECT_TRUE(rejected.optimal_weights.empty());
+}
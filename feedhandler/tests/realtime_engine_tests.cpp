@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include "analytics/realtime_engine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::analytics;
+
+namespace {
+
+common::Tick make_tick(char side, double price, int32_t qty, uint64_t timestamp) {
+    common::Tick tick;
+    tick.side = side;
+    tick.price = common::double_to_price(price);
+    tick.qty = qty;
+    tick.timestamp = timestamp;
+    return tick;
+}
+
+RealtimeEngine::Config small_config() {
+    RealtimeEngine::Config config;
+    config.max_symbols = 4;
+    config.history_depth = 8;
+    config.worker_threads = 2;
+    config.correlation_window = 32;
+    config.correlation_interval_ms = 1.0;
+    return config;
+}
+
+} // namespace
+
+TEST(RealtimeEngineTest, MetricsFollowTheWindow) {
+    RealtimeEngine engine(small_config());
+    engine.process_tick("AAPL", make_tick('B', 100.00, 100, 1000));
+    engine.process_tick("AAPL", make_tick('S', 100.10, 300, 2000));
+
+    auto metrics = engine.get_metrics("AAPL");
+    EXPECT_NEAR(metrics.vwap, (100.00 * 100 + 100.10 * 300) / 400, 1e-9);
+    EXPECT_NEAR(metrics.spread_bps, 0.10 / 100.05 * 10000.0, 1e-6);
+    // Bigger ask size pulls the microprice towards the bid
+    EXPECT_LT(metrics.microprice, 100.05);
+    EXPECT_EQ(metrics.total_volume, 400u);
+    EXPECT_DOUBLE_EQ(metrics.order_flow_imbalance, -0.5);
+    EXPECT_DOUBLE_EQ(metrics.participation_rate, 1.0);
+
+    // history_depth 8: the two opening ticks leave the window
+    for (int i = 0; i < 8; ++i) {
+        engine.process_tick("AAPL", make_tick('B', 101.00, 10, 3000 + static_cast<uint64_t>(i)));
+    }
+    metrics = engine.get_metrics("AAPL");
+    EXPECT_NEAR(metrics.vwap, 101.00, 1e-9);
+    EXPECT_DOUBLE_EQ(metrics.order_flow_imbalance, 1.0);
+    EXPECT_EQ(metrics.total_volume, 480u);
+
+    EXPECT_EQ(engine.get_metrics("UNKNOWN").total_volume, 0u);
+    EXPECT_EQ(engine.get_engine_stats().ticks_processed, 10u);
+}
+
+TEST(RealtimeEngineTest, BatchRowsAreProcessedLikeTicks) {
+    RealtimeEngine engine(small_config());
+    common::InstrumentId id = common::SymbolTable::global().intern("SOAB");
+    common::TickBatch batch(4);
+    for (const common::Tick& tick : {make_tick('B', 100.00, 100, 1000), make_tick('S', 100.10, 300, 2000)}) {
+        common::CompactTick compact = tick.to_compact();
+        compact.instrument_id = id;
+        batch.push_back(compact);
+    }
+    engine.process_batch(batch);
+
+    auto metrics = engine.get_metrics(id);
+    EXPECT_NEAR(metrics.vwap, (100.00 * 100 + 100.10 * 300) / 400, 1e-9);
+    EXPECT_EQ(metrics.total_volume, 400u);
+    EXPECT_DOUBLE_EQ(metrics.order_flow_imbalance, -0.5);
+    EXPECT_EQ(engine.get_engine_stats().ticks_processed, 2u);
+}
+
+TEST(RealtimeEngineTest, TradeSizeMedianAndSpreadQuantileAreWindowed) {
+    RealtimeEngine::Config config = small_config();
+    config.quantile_window = 4;
+    config.spread_quantile = 0.9;
+    RealtimeEngine engine(config);
+    engine.process_tick("QNTL", make_tick('B', 100.00, 100, 1000));
+    engine.process_tick("QNTL", make_tick('S', 100.10, 300, 2000));
+    engine.process_tick("QNTL", make_tick('B', 100.05, 50, 3000));
+    engine.process_tick("QNTL", make_tick('S', 100.20, 1000, 4000));
+
+    auto metrics = engine.get_metrics("QNTL");
+    EXPECT_DOUBLE_EQ(metrics.median_trade_size, 200.0);
+    // Three quoted spreads so far; the 0.9 quantile is the widest
+    EXPECT_NEAR(metrics.spread_quantile_bps, 0.15 / 100.125 * 10000.0, 1e-6);
+
+    engine.process_tick("QNTL", make_tick('B', 100.00, 10, 5000));  // 100 leaves the window
+    metrics = engine.get_metrics("QNTL");
+    EXPECT_DOUBLE_EQ(metrics.median_trade_size, 175.0);
+    EXPECT_NEAR(metrics.spread_quantile_bps, 0.20 / 100.10 * 10000.0, 1e-6);
+}
+
+TEST(RealtimeEngineTest, AlertsAndCallbacksFireOutsideTheLock) {
+    auto config = small_config();
+    config.spread_alert_bps = 20.0;
+    RealtimeEngine engine(config);
+
+    std::vector<std::string> alerts;
+    size_t updates = 0;
+    engine.register_alert_callback([&](const std::string& symbol, const std::string& type, double severity) {
+        EXPECT_EQ(symbol, "MSFT");
+        EXPECT_GT(severity, 1.0);
+        alerts.push_back(type);
+    });
+    engine.register_metrics_callback([&](const std::string& symbol, const RealtimeEngine::MarketMetrics&) {
+        engine.get_metrics(symbol);  // Re-entering the engine must not deadlock
+        ++updates;
+    });
+
+    engine.process_tick("MSFT", make_tick('B', 300.00, 10, 1));
+    engine.process_tick("MSFT", make_tick('S', 301.00, 10, 2));  // ~33 bps wide
+
+    EXPECT_EQ(updates, 2u);
+    ASSERT_FALSE(alerts.empty());
+    EXPECT_NE(std::find(alerts.begin(), alerts.end(), "WIDE_SPREAD"), alerts.end());
+    EXPECT_EQ(engine.get_engine_stats().alerts_generated, alerts.size());
+}
+
+TEST(RealtimeEngineTest, RangeEstimatorsUseClosedBars) {
+    auto config = small_config();
+    config.bars.interval_ns = 100;
+    config.bars.batch_size = 4;
+    config.bar_history = 3;
+    RealtimeEngine engine(config);
+    std::vector<Bar> published;
+    engine.register_bar_callback([&](const Bar* bars, size_t count) {
+        published.insert(published.end(), bars, bars + count);
+    });
+
+    // Bar k spans prices 100 .. 100 + k; no bar has closed before the second bucket
+    engine.process_tick("BARS", make_tick('B', 100.0, 10, 0));
+    EXPECT_EQ(engine.get_metrics("BARS").parkinson_volatility, 0.0);
+    BarVolatility expected(3);
+    for (int k = 1; k <= 5; ++k) {
+        uint64_t start = static_cast<uint64_t>(k) * 100;
+        engine.process_tick("BARS", make_tick('B', 100.0, 10, start));
+        engine.process_tick("BARS", make_tick('S', 100.0 + k, 10, start + 50));
+        Bar bar;
+        bar.open = bar.low = common::double_to_price(100.0);
+        bar.high = bar.close = common::double_to_price(100.0 + (k - 1));
+        bar.tick_count = 2;
+        expected.add(bar);
+    }
+    auto metrics = engine.get_metrics("BARS");
+    EXPECT_NEAR(metrics.parkinson_volatility, expected.parkinson(), 1e-15);
+    EXPECT_NEAR(metrics.garman_klass_volatility, expected.garman_klass(), 1e-15);
+
+    // A later tick for another symbol of the same worker expires the quiet bar
+    std::string other;
+    for (int i = 0; other.empty(); ++i) {
+        std::string candidate = "OTHER" + std::to_string(i);
+        if (engine.worker_for(common::SymbolTable::global().intern(candidate)) ==
+            engine.worker_for(common::SymbolTable::global().find("BARS"))) {
+            other = candidate;
+        }
+    }
+    engine.process_tick(other, make_tick('B', 50.0, 10, 10000));
+    engine.flush_bars();
+    ASSERT_EQ(published.size(), 6u);
+    EXPECT_EQ(published.back().start_ns, 500u);
+    EXPECT_EQ(published.back().high, common::double_to_price(105.0));
+    BarVolatility with_last = expected;
+    with_last.add(published.back());
+    EXPECT_NEAR(engine.get_metrics("BARS").parkinson_volatility, with_last.parkinson(), 1e-15);
+}
+
+TEST(RealtimeEngineTest, WorkersApplyTheirOwnSymbols) {
+    auto config = small_config();
+    config.max_symbols = 16;
+    config.history_depth = 64;
+    config.enable_cross_asset_analysis = false;
+    config.queue_capacity = 64;  // Small enough for the feed to hit backpressure
+    RealtimeEngine engine(config);
+    RealtimeEngine reference(config);  // Never started: applies on this thread
+
+    std::mutex mutex;
+    std::map<std::string, std::set<std::thread::id>> threads;
+    engine.register_metrics_callback([&](const std::string& symbol, const RealtimeEngine::MarketMetrics&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads[symbol].insert(std::this_thread::get_id());
+    });
+    engine.start();
+
+    std::vector<common::InstrumentId> ids;
+    for (int s = 0; s < 6; ++s) {
+        ids.push_back(common::SymbolTable::global().intern("OWN" + std::to_string(s)));
+    }
+    for (int i = 0; i < 3000; ++i) {
+        common::CompactTick tick;
+        tick.instrument_id = ids[static_cast<size_t>(i) % ids.size()];
+        tick.side = i % 3 ? 'B' : 'S';
+        tick.price = 1000000 + (i * 7919) % 500;
+        tick.qty = 1 + i % 50;
+        tick.timestamp = 1000 + static_cast<uint64_t>(i);
+        engine.process_tick(tick);
+        reference.process_tick(tick);
+    }
+    engine.stop();  // Drains the rings
+
+    EXPECT_EQ(engine.get_engine_stats().ticks_processed, 3000u);
+    for (auto id : ids) {
+        auto metrics = engine.get_metrics(id);
+        auto expected = reference.get_metrics(id);
+        EXPECT_EQ(metrics.total_volume, expected.total_volume);
+        EXPECT_DOUBLE_EQ(metrics.vwap, expected.vwap);
+        EXPECT_DOUBLE_EQ(metrics.realized_volatility, expected.realized_volatility);
+        EXPECT_DOUBLE_EQ(metrics.spread_bps, expected.spread_bps);
+        EXPECT_EQ(engine.get_metrics(std::string(common::SymbolTable::global().name(id))).total_volume,
+                  metrics.total_volume);
+        EXPECT_LT(engine.worker_for(id), config.worker_threads);
+    }
+
+    std::vector<RealtimeEngine::MarketMetrics> all;
+    ASSERT_EQ(engine.get_all_metrics(all), ids.size());
+    for (const auto& metrics : all) {
+        EXPECT_NE(std::find(ids.begin(), ids.end(), metrics.instrument_id), ids.end());
+        EXPECT_EQ(metrics.total_volume, reference.get_metrics(metrics.instrument_id).total_volume);
+    }
+
+    // Every symbol was applied by exactly one thread, never the feed thread
+    ASSERT_EQ(threads.size(), ids.size());
+    for (const auto& [symbol, seen] : threads) {
+        EXPECT_EQ(seen.size(), 1u) << symbol;
+        EXPECT_EQ(seen.count(std::this_thread::get_id()), 0u) << symbol;
+    }
+}
+
+TEST(RealtimeEngineTest, WorkersTrackCrossAssetCorrelation) {
+    RealtimeEngine engine(small_config());
+    engine.start();
+
+    // Two symbols moving together, one against them, sampled by the workers
+    auto aaa = common::SymbolTable::global().intern("AAA");
+    auto bbb = common::SymbolTable::global().intern("BBB");
+    auto ccc = common::SymbolTable::global().intern("CCC");
+    uint64_t timestamp = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    for (int step = 0; std::chrono::steady_clock::now() < deadline; ++step) {
+        double move = (step % 2 ? 1.0 : -1.0) * (1 + step % 3);
+        engine.process_tick("AAA", make_tick('B', 100.0 + move, 10, ++timestamp));
+        engine.process_tick("BBB", make_tick('B', 50.0 + move / 2, 10, ++timestamp));
+        engine.process_tick("CCC", make_tick('B', 80.0 - move, 10, ++timestamp));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        if (step > 20 && engine.correlation(aaa, bbb) != 0.0 && engine.correlation(aaa, ccc) != 0.0) {
+            EXPECT_GT(engine.correlation(aaa, bbb), 0.5);
+            EXPECT_LT(engine.correlation(aaa, ccc), -0.5);
+            break;
+        }
+    }
+    engine.stop();
+
+    std::vector<RealtimeEngine::Correlation> row;
+    ASSERT_EQ(engine.correlations(aaa, row), 2u);
+    for (const auto& entry : row) {
+        EXPECT_EQ(entry.correlation, engine.correlation(aaa, entry.instrument_id));
+        EXPECT_TRUE(entry.instrument_id == bbb || entry.instrument_id == ccc);
+    }
+    EXPECT_EQ(engine.correlations(common::INVALID_INSTRUMENT, row), 0u);
+    EXPECT_TRUE(row.empty());
+    EXPECT_GT(engine.get_metrics(aaa).beta_to_market, 0.0);
+}
@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+#include "net/receive_buffer.hpp"
+#include "parser/streaming_fix_handler.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace feedhandler::net;
+
+namespace {
+
+// Well-formed message with correct BodyLength and CheckSum
+std::string framed_message(const std::string& body) {
+    std::string message = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    char trailer[16];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u\x01",
+                  feedhandler::parser::FixFramer::checksum_scalar(message.data(), message.size()));
+    return message + trailer;
+}
+
+std::string quote_body(int i) {
+    return "35=D\x01" "55=SYM" + std::to_string(i % 7) + "\x01" "44=" + std::to_string(100 + i) + ".25\x01"
+           "38=" + std::to_string(10 + i) + "\x01" "54=" + (i % 2 ? "2" : "1") + "\x01";
+}
+
+ReceiveBufferConfig mirrored(size_t capacity) {
+    ReceiveBufferConfig config;
+    config.mode = ReceiveBufferMode::MIRRORED;
+    config.capacity = capacity;
+    return config;
+}
+
+} // namespace
+
+TEST(ReceiveBufferTest, CompactMovesUnreadToFront) {
+    ReceiveBuffer buffer;
+    buffer.write("abcdef", 6);
+    buffer.consume(4);
+    buffer.compact();
+
+    EXPECT_EQ(buffer.readable_bytes(), 2u);
+    EXPECT_EQ(std::string(buffer.read_ptr(), 2), "ef");
+    EXPECT_EQ(buffer.available_write(), ReceiveBuffer::BUFFER_SIZE - 2);
+    EXPECT_EQ(buffer.compaction_count(), 1u);
+}
+
+TEST(ReceiveBufferTest, LinearCapacityIsConfigurable) {
+    ReceiveBufferConfig config;
+    config.capacity = 1 << 20;
+    ReceiveBuffer buffer(config);
+
+    EXPECT_EQ(buffer.mode(), ReceiveBufferMode::LINEAR);
+    EXPECT_EQ(buffer.capacity(), 1u << 20);
+    EXPECT_EQ(buffer.available_write(), 1u << 20);
+}
+
+TEST(ReceiveBufferTest, MirroredRoundsToPages) {
+    ReceiveBuffer buffer(mirrored(1000));
+    ASSERT_EQ(buffer.mode(), ReceiveBufferMode::MIRRORED);
+    EXPECT_GE(buffer.capacity(), 1000u);
+    EXPECT_EQ(buffer.capacity() % 4096, 0u);
+}
+
+TEST(ReceiveBufferTest, MirroredDataWrapsContiguously) {
+    ReceiveBuffer buffer(mirrored(4096));
+    ASSERT_EQ(buffer.mode(), ReceiveBufferMode::MIRRORED);
+    const size_t capacity = buffer.capacity();
+
+    // Park the cursors 10 bytes before the end of the ring
+    std::string filler(capacity - 10, 'f');
+    ASSERT_EQ(buffer.write(filler.data(), filler.size()), filler.size());
+    buffer.consume(filler.size());
+
+    // A 30-byte message now straddles the end yet reads back in one piece
+    std::string message = "8=FIX.4.4|55=AAPL|44=1|10=000|";
+    EXPECT_EQ(buffer.available_write(), capacity);
+    ASSERT_EQ(buffer.write(message.data(), message.size()), message.size());
+    EXPECT_EQ(std::string(buffer.read_ptr(), buffer.readable_bytes()), message);
+
+    buffer.consume(message.size());
+    EXPECT_EQ(buffer.readable_bytes(), 0u);
+    EXPECT_EQ(buffer.compaction_count(), 0u);
+}
+
+TEST(ReceiveBufferTest, MirroredFillsToCapacity) {
+    ReceiveBuffer buffer(mirrored(4096));
+    ASSERT_EQ(buffer.mode(), ReceiveBufferMode::MIRRORED);
+    const size_t capacity = buffer.capacity();
+
+    buffer.write("xyz", 3);
+    buffer.consume(3);
+
+    std::string data(capacity, 'd');
+    EXPECT_EQ(buffer.write(data.data(), data.size()), capacity);
+    EXPECT_FALSE(buffer.has_space());
+    EXPECT_EQ(buffer.write("x", 1), 0u);
+
+    buffer.consume(1);
+    EXPECT_EQ(buffer.available_write(), 1u);
+}
+
+TEST(ReceiveBufferTest, StreamingHandlerNeverCompactsWhenMirrored) {
+    feedhandler::parser::StreamingFixHandler handler(mirrored(4096));
+    std::vector<feedhandler::common::Tick> ticks;
+
+    const std::string message = "8=FIX.4.4|35=D|55=MSFT|44=123.45|38=100|54=1|10=000|\n";
+    // Deliver in odd-sized reads so messages keep wrapping the ring
+    std::string stream;
+    for (int i = 0; i < 500; ++i) {
+        stream += message;
+    }
+    for (size_t offset = 0; offset < stream.size(); offset += 97) {
+        size_t len = std::min<size_t>(97, stream.size() - offset);
+        handler.process_incoming_data(stream.data() + offset, len, ticks);
+    }
+
+    EXPECT_EQ(ticks.size(), 500u);
+    EXPECT_EQ(handler.get_stats().buffer_compactions, 0u);
+    EXPECT_EQ(handler.get_stats().total_bytes_received, stream.size());
+}
+
+TEST(ReceiveBufferTest, StreamingHandlerStampsTicksWithArrivalTime) {
+    feedhandler::parser::StreamingFixHandler handler;
+    std::vector<feedhandler::common::Tick> ticks;
+
+    // The read that completes a message decides its timestamp
+    const std::string message = "8=FIX.4.4|35=D|55=MSFT|44=123.45|38=100|54=1|10=000|";
+    handler.process_incoming_data(message.data(), 20, ticks, 1000);
+    EXPECT_TRUE(ticks.empty());
+    handler.process_incoming_data(message.data() + 20, message.size() - 20, ticks, 2000);
+    handler.process_incoming_data(message.data(), message.size(), ticks, 3000);
+
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].timestamp, 2000u);
+    EXPECT_EQ(ticks[1].timestamp, 3000u);
+    EXPECT_EQ(handler.receive_buffer().receive_timestamp(), 3000u);
+    EXPECT_EQ(handler.parse_latency().snapshot().count(), 3u);  // One per parse call
+}
+
+TEST(ReceiveBufferTest, SimdStreamingHandlerResumesAcrossReads) {
+    feedhandler::parser::SimdStreamingFixHandler handler(mirrored(4096));
+    std::vector<feedhandler::common::Tick> ticks;
+
+    const std::string message = "8=FIX.4.4|35=D|55=MSFT|44=123.45|38=100|54=1|10=000|\n";
+    std::string stream;
+    for (int i = 0; i < 500; ++i) {
+        stream += message;
+    }
+    for (size_t offset = 0; offset < stream.size(); offset += 97) {
+        size_t len = std::min<size_t>(97, stream.size() - offset);
+        handler.process_incoming_data(stream.data() + offset, len, ticks);
+    }
+
+    ASSERT_EQ(ticks.size(), 500u);
+    EXPECT_EQ(ticks.back().symbol, "MSFT");
+    EXPECT_EQ(ticks.back().price, 1234500);
+    EXPECT_EQ(handler.buffer_bytes(), 0u);  // Partial fields live in the parser
+    EXPECT_EQ(handler.get_stats().buffer_compactions, 0u);
+}
+
+TEST(ReceiveBufferTest, FramingMatchesStreamingParser) {
+    // Whole messages, a heartbeat, newlines between messages
+    std::string stream;
+    for (int i = 0; i < 300; ++i) {
+        stream += framed_message(quote_body(i));
+        if (i % 50 == 0) {
+            stream += framed_message("35=0\x01") + "\n";
+        }
+    }
+
+    for (size_t chunk : {size_t{1}, size_t{61}, size_t{1000}, size_t{2000}}) {
+        feedhandler::parser::StreamingFixHandler plain;
+        feedhandler::parser::StreamingFixHandler framed(mirrored(4096));
+        framed.set_framing(true);
+        std::vector<feedhandler::common::Tick> expected;
+        std::vector<feedhandler::common::Tick> actual;
+        for (size_t offset = 0; offset < stream.size(); offset += chunk) {
+            size_t len = std::min(chunk, stream.size() - offset);
+            plain.process_incoming_data(stream.data() + offset, len, expected);
+            framed.process_incoming_data(stream.data() + offset, len, actual, 5000 + offset);
+        }
+
+        ASSERT_EQ(actual.size(), 300u) << "chunk " << chunk;
+        ASSERT_EQ(expected.size(), 300u);
+        for (size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_EQ(actual[i].symbol, expected[i].symbol);
+            EXPECT_EQ(actual[i].price, expected[i].price);
+            EXPECT_EQ(actual[i].qty, expected[i].qty);
+            EXPECT_EQ(actual[i].side, expected[i].side);
+            EXPECT_EQ(actual[i].instrument_id, expected[i].instrument_id);
+            EXPECT_GE(actual[i].timestamp, 5000u);
+        }
+        // Every message went around the state machine, heartbeats included
+        EXPECT_EQ(framed.get_stats().framed_messages, 306u) << "chunk " << chunk;
+        EXPECT_EQ(framed.get_stats().total_messages_parsed, 300u);
+        EXPECT_EQ(framed.buffer_bytes(), 0u);
+    }
+}
+
+TEST(ReceiveBufferTest, SymbolFilterSkipsUnsubscribedMessages) {
+    std::string stream;
+    for (int i = 0; i < 280; ++i) {
+        stream += framed_message(quote_body(i));
+    }
+    stream += framed_message("35=0\x01");  // No symbol: parsed, yields nothing
+
+    feedhandler::parser::SymbolFilter filter({"SYM3", "SYM5"});
+    for (bool framing : {false, true}) {
+        for (size_t chunk : {size_t{1}, size_t{97}, size_t{2000}}) {
+            feedhandler::parser::StreamingFixHandler handler(mirrored(4096));
+            handler.set_framing(framing);
+            handler.set_symbol_filter(&filter);
+            std::vector<feedhandler::common::Tick> ticks;
+            for (size_t offset = 0; offset < stream.size(); offset += chunk) {
+                size_t len = std::min(chunk, stream.size() - offset);
+                handler.process_incoming_data(stream.data() + offset, len, ticks);
+            }
+
+            ASSERT_EQ(ticks.size(), 80u) << "framing " << framing << " chunk " << chunk;
+            for (const auto& tick : ticks) {
+                EXPECT_TRUE(tick.symbol == "SYM3" || tick.symbol == "SYM5") << tick.symbol;
+            }
+            EXPECT_EQ(ticks[0].symbol, "SYM3");
+            EXPECT_EQ(ticks[0].price, 1032500);
+            EXPECT_EQ(handler.get_stats().filtered_messages, 200u);
+        }
+    }
+}
+
+TEST(ReceiveBufferTest, SymbolFilterAppliesToFallbackParse) {
+    // A BodyLength that lies sends the message to the resumable parser
+    std::string good = framed_message(quote_body(3));
+    std::string lying = "8=FIX.4.4\x01" "9=5\x01" + quote_body(1) + "10=000\x01";
+    std::string stream = good + lying + framed_message(quote_body(1)) + good;
+
+    feedhandler::parser::SymbolFilter filter({"SYM3"});
+    feedhandler::parser::StreamingFixHandler handler;
+    handler.set_framing(true);
+    handler.set_symbol_filter(&filter);
+    std::vector<feedhandler::common::Tick> ticks;
+    handler.process_incoming_data(stream.data(), stream.size(), ticks);
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].symbol, "SYM3");
+    EXPECT_EQ(ticks[1].symbol, "SYM3");
+    EXPECT_EQ(handler.get_stats().filtered_messages, 2u);
+
+    handler.set_symbol_filter(nullptr);
+    handler.process_incoming_data(stream.data(), stream.size(), ticks);
+    EXPECT_EQ(ticks.size(), 6u);
+}
+
+TEST(ReceiveBufferTest, FramingFallsBackAndResumes) {
+    feedhandler::parser::StreamingFixHandler handler;
+    handler.set_framing(true);
+    EXPECT_TRUE(handler.is_framing_enabled());
+    std::vector<feedhandler::common::Tick> ticks;
+
+    // BodyLength 60 points past the trailer: the trailer is already
+    // here, so the streaming parser takes it instead of waiting
+    const std::string lying = "8=FIX.4.4|9=60|35=D|55=MSFT|44=123.45|38=100|54=1|10=000|";
+    const std::string good = framed_message(quote_body(1));
+    std::string read1 = lying + good + good.substr(0, 20);
+    handler.process_incoming_data(read1.data(), read1.size(), ticks);
+    EXPECT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(handler.get_stats().framed_messages, 0u);
+
+    // The held fragment is finished by the streaming parser, then the
+    // framer takes over again
+    std::string read2 = good.substr(20) + good + good;
+    handler.process_incoming_data(read2.data(), read2.size(), ticks);
+    ASSERT_EQ(ticks.size(), 5u);
+    EXPECT_EQ(handler.get_stats().framed_messages, 2u);
+    EXPECT_EQ(ticks[0].symbol, "MSFT");
+    EXPECT_EQ(ticks[4].symbol, "SYM1");
+    EXPECT_EQ(ticks[4].price, ticks[2].price);
+
+    // Junk before a message
+    std::string read3 = "garbage" + good;
+    handler.process_incoming_data(read3.data(), read3.size(), ticks);
+    std::string read4 = good;
+    handler.process_incoming_data(read4.data(), read4.size(), ticks);
+    EXPECT_EQ(ticks.size(), 7u);
+    EXPECT_EQ(handler.get_stats().framed_messages, 3u);
+
+    // A partial message waits in the buffer, unparsed, until completed
+    handler.process_incoming_data(good.data(), 30, ticks);
+    EXPECT_EQ(handler.buffer_bytes(), 30u);
+    handler.process_incoming_data(good.data() + 30, good.size() - 30, ticks);
+    EXPECT_EQ(ticks.size(), 8u);
+    EXPECT_EQ(handler.buffer_bytes(), 0u);
+    EXPECT_EQ(handler.get_stats().framed_messages, 4u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+TEST(ReceiveBufferTest, LinearStorageFromArena) {
+    feedhandler::common::ZeroLatencyAllocator region(1 << 20, false, true);
+    auto arena = region.create_arena(64 * 1024);
+
+    ReceiveBufferConfig config;
+    config.capacity = 16 * 1024;
+    config.arena = &arena;
+    {
+        ReceiveBuffer buffer(config);
+        EXPECT_TRUE(buffer.arena_backed());
+        EXPECT_TRUE(arena.owns(buffer.write_buffer()));
+        EXPECT_EQ(buffer.write("8=FIX.4.4|", 10), 10u);
+        EXPECT_EQ(std::string(buffer.read_ptr(), 10), "8=FIX.4.4|");
+    }
+    EXPECT_EQ(arena.used(), 16u * 1024);
+
+    // Too small: falls back to the heap
+    config.capacity = 128 * 1024;
+    ReceiveBuffer heap_buffer(config);
+    EXPECT_FALSE(heap_buffer.arena_backed());
+    EXPECT_EQ(heap_buffer.capacity(), 128u * 1024);
+}
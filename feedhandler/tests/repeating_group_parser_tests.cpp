@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "parser/repeating_group_parser.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::common;
+using feedhandler::parser::RepeatingGroupParser;
+
+namespace {
+
+// 35=X with one 279/269/55/270/271 entry per level
+std::string make_incremental(size_t entries) {
+    std::string message = "8=FIX.4.4|35=X|268=" + std::to_string(entries) + "|";
+    for (size_t i = 0; i < entries; ++i) {
+        message += "279=" + std::to_string(i % 3) + "|269=" + std::to_string(i % 2) +
+                   "|55=SYM" + std::to_string(i % 4) + "|270=" + std::to_string(100 + i) +
+                   ".5|271=" + std::to_string(10 + i) + "|";
+    }
+    return message + "10=000|";
+}
+
+} // namespace
+
+TEST(RepeatingGroupParserTest, IncrementalRefreshEmitsEveryEntry) {
+    std::string message = make_incremental(200);
+    std::array<RepeatingGroupParser::MDEntry, 256> storage;
+    TickSpan<RepeatingGroupParser::MDEntry> entries(storage);
+
+    ASSERT_EQ(RepeatingGroupParser::parse_entries(message, entries), 200u);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        EXPECT_EQ(entries[i].update_action, static_cast<char>('0' + i % 3));
+        EXPECT_EQ(entries[i].entry_type, static_cast<char>('0' + i % 2));
+        EXPECT_EQ(entries[i].symbol, "SYM" + std::to_string(i % 4));
+        EXPECT_EQ(entries[i].price, static_cast<int64_t>(100 + i) * 10000 + 5000);
+        EXPECT_EQ(entries[i].size, static_cast<int32_t>(10 + i));
+        EXPECT_EQ(entries[i].instrument_id, SymbolTable::global().find(entries[i].symbol));
+    }
+}
+
+TEST(RepeatingGroupParserTest, EntriesStopAtSpanCapacity) {
+    std::string message = make_incremental(10);
+    std::array<RepeatingGroupParser::MDEntry, 4> storage;
+    TickSpan<RepeatingGroupParser::MDEntry> entries(storage);
+
+    EXPECT_EQ(RepeatingGroupParser::parse_entries(message, entries), 4u);
+    EXPECT_EQ(entries[3].size, 13);
+    EXPECT_EQ(RepeatingGroupParser::parse_entries(message, entries), 0u);
+}
+
+TEST(RepeatingGroupParserTest, NestedGroupDoesNotSplitEntry) {
+    std::string message = "8=FIX.4.4\x01" "35=X\x01" "268=2\x01"
+                          "279=0\x01" "269=0\x01" "55=AAPL\x01" "270=150.25\x01"
+                          "453=2\x01" "448=BRKA\x01" "447=D\x01" "452=1\x01" "448=BRKB\x01" "447=D\x01" "452=3\x01"
+                          "271=100\x01"
+                          "279=2\x01" "269=1\x01" "55=AAPL\x01" "270=150.50\x01" "271=0\x01"
+                          "10=000\x01";
+    std::array<RepeatingGroupParser::MDEntry, 8> storage;
+    TickSpan<RepeatingGroupParser::MDEntry> entries(storage);
+
+    ASSERT_EQ(RepeatingGroupParser::parse_entries(message, entries), 2u);
+    EXPECT_EQ(entries[0].price, 1502500);
+    EXPECT_EQ(entries[0].size, 100);  // After the nested parties, still the first entry
+    EXPECT_EQ(entries[1].update_action, '2');
+    EXPECT_EQ(entries[1].entry_type, '1');
+    EXPECT_EQ(entries[1].size, 0);
+}
+
+TEST(RepeatingGroupParserTest, TicksSkipDeletesAndMapSides) {
+    std::string message = "8=FIX.4.4|35=X|268=3|"
+                          "279=0|269=0|55=MSFT|270=400.00|271=5|"
+                          "279=2|269=1|55=MSFT|270=401.00|271=0|"
+                          "279=1|269=1|55=IBM|270=180.00|271=7|";
+    auto ticks = RepeatingGroupParser::parse_repeating_groups(message);
+
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].symbol, "MSFT");
+    EXPECT_EQ(ticks[0].side, 'B');
+    EXPECT_EQ(ticks[1].symbol, "IBM");
+    EXPECT_EQ(ticks[1].side, 'S');
+    EXPECT_EQ(ticks[1].timestamp, ticks[0].timestamp);
+}
+
+TEST(RepeatingGroupParserTest, SnapshotSharesMessageSymbol) {
+    std::string message = "8=FIX.4.4|35=W|55=TSLA|268=2|269=0|270=250.00|271=10|269=1|270=250.10|271=20|";
+    std::vector<CompactTick> ticks;
+
+    EXPECT_EQ(RepeatingGroupParser::parse_repeating_groups(message, ticks), 2u);
+    EXPECT_EQ(ticks[0].instrument_id, SymbolTable::global().find("TSLA"));
+    EXPECT_EQ(ticks[1].instrument_id, ticks[0].instrument_id);
+    EXPECT_EQ(ticks[1].qty, 20);
+}
+
+TEST(RepeatingGroupParserTest, MessageWithoutGroupIsSingleTick) {
+    auto ticks = RepeatingGroupParser::parse_repeating_groups("8=FIX.4.4|35=D|55=AAPL|44=150.25|38=500|54=2|");
+
+    ASSERT_EQ(ticks.size(), 1u);
+    EXPECT_EQ(ticks[0].price, 1502500);
+    EXPECT_EQ(ticks[0].qty, 500);
+    EXPECT_EQ(ticks[0].side, 'S');
+}
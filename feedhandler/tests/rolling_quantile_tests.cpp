@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "analytics/rolling_quantile.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace feedhandler::analytics;
+
+namespace {
+
+// Nearest-rank quantile of the last window values, by sorting
+int64_t reference(const std::vector<int64_t>& values, size_t window, double quantile) {
+    size_t count = std::min(values.size(), window);
+    std::vector<int64_t> sorted(values.end() - static_cast<std::ptrdiff_t>(count), values.end());
+    std::sort(sorted.begin(), sorted.end());
+    size_t rank = std::clamp<size_t>(static_cast<size_t>(quantile * static_cast<double>(count) + 0.5), 1, count);
+    return sorted[rank - 1];
+}
+
+} // namespace
+
+TEST(RollingQuantileTest, MedianOfTheLeetcode295Stream) {
+    RollingQuantile<int> median(16, 0.5);
+    EXPECT_TRUE(median.empty());
+    EXPECT_DOUBLE_EQ(median.interpolated(), 0.0);
+    median.push(1);
+    median.push(2);
+    EXPECT_DOUBLE_EQ(median.interpolated(), 1.5);
+    median.push(3);
+    EXPECT_DOUBLE_EQ(median.interpolated(), 2.0);
+    EXPECT_EQ(median.value(), 2);
+    EXPECT_EQ(median.rank(), 2u);
+}
+
+TEST(RollingQuantileTest, EvictsTheOldestValue) {
+    RollingQuantile<int> median(3, 0.5);
+    for (int value : {100, 1, 2}) {
+        median.push(value);
+    }
+    EXPECT_EQ(median.value(), 2);
+    median.push(3);  // 100 leaves
+    EXPECT_TRUE(median.full());
+    EXPECT_EQ(median.value(), 2);
+    median.push(4);
+    median.push(5);
+    EXPECT_EQ(median.value(), 4);
+
+    median.clear();
+    EXPECT_TRUE(median.empty());
+    median.push(7);
+    EXPECT_EQ(median.value(), 7);
+}
+
+TEST(RollingQuantileTest, MatchesSortedWindowAtAnyQuantile) {
+    std::mt19937 rng(295);
+    std::uniform_int_distribution<int64_t> dist(0, 50);  // Plenty of ties
+    for (double quantile : {0.0, 0.1, 0.5, 0.9, 0.99, 1.0}) {
+        for (size_t window : {1u, 2u, 7u, 64u}) {
+            RollingQuantile<int64_t> rolling(window, quantile);
+            std::vector<int64_t> values;
+            for (int i = 0; i < 2000; ++i) {
+                values.push_back(dist(rng));
+                rolling.push(values.back());
+                ASSERT_EQ(rolling.value(), reference(values, window, quantile))
+                    << "quantile " << quantile << " window " << window << " step " << i;
+            }
+        }
+    }
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include "analytics/rolling_window.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::analytics;
+
+namespace {
+
+common::CompactTick make_tick(char side, int64_t price, int32_t qty, uint64_t timestamp) {
+    common::CompactTick tick;
+    tick.instrument_id = 1;
+    tick.side = side;
+    tick.price = price;
+    tick.qty = qty;
+    tick.timestamp = timestamp;
+    return tick;
+}
+
+// Statistics recomputed from scratch over the last n ticks
+struct Reference {
+    double vwap = 0, twap = 0, high = 0, low = 0, volatility = 0, parkinson = 0, garman_klass = 0, flow = 0;
+
+    explicit Reference(const std::vector<common::CompactTick>& ticks) {
+        double pq = 0, volume = 0, buys = 0, sells = 0, weighted = 0;
+        int64_t hi = ticks.front().price, lo = ticks.front().price;
+        std::vector<double> returns;
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            pq += static_cast<double>(ticks[i].price) * ticks[i].qty;
+            volume += ticks[i].qty;
+            (ticks[i].side == 'B' ? buys : sells) += ticks[i].qty;
+            hi = std::max(hi, ticks[i].price);
+            lo = std::min(lo, ticks[i].price);
+            if (i > 0) {
+                weighted += static_cast<double>(ticks[i - 1].price) *
+                            static_cast<double>(ticks[i].timestamp - ticks[i - 1].timestamp);
+                returns.push_back(std::log(static_cast<double>(ticks[i].price) / static_cast<double>(ticks[i - 1].price)));
+            }
+        }
+        vwap = pq / volume / 10000.0;
+        twap = weighted / static_cast<double>(ticks.back().timestamp - ticks.front().timestamp) / 10000.0;
+        high = static_cast<double>(hi) / 10000.0;
+        low = static_cast<double>(lo) / 10000.0;
+        flow = (buys - sells) / (buys + sells);
+
+        double mean = 0;
+        for (double r : returns) {
+            mean += r;
+        }
+        mean /= static_cast<double>(returns.size());
+        double m2 = 0;
+        for (double r : returns) {
+            m2 += (r - mean) * (r - mean);
+        }
+        volatility = std::sqrt(m2 / static_cast<double>(returns.size() - 1));
+
+        double range = std::log(high / low);
+        double body = std::log(static_cast<double>(ticks.back().price) / static_cast<double>(ticks.front().price));
+        parkinson = std::sqrt(range * range / (4.0 * std::log(2.0)));
+        garman_klass = std::sqrt(std::max(0.5 * range * range - (2.0 * std::log(2.0) - 1.0) * body * body, 0.0));
+    }
+};
+
+} // namespace
+
+TEST(HistoryRingTest, KeepsTheMostRecentValues) {
+    HistoryRing<int> ring(3);
+    EXPECT_TRUE(ring.empty());
+    for (int i = 1; i <= 5; ++i) {
+        ring.push_back(i);
+    }
+    ASSERT_EQ(ring.size(), 3u);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring[0], 3);
+    EXPECT_EQ(ring[2], 5);
+    EXPECT_EQ(ring.front(), 3);
+    EXPECT_EQ(ring.back(), 5);
+
+    ring.pop_front();
+    ring.pop_back();
+    ASSERT_EQ(ring.size(), 1u);
+    EXPECT_EQ(ring.front(), 4);
+    ring.push_back(6);
+    ring.push_back(7);
+    EXPECT_EQ(ring[0], 4);
+    EXPECT_EQ(ring[2], 7);
+}
+
+TEST(MonotonicWindowTest, MatchesRecomputationOverCountWindows) {
+    // The leetcode 239 example, then a random walk against a rescan
+    SlidingMax<int> max3(3);
+    std::vector<int> maxima;
+    for (int value : {1, 3, -1, -3, 5, 3, 6, 7}) {
+        max3.push(value);
+        if (max3.pushed() >= 3) {
+            maxima.push_back(max3.best());
+        }
+    }
+    EXPECT_EQ(maxima, (std::vector<int>{3, 3, 5, 5, 6, 7}));
+
+    constexpr size_t WINDOW = 17;
+    SlidingMax<int64_t> highs(WINDOW);
+    SlidingMin<int64_t> lows(WINDOW);
+    std::mt19937 rng(239);
+    std::uniform_int_distribution<int> step(-3, 3);
+    std::vector<int64_t> values;
+    int64_t value = 0;
+    for (int i = 0; i < 5000; ++i) {
+        value += step(rng);
+        values.push_back(value);
+        highs.push(value);
+        lows.push(value);
+        auto first = values.end() - static_cast<std::ptrdiff_t>(std::min(values.size(), WINDOW));
+        ASSERT_EQ(highs.best(), *std::max_element(first, values.end())) << i;
+        ASSERT_EQ(lows.best(), *std::min_element(first, values.end())) << i;
+    }
+    highs.clear();
+    EXPECT_TRUE(highs.empty());
+}
+
+TEST(MonotonicWindowTest, TimeWindowsExpireByTimestamp) {
+    SlidingMax<int> highs(64, 100);  // 100 ns, at most 64 values
+    highs.push(9, 0);
+    highs.push(5, 50);
+    highs.push(7, 60);
+    EXPECT_EQ(highs.best(), 9);
+    highs.push(1, 99);
+    EXPECT_EQ(highs.best(), 9);
+    highs.push(2, 100);  // 9 is now 100 ns old
+    EXPECT_EQ(highs.best(), 7);
+    EXPECT_EQ(highs.best_timestamp(), 60u);
+    highs.expire(200);
+    EXPECT_TRUE(highs.empty());
+
+    // Count window still bounds a time window
+    SlidingMin<int> lows(2, 1000);
+    lows.push(1, 0);
+    lows.push(5, 1);
+    lows.push(6, 2);
+    EXPECT_EQ(lows.best(), 5);
+}
+
+TEST(RollingTickWindowTest, MatchesRecomputationAsTicksAreEvicted) {
+    constexpr size_t CAPACITY = 50;
+    RollingTickWindow window(CAPACITY);
+    std::vector<common::CompactTick> all;
+    std::mt19937 rng(5);
+    int64_t price = 1000000;
+    uint64_t timestamp = 1000;
+
+    for (int i = 0; i < 2000; ++i) {
+        price = std::max<int64_t>(price + static_cast<int64_t>(rng() % 201) - 100, 1000);
+        timestamp += 1 + rng() % 1000;
+        all.push_back(make_tick(rng() % 3 ? 'B' : 'S', price, static_cast<int32_t>(1 + rng() % 1000), timestamp));
+        ASSERT_TRUE(window.push(all.back()));
+
+        if (i < 3 || i % 97 != 0) {
+            continue;
+        }
+        size_t n = std::min(all.size(), CAPACITY);
+        std::vector<common::CompactTick> last(all.end() - static_cast<std::ptrdiff_t>(n), all.end());
+        Reference expected(last);
+        ASSERT_EQ(window.size(), n);
+        EXPECT_NEAR(window.vwap(), expected.vwap, 1e-9);
+        EXPECT_NEAR(window.twap(), expected.twap, 1e-9);
+        EXPECT_DOUBLE_EQ(window.high(), expected.high);
+        EXPECT_DOUBLE_EQ(window.low(), expected.low);
+        EXPECT_NEAR(window.realized_volatility(), expected.volatility, 1e-12);
+        EXPECT_NEAR(window.parkinson_volatility(), expected.parkinson, 1e-12);
+        EXPECT_NEAR(window.garman_klass_volatility(), expected.garman_klass, 1e-12);
+        EXPECT_NEAR(window.order_flow_imbalance(), expected.flow, 1e-12);
+        EXPECT_EQ(window.return_count(), n - 1);
+    }
+}
+
+TEST(RollingTickWindowTest, IgnoresInvalidTicksAndHandlesSingleTick) {
+    RollingTickWindow window(4);
+    EXPECT_FALSE(window.push(make_tick('B', 0, 10, 1)));
+    EXPECT_FALSE(window.push(make_tick('B', 100, 0, 1)));
+    EXPECT_TRUE(window.empty());
+    EXPECT_EQ(window.vwap(), 0.0);
+
+    ASSERT_TRUE(window.push(make_tick('S', 1500000, 10, 5)));
+    EXPECT_DOUBLE_EQ(window.vwap(), 150.0);
+    EXPECT_DOUBLE_EQ(window.twap(), 150.0);  // No time elapsed yet
+    EXPECT_EQ(window.realized_volatility(), 0.0);
+    EXPECT_EQ(window.parkinson_volatility(), 0.0);
+    EXPECT_DOUBLE_EQ(window.order_flow_imbalance(), -1.0);
+
+    window.clear();
+    EXPECT_TRUE(window.empty());
+    EXPECT_EQ(window.volume(), 0);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "threading/seqlock.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace feedhandler::threading;
+
+namespace {
+
+// Every field derived from one counter, so a torn copy is detectable
+struct Record {
+    uint64_t sequence;
+    double doubled;
+    int32_t negated;
+    char tag;  // Size not a multiple of 8
+};
+
+Record make_record(uint64_t k) {
+    return Record{k, static_cast<double>(k) * 2.0, -static_cast<int32_t>(k), static_cast<char>('a' + k % 26)};
+}
+
+} // namespace
+
+TEST(SeqlockTest, StoresAndLoads) {
+    Seqlock<Record> cell;
+    EXPECT_EQ(cell.version(), 1u);
+    EXPECT_EQ(cell.load().sequence, 0u);
+
+    cell.store(make_record(7));
+    Record record{};
+    ASSERT_TRUE(cell.try_load(record));
+    EXPECT_EQ(record.sequence, 7u);
+    EXPECT_EQ(record.doubled, 14.0);
+    EXPECT_EQ(record.negated, -7);
+    EXPECT_EQ(record.tag, 'h');
+    EXPECT_EQ(cell.version(), 2u);
+}
+
+TEST(SeqlockTest, ReadersNeverSeeTornValues) {
+    Seqlock<Record> cell(make_record(0));
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> reads{0};
+
+    auto reader = [&] {
+        uint64_t last = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            Record record = cell.load();
+            Record expected = make_record(record.sequence);
+            if (record.doubled != expected.doubled || record.negated != expected.negated ||
+                record.tag != expected.tag || record.sequence < last) {
+                torn.fetch_add(1, std::memory_order_relaxed);
+            }
+            last = record.sequence;
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    std::thread first(reader);
+    std::thread second(reader);
+
+    for (uint64_t k = 1; k <= 200000; ++k) {
+        cell.store(make_record(k));
+    }
+    // Keep writing until both readers have had a chance to run
+    for (uint64_t k = 200001; reads.load(std::memory_order_relaxed) < 1000; ++k) {
+        cell.store(make_record(k));
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    first.join();
+    second.join();
+
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_GE(cell.load().sequence, 200000u);
+}
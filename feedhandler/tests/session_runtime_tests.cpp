@@ -0,0 +1,414 @@
+#include <gtest/gtest.h>
+#include "net/session_runtime.hpp"
+#include "net/receive_buffer.hpp"
+#include "net/tcp_client.hpp"
+#include "parser/fsm_fix_parser.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::net;
+
+namespace {
+
+// Non-blocking connected socket pair, closed on destruction
+struct SocketPair {
+    int fds[2] = {-1, -1};
+
+    SocketPair() {
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0) {
+            fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+        }
+    }
+    ~SocketPair() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    int reader() const { return fds[0]; }
+    void send(const char* data) { ASSERT_GT(::write(fds[1], data, strlen(data)), 0); }
+    void drain() {
+        char buf[256];
+        while (::read(fds[0], buf, sizeof(buf)) > 0) {}
+    }
+};
+
+// Non-blocking loopback listener on an ephemeral port
+class Listener {
+public:
+    Listener() {
+        fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(fd_, 64);
+        socklen_t len = sizeof(addr);
+        getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+    ~Listener() { ::close(fd_); }
+
+    int fd() const { return fd_; }
+    int port() const { return port_; }
+
+private:
+    int fd_;
+    int port_;
+};
+
+SessionRuntimeConfig config_for(EventBackend backend) {
+    SessionRuntimeConfig config;
+    config.loop.backend = backend;
+    return config;
+}
+
+Task<int> add_later(SessionRuntime& runtime, int a, int b) {
+    co_await runtime.sleep_for(0);
+    co_return a + b;
+}
+
+Task<int> fail_later(SessionRuntime& runtime) {
+    co_await runtime.sleep_for(0);
+    throw std::runtime_error("logon rejected");
+}
+
+Task<> sleeper(SessionRuntime& runtime, int ms, std::vector<int>& order) {
+    co_await runtime.sleep_for(ms);
+    order.push_back(ms);
+}
+
+std::string trade(int qty) {
+    return "8=FIX.4.4|35=D|55=CORO|44=100.25|38=" + std::to_string(qty) + "|54=1|10=000|\n";
+}
+
+// Venue side of one connection: waits for the logon, sends a burst,
+// goes quiet long enough to draw heartbeats, sends another and hangs up
+Task<> venue(SessionRuntime& runtime, int fd, int burst, int& heartbeats) {
+    std::string received;
+    char chunk[256];
+    while (received.find("35=A|") == std::string::npos) {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+        if (n > 0) {
+            received.append(chunk, static_cast<size_t>(n));
+        } else if (n == 0 || !co_await runtime.readable(fd, 1000)) {
+            break;
+        }
+    }
+
+    for (int round = 0; round < 2; ++round) {
+        std::string out;
+        for (int i = 1; i <= burst; ++i) {
+            out += trade(i);
+        }
+        EXPECT_EQ(::send(fd, out.data(), out.size(), MSG_NOSIGNAL), static_cast<ssize_t>(out.size()));
+        if (round == 0) {
+            co_await runtime.sleep_for(60);
+        }
+    }
+
+    // Heartbeats sent during the quiet spell are waiting by now
+    received.clear();
+    for (ssize_t n; (n = ::recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT)) > 0;) {
+        received.append(chunk, static_cast<size_t>(n));
+    }
+    for (size_t pos = 0; (pos = received.find("35=0|", pos)) != std::string::npos; ++pos) {
+        ++heartbeats;
+    }
+    runtime.forget(fd);
+    ::close(fd);
+}
+
+Task<> acceptor(SessionRuntime& runtime, Listener& listener, int peers, int burst, int& heartbeats) {
+    for (int accepted = 0; accepted < peers;) {
+        int fd = ::accept4(listener.fd(), nullptr, nullptr, SOCK_NONBLOCK);
+        if (fd >= 0) {
+            runtime.spawn(venue(runtime, fd, burst, heartbeats));
+            ++accepted;
+        } else if (!co_await runtime.readable(listener.fd(), 2000)) {
+            ADD_FAILURE() << "No connection within 2s";
+            co_return;
+        }
+    }
+    runtime.forget(listener.fd());
+}
+
+struct FeedStats {
+    size_t ticks = 0;
+    int64_t volume = 0;
+    int heartbeats_sent = 0;
+    bool connected = false;
+    bool closed_by_peer = false;
+};
+
+// Client side: connect, log on, parse until the venue hangs up, sending
+// a heartbeat whenever it is quiet for 20ms
+Task<> feed(SessionRuntime& runtime, int port, FeedStats& stats) {
+    TcpClient client;
+    ReceiveBuffer buffer;
+    parser::FSMFixParser parser;
+    std::vector<common::Tick> ticks;
+
+    stats.connected = co_await async_connect(runtime, client, "127.0.0.1", port, 2000);
+    if (!stats.connected) {
+        co_return;
+    }
+    client.queue("8=FIX.4.4|35=A|108=1|10=000|\n");
+    EXPECT_TRUE(co_await async_flush(runtime, client, 1000));
+
+    while (true) {
+        ssize_t received = co_await async_read(runtime, client, buffer, 20);
+        if (received < 0) {
+            stats.closed_by_peer = true;
+            break;
+        }
+        if (received == 0) {
+            client.queue("8=FIX.4.4|35=0|10=000|\n");
+            ++stats.heartbeats_sent;
+            EXPECT_TRUE(co_await async_flush(runtime, client, 1000));
+            continue;
+        }
+        ticks.clear();
+        buffer.consume(parser.parse(buffer.read_ptr(), buffer.readable_bytes(), ticks));
+        for (const common::Tick& tick : ticks) {
+            ++stats.ticks;
+            stats.volume += tick.qty;
+        }
+    }
+    async_close(runtime, client);
+}
+
+} // namespace
+
+TEST(SessionRuntimeTest, TasksChainValuesAndExceptions) {
+    SessionRuntime runtime;
+    int sum = 0;
+    std::string error;
+    auto session = [&]() -> Task<> {
+        sum = co_await add_later(runtime, 2, 3);
+        sum += co_await add_later(runtime, sum, 10);
+        try {
+            co_await fail_later(runtime);
+        } catch (const std::runtime_error& e) {
+            error = e.what();
+        }
+    };
+    runtime.spawn(session());
+    EXPECT_EQ(runtime.session_count(), 1u);
+    EXPECT_EQ(sum, 0);  // Suspended in its first sleep_for(0)
+
+    runtime.run();
+    EXPECT_EQ(sum, 20);
+    EXPECT_EQ(error, "logon rejected");
+    EXPECT_EQ(runtime.session_count(), 0u);
+
+    // Escaping the session: counted, not propagated
+    auto failing = [&]() -> Task<> { co_await fail_later(runtime); };
+    runtime.spawn(failing());
+    auto instant = []() -> Task<> { co_return; };
+    runtime.spawn(instant());  // Done inside spawn()
+    EXPECT_EQ(runtime.session_count(), 1u);
+    runtime.run();
+    EXPECT_EQ(runtime.stats().spawned, 3u);
+    EXPECT_EQ(runtime.stats().finished, 3u);
+    EXPECT_EQ(runtime.stats().failed, 1u);
+}
+
+TEST(SessionRuntimeTest, SleepsEndInDeadlineOrder) {
+    SessionRuntime runtime;
+    std::vector<int> order;
+    auto start = SessionRuntime::Clock::now();
+    for (int ms : {30, 10, 20, 0}) {
+        runtime.spawn(sleeper(runtime, ms, order));
+    }
+    runtime.run();
+    EXPECT_EQ(order, (std::vector<int>{0, 10, 20, 30}));
+    EXPECT_GE(SessionRuntime::Clock::now() - start, std::chrono::milliseconds(30));
+    EXPECT_EQ(runtime.stats().timeouts, 0u);  // Sleeps are not timeouts
+}
+
+TEST(SessionRuntimeTest, StopEndsRunFromAnotherThread) {
+    SessionRuntime runtime;
+    bool woke = false;
+    // Lambda coroutines keep referring to their closure: keep it alive
+    auto session = [&]() -> Task<> {
+        co_await runtime.sleep_for(60000);
+        woke = true;
+    };
+    runtime.spawn(session());
+    std::thread stopper([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        runtime.stop();
+    });
+    runtime.run();
+    stopper.join();
+    EXPECT_FALSE(woke);
+    EXPECT_EQ(runtime.session_count(), 1u);  // Destroyed with the runtime
+}
+
+class SessionRuntimeBackendTest : public ::testing::TestWithParam<EventBackend> {};
+
+TEST_P(SessionRuntimeBackendTest, ReadableWaitsTimeOutAndWake) {
+    SessionRuntime runtime(config_for(GetParam()));
+    SocketPair pair;
+    std::vector<bool> results;
+
+    auto reader = [&]() -> Task<> {
+        results.push_back(co_await runtime.readable(pair.reader(), 10));  // Nothing yet
+        results.push_back(co_await runtime.readable(pair.reader(), 1000));
+        pair.drain();
+    };
+    auto writer = [&]() -> Task<> {
+        co_await runtime.sleep_for(30);
+        pair.send("8=FIX.4.4|");
+    };
+    runtime.spawn(reader());
+    runtime.spawn(writer());
+    runtime.run();
+    EXPECT_EQ(results, (std::vector<bool>{false, true}));
+    EXPECT_EQ(runtime.stats().timeouts, 1u);
+}
+
+TEST_P(SessionRuntimeBackendTest, ReadyWhileBusyIsNotLost) {
+    SessionRuntime runtime(config_for(GetParam()));
+    SocketPair pair;
+    bool ready = false;
+
+    auto session = [&]() -> Task<> {
+        co_await runtime.readable(pair.reader(), 0);  // Watched from here on
+        pair.send("x");
+        co_await runtime.sleep_for(20);  // Busy elsewhere while it is reported
+        ready = co_await runtime.readable(pair.reader(), 0);
+    };
+    runtime.spawn(session());
+    runtime.run();
+    EXPECT_TRUE(ready);
+}
+
+TEST_P(SessionRuntimeBackendTest, ForgetWakesWaitersWithFalse) {
+    SessionRuntime runtime(config_for(GetParam()));
+    SocketPair pair;
+    std::vector<bool> results;
+
+    auto waiter = [&]() -> Task<> { results.push_back(co_await runtime.readable(pair.reader())); };
+    auto forgetter = [&]() -> Task<> {
+        results.push_back(co_await runtime.readable(pair.reader(), 0));  // Someone is already waiting
+        runtime.forget(pair.reader());
+    };
+    runtime.spawn(waiter());
+    EXPECT_EQ(runtime.watched_sockets(), 1u);
+    runtime.spawn(forgetter());
+    runtime.run();
+    EXPECT_EQ(results, (std::vector<bool>{false, false}));
+    EXPECT_EQ(runtime.watched_sockets(), 0u);
+}
+
+TEST_P(SessionRuntimeBackendTest, FlushWaitsForTheSocketToDrain) {
+    SessionRuntime runtime(config_for(GetParam()));
+    Listener listener;
+    TcpClientConfig client_config;
+    client_config.send_ring_bytes = 8 << 20;
+    TcpClient client(client_config);
+    const std::string payload(4 << 20, 'x');
+    size_t drained = 0;
+    std::vector<bool> flushes;
+
+    auto sender = [&]() -> Task<> {
+        if (!co_await async_connect(runtime, client, "127.0.0.1", listener.port(), 1000)) {
+            ADD_FAILURE() << "connect failed";
+            co_return;
+        }
+        EXPECT_TRUE(client.queue(payload));
+        flushes.push_back(co_await async_flush(runtime, client, 20));  // Peer not reading yet
+        flushes.push_back(co_await async_flush(runtime, client, 5000));
+        async_close(runtime, client);
+    };
+    auto receiver = [&]() -> Task<> {
+        int fd = -1;
+        while ((fd = ::accept4(listener.fd(), nullptr, nullptr, SOCK_NONBLOCK)) < 0) {
+            co_await runtime.readable(listener.fd(), 1000);
+        }
+        runtime.forget(listener.fd());
+        co_await runtime.sleep_for(50);
+        std::vector<char> chunk(1 << 16);
+        while (drained < payload.size()) {
+            ssize_t n = ::recv(fd, chunk.data(), chunk.size(), MSG_DONTWAIT);
+            if (n > 0) {
+                drained += static_cast<size_t>(n);
+            } else if (n == 0 || !co_await runtime.readable(fd, 5000)) {
+                break;
+            }
+        }
+        runtime.forget(fd);
+        ::close(fd);
+    };
+    runtime.spawn(sender());
+    runtime.spawn(receiver());
+    runtime.run();
+    EXPECT_EQ(flushes, (std::vector<bool>{false, true}));
+    EXPECT_EQ(drained, payload.size());
+}
+
+TEST_P(SessionRuntimeBackendTest, OneThreadDrivesManyFeedSessions) {
+    constexpr int PEERS = 8;
+    constexpr int BURST = 50;
+    SessionRuntime runtime(config_for(GetParam()));
+    Listener listener;
+    int venue_heartbeats = 0;
+    std::vector<FeedStats> feeds(PEERS);
+
+    runtime.spawn(acceptor(runtime, listener, PEERS, BURST, venue_heartbeats));
+    for (FeedStats& stats : feeds) {
+        runtime.spawn(feed(runtime, listener.port(), stats));
+    }
+    runtime.run();
+
+    int heartbeats_sent = 0;
+    for (const FeedStats& stats : feeds) {
+        EXPECT_TRUE(stats.connected);
+        EXPECT_TRUE(stats.closed_by_peer);
+        EXPECT_EQ(stats.ticks, 2u * BURST);
+        EXPECT_EQ(stats.volume, 2 * BURST * (BURST + 1) / 2);
+        EXPECT_GE(stats.heartbeats_sent, 1);
+        heartbeats_sent += stats.heartbeats_sent;
+    }
+    EXPECT_GE(venue_heartbeats, PEERS);
+    EXPECT_LE(venue_heartbeats, heartbeats_sent);
+    EXPECT_EQ(runtime.session_count(), 0u);
+    EXPECT_EQ(runtime.watched_sockets(), 0u);
+}
+
+TEST(SessionRuntimeTest, ConnectRefusedFailsTheSession) {
+    SessionRuntime runtime;
+    int port;
+    {
+        Listener closed;  // Port that was just released
+        port = closed.port();
+    }
+    TcpClient client;
+    bool connected = true;
+    auto session = [&]() -> Task<> {
+        connected = co_await async_connect(runtime, client, "127.0.0.1", port, 1000);
+    };
+    runtime.spawn(session());
+    runtime.run();
+    EXPECT_FALSE(connected);
+    EXPECT_FALSE(client.is_connected());
+    EXPECT_EQ(runtime.watched_sockets(), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, SessionRuntimeBackendTest,
+                         ::testing::Values(EventBackend::SELECT, EventBackend::EPOLL,
+                                           EventBackend::IO_URING));
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "threading/sharded_feedhandler.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <pthread.h>
+#include <sched.h>
+
+using namespace feedhandler;
+using namespace feedhandler::threading;
+
+namespace {
+
+std::string make_message(const std::string& symbol) {
+    return "8=FIX.4.4|9=79|35=D|55=" + symbol +
+           "|44=150.25|38=500|54=1|52=20240131-12:34:56|10=020|\n";
+}
+
+// Core the calling thread is allowed to run on, or -1 if not pinned to one
+int current_pinned_cpu() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0 || CPU_COUNT(&set) != 1) {
+        return -1;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST(ThreadedFeedHandlerTest, PinThreadToCore) {
+    std::thread worker([] {});
+    EXPECT_TRUE(ThreadedFeedHandler::pin_thread(worker, -1));  // Unpinned is a no-op
+    EXPECT_TRUE(ThreadedFeedHandler::pin_thread(worker, 0));
+    EXPECT_FALSE(ThreadedFeedHandler::pin_thread(worker, CPU_SETSIZE));
+    worker.join();
+}
+
+TEST(ShardedFeedHandlerTest, AffinityListsWrapAcrossShards) {
+    ShardedFeedHandler::Config config;
+    config.shard_count = 3;
+    config.cpu.parser_thread_affinity = {0, 1};
+
+    ShardedFeedHandler handler(config, ShardedFeedHandler::ShardTickCallback());
+    ASSERT_EQ(handler.shard_count(), 3u);
+    EXPECT_EQ(handler.parser_cpu(0), 0);
+    EXPECT_EQ(handler.parser_cpu(1), 1);
+    EXPECT_EQ(handler.parser_cpu(2), 0);
+    EXPECT_EQ(handler.network_cpu(0), -1);
+}
+
+TEST(ShardedFeedHandlerTest, ZeroShardsMeansOne) {
+    ShardedFeedHandler::Config config;
+    config.shard_count = 0;
+    ShardedFeedHandler handler(config, ShardedFeedHandler::ShardTickCallback());
+    EXPECT_EQ(handler.shard_count(), 1u);
+    EXPECT_EQ(handler.shard_for("AAPL"), 0u);
+}
+
+TEST(ShardedFeedHandlerTest, SymbolsStayOnTheirShard) {
+    ShardedFeedHandler::Config config;
+    config.shard_count = 4;
+    config.shard.queue_size = 64;
+    config.cpu.parser_thread_affinity = {0};
+    config.cpu.network_thread_affinity = {0};
+
+    std::mutex mutex;
+    std::set<std::pair<size_t, std::string>> seen;
+    std::atomic<int> wrong_cpu{0};
+
+    ShardedFeedHandler handler(config, [&](size_t shard, const common::Tick& tick) {
+        if (current_pinned_cpu() != 0) {
+            wrong_cpu.fetch_add(1);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        seen.emplace(shard, std::string(tick.symbol));
+    });
+
+    const std::string symbols[] = {"AAPL", "MSFT", "GOOG", "TSLA", "IBM", "ORCL"};
+    for (const auto& symbol : symbols) {
+        EXPECT_LT(handler.shard_for(symbol), 4u);
+        EXPECT_EQ(handler.shard_for(symbol), handler.shard_for(symbol));
+    }
+
+    handler.start();
+    for (int round = 0; round < 5; ++round) {
+        for (const auto& symbol : symbols) {
+            std::string msg = make_message(symbol);
+            handler.inject_for_symbol(symbol, msg.data(), msg.size());
+        }
+    }
+    handler.stop();
+
+    // Each symbol was parsed only by the shard that owns it
+    ASSERT_EQ(seen.size(), 6u);
+    for (const auto& [shard, symbol] : seen) {
+        EXPECT_EQ(shard, handler.shard_for(symbol)) << symbol;
+    }
+    EXPECT_EQ(wrong_cpu.load(), 0);
+
+    auto stats = handler.get_statistics();
+    EXPECT_EQ(stats.messages_parsed, 30u);
+    EXPECT_EQ(stats.queue_overflows, 0u);
+
+    uint64_t per_shard = 0;
+    for (size_t i = 0; i < handler.shard_count(); ++i) {
+        per_shard += handler.shard(i).get_statistics().messages_parsed.load();
+    }
+    EXPECT_EQ(per_shard, stats.messages_parsed);
+
+    handler.reset_statistics();
+    EXPECT_EQ(handler.get_statistics().messages_parsed, 0u);
+}
+
+TEST(ShardedFeedHandlerTest, OutOfRangeShardIgnored) {
+    ShardedFeedHandler::Config config;
+    config.shard_count = 2;
+    ShardedFeedHandler handler(config, ShardedFeedHandler::ShardTickCallback());
+
+    handler.start();
+    std::string msg = make_message("AAPL");
+    handler.inject_data(5, msg.data(), msg.size());
+    handler.stop();
+
+    EXPECT_EQ(handler.get_statistics().bytes_received, 0u);
+}
+
+TEST(ShardedFeedHandlerTest, BatchCallbackOncePerBuffer) {
+    ShardedFeedHandler::Config config;
+    config.shard_count = 2;
+
+    std::atomic<int> batches{0};
+    std::atomic<int> ticks{0};
+    ShardedFeedHandler handler(config, [&](size_t, std::span<const common::Tick> batch) {
+        batches.fetch_add(1);
+        ticks.fetch_add(static_cast<int>(batch.size()));
+    });
+
+    // Three messages in one buffer for one symbol's shard
+    std::string buffer = make_message("AAPL") + make_message("AAPL") + make_message("AAPL");
+    handler.start();
+    handler.inject_for_symbol("AAPL", buffer.data(), buffer.size());
+    handler.stop();
+
+    EXPECT_EQ(batches.load(), 1);
+    EXPECT_EQ(ticks.load(), 3);
+    EXPECT_EQ(handler.get_statistics().messages_parsed, 3u);
+}
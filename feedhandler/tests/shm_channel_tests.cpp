@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "distributed/shm_channel.hpp"
+
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+namespace {
+
+std::string unique_name(const char* test) {
+    return "/fh-shm-test-" + std::to_string(getpid()) + "-" + test;
+}
+
+} // namespace
+
+TEST(ShmFrameChannelTest, ReceiverDecodesWhatTheSenderWrote) {
+    std::string name = unique_name("roundtrip");
+    ShmFrameChannel sender;
+    ShmFrameChannel receiver;
+    ASSERT_TRUE(sender.open(name, 4096));
+    ASSERT_TRUE(receiver.open(name, 1 << 20));  // Existing segment keeps its size
+    ShmFrameChannel::unlink(name);
+    EXPECT_EQ(receiver.capacity(), 4096u);
+
+    FrameWriter batch(7);
+    batch.append(MessageType::APPLICATION, "hello", 5);
+    batch.append(MessageType::APPLICATION, "world", 5);
+    ASSERT_TRUE(sender.write(batch));
+    EXPECT_EQ(receiver.backlog(), batch.size());
+
+    std::vector<std::string> got;
+    EXPECT_EQ(receiver.read([&](const Frame& frame) {
+        got.emplace_back(reinterpret_cast<const char*>(frame.payload), frame.size());
+        EXPECT_EQ(frame.header->sender, 7u);
+    }), 2u);
+    EXPECT_EQ(got, (std::vector<std::string>{"hello", "world"}));
+    EXPECT_EQ(receiver.backlog(), 0u);
+}
+
+TEST(ShmFrameChannelTest, BatchesWrapWithPaddingAndNeverOverrun) {
+    std::string name = unique_name("wrap");
+    ShmFrameChannel channel;
+    ASSERT_TRUE(channel.open(name, 4096));
+    ShmFrameChannel::unlink(name);
+
+    // 1000-byte frames: the fifth batch would straddle the end of the ring
+    std::vector<uint8_t> payload(1000 - sizeof(FrameHeader));
+    uint32_t written = 0;
+    uint32_t read = 0;
+    for (int round = 0; round < 50; ++round) {
+        while (true) {
+            for (auto& b : payload) {
+                b = static_cast<uint8_t>(written);
+            }
+            FrameWriter batch;
+            batch.append(MessageType::APPLICATION, payload.data(), payload.size());
+            if (!channel.write(batch)) {
+                break;  // Full
+            }
+            written++;
+        }
+        EXPECT_LE(channel.backlog(), channel.capacity());
+        channel.read([&](const Frame& frame) {
+            ASSERT_EQ(frame.size(), payload.size());
+            EXPECT_EQ(frame.payload[0], static_cast<uint8_t>(read));
+            EXPECT_EQ(frame.payload[frame.size() - 1], static_cast<uint8_t>(read));
+            read++;
+        });
+    }
+    EXPECT_EQ(read, written);
+    EXPECT_GT(written, 100u);
+}
+
+TEST(ShmFrameChannelTest, ConcurrentProducerAndConsumerKeepOrder) {
+    std::string name = unique_name("threads");
+    ShmFrameChannel producer;
+    ShmFrameChannel consumer;
+    ASSERT_TRUE(producer.open(name, 8192));
+    ASSERT_TRUE(consumer.open(name));
+    ShmFrameChannel::unlink(name);
+
+    constexpr uint64_t COUNT = 20000;
+    std::thread writer([&] {
+        FrameWriter batch;
+        for (uint64_t i = 0; i < COUNT;) {
+            batch.clear();
+            for (uint64_t j = 0; j < 4 && i + j < COUNT; ++j) {
+                uint64_t value = i + j;
+                batch.append(MessageType::APPLICATION, value);
+            }
+            while (!producer.write(batch)) {
+                std::this_thread::yield();
+            }
+            i += batch.frame_count();
+        }
+    });
+
+    uint64_t expected = 0;
+    while (expected < COUNT) {
+        consumer.read([&](const Frame& frame) {
+            ASSERT_NE(frame.as<uint64_t>(), nullptr);
+            EXPECT_EQ(*frame.as<uint64_t>(), expected);
+            expected++;
+        });
+    }
+    writer.join();
+    EXPECT_EQ(expected, COUNT);
+}
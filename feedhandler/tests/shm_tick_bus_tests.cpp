@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include "threading/shm_tick_bus.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::threading;
+
+namespace {
+
+std::string unique_name(const char* test) {
+    return "/fh-tickbus-test-" + std::to_string(getpid()) + "-" + test;
+}
+
+common::CompactTick make_tick(uint64_t i, common::InstrumentId id = 0) {
+    common::CompactTick tick;
+    tick.price = static_cast<int64_t>(i + 1);
+    tick.timestamp = i + 1;  // Same as price: a torn copy would not match
+    tick.instrument_id = id;
+    tick.qty = static_cast<int32_t>(i % 1000 + 1);
+    tick.side = i % 2 ? 'S' : 'B';
+    return tick;
+}
+
+} // namespace
+
+TEST(ShmTickBusTest, ReaderSeesTicksAndSymbolsInOrder) {
+    std::string name = unique_name("order");
+    ShmTickBusWriter writer;
+    ASSERT_TRUE(writer.open(name, 100));
+    EXPECT_EQ(writer.capacity(), 128u);
+    ShmTickBusReader reader;
+    ASSERT_TRUE(reader.open(name));
+    ShmTickBusWriter::unlink(name);
+
+    common::InstrumentId aapl = common::SymbolTable::global().intern("AAPL");
+    common::InstrumentId msft = common::SymbolTable::global().intern("MSFT");
+    writer.publish(make_tick(0, aapl));
+    std::vector<common::CompactTick> batch = {make_tick(1, msft), make_tick(2, aapl)};
+    writer.publish(std::span<const common::CompactTick>(batch));
+
+    std::vector<common::CompactTick> seen;
+    EXPECT_EQ(reader.poll([&](const common::CompactTick& tick) { seen.push_back(tick); }), 3u);
+    ASSERT_EQ(seen.size(), 3u);
+    for (size_t i = 0; i < seen.size(); ++i) {
+        EXPECT_EQ(seen[i].price, static_cast<int64_t>(i + 1));
+    }
+    EXPECT_EQ(reader.symbol(seen[0].instrument_id), "AAPL");
+    EXPECT_EQ(reader.symbol(seen[1].instrument_id), "MSFT");
+    EXPECT_EQ(reader.symbol(4000), "");
+    EXPECT_EQ(reader.lag(), 0u);
+
+    common::CompactTick tick;
+    EXPECT_FALSE(reader.next(tick));
+}
+
+TEST(ShmTickBusTest, PublishesFeedHandlerBatches) {
+    std::string name = unique_name("batch");
+    ShmTickBusWriter writer;
+    ASSERT_TRUE(writer.open(name));
+    ShmTickBusReader reader;
+    ASSERT_TRUE(reader.open(name));
+    ShmTickBusWriter::unlink(name);
+
+    std::vector<common::Tick> ticks(2);
+    ticks[0].symbol = "IBM";
+    ticks[0].price = 1234500;
+    ticks[0].qty = 10;
+    ticks[0].side = 'B';
+    ticks[1] = ticks[0];
+    ticks[1].side = 'S';
+    writer.publish(std::span<const common::Tick>(ticks));
+
+    common::CompactTick tick;
+    ASSERT_TRUE(reader.next(tick));
+    EXPECT_EQ(reader.symbol(tick.instrument_id), "IBM");
+    EXPECT_EQ(tick.price, 1234500);
+    ASSERT_TRUE(reader.next(tick));
+    EXPECT_EQ(tick.side, 'S');
+}
+
+TEST(ShmTickBusTest, ReadersKeepTheirOwnCursors) {
+    std::string name = unique_name("cursors");
+    ShmTickBusWriter writer;
+    ASSERT_TRUE(writer.open(name, 64));
+    ShmTickBusReader fast;
+    ShmTickBusReader slow;
+    ASSERT_TRUE(fast.open(name));
+    ASSERT_TRUE(slow.open(name));
+
+    for (uint64_t i = 0; i < 40; ++i) {
+        writer.publish(make_tick(i));
+    }
+    EXPECT_EQ(fast.poll([](const common::CompactTick&) {}), 40u);
+    EXPECT_EQ(slow.poll([](const common::CompactTick&) {}, 10), 10u);
+    EXPECT_EQ(slow.lag(), 30u);
+
+    common::CompactTick tick;
+    ASSERT_TRUE(slow.next(tick));
+    EXPECT_EQ(tick.price, 11);
+
+    // A late joiner starts at the next tick, or at the oldest one kept
+    ShmTickBusReader live;
+    ShmTickBusReader replay;
+    ASSERT_TRUE(live.open(name));
+    ASSERT_TRUE(replay.open(name, true));
+    ShmTickBusWriter::unlink(name);
+    EXPECT_FALSE(live.next(tick));
+    ASSERT_TRUE(replay.next(tick));
+    EXPECT_EQ(tick.price, 1);
+}
+
+TEST(ShmTickBusTest, LappedReaderCountsOverrunAndResumes) {
+    std::string name = unique_name("overrun");
+    ShmTickBusWriter writer;
+    ASSERT_TRUE(writer.open(name, 64));
+    ShmTickBusReader reader;
+    ASSERT_TRUE(reader.open(name));
+    ShmTickBusWriter::unlink(name);
+
+    for (uint64_t i = 0; i < 200; ++i) {
+        writer.publish(make_tick(i));
+    }
+    std::vector<int64_t> prices;
+    reader.poll([&](const common::CompactTick& tick) { prices.push_back(tick.price); });
+    EXPECT_EQ(reader.overruns(), 1u);
+    EXPECT_EQ(reader.lost(), 200u - 64u + 1u);
+    ASSERT_EQ(prices.size(), 63u);
+    EXPECT_EQ(prices.front(), 200 - 63 + 1);
+    EXPECT_EQ(prices.back(), 200);
+}
+
+TEST(ShmTickBusTest, ConcurrentReaderNeverSeesTornTicks) {
+    std::string name = unique_name("stress");
+    ShmTickBusWriter writer;
+    ASSERT_TRUE(writer.open(name, 256));
+    ShmTickBusReader reader;
+    ASSERT_TRUE(reader.open(name));
+    ShmTickBusWriter::unlink(name);
+
+    constexpr uint64_t TOTAL = 500000;
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < TOTAL; ++i) {
+            writer.publish(make_tick(i));
+        }
+    });
+
+    uint64_t received = 0;
+    uint64_t torn = 0;
+    int64_t last = 0;
+    bool ordered = true;
+    while (received + reader.lost() < TOTAL) {
+        reader.poll([&](const common::CompactTick& tick) {
+            if (static_cast<uint64_t>(tick.price) != tick.timestamp) {
+                ++torn;
+            }
+            if (tick.price <= last) {
+                ordered = false;
+            }
+            last = tick.price;
+            ++received;
+        });
+    }
+    producer.join();
+
+    EXPECT_EQ(torn, 0u);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(received + reader.lost(), TOTAL);
+}
+
+TEST(ShmTickBusTest, ReaderInAnotherProcess) {
+    std::string name = unique_name("process");
+    ShmTickBusWriter writer;
+    ASSERT_TRUE(writer.open(name, 1 << 14));
+    common::InstrumentId id = common::SymbolTable::global().intern("ESZ4");
+
+    constexpr uint64_t TOTAL = 10000;
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // The child never publishes or interns: it only knows the bus
+        ShmTickBusReader reader;
+        if (!reader.open(name, true)) {
+            _exit(2);
+        }
+        uint64_t expected = 0;
+        while (expected < TOTAL) {
+            common::CompactTick tick;
+            if (!reader.next(tick)) {
+                continue;
+            }
+            if (tick.price != static_cast<int64_t>(expected + 1) || reader.symbol(tick.instrument_id) != "ESZ4") {
+                _exit(3);
+            }
+            ++expected;
+        }
+        _exit(reader.overruns() == 0 ? 0 : 4);
+    }
+
+    for (uint64_t i = 0; i < TOTAL; i += 100) {
+        std::vector<common::CompactTick> batch;
+        for (uint64_t j = i; j < i + 100; ++j) {
+            batch.push_back(make_tick(j, id));
+        }
+        writer.publish(std::span<const common::CompactTick>(batch));
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ShmTickBusWriter::unlink(name);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST(ShmTickBusTest, ClosedOrMissingBus) {
+    std::string name = unique_name("closed");
+    ShmTickBusReader reader;
+    EXPECT_FALSE(reader.open(name));
+
+    ShmTickBusWriter writer;
+    ASSERT_TRUE(writer.open(name));
+    ASSERT_TRUE(reader.open(name));
+    EXPECT_FALSE(reader.writer_closed());
+    writer.close();
+    EXPECT_TRUE(reader.writer_closed());
+
+    // A restarted writer gets a fresh segment; the old reader reattaches
+    ASSERT_TRUE(writer.open(name));
+    writer.publish(make_tick(0));
+    ASSERT_TRUE(reader.open(name, true));
+    ShmTickBusWriter::unlink(name);
+    common::CompactTick tick;
+    ASSERT_TRUE(reader.next(tick));
+    EXPECT_EQ(tick.price, 1);
+}
@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+#include "parser/simd_fix_parser.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::parser;
+
+namespace {
+
+// Every kernel the running CPU can execute
+std::vector<SimdLevel> runnable_levels() {
+    std::vector<SimdLevel> levels;
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE42, SimdLevel::AVX2,
+                            SimdLevel::AVX512BW, SimdLevel::NEON}) {
+        if (SIMDFixParser::supported_simd_level(level) == level) {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+std::vector<size_t> reference_positions(const std::string& data, char delimiter) {
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (data[i] == delimiter) {
+            positions.push_back(i);
+        }
+    }
+    return positions;
+}
+
+std::string make_message(const std::string& symbol, const std::string& price, int qty) {
+    return "8=FIX.4.4\x01" "9=79\x01" "35=D\x01" "55=" + symbol + "\x01" "44=" + price +
+           "\x01" "38=" + std::to_string(qty) + "\x01" "54=1\x01" "52=20240131-12:34:56\x01" "10=020\x01";
+}
+
+} // namespace
+
+TEST(SIMDFixParserDispatchTest, LevelsNeverExceedCpu) {
+    SimdLevel best = SIMDFixParser::detect_simd_level();
+    EXPECT_EQ(SIMDFixParser().simd_level(), best);
+    EXPECT_EQ(SIMDFixParser(SimdLevel::SCALAR).simd_level(), SimdLevel::SCALAR);
+
+    for (SimdLevel level : {SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512BW, SimdLevel::NEON}) {
+        SimdLevel chosen = SIMDFixParser(level).simd_level();
+        EXPECT_EQ(chosen, SIMDFixParser::supported_simd_level(level));
+        if (best != SimdLevel::NEON && chosen != SimdLevel::NEON) {
+            EXPECT_LE(chosen, best);
+        }
+    }
+
+#if defined(__x86_64__)
+    EXPECT_NE(best, SimdLevel::NEON);
+    // NEON requested on x86 falls back to the native kernel
+    EXPECT_EQ(SIMDFixParser::supported_simd_level(SimdLevel::NEON), best);
+#elif defined(__aarch64__)
+    EXPECT_EQ(best, SimdLevel::NEON);
+    EXPECT_EQ(SIMDFixParser::supported_simd_level(SimdLevel::AVX2), SimdLevel::NEON);
+#endif
+}
+
+TEST(SIMDFixParserDispatchTest, HonorsParserConfig) {
+    config::PerformanceConfig::ParserConfig config;
+    config.simd_instruction_set = "SSE4.2";
+    EXPECT_EQ(SIMDFixParser(config).simd_level(),
+              SIMDFixParser::supported_simd_level(SimdLevel::SSE42));
+
+    config.simd_instruction_set = "AVX512";
+    EXPECT_EQ(SIMDFixParser(config).simd_level(),
+              SIMDFixParser::supported_simd_level(SimdLevel::AVX512BW));
+
+    config.simd_instruction_set = "bogus";
+    EXPECT_EQ(SIMDFixParser(config).simd_level(), SIMDFixParser::detect_simd_level());
+
+    config.enable_simd = false;
+    config.simd_instruction_set = "AVX2";
+    EXPECT_EQ(SIMDFixParser(config).simd_level(), SimdLevel::SCALAR);
+
+    EXPECT_EQ(SIMDFixParser::parse_simd_level("AVX2"), SimdLevel::AVX2);
+    EXPECT_EQ(SIMDFixParser::parse_simd_level("NEON"), SimdLevel::NEON);
+    EXPECT_STREQ(SIMDFixParser::simd_level_name(SimdLevel::AVX512BW), "AVX512BW");
+}
+
+TEST(SIMDFixParserDispatchTest, KernelsAgreeOnDelimiters) {
+    // Random bytes dense in delimiters, lengths straddling the 64-byte blocks
+    std::mt19937 rng(7);
+    const char alphabet[] = {'\x01', '|', '=', 'A', '0', '\x80', '\xFF'};
+    for (size_t length : {0u, 1u, 31u, 32u, 63u, 64u, 65u, 127u, 128u, 200u, 1000u}) {
+        std::string data;
+        for (size_t i = 0; i < length; ++i) {
+            data += alphabet[rng() % sizeof(alphabet)];
+        }
+        for (char delimiter : {'\x01', '|', '\xFF'}) {
+            auto expected = reference_positions(data, delimiter);
+            for (SimdLevel level : runnable_levels()) {
+                SIMDFixParser parser(level);
+                EXPECT_EQ(parser.find_delimiters_simd(data.data(), data.size(), delimiter), expected)
+                    << SIMDFixParser::simd_level_name(level) << " length " << length;
+            }
+        }
+    }
+}
+
+TEST(SIMDFixParserDispatchTest, KernelsAgreeOnTicks) {
+    std::string stream = make_message("AAPL", "150.25", 500) + make_message("MSFT", "310.5", 200) +
+                         make_message("GOOG", "2800.1234", 75);
+
+    for (SimdLevel level : runnable_levels()) {
+        SIMDFixParser parser(level);
+        std::vector<common::Tick> ticks;
+        EXPECT_EQ(parser.parse(stream.data(), stream.size(), ticks), stream.size());
+
+        ASSERT_EQ(ticks.size(), 3u) << SIMDFixParser::simd_level_name(level);
+        EXPECT_EQ(ticks[0].symbol, "AAPL");
+        EXPECT_EQ(ticks[0].price, 1502500);
+        EXPECT_EQ(ticks[0].qty, 500);
+        EXPECT_EQ(ticks[1].symbol, "MSFT");
+        EXPECT_EQ(ticks[1].qty, 200);
+        EXPECT_EQ(ticks[2].symbol, "GOOG");
+        EXPECT_EQ(ticks[2].qty, 75);
+    }
+}
+
+TEST(SIMDFixParserDispatchTest, ForEachDelimiterMatchesVector) {
+    std::string stream = make_message("AAPL", "150.25", 500) + make_message("IBM", "99.5", 10);
+    for (SimdLevel level : runnable_levels()) {
+        SIMDFixParser parser(level);
+        std::vector<size_t> visited;
+        parser.for_each_delimiter(stream.data(), stream.size(), '=',
+                                  [&](size_t pos) { visited.push_back(pos); });
+        EXPECT_EQ(visited, reference_positions(stream, '='));
+    }
+}
+
+TEST(SIMDFixParserDispatchTest, PipeAndSohDelimitersInOnePass) {
+    // Pipe-delimited log format mixed with wire format; '=' inside a value is data
+    std::string piped = "8=FIX.4.4|9=79|35=D|55=MSFT|44=310.5|38=200|58=a=b|10=020|\n";
+    std::string stream = make_message("AAPL", "150.25", 500) + piped + make_message("GOOG", "1.5", 7);
+
+    for (SimdLevel level : runnable_levels()) {
+        SIMDFixParser parser(level);
+        std::vector<common::Tick> ticks;
+        parser.parse(stream.data(), stream.size(), ticks);
+
+        ASSERT_EQ(ticks.size(), 3u) << SIMDFixParser::simd_level_name(level);
+        EXPECT_EQ(ticks[1].symbol, "MSFT");
+        EXPECT_EQ(ticks[1].price, 3105000);
+        EXPECT_EQ(ticks[1].qty, 200);
+        EXPECT_EQ(ticks[2].symbol, "GOOG");
+        EXPECT_EQ(ticks[2].qty, 7);
+    }
+}
+
+TEST(SIMDFixParserStreamingTest, ResumesAtEverySplitPoint) {
+    std::string first = make_message("AAPL", "150.25", 500);
+    std::string stream = first + make_message("MSFT", "310.5", 200);
+
+    for (size_t split = 1; split < stream.size(); ++split) {
+        SIMDFixParser parser;
+        std::vector<common::Tick> ticks;
+        EXPECT_EQ(parser.parse(stream.data(), split, ticks), split);
+        EXPECT_EQ(parser.is_parsing(), split != first.size()) << "split " << split;
+        EXPECT_EQ(parser.parse(stream.data() + split, stream.size() - split, ticks), stream.size() - split);
+
+        ASSERT_EQ(ticks.size(), 2u) << "split " << split;
+        EXPECT_EQ(ticks[0].symbol, "AAPL");
+        EXPECT_EQ(ticks[0].price, 1502500);
+        EXPECT_EQ(ticks[1].symbol, "MSFT");
+        EXPECT_EQ(ticks[1].qty, 200);
+        EXPECT_FALSE(parser.is_parsing());
+    }
+}
+
+TEST(SIMDFixParserStreamingTest, ByteAtATimeAndLargeInput) {
+    // More than the 4 KiB processing buffer, fed both whole and byte by byte
+    std::string stream;
+    for (int i = 0; i < 100; ++i) {
+        stream += make_message("SYM" + std::to_string(i), "10.5", i + 1);
+    }
+    ASSERT_GT(stream.size(), 4096u);
+
+    SIMDFixParser whole;
+    std::vector<common::CompactTick> expected;
+    EXPECT_EQ(whole.parse(stream.data(), stream.size(), expected), stream.size());
+    ASSERT_EQ(expected.size(), 100u);
+
+    SIMDFixParser bytes;
+    std::vector<common::CompactTick> ticks;
+    for (size_t i = 0; i < stream.size(); ++i) {
+        EXPECT_EQ(bytes.parse(stream.data() + i, 1, ticks), 1u);
+    }
+    EXPECT_FALSE(bytes.is_parsing());
+    ASSERT_EQ(ticks.size(), expected.size());
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        EXPECT_EQ(ticks[i].instrument_id, expected[i].instrument_id);
+        EXPECT_EQ(ticks[i].qty, static_cast<int32_t>(i + 1));
+    }
+}
+
+TEST(SIMDFixParserStreamingTest, FullSpanReturnsUnparsedBytes) {
+    std::string first = make_message("AAPL", "1.0", 1);
+    std::string stream = first + make_message("MSFT", "2.0", 2) + make_message("GOOG", "3.0", 3);
+
+    SIMDFixParser parser;
+    common::Tick storage[1];
+    common::TickSpan<common::Tick> span(storage, 1);
+    EXPECT_EQ(parser.parse(stream.data(), stream.size(), span), first.size());
+    ASSERT_EQ(span.size(), 1u);
+    EXPECT_EQ(storage[0].symbol, "AAPL");
+    EXPECT_FALSE(parser.is_parsing());
+
+    // The caller passes the remainder again
+    std::vector<common::Tick> rest;
+    parser.parse(stream.data() + first.size(), stream.size() - first.size(), rest);
+    ASSERT_EQ(rest.size(), 2u);
+    EXPECT_EQ(rest[0].symbol, "MSFT");
+    EXPECT_EQ(rest[1].symbol, "GOOG");
+}
+
+namespace {
+
+std::string make_valid_message(const std::string& symbol, int qty) {
+    std::string body = "35=D\x01" "55=" + symbol + "\x01" "44=42.5\x01" "38=" + std::to_string(qty) + "\x01";
+    std::string message = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    char trailer[16];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u\x01", FixFramer::checksum(message.data(), message.size()));
+    return message + trailer;
+}
+
+} // namespace
+
+TEST(SIMDFixParserValidationTest, DropsCorruptMessagesAndResyncs) {
+    std::string corrupt = make_valid_message("BAD", 1);
+    corrupt[corrupt.find("BAD")] = 'X';
+    std::string stream = make_valid_message("AAPL", 100) + "\r\n" + corrupt +
+                         make_valid_message("MSFT", 200) + "junk" + make_valid_message("GOOG", 300);
+
+    for (size_t split : {stream.size(), size_t{1}, size_t{37}, stream.size() / 2}) {
+        SIMDFixParser parser;
+        parser.set_validation(true);
+        std::vector<common::Tick> ticks;
+        EXPECT_EQ(parser.parse(stream.data(), split, ticks), split);
+        if (split < stream.size()) {
+            EXPECT_EQ(parser.parse(stream.data() + split, stream.size() - split, ticks), stream.size() - split);
+        }
+
+        ASSERT_EQ(ticks.size(), 3u) << "split " << split;
+        EXPECT_EQ(ticks[0].symbol, "AAPL");
+        EXPECT_EQ(ticks[0].price, 425000);
+        EXPECT_EQ(ticks[1].symbol, "MSFT");
+        EXPECT_EQ(ticks[2].symbol, "GOOG");
+        EXPECT_EQ(ticks[2].qty, 300);
+
+        const auto& stats = parser.get_validation_stats();
+        EXPECT_EQ(stats.messages_validated, 3u);
+        EXPECT_EQ(stats.checksum_errors, 1u);
+        EXPECT_EQ(stats.bytes_skipped, 2 + corrupt.size() + 4);
+        EXPECT_FALSE(parser.is_parsing());
+    }
+}
+
+TEST(SIMDFixParserValidationTest, FullSpanHandsBackWholeMessages) {
+    std::string first = make_valid_message("AAPL", 1);
+    std::string stream = first + make_valid_message("MSFT", 2);
+
+    SIMDFixParser parser;
+    parser.set_validation(true);
+    common::CompactTick storage[1];
+    common::TickSpan<common::CompactTick> span(storage, 1);
+    EXPECT_EQ(parser.parse(stream.data(), stream.size(), span), first.size());
+    EXPECT_EQ(span.size(), 1u);
+    EXPECT_EQ(storage[0].qty, 1);
+}
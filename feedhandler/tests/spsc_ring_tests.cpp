@@ -0,0 +1,409 @@
+#include <gtest/gtest.h>
+#include "threading/spsc_ring.hpp"
+#include "threading/threaded_feedhandler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::threading;
+
+namespace {
+
+// Push 0..count-1 from a producer thread and check the consumer sees
+// them all, in order
+void run_handoff(WaitStrategy strategy, uint32_t spin_limit) {
+    constexpr uint64_t count = 20000;
+    SpscRing<uint64_t> ring(64, strategy, spin_limit);
+
+    std::thread producer([&ring] {
+        for (uint64_t i = 0; i < count; ++i) {
+            while (!ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+        ring.shutdown();
+    });
+
+    uint64_t expected = 0;
+    uint64_t value = 0;
+    while (ring.pop(value)) {
+        ASSERT_EQ(value, expected);
+        ++expected;
+    }
+    producer.join();
+
+    EXPECT_EQ(expected, count);
+    EXPECT_TRUE(ring.empty());
+}
+
+} // namespace
+
+TEST(SpscRingTest, CapacityRoundsUpToPowerOfTwo) {
+    SpscRing<int> ring(1000);
+    EXPECT_EQ(ring.capacity(), 1024u);
+    EXPECT_EQ(ring.wait_strategy(), WaitStrategy::SPIN_YIELD);
+}
+
+TEST(SpscRingTest, FillsToCapacityThenRejects) {
+    SpscRing<int> ring(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(99));
+    EXPECT_EQ(ring.size(), 4u);
+
+    int value = -1;
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.try_push(4));  // Slot freed by the pop
+
+    for (int i = 1; i <= 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, MovesOwningElements) {
+    SpscRing<MessageBuffer> ring(2);
+    std::string payload = "8=FIX.4.4|35=D|";
+    EXPECT_TRUE(ring.try_push(MessageBuffer(payload.data(), payload.size())));
+
+    MessageBuffer out;
+    ASSERT_TRUE(ring.try_pop(out));
+    EXPECT_EQ(out.length, payload.size());
+    EXPECT_EQ(std::string(out.data.data(), out.length), payload);
+}
+
+TEST(SpscRingTest, ShutdownDrainsThenStops) {
+    SpscRing<int> ring(4, WaitStrategy::BUSY_SPIN);
+    EXPECT_TRUE(ring.try_push(1));
+    ring.shutdown();
+    EXPECT_FALSE(ring.try_push(2));
+
+    int value = 0;
+    EXPECT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(ring.pop(value));
+}
+
+TEST(SpscRingTest, BusySpinHandoff) {
+    run_handoff(WaitStrategy::BUSY_SPIN, 0);
+}
+
+TEST(SpscRingTest, SpinYieldHandoff) {
+    run_handoff(WaitStrategy::SPIN_YIELD, 16);
+}
+
+TEST(SpscRingTest, FutexParkHandoff) {
+    run_handoff(WaitStrategy::FUTEX_PARK, 16);
+}
+
+TEST(SpscRingTest, ShutdownWakesParkedConsumer) {
+    SpscRing<int> ring(4, WaitStrategy::FUTEX_PARK, 0);
+    std::atomic<bool> returned{false};
+
+    std::thread consumer([&] {
+        int value = 0;
+        EXPECT_FALSE(ring.pop(value));
+        returned.store(true);
+    });
+
+    // Let the consumer go to sleep before shutting down
+    for (int i = 0; i < 1000 && ring.park_count() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(ring.park_count(), 1u);
+    EXPECT_FALSE(returned.load());
+
+    ring.shutdown();
+    consumer.join();
+    EXPECT_TRUE(returned.load());
+}
+
+TEST(SpscRingTest, PushWakesParkedConsumer) {
+    SpscRing<int> ring(4, WaitStrategy::FUTEX_PARK, 0);
+    int received = 0;
+
+    std::thread consumer([&] {
+        ring.pop(received);
+    });
+
+    for (int i = 0; i < 1000 && ring.park_count() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(ring.try_push(42));
+    consumer.join();
+    EXPECT_EQ(received, 42);
+}
+
+TEST(ThreadedFeedHandlerTest, ParsesThroughRingWithEachStrategy) {
+    const std::string msg = "8=FIX.4.4|9=79|35=D|55=AAPL|44=150.25|38=500|54=1|52=20240131-12:34:56|10=020|\n";
+
+    for (WaitStrategy strategy : {WaitStrategy::BUSY_SPIN, WaitStrategy::SPIN_YIELD,
+                                  WaitStrategy::FUTEX_PARK}) {
+        ThreadedFeedHandler::Config config;
+        config.queue_size = 64;
+        config.wait_strategy = strategy;
+        config.spin_limit = 8;
+
+        std::atomic<int> ticks{0};
+        ThreadedFeedHandler handler(config, [&ticks](const feedhandler::common::Tick& tick) {
+            if (tick.price == feedhandler::common::double_to_price(150.25)) {
+                ticks.fetch_add(1);
+            }
+        });
+
+        handler.start();
+        for (int i = 0; i < 10; ++i) {
+            handler.inject_data(msg.data(), msg.size());
+        }
+        handler.stop();
+
+        const auto& stats = handler.get_statistics();
+        EXPECT_EQ(stats.queue_overflows.load(), 0u);
+        EXPECT_EQ(stats.messages_parsed.load(), 10u);
+        EXPECT_EQ(ticks.load(), 10);
+    }
+}
+
+TEST(ThreadedFeedHandlerTest, BatchCallbackReceivesWholeBuffer) {
+    const std::string msg = "8=FIX.4.4|9=79|35=D|55=MSFT|44=300.50|38=10|54=2|52=20240131-12:34:56|10=020|\n";
+    const std::string buffer = msg + msg;
+
+    ThreadedFeedHandler::Config config;
+    std::atomic<int> batches{0};
+    std::atomic<int> ticks{0};
+    ThreadedFeedHandler handler(config, [&](std::span<const feedhandler::common::Tick> batch) {
+        batches.fetch_add(1);
+        ticks.fetch_add(static_cast<int>(batch.size()));
+    });
+
+    handler.start();
+    handler.inject_data(buffer.data(), buffer.size());
+    handler.inject_data(buffer.data(), buffer.size());
+    handler.stop();
+
+    EXPECT_EQ(batches.load(), 2);
+    EXPECT_EQ(ticks.load(), 4);
+    EXPECT_EQ(handler.get_statistics().messages_parsed.load(), 4u);
+}
+
+namespace {
+
+std::string quote(const std::string& symbol, int price, char side) {
+    return "8=FIX.4.4|9=60|35=D|55=" + symbol + "|44=" + std::to_string(price) +
+           "|38=100|54=" + (side == 'S' ? "2" : "1") + "|10=000|\n";
+}
+
+// Holds the parser thread in the first callback until released, so the
+// test can fill the ring behind it
+struct StalledConsumer {
+    std::atomic<bool> entered{false};
+    std::atomic<bool> released{false};
+
+    void hold() {
+        if (!entered.exchange(true)) {
+            while (!released.load()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void wait_entered() const {
+        while (!entered.load()) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+} // namespace
+
+TEST(ThreadedFeedHandlerTest, OverflowPolicyFromQueueConfig) {
+    OverflowPolicy policy = OverflowPolicy::DROP_NEWEST;
+    EXPECT_TRUE(parse_overflow_policy("conflate", policy));
+    EXPECT_EQ(policy, OverflowPolicy::CONFLATE);
+    EXPECT_FALSE(parse_overflow_policy("drop_everything", policy));
+    EXPECT_EQ(policy, OverflowPolicy::CONFLATE);
+
+    feedhandler::config::PerformanceConfig::QueueConfig queue;
+    queue.ring_buffer_size = 256;
+    EXPECT_EQ(ThreadedFeedHandler::Config::from_queue(queue).overflow_policy, OverflowPolicy::DROP_NEWEST);
+    EXPECT_EQ(ThreadedFeedHandler::Config::from_queue(queue).queue_size, 256u);
+    queue.enable_backpressure = true;
+    EXPECT_EQ(ThreadedFeedHandler::Config::from_queue(queue).overflow_policy, OverflowPolicy::BLOCK);
+    queue.overflow_policy = "drop_oldest";
+    EXPECT_EQ(ThreadedFeedHandler::Config::from_queue(queue).overflow_policy, OverflowPolicy::DROP_OLDEST);
+}
+
+TEST(ThreadedFeedHandlerTest, BlockPolicyWaitsInsteadOfDropping) {
+    ThreadedFeedHandler::Config config;
+    config.queue_size = 2;
+    config.overflow_policy = OverflowPolicy::BLOCK;
+    StalledConsumer consumer;
+    std::atomic<int> ticks{0};
+    ThreadedFeedHandler handler(config, [&](const feedhandler::common::Tick&) {
+        consumer.hold();
+        ticks.fetch_add(1);
+    });
+
+    handler.start();
+    std::string msg = quote("AAPL", 100, 'B');
+    handler.inject_data(msg.data(), msg.size());
+    consumer.wait_entered();
+    std::thread release([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        consumer.released.store(true);
+    });
+    for (int i = 0; i < 20; ++i) {
+        handler.inject_data(msg.data(), msg.size());  // Blocks once the ring is full
+    }
+    release.join();
+    handler.stop();
+
+    const auto& stats = handler.get_statistics();
+    EXPECT_EQ(stats.queue_overflows.load(), 0u);
+    EXPECT_GT(stats.backpressure_waits.load(), 0u);
+    EXPECT_EQ(ticks.load(), 21);
+}
+
+TEST(ThreadedFeedHandlerTest, DropOldestKeepsFreshestBuffers) {
+    ThreadedFeedHandler::Config config;
+    config.queue_size = 16;
+    config.high_watermark = 0.5;
+    config.overflow_policy = OverflowPolicy::DROP_OLDEST;
+    StalledConsumer consumer;
+    std::vector<int64_t> prices;
+    ThreadedFeedHandler handler(config, [&](const feedhandler::common::Tick& tick) {
+        consumer.hold();
+        prices.push_back(tick.price);
+    });
+
+    handler.start();
+    std::string first = quote("AAPL", 100, 'B');
+    handler.inject_data(first.data(), first.size());
+    consumer.wait_entered();
+    for (int i = 1; i <= 16; ++i) {
+        std::string msg = quote("AAPL", 100 + i, 'B');
+        handler.inject_data(msg.data(), msg.size());
+    }
+    consumer.released.store(true);
+    handler.stop();
+
+    const auto& stats = handler.get_statistics();
+    EXPECT_EQ(stats.queue_overflows.load(), 0u);
+    EXPECT_GT(stats.buffers_shed.load(), 0u);
+    EXPECT_EQ(prices.size() + stats.buffers_shed.load(), 17u);
+    ASSERT_FALSE(prices.empty());
+    EXPECT_EQ(prices.back(), feedhandler::common::double_to_price(116.0));
+    EXPECT_EQ(prices[1], feedhandler::common::double_to_price(100.0 + static_cast<double>(stats.buffers_shed.load()) + 1));
+}
+
+TEST(ThreadedFeedHandlerTest, ConflateDeliversLatestPerSymbolAndSide) {
+    ThreadedFeedHandler::Config config;
+    config.queue_size = 16;
+    config.high_watermark = 0.5;
+    config.overflow_policy = OverflowPolicy::CONFLATE;
+    StalledConsumer consumer;
+    std::vector<std::vector<feedhandler::common::Tick>> batches;
+    ThreadedFeedHandler handler(config, [&](std::span<const feedhandler::common::Tick> batch) {
+        consumer.hold();
+        batches.emplace_back(batch.begin(), batch.end());
+    });
+
+    handler.start();
+    std::string first = quote("AAPL", 100, 'B');
+    handler.inject_data(first.data(), first.size());
+    consumer.wait_entered();
+    for (int i = 1; i <= 12; ++i) {
+        std::string msg = quote("AAPL", 100 + i, 'B') + quote("AAPL", 200 + i, 'S');
+        if (i == 3) {
+            msg += quote("MSFT", 50, 'B');
+        }
+        handler.inject_data(msg.data(), msg.size());
+    }
+    consumer.released.store(true);
+    handler.stop();
+
+    const auto& stats = handler.get_statistics();
+    EXPECT_EQ(stats.queue_overflows.load(), 0u);
+    EXPECT_EQ(stats.messages_parsed.load(), 26u);
+    ASSERT_EQ(batches.size(), 2u);  // The stalled one, then the whole backlog conflated
+
+    const auto& conflated = batches[1];
+    ASSERT_EQ(conflated.size(), 3u);
+    EXPECT_EQ(stats.ticks_conflated.load(), 22u);
+    EXPECT_EQ(std::string(conflated[0].symbol), "MSFT");  // Ordered by each key's last update
+    EXPECT_EQ(conflated[1].side, 'B');
+    EXPECT_EQ(conflated[1].price, feedhandler::common::double_to_price(112.0));
+    EXPECT_EQ(conflated[2].side, 'S');
+    EXPECT_EQ(conflated[2].price, feedhandler::common::double_to_price(212.0));
+}
+
+TEST(ThreadedFeedHandlerTest, DeliveryBatchFoldsQueuedBuffers) {
+    feedhandler::config::PerformanceConfig::QueueConfig queue;
+    queue.enable_batching = true;
+    queue.batch_size = 4;
+    EXPECT_EQ(ThreadedFeedHandler::Config::from_queue(queue).delivery_batch, 4u);
+    queue.enable_batching = false;
+    EXPECT_EQ(ThreadedFeedHandler::Config::from_queue(queue).delivery_batch, 1u);
+
+    ThreadedFeedHandler::Config config;
+    config.queue_size = 16;
+    config.delivery_batch = 4;
+    StalledConsumer consumer;
+    std::vector<size_t> batches;
+    ThreadedFeedHandler handler(config, [&](std::span<const feedhandler::common::Tick> batch) {
+        consumer.hold();
+        batches.push_back(batch.size());
+    });
+
+    handler.start();
+    std::string msg = quote("AAPL", 100, 'B');
+    handler.inject_data(msg.data(), msg.size());
+    consumer.wait_entered();
+    for (int i = 0; i < 6; ++i) {
+        handler.inject_data(msg.data(), msg.size());
+    }
+    consumer.released.store(true);
+    handler.stop();
+
+    // The stalled buffer alone, then the six queued behind it in groups of four
+    EXPECT_EQ(batches, (std::vector<size_t>{1, 4, 2}));
+    EXPECT_EQ(handler.get_statistics().messages_parsed.load(), 7u);
+}
+
+TEST(ThreadedFeedHandlerTest, SimdParsingStampsReceiveTime) {
+    ThreadedFeedHandler::Config config;
+    config.simd_parsing = true;
+    config.simd_level = feedhandler::parser::SimdLevel::AVX512BW;
+    std::vector<feedhandler::common::Tick> ticks;
+    ThreadedFeedHandler handler(config, [&](std::span<const feedhandler::common::Tick> batch) {
+        ticks.insert(ticks.end(), batch.begin(), batch.end());
+    });
+    ASSERT_TRUE(handler.simd_level().has_value());
+    EXPECT_EQ(*handler.simd_level(),
+              feedhandler::parser::SIMDFixParser::supported_simd_level(feedhandler::parser::SimdLevel::AVX512BW));
+
+    // A message split across two reads is completed by the second
+    const std::string msg = quote("MSFT", 300, 'S') + quote("AAPL", 100, 'B');
+    handler.start();
+    handler.inject_data(msg.data(), 40, 1111);
+    handler.inject_data(msg.data() + 40, msg.size() - 40, 2222);
+    handler.stop();
+
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(std::string(ticks[0].symbol), "MSFT");
+    EXPECT_EQ(ticks[0].side, 'S');
+    EXPECT_EQ(ticks[1].price, feedhandler::common::double_to_price(100.0));
+    EXPECT_EQ(ticks[0].timestamp, 2222u);
+    EXPECT_EQ(ticks[1].timestamp, 2222u);
+
+    ThreadedFeedHandler fsm{ThreadedFeedHandler::Config(), ThreadedFeedHandler::TickCallback()};
+    EXPECT_FALSE(fsm.simd_level().has_value());
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "benchmarks/stage_profiler.hpp"
+
+#include <cstdint>
+#include <thread>
+
+using namespace feedhandler::benchmarks;
+
+namespace {
+
+uint64_t busy_work(uint64_t rounds) {
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < rounds; ++i) {
+        sum = sum + i * 7;
+    }
+    return sum;
+}
+
+} // namespace
+
+TEST(StageProfilerTest, AttributesBatchesToStages) {
+    StageProfiler profiler;
+    size_t parse = profiler.add_stage("parse");
+    size_t book = profiler.add_stage("book_update");
+    EXPECT_EQ(profiler.stage_count(), 2u);
+    EXPECT_EQ(profiler.stage_name(book), "book_update");
+
+    for (int i = 0; i < 4; ++i) {
+        StageProfiler::Scope scope(profiler, parse);
+        busy_work(100000);
+    }
+    {
+        StageProfiler::Scope scope(profiler, book);
+        busy_work(1000);
+    }
+
+    EXPECT_EQ(profiler.batches(parse), 4u);
+    EXPECT_EQ(profiler.batches(book), 1u);
+    HardwareProfiler::Metrics parse_metrics = profiler.metrics(parse);
+    EXPECT_GT(parse_metrics.wall_time.count(), 0);
+    if (StageProfiler::counters_available()) {
+        // The heavy stage ran ~400x the instructions of the light one
+        EXPECT_GT(parse_metrics.instructions, 400000u);
+        EXPECT_GT(parse_metrics.instructions, profiler.metrics(book).instructions);
+        EXPECT_GT(parse_metrics.ipc, 0.0);
+    } else {
+        EXPECT_EQ(parse_metrics.instructions, 0u);
+    }
+
+    profiler.reset();
+    EXPECT_EQ(profiler.batches(parse), 0u);
+    EXPECT_EQ(profiler.metrics(parse).wall_time.count(), 0);
+}
+
+TEST(StageProfilerTest, SampleIntervalSkipsBatches) {
+    StageProfiler profiler(4);
+    size_t stage = profiler.add_stage("parse");
+
+    // Fresh thread, so the per-thread sample countdown starts at zero
+    std::thread worker([&] {
+        for (int i = 0; i < 10; ++i) {
+            profiler.end(stage, profiler.begin());
+        }
+    });
+    worker.join();
+
+    EXPECT_EQ(profiler.batches(stage), 10u);
+    EXPECT_EQ(profiler.sampled_batches(stage), 3u);  // Batches 0, 4, 8
+}
+
+TEST(StageProfilerTest, RejectsUnknownAndExtraStages) {
+    StageProfiler profiler;
+    for (size_t i = 0; i < StageProfiler::MAX_STAGES; ++i) {
+        EXPECT_EQ(profiler.add_stage("stage"), i);
+    }
+    EXPECT_EQ(profiler.add_stage("overflow"), StageProfiler::INVALID_STAGE);
+
+    profiler.end(StageProfiler::INVALID_STAGE, profiler.begin());
+    EXPECT_EQ(profiler.batches(StageProfiler::INVALID_STAGE), 0u);
+}
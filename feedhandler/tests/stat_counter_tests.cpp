@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "common/stat_counter.hpp"
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::common;
+
+TEST(StatCounterTest, SlotsDoNotShareCacheLines) {
+    EXPECT_EQ(sizeof(LocalCounter), 64u);
+    EXPECT_EQ(alignof(LocalCounter), 64u);
+    EXPECT_EQ(sizeof(StatCounter), STAT_COUNTER_SLOTS * 64);
+}
+
+TEST(StatCounterTest, AddLoadAndStore) {
+    StatCounter counter;
+    EXPECT_EQ(counter.load(), 0u);
+    counter.add();
+    counter.add(41);
+    EXPECT_EQ(counter.load(), 42u);
+    counter.store(7);
+    EXPECT_EQ(counter.load(), 7u);
+    counter.reset();
+    EXPECT_EQ(counter.load(), 0u);
+
+    LocalCounter local;
+    local.add(5);
+    local.add();
+    EXPECT_EQ(local.load(), 6u);
+    local.reset();
+    EXPECT_EQ(local.load(), 0u);
+}
+
+TEST(StatCounterTest, AggregatesEveryThread) {
+    // More threads than exclusive slots: the rest share the last one
+    constexpr size_t THREADS = STAT_COUNTER_SLOTS + 8;
+    constexpr uint64_t PER_THREAD = 20000;
+    StatCounter counter;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&] {
+            for (uint64_t i = 0; i < PER_THREAD; ++i) {
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.load(), THREADS * PER_THREAD);
+}
+
+TEST(StatCounterTest, ExitedThreadsGiveTheirSlotBack) {
+    std::set<size_t> slots;
+    for (int round = 0; round < 3 * static_cast<int>(STAT_COUNTER_SLOTS); ++round) {
+        size_t slot = 0;
+        std::thread([&] { slot = this_thread_counter_slot(); }).join();
+        slots.insert(slot);
+    }
+    // Threads that come and go one at a time keep reusing a few slots
+    EXPECT_LT(slots.size(), STAT_COUNTER_SLOTS / 2);
+    EXPECT_EQ(slots.count(STAT_COUNTER_SHARED_SLOT), 0u);
+
+    // Threads alive together get distinct slots
+    const size_t main_slot = this_thread_counter_slot();
+    size_t worker_slot = main_slot;
+    std::thread([&] { worker_slot = this_thread_counter_slot(); }).join();
+    EXPECT_NE(worker_slot, main_slot);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "quantum/state_vector.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace feedhandler::quantum;
+
+namespace {
+
+// Random mix of every op kind, touching low and high qubits alike
+GateSequence random_circuit(size_t qubits, size_t ops, std::vector<double>& diagonal, std::mt19937& gen) {
+    std::uniform_real_distribution<double> angle(-3.0, 3.0);
+    std::uniform_int_distribution<size_t> qubit(0, qubits - 1);
+    std::uniform_int_distribution<int> kind(0, 9);
+
+    diagonal.resize(size_t{1} << qubits);
+    for (auto& d : diagonal) {
+        d = angle(gen);
+    }
+
+    GateSequence sequence;
+    for (size_t i = 0; i < ops; ++i) {
+        int k = kind(gen);
+        size_t q = qubit(gen);
+        if (k < 3) {
+            sequence.add_hadamard(q);
+        } else if (k < 5) {
+            sequence.add_rotation_x(q, angle(gen));
+        } else if (k < 7) {
+            sequence.add_rotation_z(q, angle(gen));
+        } else if (k < 9) {
+            size_t target = (q + 1 + qubit(gen) % (qubits - 1)) % qubits;
+            sequence.add_cnot(q, target);
+        } else {
+            sequence.add_phase(diagonal.data(), angle(gen));
+        }
+    }
+    return sequence;
+}
+
+void expect_same_state(const StateVector& actual, const StateVector& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        ASSERT_NEAR(actual.real()[i], expected.real()[i], 1e-10) << "amplitude " << i;
+        ASSERT_NEAR(actual.imag()[i], expected.imag()[i], 1e-10) << "amplitude " << i;
+    }
+}
+
+} // namespace
+
+TEST(StateVectorTest, FusedGatesEqualTheirProduct) {
+    GateSequence sequence;
+    sequence.add_rotation_z(0, 0.3);
+    sequence.add_rotation_x(0, 1.1);
+    sequence.add_rotation_z(0, -0.7);
+    sequence.add_hadamard(1);
+    ASSERT_EQ(sequence.size(), 2u);  // One op per qubit
+
+    sequence.add_cnot(0, 1);
+    sequence.add_hadamard(1);  // After the CNOT: no fusion across it
+    EXPECT_EQ(sequence.size(), 4u);
+
+    StateVector state(2);
+    StateVectorSimulator simulator;
+    simulator.apply(sequence, state);
+
+    Gate2x2 q0 = Gate2x2::rotation_z(0.3).then(Gate2x2::rotation_x(1.1)).then(Gate2x2::rotation_z(-0.7));
+    StateVector expected(2);
+    GateSequence reference;
+    reference.add(0, q0);
+    reference.add_hadamard(1);
+    reference.add_cnot(0, 1);
+    reference.add_hadamard(1);
+    StateVectorSimulator::apply_unblocked(reference, expected);
+    expect_same_state(state, expected);
+}
+
+TEST(StateVectorTest, BlockedPassesMatchTheUnblockedReference) {
+    std::mt19937 gen(5);
+    // Default blocking, blocks smaller than the state (global passes) and two threads
+    const StateVectorSimulator::Config configs[] = {
+        {12, 1, 18},
+        {3, 1, 18},
+        {1, 1, 18},
+        {4, 2, 1},
+    };
+    for (size_t n : {2, 3, 5, 9}) {
+        for (const auto& config : configs) {
+            std::vector<double> diagonal;
+            GateSequence sequence = random_circuit(n, 60, diagonal, gen);
+
+            StateVector expected(n);
+            expected.set_uniform();
+            StateVector state = expected;
+            StateVectorSimulator::apply_unblocked(sequence, expected);
+            StateVectorSimulator(config).apply(sequence, state);
+
+            SCOPED_TRACE(testing::Message() << n << " qubits, block " << config.block_qubits);
+            expect_same_state(state, expected);
+            EXPECT_NEAR(state.norm_squared(), 1.0, 1e-10);
+        }
+    }
+}
+
+TEST(StateVectorTest, ComplexRoundTripAndUniformState) {
+    StateVector state(3);
+    state.set_uniform();
+    EXPECT_NEAR(state.probability(5), 1.0 / 8.0, 1e-15);
+
+    std::vector<StateVector::Complex> amplitudes = {{0.5, 0.0}, {0.0, 0.5}, {-0.5, 0.0}, {0.0, -0.5}};
+    StateVector copy = StateVector::from_complex(amplitudes);
+    EXPECT_EQ(copy.qubits(), 2u);
+    EXPECT_EQ(copy.to_complex(), amplitudes);
+    EXPECT_THROW(StateVector::from_complex(std::vector<StateVector::Complex>(3)), std::invalid_argument);
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include "distributed/cluster_computing.hpp"
+
+#include <unistd.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+namespace {
+
+ClusterManager::ClusterConfig cluster_config() {
+    static int counter = 0;
+    ClusterManager::ClusterConfig config;
+    config.cluster_name = "stream" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+    return config;
+}
+
+StreamProcessor::StreamConfig stream_config(size_t batch_size, uint32_t flush_interval_us) {
+    StreamProcessor::StreamConfig config;
+    config.buffer_size = 64;
+    config.batch_size = batch_size;
+    config.flush_interval_us = flush_interval_us;
+    return config;
+}
+
+bool publish(StreamProcessor& processor, const std::string& stream, const std::string& symbol,
+             const std::string& text, uint64_t sequence = 0) {
+    return processor.publish(stream, symbol, reinterpret_cast<const uint8_t*>(text.data()), text.size(),
+                             sequence);
+}
+
+template<typename Predicate>
+bool wait_for(Predicate done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+}
+
+// Collects processed payloads and checkpoints across threads
+struct Recorder {
+    std::mutex mutex;
+    std::vector<std::string> payloads;
+    std::vector<StreamProcessor::CheckpointOffsets> checkpoints;
+
+    StreamProcessor::StreamFunction function() {
+        return [this](const std::string&, const std::vector<uint8_t>& data) {
+            std::lock_guard<std::mutex> lock(mutex);
+            payloads.emplace_back(data.begin(), data.end());
+        };
+    }
+
+    StreamProcessor::CheckpointSink sink() {
+        return [this](const std::string&, const StreamProcessor::CheckpointOffsets& changed) {
+            std::lock_guard<std::mutex> lock(mutex);
+            checkpoints.push_back(changed);
+        };
+    }
+
+    size_t processed() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return payloads.size();
+    }
+};
+
+} // namespace
+
+TEST(StreamProcessorTest, FullBatchesFlushWithoutWaitingForTheDeadline) {
+    ClusterManager cluster(cluster_config());
+    StreamProcessor processor(stream_config(4, 10000000), cluster);  // 10 s deadline
+    Recorder recorder;
+    std::string stream = processor.create_stream("trades", {"feed"}, recorder.function());
+    ASSERT_EQ(stream, "trades");
+    EXPECT_TRUE(processor.create_stream("trades", {}, recorder.function()).empty());
+    processor.start_stream(stream);
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(publish(processor, stream, "AAPL", "t" + std::to_string(i)));
+    }
+    ASSERT_TRUE(wait_for([&] { return recorder.processed() == 8; }));
+
+    auto stats = processor.get_stream_stats(stream);
+    EXPECT_EQ(stats.messages_processed, 8u);
+    EXPECT_EQ(stats.batches_flushed, 2u);
+    EXPECT_EQ(stats.deadline_flushes, 0u);
+    EXPECT_LT(stats.max_latency_ms, 5000.0);
+    processor.stop_stream(stream);
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < 8; ++i) {
+        expected.push_back("t" + std::to_string(i));
+    }
+    EXPECT_EQ(recorder.payloads, expected);
+}
+
+TEST(StreamProcessorTest, PartialBatchFlushesAtSubMillisecondDeadline) {
+    ClusterManager cluster(cluster_config());
+    StreamProcessor processor(stream_config(32, 200), cluster);
+    Recorder recorder;
+    std::string stream = processor.create_stream("quotes", {"feed"}, recorder.function());
+    processor.start_stream(stream);
+
+    ASSERT_TRUE(publish(processor, stream, "MSFT", "a"));
+    ASSERT_TRUE(publish(processor, stream, "MSFT", "b"));
+    ASSERT_TRUE(wait_for([&] { return recorder.processed() == 2; }));
+
+    auto stats = processor.get_stream_stats(stream);
+    EXPECT_GE(stats.deadline_flushes, 1u);
+    EXPECT_EQ(stats.backlog_size, 0u);
+    EXPECT_GT(stats.average_latency_ms, 0.0);
+    EXPECT_GE(stats.p99_latency_ms, stats.average_latency_ms * 0.5);
+    EXPECT_GE(stats.max_latency_ms, stats.p99_latency_ms);
+    processor.stop_stream(stream);
+}
+
+TEST(StreamProcessorTest, FullBacklogRejectsAndDrainsOnStart) {
+    ClusterManager cluster(cluster_config());
+    auto config = stream_config(2, 100);
+    config.buffer_size = 4;
+    StreamProcessor processor(config, cluster);
+    Recorder recorder;
+    std::string stream = processor.create_stream("book", {"feed"}, recorder.function());
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(publish(processor, stream, "IBM", std::to_string(i)));
+    }
+    EXPECT_FALSE(publish(processor, stream, "IBM", "overflow"));
+    EXPECT_FALSE(publish(processor, "missing", "IBM", "x"));
+    auto stats = processor.get_stream_stats(stream);
+    EXPECT_EQ(stats.backlog_size, 4u);
+    EXPECT_EQ(stats.publish_rejected, 1u);
+
+    processor.start_stream(stream);
+    ASSERT_TRUE(wait_for([&] { return recorder.processed() == 4; }));
+    processor.stop_stream(stream);
+    EXPECT_EQ(processor.get_stream_stats(stream).backlog_size, 0u);
+
+    // Slots are reused once drained
+    processor.start_stream(stream);
+    ASSERT_TRUE(publish(processor, stream, "IBM", "again"));
+    processor.stop_stream(stream);
+    EXPECT_EQ(recorder.processed(), 5u);
+}
+
+TEST(StreamProcessorTest, ExactlyOnceDropsReplaysAcrossRestore) {
+    ClusterManager cluster(cluster_config());
+    Recorder recorder;
+    StreamProcessor::CheckpointOffsets restored;
+    {
+        StreamProcessor processor(stream_config(8, 100), cluster);
+        processor.set_checkpoint_sink(recorder.sink());
+        std::string stream = processor.create_stream("fills", {"feed"}, recorder.function());
+        processor.start_stream(stream);
+        for (uint64_t seq = 1; seq <= 3; ++seq) {
+            ASSERT_TRUE(publish(processor, stream, "AAPL", "a" + std::to_string(seq), seq));
+        }
+        ASSERT_TRUE(publish(processor, stream, "AAPL", "dup", 2));
+        ASSERT_TRUE(publish(processor, stream, "MSFT", "m1", 1));
+        processor.stop_stream(stream);
+
+        auto stats = processor.get_stream_stats(stream);
+        EXPECT_EQ(stats.messages_processed, 4u);
+        EXPECT_EQ(stats.duplicates_dropped, 1u);
+        EXPECT_GE(stats.checkpoint_count, 1u);
+        for (const auto& checkpoint : recorder.checkpoints) {
+            for (const auto& [symbol, offset] : checkpoint) {
+                restored[symbol] = offset;
+            }
+        }
+    }
+    EXPECT_EQ(restored["AAPL"], 3u);
+    EXPECT_EQ(restored["MSFT"], 1u);
+
+    // A restarted consumer replays from the source; only new records count
+    StreamProcessor processor(stream_config(8, 100), cluster);
+    std::string stream = processor.create_stream("fills", {"feed"}, recorder.function());
+    ASSERT_TRUE(processor.restore_checkpoint(stream, restored));
+    EXPECT_FALSE(processor.restore_checkpoint("missing", restored));
+    processor.start_stream(stream);
+    EXPECT_FALSE(processor.restore_checkpoint(stream, restored));
+    for (uint64_t seq = 1; seq <= 4; ++seq) {
+        ASSERT_TRUE(publish(processor, stream, "AAPL", "r" + std::to_string(seq), seq));
+    }
+    processor.stop_stream(stream);
+    EXPECT_EQ(processor.get_stream_stats(stream).messages_processed, 1u);
+    EXPECT_EQ(processor.get_stream_stats(stream).duplicates_dropped, 3u);
+    EXPECT_EQ(recorder.payloads.back(), "r4");
+}
+
+TEST(StreamProcessorTest, PeriodicCheckpointsCarryOnlyChangedOffsets) {
+    ClusterManager cluster(cluster_config());
+    auto config = stream_config(1, 100);
+    config.checkpoint_interval_ms = 5;
+    StreamProcessor processor(config, cluster);
+    Recorder recorder;
+    processor.set_checkpoint_sink(recorder.sink());
+    std::string stream = processor.create_stream("ticks", {"feed"}, recorder.function());
+    processor.start_stream(stream);
+
+    ASSERT_TRUE(publish(processor, stream, "AAPL", "a", 1));
+    ASSERT_TRUE(publish(processor, stream, "MSFT", "m", 1));
+    ASSERT_TRUE(wait_for([&] {
+        std::lock_guard<std::mutex> lock(recorder.mutex);
+        size_t symbols = 0;
+        for (const auto& checkpoint : recorder.checkpoints) {
+            symbols += checkpoint.size();
+        }
+        return symbols == 2;
+    }));
+    const size_t first_checkpoints = processor.get_stream_stats(stream).checkpoint_count;
+    EXPECT_GE(first_checkpoints, 1u);
+
+    ASSERT_TRUE(publish(processor, stream, "AAPL", "b", 2));
+    ASSERT_TRUE(wait_for([&] { return processor.get_stream_stats(stream).checkpoint_count > first_checkpoints; }));
+    processor.stop_stream(stream);
+
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    const auto& last = recorder.checkpoints.back();
+    ASSERT_EQ(last.size(), 1u);
+    EXPECT_EQ(last.at("AAPL"), 2u);
+}
+
+TEST(StreamProcessorTest, RejectsInvalidConfig) {
+    ClusterManager cluster(cluster_config());
+    auto config = stream_config(0, 100);
+    EXPECT_THROW(StreamProcessor(config, cluster), std::invalid_argument);
+    config = stream_config(128, 100);
+    EXPECT_THROW(StreamProcessor(config, cluster), std::invalid_argument);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "parser/symbol_filter.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace feedhandler::parser;
+
+TEST(SymbolFilterTest, ContainsExactlyTheSubscribedSymbols) {
+    SymbolFilter filter({"AAPL", "MSFT", "ESZ4"});
+    EXPECT_EQ(filter.size(), 3u);
+    EXPECT_TRUE(filter.contains("AAPL"));
+    EXPECT_TRUE(filter.contains("MSFT"));
+    EXPECT_TRUE(filter.contains("ESZ4"));
+    EXPECT_FALSE(filter.contains("AAP"));
+    EXPECT_FALSE(filter.contains("AAPLX"));
+    EXPECT_FALSE(filter.contains(""));
+    EXPECT_FALSE(filter.add("AAPL"));
+    EXPECT_FALSE(filter.add(""));
+
+    SymbolFilter empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.contains("AAPL"));
+}
+
+TEST(SymbolFilterTest, GrowsAndRejectsMostOfTheUniverse) {
+    // Subscribe to every tenth of 20000 symbols, as on a full-universe feed
+    SymbolFilter filter;
+    for (int i = 0; i < 20000; i += 10) {
+        EXPECT_TRUE(filter.add("SYM" + std::to_string(i)));
+    }
+    EXPECT_EQ(filter.size(), 2000u);
+
+    size_t false_matches = 0;
+    for (int i = 0; i < 20000; ++i) {
+        bool subscribed = i % 10 == 0;
+        EXPECT_EQ(filter.contains("SYM" + std::to_string(i)), subscribed) << i;
+    }
+    for (int i = 0; i < 20000; ++i) {
+        false_matches += filter.contains("OTHER" + std::to_string(i));
+    }
+    EXPECT_EQ(false_matches, 0u);
+
+    filter.clear();
+    EXPECT_TRUE(filter.empty());
+    EXPECT_FALSE(filter.contains("SYM0"));
+    EXPECT_TRUE(filter.add("SYM0"));
+    EXPECT_TRUE(filter.contains("SYM0"));
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "distributed/symbol_load_balancer.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+namespace {
+
+constexpr uint64_t SECOND = 1000000000ull;
+
+SymbolLoadBalancer::Node node(const std::string& id, std::vector<std::string> symbols, double capacity = 1.0) {
+    return SymbolLoadBalancer::Node{id, capacity, std::move(symbols)};
+}
+
+SymbolLoadBalancer::Config config(double trigger, double target, size_t max_moves, uint64_t cooldown_ns) {
+    SymbolLoadBalancer::Config config;
+    config.trigger_imbalance = trigger;
+    config.target_imbalance = target;
+    config.max_moves = max_moves;
+    config.cooldown_ns = cooldown_ns;
+    return config;
+}
+
+} // namespace
+
+TEST(SymbolRateTrackerTest, SamplesCountersIntoDecayingRates) {
+    SymbolRateTracker tracker(1000, 0);
+    auto& spy = tracker.counter("SPY");
+    for (int i = 0; i < 100; ++i) {
+        tracker.counter("SYM" + std::to_string(i));
+    }
+    EXPECT_EQ(&tracker.counter("SPY"), &spy);  // Stable across growth
+
+    spy.fetch_add(1000, std::memory_order_relaxed);
+    tracker.record("AAPL", 10);
+    EXPECT_EQ(tracker.rate("SPY"), 0.0);
+    tracker.sample(SECOND);
+    EXPECT_DOUBLE_EQ(tracker.rate("SPY"), 1000.0);  // First sample as measured
+    EXPECT_DOUBLE_EQ(tracker.rate("AAPL"), 10.0);
+
+    // A silent half-life halves the rate
+    tracker.sample(2 * SECOND);
+    EXPECT_DOUBLE_EQ(tracker.rate("SPY"), 500.0);
+    EXPECT_EQ(tracker.rates().size(), 102u);
+    EXPECT_EQ(tracker.rate("MSFT"), 0.0);
+}
+
+TEST(SymbolRateTrackerTest, ReportedRatesHoldUntilCountedLocally) {
+    SymbolRateTracker tracker(1000, 0);
+    tracker.set_rate("MSFT", 200.0);
+    tracker.sample(SECOND);
+    tracker.sample(2 * SECOND);
+    EXPECT_DOUBLE_EQ(tracker.rate("MSFT"), 200.0);
+
+    // Messages counted here take over from the reported rate
+    tracker.record("MSFT", 100);
+    tracker.sample(3 * SECOND);
+    EXPECT_DOUBLE_EQ(tracker.rate("MSFT"), 150.0);
+}
+
+TEST(SymbolLoadBalancerTest, PlaceGivesHotSymbolsTheirOwnNode) {
+    SymbolLoadBalancer::Rates rates = {{"ETF", 1000.0}};
+    std::vector<std::string> symbols = {"ETF"};
+    for (int i = 0; i < 9; ++i) {
+        symbols.push_back("S" + std::to_string(i));
+        rates["S" + std::to_string(i)] = 100.0;
+    }
+    std::vector<SymbolLoadBalancer::Node> nodes = {node("a", {}), node("b", {}), node("c", {})};
+    SymbolLoadBalancer::place(nodes, symbols, rates);
+    EXPECT_EQ(nodes[0].symbols, std::vector<std::string>{"ETF"});
+    EXPECT_EQ(nodes[1].symbols.size() + nodes[2].symbols.size(), 9u);
+    EXPECT_LE(SymbolLoadBalancer::imbalance(nodes, rates), 1000.0 / (1900.0 / 3.0) - 1.0 + 1e-9);
+
+    // Unmeasured symbols weigh the mean; capacity scales each node's share
+    std::vector<SymbolLoadBalancer::Node> weighted = {node("a", {}, 0.75), node("b", {}, 0.25)};
+    SymbolLoadBalancer::place(weighted, {"A", "B", "C", "D", "E", "F", "G", "H"}, {});
+    EXPECT_EQ(weighted[0].symbols.size(), 6u);
+    EXPECT_EQ(weighted[1].symbols.size(), 2u);
+    EXPECT_DOUBLE_EQ(SymbolLoadBalancer::imbalance(weighted, {}), 0.0);
+}
+
+TEST(SymbolLoadBalancerTest, PlanStartsPastTheTriggerAndRunsToTheTarget) {
+    SymbolLoadBalancer::Rates rates;
+    for (int i = 0; i < 8; ++i) {
+        rates["S" + std::to_string(i)] = 100.0;
+    }
+
+    // 25% over ideal: inside the band, nothing moves
+    SymbolLoadBalancer quiet(config(0.3, 0.05, 1, SECOND));
+    std::vector<SymbolLoadBalancer::Node> near = {node("a", {"S0", "S1", "S2", "S3", "S4"}),
+                                                  node("b", {"S5", "S6", "S7"})};
+    EXPECT_TRUE(quiet.plan(near, rates, 0).empty());
+    EXPECT_FALSE(quiet.rebalancing());
+
+    // 50% over: one move per round until even, though the second round starts inside the band
+    SymbolLoadBalancer balancer(config(0.3, 0.05, 1, SECOND));
+    std::vector<SymbolLoadBalancer::Node> nodes = {node("a", {"S0", "S1", "S2", "S3", "S4", "S5"}),
+                                                   node("b", {"S6", "S7"})};
+    auto first = balancer.plan(nodes, rates, 0);
+    ASSERT_EQ(first.size(), 1u);
+    EXPECT_EQ(first[0].from, "a");
+    EXPECT_EQ(first[0].to, "b");
+    EXPECT_TRUE(balancer.rebalancing());
+    EXPECT_DOUBLE_EQ(SymbolLoadBalancer::imbalance(nodes, rates), 0.25);
+
+    auto second = balancer.plan(nodes, rates, 1);
+    ASSERT_EQ(second.size(), 1u);
+    EXPECT_EQ(nodes[0].symbols.size(), 4u);
+    EXPECT_EQ(nodes[1].symbols.size(), 4u);
+    EXPECT_TRUE(balancer.plan(nodes, rates, 2).empty());
+    EXPECT_FALSE(balancer.rebalancing());
+}
+
+TEST(SymbolLoadBalancerTest, HotSymbolsStayPutAndMovedOnesCoolDown) {
+    SymbolLoadBalancer balancer(config(0.1, 0.05, 4, SECOND));
+
+    // Moving the ETF would only overload the other node
+    SymbolLoadBalancer::Rates rates = {{"ETF", 1000.0}, {"S0", 100.0}};
+    std::vector<SymbolLoadBalancer::Node> skewed = {node("a", {"ETF"}), node("b", {"S0"})};
+    EXPECT_TRUE(balancer.plan(skewed, rates, 0).empty());
+    EXPECT_GT(SymbolLoadBalancer::imbalance(skewed, rates), 0.8);
+
+    rates = {{"X", 300.0}, {"Y", 100.0}, {"Z", 100.0}};
+    std::vector<SymbolLoadBalancer::Node> nodes = {node("a", {"X", "Y"}), node("b", {"Z"})};
+    auto moves = balancer.plan(nodes, rates, 0);
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_EQ(moves[0].symbol, "Y");  // X would just move the hot spot
+
+    // b turns hot: Y may only go back once its cooldown is over
+    rates["Z"] = 400.0;
+    EXPECT_TRUE(balancer.plan(nodes, rates, SECOND / 2).empty());
+    moves = balancer.plan(nodes, rates, 2 * SECOND);
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_EQ(moves[0].symbol, "Y");
+    EXPECT_EQ(moves[0].to, "a");
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "common/symbol_table.hpp"
+#include "common/tick.hpp"
+#include "parser/fsm_fix_parser.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::common;
+
+TEST(SymbolTableTest, InternAssignsDenseIds) {
+    SymbolTable table(16);
+
+    EXPECT_EQ(table.intern("AAPL"), 0u);
+    EXPECT_EQ(table.intern("MSFT"), 1u);
+    EXPECT_EQ(table.intern("AAPL"), 0u);  // Same symbol, same ID
+    EXPECT_EQ(table.size(), 2u);
+
+    EXPECT_EQ(table.name(0), "AAPL");
+    EXPECT_EQ(table.name(1), "MSFT");
+    EXPECT_TRUE(table.name(2).empty());
+}
+
+TEST(SymbolTableTest, FindDoesNotInsert) {
+    SymbolTable table(16);
+
+    EXPECT_EQ(table.find("GOOG"), INVALID_INSTRUMENT);
+    EXPECT_EQ(table.size(), 0u);
+
+    InstrumentId id = table.intern("GOOG");
+    EXPECT_EQ(table.find("GOOG"), id);
+}
+
+TEST(SymbolTableTest, RejectsEmptyAndOversizedSymbols) {
+    SymbolTable table(16);
+
+    EXPECT_EQ(table.intern(""), INVALID_INSTRUMENT);
+    EXPECT_EQ(table.intern(std::string(SymbolTable::MAX_SYMBOL_LENGTH + 1, 'X')), INVALID_INSTRUMENT);
+
+    std::string longest(SymbolTable::MAX_SYMBOL_LENGTH, 'Y');
+    InstrumentId id = table.intern(longest);
+    ASSERT_NE(id, INVALID_INSTRUMENT);
+    EXPECT_EQ(table.name(id), longest);
+}
+
+TEST(SymbolTableTest, FullTableReturnsInvalid) {
+    SymbolTable table(2);
+
+    EXPECT_NE(table.intern("A"), INVALID_INSTRUMENT);
+    EXPECT_NE(table.intern("B"), INVALID_INSTRUMENT);
+    EXPECT_EQ(table.intern("C"), INVALID_INSTRUMENT);
+    EXPECT_EQ(table.find("A"), 0u);  // Existing symbols still resolve
+}
+
+TEST(SymbolTableTest, ConcurrentInternAgreesOnIds) {
+    SymbolTable table(1024);
+    constexpr int THREADS = 4;
+    constexpr int SYMBOLS = 500;
+
+    std::vector<std::vector<InstrumentId>> ids(THREADS, std::vector<InstrumentId>(SYMBOLS));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < SYMBOLS; ++i) {
+                ids[t][i] = table.intern("SYM" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(table.size(), static_cast<size_t>(SYMBOLS));
+    for (int i = 0; i < SYMBOLS; ++i) {
+        for (int t = 1; t < THREADS; ++t) {
+            ASSERT_EQ(ids[t][i], ids[0][i]);
+        }
+        EXPECT_EQ(table.name(ids[0][i]), "SYM" + std::to_string(i));
+    }
+}
+
+TEST(SymbolTableTest, TickCopiesInstrumentId) {
+    Tick tick;
+    tick.copy_symbol("NVDA");
+    InstrumentId id = tick.intern_symbol();
+
+    Tick copy = tick;
+    EXPECT_EQ(copy.instrument_id, id);
+    EXPECT_EQ(SymbolTable::global().name(id), "NVDA");
+}
+
+TEST(SymbolTableTest, FSMParserEmitsInstrumentId) {
+    feedhandler::parser::FSMFixParser parser;
+    std::vector<Tick> ticks;
+
+    std::string msg = "8=FIX.4.4|55=TSLA|44=250.50|38=100|54=1|10=000|";
+    parser.parse(msg.data(), msg.size(), ticks);
+
+    ASSERT_EQ(ticks.size(), 1u);
+    EXPECT_EQ(ticks[0].instrument_id, SymbolTable::global().find("TSLA"));
+    EXPECT_NE(ticks[0].instrument_id, INVALID_INSTRUMENT);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
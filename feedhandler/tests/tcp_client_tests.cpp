@@ -0,0 +1,278 @@
+#include <gtest/gtest.h>
+#include "net/tcp_client.hpp"
+#include "net/receive_buffer.hpp"
+#include "net/rx_timestamp.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace feedhandler::net;
+
+namespace {
+
+// Loopback listener on an ephemeral port; accepts one peer
+class LoopbackServer {
+public:
+    LoopbackServer() {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_fd_, 1);
+
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+
+    ~LoopbackServer() {
+        close_peer();
+        ::close(listen_fd_);
+    }
+
+    int port() const { return port_; }
+    void accept_peer() { peer_fd_ = ::accept(listen_fd_, nullptr, nullptr); }
+    void close_peer() {
+        if (peer_fd_ >= 0) {
+            ::close(peer_fd_);
+            peer_fd_ = -1;
+        }
+    }
+    void send(const std::string& data) {
+        ASSERT_EQ(::send(peer_fd_, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+    }
+
+    // Whatever has arrived, without waiting
+    std::string receive_available() {
+        std::string out;
+        char chunk[65536];
+        ssize_t n;
+        while ((n = ::recv(peer_fd_, chunk, sizeof(chunk), MSG_DONTWAIT)) > 0) {
+            out.append(chunk, static_cast<size_t>(n));
+        }
+        return out;
+    }
+
+    std::string receive_exactly(size_t length) {
+        std::string out(length, '\0');
+        size_t got = 0;
+        while (got < length) {
+            ssize_t n = ::recv(peer_fd_, out.data() + got, length - got, 0);
+            if (n <= 0) {
+                break;
+            }
+            got += static_cast<size_t>(n);
+        }
+        out.resize(got);
+        return out;
+    }
+
+private:
+    int listen_fd_ = -1;
+    int peer_fd_ = -1;
+    int port_ = 0;
+};
+
+class TcpClientTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(client.connect("127.0.0.1", server.port()));
+        server.accept_peer();
+    }
+
+    LoopbackServer server;
+    TcpClient client;
+    ReceiveBuffer buffer;
+};
+
+} // namespace
+
+TEST_F(TcpClientTest, RecvIntoLandsBytesInBuffer) {
+    server.send("8=FIX.4.4|55=AAPL|");
+
+    ssize_t n = client.recv_into(buffer);
+    ASSERT_EQ(n, 18);
+    EXPECT_EQ(std::string(buffer.read_ptr(), buffer.readable_bytes()), "8=FIX.4.4|55=AAPL|");
+
+    // Appends after unread bytes
+    server.send("10=000|");
+    EXPECT_EQ(client.recv_into(buffer), 7);
+    EXPECT_EQ(std::string(buffer.read_ptr(), buffer.readable_bytes()), "8=FIX.4.4|55=AAPL|10=000|");
+}
+
+TEST_F(TcpClientTest, DontWaitReturnsZeroWhenIdle) {
+    EXPECT_EQ(client.recv_into(buffer, MSG_DONTWAIT), 0);
+    EXPECT_TRUE(client.is_connected());
+    EXPECT_EQ(client.drain_into(buffer), 0u);
+}
+
+TEST_F(TcpClientTest, DrainCompactsFullBuffer) {
+    // Fill the buffer, consume a little, then drain more: the unread tail
+    // is moved to the front to make room
+    std::string chunk(ReceiveBuffer::BUFFER_SIZE, 'x');
+    server.send(chunk);
+    while (buffer.available_write() > 0) {
+        ASSERT_GT(client.recv_into(buffer), 0);
+    }
+    buffer.consume(100);
+
+    server.send(std::string(100, 'y'));
+    EXPECT_EQ(client.drain_into(buffer), 100u);
+    EXPECT_EQ(buffer.readable_bytes(), ReceiveBuffer::BUFFER_SIZE);
+    EXPECT_EQ(buffer.read_ptr()[ReceiveBuffer::BUFFER_SIZE - 1], 'y');
+}
+
+TEST_F(TcpClientTest, PeerCloseDisconnects) {
+    server.close_peer();
+    EXPECT_EQ(client.recv_into(buffer), -1);
+    EXPECT_FALSE(client.is_connected());
+    EXPECT_EQ(client.recv_into(buffer), -1);
+}
+
+TEST_F(TcpClientTest, TimestampingRecordsArrivalTime) {
+    EXPECT_EQ(buffer.receive_timestamp(), 0u);
+    ASSERT_TRUE(client.enable_timestamping());
+    
+    uint64_t before = realtime_ns();
+    server.send("8=FIX.4.4|55=AAPL|");
+    ASSERT_EQ(client.recv_into(buffer), 18);
+    uint64_t after = realtime_ns();
+    
+    // Kernel receive time (or read time if the stack gave none)
+    EXPECT_GE(buffer.receive_timestamp(), before - 1000000000ull);
+    EXPECT_LE(buffer.receive_timestamp(), after);
+    EXPECT_EQ(std::string(buffer.read_ptr(), buffer.readable_bytes()), "8=FIX.4.4|55=AAPL|");
+}
+
+TEST_F(TcpClientTest, QueuedMessagesGoOutInOneWrite) {
+    std::string expected;
+    for (int i = 0; i < 50; ++i) {
+        std::string heartbeat = "8=FIX.4.4|35=0|34=" + std::to_string(i) + "|10=000|";
+        ASSERT_TRUE(client.queue(heartbeat));
+        expected += heartbeat;
+    }
+    EXPECT_EQ(client.pending_send_bytes(), expected.size());
+    EXPECT_EQ(client.send_stats().syscalls, 0u);
+
+    ASSERT_TRUE(client.flush());
+    EXPECT_FALSE(client.has_pending_send());
+    EXPECT_EQ(client.send_stats().syscalls, 1u);
+    EXPECT_EQ(client.send_stats().messages, 50u);
+    EXPECT_EQ(server.receive_exactly(expected.size()), expected);
+
+    // Blocking send behind queued bytes keeps their order
+    ASSERT_TRUE(client.queue("first|"));
+    ASSERT_TRUE(client.send("second|"));
+    EXPECT_EQ(server.receive_exactly(13), "first|second|");
+}
+
+TEST_F(TcpClientTest, GatherSendKeepsMessageOrder) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 100; ++i) {
+        storage.push_back("35=V|262=" + std::to_string(i) + "|");
+    }
+    std::vector<std::string_view> messages(storage.begin(), storage.end());
+    std::string expected;
+    for (const auto& message : storage) {
+        expected += message;
+    }
+
+    ASSERT_TRUE(client.send(messages));
+    EXPECT_EQ(client.send_stats().syscalls, 2u);  // 64 gather entries per call
+    EXPECT_EQ(client.send_stats().bytes, expected.size());
+    EXPECT_EQ(server.receive_exactly(expected.size()), expected);
+}
+
+TEST(TcpClientOptionsTest, NonBlockingSendNeverWaitsOnSlowPeer) {
+    LoopbackServer server;
+    TcpClientConfig config;
+    config.nonblocking = true;
+    config.send_ring_bytes = 16 * 1024;
+    TcpClient client(config);
+    ASSERT_TRUE(client.connect("127.0.0.1", server.port()));
+    server.accept_peer();
+    EXPECT_TRUE(client.is_nonblocking());
+    int small = 4096;
+    setsockopt(client.fd(), SOL_SOCKET, SO_SNDBUF, &small, sizeof(small));
+
+    // The peer reads nothing: the kernel buffers fill, then the ring, and
+    // send() reports the overflow instead of stalling the thread
+    std::string accepted;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000000; ++i) {
+        std::string message = "seq=" + std::to_string(i) + "|" + std::string(1000, 'a' + i % 26) + "\n";
+        if (!client.send(message)) {
+            break;
+        }
+        accepted += message;
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_TRUE(client.is_connected());
+    EXPECT_GE(client.send_stats().ring_full, 1u);
+    EXPECT_GE(client.send_stats().would_block, 1u);
+    EXPECT_GT(client.pending_send_bytes(), 0u);
+    EXPECT_LE(client.pending_send_bytes(), client.send_ring_capacity());
+
+    // Once the peer reads, flush() delivers the rest, intact and in order
+    std::string received;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (received.size() < accepted.size() && std::chrono::steady_clock::now() < deadline) {
+        received += server.receive_available();
+        ASSERT_TRUE(client.flush());
+    }
+    EXPECT_FALSE(client.has_pending_send());
+    EXPECT_EQ(received.size(), accepted.size());
+    EXPECT_TRUE(received == accepted);
+}
+
+TEST(TcpClientOptionsTest, SocketOptionsAndConnectTimeout) {
+    TcpClientConfig config;
+    config.connect_timeout_ms = 1000;
+    config.quick_ack = true;
+    {
+        LoopbackServer server;
+        TcpClient client(config);
+        ASSERT_TRUE(client.connect("127.0.0.1", server.port()));
+        server.accept_peer();
+
+        // The timed connect does not leave the socket non-blocking
+        EXPECT_FALSE(client.is_nonblocking());
+        int nodelay = 0;
+        socklen_t length = sizeof(nodelay);
+        ASSERT_EQ(getsockopt(client.fd(), IPPROTO_TCP, TCP_NODELAY, &nodelay, &length), 0);
+        EXPECT_NE(nodelay, 0);
+
+        server.send("8=FIX.4.4|");
+        ReceiveBuffer buffer;
+        EXPECT_EQ(client.recv_into(buffer), 10);
+    }
+
+    // Nobody listening: refused, well inside the timeout
+    int closed_port;
+    {
+        LoopbackServer gone;
+        closed_port = gone.port();
+    }
+    TcpClient client(config);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(client.connect("127.0.0.1", closed_port));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_FALSE(client.is_connected());
+    EXPECT_FALSE(client.send("x"));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include "common/tick_batch.hpp"
+#include "parser/fsm_fix_parser.hpp"
+#include "parser/simd_fix_parser.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace feedhandler::common;
+using namespace feedhandler::parser;
+
+namespace {
+
+CompactTick make_tick(InstrumentId id, int64_t price, int32_t qty, char side, uint64_t timestamp = 0) {
+    CompactTick tick;
+    tick.instrument_id = id;
+    tick.price = price;
+    tick.qty = qty;
+    tick.side = side;
+    tick.timestamp = timestamp;
+    return tick;
+}
+
+// Straight row-by-row reference, wrapping like the kernels
+TickBatchSummary reference(const std::vector<CompactTick>& ticks, const InstrumentId* only) {
+    TickBatchSummary s;
+    uint64_t volume = 0, bids = 0, asks = 0, notional = 0;
+    for (const CompactTick& tick : ticks) {
+        if (only && tick.instrument_id != *only) {
+            continue;
+        }
+        uint64_t q = static_cast<uint64_t>(static_cast<int64_t>(tick.qty));
+        volume += q;
+        bids += tick.side == 'B' ? q : 0;
+        asks += tick.side == 'S' ? q : 0;
+        notional += static_cast<uint64_t>(tick.price) * q;
+        s.min_price = s.ticks == 0 ? tick.price : std::min(s.min_price, tick.price);
+        s.max_price = s.ticks == 0 ? tick.price : std::max(s.max_price, tick.price);
+        ++s.ticks;
+    }
+    s.volume = static_cast<int64_t>(volume);
+    s.bid_volume = static_cast<int64_t>(bids);
+    s.ask_volume = static_cast<int64_t>(asks);
+    s.notional = static_cast<int64_t>(notional);
+    return s;
+}
+
+void expect_summary(const TickBatchSummary& actual, const TickBatchSummary& expected) {
+    EXPECT_EQ(actual.ticks, expected.ticks);
+    EXPECT_EQ(actual.volume, expected.volume);
+    EXPECT_EQ(actual.bid_volume, expected.bid_volume);
+    EXPECT_EQ(actual.ask_volume, expected.ask_volume);
+    EXPECT_EQ(actual.notional, expected.notional);
+    EXPECT_EQ(actual.min_price, expected.min_price);
+    EXPECT_EQ(actual.max_price, expected.max_price);
+}
+
+std::string make_messages(size_t count) {
+    std::string buffer;
+    for (size_t i = 0; i < count; ++i) {
+        buffer += "8=FIX.4.4|35=D|55=SOA" + std::to_string(i % 3) + "|44=100.25|38=" + std::to_string(i + 1) +
+                  "|54=" + (i % 2 ? "2" : "1") + "|10=000|\n";
+    }
+    return buffer;
+}
+
+} // namespace
+
+TEST(TickBatchTest, ColumnsAreAlignedAndRowsRoundTrip) {
+    TickBatch batch(5);
+    EXPECT_EQ(batch.capacity(), 5u);
+    EXPECT_TRUE(batch.empty());
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(batch.push_back(make_tick(7, 1000 + i, 10 + i, i % 2 ? 'S' : 'B', 500 + i)));
+    }
+    EXPECT_FALSE(batch.push_back(make_tick(7, 1, 1, 'B')));
+    EXPECT_TRUE(batch.is_full());
+    EXPECT_EQ(batch.remaining(), 0u);
+
+    for (const void* column : {static_cast<const void*>(batch.prices().data()),
+                               static_cast<const void*>(batch.timestamps().data()),
+                               static_cast<const void*>(batch.instrument_ids().data()),
+                               static_cast<const void*>(batch.quantities().data()),
+                               static_cast<const void*>(batch.sides().data())}) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(column) % TickBatch::ALIGNMENT, 0u);
+    }
+    ASSERT_EQ(batch.prices().size(), 5u);
+    EXPECT_EQ(batch.prices()[3], 1003);
+    EXPECT_EQ(batch.sides()[3], 'S');
+
+    CompactTick row = batch[4];
+    EXPECT_EQ(row.instrument_id, 7u);
+    EXPECT_EQ(row.price, 1004);
+    EXPECT_EQ(row.qty, 14);
+    EXPECT_EQ(row.side, 'B');
+    EXPECT_EQ(row.timestamp, 504u);
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    std::vector<CompactTick> ticks(8, make_tick(1, 5, 1, 'B'));
+    EXPECT_EQ(batch.append(ticks), 5u);
+
+    TickBatch moved(std::move(batch));
+    EXPECT_EQ(moved.size(), 5u);
+    EXPECT_EQ(batch.capacity(), 0u);
+    EXPECT_FALSE(batch.push_back(ticks[0]));
+}
+
+TEST(TickBatchTest, SummaryComputesVwapAndImbalance) {
+    TickBatch batch(8);
+    batch.push_back(make_tick(1, 1000000, 100, 'B'));  // $100.00
+    batch.push_back(make_tick(1, 1010000, 300, 'S'));  // $101.00
+    batch.push_back(make_tick(2, 500000, 50, 'B'));
+    TickBatchSummary one = batch.summarize(1);
+    EXPECT_EQ(one.ticks, 2u);
+    EXPECT_EQ(one.volume, 400);
+    EXPECT_DOUBLE_EQ(one.vwap(), 1007500.0);
+    EXPECT_DOUBLE_EQ(one.imbalance(), -0.5);
+    EXPECT_EQ(one.min_price, 1000000);
+    EXPECT_EQ(one.max_price, 1010000);
+
+    TickBatchSummary all = batch.summarize();
+    EXPECT_EQ(all.ticks, 3u);
+    EXPECT_EQ(all.bid_volume, 150);
+    EXPECT_EQ(all.min_price, 500000);
+
+    TickBatchSummary none = batch.summarize(99);
+    EXPECT_EQ(none.ticks, 0u);
+    EXPECT_EQ(none.min_price, 0);
+    EXPECT_EQ(none.max_price, 0);
+    EXPECT_DOUBLE_EQ(none.vwap(), 0.0);
+    EXPECT_DOUBLE_EQ(none.imbalance(), 0.0);
+    EXPECT_EQ(TickBatch(0).summarize().ticks, 0u);
+}
+
+TEST(TickBatchTest, SummaryMatchesTheRowByRowReference) {
+    // Every length around the 4-row vector step, wide prices and
+    // negative quantities to exercise the split multiply
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> price(-(int64_t(1) << 40), int64_t(1) << 40);
+    std::uniform_int_distribution<int32_t> qty(-1000000, 1000000);
+    const char sides[] = {'B', 'S', 'X', '\0'};
+    for (size_t rows : {0u, 1u, 3u, 4u, 5u, 7u, 8u, 63u, 1000u}) {
+        std::vector<CompactTick> ticks;
+        TickBatch batch(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            ticks.push_back(make_tick(static_cast<InstrumentId>(rng() % 3), price(rng), qty(rng), sides[rng() % 4]));
+            batch.push_back(ticks.back());
+        }
+        SCOPED_TRACE(rows);
+        expect_summary(batch.summarize(), reference(ticks, nullptr));
+        for (InstrumentId id : {0u, 2u, INVALID_INSTRUMENT}) {
+            expect_summary(batch.summarize(id), reference(ticks, &id));
+        }
+    }
+}
+
+TEST(TickBatchTest, ParsersFillTheBatchAndStopWhenFull) {
+    std::string buffer = make_messages(7);
+    TickBatch batch(3);
+    FSMFixParser parser;
+
+    std::vector<int32_t> quantities;
+    size_t offset = 0;
+    while (offset < buffer.size()) {
+        size_t consumed = parser.parse(buffer.data() + offset, buffer.size() - offset, batch);
+        for (int32_t q : batch.quantities()) {
+            quantities.push_back(q);
+        }
+        if (offset == 0) {
+            EXPECT_TRUE(batch.is_full());
+            EXPECT_EQ(parser.parse(buffer.data() + consumed, buffer.size() - consumed, batch), 0u);
+            EXPECT_EQ(batch[0].instrument_id, SymbolTable::global().find("SOA0"));
+            EXPECT_EQ(batch[0].price, 1002500);
+            EXPECT_EQ(batch[1].side, 'S');
+        }
+        batch.clear();
+        ASSERT_GT(consumed, 0u);
+        offset += consumed;
+    }
+    EXPECT_EQ(quantities, (std::vector<int32_t>{1, 2, 3, 4, 5, 6, 7}));
+
+    SIMDFixParser simd;
+    TickBatch all(16);
+    simd.parse(buffer.data(), buffer.size(), all);
+    ASSERT_EQ(all.size(), 7u);
+    TickBatchSummary soa1 = all.summarize(SymbolTable::global().find("SOA1"));
+    EXPECT_EQ(soa1.ticks, 2u);  // Messages 1 and 4
+    EXPECT_EQ(soa1.volume, 2 + 5);
+    EXPECT_EQ(soa1.bid_volume, 5);
+    EXPECT_EQ(soa1.ask_volume, 2);
+}
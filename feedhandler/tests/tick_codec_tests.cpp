@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "storage/lz_codec.hpp"
+#include "storage/tick_codec.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::storage;
+
+namespace {
+
+// Four symbols interleaved at ~1us spacing, prices walking a few ticks
+std::vector<JournalRecord> market_data(size_t count) {
+    std::mt19937 rng(11);
+    std::vector<JournalRecord> records(count);
+    int64_t prices[4] = {1902500, 4151000, 1735000, 8801200};
+    uint64_t timestamp = 1700000000000000000ull;
+    for (size_t i = 0; i < count; ++i) {
+        JournalRecord& record = records[i];
+        record = JournalRecord{};
+        record.symbol = static_cast<uint32_t>(i % 4);
+        prices[record.symbol] += (static_cast<int64_t>(rng() % 5) - 2) * 100;
+        record.price = prices[record.symbol];
+        timestamp += 1000 + rng() % 3;
+        record.timestamp = timestamp;
+        record.qty = static_cast<int32_t>(100 * (1 + rng() % 10));
+        record.side = (rng() & 1) ? 'B' : 'S';
+    }
+    return records;
+}
+
+void expect_equal(const JournalRecord& a, const JournalRecord& b) {
+    EXPECT_EQ(a.price, b.price);
+    EXPECT_EQ(a.timestamp, b.timestamp);
+    EXPECT_EQ(a.symbol, b.symbol);
+    EXPECT_EQ(a.qty, b.qty);
+    EXPECT_EQ(a.side, b.side);
+}
+
+} // namespace
+
+TEST(TickCodecTest, VarintsAndZigzagRoundTrip) {
+    std::vector<uint8_t> out;
+    const int64_t values[] = {0, 1, -1, 63, -64, 1 << 20, INT64_MAX, INT64_MIN};
+    for (int64_t value : values) {
+        put_varint(out, zigzag_encode(value));
+    }
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[1], 2);
+    EXPECT_EQ(out[2], 1);
+    const uint8_t* p = out.data();
+    for (int64_t value : values) {
+        uint64_t encoded;
+        ASSERT_TRUE(get_varint(p, out.data() + out.size(), encoded));
+        EXPECT_EQ(zigzag_decode(encoded), value);
+    }
+    EXPECT_EQ(p, out.data() + out.size());
+    uint64_t value;
+    EXPECT_FALSE(get_varint(p, p, value));
+}
+
+TEST(TickCodecTest, MarketDataShrinksTenfoldWithLzOnTop) {
+    auto records = market_data(4096);
+    std::vector<uint8_t> encoded;
+    encode_ticks(std::span<const JournalRecord>(records), encoded);
+    const size_t raw = records.size() * sizeof(JournalRecord);
+    EXPECT_LT(encoded.size(), raw / 5);
+
+    std::vector<JournalRecord> decoded;
+    ASSERT_TRUE(decode_ticks(encoded.data(), encoded.size(), decoded));
+    ASSERT_EQ(decoded.size(), records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        expect_equal(decoded[i], records[i]);
+    }
+
+    std::vector<uint8_t> compressed(lz_compress_bound(encoded.size()));
+    size_t bytes = lz_compress(encoded.data(), encoded.size(), compressed.data(), compressed.size(), MAX_LEVEL);
+    EXPECT_LT(bytes, raw / 6);
+
+    EXPECT_FALSE(decode_ticks(encoded.data(), encoded.size() - 1, decoded));  // Truncated
+    encoded.push_back(0);
+    EXPECT_FALSE(decode_ticks(encoded.data(), encoded.size(), decoded));      // Trailing bytes
+}
+
+TEST(TickCodecTest, ExtremeFieldsAndCompactTicksRoundTrip) {
+    std::vector<common::CompactTick> ticks(4);
+    ticks[0].price = INT64_MAX;
+    ticks[0].timestamp = UINT64_MAX;
+    ticks[0].qty = INT32_MIN;
+    ticks[0].side = 'X';
+    ticks[1].price = INT64_MIN;
+    ticks[1].timestamp = 0;
+    ticks[1].instrument_id = 70000;  // Past the per-symbol price slots
+    ticks[1].qty = INT32_MAX;
+    ticks[1].side = 'B';
+    ticks[3].instrument_id = 7;
+    ticks[3].side = 'S';
+
+    std::vector<uint8_t> encoded;
+    encode_ticks(std::span<const common::CompactTick>(ticks), encoded);
+    std::vector<common::CompactTick> decoded;
+    ASSERT_TRUE(decode_ticks(encoded.data(), encoded.size(), decoded));
+    ASSERT_EQ(decoded.size(), ticks.size());
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        EXPECT_EQ(decoded[i].price, ticks[i].price) << i;
+        EXPECT_EQ(decoded[i].timestamp, ticks[i].timestamp) << i;
+        EXPECT_EQ(decoded[i].instrument_id, ticks[i].instrument_id) << i;
+        EXPECT_EQ(decoded[i].qty, ticks[i].qty) << i;
+        EXPECT_EQ(decoded[i].side, ticks[i].side) << i;
+    }
+}
+
+TEST(TickCodecTest, PriceLevelsRoundTripCompactly) {
+    std::vector<BookLevel> levels;
+    for (int i = 0; i < 20; ++i) {
+        levels.push_back({1902500 - i * 100, 100 * (i + 1)});
+    }
+    std::vector<uint8_t> encoded;
+    encode_levels(levels, encoded);
+    EXPECT_LT(encoded.size(), levels.size() * sizeof(BookLevel) / 3);
+
+    std::vector<BookLevel> decoded;
+    ASSERT_TRUE(decode_levels(encoded.data(), encoded.size(), decoded));
+    ASSERT_EQ(decoded.size(), levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        EXPECT_EQ(decoded[i].price, levels[i].price);
+        EXPECT_EQ(decoded[i].quantity, levels[i].quantity);
+    }
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include "storage/tick_journal.hpp"
+#include "threading/threaded_feedhandler.hpp"
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::common;
+using namespace feedhandler::storage;
+
+namespace {
+
+std::string temp_path() {
+    char name[] = "/tmp/tick_journal_XXXXXX";
+    int fd = mkstemp(name);
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    return name;
+}
+
+CompactTick make_tick(std::string_view symbol, uint64_t timestamp, int32_t qty) {
+    CompactTick tick;
+    tick.instrument_id = SymbolTable::global().intern(symbol);
+    tick.price = 1500000 + qty;
+    tick.timestamp = timestamp;
+    tick.qty = qty;
+    tick.side = (qty % 2) ? 'B' : 'S';
+    return tick;
+}
+
+} // namespace
+
+TEST(TickJournalTest, RoundTripAcrossBlocks) {
+    std::string path = temp_path();
+    const char* symbols[] = {"JRNL_A", "JRNL_B", "JRNL_C"};
+    {
+        TickJournalWriter writer(16);
+        ASSERT_TRUE(writer.open(path));
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(writer.append(make_tick(symbols[i % 3], 1000 + i * 10, i + 1)));
+        }
+        ASSERT_TRUE(writer.close());
+        EXPECT_EQ(writer.records_written(), 100u);
+    }
+
+    TickJournalReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_TRUE(reader.has_footer());
+    EXPECT_EQ(reader.block_count(), 7u);  // 6 full blocks of 16 + 4
+    EXPECT_EQ(reader.record_count(), 100u);
+    EXPECT_EQ(reader.symbol_count(), 3u);
+    EXPECT_EQ(reader.symbol(0), "JRNL_A");
+    EXPECT_EQ(reader.symbol(2), "JRNL_C");
+
+    auto first = reader.records(0);
+    ASSERT_EQ(first.size(), 16u);
+    EXPECT_EQ(first[1].symbol, 1u);
+    EXPECT_EQ(first[1].qty, 2);
+    EXPECT_EQ(first[1].timestamp, 1010u);
+
+    std::vector<CompactTick> ticks;
+    EXPECT_EQ(reader.read(0, UINT64_MAX, ticks), 100u);
+    EXPECT_EQ(ticks[50].instrument_id, SymbolTable::global().find(symbols[50 % 3]));
+    EXPECT_EQ(ticks[50].price, 1500051);
+    EXPECT_EQ(ticks[50].side, 'B');
+    std::remove(path.c_str());
+}
+
+TEST(TickJournalTest, SeekByTimestamp) {
+    std::string path = temp_path();
+    {
+        TickJournalWriter writer(10);
+        ASSERT_TRUE(writer.open(path));
+        for (int i = 0; i < 50; ++i) {
+            writer.append(make_tick("JRNL_SEEK", 100 * (i + 1), i + 1));
+        }
+    }  // Destructor closes and writes the index
+
+    TickJournalReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.find_block(0), 0u);
+    EXPECT_EQ(reader.find_block(2500), 2u);   // Block 2 spans 2100..3000
+    EXPECT_EQ(reader.find_block(5001), reader.block_count());
+
+    std::vector<CompactTick> ticks;
+    EXPECT_EQ(reader.read(2500, 3200, ticks), 7u);
+    EXPECT_EQ(ticks.front().timestamp, 2500u);
+    EXPECT_EQ(ticks.back().timestamp, 3100u);
+    std::remove(path.c_str());
+}
+
+TEST(TickJournalTest, UnclosedJournalIsRecoveredFromBlockHeaders) {
+    std::string path = temp_path();
+    TickJournalWriter writer(4);
+    ASSERT_TRUE(writer.open(path));
+    for (int i = 0; i < 10; ++i) {
+        writer.append(make_tick("JRNL_LIVE", 10 + i, i + 1));
+    }
+    ASSERT_TRUE(writer.flush());
+
+    TickJournalReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_FALSE(reader.has_footer());
+    EXPECT_EQ(reader.block_count(), 3u);
+    EXPECT_EQ(reader.record_count(), 10u);
+    EXPECT_EQ(reader.symbol(0), "JRNL_LIVE");
+
+    writer.close();
+    std::remove(path.c_str());
+}
+
+TEST(TickJournalTest, EncodedBlocksRoundTripAndShrinkTheFile) {
+    const char* symbols[] = {"JRNL_E1", "JRNL_E2"};
+    uint64_t raw_bytes = 0;
+    for (JournalEncoding encoding : {JournalEncoding::RAW, JournalEncoding::DELTA, JournalEncoding::DELTA_LZ}) {
+        std::string path = temp_path();
+        TickJournalWriter writer(256, encoding);
+        ASSERT_TRUE(writer.open(path));
+        for (int i = 0; i < 1000; ++i) {
+            ASSERT_TRUE(writer.append(make_tick(symbols[i % 2], 1000000 + i * 1000, 100 + i % 5)));
+        }
+        ASSERT_TRUE(writer.flush());  // Recoverable without the footer too
+        {
+            TickJournalReader unclosed;
+            ASSERT_TRUE(unclosed.open(path));
+            EXPECT_EQ(unclosed.block_count(), 4u);
+        }
+        ASSERT_TRUE(writer.close());
+        if (encoding == JournalEncoding::RAW) {
+            raw_bytes = writer.bytes_written();
+        } else {
+            EXPECT_LT(writer.bytes_written(), raw_bytes / 4);
+        }
+
+        TickJournalReader reader;
+        ASSERT_TRUE(reader.open(path));
+        EXPECT_TRUE(reader.has_footer());
+        EXPECT_EQ(reader.record_count(), 1000u);
+        auto block = reader.records(2);
+        ASSERT_EQ(block.size(), 256u);
+        EXPECT_EQ(block[3].timestamp, 1000000u + 515 * 1000);
+        EXPECT_EQ(block[3].symbol, 1u);
+
+        std::vector<CompactTick> ticks;
+        EXPECT_EQ(reader.read(1000000 + 500 * 1000, 1000000 + 510 * 1000, ticks), 10u);
+        EXPECT_EQ(ticks[1].instrument_id, SymbolTable::global().find("JRNL_E2"));
+        EXPECT_EQ(ticks[1].qty, 101);
+        EXPECT_EQ(ticks[1].price, 1500101);
+        std::remove(path.c_str());
+    }
+}
+
+TEST(TickJournalTest, RejectsOtherFiles) {
+    std::string path = temp_path();
+    FILE* file = std::fopen(path.c_str(), "w");
+    std::fputs("8=FIX.4.4|35=D|55=AAPL|44=150.25|38=500|54=1|10=020|\n"
+               "8=FIX.4.4|35=D|55=AAPL|44=150.25|38=500|54=1|10=020|\n", file);
+    std::fclose(file);
+
+    TickJournalReader reader;
+    EXPECT_FALSE(reader.open(path));
+    EXPECT_FALSE(reader.open("/nonexistent/ticks.jrnl"));
+    std::remove(path.c_str());
+}
+
+TEST(JournalRecorderTest, RecordsFeedHandlerBatches) {
+    std::string path = temp_path();
+    TickJournalWriter writer(8);
+    ASSERT_TRUE(writer.open(path));
+
+    {
+        JournalRecorder recorder(writer, 1024);
+        recorder.start();
+
+        threading::ThreadedFeedHandler::Config config;
+        threading::ThreadedFeedHandler handler(config, [&](std::span<const Tick> ticks) {
+            recorder.on_ticks(ticks);
+        });
+        handler.start();
+        std::string msg = "8=FIX.4.4|9=79|35=D|55=JRNL_FEED|44=150.25|38=500|54=1|52=20240131-12:34:56|10=020|\n";
+        for (int i = 0; i < 5; ++i) {
+            handler.inject_data(msg.data(), msg.size());
+        }
+        handler.stop();
+        recorder.stop();
+
+        EXPECT_EQ(recorder.recorded(), 5u);
+        EXPECT_EQ(recorder.dropped(), 0u);
+    }
+    ASSERT_TRUE(writer.close());
+
+    TickJournalReader reader;
+    ASSERT_TRUE(reader.open(path));
+    std::vector<CompactTick> ticks;
+    EXPECT_EQ(reader.read(0, UINT64_MAX, ticks), 5u);
+    EXPECT_EQ(ticks[0].symbol(), "JRNL_FEED");
+    EXPECT_EQ(ticks[0].qty, 500);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "common/tick_pool.hpp"
+#include "common/zero_latency_allocator.hpp"
+#include "threading/spsc_ring.hpp"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::common;
+
+TEST(RecyclingTickPoolTest, AcquireUntilExhaustedThenRecycle) {
+    RecyclingTickPool pool(4);
+    std::set<Tick*> seen;
+    for (int i = 0; i < 4; ++i) {
+        Tick* tick = pool.acquire();
+        ASSERT_NE(tick, nullptr);
+        EXPECT_TRUE(pool.owns(tick));
+        seen.insert(tick);
+    }
+    EXPECT_EQ(seen.size(), 4u);
+    EXPECT_EQ(pool.acquire(), nullptr);
+    EXPECT_EQ(pool.global_free(), 0u);
+
+    Tick* returned = *seen.begin();
+    pool.release(returned);
+    EXPECT_EQ(pool.global_free(), 1u);
+    EXPECT_EQ(pool.acquire(), returned);
+}
+
+TEST(RecyclingTickPoolTest, ForeignPointersIgnored) {
+    RecyclingTickPool pool(2);
+    Tick outside;
+    pool.release(&outside);
+    pool.release(nullptr);
+    EXPECT_FALSE(pool.owns(&outside));
+    EXPECT_EQ(pool.global_free(), 2u);
+}
+
+TEST(RecyclingTickPoolTest, LocalCacheRefillsAndFlushesInBatches) {
+    RecyclingTickPool pool(256);
+    std::vector<Tick*> held;
+    {
+        RecyclingTickPool::LocalCache cache(pool, 16);
+
+        held.push_back(cache.acquire());
+        EXPECT_EQ(cache.cached(), 15u);  // Refilled one batch
+        EXPECT_EQ(pool.global_free(), 240u);
+
+        for (int i = 0; i < 99; ++i) {
+            held.push_back(cache.acquire());
+        }
+        for (Tick* tick : held) {
+            cache.release(tick);
+        }
+        // Never holds more than MAX_CACHED locally
+        EXPECT_LE(cache.cached(), RecyclingTickPool::LocalCache::MAX_CACHED);
+    }
+    // Destructor handed everything back
+    EXPECT_EQ(pool.global_free(), 256u);
+}
+
+TEST(RecyclingTickPoolTest, RefillTakesTopOfStackFirst) {
+    RecyclingTickPool pool(8);
+    std::vector<Tick*> ticks;
+    for (int i = 0; i < 5; ++i) {
+        ticks.push_back(pool.acquire());
+    }
+    pool.release(ticks[2]);
+    pool.release(ticks[4]);  // Now on top, 5 free in all
+
+    RecyclingTickPool::LocalCache cache(pool, 16);
+    EXPECT_EQ(cache.acquire(), ticks[4]);  // Most recently released first
+    EXPECT_EQ(cache.acquire(), ticks[2]);
+    EXPECT_EQ(cache.cached(), 3u);         // Short refill: whatever was free
+    EXPECT_EQ(pool.global_free(), 0u);
+}
+
+TEST(RecyclingTickPoolTest, CacheReportsExhaustion) {
+    RecyclingTickPool pool(3);
+    RecyclingTickPool::LocalCache cache(pool, 8);
+    EXPECT_NE(cache.acquire(), nullptr);
+    EXPECT_NE(cache.acquire(), nullptr);
+    EXPECT_NE(cache.acquire(), nullptr);
+    EXPECT_EQ(cache.acquire(), nullptr);
+}
+
+TEST(RecyclingTickPoolTest, ProducedOnOneThreadReleasedOnAnother) {
+    constexpr int count = 50000;
+    RecyclingTickPool pool(512);
+    threading::SpscRing<Tick*> ring(128, threading::WaitStrategy::SPIN_YIELD, 16);
+    std::atomic<int> duplicates{0};
+
+    std::thread consumer([&] {
+        RecyclingTickPool::LocalCache cache(pool);
+        Tick* tick = nullptr;
+        int expected = 0;
+        while (ring.pop(tick)) {
+            if (tick->qty != expected++) {
+                duplicates.fetch_add(1);
+            }
+            cache.release(tick);
+        }
+    });
+
+    {
+        RecyclingTickPool::LocalCache cache(pool);
+        for (int i = 0; i < count; ++i) {
+            Tick* tick;
+            while ((tick = cache.acquire()) == nullptr) {
+                std::this_thread::yield();  // Consumer still holds everything
+            }
+            tick->qty = i;
+            while (!ring.try_push(tick)) {
+                std::this_thread::yield();
+            }
+        }
+        ring.shutdown();
+        consumer.join();
+    }
+
+    EXPECT_EQ(duplicates.load(), 0);
+    EXPECT_EQ(pool.global_free(), 512u);
+}
+
+TEST(RecyclingTickPoolTest, ConcurrentAcquireReleaseNeverSharesATick) {
+    constexpr int threads = 4;
+    constexpr int rounds = 20000;
+    RecyclingTickPool pool(16);
+    std::atomic<int> conflicts{0};
+
+    // qty doubles as an in-use flag; a tick handed out twice trips it
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&pool, &conflicts, t] {
+            RecyclingTickPool::LocalCache cache(pool, 4);
+            for (int r = 0; r < rounds; ++r) {
+                bool use_cache = (r + t) % 2 == 0;
+                Tick* tick = use_cache ? cache.acquire() : pool.acquire();
+                if (!tick) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (std::atomic_ref<int32_t>(tick->qty).exchange(1) != 0) {
+                    conflicts.fetch_add(1);
+                }
+                std::atomic_ref<int32_t>(tick->qty).store(0);
+                if (use_cache) {
+                    cache.release(tick);
+                } else {
+                    pool.release(tick);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    EXPECT_EQ(conflicts.load(), 0);
+    EXPECT_EQ(pool.global_free(), 16u);
+}
+
+TEST(TickPoolTest, ArenaBackedStorage) {
+    ZeroLatencyAllocator region(1 << 20, false, true);
+    auto arena = region.create_arena(256 * 1024);
+
+    TickPool pool(100, arena);
+    EXPECT_TRUE(pool.arena_backed());
+    EXPECT_EQ(pool.capacity(), 100u);
+    EXPECT_TRUE(arena.owns(pool.get_ticks().data()));
+
+    Tick tick;
+    tick.copy_symbol("AAPL");
+    tick.qty = 5;
+    EXPECT_TRUE(pool.push_back(tick));
+    EXPECT_EQ(pool.get_ticks()[0].symbol, "AAPL");
+    EXPECT_EQ(pool.get_ticks()[0].qty, 5);
+
+    TickPool heap_pool(100000, arena);  // Does not fit
+    EXPECT_FALSE(heap_pool.arena_backed());
+    EXPECT_EQ(heap_pool.capacity(), 100000u);
+}
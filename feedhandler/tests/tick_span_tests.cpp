@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "common/tick_span.hpp"
+#include "parser/fsm_fix_parser.hpp"
+#include "parser/stringview_fix_parser.hpp"
+#include "parser/repeating_group_parser.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace feedhandler::common;
+using namespace feedhandler::parser;
+
+namespace {
+
+std::string make_messages(size_t count) {
+    std::string buffer;
+    for (size_t i = 0; i < count; ++i) {
+        buffer += "8=FIX.4.4|35=D|55=SYM" + std::to_string(i) + "|44=100.25|38=" +
+                  std::to_string(i + 1) + "|54=1|10=000|\n";
+    }
+    return buffer;
+}
+
+} // namespace
+
+TEST(TickSpanTest, PushBackStopsAtCapacity) {
+    std::array<CompactTick, 2> storage;
+    TickSpan<CompactTick> span(storage);
+
+    CompactTick tick;
+    tick.qty = 1;
+    EXPECT_TRUE(span.push_back(tick));
+    EXPECT_TRUE(span.push_back(tick));
+    EXPECT_FALSE(span.push_back(tick));
+    EXPECT_TRUE(span.is_full());
+    EXPECT_EQ(span.size(), 2u);
+    EXPECT_EQ(span.remaining(), 0u);
+
+    span.clear();
+    EXPECT_TRUE(span.empty());
+    EXPECT_EQ(span.capacity(), 2u);
+}
+
+TEST(TickSpanTest, FSMStopsAtMessageBoundaryAndResumes) {
+    std::string buffer = make_messages(5);
+    std::array<Tick, 2> storage;
+    TickSpan<Tick> span(storage);
+    FSMFixParser parser;
+
+    std::vector<int32_t> quantities;
+    size_t offset = 0;
+    while (offset < buffer.size()) {
+        size_t consumed = parser.parse(buffer.data() + offset, buffer.size() - offset, span);
+        for (const Tick& tick : span) {
+            quantities.push_back(tick.qty);
+        }
+        span.clear();
+        ASSERT_GT(consumed, 0u);
+        offset += consumed;
+    }
+
+    EXPECT_EQ(quantities, (std::vector<int32_t>{1, 2, 3, 4, 5}));
+}
+
+TEST(TickSpanTest, FSMFullSpanConsumesNothing) {
+    std::string buffer = make_messages(1);
+    std::array<CompactTick, 1> storage;
+    TickSpan<CompactTick> span(storage);
+    span.push_back(CompactTick());
+
+    FSMFixParser parser;
+    EXPECT_EQ(parser.parse(buffer.data(), buffer.size(), span), 0u);
+    EXPECT_EQ(span.size(), 1u);
+}
+
+TEST(TickSpanTest, FSMWritesIntoTickPool) {
+    std::string buffer = make_messages(3);
+    TickPool pool(2);
+    FSMFixParser parser;
+
+    size_t consumed = parser.parse(buffer.data(), buffer.size(), pool);
+    EXPECT_LT(consumed, buffer.size());
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(pool.get_ticks()[1].symbol, "SYM1");
+
+    pool.reset();
+    parser.parse(buffer.data() + consumed, buffer.size() - consumed, pool);
+    EXPECT_EQ(pool.size(), 1u);
+    EXPECT_EQ(pool.get_ticks()[0].symbol, "SYM2");
+}
+
+TEST(TickSpanTest, StringViewBufferFillsSpan) {
+    std::string buffer = make_messages(4);
+    std::array<CompactTick, 3> storage;
+    TickSpan<CompactTick> span(storage);
+
+    EXPECT_EQ(StringViewFixParser::parse_messages_from_buffer(buffer, span), 3u);
+    EXPECT_EQ(span[2].qty, 3);
+    EXPECT_EQ(StringViewFixParser::parse_messages_from_buffer(buffer, span), 0u);
+}
+
+TEST(TickSpanTest, RepeatingGroupsFillSpanAcrossMessages) {
+    std::string buffer = "8=FIX.4.4|35=W|55=AAPL|268=2|269=0|270=150.00|271=10|269=1|270=150.50|271=20|\n"
+                         "8=FIX.4.4|35=W|55=MSFT|268=2|269=0|270=400.00|271=30|269=1|270=400.50|271=40|";
+    std::array<Tick, 3> storage;
+    TickSpan<Tick> span(storage);
+
+    EXPECT_EQ(RepeatingGroupParser::parse_buffer_with_repeating_groups(buffer, span), 3u);
+    EXPECT_EQ(span[0].symbol, "AAPL");
+    EXPECT_EQ(span[2].symbol, "MSFT");
+    EXPECT_EQ(span[2].qty, 30);
+
+    // Vector path still returns every entry
+    EXPECT_EQ(RepeatingGroupParser::parse_buffer_with_repeating_groups(buffer).size(), 4u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
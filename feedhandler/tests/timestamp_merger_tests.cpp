@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "pipeline/timestamp_merger.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace feedhandler::pipeline;
+
+namespace {
+
+struct Record {
+    uint64_t timestamp = 0;
+    uint32_t source = 0;
+    uint32_t sequence = 0;
+};
+
+// Source handing out records in blocks of at most max_block
+TimestampMerger<Record>::Fill vector_source(std::shared_ptr<std::vector<Record>> records, size_t max_block) {
+    auto next = std::make_shared<size_t>(0);
+    return [records, next, max_block](std::span<Record> out) {
+        size_t count = std::min({out.size(), max_block, records->size() - *next});
+        std::copy_n(records->begin() + static_cast<std::ptrdiff_t>(*next), count, out.begin());
+        *next += count;
+        return count;
+    };
+}
+
+} // namespace
+
+TEST(TimestampMergerTest, MatchesStableSortForAnyNumberOfSources) {
+    std::mt19937 rng(355);
+    for (uint32_t sources : {1u, 2u, 3u, 5u, 8u, 13u}) {
+        TimestampMerger<Record> merger(4);  // Small buffers: many refills
+        std::vector<Record> all;
+        for (uint32_t s = 0; s < sources; ++s) {
+            auto records = std::make_shared<std::vector<Record>>();
+            uint64_t timestamp = 0;
+            size_t length = std::uniform_int_distribution<size_t>(0, 200)(rng);
+            for (uint32_t i = 0; i < length; ++i) {
+                timestamp += std::uniform_int_distribution<uint64_t>(0, 3)(rng);  // Plenty of ties
+                records->push_back({timestamp, s, i});
+            }
+            all.insert(all.end(), records->begin(), records->end());
+            merger.add_source(vector_source(records, 3));
+        }
+        // Sources were appended in index order, so a stable sort breaks ties by source
+        std::stable_sort(all.begin(), all.end(), [](const Record& a, const Record& b) {
+            return a.timestamp < b.timestamp;
+        });
+
+        std::vector<Record> merged;
+        Record batch[7];
+        size_t total = merger.drain(std::span<Record>(batch), [&](std::span<const Record> records) {
+            EXPECT_LE(records.size(), 7u);
+            merged.insert(merged.end(), records.begin(), records.end());
+        });
+        ASSERT_EQ(total, all.size());
+        for (size_t i = 0; i < all.size(); ++i) {
+            ASSERT_EQ(merged[i].source, all[i].source) << sources << " sources, record " << i;
+            ASSERT_EQ(merged[i].sequence, all[i].sequence);
+        }
+        EXPECT_TRUE(merger.done());
+        EXPECT_EQ(merger.stats().merged, all.size());
+        EXPECT_EQ(merger.stats().out_of_order, 0u);
+    }
+}
+
+TEST(TimestampMergerTest, ToleratesEmptyLateAndUnorderedSources) {
+    TimestampMerger<Record> merger(8);
+    merger.add_source([](std::span<Record>) { return size_t{0}; });
+    merger.add_source(vector_source(std::make_shared<std::vector<Record>>(std::vector<Record>{{10, 1, 0}, {30, 1, 1}}), 8));
+
+    Record out[1];
+    ASSERT_EQ(merger.pop(std::span<Record>(out)), 1u);
+    EXPECT_EQ(out[0].timestamp, 10u);
+
+    // A source added mid-merge joins the tree; its 5 comes out after the 10 already popped
+    merger.add_source(vector_source(std::make_shared<std::vector<Record>>(std::vector<Record>{{5, 2, 0}, {20, 2, 1}}), 8));
+    Record rest[8];
+    ASSERT_EQ(merger.pop(std::span<Record>(rest)), 3u);
+    EXPECT_EQ(rest[0].timestamp, 5u);
+    EXPECT_EQ(rest[1].timestamp, 20u);
+    EXPECT_EQ(rest[2].timestamp, 30u);
+    EXPECT_EQ(merger.stats().out_of_order, 1u);
+    EXPECT_TRUE(merger.done());
+    EXPECT_EQ(merger.pop(std::span<Record>(rest)), 0u);
+
+    TimestampMerger<Record> empty;
+    EXPECT_EQ(empty.pop(std::span<Record>(rest)), 0u);
+    EXPECT_TRUE(empty.done());
+}
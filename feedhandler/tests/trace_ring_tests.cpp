@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include "common/trace_ring.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::common;
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return std::string(::testing::TempDir()) + name;
+}
+
+size_t count(const std::string& text, const std::string& needle) {
+    size_t n = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+TraceDump::Event event(uint64_t ns, uint16_t stage, TracePhase phase, uint64_t seq = 0) {
+    TraceDump::Event e;
+    e.ns = ns;
+    e.stage = stage;
+    e.phase = phase;
+    e.seq = seq;
+    return e;
+}
+
+} // namespace
+
+TEST(TraceRingTest, KeepsTheLastCapacityEventsInOrder) {
+    TraceRing ring(5);
+    EXPECT_EQ(ring.capacity(), 8u);
+
+    std::vector<TraceEvent> events;
+    EXPECT_EQ(ring.snapshot(events), 0u);
+    for (uint64_t seq = 1; seq <= 20; ++seq) {
+        ring.record(static_cast<uint16_t>(seq % 3), TracePhase::INSTANT, seq);
+    }
+    EXPECT_EQ(ring.recorded(), 20u);
+
+    // The oldest retained slot is the one the writer would take next
+    ASSERT_EQ(ring.snapshot(events), 7u);
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].seq, 14 + i);
+        EXPECT_EQ(events[i].stage, (14 + i) % 3);
+        if (i > 0) {
+            EXPECT_GE(events[i].tsc, events[i - 1].tsc);
+        }
+    }
+}
+
+TEST(TraceRingTest, GlobalTracerIsOffByDefault) {
+    EXPECT_FALSE(Tracer::global().enabled());
+    size_t threads = Tracer::global().thread_count();
+    {
+        TraceScope scope(Tracer::global().add_stage("test.scope"), 1);
+        trace(0, TracePhase::INSTANT);
+    }
+    EXPECT_EQ(Tracer::global().thread_count(), threads);
+}
+
+TEST(TraceRingTest, RecordsOnlyWhileEnabled) {
+    Tracer tracer;
+    uint16_t stage = tracer.add_stage("parse");
+    tracer.record(stage, TracePhase::BEGIN, 1);
+    EXPECT_EQ(tracer.thread_count(), 0u);  // No ring allocated either
+
+    tracer.enable();
+    tracer.record(stage, TracePhase::BEGIN, 1);
+    tracer.record(stage, TracePhase::END, 1);
+    tracer.record(Tracer::INVALID_STAGE, TracePhase::INSTANT, 2);
+    tracer.enable(false);
+    tracer.record(stage, TracePhase::INSTANT, 3);
+
+    TraceDump dump = tracer.capture();
+    ASSERT_EQ(dump.threads.size(), 1u);
+    ASSERT_EQ(dump.threads[0].events.size(), 2u);
+    EXPECT_EQ(dump.threads[0].events[0].phase, TracePhase::BEGIN);
+    EXPECT_EQ(dump.threads[0].events[1].phase, TracePhase::END);
+    EXPECT_LE(dump.threads[0].events[0].ns, dump.threads[0].events[1].ns);
+    EXPECT_GT(dump.threads[0].events[0].ns, 0u);
+}
+
+TEST(TraceRingTest, StagesAreIdempotentAndBounded) {
+    Tracer tracer;
+    EXPECT_EQ(tracer.add_stage("a"), 0);
+    EXPECT_EQ(tracer.add_stage("b"), 1);
+    EXPECT_EQ(tracer.add_stage("a"), 0);
+    for (int i = 2; i < Tracer::MAX_STAGES; ++i) {
+        EXPECT_EQ(tracer.add_stage("s" + std::to_string(i)), i);
+    }
+    EXPECT_EQ(tracer.add_stage("one too many"), Tracer::INVALID_STAGE);
+    EXPECT_EQ(tracer.add_stage("b"), 1);
+    EXPECT_EQ(tracer.capture().stages.size(), static_cast<size_t>(Tracer::MAX_STAGES));
+}
+
+TEST(TraceRingTest, ThreadRingsOutliveTheirThreads) {
+    Tracer tracer;
+    tracer.set_ring_events(16);
+    tracer.enable();
+    uint16_t stage = tracer.add_stage("work");
+
+    std::thread named([&] {
+        tracer.register_thread("worker");
+        for (uint64_t seq = 1; seq <= 100; ++seq) {
+            tracer.record(stage, TracePhase::INSTANT, seq);
+        }
+    });
+    named.join();
+    std::thread unnamed([&] { tracer.record(stage, TracePhase::INSTANT, 7); });
+    unnamed.join();
+    tracer.record(stage, TracePhase::INSTANT, 8);
+    tracer.record(stage, TracePhase::INSTANT, 9);
+
+    TraceDump dump = tracer.capture();
+    ASSERT_EQ(dump.threads.size(), 3u);
+    EXPECT_EQ(dump.threads[0].name, "worker");
+    ASSERT_EQ(dump.threads[0].events.size(), 15u);
+    EXPECT_EQ(dump.threads[0].events.back().seq, 100u);
+    EXPECT_EQ(dump.threads[1].name, "thread-2");
+    EXPECT_EQ(dump.threads[1].events.size(), 1u);
+    EXPECT_EQ(dump.threads[2].events.size(), 2u);
+    EXPECT_EQ(dump.threads[2].id, 3u);
+
+    // A second tracer on the same thread gets a ring of its own
+    Tracer other;
+    other.enable();
+    other.record(other.add_stage("x"), TracePhase::INSTANT, 1);
+    EXPECT_EQ(other.capture().threads.size(), 1u);
+    tracer.record(stage, TracePhase::INSTANT, 10);
+    EXPECT_EQ(tracer.capture().threads[2].events.size(), 3u);
+}
+
+TEST(TraceRingTest, SavedTraceLoadsBack) {
+    Tracer tracer;
+    tracer.enable();
+    uint16_t outer = tracer.add_stage("outer");
+    tracer.record(tracer.add_stage("mark"), TracePhase::INSTANT, 43);
+    tracer.record(outer, TracePhase::BEGIN, 42);
+    tracer.record(outer, TracePhase::END, 42);
+
+    TraceDump dump = tracer.capture();
+    std::string path = temp_path("trace_roundtrip.bin");
+    ASSERT_TRUE(dump.save(path));
+
+    TraceDump loaded;
+    ASSERT_TRUE(TraceDump::load(path, loaded));
+    EXPECT_EQ(loaded.stages, dump.stages);
+    ASSERT_EQ(loaded.threads.size(), 1u);
+    ASSERT_EQ(loaded.threads[0].events.size(), 3u);
+    for (size_t i = 0; i < 3; ++i) {
+        const TraceDump::Event& a = dump.threads[0].events[i];
+        const TraceDump::Event& b = loaded.threads[0].events[i];
+        EXPECT_EQ(a.ns, b.ns);
+        EXPECT_EQ(a.seq, b.seq);
+        EXPECT_EQ(a.stage, b.stage);
+        EXPECT_EQ(a.phase, b.phase);
+    }
+    EXPECT_EQ(loaded.threads[0].events[0].stage, 1);
+
+    // Truncated, bad magic, out-of-range stage
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::string corrupt = temp_path("trace_corrupt.bin");
+    auto rejects = [&](const std::string& content) {
+        std::ofstream(corrupt, std::ios::binary) << content;
+        TraceDump kept = loaded;
+        bool ok = TraceDump::load(corrupt, kept);
+        EXPECT_EQ(kept.stages, loaded.stages);  // Untouched on failure
+        return !ok;
+    };
+    EXPECT_TRUE(rejects(bytes.substr(0, bytes.size() - 1)));
+    std::string magic = bytes;
+    magic[0] = 'X';
+    EXPECT_TRUE(rejects(magic));
+    std::string stage = bytes;
+    stage[bytes.size() - 24 + 16] = 9;  // Last event's stage
+    EXPECT_TRUE(rejects(stage));
+    EXPECT_FALSE(TraceDump::load(temp_path("trace_absent.bin"), loaded));
+    std::remove(path.c_str());
+    std::remove(corrupt.c_str());
+}
+
+TEST(TraceRingTest, WritesChromeTraceWithFlows) {
+    TraceDump dump;
+    dump.stages = {"feed.inject", "feed.parse", "mark"};
+    TraceDump::Thread producer;
+    producer.id = 1;
+    producer.name = "main";
+    producer.events = {
+        event(1000, 0, TracePhase::END, 4),    // BEGIN was overwritten
+        event(2000, 0, TracePhase::BEGIN, 5),
+        event(2500, 0, TracePhase::END, 5),
+        event(3000, 0, TracePhase::BEGIN, 6),
+        event(3400, 0, TracePhase::END, 6),
+    };
+    TraceDump::Thread parser;
+    parser.id = 2;
+    parser.name = "parser \"p\"";
+    parser.events = {
+        event(4000, 1, TracePhase::BEGIN, 5),
+        event(4100, 2, TracePhase::INSTANT, 5),
+        event(5500, 1, TracePhase::END, 5),
+    };
+    dump.threads = {producer, parser};
+
+    std::ostringstream out;
+    dump.write_chrome_json(out);
+    std::string json = out.str();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"otherData\":{\"start_unix_ns\":1000}", 0), 0u);
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+    EXPECT_NE(json.find("\"name\":\"thread_name\",\"args\":{\"name\":\"parser \\\"p\\\"\"}"), std::string::npos);
+    EXPECT_EQ(count(json, "\"ph\":\"B\""), 3u);
+    EXPECT_EQ(count(json, "\"ph\":\"E\""), 3u);  // Orphan END dropped
+    EXPECT_NE(json.find("{\"ph\":\"B\",\"pid\":1,\"tid\":1,\"name\":\"feed.inject\",\"ts\":1.000,\"args\":{\"seq\":5}}"),
+              std::string::npos);
+    EXPECT_NE(json.find("{\"ph\":\"i\",\"pid\":1,\"tid\":2,\"name\":\"mark\",\"ts\":3.100,\"s\":\"t\""),
+              std::string::npos);
+
+    // Message 5 crossed threads; 6 stayed on one
+    EXPECT_NE(json.find("{\"ph\":\"s\",\"pid\":1,\"tid\":1,\"name\":\"message\",\"cat\":\"message\",\"id\":5,\"ts\":1.000}"),
+              std::string::npos);
+    EXPECT_NE(json.find("{\"ph\":\"f\",\"pid\":1,\"tid\":2,\"name\":\"message\",\"cat\":\"message\",\"id\":5,"
+                        "\"ts\":3.000,\"bp\":\"e\"}"),
+              std::string::npos);
+    EXPECT_EQ(count(json, "\"cat\":\"message\""), 2u);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "parser/trade_json_parser.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::parser;
+
+namespace {
+
+const std::string TRADE =
+    R"({"e":"trade","E":1672515782136,"s":"BTCUSDT","t":12345,"p":"16541.25000000",)"
+    R"("q":"0.00150000","b":88,"a":50,"T":1672515782136,"m":true,"M":true})";
+
+} // namespace
+
+TEST(TradeJsonParserTest, DecodesBinanceTrade) {
+    TradeJsonParser::Config config;
+    config.qty_scale = 100000000;  // Satoshis
+    TradeJsonParser parser(config);
+
+    common::Tick tick;
+    ASSERT_TRUE(parser.parse(TRADE, tick, 42));
+    EXPECT_EQ(tick.symbol, "BTCUSDT");
+    EXPECT_EQ(tick.price, 165412500);
+    EXPECT_EQ(tick.qty, 150000);
+    EXPECT_EQ(tick.side, 'S');  // Buyer was the maker: a seller took the bid
+    EXPECT_EQ(tick.timestamp, 42u);
+    EXPECT_EQ(tick.instrument_id, common::SymbolTable::global().find("BTCUSDT"));
+
+    // The tick owns its symbol: the payload can go
+    std::string payload = TRADE;
+    ASSERT_TRUE(parser.parse(payload, tick));
+    payload.assign(payload.size(), 'x');
+    EXPECT_EQ(tick.symbol, "BTCUSDT");
+    EXPECT_GT(tick.timestamp, 0u);
+}
+
+TEST(TradeJsonParserTest, AggTradesWrappersAndWhitespace) {
+    TradeJsonParser parser;
+    std::vector<common::Tick> ticks;
+
+    EXPECT_EQ(parser.parse(R"({"stream":"ethusdt@aggTrade","data":{"e":"aggTrade","E":1,"s":"ETHUSDT",)"
+                           R"("a":7,"p":"1200.5","q":"3","f":1,"l":2,"T":1,"m":false,"M":true}})", ticks), 1u);
+    EXPECT_EQ(parser.parse("{ \"e\" : \"trade\",\n \"s\" : \"SOLUSDT\", \"p\" : \"10\", \"q\" : \"25\", "
+                           "\"m\" : false }", ticks), 1u);
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].symbol, "ETHUSDT");
+    EXPECT_EQ(ticks[0].price, 12005000);
+    EXPECT_EQ(ticks[0].qty, 3);
+    EXPECT_EQ(ticks[0].side, 'B');
+    EXPECT_EQ(ticks[1].symbol, "SOLUSDT");
+    EXPECT_EQ(ticks[1].qty, 25);
+}
+
+TEST(TradeJsonParserTest, RejectsWhatIsNotATrade) {
+    TradeJsonParser parser;
+    std::vector<common::Tick> ticks;
+    EXPECT_EQ(parser.parse(R"({"result":null,"id":1})", ticks), 0u);
+    EXPECT_EQ(parser.parse(R"({"e":"depthUpdate","s":"BTCUSDT","p":"1","q":"1","m":true})", ticks), 0u);
+    EXPECT_EQ(parser.parse(R"({"e":"trade","s":"BTCUSDT","p":"1","m":true})", ticks), 0u);  // No q
+    EXPECT_EQ(parser.parse(R"({"e":"trade","s":"BTCUSDT","p":"1","q":"1"})", ticks), 0u);   // No m
+    EXPECT_EQ(parser.parse(R"({"e":"trade","s":"BTC)", ticks), 0u);                         // Cut off
+    EXPECT_EQ(parser.parse("", ticks), 0u);
+    EXPECT_TRUE(ticks.empty());
+
+    // Escaped quotes inside an unrelated string do not derail the scan
+    EXPECT_EQ(parser.parse(R"({"x":"say \"s\":\"NO\"","e":"trade","s":"XRPUSDT","p":"0.5","q":"9","m":true})",
+                           ticks), 1u);
+    ASSERT_EQ(ticks.size(), 1u);
+    EXPECT_EQ(ticks[0].symbol, "XRPUSDT");
+
+    // Quantity that overflows Tick::qty at the configured scale
+    TradeJsonParser::Config config;
+    config.qty_scale = 100000000;
+    EXPECT_EQ(TradeJsonParser(config).parse(R"({"e":"trade","s":"BTCUSDT","p":"1","q":"50","m":true})", ticks), 0u);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "common/tsc_clock.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <thread>
+
+using namespace feedhandler::common;
+
+namespace {
+
+int64_t diff(uint64_t a, uint64_t b) {
+    return static_cast<int64_t>(a - b);
+}
+
+} // namespace
+
+TEST(TscClockTest, TracksRealtime) {
+    TscClock& clock = TscClock::global();
+    if (clock.uses_counter()) {
+        EXPECT_GT(clock.frequency_hz(), 1e6);
+    }
+
+    for (int i = 0; i < 5; ++i) {
+        uint64_t before = TscClock::realtime_ns();
+        uint64_t now = clock.now_ns();
+        uint64_t after = TscClock::realtime_ns();
+        // Within 100us of the kernel clock (calibration + read jitter)
+        EXPECT_GE(diff(now, before), -100000);
+        EXPECT_LE(diff(now, after), 100000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+TEST(TscClockTest, DurationsMatchSleep) {
+    TscClock& clock = TscClock::global();
+    uint64_t start_counter = TscClock::read_counter();
+    uint64_t start_real = TscClock::realtime_ns();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t elapsed = clock.ticks_to_ns(TscClock::read_counter() - start_counter);
+    uint64_t real = TscClock::realtime_ns() - start_real;
+
+    EXPECT_GE(elapsed, 20000000u);
+    EXPECT_LE(std::abs(diff(elapsed, real)), 200000);  // 1% of the window
+}
+
+TEST(TscClockTest, RecalibrationKeepsTimeContinuous) {
+    TscClock& clock = TscClock::global();
+    uint64_t before = clock.now_ns();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    clock.recalibrate();
+    uint64_t after = clock.now_ns();
+
+    EXPECT_GE(diff(after, before), 4000000);
+    EXPECT_LE(std::abs(diff(after, TscClock::realtime_ns())), 100000);
+}
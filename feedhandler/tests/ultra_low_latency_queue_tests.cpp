@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "threading/ultra_low_latency_queue.hpp"
+#include "common/tick.hpp"
+#include "common/zero_latency_allocator.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::threading;
+
+TEST(UltraLowLatencyQueueTest, SingleEnqueueDequeue) {
+    auto queue = std::make_unique<UltraLowLatencyQueue<uint64_t, 1024>>();
+    EXPECT_TRUE(queue->empty());
+    EXPECT_TRUE(queue->enqueue(7));
+    EXPECT_EQ(queue->size(), 1u);
+
+    uint64_t value = 0;
+    EXPECT_TRUE(queue->dequeue(value));
+    EXPECT_EQ(value, 7u);
+    EXPECT_FALSE(queue->dequeue(value));
+}
+
+TEST(UltraLowLatencyQueueTest, BulkStopsAtCapacity) {
+    auto queue = std::make_unique<UltraLowLatencyQueue<uint64_t, 1024>>();
+    std::vector<uint64_t> in(1500);
+    for (size_t i = 0; i < in.size(); ++i) {
+        in[i] = i;
+    }
+
+    // Usable capacity is Size - 1
+    EXPECT_EQ(queue->try_enqueue_bulk(in.data(), in.size()), 1023u);
+    EXPECT_EQ(queue->try_enqueue_bulk(in.data(), 1), 0u);
+    EXPECT_EQ(queue->size(), 1023u);
+
+    std::vector<uint64_t> out(600);
+    EXPECT_EQ(queue->try_dequeue_bulk(out.data(), out.size()), 600u);
+    EXPECT_EQ(out.front(), 0u);
+    EXPECT_EQ(out.back(), 599u);
+
+    // Wraps around the end of the ring
+    EXPECT_EQ(queue->try_enqueue_bulk(in.data() + 1023, 477), 477u);
+    std::vector<uint64_t> rest(2000);
+    EXPECT_EQ(queue->try_dequeue_bulk(rest.data(), rest.size()), 900u);
+    for (size_t i = 0; i < 900; ++i) {
+        ASSERT_EQ(rest[i], 600 + i);
+    }
+    EXPECT_EQ(queue->try_dequeue_bulk(rest.data(), rest.size()), 0u);
+}
+
+TEST(UltraLowLatencyQueueTest, ReserveAndPublishTick) {
+    auto queue = std::make_unique<UltraLowLatencyQueue<common::Tick, 1024>>();
+
+    common::Tick* slot = queue->reserve();
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(queue->reserve(), slot);  // Same slot until published
+    slot->copy_symbol("AAPL");
+    slot->price = common::double_to_price(150.25);
+    slot->qty = 100;
+    slot->side = 'B';
+
+    common::Tick out;
+    EXPECT_FALSE(queue->dequeue(out));  // Not visible before publish
+    queue->publish();
+
+    ASSERT_TRUE(queue->dequeue(out));
+    EXPECT_EQ(out.symbol, "AAPL");
+    EXPECT_EQ(out.price, common::double_to_price(150.25));
+    EXPECT_EQ(out.qty, 100);
+}
+
+TEST(UltraLowLatencyQueueTest, ReserveReturnsNullWhenFull) {
+    auto queue = std::make_unique<UltraLowLatencyQueue<uint64_t, 1024>>();
+    for (int i = 0; i < 1023; ++i) {
+        uint64_t* slot = queue->reserve();
+        ASSERT_NE(slot, nullptr);
+        *slot = i;
+        queue->publish();
+    }
+    EXPECT_EQ(queue->reserve(), nullptr);
+
+    uint64_t value = 0;
+    ASSERT_TRUE(queue->dequeue(value));
+    EXPECT_NE(queue->reserve(), nullptr);
+}
+
+TEST(UltraLowLatencyQueueTest, BulkHandoffAcrossThreads) {
+    constexpr uint64_t count = 100000;
+    auto queue = std::make_unique<UltraLowLatencyQueue<uint64_t, 1024>>();
+
+    std::thread producer([&queue] {
+        uint64_t batch[32];
+        uint64_t next = 0;
+        while (next < count) {
+            size_t n = 0;
+            while (n < 32 && next + n < count) {
+                batch[n] = next + n;
+                ++n;
+            }
+            size_t sent = 0;
+            while (sent < n) {
+                sent += queue->try_enqueue_bulk(batch + sent, n - sent);
+                if (sent < n) {
+                    std::this_thread::yield();
+                }
+            }
+            next += n;
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t batch[64];
+    while (expected < count) {
+        size_t n = queue->try_dequeue_bulk(batch, 64);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(batch[i], expected++);
+        }
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue->empty());
+}
+
+TEST(UltraLowLatencyQueueTest, ConstructedInsideArena) {
+    using Queue = UltraLowLatencyQueue<common::CompactTick, 1024>;
+    common::ZeroLatencyAllocator region(1 << 20, true, true);
+    auto arena = region.create_arena(sizeof(Queue) + 64);
+
+    Queue* queue = arena.create<Queue>();
+    ASSERT_NE(queue, nullptr);
+    EXPECT_TRUE(region.owns(queue));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(queue) % alignof(Queue), 0u);
+
+    common::CompactTick tick;
+    tick.qty = 9;
+    EXPECT_TRUE(queue->enqueue(tick));
+    common::CompactTick out;
+    ASSERT_TRUE(queue->dequeue(out));
+    EXPECT_EQ(out.qty, 9);
+
+    queue->~Queue();
+}
@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include "net/websocket_client.hpp"
+#include "net/websocket_frame.hpp"
+#include "parser/trade_json_parser.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace feedhandler;
+using namespace feedhandler::net;
+
+namespace {
+
+constexpr uint32_t KEY = 0x1BADF00D;
+
+std::vector<WebSocketFrameDecoder::Message> decode_all(WebSocketFrameDecoder& decoder, ReceiveBuffer& buffer,
+                                                       std::vector<std::string>& payloads) {
+    std::vector<WebSocketFrameDecoder::Message> messages;
+    WebSocketFrameDecoder::Message message;
+    while (decoder.next(buffer, message)) {
+        messages.push_back(message);
+        payloads.emplace_back(message.payload);
+    }
+    return messages;
+}
+
+// Continuation-capable frame builder: ws_encode_frame only writes final frames
+std::string fragment(WsOpcode opcode, std::string_view payload, bool fin, uint32_t key) {
+    std::string frame;
+    ws_encode_frame(frame, opcode, payload, key);
+    if (!fin) {
+        frame[0] = static_cast<char>(frame[0] & 0x7F);
+    }
+    return frame;
+}
+
+// Loopback WebSocket server: accepts one peer, answers the upgrade
+class LoopbackServer {
+public:
+    LoopbackServer() {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_fd_, 1);
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+
+    ~LoopbackServer() {
+        if (peer_fd_ >= 0) {
+            ::close(peer_fd_);
+        }
+        ::close(listen_fd_);
+    }
+
+    int port() const { return port_; }
+    void accept_peer() { peer_fd_ = ::accept(listen_fd_, nullptr, nullptr); }
+
+    // Bytes up to and including the first "\r\n\r\n"
+    std::string read_request() {
+        std::string request;
+        char c;
+        while (request.find("\r\n\r\n") == std::string::npos && ::recv(peer_fd_, &c, 1, 0) == 1) {
+            request.push_back(c);
+        }
+        return request;
+    }
+
+    std::string read_exactly(size_t length) {
+        std::string out(length, '\0');
+        size_t got = 0;
+        while (got < length) {
+            ssize_t n = ::recv(peer_fd_, out.data() + got, length - got, 0);
+            if (n <= 0) {
+                break;
+            }
+            got += static_cast<size_t>(n);
+        }
+        out.resize(got);
+        return out;
+    }
+
+    void send(const std::string& data) {
+        ASSERT_EQ(::send(peer_fd_, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+    }
+
+private:
+    int listen_fd_ = -1;
+    int peer_fd_ = -1;
+    int port_ = 0;
+};
+
+} // namespace
+
+TEST(WebSocketFrameTest, SimdUnmaskMatchesScalar) {
+    for (size_t length : {0u, 1u, 3u, 15u, 16u, 17u, 64u, 1000u}) {
+        for (size_t offset = 0; offset < 4; ++offset) {
+            std::string payload(length, '\0');
+            for (size_t i = 0; i < length; ++i) {
+                payload[i] = static_cast<char>(i * 31 + 7);
+            }
+            std::string simd = payload;
+            std::string scalar = payload;
+            ws_unmask(simd.data(), length, KEY, offset);
+            ws_unmask_scalar(scalar.data(), length, KEY, offset);
+            EXPECT_EQ(simd, scalar) << length << " at " << offset;
+            ws_unmask(simd.data(), length, KEY, offset);
+            EXPECT_EQ(simd, payload);
+        }
+    }
+}
+
+TEST(WebSocketFrameTest, DecodesEveryLengthEncodingInPlace) {
+    ReceiveBuffer buffer;
+    WebSocketFrameDecoder decoder;
+    const std::string small = "{\"e\":\"trade\"}";
+    const std::string medium(300, 'm');    // 16-bit length
+    const std::string large(70000, 'l');   // 64-bit length, needs a bigger buffer
+    std::string wire;
+    ws_encode_frame(wire, WsOpcode::TEXT, small);
+    ws_encode_frame(wire, WsOpcode::BINARY, medium, KEY);
+    ASSERT_EQ(buffer.write(wire.data(), wire.size()), wire.size());
+
+    std::vector<std::string> payloads;
+    auto messages = decode_all(decoder, buffer, payloads);
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0].opcode, WsOpcode::TEXT);
+    EXPECT_EQ(payloads[0], small);
+    EXPECT_EQ(messages[1].opcode, WsOpcode::BINARY);
+    EXPECT_EQ(payloads[1], medium);  // Unmasked
+    EXPECT_EQ(decoder.messages(), 2u);
+
+    // The view is the buffer itself: no copy out
+    wire.clear();
+    ws_encode_frame(wire, WsOpcode::TEXT, small, KEY);
+    ASSERT_EQ(buffer.write(wire.data(), wire.size()), wire.size());
+    WebSocketFrameDecoder::Message message;
+    ASSERT_TRUE(decoder.next(buffer, message));
+    EXPECT_GE(message.payload.data(), buffer.read_ptr());
+    EXPECT_LE(message.payload.data() + message.payload.size(), buffer.read_ptr() + buffer.readable_bytes());
+    EXPECT_EQ(message.payload, small);
+
+    ReceiveBufferConfig config;
+    config.capacity = 128 * 1024;
+    ReceiveBuffer big(config);
+    WebSocketFrameDecoder big_decoder;
+    wire.clear();
+    ws_encode_frame(wire, WsOpcode::BINARY, large, KEY);
+    ASSERT_EQ(big.write(wire.data(), wire.size()), wire.size());
+    payloads.clear();
+    ASSERT_EQ(decode_all(big_decoder, big, payloads).size(), 1u);
+    EXPECT_EQ(payloads[0], large);
+}
+
+TEST(WebSocketFrameTest, ReassemblesFragmentsAroundControlFrames) {
+    std::string wire = fragment(WsOpcode::TEXT, "{\"e\":\"tr", false, KEY);
+    wire += fragment(WsOpcode::PING, "are you there", true, KEY);
+    wire += fragment(WsOpcode::CONTINUATION, "ade\",\"s\":", false, 0);
+    wire += fragment(WsOpcode::CONTINUATION, "\"BTCUSDT\"}", true, KEY);
+    wire += fragment(WsOpcode::TEXT, "next", true, 0);
+
+    // Byte at a time: nothing may be decoded twice or skipped
+    ReceiveBuffer buffer;
+    WebSocketFrameDecoder decoder;
+    std::vector<std::string> payloads;
+    std::vector<WsOpcode> opcodes;
+    for (char c : wire) {
+        ASSERT_EQ(buffer.write(&c, 1), 1u);
+        WebSocketFrameDecoder::Message message;
+        while (decoder.next(buffer, message)) {
+            opcodes.push_back(message.opcode);
+            payloads.emplace_back(message.payload);
+        }
+    }
+    ASSERT_EQ(payloads.size(), 3u);
+    EXPECT_EQ(opcodes[0], WsOpcode::PING);
+    EXPECT_EQ(payloads[0], "are you there");
+    EXPECT_EQ(opcodes[1], WsOpcode::TEXT);
+    EXPECT_EQ(payloads[1], "{\"e\":\"trade\",\"s\":\"BTCUSDT\"}");
+    EXPECT_EQ(payloads[2], "next");
+    EXPECT_EQ(decoder.frames(), 5u);
+
+    // Everything is consumed once the caller comes back
+    WebSocketFrameDecoder::Message message;
+    EXPECT_FALSE(decoder.next(buffer, message));
+    EXPECT_EQ(buffer.readable_bytes(), 0u);
+}
+
+TEST(WebSocketFrameTest, ProtocolErrorsStopTheDecoder) {
+    auto status_of = [](const std::string& wire, size_t max_message = 1 << 20) {
+        ReceiveBuffer buffer;
+        WebSocketDecoderConfig config;
+        config.max_message_bytes = max_message;
+        WebSocketFrameDecoder decoder(config);
+        buffer.write(wire.data(), wire.size());
+        WebSocketFrameDecoder::Message message;
+        while (decoder.next(buffer, message)) {
+        }
+        return decoder.status();
+    };
+    using Status = WebSocketFrameDecoder::Status;
+
+    EXPECT_EQ(status_of(fragment(WsOpcode::TEXT, "ok", true, 0)), Status::OK);
+    EXPECT_EQ(status_of(fragment(WsOpcode::CONTINUATION, "orphan", true, 0)), Status::PROTOCOL_ERROR);
+    EXPECT_EQ(status_of(fragment(WsOpcode::TEXT, "a", false, 0) + fragment(WsOpcode::TEXT, "b", true, 0)),
+              Status::PROTOCOL_ERROR);
+    EXPECT_EQ(status_of(fragment(WsOpcode::PING, "x", false, 0)), Status::PROTOCOL_ERROR);
+    EXPECT_EQ(status_of(fragment(WsOpcode::PING, std::string(126, 'p'), true, 0)), Status::PROTOCOL_ERROR);
+    std::string reserved = fragment(WsOpcode::TEXT, "rsv", true, 0);
+    reserved[0] = static_cast<char>(reserved[0] | 0x40);
+    EXPECT_EQ(status_of(reserved), Status::PROTOCOL_ERROR);
+    EXPECT_EQ(status_of(fragment(WsOpcode::TEXT, std::string(100, 'b'), true, 0), 64), Status::MESSAGE_TOO_BIG);
+
+    // A frame that can never fit in the receive buffer
+    std::string huge;
+    ws_encode_frame(huge, WsOpcode::BINARY, std::string(ReceiveBufferConfig{}.capacity * 2, 'h'));
+    EXPECT_EQ(status_of(huge.substr(0, 100)), Status::MESSAGE_TOO_BIG);
+}
+
+TEST(WebSocketClientTest, UpgradesAnswersPingsAndDecodesTrades) {
+    LoopbackServer server;
+    WebSocketClient client;
+    ASSERT_TRUE(client.connect_to_feed("/ws/btcusdt@trade", "127.0.0.1", server.port()));
+    server.accept_peer();
+    ASSERT_TRUE(client.send_handshake());
+
+    std::string request = server.read_request();
+    EXPECT_EQ(request.rfind("GET /ws/btcusdt@trade HTTP/1.1\r\n", 0), 0u);
+    EXPECT_NE(request.find("Host: 127.0.0.1:" + std::to_string(server.port())), std::string::npos);
+    EXPECT_NE(request.find("Sec-WebSocket-Key: "), std::string::npos);
+
+    // Upgrade response and the first frames in one segment
+    std::string wire = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n\r\n";
+    ws_encode_frame(wire, WsOpcode::PING, "hb");
+    ws_encode_frame(wire, WsOpcode::TEXT,
+                    R"({"e":"trade","s":"BTCUSDT","p":"16541.25","q":"2","m":false})");
+    ws_encode_frame(wire, WsOpcode::TEXT, R"({"result":null,"id":1})");
+    ws_encode_frame(wire, WsOpcode::TEXT, R"({"e":"trade","s":"BTCUSDT","p":"16541.00","q":"1","m":true})");
+    server.send(wire);
+
+    parser::TradeJsonParser parser;
+    std::vector<common::Tick> ticks;
+    while (ticks.size() < 2 && client.is_connected()) {
+        client.read_trades(parser, ticks);
+    }
+    EXPECT_TRUE(client.is_upgraded());
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].price, 165412500);
+    EXPECT_EQ(ticks[0].side, 'B');
+    EXPECT_EQ(ticks[1].side, 'S');
+
+    // The pong echoes the ping payload, masked as a client frame must be
+    std::string pong = server.read_exactly(2 + 4 + 2);
+    ASSERT_EQ(pong.size(), 8u);
+    EXPECT_EQ(static_cast<unsigned char>(pong[0]), 0x8A);
+    EXPECT_EQ(static_cast<unsigned char>(pong[1]), 0x82);
+    uint32_t key;
+    std::memcpy(&key, pong.data() + 2, 4);
+    std::string payload = pong.substr(6);
+    ws_unmask(payload.data(), payload.size(), key);
+    EXPECT_EQ(payload, "hb");
+
+    // Subscriptions go out masked too
+    ASSERT_TRUE(client.send_text(R"({"method":"SUBSCRIBE"})"));
+    std::string frame = server.read_exactly(2 + 4 + 22);
+    ASSERT_EQ(frame.size(), 28u);
+    std::memcpy(&key, frame.data() + 2, 4);
+    payload = frame.substr(6);
+    ws_unmask(payload.data(), payload.size(), key);
+    EXPECT_EQ(payload, R"({"method":"SUBSCRIBE"})");
+
+    // A close frame is echoed and ends the session
+    wire.clear();
+    ws_encode_frame(wire, WsOpcode::CLOSE, std::string("\x03\xe8", 2));
+    server.send(wire);
+    while (client.is_connected()) {
+        client.poll(nullptr);
+    }
+    std::string close = server.read_exactly(2 + 4 + 2);
+    ASSERT_EQ(close.size(), 8u);
+    EXPECT_EQ(static_cast<unsigned char>(close[0]), 0x88);
+}
+
+TEST(WebSocketClientTest, RefusedUpgradeCloses) {
+    LoopbackServer server;
+    WebSocketClient client;
+    ASSERT_TRUE(client.connect_to_feed("/", "127.0.0.1", server.port()));
+    server.accept_peer();
+    ASSERT_TRUE(client.send_handshake());
+    server.read_request();
+    server.send("HTTP/1.1 403 Forbidden\r\nContent-Length: 0\r\n\r\n");
+    EXPECT_EQ(client.recv_data(), "");
+    EXPECT_FALSE(client.is_connected());
+    EXPECT_FALSE(client.is_upgraded());
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "distributed/wire_protocol.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace feedhandler::distributed;
+
+TEST(WireProtocolTest, FramesRoundTripInPlaceAndAligned) {
+    FrameWriter writer(node_hash("node-a"));
+    HeartbeatMessage heartbeat{123, 0.5, 2048, 10000, 7, 1};
+    writer.append(MessageType::HEARTBEAT, heartbeat);
+    writer.append(MessageType::APPLICATION, "abc", 3);
+    writer.append(MessageType::APPLICATION, nullptr, 0);
+    ASSERT_EQ(writer.frame_count(), 3u);
+    EXPECT_EQ(writer.size(), frame_size(sizeof(HeartbeatMessage)) + frame_size(3) + frame_size(0));
+    EXPECT_EQ(writer.size() % FRAME_ALIGNMENT, 0u);
+
+    std::vector<Frame> frames;
+    size_t consumed = for_each_frame(writer.data(), writer.size(), [&](const Frame& frame) { frames.push_back(frame); });
+    EXPECT_EQ(consumed, writer.size());
+    ASSERT_EQ(frames.size(), 3u);
+
+    const HeartbeatMessage* decoded = frames[0].as<HeartbeatMessage>();
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(static_cast<const void*>(decoded), static_cast<const void*>(writer.data() + sizeof(FrameHeader)));
+    EXPECT_EQ(decoded->memory_usage_mb, 2048u);
+    EXPECT_EQ(decoded->assigned_symbols, 7u);
+    EXPECT_EQ(frames[0].header->sender, node_hash("node-a"));
+
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(frames[1].payload), frames[1].size()), "abc");
+    EXPECT_EQ(frames[1].as<HeartbeatMessage>(), nullptr);  // Too short
+    EXPECT_EQ(frames[2].header->sequence, 2u);
+}
+
+TEST(WireProtocolTest, PartialFramesWaitForMoreBytes) {
+    FrameWriter writer;
+    writer.append(MessageType::APPLICATION, "first", 5);
+    writer.append(MessageType::APPLICATION, "second", 6);
+
+    size_t first = frame_size(5);
+    size_t seen = 0;
+    auto count = [&](const Frame&) { seen++; };
+    EXPECT_EQ(for_each_frame(writer.data(), sizeof(FrameHeader) - 1, count), 0u);
+    EXPECT_EQ(for_each_frame(writer.data(), first + 10, count), first);
+    EXPECT_EQ(seen, 1u);
+    EXPECT_EQ(for_each_frame(writer.data() + first, writer.size() - first, count), writer.size() - first);
+    EXPECT_EQ(seen, 2u);
+
+    FrameHeader corrupt{static_cast<uint32_t>(MAX_FRAME_PAYLOAD + 1), 0x100, 0, 0, 0};
+    EXPECT_EQ(for_each_frame(reinterpret_cast<const uint8_t*>(&corrupt), sizeof(corrupt), count), SIZE_MAX);
+}
+
+TEST(WireProtocolTest, WriterReusesItsBufferAfterClear) {
+    FrameWriter writer;
+    for (int i = 0; i < 100; ++i) {
+        writer.append(MessageType::APPLICATION, &i, sizeof(i));
+    }
+    const uint8_t* storage = writer.data();
+    writer.clear();
+    EXPECT_TRUE(writer.empty());
+    writer.append(MessageType::APPLICATION, "x", 1);
+    EXPECT_EQ(writer.data(), storage);
+    EXPECT_EQ(writer.size(), frame_size(1));
+}
+
+TEST(WireProtocolTest, WorkloadAssignmentDecodesWithoutCopies) {
+    FrameWriter writer;
+    const std::vector<std::string> symbols = {"AAPL", "MSFT", "", "SPY"};
+    write_workload_assignment(writer, symbols);
+
+    std::vector<std::string> decoded;
+    for_each_frame(writer.data(), writer.size(), [&](const Frame& frame) {
+        WorkloadAssignmentView view(frame);
+        ASSERT_TRUE(view.valid());
+        for (size_t i = 0; i < view.size(); ++i) {
+            decoded.emplace_back(view.symbol(i));
+        }
+    });
+    EXPECT_EQ(decoded, symbols);
+
+    // Offsets past the names are rejected
+    FrameWriter bad;
+    uint32_t* payload = reinterpret_cast<uint32_t*>(bad.begin_frame(MessageType::WORKLOAD_ASSIGNMENT, 12));
+    payload[0] = 1;
+    payload[1] = 0;
+    payload[2] = 50;
+    for_each_frame(bad.data(), bad.size(), [](const Frame& frame) { EXPECT_FALSE(WorkloadAssignmentView(frame).valid()); });
+}
+
+TEST(WireProtocolTest, SymbolRatesDecodeInPlace) {
+    FrameWriter writer;
+    const std::vector<std::pair<std::string, double>> rates = {{"SPY", 12000.5}, {"AAPL", 310.0}, {"X", 0.0}};
+    write_symbol_rates(writer, rates);
+
+    std::vector<std::pair<std::string, double>> decoded;
+    for_each_frame(writer.data(), writer.size(), [&](const Frame& frame) {
+        SymbolRatesView view(frame);
+        ASSERT_TRUE(view.valid());
+        EXPECT_FALSE(WorkloadAssignmentView(frame).valid());
+        for (size_t i = 0; i < view.size(); ++i) {
+            decoded.emplace_back(std::string(view.symbol(i)), view.rate(i));
+        }
+    });
+    EXPECT_EQ(decoded, rates);
+
+    // A count past the payload is rejected
+    FrameWriter bad;
+    uint32_t* payload = reinterpret_cast<uint32_t*>(bad.begin_frame(MessageType::SYMBOL_RATES, 16));
+    payload[0] = 1000;
+    for_each_frame(bad.data(), bad.size(), [](const Frame& frame) { EXPECT_FALSE(SymbolRatesView(frame).valid()); });
+}
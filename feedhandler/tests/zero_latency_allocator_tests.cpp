@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "common/zero_latency_allocator.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace feedhandler::common;
+
+TEST(ZeroLatencyArenaTest, CarvedFromRegion) {
+    ZeroLatencyAllocator region(1 << 20);
+    auto arena = region.create_arena(1000);
+
+    ASSERT_TRUE(arena.valid());
+    EXPECT_EQ(arena.capacity(), 1024u);  // Rounded to a cache line
+    EXPECT_EQ(region.get_stats().allocated_size, 1024u);
+
+    void* p = arena.allocate(100, 64);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+    EXPECT_TRUE(arena.owns(p));
+    EXPECT_TRUE(region.owns(p));
+
+    // Arena allocations do not touch the shared region counters
+    EXPECT_EQ(region.get_stats().allocation_count, 1u);
+}
+
+TEST(ZeroLatencyArenaTest, ExhaustionReturnsNull) {
+    ZeroLatencyAllocator region(1 << 20);
+    auto arena = region.create_arena(128);
+    EXPECT_NE(arena.allocate(100), nullptr);
+    EXPECT_EQ(arena.allocate(100), nullptr);
+
+    ZeroLatencyAllocator tiny(4096);
+    EXPECT_FALSE(tiny.create_arena(8192).valid());
+}
+
+TEST(ZeroLatencyArenaTest, ScopeRollsBack) {
+    ZeroLatencyAllocator region(1 << 20);
+    auto arena = region.create_arena(4096);
+
+    void* outer = arena.allocate(64);
+    size_t used = arena.used();
+
+    void* first_inner = nullptr;
+    {
+        ArenaScope scope(arena);
+        first_inner = arena.allocate(256);
+        arena.allocate(512);
+        EXPECT_GT(arena.used(), used);
+        EXPECT_EQ(arena.allocation_count(), 3u);
+    }
+    EXPECT_EQ(arena.used(), used);
+    EXPECT_EQ(arena.allocation_count(), 1u);
+
+    // Space is reused by the next scope
+    {
+        ArenaScope scope(arena);
+        EXPECT_EQ(arena.allocate(256), first_inner);
+    }
+    EXPECT_NE(outer, nullptr);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+}
+
+TEST(ZeroLatencyArenaTest, NestedCheckpoints) {
+    ZeroLatencyAllocator region(1 << 20);
+    auto arena = region.create_arena(4096);
+
+    auto batch = arena.checkpoint();
+    arena.allocate(100);
+    auto message = arena.checkpoint();
+    arena.allocate(100);
+    arena.rollback(message);
+    EXPECT_EQ(arena.used(), message.offset);
+    arena.rollback(batch);
+    EXPECT_EQ(arena.used(), 0u);
+}
+
+TEST(ZeroLatencyArenaTest, StlContainerInScope) {
+    ZeroLatencyAllocator region(1 << 20);
+    auto arena = region.create_arena(64 * 1024);
+
+    for (int message = 0; message < 100; ++message) {
+        ArenaScope scope(arena);
+        std::vector<int, ArenaSTLAllocator<int>> values{ArenaSTLAllocator<int>(arena)};
+        for (int i = 0; i < 500; ++i) {
+            values.push_back(i);
+        }
+        EXPECT_EQ(values.back(), 499);
+    }
+    // Nothing leaked across messages
+    EXPECT_EQ(arena.used(), 0u);
+}
+
+TEST(ZeroLatencyArenaTest, OneArenaPerThread) {
+    ZeroLatencyAllocator region(1 << 22);
+    std::vector<std::thread> threads;
+    std::vector<int> ok(4, 0);
+
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&region, &ok, t] {
+            auto arena = region.create_arena(256 * 1024);
+            bool all_owned = arena.valid();
+            for (int i = 0; i < 1000 && all_owned; ++i) {
+                ArenaScope scope(arena);
+                void* p = arena.allocate(128);
+                all_owned = p && arena.owns(p);
+            }
+            ok[t] = all_owned ? 1 : 0;
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(ok, std::vector<int>(4, 1));
+}
+
+TEST(ZeroLatencyAllocatorTest, PagePolicyFromConfig) {
+    feedhandler::config::PerformanceConfig::MemoryConfig memory;
+    memory.zero_latency_pool_size = 1 << 20;
+    memory.enable_huge_pages = false;
+    memory.prefault_memory = false;
+
+    ZeroLatencyAllocator region(memory);
+    EXPECT_FALSE(region.huge_pages());
+    EXPECT_FALSE(region.prefaulted());
+    EXPECT_EQ(region.get_stats().total_size, 1u << 20);
+    EXPECT_NE(region.allocate(64), nullptr);
+
+    ZeroLatencyAllocator prefaulted(1 << 20, false, true);
+    EXPECT_TRUE(prefaulted.prefaulted());
+}
@@ -0,0 +1,584 @@
+// Google Benchmark suite for the order books under realistic update flow
+// Compares: OrderBook (MAP and ARRAY ladders), L3OrderBook and
+// OrderBookHandler (L2 level updates and L3 order events) over the same
+// generated streams, so the numbers can be compared across implementations
+//
+// Streams come out of one order-level generator, seeded, so every run
+// replays the same events:
+//   - placement: 80% of new orders land a geometric number of ticks
+//     (p = 0.25) from their side's touch, the rest anywhere in the
+//     500 ticks behind it; 5% improve the spread by a tick when it is open
+//   - cancels and modifies pick a level the same way (p = 0.3) and a
+//     random order in it, so the touch churns most
+//   - the mix (REALISTIC) is 40% adds, 40% cancels, 14% modifies and 6%
+//     executions against the front of the touch: cancels outnumber trades
+//     roughly 7:1, and levels come and go as their last order leaves
+//   - each side holds between 1000 and 4000 live orders (2000 to start,
+//     a few hundred levels deep)
+// The L2 views (BookUpdate-style add/modify/delete, FIX 279 level updates)
+// are the same events aggregated per level. A stream that runs out is
+// restarted from the starting book with the timer paused.
+//
+// Per implementation: add, modify and cancel streams on their own, the
+// mixed replay, top-N reads (cache and get_depth) and deep snapshot loads.
+// The ladder argument selects MAP (0) or ARRAY (1).
+
+#include <benchmark/benchmark.h>
+#include "orderbook/order_book.hpp"
+#include "orderbook/l3_order_book.hpp"
+#include "orderbook/event_handler.hpp"
+#include "orderbook/market_event.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+constexpr int64_t TICK = 100;                 // 0.01 at the default price scale
+constexpr int64_t REFERENCE_PRICE = 1000000;  // 100.00
+constexpr size_t ORDERS_PER_SIDE = 2000;
+constexpr size_t REPLAY_EVENTS = 1 << 16;
+constexpr size_t EXPECTED_ORDERS = 4 * ORDERS_PER_SIDE * 2;
+constexpr const char* SYMBOL = "BENCH";
+
+struct Mix {
+    double add;
+    double modify;
+    double cancel;
+    double execute;
+};
+
+constexpr Mix REALISTIC{0.40, 0.14, 0.40, 0.06};
+constexpr Mix ADDS{1.0, 0.0, 0.0, 0.0};
+constexpr Mix MODIFIES{0.0, 1.0, 0.0, 0.0};
+constexpr Mix CANCELS{0.0, 0.0, 1.0, 0.0};
+
+struct OrderEvent {
+    enum class Type : uint8_t { ADD, MODIFY, CANCEL, EXECUTE };
+
+    Type type;
+    Side side;
+    uint64_t order_id;
+    int64_t price;
+    int64_t quantity;      // ADD: size, MODIFY: new size, CANCEL: size left, EXECUTE: filled
+    int64_t remaining;     // Order size after the event, 0 once it left the book
+    int64_t level_before;  // Level total before and after, for the L2 views
+    int64_t level_after;
+};
+
+struct Workload {
+    std::vector<OrderEvent> initial;  // Adds that build the starting book
+    std::vector<OrderEvent> events;
+    std::vector<PriceLevel> bids;     // Starting book, best first
+    std::vector<PriceLevel> asks;
+};
+
+// Order-level book model the streams are drawn from
+class Generator {
+public:
+    explicit Generator(uint64_t seed) : rng_(seed) {}
+
+    void add(Side side, std::vector<OrderEvent>& out) {
+        int64_t price = place(side);
+        int64_t quantity = lot();
+        Level& level = levels(side)[key(side, price)];
+        level.price = price;
+        uint64_t id = next_id_++;
+        out.push_back({OrderEvent::Type::ADD, side, id, price, quantity, quantity, level.total, level.total + quantity});
+        level.total += quantity;
+        level.queue.push_back(id);
+        orders_[id] = Resting{side, price, quantity};
+        ++live_[index(side)];
+    }
+
+    /**
+     * @return false if the mix only removes (or only adds) and the side
+     *         reached its bound, which ends the stream
+     */
+    bool step(const Mix& mix, std::vector<OrderEvent>& out) {
+        Side side = coin_(rng_) ? Side::BID : Side::ASK;
+        double roll = unit_(rng_) * (mix.add + mix.modify + mix.cancel + mix.execute);
+        bool adding = roll < mix.add;
+        bool removing = !adding && roll >= mix.add + mix.modify;
+        size_t live = live_[index(side)];
+        if (removing && live <= ORDERS_PER_SIDE / 2) {
+            if (mix.add == 0.0) {
+                return false;
+            }
+            adding = true;
+            removing = false;
+        } else if (adding && live >= ORDERS_PER_SIDE * 2) {
+            if (mix.cancel == 0.0) {
+                return false;
+            }
+            adding = false;
+            removing = true;
+            roll = mix.add + mix.modify;  // Cancel
+        }
+
+        if (adding) {
+            add(side, out);
+        } else if (!removing) {
+            modify(side, out);
+        } else if (roll < mix.add + mix.modify + mix.cancel) {
+            cancel(side, out);
+        } else {
+            execute(side, out);
+        }
+        return true;
+    }
+
+    void levels_of(Side side, std::vector<PriceLevel>& out) const {
+        const auto& side_levels = levels(side);
+        for (const auto& [_, level] : side_levels) {
+            out.emplace_back(level.price, level.total, static_cast<uint32_t>(level.queue.size()));
+        }
+    }
+
+    size_t live(Side side) const { return live_[index(side)]; }
+
+private:
+    struct Level {
+        int64_t price = 0;
+        int64_t total = 0;
+        std::vector<uint64_t> queue;  // Oldest first
+    };
+    struct Resting {
+        Side side;
+        int64_t price;
+        int64_t quantity;
+    };
+    // Keyed so both sides iterate best first
+    using Levels = std::map<int64_t, Level>;
+
+    std::mt19937_64 rng_;
+    std::uniform_int_distribution<int> coin_{0, 1};
+    std::uniform_real_distribution<double> unit_{0.0, 1.0};
+    Levels bids_;
+    Levels asks_;
+    std::unordered_map<uint64_t, Resting> orders_;
+    size_t live_[2] = {0, 0};
+    uint64_t next_id_ = 1;
+
+    static size_t index(Side side) { return side == Side::BID ? 0 : 1; }
+    static int64_t key(Side side, int64_t price) { return side == Side::BID ? -price : price; }
+    Levels& levels(Side side) { return side == Side::BID ? bids_ : asks_; }
+    const Levels& levels(Side side) const { return side == Side::BID ? bids_ : asks_; }
+
+    int64_t best(Side side) const {
+        const Levels& side_levels = levels(side);
+        if (side_levels.empty()) {
+            return side == Side::BID ? REFERENCE_PRICE - TICK : REFERENCE_PRICE + TICK;
+        }
+        return side_levels.begin()->second.price;
+    }
+
+    int64_t place(Side side) {
+        int64_t touch = best(side);
+        const Levels& other = levels(side == Side::BID ? Side::ASK : Side::BID);
+        if (!other.empty() && unit_(rng_) < 0.05) {
+            int64_t inside = side == Side::BID ? touch + TICK : touch - TICK;
+            int64_t opposite = other.begin()->second.price;
+            if (side == Side::BID ? inside < opposite : inside > opposite) {
+                return inside;
+            }
+        }
+        int64_t ticks = unit_(rng_) < 0.8 ? std::geometric_distribution<int64_t>(0.25)(rng_)
+                                          : std::uniform_int_distribution<int64_t>(0, 500)(rng_);
+        int64_t price = side == Side::BID ? touch - ticks * TICK : touch + ticks * TICK;
+        return std::max(price, TICK);
+    }
+
+    int64_t lot() {
+        static constexpr int64_t LOTS[] = {100, 100, 100, 200, 200, 300, 500, 1000};
+        return LOTS[std::uniform_int_distribution<size_t>(0, std::size(LOTS) - 1)(rng_)];
+    }
+
+    // A level near the touch, then any order in it
+    Levels::iterator pick_level(Side side) {
+        Levels& side_levels = levels(side);
+        size_t rank = std::min<size_t>(std::geometric_distribution<size_t>(0.3)(rng_), side_levels.size() - 1);
+        return std::next(side_levels.begin(), static_cast<std::ptrdiff_t>(rank));
+    }
+
+    void remove(Levels::iterator level, size_t position, Side side) {
+        level->second.queue.erase(level->second.queue.begin() + static_cast<std::ptrdiff_t>(position));
+        if (level->second.queue.empty()) {
+            levels(side).erase(level);
+        }
+        --live_[index(side)];
+    }
+
+    void modify(Side side, std::vector<OrderEvent>& out) {
+        auto level = pick_level(side);
+        auto& queue = level->second.queue;
+        size_t position = std::uniform_int_distribution<size_t>(0, queue.size() - 1)(rng_);
+        uint64_t id = queue[position];
+        Resting& order = orders_[id];
+        // Mostly partial reductions (priority kept); increases go to the back
+        bool reduce = order.quantity > 100 && unit_(rng_) < 0.7;
+        int64_t quantity = reduce ? order.quantity - 100 : order.quantity + 100;
+        int64_t before = level->second.total;
+        level->second.total += quantity - order.quantity;
+        order.quantity = quantity;
+        if (!reduce) {
+            queue.erase(queue.begin() + static_cast<std::ptrdiff_t>(position));
+            queue.push_back(id);
+        }
+        out.push_back({OrderEvent::Type::MODIFY, side, id, order.price, quantity, quantity, before, level->second.total});
+    }
+
+    void cancel(Side side, std::vector<OrderEvent>& out) {
+        auto level = pick_level(side);
+        auto& queue = level->second.queue;
+        size_t position = std::uniform_int_distribution<size_t>(0, queue.size() - 1)(rng_);
+        uint64_t id = queue[position];
+        Resting order = orders_[id];
+        orders_.erase(id);
+        int64_t before = level->second.total;
+        level->second.total -= order.quantity;
+        out.push_back({OrderEvent::Type::CANCEL, side, id, order.price, order.quantity, 0, before, level->second.total});
+        remove(level, position, side);
+    }
+
+    // A marketable order against the front of the touch
+    void execute(Side side, std::vector<OrderEvent>& out) {
+        auto level = levels(side).begin();
+        uint64_t id = level->second.queue.front();
+        Resting& order = orders_[id];
+        int64_t filled = std::min(order.quantity, lot());
+        int64_t before = level->second.total;
+        level->second.total -= filled;
+        order.quantity -= filled;
+        out.push_back({OrderEvent::Type::EXECUTE, side, id, order.price, filled, order.quantity, before,
+                       level->second.total});
+        if (order.quantity == 0) {
+            orders_.erase(id);
+            remove(level, 0, side);
+        }
+    }
+};
+
+Workload make_workload(const Mix& mix, size_t max_events, uint64_t seed) {
+    Workload workload;
+    Generator generator(seed);
+    while (generator.live(Side::BID) < ORDERS_PER_SIDE || generator.live(Side::ASK) < ORDERS_PER_SIDE) {
+        generator.add(generator.live(Side::BID) <= generator.live(Side::ASK) ? Side::BID : Side::ASK,
+                      workload.initial);
+    }
+    generator.levels_of(Side::BID, workload.bids);
+    generator.levels_of(Side::ASK, workload.asks);
+    workload.events.reserve(max_events);
+    while (workload.events.size() < max_events && generator.step(mix, workload.events)) {
+    }
+    return workload;
+}
+
+enum class Stream { ADDS, MODIFIES, CANCELS, REPLAY };
+
+// Built once per process; every benchmark of a stream replays the same events
+const Workload& workload(Stream stream) {
+    static const Workload adds = make_workload(ADDS, REPLAY_EVENTS, 1);
+    static const Workload modifies = make_workload(MODIFIES, REPLAY_EVENTS, 2);
+    static const Workload cancels = make_workload(CANCELS, REPLAY_EVENTS, 3);
+    static const Workload replay = make_workload(REALISTIC, REPLAY_EVENTS, 4);
+    switch (stream) {
+        case Stream::ADDS: return adds;
+        case Stream::MODIFIES: return modifies;
+        case Stream::CANCELS: return cancels;
+        default: return replay;
+    }
+}
+
+OrderBookConfig book_config(const benchmark::State& state) {
+    OrderBookConfig config;
+    config.ladder_type = state.range(0) ? LadderType::ARRAY : LadderType::MAP;
+    config.tick_size = TICK;
+    return config;
+}
+
+// One event per iteration; reset() restores the starting book, untimed
+template<typename Event, typename Apply, typename Reset>
+void replay(benchmark::State& state, const std::vector<Event>& events, Apply&& apply, Reset&& reset) {
+    size_t next = 0;
+    for (auto _ : state) {
+        if (next == events.size()) {
+            state.PauseTiming();
+            reset();
+            next = 0;
+            state.ResumeTiming();
+        }
+        apply(events[next++]);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["events"] = static_cast<double>(events.size());
+}
+
+void apply_levels(OrderBook& book, const OrderEvent& event) {
+    switch (event.type) {
+        case OrderEvent::Type::ADD:
+            book.add_order(event.side, event.price, event.quantity);
+            break;
+        case OrderEvent::Type::MODIFY:
+            book.modify_order(event.side, event.price, event.level_after - event.level_before);
+            break;
+        case OrderEvent::Type::CANCEL:
+            book.delete_order(event.side, event.price, event.quantity);
+            break;
+        case OrderEvent::Type::EXECUTE:
+            if (event.remaining == 0) {
+                book.delete_order(event.side, event.price, event.quantity);
+            } else {
+                book.modify_order(event.side, event.price, -event.quantity);
+            }
+            break;
+    }
+}
+
+void apply_orders(L3OrderBook& book, const OrderEvent& event) {
+    switch (event.type) {
+        case OrderEvent::Type::ADD:
+            book.add_order(event.order_id, event.side, event.price, event.quantity);
+            break;
+        case OrderEvent::Type::MODIFY:
+            book.modify_order(event.order_id, event.price, event.quantity);
+            break;
+        case OrderEvent::Type::CANCEL:
+            book.cancel_order(event.order_id);
+            break;
+        case OrderEvent::Type::EXECUTE:
+            book.execute_order(event.order_id, event.quantity);
+            break;
+    }
+}
+
+// FIX 279 view of an event: new, change or delete of its level
+char level_action(const OrderEvent& event) {
+    return event.level_before == 0 ? '0' : event.level_after == 0 ? '2' : '1';
+}
+
+std::vector<MarketEventValue> to_market_events(const std::vector<OrderEvent>& events, uint64_t first_sequence) {
+    std::vector<MarketEventValue> out;
+    out.reserve(events.size());
+    uint64_t sequence = first_sequence;
+    for (const OrderEvent& event : events) {
+        uint64_t ts = sequence * 1000;
+        switch (event.type) {
+            case OrderEvent::Type::ADD:
+                out.push_back(MarketEventValue::make_new_order(sequence, ts, SYMBOL, event.order_id, event.side,
+                                                               event.price, event.quantity));
+                break;
+            case OrderEvent::Type::MODIFY:
+                out.push_back(MarketEventValue::make_modify_order(sequence, ts, SYMBOL, event.order_id, event.side,
+                                                                  event.price, event.quantity,
+                                                                  event.level_after - event.level_before));
+                break;
+            case OrderEvent::Type::CANCEL:
+                out.push_back(MarketEventValue::make_delete_order(sequence, ts, SYMBOL, event.order_id, event.side,
+                                                                  event.price, event.quantity));
+                break;
+            case OrderEvent::Type::EXECUTE: {
+                // The aggressor is on the other side of the resting order
+                bool resting_bid = event.side == Side::BID;
+                out.push_back(MarketEventValue::make_trade(sequence, ts, SYMBOL, sequence,
+                                                           resting_bid ? event.order_id : 0,
+                                                           resting_bid ? 0 : event.order_id, event.price,
+                                                           event.quantity, resting_bid ? Side::ASK : Side::BID));
+                break;
+            }
+        }
+        ++sequence;
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------- OrderBook
+
+void BM_OrderBook(benchmark::State& state, Stream stream) {
+    const Workload& work = workload(stream);
+    OrderBook book(SYMBOL, book_config(state));
+    book.load_levels(work.bids, work.asks);
+    replay(state, work.events, [&](const OrderEvent& event) { apply_levels(book, event); },
+           [&] { book.load_levels(work.bids, work.asks); });
+    state.counters["levels"] = static_cast<double>(work.bids.size() + work.asks.size());
+}
+BENCHMARK_CAPTURE(BM_OrderBook, add, Stream::ADDS)->ArgName("array")->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_OrderBook, modify, Stream::MODIFIES)->ArgName("array")->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_OrderBook, cancel, Stream::CANCELS)->ArgName("array")->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_OrderBook, replay, Stream::REPLAY)->ArgName("array")->Arg(0)->Arg(1);
+
+// The same replay through apply_batch, in runs of range(1) updates
+void BM_OrderBook_Batched(benchmark::State& state) {
+    const Workload& work = workload(Stream::REPLAY);
+    OrderBook book(SYMBOL, book_config(state));
+    book.load_levels(work.bids, work.asks);
+    size_t batch = static_cast<size_t>(state.range(1));
+    std::vector<BookUpdate> updates;
+    for (const OrderEvent& event : work.events) {
+        BookUpdate update;
+        update.side = event.side;
+        update.price = event.price;
+        bool removes = event.type == OrderEvent::Type::CANCEL ||
+                       (event.type == OrderEvent::Type::EXECUTE && event.remaining == 0);
+        update.action = event.type == OrderEvent::Type::ADD ? BookUpdate::Action::ADD
+                        : removes                           ? BookUpdate::Action::DELETE
+                                                            : BookUpdate::Action::MODIFY;
+        update.quantity = update.action == BookUpdate::Action::MODIFY ? event.level_after - event.level_before
+                                                                      : event.quantity;
+        updates.push_back(update);
+    }
+    size_t next = 0;
+    for (auto _ : state) {
+        if (next + batch > updates.size()) {
+            state.PauseTiming();
+            book.load_levels(work.bids, work.asks);
+            next = 0;
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(book.apply_batch(std::span<const BookUpdate>(updates.data() + next, batch)));
+        next += batch;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_OrderBook_Batched)->ArgNames({"array", "batch"})->ArgsProduct({{0, 1}, {8, 64}});
+
+void BM_OrderBook_TopLevels(benchmark::State& state) {
+    const Workload& work = workload(Stream::REPLAY);
+    OrderBook book(SYMBOL, book_config(state));
+    book.load_levels(work.bids, work.asks);
+    size_t levels = static_cast<size_t>(state.range(1));
+    Side side = Side::BID;
+    for (auto _ : state) {
+        int64_t total = 0;
+        for (const PriceLevel& level : book.top_levels(side, levels)) {
+            total += level.quantity;
+        }
+        benchmark::DoNotOptimize(total);
+        side = side == Side::BID ? Side::ASK : Side::BID;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderBook_TopLevels)->ArgNames({"array", "levels"})->ArgsProduct({{0, 1}, {1, 5, 10}});
+
+// Beyond the cache: get_depth walks the ladder and allocates
+void BM_OrderBook_Depth(benchmark::State& state) {
+    const Workload& work = workload(Stream::REPLAY);
+    OrderBook book(SYMBOL, book_config(state));
+    book.load_levels(work.bids, work.asks);
+    size_t levels = static_cast<size_t>(state.range(1));
+    Side side = Side::BID;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book.get_depth(side, levels).size());
+        side = side == Side::BID ? Side::ASK : Side::BID;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderBook_Depth)->ArgNames({"array", "levels"})->ArgsProduct({{0, 1}, {10, 100}});
+
+// Deep contiguous snapshot, range(1) levels per side
+void build_snapshot(size_t depth, std::vector<PriceLevel>& bids, std::vector<PriceLevel>& asks) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int64_t> lots(1, 50);
+    for (size_t i = 0; i < depth; ++i) {
+        int64_t offset = static_cast<int64_t>(i + 1) * TICK;
+        bids.emplace_back(REFERENCE_PRICE - offset, lots(rng) * 100, 3);
+        asks.emplace_back(REFERENCE_PRICE + offset, lots(rng) * 100, 3);
+    }
+}
+
+void BM_OrderBook_LoadSnapshot(benchmark::State& state) {
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+    build_snapshot(static_cast<size_t>(state.range(1)), bids, asks);
+    OrderBook book(SYMBOL, book_config(state));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book.load_levels(bids, asks));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bids.size() + asks.size()));
+}
+BENCHMARK(BM_OrderBook_LoadSnapshot)->ArgNames({"array", "levels"})->ArgsProduct({{0, 1}, {100, 1000, 5000}});
+
+// -------------------------------------------------------------- L3OrderBook
+
+void load_orders(L3OrderBook& book, const Workload& work) {
+    book.clear();
+    for (const OrderEvent& event : work.initial) {
+        apply_orders(book, event);
+    }
+}
+
+void BM_L3OrderBook(benchmark::State& state, Stream stream) {
+    const Workload& work = workload(stream);
+    L3OrderBook book(SYMBOL, book_config(state), EXPECTED_ORDERS);
+    load_orders(book, work);
+    replay(state, work.events, [&](const OrderEvent& event) { apply_orders(book, event); },
+           [&] { load_orders(book, work); });
+}
+BENCHMARK_CAPTURE(BM_L3OrderBook, add, Stream::ADDS)->ArgName("array")->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_L3OrderBook, modify, Stream::MODIFIES)->ArgName("array")->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_L3OrderBook, cancel, Stream::CANCELS)->ArgName("array")->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_L3OrderBook, replay, Stream::REPLAY)->ArgName("array")->Arg(0)->Arg(1);
+
+// --------------------------------------------------------- OrderBookHandler
+
+// Fused L2 path: FIX 279 level updates carrying the level's new size
+void BM_Handler_LevelUpdates(benchmark::State& state, Stream stream) {
+    const Workload& work = workload(stream);
+    OrderBookHandler handler(SYMBOL, BookMode::AGGREGATED, book_config(state));
+    handler.load_snapshot(1, work.bids, work.asks);
+    replay(state, work.events,
+           [&](const OrderEvent& event) {
+               handler.on_level_update(level_action(event), event.side, event.price, event.level_after);
+           },
+           [&] { handler.load_snapshot(1, work.bids, work.asks); });
+}
+BENCHMARK_CAPTURE(BM_Handler_LevelUpdates, replay, Stream::REPLAY)->ArgName("array")->Arg(0)->Arg(1);
+
+// L3 feed through process_event: sequencing, validation and dispatch included
+void BM_Handler_OrderEvents(benchmark::State& state, Stream stream) {
+    const Workload& work = workload(stream);
+    std::vector<MarketEventValue> initial = to_market_events(work.initial, 1);
+    std::vector<MarketEventValue> events = to_market_events(work.events, initial.size() + 1);
+    auto fresh = [&] {
+        auto handler = std::make_unique<OrderBookHandler>(SYMBOL, BookMode::ORDER_LEVEL, book_config(state));
+        for (const MarketEventValue& event : initial) {
+            handler->process_event(event);
+        }
+        return handler;
+    };
+    std::unique_ptr<OrderBookHandler> handler = fresh();
+    replay(state, events, [&](const MarketEventValue& event) { handler->process_event(event); },
+           [&] { handler = fresh(); });
+    state.counters["errors"] = static_cast<double>(handler->get_stats().errors);
+}
+BENCHMARK_CAPTURE(BM_Handler_OrderEvents, replay, Stream::REPLAY)->ArgName("array")->Arg(0)->Arg(1);
+
+void BM_Handler_Snapshot(benchmark::State& state) {
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+    build_snapshot(static_cast<size_t>(state.range(1)), bids, asks);
+    SnapshotEvent snapshot(1, 1000, SYMBOL);
+    for (size_t i = 0; i < bids.size(); ++i) {
+        snapshot.add_bid(bids[i].price, bids[i].quantity, static_cast<int32_t>(bids[i].order_count));
+        snapshot.add_ask(asks[i].price, asks[i].quantity, static_cast<int32_t>(asks[i].order_count));
+    }
+    OrderBookHandler handler(SYMBOL, BookMode::AGGREGATED, book_config(state));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(handler.on_snapshot(snapshot));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(bids.size() + asks.size()));
+}
+BENCHMARK(BM_Handler_Snapshot)->ArgNames({"array", "levels"})->ArgsProduct({{0, 1}, {100, 1000, 5000}});
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -2,6 +2,12 @@
 
 #include "orderbook/order_book.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <sys/types.h>
+#include <vector>
+
 namespace orderbook {
 
 /**
@@ -15,7 +21,7 @@ public:
      * @param levels Number of levels to show on each side
      */
     static void print(const OrderBook& book, int levels = 10);
-    
+
     /**
      * @brief Print order book with custom formatting
      * @param book Order book to print
@@ -23,6 +29,82 @@ public:
      * @param show_header Whether to show column headers
      */
     static void print_detailed(const OrderBook& book, int levels = 10, bool show_header = true);
+
+    /**
+     * @brief Print compact one-line summary (best bid/ask and spread)
+     * @param book Order book to print
+     */
+    static void print_summary(const OrderBook& book);
+};
+
+/**
+ * @brief Double-buffered ladder renderer for live dashboards
+ *
+ * Each refresh() formats the top levels into a preallocated frame of
+ * fixed-size lines (integer-to-text, no iostreams), compares it with the
+ * frame already on screen and writes only the lines that changed, each
+ * prefixed with a cursor-positioning escape, in a single write(). Nothing
+ * is allocated after construction, and an unchanged book costs one pass
+ * over the top levels and no system call.
+ *
+ * Give each printer its own first_row to tile several books on one
+ * terminal.
+ */
+class LiveBookPrinter {
+public:
+    static constexpr size_t LINE_CAPACITY = 96;  // Bytes per line, escapes included
+
+    /**
+     * @brief Constructor
+     * @param levels Levels per side (at most OrderBook::CACHED_LEVELS)
+     * @param fd Output descriptor (-1 to render without writing)
+     * @param first_row Terminal row (1-based) of the first line
+     */
+    explicit LiveBookPrinter(size_t levels = 10, int fd = 1, int first_row = 1);
+
+    /**
+     * @brief Render book and write the lines that changed since the last refresh
+     * @return Bytes written (0 if nothing changed), -1 if write() failed
+     */
+    ssize_t refresh(const OrderBook& book);
+
+    /**
+     * @brief Redraw every line on the next refresh (e.g. after the screen was cleared)
+     */
+    void invalidate() { valid_ = false; }
+
+    size_t line_count() const { return line_count_; }
+
+    /**
+     * @brief Line i of the frame last rendered
+     */
+    std::string_view line(size_t i) const;
+
+    /**
+     * @brief Lines written since construction
+     */
+    uint64_t lines_written() const { return lines_written_; }
+
+private:
+    struct Line {
+        char text[LINE_CAPACITY];
+        uint8_t length = 0;
+    };
+
+    void render(const OrderBook& book);
+    void render_level(Line& line, const PriceLevel* level, Side side, int64_t scale);
+    void render_spread(Line& line, const OrderBook& book);
+
+    size_t levels_;
+    int fd_;
+    int first_row_;
+    size_t line_count_;
+    bool valid_ = false;  // front_ matches the screen
+    uint64_t lines_written_ = 0;
+
+    std::vector<Line> front_;  // On screen
+    std::vector<Line> back_;   // Being rendered
+    std::vector<char> out_;    // Escapes and changed lines for one write()
 };
 
 } // namespace orderbook
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "price_level.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace orderbook {
+
+/**
+ * @brief Single-writer, multi-reader seqlock around a trivially copyable value
+ *
+ * The writer bumps the sequence to odd, stores the value, then bumps it to
+ * even; readers copy the value and retry if the sequence was odd or moved
+ * meanwhile. Readers never block the writer and never take a lock.
+ *
+ * The value is kept as relaxed atomic words, so concurrent copies are
+ * well-defined rather than racing on plain memory.
+ */
+template<typename T>
+class SeqlockCell {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqlockCell copies T bytewise");
+
+public:
+    SeqlockCell() {
+        for (auto& word : words_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    SeqlockCell(const SeqlockCell&) = delete;
+    SeqlockCell& operator=(const SeqlockCell&) = delete;
+
+    /**
+     * @brief Publish a new value (writer thread only)
+     */
+    void store(const T& value) {
+        uint64_t buffer[WORDS] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+
+        uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy out the latest consistent value (any thread)
+     */
+    void load(T& value) const {
+        uint64_t buffer[WORDS];
+        uint64_t before;
+        do {
+            before = sequence_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; ++i) {
+                buffer[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((before & 1) || sequence_.load(std::memory_order_relaxed) != before);
+        std::memcpy(&value, buffer, sizeof(T));
+    }
+
+    /**
+     * @brief Number of completed stores
+     */
+    uint64_t stores() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> words_[WORDS];
+};
+
+/**
+ * @brief Consistent copy of a book's top levels for other threads
+ */
+template<size_t Levels>
+struct BookSnapshot {
+    std::array<PriceLevel, Levels> bids;  // Best first
+    std::array<PriceLevel, Levels> asks;  // Best first
+    uint32_t bid_count = 0;
+    uint32_t ask_count = 0;
+    uint64_t version = 0;                 // OrderBook::version() when published
+
+    std::span<const PriceLevel> bid_levels() const { return {bids.data(), bid_count}; }
+    std::span<const PriceLevel> ask_levels() const { return {asks.data(), ask_count}; }
+
+    /**
+     * @brief Best bid, or an empty level if there are no bids
+     */
+    PriceLevel best_bid() const { return bid_count > 0 ? bids[0] : PriceLevel(); }
+
+    /**
+     * @brief Best ask, or an empty level if there are no asks
+     */
+    PriceLevel best_ask() const { return ask_count > 0 ? asks[0] : PriceLevel(); }
+};
+
+} // namespace orderbook
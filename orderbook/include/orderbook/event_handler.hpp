@@ -1,33 +1,80 @@
 #pragma once
 
 #include "orderbook/order_book.hpp"
+#include "orderbook/l3_order_book.hpp"
 #include "orderbook/market_event.hpp"
 
+#include <functional>
 #include <memory>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace orderbook {
 
+/**
+ * @brief How the handler applies order events
+ */
+enum class BookMode {
+    AGGREGATED,   // Price-level (L2) feed: events carry level quantities
+    ORDER_LEVEL   // Order-by-order (L3) feed: events keyed by order_id
+};
+
+/**
+ * @brief Options for OrderBookHandler::enable_gap_recovery()
+ */
+struct GapRecoveryConfig {
+    size_t buffer_capacity = 4096;  // Events held while waiting for a snapshot
+    
+    // Called once per recovery (and again if replay finds another gap) with
+    // the symbol and the first missing sequence number; must not block
+    std::function<void(const std::string& symbol, uint64_t expected_sequence)> request_snapshot;
+};
+
 /**
  * @brief Event handler that processes market data events and updates order book
  * 
  * This class acts as the bridge between market data feed and order book.
  * It receives market events (new order, modify, delete, trade) and applies
  * them to the order book, maintaining consistency and handling edge cases.
+ * 
+ * In ORDER_LEVEL mode, modify/delete/trade events are resolved through
+ * their order_id (L3OrderBook) instead of price + quantity. Events for
+ * unknown order ids count as errors.
+ * 
+ * With enable_gap_recovery(), a sequence gap no longer drops events: the
+ * handler requests a snapshot and buffers incoming events in a fixed ring
+ * until the snapshot arrives, then replays the buffered events newer than
+ * the snapshot in sequence order. Each handler recovers on its own, so
+ * other symbols keep processing meanwhile.
  */
 class OrderBookHandler {
 public:
     /**
      * @brief Constructor
      * @param symbol Symbol for this order book
+     * @param mode Aggregated (L2) or order-level (L3) processing
+     * @param config Book options, including the price scale of event prices
      */
-    explicit OrderBookHandler(const std::string& symbol);
+    explicit OrderBookHandler(const std::string& symbol,
+                              BookMode mode = BookMode::AGGREGATED,
+                              const OrderBookConfig& config = OrderBookConfig());
     
     /**
      * @brief Get the order book
      */
-    OrderBook& get_order_book() { return order_book_; }
-    const OrderBook& get_order_book() const { return order_book_; }
+    OrderBook& get_order_book() { return l3_book_.book(); }
+    const OrderBook& get_order_book() const { return l3_book_.book(); }
+    
+    /**
+     * @brief Get the order-level book (populated in ORDER_LEVEL mode)
+     */
+    const L3OrderBook& get_l3_book() const { return l3_book_; }
+    
+    /**
+     * @brief Get processing mode
+     */
+    BookMode get_mode() const { return mode_; }
     
     /**
      * @brief Handle new order event
@@ -64,6 +111,33 @@ public:
      */
     bool on_snapshot(const SnapshotEvent& event);
     
+    /**
+     * @brief Replace the book with pre-sorted fixed-point levels
+     * 
+     * The bulk path behind on_snapshot(), for callers that already hold
+     * levels in the book's fixed-point scale. Tracked orders are dropped
+     * and the sequence resets to sequence_number.
+     * @param sequence_number Sequence number of the snapshot
+     * @param bids Bid levels, best (highest) first
+     * @param asks Ask levels, best (lowest) first
+     * @return true (levels with non-positive quantity are skipped)
+     */
+    bool load_snapshot(uint64_t sequence_number, std::span<const PriceLevel> bids,
+                       std::span<const PriceLevel> asks);
+    
+    /**
+     * @brief Apply a price-level update (FIX 279 MDUpdateAction) directly
+     * 
+     * Used by fused feed stages that skip event materialization. New and
+     * change both set the level to size; delete removes the level.
+     * @param action '0' new, '1' change, '2' delete, '\0' (snapshot) set level
+     * @param side BID or ASK
+     * @param price_fixed Level price in the book's fixed-point scale
+     * @param size Level quantity after the update (ignored for delete)
+     * @return true if applied (AGGREGATED mode only)
+     */
+    bool on_level_update(char action, Side side, int64_t price_fixed, int64_t size);
+    
     /**
      * @brief Process generic market event
      * @param event Market event (polymorphic)
@@ -71,6 +145,13 @@ public:
      */
     bool process_event(const MarketEvent& event);
     
+    /**
+     * @brief Process value-type market event (allocation-free hot path)
+     * @param event Market event value (snapshots not supported)
+     * @return true if successfully processed
+     */
+    bool process_event(const MarketEventValue& event);
+    
     /**
      * @brief Get event processing statistics
      */
@@ -112,23 +193,80 @@ public:
     struct GapStats {
         uint64_t gaps_detected;
         uint64_t messages_dropped;
+        uint64_t stale_messages;      // Sequence at or before the last applied one
+        uint64_t recoveries;          // Snapshot requests (gap recovery)
+        uint64_t messages_buffered;
+        uint64_t messages_replayed;
+        uint64_t buffer_overflows;    // Buffered events dropped, ring full
         
-        GapStats() : gaps_detected(0), messages_dropped(0) {}
+        GapStats() : gaps_detected(0), messages_dropped(0), stale_messages(0), recoveries(0),
+                     messages_buffered(0), messages_replayed(0), buffer_overflows(0) {}
     };
     
     const GapStats& get_gap_stats() const { return gap_stats_; }
+    
+    /**
+     * @brief Buffer and replay around sequence gaps instead of dropping
+     * 
+     * The ring is allocated here, once. When it fills during a recovery
+     * the oldest events are dropped (buffer_overflows); if that leaves a
+     * hole after the snapshot, replay stops there and requests another.
+     */
+    void enable_gap_recovery(GapRecoveryConfig config);
+    
+    /**
+     * @brief Whether the handler is buffering events awaiting a snapshot
+     */
+    bool is_recovering() const { return recovery_ && recovery_->active; }
 
 private:
     std::string symbol_;
-    OrderBook order_book_;
+    BookMode mode_;
+    L3OrderBook l3_book_;  // Owns the aggregated book used in both modes
     EventStats stats_;
     uint64_t last_sequence_;
     GapStats gap_stats_;
     
+    // Gap recovery state (enable_gap_recovery), nullptr when disabled
+    struct GapRecovery {
+        GapRecoveryConfig config;
+        std::vector<MarketEventValue> ring;  // Pooled, allocated once
+        size_t head = 0;                     // Oldest buffered event
+        size_t count = 0;
+        bool active = false;                 // Waiting for a snapshot
+    };
+    std::unique_ptr<GapRecovery> recovery_;
+    
+    // on_snapshot() conversion scratch, reused across snapshots
+    std::vector<PriceLevel> snapshot_bids_;
+    std::vector<PriceLevel> snapshot_asks_;
+    
     /**
      * @brief Validate event before processing
      */
     bool validate_event(const MarketEvent& event) const;
+    bool validate_event(const MarketEventValue& event) const;
+    
+    /**
+     * @brief Validate and apply a value event (sequence already checked)
+     */
+    bool dispatch(const MarketEventValue& event);
+    
+    /**
+     * @brief Gap recovery: request a snapshot, buffer, replay after it
+     */
+    void start_recovery();
+    void buffer_event(const MarketEventValue& event);
+    void replay_buffered();
+    
+    /**
+     * @brief Apply validated event fields to the book (shared by both event paths)
+     */
+    bool apply_new_order(uint64_t order_id, Side side, int64_t price_fixed, int64_t quantity);
+    bool apply_modify_order(uint64_t order_id, Side side, int64_t price_fixed, int64_t new_quantity);
+    bool apply_delete_order(uint64_t order_id, Side side, int64_t price_fixed, int64_t quantity);
+    bool apply_trade(uint64_t buy_order_id, uint64_t sell_order_id, int64_t price_fixed,
+                     int64_t quantity, Side aggressor_side);
 };
 
 } // namespace orderbook
@@ -3,10 +3,24 @@
 #include "orderbook/event_handler.hpp"
 #include "orderbook/market_event.hpp"
 #include "common/tick.hpp"
+#include "common/symbol_table.hpp"
+#include "common/latency_histogram.hpp"
+#include "pipeline/timestamp_merger.hpp"
 
+#include <functional>
 #include <memory>
+#include <optional>
+#include <span>
 #include <unordered_map>
 #include <string>
+#include <string_view>
+#include <vector>
+
+namespace feedhandler {
+namespace benchmarks {
+class StageProfiler;
+}
+}
 
 namespace orderbook {
 
@@ -15,13 +29,45 @@ namespace orderbook {
  * 
  * Converts FIX ticks from feedhandler into market events
  * and updates order books accordingly.
+ * 
+ * The per-tick path is allocation-free: ticks become stack-allocated
+ * MarketEventValue objects and handlers are found through a flat vector
+ * indexed by the tick's instrument ID (common::SymbolTable). Ticks
+ * without an ID are interned on the fly. Allocation only happens the
+ * first time a symbol is seen.
+ * 
+ * Prices stay fixed-point from Tick to PriceLevel. Books use the feed's
+ * scale (DEFAULT_PRICE_SCALE) unless set_book_config() gives an
+ * instrument its own price_scale, in which case prices are rescaled in
+ * integer arithmetic.
+ * 
+ * Books check Tick::sequence for gaps and stale ticks when the feed
+ * supplies one (a per-instrument sequence). Ticks without one (0) are
+ * applied in arrival order, each following on from its book's last
+ * sequence. Tick::timestamp is only the receive time, used for
+ * wire-to-book latency and replay ordering.
  */
 class FeedIntegration {
 public:
     /**
      * @brief Constructor
+     * @param default_config Options for books without a set_book_config() entry
      */
-    FeedIntegration();
+    explicit FeedIntegration(const OrderBookConfig& default_config = OrderBookConfig());
+    
+    /**
+     * @brief Book options (ladder, tick size, price scale) for one instrument
+     * 
+     * Takes effect when the instrument's book is created, i.e. call it
+     * before the first tick for symbol.
+     */
+    void set_book_config(std::string_view symbol, const OrderBookConfig& config);
+    
+    /**
+     * @brief Gap recovery for every book, existing and future
+     *        (see OrderBookHandler::enable_gap_recovery)
+     */
+    void enable_gap_recovery(const GapRecoveryConfig& config);
     
     /**
      * @brief Process a tick from the feed handler
@@ -30,51 +76,215 @@ public:
      */
     bool process_tick(const feedhandler::common::Tick& tick);
     
+    /**
+     * @brief Process a batch of ticks (e.g. one parsed buffer)
+     * 
+     * Suitable as a ThreadedFeedHandler::BatchCallback target: one call
+     * per buffer, with process_tick inlined into the loop.
+     * @param ticks Market data ticks
+     * @return Number of ticks successfully processed
+     */
+    size_t process_ticks(std::span<const feedhandler::common::Tick> ticks);
+    
+    /**
+     * @brief Apply a timestamp-ordered merge of several sources (captured
+     *        sessions, replay files) through process_ticks()
+     * @param batch Ticks per process_ticks() call
+     * @return Number of ticks successfully processed
+     */
+    size_t replay(feedhandler::pipeline::TimestampMerger<feedhandler::common::Tick>& merger, size_t batch = 256);
+    
+    /**
+     * @brief Apply a market data message (35=X or 35=W) straight to the books
+     * 
+     * Fused stage: each MDEntry is routed by instrument and applied with
+     * OrderBookHandler::on_level_update as the message is scanned, with
+     * no Tick or MarketEvent in between. 279 MDUpdateAction selects
+     * add/modify/delete; entries other than bids (269=0) and offers
+     * (269=1) are skipped.
+     * @param message One FIX message
+     * @return Number of entries applied
+     */
+    size_t process_market_data(std::string_view message);
+    
+    /**
+     * @brief Record wire-to-book latency (book update time - Tick::timestamp)
+     * @param histogram Destination, nullptr to disable; must outlive this
+     * 
+     * Tick::timestamp is the receive time when the feed supplies one (see
+     * FSMFixParser::set_receive_timestamp). One clock read per
+     * process_ticks() batch or process_tick() call; ticks with no
+     * timestamp are not recorded.
+     */
+    void set_latency_histogram(feedhandler::common::AtomicLatencyHistogram* histogram) { wire_to_book_ = histogram; }
+    
+    /**
+     * @brief Time to apply each tick (process_tick/process_ticks) or
+     *        each market data message (process_market_data) to the books
+     * 
+     * Recorded on the calling thread; snapshot() from any thread.
+     */
+    const feedhandler::common::AtomicLatencyHistogram& book_latency() const { return book_latency_; }
+    
+    /**
+     * @brief Enable/disable book_latency() recording
+     *        (MonitoringConfig::enable_latency_tracking, on by default)
+     */
+    void set_latency_tracking(bool enable) { latency_tracking_ = enable; }
+    
+    /**
+     * @brief Sample hardware counters for book updates as stage "book_update"
+     * @param profiler Profiler to register with, nullptr to stop; must outlive this
+     * 
+     * One sample per process_tick()/process_ticks()/process_market_data() call.
+     */
+    void set_stage_profiler(feedhandler::benchmarks::StageProfiler* profiler);
+    
     /**
      * @brief Get or create order book handler for symbol
      * @param symbol Trading symbol
      * @return Reference to order book handler
      */
-    OrderBookHandler& get_handler(const std::string& symbol);
+    OrderBookHandler& get_handler(std::string_view symbol);
+    
+    /**
+     * @brief Get or create order book handler for an interned instrument
+     * @param instrument_id ID from the global SymbolTable
+     * @return Pointer to handler, or nullptr if the ID is unknown
+     */
+    OrderBookHandler* get_handler(feedhandler::common::InstrumentId instrument_id);
+    
+    /**
+     * @brief Detach an instrument's handler, book and all
+     * 
+     * The next tick for the instrument starts a fresh book unless
+     * adopt_handler() puts one back.
+     * @return The handler, or nullptr if the instrument has none
+     */
+    std::unique_ptr<OrderBookHandler> release_handler(feedhandler::common::InstrumentId instrument_id);
+    
+    /**
+     * @brief Take over a handler detached by another integration's release_handler()
+     * @return false if handler is null or the instrument already has one
+     */
+    bool adopt_handler(feedhandler::common::InstrumentId instrument_id,
+                       std::unique_ptr<OrderBookHandler> handler);
     
     /**
      * @brief Get order book for symbol
      * @param symbol Trading symbol
      * @return Pointer to order book, or nullptr if not found
      */
-    OrderBook* get_order_book(const std::string& symbol);
+    OrderBook* get_order_book(std::string_view symbol);
+    
+    /**
+     * @brief Get order book for an interned instrument
+     * @param instrument_id ID from the global SymbolTable
+     * @return Pointer to order book, or nullptr if not found
+     */
+    OrderBook* get_order_book(feedhandler::common::InstrumentId instrument_id);
     
     /**
      * @brief Get all active symbols
      */
     std::vector<std::string> get_symbols() const;
     
+    /**
+     * @brief Warm-up sizing (see warm_up())
+     */
+    struct WarmupConfig {
+        size_t levels_per_side = 256;  // Levels reserved, and built each round
+        size_t rounds = 4;             // Build-and-empty cycles per book
+        
+        WarmupConfig() = default;
+    };
+    
+    /**
+     * @brief Prepare the books of the configured instruments before going live
+     * 
+     * For each symbol: interns it and creates its handler and book,
+     * reserves levels_per_side levels per side (OrderBook::reserve_levels),
+     * then runs rounds cycles of synthetic ticks through the same tick
+     * path as process_tick(), each building levels_per_side levels per
+     * side and emptying the book again, so the conversion, routing,
+     * handler and level code are hot and the level nodes allocated.
+     * Afterwards every book is empty with its sequence reset, and
+     * handler and integration statistics are cleared. Latency is not
+     * recorded for the synthetic ticks.
+     * @return Synthetic ticks applied
+     */
+    size_t warm_up(std::span<const std::string> symbols);
+    size_t warm_up(std::span<const std::string> symbols, const WarmupConfig& config);
+    
     /**
      * @brief Get processing statistics
      */
     struct Stats {
         uint64_t ticks_processed;
         uint64_t events_generated;
+        uint64_t entries_processed;   // MDEntries seen by process_market_data
         uint64_t errors;
         
-        Stats() : ticks_processed(0), events_generated(0), errors(0) {}
+        Stats() : ticks_processed(0), events_generated(0), entries_processed(0), errors(0) {}
     };
     
     const Stats& get_stats() const { return stats_; }
-    void reset_stats() { stats_ = Stats(); }
+    void reset_stats() {
+        stats_ = Stats();
+        book_latency_.reset();
+    }
 
 private:
+    /**
+     * @brief Transparent hash so lookups by string_view do not build a std::string
+     */
+    struct SymbolHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view symbol) const {
+            return std::hash<std::string_view>{}(symbol);
+        }
+    };
+    
     // Map of symbol -> OrderBookHandler
-    std::unordered_map<std::string, std::unique_ptr<OrderBookHandler>> handlers_;
+    std::unordered_map<std::string, std::unique_ptr<OrderBookHandler>,
+                       SymbolHash, std::equal_to<>> handlers_;
+    
+    // Instrument ID -> handler (non-owning, nullptr until first tick)
+    std::vector<OrderBookHandler*> handlers_by_id_;
+    
+    OrderBookConfig default_config_;
+    std::unordered_map<std::string, OrderBookConfig, SymbolHash, std::equal_to<>> book_configs_;
+    std::optional<GapRecoveryConfig> gap_recovery_;
     
     Stats stats_;
+    feedhandler::common::AtomicLatencyHistogram* wire_to_book_ = nullptr;
+    feedhandler::common::AtomicLatencyHistogram book_latency_;
+    bool latency_tracking_ = true;
+    feedhandler::benchmarks::StageProfiler* stage_profiler_ = nullptr;
+    size_t book_stage_ = 0;
+    
+    uint64_t latency_stamp() const {
+        return latency_tracking_ ? feedhandler::common::TscClock::read_counter() : 0;
+    }
+    void record_book_latency(uint64_t start, uint64_t end);
+    
+    /**
+     * @brief Route one tick to its book (process_tick without latency recording)
+     */
+    bool apply_tick(const feedhandler::common::Tick& tick);
+    
+    /**
+     * @brief Record now - timestamp for each stamped tick
+     */
+    void record_latency(std::span<const feedhandler::common::Tick> ticks);
     
     /**
      * @brief Convert tick to market event
      * @param tick Input tick
-     * @return Market event (or nullptr if conversion fails)
+     * @param event Output event
+     * @return false if conversion fails (e.g. symbol too long)
      */
-    std::unique_ptr<MarketEvent> tick_to_event(const feedhandler::common::Tick& tick);
+    bool tick_to_event(const feedhandler::common::Tick& tick, MarketEventValue& event);
 };
 
 } // namespace orderbook
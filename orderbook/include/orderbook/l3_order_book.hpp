@@ -0,0 +1,219 @@
+#pragma once
+
+#include "orderbook/order_book.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Resting order tracked by L3OrderBook
+ *
+ * Orders live in a pooled array and are linked into a FIFO per price
+ * level through prev/next slot indices (intrusive list, no allocation).
+ */
+struct Order {
+    uint64_t order_id;
+    int64_t price;       // Fixed-point (scaled by 10000)
+    int64_t quantity;    // Remaining quantity
+    uint32_t prev;       // Older order at same level, NO_ORDER if head
+    uint32_t next;       // Newer order at same level, NO_ORDER if tail
+    Side side;
+
+    Order() : order_id(0), price(0), quantity(0),
+              prev(NO_ORDER), next(NO_ORDER), side(Side::BID) {}
+};
+
+/**
+ * @brief Open-addressing hash from order_id to order slot
+ *
+ * Linear probing over a power-of-two table kept at most half full,
+ * with backward-shift deletion so there are no tombstones. All order
+ * ids (including 0) are valid keys; empty buckets are marked by
+ * slot == NO_ORDER.
+ */
+class OrderIdMap {
+public:
+    /**
+     * @brief Constructor
+     * @param expected_orders Number of live orders to size for
+     */
+    explicit OrderIdMap(size_t expected_orders = 1024);
+
+    /**
+     * @brief Find slot for order_id
+     * @return Slot index, or NO_ORDER if absent
+     */
+    uint32_t find(uint64_t order_id) const;
+
+    /**
+     * @brief Insert order_id -> slot
+     * @return false if order_id already present
+     */
+    bool insert(uint64_t order_id, uint32_t slot);
+
+    /**
+     * @brief Remove order_id (no-op if absent)
+     */
+    void erase(uint64_t order_id);
+
+    size_t size() const { return size_; }
+    void clear();
+
+private:
+    struct Bucket {
+        uint64_t key;
+        uint32_t slot;
+    };
+
+    std::vector<Bucket> buckets_;
+    size_t mask_;
+    size_t size_;
+
+    size_t bucket_of(uint64_t order_id) const {
+        // 64-bit finalizer from MurmurHash3: sequential ids spread well
+        uint64_t h = order_id;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h) & mask_;
+    }
+
+    void grow();
+};
+
+/**
+ * @brief Order-level (L3) order book
+ *
+ * Tracks individual orders by id on top of the aggregated OrderBook.
+ * Every operation keeps the aggregated PriceLevel quantity and
+ * order_count in sync, so the L2 view (best bid/ask, depth) is always
+ * available through book().
+ *
+ * Each PriceLevel carries head/tail slot indices of a FIFO of its
+ * orders, giving time priority within a level.
+ *
+ * Complexity:
+ * - Add/Cancel/Execute/Modify by order_id: O(1) plus the ladder's
+ *   price lookup (O(1) for ARRAY, O(log n) for MAP)
+ *
+ * Priority rules on modify:
+ * - Quantity decrease: keeps queue position
+ * - Quantity increase: moves to back of queue
+ * - Price change: cancel and re-add at new price (back of queue)
+ */
+class L3OrderBook {
+public:
+    /**
+     * @brief Constructor
+     * @param symbol Trading symbol
+     * @param config Ladder selection for the aggregated book
+     * @param expected_orders Live orders to preallocate for
+     */
+    explicit L3OrderBook(std::string_view symbol,
+                         const OrderBookConfig& config = OrderBookConfig(),
+                         size_t expected_orders = 1024);
+
+    /**
+     * @brief Add a new resting order
+     * @return false if order_id already exists, quantity <= 0 or
+     *         price rejected by the ladder (off-tick)
+     */
+    bool add_order(uint64_t order_id, Side side, int64_t price, int64_t quantity);
+
+    /**
+     * @brief Change an order's price and/or total quantity
+     * @param order_id Existing order
+     * @param price New price (fixed-point)
+     * @param new_quantity New remaining quantity (0 cancels the order)
+     * @return false if order_id is unknown or the new price is rejected
+     *         (the order then stays where it was)
+     */
+    bool modify_order(uint64_t order_id, int64_t price, int64_t new_quantity);
+
+    /**
+     * @brief Remove an order
+     * @return false if order_id is unknown
+     */
+    bool cancel_order(uint64_t order_id);
+
+    /**
+     * @brief Fill part or all of a resting order
+     * @param order_id Resting order
+     * @param quantity Executed quantity (order removed when fully filled)
+     * @return false if order_id is unknown or quantity <= 0
+     */
+    bool execute_order(uint64_t order_id, int64_t quantity);
+
+    /**
+     * @brief Look up an order
+     * @return Pointer to order, or nullptr if unknown
+     * @note Pointer is invalidated by the next add
+     */
+    const Order* find_order(uint64_t order_id) const;
+
+    /**
+     * @brief Visit orders at a price level in time priority
+     */
+    template<typename Func>
+    void for_each_order(Side side, int64_t price, Func&& func) const {
+        const PriceLevel* level = book_.find_level(side, price);
+        if (!level) return;
+        for (uint32_t slot = level->head_order; slot != NO_ORDER; slot = orders_[slot].next) {
+            func(orders_[slot]);
+        }
+    }
+
+    /**
+     * @brief Number of live orders
+     */
+    size_t order_count() const { return index_.size(); }
+
+    /**
+     * @brief Remove all orders and levels
+     */
+    void clear();
+
+    /**
+     * @brief Drop all orders and load aggregated levels (snapshot recovery)
+     *
+     * Levels carry no orders; see OrderBook::load_levels().
+     * @return Number of levels loaded
+     */
+    size_t load_levels(std::span<const PriceLevel> bids, std::span<const PriceLevel> asks);
+
+    /**
+     * @brief Aggregated (L2) view
+     */
+    OrderBook& book() { return book_; }
+    const OrderBook& book() const { return book_; }
+
+private:
+    OrderBook book_;
+    std::vector<Order> orders_;        // Order pool, indexed by slot
+    std::vector<uint32_t> free_slots_; // Recycled pool slots
+    OrderIdMap index_;
+
+    uint32_t acquire_slot();
+    void release_slot(uint32_t slot);
+
+    /**
+     * @brief Append order to the back of its level's FIFO
+     */
+    void link_back(PriceLevel& level, uint32_t slot);
+
+    /**
+     * @brief Remove order from its level's FIFO
+     */
+    void unlink(PriceLevel& level, uint32_t slot);
+
+    /**
+     * @brief Unlink, remove from level and release (order must exist)
+     */
+    void remove(uint32_t slot);
+};
+
+} // namespace orderbook
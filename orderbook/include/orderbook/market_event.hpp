@@ -1,7 +1,9 @@
 #pragma once
 
 #include "orderbook/order_book.hpp"
+#include "orderbook/snapshot_levels.hpp"
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -21,6 +23,10 @@ enum class EventType {
 
 /**
  * @brief Base market event structure
+ * 
+ * Prices in all events are fixed-point integers in the receiving book's
+ * scale (OrderBookConfig::price_scale, common::Tick's scale by default),
+ * so ticks flow into the book without a round trip through double.
  */
 struct MarketEvent {
     EventType type;
@@ -45,11 +51,11 @@ struct MarketEvent {
 struct NewOrderEvent : public MarketEvent {
     uint64_t order_id;
     Side side;
-    double price;
+    int64_t price;             // Fixed-point, in the book's price scale
     int64_t quantity;
     
     NewOrderEvent(uint64_t seq, uint64_t ts, std::string_view sym,
-                  uint64_t oid, Side s, double p, int64_t q)
+                  uint64_t oid, Side s, int64_t p, int64_t q)
         : MarketEvent(EventType::NEW_ORDER, seq, ts, sym)
         , order_id(oid)
         , side(s)
@@ -65,12 +71,12 @@ struct NewOrderEvent : public MarketEvent {
 struct ModifyOrderEvent : public MarketEvent {
     uint64_t order_id;
     Side side;
-    double price;
+    int64_t price;             // Fixed-point, in the book's price scale
     int64_t new_quantity;      // New total quantity
     int64_t quantity_delta;    // Change in quantity (can be negative)
     
     ModifyOrderEvent(uint64_t seq, uint64_t ts, std::string_view sym,
-                     uint64_t oid, Side s, double p, int64_t new_qty, int64_t delta)
+                     uint64_t oid, Side s, int64_t p, int64_t new_qty, int64_t delta)
         : MarketEvent(EventType::MODIFY_ORDER, seq, ts, sym)
         , order_id(oid)
         , side(s)
@@ -87,11 +93,11 @@ struct ModifyOrderEvent : public MarketEvent {
 struct DeleteOrderEvent : public MarketEvent {
     uint64_t order_id;
     Side side;
-    double price;
+    int64_t price;             // Fixed-point, in the book's price scale
     int64_t quantity;  // Quantity being removed
     
     DeleteOrderEvent(uint64_t seq, uint64_t ts, std::string_view sym,
-                     uint64_t oid, Side s, double p, int64_t q)
+                     uint64_t oid, Side s, int64_t p, int64_t q)
         : MarketEvent(EventType::DELETE_ORDER, seq, ts, sym)
         , order_id(oid)
         , side(s)
@@ -108,13 +114,13 @@ struct TradeEvent : public MarketEvent {
     uint64_t trade_id;
     uint64_t buy_order_id;
     uint64_t sell_order_id;
-    double price;
+    int64_t price;             // Fixed-point, in the book's price scale
     int64_t quantity;
     Side aggressor_side;  // Which side initiated the trade
     
     TradeEvent(uint64_t seq, uint64_t ts, std::string_view sym,
                uint64_t tid, uint64_t buy_oid, uint64_t sell_oid,
-               double p, int64_t q, Side aggressor)
+               int64_t p, int64_t q, Side aggressor)
         : MarketEvent(EventType::TRADE, seq, ts, sym)
         , trade_id(tid)
         , buy_order_id(buy_oid)
@@ -124,40 +130,180 @@ struct TradeEvent : public MarketEvent {
         , aggressor_side(aggressor) {}
 };
 
-/**
- * @brief Price level snapshot entry
- */
-struct SnapshotLevel {
-    double price;
-    int64_t quantity;
-    int32_t order_count;
-    
-    SnapshotLevel(double p, int64_t q, int32_t count)
-        : price(p), quantity(q), order_count(count) {}
-};
-
 /**
  * @brief Snapshot event
  * 
  * Represents a full order book snapshot.
  * Used for initial book construction or recovery from gaps.
+ * 
+ * Built on a SnapshotLevelPool, each side lives in a preallocated
+ * block; keep one event per instrument and reset() it for every
+ * snapshot, and a snapshot storm allocates nothing.
  */
 struct SnapshotEvent : public MarketEvent {
-    std::vector<SnapshotLevel> bids;  // Sorted descending by price
-    std::vector<SnapshotLevel> asks;  // Sorted ascending by price
+    SnapshotLevels bids;  // Sorted descending by price
+    SnapshotLevels asks;  // Sorted ascending by price
     
     SnapshotEvent(uint64_t seq, uint64_t ts, std::string_view sym)
         : MarketEvent(EventType::SNAPSHOT, seq, ts, sym) {}
     
-    void add_bid(double price, int64_t quantity, int32_t order_count) {
+    SnapshotEvent(uint64_t seq, uint64_t ts, std::string_view sym, SnapshotLevelPool& pool)
+        : MarketEvent(EventType::SNAPSHOT, seq, ts, sym)
+        , bids(&pool)
+        , asks(&pool) {}
+    
+    /**
+     * @brief Start the next snapshot of the same instrument, keeping the level storage
+     */
+    void reset(uint64_t seq, uint64_t ts) {
+        sequence_number = seq;
+        timestamp_ns = ts;
+        bids.clear();
+        asks.clear();
+    }
+    
+    void add_bid(int64_t price, int64_t quantity, int32_t order_count) {
         bids.emplace_back(price, quantity, order_count);
     }
     
-    void add_ask(double price, int64_t quantity, int32_t order_count) {
+    void add_ask(int64_t price, int64_t quantity, int32_t order_count) {
         asks.emplace_back(price, quantity, order_count);
     }
 };
 
+/**
+ * @brief Fixed-capacity symbol stored inline (no heap allocation)
+ */
+struct InlineSymbol {
+    static constexpr size_t CAPACITY = 31;
+    
+    char data[CAPACITY];
+    uint8_t length;
+    
+    InlineSymbol() : data{}, length(0) {}
+    
+    /**
+     * @brief Copy symbol in
+     * @return false if symbol is longer than CAPACITY (left empty)
+     */
+    bool assign(std::string_view sym) {
+        if (sym.size() > CAPACITY) {
+            length = 0;
+            return false;
+        }
+        std::memcpy(data, sym.data(), sym.size());
+        length = static_cast<uint8_t>(sym.size());
+        return true;
+    }
+    
+    std::string_view view() const { return std::string_view(data, length); }
+    bool empty() const { return length == 0; }
+};
+
+/**
+ * @brief Value-type market event (tagged union)
+ * 
+ * Allocation-free counterpart of the polymorphic MarketEvent hierarchy
+ * for the per-tick hot path: fits in a couple of cache lines, is
+ * trivially copyable and can live on the stack or in ring buffers.
+ * 
+ * Covers NEW_ORDER, MODIFY_ORDER, DELETE_ORDER and TRADE. Snapshots
+ * carry variable-length level lists and stay on SnapshotEvent.
+ */
+struct MarketEventValue {
+    struct NewOrder {
+        uint64_t order_id;
+        Side side;
+        int64_t price;
+        int64_t quantity;
+    };
+    
+    struct ModifyOrder {
+        uint64_t order_id;
+        Side side;
+        int64_t price;
+        int64_t new_quantity;
+        int64_t quantity_delta;
+    };
+    
+    struct DeleteOrder {
+        uint64_t order_id;
+        Side side;
+        int64_t price;
+        int64_t quantity;
+    };
+    
+    struct Trade {
+        uint64_t trade_id;
+        uint64_t buy_order_id;
+        uint64_t sell_order_id;
+        int64_t price;
+        int64_t quantity;
+        Side aggressor_side;
+    };
+    
+    EventType type;
+    uint64_t sequence_number;
+    uint64_t timestamp_ns;
+    InlineSymbol symbol;
+    
+    union {
+        NewOrder new_order;
+        ModifyOrder modify_order;
+        DeleteOrder delete_order;
+        Trade trade;
+    };
+    
+    MarketEventValue()
+        : type(EventType::NEW_ORDER)
+        , sequence_number(0)
+        , timestamp_ns(0)
+        , new_order{0, Side::BID, 0, 0} {}
+    
+    /**
+     * @brief Build new order event
+     * @note Symbol is left empty if longer than InlineSymbol::CAPACITY
+     */
+    static MarketEventValue make_new_order(uint64_t seq, uint64_t ts, std::string_view sym,
+                                           uint64_t oid, Side s, int64_t p, int64_t q) {
+        MarketEventValue e(EventType::NEW_ORDER, seq, ts, sym);
+        e.new_order = NewOrder{oid, s, p, q};
+        return e;
+    }
+    
+    static MarketEventValue make_modify_order(uint64_t seq, uint64_t ts, std::string_view sym,
+                                              uint64_t oid, Side s, int64_t p,
+                                              int64_t new_qty, int64_t delta) {
+        MarketEventValue e(EventType::MODIFY_ORDER, seq, ts, sym);
+        e.modify_order = ModifyOrder{oid, s, p, new_qty, delta};
+        return e;
+    }
+    
+    static MarketEventValue make_delete_order(uint64_t seq, uint64_t ts, std::string_view sym,
+                                              uint64_t oid, Side s, int64_t p, int64_t q) {
+        MarketEventValue e(EventType::DELETE_ORDER, seq, ts, sym);
+        e.delete_order = DeleteOrder{oid, s, p, q};
+        return e;
+    }
+    
+    static MarketEventValue make_trade(uint64_t seq, uint64_t ts, std::string_view sym,
+                                       uint64_t tid, uint64_t buy_oid, uint64_t sell_oid,
+                                       int64_t p, int64_t q, Side aggressor) {
+        MarketEventValue e(EventType::TRADE, seq, ts, sym);
+        e.trade = Trade{tid, buy_oid, sell_oid, p, q, aggressor};
+        return e;
+    }
+
+private:
+    MarketEventValue(EventType t, uint64_t seq, uint64_t ts, std::string_view sym)
+        : type(t)
+        , sequence_number(seq)
+        , timestamp_ns(ts)
+        , new_order{0, Side::BID, 0, 0} {
+        symbol.assign(sym);
+    }
+};
+
 /**
  * @brief Convert event type to string
  */
@@ -1,9 +1,15 @@
 #pragma once
 
 #include "price_level.hpp"
+#include "price_ladder.hpp"
+#include "book_snapshot.hpp"
+#include <array>
 #include <map>
+#include <memory>
+#include <span>
 #include <vector>
 #include <cstdint>
+#include <string>
 #include <string_view>
 
 namespace orderbook {
@@ -16,14 +22,54 @@ enum class Side {
     ASK   // Sell side
 };
 
+/**
+ * @brief Price ladder implementation backing each side of the book
+ */
+enum class LadderType {
+    MAP,    // std::map keyed by price (sparse books, arbitrary prices)
+    ARRAY   // Tick-indexed contiguous array with occupancy bitmap
+};
+
+/**
+ * @brief Order book construction options
+ */
+struct OrderBookConfig {
+    LadderType ladder_type = LadderType::MAP;
+    int64_t tick_size = 1;          // ARRAY: price increment per slot (fixed-point)
+    size_t initial_levels = 4096;   // ARRAY: initial window size in ticks
+    size_t max_levels = 1 << 18;    // ARRAY: largest window in ticks; prices beyond it are rejected
+    bool publish_snapshots = false; // Publish the top levels for other threads (read_snapshot)
+    int64_t price_scale = DEFAULT_PRICE_SCALE;  // Fixed-point units per 1.0 of this instrument
+};
+
+/**
+ * @brief One level update for OrderBook::apply_batch()
+ */
+struct BookUpdate {
+    enum class Action : uint8_t {
+        ADD,     // add_order(side, price, quantity)
+        MODIFY,  // modify_order(side, price, quantity) - quantity is the delta
+        DELETE   // delete_order(side, price, quantity)
+    };
+    
+    Action action = Action::ADD;
+    Side side = Side::BID;
+    int64_t price = 0;
+    int64_t quantity = 0;
+};
+
 /**
  * @brief Limit order book maintaining real-time market depth
  * 
- * Data structure choice: std::map
- * - Bid side: std::map with std::greater (descending, highest price first)
- * - Ask side: std::map with std::less (ascending, lowest price first)
+ * Data structure choice (selected via OrderBookConfig::ladder_type):
+ * - MAP (default):
+ *   - Bid side: std::map with std::greater (descending, highest price first)
+ *   - Ask side: std::map with std::less (ascending, lowest price first)
+ * - ARRAY: ArrayPriceLadder per side, O(1) updates and cache-line scans
+ *   for best price / depth. Prices must sit on the configured tick grid,
+ *   within max_levels ticks of the rest of their side.
  * 
- * Complexity:
+ * Complexity (MAP):
  * - Insert: O(log n)
  * - Update: O(log n)
  * - Delete: O(log n)
@@ -31,14 +77,36 @@ enum class Side {
  * - Get depth: O(k) where k = number of levels
  * 
  * Memory: O(n) where n = number of price levels
+ * 
+ * Top-of-book cache: the best CACHED_LEVELS levels of each side are kept
+ * in a fixed array that add/modify/delete update in place when they touch
+ * that range, so best bid/ask, spread, mid and shallow depth are reads of
+ * contiguous memory on either ladder type. version() changes whenever a
+ * cached level does, so pollers can skip books whose top did not move.
+ * 
+ * Threading: one thread owns the book. With publish_snapshots, every
+ * change to the cached levels is also published through a seqlock, and
+ * any number of other threads may call read_snapshot() and
+ * published_version() concurrently with the owner, without locks.
  */
 class OrderBook {
 public:
+    /**
+     * @brief Levels per side kept in the top-of-book cache
+     */
+    static constexpr size_t CACHED_LEVELS = 10;
+    
+    /**
+     * @brief Top levels as published to other threads
+     */
+    using Snapshot = BookSnapshot<CACHED_LEVELS>;
+    
     /**
      * @brief Constructor
      * @param symbol Trading symbol (e.g., "AAPL", "MSFT")
+     * @param config Ladder selection and sizing
      */
-    explicit OrderBook(std::string_view symbol);
+    explicit OrderBook(std::string_view symbol, const OrderBookConfig& config = OrderBookConfig());
     
     /**
      * @brief Add a new order to the book
@@ -64,17 +132,49 @@ public:
      */
     void delete_order(Side side, int64_t price, int64_t quantity);
     
+    /**
+     * @brief Apply a batch of updates, touching each level once
+     *
+     * Same result as calling add_order/modify_order/delete_order for
+     * each update in order, but updates are grouped by side and price
+     * (keeping their order within a level), folded into one final
+     * level state, and written with a single lookup per level. The
+     * top-of-book cache, version() and the published snapshot are
+     * refreshed once at the end.
+     * @param updates Updates in arrival order
+     * @return Number of distinct levels touched
+     */
+    size_t apply_batch(std::span<const BookUpdate> updates);
+    
+    /**
+     * @brief Replace the whole book with pre-sorted levels
+     *
+     * Bulk path for snapshot loads: the array ladder is sized and filled
+     * in one pass and map nodes are recycled rather than freed by clear()
+     * and reallocated by one add_order() per level. Levels keep their
+     * quantity and order count. The cache is rebuilt and version()
+     * advances once.
+     * @param bids Bid levels, best (highest) first
+     * @param asks Ask levels, best (lowest) first
+     * @return Number of levels loaded (non-positive quantities, duplicate
+     *         and, in ARRAY mode, off-tick and out-of-window prices are
+     *         skipped)
+     */
+    size_t load_levels(std::span<const PriceLevel> bids, std::span<const PriceLevel> asks);
+    
     /**
      * @brief Get best bid price and quantity
-     * @return PriceLevel with best bid, or empty if no bids
+     * @return PriceLevel with best bid, or an empty level if no bids
+     * @note Reference is into the cache, valid until the next change
      */
-    PriceLevel get_best_bid() const;
+    const PriceLevel& get_best_bid() const;
     
     /**
      * @brief Get best ask price and quantity
-     * @return PriceLevel with best ask, or empty if no asks
+     * @return PriceLevel with best ask, or an empty level if no asks
+     * @note Reference is into the cache, valid until the next change
      */
-    PriceLevel get_best_ask() const;
+    const PriceLevel& get_best_ask() const;
     
     /**
      * @brief Get bid-ask spread
@@ -96,11 +196,70 @@ public:
      */
     std::vector<PriceLevel> get_depth(Side side, size_t levels) const;
     
+    /**
+     * @brief Best levels of a side straight from the cache, no allocation
+     * @param side BID or ASK
+     * @param levels Levels wanted (at most CACHED_LEVELS)
+     * @return Up to levels levels in priority order, valid until the next change
+     */
+    std::span<const PriceLevel> top_levels(Side side, size_t levels = CACHED_LEVELS) const;
+    
+    /**
+     * @brief Counter that changes whenever a cached top level changes
+     *
+     * Changes outside the best CACHED_LEVELS of either side leave it as is.
+     */
+    uint64_t version() const { return version_; }
+    
+    /**
+     * @brief Copy the latest published top levels (any thread)
+     * @param snapshot Filled with a consistent view of both sides
+     * @return false if the book was built without publish_snapshots
+     */
+    bool read_snapshot(Snapshot& snapshot) const;
+    
+    /**
+     * @brief version() of the latest published snapshot (any thread)
+     *
+     * Cheaper than read_snapshot() for checking whether anything moved.
+     * @return 0 without publish_snapshots
+     */
+    uint64_t published_version() const;
+    
+    /**
+     * @brief Refresh the cache after changing a level via find_level()
+     * @param side BID or ASK
+     * @param price Price of the changed level
+     */
+    void level_updated(Side side, int64_t price);
+    
     /**
      * @brief Clear all orders from the book
+     *
+     * After reserve_levels(), the level nodes are kept for reuse.
      */
     void clear();
     
+    /**
+     * @brief Pre-allocate room for levels price levels per side
+     *
+     * Warm-up before going live. MAP: allocates the nodes up front and
+     * from then on keeps the nodes of erased levels for new ones, so up
+     * to levels levels per side come and go without touching the heap.
+     * ARRAY: grows the window to at least levels ticks (keeping the
+     * current anchor). Calling it again with a smaller count never
+     * shrinks anything.
+     * @param levels Levels per side
+     */
+    void reserve_levels(size_t levels);
+    
+    /**
+     * @brief Allocated MAP nodes waiting for a new level (0 without reserve_levels())
+     */
+    size_t spare_levels(Side side) const {
+        return side == Side::BID ? spare_bids_.size() : spare_asks_.size();
+    }
+    
     /**
      * @brief Get total number of price levels
      * @param side BID or ASK
@@ -108,6 +267,19 @@ public:
      */
     size_t level_count(Side side) const;
     
+    /**
+     * @brief ARRAY: window size in ticks (0 for MAP)
+     */
+    size_t window_levels(Side side) const {
+        return ladder_type_ == LadderType::ARRAY ? ladder(side).capacity() : 0;
+    }
+    
+    /**
+     * @brief ARRAY: prices dropped for lying more than max_levels ticks
+     *        from the rest of the side (0 for MAP)
+     */
+    uint64_t out_of_window(Side side) const { return ladder(side).out_of_window(); }
+    
     /**
      * @brief Get trading symbol
      */
@@ -117,16 +289,87 @@ public:
      * @brief Check if book is empty
      */
     bool is_empty() const;
+    
+    /**
+     * @brief Mutable access to a price level
+     * @param side BID or ASK
+     * @param price Price level
+     * @return Pointer to level, or nullptr if no level at price
+     * @note Pointer is invalidated by any later add/modify/delete;
+     *       call level_updated() after changing the level through it
+     */
+    PriceLevel* find_level(Side side, int64_t price);
+    const PriceLevel* find_level(Side side, int64_t price) const;
+    
+    /**
+     * @brief Get ladder implementation in use
+     */
+    LadderType ladder_type() const { return ladder_type_; }
+    
+    /**
+     * @brief Fixed-point units per 1.0 (OrderBookConfig::price_scale)
+     */
+    int64_t price_scale() const { return price_scale_; }
 
 private:
     std::string symbol_;
+    LadderType ladder_type_;
+    int64_t price_scale_;
+    
+    using BidMap = std::map<int64_t, PriceLevel, std::greater<int64_t>>;
+    using AskMap = std::map<int64_t, PriceLevel, std::less<int64_t>>;
     
     // Bid side: descending order (highest price first)
     // Key = price, Value = PriceLevel
-    std::map<int64_t, PriceLevel, std::greater<int64_t>> bids_;
+    BidMap bids_;
     
     // Ask side: ascending order (lowest price first)
-    std::map<int64_t, PriceLevel, std::less<int64_t>> asks_;
+    AskMap asks_;
+    
+    // Nodes of erased levels, reused for new ones (reserve_levels());
+    // capacity is the most a side keeps, 0 means free them as usual
+    std::vector<BidMap::node_type> spare_bids_;
+    std::vector<AskMap::node_type> spare_asks_;
+    
+    // Tick-indexed ladders (used when ladder_type_ == ARRAY)
+    ArrayPriceLadder bid_ladder_;
+    ArrayPriceLadder ask_ladder_;
+    
+    // Best CACHED_LEVELS levels per side, in priority order
+    struct DepthCache {
+        std::array<PriceLevel, CACHED_LEVELS> levels;
+        size_t count = 0;
+    };
+    DepthCache bid_cache_;
+    DepthCache ask_cache_;
+    uint64_t version_ = 0;
+    
+    // Seqlocked copy of the caches for other threads (publish_snapshots);
+    // heap-allocated so the book stays movable
+    struct Published {
+        SeqlockCell<Snapshot> snapshot;
+        std::atomic<uint64_t> version{0};
+    };
+    std::unique_ptr<Published> published_;
+    
+    // apply_batch() scratch: update indices grouped by side and price
+    std::vector<uint32_t> batch_order_;
+    
+    /**
+     * @brief Publish the caches if publish_snapshots is set
+     */
+    void publish();
+    
+    DepthCache& cache(Side side) { return side == Side::BID ? bid_cache_ : ask_cache_; }
+    const DepthCache& cache(Side side) const { return side == Side::BID ? bid_cache_ : ask_cache_; }
+    
+    /**
+     * @brief Reload a side's cache from the ladder/map
+     */
+    void rebuild_cache(Side side);
+    
+    ArrayPriceLadder& ladder(Side side) { return side == Side::BID ? bid_ladder_ : ask_ladder_; }
+    const ArrayPriceLadder& ladder(Side side) const { return side == Side::BID ? bid_ladder_ : ask_ladder_; }
     
     /**
      * @brief Get the appropriate map for a side
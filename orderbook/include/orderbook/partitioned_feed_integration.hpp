@@ -0,0 +1,224 @@
+#pragma once
+
+#include "orderbook/feed_integration.hpp"
+#include "threading/spsc_ring.hpp"
+#include "common/tick.hpp"
+#include "common/compact_tick.hpp"
+#include "common/symbol_table.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief FeedIntegration partitioned by symbol across book-builder threads
+ *
+ * Architecture:
+ * - Worker i owns one FeedIntegration (and so its OrderBookHandlers) and
+ *   one SPSC inbound ring; only worker i's thread touches its books
+ * - The producer (typically a ThreadedFeedHandler batch callback) routes
+ *   each tick through a routing table indexed by InstrumentId. A symbol
+ *   is assigned by FNV-1a hash the first time it is seen and then stays
+ *   on its worker, so per-symbol order is preserved
+ * - rebalance() moves the instrument that best evens out the load from
+ *   the busiest worker to the idlest one. The book moves with it: the old
+ *   worker hands the handler over after applying the symbol's last queued
+ *   tick, and the new worker picks it up before applying the next one
+ *
+ * A full inbound ring applies backpressure: the producer waits rather
+ * than dropping book updates (counted in WorkerStats::backpressure_waits). Ticks travel
+ * as CompactTick and are rebuilt on the worker with their symbol pointing
+ * into the SymbolTable, so nothing refers to the producer's buffers.
+ *
+ * Threading: route(), route_batch(), rebalance() and flush() from one
+ * producer thread. Books may be inspected through get_order_book() only
+ * while stopped (or after flush() from the producer thread); use
+ * OrderBookConfig::publish_snapshots to read top levels while running.
+ */
+class PartitionedFeedIntegration {
+public:
+    /**
+     * @brief Configuration
+     */
+    struct Config {
+        size_t worker_count = 2;            // Book-builder threads
+        size_t queue_capacity = 65536;      // Ticks per inbound ring (rounded up to a power of 2)
+        feedhandler::threading::WaitStrategy wait_strategy = feedhandler::threading::WaitStrategy::SPIN_YIELD;
+        OrderBookConfig book_config;        // Options for every book
+        double rebalance_threshold = 0.25;  // rebalance() acts when busiest > idlest * (1 + threshold)
+
+        Config() = default;
+    };
+
+    /**
+     * @brief Per-worker totals
+     */
+    struct WorkerStats {
+        uint64_t ticks_routed = 0;       // Pushed by the producer
+        uint64_t ticks_applied = 0;      // Processed by the worker (FeedIntegration::process_ticks)
+        uint64_t backpressure_waits = 0; // Producer found the ring full
+        size_t instruments = 0;          // Instruments currently routed here
+    };
+
+    /**
+     * @brief Constructor with the default Config
+     */
+    PartitionedFeedIntegration();
+
+    /**
+     * @brief Constructor
+     * @param config Configuration (worker_count of 0 is treated as 1)
+     */
+    explicit PartitionedFeedIntegration(const Config& config);
+
+    /**
+     * @brief Destructor - stops the workers
+     */
+    ~PartitionedFeedIntegration();
+
+    PartitionedFeedIntegration(const PartitionedFeedIntegration&) = delete;
+    PartitionedFeedIntegration& operator=(const PartitionedFeedIntegration&) = delete;
+
+    /**
+     * @brief Start the worker threads
+     * @return false if already running
+     */
+    bool start();
+
+    /**
+     * @brief Apply everything queued, then stop the worker threads
+     */
+    void stop();
+
+    bool is_running() const { return running_; }
+
+    /**
+     * @brief Send one tick to the worker that owns its instrument
+     *
+     * Interns the symbol if the parser did not. The queued copy refers to
+     * the SymbolTable's copy of the symbol, so the receive buffer may be
+     * reused as soon as this returns.
+     * @return false if not running or the symbol cannot be interned
+     */
+    bool route(const feedhandler::common::Tick& tick);
+
+    /**
+     * @brief route() each tick of a batch (ThreadedFeedHandler::BatchCallback target)
+     * @return Number of ticks routed
+     */
+    size_t route_batch(std::span<const feedhandler::common::Tick> ticks);
+
+    /**
+     * @brief Move one hot instrument off the busiest worker if load is uneven
+     *
+     * Load is the number of ticks routed per worker since the previous
+     * rebalance(); the counts restart on every call.
+     * @return true if an instrument was moved
+     */
+    bool rebalance();
+
+    /**
+     * @brief Move an instrument's book to another worker
+     *
+     * While running, the new worker waits for the old one to apply the
+     * instrument's queued ticks before it applies any newer ones.
+     * @return false if the instrument was never routed or worker is out of range
+     */
+    bool move_instrument(feedhandler::common::InstrumentId instrument_id, size_t worker);
+
+    /**
+     * @brief Wait until the workers have applied every routed tick (producer thread)
+     */
+    void flush();
+
+    /**
+     * @brief Worker that owns an instrument, or worker_count() if not routed yet
+     */
+    size_t worker_for(feedhandler::common::InstrumentId instrument_id) const;
+
+    /**
+     * @brief Initial worker for a symbol (stable for a given worker count)
+     */
+    size_t hash_worker(std::string_view symbol) const;
+
+    size_t worker_count() const { return workers_.size(); }
+
+    WorkerStats worker_stats(size_t worker) const;
+
+    /**
+     * @brief Book for a symbol, nullptr if it has none (see threading note)
+     */
+    OrderBook* get_order_book(std::string_view symbol);
+
+    /**
+     * @brief Worker i's integration (see threading note)
+     */
+    FeedIntegration& integration(size_t worker) { return workers_[worker]->integration; }
+
+    /**
+     * @brief Ticks handed to a worker in one FeedIntegration::process_ticks() call at most
+     */
+    static constexpr size_t MAX_BATCH = 256;
+
+private:
+    // Book handed from one worker to another by move_instrument()
+    struct Handoff {
+        feedhandler::common::InstrumentId instrument_id = feedhandler::common::INVALID_INSTRUMENT;
+        std::unique_ptr<OrderBookHandler> handler;  // nullptr if the old worker had no book yet
+        std::atomic<bool> ready{false};             // Set by the old worker after release
+    };
+
+    // One inbound ring entry: a tick, or a handoff step for the worker
+    struct Inbound {
+        enum class Kind : uint8_t { TICK, RELEASE, ADOPT };
+        Kind kind = Kind::TICK;
+        feedhandler::common::CompactTick tick;
+        uint64_t sequence = 0;  // Tick::sequence (CompactTick has no room for it)
+        Handoff* handoff = nullptr;
+    };
+
+    struct Worker {
+        explicit Worker(const Config& config);
+
+        // Recreated by start(): a ring cannot be reopened after shutdown()
+        std::unique_ptr<feedhandler::threading::SpscRing<Inbound>> inbound;
+        FeedIntegration integration;
+        std::thread thread;
+
+        // Producer side
+        uint64_t pushed = 0;          // Ring entries, ticks and handoff steps
+        uint64_t ticks_routed = 0;
+        uint64_t backpressure_waits = 0;
+        uint64_t load = 0;            // Ticks routed since the last rebalance()
+        size_t instruments = 0;
+
+        // Worker side
+        std::atomic<uint64_t> completed{0};  // Ring entries fully handled (flush() waits for pushed)
+        std::atomic<uint64_t> ticks_applied{0};
+    };
+
+    void run(Worker& worker);
+    void push(Worker& worker, Inbound&& item);
+    static void apply(Worker& worker, std::vector<feedhandler::common::Tick>& batch);
+
+    Config config_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    bool running_ = false;
+
+    // Producer-owned routing table, indexed by InstrumentId
+    static constexpr uint16_t UNROUTED = UINT16_MAX;
+    std::vector<uint16_t> route_;
+    std::vector<uint64_t> instrument_load_;  // Ticks per instrument since the last rebalance()
+
+    // Completed and in-flight handoffs (rebalancing is rare; kept until destruction)
+    std::deque<Handoff> handoffs_;
+};
+
+} // namespace orderbook
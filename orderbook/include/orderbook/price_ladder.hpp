@@ -0,0 +1,187 @@
+#pragma once
+
+#include "price_level.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Tick-indexed price ladder for one side of the book
+ *
+ * Price levels live in a contiguous array indexed by
+ * (price - base_price) / tick_size. A bitmap of non-empty slots
+ * (one bit per slot, 64 slots per word) lets best price and depth
+ * queries scan whole cache lines instead of walking tree nodes.
+ *
+ * The window is anchored around the first price seen and re-anchored
+ * (or doubled in size) when a price falls outside it. Re-anchoring is
+ * O(capacity) but happens only when the touch drifts out of range.
+ * The window never grows past max_levels ticks: a price that would need
+ * a wider one (a bad print far from the book) is rejected and counted
+ * in out_of_window() rather than allocating for it.
+ *
+ * Complexity:
+ * - Insert/Update/Delete: O(1) (amortized, excluding re-anchor)
+ * - Best price: O(capacity / 64) worst case, usually one word
+ * - Get depth: O(k + words scanned)
+ *
+ * @note Prices must be multiples of tick_size relative to the anchor;
+ *       off-tick prices are rejected.
+ */
+class ArrayPriceLadder {
+public:
+    /**
+     * @brief Constructor
+     * @param descending true for bid side (best = highest price)
+     * @param tick_size Minimum price increment (fixed-point)
+     * @param initial_levels Initial window size in ticks (rounded up to 64)
+     * @param max_levels Largest window in ticks (rounded up to 64, at
+     *        least the initial window)
+     */
+    ArrayPriceLadder(bool descending, int64_t tick_size, size_t initial_levels, size_t max_levels);
+
+    /**
+     * @brief Find level at price
+     * @return Pointer to level, or nullptr if price has no level
+     */
+    PriceLevel* find(int64_t price);
+    const PriceLevel* find(int64_t price) const;
+
+    /**
+     * @brief Find or create level at price
+     * @return Pointer to level, or nullptr if price is off-tick or too
+     *         far from the existing levels to fit in max_levels ticks
+     */
+    PriceLevel* insert(int64_t price);
+
+    /**
+     * @brief Remove level at price (no-op if absent)
+     */
+    void erase(int64_t price);
+
+    /**
+     * @brief Replace all levels in one pass (snapshot load)
+     *
+     * Sizes and anchors the window once for the whole price range and
+     * writes the slots directly, reusing the allocated window when the
+     * range fits: O(levels + capacity / 64) instead of one insert (and
+     * possibly several re-anchors) per level.
+     * When the levels span more than max_levels ticks, the window keeps
+     * the max_levels ticks from the best price outwards and the levels
+     * beyond it count towards out_of_window().
+     * @param levels Levels in any order; the first fixes the tick grid
+     * @return Number of levels loaded (non-positive quantities, off-tick,
+     *         duplicate and out-of-window prices are skipped)
+     */
+    size_t assign(std::span<const PriceLevel> levels);
+
+    /**
+     * @brief Best level (highest bid / lowest ask)
+     * @return Pointer to best level, or nullptr if side is empty
+     */
+    const PriceLevel* best() const;
+
+    /**
+     * @brief Append up to `levels` levels in priority order
+     */
+    void collect(std::vector<PriceLevel>& out, size_t levels) const;
+
+    /**
+     * @brief Visit non-empty levels in priority order until func returns false
+     */
+    template<typename Func>
+    void for_each(Func&& func) const {
+        if (count_ == 0) return;
+        const size_t words = occupancy_.size();
+        if (descending_) {
+            for (size_t w = words; w-- > 0;) {
+                uint64_t bits = occupancy_[w];
+                while (bits != 0) {
+                    int bit = 63 - __builtin_clzll(bits);
+                    if (!func(slots_[w * 64 + bit])) return;
+                    bits &= ~(uint64_t{1} << bit);
+                }
+            }
+        } else {
+            for (size_t w = 0; w < words; ++w) {
+                uint64_t bits = occupancy_[w];
+                while (bits != 0) {
+                    int bit = __builtin_ctzll(bits);
+                    if (!func(slots_[w * 64 + bit])) return;
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Number of non-empty levels
+     */
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    /**
+     * @brief Remove all levels (keeps allocated window)
+     */
+    void clear();
+
+    /**
+     * @brief Grow the window to at least levels ticks (rounded up to 64)
+     *
+     * Levels keep their slots: the window extends above the current
+     * anchor. Never shrinks, and stops at max_levels.
+     */
+    void reserve(size_t levels);
+
+    /**
+     * @brief Current window size in ticks
+     */
+    size_t capacity() const { return slots_.size(); }
+
+    /**
+     * @brief Largest window size in ticks
+     */
+    size_t max_levels() const { return max_levels_; }
+
+    /**
+     * @brief Prices rejected because they would not fit in max_levels ticks
+     */
+    uint64_t out_of_window() const { return out_of_window_; }
+
+    int64_t tick_size() const { return tick_size_; }
+
+private:
+    bool descending_;
+    int64_t tick_size_;
+    int64_t base_price_;   // Price of slot 0
+    size_t count_;         // Non-empty levels
+    bool anchored_;        // base_price_ valid
+    size_t max_levels_;    // Window size limit in ticks
+    uint64_t out_of_window_;
+
+    std::vector<PriceLevel> slots_;     // One slot per tick in the window
+    std::vector<uint64_t> occupancy_;   // Bit per slot: level non-empty
+
+    /**
+     * @brief Slot index for price, or -1 if outside window / off-tick
+     */
+    int64_t slot_of(int64_t price) const;
+
+    bool is_set(size_t slot) const {
+        return (occupancy_[slot >> 6] >> (slot & 63)) & 1;
+    }
+
+    size_t lowest_slot() const;
+    size_t highest_slot() const;
+
+    /**
+     * @brief Move/grow window so that price fits
+     * @return false (window untouched) if that takes more than max_levels ticks
+     */
+    bool reanchor(int64_t price);
+};
+
+} // namespace orderbook
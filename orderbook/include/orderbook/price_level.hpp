@@ -1,33 +1,50 @@
 #pragma once
 
+#include <cmath>
 #include <cstdint>
 #include <compare>
 
 namespace orderbook {
 
+/**
+ * @brief Fixed-point units per 1.0 unless a book configures its own
+ *        (OrderBookConfig::price_scale); same scale as common::Tick
+ */
+constexpr int64_t DEFAULT_PRICE_SCALE = 10000;
+
+/**
+ * @brief Sentinel for "no order" in intrusive order lists
+ */
+constexpr uint32_t NO_ORDER = UINT32_MAX;
+
 /**
  * @brief Price level in the order book
  * 
  * Aggregates all orders at a specific price point.
- * Uses fixed-point arithmetic for price (scaled by 10000).
+ * Uses fixed-point arithmetic for price (scaled by the book's price
+ * scale, DEFAULT_PRICE_SCALE = 10000 unless configured).
  * 
  * Example: $150.25 = 1502500 (150.25 * 10000)
  */
 struct PriceLevel {
-    int64_t price;        // Price in fixed-point (scaled by 10000)
+    int64_t price;        // Price in fixed-point (book's price scale)
     int64_t quantity;     // Total quantity at this price
     uint32_t order_count; // Number of orders at this price
+    uint32_t head_order;  // L3: oldest order (L3OrderBook slot), NO_ORDER if none
+    uint32_t tail_order;  // L3: newest order (L3OrderBook slot), NO_ORDER if none
     
     /**
      * @brief Default constructor
      */
-    PriceLevel() : price(0), quantity(0), order_count(0) {}
+    PriceLevel() : price(0), quantity(0), order_count(0),
+                   head_order(NO_ORDER), tail_order(NO_ORDER) {}
     
     /**
      * @brief Constructor with values
      */
     PriceLevel(int64_t p, int64_t q, uint32_t c = 1) 
-        : price(p), quantity(q), order_count(c) {}
+        : price(p), quantity(q), order_count(c),
+          head_order(NO_ORDER), tail_order(NO_ORDER) {}
     
     /**
      * @brief Add quantity to this level
@@ -114,19 +131,37 @@ struct PriceLevel {
 /**
  * @brief Helper function to create price from double
  * @param price_double Price as double (e.g., 150.25)
- * @return Fixed-point price (e.g., 1502500)
+ * @param scale Fixed-point units per 1.0
+ * @return Fixed-point price (e.g., 1502500), rounded to nearest
  */
-inline int64_t price_from_double(double price_double) {
-    return static_cast<int64_t>(price_double * 10000.0);
+inline int64_t price_from_double(double price_double, int64_t scale = DEFAULT_PRICE_SCALE) {
+    return std::llround(price_double * static_cast<double>(scale));
 }
 
 /**
- * @brief Helper function to convert price to double
+ * @brief Helper function to convert price to double (display only)
  * @param price_fixed Fixed-point price (e.g., 1502500)
+ * @param scale Fixed-point units per 1.0
  * @return Price as double (e.g., 150.25)
  */
-inline double price_to_double(int64_t price_fixed) {
-    return static_cast<double>(price_fixed) / 10000.0;
+inline double price_to_double(int64_t price_fixed, int64_t scale = DEFAULT_PRICE_SCALE) {
+    return static_cast<double>(price_fixed) / static_cast<double>(scale);
+}
+
+/**
+ * @brief Convert a fixed-point price between scales in integer arithmetic
+ * @return price unchanged when the scales match, else rounded to nearest
+ */
+inline int64_t rescale_price(int64_t price, int64_t from_scale, int64_t to_scale) {
+    if (from_scale == to_scale) {
+        return price;
+    }
+    if (to_scale % from_scale == 0) {
+        return price * (to_scale / from_scale);
+    }
+    __int128 scaled = static_cast<__int128>(price) * to_scale;
+    __int128 half = from_scale / 2;
+    return static_cast<int64_t>((scaled + (scaled < 0 ? -half : half)) / from_scale);
 }
 
 } // namespace orderbook
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Price level snapshot entry
+ */
+struct SnapshotLevel {
+    int64_t price;             // Fixed-point, in the book's price scale
+    int64_t quantity;
+    int32_t order_count;
+
+    SnapshotLevel() : price(0), quantity(0), order_count(0) {}
+    SnapshotLevel(int64_t p, int64_t q, int32_t count)
+        : price(p), quantity(q), order_count(count) {}
+};
+
+struct SnapshotLevelPoolConfig {
+    size_t blocks = 64;          // Level blocks, one per snapshot side in flight
+    size_t block_levels = 256;   // Levels per block; deeper snapshots spill to the heap
+};
+
+/**
+ * @brief Fixed-capacity level blocks shared by SnapshotEvents
+ *
+ * Allocates blocks * block_levels levels once, up front, and hands them
+ * out a block per snapshot side. A snapshot storm after a feed restart
+ * then takes blocks off a free list instead of growing two vectors per
+ * event. When the pool is exhausted, or a side is deeper than a block,
+ * SnapshotLevels falls back to the heap and the miss is counted.
+ *
+ * Not thread-safe: one pool per decoding thread. Must outlive every
+ * SnapshotLevels built on it.
+ */
+class SnapshotLevelPool {
+public:
+    struct Stats {
+        uint64_t acquired = 0;   // Blocks handed out
+        uint64_t exhausted = 0;  // Requests with no free block
+        uint64_t outgrown = 0;   // Sides that outgrew their block
+    };
+
+    explicit SnapshotLevelPool(const SnapshotLevelPoolConfig& config = SnapshotLevelPoolConfig())
+        : block_levels_(std::max<size_t>(config.block_levels, 1))
+        , levels_(config.blocks * block_levels_) {
+        free_.reserve(config.blocks);
+        for (size_t i = config.blocks; i > 0; --i) {
+            free_.push_back(&levels_[(i - 1) * block_levels_]);
+        }
+    }
+
+    // Non-copyable (blocks point into levels_)
+    SnapshotLevelPool(const SnapshotLevelPool&) = delete;
+    SnapshotLevelPool& operator=(const SnapshotLevelPool&) = delete;
+
+    /**
+     * @brief Take a block of block_levels() levels
+     * @return nullptr if every block is in use
+     */
+    SnapshotLevel* acquire() {
+        if (free_.empty()) {
+            stats_.exhausted++;
+            return nullptr;
+        }
+        SnapshotLevel* block = free_.back();
+        free_.pop_back();
+        stats_.acquired++;
+        return block;
+    }
+
+    /**
+     * @brief Return a block taken with acquire()
+     */
+    void release(SnapshotLevel* block) { free_.push_back(block); }
+
+    void note_outgrown() { stats_.outgrown++; }
+
+    size_t block_levels() const { return block_levels_; }
+    size_t blocks() const { return levels_.size() / block_levels_; }
+    size_t available() const { return free_.size(); }
+    const Stats& stats() const { return stats_; }
+
+private:
+    size_t block_levels_;
+    std::vector<SnapshotLevel> levels_;
+    std::vector<SnapshotLevel*> free_;
+    Stats stats_;
+};
+
+/**
+ * @brief One side of a snapshot: levels in a pool block when there is one
+ *
+ * Vector-like, but the storage comes from a SnapshotLevelPool block
+ * (when given a pool and one is free) and only moves to the heap if
+ * the side outgrows it. clear() keeps the storage, so an event reset
+ * for the next snapshot of the same instrument allocates nothing; the
+ * block goes back to the pool when the levels are destroyed.
+ */
+class SnapshotLevels {
+public:
+    SnapshotLevels() = default;
+    explicit SnapshotLevels(SnapshotLevelPool* pool) : pool_(pool) {}
+    ~SnapshotLevels() { release(); }
+
+    SnapshotLevels(SnapshotLevels&& other) noexcept
+        : heap_(std::move(other.heap_))
+        , data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , pool_(other.pool_)
+        , pooled_(std::exchange(other.pooled_, false)) {}
+
+    SnapshotLevels& operator=(SnapshotLevels&& other) noexcept {
+        if (this != &other) {
+            release();
+            heap_ = std::move(other.heap_);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+            pool_ = other.pool_;
+            pooled_ = std::exchange(other.pooled_, false);
+        }
+        return *this;
+    }
+
+    // Non-copyable (may own a pool block)
+    SnapshotLevels(const SnapshotLevels&) = delete;
+    SnapshotLevels& operator=(const SnapshotLevels&) = delete;
+
+    void push_back(const SnapshotLevel& level) {
+        if (size_ == capacity_) {
+            grow();
+        }
+        data_[size_++] = level;
+    }
+
+    void emplace_back(int64_t price, int64_t quantity, int32_t order_count) {
+        push_back(SnapshotLevel(price, quantity, order_count));
+    }
+
+    /**
+     * @brief Drop the levels, keeping the storage for the next snapshot
+     */
+    void clear() { size_ = 0; }
+
+    /**
+     * @brief Room for at least levels without growing again
+     */
+    void reserve(size_t levels) {
+        while (capacity_ < levels) {
+            grow();
+        }
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+    bool pooled() const { return pooled_; }
+
+    const SnapshotLevel& operator[](size_t i) const { return data_[i]; }
+    SnapshotLevel& operator[](size_t i) { return data_[i]; }
+    const SnapshotLevel* begin() const { return data_; }
+    const SnapshotLevel* end() const { return data_ + size_; }
+    std::span<const SnapshotLevel> span() const { return {data_, size_}; }
+
+private:
+    static constexpr size_t MIN_HEAP_LEVELS = 16;
+
+    // First a pool block, then the heap, doubling from then on
+    void grow() {
+        if (capacity_ == 0 && pool_) {
+            if (SnapshotLevel* block = pool_->acquire()) {
+                data_ = block;
+                capacity_ = pool_->block_levels();
+                pooled_ = true;
+                return;
+            }
+        }
+        if (pooled_) {
+            pool_->note_outgrown();
+        }
+
+        size_t capacity = std::max(capacity_ * 2, MIN_HEAP_LEVELS);
+        std::unique_ptr<SnapshotLevel[]> heap(new SnapshotLevel[capacity]);
+        std::copy_n(data_, size_, heap.get());
+        release();
+        heap_ = std::move(heap);
+        data_ = heap_.get();
+        capacity_ = capacity;
+    }
+
+    void release() {
+        if (pooled_) {
+            pool_->release(data_);
+            pooled_ = false;
+        }
+        heap_.reset();
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+
+    std::unique_ptr<SnapshotLevel[]> heap_;
+    SnapshotLevel* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    SnapshotLevelPool* pool_ = nullptr;
+    bool pooled_ = false;
+};
+
+} // namespace orderbook
@@ -0,0 +1,66 @@
+// Order Book Visualization Demo
+// Builds a sample book and prints it with BookPrinter
+
+#include "orderbook/book_printer.hpp"
+#include "orderbook/order_book.hpp"
+#include "orderbook/price_level.hpp"
+
+#include <iostream>
+
+int main() {
+    using namespace orderbook;
+    
+    std::cout << "Order Book Visualization Demo\n";
+    std::cout << "==============================\n";
+    
+    // Create order book
+    OrderBook book("AAPL");
+    
+    // Add some orders to create a realistic book
+    // Bids (buy orders)
+    book.add_order(Side::BID, price_from_double(150.00), 1000);
+    book.add_order(Side::BID, price_from_double(149.99), 1500);
+    book.add_order(Side::BID, price_from_double(149.98), 2000);
+    book.add_order(Side::BID, price_from_double(149.97), 1200);
+    book.add_order(Side::BID, price_from_double(149.96), 800);
+    book.add_order(Side::BID, price_from_double(149.95), 1800);
+    book.add_order(Side::BID, price_from_double(149.94), 900);
+    book.add_order(Side::BID, price_from_double(149.93), 1100);
+    book.add_order(Side::BID, price_from_double(149.92), 1300);
+    book.add_order(Side::BID, price_from_double(149.91), 700);
+    
+    // Asks (sell orders)
+    book.add_order(Side::ASK, price_from_double(150.01), 900);
+    book.add_order(Side::ASK, price_from_double(150.02), 1400);
+    book.add_order(Side::ASK, price_from_double(150.03), 1900);
+    book.add_order(Side::ASK, price_from_double(150.04), 1100);
+    book.add_order(Side::ASK, price_from_double(150.05), 750);
+    book.add_order(Side::ASK, price_from_double(150.06), 1600);
+    book.add_order(Side::ASK, price_from_double(150.07), 850);
+    book.add_order(Side::ASK, price_from_double(150.08), 1050);
+    book.add_order(Side::ASK, price_from_double(150.09), 1250);
+    book.add_order(Side::ASK, price_from_double(150.10), 650);
+    
+    // Print full book
+    BookPrinter::print(book, 10);
+    
+    // Print summary
+    std::cout << "Summary View:\n";
+    std::cout << "-------------\n";
+    BookPrinter::print_summary(book);
+    
+    // Simulate some trades
+    std::cout << "\nAfter executing 500 shares at best ask...\n";
+    book.modify_order(Side::ASK, price_from_double(150.01), -500);
+    BookPrinter::print_summary(book);
+    
+    std::cout << "\nAfter adding large bid...\n";
+    book.add_order(Side::BID, price_from_double(149.99), 5000);
+    BookPrinter::print_summary(book);
+    
+    // Show top 5 levels
+    std::cout << "\nTop 5 Levels:\n";
+    BookPrinter::print(book, 5);
+    
+    return 0;
+}
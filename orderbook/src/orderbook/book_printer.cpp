@@ -1,215 +1,398 @@
 // Order Book Visualization - Console Printer
 // Displays order book in human-readable format with bid/ask spread
 
-#include "orderbook/order_book.hpp"
+#include "orderbook/book_printer.hpp"
 #include "orderbook/price_level.hpp"
 
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <iomanip>
+#include <iostream>
 #include <sstream>
-#include <vector>
+#include <unistd.h>
 
 namespace orderbook {
 
-class BookPrinter {
-public:
-    /**
-     * @brief Print order book to console with formatting
-     * @param book Order book to print
-     * @param levels Number of levels to show (default 10)
-     */
-    static void print(const OrderBook& book, size_t levels = 10) {
-        print_header(book.get_symbol());
-        
-        // Get market depth
-        auto asks = book.get_depth(Side::ASK, levels);
-        auto bids = book.get_depth(Side::BID, levels);
-        
-        // Print asks (reversed - highest first)
-        print_asks(asks);
-        
-        // Print spread
-        print_spread(book);
-        
-        // Print bids (highest first)
-        print_bids(bids);
-        
-        print_footer();
-    }
-    
-    /**
-     * @brief Print compact one-line summary
-     */
-    static void print_summary(const OrderBook& book) {
-        auto best_bid = book.get_best_bid();
-        auto best_ask = book.get_best_ask();
-        
-        std::cout << book.get_symbol() << " | ";
-        
-        if (best_bid.price > 0) {
-            std::cout << "Bid: " << format_price(best_bid.price) 
-                     << " (" << best_bid.quantity << ") ";
-        } else {
-            std::cout << "Bid: --- ";
-        }
-        
-        std::cout << "| ";
-        
-        if (best_ask.price > 0) {
-            std::cout << "Ask: " << format_price(best_ask.price) 
-                     << " (" << best_ask.quantity << ") ";
-        } else {
-            std::cout << "Ask: --- ";
+namespace {
+
+void print_header(std::string_view symbol) {
+    std::cout << "\n";
+    std::cout << "╔════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║  ORDER BOOK: " << std::left << std::setw(43) << symbol << "║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║     PRICE     │    QUANTITY    │   ORDERS   │    SIDE    ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════╣\n";
+}
+
+std::string format_price(int64_t price_fixed, int64_t scale) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2) << price_to_double(price_fixed, scale);
+    return oss.str();
+}
+
+void print_level(const PriceLevel& level, Side side, int64_t scale) {
+    std::cout << "║ ";
+
+    // Price (right-aligned)
+    std::cout << std::right << std::setw(13) << format_price(level.price, scale) << " │ ";
+
+    // Quantity (right-aligned)
+    std::cout << std::right << std::setw(14) << level.quantity << " │ ";
+
+    // Order count (right-aligned)
+    std::cout << std::right << std::setw(10) << level.order_count << " │ ";
+
+    // Side with color indicator
+    if (side == Side::BID) {
+        std::cout << "   \033[32mBID\033[0m     ";  // Green
+    } else {
+        std::cout << "   \033[31mASK\033[0m     ";  // Red
+    }
+
+    std::cout << "║\n";
+}
+
+void print_spread(const OrderBook& book) {
+    auto best_bid = book.get_best_bid();
+    auto best_ask = book.get_best_ask();
+
+    std::cout << "╠════════════════════════════════════════════════════════════╣\n";
+
+    if (best_bid.price > 0 && best_ask.price > 0) {
+        int64_t spread = best_ask.price - best_bid.price;
+        int64_t mid = (best_bid.price + best_ask.price) / 2;
+        double spread_bps = (static_cast<double>(spread) / static_cast<double>(mid)) * 10000.0;
+
+        std::cout << "║  SPREAD: " << std::left << std::setw(12) << format_price(spread, book.price_scale())
+                 << " │ MID: " << std::left << std::setw(12) << format_price(mid, book.price_scale())
+                 << " │ " << std::fixed << std::setprecision(2) << std::setw(6) << spread_bps
+                 << " bps  ║\n";
+    } else {
+        std::cout << "║  SPREAD: ---           │ MID: ---           │ --- bps    ║\n";
+    }
+
+    std::cout << "╠════════════════════════════════════════════════════════════╣\n";
+}
+
+void print_footer() {
+    std::cout << "╚════════════════════════════════════════════════════════════╝\n";
+    std::cout << "\n";
+}
+
+// "00".."99", two digits per division in the integer-to-text paths
+constexpr auto DIGIT_PAIRS = [] {
+    std::array<char, 200> table{};
+    for (int i = 0; i < 100; ++i) {
+        table[2 * i] = static_cast<char>('0' + i / 10);
+        table[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return table;
+}();
+
+// Write value's digits ending just before end; returns the first digit
+char* put_digits(char* end, uint64_t value) {
+    while (value >= 100) {
+        size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        *--end = DIGIT_PAIRS[pair + 1];
+        *--end = DIGIT_PAIRS[pair];
+    }
+    if (value >= 10) {
+        size_t pair = static_cast<size_t>(value) * 2;
+        *--end = DIGIT_PAIRS[pair + 1];
+        *--end = DIGIT_PAIRS[pair];
+    } else {
+        *--end = static_cast<char>('0' + value);
+    }
+    return end;
+}
+
+// Fixed-point value as decimal text ending just before end, with as many
+// decimals as scale needs (10000 -> 4); returns the first character
+char* put_fixed(char* end, int64_t value, int64_t scale) {
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    uint64_t unit = scale > 0 ? static_cast<uint64_t>(scale) : 1;
+
+    uint64_t place = 1;
+    int decimals = 0;
+    while (place < unit) {
+        place *= 10;
+        ++decimals;
+    }
+    if (decimals > 0) {
+        uint64_t fraction = (magnitude % unit) * place / unit;
+        for (int i = 0; i < decimals; ++i) {
+            *--end = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
         }
-        
-        if (best_bid.price > 0 && best_ask.price > 0) {
-            int64_t spread = best_ask.price - best_bid.price;
-            int64_t mid = (best_bid.price + best_ask.price) / 2;
-            double spread_bps = (static_cast<double>(spread) / mid) * 10000.0;
-            std::cout << "| Spread: " << format_price(spread) 
-                     << " (" << std::fixed << std::setprecision(2) << spread_bps << " bps)";
+        *--end = '.';
+    }
+    end = put_digits(end, magnitude / unit);
+    if (value < 0) {
+        *--end = '-';
+    }
+    return end;
+}
+
+// Appends to a fixed-size line, truncating at its capacity
+class LineWriter {
+public:
+    LineWriter(char* text, uint8_t& length) : text_(text), length_(length) { length_ = 0; }
+
+    void append(const char* data, size_t size) {
+        size_t room = LiveBookPrinter::LINE_CAPACITY - length_;
+        size = std::min(size, room);
+        std::memcpy(text_ + length_, data, size);
+        length_ = static_cast<uint8_t>(length_ + size);
+    }
+
+    void append(std::string_view text) { append(text.data(), text.size()); }
+
+    // Right-align [begin, end) in a field of width
+    void append_right(const char* begin, const char* end, size_t width) {
+        size_t size = static_cast<size_t>(end - begin);
+        for (size_t i = size; i < width; ++i) {
+            append(" ", 1);
         }
-        
-        std::cout << std::endl;
+        append(begin, size);
     }
 
 private:
-    static void print_header(std::string_view symbol) {
-        std::cout << "\n";
-        std::cout << "╔════════════════════════════════════════════════════════════╗\n";
-        std::cout << "║  ORDER BOOK: " << std::left << std::setw(43) << symbol << "║\n";
-        std::cout << "╠════════════════════════════════════════════════════════════╣\n";
-        std::cout << "║     PRICE     │    QUANTITY    │   ORDERS   │    SIDE    ║\n";
-        std::cout << "╠════════════════════════════════════════════════════════════╣\n";
-    }
-    
-    static void print_asks(const std::vector<PriceLevel>& asks) {
-        // Print asks in reverse order (highest to lowest)
-        for (auto it = asks.rbegin(); it != asks.rend(); ++it) {
-            print_level(*it, Side::ASK);
-        }
+    char* text_;
+    uint8_t& length_;
+};
+
+constexpr size_t PRICE_WIDTH = 14;
+constexpr size_t QUANTITY_WIDTH = 16;
+constexpr size_t ORDERS_WIDTH = 12;
+
+} // namespace
+
+void BookPrinter::print(const OrderBook& book, int levels) {
+    print_header(book.get_symbol());
+
+    size_t depth = levels > 0 ? static_cast<size_t>(levels) : 0;
+    auto asks = book.get_depth(Side::ASK, depth);
+    auto bids = book.get_depth(Side::BID, depth);
+
+    // Asks reversed (highest first) so the spread sits in the middle
+    for (auto it = asks.rbegin(); it != asks.rend(); ++it) {
+        print_level(*it, Side::ASK, book.price_scale());
     }
-    
-    static void print_bids(const std::vector<PriceLevel>& bids) {
-        // Print bids in order (highest to lowest)
-        for (const auto& level : bids) {
-            print_level(level, Side::BID);
-        }
+
+    print_spread(book);
+
+    // Bids highest first
+    for (const auto& level : bids) {
+        print_level(level, Side::BID, book.price_scale());
+    }
+
+    print_footer();
+}
+
+void BookPrinter::print_detailed(const OrderBook& book, int levels, bool show_header) {
+    size_t depth = levels > 0 ? static_cast<size_t>(levels) : 0;
+    auto asks = book.get_depth(Side::ASK, depth);
+    auto bids = book.get_depth(Side::BID, depth);
+
+    if (show_header) {
+        std::cout << book.get_symbol() << " (" << book.level_count(Side::BID) << " bid / "
+                  << book.level_count(Side::ASK) << " ask levels)\n";
+        std::cout << std::right << std::setw(6) << "SIDE" << std::setw(14) << "PRICE"
+                  << std::setw(14) << "QUANTITY" << std::setw(10) << "ORDERS"
+                  << std::setw(16) << "CUMULATIVE" << "\n";
+    }
+
+    // Cumulative quantity runs outwards from the touch on each side
+    std::vector<int64_t> ask_totals(asks.size());
+    int64_t running = 0;
+    for (size_t i = 0; i < asks.size(); ++i) {
+        running += asks[i].quantity;
+        ask_totals[i] = running;
+    }
+    for (size_t i = asks.size(); i-- > 0;) {
+        std::cout << std::right << std::setw(6) << "ASK" << std::setw(14) << format_price(asks[i].price, book.price_scale())
+                  << std::setw(14) << asks[i].quantity << std::setw(10) << asks[i].order_count
+                  << std::setw(16) << ask_totals[i] << "\n";
+    }
+
+    running = 0;
+    for (const auto& level : bids) {
+        running += level.quantity;
+        std::cout << std::right << std::setw(6) << "BID" << std::setw(14) << format_price(level.price, book.price_scale())
+                  << std::setw(14) << level.quantity << std::setw(10) << level.order_count
+                  << std::setw(16) << running << "\n";
+    }
+    std::cout << std::flush;
+}
+
+void BookPrinter::print_summary(const OrderBook& book) {
+    auto best_bid = book.get_best_bid();
+    auto best_ask = book.get_best_ask();
+
+    std::cout << book.get_symbol() << " | ";
+
+    if (best_bid.price > 0) {
+        std::cout << "Bid: " << format_price(best_bid.price, book.price_scale())
+                 << " (" << best_bid.quantity << ") ";
+    } else {
+        std::cout << "Bid: --- ";
+    }
+
+    std::cout << "| ";
+
+    if (best_ask.price > 0) {
+        std::cout << "Ask: " << format_price(best_ask.price, book.price_scale())
+                 << " (" << best_ask.quantity << ") ";
+    } else {
+        std::cout << "Ask: --- ";
     }
-    
-    static void print_level(const PriceLevel& level, Side side) {
-        std::cout << "║ ";
-        
-        // Price (right-aligned)
-        std::cout << std::right << std::setw(13) << format_price(level.price) << " │ ";
-        
-        // Quantity (right-aligned)
-        std::cout << std::right << std::setw(14) << level.quantity << " │ ";
-        
-        // Order count (right-aligned)
-        std::cout << std::right << std::setw(10) << level.order_count << " │ ";
-        
-        // Side with color indicator
-        if (side == Side::BID) {
-            std::cout << "   \033[32mBID\033[0m     ";  // Green
-        } else {
-            std::cout << "   \033[31mASK\033[0m     ";  // Red
+
+    if (best_bid.price > 0 && best_ask.price > 0) {
+        int64_t spread = best_ask.price - best_bid.price;
+        int64_t mid = (best_bid.price + best_ask.price) / 2;
+        double spread_bps = (static_cast<double>(spread) / static_cast<double>(mid)) * 10000.0;
+        std::cout << "| Spread: " << format_price(spread, book.price_scale())
+                 << " (" << std::fixed << std::setprecision(2) << spread_bps << " bps)";
+    }
+
+    std::cout << std::endl;
+}
+
+LiveBookPrinter::LiveBookPrinter(size_t levels, int fd, int first_row)
+    : levels_(std::min(levels, OrderBook::CACHED_LEVELS))
+    , fd_(fd)
+    , first_row_(std::max(first_row, 1))
+    , line_count_(3 + 2 * levels_)
+    , front_(line_count_)
+    , back_(line_count_)
+    // Per line: "\033[<row>;1H" + text + "\033[K"
+    , out_(line_count_ * (LINE_CAPACITY + 32)) {
+}
+
+std::string_view LiveBookPrinter::line(size_t i) const {
+    if (i >= line_count_) {
+        return {};
+    }
+    return std::string_view(front_[i].text, front_[i].length);
+}
+
+ssize_t LiveBookPrinter::refresh(const OrderBook& book) {
+    render(book);
+
+    char* out = out_.data();
+    uint64_t changed = 0;
+    for (size_t i = 0; i < line_count_; ++i) {
+        const Line& next = back_[i];
+        const Line& shown = front_[i];
+        if (valid_ && next.length == shown.length && std::memcmp(next.text, shown.text, next.length) == 0) {
+            continue;
         }
-        
-        std::cout << "║\n";
-    }
-    
-    static void print_spread(const OrderBook& book) {
-        auto best_bid = book.get_best_bid();
-        auto best_ask = book.get_best_ask();
-        
-        std::cout << "╠════════════════════════════════════════════════════════════╣\n";
-        
-        if (best_bid.price > 0 && best_ask.price > 0) {
-            int64_t spread = best_ask.price - best_bid.price;
-            int64_t mid = (best_bid.price + best_ask.price) / 2;
-            double spread_bps = (static_cast<double>(spread) / mid) * 10000.0;
-            
-            std::cout << "║  SPREAD: " << std::left << std::setw(12) << format_price(spread)
-                     << " │ MID: " << std::left << std::setw(12) << format_price(mid)
-                     << " │ " << std::fixed << std::setprecision(2) << std::setw(6) << spread_bps 
-                     << " bps  ║\n";
-        } else {
-            std::cout << "║  SPREAD: ---           │ MID: ---           │ --- bps    ║\n";
+
+        char row[24];
+        char* row_begin = put_digits(row + sizeof(row), static_cast<uint64_t>(first_row_) + i);
+        std::memcpy(out, "\033[", 2);
+        out += 2;
+        size_t row_size = static_cast<size_t>(row + sizeof(row) - row_begin);
+        std::memcpy(out, row_begin, row_size);
+        out += row_size;
+        std::memcpy(out, ";1H", 3);
+        out += 3;
+        std::memcpy(out, next.text, next.length);
+        out += next.length;
+        std::memcpy(out, "\033[K", 3);  // Clear what a longer old line left behind
+        out += 3;
+        ++changed;
+    }
+    std::swap(front_, back_);
+    valid_ = true;
+
+    size_t size = static_cast<size_t>(out - out_.data());
+    lines_written_ += changed;
+    if (size == 0 || fd_ < 0) {
+        return static_cast<ssize_t>(size);
+    }
+
+    size_t written = 0;
+    while (written < size) {
+        ssize_t result = ::write(fd_, out_.data() + written, size - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            valid_ = false;  // Screen state unknown: redraw everything next time
+            return -1;
         }
-        
-        std::cout << "╠════════════════════════════════════════════════════════════╣\n";
+        written += static_cast<size_t>(result);
     }
-    
-    static void print_footer() {
-        std::cout << "╚════════════════════════════════════════════════════════════╝\n";
-        std::cout << "\n";
+    return static_cast<ssize_t>(written);
+}
+
+void LiveBookPrinter::render(const OrderBook& book) {
+    int64_t scale = book.price_scale();
+
+    LineWriter title(back_[0].text, back_[0].length);
+    title.append("ORDER BOOK: ");
+    title.append(book.get_symbol());
+
+    LineWriter columns(back_[1].text, back_[1].length);
+    columns.append("         PRICE        QUANTITY      ORDERS  SIDE");
+
+    // Asks highest first above the spread line, bids highest first below;
+    // rows beyond the book's depth render empty
+    auto asks = book.top_levels(Side::ASK, levels_);
+    auto bids = book.top_levels(Side::BID, levels_);
+    for (size_t i = 0; i < levels_; ++i) {
+        size_t level = levels_ - 1 - i;
+        render_level(back_[2 + i], level < asks.size() ? &asks[level] : nullptr, Side::ASK, scale);
+        render_level(back_[3 + levels_ + i], i < bids.size() ? &bids[i] : nullptr, Side::BID, scale);
     }
-    
-    static std::string format_price(int64_t price_fixed) {
-        std::ostringstream oss;
-        oss << std::fixed << std::setprecision(2) << price_to_double(price_fixed);
-        return oss.str();
+    render_spread(back_[2 + levels_], book);
+}
+
+void LiveBookPrinter::render_level(Line& line, const PriceLevel* level, Side side, int64_t scale) {
+    LineWriter writer(line.text, line.length);
+    if (!level) {
+        return;
     }
-};
 
-} // namespace orderbook
+    char field[32];
+    char* end = field + sizeof(field);
+    writer.append_right(put_fixed(end, level->price, scale), end, PRICE_WIDTH);
+    writer.append_right(put_fixed(end, level->quantity, 1), end, QUANTITY_WIDTH);
+    writer.append_right(put_digits(end, level->order_count), end, ORDERS_WIDTH);
+    writer.append(side == Side::BID ? "  \033[32mBID\033[0m" : "  \033[31mASK\033[0m");
+}
+
+void LiveBookPrinter::render_spread(Line& line, const OrderBook& book) {
+    LineWriter writer(line.text, line.length);
+    const PriceLevel& best_bid = book.get_best_bid();
+    const PriceLevel& best_ask = book.get_best_ask();
+    if (best_bid.price <= 0 || best_ask.price <= 0) {
+        writer.append("  SPREAD: ---  MID: ---  --- bps");
+        return;
+    }
 
-// Test program
-int main() {
-    using namespace orderbook;
-    
-    std::cout << "Order Book Visualization Demo\n";
-    std::cout << "==============================\n";
-    
-    // Create order book
-    OrderBook book("AAPL");
-    
-    // Add some orders to create a realistic book
-    // Bids (buy orders)
-    book.add_order(Side::BID, price_from_double(150.00), 1000);
-    book.add_order(Side::BID, price_from_double(149.99), 1500);
-    book.add_order(Side::BID, price_from_double(149.98), 2000);
-    book.add_order(Side::BID, price_from_double(149.97), 1200);
-    book.add_order(Side::BID, price_from_double(149.96), 800);
-    book.add_order(Side::BID, price_from_double(149.95), 1800);
-    book.add_order(Side::BID, price_from_double(149.94), 900);
-    book.add_order(Side::BID, price_from_double(149.93), 1100);
-    book.add_order(Side::BID, price_from_double(149.92), 1300);
-    book.add_order(Side::BID, price_from_double(149.91), 700);
-    
-    // Asks (sell orders)
-    book.add_order(Side::ASK, price_from_double(150.01), 900);
-    book.add_order(Side::ASK, price_from_double(150.02), 1400);
-    book.add_order(Side::ASK, price_from_double(150.03), 1900);
-    book.add_order(Side::ASK, price_from_double(150.04), 1100);
-    book.add_order(Side::ASK, price_from_double(150.05), 750);
-    book.add_order(Side::ASK, price_from_double(150.06), 1600);
-    book.add_order(Side::ASK, price_from_double(150.07), 850);
-    book.add_order(Side::ASK, price_from_double(150.08), 1050);
-    book.add_order(Side::ASK, price_from_double(150.09), 1250);
-    book.add_order(Side::ASK, price_from_double(150.10), 650);
-    
-    // Print full book
-    BookPrinter::print(book, 10);
-    
-    // Print summary
-    std::cout << "Summary View:\n";
-    std::cout << "-------------\n";
-    BookPrinter::print_summary(book);
-    
-    // Simulate some trades
-    std::cout << "\nAfter executing 500 shares at best ask...\n";
-    book.modify_order(Side::ASK, price_from_double(150.01), -500);
-    BookPrinter::print_summary(book);
-    
-    std::cout << "\nAfter adding large bid...\n";
-    book.add_order(Side::BID, price_from_double(149.99), 5000);
-    BookPrinter::print_summary(book);
-    
-    // Show top 5 levels
-    std::cout << "\nTop 5 Levels:\n";
-    BookPrinter::print(book, 5);
-    
-    return 0;
+    int64_t scale = book.price_scale();
+    int64_t spread = best_ask.price - best_bid.price;
+    int64_t mid = (best_bid.price + best_ask.price) / 2;
+
+    char field[32];
+    char* end = field + sizeof(field);
+    writer.append("  SPREAD: ");
+    char* text = put_fixed(end, spread, scale);
+    writer.append(text, static_cast<size_t>(end - text));
+    writer.append("  MID: ");
+    text = put_fixed(end, mid, scale);
+    writer.append(text, static_cast<size_t>(end - text));
+    writer.append("  ");
+    // Hundredths of a basis point, in integers
+    int64_t centi_bps = mid > 0 ? static_cast<int64_t>(static_cast<__int128>(spread) * 1000000 / mid) : 0;
+    text = put_fixed(end, centi_bps, 100);
+    writer.append(text, static_cast<size_t>(end - text));
+    writer.append(" bps");
 }
+
+} // namespace orderbook
@@ -1,12 +1,15 @@
 #include "orderbook/event_handler.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 namespace orderbook {
 
-OrderBookHandler::OrderBookHandler(const std::string& symbol)
+OrderBookHandler::OrderBookHandler(const std::string& symbol, BookMode mode,
+                                   const OrderBookConfig& config)
     : symbol_(symbol)
-    , order_book_(symbol)
+    , mode_(mode)
+    , l3_book_(symbol, config, mode == BookMode::ORDER_LEVEL ? 1024 : 0)
     , last_sequence_(0) {
 }
 
@@ -15,67 +18,151 @@ bool OrderBookHandler::on_new_order(const NewOrderEvent& event) {
         stats_.errors++;
         return false;
     }
+    return apply_new_order(event.order_id, event.side, event.price, event.quantity);
+}
+
+bool OrderBookHandler::on_modify_order(const ModifyOrderEvent& event) {
+    if (!validate_event(event)) {
+        stats_.errors++;
+        return false;
+    }
+    return apply_modify_order(event.order_id, event.side, event.price, event.new_quantity);
+}
+
+bool OrderBookHandler::on_delete_order(const DeleteOrderEvent& event) {
+    if (!validate_event(event)) {
+        stats_.errors++;
+        return false;
+    }
+    return apply_delete_order(event.order_id, event.side, event.price, event.quantity);
+}
+
+bool OrderBookHandler::on_trade(const TradeEvent& event) {
+    if (!validate_event(event)) {
+        stats_.errors++;
+        return false;
+    }
+    return apply_trade(event.buy_order_id, event.sell_order_id, event.price,
+                       event.quantity, event.aggressor_side);
+}
+
+bool OrderBookHandler::on_level_update(char action, Side side, int64_t price_fixed, int64_t size) {
+    if (mode_ != BookMode::AGGREGATED || price_fixed <= 0 || size < 0) {
+        stats_.errors++;
+        return false;
+    }
+    
+    OrderBook& book = get_order_book();
+    const PriceLevel* level = book.find_level(side, price_fixed);
+    
+    if (action == '2') {
+        if (!level) {
+            stats_.errors++;  // Delete for a level we never saw
+            return false;
+        }
+        book.delete_order(side, price_fixed, level->quantity);
+        stats_.deletions++;
+        return true;
+    }
+    
+    if (action != '0' && action != '1' && action != '\0') {
+        stats_.errors++;
+        return false;
+    }
+    
+    // New/change carry the level's total size: apply the difference
+    if (level) {
+        int64_t delta = size - level->quantity;
+        if (delta != 0) {
+            book.modify_order(side, price_fixed, delta);
+        }
+    } else if (size > 0) {
+        book.add_order(side, price_fixed, size);
+    }
     
-    // Convert double price to fixed-point int64_t (multiply by 100 for 2 decimal places)
-    int64_t price_fixed = static_cast<int64_t>(event.price * 100.0);
+    if (action == '1') {
+        stats_.modifications++;
+    } else {
+        stats_.new_orders++;
+    }
+    return true;
+}
+
+bool OrderBookHandler::apply_new_order(uint64_t order_id, Side side, int64_t price_fixed, int64_t quantity) {
+    if (mode_ == BookMode::ORDER_LEVEL) {
+        if (!l3_book_.add_order(order_id, side, price_fixed, quantity)) {
+            stats_.errors++;
+            return false;
+        }
+        stats_.new_orders++;
+        return true;
+    }
     
     // Side is already BID/ASK from order_book.hpp
     // Add order to book
-    order_book_.add_order(event.side, price_fixed, event.quantity);
+    get_order_book().add_order(side, price_fixed, quantity);
     
     stats_.new_orders++;
     return true;
 }
 
-bool OrderBookHandler::on_modify_order(const ModifyOrderEvent& event) {
-    if (!validate_event(event)) {
-        stats_.errors++;
-        return false;
+bool OrderBookHandler::apply_modify_order(uint64_t order_id, Side side, int64_t price_fixed,
+                                          int64_t new_quantity) {
+    if (mode_ == BookMode::ORDER_LEVEL) {
+        if (!l3_book_.modify_order(order_id, price_fixed, new_quantity)) {
+            stats_.errors++;
+            return false;
+        }
+        stats_.modifications++;
+        return true;
     }
     
-    // Convert double price to fixed-point int64_t
-    int64_t price_fixed = static_cast<int64_t>(event.price * 100.0);
-    
     // Modify order in book
-    order_book_.modify_order(event.side, price_fixed, event.new_quantity);
+    get_order_book().modify_order(side, price_fixed, new_quantity);
     
     stats_.modifications++;
     return true;
 }
 
-bool OrderBookHandler::on_delete_order(const DeleteOrderEvent& event) {
-    if (!validate_event(event)) {
-        stats_.errors++;
-        return false;
+bool OrderBookHandler::apply_delete_order(uint64_t order_id, Side side, int64_t price_fixed,
+                                          int64_t quantity) {
+    if (mode_ == BookMode::ORDER_LEVEL) {
+        if (!l3_book_.cancel_order(order_id)) {
+            stats_.errors++;
+            return false;
+        }
+        stats_.deletions++;
+        return true;
     }
     
-    // Convert double price to fixed-point int64_t
-    int64_t price_fixed = static_cast<int64_t>(event.price * 100.0);
-    
     // Delete order from book
-    order_book_.delete_order(event.side, price_fixed, event.quantity);
+    get_order_book().delete_order(side, price_fixed, quantity);
     
     stats_.deletions++;
     return true;
 }
 
-bool OrderBookHandler::on_trade(const TradeEvent& event) {
-    if (!validate_event(event)) {
-        stats_.errors++;
-        return false;
+bool OrderBookHandler::apply_trade(uint64_t buy_order_id, uint64_t sell_order_id, int64_t price_fixed,
+                                   int64_t quantity, Side aggressor_side) {
+    if (mode_ == BookMode::ORDER_LEVEL) {
+        // Only the passive (resting) order is in the book
+        uint64_t resting_id = (aggressor_side == Side::BID) ? sell_order_id : buy_order_id;
+        if (!l3_book_.execute_order(resting_id, quantity)) {
+            stats_.errors++;
+            return false;
+        }
+        stats_.trades++;
+        return true;
     }
     
-    // Convert double price to fixed-point int64_t
-    int64_t price_fixed = static_cast<int64_t>(event.price * 100.0);
-    
     // Trade execution reduces quantity on both sides
     // Aggressor side determines which side to reduce
-    if (event.aggressor_side == Side::BID) {
+    if (aggressor_side == Side::BID) {
         // Buy aggressor hits ask side
-        order_book_.delete_order(Side::ASK, price_fixed, event.quantity);
+        get_order_book().delete_order(Side::ASK, price_fixed, quantity);
     } else {
         // Sell aggressor hits bid side
-        order_book_.delete_order(Side::BID, price_fixed, event.quantity);
+        get_order_book().delete_order(Side::BID, price_fixed, quantity);
     }
     
     stats_.trades++;
@@ -88,36 +175,151 @@ bool OrderBookHandler::on_snapshot(const SnapshotEvent& event) {
         return false;
     }
     
-    // Clear existing book
-    order_book_.clear();
+    // Copy into book levels, then load both sides in bulk
+    auto convert = [](const SnapshotLevels& levels, std::vector<PriceLevel>& out) {
+        out.clear();
+        out.reserve(levels.size());
+        for (const auto& level : levels) {
+            uint32_t orders = level.order_count > 0 ? static_cast<uint32_t>(level.order_count) : 1;
+            out.emplace_back(level.price, level.quantity, orders);
+        }
+    };
+    convert(event.bids, snapshot_bids_);
+    convert(event.asks, snapshot_asks_);
+    return load_snapshot(event.sequence_number, snapshot_bids_, snapshot_asks_);
+}
+
+bool OrderBookHandler::load_snapshot(uint64_t sequence_number, std::span<const PriceLevel> bids,
+                                     std::span<const PriceLevel> asks) {
+    // Levels carry no order ids, so in ORDER_LEVEL mode only the
+    // aggregated view is restored; orders resume with new order events
+    l3_book_.load_levels(bids, asks);
     
     // Reset sequence number to snapshot sequence
-    last_sequence_ = event.sequence_number;
+    last_sequence_ = sequence_number;
     
-    // Rebuild from snapshot
-    // Add all bid levels
-    for (const auto& level : event.bids) {
-        int64_t price_fixed = static_cast<int64_t>(level.price * 100.0);
-        order_book_.add_order(Side::BID, price_fixed, level.quantity);
+    stats_.snapshots++;
+    if (is_recovering()) {
+        replay_buffered();
     }
+    return true;
+}
+
+void OrderBookHandler::enable_gap_recovery(GapRecoveryConfig config) {
+    recovery_ = std::make_unique<GapRecovery>();
+    recovery_->ring.resize(std::max<size_t>(config.buffer_capacity, 1));
+    recovery_->config = std::move(config);
+}
+
+void OrderBookHandler::start_recovery() {
+    recovery_->active = true;
+    gap_stats_.recoveries++;
+    if (recovery_->config.request_snapshot) {
+        recovery_->config.request_snapshot(symbol_, last_sequence_ + 1);
+    }
+}
+
+void OrderBookHandler::buffer_event(const MarketEventValue& event) {
+    GapRecovery& r = *recovery_;
+    if (r.count == r.ring.size()) {
+        // Full: drop the oldest; the snapshot most likely covers it
+        r.head = (r.head + 1) % r.ring.size();
+        r.count--;
+        gap_stats_.buffer_overflows++;
+    }
+    r.ring[(r.head + r.count) % r.ring.size()] = event;
+    r.count++;
+    gap_stats_.messages_buffered++;
+}
+
+void OrderBookHandler::replay_buffered() {
+    GapRecovery& r = *recovery_;
+    
+    // Linearize the ring, then order by sequence; the feed may have
+    // delivered events out of order around the gap
+    std::rotate(r.ring.begin(), r.ring.begin() + static_cast<std::ptrdiff_t>(r.head), r.ring.end());
+    r.head = 0;
+    auto buffered_end = r.ring.begin() + static_cast<std::ptrdiff_t>(r.count);
+    std::stable_sort(r.ring.begin(), buffered_end, [](const MarketEventValue& a, const MarketEventValue& b) {
+        return a.sequence_number < b.sequence_number;
+    });
     
-    // Add all ask levels
-    for (const auto& level : event.asks) {
-        int64_t price_fixed = static_cast<int64_t>(level.price * 100.0);
-        order_book_.add_order(Side::ASK, price_fixed, level.quantity);
+    size_t i = 0;
+    for (; i < r.count; ++i) {
+        const MarketEventValue& event = r.ring[i];
+        if (event.sequence_number <= last_sequence_) {
+            continue;  // Covered by the snapshot, or a duplicate
+        }
+        if (event.sequence_number != last_sequence_ + 1) {
+            break;  // Still missing events after the snapshot
+        }
+        last_sequence_ = event.sequence_number;
+        dispatch(event);
+        gap_stats_.messages_replayed++;
     }
     
-    stats_.snapshots++;
-    return true;
+    // Keep what is beyond a remaining hole and ask again
+    r.head = i;
+    r.count -= i;
+    r.active = false;
+    if (r.count > 0) {
+        start_recovery();
+    }
 }
 
 bool OrderBookHandler::process_event(const MarketEvent& event) {
+    // A snapshot resets the sequence rather than continuing it
+    if (event.type == EventType::SNAPSHOT) {
+        return on_snapshot(static_cast<const SnapshotEvent&>(event));
+    }
+    
+    // Recovery buffers value events, so take the value path
+    if (recovery_) {
+        MarketEventValue value;
+        switch (event.type) {
+            case EventType::NEW_ORDER: {
+                const auto& e = static_cast<const NewOrderEvent&>(event);
+                value = MarketEventValue::make_new_order(e.sequence_number, e.timestamp_ns, e.symbol,
+                                                         e.order_id, e.side, e.price, e.quantity);
+                break;
+            }
+            case EventType::MODIFY_ORDER: {
+                const auto& e = static_cast<const ModifyOrderEvent&>(event);
+                value = MarketEventValue::make_modify_order(e.sequence_number, e.timestamp_ns, e.symbol,
+                                                            e.order_id, e.side, e.price,
+                                                            e.new_quantity, e.quantity_delta);
+                break;
+            }
+            case EventType::DELETE_ORDER: {
+                const auto& e = static_cast<const DeleteOrderEvent&>(event);
+                value = MarketEventValue::make_delete_order(e.sequence_number, e.timestamp_ns, e.symbol,
+                                                            e.order_id, e.side, e.price, e.quantity);
+                break;
+            }
+            case EventType::TRADE: {
+                const auto& e = static_cast<const TradeEvent&>(event);
+                value = MarketEventValue::make_trade(e.sequence_number, e.timestamp_ns, e.symbol,
+                                                     e.trade_id, e.buy_order_id, e.sell_order_id,
+                                                     e.price, e.quantity, e.aggressor_side);
+                break;
+            }
+            default:
+                std::cerr << "Unknown event type" << std::endl;
+                stats_.errors++;
+                return false;
+        }
+        return process_event(value);
+    }
+    
     // Validate sequence number
     if (!validate_sequence(event.sequence_number)) {
+        if (event.sequence_number <= last_sequence_) {
+            return false;  // Stale or duplicate, counted by validate_sequence
+        }
         std::cerr << "Sequence gap detected: expected " << (last_sequence_ + 1)
                   << ", got " << event.sequence_number << std::endl;
         gap_stats_.gaps_detected++;
-        // In production, would request snapshot here
+        // See enable_gap_recovery() to recover instead of dropping
         return false;
     }
     
@@ -134,9 +336,6 @@ bool OrderBookHandler::process_event(const MarketEvent& event) {
         case EventType::TRADE:
             return on_trade(static_cast<const TradeEvent&>(event));
             
-        case EventType::SNAPSHOT:
-            return on_snapshot(static_cast<const SnapshotEvent&>(event));
-            
         default:
             std::cerr << "Unknown event type" << std::endl;
             stats_.errors++;
@@ -144,6 +343,68 @@ bool OrderBookHandler::process_event(const MarketEvent& event) {
     }
 }
 
+bool OrderBookHandler::process_event(const MarketEventValue& event) {
+    // Waiting for a snapshot: everything queues behind it
+    if (is_recovering()) {
+        buffer_event(event);
+        return true;
+    }
+    
+    // Validate sequence number
+    if (!validate_sequence(event.sequence_number)) {
+        if (event.sequence_number <= last_sequence_) {
+            return false;  // Stale or duplicate, counted by validate_sequence
+        }
+        std::cerr << "Sequence gap detected: expected " << (last_sequence_ + 1)
+                  << ", got " << event.sequence_number << std::endl;
+        gap_stats_.gaps_detected++;
+        if (recovery_) {
+            start_recovery();
+            buffer_event(event);
+            return true;
+        }
+        return false;
+    }
+    
+    return dispatch(event);
+}
+
+bool OrderBookHandler::dispatch(const MarketEventValue& event) {
+    if (!validate_event(event)) {
+        stats_.errors++;
+        return false;
+    }
+    
+    switch (event.type) {
+        case EventType::NEW_ORDER: {
+            const auto& e = event.new_order;
+            return apply_new_order(e.order_id, e.side, e.price, e.quantity);
+        }
+        
+        case EventType::MODIFY_ORDER: {
+            const auto& e = event.modify_order;
+            return apply_modify_order(e.order_id, e.side, e.price, e.new_quantity);
+        }
+        
+        case EventType::DELETE_ORDER: {
+            const auto& e = event.delete_order;
+            return apply_delete_order(e.order_id, e.side, e.price, e.quantity);
+        }
+        
+        case EventType::TRADE: {
+            const auto& e = event.trade;
+            return apply_trade(e.buy_order_id, e.sell_order_id, e.price,
+                               e.quantity, e.aggressor_side);
+        }
+        
+        default:
+            // Snapshots are not representable as value events
+            std::cerr << "Unsupported value event type" << std::endl;
+            stats_.errors++;
+            return false;
+    }
+}
+
 bool OrderBookHandler::validate_sequence(uint64_t seq) {
     // First message or snapshot resets sequence
     if (last_sequence_ == 0) {
@@ -151,6 +412,12 @@ bool OrderBookHandler::validate_sequence(uint64_t seq) {
         return true;
     }
     
+    // Replayed or duplicated message: not a gap
+    if (seq <= last_sequence_) {
+        gap_stats_.stale_messages++;
+        return false;
+    }
+    
     // Check for gap
     if (seq != last_sequence_ + 1) {
         gap_stats_.messages_dropped += (seq - last_sequence_ - 1);
@@ -224,4 +491,48 @@ bool OrderBookHandler::validate_event(const MarketEvent& event) const {
     return true;
 }
 
+bool OrderBookHandler::validate_event(const MarketEventValue& event) const {
+    // Check symbol matches (string_view compare, no allocation)
+    if (event.symbol.view() != symbol_) {
+        std::cerr << "Symbol mismatch: expected " << symbol_ 
+                  << ", got " << event.symbol.view() << std::endl;
+        return false;
+    }
+    
+    if (event.timestamp_ns == 0) {
+        std::cerr << "Invalid timestamp: 0" << std::endl;
+        return false;
+    }
+    
+    int64_t price = 0;
+    bool quantity_ok = false;
+    switch (event.type) {
+        case EventType::NEW_ORDER:
+            price = event.new_order.price;
+            quantity_ok = event.new_order.quantity > 0;
+            break;
+        case EventType::MODIFY_ORDER:
+            price = event.modify_order.price;
+            quantity_ok = event.modify_order.new_quantity >= 0;
+            break;
+        case EventType::DELETE_ORDER:
+            price = event.delete_order.price;
+            quantity_ok = event.delete_order.quantity > 0;
+            break;
+        case EventType::TRADE:
+            price = event.trade.price;
+            quantity_ok = event.trade.quantity > 0;
+            break;
+        default:
+            return false;
+    }
+    
+    if (price <= 0 || !quantity_ok) {
+        std::cerr << "Invalid price or quantity" << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
 } // namespace orderbook
@@ -1,30 +1,97 @@
 #include "orderbook/feed_integration.hpp"
+#include "benchmarks/stage_profiler.hpp"
+#include "parser/repeating_group_parser.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 namespace orderbook {
 
-FeedIntegration::FeedIntegration() {
+namespace {
+
+// Scale of common::Tick and MDEntry prices (feedhandler::common::double_to_price)
+constexpr int64_t FEED_PRICE_SCALE = DEFAULT_PRICE_SCALE;
+
+} // namespace
+
+FeedIntegration::FeedIntegration(const OrderBookConfig& default_config)
+    : default_config_(default_config) {
+}
+
+void FeedIntegration::set_book_config(std::string_view symbol, const OrderBookConfig& config) {
+    auto it = book_configs_.find(symbol);
+    if (it != book_configs_.end()) {
+        it->second = config;
+    } else {
+        book_configs_.emplace(std::string(symbol), config);
+    }
+}
+
+void FeedIntegration::set_stage_profiler(feedhandler::benchmarks::StageProfiler* profiler) {
+    stage_profiler_ = profiler;
+    if (profiler) {
+        book_stage_ = profiler->add_stage("book_update");
+    }
+}
+
+void FeedIntegration::enable_gap_recovery(const GapRecoveryConfig& config) {
+    gap_recovery_ = config;
+    for (auto& [symbol, handler] : handlers_) {
+        handler->enable_gap_recovery(config);
+    }
 }
 
 bool FeedIntegration::process_tick(const feedhandler::common::Tick& tick) {
+    feedhandler::benchmarks::StageProfiler::Sample sample;
+    if (stage_profiler_) {
+        sample = stage_profiler_->begin();
+    }
+    uint64_t start = latency_stamp();
+    bool success = apply_tick(tick);
+    record_book_latency(start, latency_stamp());
+    if (stage_profiler_) {
+        stage_profiler_->end(book_stage_, sample);
+    }
+    if (wire_to_book_) {
+        record_latency(std::span<const feedhandler::common::Tick>(&tick, 1));
+    }
+    return success;
+}
+
+bool FeedIntegration::apply_tick(const feedhandler::common::Tick& tick) {
     stats_.ticks_processed++;
     
-    // Get symbol from tick
-    std::string symbol(tick.symbol.data(), tick.symbol.size());
+    // Convert tick to market event (on the stack, no allocation)
+    MarketEventValue event;
+    if (!tick_to_event(tick, event)) {
+        stats_.errors++;
+        return false;
+    }
     
-    // Get or create handler for this symbol
-    auto& handler = get_handler(symbol);
+    // Route by instrument ID (flat vector, no hashing when the parser set it)
+    feedhandler::common::InstrumentId id = tick.instrument_id;
+    if (id == feedhandler::common::INVALID_INSTRUMENT) {
+        id = feedhandler::common::SymbolTable::global().intern(event.symbol.view());
+    }
     
-    // Convert tick to market event
-    auto event = tick_to_event(tick);
-    if (!event) {
+    OrderBookHandler* handler = get_handler(id);
+    if (!handler) {
         stats_.errors++;
         return false;
     }
     
+    // Without a feed sequence, a tick follows on from the book's last one
+    if (event.sequence_number == 0) {
+        event.sequence_number = handler->get_last_sequence() + 1;
+        event.new_order.order_id = event.sequence_number;
+    }
+    
+    // Ticks carry the feed's scale; a book may be configured with its own
+    event.new_order.price = rescale_price(event.new_order.price, FEED_PRICE_SCALE,
+                                          handler->get_order_book().price_scale());
+    
     // Process event through handler
-    bool success = handler.process_event(*event);
+    bool success = handler->process_event(event);
     if (success) {
         stats_.events_generated++;
     } else {
@@ -34,19 +101,169 @@ bool FeedIntegration::process_tick(const feedhandler::common::Tick& tick) {
     return success;
 }
 
-OrderBookHandler& FeedIntegration::get_handler(const std::string& symbol) {
+size_t FeedIntegration::process_ticks(std::span<const feedhandler::common::Tick> ticks) {
+    size_t processed = 0;
+    feedhandler::benchmarks::StageProfiler::Sample sample;
+    if (stage_profiler_) {
+        sample = stage_profiler_->begin();
+    }
+    uint64_t start = latency_stamp();
+    for (const auto& tick : ticks) {
+        if (apply_tick(tick)) {
+            ++processed;
+        }
+        // One counter read per tick: this tick's end is the next one's start
+        uint64_t end = latency_stamp();
+        record_book_latency(start, end);
+        start = end;
+    }
+    if (stage_profiler_) {
+        stage_profiler_->end(book_stage_, sample);
+    }
+    if (wire_to_book_) {
+        record_latency(ticks);
+    }
+    return processed;
+}
+
+size_t FeedIntegration::replay(feedhandler::pipeline::TimestampMerger<feedhandler::common::Tick>& merger, size_t batch) {
+    std::vector<feedhandler::common::Tick> scratch(batch > 0 ? batch : 1);
+    size_t processed = 0;
+    merger.drain(std::span<feedhandler::common::Tick>(scratch), [&](std::span<const feedhandler::common::Tick> ticks) {
+        processed += process_ticks(ticks);
+    });
+    return processed;
+}
+
+void FeedIntegration::record_latency(std::span<const feedhandler::common::Tick> ticks) {
+    uint64_t now = feedhandler::common::Tick::current_timestamp_ns();
+    for (const auto& tick : ticks) {
+        if (tick.timestamp != 0) {
+            wire_to_book_->record(now > tick.timestamp ? now - tick.timestamp : 0);
+        }
+    }
+}
+
+size_t FeedIntegration::process_market_data(std::string_view message) {
+    using feedhandler::parser::RepeatingGroupParser;
+    
+    size_t applied = 0;
+    feedhandler::benchmarks::StageProfiler::Sample sample;
+    if (stage_profiler_) {
+        sample = stage_profiler_->begin();
+    }
+    uint64_t start = latency_stamp();
+    RepeatingGroupParser::for_each_entry(message, [&](const RepeatingGroupParser::MDEntry& entry) {
+        stats_.entries_processed++;
+        if (entry.entry_type != '0' && entry.entry_type != '1') {
+            return true;  // Trades, imbalances etc. do not change depth
+        }
+        
+        OrderBookHandler* handler = get_handler(entry.instrument_id);
+        if (!handler) {
+            stats_.errors++;
+            return true;
+        }
+        
+        // Same conversion the tick path uses: none unless the book has its own scale
+        Side side = (entry.entry_type == '0') ? Side::BID : Side::ASK;
+        int64_t price = rescale_price(entry.price, FEED_PRICE_SCALE,
+                                      handler->get_order_book().price_scale());
+        if (handler->on_level_update(entry.update_action, side, price, entry.size)) {
+            stats_.events_generated++;
+            ++applied;
+        } else {
+            stats_.errors++;
+        }
+        return true;
+    });
+    record_book_latency(start, latency_stamp());
+    if (stage_profiler_) {
+        stage_profiler_->end(book_stage_, sample);
+    }
+    return applied;
+}
+
+void FeedIntegration::record_book_latency(uint64_t start, uint64_t end) {
+    if (start != 0 && end > start) {
+        book_latency_.record(feedhandler::common::TscClock::global().ticks_to_ns(end - start));
+    }
+}
+
+OrderBookHandler& FeedIntegration::get_handler(std::string_view symbol) {
     auto it = handlers_.find(symbol);
     if (it == handlers_.end()) {
         // Create new handler for this symbol
-        auto handler = std::make_unique<OrderBookHandler>(symbol);
+        std::string key(symbol);
+        auto config = book_configs_.find(symbol);
+        auto handler = std::make_unique<OrderBookHandler>(
+            key, BookMode::AGGREGATED, config != book_configs_.end() ? config->second : default_config_);
+        if (gap_recovery_) {
+            handler->enable_gap_recovery(*gap_recovery_);
+        }
         auto& ref = *handler;
-        handlers_[symbol] = std::move(handler);
+        handlers_.emplace(std::move(key), std::move(handler));
         return ref;
     }
     return *it->second;
 }
 
-OrderBook* FeedIntegration::get_order_book(const std::string& symbol) {
+OrderBookHandler* FeedIntegration::get_handler(feedhandler::common::InstrumentId instrument_id) {
+    if (__builtin_expect(instrument_id < handlers_by_id_.size() &&
+                         handlers_by_id_[instrument_id] != nullptr, 1)) {
+        return handlers_by_id_[instrument_id];
+    }
+    
+    std::string_view symbol = feedhandler::common::SymbolTable::global().name(instrument_id);
+    if (symbol.empty()) {
+        return nullptr;  // Unknown instrument
+    }
+    
+    if (instrument_id >= handlers_by_id_.size()) {
+        handlers_by_id_.resize(instrument_id + 1, nullptr);
+    }
+    handlers_by_id_[instrument_id] = &get_handler(symbol);
+    return handlers_by_id_[instrument_id];
+}
+
+std::unique_ptr<OrderBookHandler> FeedIntegration::release_handler(feedhandler::common::InstrumentId instrument_id) {
+    std::string_view symbol = feedhandler::common::SymbolTable::global().name(instrument_id);
+    auto it = handlers_.find(symbol);
+    if (symbol.empty() || it == handlers_.end()) {
+        return nullptr;
+    }
+    
+    std::unique_ptr<OrderBookHandler> handler = std::move(it->second);
+    handlers_.erase(it);
+    if (instrument_id < handlers_by_id_.size()) {
+        handlers_by_id_[instrument_id] = nullptr;
+    }
+    return handler;
+}
+
+bool FeedIntegration::adopt_handler(feedhandler::common::InstrumentId instrument_id,
+                                    std::unique_ptr<OrderBookHandler> handler) {
+    std::string_view symbol = feedhandler::common::SymbolTable::global().name(instrument_id);
+    if (!handler || symbol.empty() || handlers_.find(symbol) != handlers_.end()) {
+        return false;
+    }
+    
+    if (instrument_id >= handlers_by_id_.size()) {
+        handlers_by_id_.resize(instrument_id + 1, nullptr);
+    }
+    handlers_by_id_[instrument_id] = handler.get();
+    handlers_.emplace(std::string(symbol), std::move(handler));
+    return true;
+}
+
+OrderBook* FeedIntegration::get_order_book(feedhandler::common::InstrumentId instrument_id) {
+    if (instrument_id >= handlers_by_id_.size() || handlers_by_id_[instrument_id] == nullptr) {
+        return nullptr;
+    }
+    return &handlers_by_id_[instrument_id]->get_order_book();
+}
+
+OrderBook* FeedIntegration::get_order_book(std::string_view symbol) {
     auto it = handlers_.find(symbol);
     if (it == handlers_.end()) {
         return nullptr;
@@ -54,6 +271,52 @@ OrderBook* FeedIntegration::get_order_book(const std::string& symbol) {
     return &it->second->get_order_book();
 }
 
+size_t FeedIntegration::warm_up(std::span<const std::string> symbols) {
+    return warm_up(symbols, WarmupConfig());
+}
+
+size_t FeedIntegration::warm_up(std::span<const std::string> symbols, const WarmupConfig& config) {
+    size_t applied = 0;
+    for (const auto& symbol : symbols) {
+        feedhandler::common::InstrumentId id = feedhandler::common::SymbolTable::global().intern(symbol);
+        OrderBookHandler* handler = get_handler(id);
+        if (!handler) {
+            std::cerr << "[FeedIntegration] Cannot warm up " << symbol << std::endl;
+            continue;
+        }
+        OrderBook& book = handler->get_order_book();
+        book.reserve_levels(config.levels_per_side);
+        
+        // One book tick in feed scale, so ARRAY books see on-grid prices
+        auto entry = book_configs_.find(symbol);
+        const int64_t tick_size = (entry != book_configs_.end() ? entry->second : default_config_).tick_size;
+        const int64_t step = std::max<int64_t>(rescale_price(tick_size, book.price_scale(), FEED_PRICE_SCALE), 1);
+        const int64_t mid = (100 * FEED_PRICE_SCALE / step) * step;
+        
+        feedhandler::common::Tick tick;
+        tick.symbol = symbol;
+        tick.instrument_id = id;
+        tick.qty = 100;
+        tick.timestamp = feedhandler::common::Tick::current_timestamp_ns();
+        for (size_t round = 0; round < config.rounds; ++round) {
+            for (size_t level = 0; level < config.levels_per_side; ++level) {
+                const int64_t offset = static_cast<int64_t>(level + 1) * step;
+                tick.side = 'B';
+                tick.price = mid - offset;
+                applied += apply_tick(tick);
+                tick.side = 'S';
+                tick.price = mid + offset;
+                applied += apply_tick(tick);
+            }
+            // Empty book, sequence 0: the levels' nodes stay reserved
+            handler->load_snapshot(0, {}, {});
+        }
+        handler->reset_stats();
+    }
+    reset_stats();
+    return applied;
+}
+
 std::vector<std::string> FeedIntegration::get_symbols() const {
     std::vector<std::string> symbols;
     symbols.reserve(handlers_.size());
@@ -65,32 +328,26 @@ std::vector<std::string> FeedIntegration::get_symbols() const {
     return symbols;
 }
 
-std::unique_ptr<MarketEvent> FeedIntegration::tick_to_event(const feedhandler::common::Tick& tick) {
-    // Extract symbol
-    std::string symbol(tick.symbol.data(), tick.symbol.size());
-    
-    // Convert price from fixed-point to double
-    double price = feedhandler::common::price_to_double(tick.price);
-    
+bool FeedIntegration::tick_to_event(const feedhandler::common::Tick& tick, MarketEventValue& event) {
     // Determine side from tick.side ('B' or 'S')
     Side side = (tick.side == 'B') ? Side::BID : Side::ASK;
     
-    // Generate sequence number from timestamp
-    uint64_t seq = tick.timestamp;
-    
-    // Create NewOrderEvent (simplified - in real system would parse order type)
-    // Using timestamp as order_id for simplicity
-    auto event = std::make_unique<NewOrderEvent>(
-        seq,                    // sequence number
+    // Create NewOrderEvent (simplified - in real system would parse order type).
+    // The timestamp is the receive time, shared by every tick of one read,
+    // so it is neither sequence nor order id; both are the feed sequence,
+    // or 0 for apply_tick() to fill in
+    event = MarketEventValue::make_new_order(
+        tick.sequence,          // sequence number
         tick.timestamp,         // timestamp
-        symbol,                 // symbol
-        tick.timestamp,         // order_id (using timestamp as proxy)
+        tick.symbol,            // symbol (copied inline)
+        tick.sequence,          // order_id (sequence as proxy)
         side,                   // side
-        price,                  // price
+        tick.price,             // price (feed scale, fixed-point)
         tick.qty                // quantity
     );
     
-    return event;
+    // Symbols longer than the inline buffer are rejected
+    return !event.symbol.empty();
 }
 
 } // namespace orderbook
@@ -0,0 +1,306 @@
+#include "orderbook/l3_order_book.hpp"
+
+namespace orderbook {
+
+// ============================================================================
+// OrderIdMap
+// ============================================================================
+
+OrderIdMap::OrderIdMap(size_t expected_orders)
+    : mask_(0)
+    , size_(0) {
+    // Keep load factor <= 0.5
+    size_t capacity = 16;
+    while (capacity < expected_orders * 2) {
+        capacity *= 2;
+    }
+    buckets_.assign(capacity, Bucket{0, NO_ORDER});
+    mask_ = capacity - 1;
+}
+
+uint32_t OrderIdMap::find(uint64_t order_id) const {
+    size_t i = bucket_of(order_id);
+    while (buckets_[i].slot != NO_ORDER) {
+        if (buckets_[i].key == order_id) {
+            return buckets_[i].slot;
+        }
+        i = (i + 1) & mask_;
+    }
+    return NO_ORDER;
+}
+
+bool OrderIdMap::insert(uint64_t order_id, uint32_t slot) {
+    if ((size_ + 1) * 2 > buckets_.size()) {
+        grow();
+    }
+
+    size_t i = bucket_of(order_id);
+    while (buckets_[i].slot != NO_ORDER) {
+        if (buckets_[i].key == order_id) {
+            return false;  // Duplicate order id
+        }
+        i = (i + 1) & mask_;
+    }
+
+    buckets_[i] = Bucket{order_id, slot};
+    ++size_;
+    return true;
+}
+
+void OrderIdMap::erase(uint64_t order_id) {
+    size_t i = bucket_of(order_id);
+    while (buckets_[i].slot != NO_ORDER && buckets_[i].key != order_id) {
+        i = (i + 1) & mask_;
+    }
+    if (buckets_[i].slot == NO_ORDER) {
+        return;  // Not present
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into
+    // the hole unless they already sit at or after their home bucket
+    size_t hole = i;
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask_;
+        if (buckets_[j].slot == NO_ORDER) {
+            break;
+        }
+        size_t home = bucket_of(buckets_[j].key);
+        // Entry at j may move to hole if home is not in (hole, j]
+        bool in_range = (hole < j) ? (home > hole && home <= j)
+                                   : (home > hole || home <= j);
+        if (!in_range) {
+            buckets_[hole] = buckets_[j];
+            hole = j;
+        }
+    }
+    buckets_[hole] = Bucket{0, NO_ORDER};
+    --size_;
+}
+
+void OrderIdMap::clear() {
+    for (auto& bucket : buckets_) {
+        bucket = Bucket{0, NO_ORDER};
+    }
+    size_ = 0;
+}
+
+void OrderIdMap::grow() {
+    std::vector<Bucket> old;
+    old.swap(buckets_);
+
+    buckets_.assign(old.size() * 2, Bucket{0, NO_ORDER});
+    mask_ = buckets_.size() - 1;
+
+    for (const auto& bucket : old) {
+        if (bucket.slot == NO_ORDER) continue;
+        size_t i = bucket_of(bucket.key);
+        while (buckets_[i].slot != NO_ORDER) {
+            i = (i + 1) & mask_;
+        }
+        buckets_[i] = bucket;
+    }
+}
+
+// ============================================================================
+// L3OrderBook
+// ============================================================================
+
+L3OrderBook::L3OrderBook(std::string_view symbol, const OrderBookConfig& config,
+                         size_t expected_orders)
+    : book_(symbol, config)
+    , index_(expected_orders) {
+    orders_.reserve(expected_orders);
+    free_slots_.reserve(expected_orders);
+}
+
+bool L3OrderBook::add_order(uint64_t order_id, Side side, int64_t price, int64_t quantity) {
+    if (quantity <= 0) {
+        return false;  // Ignore invalid quantities
+    }
+    if (index_.find(order_id) != NO_ORDER) {
+        return false;  // Duplicate order id
+    }
+
+    book_.add_order(side, price, quantity);
+    PriceLevel* level = book_.find_level(side, price);
+    if (!level) {
+        return false;  // Rejected by ladder (off-tick price)
+    }
+
+    uint32_t slot = acquire_slot();
+    Order& order = orders_[slot];
+    order.order_id = order_id;
+    order.price = price;
+    order.quantity = quantity;
+    order.side = side;
+
+    link_back(*level, slot);
+    index_.insert(order_id, slot);
+    return true;
+}
+
+bool L3OrderBook::modify_order(uint64_t order_id, int64_t price, int64_t new_quantity) {
+    uint32_t slot = index_.find(order_id);
+    if (slot == NO_ORDER) {
+        return false;
+    }
+
+    if (new_quantity <= 0) {
+        remove(slot);
+        return true;
+    }
+
+    Order& order = orders_[slot];
+
+    if (price != order.price) {
+        // Price change loses priority. Queue at the new price first so a
+        // rejected price (off-tick, out of window) leaves the order resting
+        book_.add_order(order.side, price, new_quantity);
+        if (!book_.find_level(order.side, price)) {
+            return false;
+        }
+
+        // Levels may have moved (ladder re-anchor): look each one up again
+        if (PriceLevel* old_level = book_.find_level(order.side, order.price)) {
+            unlink(*old_level, slot);
+        }
+        book_.delete_order(order.side, order.price, order.quantity);
+
+        order.price = price;
+        order.quantity = new_quantity;
+        link_back(*book_.find_level(order.side, price), slot);
+        return true;
+    }
+
+    int64_t delta = new_quantity - order.quantity;
+    if (delta == 0) {
+        return true;
+    }
+
+    PriceLevel* level = book_.find_level(order.side, order.price);
+    level->quantity += delta;
+    order.quantity = new_quantity;
+
+    if (delta > 0 && order.next != NO_ORDER) {
+        // Size increase loses priority: move to back of queue
+        unlink(*level, slot);
+        link_back(*level, slot);
+    }
+    book_.level_updated(order.side, order.price);
+    return true;
+}
+
+bool L3OrderBook::cancel_order(uint64_t order_id) {
+    uint32_t slot = index_.find(order_id);
+    if (slot == NO_ORDER) {
+        return false;
+    }
+    remove(slot);
+    return true;
+}
+
+bool L3OrderBook::execute_order(uint64_t order_id, int64_t quantity) {
+    if (quantity <= 0) {
+        return false;
+    }
+
+    uint32_t slot = index_.find(order_id);
+    if (slot == NO_ORDER) {
+        return false;
+    }
+
+    Order& order = orders_[slot];
+    if (quantity >= order.quantity) {
+        remove(slot);
+        return true;
+    }
+
+    // Partial fill keeps priority
+    book_.find_level(order.side, order.price)->quantity -= quantity;
+    book_.level_updated(order.side, order.price);
+    order.quantity -= quantity;
+    return true;
+}
+
+const Order* L3OrderBook::find_order(uint64_t order_id) const {
+    uint32_t slot = index_.find(order_id);
+    return slot == NO_ORDER ? nullptr : &orders_[slot];
+}
+
+void L3OrderBook::clear() {
+    book_.clear();
+    orders_.clear();
+    free_slots_.clear();
+    index_.clear();
+}
+
+size_t L3OrderBook::load_levels(std::span<const PriceLevel> bids, std::span<const PriceLevel> asks) {
+    orders_.clear();
+    free_slots_.clear();
+    index_.clear();
+    return book_.load_levels(bids, asks);
+}
+
+uint32_t L3OrderBook::acquire_slot() {
+    if (!free_slots_.empty()) {
+        uint32_t slot = free_slots_.back();
+        free_slots_.pop_back();
+        return slot;
+    }
+    orders_.emplace_back();
+    return static_cast<uint32_t>(orders_.size() - 1);
+}
+
+void L3OrderBook::release_slot(uint32_t slot) {
+    orders_[slot] = Order();
+    free_slots_.push_back(slot);
+}
+
+void L3OrderBook::link_back(PriceLevel& level, uint32_t slot) {
+    Order& order = orders_[slot];
+    order.prev = level.tail_order;
+    order.next = NO_ORDER;
+
+    if (level.tail_order != NO_ORDER) {
+        orders_[level.tail_order].next = slot;
+    } else {
+        level.head_order = slot;
+    }
+    level.tail_order = slot;
+}
+
+void L3OrderBook::unlink(PriceLevel& level, uint32_t slot) {
+    Order& order = orders_[slot];
+
+    if (order.prev != NO_ORDER) {
+        orders_[order.prev].next = order.next;
+    } else {
+        level.head_order = order.next;
+    }
+
+    if (order.next != NO_ORDER) {
+        orders_[order.next].prev = order.prev;
+    } else {
+        level.tail_order = order.prev;
+    }
+
+    order.prev = NO_ORDER;
+    order.next = NO_ORDER;
+}
+
+void L3OrderBook::remove(uint32_t slot) {
+    Order& order = orders_[slot];
+
+    if (PriceLevel* level = book_.find_level(order.side, order.price)) {
+        unlink(*level, slot);
+    }
+
+    // Removes the level once its last order goes
+    book_.delete_order(order.side, order.price, order.quantity);
+
+    index_.erase(order.order_id);
+    release_slot(slot);
+}
+
+} // namespace orderbook
@@ -4,8 +4,170 @@
 
 namespace orderbook {
 
-OrderBook::OrderBook(std::string_view symbol) 
-    : symbol_(symbol) {
+namespace {
+
+// Level state while folding a batch: exists, quantity, order count
+struct FoldedLevel {
+    bool exists = false;
+    int64_t quantity = 0;
+    uint32_t order_count = 0;
+    
+    bool operator==(const FoldedLevel& other) const = default;
+};
+
+// Apply one update with add_order/modify_order/delete_order semantics
+void fold(FoldedLevel& level, const BookUpdate& update) {
+    switch (update.action) {
+        case BookUpdate::Action::ADD:
+            if (update.quantity <= 0) return;
+            if (!level.exists) {
+                level = FoldedLevel{true, 0, 0};
+            }
+            level.quantity += update.quantity;
+            level.order_count++;
+            break;
+        case BookUpdate::Action::MODIFY:
+            if (!level.exists) return;
+            level.quantity += update.quantity;
+            break;
+        case BookUpdate::Action::DELETE:
+            if (update.quantity <= 0 || !level.exists) return;
+            level.quantity -= update.quantity;
+            if (level.order_count > 0) {
+                level.order_count--;
+            }
+            break;
+    }
+    if (level.quantity <= 0) {
+        level.exists = false;
+    }
+}
+
+// Spare nodes for a map side (OrderBook::reserve_levels). Erased levels
+// park their node while the stash has room; new levels take one rather
+// than allocate. Without a reserve the stash has no room and the map
+// allocates and frees as usual.
+template<typename Map>
+using SpareNodes = std::vector<typename Map::node_type>;
+
+template<typename Map>
+void insert_level(Map& map, SpareNodes<Map>& spare, typename Map::const_iterator hint,
+                  const PriceLevel& level) {
+    if (spare.empty()) {
+        map.emplace_hint(hint, level.price, level);
+        return;
+    }
+    auto node = std::move(spare.back());
+    spare.pop_back();
+    node.key() = level.price;
+    node.mapped() = level;
+    map.insert(hint, std::move(node));
+}
+
+template<typename Map>
+void erase_level(Map& map, SpareNodes<Map>& spare, typename Map::iterator it) {
+    if (spare.size() < spare.capacity()) {
+        spare.push_back(map.extract(it));
+    } else {
+        map.erase(it);
+    }
+}
+
+template<typename Map>
+void clear_levels(Map& map, SpareNodes<Map>& spare) {
+    while (!map.empty() && spare.size() < spare.capacity()) {
+        spare.push_back(map.extract(map.begin()));
+    }
+    map.clear();
+}
+
+// Allocate nodes until the side holds levels between map and stash
+template<typename Map>
+void reserve_nodes(const Map& map, SpareNodes<Map>& spare, size_t levels) {
+    spare.reserve(levels);
+    Map fresh;
+    for (size_t i = map.size() + spare.size(); i < levels; ++i) {
+        fresh.emplace(static_cast<int64_t>(i), PriceLevel());
+    }
+    while (!fresh.empty()) {
+        spare.push_back(fresh.extract(fresh.begin()));
+    }
+}
+
+// Existing level at price, or end() with hint set to where it would go
+template<typename Map>
+typename Map::iterator find_level_hint(Map& map, int64_t price, typename Map::iterator& hint) {
+    hint = map.lower_bound(price);
+    return hint != map.end() && hint->first == price ? hint : map.end();
+}
+
+// Fold updates[first, last) of one level into a map side, one lookup
+// @return Whether the level changed
+template<typename Map>
+bool apply_folded(Map& map, SpareNodes<Map>& spare, int64_t price, std::span<const BookUpdate> updates,
+                  const uint32_t* first, const uint32_t* last) {
+    typename Map::iterator hint;
+    auto it = find_level_hint(map, price, hint);
+    FoldedLevel level;
+    if (it != map.end()) {
+        level = FoldedLevel{true, it->second.quantity, it->second.order_count};
+    }
+    const FoldedLevel before = level;
+    for (const uint32_t* i = first; i != last; ++i) {
+        fold(level, updates[*i]);
+    }
+    if (level == before) {
+        return false;
+    }
+    
+    if (!level.exists) {
+        if (it != map.end()) {
+            erase_level(map, spare, it);
+        }
+    } else if (it != map.end()) {
+        it->second.quantity = level.quantity;
+        it->second.order_count = level.order_count;
+    } else {
+        insert_level(map, spare, hint, PriceLevel(price, level.quantity, level.order_count));
+    }
+    return true;
+}
+
+// Replace a map side with levels in map order, recycling its nodes
+// (and spare ones); nodes left over go back to the stash
+template<typename Map>
+size_t assign_levels(Map& map, SpareNodes<Map>& spare, std::span<const PriceLevel> levels) {
+    Map recycled;
+    recycled.swap(map);
+    for (const auto& level : levels) {
+        if (level.quantity <= 0) {
+            continue;
+        }
+        PriceLevel loaded(level.price, level.quantity, level.order_count);
+        if (recycled.empty()) {
+            insert_level(map, spare, map.end(), loaded);
+            continue;
+        }
+        auto node = recycled.extract(recycled.begin());
+        node.key() = level.price;
+        node.mapped() = loaded;
+        map.insert(map.end(), std::move(node));  // Duplicate price: node is freed
+    }
+    clear_levels(recycled, spare);
+    return map.size();
+}
+
+} // namespace
+
+OrderBook::OrderBook(std::string_view symbol, const OrderBookConfig& config) 
+    : symbol_(symbol)
+    , ladder_type_(config.ladder_type)
+    , price_scale_(config.price_scale > 0 ? config.price_scale : DEFAULT_PRICE_SCALE)
+    , bid_ladder_(true, config.tick_size,
+                  config.ladder_type == LadderType::ARRAY ? config.initial_levels : 0, config.max_levels)
+    , ask_ladder_(false, config.tick_size,
+                  config.ladder_type == LadderType::ARRAY ? config.initial_levels : 0, config.max_levels)
+    , published_(config.publish_snapshots ? std::make_unique<Published>() : nullptr) {
 }
 
 void OrderBook::add_order(Side side, int64_t price, int64_t quantity) {
@@ -13,30 +175,54 @@ void OrderBook::add_order(Side side, int64_t price, int64_t quantity) {
         return;  // Ignore invalid quantities
     }
     
+    if (ladder_type_ == LadderType::ARRAY) {
+        // Creates an empty level if needed; nullptr means off-tick or out of window
+        if (PriceLevel* level = ladder(side).insert(price)) {
+            level->quantity += quantity;
+            level->order_count++;
+            level_updated(side, price);
+        }
+        return;
+    }
+    
     if (side == Side::BID) {
-        auto it = bids_.find(price);
+        BidMap::iterator hint;
+        auto it = find_level_hint(bids_, price, hint);
         if (it != bids_.end()) {
             // Price level exists, update it
             it->second.quantity += quantity;
             it->second.order_count++;
         } else {
             // New price level
-            bids_[price] = PriceLevel(price, quantity, 1);
+            insert_level(bids_, spare_bids_, hint, PriceLevel(price, quantity, 1));
         }
     } else {  // ASK
-        auto it = asks_.find(price);
+        AskMap::iterator hint;
+        auto it = find_level_hint(asks_, price, hint);
         if (it != asks_.end()) {
             // Price level exists, update it
             it->second.quantity += quantity;
             it->second.order_count++;
         } else {
             // New price level
-            asks_[price] = PriceLevel(price, quantity, 1);
+            insert_level(asks_, spare_asks_, hint, PriceLevel(price, quantity, 1));
         }
     }
+    level_updated(side, price);
 }
 
 void OrderBook::modify_order(Side side, int64_t price, int64_t quantity_delta) {
+    if (ladder_type_ == LadderType::ARRAY) {
+        if (PriceLevel* level = ladder(side).find(price)) {
+            level->quantity += quantity_delta;
+            if (level->quantity <= 0) {
+                ladder(side).erase(price);
+            }
+            level_updated(side, price);
+        }
+        return;
+    }
+    
     if (side == Side::BID) {
         auto it = bids_.find(price);
         if (it != bids_.end()) {
@@ -44,7 +230,7 @@ void OrderBook::modify_order(Side side, int64_t price, int64_t quantity_delta) {
             
             // Remove price level if quantity becomes zero or negative
             if (it->second.quantity <= 0) {
-                bids_.erase(it);
+                erase_level(bids_, spare_bids_, it);
             }
         }
     } else {  // ASK
@@ -54,10 +240,11 @@ void OrderBook::modify_order(Side side, int64_t price, int64_t quantity_delta) {
             
             // Remove price level if quantity becomes zero or negative
             if (it->second.quantity <= 0) {
-                asks_.erase(it);
+                erase_level(asks_, spare_asks_, it);
             }
         }
     }
+    level_updated(side, price);
 }
 
 void OrderBook::delete_order(Side side, int64_t price, int64_t quantity) {
@@ -65,6 +252,20 @@ void OrderBook::delete_order(Side side, int64_t price, int64_t quantity) {
         return;  // Ignore invalid quantities
     }
     
+    if (ladder_type_ == LadderType::ARRAY) {
+        if (PriceLevel* level = ladder(side).find(price)) {
+            level->quantity -= quantity;
+            if (level->order_count > 0) {
+                level->order_count--;
+            }
+            if (level->quantity <= 0) {
+                ladder(side).erase(price);
+            }
+            level_updated(side, price);
+        }
+        return;
+    }
+    
     if (side == Side::BID) {
         auto it = bids_.find(price);
         if (it != bids_.end()) {
@@ -75,7 +276,7 @@ void OrderBook::delete_order(Side side, int64_t price, int64_t quantity) {
             
             // Remove price level if quantity becomes zero or negative
             if (it->second.quantity <= 0) {
-                bids_.erase(it);
+                erase_level(bids_, spare_bids_, it);
             }
         }
     } else {  // ASK
@@ -88,56 +289,251 @@ void OrderBook::delete_order(Side side, int64_t price, int64_t quantity) {
             
             // Remove price level if quantity becomes zero or negative
             if (it->second.quantity <= 0) {
-                asks_.erase(it);
+                erase_level(asks_, spare_asks_, it);
             }
         }
     }
+    level_updated(side, price);
 }
 
-PriceLevel OrderBook::get_best_bid() const {
-    if (bids_.empty()) {
-        return PriceLevel();  // Empty price level
+size_t OrderBook::apply_batch(std::span<const BookUpdate> updates) {
+    // Group by side and price. The index breaks ties so each level sees
+    // its updates in order; std::stable_sort would allocate a buffer per batch
+    batch_order_.resize(updates.size());
+    for (uint32_t i = 0; i < updates.size(); ++i) {
+        batch_order_[i] = i;
     }
+    std::sort(batch_order_.begin(), batch_order_.end(), [&updates](uint32_t a, uint32_t b) {
+        if (updates[a].side != updates[b].side) {
+            return updates[a].side < updates[b].side;
+        }
+        if (updates[a].price != updates[b].price) {
+            return updates[a].price < updates[b].price;
+        }
+        return a < b;
+    });
     
-    // std::map with std::greater: first element is highest price
-    return bids_.begin()->second;
+    // Whether a level can matter to the cache, judged before the batch:
+    // anything at or better than the last cached level, or anything at
+    // all while the side has fewer levels than the cache holds
+    auto reaches_top = [this](Side side, int64_t price) {
+        const DepthCache& c = cache(side);
+        if (c.count < CACHED_LEVELS) {
+            return true;
+        }
+        int64_t worst = c.levels[CACHED_LEVELS - 1].price;
+        return side == Side::BID ? price >= worst : price <= worst;
+    };
+    bool top_touched[2] = {false, false};
+    
+    size_t levels = 0;
+    const uint32_t* order = batch_order_.data();
+    for (size_t begin = 0; begin < batch_order_.size();) {
+        const BookUpdate& head = updates[order[begin]];
+        size_t end = begin + 1;
+        while (end < batch_order_.size() && updates[order[end]].side == head.side &&
+               updates[order[end]].price == head.price) {
+            ++end;
+        }
+        
+        bool changed = false;
+        if (ladder_type_ == LadderType::ARRAY) {
+            ArrayPriceLadder& side_ladder = ladder(head.side);
+            PriceLevel* existing = side_ladder.find(head.price);
+            FoldedLevel level;
+            if (existing) {
+                level = FoldedLevel{true, existing->quantity, existing->order_count};
+            }
+            const FoldedLevel before = level;
+            for (size_t i = begin; i < end; ++i) {
+                fold(level, updates[order[i]]);
+            }
+            if (level == before) {
+                // Unchanged
+            } else if (!level.exists) {
+                side_ladder.erase(head.price);
+                changed = true;
+            } else if (PriceLevel* target = existing ? existing : side_ladder.insert(head.price)) {
+                target->quantity = level.quantity;
+                target->order_count = level.order_count;
+                changed = true;
+            }
+        } else if (head.side == Side::BID) {
+            changed = apply_folded(bids_, spare_bids_, head.price, updates, order + begin, order + end);
+        } else {
+            changed = apply_folded(asks_, spare_asks_, head.price, updates, order + begin, order + end);
+        }
+        
+        if (changed) {
+            top_touched[head.side == Side::BID ? 0 : 1] |= reaches_top(head.side, head.price);
+        }
+        ++levels;
+        begin = end;
+    }
+    
+    // One cache refresh, version bump and publish for the whole batch,
+    // and none when no level within reach of the cache changed
+    if (top_touched[0] || top_touched[1]) {
+        if (top_touched[0]) {
+            rebuild_cache(Side::BID);
+        }
+        if (top_touched[1]) {
+            rebuild_cache(Side::ASK);
+        }
+        ++version_;
+        publish();
+    }
+    return levels;
 }
 
-PriceLevel OrderBook::get_best_ask() const {
-    if (asks_.empty()) {
-        return PriceLevel();  // Empty price level
+size_t OrderBook::load_levels(std::span<const PriceLevel> bids, std::span<const PriceLevel> asks) {
+    size_t loaded;
+    if (ladder_type_ == LadderType::ARRAY) {
+        loaded = bid_ladder_.assign(bids) + ask_ladder_.assign(asks);
+    } else {
+        loaded = assign_levels(bids_, spare_bids_, bids) + assign_levels(asks_, spare_asks_, asks);
     }
-    
-    // std::map with std::less: first element is lowest price
-    return asks_.begin()->second;
+    rebuild_cache(Side::BID);
+    rebuild_cache(Side::ASK);
+    ++version_;
+    publish();
+    return loaded;
+}
+
+const PriceLevel& OrderBook::get_best_bid() const {
+    static const PriceLevel empty;
+    return bid_cache_.count > 0 ? bid_cache_.levels[0] : empty;
+}
+
+const PriceLevel& OrderBook::get_best_ask() const {
+    static const PriceLevel empty;
+    return ask_cache_.count > 0 ? ask_cache_.levels[0] : empty;
 }
 
 int64_t OrderBook::get_spread() const {
-    if (bids_.empty() || asks_.empty()) {
+    if (bid_cache_.count == 0 || ask_cache_.count == 0) {
         return -1;  // Invalid spread
     }
-    
-    int64_t best_bid_price = bids_.begin()->first;
-    int64_t best_ask_price = asks_.begin()->first;
-    
-    return best_ask_price - best_bid_price;
+    return ask_cache_.levels[0].price - bid_cache_.levels[0].price;
 }
 
 int64_t OrderBook::get_mid_price() const {
-    if (bids_.empty() || asks_.empty()) {
+    if (bid_cache_.count == 0 || ask_cache_.count == 0) {
         return 0;  // Invalid mid price
     }
+    return (bid_cache_.levels[0].price + ask_cache_.levels[0].price) / 2;
+}
+
+std::span<const PriceLevel> OrderBook::top_levels(Side side, size_t levels) const {
+    const DepthCache& c = cache(side);
+    return std::span<const PriceLevel>(c.levels.data(), std::min(levels, c.count));
+}
+
+void OrderBook::level_updated(Side side, int64_t price) {
+    DepthCache& c = cache(side);
+    auto better = [side](int64_t a, int64_t b) { return side == Side::BID ? a > b : a < b; };
+    
+    // A full cache holds nothing worse than its last level: nothing to do
+    if (c.count == CACHED_LEVELS && better(c.levels[CACHED_LEVELS - 1].price, price)) {
+        return;
+    }
     
-    int64_t best_bid_price = bids_.begin()->first;
-    int64_t best_ask_price = asks_.begin()->first;
+    size_t i = 0;
+    while (i < c.count && better(c.levels[i].price, price)) {
+        ++i;
+    }
+    bool cached = i < c.count && c.levels[i].price == price;
+    const PriceLevel* level = find_level(side, price);
     
-    return (best_bid_price + best_ask_price) / 2;
+    if (level && cached) {
+        c.levels[i] = *level;
+    } else if (level) {
+        // New level inside the cached range: shift the worse ones down
+        size_t last = std::min(c.count, CACHED_LEVELS - 1);
+        for (size_t j = last; j > i; --j) {
+            c.levels[j] = c.levels[j - 1];
+        }
+        c.levels[i] = *level;
+        c.count = std::min(c.count + 1, CACHED_LEVELS);
+    } else if (cached) {
+        if (level_count(side) >= c.count) {
+            rebuild_cache(side);  // Next level below the cache moves up
+        } else {
+            for (size_t j = i; j + 1 < c.count; ++j) {
+                c.levels[j] = c.levels[j + 1];
+            }
+            --c.count;
+        }
+    } else {
+        return;  // Nothing cached at this price and no level there
+    }
+    ++version_;
+    publish();
+}
+
+void OrderBook::publish() {
+    if (!published_) {
+        return;
+    }
+    Snapshot snapshot;
+    std::copy_n(bid_cache_.levels.begin(), bid_cache_.count, snapshot.bids.begin());
+    std::copy_n(ask_cache_.levels.begin(), ask_cache_.count, snapshot.asks.begin());
+    snapshot.bid_count = static_cast<uint32_t>(bid_cache_.count);
+    snapshot.ask_count = static_cast<uint32_t>(ask_cache_.count);
+    snapshot.version = version_;
+    published_->snapshot.store(snapshot);
+    published_->version.store(version_, std::memory_order_release);
+}
+
+bool OrderBook::read_snapshot(Snapshot& snapshot) const {
+    if (!published_) {
+        return false;
+    }
+    published_->snapshot.load(snapshot);
+    return true;
+}
+
+uint64_t OrderBook::published_version() const {
+    return published_ ? published_->version.load(std::memory_order_acquire) : 0;
+}
+
+void OrderBook::rebuild_cache(Side side) {
+    DepthCache& c = cache(side);
+    c.count = 0;
+    auto append = [&c](const PriceLevel& level) {
+        c.levels[c.count++] = level;
+        return c.count < CACHED_LEVELS;
+    };
+    
+    if (ladder_type_ == LadderType::ARRAY) {
+        ladder(side).for_each(append);
+    } else if (side == Side::BID) {
+        for (const auto& [price, level] : bids_) {
+            if (!append(level)) break;
+        }
+    } else {
+        for (const auto& [price, level] : asks_) {
+            if (!append(level)) break;
+        }
+    }
 }
 
 std::vector<PriceLevel> OrderBook::get_depth(Side side, size_t levels) const {
     std::vector<PriceLevel> depth;
     depth.reserve(levels);
     
+    // Served from the cache when it holds everything asked for
+    const DepthCache& c = cache(side);
+    if (levels <= c.count || c.count < CACHED_LEVELS) {
+        depth.assign(c.levels.begin(), c.levels.begin() + static_cast<std::ptrdiff_t>(std::min(levels, c.count)));
+        return depth;
+    }
+    
+    if (ladder_type_ == LadderType::ARRAY) {
+        ladder(side).collect(depth, levels);
+        return depth;
+    }
+    
     if (side == Side::BID) {
         size_t count = 0;
         for (const auto& [price, level] : bids_) {
@@ -157,16 +553,56 @@ std::vector<PriceLevel> OrderBook::get_depth(Side side, size_t levels) const {
     return depth;
 }
 
+PriceLevel* OrderBook::find_level(Side side, int64_t price) {
+    if (ladder_type_ == LadderType::ARRAY) {
+        return ladder(side).find(price);
+    }
+    
+    if (side == Side::BID) {
+        auto it = bids_.find(price);
+        return it != bids_.end() ? &it->second : nullptr;
+    } else {
+        auto it = asks_.find(price);
+        return it != asks_.end() ? &it->second : nullptr;
+    }
+}
+
+const PriceLevel* OrderBook::find_level(Side side, int64_t price) const {
+    return const_cast<OrderBook*>(this)->find_level(side, price);
+}
+
 void OrderBook::clear() {
-    bids_.clear();
-    asks_.clear();
+    clear_levels(bids_, spare_bids_);
+    clear_levels(asks_, spare_asks_);
+    bid_ladder_.clear();
+    ask_ladder_.clear();
+    bid_cache_.count = 0;
+    ask_cache_.count = 0;
+    ++version_;
+    publish();
+}
+
+void OrderBook::reserve_levels(size_t levels) {
+    if (ladder_type_ == LadderType::ARRAY) {
+        bid_ladder_.reserve(levels);
+        ask_ladder_.reserve(levels);
+        return;
+    }
+    reserve_nodes(bids_, spare_bids_, levels);
+    reserve_nodes(asks_, spare_asks_, levels);
 }
 
 size_t OrderBook::level_count(Side side) const {
+    if (ladder_type_ == LadderType::ARRAY) {
+        return ladder(side).size();
+    }
     return (side == Side::BID) ? bids_.size() : asks_.size();
 }
 
 bool OrderBook::is_empty() const {
+    if (ladder_type_ == LadderType::ARRAY) {
+        return bid_ladder_.empty() && ask_ladder_.empty();
+    }
     return bids_.empty() && asks_.empty();
 }
 
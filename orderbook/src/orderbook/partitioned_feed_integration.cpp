@@ -0,0 +1,305 @@
+#include "orderbook/partitioned_feed_integration.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace orderbook {
+
+using feedhandler::common::CompactTick;
+using feedhandler::common::InstrumentId;
+using feedhandler::common::SymbolTable;
+using feedhandler::common::Tick;
+
+PartitionedFeedIntegration::Worker::Worker(const Config& config)
+    : integration(config.book_config) {
+}
+
+PartitionedFeedIntegration::PartitionedFeedIntegration()
+    : PartitionedFeedIntegration(Config()) {
+}
+
+PartitionedFeedIntegration::PartitionedFeedIntegration(const Config& config)
+    : config_(config) {
+    size_t count = std::clamp<size_t>(config_.worker_count, 1, UNROUTED);
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.push_back(std::make_unique<Worker>(config_));
+    }
+}
+
+PartitionedFeedIntegration::~PartitionedFeedIntegration() {
+    stop();
+}
+
+bool PartitionedFeedIntegration::start() {
+    if (running_) {
+        return false;
+    }
+    for (auto& worker : workers_) {
+        worker->inbound = std::make_unique<feedhandler::threading::SpscRing<Inbound>>(
+            config_.queue_capacity, config_.wait_strategy);
+        worker->thread = std::thread([this, &worker = *worker] { run(worker); });
+    }
+    running_ = true;
+    return true;
+}
+
+void PartitionedFeedIntegration::stop() {
+    if (!running_) {
+        return;
+    }
+    // Workers drain their rings before pop() reports the shutdown
+    for (auto& worker : workers_) {
+        worker->inbound->shutdown();
+    }
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    running_ = false;
+}
+
+bool PartitionedFeedIntegration::route(const Tick& tick) {
+    if (!running_) {
+        return false;
+    }
+
+    InstrumentId id = tick.instrument_id;
+    if (id == feedhandler::common::INVALID_INSTRUMENT) {
+        id = SymbolTable::global().intern(tick.symbol);
+        if (id == feedhandler::common::INVALID_INSTRUMENT) {
+            return false;
+        }
+    }
+
+    if (id >= route_.size()) {
+        route_.resize(id + 1, UNROUTED);
+        instrument_load_.resize(id + 1, 0);
+    }
+    if (route_[id] == UNROUTED) {
+        route_[id] = static_cast<uint16_t>(hash_worker(SymbolTable::global().name(id)));
+        workers_[route_[id]]->instruments++;
+    }
+
+    Worker& worker = *workers_[route_[id]];
+    Inbound item;
+    item.tick.price = tick.price;
+    item.tick.timestamp = tick.timestamp;
+    item.tick.instrument_id = id;
+    item.tick.qty = tick.qty;
+    item.tick.side = tick.side;
+    item.sequence = tick.sequence;
+    push(worker, std::move(item));
+
+    worker.ticks_routed++;
+    worker.load++;
+    instrument_load_[id]++;
+    return true;
+}
+
+size_t PartitionedFeedIntegration::route_batch(std::span<const Tick> ticks) {
+    size_t routed = 0;
+    for (const auto& tick : ticks) {
+        if (route(tick)) {
+            ++routed;
+        }
+    }
+    return routed;
+}
+
+bool PartitionedFeedIntegration::rebalance() {
+    auto restart_counts = [this] {
+        std::fill(instrument_load_.begin(), instrument_load_.end(), 0);
+        for (auto& worker : workers_) {
+            worker->load = 0;
+        }
+    };
+
+    if (workers_.size() < 2) {
+        restart_counts();
+        return false;
+    }
+
+    auto by_load = [](const std::unique_ptr<Worker>& a, const std::unique_ptr<Worker>& b) {
+        return a->load < b->load;
+    };
+    size_t busiest = static_cast<size_t>(std::max_element(workers_.begin(), workers_.end(), by_load) - workers_.begin());
+    size_t idlest = static_cast<size_t>(std::min_element(workers_.begin(), workers_.end(), by_load) - workers_.begin());
+    uint64_t high = workers_[busiest]->load;
+    uint64_t low = workers_[idlest]->load;
+    if (high == 0 || static_cast<double>(high) <= static_cast<double>(low) * (1.0 + config_.rebalance_threshold)) {
+        restart_counts();
+        return false;
+    }
+
+    // Moving an instrument with load l leaves the pair |gap - 2l| apart:
+    // pick the one closest to half the gap, if it narrows it at all
+    uint64_t gap = high - low;
+    InstrumentId best = feedhandler::common::INVALID_INSTRUMENT;
+    uint64_t best_gap = gap;
+    for (size_t id = 0; id < route_.size(); ++id) {
+        uint64_t load = instrument_load_[id];
+        if (route_[id] != busiest || load == 0 || load >= gap) {
+            continue;
+        }
+        uint64_t remaining = 2 * load > gap ? 2 * load - gap : gap - 2 * load;
+        if (remaining < best_gap) {
+            best_gap = remaining;
+            best = static_cast<InstrumentId>(id);
+        }
+    }
+
+    restart_counts();
+    return best != feedhandler::common::INVALID_INSTRUMENT && move_instrument(best, idlest);
+}
+
+bool PartitionedFeedIntegration::move_instrument(InstrumentId instrument_id, size_t worker) {
+    if (instrument_id >= route_.size() || route_[instrument_id] == UNROUTED || worker >= workers_.size()) {
+        return false;
+    }
+    size_t from = route_[instrument_id];
+    if (from == worker) {
+        return true;
+    }
+
+    if (running_) {
+        // The old worker releases after the instrument's queued ticks; the
+        // new one adopts before any tick routed from here on
+        Handoff& handoff = handoffs_.emplace_back();
+        handoff.instrument_id = instrument_id;
+
+        Inbound release;
+        release.kind = Inbound::Kind::RELEASE;
+        release.handoff = &handoff;
+        push(*workers_[from], std::move(release));
+
+        Inbound adopt;
+        adopt.kind = Inbound::Kind::ADOPT;
+        adopt.handoff = &handoff;
+        push(*workers_[worker], std::move(adopt));
+    } else {
+        auto handler = workers_[from]->integration.release_handler(instrument_id);
+        if (handler && !workers_[worker]->integration.adopt_handler(instrument_id, std::move(handler))) {
+            std::cerr << "Failed to move book for instrument " << instrument_id << std::endl;
+        }
+    }
+
+    route_[instrument_id] = static_cast<uint16_t>(worker);
+    workers_[from]->instruments--;
+    workers_[worker]->instruments++;
+    return true;
+}
+
+void PartitionedFeedIntegration::flush() {
+    if (!running_) {
+        return;
+    }
+    for (auto& worker : workers_) {
+        while (worker->completed.load(std::memory_order_acquire) < worker->pushed) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+size_t PartitionedFeedIntegration::worker_for(InstrumentId instrument_id) const {
+    if (instrument_id >= route_.size() || route_[instrument_id] == UNROUTED) {
+        return workers_.size();
+    }
+    return route_[instrument_id];
+}
+
+size_t PartitionedFeedIntegration::hash_worker(std::string_view symbol) const {
+    // FNV-1a, as ShardedFeedHandler::shard_for
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : symbol) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash % workers_.size());
+}
+
+PartitionedFeedIntegration::WorkerStats PartitionedFeedIntegration::worker_stats(size_t worker) const {
+    WorkerStats stats;
+    if (worker >= workers_.size()) {
+        return stats;
+    }
+    const Worker& w = *workers_[worker];
+    stats.ticks_routed = w.ticks_routed;
+    stats.ticks_applied = w.ticks_applied.load(std::memory_order_acquire);
+    stats.backpressure_waits = w.backpressure_waits;
+    stats.instruments = w.instruments;
+    return stats;
+}
+
+OrderBook* PartitionedFeedIntegration::get_order_book(std::string_view symbol) {
+    for (auto& worker : workers_) {
+        if (OrderBook* book = worker->integration.get_order_book(symbol)) {
+            return book;
+        }
+    }
+    return nullptr;
+}
+
+void PartitionedFeedIntegration::push(Worker& worker, Inbound&& item) {
+    worker.pushed++;
+    if (worker.inbound->try_push(std::move(item))) {
+        return;
+    }
+    // Full: wait for the worker rather than lose a book update
+    worker.backpressure_waits++;
+    while (!worker.inbound->try_push(std::move(item))) {
+        std::this_thread::yield();
+    }
+}
+
+void PartitionedFeedIntegration::apply(Worker& worker, std::vector<Tick>& batch) {
+    if (batch.empty()) {
+        return;
+    }
+    worker.integration.process_ticks(std::span<const Tick>(batch.data(), batch.size()));
+    worker.ticks_applied.fetch_add(batch.size(), std::memory_order_relaxed);
+    worker.completed.fetch_add(batch.size(), std::memory_order_release);
+    batch.clear();
+}
+
+void PartitionedFeedIntegration::run(Worker& worker) {
+    std::vector<Tick> batch;
+    batch.reserve(MAX_BATCH);
+    Inbound item;
+
+    while (worker.inbound->pop(item)) {
+        // Take whatever else is queued, so one process_ticks() call covers a burst
+        do {
+            if (item.kind == Inbound::Kind::TICK) {
+                batch.push_back(Tick::from_compact(item.tick));
+                batch.back().sequence = item.sequence;
+                if (batch.size() == MAX_BATCH) {
+                    apply(worker, batch);
+                }
+                continue;
+            }
+
+            // Handoffs apply in ring order, after the ticks queued before them
+            apply(worker, batch);
+            Handoff& handoff = *item.handoff;
+            if (item.kind == Inbound::Kind::RELEASE) {
+                handoff.handler = worker.integration.release_handler(handoff.instrument_id);
+                handoff.ready.store(true, std::memory_order_release);
+            } else {
+                while (!handoff.ready.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                if (handoff.handler &&
+                    !worker.integration.adopt_handler(handoff.instrument_id, std::move(handoff.handler))) {
+                    std::cerr << "Failed to move book for instrument " << handoff.instrument_id << std::endl;
+                }
+            }
+            worker.completed.fetch_add(1, std::memory_order_release);
+        } while (worker.inbound->try_pop(item));
+
+        apply(worker, batch);
+    }
+}
+
+} // namespace orderbook
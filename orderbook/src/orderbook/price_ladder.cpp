@@ -0,0 +1,252 @@
+#include "orderbook/price_ladder.hpp"
+#include <algorithm>
+
+namespace orderbook {
+
+namespace {
+
+constexpr size_t BITS_PER_WORD = 64;
+
+size_t round_up_to_word(size_t levels) {
+    size_t rounded = (levels + BITS_PER_WORD - 1) & ~(BITS_PER_WORD - 1);
+    return std::max(rounded, BITS_PER_WORD);
+}
+
+} // namespace
+
+ArrayPriceLadder::ArrayPriceLadder(bool descending, int64_t tick_size, size_t initial_levels,
+                                   size_t max_levels)
+    : descending_(descending)
+    , tick_size_(tick_size > 0 ? tick_size : 1)
+    , base_price_(0)
+    , count_(0)
+    , anchored_(false)
+    , max_levels_(std::max(round_up_to_word(max_levels), round_up_to_word(initial_levels)))
+    , out_of_window_(0)
+    , slots_(round_up_to_word(initial_levels))
+    , occupancy_(slots_.size() / BITS_PER_WORD, 0) {
+}
+
+int64_t ArrayPriceLadder::slot_of(int64_t price) const {
+    if (!anchored_) return -1;
+
+    int64_t diff = price - base_price_;
+    if (diff < 0 || diff % tick_size_ != 0) return -1;
+
+    int64_t slot = diff / tick_size_;
+    return slot < static_cast<int64_t>(slots_.size()) ? slot : -1;
+}
+
+PriceLevel* ArrayPriceLadder::find(int64_t price) {
+    int64_t slot = slot_of(price);
+    if (slot < 0 || !is_set(static_cast<size_t>(slot))) return nullptr;
+    return &slots_[slot];
+}
+
+const PriceLevel* ArrayPriceLadder::find(int64_t price) const {
+    int64_t slot = slot_of(price);
+    if (slot < 0 || !is_set(static_cast<size_t>(slot))) return nullptr;
+    return &slots_[slot];
+}
+
+PriceLevel* ArrayPriceLadder::insert(int64_t price) {
+    // Off-tick prices can never be indexed on this grid
+    if (anchored_ && count_ > 0 && (price - base_price_) % tick_size_ != 0) {
+        return nullptr;
+    }
+
+    int64_t slot = slot_of(price);
+    if (slot < 0) {
+        if (!reanchor(price)) {
+            ++out_of_window_;
+            return nullptr;
+        }
+        slot = slot_of(price);
+    }
+
+    size_t s = static_cast<size_t>(slot);
+    if (!is_set(s)) {
+        slots_[s] = PriceLevel(price, 0, 0);
+        occupancy_[s >> 6] |= uint64_t{1} << (s & 63);
+        ++count_;
+    }
+    return &slots_[s];
+}
+
+void ArrayPriceLadder::erase(int64_t price) {
+    int64_t slot = slot_of(price);
+    if (slot < 0) return;
+
+    size_t s = static_cast<size_t>(slot);
+    if (!is_set(s)) return;
+
+    occupancy_[s >> 6] &= ~(uint64_t{1} << (s & 63));
+    slots_[s] = PriceLevel();
+    --count_;
+}
+
+size_t ArrayPriceLadder::assign(std::span<const PriceLevel> levels) {
+    clear();
+
+    // Price range of the levels that will load
+    const PriceLevel* first = nullptr;
+    int64_t low = 0;
+    int64_t high = 0;
+    auto loads = [&](const PriceLevel& level) {
+        return level.quantity > 0 && (level.price - first->price) % tick_size_ == 0;
+    };
+    for (const auto& level : levels) {
+        if (!first) {
+            if (level.quantity <= 0) continue;
+            first = &level;
+            low = high = level.price;
+        } else if (loads(level)) {
+            low = std::min(low, level.price);
+            high = std::max(high, level.price);
+        }
+    }
+    if (!first) return 0;
+
+    // Too wide for the largest window: keep the ticks nearest the touch
+    size_t needed = static_cast<size_t>((high - low) / tick_size_) + 1;
+    if (needed > max_levels_) {
+        const int64_t reach = static_cast<int64_t>(max_levels_ - 1) * tick_size_;
+        if (descending_) {
+            low = high - reach;
+        } else {
+            high = low + reach;
+        }
+        needed = max_levels_;
+    }
+
+    // Same headroom rule as reanchor()
+    size_t capacity = slots_.size();
+    while (capacity < needed * 2 && capacity < max_levels_) {
+        capacity *= 2;
+    }
+    capacity = std::max(std::min(capacity, max_levels_), slots_.size());
+    if (capacity != slots_.size()) {
+        slots_.assign(capacity, PriceLevel());
+        occupancy_.assign(capacity / BITS_PER_WORD, 0);
+    }
+    base_price_ = low - static_cast<int64_t>((capacity - needed) / 2) * tick_size_;
+    anchored_ = true;
+
+    for (const auto& level : levels) {
+        if (!loads(level)) continue;
+        if (level.price < low || level.price > high) {
+            ++out_of_window_;
+            continue;
+        }
+        size_t s = static_cast<size_t>((level.price - base_price_) / tick_size_);
+        if (is_set(s)) continue;
+        slots_[s] = PriceLevel(level.price, level.quantity, level.order_count);
+        occupancy_[s >> 6] |= uint64_t{1} << (s & 63);
+        ++count_;
+    }
+    return count_;
+}
+
+const PriceLevel* ArrayPriceLadder::best() const {
+    if (count_ == 0) return nullptr;
+    return &slots_[descending_ ? highest_slot() : lowest_slot()];
+}
+
+void ArrayPriceLadder::collect(std::vector<PriceLevel>& out, size_t levels) const {
+    if (levels == 0) return;
+    size_t remaining = levels;
+    for_each([&](const PriceLevel& level) {
+        out.push_back(level);
+        return --remaining > 0;
+    });
+}
+
+void ArrayPriceLadder::clear() {
+    for (size_t w = 0; w < occupancy_.size(); ++w) {
+        uint64_t bits = occupancy_[w];
+        while (bits != 0) {
+            int bit = __builtin_ctzll(bits);
+            slots_[w * BITS_PER_WORD + bit] = PriceLevel();
+            bits &= bits - 1;
+        }
+        occupancy_[w] = 0;
+    }
+    count_ = 0;
+    anchored_ = false;
+}
+
+void ArrayPriceLadder::reserve(size_t levels) {
+    const size_t capacity = std::min(round_up_to_word(levels), max_levels_);
+    if (capacity <= slots_.size()) return;
+    slots_.resize(capacity);
+    occupancy_.resize(capacity / BITS_PER_WORD, 0);
+}
+
+size_t ArrayPriceLadder::lowest_slot() const {
+    for (size_t w = 0; w < occupancy_.size(); ++w) {
+        if (occupancy_[w] != 0) {
+            return w * BITS_PER_WORD + __builtin_ctzll(occupancy_[w]);
+        }
+    }
+    return 0;
+}
+
+size_t ArrayPriceLadder::highest_slot() const {
+    for (size_t w = occupancy_.size(); w-- > 0;) {
+        if (occupancy_[w] != 0) {
+            return w * BITS_PER_WORD + (63 - __builtin_clzll(occupancy_[w]));
+        }
+    }
+    return 0;
+}
+
+bool ArrayPriceLadder::reanchor(int64_t price) {
+    size_t capacity = slots_.size();
+
+    if (count_ == 0) {
+        // Empty side: centre the window on the new price
+        base_price_ = price - static_cast<int64_t>(capacity / 2) * tick_size_;
+        anchored_ = true;
+        return true;
+    }
+
+    int64_t low = std::min(price, slots_[lowest_slot()].price);
+    int64_t high = std::max(price, slots_[highest_slot()].price);
+    size_t needed = static_cast<size_t>((high - low) / tick_size_) + 1;
+    if (needed > max_levels_) {
+        return false;
+    }
+
+    // Keep at least as much headroom as occupied span so a drifting
+    // touch does not trigger a re-anchor on every update, short of
+    // going past max_levels
+    size_t new_capacity = capacity;
+    while (new_capacity < needed * 2 && new_capacity < max_levels_) {
+        new_capacity *= 2;
+    }
+    new_capacity = std::max(std::min(new_capacity, max_levels_), capacity);
+
+    int64_t new_base = low - static_cast<int64_t>((new_capacity - needed) / 2) * tick_size_;
+
+    std::vector<PriceLevel> new_slots(new_capacity);
+    std::vector<uint64_t> new_occupancy(new_capacity / BITS_PER_WORD, 0);
+
+    for (size_t w = 0; w < occupancy_.size(); ++w) {
+        uint64_t bits = occupancy_[w];
+        while (bits != 0) {
+            int bit = __builtin_ctzll(bits);
+            const PriceLevel& level = slots_[w * BITS_PER_WORD + bit];
+            size_t s = static_cast<size_t>((level.price - new_base) / tick_size_);
+            new_slots[s] = level;
+            new_occupancy[s >> 6] |= uint64_t{1} << (s & 63);
+            bits &= bits - 1;
+        }
+    }
+
+    slots_.swap(new_slots);
+    occupancy_.swap(new_occupancy);
+    base_price_ = new_base;
+    return true;
+}
+
+} // namespace orderbook
@@ -0,0 +1,293 @@
+// End-to-end pipeline benchmark: loopback socket -> ThreadedFeedHandler ->
+// FeedIntegration order books, at a series of offered message rates
+//
+// A sender thread plays the exchange (like mock_fix_server, over a loopback
+// TCP connection) and paces framed 35=D messages at the offered rate; the
+// receiving thread reads the socket, stamps each read and injects it into a
+// ThreadedFeedHandler, whose batch callback applies the ticks to the books.
+// Per rate it prints achieved throughput, drops, tick-to-book latency
+// percentiles (socket read to book updated) and the p99 of each stage, so
+// the rate where the pipeline saturates is visible directly.
+//
+// Usage: pipeline_benchmark [--rates 50000,200000,0] [--seconds 2] [--symbols 8]
+//        (rate 0 = send as fast as the socket takes it)
+
+#include "orderbook/feed_integration.hpp"
+#include "threading/threaded_feedhandler.hpp"
+#include "common/latency_histogram.hpp"
+#include "common/tsc_clock.hpp"
+#include "common/tick.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace feedhandler;
+
+namespace {
+
+const char* const SYMBOLS[] = {"AAPL", "MSFT", "GOOGL", "TSLA", "NVDA", "AMZN", "META", "NFLX",
+                               "AMD", "INTC", "ORCL", "IBM", "CSCO", "ADBE", "CRM", "QCOM"};
+constexpr size_t MAX_SYMBOLS = sizeof(SYMBOLS) / sizeof(SYMBOLS[0]);
+constexpr size_t SEND_BATCH_BYTES = 16384;
+constexpr size_t RECV_BYTES = 65536;
+
+struct Options {
+    std::vector<uint64_t> rates = {50000, 100000, 200000, 500000, 1000000, 0};
+    double seconds = 2.0;
+    size_t symbols = 8;
+};
+
+struct Result {
+    uint64_t offered = 0;
+    uint64_t sent = 0;
+    uint64_t delivered = 0;
+    uint64_t dropped = 0;
+    double elapsed_s = 0.0;
+    common::LatencySummary tick_to_book;
+    common::LatencySummary queue;
+    common::LatencySummary parse;
+    common::LatencySummary book;
+};
+
+// "8=FIX.4.4|9=<len>|<body>10=<sum>|"
+std::string frame(const std::string& body) {
+    std::string message = "8=FIX.4.4|9=" + std::to_string(body.size()) + "|" + body;
+    unsigned checksum = 0;
+    for (unsigned char c : message) {
+        checksum += c;
+    }
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u|", checksum % 256);
+    return message + trailer;
+}
+
+// A rotating set of messages over symbols and a few price levels per side
+std::vector<std::string> make_messages(size_t symbols) {
+    std::vector<std::string> messages;
+    for (size_t i = 0; i < 1024; ++i) {
+        bool buy = (i / symbols) % 2 == 0;
+        std::ostringstream body;
+        body << "35=D|55=" << SYMBOLS[i % symbols]
+             << "|44=" << (buy ? 100 : 101) << '.' << std::setw(2) << std::setfill('0') << (i * 7) % 50
+             << "|38=" << 100 * (1 + i % 5)
+             << "|54=" << (buy ? 1 : 2) << '|';
+        messages.push_back(frame(body.str()));
+    }
+    return messages;
+}
+
+bool open_loopback(int& sender, int& receiver) {
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        std::cerr << "socket() failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;  // Ephemeral
+    socklen_t length = sizeof(address);
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listener, 1) < 0 ||
+        ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) < 0) {
+        std::cerr << "Failed to listen on loopback: " << std::strerror(errno) << std::endl;
+        ::close(listener);
+        return false;
+    }
+
+    receiver = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (receiver < 0 || ::connect(receiver, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::cerr << "Failed to connect to loopback: " << std::strerror(errno) << std::endl;
+        ::close(listener);
+        return false;
+    }
+    sender = ::accept(listener, nullptr, nullptr);
+    ::close(listener);
+    if (sender < 0) {
+        std::cerr << "accept() failed: " << std::strerror(errno) << std::endl;
+        ::close(receiver);
+        return false;
+    }
+
+    int one = 1;
+    ::setsockopt(sender, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return true;
+}
+
+// Exchange side: pace messages at rate per second (0 = unthrottled) for seconds
+uint64_t send_feed(int fd, const std::vector<std::string>& messages, uint64_t rate, double seconds) {
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(seconds));
+    std::string batch;
+    batch.reserve(SEND_BATCH_BYTES + 256);
+    uint64_t sent = 0;
+
+    for (auto now = start; now < end; now = std::chrono::steady_clock::now()) {
+        uint64_t due = rate == 0 ? ~uint64_t{0} :
+            static_cast<uint64_t>(std::chrono::duration<double>(now - start).count() * static_cast<double>(rate));
+        if (sent >= due) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        batch.clear();
+        uint64_t batched = sent;
+        while (batched < due && batch.size() < SEND_BATCH_BYTES) {
+            batch += messages[batched % messages.size()];
+            ++batched;
+        }
+        size_t offset = 0;
+        while (offset < batch.size()) {
+            ssize_t written = ::send(fd, batch.data() + offset, batch.size() - offset, 0);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return sent;
+            }
+            offset += static_cast<size_t>(written);
+        }
+        sent = batched;
+    }
+    return sent;
+}
+
+Result run_rate(const Options& options, const std::vector<std::string>& messages, uint64_t rate) {
+    Result result;
+    result.offered = rate;
+
+    int sender = -1;
+    int receiver = -1;
+    if (!open_loopback(sender, receiver)) {
+        return result;
+    }
+
+    // Ticks carry the read's receive stamp; latency runs from it to the
+    // moment the batch is in the books
+    orderbook::FeedIntegration integration;
+    common::LatencyHistogram tick_to_book;
+    uint64_t delivered = 0;
+
+    threading::ThreadedFeedHandler::Config config;
+    config.queue_size = 4096;
+    config.buffer_size = RECV_BYTES;
+    threading::ThreadedFeedHandler handler(config, [&](std::span<const common::Tick> ticks) {
+        integration.process_ticks(ticks);
+
+        uint64_t now = common::TscClock::global().now_ns();
+        for (const auto& tick : ticks) {
+            tick_to_book.record(now > tick.timestamp ? now - tick.timestamp : 0);
+        }
+        delivered += ticks.size();
+    });
+
+    handler.start();
+    auto start = std::chrono::steady_clock::now();
+    std::thread exchange([&] {
+        result.sent = send_feed(sender, messages, rate, options.seconds);
+        ::shutdown(sender, SHUT_WR);
+    });
+
+    // Network side: every read is stamped and handed to the parser thread
+    std::vector<char> buffer(RECV_BYTES);
+    while (true) {
+        ssize_t received = ::recv(receiver, buffer.data(), buffer.size(), 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            break;
+        }
+        handler.inject_data(buffer.data(), static_cast<size_t>(received), common::TscClock::global().now_ns());
+    }
+    exchange.join();
+    handler.stop();  // Drains the queue
+    result.elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ::close(sender);
+    ::close(receiver);
+
+    const auto& stats = handler.get_statistics();
+    result.delivered = delivered;
+    result.dropped = stats.queue_overflows.load();
+    result.tick_to_book = tick_to_book.summary();
+    result.queue = stats.queue_latency.snapshot().summary();
+    result.parse = stats.parse_latency.snapshot().summary();
+    result.book = integration.book_latency().snapshot().summary();
+    return result;
+}
+
+std::vector<uint64_t> parse_rates(const std::string& list) {
+    std::vector<uint64_t> rates;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        rates.push_back(std::strtoull(item.c_str(), nullptr, 10));
+    }
+    return rates;
+}
+
+double us(uint64_t ns) {
+    return static_cast<double>(ns) / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--rates") {
+            options.rates = parse_rates(argv[i + 1]);
+        } else if (flag == "--seconds") {
+            options.seconds = std::atof(argv[i + 1]);
+        } else if (flag == "--symbols") {
+            options.symbols = std::clamp<size_t>(std::strtoull(argv[i + 1], nullptr, 10), 1, MAX_SYMBOLS);
+        } else {
+            std::cerr << "Unknown option " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<std::string> messages = make_messages(options.symbols);
+
+    std::cout << "=== Pipeline Benchmark: socket -> ThreadedFeedHandler -> FeedIntegration ===" << std::endl;
+    std::cout << options.symbols << " symbols, " << options.seconds << " s per rate\n" << std::endl;
+    std::cout << std::left << std::setw(12) << "offered/s" << std::setw(12) << "achieved/s"
+              << std::setw(12) << "ticks/s" << std::setw(10) << "dropped"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(11) << "p99.9 us"
+              << std::setw(11) << "max us" << std::setw(12) << "queue p99" << std::setw(12) << "parse p99"
+              << "book p99" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (uint64_t rate : options.rates) {
+        Result r = run_rate(options, messages, rate);
+        double seconds = r.elapsed_s > 0 ? r.elapsed_s : 1.0;
+        std::cout << std::setw(12) << (rate ? std::to_string(rate) : std::string("max"))
+                  << std::setw(12) << static_cast<uint64_t>(static_cast<double>(r.sent) / seconds)
+                  << std::setw(12) << static_cast<uint64_t>(static_cast<double>(r.delivered) / seconds)
+                  << std::setw(10) << r.dropped
+                  << std::setw(10) << us(r.tick_to_book.p50) << std::setw(10) << us(r.tick_to_book.p99)
+                  << std::setw(11) << us(r.tick_to_book.p999) << std::setw(11) << us(r.tick_to_book.max)
+                  << std::setw(12) << us(r.queue.p99) << std::setw(12) << us(r.parse.p99)
+                  << us(r.book.p99) << std::endl;
+    }
+    return 0;
+}
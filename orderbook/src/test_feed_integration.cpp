@@ -87,7 +87,7 @@ int main() {
     // Process each tick
     for (const auto& tick : ticks) {
         std::string symbol(tick.symbol.data(), tick.symbol.size());
-        double price = price_to_double(tick.price);
+        double price = feedhandler::common::price_to_double(tick.price);
         
         std::cout << "Tick: " << symbol 
                   << " | Side: " << tick.side
@@ -7,11 +7,6 @@
 
 using namespace orderbook;
 
-// Helper to convert fixed-point price to double
-double price_to_double(int64_t price) {
-    return static_cast<double>(price) / 10000.0;
-}
-
 // Helper to convert double to fixed-point price
 int64_t double_to_price(double price) {
     return static_cast<int64_t>(price * 10000.0);
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "orderbook/book_printer.hpp"
+#include "orderbook/order_book.hpp"
+
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+
+using namespace orderbook;
+
+class LiveBookPrinterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(::pipe(fds_), 0);
+        ::fcntl(fds_[0], F_SETFL, O_NONBLOCK);
+        book.add_order(Side::BID, price_from_double(150.00), 1000);
+        book.add_order(Side::BID, price_from_double(149.99), 1500);
+        book.add_order(Side::ASK, price_from_double(150.01), 900);
+    }
+
+    void TearDown() override {
+        ::close(fds_[0]);
+        ::close(fds_[1]);
+    }
+
+    // Everything written to the pipe since the last call
+    std::string drain() {
+        std::string data;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = ::read(fds_[0], buffer, sizeof(buffer))) > 0) {
+            data.append(buffer, static_cast<size_t>(n));
+        }
+        return data;
+    }
+
+    static size_t count(const std::string& text, const std::string& pattern) {
+        size_t found = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            ++found;
+        }
+        return found;
+    }
+
+    OrderBook book{"AAPL"};
+    int fds_[2] = {-1, -1};
+};
+
+TEST_F(LiveBookPrinterTest, RendersLadderAroundTheSpread) {
+    LiveBookPrinter printer(3, -1);
+    ASSERT_EQ(printer.line_count(), 9u);
+    EXPECT_GT(printer.refresh(book), 0);
+
+    EXPECT_EQ(printer.line(0), "ORDER BOOK: AAPL");
+    // Asks fill upwards from the spread line, so the top rows stay empty
+    EXPECT_TRUE(printer.line(2).empty());
+    EXPECT_TRUE(printer.line(3).empty());
+    EXPECT_EQ(printer.line(4), "      150.0100             900           1  \033[31mASK\033[0m");
+    EXPECT_EQ(printer.line(5), "  SPREAD: 0.0100  MID: 150.0050  0.66 bps");
+    EXPECT_EQ(printer.line(6), "      150.0000            1000           1  \033[32mBID\033[0m");
+    EXPECT_EQ(printer.line(7).substr(0, 14), "      149.9900");
+    EXPECT_TRUE(printer.line(8).empty());
+}
+
+TEST_F(LiveBookPrinterTest, WritesOnlyChangedLines) {
+    LiveBookPrinter printer(3, fds_[1], 5);
+
+    // First frame: every line, each positioned from first_row
+    ssize_t written = printer.refresh(book);
+    std::string first = drain();
+    EXPECT_EQ(static_cast<size_t>(written), first.size());
+    EXPECT_EQ(count(first, "\033[K"), printer.line_count());
+    EXPECT_NE(first.find("\033[5;1HORDER BOOK: AAPL\033[K"), std::string::npos);
+
+    // Nothing changed: no write at all
+    EXPECT_EQ(printer.refresh(book), 0);
+    EXPECT_TRUE(drain().empty());
+
+    // One level changed: that line only (best bid is row 5 + 6)
+    book.modify_order(Side::BID, price_from_double(150.00), 250);
+    EXPECT_GT(printer.refresh(book), 0);
+    std::string update = drain();
+    EXPECT_EQ(count(update, "\033[K"), 1u);
+    EXPECT_EQ(update.rfind("\033[11;1H", 0), 0u);
+    EXPECT_NE(update.find("1250"), std::string::npos);
+    EXPECT_EQ(printer.lines_written(), printer.line_count() + 1);
+
+    // A new best ask moves the spread line and the ask rows
+    book.add_order(Side::ASK, price_from_double(150.005), 10);
+    printer.refresh(book);
+    EXPECT_EQ(count(drain(), "\033[K"), 3u);
+
+    printer.invalidate();
+    printer.refresh(book);
+    EXPECT_EQ(count(drain(), "\033[K"), printer.line_count());
+}
+
+TEST_F(LiveBookPrinterTest, UsesTheBookPriceScale) {
+    OrderBookConfig cents;
+    cents.price_scale = 100;
+    OrderBook cents_book("MSFT", cents);
+    cents_book.add_order(Side::BID, 31250, 7);
+    cents_book.add_order(Side::ASK, 31275, 3);
+
+    LiveBookPrinter printer(1, -1);
+    printer.refresh(cents_book);
+    EXPECT_EQ(printer.line(2).substr(0, 14), "        312.75");
+    EXPECT_EQ(printer.line(3), "  SPREAD: 0.25  MID: 312.62  7.99 bps");
+    EXPECT_EQ(printer.line(4).substr(0, 14), "        312.50");
+}
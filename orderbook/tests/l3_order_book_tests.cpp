@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+#include "orderbook/l3_order_book.hpp"
+#include "orderbook/event_handler.hpp"
+
+#include <vector>
+
+using namespace orderbook;
+
+class L3OrderBookTest : public ::testing::Test {
+protected:
+    L3OrderBook book{"AAPL"};
+
+    // Helper to convert double to fixed-point
+    int64_t to_fixed(double price) {
+        return static_cast<int64_t>(price * 10000);
+    }
+
+    std::vector<uint64_t> queue_at(Side side, int64_t price) {
+        return queue_at_in(book, side, price);
+    }
+
+    static std::vector<uint64_t> queue_at_in(const L3OrderBook& l3, Side side, int64_t price) {
+        std::vector<uint64_t> ids;
+        l3.for_each_order(side, price, [&](const Order& order) {
+            ids.push_back(order.order_id);
+        });
+        return ids;
+    }
+};
+
+// ============================================================================
+// OrderIdMap Tests
+// ============================================================================
+
+TEST(OrderIdMapTest, InsertFindErase) {
+    OrderIdMap map(4);
+    EXPECT_TRUE(map.insert(0, 10));   // Order id 0 is a valid key
+    EXPECT_TRUE(map.insert(42, 11));
+    EXPECT_FALSE(map.insert(42, 12)); // Duplicate
+
+    EXPECT_EQ(map.find(0), 10u);
+    EXPECT_EQ(map.find(42), 11u);
+    EXPECT_EQ(map.find(7), NO_ORDER);
+
+    map.erase(0);
+    EXPECT_EQ(map.find(0), NO_ORDER);
+    EXPECT_EQ(map.find(42), 11u);
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(OrderIdMapTest, GrowsAndSurvivesChurn) {
+    OrderIdMap map(1);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(map.insert(i * 7919u, i));
+    }
+    // Erase every other key, then verify the rest are still reachable
+    for (uint32_t i = 0; i < 10000; i += 2) {
+        map.erase(i * 7919u);
+    }
+    EXPECT_EQ(map.size(), 5000u);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        uint32_t expected = (i % 2 == 0) ? NO_ORDER : i;
+        ASSERT_EQ(map.find(i * 7919u), expected);
+    }
+}
+
+// ============================================================================
+// Order Lifecycle Tests
+// ============================================================================
+
+TEST_F(L3OrderBookTest, AddOrderUpdatesLevel) {
+    EXPECT_TRUE(book.add_order(1, Side::BID, to_fixed(150.00), 100));
+    EXPECT_TRUE(book.add_order(2, Side::BID, to_fixed(150.00), 200));
+
+    EXPECT_EQ(book.order_count(), 2u);
+    auto best_bid = book.book().get_best_bid();
+    EXPECT_EQ(best_bid.quantity, 300);
+    EXPECT_EQ(best_bid.order_count, 2u);
+
+    const Order* order = book.find_order(2);
+    ASSERT_NE(order, nullptr);
+    EXPECT_EQ(order->quantity, 200);
+    EXPECT_EQ(order->side, Side::BID);
+}
+
+TEST_F(L3OrderBookTest, DuplicateAndInvalidOrdersRejected) {
+    EXPECT_TRUE(book.add_order(1, Side::BID, to_fixed(150.00), 100));
+    EXPECT_FALSE(book.add_order(1, Side::ASK, to_fixed(151.00), 100));
+    EXPECT_FALSE(book.add_order(2, Side::BID, to_fixed(150.00), 0));
+
+    EXPECT_EQ(book.order_count(), 1u);
+    EXPECT_EQ(book.book().level_count(Side::ASK), 0u);
+    EXPECT_EQ(book.book().get_best_bid().quantity, 100);
+}
+
+TEST_F(L3OrderBookTest, OrdersQueuedInTimePriority) {
+    book.add_order(1, Side::ASK, to_fixed(150.01), 100);
+    book.add_order(2, Side::ASK, to_fixed(150.01), 100);
+    book.add_order(3, Side::ASK, to_fixed(150.01), 100);
+
+    EXPECT_EQ(queue_at(Side::ASK, to_fixed(150.01)), (std::vector<uint64_t>{1, 2, 3}));
+}
+
+TEST_F(L3OrderBookTest, CancelFromMiddleOfQueue) {
+    book.add_order(1, Side::ASK, to_fixed(150.01), 100);
+    book.add_order(2, Side::ASK, to_fixed(150.01), 200);
+    book.add_order(3, Side::ASK, to_fixed(150.01), 300);
+
+    EXPECT_TRUE(book.cancel_order(2));
+    EXPECT_FALSE(book.cancel_order(2));
+
+    EXPECT_EQ(queue_at(Side::ASK, to_fixed(150.01)), (std::vector<uint64_t>{1, 3}));
+    auto best_ask = book.book().get_best_ask();
+    EXPECT_EQ(best_ask.quantity, 400);
+    EXPECT_EQ(best_ask.order_count, 2u);
+}
+
+TEST_F(L3OrderBookTest, CancelLastOrderRemovesLevel) {
+    book.add_order(1, Side::BID, to_fixed(150.00), 100);
+    book.add_order(2, Side::BID, to_fixed(149.99), 100);
+
+    EXPECT_TRUE(book.cancel_order(1));
+    EXPECT_EQ(book.book().level_count(Side::BID), 1u);
+    EXPECT_EQ(book.book().get_best_bid().price, to_fixed(149.99));
+    EXPECT_EQ(book.find_order(1), nullptr);
+}
+
+TEST_F(L3OrderBookTest, ModifyDecreaseKeepsPriority) {
+    book.add_order(1, Side::BID, to_fixed(150.00), 100);
+    book.add_order(2, Side::BID, to_fixed(150.00), 100);
+
+    EXPECT_TRUE(book.modify_order(1, to_fixed(150.00), 40));
+
+    EXPECT_EQ(queue_at(Side::BID, to_fixed(150.00)), (std::vector<uint64_t>{1, 2}));
+    EXPECT_EQ(book.book().get_best_bid().quantity, 140);
+}
+
+TEST_F(L3OrderBookTest, ModifyIncreaseLosesPriority) {
+    book.add_order(1, Side::BID, to_fixed(150.00), 100);
+    book.add_order(2, Side::BID, to_fixed(150.00), 100);
+
+    EXPECT_TRUE(book.modify_order(1, to_fixed(150.00), 150));
+
+    EXPECT_EQ(queue_at(Side::BID, to_fixed(150.00)), (std::vector<uint64_t>{2, 1}));
+    EXPECT_EQ(book.book().get_best_bid().quantity, 250);
+}
+
+TEST_F(L3OrderBookTest, ModifyPriceMovesOrder) {
+    book.add_order(1, Side::BID, to_fixed(150.00), 100);
+    book.add_order(2, Side::BID, to_fixed(149.99), 100);
+
+    EXPECT_TRUE(book.modify_order(1, to_fixed(149.99), 100));
+
+    EXPECT_EQ(book.book().level_count(Side::BID), 1u);
+    EXPECT_EQ(queue_at(Side::BID, to_fixed(149.99)), (std::vector<uint64_t>{2, 1}));
+    EXPECT_EQ(book.book().get_best_bid().quantity, 200);
+}
+
+TEST_F(L3OrderBookTest, ModifyToZeroCancels) {
+    book.add_order(1, Side::BID, to_fixed(150.00), 100);
+    EXPECT_TRUE(book.modify_order(1, to_fixed(150.00), 0));
+    EXPECT_TRUE(book.book().is_empty());
+    EXPECT_EQ(book.order_count(), 0u);
+}
+
+TEST_F(L3OrderBookTest, ModifyUnknownOrderFails) {
+    EXPECT_FALSE(book.modify_order(99, to_fixed(150.00), 100));
+}
+
+TEST_F(L3OrderBookTest, PartialAndFullExecution) {
+    book.add_order(1, Side::ASK, to_fixed(150.01), 100);
+    book.add_order(2, Side::ASK, to_fixed(150.01), 100);
+
+    EXPECT_TRUE(book.execute_order(1, 30));
+    EXPECT_EQ(book.find_order(1)->quantity, 70);
+    EXPECT_EQ(queue_at(Side::ASK, to_fixed(150.01)), (std::vector<uint64_t>{1, 2}));
+    EXPECT_EQ(book.book().get_best_ask().order_count, 2u);
+
+    EXPECT_TRUE(book.execute_order(1, 70));
+    EXPECT_EQ(book.find_order(1), nullptr);
+    EXPECT_EQ(book.book().get_best_ask().quantity, 100);
+    EXPECT_EQ(book.book().get_best_ask().order_count, 1u);
+}
+
+TEST_F(L3OrderBookTest, SlotsReusedAfterCancel) {
+    for (uint64_t id = 0; id < 1000; ++id) {
+        ASSERT_TRUE(book.add_order(id, Side::BID, to_fixed(150.00), 10));
+        ASSERT_TRUE(book.cancel_order(id));
+    }
+    EXPECT_EQ(book.order_count(), 0u);
+    EXPECT_TRUE(book.book().is_empty());
+}
+
+TEST_F(L3OrderBookTest, WorksWithArrayLadder) {
+    OrderBookConfig config;
+    config.ladder_type = LadderType::ARRAY;
+    config.tick_size = 100;
+    L3OrderBook array_book("AAPL", config);
+
+    EXPECT_TRUE(array_book.add_order(1, Side::BID, to_fixed(150.00), 100));
+    EXPECT_TRUE(array_book.add_order(2, Side::BID, to_fixed(150.00), 50));
+    EXPECT_FALSE(array_book.add_order(3, Side::BID, to_fixed(150.00) + 1, 50));  // Off-tick
+    EXPECT_TRUE(array_book.cancel_order(1));
+
+    EXPECT_EQ(array_book.order_count(), 1u);
+    EXPECT_EQ(array_book.book().get_best_bid().quantity, 50);
+}
+
+TEST_F(L3OrderBookTest, RejectedPriceChangeKeepsOrder) {
+    OrderBookConfig config;
+    config.ladder_type = LadderType::ARRAY;
+    config.tick_size = 100;
+    config.initial_levels = 64;
+    config.max_levels = 64;
+    L3OrderBook array_book("AAPL", config);
+
+    EXPECT_TRUE(array_book.add_order(1, Side::BID, to_fixed(150.00), 100));
+    EXPECT_TRUE(array_book.add_order(2, Side::BID, to_fixed(150.00), 50));
+
+    EXPECT_FALSE(array_book.modify_order(1, to_fixed(150.00) + 1, 100));  // Off-tick
+    EXPECT_FALSE(array_book.modify_order(1, to_fixed(151.00), 100));      // Out of window
+
+    // Still resting, still first in the queue
+    EXPECT_EQ(array_book.order_count(), 2u);
+    ASSERT_NE(array_book.find_order(1), nullptr);
+    EXPECT_EQ(array_book.find_order(1)->price, to_fixed(150.00));
+    EXPECT_EQ(queue_at_in(array_book, Side::BID, to_fixed(150.00)), (std::vector<uint64_t>{1, 2}));
+    EXPECT_EQ(array_book.book().get_best_bid().quantity, 150);
+    EXPECT_EQ(array_book.book().level_count(Side::BID), 1u);
+
+    EXPECT_TRUE(array_book.modify_order(1, to_fixed(149.99), 100));
+    EXPECT_EQ(array_book.find_order(1)->price, to_fixed(149.99));
+    EXPECT_EQ(array_book.book().level_count(Side::BID), 2u);
+}
+
+TEST_F(L3OrderBookTest, AddBumpsVersionOnce) {
+    uint64_t before = book.book().version();
+    EXPECT_TRUE(book.add_order(1, Side::BID, to_fixed(150.00), 100));
+    EXPECT_EQ(book.book().version(), before + 1);
+}
+
+// ============================================================================
+// Handler Integration Tests
+// ============================================================================
+
+TEST(OrderLevelHandlerTest, EventsResolvedByOrderId) {
+    OrderBookHandler handler("AAPL", BookMode::ORDER_LEVEL);
+
+    EXPECT_TRUE(handler.on_new_order({1, 1000, "AAPL", 10, Side::BID, price_from_double(150.00), 100}));
+    EXPECT_TRUE(handler.on_new_order({2, 1001, "AAPL", 11, Side::BID, price_from_double(150.00), 200}));
+    EXPECT_TRUE(handler.on_new_order({3, 1002, "AAPL", 12, Side::ASK, price_from_double(150.50), 300}));
+
+    // Modify carries new total quantity
+    EXPECT_TRUE(handler.on_modify_order({4, 1003, "AAPL", 11, Side::BID, price_from_double(150.00), 150, -50}));
+    // Delete removes the whole order regardless of event quantity
+    EXPECT_TRUE(handler.on_delete_order({5, 1004, "AAPL", 10, Side::BID, price_from_double(150.00), 1}));
+    // Buy aggressor fills the resting sell order
+    EXPECT_TRUE(handler.on_trade({6, 1005, "AAPL", 1, 99, 12, price_from_double(150.50), 100, Side::BID}));
+
+    const OrderBook& book = handler.get_order_book();
+    EXPECT_EQ(book.get_best_bid().quantity, 150);
+    EXPECT_EQ(book.get_best_bid().order_count, 1u);
+    EXPECT_EQ(book.get_best_ask().quantity, 200);
+    EXPECT_EQ(handler.get_l3_book().order_count(), 2u);
+    EXPECT_EQ(handler.get_stats().errors, 0u);
+}
+
+TEST(OrderLevelHandlerTest, UnknownOrderIdIsError) {
+    OrderBookHandler handler("AAPL", BookMode::ORDER_LEVEL);
+
+    EXPECT_FALSE(handler.on_delete_order({1, 1000, "AAPL", 42, Side::BID, price_from_double(150.00), 100}));
+    EXPECT_EQ(handler.get_stats().errors, 1u);
+    EXPECT_EQ(handler.get_stats().deletions, 0u);
+}
+
+TEST(OrderLevelHandlerTest, SnapshotReplacesOrdersWithLevels) {
+    OrderBookHandler handler("AAPL", BookMode::ORDER_LEVEL);
+    EXPECT_TRUE(handler.on_new_order({1, 1000, "AAPL", 10, Side::BID, price_from_double(149.00), 100}));
+    EXPECT_TRUE(handler.on_new_order({2, 1001, "AAPL", 11, Side::ASK, price_from_double(152.00), 100}));
+
+    SnapshotEvent snapshot(50, 2000, "AAPL");
+    snapshot.add_bid(price_from_double(150.00), 300, 4);
+    snapshot.add_bid(price_from_double(149.50), 100, 1);
+    snapshot.add_ask(price_from_double(150.50), 200, 2);
+    EXPECT_TRUE(handler.on_snapshot(snapshot));
+
+    const OrderBook& book = handler.get_order_book();
+    EXPECT_EQ(handler.get_last_sequence(), 50u);
+    EXPECT_EQ(handler.get_l3_book().order_count(), 0u);
+    EXPECT_EQ(book.level_count(Side::BID), 2u);
+    EXPECT_EQ(book.level_count(Side::ASK), 1u);
+    EXPECT_EQ(book.get_best_bid().quantity, 300);
+    EXPECT_EQ(book.get_best_bid().order_count, 4u);
+    EXPECT_EQ(book.get_best_ask().quantity, 200);
+    EXPECT_EQ(handler.get_stats().snapshots, 1u);
+
+    // Order events resume on top of the restored levels
+    EXPECT_TRUE(handler.on_new_order({51, 2001, "AAPL", 20, Side::BID, price_from_double(150.00), 50}));
+    EXPECT_EQ(book.get_best_bid().quantity, 350);
+    EXPECT_EQ(book.get_best_bid().order_count, 5u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
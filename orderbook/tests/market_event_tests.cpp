@@ -0,0 +1,612 @@
+#include <gtest/gtest.h>
+#include "orderbook/market_event.hpp"
+#include "orderbook/event_handler.hpp"
+#include "orderbook/feed_integration.hpp"
+#include "benchmarks/stage_profiler.hpp"
+#include "common/tick.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+using namespace orderbook;
+
+static_assert(std::is_trivially_copyable_v<MarketEventValue>,
+              "MarketEventValue must be copyable without allocation");
+
+// ============================================================================
+// MarketEventValue Tests
+// ============================================================================
+
+TEST(MarketEventValueTest, NewOrderFields) {
+    auto event = MarketEventValue::make_new_order(7, 1000, "AAPL", 42, Side::ASK, price_from_double(150.25), 300);
+
+    EXPECT_EQ(event.type, EventType::NEW_ORDER);
+    EXPECT_EQ(event.sequence_number, 7u);
+    EXPECT_EQ(event.timestamp_ns, 1000u);
+    EXPECT_EQ(event.symbol.view(), "AAPL");
+    EXPECT_EQ(event.new_order.order_id, 42u);
+    EXPECT_EQ(event.new_order.side, Side::ASK);
+    EXPECT_EQ(event.new_order.price, 1502500);
+    EXPECT_EQ(event.new_order.quantity, 300);
+}
+
+TEST(MarketEventValueTest, TradeFields) {
+    auto event = MarketEventValue::make_trade(1, 1000, "MSFT", 9, 10, 11, price_from_double(300.5), 25, Side::BID);
+
+    EXPECT_EQ(event.type, EventType::TRADE);
+    EXPECT_EQ(event.trade.buy_order_id, 10u);
+    EXPECT_EQ(event.trade.sell_order_id, 11u);
+    EXPECT_EQ(event.trade.aggressor_side, Side::BID);
+}
+
+TEST(MarketEventValueTest, OversizedSymbolLeftEmpty) {
+    std::string long_symbol(InlineSymbol::CAPACITY + 1, 'X');
+    auto event = MarketEventValue::make_new_order(1, 1000, long_symbol, 1, Side::BID, price_from_double(1.0), 1);
+    EXPECT_TRUE(event.symbol.empty());
+
+    std::string max_symbol(InlineSymbol::CAPACITY, 'Y');
+    event = MarketEventValue::make_new_order(1, 1000, max_symbol, 1, Side::BID, price_from_double(1.0), 1);
+    EXPECT_EQ(event.symbol.view(), max_symbol);
+}
+
+// ============================================================================
+// Handler Value Path Tests
+// ============================================================================
+
+TEST(ValueEventHandlerTest, MatchesPolymorphicPath) {
+    OrderBookHandler value_handler("AAPL");
+    OrderBookHandler virtual_handler("AAPL");
+
+    value_handler.process_event(MarketEventValue::make_new_order(1, 1000, "AAPL", 1, Side::BID, price_from_double(150.00), 100));
+    value_handler.process_event(MarketEventValue::make_new_order(2, 1001, "AAPL", 2, Side::ASK, price_from_double(150.50), 200));
+    value_handler.process_event(MarketEventValue::make_delete_order(3, 1002, "AAPL", 2, Side::ASK, price_from_double(150.50), 50));
+    value_handler.process_event(MarketEventValue::make_trade(4, 1003, "AAPL", 1, 9, 1, price_from_double(150.00), 40, Side::ASK));
+
+    virtual_handler.process_event(NewOrderEvent{1, 1000, "AAPL", 1, Side::BID, price_from_double(150.00), 100});
+    virtual_handler.process_event(NewOrderEvent{2, 1001, "AAPL", 2, Side::ASK, price_from_double(150.50), 200});
+    virtual_handler.process_event(DeleteOrderEvent{3, 1002, "AAPL", 2, Side::ASK, price_from_double(150.50), 50});
+    virtual_handler.process_event(TradeEvent{4, 1003, "AAPL", 1, 9, 1, price_from_double(150.00), 40, Side::ASK});
+
+    const OrderBook& a = value_handler.get_order_book();
+    const OrderBook& b = virtual_handler.get_order_book();
+    EXPECT_EQ(a.get_best_bid(), b.get_best_bid());
+    EXPECT_EQ(a.get_best_ask(), b.get_best_ask());
+    EXPECT_EQ(value_handler.get_stats().trades, 1u);
+    EXPECT_EQ(value_handler.get_stats().errors, 0u);
+}
+
+TEST(ValueEventHandlerTest, RejectsInvalidEvents) {
+    OrderBookHandler handler("AAPL");
+
+    EXPECT_FALSE(handler.process_event(MarketEventValue::make_new_order(1, 1000, "MSFT", 1, Side::BID, price_from_double(150.00), 100)));
+    EXPECT_FALSE(handler.process_event(MarketEventValue::make_new_order(2, 1000, "AAPL", 1, Side::BID, price_from_double(150.00), 0)));
+    EXPECT_FALSE(handler.process_event(MarketEventValue::make_new_order(3, 0, "AAPL", 1, Side::BID, price_from_double(150.00), 100)));
+
+    EXPECT_EQ(handler.get_stats().errors, 3u);
+    EXPECT_TRUE(handler.get_order_book().is_empty());
+}
+
+TEST(ValueEventHandlerTest, SequenceGapDetected) {
+    OrderBookHandler handler("AAPL");
+
+    EXPECT_TRUE(handler.process_event(MarketEventValue::make_new_order(10, 1000, "AAPL", 1, Side::BID, price_from_double(150.00), 100)));
+    EXPECT_FALSE(handler.process_event(MarketEventValue::make_new_order(12, 1001, "AAPL", 2, Side::BID, price_from_double(150.00), 100)));
+    EXPECT_EQ(handler.get_gap_stats().gaps_detected, 1u);
+}
+
+TEST(ValueEventHandlerTest, StaleSequenceIsNotAGap) {
+    OrderBookHandler handler("AAPL");
+
+    EXPECT_TRUE(handler.process_event(MarketEventValue::make_new_order(5, 1000, "AAPL", 1, Side::BID, price_from_double(150.00), 100)));
+    EXPECT_FALSE(handler.process_event(MarketEventValue::make_new_order(5, 1001, "AAPL", 2, Side::BID, price_from_double(150.00), 100)));
+    EXPECT_EQ(handler.get_gap_stats().gaps_detected, 0u);
+    EXPECT_EQ(handler.get_gap_stats().messages_dropped, 0u);
+    EXPECT_EQ(handler.get_gap_stats().stale_messages, 1u);
+    EXPECT_EQ(handler.get_last_sequence(), 5u);
+}
+
+// ============================================================================
+// Snapshot Level Pool Tests
+// ============================================================================
+
+TEST(SnapshotLevelPoolTest, PooledEventReusesItsBlocks) {
+    SnapshotLevelPoolConfig config;
+    config.blocks = 2;
+    config.block_levels = 8;
+    SnapshotLevelPool pool(config);
+    OrderBookHandler handler("AAPL");
+
+    SnapshotEvent snapshot(1, 1000, "AAPL", pool);
+    EXPECT_EQ(pool.available(), 2u);  // Blocks are taken on the first level
+    for (uint64_t seq = 1; seq <= 3; ++seq) {
+        snapshot.reset(seq, 1000 + seq);
+        for (int i = 0; i < 5; ++i) {
+            snapshot.add_bid(price_from_double(150.00 - i) + static_cast<int64_t>(seq), 100 + i, 1);
+            snapshot.add_ask(price_from_double(151.00 + i), 200 + i, 2);
+        }
+        EXPECT_TRUE(snapshot.bids.pooled());
+        EXPECT_EQ(snapshot.bids.size(), 5u);
+        EXPECT_TRUE(handler.process_event(snapshot));
+        EXPECT_EQ(handler.get_order_book().get_best_bid().price, price_from_double(150.00) + static_cast<int64_t>(seq));
+    }
+    EXPECT_EQ(pool.stats().acquired, 2u);  // Once per side, not per snapshot
+    EXPECT_EQ(pool.available(), 0u);
+    EXPECT_EQ(handler.get_order_book().level_count(Side::ASK), 5u);
+    EXPECT_EQ(handler.get_last_sequence(), 3u);
+    EXPECT_EQ(handler.get_stats().snapshots, 3u);
+
+    // Pool exhausted: another event still works, from the heap
+    SnapshotEvent other(1, 1000, "MSFT", pool);
+    other.add_bid(price_from_double(300.00), 10, 1);
+    EXPECT_FALSE(other.bids.pooled());
+    EXPECT_EQ(pool.stats().exhausted, 1u);
+
+    {
+        SnapshotEvent moved(std::move(snapshot));
+        EXPECT_EQ(moved.asks.size(), 5u);
+        EXPECT_TRUE(snapshot.asks.empty());
+    }
+    EXPECT_EQ(pool.available(), 2u);  // Returned with the event
+}
+
+TEST(SnapshotLevelPoolTest, DeepSideSpillsToTheHeapInOrder) {
+    SnapshotLevelPoolConfig config;
+    config.blocks = 1;
+    config.block_levels = 4;
+    SnapshotLevelPool pool(config);
+
+    SnapshotLevels levels(&pool);
+    for (int i = 0; i < 40; ++i) {
+        levels.emplace_back(1000 - i, i + 1, i);
+    }
+    ASSERT_EQ(levels.size(), 40u);
+    EXPECT_FALSE(levels.pooled());
+    EXPECT_EQ(pool.available(), 1u);  // Block handed back when it was outgrown
+    EXPECT_EQ(pool.stats().outgrown, 1u);
+    for (int i = 0; i < 40; ++i) {
+        EXPECT_EQ(levels[i].price, 1000 - i);
+        EXPECT_EQ(levels[i].order_count, i);
+    }
+
+    // Unpooled events grow like a vector
+    SnapshotEvent plain(1, 1000, "AAPL");
+    plain.bids.reserve(100);
+    EXPECT_GE(plain.bids.capacity(), 100u);
+    EXPECT_TRUE(plain.asks.span().empty());
+}
+
+class GapRecoveryTest : public ::testing::Test {
+protected:
+    OrderBookHandler handler{"AAPL"};
+    std::vector<uint64_t> requests;
+
+    void SetUp() override {
+        GapRecoveryConfig config;
+        config.buffer_capacity = 8;
+        config.request_snapshot = [this](const std::string& symbol, uint64_t expected) {
+            EXPECT_EQ(symbol, "AAPL");
+            requests.push_back(expected);
+        };
+        handler.enable_gap_recovery(config);
+    }
+
+    bool add(uint64_t seq, double price, int64_t quantity) {
+        return handler.process_event(MarketEventValue::make_new_order(
+            seq, 1000 + seq, "AAPL", seq, Side::BID, price_from_double(price), quantity));
+    }
+
+    void snapshot(uint64_t seq, double bid, int64_t quantity) {
+        SnapshotEvent event(seq, 5000, "AAPL");
+        event.add_bid(price_from_double(bid), quantity, 1);
+        EXPECT_TRUE(handler.process_event(event));
+    }
+};
+
+TEST_F(GapRecoveryTest, BuffersUntilSnapshotThenReplays) {
+    EXPECT_TRUE(add(1, 150.00, 100));
+    EXPECT_TRUE(add(4, 150.10, 40));  // 2 and 3 missing
+    EXPECT_TRUE(handler.is_recovering());
+    EXPECT_EQ(requests, (std::vector<uint64_t>{2}));
+
+    // Out of order, and 3 is already covered by the snapshot
+    EXPECT_TRUE(add(5, 150.20, 50));
+    EXPECT_TRUE(add(3, 149.00, 30));
+    EXPECT_TRUE(handler.process_event(NewOrderEvent{6, 1006, "AAPL", 6, Side::BID, price_from_double(150.20), 10}));
+    EXPECT_EQ(handler.get_order_book().level_count(Side::BID), 1u);  // Stale until the snapshot
+
+    snapshot(3, 149.90, 300);
+    EXPECT_FALSE(handler.is_recovering());
+    EXPECT_EQ(handler.get_last_sequence(), 6u);
+
+    const OrderBook& book = handler.get_order_book();
+    EXPECT_EQ(book.level_count(Side::BID), 3u);
+    EXPECT_EQ(book.get_best_bid(), PriceLevel(price_from_double(150.20), 60, 2));
+    EXPECT_EQ(book.find_level(Side::BID, price_from_double(150.00)), nullptr);  // Replaced by the snapshot
+
+    const auto& gaps = handler.get_gap_stats();
+    EXPECT_EQ(gaps.gaps_detected, 1u);
+    EXPECT_EQ(gaps.recoveries, 1u);
+    EXPECT_EQ(gaps.messages_buffered, 4u);
+    EXPECT_EQ(gaps.messages_replayed, 3u);
+
+    // Back to live processing
+    EXPECT_TRUE(add(7, 150.30, 5));
+    EXPECT_EQ(book.get_best_bid().price, price_from_double(150.30));
+}
+
+TEST_F(GapRecoveryTest, HoleAfterSnapshotRequestsAgain) {
+    EXPECT_TRUE(add(1, 150.00, 100));
+    EXPECT_TRUE(add(5, 150.10, 10));
+    EXPECT_TRUE(add(6, 150.20, 10));
+
+    snapshot(3, 149.90, 300);  // 4 still missing
+    EXPECT_TRUE(handler.is_recovering());
+    EXPECT_EQ(requests, (std::vector<uint64_t>{2, 4}));
+    EXPECT_EQ(handler.get_gap_stats().messages_replayed, 0u);
+
+    snapshot(4, 149.95, 200);
+    EXPECT_FALSE(handler.is_recovering());
+    EXPECT_EQ(handler.get_last_sequence(), 6u);
+    EXPECT_EQ(handler.get_order_book().get_best_bid().price, price_from_double(150.20));
+    EXPECT_EQ(handler.get_gap_stats().messages_replayed, 2u);
+}
+
+TEST_F(GapRecoveryTest, FullBufferDropsOldest) {
+    EXPECT_TRUE(add(1, 150.00, 100));
+    for (uint64_t seq = 3; seq < 13; ++seq) {
+        EXPECT_TRUE(add(seq, 150.00, 1));
+    }
+    EXPECT_EQ(handler.get_gap_stats().buffer_overflows, 2u);
+
+    snapshot(4, 149.00, 10);  // Covers the dropped 3 and 4
+    EXPECT_FALSE(handler.is_recovering());
+    EXPECT_EQ(handler.get_last_sequence(), 12u);
+    EXPECT_EQ(handler.get_order_book().get_best_bid().quantity, 8);
+}
+
+// ============================================================================
+// FeedIntegration Tests
+// ============================================================================
+
+TEST(FeedIntegrationTest, TicksCreateBooksPerSymbol) {
+    FeedIntegration integration;
+
+    feedhandler::common::Tick tick;
+    tick.copy_symbol("AAPL");
+    tick.price = feedhandler::common::double_to_price(150.00);
+    tick.qty = 100;
+    tick.side = 'B';
+    tick.timestamp = 1;
+    EXPECT_TRUE(integration.process_tick(tick));
+
+    tick.copy_symbol("MSFT");
+    tick.side = 'S';
+    tick.timestamp = 2;
+    EXPECT_TRUE(integration.process_tick(tick));
+
+    ASSERT_NE(integration.get_order_book("AAPL"), nullptr);
+    ASSERT_NE(integration.get_order_book("MSFT"), nullptr);
+    EXPECT_EQ(integration.get_order_book("GOOG"), nullptr);
+
+    EXPECT_EQ(integration.get_order_book("AAPL")->level_count(Side::BID), 1u);
+    EXPECT_EQ(integration.get_order_book("MSFT")->level_count(Side::ASK), 1u);
+    EXPECT_EQ(integration.get_stats().ticks_processed, 2u);
+    EXPECT_EQ(integration.get_stats().events_generated, 2u);
+    EXPECT_EQ(integration.get_symbols().size(), 2u);
+}
+
+TEST(FeedIntegrationTest, PricesStayFixedPointIntoTheBook) {
+    FeedIntegration integration;
+    OrderBookConfig cents;
+    cents.price_scale = 100;
+    integration.set_book_config("INTC", cents);
+
+    feedhandler::common::Tick tick;
+    tick.copy_symbol("ORCL");
+    tick.price = 1501234;  // 150.1234, finer than two decimals
+    tick.qty = 100;
+    tick.side = 'B';
+    tick.timestamp = 1;
+    EXPECT_TRUE(integration.process_tick(tick));
+    EXPECT_EQ(integration.get_order_book("ORCL")->get_best_bid().price, 1501234);
+
+    tick.copy_symbol("INTC");
+    tick.price = 3125050;  // 312.5050 -> 312.51 in cents
+    EXPECT_TRUE(integration.process_tick(tick));
+    EXPECT_EQ(integration.get_order_book("INTC")->get_best_bid().price, 31251);
+    EXPECT_EQ(integration.get_order_book("INTC")->price_scale(), 100);
+}
+
+TEST(FeedIntegrationTest, OversizedSymbolCountsAsError) {
+    FeedIntegration integration;
+
+    feedhandler::common::Tick tick;
+    tick.copy_symbol(std::string(InlineSymbol::CAPACITY + 1, 'X'));
+    tick.price = feedhandler::common::double_to_price(1.00);
+    tick.qty = 1;
+    tick.side = 'B';
+    tick.timestamp = 1;
+
+    EXPECT_FALSE(integration.process_tick(tick));
+    EXPECT_EQ(integration.get_stats().errors, 1u);
+    EXPECT_TRUE(integration.get_symbols().empty());
+}
+
+TEST(FeedIntegrationTest, RoutesByInstrumentId) {
+    FeedIntegration integration;
+    auto& symbols = feedhandler::common::SymbolTable::global();
+
+    feedhandler::common::Tick tick;
+    tick.copy_symbol("IBM");
+    tick.intern_symbol();
+    tick.price = feedhandler::common::double_to_price(120.00);
+    tick.qty = 10;
+    tick.side = 'B';
+    tick.timestamp = 1;
+    EXPECT_TRUE(integration.process_tick(tick));
+
+    feedhandler::common::InstrumentId id = symbols.find("IBM");
+    ASSERT_NE(id, feedhandler::common::INVALID_INSTRUMENT);
+    EXPECT_EQ(tick.instrument_id, id);
+
+    // ID and name lookups resolve to the same book
+    EXPECT_EQ(integration.get_order_book(id), integration.get_order_book("IBM"));
+    EXPECT_EQ(integration.get_order_book(id)->level_count(Side::BID), 1u);
+}
+
+TEST(FeedIntegrationTest, TicksWithoutIdAreInterned) {
+    FeedIntegration integration;
+
+    feedhandler::common::Tick tick;
+    tick.copy_symbol("ORCL");
+    tick.price = feedhandler::common::double_to_price(100.00);
+    tick.qty = 10;
+    tick.side = 'S';
+    tick.timestamp = 1;
+    ASSERT_EQ(tick.instrument_id, feedhandler::common::INVALID_INSTRUMENT);
+    EXPECT_TRUE(integration.process_tick(tick));
+
+    auto id = feedhandler::common::SymbolTable::global().find("ORCL");
+    ASSERT_NE(integration.get_order_book(id), nullptr);
+    EXPECT_EQ(integration.get_order_book(id)->level_count(Side::ASK), 1u);
+}
+
+TEST(FeedIntegrationTest, ProcessTicksBatch) {
+    FeedIntegration integration;
+
+    std::vector<feedhandler::common::Tick> ticks(3);
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        ticks[i].copy_symbol("NFLX");
+        ticks[i].price = feedhandler::common::double_to_price(400.00 + i);
+        ticks[i].qty = 10;
+        ticks[i].side = 'B';
+        ticks[i].timestamp = i + 1;
+    }
+    ticks[2].qty = 0;  // Invalid, counted as error
+
+    EXPECT_EQ(integration.process_ticks(ticks), 2u);
+    EXPECT_EQ(integration.get_stats().ticks_processed, 3u);
+    EXPECT_EQ(integration.get_stats().errors, 1u);
+    EXPECT_EQ(integration.get_order_book("NFLX")->level_count(Side::BID), 2u);
+}
+
+TEST(FeedIntegrationTest, ReplaysMergedSessionsInTimestampOrder) {
+    // Receive times as captured: nanoseconds since the epoch, irregular
+    // gaps, several ticks of one read sharing a stamp, two instruments
+    auto session = [](std::vector<std::tuple<uint64_t, const char*, int32_t>> updates) {
+        auto ticks = std::make_shared<std::vector<feedhandler::common::Tick>>(updates.size());
+        for (size_t i = 0; i < updates.size(); ++i) {
+            (*ticks)[i].copy_symbol(std::get<1>(updates[i]));
+            (*ticks)[i].price = feedhandler::common::double_to_price(50.00);
+            (*ticks)[i].qty = std::get<2>(updates[i]);
+            (*ticks)[i].side = 'B';
+            (*ticks)[i].timestamp = std::get<0>(updates[i]);
+        }
+        auto next = std::make_shared<size_t>(0);
+        return [ticks, next](std::span<feedhandler::common::Tick> out) {
+            size_t count = std::min(out.size(), ticks->size() - *next);
+            std::copy_n(ticks->begin() + static_cast<std::ptrdiff_t>(*next), count, out.begin());
+            *next += count;
+            return count;
+        };
+    };
+    const uint64_t open = 1700000000123456789ULL;
+    feedhandler::pipeline::TimestampMerger<feedhandler::common::Tick> merger(2);
+    merger.add_source(session({{open, "MRGE", 100}, {open, "MRG2", 7}, {open + 48211, "MRGE", 300},
+                               {open + 9000317, "MRGE", 500}}));
+    merger.add_source(session({{open + 1502, "MRGE", 200}, {open + 1502, "MRG2", 8},
+                               {open + 731004, "MRGE", 400}, {open + 2000000000, "MRGE", 600}}));
+
+    FeedIntegration integration;
+    EXPECT_EQ(integration.replay(merger, 3), 8u);
+    EXPECT_EQ(integration.get_stats().errors, 0u);
+    EXPECT_EQ(integration.get_order_book("MRGE")->get_best_bid().quantity, 2100);
+    EXPECT_EQ(integration.get_order_book("MRG2")->get_best_bid().quantity, 15);
+    EXPECT_TRUE(merger.done());
+
+    // Every tick taken in turn: no gaps, nothing stale
+    const OrderBookHandler& handler = integration.get_handler("MRGE");
+    EXPECT_EQ(handler.get_last_sequence(), 6u);
+    EXPECT_EQ(handler.get_gap_stats().messages_dropped, 0u);
+    EXPECT_EQ(handler.get_gap_stats().stale_messages, 0u);
+    EXPECT_EQ(integration.get_handler("MRG2").get_last_sequence(), 2u);
+}
+
+TEST(FeedIntegrationTest, FeedSequenceIsGapChecked) {
+    FeedIntegration integration;
+
+    feedhandler::common::Tick tick;
+    tick.copy_symbol("SEQD");
+    tick.price = feedhandler::common::double_to_price(20.00);
+    tick.qty = 10;
+    tick.side = 'B';
+    tick.timestamp = 1700000000000000000ULL;
+    for (uint64_t sequence : {41, 42, 42, 44}) {
+        tick.sequence = sequence;
+        integration.process_tick(tick);
+    }
+
+    const OrderBookHandler& handler = integration.get_handler("SEQD");
+    EXPECT_EQ(handler.get_last_sequence(), 42u);
+    EXPECT_EQ(handler.get_gap_stats().stale_messages, 1u);
+    EXPECT_EQ(handler.get_gap_stats().messages_dropped, 1u);
+    EXPECT_EQ(integration.get_order_book("SEQD")->get_best_bid().quantity, 20);
+}
+
+TEST(FeedIntegrationTest, RecordsWireToBookLatency) {
+    FeedIntegration integration;
+    feedhandler::common::AtomicLatencyHistogram wire_to_book;
+    integration.set_latency_histogram(&wire_to_book);
+
+    // One read: every tick carries the same receive time
+    uint64_t received = feedhandler::common::Tick::current_timestamp_ns() - 1000000;
+    std::vector<feedhandler::common::Tick> ticks(3);
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        ticks[i].copy_symbol("NFLX");
+        ticks[i].price = feedhandler::common::double_to_price(400.00 + i);
+        ticks[i].qty = 10;
+        ticks[i].side = 'S';
+        ticks[i].timestamp = received;
+    }
+
+    EXPECT_EQ(integration.process_ticks(std::span<const feedhandler::common::Tick>(ticks.data(), 2)), 2u);
+    EXPECT_EQ(wire_to_book.snapshot().count(), 2u);
+    EXPECT_GE(wire_to_book.snapshot().min(), 999999u);
+
+    EXPECT_TRUE(integration.process_tick(ticks[2]));
+    EXPECT_EQ(wire_to_book.snapshot().count(), 3u);
+    EXPECT_EQ(integration.get_order_book("NFLX")->level_count(Side::ASK), 3u);
+    EXPECT_EQ(integration.get_handler("NFLX").get_gap_stats().stale_messages, 0u);
+    
+    // Book stage: one sample per tick, cleared with the counters
+    EXPECT_EQ(integration.book_latency().snapshot().count(), 3u);
+    integration.reset_stats();
+    EXPECT_EQ(integration.book_latency().snapshot().count(), 0u);
+}
+
+TEST(FeedIntegrationTest, ProfilesBookUpdateStage) {
+    FeedIntegration integration;
+    feedhandler::benchmarks::StageProfiler profiler;
+    integration.set_stage_profiler(&profiler);
+    ASSERT_EQ(profiler.stage_count(), 1u);
+    EXPECT_EQ(profiler.stage_name(0), "book_update");
+
+    std::vector<feedhandler::common::Tick> ticks(2);
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        ticks[i].copy_symbol("AMD");
+        ticks[i].price = feedhandler::common::double_to_price(150.00 + i);
+        ticks[i].qty = 10;
+        ticks[i].side = 'B';
+        ticks[i].timestamp = 1 + i;
+    }
+
+    // One sample per batch, not per tick
+    integration.process_ticks(std::span<const feedhandler::common::Tick>(ticks.data(), ticks.size()));
+    integration.process_market_data("8=FIX.4.4|35=X|268=1|279=0|269=1|55=AMD|270=151.00|271=5|");
+    EXPECT_EQ(profiler.batches(0), 2u);
+
+    integration.set_stage_profiler(nullptr);
+    ticks[0].timestamp = 3;
+    integration.process_tick(ticks[0]);
+    EXPECT_EQ(profiler.batches(0), 2u);
+}
+
+TEST(FeedIntegrationTest, UnknownInstrumentIdHasNoBook) {
+    FeedIntegration integration;
+    EXPECT_EQ(integration.get_order_book(feedhandler::common::INVALID_INSTRUMENT), nullptr);
+    EXPECT_EQ(integration.get_handler(feedhandler::common::INVALID_INSTRUMENT), nullptr);
+}
+
+TEST(FeedIntegrationTest, IncrementalRefreshUpdatesBookDirectly) {
+    FeedIntegration integration;
+
+    EXPECT_EQ(integration.process_market_data(
+        "8=FIX.4.4|35=X|268=3|"
+        "279=0|269=0|55=AMZN|270=180.25|271=100|"
+        "279=0|269=0|55=AMZN|270=180.20|271=50|"
+        "279=0|269=1|55=AMZN|270=180.30|271=70|10=000|"), 3u);
+
+    OrderBook* book = integration.get_order_book("AMZN");
+    ASSERT_NE(book, nullptr);
+    EXPECT_EQ(book->level_count(Side::BID), 2u);
+    EXPECT_EQ(book->get_best_bid().price, 1802500);
+    EXPECT_EQ(book->get_best_bid().quantity, 100);
+
+    // Change sets the level size, delete removes the level, trades are skipped
+    EXPECT_EQ(integration.process_market_data(
+        "8=FIX.4.4|35=X|268=3|"
+        "279=1|269=0|55=AMZN|270=180.25|271=40|"
+        "279=2|269=1|55=AMZN|270=180.30|271=0|"
+        "279=0|269=2|55=AMZN|270=180.25|271=5|10=000|"), 2u);
+    EXPECT_EQ(book->get_best_bid().quantity, 40);
+    EXPECT_EQ(book->level_count(Side::ASK), 0u);
+
+    const auto& stats = integration.get_stats();
+    EXPECT_EQ(stats.entries_processed, 6u);
+    EXPECT_EQ(stats.events_generated, 5u);
+    EXPECT_EQ(stats.ticks_processed, 0u);
+    EXPECT_EQ(stats.errors, 0u);
+
+    const auto& handler_stats = integration.get_handler("AMZN").get_stats();
+    EXPECT_EQ(handler_stats.new_orders, 3u);
+    EXPECT_EQ(handler_stats.modifications, 1u);
+    EXPECT_EQ(handler_stats.deletions, 1u);
+}
+
+TEST(FeedIntegrationTest, DeleteOfUnknownLevelCountsAsError) {
+    FeedIntegration integration;
+
+    EXPECT_EQ(integration.process_market_data(
+        "8=FIX.4.4|35=X|268=1|279=2|269=0|55=CSCO|270=50.00|271=0|"), 0u);
+    EXPECT_EQ(integration.get_stats().errors, 1u);
+    EXPECT_TRUE(integration.get_order_book("CSCO")->is_empty());
+}
+
+TEST(FeedIntegrationTest, WarmUpLeavesEmptyReservedBooks) {
+    FeedIntegration integration;
+    OrderBookConfig ladder;
+    ladder.ladder_type = LadderType::ARRAY;
+    ladder.tick_size = 5;
+    ladder.price_scale = 100;
+    ladder.initial_levels = 64;
+    integration.set_book_config("WARM2", ladder);
+
+    FeedIntegration::WarmupConfig config;
+    config.levels_per_side = 200;
+    config.rounds = 3;
+    const std::vector<std::string> symbols = {"WARM1", "WARM2"};
+    EXPECT_EQ(integration.warm_up(symbols, config), 2u * 3 * 2 * 200);
+
+    OrderBook* map_book = integration.get_order_book("WARM1");
+    OrderBook* array_book = integration.get_order_book("WARM2");
+    ASSERT_NE(map_book, nullptr);
+    ASSERT_NE(array_book, nullptr);
+    EXPECT_TRUE(map_book->is_empty());
+    EXPECT_TRUE(array_book->is_empty());
+    EXPECT_EQ(map_book->spare_levels(Side::BID), 200u);
+    EXPECT_EQ(map_book->spare_levels(Side::ASK), 200u);
+    EXPECT_EQ(integration.get_stats().ticks_processed, 0u);
+    EXPECT_EQ(integration.get_handler("WARM1").get_stats().new_orders, 0u);
+    EXPECT_EQ(integration.get_handler("WARM1").get_last_sequence(), 0u);
+    EXPECT_EQ(integration.get_handler("WARM1").get_gap_stats().messages_dropped, 0u);
+
+    // Live ticks start from a clean book and sequence
+    feedhandler::common::Tick tick;
+    tick.copy_symbol("WARM1");
+    tick.price = feedhandler::common::double_to_price(42.00);
+    tick.qty = 10;
+    tick.side = 'B';
+    tick.timestamp = 1000;
+    EXPECT_TRUE(integration.process_tick(tick));
+    EXPECT_EQ(map_book->level_count(Side::BID), 1u);
+    EXPECT_EQ(map_book->spare_levels(Side::BID), 199u);
+    EXPECT_EQ(integration.get_stats().ticks_processed, 1u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "orderbook/order_book.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 using namespace orderbook;
 
 class OrderBookTest : public ::testing::Test {
@@ -311,6 +315,552 @@ TEST_F(OrderBookTest, DeleteZeroQuantityIgnored) {
     EXPECT_EQ(best_bid.quantity, 100);  // Unchanged
 }
 
+// ============================================================================
+// Array Ladder Tests
+// ============================================================================
+
+class ArrayOrderBookTest : public ::testing::Test {
+protected:
+    static OrderBookConfig array_config() {
+        OrderBookConfig config;
+        config.ladder_type = LadderType::ARRAY;
+        config.tick_size = 100;         // $0.01 in fixed-point
+        config.initial_levels = 64;     // Small window to exercise re-anchoring
+        return config;
+    }
+    
+    OrderBook book{"AAPL", array_config()};
+    
+    int64_t to_fixed(double price) {
+        return static_cast<int64_t>(price * 10000 + 0.5);
+    }
+};
+
+TEST_F(ArrayOrderBookTest, UsesArrayLadder) {
+    EXPECT_EQ(book.ladder_type(), LadderType::ARRAY);
+    EXPECT_TRUE(book.is_empty());
+}
+
+TEST_F(ArrayOrderBookTest, BidsSortedDescendingAsksAscending) {
+    book.add_order(Side::BID, to_fixed(149.98), 100);
+    book.add_order(Side::BID, to_fixed(150.00), 200);
+    book.add_order(Side::BID, to_fixed(149.99), 300);
+    book.add_order(Side::ASK, to_fixed(150.03), 100);
+    book.add_order(Side::ASK, to_fixed(150.01), 200);
+    book.add_order(Side::ASK, to_fixed(150.02), 300);
+    
+    auto bids = book.get_depth(Side::BID, 10);
+    ASSERT_EQ(bids.size(), 3);
+    EXPECT_EQ(bids[0].price, to_fixed(150.00));
+    EXPECT_EQ(bids[1].price, to_fixed(149.99));
+    EXPECT_EQ(bids[2].price, to_fixed(149.98));
+    
+    auto asks = book.get_depth(Side::ASK, 2);
+    ASSERT_EQ(asks.size(), 2);
+    EXPECT_EQ(asks[0].price, to_fixed(150.01));
+    EXPECT_EQ(asks[1].price, to_fixed(150.02));
+    
+    EXPECT_EQ(book.get_spread(), to_fixed(0.01));
+}
+
+TEST_F(ArrayOrderBookTest, ModifyAndDeleteRemoveLevels) {
+    book.add_order(Side::BID, to_fixed(150.00), 100);
+    book.add_order(Side::BID, to_fixed(149.99), 100);
+    
+    book.modify_order(Side::BID, to_fixed(150.00), -100);
+    EXPECT_EQ(book.level_count(Side::BID), 1);
+    EXPECT_EQ(book.get_best_bid().price, to_fixed(149.99));
+    
+    book.delete_order(Side::BID, to_fixed(149.99), 100);
+    EXPECT_TRUE(book.is_empty());
+    EXPECT_EQ(book.get_best_bid().price, 0);
+}
+
+TEST_F(ArrayOrderBookTest, PricesOutsideWindowReanchor) {
+    // Far wider than the 64-tick initial window
+    book.add_order(Side::ASK, to_fixed(150.00), 100);
+    book.add_order(Side::ASK, to_fixed(155.00), 200);
+    book.add_order(Side::ASK, to_fixed(140.00), 300);
+    
+    EXPECT_EQ(book.level_count(Side::ASK), 3);
+    auto asks = book.get_depth(Side::ASK, 10);
+    ASSERT_EQ(asks.size(), 3);
+    EXPECT_EQ(asks[0].price, to_fixed(140.00));
+    EXPECT_EQ(asks[0].quantity, 300);
+    EXPECT_EQ(asks[1].price, to_fixed(150.00));
+    EXPECT_EQ(asks[2].price, to_fixed(155.00));
+}
+
+TEST_F(ArrayOrderBookTest, OffTickPriceIgnored) {
+    book.add_order(Side::BID, to_fixed(150.00), 100);
+    book.add_order(Side::BID, to_fixed(150.00) + 50, 100);
+    
+    EXPECT_EQ(book.level_count(Side::BID), 1);
+    EXPECT_EQ(book.get_best_bid().quantity, 100);
+}
+
+TEST_F(ArrayOrderBookTest, OutlierPriceDoesNotGrowWindowPastMax) {
+    OrderBookConfig config = array_config();
+    config.max_levels = 1024;
+    OrderBook bounded("AAPL", config);
+    
+    bounded.add_order(Side::BID, to_fixed(150.00), 100);
+    bounded.add_order(Side::BID, to_fixed(149.00), 100);  // 100 ticks away: grows
+    EXPECT_EQ(bounded.level_count(Side::BID), 2u);
+    
+    // A bad print ~100M ticks away (and one below zero) would need a
+    // window of gigabytes; both are dropped and counted instead
+    bounded.add_order(Side::BID, to_fixed(1000000.00), 100);
+    bounded.add_order(Side::BID, -to_fixed(1000000.00), 100);
+    EXPECT_EQ(bounded.level_count(Side::BID), 2u);
+    EXPECT_EQ(bounded.out_of_window(Side::BID), 2u);
+    EXPECT_LE(bounded.window_levels(Side::BID), 1024u);
+    EXPECT_EQ(bounded.get_best_bid().price, to_fixed(150.00));
+    
+    // Prices that still fit keep growing the window up to the limit
+    bounded.add_order(Side::BID, to_fixed(145.00), 100);
+    EXPECT_EQ(bounded.level_count(Side::BID), 3u);
+    EXPECT_EQ(bounded.window_levels(Side::BID), 1024u);
+    
+    // The same goes for a batch
+    const BookUpdate batch[] = {{BookUpdate::Action::ADD, Side::BID, to_fixed(50000.00), 100}};
+    bounded.apply_batch(batch);
+    EXPECT_EQ(bounded.out_of_window(Side::BID), 3u);
+    EXPECT_EQ(bounded.window_levels(Side::BID), 1024u);
+    
+    // Once the side empties, a new price range anchors a fresh window
+    bounded.clear();
+    bounded.add_order(Side::BID, to_fixed(1000000.00), 100);
+    EXPECT_EQ(bounded.get_best_bid().price, to_fixed(1000000.00));
+}
+
+TEST_F(ArrayOrderBookTest, LoadKeepsMaxLevelsFromTheTouch) {
+    OrderBookConfig config = array_config();
+    config.max_levels = 128;
+    OrderBook bounded("AAPL", config);
+    
+    const PriceLevel bids[] = {{to_fixed(150.00), 10, 1}, {to_fixed(149.50), 20, 1}, {to_fixed(0.01), 30, 1}};
+    const PriceLevel asks[] = {{to_fixed(150.01), 10, 1}, {to_fixed(150.60), 20, 1}, {to_fixed(99999.99), 30, 1}};
+    EXPECT_EQ(bounded.load_levels(bids, asks), 4u);
+    EXPECT_EQ(bounded.out_of_window(Side::BID), 1u);
+    EXPECT_EQ(bounded.out_of_window(Side::ASK), 1u);
+    EXPECT_LE(bounded.window_levels(Side::BID), 128u);
+    EXPECT_LE(bounded.window_levels(Side::ASK), 128u);
+    EXPECT_EQ(bounded.get_depth(Side::BID, 10).back().price, to_fixed(149.50));
+    EXPECT_EQ(bounded.get_depth(Side::ASK, 10).back().price, to_fixed(150.60));
+}
+
+TEST_F(ArrayOrderBookTest, MatchesMapLadder) {
+    OrderBookConfig map_config;
+    map_config.tick_size = 100;
+    OrderBook map_book("AAPL", map_config);
+    
+    // Deterministic pseudo-random walk of adds/deletes across both sides
+    uint32_t state = 12345;
+    auto next = [&state]() {
+        state = state * 1103515245u + 12345u;
+        return (state >> 16) & 0x7FFF;
+    };
+    
+    for (int i = 0; i < 5000; ++i) {
+        Side side = (next() & 1) ? Side::BID : Side::ASK;
+        int64_t price = to_fixed(150.00) + (static_cast<int64_t>(next() % 400) - 200) * 100;
+        int64_t qty = static_cast<int64_t>(next() % 500) + 1;
+        
+        if (next() % 3 == 0) {
+            book.delete_order(side, price, qty);
+            map_book.delete_order(side, price, qty);
+        } else {
+            book.add_order(side, price, qty);
+            map_book.add_order(side, price, qty);
+        }
+    }
+    
+    for (Side side : {Side::BID, Side::ASK}) {
+        auto array_depth = book.get_depth(side, 1000);
+        auto map_depth = map_book.get_depth(side, 1000);
+        ASSERT_EQ(array_depth.size(), map_depth.size());
+        for (size_t i = 0; i < array_depth.size(); ++i) {
+            EXPECT_EQ(array_depth[i].price, map_depth[i].price);
+            EXPECT_EQ(array_depth[i].quantity, map_depth[i].quantity);
+            EXPECT_EQ(array_depth[i].order_count, map_depth[i].order_count);
+        }
+    }
+    EXPECT_EQ(book.get_spread(), map_book.get_spread());
+    EXPECT_EQ(book.get_mid_price(), map_book.get_mid_price());
+}
+
+TEST_F(ArrayOrderBookTest, ClearResetsWindow) {
+    book.add_order(Side::BID, to_fixed(150.00), 100);
+    book.clear();
+    EXPECT_TRUE(book.is_empty());
+    
+    // A completely different price range works after clear
+    book.add_order(Side::BID, to_fixed(10.00), 100);
+    EXPECT_EQ(book.get_best_bid().price, to_fixed(10.00));
+}
+
+// ============================================================================
+// Top-of-Book Cache Tests
+// ============================================================================
+
+TEST_F(OrderBookTest, VersionIgnoresChangesBelowCachedLevels) {
+    for (size_t i = 0; i < OrderBook::CACHED_LEVELS; ++i) {
+        book.add_order(Side::BID, to_fixed(150.00) - static_cast<int64_t>(i) * 100, 100);
+    }
+    uint64_t version = book.version();
+    
+    book.add_order(Side::BID, to_fixed(140.00), 100);      // Below the cache
+    book.delete_order(Side::BID, to_fixed(140.00), 100);
+    EXPECT_EQ(book.version(), version);
+    
+    book.modify_order(Side::BID, to_fixed(149.99), 50);    // Second level
+    EXPECT_NE(book.version(), version);
+    
+    auto top = book.top_levels(Side::BID, 3);
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(top[0].price, to_fixed(150.00));
+    EXPECT_EQ(top[1].quantity, 150);
+    EXPECT_EQ(book.top_levels(Side::ASK).size(), 0u);
+    
+    // Removing a cached level pulls the next one up from below
+    book.add_order(Side::BID, to_fixed(140.00), 7);
+    book.delete_order(Side::BID, to_fixed(150.00), 100);
+    auto full = book.top_levels(Side::BID);
+    ASSERT_EQ(full.size(), OrderBook::CACHED_LEVELS);
+    EXPECT_EQ(full.back().price, to_fixed(140.00));
+    EXPECT_EQ(full.back().quantity, 7);
+}
+
+TEST(OrderBookCacheTest, CacheTracksBookUnderRandomWalk) {
+    for (LadderType type : {LadderType::MAP, LadderType::ARRAY}) {
+        OrderBookConfig config;
+        config.ladder_type = type;
+        config.tick_size = 100;
+        config.initial_levels = 64;
+        OrderBook book("AAPL", config);
+        
+        uint32_t state = 777;
+        auto next = [&state]() {
+            state = state * 1103515245u + 12345u;
+            return (state >> 16) & 0x7FFF;
+        };
+        
+        for (int i = 0; i < 5000; ++i) {
+            Side side = (next() & 1) ? Side::BID : Side::ASK;
+            int64_t price = 1500000 + (static_cast<int64_t>(next() % 60) - 30) * 100;
+            int64_t qty = static_cast<int64_t>(next() % 500) + 1;
+            switch (next() % 3) {
+                case 0: book.delete_order(side, price, qty); break;
+                case 1: book.modify_order(side, price, static_cast<int64_t>(next() % 400) - 300); break;
+                default: book.add_order(side, price, qty); break;
+            }
+            
+            for (Side s : {Side::BID, Side::ASK}) {
+                auto cached = book.top_levels(s);
+                auto full = book.get_depth(s, 1000);
+                ASSERT_EQ(cached.size(), std::min(full.size(), OrderBook::CACHED_LEVELS));
+                for (size_t j = 0; j < cached.size(); ++j) {
+                    ASSERT_EQ(cached[j], full[j]) << "step " << i << " level " << j;
+                }
+            }
+        }
+    }
+}
+
+TEST(OrderBookSnapshotTest, PublishesOnlyWhenEnabled) {
+    OrderBook plain("AAPL");
+    OrderBook::Snapshot snapshot;
+    plain.add_order(Side::BID, 1500000, 100);
+    EXPECT_FALSE(plain.read_snapshot(snapshot));
+    EXPECT_EQ(plain.published_version(), 0u);
+    
+    OrderBookConfig config;
+    config.publish_snapshots = true;
+    OrderBook book("AAPL", config);
+    book.add_order(Side::BID, 1500000, 100);
+    book.add_order(Side::ASK, 1500100, 40);
+    book.add_order(Side::BID, 1490000, 10);
+    ASSERT_TRUE(book.read_snapshot(snapshot));
+    EXPECT_EQ(snapshot.version, book.version());
+    EXPECT_EQ(book.published_version(), book.version());
+    ASSERT_EQ(snapshot.bid_levels().size(), 2u);
+    EXPECT_EQ(snapshot.best_bid().price, 1500000);
+    EXPECT_EQ(snapshot.bids[1].price, 1490000);
+    EXPECT_EQ(snapshot.best_ask().quantity, 40);
+    
+    book.clear();
+    ASSERT_TRUE(book.read_snapshot(snapshot));
+    EXPECT_EQ(snapshot.bid_count, 0u);
+    EXPECT_EQ(snapshot.ask_count, 0u);
+}
+
+TEST(OrderBookSnapshotTest, ReadersSeeConsistentSnapshotsWhileWriting) {
+    OrderBookConfig config;
+    config.publish_snapshots = true;
+    OrderBook book("AAPL", config);
+    std::atomic<bool> done{false};
+    
+    // Owner thread: slide a window of levels up and down; every level's
+    // quantity is derived from its price so torn copies show
+    std::thread writer([&] {
+        for (int round = 0; round < 20000; ++round) {
+            int64_t price = 1500000 + (round % 40) * 100;
+            book.add_order(Side::BID, price, price % 997 + 1);
+            book.add_order(Side::ASK, price + 10000, (price + 10000) % 997 + 1);
+            if (round >= 15) {
+                int64_t old = 1500000 + ((round - 15) % 40) * 100;
+                book.delete_order(Side::BID, old, old % 997 + 1);
+                book.delete_order(Side::ASK, old + 10000, (old + 10000) % 997 + 1);
+            }
+        }
+        done.store(true);
+    });
+    
+    uint64_t bad = 0;
+    uint64_t reads = 0;
+    uint64_t last_version = 0;
+    OrderBook::Snapshot snapshot;
+    while (!done.load()) {
+        if (book.published_version() == last_version) {
+            continue;
+        }
+        book.read_snapshot(snapshot);
+        ++reads;
+        bad += snapshot.version < last_version;
+        last_version = snapshot.version;
+        for (uint32_t i = 0; i < snapshot.bid_count; ++i) {
+            bad += snapshot.bids[i].quantity != snapshot.bids[i].price % 997 + 1;
+            bad += i > 0 && snapshot.bids[i].price >= snapshot.bids[i - 1].price;
+        }
+        for (uint32_t i = 0; i < snapshot.ask_count; ++i) {
+            bad += snapshot.asks[i].quantity != snapshot.asks[i].price % 997 + 1;
+            bad += i > 0 && snapshot.asks[i].price <= snapshot.asks[i - 1].price;
+        }
+    }
+    writer.join();
+    
+    EXPECT_EQ(bad, 0u);
+    EXPECT_GT(reads, 0u);
+    book.read_snapshot(snapshot);
+    EXPECT_EQ(snapshot.version, book.version());
+}
+
+TEST(OrderBookBatchTest, BatchMatchesSequentialUpdates) {
+    for (LadderType type : {LadderType::MAP, LadderType::ARRAY}) {
+        OrderBookConfig config;
+        config.ladder_type = type;
+        config.tick_size = 100;
+        config.initial_levels = 64;
+        OrderBook batched("AAPL", config);
+        OrderBook sequential("AAPL", config);
+        
+        uint32_t state = 4242;
+        auto next = [&state]() {
+            state = state * 1103515245u + 12345u;
+            return (state >> 16) & 0x7FFF;
+        };
+        
+        std::vector<BookUpdate> batch;
+        for (int round = 0; round < 300; ++round) {
+            // Few distinct levels per batch so levels are hit repeatedly,
+            // including removed and re-created within one batch
+            batch.clear();
+            size_t size = next() % 40 + 1;
+            for (size_t i = 0; i < size; ++i) {
+                BookUpdate update;
+                update.side = (next() & 1) ? Side::BID : Side::ASK;
+                update.price = 1500000 + (static_cast<int64_t>(next() % 24) - 12) * 100;
+                switch (next() % 3) {
+                    case 0:
+                        update.action = BookUpdate::Action::DELETE;
+                        update.quantity = static_cast<int64_t>(next() % 500) + 1;
+                        break;
+                    case 1:
+                        update.action = BookUpdate::Action::MODIFY;
+                        update.quantity = static_cast<int64_t>(next() % 400) - 300;
+                        break;
+                    default:
+                        update.action = BookUpdate::Action::ADD;
+                        update.quantity = static_cast<int64_t>(next() % 500) + 1;
+                        break;
+                }
+                batch.push_back(update);
+            }
+            
+            batched.apply_batch(batch);
+            for (const auto& update : batch) {
+                switch (update.action) {
+                    case BookUpdate::Action::ADD: sequential.add_order(update.side, update.price, update.quantity); break;
+                    case BookUpdate::Action::MODIFY: sequential.modify_order(update.side, update.price, update.quantity); break;
+                    case BookUpdate::Action::DELETE: sequential.delete_order(update.side, update.price, update.quantity); break;
+                }
+            }
+            
+            for (Side s : {Side::BID, Side::ASK}) {
+                ASSERT_EQ(batched.get_depth(s, 1000), sequential.get_depth(s, 1000)) << "round " << round;
+                auto cached = batched.top_levels(s);
+                auto expected = sequential.top_levels(s);
+                ASSERT_TRUE(std::equal(cached.begin(), cached.end(), expected.begin(), expected.end()))
+                    << "round " << round;
+            }
+        }
+    }
+}
+
+TEST(OrderBookBatchTest, CoalescesLevelsAndBumpsVersionOnce) {
+    OrderBookConfig config;
+    config.publish_snapshots = true;
+    OrderBook book("AAPL", config);
+    
+    const BookUpdate updates[] = {
+        {BookUpdate::Action::ADD, Side::BID, 1500000, 100},
+        {BookUpdate::Action::ADD, Side::ASK, 1500100, 200},
+        {BookUpdate::Action::ADD, Side::BID, 1500000, 50},
+        {BookUpdate::Action::MODIFY, Side::BID, 1500000, -30},
+        {BookUpdate::Action::DELETE, Side::ASK, 1500100, 200},  // Removed...
+        {BookUpdate::Action::ADD, Side::ASK, 1500100, 70},      // ...and re-created
+    };
+    EXPECT_EQ(book.apply_batch(updates), 2u);
+    EXPECT_EQ(book.version(), 1u);
+    EXPECT_EQ(book.published_version(), 1u);
+    EXPECT_EQ(book.get_best_bid(), PriceLevel(1500000, 120, 2));
+    EXPECT_EQ(book.get_best_ask(), PriceLevel(1500100, 70, 1));
+    
+    // A batch that changes nothing visible leaves the version alone
+    const BookUpdate noop[] = {{BookUpdate::Action::MODIFY, Side::BID, 1490000, 10}};
+    EXPECT_EQ(book.apply_batch(noop), 1u);
+    EXPECT_EQ(book.apply_batch(std::span<const BookUpdate>()), 0u);
+    EXPECT_EQ(book.version(), 1u);
+}
+
+TEST(OrderBookLoadTest, LoadLevelsReplacesBook) {
+    for (LadderType type : {LadderType::MAP, LadderType::ARRAY}) {
+        OrderBookConfig config;
+        config.ladder_type = type;
+        config.tick_size = 100;
+        config.initial_levels = 64;
+        OrderBook book("AAPL", config);
+        
+        // Existing levels, some of which the snapshot does not contain
+        for (int i = 0; i < 20; ++i) {
+            book.add_order(Side::BID, 1400000 - i * 100, 10);
+            book.add_order(Side::ASK, 1400100 + i * 100, 10);
+        }
+        
+        std::vector<PriceLevel> bids;
+        std::vector<PriceLevel> asks;
+        for (int i = 0; i < 500; ++i) {  // Wider than the array window
+            bids.emplace_back(1500000 - i * 100, 100 + i, 3);
+            asks.emplace_back(1500100 + i * 100, 200 + i, 2);
+        }
+        uint64_t version = book.version();
+        EXPECT_EQ(book.load_levels(bids, asks), 1000u);
+        EXPECT_EQ(book.version(), version + 1);
+        
+        EXPECT_EQ(book.level_count(Side::BID), 500u);
+        EXPECT_EQ(book.level_count(Side::ASK), 500u);
+        EXPECT_EQ(book.get_depth(Side::BID, 1000), bids);
+        EXPECT_EQ(book.get_depth(Side::ASK, 1000), asks);
+        EXPECT_EQ(book.get_best_bid(), PriceLevel(1500000, 100, 3));
+        EXPECT_EQ(book.get_best_ask(), PriceLevel(1500100, 200, 2));
+        
+        // Updates after the load apply normally
+        book.add_order(Side::BID, 1500100 - 50 * 100, 5);
+        book.delete_order(Side::ASK, 1500100, 200);
+        EXPECT_EQ(book.get_best_ask().price, 1500200);
+        
+        // Reloading a smaller book drops what it does not contain
+        const PriceLevel small_bids[] = {{1490000, 7, 1}, {1489900, 0, 1}, {1489800, 8, 1}};
+        EXPECT_EQ(book.load_levels(small_bids, {}), 2u);
+        EXPECT_EQ(book.level_count(Side::BID), 2u);
+        EXPECT_EQ(book.level_count(Side::ASK), 0u);
+        EXPECT_EQ(book.get_best_bid(), PriceLevel(1490000, 7, 1));
+        EXPECT_EQ(book.get_best_ask().price, 0);
+    }
+}
+
+TEST(OrderBookReserveTest, MapLevelsReuseReservedNodes) {
+    OrderBook book("AAPL");
+    EXPECT_EQ(book.spare_levels(Side::BID), 0u);
+    book.reserve_levels(100);
+    EXPECT_EQ(book.spare_levels(Side::BID), 100u);
+    EXPECT_EQ(book.spare_levels(Side::ASK), 100u);
+
+    for (int i = 0; i < 60; ++i) {
+        book.add_order(Side::BID, 1000000 - i * 100, 10);
+        book.add_order(Side::ASK, 1000100 + i * 100, 10);
+    }
+    EXPECT_EQ(book.spare_levels(Side::BID), 40u);
+    EXPECT_EQ(book.get_best_bid(), PriceLevel(1000000, 10, 1));
+    EXPECT_EQ(book.get_best_ask(), PriceLevel(1000100, 10, 1));
+    EXPECT_EQ(book.get_depth(Side::BID, 3)[2].price, 999800);
+
+    // Erased levels park their node; new levels take it back
+    book.delete_order(Side::BID, 1000000, 10);
+    book.modify_order(Side::ASK, 1000100, -10);
+    EXPECT_EQ(book.spare_levels(Side::BID), 41u);
+    EXPECT_EQ(book.spare_levels(Side::ASK), 41u);
+    book.add_order(Side::BID, 1000050, 7);
+    EXPECT_EQ(book.spare_levels(Side::BID), 40u);
+    EXPECT_EQ(book.get_best_bid(), PriceLevel(1000050, 7, 1));
+
+    const BookUpdate updates[] = {{BookUpdate::Action::DELETE, Side::ASK, 1000200, 10},
+                                  {BookUpdate::Action::ADD, Side::ASK, 1000000, 5}};
+    book.apply_batch(updates);
+    EXPECT_EQ(book.spare_levels(Side::ASK), 41u);
+    EXPECT_EQ(book.get_best_ask(), PriceLevel(1000000, 5, 1));
+
+    // clear() and load_levels() keep nodes up to the reserve, no more
+    book.clear();
+    EXPECT_EQ(book.spare_levels(Side::BID), 100u);
+    const PriceLevel bids[] = {{900000, 1, 1}, {899900, 2, 1}};
+    EXPECT_EQ(book.load_levels(bids, {}), 2u);
+    EXPECT_EQ(book.spare_levels(Side::BID), 98u);
+    EXPECT_EQ(book.spare_levels(Side::ASK), 100u);
+    EXPECT_EQ(book.get_best_bid(), PriceLevel(900000, 1, 1));
+
+    for (int i = 0; i < 150; ++i) {
+        book.add_order(Side::ASK, 2000000 + i, 1);
+    }
+    EXPECT_EQ(book.spare_levels(Side::ASK), 0u);
+    book.clear();
+    EXPECT_EQ(book.spare_levels(Side::ASK), 100u);
+
+    // A smaller reserve later does not shrink the stash
+    book.reserve_levels(10);
+    EXPECT_EQ(book.spare_levels(Side::ASK), 100u);
+}
+
+TEST(OrderBookReserveTest, ArrayReserveGrowsWindow) {
+    OrderBookConfig config;
+    config.ladder_type = LadderType::ARRAY;
+    config.tick_size = 100;
+    config.initial_levels = 64;
+    OrderBook book("AAPL", config);
+    book.add_order(Side::BID, 1000000, 10);
+    book.reserve_levels(1000);
+    EXPECT_EQ(book.spare_levels(Side::BID), 0u);
+    EXPECT_EQ(book.get_best_bid(), PriceLevel(1000000, 10, 1));
+    for (int i = 1; i < 400; ++i) {
+        book.add_order(Side::BID, 1000000 + i * 100, 1);
+    }
+    EXPECT_EQ(book.level_count(Side::BID), 400u);
+    EXPECT_EQ(book.get_best_bid().price, 1000000 + 399 * 100);
+}
+
+TEST(OrderBookLoadTest, ArrayLoadSkipsOffTickAndDuplicatePrices) {
+    OrderBookConfig config;
+    config.ladder_type = LadderType::ARRAY;
+    config.tick_size = 100;
+    OrderBook book("AAPL", config);
+    
+    const PriceLevel bids[] = {{1500000, 10, 1}, {1499950, 20, 1}, {1500000, 30, 1}, {1499900, 40, 1}};
+    EXPECT_EQ(book.load_levels(bids, {}), 2u);
+    EXPECT_EQ(book.get_best_bid(), PriceLevel(1500000, 10, 1));
+    EXPECT_EQ(book.get_depth(Side::BID, 10).back(), PriceLevel(1499900, 40, 1));
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "orderbook/partitioned_feed_integration.hpp"
+#include "orderbook/feed_integration.hpp"
+#include "common/tick.hpp"
+#include "common/symbol_table.hpp"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+// Ticks for symbols with per-symbol feed sequence numbers (gap-checked
+// by each book), random prices and sides
+class TickStream {
+public:
+    explicit TickStream(uint32_t seed) : rng_(seed) {}
+
+    feedhandler::common::Tick next(const std::string& symbol) {
+        feedhandler::common::Tick tick;
+        tick.copy_symbol(symbol);
+        tick.side = rng_() % 2 ? 'B' : 'S';
+        tick.price = feedhandler::common::double_to_price(tick.side == 'B' ? 100.0 : 101.0) +
+                     static_cast<int64_t>(rng_() % 20) * 100;
+        tick.qty = static_cast<int32_t>(1 + rng_() % 500);
+        tick.sequence = ++sequence_[symbol];
+        tick.timestamp = feedhandler::common::Tick::current_timestamp_ns();
+        return tick;
+    }
+
+private:
+    std::mt19937 rng_;
+    std::map<std::string, uint64_t> sequence_;
+};
+
+// Symbols whose initial worker is `worker`
+std::vector<std::string> symbols_on(const PartitionedFeedIntegration& partitioned, size_t worker, size_t count) {
+    std::vector<std::string> symbols;
+    for (int i = 0; symbols.size() < count; ++i) {
+        std::string symbol = "P" + std::to_string(i);
+        if (partitioned.hash_worker(symbol) == worker) {
+            symbols.push_back(symbol);
+        }
+    }
+    return symbols;
+}
+
+void expect_same_book(OrderBook* actual, OrderBook* expected, const std::string& symbol) {
+    ASSERT_NE(actual, nullptr) << symbol;
+    ASSERT_NE(expected, nullptr) << symbol;
+    for (Side side : {Side::BID, Side::ASK}) {
+        auto actual_levels = actual->get_depth(side, 1000);
+        auto expected_levels = expected->get_depth(side, 1000);
+        ASSERT_EQ(actual_levels.size(), expected_levels.size()) << symbol;
+        for (size_t i = 0; i < actual_levels.size(); ++i) {
+            EXPECT_EQ(actual_levels[i].price, expected_levels[i].price) << symbol;
+            EXPECT_EQ(actual_levels[i].quantity, expected_levels[i].quantity) << symbol;
+            EXPECT_EQ(actual_levels[i].order_count, expected_levels[i].order_count) << symbol;
+        }
+    }
+}
+
+} // namespace
+
+TEST(PartitionedFeedIntegrationTest, RoutesEachSymbolToItsHashedWorker) {
+    PartitionedFeedIntegration::Config config;
+    config.worker_count = 3;
+    PartitionedFeedIntegration partitioned(config);
+    TickStream stream(1);
+
+    EXPECT_FALSE(partitioned.route(stream.next("P0")));  // Not started
+    ASSERT_TRUE(partitioned.start());
+    EXPECT_FALSE(partitioned.start());
+
+    const std::vector<std::string> symbols = {"AAPL", "MSFT", "GOOGL", "TSLA", "NVDA", "AMZN"};
+    for (int round = 0; round < 50; ++round) {
+        for (const auto& symbol : symbols) {
+            ASSERT_TRUE(partitioned.route(stream.next(symbol)));
+        }
+    }
+    partitioned.flush();
+
+    auto& table = feedhandler::common::SymbolTable::global();
+    uint64_t routed = 0;
+    for (const auto& symbol : symbols) {
+        size_t worker = partitioned.worker_for(table.intern(symbol));
+        EXPECT_EQ(worker, partitioned.hash_worker(symbol));
+        EXPECT_NE(partitioned.integration(worker).get_order_book(symbol), nullptr);
+    }
+    for (size_t i = 0; i < partitioned.worker_count(); ++i) {
+        auto stats = partitioned.worker_stats(i);
+        EXPECT_EQ(stats.ticks_applied, stats.ticks_routed);
+        routed += stats.ticks_routed;
+    }
+    EXPECT_EQ(routed, 50 * symbols.size());
+    EXPECT_EQ(partitioned.worker_for(table.intern("UNSEEN")), partitioned.worker_count());
+    partitioned.stop();
+}
+
+TEST(PartitionedFeedIntegrationTest, MatchesSingleThreadedIntegration) {
+    PartitionedFeedIntegration::Config config;
+    config.worker_count = 3;
+    config.queue_capacity = 64;  // Small enough for the producer to wait on full rings
+    PartitionedFeedIntegration partitioned(config);
+    FeedIntegration reference;
+    TickStream stream(7);
+
+    const std::vector<std::string> symbols = {"AAPL", "MSFT", "GOOGL", "TSLA", "NVDA", "AMZN", "META", "NFLX"};
+    std::vector<feedhandler::common::Tick> ticks;
+    std::mt19937 pick(3);
+    for (int i = 0; i < 20000; ++i) {
+        ticks.push_back(stream.next(symbols[pick() % symbols.size()]));
+    }
+
+    ASSERT_TRUE(partitioned.start());
+    for (size_t offset = 0; offset < ticks.size(); offset += 100) {
+        std::span<const feedhandler::common::Tick> batch(ticks.data() + offset, 100);
+        EXPECT_EQ(partitioned.route_batch(batch), batch.size());
+    }
+    partitioned.stop();
+    reference.process_ticks(ticks);
+
+    for (const auto& symbol : symbols) {
+        expect_same_book(partitioned.get_order_book(symbol), reference.get_order_book(symbol), symbol);
+    }
+}
+
+TEST(PartitionedFeedIntegrationTest, RebalanceMovesHotSymbolWithItsBook) {
+    PartitionedFeedIntegration::Config config;
+    config.worker_count = 2;
+    config.queue_capacity = 128;
+    PartitionedFeedIntegration partitioned(config);
+    FeedIntegration reference;
+    TickStream stream(11);
+
+    // Two symbols share worker 0, one is on worker 1: moving the lighter
+    // of worker 0's pair evens the load best
+    std::vector<std::string> busy = symbols_on(partitioned, 0, 2);
+    std::string quiet = symbols_on(partitioned, 1, 1)[0];
+    std::vector<feedhandler::common::Tick> ticks;
+    auto send = [&](const std::string& symbol, int count) {
+        for (int i = 0; i < count; ++i) {
+            ticks.push_back(stream.next(symbol));
+            ASSERT_TRUE(partitioned.route(ticks.back()));
+        }
+    };
+
+    ASSERT_TRUE(partitioned.start());
+    send(busy[0], 300);
+    send(busy[1], 100);
+    send(quiet, 50);
+
+    auto& table = feedhandler::common::SymbolTable::global();
+    EXPECT_TRUE(partitioned.rebalance());
+    EXPECT_EQ(partitioned.worker_for(table.intern(busy[0])), 0u);
+    EXPECT_EQ(partitioned.worker_for(table.intern(busy[1])), 1u);
+    EXPECT_EQ(partitioned.worker_stats(0).instruments, 1u);
+    EXPECT_EQ(partitioned.worker_stats(1).instruments, 2u);
+
+    // Updates after the move continue the moved book rather than a new one
+    send(busy[1], 200);
+    send(busy[0], 100);
+    partitioned.flush();
+    EXPECT_EQ(partitioned.integration(0).get_order_book(busy[1]), nullptr);
+    EXPECT_NE(partitioned.integration(1).get_order_book(busy[1]), nullptr);
+
+    // Counts restarted: worker 1 is busier now, but its only active
+    // symbol would just move the imbalance back
+    EXPECT_FALSE(partitioned.rebalance());
+
+    // Moving while stopped hands the book over directly
+    partitioned.stop();
+    EXPECT_TRUE(partitioned.move_instrument(table.intern(quiet), 0));
+    EXPECT_NE(partitioned.integration(0).get_order_book(quiet), nullptr);
+    EXPECT_FALSE(partitioned.move_instrument(table.intern("NEVER_ROUTED"), 0));
+
+    reference.process_ticks(ticks);
+    for (const auto& symbol : {busy[0], busy[1], quiet}) {
+        expect_same_book(partitioned.get_order_book(symbol), reference.get_order_book(symbol), symbol);
+    }
+}
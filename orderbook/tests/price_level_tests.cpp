@@ -190,6 +190,22 @@ TEST(PriceLevelTest, PriceConversionLargeValue) {
     EXPECT_DOUBLE_EQ(price_to_double(fixed), large);
 }
 
+TEST(PriceLevelTest, PriceConversionRoundsToNearest) {
+    EXPECT_EQ(price_from_double(149.99), 1499900);  // 1499899.999... in binary
+    EXPECT_EQ(price_from_double(0.29), 2900);
+    EXPECT_EQ(price_from_double(150.25, 100), 15025);
+    EXPECT_DOUBLE_EQ(price_to_double(15025, 100), 150.25);
+}
+
+TEST(PriceLevelTest, RescalePrice) {
+    EXPECT_EQ(rescale_price(1502500, 10000, 10000), 1502500);
+    EXPECT_EQ(rescale_price(15025, 100, 10000), 1502500);
+    EXPECT_EQ(rescale_price(1502549, 10000, 100), 15025);
+    EXPECT_EQ(rescale_price(1502550, 10000, 100), 15026);
+    EXPECT_EQ(rescale_price(-1502550, 10000, 100), -15026);
+    EXPECT_EQ(rescale_price(1000, 1000, 256), 256);
+}
+
 // ============================================================================
 // Comparison Operator Tests
 // ============================================================================